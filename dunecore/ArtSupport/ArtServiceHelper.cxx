@@ -4,12 +4,70 @@
 
 #include "dunecore/ArtSupport/ArtServiceHelper.h"
 
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+std::atomic<bool>& lazyFlag() {
+  static std::atomic<bool> lazy{false};
+  return lazy;
+}
+
+// FNV-1a hash, which unlike std::hash is the same in every build.
+std::uint64_t stableHash(std::string const& str, std::uint64_t hash = 14695981039346656037ull)
+{
+  for (unsigned char ch : str) {
+    hash ^= ch;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// Return the name of the cache file for a configuration file, or blank if the
+// cache is not enabled or the file cannot be read.
+std::string cacheFileName(std::string const& filename, std::string const& path)
+{
+  char const* pdir = std::getenv("DUNE_FCL_CACHE_DIR");
+  if (pdir == nullptr || *pdir == '\0') return "";
+  std::ifstream fin{path};
+  if (!fin) return "";
+  std::ostringstream sstxt;
+  sstxt << fin.rdbuf();
+  char const* pfpath = std::getenv("FHICL_FILE_PATH");
+  std::uint64_t hash = stableHash(filename);
+  hash = stableHash(sstxt.str(), hash);
+  hash = stableHash(pfpath == nullptr ? "" : pfpath, hash);
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash));
+  return std::string(pdir) + "/artsvc_" + buf + ".fcl";
+}
+
+}
+
 ArtServiceHelper::ArtServiceHelper(fhicl::ParameterSet&& pset) :
   activityRegistry_{},
   sharedResources_{},
   servicesManager_{std::move(pset), activityRegistry_, sharedResources_}
 {
-  servicesManager_.forceCreation();
+  // Without forced creation, the services manager constructs each service
+  // when it is first requested.
+  if (!lazyCreation()) servicesManager_.forceCreation();
+}
+
+void ArtServiceHelper::setLazyCreation(bool lazy)
+{
+  lazyFlag() = lazy;
+}
+
+bool ArtServiceHelper::lazyCreation()
+{
+  return lazyFlag();
 }
 
 void ArtServiceHelper::load_services(std::string const& config)
@@ -28,7 +86,33 @@ void ArtServiceHelper::load_services(std::istream& config)
 void ArtServiceHelper::load_services(std::string const& filename, FileOnPath_t)
 {
   cet::filepath_lookup lookup{"FHICL_FILE_PATH"};
-  load_services(fhicl::ParameterSet::make(filename, lookup));
+  std::string cachename;
+  try {
+    cachename = cacheFileName(filename, lookup(filename));
+  } catch (...) {
+    // The file is not on the path.  Leave the error to the parse below.
+  }
+  if (!cachename.empty()) {
+    std::ifstream fin{cachename};
+    if (fin) {
+      std::ostringstream sscfg;
+      sscfg << fin.rdbuf();
+      load_services(fhicl::ParameterSet::make(sscfg.str()));
+      return;
+    }
+  }
+  fhicl::ParameterSet pset = fhicl::ParameterSet::make(filename, lookup);
+  if (!cachename.empty()) {
+    // Write to a temporary name and rename so concurrent jobs do not read partial files.
+    std::string tmpname = cachename + ".tmp" + std::to_string(std::rand());
+    std::ofstream fout{tmpname};
+    if (fout) {
+      fout << pset.to_string() << std::endl;
+      fout.close();
+      if (std::rename(tmpname.c_str(), cachename.c_str()) != 0) std::remove(tmpname.c_str());
+    }
+  }
+  load_services(pset);
 }
 
 void ArtServiceHelper::load_services(fhicl::ParameterSet const& pset)
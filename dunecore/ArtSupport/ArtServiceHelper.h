@@ -97,6 +97,26 @@
 // parameter for each service--the ArtServiceHelper class inserts
 // those configuration parameters automatically.
 //
+// Startup
+// =======
+//
+// By default all configured services are constructed when the
+// services are loaded, as in art.  Standalone programs that use
+// only a few of them may call
+//
+//   ArtServiceHelper::setLazyCreation(true);
+//
+// before loading so that each service is constructed on first access,
+// e.g. through ArtServicePointer or art::ServiceHandle.  Services that
+// act only through framework callbacks are then never constructed.
+//
+// For filename-based configuration, the processed configuration may
+// be cached on disk by setting the environment variable
+// DUNE_FCL_CACHE_DIR to a writable directory.  The cache file is keyed
+// by a hash of the file name, its contents and FHICL_FILE_PATH, so it
+// is not refreshed when only an included file changes; remove the
+// cached files after changing included files.
+//
 // =================================================================
 
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
@@ -120,6 +140,10 @@ public:
   // For backward compatibility.
   static void load(std::string const& filename) { load_services(filename, FileOnPath_t{}); }
 
+  // Set/return whether services are constructed on first access rather than when loaded.
+  static void setLazyCreation(bool lazy);
+  static bool lazyCreation();
+
 private:
   explicit ArtServiceHelper(fhicl::ParameterSet&& pset);
   art::ActivityRegistry activityRegistry_;
@@ -7,6 +7,8 @@
 #include <fstream>
 #include <sstream>
 #include <cctype>
+#include <mutex>
+#include <atomic>
 
 using std::string;
 using std::cout;
@@ -23,6 +25,8 @@ string DuneToolManager::fclFilename(string a_fclname, int dbg) {
   const string myname = "DuneToolManager::fclFilename: ";
   if ( dbg >= 2 ) cout << myname << "Called with " << a_fclname << endl;
   static string fclname;
+  static std::mutex nameMutex;
+  std::lock_guard<std::mutex> lock(nameMutex);
   bool haveName = fclname.size();
   bool setName = a_fclname.size();
   if ( !haveName && !setName ) {
@@ -96,8 +100,19 @@ DuneToolManager* DuneToolManager::instance(string a_fclname, int dbg) {
   const string myname = "DuneToolManager::instance: ";
   if ( dbg >= 2 ) cout << myname << "Called with " << a_fclname << endl;
   static std::unique_ptr<DuneToolManager> pins;
+  static std::atomic<DuneToolManager*> pinsReady(nullptr);
+  static std::mutex insMutex;
+  // Once the instance exists, calls without a name need no lock.
+  if ( a_fclname.empty() ) {
+    DuneToolManager* ptm = pinsReady.load(std::memory_order_acquire);
+    if ( ptm != nullptr ) return ptm;
+  }
+  std::lock_guard<std::mutex> lock(insMutex);
   string fclname = fclFilename(a_fclname, dbg);
-  if ( !pins ) pins.reset(new DuneToolManager(fclname));
+  if ( !pins ) {
+    pins.reset(new DuneToolManager(fclname));
+    pinsReady.store(pins.get(), std::memory_order_release);
+  }
   return pins.get();
 }
 
@@ -135,23 +150,40 @@ DuneToolManager::DuneToolManager(std::string fclname)
     fhicl::ParameterSet::make(fhicl::parse_document(fclname, policy)).
     get<fhicl::ParameterSet>("tools");
   m_toolNames = m_pstools.get_pset_names();
+  m_toolNameSet.insert(m_toolNames.begin(), m_toolNames.end());
 }
 
 //**********************************************************************
 
 int DuneToolManager::deleteShared(std::string tnam) {
   int nerr = 0;
-  SharedToolMap::iterator itoo = m_sharedTools.find(tnam);
-  if ( itoo == m_sharedTools.end() ) nerr = nerr + 1;
-  else m_sharedTools.erase(tnam);
-  NameSet::iterator inam = m_redirectingNames.find(tnam);
-  if ( inam == m_redirectingNames.end()  ) nerr = nerr + 2;
-  else m_redirectingNames.erase(inam);
+  // The tool is deleted after the lock is released in case its dtor uses other tools.
+  SharedToolPtr pold;
+  {
+    std::unique_lock<std::shared_mutex> lock(m_sharedMutex);
+    SharedToolMap::iterator itoo = m_sharedTools.find(tnam);
+    if ( itoo == m_sharedTools.end() ) nerr = nerr + 1;
+    else {
+      pold = std::move(itoo->second);
+      m_sharedTools.erase(itoo);
+      ++m_sharedGeneration;
+    }
+    NameSet::iterator inam = m_redirectingNames.find(tnam);
+    if ( inam == m_redirectingNames.end()  ) nerr = nerr + 2;
+    else m_redirectingNames.erase(inam);
+  }
   return nerr;
 }
 
 //**********************************************************************
 
+bool DuneToolManager::hasShared(Name name) const {
+  std::shared_lock<std::shared_mutex> lock(m_sharedMutex);
+  return m_sharedTools.find(name) != m_sharedTools.end();
+}
+
+//**********************************************************************
+
 const std::vector<std::string>& DuneToolManager::toolNames() const {
   return m_toolNames;
 }
@@ -159,6 +191,7 @@ const std::vector<std::string>& DuneToolManager::toolNames() const {
 //**********************************************************************
 
 bool DuneToolManager::isRedirecting(Name name) const {
+  std::shared_lock<std::shared_mutex> lock(m_sharedMutex);
   return m_redirectingNames.find(name) != m_redirectingNames.end();
 }
 
@@ -173,6 +206,15 @@ void DuneToolManager::print() const {
 
 //**********************************************************************
 
+std::mutex& DuneToolManager::constructionMutex(Name name) {
+  std::unique_lock<std::shared_mutex> lock(m_sharedMutex);
+  std::unique_ptr<std::mutex>& pmut = m_constructionMutexes[name];
+  if ( ! pmut ) pmut.reset(new std::mutex);
+  return *pmut;
+}
+
+//**********************************************************************
+
 int DuneToolManager::makeParameterSet(std::string scfgin, fhicl::ParameterSet& ps) {
   // Strip surrounding braces.
   if ( scfgin.size() < 1 ) return 1;
@@ -189,3 +231,22 @@ int DuneToolManager::makeParameterSet(std::string scfgin, fhicl::ParameterSet& p
 }
 
 //**********************************************************************
+
+int DuneToolManager::cachedParameterSet(std::string scfg, fhicl::ParameterSet& ps) {
+  {
+    std::lock_guard<std::mutex> lock(m_cfgMutex);
+    auto icfg = m_cfgCache.find(scfg);
+    if ( icfg != m_cfgCache.end() ) {
+      ps = icfg->second;
+      return 0;
+    }
+  }
+  int rstat = makeParameterSet(scfg, ps);
+  if ( rstat == 0 ) {
+    std::lock_guard<std::mutex> lock(m_cfgMutex);
+    m_cfgCache.emplace(scfg, ps);
+  }
+  return rstat;
+}
+
+//**********************************************************************
@@ -23,6 +23,13 @@
 //
 // [January 2023] If the returned tool is a tool redirector, than call it to
 // retrieve the final tool.
+//
+// The primary instance is created once even if instance() is called concurrently.
+// Private and shared tools may be fetched concurrently from different threads.
+// Shared tools are each constructed once, and independent tools may be constructed
+// in parallel. The pointers to shared tools are stable and may be cached directly
+// or with a SharedToolHandle. Shared tools may be constructed ahead of the event
+// loop with preloadShared.
 
 #ifndef DuneToolManager_H
 #define DuneToolManager_H
@@ -31,6 +38,12 @@
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <unordered_map>
 #include "fhiclcpp/ParameterSet.h"
 #include "art/Utilities/make_tool.h"
 #include "dunecore/ArtSupport/ToolRedirector.h"
@@ -91,8 +104,8 @@ public:
       std::cout << myname << "ERROR: Tool name is blank" << std::endl;
       return nullptr;
     } else if ( name[0] == '{' ) {    // Name is a tool cfg string
-      makeParameterSet(name, psTool);
-    } else if ( std::find(m_toolNames.begin(), m_toolNames.end(), name) != m_toolNames.end() ) {
+      cachedParameterSet(name, psTool);
+    } else if ( hasTool(name) ) {
       psTool = m_pstools.get<fhicl::ParameterSet>(name);
     } else {
       std::cout << myname << "ERROR: No such tool name: " << name << std::endl;
@@ -111,16 +124,30 @@ public:
   }
 
   // Return a shared tool.
+  // The returned pointer is valid until the tool is deleted with deleteShared or the
+  // tool manager is destroyed. Callers making frequent requests should hold the
+  // pointer or a SharedToolHandle rather than repeating the name lookup.
+  // This method may be called concurrently from different threads.
   template<class T>
   T* getShared(Name name, bool doRedirect =true) {
     Name myname = "DuneToolManager::getShared: ";
-    SharedToolMap::iterator itoo = m_sharedTools.find(name);
-    if ( itoo != m_sharedTools.end() ) {
-      SharedToolPtr& pent = itoo->second;
-      if ( pent ) {
-        if ( isRedirecting(name) ) {
-          TSharedToolEntry<ToolRedirector>* prdent = dynamic_cast<TSharedToolEntry<ToolRedirector>*>(pent.get());
-          ToolRedirector* prd = prdent->get();
+    bool found = false;
+    bool redirecting = false;
+    SharedToolEntry* pent = nullptr;
+    {
+      std::shared_lock<std::shared_mutex> lock(m_sharedMutex);
+      SharedToolMap::const_iterator itoo = m_sharedTools.find(name);
+      if ( itoo != m_sharedTools.end() ) {
+        found = true;
+        pent = itoo->second.get();
+        redirecting = m_redirectingNames.count(name);
+      }
+    }
+    if ( found ) {
+      if ( pent != nullptr ) {
+        if ( redirecting ) {
+          TSharedToolEntry<ToolRedirector>* prdent = dynamic_cast<TSharedToolEntry<ToolRedirector>*>(pent);
+          ToolRedirector* prd = prdent == nullptr ? nullptr : prdent->get();
           if ( prd == nullptr ) {
             std::cout << myname << "ERROR: Null redirector with name " << name << "." << std::endl;
             return nullptr;
@@ -128,22 +155,35 @@ public:
           Name rname = prd->getName();
           return getShared<T>(rname);
         } else {
-          TSharedToolEntry<T>* ptent = dynamic_cast<TSharedToolEntry<T>*>(pent.get());
-          if ( pent != nullptr ) return ptent->get();
+          TSharedToolEntry<T>* ptent = dynamic_cast<TSharedToolEntry<T>*>(pent);
+          if ( ptent != nullptr ) return ptent->get();
         }
       }
       std::cout << myname << "ERROR: Null tool pointer for " << name << "." << std::endl;
       return nullptr;
     }
-    if ( std::find(m_toolNames.begin(), m_toolNames.end(), name) != m_toolNames.end() ) {
-      fhicl::ParameterSet psTool = m_pstools.get<fhicl::ParameterSet>(name);
-      if ( doRedirect && ToolRedirector::isRedirecting(psTool) ) {
-        std::unique_ptr<ToolRedirector> prd = art::make_tool<ToolRedirector>(psTool);
-        m_sharedTools.emplace(name, new TSharedToolEntry<ToolRedirector>(prd));
-        m_redirectingNames.insert(name);
-      } else {
-        std::unique_ptr<T> ptoo = art::make_tool<T>(psTool);
-        m_sharedTools.emplace(name, new TSharedToolEntry<T>(ptoo));
+    if ( hasTool(name) ) {
+      // Construction of each tool is serialized so that it is built only once, but
+      // tools with different names may be constructed concurrently. The registry
+      // lock is not held during construction because the tool ctor may fetch
+      // other shared tools.
+      {
+        std::lock_guard<std::mutex> conLock(constructionMutex(name));
+        if ( ! hasShared(name) ) {
+          fhicl::ParameterSet psTool = m_pstools.get<fhicl::ParameterSet>(name);
+          SharedToolPtr pnew;
+          bool newRedirecting = doRedirect && ToolRedirector::isRedirecting(psTool);
+          if ( newRedirecting ) {
+            std::unique_ptr<ToolRedirector> prd = art::make_tool<ToolRedirector>(psTool);
+            pnew.reset(new TSharedToolEntry<ToolRedirector>(prd));
+          } else {
+            std::unique_ptr<T> ptoo = art::make_tool<T>(psTool);
+            pnew.reset(new TSharedToolEntry<T>(ptoo));
+          }
+          std::unique_lock<std::shared_mutex> lock(m_sharedMutex);
+          m_sharedTools.emplace(name, std::move(pnew));
+          if ( newRedirecting ) m_redirectingNames.insert(name);
+        }
       }
       // Now tool is known. Repeat call to fetch the tool.
       return getShared<T>(name, doRedirect);
@@ -153,8 +193,85 @@ public:
     }
   }
 
+  // Construct the shared tools with the given names, e.g. during job initialization
+  // so that the cost is not incurred in the first event. All must have interface T.
+  // Up to nthread threads are used so that independent tools are constructed
+  // concurrently.
+  // Returns the number of tools that could not be obtained.
+  template<class T>
+  unsigned int preloadShared(const NameVector& names, unsigned int nthread =1) {
+    std::atomic<unsigned int> inext(0);
+    std::atomic<unsigned int> nerr(0);
+    auto work = [this, &names, &inext, &nerr]() {
+      for ( unsigned int inam=inext++; inam<names.size(); inam=inext++ ) {
+        if ( getShared<T>(names[inam]) == nullptr ) ++nerr;
+      }
+    };
+    if ( nthread > names.size() ) nthread = names.size();
+    std::vector<std::thread> thrs;
+    for ( unsigned int ithr=1; ithr<nthread; ++ithr ) thrs.emplace_back(work);
+    work();
+    for ( std::thread& thr : thrs ) thr.join();
+    return nerr;
+  }
+
+  // Return if a shared tool has been constructed.
+  bool hasShared(Name name) const;
+
+  // Handle to a shared tool that caches the tool pointer.
+  // The pointer is fetched from the manager on first use and again only after a
+  // shared tool has been deleted, so that get() is nearly free. The pointer is not
+  // cached for redirecting names. The handle may be used concurrently from
+  // different threads.
+  template<class T>
+  class SharedToolHandle {
+  public:
+    SharedToolHandle() =default;
+    SharedToolHandle(DuneToolManager* ptm, Name name) : m_ptm(ptm), m_name(name) { }
+    SharedToolHandle(const SharedToolHandle& rhs) : m_ptm(rhs.m_ptm), m_name(rhs.m_name) { }
+    SharedToolHandle& operator=(const SharedToolHandle& rhs) {
+      m_ptm = rhs.m_ptm;
+      m_name = rhs.m_name;
+      m_ptool.store(nullptr);
+      return *this;
+    }
+    const Name& name() const { return m_name; }
+    T* get() const {
+      if ( m_ptm == nullptr ) return nullptr;
+      unsigned long igen = m_ptm->sharedGeneration();
+      // The generation is stored after the pointer and loaded before it.
+      bool current = m_gen.load(std::memory_order_acquire) == igen;
+      T* ptool = m_ptool.load(std::memory_order_acquire);
+      if ( current && ptool != nullptr ) return ptool;
+      ptool = m_ptm->getShared<T>(m_name);
+      // The target of a redirecting name depends on the context and is not cached
+      // here. Redirectors cache their own choice of name.
+      if ( m_ptm->isRedirecting(m_name) ) return ptool;
+      m_ptool.store(ptool, std::memory_order_release);
+      m_gen.store(igen, std::memory_order_release);
+      return ptool;
+    }
+    T* operator->() const { return get(); }
+    explicit operator bool() const { return get() != nullptr; }
+  private:
+    DuneToolManager* m_ptm = nullptr;
+    Name m_name;
+    mutable std::atomic<T*> m_ptool {nullptr};
+    mutable std::atomic<unsigned long> m_gen {0};
+  };
+
+  // Return a handle for a shared tool.
+  template<class T>
+  SharedToolHandle<T> sharedHandle(Name name) { return SharedToolHandle<T>(this, name); }
+
+  // Count of shared tool deletions. Pointers to shared tools fetched when this
+  // had the current value are still valid.
+  unsigned long sharedGeneration() const { return m_sharedGeneration.load(std::memory_order_acquire); }
+
   // Delete a shared tool.
   // Returns 0 if tool is deleted.
+  // Pointers to the tool held elsewhere become invalid; SharedToolHandle objects
+  // fetch the tool again.
   // These tools are otherwise deleted when the tool manager is deleted. This method
   // provides the opportunity to ensure this destruction occurs before general C++
   // closeout, e.g. before Root objects begin to dissappear.
@@ -163,6 +280,9 @@ public:
   // Return the list of available tool names.
   const NameVector& toolNames() const;
 
+  // Return if a tool name is defined in the fcl.
+  bool hasTool(Name name) const { return m_toolNameSet.count(name); }
+
   // Return if name references a redirecting tool.
   bool isRedirecting(Name name) const;
 
@@ -174,11 +294,28 @@ private:
   Name m_fclname;
   fhicl::ParameterSet m_pstools;
   NameVector m_toolNames;
+  std::unordered_set<Name> m_toolNameSet;
   SharedToolMap m_sharedTools;
   NameSet m_redirectingNames;
+  mutable std::shared_mutex m_sharedMutex;
+  std::atomic<unsigned long> m_sharedGeneration {0};
+
+  // Mutexes serializing the construction of each shared tool.
+  std::map<Name, std::unique_ptr<std::mutex>> m_constructionMutexes;
+
+  // Return the construction mutex for a shared tool.
+  std::mutex& constructionMutex(Name name);
+
+  // Parameter sets for configuration strings.
+  std::unordered_map<Name, fhicl::ParameterSet> m_cfgCache;
+  std::mutex m_cfgMutex;
 
   // Convert a string into a paramter set.
   int makeParameterSet(Name scfg, fhicl::ParameterSet& ps);
+
+  // Same, returning the parameter set from an earlier call with the same string
+  // if there is one.
+  int cachedParameterSet(Name scfg, fhicl::ParameterSet& ps);
   
 };
 
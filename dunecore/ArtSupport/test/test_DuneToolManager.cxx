@@ -7,6 +7,8 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 using std::string;
 using std::cout;
@@ -40,6 +42,18 @@ int test_DuneToolManager(bool useExistingFcl =false) {
     fout << "    tool_type: TestTool" << endl;
     fout << "    Label: \"Tool 2\"" << endl;
     fout << "  }" << endl;
+    fout << "  mytool3: {" << endl;
+    fout << "    tool_type: TestTool" << endl;
+    fout << "    Label: \"Tool 3\"" << endl;
+    fout << "  }" << endl;
+    fout << "  mytool4: {" << endl;
+    fout << "    tool_type: TestTool" << endl;
+    fout << "    Label: \"Tool 4\"" << endl;
+    fout << "  }" << endl;
+    fout << "  mytool5: {" << endl;
+    fout << "    tool_type: TestTool" << endl;
+    fout << "    Label: \"Tool 5\"" << endl;
+    fout << "  }" << endl;
     fout << "}" << endl;
     fout.close();
   } else {
@@ -95,6 +109,52 @@ int test_DuneToolManager(bool useExistingFcl =false) {
   assert( pts3 != pts2 );
   assert( pts3->label() == "Tool 2" );
 
+  cout << myname << line << endl;
+  cout << myname << "Preload shared tools." << endl;
+  assert( ! ptm->hasShared("mytool4") );
+  assert( ! ptm->hasShared("mytool5") );
+  DuneToolManager::NameVector preNames = {"mytool4", "mytool5", "mytool1", "nosuchtool"};
+  assert( ptm->preloadShared<TestTool>(preNames, 3) == 1 );
+  assert( ptm->hasShared("mytool4") );
+  assert( ptm->hasShared("mytool5") );
+  assert( ptm->getShared<TestTool>("mytool1") == pts1 );
+  assert( ptm->getShared<TestTool>("mytool5")->label() == "Tool 5" );
+
+  cout << myname << line << endl;
+  cout << myname << "Fetch shared tool with a handle." << endl;
+  DuneToolManager::SharedToolHandle<TestTool> htool = ptm->sharedHandle<TestTool>("mytool2");
+  assert( htool.name() == "mytool2" );
+  assert( htool.get() == pts3 );
+  assert( htool->label() == "Tool 2" );
+
+  cout << myname << line << endl;
+  cout << myname << "Fetch shared tool from several threads." << endl;
+  std::vector<TestTool*> thrTools(8, nullptr);
+  std::vector<std::thread> thrs;
+  for ( unsigned int ithr=0; ithr<thrTools.size(); ++ithr ) {
+    thrs.emplace_back([&thrTools, &htool, ptm, ithr]() {
+      TestTool* ptoo = ptm->getShared<TestTool>("mytool3");
+      for ( unsigned int icall=0; icall<1000; ++icall ) assert( htool.get() != nullptr );
+      thrTools[ithr] = ptoo;
+    });
+  }
+  for ( std::thread& thr : thrs ) thr.join();
+  assert( thrTools[0] != nullptr );
+  for ( TestTool* ptoo : thrTools ) assert( ptoo == thrTools[0] );
+  assert( thrTools[0]->label() == "Tool 3" );
+
+  cout << myname << line << endl;
+  cout << myname << "Delete shared tool." << endl;
+  unsigned long igen = ptm->sharedGeneration();
+  assert( ptm->deleteShared("mytool2") == 2 );
+  assert( ptm->sharedGeneration() == igen + 1 );
+  assert( ptm->deleteShared("mytool2") == 3 );
+  assert( ptm->sharedGeneration() == igen + 1 );
+  TestTool* pts4 = htool.get();
+  assert( pts4 != nullptr );
+  assert( pts4 == ptm->getShared<TestTool>("mytool2") );
+  assert( pts4->label() == "Tool 2" );
+
   cout << myname << line << endl;
   cout << myname << "Fetch a private tool with config." << endl;
   string scfgTool = "{ tool_type:TestTool Label:\"Tool C\" }";
@@ -104,6 +164,20 @@ int test_DuneToolManager(bool useExistingFcl =false) {
   assert( ptpc != ptp1 );
   assert( ptpc->label() == "Tool C" );
 
+  cout << myname << line << endl;
+  cout << myname << "Fetch another private tool with the same config." << endl;
+  auto ptpc2 = ptm->getPrivate<TestTool>(scfgTool);
+  assert( ptpc2 != nullptr );
+  assert( ptpc2 != ptpc );
+  assert( ptpc2->label() == "Tool C" );
+
+  cout << myname << line << endl;
+  cout << myname << "Check tool names." << endl;
+  assert( ptm->hasTool("mytool1") );
+  assert( ptm->hasTool("mytool5") );
+  assert( ! ptm->hasTool("nosuchtool") );
+  assert( ! ptm->hasTool(scfgTool) );
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
@@ -16,7 +16,64 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstdio>
+#include <cstring>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+  // Layout of the binary cache file: a header followed by nchan ChanRecords and ncrate
+  // CrateRecords.  The record sizes and a byte-order tag are stored so that a cache written
+  // by an incompatible build is rejected rather than misread.
+
+  const char cacheMagic[8] = {'F', 'D', 'H', 'D', 'C', 'M', 'A', 'P'};
+  constexpr uint32_t cacheVersion = 1;
+  constexpr uint32_t cacheByteOrder = 0x01020304;
+
+  struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t chanRecordSize;
+    uint32_t crateRecordSize;
+    uint64_t key;
+    uint64_t nchan;
+    uint64_t ncrate;
+    uint64_t checksum;   // of the records following the header
+  };
+
+  // 64-bit FNV-1a hash, used to key the cache on the contents of the map files
+
+  uint64_t fnv1a(const char *data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL)
+  {
+    for (size_t i = 0; i < size; ++i)
+      {
+        hash ^= (unsigned char) data[i];
+        hash *= 0x100000001b3ULL;
+      }
+    return hash;
+  }
+
+  uint64_t fnv1a(const std::string &text, uint64_t hash = 0xcbf29ce484222325ULL)
+  {
+    return fnv1a(text.data(), text.size(), hash);
+  }
+
+  bool readWholeFile(const std::string &filename, std::string &contents)
+  {
+    std::ifstream inFile(filename, std::ios::in | std::ios::binary);
+    if (!inFile) return false;
+    std::ostringstream ss;
+    ss << inFile.rdbuf();
+    contents = ss.str();
+    return true;
+  }
+
+}
 
 // so far, nothing needs to be done in the constructor
 
@@ -27,25 +84,100 @@ dune::FDHDChannelMapSP::FDHDChannelMapSP()
 void dune::FDHDChannelMapSP::ReadMapFromFiles(const std::string &chanmapfile, const std::string &cratemapfile)
 {
   std::ifstream inFile(chanmapfile, std::ios::in);
+  std::ifstream inFile2(cratemapfile, std::ios::in);
+  std::vector<ChanRecord> chans;
+  std::vector<CrateEntry> crates;
+  parseMapFiles(inFile, inFile2, chans, crates);
+  buildTables(chans.data(), chans.size(), crates);
+}
+
+bool dune::FDHDChannelMapSP::ReadMapFromFiles(const std::string &chanmapfile, const std::string &cratemapfile,
+                                              const std::string &cachedir)
+{
+  std::string chantext;
+  std::string cratetext;
+  if (cachedir.empty() || !readWholeFile(chanmapfile, chantext) || !readWholeFile(cratemapfile, cratetext))
+    {
+      ReadMapFromFiles(chanmapfile, cratemapfile);
+      return false;
+    }
+
+  uint64_t key = fnv1a(cratetext, fnv1a(chantext) ^ cacheVersion);
+  char keyname[17];
+  snprintf(keyname, sizeof(keyname), "%016llx", (unsigned long long) key);
+  std::string cachefile = cachedir + "/FDHDChannelMap_" + keyname + ".bin";
+
+  if (readCache(cachefile, key)) return true;
+
+  std::istringstream chanstream(chantext);
+  std::istringstream cratestream(cratetext);
+  std::vector<ChanRecord> chans;
+  std::vector<CrateEntry> crates;
+  parseMapFiles(chanstream, cratestream, chans, crates);
+  buildTables(chans.data(), chans.size(), crates);
+  writeCache(cachefile, key, chans, crates);
+  return false;
+}
+
+// Read the two text files into records.  Lines that do not parse are skipped.
+
+void dune::FDHDChannelMapSP::parseMapFiles(std::istream &chanstream, std::istream &cratestream,
+                                           std::vector<ChanRecord> &chans, std::vector<CrateEntry> &crates) const
+{
   std::string line;
+  while (std::getline(chanstream,line)) {
+    std::stringstream linestream(line);
 
-  while (std::getline(inFile,line)) {
+    ChanRecord rec;
+    linestream 
+      >> rec.offlchan 
+      >> rec.upright
+      >> rec.wib 
+      >> rec.link 
+      >> rec.femb_on_link 
+      >> rec.cebchan 
+      >> rec.plane 
+      >> rec.chan_in_plane 
+      >> rec.femb 
+      >> rec.asic 
+      >> rec.asicchan
+      >> rec.wibframechan; 
+    if (!linestream) continue;
+    chans.push_back(rec);
+  }
+
+  while (std::getline(cratestream,line)) {
+    CrateEntry entry;
     std::stringstream linestream(line);
+    linestream >> entry.crate >> entry.apaname;
+    if (!linestream) continue;
+    crates.push_back(entry);
+  }
+}
+
+// Build all lookup tables from the parsed records, from the text files or the cache.
+
+void dune::FDHDChannelMapSP::buildTables(const ChanRecord *chans, size_t nchans, const std::vector<CrateEntry> &crates)
+{
+  std::vector<HDChanInfo_t> detChanInfos;
+  detChanInfos.reserve(nchans);
+
+  for (size_t ichan = 0; ichan < nchans; ++ichan) {
+    const ChanRecord &rec = chans[ichan];
 
     HDChanInfo_t chanInfo;
-    linestream 
-      >> chanInfo.offlchan 
-      >> chanInfo.upright
-      >> chanInfo.wib 
-      >> chanInfo.link 
-      >> chanInfo.femb_on_link 
-      >> chanInfo.cebchan 
-      >> chanInfo.plane 
-      >> chanInfo.chan_in_plane 
-      >> chanInfo.femb 
-      >> chanInfo.asic 
-      >> chanInfo.asicchan
-      >> chanInfo.wibframechan; 
+    chanInfo.offlchan = rec.offlchan;
+    chanInfo.upright = rec.upright;
+    chanInfo.wib = rec.wib;
+    chanInfo.link = rec.link;
+    chanInfo.femb_on_link = rec.femb_on_link;
+    chanInfo.cebchan = rec.cebchan;
+    chanInfo.plane = rec.plane;
+    chanInfo.chan_in_plane = rec.chan_in_plane;
+    chanInfo.femb = rec.femb;
+    chanInfo.asic = rec.asic;
+    chanInfo.asicchan = rec.asicchan;
+    chanInfo.wibframechan = rec.wibframechan;
 
     // internal information lacks crate number and APA name because it is meant to
     // be generic for all APAs.
@@ -57,31 +189,53 @@ void dune::FDHDChannelMapSP::ReadMapFromFiles(const std::string &chanmapfile, co
 
     check_offline_channel(chanInfo.offlchan);
 
-    DetToChanInfo[chanInfo.upright][chanInfo.wib][chanInfo.link][chanInfo.wibframechan] = chanInfo;
-    if (chanInfo.upright)
-      {
-        OfflToChanInfo_Upright[chanInfo.offlchan] = chanInfo;
-      }
-    else
+    if (chanInfo.upright > 1 || chanInfo.wibframechan >= NChansPerWIBFrame)
       {
-        OfflToChanInfo_Inverted[chanInfo.offlchan] = chanInfo;
+        throw std::invalid_argument("FDHDChannelMapSP: upright flag or WIB frame channel out of range in channel map file\n");
       }
+    chanInfo.valid = true;
+    detChanInfos.push_back(chanInfo);
   }
-  inFile.close();
 
-  std::ifstream inFile2(cratemapfile, std::ios::in);
-  while (std::getline(inFile2,line)) {
-    std::string apaname;
-    unsigned int cratenum;
-    std::stringstream linestream(line);
-    linestream >> cratenum >> apaname;
-    if (fAPANameFromCrate.find(cratenum) != fAPANameFromCrate.end())
+  // build the flat (upright, wib, link, wibframechan) table
+
+  fNWibIndex = 0;
+  fNLinkIndex = 0;
+  for (const auto &ci : detChanInfos)
+    {
+      if (ci.wib >= fNWibIndex) fNWibIndex = ci.wib + 1;
+      if (ci.link >= fNLinkIndex) fNLinkIndex = ci.link + 1;
+    }
+  HDChanInfo_t badInfo = {};
+  badInfo.valid = false;
+  fChanInfoTable.assign(2*fNWibIndex*fNLinkIndex*NChansPerWIBFrame, badInfo);
+  fChanInfoOffl.assign(fChanInfoTable.size(), InvalidChannel);
+  for (const auto &ci : detChanInfos)
+    {
+      size_t idx = chanTableIndex(ci.upright, ci.wib, ci.link, ci.wibframechan);
+      fChanInfoTable[idx] = ci;
+      fChanInfoOffl[idx] = ci.offlchan;
+    }
+
+  // and the reverse (upright, offline channel modulo 2560) table
+
+  fOfflChanInfoTable.assign(2*NChansPerAPA, badInfo);
+  for (const auto &ci : detChanInfos)
+    {
+      fOfflChanInfoTable[ci.upright*NChansPerAPA + ci.offlchan % NChansPerAPA] = ci;
+    }
+
+  fAPANameFromCrate.clear();
+  fUprightFromCrate.clear();
+  fCrateFromTPCSet.clear();
+  fTPCSetFromCrate.clear();
+  for (const auto &entry : crates) {
+    if (fAPANameFromCrate.find(entry.crate) != fAPANameFromCrate.end())
       {
 	throw std::invalid_argument("FDHDChannelMapSP: Duplicate crate number in cratemap file\n"); 
       }
-    fAPANameFromCrate[cratenum] = apaname;
+    fAPANameFromCrate[entry.crate] = entry.apaname;
   }
-  inFile2.close();
 
   // fill maps of crates and TPCSets
 
@@ -108,6 +262,151 @@ void dune::FDHDChannelMapSP::ReadMapFromFiles(const std::string &chanmapfile, co
       fCrateFromTPCSet[TPCSet] = crate;
       fTPCSetFromCrate[crate] = TPCSet;
     }
+
+  // flat per-crate table
+
+  fCrateInfo.clear();
+  for (auto &ani : fAPANameFromCrate )
+    {
+      auto crate = ani.first;
+      if (crate >= fCrateInfo.size()) fCrateInfo.resize(crate + 1);
+      CrateInfo &cinfo = fCrateInfo[crate];
+      cinfo.valid = true;
+      cinfo.upright = fUprightFromCrate[crate];
+      cinfo.tpcset = fTPCSetFromCrate[crate];
+      cinfo.apaname = ani.second;
+    }
+  if (!fAPANameFromCrate.empty()) fSubstituteCrate = fAPANameFromCrate.begin()->first;
+
+  // flat per-TPCSet table
+
+  fTPCSetInfo.assign(fNAPAs, TPCSetInfo());
+  for (auto &cti : fCrateFromTPCSet)
+    {
+      if (cti.first >= fTPCSetInfo.size()) continue;   // not reachable from a valid offline channel
+      TPCSetInfo &tinfo = fTPCSetInfo[cti.first];
+      tinfo.valid = true;
+      tinfo.crate = cti.second;
+      tinfo.upright = fUprightFromCrate[cti.second];
+      tinfo.apaname = fAPANameFromCrate[cti.second];
+    }
+}
+
+// Map the cache file and build the tables from it.  Returns false, leaving the tables
+// to be built from the text files, if the file is missing, of another format or key,
+// or inconsistent.
+
+bool dune::FDHDChannelMapSP::readCache(const std::string &cachefile, uint64_t key)
+{
+  int fd = open(cachefile.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(CacheHeader))
+    {
+      close(fd);
+      return false;
+    }
+  size_t size = st.st_size;
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) return false;
+
+  bool ok = false;
+  const char *base = static_cast<const char*>(addr);
+  CacheHeader hdr;
+  std::memcpy(&hdr, base, sizeof(hdr));
+  if (std::memcmp(hdr.magic, cacheMagic, sizeof(cacheMagic)) == 0 &&
+      hdr.version == cacheVersion && hdr.byteOrder == cacheByteOrder &&
+      hdr.chanRecordSize == sizeof(ChanRecord) && hdr.crateRecordSize == sizeof(CrateRecord) &&
+      hdr.key == key &&
+      size == sizeof(CacheHeader) + hdr.nchan*sizeof(ChanRecord) + hdr.ncrate*sizeof(CrateRecord) &&
+      hdr.checksum == fnv1a(base + sizeof(CacheHeader), size - sizeof(CacheHeader)))
+    {
+      // the records follow the 8-byte aligned header in the page-aligned mapping
+      const ChanRecord *chans = reinterpret_cast<const ChanRecord*>(base + sizeof(CacheHeader));
+      const CrateRecord *crecs = reinterpret_cast<const CrateRecord*>(base + sizeof(CacheHeader) + hdr.nchan*sizeof(ChanRecord));
+      std::vector<CrateEntry> crates(hdr.ncrate);
+      for (size_t icrate = 0; icrate < hdr.ncrate; ++icrate)
+        {
+          crates[icrate].crate = crecs[icrate].crate;
+          crates[icrate].apaname.assign(crecs[icrate].apaname, strnlen(crecs[icrate].apaname, sizeof(crecs[icrate].apaname)));
+        }
+      try
+        {
+          buildTables(chans, hdr.nchan, crates);
+          ok = true;
+        }
+      catch (const std::exception&)
+        {
+          ok = false;
+        }
+    }
+  munmap(addr, size);
+  return ok;
+}
+
+// Write the cache through a temporary file renamed into place, so that jobs starting at
+// the same time never see a partial file.  Failure to write is not an error.
+
+bool dune::FDHDChannelMapSP::writeCache(const std::string &cachefile, uint64_t key,
+                                        const std::vector<ChanRecord> &chans, const std::vector<CrateEntry> &crates) const
+{
+  std::vector<CrateRecord> crecs(crates.size());
+  for (size_t icrate = 0; icrate < crates.size(); ++icrate)
+    {
+      if (crates[icrate].apaname.size() >= sizeof(crecs[icrate].apaname)) return false;
+      crecs[icrate] = CrateRecord();
+      crecs[icrate].crate = crates[icrate].crate;
+      std::memcpy(crecs[icrate].apaname, crates[icrate].apaname.data(), crates[icrate].apaname.size());
+    }
+
+  CacheHeader hdr;
+  std::memset(&hdr, 0, sizeof(hdr));
+  std::memcpy(hdr.magic, cacheMagic, sizeof(cacheMagic));
+  hdr.version = cacheVersion;
+  hdr.byteOrder = cacheByteOrder;
+  hdr.chanRecordSize = sizeof(ChanRecord);
+  hdr.crateRecordSize = sizeof(CrateRecord);
+  hdr.key = key;
+  hdr.nchan = chans.size();
+  hdr.ncrate = crecs.size();
+  hdr.checksum = fnv1a(reinterpret_cast<const char*>(crecs.data()), crecs.size()*sizeof(CrateRecord),
+                       fnv1a(reinterpret_cast<const char*>(chans.data()), chans.size()*sizeof(ChanRecord)));
+
+  std::string tmpfile = cachefile + ".tmp." + std::to_string(getpid());
+  FILE *fp = fopen(tmpfile.c_str(), "wb");
+  if (fp == nullptr) return false;
+  bool ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+  if (ok && !chans.empty()) ok = fwrite(chans.data(), sizeof(ChanRecord), chans.size(), fp) == chans.size();
+  if (ok && !crecs.empty()) ok = fwrite(crecs.data(), sizeof(CrateRecord), crecs.size(), fp) == crecs.size();
+  if (fclose(fp) != 0) ok = false;
+  if (ok) ok = (rename(tmpfile.c_str(), cachefile.c_str()) == 0);
+  if (!ok) remove(tmpfile.c_str());
+  return ok;
+}
+
+// ununderstood crates are mapped to the first crate in the APA name map
+
+const dune::FDHDChannelMapSP::CrateInfo& dune::FDHDChannelMapSP::crateInfo(unsigned int crate, unsigned int &scrate) const
+{
+  scrate = crate;
+  if (crate >= fCrateInfo.size() || !fCrateInfo[crate].valid)
+    {
+      scrate = fSubstituteCrate;
+      if (scrate >= fCrateInfo.size())
+        {
+          throw std::invalid_argument("FDHDChannelMapSP: Logic error in TPCSet from crate\n");
+        }
+    }
+  return fCrateInfo[scrate];
+}
+
+const dune::FDHDChannelMapSP::TPCSetInfo& dune::FDHDChannelMapSP::tpcSetInfo(unsigned int offlchan) const
+{
+  check_offline_channel(offlchan);
+  static const TPCSetInfo noInfo;
+  unsigned int tpcset = offlchan / NChansPerAPA;
+  return (tpcset < fTPCSetInfo.size()) ? fTPCSetInfo[tpcset] : noInfo;
 }
 
 dune::FDHDChannelMapSP::HDChanInfo_t dune::FDHDChannelMapSP::GetChanInfoFromWIBElements(
@@ -121,76 +420,88 @@ dune::FDHDChannelMapSP::HDChanInfo_t dune::FDHDChannelMapSP::GetChanInfoFromWIBE
   HDChanInfo_t badInfo = {};
   badInfo.valid = false;
 
-// ununderstood crates are mapped to the first crate in the APA name map
-
-  auto scrate = crate;   // substitute crate
-  auto upri = fUprightFromCrate.find(crate);
-  if (upri == fUprightFromCrate.end())
-    {
-      scrate = fAPANameFromCrate.begin()->first;  
-    }
-  auto upright = upri->second;
-  auto TPCSi = fTPCSetFromCrate.find(scrate);
-  if (TPCSi == fTPCSetFromCrate.end())
-    {
-      throw std::invalid_argument("FDHDChannelMapSP: Logic error in TPCSet from crate\n");
-    }
-  auto tpcset = TPCSi->second;
-
-  auto fm1 = DetToChanInfo.find(upright);  // this should never fail as we have a substitute crate
-  auto& m1 = fm1->second;
-
-  auto fm2 = m1.find(wib);
-  if (fm2 == m1.end()) return badInfo;
-  auto& m2 = fm2->second;
+  unsigned int scrate = 0;   // substitute crate
+  const CrateInfo &cinfo = crateInfo(crate, scrate);
 
-  auto fm3 = m2.find(link);
-  if (fm3 == m2.end()) return badInfo;
-  auto& m3 = fm3->second;
+  if (wib >= fNWibIndex || link >= fNLinkIndex || wibframechan >= NChansPerWIBFrame) return badInfo;
+  const HDChanInfo_t &tinfo = fChanInfoTable[chanTableIndex(cinfo.upright, wib, link, wibframechan)];
+  if (!tinfo.valid) return badInfo;
 
-  auto fm4 = m3.find(wibframechan);
-  if (fm4 == m3.end()) return badInfo;
-
-  auto outputinfo = fm4->second;
-  outputinfo.offlchan += tpcset * 2560;
+  auto outputinfo = tinfo;
+  outputinfo.offlchan += cinfo.tpcset * 2560;
   outputinfo.crate = scrate;
-  auto aci = fAPANameFromCrate.find(scrate);
-  outputinfo.APAName = aci->second;
-  outputinfo.upright = upright;
+  outputinfo.APAName = cinfo.apaname;
+  outputinfo.upright = cinfo.upright;
 
   return outputinfo;
 
 }
 
 
-dune::FDHDChannelMapSP::HDChanInfo_t dune::FDHDChannelMapSP::GetChanInfoFromOfflChan(unsigned int offlineChannel) const {
+unsigned int dune::FDHDChannelMapSP::GetOfflChansFromWIBElements(
+    unsigned int crate,
+    unsigned int slot,
+    unsigned int link,
+    std::vector<unsigned int> &offlchans) const {
 
-  check_offline_channel(offlineChannel);
+  unsigned int wib = slot + 1;
+  offlchans.assign(NChansPerWIBFrame, InvalidChannel);
 
-  HDChanInfo_t outputinfo;
-  HDChanInfo_t internalinfo;
+  unsigned int scrate = 0;
+  const CrateInfo &cinfo = crateInfo(crate, scrate);
+  if (wib >= fNWibIndex || link >= fNLinkIndex) return 0;
 
-  unsigned int tpcset = offlineChannel / 2560;
-  auto ci = fCrateFromTPCSet.find(tpcset);
-  unsigned int crate = ci->second;
-  auto ui = fUprightFromCrate.find(crate);
-  unsigned int upright = ui->second;
-  if (upright)
+  const unsigned int* toffl = &fChanInfoOffl[chanTableIndex(cinfo.upright, wib, link, 0)];
+  unsigned int offset = cinfo.tpcset * 2560;
+  unsigned int nvalid = 0;
+  for (unsigned int ichan = 0; ichan < NChansPerWIBFrame; ++ichan)
     {
-       auto ci = OfflToChanInfo_Upright.find(offlineChannel % 2560);
-       internalinfo = ci->second;
+      if (toffl[ichan] == InvalidChannel) continue;
+      offlchans[ichan] = toffl[ichan] + offset;
+      ++nvalid;
     }
-  else
+  return nvalid;
+}
+
+unsigned int dune::FDHDChannelMapSP::GetOfflChansFromWIBElements(
+    unsigned int crate,
+    unsigned int slot,
+    unsigned int link,
+    std::vector<unsigned int> &offlchans,
+    std::vector<unsigned int> &planes) const {
+
+  unsigned int nvalid = GetOfflChansFromWIBElements(crate, slot, link, offlchans);
+  planes.assign(NChansPerWIBFrame, 0);
+  if (nvalid == 0) return 0;
+
+  unsigned int scrate = 0;
+  const CrateInfo &cinfo = crateInfo(crate, scrate);
+  const HDChanInfo_t* tinfo = &fChanInfoTable[chanTableIndex(cinfo.upright, slot + 1, link, 0)];
+  for (unsigned int ichan = 0; ichan < NChansPerWIBFrame; ++ichan)
     {
-       auto ci = OfflToChanInfo_Inverted.find(offlineChannel % 2560);
-       internalinfo = ci->second;
+      if (tinfo[ichan].valid) planes[ichan] = tinfo[ichan].plane;
     }
+  return nvalid;
+}
 
+
+dune::FDHDChannelMapSP::HDChanInfo_t dune::FDHDChannelMapSP::GetChanInfoFromOfflChan(unsigned int offlineChannel) const {
+
+  check_offline_channel(offlineChannel);
+
+  HDChanInfo_t outputinfo = {};
+  outputinfo.valid = false;
+
+  const TPCSetInfo &tinfo = tpcSetInfo(offlineChannel);
+  if (!tinfo.valid) return outputinfo;
+  const HDChanInfo_t &internalinfo = fOfflChanInfoTable[tinfo.upright*NChansPerAPA + offlineChannel % NChansPerAPA];
+  if (!internalinfo.valid) return outputinfo;
+
+  // copy field by field: the table entries have no APA name, so it is only copied once
   outputinfo.offlchan = offlineChannel;
-  outputinfo.crate = crate;
-  auto aci = fAPANameFromCrate.find(crate);
-  outputinfo.APAName = aci->second;
-  outputinfo.upright = upright;
+  outputinfo.crate = tinfo.crate;
+  outputinfo.APAName = tinfo.apaname;
+  outputinfo.upright = tinfo.upright;
   outputinfo.wib = internalinfo.wib;
   outputinfo.link = internalinfo.link;
   outputinfo.femb_on_link = internalinfo.femb_on_link;
@@ -205,3 +516,16 @@ dune::FDHDChannelMapSP::HDChanInfo_t dune::FDHDChannelMapSP::GetChanInfoFromOffl
 
   return outputinfo;
 }
+
+
+unsigned int dune::FDHDChannelMapSP::GetCrateFromOfflChan(unsigned int offlineChannel) const {
+
+  const TPCSetInfo &tinfo = tpcSetInfo(offlineChannel);
+  return tinfo.valid ? tinfo.crate : InvalidChannel;
+}
+
+
+std::string_view dune::FDHDChannelMapSP::GetAPANameFromOfflChan(unsigned int offlineChannel) const {
+
+  return tpcSetInfo(offlineChannel).apaname;
+}
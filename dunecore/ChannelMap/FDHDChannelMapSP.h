@@ -13,9 +13,12 @@
 #ifndef FDHDChannelMapSP_H
 #define FDHDChannelMapSP_H
 
+#include <cstdint>
+#include <iosfwd>
 #include <unordered_map>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 
 namespace dune {
@@ -51,6 +54,13 @@ public:
 
   void ReadMapFromFiles(const std::string &chanlist, const std::string &cratelist);
 
+  // Same, with a binary cache of the parsed files in directory cachedir, keyed by a hash of the
+  // contents of both files.  A valid cache is memory-mapped and used instead of parsing the text;
+  // otherwise the text files are parsed and the cache is written for later jobs.  Returns true if
+  // the map was taken from the cache.  An empty cachedir reads the text files only.
+
+  bool ReadMapFromFiles(const std::string &chanlist, const std::string &cratelist, const std::string &cachedir);
+
   // TPC channel map accessors
 
   // Map instrumentation numbers (crate:slot:link:FEMB:plane) to offline channel number.  FEMB is 0 or 1 and indexes the FEMB in the WIB frame.
@@ -62,13 +72,78 @@ public:
    unsigned int link,
    unsigned int wibframechan) const;
 
+  // Batch version for all channels of one WIB frame: fill offlchans[wibframechan] for
+  // wibframechan = 0 to 255 with the offline channel numbers.  Channels that are not
+  // mapped are given the value InvalidChannel.  Returns the number of mapped channels.
+
+  static constexpr unsigned int InvalidChannel = 0xffffffff;
+  static constexpr unsigned int NChansPerWIBFrame = 256;
+
+  unsigned int GetOfflChansFromWIBElements(
+   unsigned int crate,
+   unsigned int slot,
+   unsigned int link,
+   std::vector<unsigned int> &offlchans) const;
+
+  // Same, also filling planes[wibframechan] with the plane numbers.  Unmapped channels
+  // are given plane 0, as in the HDChanInfo_t returned for them by GetChanInfoFromWIBElements.
+
+  unsigned int GetOfflChansFromWIBElements(
+   unsigned int crate,
+   unsigned int slot,
+   unsigned int link,
+   std::vector<unsigned int> &offlchans,
+   std::vector<unsigned int> &planes) const;
+
   HDChanInfo_t GetChanInfoFromOfflChan(unsigned int offlchan) const;
 
+  // Crate number and APA name for an offline channel, without building a full HDChanInfo_t.
+  // The name refers to the map's own table and stays valid as long as the map.
+  // Channels in APAs not listed in the crate map give InvalidChannel and an empty name.
+
+  unsigned int GetCrateFromOfflChan(unsigned int offlchan) const;
+  std::string_view GetAPANameFromOfflChan(unsigned int offlchan) const;
+
   unsigned int getNChans() { return fNChans; }
 
 private:
 
   const unsigned int fNAPAs = 150;
+
+  // map file contents, one channel-map line per ChanRecord and one crate-map line per
+  // CrateEntry.  ChanRecord and CrateRecord are the binary cache format.
+
+  struct ChanRecord {
+    uint32_t offlchan = 0;
+    uint32_t upright = 0;
+    uint32_t wib = 0;
+    uint32_t link = 0;
+    uint32_t femb_on_link = 0;
+    uint32_t cebchan = 0;
+    uint32_t plane = 0;
+    uint32_t chan_in_plane = 0;
+    uint32_t femb = 0;
+    uint32_t asic = 0;
+    uint32_t asicchan = 0;
+    uint32_t wibframechan = 0;
+  };
+
+  struct CrateEntry {
+    unsigned int crate = 0;
+    std::string apaname;
+  };
+
+  struct CrateRecord {
+    uint32_t crate = 0;
+    char apaname[28] = {};   // null-terminated
+  };
+
+  void parseMapFiles(std::istream &chanstream, std::istream &cratestream,
+                     std::vector<ChanRecord> &chans, std::vector<CrateEntry> &crates) const;
+  void buildTables(const ChanRecord *chans, size_t nchans, const std::vector<CrateEntry> &crates);
+  bool readCache(const std::string &cachefile, uint64_t key);
+  bool writeCache(const std::string &cachefile, uint64_t key,
+                  const std::vector<ChanRecord> &chans, const std::vector<CrateEntry> &crates) const;
   const unsigned int fNChans = 2560*fNAPAs;
 
   // maps of crate numbers and APAs.  These are maps so we do not have to assume that
@@ -79,19 +154,52 @@ private:
   std::unordered_map<unsigned int, unsigned int>  fCrateFromTPCSet;
   std::unordered_map<unsigned int, unsigned int>  fTPCSetFromCrate;
 
-  // map of crate, slot, link, femb_on_link, plane, chan to channel info struct
-  // This is only for two APAs, one upright, and one inverted
+  // flat lookup table of channel info indexed by (upright, wib, link, wibframechan) for the
+  // two generic APAs, one upright and one inverted.  Entries not in the map file have valid = false.
+  // fChanInfoOffl holds just the offline channel numbers of the same table (InvalidChannel if
+  // not mapped) for the batch lookup.
 
-  std::unordered_map<unsigned int,   // upright
-    std::unordered_map<unsigned int, // wib
-    std::unordered_map<unsigned int, // link
-    std::unordered_map<unsigned int, // wibframechan
-    HDChanInfo_t > > > > DetToChanInfo;
+  unsigned int fNWibIndex = 0;    // wib numbers 0 to fNWibIndex-1 are in the table
+  unsigned int fNLinkIndex = 0;   // links 0 to fNLinkIndex-1 are in the table
+  std::vector<HDChanInfo_t> fChanInfoTable;
+  std::vector<unsigned int> fChanInfoOffl;
+
+  size_t chanTableIndex(unsigned int upright, unsigned int wib, unsigned int link, unsigned int wibframechan) const
+  {
+    return ((size_t(upright)*fNWibIndex + wib)*fNLinkIndex + link)*NChansPerWIBFrame + wibframechan;
+  }
 
-  // maps of chan info indexed by offline channel number modulo 2560, for one APA each
+  // per-crate information in a table indexed by crate number
+
+  struct CrateInfo {
+    bool valid = false;
+    unsigned int upright = 0;
+    unsigned int tpcset = 0;
+    std::string apaname;
+  };
+  std::vector<CrateInfo> fCrateInfo;
+  unsigned int fSubstituteCrate = 0;   // used for crates that are not in the crate map
+
+  // Return the info for a crate, substituting the first crate in the map for unknown crates.
+  const CrateInfo& crateInfo(unsigned int crate, unsigned int &scrate) const;
+
+  // reverse table of chan info indexed by (upright, offline channel number modulo 2560),
+  // and per-TPCSet (offline channel / 2560) table of the crate, its orientation and APA name.
+  // Entries not in the map files have valid = false.
+
+  static constexpr unsigned int NChansPerAPA = 2560;
+  std::vector<HDChanInfo_t> fOfflChanInfoTable;
+
+  struct TPCSetInfo {
+    bool valid = false;
+    unsigned int crate = 0;
+    unsigned int upright = 0;
+    std::string apaname;
+  };
+  std::vector<TPCSetInfo> fTPCSetInfo;
 
-  std::unordered_map<unsigned int, HDChanInfo_t> OfflToChanInfo_Inverted;
-  std::unordered_map<unsigned int, HDChanInfo_t> OfflToChanInfo_Upright;
+  // Return the info for the TPCSet of an offline channel; an invalid entry if there is none.
+  const TPCSetInfo& tpcSetInfo(unsigned int offlchan) const;
 
   //-----------------------------------------------
 
@@ -36,8 +36,27 @@ public:
    unsigned int link,
    unsigned int wibframechan) const;
 
+  // offline channels for all 256 channels of a WIB frame; see FDHDChannelMapSP
+  unsigned int GetOfflChansFromWIBElements(
+   unsigned int crate,
+   unsigned int slot,
+   unsigned int link,
+   std::vector<unsigned int> &offlchans) const;
+
+  // same, also with the plane numbers
+  unsigned int GetOfflChansFromWIBElements(
+   unsigned int crate,
+   unsigned int slot,
+   unsigned int link,
+   std::vector<unsigned int> &offlchans,
+   std::vector<unsigned int> &planes) const;
+
   dune::FDHDChannelMapSP::HDChanInfo_t GetChanInfoFromOfflChan(unsigned int offlchan) const;
 
+  // crate and APA name of an offline channel without a full HDChanInfo_t; see FDHDChannelMapSP
+  unsigned int GetCrateFromOfflChan(unsigned int offlchan) const;
+  std::string_view GetAPANameFromOfflChan(unsigned int offlchan) const;
+
   unsigned int getNChans() { return fHDChanMap.getNChans(); }
 
 private:
@@ -34,7 +34,13 @@ dune::FDHDChannelMapService::FDHDChannelMapService(fhicl::ParameterSet const& ps
   
   MF_LOG_INFO("FDHDChannelMapService") << "Building FDHD wiremap from file " << channelMapFile << " and crate map: " << crateMapFile << std::endl;
 
-  fHDChanMap.ReadMapFromFiles(chanmapfullname,cratemapfullname);
+  // optional binary cache of the parsed map files, shared by jobs using the same directory
+
+  std::string cacheDir = pset.get<std::string>("CacheDirectory", "");
+  if (fHDChanMap.ReadMapFromFiles(chanmapfullname,cratemapfullname,cacheDir))
+    {
+      MF_LOG_INFO("FDHDChannelMapService") << "FDHD wiremap taken from the cache in " << cacheDir << std::endl;
+    }
 }
 
 dune::FDHDChannelMapService::FDHDChannelMapService(fhicl::ParameterSet const& pset, art::ActivityRegistry&) : FDHDChannelMapService(pset) {
@@ -50,6 +56,27 @@ dune::FDHDChannelMapSP::HDChanInfo_t dune::FDHDChannelMapService::GetChanInfoFro
 }
 
 
+unsigned int dune::FDHDChannelMapService::GetOfflChansFromWIBElements(
+    unsigned int crate,
+    unsigned int slot,
+    unsigned int link,
+    std::vector<unsigned int> &offlchans) const {
+
+  return fHDChanMap.GetOfflChansFromWIBElements(crate,slot,link,offlchans);
+}
+
+unsigned int dune::FDHDChannelMapService::GetOfflChansFromWIBElements(
+    unsigned int crate,
+    unsigned int slot,
+    unsigned int link,
+    std::vector<unsigned int> &offlchans,
+    std::vector<unsigned int> &planes) const {
+
+  return fHDChanMap.GetOfflChansFromWIBElements(crate,slot,link,offlchans,planes);
+}
+
+
+
 dune::FDHDChannelMapSP::HDChanInfo_t dune::FDHDChannelMapService::GetChanInfoFromOfflChan(unsigned int offlineChannel) const {
 
   return fHDChanMap.GetChanInfoFromOfflChan(offlineChannel);
@@ -57,4 +84,16 @@ dune::FDHDChannelMapSP::HDChanInfo_t dune::FDHDChannelMapService::GetChanInfoFro
 }
 
 
+unsigned int dune::FDHDChannelMapService::GetCrateFromOfflChan(unsigned int offlineChannel) const {
+
+  return fHDChanMap.GetCrateFromOfflChan(offlineChannel);
+}
+
+
+std::string_view dune::FDHDChannelMapService::GetAPANameFromOfflChan(unsigned int offlineChannel) const {
+
+  return fHDChanMap.GetAPANameFromOfflChan(offlineChannel);
+}
+
+
 DEFINE_ART_SERVICE(dune::FDHDChannelMapService)
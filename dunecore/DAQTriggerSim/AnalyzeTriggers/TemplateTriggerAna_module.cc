@@ -30,6 +30,7 @@
 // DUNETPC specific includes
 #include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerTypes.h"
 #include "dunecore/DAQTriggerSim/TriggerDataProducts/BasicTrigger.h"
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerCollection.h"
 
 namespace triggersim {
 
@@ -59,6 +60,12 @@ private:
   // label for module that made trigger objects
   std::string fTriggerLabel;
 
+  // read a TriggerCollection instead of a vector of BasicTrigger
+  bool fUseTriggerCollection;
+
+  // Fill the tree and histogram from a TriggerCollection.
+  void analyzeCollection(art::Event const & evt);
+
   // a simple histo to be filled
   TH1F *fTrigTypes;
 
@@ -94,6 +101,7 @@ TemplateTriggerAna::TemplateTriggerAna(fhicl::ParameterSet const & p)
 void TemplateTriggerAna::reconfigure(fhicl::ParameterSet const & p)
 {
   fTriggerLabel = p.get<std::string> ("TriggerLabel");
+  fUseTriggerCollection = p.get<bool> ("UseTriggerCollection", false);
 }
 
 //......................................................
@@ -122,6 +130,11 @@ void TemplateTriggerAna::analyze(art::Event const & evt) {
 
   // --- Reset all of our variables...
   ResetVars();
+
+  if (fUseTriggerCollection) {
+    analyzeCollection(evt);
+    return;
+  }
   
   // --- Get trigger data products out of the event...
   auto triggers = evt.getValidHandle<std::vector<triggersim::BasicTrigger> >(fTriggerLabel);
@@ -158,6 +171,31 @@ void TemplateTriggerAna::analyze(art::Event const & evt) {
 
 }
 
+//......................................................
+void TemplateTriggerAna::analyzeCollection(art::Event const & evt) {
+
+  // --- Get the columnar trigger data product out of the event...
+  auto trigcol = evt.getValidHandle<triggersim::TriggerCollection>(fTriggerLabel);
+
+  Run    = evt.run();
+  SubRun = evt.subRun();
+  Event  = evt.event();
+
+  // --- Scan the columns directly, there is no need to make BasicTrigger objects...
+  const std::vector<unsigned char>& decisions = trigcol->TrigDecisions();
+  const std::vector<unsigned int>&  types     = trigcol->TrigTypes();
+  const std::vector<unsigned int>&  subtypes  = trigcol->TrigSubTypes();
+  for(unsigned int i = 0; i < trigcol->size(); ++i) {
+    TrigDecision = decisions[i];
+    TrigType     = types[i];
+    TrigSubType  = subtypes[i];
+    fTrigTypes->Fill(TrigType);
+    TrigAnaTree -> Fill();
+  }
+
+  std::cout << "\n----------Read " << trigcol->size() << " triggers from the TriggerCollection." << std::endl;
+}
+
 DEFINE_ART_MODULE(TemplateTriggerAna)
 
 }
@@ -28,18 +28,62 @@
 #include <iomanip>
 #include <vector>
 #include <map>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <charconv>
+#include <cstring>
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include "daqdataformats/v3_3_3/Fragment.hpp"
 #include "detdataformats/wib2/WIB2Frame.hpp"
 #include "lardataobj/RawData/raw.h"
 #include "lardataobj/RawData/RawDigit.h"
 #include "dunecore/ChannelMap/FDHDChannelMapService.h"
 #include "dunecore/HDF5Utils/HDF5Utils.h"
+#include "dunecore/RawDecoding/WIB2FramePacker.h"
+
+namespace {
+
+  // Append value to name, zero-padded to width digits, without stream formatting.
+  void appendZeroPadded(std::string& name, uint64_t value, int width)
+  {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    int ndig = res.ptr - buf;
+    if (width > ndig) name.append(width - ndig, '0');
+    name.append(buf, res.ptr);
+  }
+
+  // Link dataset names "Link00", "Link01", ... built once.
+  const std::vector<std::string>& linkNames(size_t nlink)
+  {
+    static const std::vector<std::string> names = []
+      {
+        std::vector<std::string> v(100);
+        for (size_t ilink = 0; ilink < v.size(); ++ilink)
+          {
+            v[ilink] = "Link";
+            appendZeroPadded(v[ilink], ilink, 2);
+          }
+        return v;
+      }();
+    if (nlink > names.size())
+      {
+        throw cet::exception("FDHDDAQWriter") << "Too many links: " << nlink << std::endl;
+      }
+    return names;
+  }
+
+}
 
 class FDHDDAQWriter : public art::EDAnalyzer {
 public:
   explicit FDHDDAQWriter(fhicl::ParameterSet const& p);
-  // The compiler-generated destructor is fine for non-base
-  // classes without bare pointers or other resource use.
+  ~FDHDDAQWriter();   // joins the writer thread if endRun was not reached
 
   // Plugins should not be copied or assigned.
   FDHDDAQWriter(FDHDDAQWriter const&) = delete;
@@ -53,6 +97,55 @@ public:
 
 private:
 
+  // one trigger record, fully built in memory and ready to be written
+
+  struct PendingLink {
+    std::string name;
+    std::unique_ptr<dunedaq::daqdataformats::Fragment> frag;
+  };
+  struct PendingAPA {
+    std::string name;
+    std::vector<PendingLink> links;
+  };
+  struct PendingRecord {
+    std::string trgname;
+    std::string tpcgname;
+    std::vector<PendingAPA> apas;
+    dune::HDF5Utils::HeaderInfo trhinfo;
+  };
+
+  bool makeAPA(int apa, const std::vector<const raw::RawDigit*>& rdindex, size_t nSamples,
+               const dune::FDHDChannelMapService& channelMap,
+               uint32_t runno, uint32_t evtno, const std::string& tpcgname,
+               uint64_t firstTimestamp, PendingAPA& papa) const;
+  void writeRecord(const PendingRecord& rec);
+
+  // TimeSlice mode: one record for the run whose link datasets are extendable and grow by
+  // the frames of each event.  The fragment header of each dataset is written with the
+  // first event and its size is brought up to date when the slice is closed.
+
+  struct SliceDataset {
+    hid_t dset;
+    hsize_t size;                                   // bytes written so far
+    dunedaq::daqdataformats::FragmentHeader header;  // header written with the first event
+  };
+  void appendTimeSlice(const PendingRecord& rec);
+  void appendSliceDataset(hid_t grp, const std::string& path, const PendingLink& plink);
+  void closeTimeSlice();
+  hid_t getSliceCreatePL();
+  void writeDataset(hid_t grp, const std::string& name, const void* data, hsize_t size, hid_t dcpl);
+  hid_t getDataspace(hsize_t size);
+  hid_t getFragmentCreatePL(hsize_t size);
+  void checkFilters() const;
+
+  // background writer used when fBufferedWrite is set; the HDF5 calls are then all made
+  // on the writer thread between beginRun and endRun
+
+  void startWriter();
+  void stopWriter();
+  void writerLoop();
+  void checkWriterError();
+
   void addStringAttribute(hid_t fp, std::string attrname, std::string attrval);
   void addU64Attribute(hid_t fp,  std::string attrname, uint64_t value);
   void addU32Attribute(hid_t fp,  std::string attrname, uint32_t value);
@@ -64,11 +157,40 @@ private:
   size_t fBytesWritten;
   int fCollectionPedestalOffset;
   int fInductionPedestalOffset;
+  bool fBufferedWrite;                  // hand complete records to a writer thread
+  size_t fWriteQueueDepth;              // records that may wait in the queue before analyze blocks
+  bool fParallelGenerate;               // build the fragments of all APAs concurrently (TBB)
+  dune::WIB2FramePacker fPacker;        // bulk WIB2 frame encoder
+
+  hid_t fLinkCreatePL;                  // link creation property list, UTF-8 names
+  std::map<hsize_t,hid_t> fDataspaces;  // dataspaces by dataset size, reused between datasets
+
+  // optional chunked layout and filters for the fragment datasets
+  hsize_t fChunkBytes;                  // chunk size in bytes, 0 for contiguous datasets
+  unsigned int fDeflateLevel;           // gzip level 1-9, 0 for none
+  unsigned int fFilterID;               // registered HDF5 filter plugin ID, 0 for none
+  std::vector<unsigned int> fFilterParams;  // cd_values passed to the plugin filter
+  std::map<hsize_t,hid_t> fCreatePLs;   // fragment dataset creation property lists by dataset size
+
+  bool fTimeSlice;                      // write one TimeSlice record with extendable link datasets
+  std::string fSliceName;               // TimeSlice group name, from the first event
+  uint64_t fSliceTimestamp;             // timestamp of the next frame of the slice
+  dune::HDF5Utils::HeaderInfo fSliceHeaderInfo;
+  std::map<std::string,SliceDataset> fSliceDatasets;   // open link datasets by path
+  hid_t fSliceCreatePL;                 // creation properties of the extendable datasets
+
+  std::deque<std::unique_ptr<PendingRecord>> fWriteQueue;
+  std::mutex fWriteMutex;
+  std::condition_variable fWriteCond;
+  std::thread fWriterThread;
+  bool fStopWriter;
+  std::exception_ptr fWriterError;
 };
 
 
 FDHDDAQWriter::FDHDDAQWriter(fhicl::ParameterSet const& p)
-  : EDAnalyzer{p}  // ,
+  : EDAnalyzer{p},
+    fPacker(p.get<bool>("UseSIMDPacker", true) ? dune::WIB2FramePacker::AUTO : dune::WIB2FramePacker::SCALAR)
 // More initializers here.
 {
   fOutfilename = p.get<std::string>("filename","hdcoldboxrawsim.hdf5");
@@ -76,7 +198,34 @@ FDHDDAQWriter::FDHDDAQWriter(fhicl::ParameterSet const& p)
   fOperationalEnvironment = p.get<std::string>("operational_environment","np04_coldbox");
   fCollectionPedestalOffset = p.get<int>("CollectionPedestalOffset",900);
   fInductionPedestalOffset = p.get<int>("InductionPedestalOffset",2000);
+  fBufferedWrite = p.get<bool>("BufferedWrite",false);
+  fParallelGenerate = p.get<bool>("ParallelGenerate",false);
+  fWriteQueueDepth = p.get<size_t>("WriteQueueDepth",2);
+  if (fWriteQueueDepth == 0) fWriteQueueDepth = 1;
+  fChunkBytes = p.get<size_t>("ChunkBytes",0);
+  fDeflateLevel = p.get<unsigned int>("DeflateLevel",0);
+  fFilterID = p.get<unsigned int>("FilterID",0);
+  fFilterParams = p.get<std::vector<unsigned int>>("FilterParams",std::vector<unsigned int>());
+  std::string recordType = p.get<std::string>("RecordType","TriggerRecord");
+  if (recordType != "TriggerRecord" && recordType != "TimeSlice")
+    {
+      throw cet::exception("FDHDDAQWriter") << "RecordType must be TriggerRecord or TimeSlice: " << recordType << std::endl;
+    }
+  fTimeSlice = recordType == "TimeSlice";
+  fSliceTimestamp = 0;
+  fSliceCreatePL = H5I_INVALID_HID;
+  if (fDeflateLevel > 9)
+    {
+      throw cet::exception("FDHDDAQWriter") << "DeflateLevel must be between 0 and 9: " << fDeflateLevel << std::endl;
+    }
   fFilePtr = H5I_INVALID_HID;
+  fLinkCreatePL = H5I_INVALID_HID;
+  fStopWriter = false;
+}
+
+FDHDDAQWriter::~FDHDDAQWriter()
+{
+  stopWriter();
 }
 
 void FDHDDAQWriter::analyze(art::Event const& e)
@@ -87,186 +236,572 @@ void FDHDDAQWriter::analyze(art::Event const& e)
   //auto subrun = e.subRun();
   auto evtno = e.event();
 
-  bool warnedNegative = false;  // warn just once per event
+  checkWriterError();
 
-  hid_t gpl = H5Pcreate(H5P_LINK_CREATE);
-  H5Pset_char_encoding(gpl,H5T_CSET_UTF8);
-  std::string trgname = "/TriggerRecord";
-  std::ostringstream ofm1;
-  ofm1 << std::internal << std::setfill('0') << std::setw(5) << evtno;
-  trgname += ofm1.str();
-  trgname += ".0000";
-  hid_t trg = H5Gcreate(fFilePtr,trgname.c_str(),gpl,H5P_DEFAULT,H5P_DEFAULT);
+  auto rec = std::make_unique<PendingRecord>();
+  std::string trgname;
+  if (!fTimeSlice)
+    {
+      trgname = "/TriggerRecord";
+      appendZeroPadded(trgname, evtno, 5);
+      trgname += ".0000";
+    }
+  else
+    {
+      // all events go into the slice named after the first one
+      if (fSliceName.empty())
+        {
+          fSliceName = "/TimeSlice";
+          appendZeroPadded(fSliceName, evtno, 5);
+          fSliceHeaderInfo.runNum = runno;
+          fSliceHeaderInfo.trigNum = evtno;
+        }
+      trgname = fSliceName;
+    }
+  rec->trgname = trgname;
   std::string tpcgname = trgname + "/TPC";
-  hid_t tpcg = H5Gcreate(fFilePtr,tpcgname.c_str(),gpl,H5P_DEFAULT,H5P_DEFAULT);
+  rec->tpcgname = tpcgname;
 
 
   // this will throw an exception if the raw digits cannot be found.
 
   auto const& RawDigits = e.getProduct< std::vector<raw::RawDigit> >(fRawDigitLabel);
 
-  // need a map of indices to raw digits sorted by channel number
+  // dense index of the raw digits by offline channel number, null for channels without one,
+  // and the list of APAs that have at least one, built in a single pass.
   // check that all raw digits have the same number of samples
 
-  std::map<uint32_t,uint32_t> rdmap;
+  std::vector<const raw::RawDigit*> rdindex;
+  std::vector<char> apahasdigits;
   size_t nSamples = 0;
-  for (uint32_t iptn=0; iptn<RawDigits.size(); ++iptn)
+  for (auto const& rd : RawDigits)
     {
-      rdmap[RawDigits[iptn].Channel()] = iptn;
-      size_t nSc = RawDigits[iptn].Samples();
+      uint32_t channo = rd.Channel();
+      if (channo >= rdindex.size())
+        {
+          size_t napa = channo/2560 + 1;
+          rdindex.resize(2560*napa, nullptr);
+          apahasdigits.resize(napa, 0);
+        }
+      rdindex[channo] = &rd;
+      apahasdigits[channo/2560] = 1;
+      size_t nSc = rd.Samples();
       if (nSamples == 0)
 	{
 	  nSamples = nSc;
 	}
       if (nSamples != 0 && nSamples != nSc)
 	{
-	  throw cet::exception("FDHDDAQWriter") << "raw digits have different numbers of samples: " 
+	  throw cet::exception("FDHDDAQWriter") << "raw digits have different numbers of samples: "
 						     << nSamples << " " <<  nSc << std::endl;
 	}
     }
-  std::vector<short> uncompressed(nSamples);
 
+  std::vector<int> apalist;
+  for (size_t iapa = 0; iapa < apahasdigits.size(); ++iapa)
+    {
+      if (apahasdigits[iapa]) apalist.push_back(iapa);
+    }
+  rec->apas.resize(apalist.size());
+
+  // the APAs are independent; only the HDF5 calls, made later by writeRecord, are serialized
+
+  const dune::FDHDChannelMapService &cmap = *channelMap;
+  uint64_t firstTimestamp = 0;
+  if (fTimeSlice)
+    {
+      // the frames of consecutive events continue the same clock
+      firstTimestamp = fSliceTimestamp;
+      fSliceTimestamp += 25*nSamples;
+    }
+  std::vector<char> clipped(apalist.size(), 0);
+  if (!fParallelGenerate)
+    {
+      for (size_t iapa = 0; iapa < apalist.size(); ++iapa)
+        {
+          clipped[iapa] = makeAPA(apalist[iapa], rdindex, nSamples, cmap, runno, evtno, tpcgname, firstTimestamp, rec->apas[iapa]);
+        }
+    }
+  else
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, apalist.size()),
+                        [&](const tbb::blocked_range<size_t> &range)
+                        {
+                          for (size_t iapa = range.begin(); iapa != range.end(); ++iapa)
+                            {
+                              clipped[iapa] = makeAPA(apalist[iapa], rdindex, nSamples, cmap, runno, evtno, tpcgname, firstTimestamp, rec->apas[iapa]);
+                            }
+                        });
+    }
+
+  bool anyClipped = false;   // warn just once per event
+  for (size_t iapa = 0; iapa < apalist.size(); ++iapa)
+    {
+      for (auto const& plink : rec->apas[iapa].links) fBytesWritten += plink.frag->get_size();
+      if (clipped[iapa]) anyClipped = true;
+    }
+  if (anyClipped)
+    {
+      MF_LOG_WARNING("FDHDDAQWriter_module") << "Negative ADC value in raw::RawDigit.  Setting to zero to put in WIB frame\n";
+    }
+
+  // make our own trigger record header
+
+  rec->trhinfo.runNum = runno;
+  rec->trhinfo.trigNum = evtno;
+
+  if (!fBufferedWrite)
+    {
+      writeRecord(*rec);
+      return;
+    }
+
+  // wait for room in the queue, so at most fWriteQueueDepth records are held in memory
+
+  std::unique_lock<std::mutex> lock(fWriteMutex);
+  fWriteCond.wait(lock, [this] { return fWriteQueue.size() < fWriteQueueDepth || fWriterError; });
+  if (fWriterError)
+    {
+      lock.unlock();
+      checkWriterError();
+    }
+  fWriteQueue.push_back(std::move(rec));
+  fWriteCond.notify_all();
+}
+
+// Build the fragments of the ten links of one APA in papa.  This only reads the event,
+// the channel map and the packer, so several APAs may be built at the same time.
+// Returns true if negative ADC values had to be set to zero.
+
+bool FDHDDAQWriter::makeAPA(int apa, const std::vector<const raw::RawDigit*>& rdindex, size_t nSamples,
+                            const dune::FDHDChannelMapService& channelMap,
+                            uint32_t runno, uint32_t evtno, const std::string& tpcgname,
+                            uint64_t firstTimestamp, PendingAPA& papa) const
+{
   const uint32_t nLinks = 10;
+  bool clipped = false;
+
+  std::vector<short> uncompressed(nSamples);
+  std::vector<short> linkadcs(256*nSamples);                // channel-major ADC values of one link
+  std::vector<short> pedestaloffsets(256);                  // per WIB frame channel
+  std::vector<const raw::RawDigit*> linkdigits(256);        // per WIB frame channel, null if missing
+  std::vector<unsigned int> linkoffl;                       // offline channels of the link
+  std::vector<unsigned int> linkplanes;                     // and their planes
+
+  std::string agname = tpcgname + "/APA";
+  appendZeroPadded(agname, apa, 3);
+  papa.name = agname;
+  papa.links.reserve(nLinks);
+  const std::vector<std::string>& lgnames = linkNames(nLinks);
+
+  uint32_t first_chan_on_apa = 2560*apa;
+  uint32_t crate = channelMap.GetCrateFromOfflChan(first_chan_on_apa);
+  if (crate == dune::FDHDChannelMapSP::InvalidChannel)
+    {
+      throw cet::exception("FDHDDAQWriter") << "APA " << apa << " is not in the crate map" << std::endl;
+    }
 
+  // loop over HDF5 groupname links (not the link in the WIB frame)
+  // the HDF5 groupname links were defined by the DAQ consortium and the ones in the WIB
+  // frame were defined by the electronics consortium.
   // DAQ consortium link goes from 0 to 9, and is used to name the datasets in the HDF5 file
   // two links per WIB, two FEMBs per link
   // electronics consortium link names in the WIB frame header are 0 or 1.
 
-  int curapa = -1;
-  hid_t agrp = H5I_INVALID_HID;
-
-  for (auto const &dmp : rdmap)
+  for (size_t ilink=0; ilink<nLinks; ++ilink)
     {
-      uint32_t channo = dmp.first;
-
-      if (curapa == -1 || (int) channo > (curapa+1)*2560 - 1)
-	{
-	  curapa = channo / 2560;
-
-          std::string agname = tpcgname + "/APA";
-          std::ostringstream ofm2;
-          ofm2 << std::internal << std::setfill('0') << std::setw(3) << curapa;
-          agname += ofm2.str();
-	  if (agrp != H5I_INVALID_HID)
-	    {
-	      H5Gclose(agrp);
-	    }
-          agrp = H5Gcreate(fFilePtr,agname.c_str(),gpl,H5P_DEFAULT,H5P_DEFAULT);
- 
-	  uint32_t first_chan_on_apa = 2560*curapa;
-          auto cinfofca = channelMap->GetChanInfoFromOfflChan(first_chan_on_apa);
-
-	  // loop over HDF5 groupname links (not the link in the WIB frame)
-	  // the HDF5 groupname links were defined by the DAQ consortium and the ones in the WIB
-	  // frame were defined by the electronics consortium.
-
-          for (size_t ilink=0; ilink<nLinks; ++ilink)
+      const std::string& lgname = lgnames[ilink];
+
+      uint32_t wib = ilink/2 + 1;  // runs from 1 to 5
+      uint32_t slot = wib + 7;     // 7 = 8 - 1:  extra bit set to mimic WIB firmware (ProtoDUNE-HD)
+      uint32_t sloc = slot & 0x7;  // but use this for channel map lookup
+      uint32_t daqlink = ilink % 2;
+
+      // template frame for this link: the header and every channel at its pedestal offset.
+      // Channels that are not in the list of raw::RawDigits keep these values.
+
+      dunedaq::detdataformats::wib2::WIB2Frame tmpl{};
+      tmpl.header.version = 2;
+      tmpl.header.timestamp_2 = 0;
+      tmpl.header.crate = crate;
+      tmpl.header.slot =  slot;
+      tmpl.header.link =  daqlink;
+
+      // remap the whole link in one call
+
+      channelMap.GetOfflChansFromWIBElements(crate,sloc,daqlink,linkoffl,linkplanes);
+      bool anyDigits = false;
+      for (size_t wibframechan = 0; wibframechan < 256; ++wibframechan)
+        {
+          uint32_t offlchan = linkoffl[wibframechan];
+          pedestaloffsets[wibframechan] = (linkplanes[wibframechan] == 2) ? fCollectionPedestalOffset : fInductionPedestalOffset;
+          linkdigits[wibframechan] = (offlchan < rdindex.size()) ? rdindex[offlchan] : nullptr;
+          if (linkdigits[wibframechan] != nullptr) anyDigits = true;
+        }
+      fPacker.packFrame(pedestaloffsets.data(), &tmpl);
+
+      std::vector<dunedaq::detdataformats::wib2::WIB2Frame> frames(nSamples, tmpl);
+      for (size_t isample=0; isample<nSamples; ++isample)
+        {
+          uint64_t timestamp = firstTimestamp + 25*isample;
+          frames[isample].header.timestamp_1 = timestamp & 0xffffffff;
+          frames[isample].header.timestamp_2 = timestamp >> 32;
+        }
+
+      // fill the channel-major ADC block for the link and pack all of it at once,
+      // unless no channel of the link has a raw::RawDigit and the template is already right
+
+      if (anyDigits)
+        {
+          for (size_t wibframechan = 0; wibframechan < 256; ++wibframechan)
             {
-              std::string lgname = agname + "/Link";
-              std::ostringstream ofm3;
-              ofm3 << std::internal << std::setfill('0') << std::setw(2) << ilink;
-              lgname += ofm3.str();
-
-	      uint32_t crate = cinfofca.crate;
-	      uint32_t wib = ilink/2 + 1;  // runs from 1 to 5
-	      uint32_t slot = wib + 7;     // 7 = 8 - 1:  extra bit set to mimic WIB firmware (ProtoDUNE-HD)
-	      uint32_t sloc = slot & 0x7;  // but use this for channel map lookup
-	      uint32_t daqlink = ilink % 2;
-
-              std::vector<dunedaq::detdataformats::wib2::WIB2Frame> frames(nSamples);
-	      for (size_t isample=0; isample<nSamples; ++isample)
-		{
-		  frames.at(isample).header.version = 2;
-		  frames.at(isample).header.timestamp_2 = 0;  
-		  frames.at(isample).header.timestamp_1 = 25*isample;
-		  frames.at(isample).header.crate = crate;
-		  frames.at(isample).header.slot =  slot;  
-		  frames.at(isample).header.link =  daqlink;
-		}
-
-	      for (size_t wibframechan = 0; wibframechan < 256; ++wibframechan)
-		{
-	          auto cinfo2 = channelMap->GetChanInfoFromWIBElements(crate,sloc,daqlink,wibframechan);
-		  uint32_t offlchan = cinfo2.offlchan;
-		  int pedestaloffset = (cinfo2.plane == 2) ? fCollectionPedestalOffset : fInductionPedestalOffset;
-
-		  auto rdmi = rdmap.find(offlchan);
-		  if (rdmi == rdmap.end())  // channel not list of raw::RawDigits.  Fill ADC values with pedestal offset + 0
-		    {
-		      for (size_t isample=0; isample<nSamples; ++isample)
-			{
-			  frames.at(isample).set_adc(wibframechan,pedestaloffset);
-			}
-		    }
-		  else
-		    {
-                      int pedestal = (int) (RawDigits[rdmi->second].GetPedestal() + 0.5);  // nearest integer
-                      raw::Uncompress(RawDigits[rdmi->second].ADCs(), uncompressed, pedestal, RawDigits[rdmi->second].Compression());
-		      for (size_t isample=0; isample<nSamples; ++isample)
-			{
-			  auto adc = uncompressed.at(isample) + pedestaloffset;
-			  if (adc < 0)
-			    {
-			      adc = 0;
-			      if (!warnedNegative)
-				{
-				  MF_LOG_WARNING("FDHDDAQWriter_module") << "Negative ADC value in raw::RawDigit.  Setting to zero to put in WIB frame\n";
-				  warnedNegative = true;
-				}
-			    }
-			  frames.at(isample).set_adc(wibframechan,adc);
-			}		      
-		    }
-		}
-
-              dunedaq::daqdataformats::Fragment frag(&frames[0],frames.size()*sizeof(dunedaq::detdataformats::wib2::WIB2Frame));
-	      frag.set_run_number(runno);
-	      frag.set_trigger_number(evtno);
-	      frag.set_trigger_timestamp(0);
-
-              hid_t linkspl = H5Pcreate(H5P_LINK_CREATE);
-              H5Pset_char_encoding(linkspl,H5T_CSET_UTF8);
-              hsize_t linkdims[2];
-              linkdims[0] = frag.get_size();
-              linkdims[1] = 1;
-	      fBytesWritten += frag.get_size();
-              //std::cout << "frag size: " << linkdims[0] << std::endl;
-              hid_t linkspace = H5Screate_simple(2,linkdims,NULL);
-              hid_t linkdset = H5Dcreate2(agrp,lgname.c_str(),H5T_STD_I8LE,linkspace,linkspl,H5P_DEFAULT,H5P_DEFAULT);
-              H5Dwrite(linkdset,H5T_STD_I8LE,H5S_ALL,H5S_ALL,H5P_DEFAULT,frag.get_storage_location());
-              H5Dclose(linkdset);
-              H5Pclose(linkspl);
-              H5Sclose(linkspace);
+              short *chanadcs = linkadcs.data() + wibframechan*nSamples;
+              short pedestaloffset = pedestaloffsets[wibframechan];
+              const raw::RawDigit *rd = linkdigits[wibframechan];
+              if (rd == nullptr)
+                {
+                  std::fill(chanadcs, chanadcs + nSamples, pedestaloffset);
+                  continue;
+                }
+              int pedestal = (int) (rd->GetPedestal() + 0.5);  // nearest integer
+              raw::Uncompress(rd->ADCs(), uncompressed, pedestal, rd->Compression());
+              for (size_t isample=0; isample<nSamples; ++isample)
+                {
+                  int adc = uncompressed[isample] + pedestaloffset;
+                  if (adc < 0)
+                    {
+                      adc = 0;
+                      clipped = true;
+                    }
+                  chanadcs[isample] = adc;
+                }
             }
-	}
+          fPacker.pack(linkadcs.data(), nSamples, frames.data());
+        }
+
+      auto frag = std::make_unique<dunedaq::daqdataformats::Fragment>(&frames[0],frames.size()*sizeof(dunedaq::detdataformats::wib2::WIB2Frame));
+      frag->set_run_number(runno);
+      frag->set_trigger_number(evtno);
+      frag->set_trigger_timestamp(0);
+      papa.links.push_back(PendingLink{lgname, std::move(frag)});
+    }
+  return clipped;
+}
+
+void FDHDDAQWriter::writeRecord(const PendingRecord& rec)
+{
+  if (fTimeSlice)
+    {
+      appendTimeSlice(rec);
+      return;
     }
-  // close the last APA group
-  if (agrp != H5I_INVALID_HID)
+  hid_t trg = H5Gcreate(fFilePtr,rec.trgname.c_str(),fLinkCreatePL,H5P_DEFAULT,H5P_DEFAULT);
+  hid_t tpcg = H5Gcreate(fFilePtr,rec.tpcgname.c_str(),fLinkCreatePL,H5P_DEFAULT,H5P_DEFAULT);
+  if (trg < 0 || tpcg < 0)
     {
+      throw cet::exception("FDHDDAQWriter") << "failed to create trigger record group " << rec.trgname << std::endl;
+    }
+  for (auto const& papa : rec.apas)
+    {
+      hid_t agrp = H5Gcreate(fFilePtr,papa.name.c_str(),fLinkCreatePL,H5P_DEFAULT,H5P_DEFAULT);
+      for (auto const& plink : papa.links)
+        {
+          writeDataset(agrp, plink.name, plink.frag->get_storage_location(), plink.frag->get_size(),
+                       getFragmentCreatePL(plink.frag->get_size()));
+        }
       H5Gclose(agrp);
     }
   H5Gclose(tpcg);
+  writeDataset(trg, "TriggerRecordHeader", &rec.trhinfo, sizeof(rec.trhinfo), H5P_DEFAULT);
+  H5Gclose(trg);
+}
 
-  // make our own trigger record header
+// Append the frames of one event to the TimeSlice.  The groups and the link datasets are
+// created with the first event; later events only extend the datasets, so the file holds
+// one dataset per link for the whole run instead of one per link and event.
+
+void FDHDDAQWriter::appendTimeSlice(const PendingRecord& rec)
+{
+  bool first = fSliceDatasets.empty();
+  hid_t trg = H5I_INVALID_HID;
+  hid_t tpcg = H5I_INVALID_HID;
+  if (first)
+    {
+      trg = H5Gcreate(fFilePtr,rec.trgname.c_str(),fLinkCreatePL,H5P_DEFAULT,H5P_DEFAULT);
+      tpcg = H5Gcreate(fFilePtr,rec.tpcgname.c_str(),fLinkCreatePL,H5P_DEFAULT,H5P_DEFAULT);
+      if (trg < 0 || tpcg < 0)
+        {
+          throw cet::exception("FDHDDAQWriter") << "failed to create time slice group " << rec.trgname << std::endl;
+        }
+    }
+  for (auto const& papa : rec.apas)
+    {
+      hid_t agrp = H5I_INVALID_HID;
+      for (auto const& plink : papa.links)
+        {
+          std::string path = papa.name + "/" + plink.name;
+          if (fSliceDatasets.count(path) == 0 && agrp == H5I_INVALID_HID)
+            {
+              htri_t exists = H5Lexists(fFilePtr,papa.name.c_str(),H5P_DEFAULT);
+              agrp = exists > 0 ? H5Gopen(fFilePtr,papa.name.c_str(),H5P_DEFAULT)
+                                : H5Gcreate(fFilePtr,papa.name.c_str(),fLinkCreatePL,H5P_DEFAULT,H5P_DEFAULT);
+            }
+          appendSliceDataset(agrp, path, plink);
+        }
+      if (agrp != H5I_INVALID_HID) H5Gclose(agrp);
+    }
+  if (first)
+    {
+      H5Gclose(tpcg);
+      H5Gclose(trg);
+    }
+}
 
-  dune::HDF5Utils::HeaderInfo trhinfo;
-  trhinfo.runNum = runno;
-  trhinfo.trigNum = evtno;
+// Create the link dataset with the whole fragment, or extend it by the frames of the
+// fragment, leaving out its header.
 
-  hid_t dspl = H5Pcreate(H5P_LINK_CREATE);
-  H5Pset_char_encoding(dspl,H5T_CSET_UTF8);
+void FDHDDAQWriter::appendSliceDataset(hid_t grp, const std::string& path, const PendingLink& plink)
+{
+  const char* data = static_cast<const char*>(plink.frag->get_storage_location());
+  hsize_t size = plink.frag->get_size();
+  auto ids = fSliceDatasets.find(path);
+  if (ids == fSliceDatasets.end())
+    {
+      hsize_t dims[2] = {size, 1};
+      hsize_t maxdims[2] = {H5S_UNLIMITED, 1};
+      hid_t space = H5Screate_simple(2,dims,maxdims);
+      hid_t dset = H5Dcreate2(grp,plink.name.c_str(),H5T_STD_I8LE,space,fLinkCreatePL,getSliceCreatePL(),H5P_DEFAULT);
+      H5Sclose(space);
+      if (dset < 0 || H5Dwrite(dset,H5T_STD_I8LE,H5S_ALL,H5S_ALL,H5P_DEFAULT,data) < 0)
+        {
+          if (dset >= 0) H5Dclose(dset);
+          throw cet::exception("FDHDDAQWriter") << "failed to write dataset " << path << std::endl;
+        }
+      SliceDataset& sds = fSliceDatasets[path];
+      sds.dset = dset;
+      sds.size = size;
+      std::memcpy(&sds.header, data, sizeof(sds.header));
+      return;
+    }
+
+  SliceDataset& sds = ids->second;
+  hsize_t hdrSize = sizeof(dunedaq::daqdataformats::FragmentHeader);
+  if (size <= hdrSize) return;
+  hsize_t count[2] = {size - hdrSize, 1};
+  hsize_t start[2] = {sds.size, 0};
+  hsize_t dims[2] = {sds.size + count[0], 1};
+  herr_t status = H5Dset_extent(sds.dset,dims);
+  hid_t filespace = status >= 0 ? H5Dget_space(sds.dset) : H5I_INVALID_HID;
+  hid_t memspace = H5Screate_simple(2,count,NULL);
+  if (filespace >= 0)
+    {
+      status = H5Sselect_hyperslab(filespace,H5S_SELECT_SET,start,NULL,count,NULL);
+      if (status >= 0) status = H5Dwrite(sds.dset,H5T_STD_I8LE,memspace,filespace,H5P_DEFAULT,data + hdrSize);
+      H5Sclose(filespace);
+    }
+  H5Sclose(memspace);
+  if (filespace < 0 || status < 0)
+    {
+      throw cet::exception("FDHDDAQWriter") << "failed to extend dataset " << path << std::endl;
+    }
+  sds.size = dims[0];
+}
+
+// Bring the fragment headers up to date with the final sizes and close the datasets, then
+// write the slice header.
+
+void FDHDDAQWriter::closeTimeSlice()
+{
+  for (auto& ids : fSliceDatasets)
+    {
+      SliceDataset& sds = ids.second;
+      sds.header.size = sds.size;
+      hsize_t count[2] = {sizeof(sds.header), 1};
+      hsize_t start[2] = {0, 0};
+      hid_t filespace = H5Dget_space(sds.dset);
+      hid_t memspace = H5Screate_simple(2,count,NULL);
+      H5Sselect_hyperslab(filespace,H5S_SELECT_SET,start,NULL,count,NULL);
+      herr_t status = H5Dwrite(sds.dset,H5T_STD_I8LE,memspace,filespace,H5P_DEFAULT,&sds.header);
+      H5Sclose(memspace);
+      H5Sclose(filespace);
+      H5Dclose(sds.dset);
+      if (status < 0)
+        {
+          throw cet::exception("FDHDDAQWriter") << "failed to update the fragment header of " << ids.first << std::endl;
+        }
+    }
+  if (!fSliceDatasets.empty())
+    {
+      hid_t trg = H5Gopen(fFilePtr,fSliceName.c_str(),H5P_DEFAULT);
+      writeDataset(trg, "TimeSliceHeader", &fSliceHeaderInfo, sizeof(fSliceHeaderInfo), H5P_DEFAULT);
+      H5Gclose(trg);
+    }
+  fSliceDatasets.clear();
+  fSliceName.clear();
+  fSliceTimestamp = 0;
+}
+
+// Extendable datasets must be chunked.  The chunk size is ChunkBytes or, without it, 1 MiB,
+// about ten events of a link with 6000-tick readouts; the filters are applied as for the
+// TriggerRecord datasets.
+
+hid_t FDHDDAQWriter::getSliceCreatePL()
+{
+  if (fSliceCreatePL != H5I_INVALID_HID) return fSliceCreatePL;
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  hsize_t chunk[2];
+  chunk[0] = fChunkBytes == 0 ? 1048576 : fChunkBytes;
+  chunk[1] = 1;
+  herr_t status = H5Pset_chunk(dcpl,2,chunk);
+  if (status >= 0 && fFilterID != 0)
+    {
+      status = H5Pset_filter(dcpl,fFilterID,H5Z_FLAG_MANDATORY,fFilterParams.size(),fFilterParams.data());
+    }
+  if (status >= 0 && fDeflateLevel != 0)
+    {
+      status = H5Pset_deflate(dcpl,fDeflateLevel);
+    }
+  if (status < 0)
+    {
+      H5Pclose(dcpl);
+      throw cet::exception("FDHDDAQWriter") << "failed to set up chunking for the time slice datasets" << std::endl;
+    }
+  fSliceCreatePL = dcpl;
+  return dcpl;
+}
+
+void FDHDDAQWriter::writeDataset(hid_t grp, const std::string& name, const void* data, hsize_t size, hid_t dcpl)
+{
+  hid_t dset = H5Dcreate2(grp,name.c_str(),H5T_STD_I8LE,getDataspace(size),fLinkCreatePL,dcpl,H5P_DEFAULT);
+  if (dset < 0 || H5Dwrite(dset,H5T_STD_I8LE,H5S_ALL,H5S_ALL,H5P_DEFAULT,data) < 0)
+    {
+      if (dset >= 0) H5Dclose(dset);
+      throw cet::exception("FDHDDAQWriter") << "failed to write dataset " << name << std::endl;
+    }
+  H5Dclose(dset);
+}
+
+// datasets are 2D, size x 1, as in the DAQ files.  The fragments of one geometry all have
+// the same size, so in practice there are only two or three dataspaces per file.
+
+hid_t FDHDDAQWriter::getDataspace(hsize_t size)
+{
+  auto ids = fDataspaces.find(size);
+  if (ids != fDataspaces.end()) return ids->second;
   hsize_t dims[2];
-  //dims[0] = trHeader.get_total_size_bytes();
-  dims[0] = sizeof(trhinfo);
+  dims[0] = size;
   dims[1] = 1;
-  //std::cout << "trheader size: " << dims[0] << std::endl;
-  hid_t trhspace = H5Screate_simple(2,dims,NULL);
-  hid_t trdset = H5Dcreate2(trg,"TriggerRecordHeader",H5T_STD_I8LE,trhspace,dspl,H5P_DEFAULT,H5P_DEFAULT);
-  H5Dwrite(trdset,H5T_STD_I8LE,H5S_ALL,H5S_ALL,H5P_DEFAULT,&trhinfo);
-  H5Dclose(trdset);
-  H5Pclose(dspl);
-  H5Sclose(trhspace);
-  H5Gclose(trg);
+  hid_t space = H5Screate_simple(2,dims,NULL);
+  fDataspaces[size] = space;
+  return space;
+}
+
+// Creation properties of the fragment datasets: default (contiguous) unless chunking or a
+// filter was requested.  Filters need a chunked layout, so without ChunkBytes the whole
+// dataset is one chunk, which suits readers that always read complete fragments.
+// The chunk dimensions depend on the dataset size, so the lists are cached by size.
+
+hid_t FDHDDAQWriter::getFragmentCreatePL(hsize_t size)
+{
+  if (fChunkBytes == 0 && fDeflateLevel == 0 && fFilterID == 0) return H5P_DEFAULT;
+  auto ipl = fCreatePLs.find(size);
+  if (ipl != fCreatePLs.end()) return ipl->second;
+
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  hsize_t chunk[2];
+  chunk[0] = (fChunkBytes == 0 || fChunkBytes > size) ? size : fChunkBytes;
+  chunk[1] = 1;
+  herr_t status = H5Pset_chunk(dcpl,2,chunk);
+  if (status >= 0 && fFilterID != 0)
+    {
+      status = H5Pset_filter(dcpl,fFilterID,H5Z_FLAG_MANDATORY,fFilterParams.size(),fFilterParams.data());
+    }
+  if (status >= 0 && fDeflateLevel != 0)
+    {
+      status = H5Pset_deflate(dcpl,fDeflateLevel);
+    }
+  if (status < 0)
+    {
+      H5Pclose(dcpl);
+      throw cet::exception("FDHDDAQWriter") << "failed to set up chunking and filters for datasets of size " << size << std::endl;
+    }
+  fCreatePLs[size] = dcpl;
+  return dcpl;
+}
+
+// make sure the requested filters can be used before anything is written
+
+void FDHDDAQWriter::checkFilters() const
+{
+  if (fDeflateLevel != 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+    {
+      throw cet::exception("FDHDDAQWriter") << "deflate filter is not available in this HDF5 library" << std::endl;
+    }
+  if (fFilterID != 0 && H5Zfilter_avail(fFilterID) <= 0)
+    {
+      throw cet::exception("FDHDDAQWriter") << "HDF5 filter " << fFilterID
+                                            << " is not available; check HDF5_PLUGIN_PATH" << std::endl;
+    }
+}
+
+void FDHDDAQWriter::startWriter()
+{
+  fStopWriter = false;
+  fWriterError = nullptr;
+  fWriterThread = std::thread(&FDHDDAQWriter::writerLoop, this);
+}
+
+// writes out whatever is still queued, then returns
+
+void FDHDDAQWriter::stopWriter()
+{
+  if (!fWriterThread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(fWriteMutex);
+    fStopWriter = true;
+  }
+  fWriteCond.notify_all();
+  fWriterThread.join();
+}
+
+void FDHDDAQWriter::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(fWriteMutex);
+  while (true)
+    {
+      fWriteCond.wait(lock, [this] { return fStopWriter || !fWriteQueue.empty(); });
+      if (fWriteQueue.empty()) return;   // stop requested and nothing left
+      std::unique_ptr<PendingRecord> rec = std::move(fWriteQueue.front());
+      lock.unlock();
+      try
+        {
+          writeRecord(*rec);
+        }
+      catch (...)
+        {
+          lock.lock();
+          fWriterError = std::current_exception();
+          fWriteQueue.clear();
+          fWriteCond.notify_all();
+          return;
+        }
+      rec.reset();
+      lock.lock();
+      fWriteQueue.pop_front();
+      fWriteCond.notify_all();
+    }
+}
+
+// rethrow on the art thread an exception raised while writing in the background
+
+void FDHDDAQWriter::checkWriterError()
+{
+  std::exception_ptr err;
+  {
+    std::lock_guard<std::mutex> lock(fWriteMutex);
+    std::swap(err, fWriterError);
+  }
+  if (err) std::rethrow_exception(err);
 }
 
 void FDHDDAQWriter::beginRun(art::Run const& run)
@@ -274,6 +809,8 @@ void FDHDDAQWriter::beginRun(art::Run const& run)
   auto runno = run.run();
   //auto subrun = run.subRun();
 
+  checkFilters();
+
   // to think about -- do we want to append the run number to the output file name in case we
   // have more than one than one run number?  DAQ-formatted files cannot support more than one
   // run number.
@@ -294,20 +831,50 @@ void FDHDDAQWriter::beginRun(art::Run const& run)
 
   // from a coldbox data file
 
-  addStringAttribute(fFilePtr,"filelayout_params","{\"digits_for_record_number\":5,\"digits_for_sequence_number\":4,\"path_param_list\":[{\"detector_group_name\":\"TPC\",\"detector_group_type\":\"TPC\",\"digits_for_element_number\":2,\"digits_for_region_number\":3,\"element_name_prefix\":\"Link\",\"region_name_prefix\":\"APA\"},{\"detector_group_name\":\"PDS\",\"detector_group_type\":\"PDS\",\"digits_for_element_number\":2,\"digits_for_region_number\":3,\"element_name_prefix\":\"Element\",\"region_name_prefix\":\"Region\"},{\"detector_group_name\":\"NDLArTPC\",\"detector_group_type\":\"NDLArTPC\",\"digits_for_element_number\":2,\"digits_for_region_number\":3,\"element_name_prefix\":\"Element\",\"region_name_prefix\":\"Region\"},{\"detector_group_name\":\"Trigger\",\"detector_group_type\":\"DataSelection\",\"digits_for_element_number\":2,\"digits_for_region_number\":3,\"element_name_prefix\":\"Element\",\"region_name_prefix\":\"Region\"}],\"record_header_dataset_name\":\"TriggerRecordHeader\",\"record_name_prefix\":\"TriggerRecord\"}");
+  std::string layout = "{\"digits_for_record_number\":5,\"digits_for_sequence_number\":4,\"path_param_list\":[{\"detector_group_name\":\"TPC\",\"detector_group_type\":\"TPC\",\"digits_for_element_number\":2,\"digits_for_region_number\":3,\"element_name_prefix\":\"Link\",\"region_name_prefix\":\"APA\"},{\"detector_group_name\":\"PDS\",\"detector_group_type\":\"PDS\",\"digits_for_element_number\":2,\"digits_for_region_number\":3,\"element_name_prefix\":\"Element\",\"region_name_prefix\":\"Region\"},{\"detector_group_name\":\"NDLArTPC\",\"detector_group_type\":\"NDLArTPC\",\"digits_for_element_number\":2,\"digits_for_region_number\":3,\"element_name_prefix\":\"Element\",\"region_name_prefix\":\"Region\"},{\"detector_group_name\":\"Trigger\",\"detector_group_type\":\"DataSelection\",\"digits_for_element_number\":2,\"digits_for_region_number\":3,\"element_name_prefix\":\"Element\",\"region_name_prefix\":\"Region\"}],\"record_header_dataset_name\":\"TriggerRecordHeader\",\"record_name_prefix\":\"TriggerRecord\"}";
+
+  if (fTimeSlice)
+    {
+      // TimeSlice records have no sequence number
+      auto replace = [&layout](const std::string& from, const std::string& to)
+        {
+          size_t pos = layout.find(from);
+          if (pos != std::string::npos) layout.replace(pos, from.size(), to);
+        };
+      replace("\"digits_for_sequence_number\":4", "\"digits_for_sequence_number\":0");
+      replace("\"record_header_dataset_name\":\"TriggerRecordHeader\"", "\"record_header_dataset_name\":\"TimeSliceHeader\"");
+      replace("\"record_name_prefix\":\"TriggerRecord\"", "\"record_name_prefix\":\"TimeSlice\"");
+    }
+  addStringAttribute(fFilePtr,"filelayout_params",layout);
 
   addU32Attribute(fFilePtr,"filelayout_version",2);
   addStringAttribute(fFilePtr,"operational_environment","np04_coldbox");
-  addStringAttribute(fFilePtr,"record_type","TriggerRecord");
+  addStringAttribute(fFilePtr,"record_type",fTimeSlice ? "TimeSlice" : "TriggerRecord");
   addU32Attribute(fFilePtr,"run_number",runno);
 
+  fLinkCreatePL = H5Pcreate(H5P_LINK_CREATE);
+  H5Pset_char_encoding(fLinkCreatePL,H5T_CSET_UTF8);
+
   fBytesWritten = 0;  // does this include the attributes and group names and such?  For now,
                       // just add up the data sizes.
 
+  if (fBufferedWrite) startWriter();
 }
 
 void FDHDDAQWriter::endRun(art::Run const& run)
 {
+  stopWriter();
+  closeTimeSlice();
+  if (fSliceCreatePL != H5I_INVALID_HID) H5Pclose(fSliceCreatePL);
+  fSliceCreatePL = H5I_INVALID_HID;
+  for (auto const& ids : fDataspaces) H5Sclose(ids.second);
+  fDataspaces.clear();
+  for (auto const& ipl : fCreatePLs) H5Pclose(ipl.second);
+  fCreatePLs.clear();
+  if (fLinkCreatePL != H5I_INVALID_HID) H5Pclose(fLinkCreatePL);
+  fLinkCreatePL = H5I_INVALID_HID;
+  checkWriterError();
+
   addU64Attribute(fFilePtr,"recorded_size",fBytesWritten);
   H5Fclose(fFilePtr);
   fFilePtr = H5I_INVALID_HID;
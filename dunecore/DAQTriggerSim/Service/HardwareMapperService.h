@@ -63,6 +63,18 @@ class HardwareMapperService{
   std::set<raw::ChannelID_t> const& getTPCChannelsSet(Hardware::ID tpc_id);
   std::set<raw::ChannelID_t> const& getAPAChannelsSet(Hardware::ID apa_id);
 
+  //Dense tables: channel -> element index and contiguous channel lists per element.
+  //These are built once in fillHardwareMaps and are the fast path for trigger algorithms
+  //that aggregate by hardware element.
+  Hardware::DenseMap const& getDenseASICMap() const { return fDenseASICMap; }
+  Hardware::DenseMap const& getDenseBoardMap() const { return fDenseBoardMap; }
+  Hardware::DenseMap const& getDenseTPCMap() const { return fDenseTPCMap; }
+  Hardware::DenseMap const& getDenseAPAMap() const { return fDenseAPAMap; }
+
+  //IDs of all the TPCs and APAs, e.g. to set up per-element trigger counters
+  std::vector<Hardware::HardwareID> getTPCIDs() const;
+  std::vector<Hardware::HardwareID> getAPAIDs() const;
+
   //jpd -- We register this such that it gets called just before we process a new run
   //    -- It double checks that the geometry we filled with is the same as that used 
   //    -- to produce this run
@@ -86,11 +98,17 @@ class HardwareMapperService{
   void fillTPCMap();
   void fillAPAMap();
   void fillHardwareMaps();
+  void fillDenseMaps();
 
   Hardware::ASICMap fASICMap;
   Hardware::BoardMap fBoardMap;
   Hardware::TPCMap fTPCMap;
   Hardware::APAMap fAPAMap;
+
+  Hardware::DenseMap fDenseASICMap;
+  Hardware::DenseMap fDenseBoardMap;
+  Hardware::DenseMap fDenseTPCMap;
+  Hardware::DenseMap fDenseAPAMap;
 };
 
 //......................................................
@@ -380,6 +380,7 @@ void HardwareMapperService::fillHardwareMaps(){
   fillAPAMap();
   fillBoardMap();
   fillASICMap();
+  fillDenseMaps();
   
   mf::LogInfo loginfo(fServiceName);
   loginfo << "Number of TPCs:   " << getNTPCs() << "\n"
@@ -389,6 +390,17 @@ void HardwareMapperService::fillHardwareMaps(){
 
 }
 
+//......................................................
+void HardwareMapperService::fillDenseMaps(){
+  const std::string func_name = "fillDenseMaps";
+  if(fLogLevel>1) mf::LogInfo(fServiceName) << "In Function: " << func_name;
+  unsigned int Nchannels = fGeometryService->Nchannels();
+  fDenseASICMap.fill(fASICMap, Nchannels);
+  fDenseBoardMap.fill(fBoardMap, Nchannels);
+  fDenseTPCMap.fill(fTPCMap, Nchannels);
+  fDenseAPAMap.fill(fAPAMap, Nchannels);
+}
+
 //......................................................
 void HardwareMapperService::printASICMap(unsigned int num_asics_to_print){
   const std::string func_name = "printASICMap";
@@ -604,5 +616,21 @@ std::set<raw::ChannelID_t> const& HardwareMapperService::getAPAChannelsSet(Hardw
   return this_apa->getChannelsSet();  
 }
 
+//......................................................
+std::vector<Hardware::HardwareID> HardwareMapperService::getTPCIDs() const{
+  std::vector<Hardware::HardwareID> ids;
+  ids.reserve(fTPCMap.size());
+  for(auto const& this_pair : fTPCMap) ids.push_back(*this_pair.second);
+  return ids;
+}
+
+//......................................................
+std::vector<Hardware::HardwareID> HardwareMapperService::getAPAIDs() const{
+  std::vector<Hardware::HardwareID> ids;
+  ids.reserve(fAPAMap.size());
+  for(auto const& this_pair : fAPAMap) ids.push_back(*this_pair.second);
+  return ids;
+}
+
 //......................................................
 DEFINE_ART_SERVICE(HardwareMapperService)
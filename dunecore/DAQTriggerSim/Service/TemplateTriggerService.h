@@ -46,6 +46,13 @@ class TemplateTriggerService : public BaseTriggerService {
   //         sees fit...
   virtual bool TPCTrigger(std::vector<raw::RawDigit> const & raw);
 
+  // Make a trigger decision based on TPC trigger primitives only.
+  //
+  //   params:
+  //   tps - A vector of trigger primitives, to be sliced and diced as the trigger algorithm
+  //         sees fit...
+  virtual bool TPTrigger(std::vector<triggersim::TriggerPrimitive> const & tps);
+
   virtual std::string GetName(){ return "TemplateTriggerService";}
 
  private:
@@ -77,4 +77,27 @@ bool TemplateTriggerService::TPCTrigger(std::vector<raw::RawDigit> const & raw)
 
 
 
+//.....................................................................
+bool TemplateTriggerService::TPTrigger(std::vector<triggersim::TriggerPrimitive> const & tps)
+{
+
+  //
+  // Into this function will go the guts of a trigger algorithm that uses TPC trigger primitives.
+  //
+
+  float sumADC = 0.0;
+  for (const triggersim::TriggerPrimitive& tp : tps) sumADC += tp.ADCIntegral();
+
+  std::cout << "\n\nIn the TPTrigger function... "
+	    << "\n\nSize of trigger primitive vector = " << tps.size()
+	    << "\nSummed ADC integral = " << sumADC
+	    << "\n\n\n";
+
+  fIndex++;
+
+  return false;
+}
+
+
+
 DEFINE_ART_SERVICE_INTERFACE_IMPL(TemplateTriggerService, BaseTriggerService)
@@ -25,6 +25,9 @@
 
 // C++ includes
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 //----------------------------------------------------------------------
 //------------- The constructor for this trigger algorithm -------------
@@ -39,12 +42,30 @@ void triggersim::ActivityTrigger::Configure( fhicl::ParameterSet const& pset ) {
   fMyString    = pset.get<std::string> ("AString");
   fRawDigLabel = pset.get<std::string> ("RawDigitLabel");
   fOpWaveLabel = pset.get<std::string> ("OpDetWaveLabel");
+  fADCThreshold      = pset.get<float>        ("ADCThreshold", 30.0);
+  fMinActiveChannels = pset.get<unsigned int> ("MinActiveChannels", 0);
+  fWindowTicks       = pset.get<unsigned int> ("WindowTicks", 0);
+  fWindowStep        = pset.get<unsigned int> ("WindowStep", 0);
+  fPDThreshold         = pset.get<float>        ("PDThreshold", 20.0);
+  fPDBaselineSamples   = pset.get<unsigned int> ("PDBaselineSamples", 20);
+  fPDTickPeriod        = pset.get<double>       ("PDTickPeriod", 0.016);
+  fPDCoincidenceWindow = pset.get<double>       ("PDCoincidenceWindow", 0.5);
+  fPDMinChannels       = pset.get<unsigned int> ("PDMinChannels", 0);
 
   // --- We have got all of the fcl parameters here too, lets check that they are what we expect...
   std::cout << "\n------In my trigger class------\nThe fcl params have been set to :" 
 	    << "\n  fMyString:    " << fMyString 
 	    << "\n  fRawDigLabel: " << fRawDigLabel
 	    << "\n  fOpWaveLabel: " << fOpWaveLabel
+	    << "\n  fADCThreshold:      " << fADCThreshold
+	    << "\n  fMinActiveChannels: " << fMinActiveChannels
+	    << "\n  fWindowTicks:       " << fWindowTicks
+	    << "\n  fWindowStep:        " << fWindowStep
+	    << "\n  fPDThreshold:         " << fPDThreshold
+	    << "\n  fPDBaselineSamples:   " << fPDBaselineSamples
+	    << "\n  fPDTickPeriod:        " << fPDTickPeriod
+	    << "\n  fPDCoincidenceWindow: " << fPDCoincidenceWindow
+	    << "\n  fPDMinChannels:       " << fPDMinChannels
 	    << "\n-------------------------------\n"
 	    << std::endl;
 } // Configure
@@ -87,89 +108,281 @@ bool triggersim::ActivityTrigger::TriggerOnWholeEvent( art::Event& event ) {
 //----------------------------------------------------------------------
 //----------- The trigger algorithm on just the TPC RawDigits ----------
 //----------------------------------------------------------------------
-bool triggersim::ActivityTrigger::TriggerOnTPC( std::vector< raw::RawDigit> rawTPC ) {
+bool triggersim::ActivityTrigger::TriggerOnTPC( const std::vector< raw::RawDigit>& rawTPC ) {
+  return TriggerOnTPC(rawTPC.data(), rawTPC.size());
+} // TriggerOnTPC
+
+//----------------------------------------------------------------------
+bool triggersim::ActivityTrigger::TriggerOnTPC( const raw::RawDigit* pdigs, size_t ndig ) {
   // --- If for some reason you changed your mind about making this trigger...
   if (!fMakeTrig) return false;
 
-  // --- It is often helpful to make a geometry service handle.
-  art::ServiceHandle<geo::Geometry> geom;
-  
   // --- Now do stuff...
-  fNumber = rawTPC.size();
-  for (unsigned int Dig=0; Dig < rawTPC.size(); ++Dig) {
-    raw::RawDigit ThisDig = rawTPC[Dig]; // Can also use rawTPC.at(Dig);
-    int Chan = rawTPC[Dig].Channel();    // Alternatively can access stuff by doing rawTPC[Dig]->Channel()
-    if (Dig < 5) {
-      std::cout << "    Looking at Dig " << Dig << " of " << rawTPC.size() << ", it has " << ThisDig.Samples() << " samples on Channel " << ThisDig.Channel() << " ("<<Chan<<")" 
-		<< ", and " << ThisDig.NADC() << " ADCs with a pedestal of " << ThisDig.GetPedestal()
-		<< std::endl;
-      for (unsigned int ADCLoop=0; ADCLoop < ThisDig.NADC(); ++ADCLoop) {
-	if (ADCLoop < 5) {
-	  std::cout << "      Looking at ADC " << ADCLoop << " of " << ThisDig.NADC() << ", it was " << ThisDig.ADC(ADCLoop) << std::endl;
-	} // If ADCLoop < 5
-      } // Loop over ADCs
-    } // If Dig < 5
-
-    // --- It can be useful to select only specific types of channels, normally you just continue for one of them.
-    if (geom->SignalType(ThisDig.Channel()) == geo::kCollection) {
-      // --- Something for collection plane wires...
-    } else if (geom->SignalType(ThisDig.Channel()) == geo::kInduction) {
-      // --- Something for induction plane wires...
-    }
-
-  } // Loop over rawPD
+  fNumber = ndig;
+  for (unsigned int Dig=0; Dig < ndig && Dig < 5; ++Dig) {
+    const raw::RawDigit& ThisDig = pdigs[Dig]; // Use a reference, a copy would duplicate the ADC vector.
+    std::cout << "    Looking at Dig " << Dig << " of " << ndig << ", it has " << ThisDig.Samples() << " samples on Channel " << ThisDig.Channel()
+	      << ", and " << ThisDig.NADC() << " ADCs with a pedestal of " << ThisDig.GetPedestal()
+	      << std::endl;
+    for (unsigned int ADCLoop=0; ADCLoop < ThisDig.NADC() && ADCLoop < 5; ++ADCLoop) {
+      std::cout << "      Looking at ADC " << ADCLoop << " of " << ThisDig.NADC() << ", it was " << ThisDig.ADC(ADCLoop) << std::endl;
+    } // Loop over ADCs
+  } // Loop over the first digits
 
   std::cout << "  I have just got into my activity TPC trigger , fMakeTrig is " << fMakeTrig << ", and (size) fNumber is now " << fNumber << std::endl;
-  
-  // --- For now just trigger on how raw::RawDigits there are in this event...
-  if (fNumber > 3700) {
-    fTrigDecision = true;
+
+  if (fMinActiveChannels == 0) {
+    // --- Trigger on how many raw::RawDigits there are in this event...
+    fTrigDecision = fNumber > 3700;
   } else {
-    fTrigDecision = false;
+    // --- ...or on the number of active collection channels in any time window.
+    IndexCrossings(pdigs, ndig);
+    fTrigDecision = WindowDecision();
   }
 
   // --- Return the result of the trigger.
   return fTrigDecision;
 } // TriggerOnTPC
 
+//----------------------------------------------------------------------
+bool triggersim::ActivityTrigger::TriggerOnTPC( const std::vector<const raw::RawDigit*>& digs ) {
+  if (!fMakeTrig) return false;
+  fNumber = digs.size();
+  if (fMinActiveChannels == 0) {
+    fTrigDecision = fNumber > 3700;
+  } else {
+    IndexCrossings(digs);
+    fTrigDecision = WindowDecision();
+  }
+  return fTrigDecision;
+} // TriggerOnTPC
+
+//----------------------------------------------------------------------
+bool triggersim::ActivityTrigger::WindowDecision() {
+  unsigned int width = fWindowTicks ? fWindowTicks : fNTicks;
+  unsigned int step = fWindowStep ? fWindowStep : width;
+  unsigned int maxActive = WindowActivity(width, step, fWindowCounts);
+  fTriggerTick = 0;
+  for (unsigned int iwin=0; iwin < fWindowCounts.size(); ++iwin) {
+    if (fWindowCounts[iwin] >= fMinActiveChannels) {
+      fTriggerTick = iwin*step;
+      break;
+    }
+  }
+  return maxActive >= fMinActiveChannels;
+} // WindowDecision
+
+//----------------------------------------------------------------------
+const std::vector<char>& triggersim::ActivityTrigger::CollectionMask() {
+  if (!fCollectionMask) {
+    art::ServiceHandle<geo::Geometry> geom;
+    unsigned int nchan = geom->Nchannels();
+    auto mask = std::make_shared<std::vector<char>>(nchan, 0);
+    for (unsigned int Chan=0; Chan < nchan; ++Chan) {
+      (*mask)[Chan] = geom->SignalType(Chan) == geo::kCollection;
+    }
+    fCollectionMask = mask;
+  }
+  return *fCollectionMask;
+} // CollectionMask
+
+//----------------------------------------------------------------------
+unsigned int triggersim::ActivityTrigger::
+FindCrossings(const short* padc, unsigned int nadc, float threshold, std::vector<unsigned int>& ticks) {
+  unsigned int ncross = 0;
+  // --- An integer ADC is at or above threshold if it is at or above the rounded-up threshold.
+  float cthr = std::ceil(threshold);
+  if (!(cthr <= 32767.0)) return ncross;
+  const short ithr = cthr < -32768.0 ? -32768 : short(cthr);
+  uint64_t lastAbove = 0;   // Whether the last tick of the previous block was above
+  for (unsigned int Tick0=0; Tick0 < nadc; Tick0 += 64) {
+    unsigned int nblk = std::min(nadc - Tick0, 64u);
+    const short* pblk = padc + Tick0;
+    uint64_t above = 0;
+    for (unsigned int ibit=0; ibit < nblk; ++ibit) above |= uint64_t(pblk[ibit] >= ithr) << ibit;
+    // --- Leading edges are ticks above threshold whose previous tick is not.
+    uint64_t edges = above & ~((above << 1) | lastAbove);
+    lastAbove = (above >> (nblk - 1)) & 1;
+    while (edges) {
+      ticks.push_back(Tick0 + __builtin_ctzll(edges));
+      ++ncross;
+      edges &= edges - 1;
+    }
+  }
+  return ncross;
+} // FindCrossings
+
+//----------------------------------------------------------------------
+void triggersim::ActivityTrigger::IndexCrossings(const raw::RawDigit* pdigs, size_t ndig) {
+  CollectionMask();
+  fCrossTicks.clear();
+  fCrossBegin.clear();
+  fNTicks = 0;
+  for (size_t Dig=0; Dig < ndig; ++Dig) IndexDigit(pdigs[Dig]);
+  fCrossBegin.push_back(fCrossTicks.size());
+} // IndexCrossings
+
+//----------------------------------------------------------------------
+void triggersim::ActivityTrigger::IndexCrossings(const std::vector<const raw::RawDigit*>& digs) {
+  CollectionMask();
+  fCrossTicks.clear();
+  fCrossBegin.clear();
+  fNTicks = 0;
+  for (const raw::RawDigit* pdig : digs) if (pdig != nullptr) IndexDigit(*pdig);
+  fCrossBegin.push_back(fCrossTicks.size());
+} // IndexCrossings
+
+//----------------------------------------------------------------------
+void triggersim::ActivityTrigger::IndexDigit(const raw::RawDigit& ThisDig) {
+  raw::ChannelID_t Chan = ThisDig.Channel();
+  const std::vector<char>& mask = *fCollectionMask;
+  if (Chan >= mask.size() || !mask[Chan]) return;
+  const short* padc = ThisDig.ADCs().data();
+  unsigned int nadc = ThisDig.NADC();
+  if (ThisDig.Compression() != raw::kNone) {
+    fADCBuffer.resize(ThisDig.Samples());
+    raw::Uncompress(ThisDig.ADCs(), fADCBuffer, ThisDig.Compression());
+    padc = fADCBuffer.data();
+    nadc = fADCBuffer.size();
+  }
+  fCrossBegin.push_back(fCrossTicks.size());
+  FindCrossings(padc, nadc, ThisDig.GetPedestal() + fADCThreshold, fCrossTicks);
+  fNTicks = std::max(fNTicks, nadc);
+} // IndexDigit
+
+//----------------------------------------------------------------------
+unsigned int triggersim::ActivityTrigger::ActiveChannels(unsigned int tick0, unsigned int tick1) const {
+  unsigned int nactive = 0;
+  if (tick1 <= tick0) return nactive;
+  for (unsigned int ich=0; ich+1 < fCrossBegin.size(); ++ich) {
+    auto ibeg = fCrossTicks.begin() + fCrossBegin[ich];
+    auto iend = fCrossTicks.begin() + fCrossBegin[ich+1];
+    auto icro = std::lower_bound(ibeg, iend, tick0);
+    if (icro != iend && *icro < tick1) ++nactive;
+  }
+  return nactive;
+} // ActiveChannels
+
+//----------------------------------------------------------------------
+unsigned int triggersim::ActivityTrigger::
+WindowActivity(unsigned int width, unsigned int step, std::vector<unsigned int>& counts) const {
+  counts.clear();
+  if (width == 0 || step == 0 || fNTicks == 0) return 0;
+  unsigned int nwin = fNTicks > width ? (fNTicks - width)/step + 1 : 1;
+  // --- Each crossing at tick t activates its channel in windows [wlo, whi].
+  //     These ranges are accumulated as differences so each crossing is visited once.
+  std::vector<int> diffs(nwin + 1, 0);
+  for (unsigned int ich=0; ich+1 < fCrossBegin.size(); ++ich) {
+    unsigned int nextWin = 0;   // First window not yet counted for this channel
+    for (unsigned int icro=fCrossBegin[ich]; icro < fCrossBegin[ich+1]; ++icro) {
+      unsigned int Tick = fCrossTicks[icro];
+      unsigned int wlo = Tick < width ? 0 : (Tick - width)/step + 1;
+      unsigned int whi = std::min(Tick/step, nwin - 1);
+      wlo = std::max(wlo, nextWin);
+      if (wlo > whi) continue;
+      ++diffs[wlo];
+      --diffs[whi+1];
+      nextWin = whi + 1;
+    }
+  }
+  counts.resize(nwin);
+  int count = 0;
+  unsigned int maxCount = 0;
+  for (unsigned int iwin=0; iwin < nwin; ++iwin) {
+    count += diffs[iwin];
+    counts[iwin] = count;
+    maxCount = std::max(maxCount, counts[iwin]);
+  }
+  return maxCount;
+} // WindowActivity
+
 //----------------------------------------------------------------------
 //-- The trigger algorithm on just the Photon Detector OpDetWaveforms --
 //----------------------------------------------------------------------
-bool triggersim::ActivityTrigger::TriggerOnPD( std::vector< raw::OpDetWaveform > rawPD) {
+bool triggersim::ActivityTrigger::TriggerOnPD( const std::vector< raw::OpDetWaveform >& rawPD) {
+  return TriggerOnPD(rawPD.data(), rawPD.size());
+} // TriggerOnPD
+
+//----------------------------------------------------------------------
+bool triggersim::ActivityTrigger::TriggerOnPD( const raw::OpDetWaveform* pwfs, size_t nwf) {
   // --- If for some reason you changed your mind about making this trigger...
   if (!fMakeTrig) return false;
 
   // --- Now do stuff...
-  fNumber = rawPD.size();
-  for (unsigned int Wave=0; Wave < rawPD.size(); ++Wave) {
-    if (Wave < 5) {
-      raw::OpDetWaveform ThisWaveform = rawPD[Wave]; // Also, rawPD.at(Wave);
-      std::cout << "    Looking at Wave " << Wave << " of " << rawPD.size() << ", it was on channel " << ThisWaveform.ChannelNumber() << ", at time " << ThisWaveform.TimeStamp()
-		<< ", there are " << ThisWaveform.Waveform().size() << " ADCs in this waveform " << std::endl;
-      std::vector< short > WaveformVec = ThisWaveform.Waveform();
-      for (unsigned int WaveformLoop=0; WaveformLoop < WaveformVec.size(); ++WaveformLoop) {
-	if (WaveformLoop < 5) {
-	  std::cout << "      Element " << WaveformLoop << " of " << WaveformVec.size() << " has ADC value " << WaveformVec.at(WaveformLoop) << std::endl;
-	} // If WaveformLoop < 5
-      } // Loop over the Waveform() data member
-    } // If Wave < 5
-  } // Loop over rawPD
-  
+  fNumber = nwf;
+  for (unsigned int Wave=0; Wave < nwf && Wave < 5; ++Wave) {
+    const raw::OpDetWaveform& ThisWaveform = pwfs[Wave];
+    std::cout << "    Looking at Wave " << Wave << " of " << nwf << ", it was on channel " << ThisWaveform.ChannelNumber() << ", at time " << ThisWaveform.TimeStamp()
+	      << ", there are " << ThisWaveform.Waveform().size() << " ADCs in this waveform " << std::endl;
+    const std::vector< short >& WaveformVec = ThisWaveform.Waveform();
+    for (unsigned int WaveformLoop=0; WaveformLoop < WaveformVec.size() && WaveformLoop < 5; ++WaveformLoop) {
+      std::cout << "      Element " << WaveformLoop << " of " << WaveformVec.size() << " has ADC value " << WaveformVec[WaveformLoop] << std::endl;
+    } // Loop over the Waveform() data member
+  } // Loop over the first waveforms
+
+  if (fPDMinChannels == 0) {
     // --- If there are any OpDetWaveforms return true.
-  if (fNumber) {
-    fTrigDecision = true;
+    fTrigDecision = fNumber > 0;
   } else {
-    fTrigDecision = false;
+    // --- ...or trigger on a coincidence of leading edges on different channels.
+    IndexPDEdges(pwfs, nwf);
+    fTrigDecision = PDCoincidence(fPDCoincidenceWindow, fPDMinChannels, fPDTriggerTime) >= fPDMinChannels;
   }
 
   // --- Return the result of the trigger.
   return fTrigDecision;
 } // TriggerOnPD
 
+//----------------------------------------------------------------------
+void triggersim::ActivityTrigger::IndexPDEdges(const raw::OpDetWaveform* pwfs, size_t nwf) {
+  fPDEdges.clear();
+  for (size_t Wave=0; Wave < nwf; ++Wave) {
+    const raw::OpDetWaveform& ThisWaveform = pwfs[Wave];
+    const std::vector<short>& adcs = ThisWaveform.Waveform();
+    unsigned int nadc = adcs.size();
+    if (nadc == 0) continue;
+    unsigned int nbase = std::min(fPDBaselineSamples, nadc);
+    double baseline = 0.0;
+    for (unsigned int isam=0; isam < nbase; ++isam) baseline += adcs[isam];
+    if (nbase) baseline /= nbase;
+    fPDEdgeTicks.clear();
+    FindCrossings(adcs.data(), nadc, baseline + fPDThreshold, fPDEdgeTicks);
+    for (unsigned int Tick : fPDEdgeTicks) {
+      fPDEdges.emplace_back(ThisWaveform.TimeStamp() + Tick*fPDTickPeriod, ThisWaveform.ChannelNumber());
+    }
+  }
+  std::sort(fPDEdges.begin(), fPDEdges.end());
+} // IndexPDEdges
+
+//----------------------------------------------------------------------
+unsigned int triggersim::ActivityTrigger::PDCoincidence(double width, unsigned int nmin, double& tfirst) {
+  tfirst = -1.0;
+  unsigned int maxChannels = 0;
+  if (fPDEdges.empty()) return maxChannels;
+  unsigned int nchan = 0;
+  for (const auto& edge : fPDEdges) nchan = std::max(nchan, edge.second + 1);
+  fPDChannelCounts.assign(nchan, 0);
+  // --- Slide the window [t - width, t] over the edges, keeping the edge count of
+  //     each channel in the window and the number of channels with edges.
+  unsigned int nactive = 0;
+  size_t ifirst = 0;
+  for (size_t iedge=0; iedge < fPDEdges.size(); ++iedge) {
+    double Time = fPDEdges[iedge].first;
+    if (fPDChannelCounts[fPDEdges[iedge].second]++ == 0) ++nactive;
+    while (fPDEdges[ifirst].first < Time - width) {
+      if (--fPDChannelCounts[fPDEdges[ifirst].second] == 0) --nactive;
+      ++ifirst;
+    }
+    if (nactive >= nmin && tfirst < 0.0) tfirst = fPDEdges[ifirst].first;
+    maxChannels = std::max(maxChannels, nactive);
+  }
+  return maxChannels;
+} // PDCoincidence
+
 //----------------------------------------------------------------------
 //----- The trigger algorithm on the RawDigits and OpDetWaveforms ------
 //----------------------------------------------------------------------
-bool triggersim::ActivityTrigger::TriggerOnTPC_PD( std::vector< raw::RawDigit > rawTPC, std::vector< raw::OpDetWaveform > rawPD) {
+bool triggersim::ActivityTrigger::TriggerOnTPC_PD( const std::vector< raw::RawDigit >& rawTPC, const std::vector< raw::OpDetWaveform >& rawPD) {
   // --- If for some reason you changed your mind about making this trigger...
   if (!fMakeTrig) return false;
 
@@ -188,7 +401,7 @@ bool triggersim::ActivityTrigger::TriggerOnTPC_PD( std::vector< raw::RawDigit >
 //----------------------------------------------------------------------
 //----- The trigger algorithm on the RawDigits and OpDetWaveforms ------
 //----------------------------------------------------------------------
-bool triggersim::ActivityTrigger::TriggerOnTriggers( std::vector<triggersim::BasicTrigger> triggerVec) {
+bool triggersim::ActivityTrigger::TriggerOnTriggers( const std::vector<triggersim::BasicTrigger>& triggerVec) {
 
   std::cout << "    Looking at TriggerOnTriggers...I currently have " << triggerVec.size() << " triggers." << std::endl;
   for (unsigned int TrigVecLoop=0; TrigVecLoop < triggerVec.size(); ++TrigVecLoop) {
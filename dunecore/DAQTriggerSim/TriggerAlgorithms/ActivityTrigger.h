@@ -22,6 +22,8 @@
 #include <vector>
 #include <iostream>
 #include <string>
+#include <memory>
+#include <utility>
 
 namespace triggersim {
   class ActivityTrigger;
@@ -50,24 +52,94 @@ class triggersim::ActivityTrigger{
   // An example function for how you could trigger using information from the TPC Raw Digits.
   //    Using this trigger means that you ony have access to the Raw Digits.
   //      You can find the info on these here: http://nusoft.fnal.gov/larsoft/doxsvn/html/classraw_1_1RawDigit.html
-  bool TriggerOnTPC(std::vector< raw::RawDigit> rawTPC);
+  //    The digits are passed by reference, which also allows a span of a larger
+  //      collection to be given, e.g. one readout window of streaming data.
+  //    If MinActiveChannels is zero, this triggers on the number of digits. Otherwise
+  //      it triggers if any time window has at least that many collection channels
+  //      with a threshold crossing.
+  bool TriggerOnTPC(const std::vector< raw::RawDigit>& rawTPC);
+  bool TriggerOnTPC(const raw::RawDigit* pdigs, size_t ndig);
+
+  // Trigger on a selection of digits, e.g. those for one APA.
+  //    This skips the example printout so that many of these can run concurrently
+  //      on different ActivityTrigger objects.
+  bool TriggerOnTPC(const std::vector<const raw::RawDigit*>& digs);
+
+  // Start tick of the first window that met MinActiveChannels in the last TPC trigger.
+  unsigned int TriggerTick() const { return fTriggerTick; }
+
+  // Mask of collection channels indexed by channel number.
+  //    This is built from the geometry on first use and then reused. Copies of
+  //      this object share the mask.
+  const std::vector<char>& CollectionMask();
+
+  // Per-channel kernel, a leading-edge discriminator: append to ticks each tick
+  //    where the ADC value rises to or above threshold. Returns the number of
+  //    crossings found. The comparisons are made on blocks of 64 ticks with an
+  //    integer threshold and packed into a bit mask so the loop vectorises.
+  static unsigned int FindCrossings(const short* padc, unsigned int nadc, float threshold,
+                                    std::vector<unsigned int>& ticks);
+
+  // Index the threshold crossings of the collection channels in a span of digits.
+  //    The threshold is ADCThreshold above each digit pedestal.
+  void IndexCrossings(const raw::RawDigit* pdigs, size_t ndig);
+  void IndexCrossings(const std::vector<const raw::RawDigit*>& digs);
+
+  // Number of indexed channels with a crossing in ticks [tick0, tick1).
+  unsigned int ActiveChannels(unsigned int tick0, unsigned int tick1) const;
+
+  // Number of indexed channels with a crossing in each of the windows
+  //    [i*step, i*step + width) that fit in the indexed readout.
+  //    The windows are evaluated incrementally in one pass over the crossings.
+  //    Returns the largest count.
+  unsigned int WindowActivity(unsigned int width, unsigned int step,
+                              std::vector<unsigned int>& counts) const;
 
   // An example function for how you could trigger using information from the Photon detector OpDetWaveforms
   //    Using this trigger means that you ony have access to the OpDetWaveforms
   //      You can find the info on these here: http://nusoft.fnal.gov/larsoft/doxsvn/html/classraw_1_1OpDetWaveform.html
-  bool TriggerOnPD( std::vector< raw::OpDetWaveform > rawPD );
+  //    As for the TPC, a pointer and count may be given for a span of a larger collection.
+  //    If PDMinChannels is zero, this triggers if there are any waveforms. Otherwise it
+  //      triggers if at least PDMinChannels OpDet channels have a leading edge within
+  //      PDCoincidenceWindow of each other.
+  bool TriggerOnPD( const std::vector< raw::OpDetWaveform >& rawPD );
+  bool TriggerOnPD( const raw::OpDetWaveform* pwfs, size_t nwf );
+
+  // Time [us] of the first edge of the first coincidence in the last PD trigger.
+  double PDTriggerTime() const { return fPDTriggerTime; }
+
+  // Index the leading edges of the waveforms in a span.
+  //    Each waveform is passed through FindCrossings at PDThreshold above its baseline,
+  //      the mean of its first PDBaselineSamples samples, and the edge times are
+  //      TimeStamp() + tick*PDTickPeriod.
+  void IndexPDEdges(const raw::OpDetWaveform* pwfs, size_t nwf);
+
+  // Number of indexed PD edges.
+  size_t PDEdgeCount() const { return fPDEdges.size(); }
+
+  // Largest number of distinct OpDet channels with an indexed edge in any time window
+  //    of the given width [us]. The window is evaluated in one pass over the edges in
+  //    time order. Sets tfirst to the time of the first edge of the first window with
+  //    at least nmin channels, or to -1 if there is none.
+  unsigned int PDCoincidence(double width, unsigned int nmin, double& tfirst);
 
   // An example function for how to trigger using both RawDigits and OpDetWaveforms.
   //    Using this trigger will mean that you have access to both RawDigits and OpDetWaveforms.
   //      The methods to access stuff from these can be found in the documentation of the above functions...
-  bool TriggerOnTPC_PD( std::vector< raw::RawDigit> rawTPC, std::vector< raw::OpDetWaveform> rawPD);
+  bool TriggerOnTPC_PD( const std::vector< raw::RawDigit>& rawTPC, const std::vector< raw::OpDetWaveform>& rawPD);
 
   // An example function for how to trigger using the output of other triggers.
   //    Using this trigger means that you only have access to what is stored in the triggersim::BasicTrigger data product.
   //      The methods to access stuff from these can be found in: dunecore/DAQTriggerSim/TriggerDataProducts/BasicTrigger.h
-  bool TriggerOnTriggers( std::vector<triggersim::BasicTrigger> triggerVec);
+  bool TriggerOnTriggers( const std::vector<triggersim::BasicTrigger>& triggerVec);
 
  private:
+
+  // Add the crossings for one digit to the index.
+  void IndexDigit(const raw::RawDigit& digit);
+
+  // Evaluate the windowed decision on the indexed crossings.
+  bool WindowDecision();
   
   // Parameters:
   bool         fMakeTrig;        ///< Boolean which is passed as to whether to even attempt this trigger
@@ -78,6 +150,30 @@ class triggersim::ActivityTrigger{
   std::string fRawDigLabel;
   std::string fOpWaveLabel;
 
+  float        fADCThreshold;      ///< Crossing threshold above pedestal
+  unsigned int fMinActiveChannels; ///< Active channels to trigger, 0 to trigger on digit count
+  unsigned int fWindowTicks;       ///< Trigger window width, 0 for the whole readout
+  unsigned int fWindowStep;        ///< Trigger window step, 0 for the window width
+
+  float        fPDThreshold;         ///< PD discriminator threshold above baseline
+  unsigned int fPDBaselineSamples;   ///< Samples used for the PD baseline, 0 for a zero baseline
+  double       fPDTickPeriod;        ///< PD sample period [us]
+  double       fPDCoincidenceWindow; ///< PD coincidence window [us]
+  unsigned int fPDMinChannels;       ///< OpDet channels in coincidence to trigger, 0 to trigger on any waveform
+
+  // Cached state.
+  std::shared_ptr<const std::vector<char>> fCollectionMask;  ///< Nonzero for collection channels, shared by copies
+  std::vector<unsigned int> fCrossTicks;      ///< Crossing ticks for all indexed channels
+  std::vector<unsigned int> fCrossBegin;      ///< Start of each channel in fCrossTicks, plus end
+  unsigned int              fNTicks = 0;      ///< Length of the indexed readout
+  unsigned int              fTriggerTick = 0; ///< Start of the first window over threshold
+  std::vector<short>        fADCBuffer;       ///< Buffer for uncompressed ADCs
+  std::vector<unsigned int> fWindowCounts;    ///< Buffer for window counts
+  std::vector<std::pair<double, unsigned int>> fPDEdges;  ///< (time, OpDet channel) of each PD edge
+  std::vector<unsigned int> fPDEdgeTicks;     ///< Buffer for the edge ticks of one waveform
+  std::vector<unsigned int> fPDChannelCounts; ///< Buffer for edges per channel in the window
+  double                    fPDTriggerTime = -1.0; ///< Start of the first PD coincidence
+
 };
 
 #endif
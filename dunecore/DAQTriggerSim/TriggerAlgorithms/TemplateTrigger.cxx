@@ -87,7 +87,7 @@ bool triggersim::TemplateTrigger::TriggerOnWholeEvent( art::Event& event ) {
 //----------------------------------------------------------------------
 //----------- The trigger algorithm on just the TPC RawDigits ----------
 //----------------------------------------------------------------------
-bool triggersim::TemplateTrigger::TriggerOnTPC( std::vector< raw::RawDigit> rawTPC ) {
+bool triggersim::TemplateTrigger::TriggerOnTPC( const std::vector< raw::RawDigit>& rawTPC ) {
   // --- If for some reason you changed your mind about making this trigger...
   if (!fMakeTrig) return false;
 
@@ -97,7 +97,7 @@ bool triggersim::TemplateTrigger::TriggerOnTPC( std::vector< raw::RawDigit> rawT
   // --- Now do stuff...
   fNumber = rawTPC.size();
   for (unsigned int Dig=0; Dig < rawTPC.size(); ++Dig) {
-    raw::RawDigit ThisDig = rawTPC[Dig]; // Can also use rawTPC.at(Dig);
+    const raw::RawDigit& ThisDig = rawTPC[Dig]; // Can also use rawTPC.at(Dig);
     int Chan = rawTPC[Dig].Channel();    // Alternatively can access stuff by doing rawTPC[Dig]->Channel()
     if (Dig < 5) {
       std::cout << "    Looking at Dig " << Dig << " of " << rawTPC.size() << ", it has " << ThisDig.Samples() << " samples on Channel " << ThisDig.Channel() << " ("<<Chan<<")" 
@@ -137,7 +137,7 @@ bool triggersim::TemplateTrigger::TriggerOnTPC( std::vector< raw::RawDigit> rawT
 //----------------------------------------------------------------------
 //-- The trigger algorithm on just the Photon Detector OpDetWaveforms --
 //----------------------------------------------------------------------
-bool triggersim::TemplateTrigger::TriggerOnPD( std::vector< raw::OpDetWaveform > rawPD) {
+bool triggersim::TemplateTrigger::TriggerOnPD( const std::vector< raw::OpDetWaveform >& rawPD) {
   // --- If for some reason you changed your mind about making this trigger...
   if (!fMakeTrig) return false;
 
@@ -145,10 +145,10 @@ bool triggersim::TemplateTrigger::TriggerOnPD( std::vector< raw::OpDetWaveform >
   fNumber = rawPD.size();
   for (unsigned int Wave=0; Wave < rawPD.size(); ++Wave) {
     if (Wave < 5) {
-      raw::OpDetWaveform ThisWaveform = rawPD[Wave]; // Also, rawPD.at(Wave);
+      const raw::OpDetWaveform& ThisWaveform = rawPD[Wave]; // Also, rawPD.at(Wave);
       std::cout << "    Looking at Wave " << Wave << " of " << rawPD.size() << ", it was on channel " << ThisWaveform.ChannelNumber() << ", at time " << ThisWaveform.TimeStamp()
 		<< ", there are " << ThisWaveform.Waveform().size() << " ADCs in this waveform " << std::endl;
-      std::vector< short > WaveformVec = ThisWaveform.Waveform();
+      const std::vector< short >& WaveformVec = ThisWaveform.Waveform();
       for (unsigned int WaveformLoop=0; WaveformLoop < WaveformVec.size(); ++WaveformLoop) {
 	if (WaveformLoop < 5) {
 	  std::cout << "      Element " << WaveformLoop << " of " << WaveformVec.size() << " has ADC value " << WaveformVec.at(WaveformLoop) << std::endl;
@@ -171,7 +171,7 @@ bool triggersim::TemplateTrigger::TriggerOnPD( std::vector< raw::OpDetWaveform >
 //----------------------------------------------------------------------
 //----- The trigger algorithm on the RawDigits and OpDetWaveforms ------
 //----------------------------------------------------------------------
-bool triggersim::TemplateTrigger::TriggerOnTPC_PD( std::vector< raw::RawDigit > rawTPC, std::vector< raw::OpDetWaveform> rawPD) {
+bool triggersim::TemplateTrigger::TriggerOnTPC_PD( const std::vector< raw::RawDigit >& rawTPC, const std::vector< raw::OpDetWaveform>& rawPD) {
   // --- If for some reason you changed your mind about making this trigger...
   if (!fMakeTrig) return false;
 
@@ -190,7 +190,7 @@ bool triggersim::TemplateTrigger::TriggerOnTPC_PD( std::vector< raw::RawDigit >
 //----------------------------------------------------------------------
 //----- The trigger algorithm on the RawDigits and OpDetWaveforms ------
 //----------------------------------------------------------------------
-bool triggersim::TemplateTrigger::TriggerOnTriggers( std::vector<triggersim::BasicTrigger> triggerVec) {
+bool triggersim::TemplateTrigger::TriggerOnTriggers( const std::vector<triggersim::BasicTrigger>& triggerVec) {
 
   std::cout << "    Looking at TriggerOnTriggers...I currently have " << triggerVec.size() << " triggers." << std::endl;
   for (unsigned int TrigVecLoop=0; TrigVecLoop < triggerVec.size(); ++TrigVecLoop) {
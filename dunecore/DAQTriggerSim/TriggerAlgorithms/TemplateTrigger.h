@@ -50,22 +50,22 @@ class triggersim::TemplateTrigger{
   // An example function for how you could trigger using information from the TPC Raw Digits.
   //    Using this trigger means that you ony have access to the Raw Digits.
   //      You can find the info on these here: http://nusoft.fnal.gov/larsoft/doxsvn/html/classraw_1_1RawDigit.html
-  bool TriggerOnTPC(std::vector< raw::RawDigit> rawTPC);
+  bool TriggerOnTPC(const std::vector< raw::RawDigit>& rawTPC);
 
   // An example function for how you could trigger using information from the Photon detector OpDetWaveforms
   //    Using this trigger means that you ony have access to the OpDetWaveforms
   //      You can find the info on these here: http://nusoft.fnal.gov/larsoft/doxsvn/html/classraw_1_1OpDetWaveform.html
-  bool TriggerOnPD( std::vector< raw::OpDetWaveform > rawPD );
+  bool TriggerOnPD( const std::vector< raw::OpDetWaveform >& rawPD );
 
   // An example function for how to trigger using both RawDigits and OpDetWaveforms.
   //    Using this trigger will mean that you have access to both RawDigits and OpDetWaveforms.
   //      The methods to access stuff from these can be found in the documentation of the above functions...
-  bool TriggerOnTPC_PD( std::vector< raw::RawDigit > rawTPC, std::vector< raw::OpDetWaveform > rawPD);
+  bool TriggerOnTPC_PD( const std::vector< raw::RawDigit >& rawTPC, const std::vector< raw::OpDetWaveform >& rawPD);
 
   // An example function for how to trigger using the output of other triggers.
   //    Using this trigger means that you only have access to what is stored in the triggersim::BasicTrigger data product.
   //      The methods to access stuff from these can be found in: dunecore/DAQTriggerSim/TriggerDataProducts/BasicTrigger.h
-  bool TriggerOnTriggers( std::vector<triggersim::BasicTrigger> triggerVec);
+  bool TriggerOnTriggers( const std::vector<triggersim::BasicTrigger>& triggerVec);
 
  private:
   
@@ -0,0 +1,157 @@
+// TriggerPrimitiveFinder.cxx
+//
+// Trigger primitive generation for the DAQ trigger framework.
+//
+
+// Framework includes
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "lardataobj/RawData/raw.h"
+
+#include "larcore/Geometry/Geometry.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
+// DUNETPC specific includes
+#include "dunecore/DAQTriggerSim/TriggerAlgorithms/TriggerPrimitiveFinder.h"
+
+// C++ includes
+#include <iostream>
+
+//----------------------------------------------------------------------
+//------------- The constructor for this trigger algorithm -------------
+//----------------------------------------------------------------------
+triggersim::TriggerPrimitiveFinder::TriggerPrimitiveFinder() :
+  fThreshold(20.0),
+  fPedestalWindow(10),
+  fMinTimeOverThreshold(1),
+  fCollectionOnly(true) {}
+
+//----------------------------------------------------------------------
+//------------ The configuration for this trigger algorithm ------------
+//----------------------------------------------------------------------
+void triggersim::TriggerPrimitiveFinder::Configure( fhicl::ParameterSet const& pset ) {
+  fThreshold            = pset.get<float>        ("Threshold", fThreshold);
+  fPedestalWindow       = pset.get<unsigned int> ("PedestalWindow", fPedestalWindow);
+  fMinTimeOverThreshold = pset.get<unsigned int> ("MinTimeOverThreshold", fMinTimeOverThreshold);
+  fCollectionOnly       = pset.get<bool>         ("CollectionOnly", fCollectionOnly);
+
+  std::cout << "\n------In my trigger primitive finder------\nThe fcl params have been set to :"
+	    << "\n  fThreshold:            " << fThreshold
+	    << "\n  fPedestalWindow:       " << fPedestalWindow
+	    << "\n  fMinTimeOverThreshold: " << fMinTimeOverThreshold
+	    << "\n  fCollectionOnly:       " << fCollectionOnly
+	    << "\n-------------------------------\n"
+	    << std::endl;
+} // Configure
+
+//----------------------------------------------------------------------
+//---------------- The trigger primitive kernel for one channel --------
+//----------------------------------------------------------------------
+unsigned int triggersim::TriggerPrimitiveFinder::
+FindPrimitives(const short* padc, unsigned int nadc, unsigned int channel, float pedestal,
+               float threshold, unsigned int pedestalWindow, unsigned int minTimeOverThreshold,
+               TriggerPrimitiveVector& tps) {
+  if (padc == nullptr || nadc == 0) return 0;
+  unsigned int ntp = 0;
+  int ped = pedestal > 0.0 ? int(pedestal + 0.5) : padc[0];
+  int acc = 0;
+  int nwin = pedestalWindow > 0 ? pedestalWindow : 1;
+  // --- State of the current primitive.
+  bool inTP = false;
+  unsigned int startTick = 0;
+  unsigned int peakTick = 0;
+  int peakADC = 0;
+  int sumADC = 0;
+  for (unsigned int Tick=0; Tick < nadc; ++Tick) {
+    int adc = padc[Tick];
+    int sig = adc - ped;
+    if (sig >= threshold) {
+      if (!inTP) {
+        inTP = true;
+        startTick = Tick;
+        peakTick = Tick;
+        peakADC = sig;
+        sumADC = 0;
+      } else if (sig > peakADC) {
+        peakTick = Tick;
+        peakADC = sig;
+      }
+      sumADC += sig;
+      continue;
+    }
+    if (inTP) {
+      inTP = false;
+      unsigned int tot = Tick - startTick;
+      if (tot >= minTimeOverThreshold) {
+        tps.emplace_back(channel, startTick, tot, peakTick, peakADC, sumADC);
+        ++ntp;
+      }
+    }
+    // --- Track the pedestal outside primitives.
+    acc += (adc > ped) - (adc < ped);
+    if (acc >= nwin) {
+      ++ped;
+      acc = 0;
+    } else if (acc <= -nwin) {
+      --ped;
+      acc = 0;
+    }
+  }
+  if (inTP) {
+    unsigned int tot = nadc - startTick;
+    if (tot >= minTimeOverThreshold) {
+      tps.emplace_back(channel, startTick, tot, peakTick, peakADC, sumADC);
+      ++ntp;
+    }
+  }
+  return ntp;
+} // FindPrimitives
+
+//----------------------------------------------------------------------
+unsigned int triggersim::TriggerPrimitiveFinder::
+FindPrimitives(const raw::RawDigit& digit, TriggerPrimitiveVector& tps) {
+  raw::ChannelID_t Chan = digit.Channel();
+  if (fCollectionOnly) {
+    const std::vector<char>& mask = CollectionMask();
+    if (Chan >= mask.size() || !mask[Chan]) return 0;
+  }
+  const short* padc = digit.ADCs().data();
+  unsigned int nadc = digit.NADC();
+  if (digit.Compression() != raw::kNone) {
+    fADCBuffer.resize(digit.Samples());
+    raw::Uncompress(digit.ADCs(), fADCBuffer, digit.Compression());
+    padc = fADCBuffer.data();
+    nadc = fADCBuffer.size();
+  }
+  return FindPrimitives(padc, nadc, Chan, digit.GetPedestal(), fThreshold,
+                        fPedestalWindow, fMinTimeOverThreshold, tps);
+} // FindPrimitives
+
+//----------------------------------------------------------------------
+unsigned int triggersim::TriggerPrimitiveFinder::
+FindPrimitives(const raw::RawDigit* pdigs, size_t ndig, TriggerPrimitiveVector& tps) {
+  unsigned int ntp = 0;
+  for (size_t Dig=0; Dig < ndig; ++Dig) ntp += FindPrimitives(pdigs[Dig], tps);
+  return ntp;
+} // FindPrimitives
+
+//----------------------------------------------------------------------
+unsigned int triggersim::TriggerPrimitiveFinder::
+FindPrimitives(const std::vector<raw::RawDigit>& digits, TriggerPrimitiveVector& tps) {
+  return FindPrimitives(digits.data(), digits.size(), tps);
+} // FindPrimitives
+
+//----------------------------------------------------------------------
+const std::vector<char>& triggersim::TriggerPrimitiveFinder::CollectionMask() {
+  if (fCollectionMask.empty()) {
+    art::ServiceHandle<geo::Geometry> geom;
+    unsigned int nchan = geom->Nchannels();
+    fCollectionMask.resize(nchan, 0);
+    for (unsigned int Chan=0; Chan < nchan; ++Chan) {
+      fCollectionMask[Chan] = geom->SignalType(Chan) == geo::kCollection;
+    }
+  }
+  return fCollectionMask;
+} // CollectionMask
+
+//----------------------------------------------------------------------
@@ -0,0 +1,87 @@
+// TriggerPrimitiveFinder.h
+//
+// Trigger primitive generation for the DAQ trigger framework.
+//
+// Each TPC waveform is scanned once. The pedestal is tracked with a frugal
+// streaming median: it moves by one ADC count when PedestalWindow more
+// samples in a row (net) lie on one side of it. Ticks whose pedestal-
+// subtracted ADC is at or above Threshold form a trigger primitive with
+// its time over threshold, peak and ADC integral. The pedestal is not
+// updated inside a primitive so that signals do not pull it up.
+//
+// The output triggersim::TriggerPrimitive vector can be passed to
+// BaseTriggerService::TPTrigger so trigger emulation does not need the
+// full waveforms.
+//
+// Parameters:
+//   Threshold            - Threshold above pedestal in ADC counts
+//   PedestalWindow       - Samples to move the tracked pedestal by one count
+//   MinTimeOverThreshold - Shortest primitive that is kept, in ticks
+//   CollectionOnly       - If true, only collection channels are processed
+//
+
+#ifndef TriggerPrimitiveFinder_H
+#define TriggerPrimitiveFinder_H
+
+// Framework includes
+#include "lardataobj/RawData/RawDigit.h"
+
+// Framework includes for the triggering framework.
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerPrimitive.h"
+
+// C++ includes
+#include <vector>
+
+namespace fhicl {
+  class ParameterSet;
+}
+
+namespace triggersim {
+  class TriggerPrimitiveFinder;
+}
+
+class triggersim::TriggerPrimitiveFinder {
+ public:
+
+  using TriggerPrimitiveVector = std::vector<triggersim::TriggerPrimitive>;
+
+  // The constructor with default parameters.
+  TriggerPrimitiveFinder();
+
+  // Pass all of the fcl parameters to the class.
+  void Configure( fhicl::ParameterSet const& pset );
+
+  // Kernel for one channel: append the primitives found in nadc samples to tps.
+  //    pedestal is the starting value for the tracked pedestal. If it is not
+  //    positive, the first sample is used.
+  //    Returns the number of primitives found.
+  static unsigned int FindPrimitives(const short* padc, unsigned int nadc,
+                                     unsigned int channel, float pedestal,
+                                     float threshold, unsigned int pedestalWindow,
+                                     unsigned int minTimeOverThreshold,
+                                     TriggerPrimitiveVector& tps);
+
+  // Append the primitives for one digit or a span of digits to tps.
+  //    Compressed digits are uncompressed into a buffer held by this object.
+  unsigned int FindPrimitives(const raw::RawDigit& digit, TriggerPrimitiveVector& tps);
+  unsigned int FindPrimitives(const raw::RawDigit* pdigs, size_t ndig, TriggerPrimitiveVector& tps);
+  unsigned int FindPrimitives(const std::vector<raw::RawDigit>& digits, TriggerPrimitiveVector& tps);
+
+ private:
+
+  // Mask of collection channels, built from the geometry on first use.
+  const std::vector<char>& CollectionMask();
+
+  // Parameters:
+  float        fThreshold;             ///< threshold above pedestal
+  unsigned int fPedestalWindow;        ///< samples to move the pedestal one count
+  unsigned int fMinTimeOverThreshold;  ///< shortest primitive kept
+  bool         fCollectionOnly;        ///< only process collection channels
+
+  // Cached state.
+  std::vector<char>  fCollectionMask;  ///< nonzero for collection channels
+  std::vector<short> fADCBuffer;       ///< buffer for uncompressed ADCs
+
+};
+
+#endif
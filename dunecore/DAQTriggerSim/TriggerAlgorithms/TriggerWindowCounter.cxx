@@ -0,0 +1,98 @@
+// TriggerWindowCounter.cxx
+//
+// Sliding-window trigger counts per hardware element.
+//
+
+// DUNETPC specific includes
+#include "dunecore/DAQTriggerSim/TriggerAlgorithms/TriggerWindowCounter.h"
+
+using Index = triggersim::TriggerWindowCounter::Index;
+
+//----------------------------------------------------------------------
+triggersim::TriggerWindowCounter::TriggerWindowCounter(double window, Index threshold) :
+  fWindow(window),
+  fThreshold(threshold),
+  fNOver(0),
+  fRing(16),
+  fHead(0),
+  fSize(0),
+  fLatest(-std::numeric_limits<double>::max()) {}
+
+//----------------------------------------------------------------------
+Index triggersim::TriggerWindowCounter::addElement(const Hardware::HardwareID& id) {
+  auto ient = fSlots.find(id);
+  if (ient != fSlots.end()) return ient->second;
+  Index islot = fIDs.size();
+  fIDs.push_back(id);
+  fSlots[id] = islot;
+  fCounts.push_back(0);
+  if (fThreshold == 0) ++fNOver;
+  return islot;
+}
+
+//----------------------------------------------------------------------
+void triggersim::TriggerWindowCounter::addElements(const std::vector<Hardware::HardwareID>& ids) {
+  for (const Hardware::HardwareID& id : ids) addElement(id);
+}
+
+//----------------------------------------------------------------------
+Index triggersim::TriggerWindowCounter::slot(const Hardware::HardwareID& id) const {
+  auto ient = fSlots.find(id);
+  return ient == fSlots.end() ? badIndex() : ient->second;
+}
+
+//----------------------------------------------------------------------
+bool triggersim::TriggerWindowCounter::add(double time, Index islot) {
+  advance(time);
+  if (islot >= fCounts.size()) return false;
+  // --- Grow the ring, unrolling it so the oldest entry is first.
+  if (fSize == fRing.size()) {
+    std::vector<Entry> ring(2*fRing.size());
+    for (Index ient=0; ient<fSize; ++ient) ring[ient] = fRing[(fHead + ient) % fRing.size()];
+    fRing.swap(ring);
+    fHead = 0;
+  }
+  fRing[(fHead + fSize) % fRing.size()] = {fLatest, islot};
+  ++fSize;
+  Index& cnt = fCounts[islot];
+  if (++cnt == fThreshold) ++fNOver;
+  return cnt >= fThreshold;
+}
+
+//----------------------------------------------------------------------
+bool triggersim::TriggerWindowCounter::add(double time, const Hardware::HardwareID& id) {
+  return add(time, slot(id));
+}
+
+//----------------------------------------------------------------------
+bool triggersim::TriggerWindowCounter::add(const triggersim::BasicTrigger& trig, double time) {
+  if (!trig.TrigDecision()) {
+    advance(time);
+    return false;
+  }
+  return add(time, trig.TrigHardwareID());
+}
+
+//----------------------------------------------------------------------
+void triggersim::TriggerWindowCounter::advance(double time) {
+  if (time > fLatest) fLatest = time;
+  double tmin = fLatest - fWindow;
+  while (fSize > 0 && fRing[fHead].time < tmin) pop();
+}
+
+//----------------------------------------------------------------------
+void triggersim::TriggerWindowCounter::clear() {
+  while (fSize > 0) pop();
+  fHead = 0;
+  fLatest = -std::numeric_limits<double>::max();
+}
+
+//----------------------------------------------------------------------
+void triggersim::TriggerWindowCounter::pop() {
+  Index& cnt = fCounts[fRing[fHead].islot];
+  if (cnt-- == fThreshold) --fNOver;
+  fHead = (fHead + 1) % fRing.size();
+  --fSize;
+}
+
+//----------------------------------------------------------------------
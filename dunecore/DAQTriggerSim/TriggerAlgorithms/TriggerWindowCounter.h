@@ -0,0 +1,117 @@
+// TriggerWindowCounter.h
+//
+// Sliding-window trigger counts per hardware element for the DAQ trigger
+// framework, e.g. for a supernova burst trigger on the number of
+// BasicTriggers seen in each APA in the last few seconds.
+//
+// Triggers are added in time order. Each is kept in a ring buffer until it
+// falls out of the window [t - Window, t], where t is the latest time added,
+// and the count for its element is updated as it enters and leaves. Adding
+// a trigger and the threshold decision are O(1) amortised; nothing is
+// rescanned.
+//
+// The elements are registered up front, e.g. with the IDs from
+// HardwareMapperService::getAPAIDs(), and are then referred to by a slot
+// index so the per-trigger path does not need a map lookup. A time earlier
+// than the latest one added is treated as the latest time.
+//
+// Usage:
+//   TriggerWindowCounter twc(window, threshold);
+//   twc.addElements(hardwareMapper->getAPAIDs());
+//   for each trigger:
+//     if ( twc.add(trig, time) ) { burst in trig.TrigHardwareID() ... }
+//
+
+#ifndef TriggerWindowCounter_H
+#define TriggerWindowCounter_H
+
+// Framework includes for the triggering framework.
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/BasicTrigger.h"
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/HardwareElements.h"
+
+// C++ includes
+#include <vector>
+#include <map>
+#include <limits>
+
+namespace triggersim {
+  class TriggerWindowCounter;
+}
+
+class triggersim::TriggerWindowCounter {
+ public:
+
+  using Index = unsigned int;
+
+  static Index badIndex() { return std::numeric_limits<Index>::max(); }
+
+  // Constructor from the window length and the count needed in one element.
+  TriggerWindowCounter(double window, Index threshold);
+
+  // Register hardware elements. Returns the slot for the element.
+  Index addElement(const Hardware::HardwareID& id);
+  void addElements(const std::vector<Hardware::HardwareID>& ids);
+
+  // Slot for an element or badIndex() if it is not registered.
+  Index slot(const Hardware::HardwareID& id) const;
+
+  // Add a trigger at a time for slot islot. Returns true if the count in
+  //    that element is at or above threshold after the addition.
+  //    An invalid slot only advances the window.
+  bool add(double time, Index islot);
+
+  // Add a trigger for a hardware element or for the element of a BasicTrigger.
+  //    Only triggers with a true decision are counted.
+  bool add(double time, const Hardware::HardwareID& id);
+  bool add(const triggersim::BasicTrigger& trig, double time);
+
+  // Move the window to end at time, dropping the triggers that leave it.
+  void advance(double time);
+
+  // Counts in the current window.
+  Index count(Index islot) const { return islot < fCounts.size() ? fCounts[islot] : 0; }
+  Index count(const Hardware::HardwareID& id) const { return count(slot(id)); }
+  Index totalCount() const { return fSize; }
+
+  // Number of elements with count at or above threshold.
+  Index nOverThreshold() const { return fNOver; }
+
+  // Access the configuration and the registered elements.
+  double window() const { return fWindow; }
+  Index threshold() const { return fThreshold; }
+  Index nElement() const { return fIDs.size(); }
+  const Hardware::HardwareID& element(Index islot) const { return fIDs[islot]; }
+  double latestTime() const { return fLatest; }
+
+  // Remove all triggers, keeping the elements.
+  void clear();
+
+ private:
+
+  struct Entry {
+    double time;
+    Index  islot;
+  };
+
+  // Remove the oldest entry.
+  void pop();
+
+  // Parameters:
+  double fWindow;     ///< window length
+  Index  fThreshold;  ///< count needed in one element
+
+  // Elements.
+  std::vector<Hardware::HardwareID> fIDs;
+  std::map<Hardware::HardwareID, Index> fSlots;
+  std::vector<Index> fCounts;
+  Index fNOver;
+
+  // Ring buffer of the triggers in the window, oldest at fHead.
+  std::vector<Entry> fRing;
+  Index fHead;
+  Index fSize;
+  double fLatest;
+
+};
+
+#endif
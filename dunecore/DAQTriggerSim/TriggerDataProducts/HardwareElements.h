@@ -15,6 +15,7 @@
 #include <set>
 #include <iostream>
 #include <iosfwd> // std::ostream
+#include <limits>
 #endif //__GCCXML__
 
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"//jpd -- needed for raw::ChannelID_t
@@ -159,6 +160,60 @@ namespace Hardware{
   using TPCMap   =   std::map<ID, std::shared_ptr<TPC  >>;
   using APAMap   =   std::map<ID, std::shared_ptr<APA  >>;
 
+  //Dense lookup tables for one type of element, e.g. all APAs.
+  //Elements get a dense index 0..N-1 in the order of their IDs. For each channel
+  //the table holds the index of the element containing it and the channels of each
+  //element are stored contiguously (CSR), so aggregating by element needs no map or
+  //set queries. A channel in more than one element, e.g. a wrapped wire in two TPCs,
+  //maps to the element with the lowest ID.
+  class DenseMap
+  {
+  public:
+    static unsigned int badIndex(){ return std::numeric_limits<unsigned int>::max(); }
+
+    template<class T>
+    void fill(std::map<ID, std::shared_ptr<T>> const& elements, size_t nchannels){
+      fIDs.clear();
+      fChannelIndex.assign(nchannels, badIndex());
+      fOffsets.assign(1, 0);
+      fChannels.clear();
+      for(auto const& id_element_pair : elements){
+        unsigned int index = fIDs.size();
+        fIDs.push_back(id_element_pair.first);
+        for(auto channel : id_element_pair.second->getChannels()){
+          fChannels.push_back(channel);
+          if(channel < nchannels && fChannelIndex[channel] == badIndex()) fChannelIndex[channel] = index;
+        }
+        fOffsets.push_back(fChannels.size());
+      }
+    }
+
+    size_t getNElements() const{ return fIDs.size(); }
+    size_t getNChannels() const{ return fChannelIndex.size(); }
+
+    //Dense index for the element holding a channel, badIndex() if there is none
+    unsigned int getIndex(raw::ChannelID_t channel) const{
+      return channel < fChannelIndex.size() ? fChannelIndex[channel] : badIndex();
+    }
+
+    //Hardware ID for a dense index
+    ID getID(unsigned int index) const{ return fIDs[index]; }
+
+    //Channels for a dense index
+    raw::ChannelID_t const* beginChannels(unsigned int index) const{ return fChannels.data() + fOffsets[index]; }
+    raw::ChannelID_t const* endChannels(unsigned int index) const{ return fChannels.data() + fOffsets[index+1]; }
+    size_t getNChannels(unsigned int index) const{ return fOffsets[index+1] - fOffsets[index]; }
+
+    //The full tables
+    std::vector<unsigned int> const& getChannelIndices() const{ return fChannelIndex; }
+
+  private:
+    std::vector<ID> fIDs;
+    std::vector<unsigned int> fChannelIndex;
+    std::vector<size_t> fOffsets;
+    std::vector<raw::ChannelID_t> fChannels;
+  };
+
 #endif //#ifndef __GCCXML__
 }
 
@@ -0,0 +1,96 @@
+// TriggerCollection.cxx
+//
+// Columnar trigger data product for the DAQ trigger framework.
+//
+
+// DUNETPC specific includes
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerCollection.h"
+
+namespace triggersim {
+
+  //----------------------------------------------------------------------
+  TriggerCollection::TriggerCollection()
+  {}
+
+
+
+  //----------------------------------------------------------------------
+  void TriggerCollection::push_back(bool trigdecision, unsigned int trigtype, unsigned int trigsubtype,
+                                    Hardware::HardwareID const& hardwareid, double time)
+  {
+    fDecisions.push_back(trigdecision);
+    fTypes.push_back(trigtype);
+    fSubTypes.push_back(trigsubtype);
+    fTimes.push_back(time);
+    fElementIDs.push_back(hardwareid.getID());
+    fElementTypes.push_back(elementTypeIndex(hardwareid.getType()));
+  }
+
+
+
+  //----------------------------------------------------------------------
+  void TriggerCollection::push_back(BasicTrigger const& trig, double time)
+  {
+    push_back(trig.TrigDecision(), trig.TrigType(), trig.TrigSubType(), trig.TrigHardwareID(), time);
+  }
+
+
+
+  //----------------------------------------------------------------------
+  void TriggerCollection::reserve(unsigned int n)
+  {
+    fDecisions.reserve(n);
+    fTypes.reserve(n);
+    fSubTypes.reserve(n);
+    fTimes.reserve(n);
+    fElementIDs.reserve(n);
+    fElementTypes.reserve(n);
+  }
+
+
+
+  //----------------------------------------------------------------------
+  void TriggerCollection::clear()
+  {
+    fDecisions.clear();
+    fTypes.clear();
+    fSubTypes.clear();
+    fTimes.clear();
+    fElementIDs.clear();
+    fElementTypes.clear();
+    fElementTypeNames.clear();
+  }
+
+
+
+  //----------------------------------------------------------------------
+  Hardware::HardwareID TriggerCollection::TrigHardwareID(unsigned int i) const
+  {
+    return Hardware::HardwareID(fElementIDs[i], ElementType(i));
+  }
+
+
+
+  //----------------------------------------------------------------------
+  BasicTrigger TriggerCollection::at(unsigned int i) const
+  {
+    BasicTrigger trig(TrigDecision(i), TrigType(i), TrigSubType(i), TrigHardwareID(i));
+    trig.setMetric(Time(i));
+    return trig;
+  }
+
+
+
+  //----------------------------------------------------------------------
+  unsigned char TriggerCollection::elementTypeIndex(std::string const& type)
+  {
+    for (unsigned int itype=0; itype<fElementTypeNames.size(); ++itype) {
+      if (fElementTypeNames[itype] == type) return itype;
+    }
+    // --- There are only a handful of element types; fold any beyond 255 into the last.
+    if (fElementTypeNames.size() > 255) return 255;
+    fElementTypeNames.push_back(type);
+    return fElementTypeNames.size() - 1;
+  }
+
+} // end namespace triggersim
@@ -0,0 +1,113 @@
+// TriggerCollection.h
+//
+// Columnar trigger data product for the DAQ trigger framework.
+//
+// Holds the same information as a vector of BasicTrigger (decision, type,
+// subtype and hardware element) plus a time, stored as one array per field
+// so that high-rate trigger streams are compact on disk and analysis can
+// scan a single field. The hardware element type strings are stored once
+// and each trigger refers to them by index.
+//
+// at(i) and the iterators present each entry as a BasicTrigger. The
+// BasicTrigger metrics are not stored; the adapter sets the time as the
+// first metric.
+//
+// Usage:
+//   TriggerCollection tc;
+//   tc.push_back(trig, time);
+//   for ( unsigned int i=0; i<tc.size(); ++i ) if ( tc.TrigDecision(i) ) ... tc.Time(i) ...
+//   for ( BasicTrigger trig : tc ) ...
+//
+
+#ifndef TRIGGERCOLLECTION_H
+#define TRIGGERCOLLECTION_H
+
+// DUNETPC specific includes
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/BasicTrigger.h"
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/HardwareElements.h"
+
+// C++ includes
+#include <vector>
+#include <string>
+#include <iterator>
+
+
+namespace triggersim {
+
+  class TriggerCollection {
+
+  public:
+
+    // Constructor...
+    TriggerCollection();
+
+    // Add a trigger.
+    void push_back(bool trigdecision, unsigned int trigtype, unsigned int trigsubtype,
+                   Hardware::HardwareID const& hardwareid, double time = 0.0);
+    void push_back(BasicTrigger const& trig, double time = 0.0);
+
+    // Size management.
+    unsigned int size() const { return fTimes.size(); }
+    bool empty() const { return fTimes.empty(); }
+    void reserve(unsigned int n);
+    void clear();
+
+    // Per-trigger access.
+    bool                 TrigDecision(unsigned int i) const { return fDecisions[i]; }
+    unsigned int         TrigType(unsigned int i)     const { return fTypes[i]; }
+    unsigned int         TrigSubType(unsigned int i)  const { return fSubTypes[i]; }
+    double               Time(unsigned int i)         const { return fTimes[i]; }
+    Hardware::ID         ElementID(unsigned int i)    const { return fElementIDs[i]; }
+    std::string const&   ElementType(unsigned int i)  const { return fElementTypeNames[fElementTypes[i]]; }
+    Hardware::HardwareID TrigHardwareID(unsigned int i) const;
+
+    // Columns.
+    std::vector<unsigned char> const& TrigDecisions() const { return fDecisions; }
+    std::vector<unsigned int>  const& TrigTypes()     const { return fTypes; }
+    std::vector<unsigned int>  const& TrigSubTypes()  const { return fSubTypes; }
+    std::vector<double>        const& Times()         const { return fTimes; }
+    std::vector<Hardware::ID>  const& ElementIDs()    const { return fElementIDs; }
+
+    // Adapter to BasicTrigger.
+    BasicTrigger at(unsigned int i) const;
+
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = BasicTrigger;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = BasicTrigger;
+      const_iterator(TriggerCollection const* pcol, unsigned int i) : fCol(pcol), fIndex(i) {}
+      BasicTrigger operator*() const { return fCol->at(fIndex); }
+      const_iterator& operator++() { ++fIndex; return *this; }
+      const_iterator operator++(int) { const_iterator old = *this; ++fIndex; return old; }
+      bool operator==(const_iterator const& rhs) const { return fIndex == rhs.fIndex && fCol == rhs.fCol; }
+      bool operator!=(const_iterator const& rhs) const { return !(*this == rhs); }
+      unsigned int index() const { return fIndex; }
+    private:
+      TriggerCollection const* fCol;
+      unsigned int fIndex;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+  private:
+
+    // Index of an element type name, adding it if needed.
+    unsigned char elementTypeIndex(std::string const& type);
+
+    // Parameters:
+    std::vector<unsigned char> fDecisions;         ///< trigger decisions
+    std::vector<unsigned int>  fTypes;             ///< trigger types (see TriggerTypes.h)
+    std::vector<unsigned int>  fSubTypes;          ///< trigger subtypes (see TriggerTypes.h)
+    std::vector<double>        fTimes;             ///< trigger times
+    std::vector<Hardware::ID>  fElementIDs;        ///< hardware element IDs
+    std::vector<unsigned char> fElementTypes;      ///< index into fElementTypeNames
+    std::vector<std::string>   fElementTypeNames;  ///< distinct hardware element types
+
+  };
+} // end namespace triggersim
+
+#endif
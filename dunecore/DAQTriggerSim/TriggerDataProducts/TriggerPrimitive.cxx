@@ -0,0 +1,59 @@
+// TriggerPrimitive.cxx
+//
+// Trigger primitive data product for the DAQ trigger framework.
+//
+
+// DUNETPC specific includes
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerPrimitive.h"
+
+// C++ includes
+#include <iostream>
+
+namespace triggersim {
+
+  //----------------------------------------------------------------------
+  TriggerPrimitive::TriggerPrimitive(unsigned int channel,
+                                     unsigned int starttick,
+                                     unsigned int timeoverthreshold,
+                                     unsigned int peaktick,
+                                     float peakadc,
+                                     float adcintegral):
+    fChannel(channel),
+    fStartTick(starttick),
+    fTimeOverThreshold(timeoverthreshold),
+    fPeakTick(peaktick),
+    fPeakADC(peakadc),
+    fADCIntegral(adcintegral)
+  {}
+
+
+
+  //----------------------------------------------------------------------
+  // ostream operator.
+  //
+#ifndef __GCCXML__
+  std::ostream& operator << (std::ostream& o, TriggerPrimitive const& tp) {
+
+    o << "TP Channel           = " << tp.Channel()           << std::endl;
+    o << "TP Start Tick        = " << tp.StartTick()         << std::endl;
+    o << "TP Time Over Thresh. = " << tp.TimeOverThreshold() << std::endl;
+    o << "TP Peak Tick         = " << tp.PeakTick()          << std::endl;
+    o << "TP Peak ADC          = " << tp.PeakADC()           << std::endl;
+    o << "TP ADC Integral      = " << tp.ADCIntegral()       << std::endl;
+    return o;
+
+  }
+
+
+
+  //----------------------------------------------------------------------
+  // < operator: order by start time and then channel.
+  //
+  bool operator < (TriggerPrimitive const& a, TriggerPrimitive const& b) {
+
+    if ( a.StartTick() != b.StartTick() ) return a.StartTick() < b.StartTick();
+    return a.Channel() < b.Channel();
+
+  }
+#endif //__GCCXML__
+} // end namespace triggersim
@@ -0,0 +1,72 @@
+// TriggerPrimitive.h
+//
+// Trigger primitive data product for the DAQ trigger framework.
+//
+// A trigger primitive is a compact hit candidate on one TPC channel: the
+// ticks where the pedestal-subtracted ADC is at or above threshold, with
+// the peak and the integrated charge. Trigger algorithms can consume these
+// instead of the full raw::RawDigit waveforms.
+//
+
+#ifndef TRIGGERPRIMITIVE_H
+#define TRIGGERPRIMITIVE_H
+
+// C++ includes
+#include <vector>
+
+#ifndef __GCCXML__
+#include <iosfwd> // std::ostream
+#endif
+
+
+namespace triggersim {
+
+  class TriggerPrimitive {
+
+  public:
+
+    // Constructor...
+    TriggerPrimitive(unsigned int channel = 0,
+                     unsigned int starttick = 0,
+                     unsigned int timeoverthreshold = 0,
+                     unsigned int peaktick = 0,
+                     float peakadc = 0.0,
+                     float adcintegral = 0.0);
+
+    // Channel number.
+    unsigned int Channel() const { return fChannel; }
+
+    // Tick at which the ADC first reached threshold.
+    unsigned int StartTick() const { return fStartTick; }
+
+    // Number of ticks at or above threshold.
+    unsigned int TimeOverThreshold() const { return fTimeOverThreshold; }
+
+    // Tick of the largest ADC value.
+    unsigned int PeakTick() const { return fPeakTick; }
+
+    // Largest pedestal-subtracted ADC value.
+    float PeakADC() const { return fPeakADC; }
+
+    // Sum of the pedestal-subtracted ADC values over threshold.
+    float ADCIntegral() const { return fADCIntegral; }
+
+#ifndef __GCCXML__
+    friend std::ostream& operator << (std::ostream& o, TriggerPrimitive const& tp);
+    friend bool          operator <  (TriggerPrimitive const& a, TriggerPrimitive const& b);
+#endif //__GCCXML__
+
+  private:
+
+    // Parameters:
+    unsigned int fChannel;            ///< TPC channel number
+    unsigned int fStartTick;          ///< first tick at or above threshold
+    unsigned int fTimeOverThreshold;  ///< number of ticks at or above threshold
+    unsigned int fPeakTick;           ///< tick of the peak ADC
+    float        fPeakADC;            ///< peak pedestal-subtracted ADC
+    float        fADCIntegral;        ///< summed pedestal-subtracted ADC
+
+  };
+} // end namespace triggersim
+
+#endif
@@ -15,3 +15,5 @@
 // DUNETPC includes:
 #include "dunecore/DAQTriggerSim/TriggerDataProducts/BasicTrigger.h"
 #include "dunecore/DAQTriggerSim/TriggerDataProducts/HardwareElements.h"
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerPrimitive.h"
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerCollection.h"
@@ -38,9 +38,16 @@
 // DUNETPC specific includes
 #include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerTypes.h"
 #include "dunecore/DAQTriggerSim/TriggerDataProducts/BasicTrigger.h"
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerCollection.h"
 
 // The trigger classes which you're including
 #include "dunecore/DAQTriggerSim/TriggerAlgorithms/ActivityTrigger.h"
+#include "dunecore/DAQTriggerSim/Service/HardwareMapperService.h"
+
+// For the per-APA triggers
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include <algorithm>
 
 namespace triggersim { // Declare that we are working in the triggersim namespace
 
@@ -76,7 +83,15 @@ namespace triggersim { // Declare that we are working in the triggersim namespac
     std::string fAString;
     std::string fRawDigitLabel;
     std::string fOpDetWaveLabel;
+    bool        fPerAPATriggers;    ///< Also make one TPC trigger for each APA
+    bool        fMakeTriggerCollection; ///< Also put the triggers in the event as a TriggerCollection
     // Your fcl params to send to the trigger functions...  
+
+    // --- One trigger object per APA so the APAs can be evaluated concurrently.
+    std::vector<ActivityTrigger> fAPATrigs;
+
+    // Make the TPC triggers for each APA and append them to triggers in time order.
+    void TriggerOnAPAs(const std::vector<raw::RawDigit>& rawdigits, std::vector<triggersim::BasicTrigger>& triggers);
   };
 
   //......................................................
@@ -87,6 +102,7 @@ namespace triggersim { // Declare that we are working in the triggersim namespac
     produces< std::vector<triggersim::BasicTrigger> >();
     // --- Configure my trigger module.
     this->reconfigure(pset);
+    if (fMakeTriggerCollection) produces< triggersim::TriggerCollection >();
     // --- Configure my trigger class.
     TempTrig.Configure( pset );
   }
@@ -100,12 +116,15 @@ namespace triggersim { // Declare that we are working in the triggersim namespac
     fAString        = pset.get<std::string> ("AString");
     fRawDigitLabel  = pset.get<std::string> ("RawDigitLabel");
     fOpDetWaveLabel = pset.get<std::string> ("OpDetWaveLabel");
+    fPerAPATriggers = pset.get<bool>        ("PerAPATriggers", false);
+    fMakeTriggerCollection = pset.get<bool> ("MakeTriggerCollection", false);
 
     // To convince ourselves that they have been set, print them out...
     std::cout << "\n------In my Activity Trigger module------\nThe fcl params have been set to :"
 	      << "\n  fAString:        " << fAString
 	      << "\n  fRawDigitLabel:  " << fRawDigitLabel
 	      << "\n  fOpDetWaveLabel: " << fOpDetWaveLabel
+	      << "\n  fPerAPATriggers: " << fPerAPATriggers
 	      << "\n-------------------------------\n"
 	      << std::endl;
   }
@@ -167,6 +186,12 @@ namespace triggersim { // Declare that we are working in the triggersim namespac
 
     std::cout << "I have now left my trigger, it's decision was " << TPCTrigDec << ".\n" << std::endl;
 
+    // --- Optionally make a TPC trigger for each APA.
+    if (fPerAPATriggers) {
+      std::cout << "\nLet's trigger on the TPC info in each APA...." << std::endl;
+      TriggerOnAPAs( *rawdigits, *triggers );
+    }
+
     // **************************************************
     // ******** Trigger on the OpDetWaveform info *******
     // **************************************************
@@ -214,9 +239,67 @@ namespace triggersim { // Declare that we are working in the triggersim namespac
     // **************************************************
     // ******* Now put all of that into the event *******
     // **************************************************
+    if (fMakeTriggerCollection) {
+      // --- The columnar copy takes the time from the first metric, if there is one.
+      auto trigcol = std::make_unique<triggersim::TriggerCollection>();
+      trigcol->reserve(triggers->size());
+      for (const triggersim::BasicTrigger& trig : *triggers) {
+        const std::vector<double> metrics = trig.Metrics();
+        trigcol->push_back(trig, metrics.empty() ? 0.0 : metrics[0]);
+      }
+      event.put(std::move(trigcol));
+    }
     event.put(std::move(triggers));
 
   } // ActivityTriggerProd::produce()
+  //......................................................
+  void ActivityTriggerProd::TriggerOnAPAs(const std::vector<raw::RawDigit>& rawdigits,
+                                          std::vector<triggersim::BasicTrigger>& triggers)
+  {
+    art::ServiceHandle<HardwareMapperService> hardwareMapper;
+    const Hardware::DenseMap& apas = hardwareMapper->getDenseAPAMap();
+    const size_t napa = apas.getNElements();
+
+    // --- Split the digits by APA with the dense channel table.
+    std::vector< std::vector<const raw::RawDigit*> > apaDigits(napa);
+    for (const raw::RawDigit& digit : rawdigits) {
+      unsigned int iapa = apas.getIndex(digit.Channel());
+      if (iapa < napa) apaDigits[iapa].push_back(&digit);
+    }
+
+    // --- Make the per-APA trigger objects from the configured one, building the
+    //     collection mask once, outside the parallel loop.
+    if (fAPATrigs.size() != napa) {
+      TempTrig.CollectionMask();
+      fAPATrigs.assign(napa, TempTrig);
+    }
+
+    // --- The APAs are independent so evaluate them concurrently.
+    std::vector<triggersim::BasicTrigger> apaTriggers(napa);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, napa),
+                      [&](const tbb::blocked_range<size_t>& r) {
+      for (size_t iapa=r.begin(); iapa!=r.end(); ++iapa) {
+        bool dec = fAPATrigs[iapa].TriggerOnTPC( apaDigits[iapa] );
+        triggersim::BasicTrigger& trig = apaTriggers[iapa];
+        trig = triggersim::BasicTrigger( dec, triggersim::kActivity, triggersim::kColAPAHits,
+                                         Hardware::HardwareID(apas.getID(iapa), "APA") );
+        trig.setMetric( fAPATrigs[iapa].TriggerTick() );
+      }
+    });
+
+    // --- Merge in order of trigger time, keeping the APA order for equal times.
+    std::stable_sort(apaTriggers.begin(), apaTriggers.end(),
+                     [](const triggersim::BasicTrigger& lhs, const triggersim::BasicTrigger& rhs) {
+                       return lhs.Metric(0) < rhs.Metric(0);
+                     });
+    unsigned int nfired = 0;
+    for (const triggersim::BasicTrigger& trig : apaTriggers) {
+      if (trig.TrigDecision()) ++nfired;
+      triggers.push_back(trig);
+    }
+    std::cout << "I have now left my APA triggers, " << nfired << " of " << napa << " APAs triggered.\n" << std::endl;
+  }
+
   //......................................................
   // If you want to another function...
 
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////
+// Class:       TriggerPrimitiveProd
+// Module Type: producer
+// File:        TriggerPrimitiveProd_module.cc
+//
+// Makes the trigger primitives for the TPC raw digits with
+// TriggerPrimitiveFinder so that later trigger stages can run on the
+// compact primitives instead of the full waveforms.
+//
+////////////////////////////////////////////////////////////////////////
+
+// Framework includes
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "lardataobj/RawData/RawDigit.h"
+
+// DUNETPC specific includes
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerPrimitive.h"
+#include "dunecore/DAQTriggerSim/TriggerAlgorithms/TriggerPrimitiveFinder.h"
+
+// C++ includes
+#include <memory>
+#include <algorithm>
+
+namespace triggersim { // Declare that we are working in the triggersim namespace
+
+  class TriggerPrimitiveProd : public art::EDProducer {
+
+  public:
+
+    explicit TriggerPrimitiveProd(fhicl::ParameterSet const & pset);
+
+    // Plugins should not be copied or assigned.
+    TriggerPrimitiveProd(TriggerPrimitiveProd const &) = delete;
+    TriggerPrimitiveProd(TriggerPrimitiveProd &&) = delete;
+    TriggerPrimitiveProd & operator = (TriggerPrimitiveProd const &) = delete;
+    TriggerPrimitiveProd & operator = (TriggerPrimitiveProd &&) = delete;
+
+    // The main guts...
+    void produce(art::Event& event) override;
+
+  private:
+
+    // declare fcl input variables here
+    std::string fRawDigitLabel;
+    bool        fSortPrimitives;
+
+    TriggerPrimitiveFinder fFinder;
+  };
+
+  //......................................................
+  TriggerPrimitiveProd::TriggerPrimitiveProd(fhicl::ParameterSet const & pset): EDProducer{pset},
+    fRawDigitLabel(pset.get<std::string> ("RawDigitLabel")),
+    fSortPrimitives(pset.get<bool> ("SortPrimitives", false))
+  {
+    // --- Declare what this module is puttting in the art event.
+    produces< std::vector<triggersim::TriggerPrimitive> >();
+    // --- Configure the primitive finder.
+    fFinder.Configure( pset );
+  }
+
+  //......................................................
+  void TriggerPrimitiveProd::produce(art::Event& event)
+  {
+    auto tps = std::make_unique< std::vector<triggersim::TriggerPrimitive> >();
+
+    // --- Lift out the TPC raw digits:
+    auto rawdigits = event.getValidHandle<std::vector<raw::RawDigit> >(fRawDigitLabel);
+    if ( rawdigits.failedToGet() )
+      mf::LogError("TriggerPrimitive_Producer") << "The raw::RawDigit you gave me " << fRawDigitLabel << " is not in the event..." << std::endl;
+    else
+      fFinder.FindPrimitives( *rawdigits, *tps );
+
+    // --- Optionally order by time for algorithms that scan in time.
+    if ( fSortPrimitives ) std::sort(tps->begin(), tps->end());
+
+    mf::LogInfo("TriggerPrimitive_Producer") << "Found " << tps->size() << " trigger primitives.";
+
+    event.put(std::move(tps));
+  } // TriggerPrimitiveProd::produce()
+
+  //......................................................
+  DEFINE_ART_MODULE(TriggerPrimitiveProd)
+} // namespace triggersim
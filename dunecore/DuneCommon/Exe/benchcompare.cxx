@@ -0,0 +1,132 @@
+// benchcompare.cxx
+//
+// Executable that lists the benchmark results in a BenchmarkDB file and compares
+// a run with a baseline.
+//
+// The benchmarks (bench_FFT, bench_GeometryDune, wib2decodebench, dataprepbench)
+// add their results when run with
+//   DUNE_BENCH_DB=FILE DUNE_BENCH_RUN=RUN
+// The return status of a comparison is 2 if any kernel regressed so that the
+// command can be used as a release check.
+
+#include "dunecore/DuneCommon/Utility/BenchmarkDB.h"
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::setw;
+using std::vector;
+
+using Index = BenchmarkDB::Index;
+
+namespace {
+
+int help(string prog) {
+  cout << "Usage: " << prog << " [-t RELTOL] [-s NSIG] [-a] FILE [BASE [RUN]]" << endl;
+  cout << "  Without BASE, lists the runs in benchmark database FILE." << endl;
+  cout << "  With BASE only, lists the results for that run." << endl;
+  cout << "  With BASE and RUN, compares RUN with baseline BASE and flags the" << endl;
+  cout << "  kernels whose relative change exceeds the larger of RELTOL and NSIG" << endl;
+  cout << "  times the combined relative spread of the two results." << endl;
+  cout << "  -t - Relative tolerance RELTOL [0.05]" << endl;
+  cout << "  -s - Number of spreads NSIG [3]" << endl;
+  cout << "  -a - Show all comparisons, not only the flagged ones." << endl;
+  return 0;
+}
+
+}  // end unnamed namespace
+
+int main(int argc, char** argv) {
+  const string myname = "benchcompare: ";
+  string prog = argv[0];
+  double reltol = 0.05;
+  double nsig = 3.0;
+  bool showAll = false;
+  vector<string> args;
+  for ( int iarg=1; iarg<argc; ++iarg ) {
+    string sarg = argv[iarg];
+    if ( sarg == "-h" ) return help(prog);
+    if ( sarg == "-a" ) {
+      showAll = true;
+    } else if ( sarg == "-t" || sarg == "-s" ) {
+      if ( iarg + 1 >= argc ) {
+        cout << myname << "ERROR: Option " << sarg << " requires a value." << endl;
+        return 1;
+      }
+      double val = std::stod(argv[++iarg]);
+      if ( sarg == "-t" ) reltol = val;
+      else nsig = val;
+    } else if ( sarg.size() > 1 && sarg[0] == '-' ) {
+      cout << myname << "ERROR: Invalid option: " << sarg << endl;
+      return 1;
+    } else {
+      args.push_back(sarg);
+    }
+  }
+  if ( args.empty() || args.size() > 3 ) return help(prog);
+  BenchmarkDB db(args[0], true);
+  if ( ! db.isValid() ) return 1;
+
+  if ( args.size() == 1 ) {
+    for ( const string& run : db.runs() ) {
+      cout << setw(30) << std::left << run << std::right << setw(8) << db.results(run).size()
+           << " results" << endl;
+    }
+    return 0;
+  }
+
+  if ( args.size() == 2 ) {
+    BenchmarkDB::ResultVector ress = db.results(args[1]);
+    if ( ress.empty() ) {
+      cout << myname << "ERROR: No results for run " << args[1] << endl;
+      return 1;
+    }
+    for ( const BenchmarkDB::Result& res : ress ) {
+      cout << setw(60) << std::left << res.kernel << " " << setw(8) << res.metric << std::right
+           << setw(14) << res.value << " +- " << setw(10) << std::left << res.spread
+           << " " << res.unit << std::right << endl;
+    }
+    return 0;
+  }
+
+  string base = args[1];
+  string run = args[2];
+  BenchmarkDB::ComparisonVector cmps = db.compare(base, run, reltol, nsig);
+  if ( cmps.empty() ) {
+    cout << myname << "ERROR: No results for runs " << base << " and " << run << endl;
+    return 1;
+  }
+  Index nreg = 0;
+  Index nimp = 0;
+  Index nunc = 0;
+  Index noth = 0;
+  cout << myname << "Comparing " << run << " with baseline " << base << endl;
+  for ( const BenchmarkDB::Comparison& cmp : cmps ) {
+    if      ( cmp.status == BenchmarkDB::Regressed ) ++nreg;
+    else if ( cmp.status == BenchmarkDB::Improved )  ++nimp;
+    else if ( cmp.status == BenchmarkDB::Unchanged ) ++nunc;
+    else ++noth;
+    if ( cmp.status == BenchmarkDB::Unchanged && ! showAll ) continue;
+    cout << setw(10) << std::left << BenchmarkDB::statusName(cmp.status) << " "
+         << setw(60) << cmp.kernel << " " << setw(8) << cmp.metric << std::right;
+    if ( cmp.status == BenchmarkDB::Added ) {
+      cout << setw(14) << cmp.value << " " << cmp.unit << endl;
+    } else if ( cmp.status == BenchmarkDB::Removed ) {
+      cout << setw(14) << cmp.baseValue << " " << cmp.unit << endl;
+    } else {
+      cout << setw(14) << cmp.baseValue << " -> " << setw(14) << cmp.value
+           << " " << setw(12) << std::left << cmp.unit << std::right
+           << std::fixed << std::setprecision(1) << setw(8) << 100.0*cmp.change << "% (threshold "
+           << 100.0*cmp.threshold << "%)" << endl;
+      cout.unsetf(std::ios_base::floatfield);
+      cout << std::setprecision(6);
+    }
+  }
+  cout << myname << "Regressed: " << nreg << ", improved: " << nimp << ", unchanged: " << nunc
+       << ", added or removed: " << noth << endl;
+  return nreg ? 2 : 0;
+}
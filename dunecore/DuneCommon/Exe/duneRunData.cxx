@@ -3,7 +3,8 @@
 // David Adams
 // May 2018
 //
-// Executable that displays the run data for a run.
+// Executable that displays the run data for one or more runs.
+// The data for all the runs are prefetched in parallel.
 
 #include <string>
 #include <iostream>
@@ -22,7 +23,7 @@ int main(int argc, char** argv) {
   const string myname = "duneRunData: ";
   bool help = false;
   bool longhelp = false;
-  unsigned int irun = 0;
+  RunDataTool::IndexVector runs;
   bool verbose = false;
   string detname = "protodune";
   string fname;
@@ -41,20 +42,23 @@ int main(int argc, char** argv) {
       } else if ( sarg == "-v" ) {
         verbose = true;
       } else {
+        unsigned int irun = 0;
         istringstream ssarg(sarg);
         ssarg >> irun;
         if ( irun == 0 ) {
           cout << myname << "ERROR: Invalid argument: " << sarg << endl;
           return 1;
         }
+        runs.push_back(irun);
       }
     }
   } else {
     help = true;
   } 
+  if ( runs.empty() ) help = true;
   if ( help ) {
-    cout << "Usage: duneRunData [-h] [-v] [-c FCLFILE] RUN" << endl;
-    cout << "  Displays the fcl-based run info for run RUN." << endl;
+    cout << "Usage: duneRunData [-h] [-v] [-c FCLFILE] RUN [RUN ...]" << endl;
+    cout << "  Displays the fcl-based run info for each run RUN." << endl;
     cout << "  -h - Display short help message." << endl;
     cout << "  -H - Display long help message." << endl;
     cout << "  -d - Detector: protodune, hdcb, ..."  << endl;
@@ -84,12 +88,16 @@ int main(int argc, char** argv) {
     cout << myname << "ERROR: Unable to find RunDataTool " << tname << endl;
     return 1;
   }
-  RunData rdat = prdt->runData(irun);
-  if ( rdat.isValid() ) {
-    cout << rdat << endl;
-  } else {
-    cout << myname << "Unable to find " << detname << " run " << irun << endl;
-    return 2;
+  if ( runs.size() > 1 ) prdt->prefetch(runs);
+  int rstat = 0;
+  for ( unsigned int irun : runs ) {
+    RunData rdat = prdt->runData(irun);
+    if ( rdat.isValid() ) {
+      cout << rdat << endl;
+    } else {
+      cout << myname << "Unable to find " << detname << " run " << irun << endl;
+      rstat = 2;
+    }
   }
-  return 0;
+  return rstat;
 }
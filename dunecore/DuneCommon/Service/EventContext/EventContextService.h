@@ -7,6 +7,9 @@
 //
 // Configuration:
 //   LogLevel - 0=quiet, 1=init, 2=run change, 3=event change
+//   PerSchedule - If true, the context for each event is set in the DuneContextManager
+//                 slot for its schedule and each module is bound to the slot of the
+//                 schedule it runs in. Otherwise (default) the global slot is used.
 
 #ifndef EventContextService_H
 #define EventContextService_H
@@ -20,6 +23,7 @@ namespace art {
   class Run;
   class Event;
   class ScheduleContext;
+  class ModuleContext;
 }
 
 class EventContextService {
@@ -39,7 +43,13 @@ private:
   // React to new event.
   void postSourceEvent(const art::Event&, art::ScheduleContext);
 
+  // Bind the thread running a module to the context slot for its schedule and
+  // restore the binding after.
+  void preModule(const art::ModuleContext&);
+  void postModule(const art::ModuleContext&);
+
   Index m_LogLevel;
+  bool m_PerSchedule;
 
 };
 
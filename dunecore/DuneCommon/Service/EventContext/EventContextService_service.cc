@@ -4,6 +4,8 @@
 #include "dunecore/DuneInterface/Data/DuneEventInfo.h"
 #include "dunecore/DuneCommon/Utility/DuneContextManager.h"
 #include "art/Framework/Principal/Event.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
 #include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
 
 using std::string;
@@ -11,23 +13,36 @@ using std::cout;
 using std::endl;
 using art::Timestamp;
 
+namespace {
+
+// Slot bound by the thread before the current module.
+thread_local EventContextService::Index oldSlot = DuneContextManager::globalSlot();
+
+}
+
 //**********************************************************************
 
 EventContextService::EventContextService(const fhicl::ParameterSet& ps, art::ActivityRegistry& reg)
-: m_LogLevel(ps.get<Index>("LogLevel")) {
+: m_LogLevel(ps.get<Index>("LogLevel")),
+  m_PerSchedule(ps.get<bool>("PerSchedule", false)) {
   reg.sPostSourceEvent.watch(this, &EventContextService::postSourceEvent);
+  if ( m_PerSchedule ) {
+    reg.sPreModule.watch(this, &EventContextService::preModule);
+    reg.sPostModule.watch(this, &EventContextService::postModule);
+  }
 }
 
 //**********************************************************************
 
-void EventContextService::postSourceEvent(const art::Event& evt, art::ScheduleContext) {
+void EventContextService::postSourceEvent(const art::Event& evt, art::ScheduleContext sc) {
   string myname = "EventContextService::postSourceEvent: ";
   DuneContextManager* pcm = DuneContextManager::instance();
   if ( pcm == nullptr ) {
     cout << myname << "WARNING: Context manager not found." << endl;
     return;
   }
-  const DuneContext* pctx = pcm->context();
+  Index islot = m_PerSchedule ? Index(sc.id().id()) : DuneContextManager::globalSlot();
+  const DuneContext* pctx = pcm->context(islot);
   bool haveOldContext = pctx != nullptr;
   Index irunOld = haveOldContext ? pctx->getRun() : 0;
   Index ievtOld = haveOldContext ? pctx->getEvent() : 0;
@@ -51,7 +66,20 @@ void EventContextService::postSourceEvent(const art::Event& evt, art::ScheduleCo
   } else if ( m_LogLevel >= 2 && irun != irunOld ) {
     cout << myname << "INFO: Run-event " << irun << "-" << ievt << endl;
   }
-  pcm->setContext(new DuneEventInfo(irun, ievt, isru, itim, itimrem));
+  pcm->setContext(islot, new DuneEventInfo(irun, ievt, isru, itim, itimrem));
+}
+
+//**********************************************************************
+
+void EventContextService::preModule(const art::ModuleContext& mc) {
+  oldSlot = DuneContextManager::currentSlot();
+  DuneContextManager::bindSlot(mc.scheduleID().id());
+}
+
+//**********************************************************************
+
+void EventContextService::postModule(const art::ModuleContext&) {
+  DuneContextManager::bindSlot(oldSlot);
 }
 
 //**********************************************************************
@@ -36,17 +36,22 @@ public:
   // Print parameters.
   std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const;
 
+  // Return the lookup with the channel ranges for each group.
+  const IndexRangeLookup* lookup() const { return &m_lookup; }
+
+  // Return the group-contiguous channel order.
+  const ChannelOrder* order() const { return &m_order; }
+
 private:
 
-  typedef std::vector<Name> NameVector;
-  typedef std::vector<ChannelVector> ChannelVectorVector;
- 
   //Index m_size; // unused
   NameVector m_names;
   ChannelVectorVector m_chanvecs;
+  IndexRangeLookup m_lookup;
+  ChannelOrder m_order;
 
 };
 
-DECLARE_ART_SERVICE_INTERFACE_IMPL(FixedChannelGroupService, ChannelGroupService, LEGACY)
+DECLARE_ART_SERVICE_INTERFACE_IMPL(FixedChannelGroupService, ChannelGroupService, SHARED)
 
 #endif
@@ -31,6 +31,8 @@ FixedChannelGroupService(fhicl::ParameterSet const& pset) {
     m_names.push_back(name);
     m_chanvecs.emplace_back(move(chans));
   }
+  m_lookup = makeLookup(m_names, m_chanvecs);
+  m_order = makeOrder(m_chanvecs);
 }
 
 //**********************************************************************
@@ -83,6 +83,8 @@ GeoApaChannelGroupService(fhicl::ParameterSet const& pset)
     }
   }
   m_size = ngrp;
+  m_lookup = makeLookup(m_names, m_chanvecs);
+  m_order = makeOrder(m_chanvecs);
 }
 
 //**********************************************************************
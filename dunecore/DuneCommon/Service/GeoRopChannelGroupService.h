@@ -37,19 +37,24 @@ public:
   // Print parameters.
   std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const;
 
+  // Return the lookup with the channel ranges for each group.
+  const IndexRangeLookup* lookup() const { return &m_lookup; }
+
+  // Return the group-contiguous channel order.
+  const ChannelOrder* order() const { return &m_order; }
+
 private:
 
-  typedef std::vector<Name> NameVector;
-  typedef std::vector<ChannelVector> ChannelVectorVector;
- 
   art::ServiceHandle<geo::Geometry> m_pgeo;
 
   Index m_size;
   NameVector m_names;
   ChannelVectorVector m_chanvecs;
+  IndexRangeLookup m_lookup;
+  ChannelOrder m_order;
 
 };
 
-DECLARE_ART_SERVICE_INTERFACE_IMPL(GeoRopChannelGroupService, ChannelGroupService, LEGACY)
+DECLARE_ART_SERVICE_INTERFACE_IMPL(GeoRopChannelGroupService, ChannelGroupService, SHARED)
 
 #endif
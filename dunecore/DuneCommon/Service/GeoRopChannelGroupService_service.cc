@@ -91,6 +91,8 @@ GeoRopChannelGroupService(fhicl::ParameterSet const& pset)
     }
   }
   m_size = krop;
+  m_lookup = makeLookup(m_names, m_chanvecs);
+  m_order = makeOrder(m_chanvecs);
 }
 
 //**********************************************************************
@@ -22,7 +22,8 @@ using std::endl;
 ToolBasedChannelStatus::ToolBasedChannelStatus(fhicl::ParameterSet const& ps)
 : m_LogLevel(ps.get<Index>("LogLevel")),
   m_NChannel(ps.get<Index>("NChannel")),
-  m_ToolName(ps.get<Name>("ToolName")) {
+  m_ToolName(ps.get<Name>("ToolName")),
+  m_imt(DuneToolManager::instance()->sharedHandle<IndexMapTool>(m_ToolName)) {
   Name myname = "ToolBasedChannelStatus::ctor: ";
   bool havetool = indexMap() != nullptr;
   Name msg = havetool ? "INFO: Channel status tool is present." : "WARNING: Channel status tool not found.";
@@ -43,31 +44,32 @@ bool ToolBasedChannelStatus::IsPresent(ChannelID channel) const {
 //**********************************************************************
 
 bool ToolBasedChannelStatus::IsGood(ChannelID channel) const {
-  return channelIsGood(indexMap(), channel);
+  return statusIsGood(channelStatus(channel));
 }
 
 //**********************************************************************
 
 bool ToolBasedChannelStatus::IsBad(ChannelID channel) const {
-  return channelIsBad(indexMap(), channel);
+  return statusIsBad(channelStatus(channel));
 }
 
 //**********************************************************************
 
 bool ToolBasedChannelStatus::IsNoisy(ChannelID channel) const {
-  return channelIsNoisy(indexMap(), channel);
+  return statusIsNoisy(channelStatus(channel));
 }
 
 //**********************************************************************
 
 ToolBasedChannelStatus::Status_t
 ToolBasedChannelStatus::Status(ChannelID chan) const {
-  return indexMapStatus(indexMap(), chan);
+  return channelStatus(chan);
 }
 
 //**********************************************************************
 
 ToolBasedChannelStatus::ChannelSet ToolBasedChannelStatus::GoodChannels() const {
+  if ( haveStatus() ) return snapshotChannels(ChannelStatusSnapshot::Good);
   const IndexMapTool* pimt = indexMap();
   if ( pimt == nullptr ) return ChannelSet();
   ChannelSet chans;
@@ -80,6 +82,7 @@ ToolBasedChannelStatus::ChannelSet ToolBasedChannelStatus::GoodChannels() const
 //**********************************************************************
 
 ToolBasedChannelStatus::ChannelSet ToolBasedChannelStatus::BadChannels() const {
+  if ( haveStatus() ) return snapshotChannels(ChannelStatusSnapshot::Bad);
   const IndexMapTool* pimt = indexMap();
   if ( pimt == nullptr ) return ChannelSet();
   ChannelSet chans;
@@ -92,6 +95,7 @@ ToolBasedChannelStatus::ChannelSet ToolBasedChannelStatus::BadChannels() const {
 //**********************************************************************
 
 ToolBasedChannelStatus::ChannelSet ToolBasedChannelStatus::NoisyChannels() const {
+  if ( haveStatus() ) return snapshotChannels(ChannelStatusSnapshot::Noisy);
   const IndexMapTool* pimt = indexMap();
   if ( pimt == nullptr ) return ChannelSet();
   ChannelSet chans;
@@ -103,10 +107,57 @@ ToolBasedChannelStatus::ChannelSet ToolBasedChannelStatus::NoisyChannels() const
 
 //**********************************************************************
 
+int ToolBasedChannelStatus::loadStatus() {
+  Name myname = "ToolBasedChannelStatus::loadStatus: ";
+  const IndexMapTool* pimt = indexMap();
+  if ( pimt == nullptr ) {
+    clearStatus();
+    cout << myname << "WARNING: Channel status tool not found." << endl;
+    return 1;
+  }
+  SnapshotPtr psnap = ChannelStatusSnapshot::fromIndexMap(pimt, m_NChannel + 1, m_snapshot);
+  if ( psnap == m_snapshot ) {
+    if ( m_LogLevel >= 2 ) {
+      cout << myname << "Status is unchanged (hash " << std::hex << psnap->contentHash()
+           << std::dec << ")." << endl;
+    }
+    return 0;
+  }
+  m_snapshot = psnap;
+  for ( Index icat=0; icat<ChannelStatusSnapshot::NCategory; ++icat ) {
+    ChannelSet& chans = m_channelSets[icat];
+    chans.clear();
+    for ( Index icha : m_snapshot->channels(ChannelStatusSnapshot::Category(icat)) ) {
+      chans.emplace_hint(chans.end(), icha);
+    }
+  }
+  if ( m_LogLevel >= 2 ) {
+    cout << myname << "Loaded status for " << m_snapshot->size() << " channels: "
+         << m_snapshot->count(ChannelStatusSnapshot::Bad) << " bad, "
+         << m_snapshot->count(ChannelStatusSnapshot::Noisy) << " noisy." << endl;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+void ToolBasedChannelStatus::clearStatus() {
+  m_snapshot.reset();
+  for ( ChannelSet& chans : m_channelSets ) chans.clear();
+}
+
+//**********************************************************************
+
+Index ToolBasedChannelStatus::channelStatus(Index chan) const {
+  if ( m_snapshot && m_snapshot->hasChannel(chan) ) return m_snapshot->status(chan);
+  return indexMapStatus(indexMap(), chan);
+}
+
+//**********************************************************************
+
 const IndexMapTool* ToolBasedChannelStatus::indexMap() const {
   Name myname = "ToolBasedChannelStatus::indexMap: ";
-  auto pimt = DuneToolManager::instance()->getShared<IndexMapTool>(m_ToolName);
-  auto pimt_bare = pimt ? &*pimt : nullptr;
+  const IndexMapTool* pimt_bare = m_imt.get();
   if ( m_LogLevel >= 3 ) {
     cout << myname << "Fetched tool " << m_ToolName << " @ " << std::hex << pimt_bare << std::dec << endl;
   }
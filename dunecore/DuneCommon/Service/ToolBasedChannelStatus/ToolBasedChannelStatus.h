@@ -6,6 +6,15 @@
 // Channel status provider that takse the lists of good, band and noisy
 // channel from an index map tool.
 //
+// The status of all channels may be loaded from the tool with loadStatus, e.g. at
+// the start of each run, into an immutable ChannelStatusSnapshot so that queries
+// read its dense arrays. Until then, queries are passed to the tool. The snapshot
+// is shared with clients through snapshot().
+//
+// Reloading keeps the current snapshot, and the good, bad and noisy channel sets
+// derived from it, if the tool status is unchanged, so run transitions with the
+// same status make no new copy.
+//
 // Parameters:
 //   LogLevel: 0 for silent, 1 for init, ...
 //   NChannel: Valid channels are {0, 1, ..., NChannel-1}
@@ -16,7 +25,10 @@
 
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
+#include "dunecore/ArtSupport/DuneToolManager.h"
+#include "dunecore/DuneCommon/Utility/ChannelStatusSnapshot.h"
 #include <string>
+#include <vector>
 #include <memory> // std::unique_ptr<>
 
 // Utility libraries
@@ -33,6 +45,7 @@ public:
   using Name = std::string;
   using ChannelID = raw::ChannelID_t;
   using ChannelSet = lariov::ChannelStatusProvider::ChannelSet_t;
+  using SnapshotPtr = ChannelStatusSnapshot::SnapshotPtr;
 
   // Configuration
   explicit ToolBasedChannelStatus(fhicl::ParameterSet const& pset);
@@ -67,14 +80,33 @@ public:
   // Returns the ID of the largest present channel
   ChannelID MaxChannelPresent() const { return MaxChannel(); }
 
+  // Load the status for all channels from the index map tool into a new
+  // snapshot or keep the current one if the status is unchanged.
+  // Returns 0 for success or 1 if the tool is not found.
+  int loadStatus();
+
+  // Discard the loaded status so that queries again use the tool.
+  // Clients holding the snapshot keep their copy.
+  void clearStatus();
+
+  // Return if the status is loaded.
+  bool haveStatus() const { return m_snapshot != nullptr; }
+
+  // Return the loaded status, null if there is none.
+  SnapshotPtr snapshot() const { return m_snapshot; }
+
 public:  // Helpers
 
   // Return the index map tool.
+  // The tool pointer is cached so repeated calls do not look up the tool by name.
   const IndexMapTool* indexMap() const;
 
   // Retrieve the index map status for a channel.
   Index indexMapStatus(const IndexMapTool* pimt, Index chan) const;
 
+  // Status for a channel from the loaded table or the tool.
+  Index channelStatus(Index chan) const;
+
   // Convert index map status to that defined here.
   // No range check.
   bool statusIsGood(Index ista) const  { return !statusIsBad(ista) && !statusIsNoisy(ista); }
@@ -100,6 +132,20 @@ private:
   Index m_NChannel;
   Name m_ToolName;
 
+  // Handle for the index map tool.
+  DuneToolManager::SharedToolHandle<IndexMapTool> m_imt;
+
+  // Loaded status for channels 0 through NChannel.
+  SnapshotPtr m_snapshot;
+
+  // Channel sets for each category of the loaded status.
+  ChannelSet m_channelSets[ChannelStatusSnapshot::NCategory];
+
+  // Return the channel set for a category of the loaded status.
+  const ChannelSet& snapshotChannels(ChannelStatusSnapshot::Category icat) const {
+    return m_channelSets[icat];
+  }
+
 };
 
 #endif
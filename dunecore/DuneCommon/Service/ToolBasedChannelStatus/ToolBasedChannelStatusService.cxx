@@ -2,6 +2,14 @@
 
 #include "ToolBasedChannelStatusService.h"
 
-ToolBasedChannelStatusService::ToolBasedChannelStatusService(const fhicl::ParameterSet& ps)
+ToolBasedChannelStatusService::
+ToolBasedChannelStatusService(const fhicl::ParameterSet& ps, art::ActivityRegistry& reg)
 : m_provider(new ToolBasedChannelStatus(ps)) {
+  reg.sPostBeginRun.watch(this, &ToolBasedChannelStatusService::postBeginRun);
+}
+
+//**********************************************************************
+
+void ToolBasedChannelStatusService::postBeginRun(art::Run const&) {
+  m_provider->loadStatus();
 }
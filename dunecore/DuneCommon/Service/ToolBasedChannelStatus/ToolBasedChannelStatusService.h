@@ -5,12 +5,20 @@
 //
 // Service implementation for ToolBasedChannelStatusService.
 //
+// The channel status is loaded from the tool at the start of each run. The
+// snapshot from the previous run is kept if the status is unchanged.
+//
+// The service has SHARED scope. The status is only replaced in postBeginRun,
+// when no events are being processed, and the provider queries read the
+// immutable snapshot or the shared tool, so they may be called concurrently.
+//
 
 #ifndef ToolBasedChannelStatusService_H
 #define ToolBasedChannelStatusService_H
 
 // LArSoft libraries
 #include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
 #include "ToolBasedChannelStatus.h"
 #include <memory>
@@ -24,7 +32,7 @@ class ToolBasedChannelStatusService : public lariov::ChannelStatusService {
 public:
 
   // Constructor: reads the channel IDs from the configuration
-  ToolBasedChannelStatusService(const fhicl::ParameterSet& ps);
+  ToolBasedChannelStatusService(const fhicl::ParameterSet& ps, art::ActivityRegistry& reg);
 
 private:
 
@@ -44,6 +52,6 @@ private:
 
 DECLARE_ART_SERVICE_INTERFACE_IMPL(ToolBasedChannelStatusService,
                                    lariov::ChannelStatusService,
-                                   LEGACY)
+                                   SHARED)
 
 #endif
@@ -115,6 +115,42 @@ int test_ToolBasedChannelStatusService() {
     }
   }
 
+  cout << myname << line << endl;
+  cout << myname << "Load the status table." << endl;
+  const ToolBasedChannelStatus* ptbcs = dynamic_cast<const ToolBasedChannelStatus*>(pcsp);
+  assert( ptbcs != nullptr );
+  lariov::ChannelStatusProvider::ChannelSet_t goods = pcsp->GoodChannels();
+  lariov::ChannelStatusProvider::ChannelSet_t bads = pcsp->BadChannels();
+  lariov::ChannelStatusProvider::ChannelSet_t noisys = pcsp->NoisyChannels();
+  assert( ! ptbcs->haveStatus() );
+  fhicl::ParameterSet psLoad;
+  psLoad.put<Index>("LogLevel", 2);
+  psLoad.put<Index>("NChannel", ncha);
+  psLoad.put<string>("ToolName", "mytool");
+  ToolBasedChannelStatus tbcs(psLoad);
+  assert( tbcs.loadStatus() == 0 );
+  assert( tbcs.haveStatus() );
+  assert( tbcs.GoodChannels() == goods );
+  assert( tbcs.BadChannels() == bads );
+  assert( tbcs.NoisyChannels() == noisys );
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    assert( tbcs.Status(icha) == pcsp->Status(icha) );
+    assert( tbcs.IsGood(icha) == pcsp->IsGood(icha) );
+    assert( tbcs.IsBad(icha) == pcsp->IsBad(icha) );
+    assert( tbcs.IsNoisy(icha) == pcsp->IsNoisy(icha) );
+  }
+  ToolBasedChannelStatus::SnapshotPtr psnap = tbcs.snapshot();
+  assert( tbcs.loadStatus() == 0 );
+  assert( tbcs.snapshot() == psnap );
+  assert( tbcs.BadChannels() == bads );
+  tbcs.clearStatus();
+  assert( ! tbcs.haveStatus() );
+  assert( tbcs.BadChannels() == bads );
+  assert( tbcs.loadStatus() == 0 );
+  assert( tbcs.snapshot() != psnap );
+  assert( tbcs.snapshot()->contentHash() == psnap->contentHash() );
+  assert( tbcs.NoisyChannels() == noisys );
+
 /*
   unsigned int ngrp = hcgs->size();
   cout << myname << "Check group count: " << ngrp << endl;
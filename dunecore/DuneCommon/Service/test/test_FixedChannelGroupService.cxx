@@ -67,6 +67,47 @@ int test_FixedChannelGroupService() {
     assert( chans.size() );
   }
 
+  cout << myname << line << endl;
+  cout << myname << "Check channel lookup." << endl;
+  assert( hcgs->lookup() != nullptr );
+  assert( hcgs->groupOf(1) == 0 );
+  assert( hcgs->groupOf(4) == 0 );
+  assert( hcgs->groupOf(12) == 1 );
+  assert( hcgs->groupOf(0) == ChannelGroupService::badIndex() );
+  assert( hcgs->groupOf(5) == ChannelGroupService::badIndex() );
+  assert( hcgs->groupOf(100) == ChannelGroupService::badIndex() );
+  ChannelGroupService::RangeVector rans = hcgs->ranges(1);
+  assert( rans.size() == 1 );
+  assert( rans[0].begin == 11 );
+  assert( rans[0].end == 14 );
+  assert( hcgs->ranges(2).size() == 0 );
+  rans = ChannelGroupService::makeRanges("test", {3, 4, 5, 8, 9, 2});
+  assert( rans.size() == 3 );
+  assert( rans[0].begin == 3 && rans[0].end == 6 );
+  assert( rans[1].begin == 8 && rans[1].end == 10 );
+  assert( rans[2].begin == 2 && rans[2].end == 3 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check channel order." << endl;
+  assert( hcgs->order() != nullptr );
+  ChannelGroupService::ChannelOrder cor = hcgs->channelOrder();
+  assert( cor.size() == 2 );
+  assert( cor.isPartition );
+  assert( cor.channels.size() == 7 );
+  assert( cor.begin(0) == 0 && cor.end(0) == 4 );
+  assert( cor.begin(1) == 4 && cor.end(1) == 7 );
+  assert( cor.channels[4] == 11 );
+  assert( cor.position(12) == 5 );
+  assert( cor.position(5) == ChannelGroupService::badIndex() );
+  assert( cor.position(100) == ChannelGroupService::badIndex() );
+  cor = ChannelGroupService::makeOrder({{7, 3}, {3, 5}, {}});
+  assert( cor.size() == 3 );
+  assert( ! cor.isPartition );
+  assert( cor.channels == ChannelGroupService::ChannelVector({7, 3, 5}) );
+  assert( cor.begin(1) == 2 && cor.end(1) == 3 );
+  assert( cor.begin(2) == 3 && cor.end(2) == 3 );
+  assert( cor.position(3) == 1 );
+
   cout << myname << line << endl;
   cout << myname << "Fetch ChannelGroupService by pointer." << endl;
   ChannelGroupService* pcgs = ArtServicePointer<ChannelGroupService>();
@@ -77,6 +77,13 @@ int test_GeoApaChannelGroupService(string sgeo) {
     assert( name.size() );
     assert( name != "NoSuchApa" );
     assert( chans.size() );
+    assert( hcgs->groupOf(chans.front()) == iapa );
+    assert( hcgs->order() != nullptr );
+    assert( hcgs->order()->end(iapa) - hcgs->order()->begin(iapa) == chans.size() );
+    assert( hcgs->order()->channels[hcgs->order()->begin(iapa)] == chans.front() );
+    assert( hcgs->groupOf(chans.back()) == iapa );
+    assert( hcgs->ranges(iapa).size() );
+    assert( hcgs->ranges(iapa).front().begin == chans.front() );
   }
 
   cout << myname << line << endl;
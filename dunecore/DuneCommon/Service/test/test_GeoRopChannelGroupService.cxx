@@ -76,6 +76,13 @@ int test_GeoRopChannelGroupService(string sgeo) {
     assert( name.size() );
     assert( name != "NoSuchRop" );
     assert( chans.size() );
+    assert( hcgs->groupOf(chans.front()) == irop );
+    assert( hcgs->order() != nullptr );
+    assert( hcgs->order()->end(irop) - hcgs->order()->begin(irop) == chans.size() );
+    assert( hcgs->order()->channels[hcgs->order()->begin(irop)] == chans.front() );
+    assert( hcgs->groupOf(chans.back()) == irop );
+    assert( hcgs->ranges(irop).size() == 1 );
+    assert( hcgs->ranges(irop).front().end == chans.back() + 1 );
   }
 
   cout << myname << line << endl;
@@ -18,6 +18,9 @@
 // If any starts are duplicated, the value for last one takes precedence.
 // If there are fewer values than starts, value zer is used for the extra starts.
 // If Period is nonzero the  mapping is done with the remainder after dividing by that value.
+//
+// The mapping is static so it is expanded into a dense vector over one period (or up
+// to the last start if there is no period) and get and getMany are array lookups.
 
 #ifndef BlockIndexMapTool_H
 #define BlockIndexMapTool_H
@@ -43,6 +46,12 @@ public:
   // Return the channel status.
   Index get(Index icha) const override;
 
+  // Map many indices.
+  void getMany(const Index* pidx, Index nidx, Index* pval) const override;
+
+  // Return if the dense vector is used.
+  bool isDense() const { return m_vals.size() > 0; }
+
 private:
 
   using IndexVector = std::vector<Index>;
@@ -56,6 +65,8 @@ private:
 
   // Derived data.
   IndexMap m_map;
+  IndexVector m_vals;     // Dense values for [0, Period) or [0, last start]
+  Index m_lastValue = 0;  // Value beyond the last start
 
 };
 
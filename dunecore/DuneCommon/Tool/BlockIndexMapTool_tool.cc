@@ -27,6 +27,19 @@ BlockIndexMapTool::BlockIndexMapTool(fhicl::ParameterSet const& ps)
      Index val = ival < m_Values.size() ? m_Values[ival] : 0;
      m_map[idx] = val;
   }
+  m_lastValue = m_map.rbegin()->second;
+  // Build the dense vector unless it would be very large.
+  const Index maxDense = 1 << 24;
+  Index nval = m_Period ? m_Period : m_map.rbegin()->first + 1;
+  if ( nval <= maxDense ) {
+    m_vals.resize(nval);
+    IndexMap::const_iterator ient = m_map.begin();
+    for ( Index kcha=0; kcha<nval; ++kcha ) {
+      IndexMap::const_iterator inext = ient;
+      if ( ++inext != m_map.end() && inext->first <= kcha ) ient = inext;
+      m_vals[kcha] = ient->second;
+    }
+  }
   // Display the parameters.
   if ( m_LogLevel >= 1 ) {
     // Use largest value to set the display width for indices and values.
@@ -57,6 +70,7 @@ BlockIndexMapTool::BlockIndexMapTool(fhicl::ParameterSet const& ps)
     }
     cout << "]" << endl;
     cout << myname << "    Period: " << m_Period << endl;
+    cout << myname << "  Dense vector size: " << m_vals.size() << endl;
   }
 }
 
@@ -65,9 +79,30 @@ BlockIndexMapTool::BlockIndexMapTool(fhicl::ParameterSet const& ps)
 Index BlockIndexMapTool::get(Index icha) const {
   const Name myname = "BlockIndexMapTool::get: ";
   Index kcha = m_Period ? icha%m_Period : icha;
+  if ( kcha < m_vals.size() ) return m_vals[kcha];
+  if ( isDense() ) return m_lastValue;
   return (--m_map.upper_bound(kcha))->second;
 }
 
 //**********************************************************************
 
+void BlockIndexMapTool::getMany(const Index* pidx, Index nidx, Index* pval) const {
+  if ( ! isDense() ) {
+    for ( Index iidx=0; iidx<nidx; ++iidx ) pval[iidx] = get(pidx[iidx]);
+    return;
+  }
+  const Index* pvals = m_vals.data();
+  Index nval = m_vals.size();
+  if ( m_Period ) {
+    for ( Index iidx=0; iidx<nidx; ++iidx ) pval[iidx] = pvals[pidx[iidx]%m_Period];
+  } else {
+    for ( Index iidx=0; iidx<nidx; ++iidx ) {
+      Index kcha = pidx[iidx];
+      pval[iidx] = kcha < nval ? pvals[kcha] : m_lastValue;
+    }
+  }
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(BlockIndexMapTool)
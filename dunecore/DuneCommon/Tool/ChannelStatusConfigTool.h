@@ -25,6 +25,10 @@
 //
 // A channel appearing in multiple lists is assigned to the first in which
 // it appears.
+//
+// The map is exposed as a dense table (IndexMapTool::table) and as an immutable
+// ChannelStatusSnapshot that may be shared with the channel status provider
+// and other clients.
 
 #ifndef ChannelStatusConfigTool_H
 #define ChannelStatusConfigTool_H
@@ -32,7 +36,9 @@
 #include "art/Utilities/ToolMacros.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "dunecore/DuneInterface/Tool/IndexMapTool.h"
+#include "dunecore/DuneCommon/Utility/ChannelStatusSnapshot.h"
 #include <vector>
+#include <mutex>
 
 class ChannelStatusConfigTool : public IndexMapTool {
 
@@ -41,6 +47,7 @@ public:
   using Index = IndexMapTool::Index;
   using IndexVector = std::vector<Index>;
   using IndexVectorVector = std::vector<IndexVector>;
+  using SnapshotPtr = ChannelStatusSnapshot::SnapshotPtr;
 
   // Ctor.
   ChannelStatusConfigTool(fhicl::ParameterSet const& ps);
@@ -51,6 +58,15 @@ public:
   // Return the channel status.
   Index get(Index icha) const override;
 
+  // Dense table of the status for the channels in any list.
+  const Index* table() const override { return m_vals.data(); }
+  Index tableSize() const override { return m_vals.size(); }
+
+  // Snapshot of the status for channels 0 through nchan-1, also covering
+  // any channel in the lists. Channels in no list have status DefaultIndex.
+  // The snapshot is cached and shared by calls with the same or smaller nchan.
+  SnapshotPtr snapshot(Index nchan =0) const;
+
 private:
 
   // Parameters.
@@ -61,6 +77,10 @@ private:
   // Derived from configuration.
   IndexVector m_vals;
 
+  // Cached snapshot.
+  mutable std::mutex m_snapMutex;
+  mutable SnapshotPtr m_psnap;
+
 };
 
 
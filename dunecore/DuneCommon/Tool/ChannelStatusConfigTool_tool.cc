@@ -89,4 +89,15 @@ Index ChannelStatusConfigTool::get(Index icha) const {
 
 //**********************************************************************
 
+ChannelStatusConfigTool::SnapshotPtr ChannelStatusConfigTool::snapshot(Index nchan) const {
+  std::lock_guard<std::mutex> lock(m_snapMutex);
+  if ( m_psnap && m_psnap->size() >= nchan ) return m_psnap;
+  IndexVector stats = m_vals;
+  if ( stats.size() < nchan ) stats.resize(nchan, m_DefaultIndex);
+  m_psnap = std::make_shared<const ChannelStatusSnapshot>(stats);
+  return m_psnap;
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(ChannelStatusConfigTool)
@@ -5,6 +5,11 @@
 //
 // Tool to return the channel status reported by ChannelStatusService.
 //
+// snapshot(nchan) copies the status reported by the provider for channels
+// 0 through nchan-1 into an immutable ChannelStatusSnapshot that clients may
+// share, e.g. for the rest of a run, instead of querying the provider for each
+// channel.
+//
 // Parameters:
 //   LogLevel - Message logging level (0=none, 1=ctor, 2=each call, ...)
 
@@ -14,6 +19,7 @@
 #include "art/Utilities/ToolMacros.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "dunecore/DuneInterface/Tool/IndexMapTool.h"
+#include "dunecore/DuneCommon/Utility/ChannelStatusSnapshot.h"
 #include <map>
 
 namespace lariov {
@@ -25,6 +31,7 @@ class ChannelStatusServiceTool : public IndexMapTool {
 public:
 
   using Index = IndexMapTool::Index;
+  using SnapshotPtr = ChannelStatusSnapshot::SnapshotPtr;
 
   // Ctor.
   ChannelStatusServiceTool(fhicl::ParameterSet const& ps);
@@ -35,6 +42,10 @@ public:
   // Return the channel status.
   Index get(Index icha) const override;
 
+  // Snapshot of the current provider status for channels 0 through nchan-1.
+  // Returns null if there is no provider.
+  SnapshotPtr snapshot(Index nchan) const;
+
 private:
 
   // Parameters.
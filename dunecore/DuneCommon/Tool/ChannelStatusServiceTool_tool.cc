@@ -50,4 +50,26 @@ Index ChannelStatusServiceTool::get(Index icha) const {
 
 //**********************************************************************
 
+ChannelStatusServiceTool::SnapshotPtr ChannelStatusServiceTool::snapshot(Index nchan) const {
+  const Name myname = "ChannelStatusServiceTool::snapshot: ";
+  if ( m_pChannelStatusProvider == nullptr ) return nullptr;
+  // The bad and noisy sets are fetched once rather than querying each channel.
+  ChannelStatusSnapshot::IndexVector stats(nchan, AdcChannelStatusGood);
+  for ( raw::ChannelID_t icha : m_pChannelStatusProvider->NoisyChannels() ) {
+    if ( icha < nchan ) stats[icha] = AdcChannelStatusNoisy;
+  }
+  for ( raw::ChannelID_t icha : m_pChannelStatusProvider->BadChannels() ) {
+    if ( icha < nchan ) stats[icha] = AdcChannelStatusBad;
+  }
+  SnapshotPtr psnap = std::make_shared<const ChannelStatusSnapshot>(stats);
+  if ( m_LogLevel >= 2 ) {
+    cout << myname << "Snapshot for " << nchan << " channels: "
+         << psnap->count(ChannelStatusSnapshot::Bad) << " bad, "
+         << psnap->count(ChannelStatusSnapshot::Noisy) << " noisy." << endl;
+  }
+  return psnap;
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(ChannelStatusServiceTool)
@@ -51,6 +51,9 @@ public:
   // Extract run from context and return the corresponding name.
   Name getNameInContext(const Context* pcon) const override;
 
+  // The name depends only on the run.
+  Key contextKey(const Context* pcon) const override;
+
 private:
 
   // Parameters.
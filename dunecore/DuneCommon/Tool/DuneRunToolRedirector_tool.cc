@@ -108,4 +108,10 @@ Name DuneRunToolRedirector::getNameInContext(const Context* pcon) const {
 
 //**********************************************************************
 
+DuneRunToolRedirector::Key DuneRunToolRedirector::contextKey(const Context* pcon) const {
+  return pcon == nullptr ? nullKey() : Key(pcon->getRun());
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(DuneRunToolRedirector)
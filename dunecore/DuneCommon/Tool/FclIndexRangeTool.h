@@ -12,6 +12,8 @@
 //             label - label
 //             begin - first index
 //               end - last+1 index
+//
+// The lookup holds the ranges in name order.
 
 #ifndef FclIndexRangeTool_H
 #define FclIndexRangeTool_H
@@ -37,12 +39,18 @@ public:
   // Return a range.
   IndexRange get(Name nam) const override;
 
+  // Return the lookup for all ranges.
+  const IndexRangeLookup* lookup() const override { return &m_lookup; }
+
 private:
 
   // Parameters.
   Index m_LogLevel;
   IndexRangeMap m_Ranges;
 
+  // Derived data.
+  IndexRangeLookup m_lookup;
+
 };
 
 
@@ -34,6 +34,9 @@ FclIndexRangeTool::FclIndexRangeTool(fhicl::ParameterSet const& ps)
     if ( ran.name.size() > namSize ) namSize = ran.name.size();
     if ( ran.label().size() > labSize ) labSize = ran.label().size();
   }
+  IndexRangeLookup::RangeVector rans;
+  for ( const IndexRangeMap::value_type& iran : m_Ranges ) rans.push_back(iran.second);
+  m_lookup = IndexRangeLookup(rans);
   if ( m_LogLevel >= 1 ) {
     cout << myname << "     LogLevel: " << m_LogLevel << endl;
     cout << myname << "  Range count: " << m_Ranges.size() << endl;
@@ -12,6 +12,10 @@
 //             RRR is the map index
 //             [EE1, EE2, ...] is the mapped vector
 //             If a map index appeared ealier, the new entries are appended.
+//
+// If the map indices are dense enough (range at most twice the number of entries
+// plus 64), the vectors are also stored contiguously with an offset table so that
+// get, getMany and contains do not search the map.
 
 #ifndef FclIndexVectorMapTool_H
 #define FclIndexVectorMapTool_H
@@ -39,6 +43,15 @@ public:
   // Return the vector for an index.
   IndexVector get(Index ient) const override;
 
+  // Fill the vectors for many indices.
+  void getMany(const Index* pidx, Index nidx, IndexVector* pvecs) const override;
+
+  // Return if the vector for an index contains a value.
+  bool contains(Index idx, Index val) override;
+
+  // Return if the dense table is used.
+  bool isDense() const { return m_offsets.size() > 0; }
+
 private:
 
   // Parameters.
@@ -46,6 +59,22 @@ private:
   IndexVectorVector m_Entries;
   IndexVectorMap m_entryMap;
 
+  // Dense table: values for index m_idx0 + ipos are
+  // m_flatValues[m_offsets[ipos]] to m_flatValues[m_offsets[ipos+1]].
+  Index m_idx0 =0;
+  IndexVector m_offsets;
+  IndexVector m_flatValues;
+
+  // Return the range of values for an index in the dense table.
+  // Returns false if the index is outside the table.
+  bool denseRange(Index idx, const Index*& pbeg, const Index*& pend) const {
+    Index ipos = idx - m_idx0;
+    if ( idx < m_idx0 || ipos + 1 >= m_offsets.size() ) return false;
+    pbeg = m_flatValues.data() + m_offsets[ipos];
+    pend = m_flatValues.data() + m_offsets[ipos+1];
+    return true;
+  }
+
 };
 
 
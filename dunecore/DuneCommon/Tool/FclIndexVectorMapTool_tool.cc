@@ -27,6 +27,24 @@ FclIndexVectorMapTool::FclIndexVectorMapTool(fhicl::ParameterSet const& ps)
   Index vecCount = m_entryMap.size();
   Index valCount = 0;
   for ( const IndexVectorMap::value_type& ent : m_entryMap ) valCount += ent.second.size();
+  // Build the dense table.
+  if ( vecCount ) {
+    Index idx0 = m_entryMap.begin()->first;
+    Index nidx = m_entryMap.rbegin()->first - idx0 + 1;
+    if ( nidx <= 2*vecCount + 64 ) {
+      m_idx0 = idx0;
+      m_offsets.assign(nidx + 1, 0);
+      m_flatValues.reserve(valCount);
+      IndexVectorMap::const_iterator ient = m_entryMap.begin();
+      for ( Index ipos=0; ipos<nidx; ++ipos ) {
+        if ( ient != m_entryMap.end() && ient->first == idx0 + ipos ) {
+          m_flatValues.insert(m_flatValues.end(), ient->second.begin(), ient->second.end());
+          ++ient;
+        }
+        m_offsets[ipos+1] = m_flatValues.size();
+      }
+    }
+  }
   if ( m_LogLevel >= 1 ) {
     cout << myname << "  LogLevel: " << m_LogLevel << endl;
     cout << myname << "   Entries: " << vecCount << " vectors with "
@@ -46,6 +64,7 @@ FclIndexVectorMapTool::FclIndexVectorMapTool(fhicl::ParameterSet const& ps)
     } else {
       cout << "." << endl;
     }
+    cout << myname << "  Dense table size: " << m_offsets.size() << endl;
   }
 }
 
@@ -53,6 +72,12 @@ FclIndexVectorMapTool::FclIndexVectorMapTool(fhicl::ParameterSet const& ps)
 
 IndexVectorMapTool::IndexVector FclIndexVectorMapTool::get(Index idx) const {
   const Name myname = "FclIndexVectorMapTool::get: ";
+  if ( isDense() ) {
+    const Index* pbeg = nullptr;
+    const Index* pend = nullptr;
+    if ( denseRange(idx, pbeg, pend) ) return IndexVector(pbeg, pend);
+    return IndexVector();
+  }
   IndexVectorMap::const_iterator ient = m_entryMap.find(idx);
   static const IndexVector empty;
   if ( ient == m_entryMap.end() ) return empty;
@@ -61,4 +86,33 @@ IndexVectorMapTool::IndexVector FclIndexVectorMapTool::get(Index idx) const {
 
 //**********************************************************************
 
+void FclIndexVectorMapTool::getMany(const Index* pidx, Index nidx, IndexVector* pvecs) const {
+  if ( ! isDense() ) {
+    for ( Index iidx=0; iidx<nidx; ++iidx ) pvecs[iidx] = get(pidx[iidx]);
+    return;
+  }
+  for ( Index iidx=0; iidx<nidx; ++iidx ) {
+    const Index* pbeg = nullptr;
+    const Index* pend = nullptr;
+    if ( denseRange(pidx[iidx], pbeg, pend) ) pvecs[iidx].assign(pbeg, pend);
+    else pvecs[iidx].clear();
+  }
+}
+
+//**********************************************************************
+
+bool FclIndexVectorMapTool::contains(Index idx, Index val) {
+  if ( ! isDense() ) {
+    IndexVectorMap::const_iterator ient = m_entryMap.find(idx);
+    if ( ient == m_entryMap.end() ) return false;
+    return std::find(ient->second.begin(), ient->second.end(), val) != ient->second.end();
+  }
+  const Index* pbeg = nullptr;
+  const Index* pend = nullptr;
+  if ( ! denseRange(idx, pbeg, pend) ) return false;
+  return std::find(pbeg, pend, val) != pend;
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(FclIndexVectorMapTool)
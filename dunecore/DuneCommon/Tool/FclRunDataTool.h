@@ -12,9 +12,18 @@
 // with the run and subrun sustitutions padded with leading zeros to attain
 // a length of (at least) six.
 //
+// The result for each (run, subrun) is cached so the files are found and
+// parsed only on the first call for that run. The cache is thread safe.
+//
+// Runs passed to prefetch, or listed in PrefetchRuns, are resolved in parallel
+// on background threads. A runData call for a run that is being resolved
+// waits for that result. The file lookups are serialized because TSystem is not
+// thread safe, but the files are parsed concurrently.
+//
 // Parameters:
 //   LogLevel - Message logging level (0=none, 1=ctor, 2=each call, ...)
 //   FileNames - Vector of file name patterns
+//   PrefetchRuns - Runs (subrun 0) to prefetch in the ctor [optional, default none]
 
 #ifndef FclRunDataTool_H
 #define FclRunDataTool_H
@@ -22,7 +31,12 @@
 #include "art/Utilities/ToolMacros.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "dunecore/DuneInterface/Tool/RunDataTool.h"
+#include "dunecore/DuneCommon/Utility/StringTemplate.h"
 #include <vector>
+#include <map>
+#include <mutex>
+#include <future>
+#include <utility>
 
 class FclRunDataTool : public RunDataTool {
 
@@ -34,20 +48,44 @@ public:
   // Ctor.
   FclRunDataTool(fhicl::ParameterSet const& ps);
 
-  // Dtor.
-  ~FclRunDataTool() override =default;
+  // Dtor. Waits for any prefetches.
+  ~FclRunDataTool() override;
 
   // Return run data.
   RunData runData(Index run, Index subRun) const override;
 
+  // Resolve run data in the background.
+  Index prefetch(const IndexVector& runs, Index subRun) const override;
+
 private:
 
   // Parameters.
   Index m_LogLevel;
   NameVector m_FileNames;
+  IndexVector m_PrefetchRuns;
 
   Name m_fclPath;
 
+  // Cached run data indexed by (run, subrun). Entries are added before the data
+  // are read so each run is read once.
+  using RunKey = std::pair<Index, Index>;
+  using RunPromise = std::promise<RunData>;
+  mutable std::map<RunKey, std::shared_future<RunData>> m_cache;
+  mutable std::mutex m_cacheMutex;
+
+  // Prefetch tasks. These are run with std::async rather than queued in the TBB
+  // pool so they make progress even when the job has no spare TBB threads.
+  mutable std::vector<std::future<void>> m_prefetchTasks;
+
+  // File name patterns parsed in the ctor. Each read uses a copy.
+  std::vector<StringTemplate> m_fileNameTemplates;
+
+  // Find and read the run data files.
+  RunData readRunData(Index run, Index subRun) const;
+
+  // Read the run data into a promise.
+  void fillRunData(Index run, Index subRun, RunPromise& prom) const;
+
 };
 
 
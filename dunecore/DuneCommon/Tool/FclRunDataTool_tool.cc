@@ -1,12 +1,14 @@
 // FclRunDataTool_tool.cc
 
 #include "FclRunDataTool.h"
-#include "dunecore/DuneCommon/Utility/StringManipulator.h"
 #include "fhiclcpp/intermediate_table.h"
 #include "fhiclcpp/make_ParameterSet.h"
 #include "TString.h"
 #include "TSystem.h"
 #include <iostream>
+#include <chrono>
+#include <exception>
+#include <memory>
 
 using std::cout;
 using std::endl;
@@ -20,9 +22,18 @@ using Name = FclRunDataTool::Name;
 using Index = RunData::Index;
 using IndexVector = RunData::IndexVector;
 
-int parseFcl(string path, string fclname, RunData& rdat) {
+// TSystem is not thread safe so the lookups of concurrent prefetches are serialized.
+std::mutex& findMutex() {
+  static std::mutex mtx;
+  return mtx;
+}
+
+int parseFcl(const string& path, const string& fclname, RunData& rdat) {
   TString ts(fclname.c_str());
-  gSystem->FindFile(path.c_str(), ts);
+  {
+    std::lock_guard<std::mutex> lock(findMutex());
+    gSystem->FindFile(path.c_str(), ts);
+  }
   string pfname = ts.Data();
   if ( pfname.size() == 0 ) return 1;
   cet::filepath_maker policy;
@@ -49,9 +60,16 @@ int parseFcl(string path, string fclname, RunData& rdat) {
 
 FclRunDataTool::FclRunDataTool(fhicl::ParameterSet const& ps)
 : m_LogLevel(ps.get<Index>("LogLevel")),
-  m_FileNames(ps.get<NameVector>("FileNames")) {
+  m_FileNames(ps.get<NameVector>("FileNames")),
+  m_PrefetchRuns(ps.get<IndexVector>("PrefetchRuns", IndexVector())) {
   const Name myname = "FclRunDataTool::ctor: ";
   m_fclPath = gSystem->Getenv("FHICL_FILE_PATH");
+  for ( Name fname : m_FileNames ) {
+    StringTemplate stm(fname);
+    stm.addField("%RUN%", 6);
+    stm.addField("%SUBRUN%", 6);
+    m_fileNameTemplates.push_back(stm);
+  }
   if ( m_LogLevel ) {
     cout << myname << "Configuration:" << endl;
     cout << myname << "   LogLevel: " << m_LogLevel << endl;
@@ -63,24 +81,89 @@ FclRunDataTool::FclRunDataTool(fhicl::ParameterSet const& ps)
       cout << "\n" << myname << "                 " << fname;
     }
     cout << endl;
+    if ( m_PrefetchRuns.size() ) {
+      cout << myname << "  PrefetchRuns: [";
+      bool first = true;
+      for ( Index run : m_PrefetchRuns ) {
+        cout << (first ? "" : ", ") << run;
+        first = false;
+      }
+      cout << "]" << endl;
+    }
   }
+  if ( m_PrefetchRuns.size() ) prefetch(m_PrefetchRuns, 0);
+}
+
+//**********************************************************************
+
+FclRunDataTool::~FclRunDataTool() {
+  for ( std::future<void>& task : m_prefetchTasks ) task.wait();
 }
 
 //**********************************************************************
 
 RunData FclRunDataTool::runData(Index run, Index subRun) const {
   const Name myname = "FclRunDataTool::runData: ";
-  RunData rdat;
   bool useSubRun = subRun;
   if ( m_LogLevel >= 2 ) {
     cout << myname << "Fetching tool for run " << run;
     if ( useSubRun ) cout << ", subrun " << subRun;
     cout << endl;
   }
-  for ( Name fname : m_FileNames ) {
-    StringManipulator sman(fname, false);
-    sman.replaceFixedWidth("%RUN%", run, 6);
-    sman.replaceFixedWidth("%SUBRUN%", subRun, 6);
+  RunKey key(run, subRun);
+  std::shared_future<RunData> frdat;
+  RunPromise prom;
+  bool doRead = false;
+  {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto irdat = m_cache.find(key);
+    if ( irdat == m_cache.end() ) {
+      frdat = m_cache.emplace(key, prom.get_future().share()).first->second;
+      doRead = true;
+    } else {
+      frdat = irdat->second;
+      if ( m_LogLevel >= 3 ) {
+        bool ready = frdat.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        cout << myname << "  Using " << (ready ? "cached" : "prefetching") << " data." << endl;
+      }
+    }
+  }
+  // The data are read outside the lock so other runs may be fetched meanwhile.
+  if ( doRead ) fillRunData(run, subRun, prom);
+  return frdat.get();
+}
+
+//**********************************************************************
+
+RunDataTool::Index FclRunDataTool::prefetch(const IndexVector& runs, Index subRun) const {
+  const Name myname = "FclRunDataTool::prefetch: ";
+  Index nsch = 0;
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  for ( Index run : runs ) {
+    RunKey key(run, subRun);
+    if ( m_cache.count(key) ) continue;
+    std::shared_ptr<RunPromise> pprom = std::make_shared<RunPromise>();
+    m_cache.emplace(key, pprom->get_future().share());
+    m_prefetchTasks.push_back(std::async(std::launch::async,
+      [this, run, subRun, pprom]() { fillRunData(run, subRun, *pprom); }));
+    ++nsch;
+  }
+  if ( m_LogLevel >= 2 ) {
+    cout << myname << "Prefetching " << nsch << " of " << runs.size() << " run"
+         << (runs.size() == 1 ? "" : "s") << endl;
+  }
+  return nsch;
+}
+
+//**********************************************************************
+
+RunData FclRunDataTool::readRunData(Index run, Index subRun) const {
+  const Name myname = "FclRunDataTool::readRunData: ";
+  RunData rdat;
+  for ( StringTemplate stm : m_fileNameTemplates ) {
+    stm.setValue(0, run);
+    stm.setValue(1, subRun);
+    const Name& fname = stm.str();
     if ( parseFcl(m_fclPath, fname, rdat) ) {
       if ( m_LogLevel >= 3 ) cout << myname << "Unable to find/read " << fname << endl;
     } else {
@@ -92,4 +175,15 @@ RunData FclRunDataTool::runData(Index run, Index subRun) const {
 
 //**********************************************************************
 
+void FclRunDataTool::fillRunData(Index run, Index subRun, RunPromise& prom) const {
+  // An exception, e.g. for an invalid file, is passed to the callers of runData.
+  try {
+    prom.set_value(readRunData(run, subRun));
+  } catch ( ... ) {
+    prom.set_exception(std::current_exception());
+  }
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(FclRunDataTool)
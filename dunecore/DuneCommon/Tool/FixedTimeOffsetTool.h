@@ -12,6 +12,8 @@
 //   Unit - Unit for the time offset (e.g. daq, tick, ns).
 //
 // For protoDUNE, daq is us/50, i.e 20 ns.
+//
+// The evaluator is the same for all data and does not depend on the clock.
 
 #ifndef FixedTimeOffsetTool_H
 #define FixedTimeOffsetTool_H
@@ -36,6 +38,9 @@ public:
   // Return run data.
   Offset offset(const Data& dat) const override;
 
+  // Return the evaluator.
+  Evaluator evaluator(const Data&) const override { return m_eval; }
+
 private:
 
   // Parameters.
@@ -44,6 +49,9 @@ private:
   double m_Rem;
   Name m_Unit;
 
+  // Derived from configuration.
+  Evaluator m_eval;
+
 };
 
 
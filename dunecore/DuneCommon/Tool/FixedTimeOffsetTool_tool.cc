@@ -19,6 +19,9 @@ FixedTimeOffsetTool::FixedTimeOffsetTool(fhicl::ParameterSet const& ps)
   m_Rem(ps.get<double>("Rem")),
   m_Unit(ps.get<Name>("Unit")) {
   const Name myname = "FixedTimeOffsetTool::ctor: ";
+  m_eval.status = 0;
+  m_eval.base = m_Value;
+  m_eval.baseRem = m_Rem;
   if ( m_LogLevel ) {
     cout << "Configuration:" << endl;
     cout << "  LogLevel: " << m_LogLevel << endl;
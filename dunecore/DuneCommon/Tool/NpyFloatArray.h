@@ -0,0 +1,74 @@
+// NpyFloatArray.h
+//
+// Tool that returns a float array read from a numpy .npy file.
+//
+// This is a fast alternative to FclFloatArray for large arrays, e.g. one
+// calibration constant for each of O(100k) channels. The file is memory
+// mapped and validated by its header (see NpyFloatFile) so jobs do not
+// parse very long fcl arrays at startup. The file may hold float32 or
+// float64 values with any shape; values are flattened in C order.
+// It may also be used as one of the configurations read by FclFileFloatArray.
+//
+// Parameters:
+//   LogLevel - Message logging level:
+//              0: No messages
+//              1: Show config in ctor with a few values
+//              2: Also show file details
+//   FileName - Name of the npy file. It is searched for along FHICL_FILE_PATH
+//              if it is not found directly.
+//   DefaultValue - Value to return when an index is out of range.
+//   Offset - Index of the first value
+//   Label - string label
+//   Unit - Units for the values
+
+#ifndef NpyFloatArray_H
+#define NpyFloatArray_H
+
+#include "art/Utilities/ToolMacros.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "dunecore/DuneInterface/Tool/FloatArrayTool.h"
+#include <vector>
+
+class NpyFloatArray : public FloatArrayTool {
+
+public:
+
+  using Name = std::string;
+
+  // Ctor.
+  NpyFloatArray(fhicl::ParameterSet const& ps);
+
+  // Dtor.
+  ~NpyFloatArray() override =default;
+
+  // Return the offset.
+  Index offset() const override { return m_Offset; }
+  
+  // Return the label.
+  std::string label() const override { return m_Label; }
+ 
+  // Return the units.
+  Name unit() const override { return m_Unit; }
+
+  // Return the values without offset.
+  const FloatVector& values() const override { return m_Values; }
+
+  // Return the default value.
+  float defaultValue() const override { return m_DefaultValue; }
+
+private:
+
+  // Parameters.
+  Index m_LogLevel;
+  Name m_FileName;
+  float m_DefaultValue;
+  Index m_Offset;
+  Name m_Label;
+  Name m_Unit;
+
+  FloatVector m_Values;
+
+};
+
+
+#endif
@@ -0,0 +1,63 @@
+// NpyFloatArray_tool.cc
+
+#include "NpyFloatArray.h"
+#include "dunecore/DuneCommon/Utility/NpyFloatFile.h"
+#include "cetlib_except/exception.h"
+#include "TString.h"
+#include "TSystem.h"
+#include <iostream>
+
+using std::cout;
+using std::endl;
+
+//**********************************************************************
+
+NpyFloatArray::NpyFloatArray(fhicl::ParameterSet const& ps)
+: m_LogLevel(ps.get<Index>("LogLevel")),
+  m_FileName(ps.get<Name>("FileName")),
+  m_DefaultValue(ps.get<float>("DefaultValue")),
+  m_Offset(ps.get<Index>("Offset")),
+  m_Label(ps.get<Name>("Label")),
+  m_Unit(ps.get<Name>("Unit")) {
+  const Name myname = "NpyFloatArray::ctor: ";
+  Name pfname = m_FileName;
+  if ( gSystem->AccessPathName(pfname.c_str()) ) {
+    Name fclPath = gSystem->Getenv("FHICL_FILE_PATH");
+    TString ts(m_FileName.c_str());
+    gSystem->FindFile(fclPath.c_str(), ts);
+    pfname = ts.Data();
+  }
+  if ( pfname.size() == 0 ) {
+    throw cet::exception("NpyFloatArray") << "Unable to find file " << m_FileName << "\n";
+  }
+  NpyFloatFile npf(pfname);
+  if ( npf.status() || npf.read(m_Values) ) {
+    throw cet::exception("NpyFloatArray") << npf.error() << "\n";
+  }
+  if ( m_LogLevel ) {
+    cout << myname << "Configuration:" << endl;
+    cout << myname << "      LogLevel: " << m_LogLevel << endl;
+    cout << myname << "      FileName: " << m_FileName << endl;
+    cout << myname << "        Offset: " << m_Offset << endl;
+    cout << myname << "  DefaultValue: " << m_DefaultValue << endl;
+    cout << myname << "         Label: " << m_Label << endl;
+    cout << myname << "          Unit: " << m_Unit << endl;
+    if ( m_LogLevel >= 2 ) {
+      cout << myname << "     File path: " << pfname << endl;
+      cout << myname << "    Value size: " << npf.valueSize() << endl;
+    }
+    cout << myname << "          Size: " << size() << endl;
+    cout << myname << "        Values: [";
+    Index nshow = size() <= 10 ? size() : 5;
+    for ( Index ival=0; ival<nshow; ++ival ) {
+      if ( ival ) cout << ", ";
+      cout << values()[ival];
+    }
+    if ( nshow < size() ) cout << ", ...";
+    cout << "]" << endl;
+  }
+}
+
+//**********************************************************************
+
+DEFINE_ART_CLASS_TOOL(NpyFloatArray)
@@ -0,0 +1,106 @@
+// ProfiledTpcDataTool.h
+//
+// Tool that forwards each TpcDataTool or AdcChannelTool call to another tool
+// and records the call count, channel count, wall time and growth in the
+// channel data size for each method.
+//
+// Profiling is enabled by replacing a tool in a chain with this one, e.g.
+//   tools.mytool_prof: { tool_type: ProfiledTpcDataTool LogLevel:1 ToolName:mytool Label:"" }
+// and using mytool_prof in the chain in place of mytool.
+//
+// The counts are held in a ToolCallProfile registered with the label so that
+// the tools in a job can be compared with ToolCallProfile::printAll. At close,
+// the table for this tool is printed if LogLevel >= 1 and that for all
+// registered profiles if LogLevel >= 2.
+//
+// The byte count is the change in the size of the sample, flag, signal, ROI and
+// DFT vectors in the processed channels. It does not include temporary or
+// tool-internal allocations.
+//
+// With TraceRecorder enabled, each call is also recorded as a span named
+// LABEL::METHOD, so the tools show up by name on the trace timeline.
+//
+// Parameters:
+//   LogLevel - Message logging level (0=none, 1=ctor and close, 2=also all tools, 3=each call)
+//   ToolName - Name of the tool receiving the calls
+//   Label - Label for the profile. If blank, ToolName is used.
+
+#ifndef ProfiledTpcDataTool_H
+#define ProfiledTpcDataTool_H
+
+#include "art/Utilities/ToolMacros.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "dunecore/DuneInterface/Tool/TpcDataTool.h"
+#include "dunecore/DuneCommon/Utility/ToolCallProfile.h"
+#include <string>
+#include <memory>
+
+class ProfiledTpcDataTool : public TpcDataTool {
+
+public:
+
+  using Name = std::string;
+
+  // Ctor.
+  ProfiledTpcDataTool(fhicl::ParameterSet const& ps);
+
+  // Dtor.
+  ~ProfiledTpcDataTool() override;
+
+  // AdcChannelTool methods.
+  DataMap update(AdcChannelData& acd) const override;
+  DataMap view(const AdcChannelData& acd) const override;
+  DataMap updateMap(AdcChannelDataMap& acds) const override;
+  DataMap viewMap(const AdcChannelDataMap& acds) const override;
+  DataMap updateFlatMap(AdcChannelDataFlatMap& acds) const override;
+  DataMap viewFlatMap(const AdcChannelDataFlatMap& acds) const override;
+  bool channelParallel() const override;
+  DataMap beginEvent(const DuneEventInfo& devt) const override;
+  DataMap endEvent(const DuneEventInfo& devt) const override;
+  DataMap close(const DataMap* dmin =nullptr) override;
+
+  // TpcDataTool methods.
+  DataMap updateTpcData(TpcData& tpd) const override;
+  DataMap viewTpcData(const TpcData& tpd) const override;
+
+  // Return the profile.
+  const ToolCallProfile& profile() const { return *m_pprf; }
+
+  // Return the number of bytes held in the vectors of channel data.
+  static long dataBytes(const AdcChannelData& acd);
+
+private:
+
+  // Parameters.
+  Index m_LogLevel;
+  Name m_ToolName;
+  Name m_Label;
+
+  // Tool receiving the calls. The TpcData pointer is null if that tool
+  // does not implement TpcDataTool.
+  std::unique_ptr<AdcChannelTool> m_ptool;
+  TpcDataTool* m_ptpdtool;
+
+  // Profile.
+  std::shared_ptr<ToolCallProfile> m_pprf;
+  bool m_closed;
+
+  // Span names for each method.
+  std::array<const char*, ToolCallProfile::NMethod> m_traceNames;
+
+  // Return an error result if there is no tool.
+  DataMap noTool() const;
+
+  // Count the channels and bytes in channel data.
+  static void countData(const AdcChannelData& acd, ToolCallProfile::Count& nchan, long& nbyte);
+  template<class C>
+  static void countData(const C& acds, ToolCallProfile::Count& nchan, long& nbyte);
+  static void countData(const TpcData& tpd, ToolCallProfile::Count& nchan, long& nbyte);
+
+  // Time fun, which processes data dat, for method imet.
+  template<class T, class F>
+  DataMap timeCall(ToolCallProfile::Method imet, const T& dat, bool mod, F fun) const;
+
+};
+
+#endif
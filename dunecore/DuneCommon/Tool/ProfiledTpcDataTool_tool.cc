@@ -0,0 +1,238 @@
+// ProfiledTpcDataTool_tool.cc
+
+#include "ProfiledTpcDataTool.h"
+#include "dunecore/ArtSupport/DuneToolManager.h"
+#include "dunecore/DuneInterface/Data/TraceRecorder.h"
+#include <iostream>
+
+using std::cout;
+using std::endl;
+using Name = ProfiledTpcDataTool::Name;
+using Count = ToolCallProfile::Count;
+
+namespace {
+
+template<class V>
+long vectorBytes(const V& vals) {
+  return vals.size()*sizeof(typename V::value_type);
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+ProfiledTpcDataTool::ProfiledTpcDataTool(fhicl::ParameterSet const& ps)
+: m_LogLevel(ps.get<Index>("LogLevel")),
+  m_ToolName(ps.get<Name>("ToolName")),
+  m_Label(ps.get<Name>("Label")),
+  m_ptpdtool(nullptr),
+  m_closed(false) {
+  const Name myname = "ProfiledTpcDataTool::ctor: ";
+  if ( m_Label.empty() ) m_Label = m_ToolName;
+  DuneToolManager* ptm = DuneToolManager::instance();
+  if ( ptm == nullptr ) {
+    cout << myname << "ERROR: Unable to retrieve tool manager." << endl;
+  } else {
+    m_ptool = ptm->getPrivate<AdcChannelTool>(m_ToolName);
+    if ( ! m_ptool ) {
+      cout << myname << "ERROR: Unable to retrieve tool " << m_ToolName << endl;
+    }
+    m_ptpdtool = dynamic_cast<TpcDataTool*>(m_ptool.get());
+  }
+  m_pprf = ToolCallProfile::registered(m_Label);
+  for ( Index imet=0; imet<ToolCallProfile::NMethod; ++imet ) {
+    m_traceNames[imet] = TraceRecorder::instance().intern(m_Label + "::" + ToolCallProfile::methodName(imet));
+  }
+  if ( m_LogLevel >= 1 ) {
+    cout << myname << "  LogLevel: " << m_LogLevel << endl;
+    cout << myname << "  ToolName: " << m_ToolName
+         << (m_ptpdtool == nullptr ? " (not a TpcDataTool)" : "") << endl;
+    cout << myname << "     Label: " << m_Label << endl;
+  }
+}
+
+//**********************************************************************
+
+ProfiledTpcDataTool::~ProfiledTpcDataTool() {
+  if ( ! m_closed ) close();
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::update(AdcChannelData& acd) const {
+  if ( ! m_ptool ) return noTool();
+  return timeCall(ToolCallProfile::Update, acd, true,
+                  [this, &acd]() { return m_ptool->update(acd); });
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::view(const AdcChannelData& acd) const {
+  if ( ! m_ptool ) return noTool();
+  return timeCall(ToolCallProfile::View, acd, false,
+                  [this, &acd]() { return m_ptool->view(acd); });
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::updateMap(AdcChannelDataMap& acds) const {
+  if ( ! m_ptool ) return noTool();
+  return timeCall(ToolCallProfile::UpdateMap, acds, true,
+                  [this, &acds]() { return m_ptool->updateMap(acds); });
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::viewMap(const AdcChannelDataMap& acds) const {
+  if ( ! m_ptool ) return noTool();
+  return timeCall(ToolCallProfile::ViewMap, acds, false,
+                  [this, &acds]() { return m_ptool->viewMap(acds); });
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::updateFlatMap(AdcChannelDataFlatMap& acds) const {
+  if ( ! m_ptool ) return noTool();
+  return timeCall(ToolCallProfile::UpdateFlatMap, acds, true,
+                  [this, &acds]() { return m_ptool->updateFlatMap(acds); });
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::viewFlatMap(const AdcChannelDataFlatMap& acds) const {
+  if ( ! m_ptool ) return noTool();
+  return timeCall(ToolCallProfile::ViewFlatMap, acds, false,
+                  [this, &acds]() { return m_ptool->viewFlatMap(acds); });
+}
+
+//**********************************************************************
+
+bool ProfiledTpcDataTool::channelParallel() const {
+  return m_ptool && m_ptool->channelParallel();
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::beginEvent(const DuneEventInfo& devt) const {
+  if ( ! m_ptool ) return noTool();
+  return m_ptool->beginEvent(devt);
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::endEvent(const DuneEventInfo& devt) const {
+  if ( ! m_ptool ) return noTool();
+  return m_ptool->endEvent(devt);
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::close(const DataMap* dmin) {
+  const Name myname = "ProfiledTpcDataTool::close: ";
+  DataMap ret;
+  if ( m_closed ) return ret;
+  m_closed = true;
+  if ( m_ptool ) ret = m_ptool->close(dmin);
+  if ( m_LogLevel >= 1 ) {
+    cout << myname << "Profile for " << m_Label << ":" << endl;
+    m_pprf->print(cout, myname);
+  }
+  if ( m_LogLevel >= 2 ) {
+    cout << myname << "Profiles for all registered tools:" << endl;
+    ToolCallProfile::printAll(cout, myname);
+  }
+  ToolCallProfile::Entry ent = m_pprf->total();
+  ret.setInt("profile_calls", ent.calls);
+  ret.setInt("profile_channels", ent.channels);
+  ret.setFloat("profile_seconds", ent.seconds());
+  return ret;
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::updateTpcData(TpcData& tpd) const {
+  if ( m_ptpdtool == nullptr ) return TpcDataTool::updateTpcData(tpd);
+  return timeCall(ToolCallProfile::UpdateTpcData, tpd, true,
+                  [this, &tpd]() { return m_ptpdtool->updateTpcData(tpd); });
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::viewTpcData(const TpcData& tpd) const {
+  if ( m_ptpdtool == nullptr ) return TpcDataTool::viewTpcData(tpd);
+  return timeCall(ToolCallProfile::ViewTpcData, tpd, false,
+                  [this, &tpd]() { return m_ptpdtool->viewTpcData(tpd); });
+}
+
+//**********************************************************************
+
+long ProfiledTpcDataTool::dataBytes(const AdcChannelData& acd) {
+  long nbyte = vectorBytes(acd.raw) + vectorBytes(acd.samples) + vectorBytes(acd.flags) +
+               vectorBytes(acd.signal) + vectorBytes(acd.rois) +
+               vectorBytes(acd.dftmags) + vectorBytes(acd.dftphases);
+  for ( const AdcSignalVector& sams : acd.binSamples ) nbyte += vectorBytes(sams);
+  return nbyte;
+}
+
+//**********************************************************************
+
+DataMap ProfiledTpcDataTool::noTool() const {
+  const Name myname = "ProfiledTpcDataTool: ";
+  if ( m_LogLevel >= 3 ) cout << myname << "ERROR: Tool " << m_ToolName << " not found." << endl;
+  return DataMap(1);
+}
+
+//**********************************************************************
+
+void ProfiledTpcDataTool::countData(const AdcChannelData& acd, Count& nchan, long& nbyte) {
+  ++nchan;
+  nbyte += dataBytes(acd);
+}
+
+//**********************************************************************
+
+template<class C>
+void ProfiledTpcDataTool::countData(const C& acds, Count& nchan, long& nbyte) {
+  for ( const auto& iacd : acds ) countData(iacd.second, nchan, nbyte);
+}
+
+//**********************************************************************
+
+void ProfiledTpcDataTool::countData(const TpcData& tpd, Count& nchan, long& nbyte) {
+  for ( const TpcData::AdcDataPtr& padc : tpd.getAdcData() ) {
+    if ( padc ) countData(*padc, nchan, nbyte);
+  }
+}
+
+//**********************************************************************
+
+template<class T, class F>
+DataMap ProfiledTpcDataTool::timeCall(ToolCallProfile::Method imet, const T& dat, bool mod, F fun) const {
+  const Name myname = "ProfiledTpcDataTool::timeCall: ";
+  // The data are counted outside the timed interval.
+  Count nchan = 0;
+  long nbyte0 = 0;
+  countData(dat, nchan, nbyte0);
+  TraceSpan span("tool", m_traceNames[imet]);
+  span.arg("nchan", nchan);
+  ToolCallProfile::Clock::time_point start = ToolCallProfile::Clock::now();
+  DataMap ret = fun();
+  Count nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(ToolCallProfile::Clock::now() - start).count();
+  long dbyte = 0;
+  if ( mod ) {
+    Count nchan1 = 0;
+    long nbyte1 = 0;
+    countData(dat, nchan1, nbyte1);
+    dbyte = nbyte1 - nbyte0;
+  }
+  m_pprf->record(imet, nchan, nsec, dbyte);
+  if ( m_LogLevel >= 3 ) {
+    cout << myname << m_Label << " " << ToolCallProfile::methodName(imet) << " processed "
+         << nchan << " channel" << (nchan == 1 ? "" : "s") << endl;
+  }
+  return ret;
+}
+
+//**********************************************************************
+
+DEFINE_ART_CLASS_TOOL(ProfiledTpcDataTool)
@@ -4,6 +4,13 @@
 // August 2017
 //
 // Tool that provides access to and management of histograms.
+//
+// Each managed histogram is given an ID, its position in the order of
+// management, so that callers may fetch it with getById without a name lookup.
+// fill(id, x, w) appends to a buffer owned by the calling thread. Each thread
+// finds its buffer without locking after its first fill, so fills may be made
+// from parallel loops. flush() adds the buffered fills to the histograms and
+// is called by release and the dtor. It must not overlap with fills.
 
 #ifndef SimpleHistogramManager_H
 #define SimpleHistogramManager_H
@@ -12,6 +19,11 @@
 #include "fhiclcpp/ParameterSet.h"
 #include "dunecore/DuneInterface/Tool/HistogramManager.h"
 #include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 
 class SimpleHistogramManager : public HistogramManager {
 
@@ -33,14 +45,42 @@ public:
 
   int release(Name hname) override;
 
+  Index id(Name hname) const override;
+
+  TH1* getById(Index hid) const override;
+
+  int fill(Index hid, double x, double w =1.0) override;
+
+  int flush() override;
+
 private:
 
+  // Buffered fill.
+  struct FillEntry {
+    Index hid;
+    double x;
+    double w;
+  };
+  using FillBuffer = std::vector<FillEntry>;
+
+  // Return the fill buffer for the calling thread.
+  FillBuffer& threadBuffer();
+
   // Parameters.
   int m_LogLevel;
 
   // Local data.
   NameVector m_names;
   std::map<Name, TH1*> m_hists;
+  std::map<Name, Index> m_ids;
+  std::vector<TH1*> m_histById;
+  mutable std::shared_mutex m_histMutex;
+
+  // Fill buffers for each thread and an ID to identify this manager in the
+  // thread-local cache.
+  std::map<std::thread::id, std::unique_ptr<FillBuffer>> m_buffers;
+  std::mutex m_bufferMutex;
+  Index m_serial;
 
 };
 
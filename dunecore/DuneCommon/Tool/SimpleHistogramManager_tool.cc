@@ -3,17 +3,35 @@
 #include "SimpleHistogramManager.h"
 #include "TH1.h"
 #include <iostream>
+#include <atomic>
+#include <algorithm>
 
 using std::string;
 using std::cout;
 using std::endl;
 
 using NameVector = HistogramManager::NameVector;
+using Index = HistogramManager::Index;
+
+namespace {
+
+// Source of manager serial numbers.
+std::atomic<Index> nextSerial(1);
+
+// Last fill buffer used by each thread and the serial of its manager.
+struct ThreadBufferCache {
+  Index serial = 0;
+  void* pbuf = nullptr;
+};
+thread_local ThreadBufferCache threadBufferCache;
+
+}  // end unnamed namespace
 
 //**********************************************************************
 
 SimpleHistogramManager::SimpleHistogramManager(fhicl::ParameterSet const& ps)
-:  m_LogLevel(ps.get<int>("LogLevel")) {
+:  m_LogLevel(ps.get<int>("LogLevel")),
+   m_serial(nextSerial++) {
   const string myname = "SimpleHistogramManager::ctor: ";
   if ( m_LogLevel > 0 ) {
     cout << myname << "LogLevel: " << m_LogLevel << endl;
@@ -50,20 +68,25 @@ int SimpleHistogramManager::manage(TH1* ph) {
     return 3;
   }
   ph->SetDirectory(nullptr);
+  std::unique_lock<std::shared_mutex> lock(m_histMutex);
   m_hists[hname] = ph;
   m_names.push_back(hname);
+  m_ids[hname] = m_histById.size();
+  m_histById.push_back(ph);
   return 0;
 }
   
 //**********************************************************************
 
 NameVector SimpleHistogramManager::names() const {
+  std::shared_lock<std::shared_mutex> lock(m_histMutex);
   return m_names;
 }
 
 //**********************************************************************
 
 TH1* SimpleHistogramManager::get(Name hname) const {
+  std::shared_lock<std::shared_mutex> lock(m_histMutex);
   std::map<Name, TH1*>::const_iterator ihst = m_hists.find(hname);
   if ( ihst == m_hists.end() ) return nullptr;
   return ihst->second;
@@ -79,15 +102,24 @@ TH1* SimpleHistogramManager::last() const {
 //**********************************************************************
 
 int SimpleHistogramManager::release(Name hname) {
+  flush();
+  std::unique_lock<std::shared_mutex> lock(m_histMutex);
   if ( hname == "*" ) {
     for ( auto ent : m_hists ) delete ent.second;
     m_names.clear();
     m_hists.clear();
+    m_ids.clear();
+    std::fill(m_histById.begin(), m_histById.end(), nullptr);
   }
   std::map<Name, TH1*>::const_iterator ihst = m_hists.find(hname);
   if ( ihst == m_hists.end() ) return 1;
   NameVector::iterator inam = find(m_names.begin(), m_names.end(), hname );
   if ( inam == m_names.end() ) return 2;
+  std::map<Name, Index>::iterator iid = m_ids.find(hname);
+  if ( iid != m_ids.end() ) {
+    m_histById[iid->second] = nullptr;
+    m_ids.erase(iid);
+  }
   m_names.erase(inam);
   m_hists.erase(ihst);
   return 0;
@@ -95,4 +127,62 @@ int SimpleHistogramManager::release(Name hname) {
 
 //**********************************************************************
 
+Index SimpleHistogramManager::id(Name hname) const {
+  std::shared_lock<std::shared_mutex> lock(m_histMutex);
+  std::map<Name, Index>::const_iterator iid = m_ids.find(hname);
+  if ( iid == m_ids.end() ) return badIndex();
+  return iid->second;
+}
+
+//**********************************************************************
+
+TH1* SimpleHistogramManager::getById(Index hid) const {
+  std::shared_lock<std::shared_mutex> lock(m_histMutex);
+  return hid < m_histById.size() ? m_histById[hid] : nullptr;
+}
+
+//**********************************************************************
+
+int SimpleHistogramManager::fill(Index hid, double x, double w) {
+  threadBuffer().push_back({hid, x, w});
+  return 0;
+}
+
+//**********************************************************************
+
+int SimpleHistogramManager::flush() {
+  const string myname = "SimpleHistogramManager::flush: ";
+  std::lock_guard<std::mutex> block(m_bufferMutex);
+  std::shared_lock<std::shared_mutex> hlock(m_histMutex);
+  Index nbad = 0;
+  for ( auto& ent : m_buffers ) {
+    FillBuffer& buf = *ent.second;
+    for ( const FillEntry& fent : buf ) {
+      TH1* ph = fent.hid < m_histById.size() ? m_histById[fent.hid] : nullptr;
+      if ( ph == nullptr ) ++nbad;
+      else ph->Fill(fent.x, fent.w);
+    }
+    buf.clear();
+  }
+  if ( nbad && m_LogLevel > 1 ) {
+    cout << myname << "Dropped " << nbad << " fills for unknown histograms." << endl;
+  }
+  return nbad ? 1 : 0;
+}
+
+//**********************************************************************
+
+SimpleHistogramManager::FillBuffer& SimpleHistogramManager::threadBuffer() {
+  ThreadBufferCache& cache = threadBufferCache;
+  if ( cache.serial == m_serial ) return *static_cast<FillBuffer*>(cache.pbuf);
+  std::lock_guard<std::mutex> lock(m_bufferMutex);
+  std::unique_ptr<FillBuffer>& pbuf = m_buffers[std::this_thread::get_id()];
+  if ( ! pbuf ) pbuf.reset(new FillBuffer);
+  cache.serial = m_serial;
+  cache.pbuf = pbuf.get();
+  return *pbuf;
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(SimpleHistogramManager)
@@ -15,6 +15,10 @@
 // The file name is FileName converted with TSystem::ExpandPathName,
 // i.e. ~ and $XXX are resolved.
 //
+// If the mapped indices are compact, i.e. their range is not much larger than
+// the number of entries, the map is also held in a dense vector so that get is an
+// array lookup and getMany is a gather.
+//
 // Parameters:
 //   LogLevel - Message logging level:
 //              0: none
@@ -49,6 +53,12 @@ public:
   // Return the channel status.
   Index get(Index icha) const override;
 
+  // Map nidx indices.
+  void getMany(const Index* pidx, Index nidx, Index* pval) const override;
+
+  // Return if the dense vector is used.
+  bool isDense() const { return m_vals.size() > 0; }
+
 private:
 
   using String = std::string;
@@ -65,6 +75,8 @@ private:
 
   // Derived data.
   IndexMap m_map;
+  Index m_idx0 =0;        // First index in the dense vector
+  IndexVector m_vals;     // Dense values for indices starting at m_idx0
 
 };
 
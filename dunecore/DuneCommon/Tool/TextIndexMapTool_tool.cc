@@ -103,6 +103,16 @@ TextIndexMapTool::TextIndexMapTool(fhicl::ParameterSet const& ps)
       m_map[iidx] = ival;
     }
   }
+  // Build the dense vector if the indices are compact.
+  if ( m_map.size() ) {
+    Index idx0 = m_map.begin()->first;
+    Index nval = m_map.rbegin()->first - idx0 + 1;
+    if ( nval <= 2*m_map.size() + 64 ) {
+      m_idx0 = idx0;
+      m_vals.resize(nval, m_DefaultValue);
+      for ( const IndexMap::value_type& ient : m_map ) m_vals[ient.first - m_idx0] = ient.second;
+    }
+  }
   // Display the parameters and result summary.
   if ( m_LogLevel >= 1 ) {
     cout << myname << "        LogLevel: " << m_LogLevel << endl;
@@ -119,6 +129,7 @@ TextIndexMapTool::TextIndexMapTool(fhicl::ParameterSet const& ps)
     cout << myname << "              Map size: " << m_map.size() << endl;
     cout << myname << "        Bad line count: " << nbad << endl;
     cout << myname << "  Duplicate line count: " << ndup << endl;
+    cout << myname << "     Dense vector size: " << m_vals.size() << endl;
   }
 }
 
@@ -126,6 +137,10 @@ TextIndexMapTool::TextIndexMapTool(fhicl::ParameterSet const& ps)
 
 Index TextIndexMapTool::get(Index iidx) const {
   const String myname = "TextIndexMapTool::get: ";
+  if ( isDense() ) {
+    Index ipos = iidx - m_idx0;
+    return ipos < m_vals.size() ? m_vals[ipos] : m_DefaultValue;
+  }
   IndexMap::const_iterator ient = m_map.find(iidx);
   if ( ient == m_map.end() ) return m_DefaultValue;
   return ient->second;
@@ -133,4 +148,19 @@ Index TextIndexMapTool::get(Index iidx) const {
 
 //**********************************************************************
 
+void TextIndexMapTool::getMany(const Index* pidx, Index nidx, Index* pval) const {
+  if ( ! isDense() ) {
+    for ( Index iidx=0; iidx<nidx; ++iidx ) pval[iidx] = get(pidx[iidx]);
+    return;
+  }
+  const Index* pvals = m_vals.data();
+  Index nval = m_vals.size();
+  for ( Index iidx=0; iidx<nidx; ++iidx ) {
+    Index ipos = pidx[iidx] - m_idx0;
+    pval[iidx] = ipos < nval ? pvals[ipos] : m_DefaultValue;
+  }
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(TextIndexMapTool)
@@ -32,6 +32,16 @@
 //
 // If the run data tool is found and has phaseGroup, then
 //  runPhase = rdat.phases[igrp]
+//
+// The offsets method computes many offsets in one call. The run data,
+// channel map and FEMB scale are looked up only when the run, subrun or FEMB
+// changes from one datum to the next and the unscaled tick offset is computed
+// with integer arithmetic only. The results are the same as offset.
+//
+// The evaluator for a datum holds the tick phase, run phase and FEMB scale for
+// its run, subrun, channel and FEMB, so callers may evaluate offsets for any
+// clock value without further lookups. The offset and offsets methods use the
+// same evaluator constants.
 
 #ifndef TimingRawDecoderOffsetTool_H
 #define TimingRawDecoderOffsetTool_H
@@ -43,6 +53,10 @@
 #include <map>
 
 class RunDataTool;
+class RunData;
+namespace dune {
+  class PdspChannelMapService;
+}
 
 class TimingRawDecoderOffsetTool : public TimeOffsetTool {
 
@@ -59,11 +73,27 @@ public:
   // Dtor.
   ~TimingRawDecoderOffsetTool() override =default;
 
-  // Return run data.
+  // Return the offset for one datum.
   Offset offset(const Data& dat) const override;
 
+  // Return the offsets for many data.
+  Index offsets(const Data* pdats, Index ndat, Offset* poffs) const override;
+
+  // Return the evaluator for data with the run, subrun, channel and FEMB of dat.
+  Evaluator evaluator(const Data& dat) const override;
+
 private:
 
+  enum class UnitCode { daq, ns, tick, bad };
+
+  // Return the phase for channel icha from the run data.
+  // The channel map is only used if the phase group requires it.
+  Index runPhase(const RunData& rdat, Index icha,
+                 const dune::PdspChannelMapService* pchanMap) const;
+
+  // Return the evaluator for a FEMB scale and run phase.
+  Evaluator makeEvaluator(bool haveScale, double scale, Index runPhase) const;
+
   // Parameters.
   Index m_LogLevel;
   Index m_TpcTickPhase;
@@ -76,6 +106,7 @@ private:
 
   // Derived from configuration.
   ScaleMap m_fembScales;    // Indexed by FEMB ID
+  UnitCode m_unitCode;
 
 };
 
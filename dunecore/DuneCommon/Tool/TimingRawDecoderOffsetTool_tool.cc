@@ -14,6 +14,7 @@ using std::string;
 using std::ifstream;
 
 using Offset = TimingRawDecoderOffsetTool::Offset;
+using Evaluator = TimingRawDecoderOffsetTool::Evaluator;
 
 //**********************************************************************
 
@@ -23,8 +24,12 @@ TimingRawDecoderOffsetTool::TimingRawDecoderOffsetTool(fhicl::ParameterSet const
   m_Unit(ps.get<Name>("Unit")),
   m_FembScaleIds(ps.get<IndexVector>("FembScaleIds")),
   m_FembScaleValues(ps.get<DoubleVector>("FembScaleValues")),
-  m_RunDataTool(ps.get<Name>("RunDataTool")) {
+  m_RunDataTool(ps.get<Name>("RunDataTool")),
+  m_unitCode(UnitCode::bad) {
   const Name myname = "TimingRawDecoderOffsetTool::ctor: ";
+  if      ( m_Unit == "daq"  ) m_unitCode = UnitCode::daq;
+  else if ( m_Unit == "ns"   ) m_unitCode = UnitCode::ns;
+  else if ( m_Unit == "tick" ) m_unitCode = UnitCode::tick;
   if ( m_RunDataTool.size() ) {
     DuneToolManager* ptm = DuneToolManager::instance();
     m_pRunDataTool = ptm->getShared<RunDataTool>(m_RunDataTool);
@@ -87,71 +92,24 @@ Offset TimingRawDecoderOffsetTool::offset(const Data& dat) const {
     }
     --checkCount;
   }
-  if ( m_Unit == "daq" ) {
-    res.value = scale*daqVal;
-    res.rem = 0.0;
-  } else if ( m_Unit == "ns" ) {
-    res.value = scale*20*daqVal;
-    res.rem = 0.0;
-  } else if ( m_Unit == "tick" ) {
-    Index runPhase = 0;
+  if ( m_unitCode == UnitCode::bad ) {
+    cout << myname << "Invalid unit: " << m_Unit << ifname << endl;
+    return res.setStatus(2);
+  }
+  Index runPhase = 0;
+  if ( m_unitCode == UnitCode::tick ) {
     if ( m_pRunDataTool != nullptr ) {
-      Index icha = dat.channel;
       RunData rdat = m_pRunDataTool->runData(dat.run, dat.subrun);
       if ( rdat.havePhaseGroup() ) {
-        bool haveGroup = true;
-        Index igrp = 0;
         art::ServiceHandle<dune::PdspChannelMapService> pchanMap;
-        bool useWib = false;
-        bool useFemb = false;
-        if ( rdat.phaseGroup() == "channel" ) igrp = icha;
-        else if ( rdat.phaseGroup() == "all" ) igrp = 0;
-        else if ( rdat.phaseGroup() == "wib" ) useWib = true;
-        else if ( rdat.phaseGroup() == "femb" ) useFemb = true;
-        else {
-          haveGroup = false;
-          cout << myname << "WARNING: Invalid phase group: " << rdat.phaseGroup() << endl;
-        }
-        if ( haveGroup ) {
-          art::ServiceHandle<dune::PdspChannelMapService> pchanMap;
-          if ( pchanMap.get() != nullptr ) {
-            Index kapa = pchanMap->APAFromOfflineChannel(icha);
-            Index jwib = pchanMap->WIBFromOfflineChannel(icha);
-            Index jcon = pchanMap->FEMBFromOfflineChannel(icha);
-            Index jfmb = 5*jcon + jwib;
-            Index kfmb = 20*kapa + jfmb;
-            Index kwib = 5*kapa + jfmb%5;
-            if ( useWib  ) igrp = kwib;
-            if ( useFemb ) igrp = kfmb;
-          } else {
-            haveGroup = false;
-            cout << myname << "WARNING: Channel map service not found." << endl;
-          }
-        }
-        if ( haveGroup ) {
-          const RunData::IndexVector& phases = rdat.phases();
-          if ( igrp + 1 > phases.size() ) {
-            cout << myname << "WARNING: Phases is too short: " << igrp << "/" << phases.size() << endl;
-          } else {
-            runPhase = phases[igrp];
-          }
-        }
+        runPhase = this->runPhase(rdat, dat.channel, pchanMap.get());
       }
       if ( m_LogLevel >= 3 ) cout << myname << "Run phase is " << runPhase << endl;
     } else {
       if ( m_LogLevel >= 3 ) cout << myname << "Run data tool not found." << endl;
     }
-    long daqoff = daqVal + m_TpcTickPhase + runPhase;
-    if ( haveScale ) {
-      res.value = scale*daqoff/25;
-    } else {
-      res.value = daqoff/25;
-    }
-    res.rem = (daqoff % 25)/25.0;
-  } else {
-    cout << myname << "Invalid unit: " << m_Unit << ifname << endl;
-    return res.setStatus(2);
   }
+  makeEvaluator(haveScale, scale, runPhase).fill(daqVal, res);
   res.unit = m_Unit;
   if ( m_LogLevel >= 2 ) cout << myname << "Offset is " << res.value
                               << " " << res.unit << endl;
@@ -160,4 +118,157 @@ Offset TimingRawDecoderOffsetTool::offset(const Data& dat) const {
 
 //**********************************************************************
 
+TimeOffsetTool::Index
+TimingRawDecoderOffsetTool::offsets(const Data* pdats, Index ndat, Offset* poffs) const {
+  const Name myname = "TimingRawDecoderOffsetTool::offsets: ";
+  if ( m_unitCode == UnitCode::bad ) {
+    cout << myname << "Invalid unit: " << m_Unit << endl;
+    for ( Index idat=0; idat<ndat; ++idat ) poffs[idat] = Offset().setStatus(2);
+    return ndat;
+  }
+  // Run data and FEMB scale for the previous datum.
+  bool haveRun = false;
+  Index lastRun = 0;
+  Index lastSubrun = 0;
+  RunData rdat;
+  bool usePhase = false;
+  const dune::PdspChannelMapService* pchanMap = nullptr;
+  bool haveFemb = false;
+  Index lastFemb = 0;
+  bool haveScale = false;
+  double scale = 1.0;
+  bool haveEval = false;
+  Index lastPhase = 0;
+  Evaluator eval;
+  for ( Index idat=0; idat<ndat; ++idat ) {
+    const Data& dat = pdats[idat];
+    Offset& res = poffs[idat];
+    res = Offset();
+    if ( ! haveFemb || dat.fembID != lastFemb ) {
+      ScaleMap::const_iterator isca = m_fembScales.find(dat.fembID);
+      haveScale = isca != m_fembScales.end();
+      scale = haveScale ? isca->second : 1.0;
+      lastFemb = dat.fembID;
+      haveFemb = true;
+      haveEval = false;
+    }
+    Index runPhase = 0;
+    if ( m_unitCode == UnitCode::tick && m_pRunDataTool != nullptr ) {
+      if ( ! haveRun || dat.run != lastRun || dat.subrun != lastSubrun ) {
+        rdat = m_pRunDataTool->runData(dat.run, dat.subrun);
+        usePhase = rdat.havePhaseGroup();
+        if ( usePhase && pchanMap == nullptr ) {
+          art::ServiceHandle<dune::PdspChannelMapService> hchanMap;
+          pchanMap = hchanMap.get();
+        }
+        lastRun = dat.run;
+        lastSubrun = dat.subrun;
+        haveRun = true;
+      }
+      if ( usePhase ) runPhase = this->runPhase(rdat, dat.channel, pchanMap);
+    }
+    if ( ! haveEval || runPhase != lastPhase ) {
+      eval = makeEvaluator(haveScale, scale, runPhase);
+      lastPhase = runPhase;
+      haveEval = true;
+    }
+    eval.fill(dat.triggerClock, res);
+    res.unit = m_Unit;
+  }
+  if ( m_LogLevel >= 2 ) cout << myname << "Filled " << ndat << " offsets." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+TimeOffsetTool::Index TimingRawDecoderOffsetTool::
+runPhase(const RunData& rdat, Index icha, const dune::PdspChannelMapService* pchanMap) const {
+  const Name myname = "TimingRawDecoderOffsetTool::runPhase: ";
+  bool haveGroup = true;
+  Index igrp = 0;
+  bool useWib = false;
+  bool useFemb = false;
+  if ( rdat.phaseGroup() == "channel" ) igrp = icha;
+  else if ( rdat.phaseGroup() == "all" ) igrp = 0;
+  else if ( rdat.phaseGroup() == "wib" ) useWib = true;
+  else if ( rdat.phaseGroup() == "femb" ) useFemb = true;
+  else {
+    haveGroup = false;
+    cout << myname << "WARNING: Invalid phase group: " << rdat.phaseGroup() << endl;
+  }
+  if ( haveGroup ) {
+    if ( pchanMap != nullptr ) {
+      Index kapa = pchanMap->APAFromOfflineChannel(icha);
+      Index jwib = pchanMap->WIBFromOfflineChannel(icha);
+      Index jcon = pchanMap->FEMBFromOfflineChannel(icha);
+      Index jfmb = 5*jcon + jwib;
+      Index kfmb = 20*kapa + jfmb;
+      Index kwib = 5*kapa + jfmb%5;
+      if ( useWib  ) igrp = kwib;
+      if ( useFemb ) igrp = kfmb;
+    } else {
+      haveGroup = false;
+      cout << myname << "WARNING: Channel map service not found." << endl;
+    }
+  }
+  if ( haveGroup ) {
+    const RunData::IndexVector& phases = rdat.phases();
+    if ( igrp + 1 > phases.size() ) {
+      cout << myname << "WARNING: Phases is too short: " << igrp << "/" << phases.size() << endl;
+    } else {
+      return phases[igrp];
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+Evaluator TimingRawDecoderOffsetTool::evaluator(const Data& dat) const {
+  const Name myname = "TimingRawDecoderOffsetTool::evaluator: ";
+  ScaleMap::const_iterator isca = m_fembScales.find(dat.fembID);
+  bool haveScale = isca != m_fembScales.end();
+  double scale = haveScale ? isca->second : 1.0;
+  Index runPhase = 0;
+  if ( m_unitCode == UnitCode::tick && m_pRunDataTool != nullptr ) {
+    RunData rdat = m_pRunDataTool->runData(dat.run, dat.subrun);
+    if ( rdat.havePhaseGroup() ) {
+      art::ServiceHandle<dune::PdspChannelMapService> pchanMap;
+      runPhase = this->runPhase(rdat, dat.channel, pchanMap.get());
+    }
+  }
+  Evaluator eval = makeEvaluator(haveScale, scale, runPhase);
+  if ( m_LogLevel >= 2 ) {
+    cout << myname << "Evaluator for run " << dat.run << "-" << dat.subrun
+         << " channel " << dat.channel << ": status " << eval.status
+         << ", phase " << eval.phase << ", scale " << eval.scale << endl;
+  }
+  return eval;
+}
+
+//**********************************************************************
+
+Evaluator TimingRawDecoderOffsetTool::
+makeEvaluator(bool haveScale, double scale, Index runPhase) const {
+  Evaluator eval;
+  eval.status = 0;
+  eval.scaled = haveScale;
+  eval.scale = scale;
+  if ( m_unitCode == UnitCode::daq ) {
+    eval.mult = 1;
+  } else if ( m_unitCode == UnitCode::ns ) {
+    eval.mult = 20;
+  } else if ( m_unitCode == UnitCode::tick ) {
+    // The TPC tick period is 25 DAQ ticks.
+    eval.mult = 1;
+    eval.phase = m_TpcTickPhase + runPhase;
+    eval.period = 25;
+  } else {
+    eval.status = 2;
+  }
+  return eval;
+}
+
+//**********************************************************************
+
 DEFINE_ART_CLASS_TOOL(TimingRawDecoderOffsetTool)
@@ -13,6 +13,7 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <vector>
 
 #undef NDEBUG
 #include <cassert>
@@ -87,6 +88,18 @@ int test_BlockIndexMapTool(bool useExistingFcl =false) {
     assert( val == chkval );
   }
 
+  cout << myname << line << endl;
+  cout << myname << "Checking getMany." << endl;
+  std::vector<Index> idxs;
+  for ( auto kchk : chk ) idxs.push_back(kchk.first);
+  idxs.push_back(1015);
+  chk[1015] = 1;
+  std::vector<Index> vals(idxs.size(), IndexMapTool::badIndex());
+  ptoo->getMany(idxs.data(), idxs.size(), vals.data());
+  for ( Index iidx=0; iidx<idxs.size(); ++iidx ) {
+    assert( vals[iidx] == chk[idxs[iidx]] );
+  }
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
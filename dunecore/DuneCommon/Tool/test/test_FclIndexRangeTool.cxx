@@ -96,6 +96,28 @@ int test_FclIndexRangeTool(bool useExistingFcl =false, Index runin =0) {
   cout << irb.rangeString() << endl;
   assert( ! irb.isValid() );
 
+  cout << myname << line << endl;
+  cout << "Check the lookup." << endl;
+  const IndexRangeLookup* pirl = irt->lookup();
+  assert( pirl != nullptr );
+  assert( pirl->size() == 2 );
+  Index iid1 = pirl->id("range1");
+  Index iid2 = pirl->id("range2");
+  assert( iid1 != IndexRangeLookup::badIndex() );
+  assert( iid2 != IndexRangeLookup::badIndex() );
+  assert( pirl->id("rangebad") == IndexRangeLookup::badIndex() );
+  assert( pirl->name(iid1) == "range1" );
+  assert( pirl->group(iid2).range(0).begin == 20 );
+  assert( pirl->firstId(9) == IndexRangeLookup::badIndex() );
+  assert( pirl->firstId(10) == iid1 );
+  assert( pirl->firstId(19) == iid1 );
+  assert( pirl->firstId(20) == iid2 );
+  assert( pirl->firstId(29) == iid2 );
+  assert( pirl->firstId(30) == IndexRangeLookup::badIndex() );
+  assert( pirl->count(15) == 1 );
+  assert( pirl->contains(iid2, 25) );
+  assert( ! pirl->contains(iid1, 25) );
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
@@ -84,6 +84,18 @@ int test_FclIndexVectorMapTool(bool useExistingFcl =false, Index runin =0) {
   assert( pvm->contains(101, 12) );
   assert( ! pvm->contains(101, 4) );
   assert( ! pvm->contains(102, 4) );
+  assert( ! pvm->contains(99, 2) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check getMany." << endl;
+  IndexVector idxs = {101, 99, 100, 102, 100000};
+  std::vector<IndexVector> vecs(idxs.size(), IndexVector(1, 7));
+  pvm->getMany(idxs.data(), idxs.size(), vecs.data());
+  assert( vecs[0] == IndexVector({12}) );
+  assert( vecs[1].size() == 0 );
+  assert( vecs[2] == IndexVector({2, 3}) );
+  assert( vecs[3].size() == 0 );
+  assert( vecs[4].size() == 0 );
 
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
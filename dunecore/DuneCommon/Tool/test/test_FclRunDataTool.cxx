@@ -112,6 +112,31 @@ int test_FclRunDataTool(bool useExistingFcl =false, Index runin =0) {
     assert( rdat.pulserAmplitude() == 8 );
   }
 
+  cout << myname << line << endl;
+  cout << "Fetch cached run data." << endl;
+  RunData rdat2 = rdt->runData(run);
+  assert( rdat2.run() == rdat.run() );
+  assert( rdat2.cryostat() == rdat.cryostat() );
+  assert( rdat2.apas() == rdat.apas() );
+  assert( rdat2.gain() == rdat.gain() );
+  assert( rdat2.shaping() == rdat.shaping() );
+  assert( rdat2.pulserAmplitude() == rdat.pulserAmplitude() );
+
+  cout << myname << line << endl;
+  cout << "Prefetch run data." << endl;
+  Index run2 = run + 1;
+  assert( rdt->prefetch({run, run2, run2}) == 1 );
+  assert( rdt->prefetch({run2}) == 0 );
+  RunData rdat3 = rdt->runData(run2);
+  cout << rdat3 << endl;
+  if ( run == 123 ) {
+    assert( rdat3.cryostat() == "protodune" );
+    assert( rdat3.apas().size() == 6 );
+    assert( rdat3.gain() == 14.0 );
+    assert( rdat3.pulserAmplitude() == 0 );
+  }
+  assert( rdt->runData(run2).gain() == rdat3.gain() );
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
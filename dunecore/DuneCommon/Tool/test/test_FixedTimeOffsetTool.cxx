@@ -84,6 +84,15 @@ int test_FixedTimeOffsetTool(bool useExistingFcl =false) {
   assert( off.rem == rem );
   assert( off.unit == "tick" );
 
+  cout << myname << line << endl;
+  cout << "Check the evaluator." << endl;
+  TimeOffsetTool::Evaluator eval = tot->evaluator(dat);
+  assert( eval.isValid() );
+  for ( unsigned long clk : {0ul, 1ul, 123456789ul} ) {
+    assert( eval.value(clk) == long(val) );
+    assert( eval.rem(clk) == rem );
+  }
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
@@ -0,0 +1,119 @@
+// test_NpyFloatArray.cxx
+//
+// Test NpyFloatArray.
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include "dunecore/ArtSupport/DuneToolManager.h"
+#include "dunecore/DuneInterface/Tool/FloatArrayTool.h"
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::ofstream;
+using std::vector;
+using Index = unsigned int;
+
+//**********************************************************************
+
+int test_NpyFloatArray(bool useExistingFcl =false) {
+  const string myname = "test_NpyFloatArray: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  Index nval = 20;
+  string npyfile = "test_NpyFloatArray.npy";
+  cout << myname << line << endl;
+  if ( ! useExistingFcl ) {
+    cout << myname << "Creating npy file." << endl;
+    vector<float> vals(nval);
+    for ( Index ival=0; ival<nval; ++ival ) vals[ival] = 100 + ival;
+    string hdr = "{'descr': '<f4', 'fortran_order': False, 'shape': (20,), }";
+    while ( (10 + hdr.size() + 1) % 64 ) hdr += ' ';
+    hdr += '\n';
+    ofstream fout(npyfile.c_str(), std::ios::binary);
+    fout.write("\x93NUMPY\x01\x00", 8);
+    fout.put(hdr.size() & 0xff);
+    fout.put(hdr.size() >> 8);
+    fout.write(hdr.data(), hdr.size());
+    fout.write(reinterpret_cast<const char*>(vals.data()), nval*sizeof(float));
+  }
+  string fclfile = "test_NpyFloatArray.fcl";
+  if ( ! useExistingFcl ) {
+    cout << myname << "Creating top-level FCL." << endl;
+    ofstream fout(fclfile.c_str());
+    fout << "tools: {" << endl;
+    fout << "  mytool: {" << endl;
+    fout << "    tool_type: NpyFloatArray" << endl;
+    fout << "    LogLevel: 2" << endl;
+    fout << "    FileName: \"" << npyfile << "\"" << endl;
+    fout << "    DefaultValue: 999" << endl;
+    fout << "    Offset: 10" << endl;
+    fout << "    Label: arr" << endl;
+    fout << "    Unit: cm" << endl;
+    fout << "  }" << endl;
+    fout << "}" << endl;
+    fout.close();
+  } else {
+    cout << myname << "Using existing top-level FCL." << endl;
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Fetching tool manager." << endl;
+  DuneToolManager* ptm = DuneToolManager::instance(fclfile);
+  assert ( ptm != nullptr );
+  DuneToolManager& tm = *ptm;
+  tm.print();
+  assert( tm.toolNames().size() >= 1 );
+
+  cout << myname << line << endl;
+  cout << myname << "Fetching tool." << endl;
+  auto ptoo = tm.getPrivate<FloatArrayTool>("mytool");
+  assert( ptoo != nullptr );
+
+  cout << myname << line << endl;
+  cout << myname << "Check values." << endl;
+  assert( ptoo->size() == nval );
+  assert( ptoo->offset() == 10 );
+  assert( ptoo->unit() == "cm" );
+  assert( ptoo->label() == "arr" );
+  for ( Index ival=0; ival<nval; ++ival ) {
+    assert( ptoo->values()[ival] == 100 + ival );
+  }
+  FloatArrayTool::FloatVector filled;
+  assert( ptoo->fill(filled, -1) == 0 );
+  assert( filled.size() == 10 + nval );
+  assert( filled[0] == -1 );
+  assert( filled[10] == 100 );
+  assert( filled[29] == 119 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main(int argc, char* argv[]) {
+  bool useExistingFcl = false;
+  if ( argc > 1 ) {
+    string sarg(argv[1]);
+    if ( sarg == "-h" ) {
+      cout << "Usage: " << argv[0] << " [keepFCL]" << endl;
+      cout << "  If keepFCL = true, existing FCL file is used." << endl;
+      return 0;
+    }
+    useExistingFcl = sarg == "true" || sarg == "1";
+  }
+  return test_NpyFloatArray(useExistingFcl);
+}
+
+//**********************************************************************
@@ -0,0 +1,123 @@
+// test_ProfiledTpcDataTool.cxx
+//
+// Test ProfiledTpcDataTool.
+//
+// The profiled tool is itself a ProfiledTpcDataTool whose target is missing
+// so that the test does not depend on other tools.
+
+#include "dunecore/ArtSupport/DuneToolManager.h"
+#include "dunecore/DuneInterface/Tool/TpcDataTool.h"
+#include "dunecore/DuneCommon/Utility/ToolCallProfile.h"
+#include <string>
+#include <iostream>
+#include <fstream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::ofstream;
+using Index = unsigned int;
+
+//**********************************************************************
+
+int test_ProfiledTpcDataTool(bool useExistingFcl =false) {
+  const string myname = "test_ProfiledTpcDataTool: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  string fclfile = "test_ProfiledTpcDataTool.fcl";
+  if ( ! useExistingFcl ) {
+    cout << myname << "Creating top-level FCL." << endl;
+    ofstream fout(fclfile.c_str());
+    fout << "tools: {" << endl;
+    fout << "  inner: {" << endl;
+    fout << "    tool_type: ProfiledTpcDataTool" << endl;
+    fout << "    LogLevel: 1" << endl;
+    fout << "    ToolName: nosuchtool" << endl;
+    fout << "    Label: \"\"" << endl;
+    fout << "  }" << endl;
+    fout << "  mytool: {" << endl;
+    fout << "    tool_type: ProfiledTpcDataTool" << endl;
+    fout << "    LogLevel: 2" << endl;
+    fout << "    ToolName: inner" << endl;
+    fout << "    Label: outer" << endl;
+    fout << "  }" << endl;
+    fout << "}" << endl;
+    fout.close();
+  } else {
+    cout << myname << "Using existing top-level FCL." << endl;
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Fetching tool manager." << endl;
+  DuneToolManager* ptm = DuneToolManager::instance(fclfile);
+  assert ( ptm != nullptr );
+  DuneToolManager& tm = *ptm;
+  tm.print();
+  assert( tm.toolNames().size() >= 2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Fetching tool." << endl;
+  auto ptoo = tm.getPrivate<TpcDataTool>("mytool");
+  assert( ptoo != nullptr );
+
+  cout << myname << line << endl;
+  cout << myname << "Call the tool." << endl;
+  Index ncha = 5;
+  AdcChannelDataMap acds;
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    AdcChannelData& acd = acds[icha];
+    acd.setChannelInfo(icha);
+    acd.samples.resize(100, 1.0);
+  }
+  DataMap ret = ptoo->updateMap(acds);
+  assert( ret.status() != 0 );
+  ret = ptoo->viewMap(acds);
+  assert( ret.status() != 0 );
+  ret = ptoo->view(acds[0]);
+  assert( ret.status() != 0 );
+  std::shared_ptr<ToolCallProfile> pprf = ToolCallProfile::registered("outer");
+  assert( pprf->entry(ToolCallProfile::UpdateMap).calls == 1 );
+  assert( pprf->entry(ToolCallProfile::UpdateMap).channels == ncha );
+  assert( pprf->entry(ToolCallProfile::UpdateMap).bytes == 0 );
+  assert( pprf->entry(ToolCallProfile::ViewMap).channels == ncha );
+  assert( pprf->entry(ToolCallProfile::View).channels == 1 );
+  assert( pprf->total().calls == 3 );
+  // The inner profile has the default label.
+  assert( ToolCallProfile::registered("nosuchtool")->total().calls == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Close the tool." << endl;
+  ret = ptoo->close();
+  assert( ret.getInt("profile_calls") == 3 );
+  assert( ret.getInt("profile_channels") == int(2*ncha + 1) );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main(int argc, char* argv[]) {
+  bool useExistingFcl = false;
+  if ( argc > 1 ) {
+    string sarg(argv[1]);
+    if ( sarg == "-h" ) {
+      cout << "Usage: " << argv[0] << " [keepFCL]" << endl;
+      cout << "  If keepFCL = true, existing FCL file is used." << endl;
+      return 0;
+    }
+    useExistingFcl = sarg == "true" || sarg == "1";
+  }
+  return test_ProfiledTpcDataTool(useExistingFcl);
+}
+
+//**********************************************************************
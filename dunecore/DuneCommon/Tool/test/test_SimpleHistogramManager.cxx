@@ -11,6 +11,8 @@
 #include "dunecore/DuneInterface/Tool/HistogramManager.h"
 #include "dunecore/ArtSupport/DuneToolManager.h"
 #include "TH1F.h"
+#include <thread>
+#include <vector>
 
 #undef NDEBUG
 #include <cassert>
@@ -70,6 +72,44 @@ int test_SimpleHistogramManager(bool useExistingFcl =false) {
   assert(phm->manage(ph) == 0);
   assert(ph->GetDirectory() == nullptr);
 
+  cout << myname << line << endl;
+  cout << myname << "Checking ID access." << endl;
+  TH1* ph2 = new TH1F("h2", "h2", 10, 0, 10);
+  assert(phm->manage(ph2) == 0);
+  HistogramManager::Index hid1 = phm->id("h1");
+  HistogramManager::Index hid2 = phm->id("h2");
+  assert( hid1 != HistogramManager::badIndex() );
+  assert( hid2 != HistogramManager::badIndex() );
+  assert( hid1 != hid2 );
+  assert( phm->id("nosuch") == HistogramManager::badIndex() );
+  assert( phm->getById(hid1) == ph );
+  assert( phm->getById(hid2) == ph2 );
+  assert( phm->getById(1000) == nullptr );
+
+  cout << myname << line << endl;
+  cout << myname << "Filling from threads." << endl;
+  unsigned int nthr = 4;
+  unsigned int nfill = 1000;
+  std::vector<std::thread> thrs;
+  for ( unsigned int ithr=0; ithr<nthr; ++ithr ) {
+    thrs.emplace_back([phm=phm.get(), hid1, hid2, ithr, nfill]() {
+      for ( unsigned int ifill=0; ifill<nfill; ++ifill ) {
+        phm->fill(hid1, ithr + 0.5);
+        phm->fill(hid2, 5.5, 2.0);
+      }
+    });
+  }
+  for ( std::thread& thr : thrs ) thr.join();
+  assert( ph->GetEntries() == 0 );
+  assert( phm->flush() == 0 );
+  cout << myname << "Entries: " << ph->GetEntries() << ", " << ph2->GetEntries() << endl;
+  assert( ph->GetEntries() == nthr*nfill );
+  assert( ph->GetBinContent(1) == nfill );
+  assert( ph2->GetEntries() == nthr*nfill );
+  assert( ph2->GetBinContent(6) == 2.0*nthr*nfill );
+  assert( phm->flush() == 0 );
+  assert( ph->GetEntries() == nthr*nfill );
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
@@ -10,6 +10,7 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #undef NDEBUG
 #include <cassert>
@@ -91,6 +92,19 @@ int test_TextIndexMapTool(bool useExistingFcl =false) {
     assert( val == expval );
   }
 
+  cout << myname << line << endl;
+  cout << myname << "Checking getMany." << endl;
+  std::vector<Index> idxs = {0, 4, 3, 11, 1, 2, 1000000};
+  std::vector<Index> vals(idxs.size(), 0);
+  ptoo->getMany(idxs.data(), idxs.size(), vals.data());
+  for ( Index iidx=0; iidx<idxs.size(); ++iidx ) {
+    Index idx = idxs[iidx];
+    Index expval = idx >= 1 && idx <= 4 ? 1000 + idx : badval;
+    cout << "   " << idx << ": " << vals[iidx] << " ?= " << expval << endl;
+    assert( vals[iidx] == expval );
+    assert( ptoo->get(idx) == expval );
+  }
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
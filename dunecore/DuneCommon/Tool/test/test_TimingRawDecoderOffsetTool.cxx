@@ -15,6 +15,7 @@
 
 #undef NDEBUG
 #include <cassert>
+#include <vector>
 
 using std::string;
 using std::cout;
@@ -85,6 +86,38 @@ int test_TimingRawDecoderOffsetTool(bool useExistingFcl =false) {
   assert( off.value == daqVal/25 );
   assert( off.unit == "tick" );
 
+  cout << myname << line << endl;
+  cout << "Fetch many time offsets." << endl;
+  Index ndat = 100;
+  std::vector<TimeOffsetTool::Data> dats(ndat, dat);
+  for ( Index idat=0; idat<ndat; ++idat ) {
+    dats[idat].channel = idat;
+    dats[idat].triggerClock = daqVal + 7*idat;
+  }
+  std::vector<TimeOffsetTool::Offset> offs(ndat);
+  assert( tot->offsets(dats.data(), ndat, offs.data()) == 0 );
+  for ( Index idat=0; idat<ndat; ++idat ) {
+    TimeOffsetTool::Offset offExp = tot->offset(dats[idat]);
+    assert( offs[idat].isValid() );
+    assert( offs[idat].value == offExp.value );
+    assert( offs[idat].rem == offExp.rem );
+    assert( offs[idat].unit == offExp.unit );
+    assert( offs[idat].value == long(dats[idat].triggerClock/25) );
+  }
+
+  cout << myname << line << endl;
+  cout << "Check the evaluator." << endl;
+  TimeOffsetTool::Evaluator eval = tot->evaluator(dat);
+  assert( eval.isValid() );
+  assert( eval.period == 25 );
+  for ( Index idat=0; idat<ndat; ++idat ) {
+    TimeOffsetTool::Offset offEval;
+    eval.fill(dats[idat].triggerClock, offEval);
+    assert( offEval.isValid() );
+    assert( offEval.value == offs[idat].value );
+    assert( offEval.rem == offs[idat].rem );
+  }
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
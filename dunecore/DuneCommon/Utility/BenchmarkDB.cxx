@@ -0,0 +1,270 @@
+// BenchmarkDB.cxx
+
+#include "BenchmarkDB.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+using std::string;
+using std::cout;
+using std::endl;
+using Name = BenchmarkDB::Name;
+using NameVector = BenchmarkDB::NameVector;
+using Result = BenchmarkDB::Result;
+using ResultVector = BenchmarkDB::ResultVector;
+using ComparisonVector = BenchmarkDB::ComparisonVector;
+
+namespace {
+
+// Owns a prepared statement.
+struct Statement {
+  sqlite3_stmt* pstmt = nullptr;
+  Statement(sqlite3* db, const char* sql) {
+    if ( db != nullptr && sqlite3_prepare_v2(db, sql, -1, &pstmt, nullptr) != SQLITE_OK ) pstmt = nullptr;
+  }
+  ~Statement() { sqlite3_finalize(pstmt); }
+  Statement(const Statement&) =delete;
+  Statement& operator=(const Statement&) =delete;
+  bool bind(int icol, const Name& val) {
+    return sqlite3_bind_text(pstmt, icol, val.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+  }
+  bool bind(int icol, double val) { return sqlite3_bind_double(pstmt, icol, val) == SQLITE_OK; }
+  bool bind(int icol, int val) { return sqlite3_bind_int(pstmt, icol, val) == SQLITE_OK; }
+  Name text(int icol) const {
+    const unsigned char* ptxt = sqlite3_column_text(pstmt, icol);
+    return ptxt == nullptr ? Name() : Name(reinterpret_cast<const char*>(ptxt));
+  }
+};
+
+const char* createSql =
+  "CREATE TABLE IF NOT EXISTS Benchmark ("
+  "Run TEXT NOT NULL, Kernel TEXT NOT NULL, Metric TEXT NOT NULL, Unit TEXT, "
+  "HigherIsBetter INTEGER, Value REAL, Spread REAL, Count INTEGER, "
+  "PRIMARY KEY (Run, Kernel, Metric))";
+
+double median(std::vector<double> vals) {
+  size_t nval = vals.size();
+  if ( nval == 0 ) return 0.0;
+  std::sort(vals.begin(), vals.end());
+  return nval % 2 ? vals[nval/2] : 0.5*(vals[nval/2 - 1] + vals[nval/2]);
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+// Class methods.
+//**********************************************************************
+
+Name BenchmarkDB::statusName(Status stat) {
+  switch ( stat ) {
+    case Unchanged: return "ok";
+    case Improved:  return "improved";
+    case Regressed: return "REGRESSED";
+    case Added:     return "added";
+    case Removed:   return "removed";
+  }
+  return "unknown";
+}
+
+//**********************************************************************
+
+Result BenchmarkDB::summarize(Name kernel, Name metric, Name unit, bool higherIsBetter,
+                              const DoubleVector& vals) {
+  Result res;
+  res.kernel = kernel;
+  res.metric = metric;
+  res.unit = unit;
+  res.higherIsBetter = higherIsBetter;
+  res.count = vals.size();
+  res.value = median(vals);
+  DoubleVector devs;
+  devs.reserve(vals.size());
+  for ( double val : vals ) devs.push_back(std::fabs(val - res.value));
+  // 1.4826 scales the median absolute deviation to the Gaussian sigma.
+  res.spread = res.count > 1 ? 1.4826*median(devs) : 0.0;
+  return res;
+}
+
+//**********************************************************************
+
+BenchmarkDB* BenchmarkDB::fromEnvironment() {
+  static std::unique_ptr<BenchmarkDB> pdb;
+  static std::once_flag once;
+  std::call_once(once, []() {
+    const char* pfname = std::getenv("DUNE_BENCH_DB");
+    if ( pfname == nullptr || *pfname == '\0' ) return;
+    pdb.reset(new BenchmarkDB(pfname));
+    if ( ! pdb->isValid() ) pdb.reset();
+  });
+  return pdb.get();
+}
+
+//**********************************************************************
+
+Name BenchmarkDB::environmentRun() {
+  static const Name run = []() {
+    const char* prun = std::getenv("DUNE_BENCH_RUN");
+    if ( prun != nullptr && *prun != '\0' ) return Name(prun);
+    std::time_t now = std::time(nullptr);
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y%m%d-%H%M%S", std::localtime(&now));
+    return Name(buf);
+  }();
+  return run;
+}
+
+//**********************************************************************
+
+int BenchmarkDB::record(const Result& res) {
+  BenchmarkDB* pdb = fromEnvironment();
+  if ( pdb == nullptr ) return 0;
+  return pdb->add(environmentRun(), res);
+}
+
+//**********************************************************************
+
+int BenchmarkDB::record(Name kernel, Name metric, Name unit, bool higherIsBetter,
+                        const DoubleVector& vals) {
+  if ( fromEnvironment() == nullptr ) return 0;
+  return record(summarize(kernel, metric, unit, higherIsBetter, vals));
+}
+
+//**********************************************************************
+// Member functions.
+//**********************************************************************
+
+BenchmarkDB::BenchmarkDB(Name fname, bool readOnly) : m_fname(fname) {
+  const string myname = "BenchmarkDB::ctor: ";
+  int flags = readOnly ? SQLITE_OPEN_READONLY : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  if ( sqlite3_open_v2(fname.c_str(), &m_db, flags, nullptr) != SQLITE_OK ) {
+    cout << myname << "ERROR: Unable to open " << fname << ": " << sqlite3_errmsg(m_db) << endl;
+    sqlite3_close(m_db);
+    m_db = nullptr;
+    return;
+  }
+  if ( ! readOnly && sqlite3_exec(m_db, createSql, nullptr, nullptr, nullptr) != SQLITE_OK ) {
+    cout << myname << "ERROR: Unable to create the benchmark table in " << fname << ": "
+         << sqlite3_errmsg(m_db) << endl;
+    sqlite3_close(m_db);
+    m_db = nullptr;
+  }
+}
+
+//**********************************************************************
+
+BenchmarkDB::~BenchmarkDB() {
+  sqlite3_close(m_db);
+}
+
+//**********************************************************************
+
+int BenchmarkDB::add(Name run, const Result& res) {
+  const string myname = "BenchmarkDB::add: ";
+  Statement stmt(m_db, "INSERT OR REPLACE INTO Benchmark "
+                       "(Run, Kernel, Metric, Unit, HigherIsBetter, Value, Spread, Count) "
+                       "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+  if ( stmt.pstmt == nullptr ) return 1;
+  bool ok = stmt.bind(1, run) && stmt.bind(2, res.kernel) && stmt.bind(3, res.metric) &&
+            stmt.bind(4, res.unit) && stmt.bind(5, int(res.higherIsBetter)) &&
+            stmt.bind(6, res.value) && stmt.bind(7, res.spread) && stmt.bind(8, int(res.count));
+  if ( ! ok || sqlite3_step(stmt.pstmt) != SQLITE_DONE ) {
+    cout << myname << "ERROR: Unable to add " << res.kernel << " " << res.metric << ": "
+         << sqlite3_errmsg(m_db) << endl;
+    return 2;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int BenchmarkDB::remove(Name run) {
+  Statement stmt(m_db, "DELETE FROM Benchmark WHERE Run = ?");
+  if ( stmt.pstmt == nullptr || ! stmt.bind(1, run) ) return 1;
+  return sqlite3_step(stmt.pstmt) == SQLITE_DONE ? 0 : 2;
+}
+
+//**********************************************************************
+
+NameVector BenchmarkDB::runs() const {
+  NameVector names;
+  Statement stmt(m_db, "SELECT Run FROM Benchmark GROUP BY Run ORDER BY MIN(rowid)");
+  if ( stmt.pstmt == nullptr ) return names;
+  while ( sqlite3_step(stmt.pstmt) == SQLITE_ROW ) names.push_back(stmt.text(0));
+  return names;
+}
+
+//**********************************************************************
+
+ResultVector BenchmarkDB::results(Name run) const {
+  ResultVector ress;
+  Statement stmt(m_db, "SELECT Kernel, Metric, Unit, HigherIsBetter, Value, Spread, Count "
+                       "FROM Benchmark WHERE Run = ? ORDER BY Kernel, Metric");
+  if ( stmt.pstmt == nullptr || ! stmt.bind(1, run) ) return ress;
+  while ( sqlite3_step(stmt.pstmt) == SQLITE_ROW ) {
+    Result res;
+    res.kernel = stmt.text(0);
+    res.metric = stmt.text(1);
+    res.unit = stmt.text(2);
+    res.higherIsBetter = sqlite3_column_int(stmt.pstmt, 3) != 0;
+    res.value = sqlite3_column_double(stmt.pstmt, 4);
+    res.spread = sqlite3_column_double(stmt.pstmt, 5);
+    res.count = sqlite3_column_int(stmt.pstmt, 6);
+    ress.push_back(res);
+  }
+  return ress;
+}
+
+//**********************************************************************
+
+ComparisonVector BenchmarkDB::compare(Name baseRun, Name run, double relTol, double nsig) const {
+  using Key = std::pair<Name, Name>;
+  std::map<Key, Result> bases;
+  for ( const Result& res : results(baseRun) ) bases[Key(res.kernel, res.metric)] = res;
+  ComparisonVector cmps;
+  for ( const Result& res : results(run) ) {
+    Comparison cmp;
+    cmp.kernel = res.kernel;
+    cmp.metric = res.metric;
+    cmp.unit = res.unit;
+    cmp.value = res.value;
+    auto ibas = bases.find(Key(res.kernel, res.metric));
+    if ( ibas == bases.end() ) {
+      cmp.status = Added;
+      cmps.push_back(cmp);
+      continue;
+    }
+    const Result bas = ibas->second;
+    bases.erase(ibas);
+    cmp.baseValue = bas.value;
+    double bmag = std::fabs(bas.value);
+    double rmag = std::fabs(res.value);
+    double bnoise = bmag > 0.0 ? bas.spread/bmag : 0.0;
+    double rnoise = rmag > 0.0 ? res.spread/rmag : 0.0;
+    cmp.threshold = std::max(relTol, nsig*std::sqrt(bnoise*bnoise + rnoise*rnoise));
+    if ( bmag > 0.0 ) {
+      cmp.change = (res.value - bas.value)/bmag;
+      if ( ! res.higherIsBetter ) cmp.change = -cmp.change;
+    }
+    if ( cmp.change < -cmp.threshold ) cmp.status = Regressed;
+    else if ( cmp.change > cmp.threshold ) cmp.status = Improved;
+    cmps.push_back(cmp);
+  }
+  for ( const auto& ent : bases ) {
+    Comparison cmp;
+    cmp.kernel = ent.second.kernel;
+    cmp.metric = ent.second.metric;
+    cmp.unit = ent.second.unit;
+    cmp.baseValue = ent.second.value;
+    cmp.status = Removed;
+    cmps.push_back(cmp);
+  }
+  return cmps;
+}
+
+//**********************************************************************
@@ -0,0 +1,121 @@
+// BenchmarkDB.h
+//
+// SQLite file of benchmark results, in the style of the time.db and mem.db files
+// written by the art TimeTracker and MemoryTracker services, and comparison of a
+// run against a stored baseline.
+//
+// Each result is a measurement of one metric (e.g. time, rate) for one kernel
+// (e.g. "bench_FFT FwFFT forward opt 1 nsam 6000") in a named run (e.g. a release
+// tag). It is held in table Benchmark with one row for each (Run, Kernel, Metric).
+// A result made from repeated measurements gives the median as the value and the
+// median absolute deviation scaled to a Gaussian sigma as the spread.
+//
+// A comparison gives, for each kernel and metric, the relative change from the
+// baseline, signed so that positive is better. The change is flagged as a
+// regression (or improvement) if it exceeds the larger of the tolerance relTol and
+// nsig times the combined relative spread of the two results, so that noisy kernels
+// need a larger change to be flagged.
+//
+// The benchmark programs add their results if environment variable DUNE_BENCH_DB
+// holds the name of the file, with run name DUNE_BENCH_RUN (default is the local
+// time of the first call). Use benchcompare to list and compare the runs.
+
+#ifndef BenchmarkDB_H
+#define BenchmarkDB_H
+
+#include <string>
+#include <vector>
+
+struct sqlite3;
+
+class BenchmarkDB {
+
+public:
+
+  using Index = unsigned int;
+  using Name = std::string;
+  using NameVector = std::vector<Name>;
+  using DoubleVector = std::vector<double>;
+
+  struct Result {
+    Name kernel;
+    Name metric;
+    Name unit;
+    bool higherIsBetter = false;
+    double value = 0.0;
+    double spread = 0.0;
+    Index count = 0;      // number of measurements
+  };
+  using ResultVector = std::vector<Result>;
+
+  enum Status { Unchanged, Improved, Regressed, Added, Removed };
+
+  struct Comparison {
+    Name kernel;
+    Name metric;
+    Name unit;
+    Status status = Unchanged;
+    double baseValue = 0.0;
+    double value = 0.0;
+    double change = 0.0;      // relative change, positive is better
+    double threshold = 0.0;   // relative change required to flag
+  };
+  using ComparisonVector = std::vector<Comparison>;
+
+  // Status as a string.
+  static Name statusName(Status stat);
+
+  // Result for a list of measurements.
+  static Result summarize(Name kernel, Name metric, Name unit, bool higherIsBetter,
+                          const DoubleVector& vals);
+
+  // Database named by DUNE_BENCH_DB, null if that is not set or cannot be opened.
+  static BenchmarkDB* fromEnvironment();
+
+  // Run name for results added with fromEnvironment().
+  static Name environmentRun();
+
+  // Add a result to the environment database if there is one. Returns 0 if it is
+  // added or there is no database.
+  static int record(const Result& res);
+  static int record(Name kernel, Name metric, Name unit, bool higherIsBetter,
+                    const DoubleVector& vals);
+
+  // Ctor from the file name. The file and table are created if needed unless
+  // readOnly is true.
+  explicit BenchmarkDB(Name fname, bool readOnly =false);
+  BenchmarkDB(const BenchmarkDB&) =delete;
+  BenchmarkDB& operator=(const BenchmarkDB&) =delete;
+
+  // Dtor. Closes the file.
+  ~BenchmarkDB();
+
+  // Was the file opened?
+  bool isValid() const { return m_db != nullptr; }
+
+  const Name& fileName() const { return m_fname; }
+
+  // Add or replace a result. Returns 0 for success.
+  int add(Name run, const Result& res);
+
+  // Remove all results for a run. Returns 0 for success.
+  int remove(Name run);
+
+  // Run names in the order they were first added.
+  NameVector runs() const;
+
+  // Results for a run ordered by kernel and metric.
+  ResultVector results(Name run) const;
+
+  // Compare run with baseRun. Results in only one of the runs are reported as
+  // Added or Removed.
+  ComparisonVector compare(Name baseRun, Name run, double relTol =0.05, double nsig =3.0) const;
+
+private:
+
+  Name m_fname;
+  sqlite3* m_db = nullptr;
+
+};
+
+#endif
@@ -0,0 +1,103 @@
+// ChannelStatusSnapshot.cxx
+
+#include "ChannelStatusSnapshot.h"
+#include "dunecore/DuneInterface/Tool/IndexMapTool.h"
+#include "dunecore/DuneInterface/Data/AdcTypes.h"
+
+using Index = ChannelStatusSnapshot::Index;
+using IndexVector = ChannelStatusSnapshot::IndexVector;
+using Category = ChannelStatusSnapshot::Category;
+using SnapshotPtr = ChannelStatusSnapshot::SnapshotPtr;
+using Hash = ChannelStatusSnapshot::Hash;
+
+//**********************************************************************
+
+SnapshotPtr ChannelStatusSnapshot::fromIndexMap(const IndexMapTool* pimt, Index nchan) {
+  return fromIndexMap(pimt, nchan, nullptr);
+}
+
+//**********************************************************************
+
+SnapshotPtr
+ChannelStatusSnapshot::fromIndexMap(const IndexMapTool* pimt, Index nchan, SnapshotPtr pold) {
+  if ( pimt == nullptr ) return nullptr;
+  IndexVector stats = readIndexMap(pimt, nchan);
+  if ( pold && pold->matches(stats) ) return pold;
+  return std::make_shared<const ChannelStatusSnapshot>(stats);
+}
+
+//**********************************************************************
+
+IndexVector ChannelStatusSnapshot::readIndexMap(const IndexMapTool* pimt, Index nchan) {
+  IndexVector stats;
+  if ( pimt == nullptr ) return stats;
+  stats.resize(nchan);
+  IndexMapView view(pimt);
+  for ( Index icha=0; icha<nchan; ++icha ) stats[icha] = view.get(icha);
+  return stats;
+}
+
+//**********************************************************************
+
+Hash ChannelStatusSnapshot::contentHash(const IndexVector& stats) {
+  Hash val = 0xcbf29ce484222325ul;
+  for ( Index ista : stats ) {
+    val ^= ista < MaxStatus ? ista : MaxStatus;
+    val *= 0x100000001b3ul;
+  }
+  return val;
+}
+
+//**********************************************************************
+
+ChannelStatusSnapshot::ChannelStatusSnapshot(const IndexVector& stats)
+: m_status(stats.size()), m_hash(contentHash(stats)) {
+  Index nwrd = (stats.size() + WordBits - 1)/WordBits;
+  for ( Index icat=0; icat<NCategory; ++icat ) {
+    m_bits[icat].resize(nwrd, 0);
+    m_counts[icat] = 0;
+  }
+  for ( Index icha=0; icha<stats.size(); ++icha ) {
+    Index ista = stats[icha];
+    m_status[icha] = ista < MaxStatus ? ista : MaxStatus;
+    Category icat = category(ista);
+    m_bits[icat][icha/WordBits] |= Word(1) << (icha%WordBits);
+    ++m_counts[icat];
+  }
+}
+
+//**********************************************************************
+
+bool ChannelStatusSnapshot::matches(const IndexVector& stats) const {
+  if ( stats.size() != size() || contentHash(stats) != m_hash ) return false;
+  for ( Index icha=0; icha<stats.size(); ++icha ) {
+    Index ista = stats[icha] < MaxStatus ? stats[icha] : MaxStatus;
+    if ( ista != m_status[icha] ) return false;
+  }
+  return true;
+}
+
+//**********************************************************************
+
+IndexVector ChannelStatusSnapshot::channels(Category icat) const {
+  IndexVector chans;
+  if ( icat >= NCategory ) return chans;
+  chans.reserve(m_counts[icat]);
+  const WordVector& wrds = m_bits[icat];
+  for ( Index iwrd=0; iwrd<wrds.size(); ++iwrd ) {
+    for ( Word wrd=wrds[iwrd]; wrd; wrd &= wrd - 1 ) {
+      chans.push_back(iwrd*WordBits + __builtin_ctzll(wrd));
+    }
+  }
+  return chans;
+}
+
+//**********************************************************************
+
+Category ChannelStatusSnapshot::category(Index ista) {
+  if ( ista == AdcChannelStatusBad ) return Bad;
+  if ( ista == AdcChannelStatusNoisy ) return Noisy;
+  return Good;
+}
+
+//**********************************************************************
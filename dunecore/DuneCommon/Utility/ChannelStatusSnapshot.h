@@ -0,0 +1,110 @@
+// ChannelStatusSnapshot.h
+//
+// Immutable channel status for channels 0 through size()-1, e.g. for one run.
+//
+// The status of each channel is held in one byte and the good, bad and noisy
+// channels in bitsets, so status and category queries read contiguous arrays.
+// Following the index map convention (AdcTypes.h), status AdcChannelStatusBad
+// is bad, AdcChannelStatusNoisy is noisy and any other status is good.
+// Status values above MaxStatus are stored as MaxStatus.
+//
+// Snapshots are handed out by shared pointer to const so that a channel status
+// tool, the channel status provider and their clients can share one copy:
+//   ChannelStatusSnapshot::SnapshotPtr psnap = ChannelStatusSnapshot::fromIndexMap(pimt, nchan);
+//   if ( psnap->isBad(icha) ) ...
+//
+// Each snapshot holds a hash of its status values. Passing the previous snapshot to
+// fromIndexMap returns that snapshot, with its bitsets, if the status is unchanged,
+// so reloading the status at each run boundary does not rebuild an identical copy.
+
+#ifndef ChannelStatusSnapshot_H
+#define ChannelStatusSnapshot_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class IndexMapTool;
+
+class ChannelStatusSnapshot {
+
+public:
+
+  using Index = unsigned int;
+  using Status = std::uint8_t;
+  using Word = std::uint64_t;
+  using IndexVector = std::vector<Index>;
+  using StatusVector = std::vector<Status>;
+  using WordVector = std::vector<Word>;
+  using SnapshotPtr = std::shared_ptr<const ChannelStatusSnapshot>;
+  using Hash = std::uint64_t;
+
+  static constexpr Index MaxStatus = 255;
+  static constexpr Index WordBits = 64;
+
+  // Categories.
+  enum Category { Good, Bad, Noisy, NCategory };
+
+  // Snapshot of the status of each channel in an index map tool for channels
+  // 0 through nchan-1. Returns null if the tool is null.
+  static SnapshotPtr fromIndexMap(const IndexMapTool* pimt, Index nchan);
+
+  // Same, returning pold if it holds the same status.
+  static SnapshotPtr fromIndexMap(const IndexMapTool* pimt, Index nchan, SnapshotPtr pold);
+
+  // Status of each channel in an index map tool for channels 0 through nchan-1.
+  static IndexVector readIndexMap(const IndexMapTool* pimt, Index nchan);
+
+  // 64-bit FNV-1a hash of the stored status values for stats.
+  static Hash contentHash(const IndexVector& stats);
+
+  // Ctor from the status of each channel.
+  explicit ChannelStatusSnapshot(const IndexVector& stats);
+
+  // Hash of the status values.
+  Hash contentHash() const { return m_hash; }
+
+  // Return if this snapshot holds the status stats.
+  bool matches(const IndexVector& stats) const;
+
+  // Number of channels.
+  Index size() const { return m_status.size(); }
+  bool hasChannel(Index icha) const { return icha < size(); }
+
+  // Status for a channel. Channels beyond the snapshot return defaultStatus.
+  Index status(Index icha, Index defaultStatus =MaxStatus) const {
+    return icha < size() ? m_status[icha] : defaultStatus;
+  }
+
+  // Category of a channel. All are false beyond the snapshot.
+  bool isGood(Index icha) const { return test(Good, icha); }
+  bool isBad(Index icha) const { return test(Bad, icha); }
+  bool isNoisy(Index icha) const { return test(Noisy, icha); }
+
+  // Number of channels and list of channels in a category.
+  Index count(Category icat) const { return icat < NCategory ? m_counts[icat] : 0; }
+  IndexVector channels(Category icat) const;
+
+  // Dense arrays: one status byte per channel and, for each category, one bit
+  // per channel with channel icha in bit icha%WordBits of word icha/WordBits.
+  const StatusVector& statuses() const { return m_status; }
+  const WordVector& bits(Category icat) const { return m_bits[icat]; }
+
+  // Category for a status.
+  static Category category(Index ista);
+
+private:
+
+  StatusVector m_status;
+  WordVector m_bits[NCategory];
+  Index m_counts[NCategory];
+  Hash m_hash;
+
+  bool test(Category icat, Index icha) const {
+    if ( icha >= size() ) return false;
+    return (m_bits[icat][icha/WordBits] >> (icha%WordBits)) & 1;
+  }
+
+};
+
+#endif
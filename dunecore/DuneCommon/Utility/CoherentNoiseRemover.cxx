@@ -0,0 +1,110 @@
+// CoherentNoiseRemover.cxx
+
+#include "CoherentNoiseRemover.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+#include <algorithm>
+#include <unordered_set>
+
+using Index = CoherentNoiseRemover::Index;
+using FloatVector = CoherentNoiseRemover::FloatVector;
+
+//**********************************************************************
+
+int CoherentNoiseRemover::update(AdcChannelDataMap& acds, const ChannelVectorVector& groups,
+                                 std::vector<FloatVector>* pnoise) const {
+  // Disjoint groups are required so that the groups may be updated in parallel.
+  std::unordered_set<AdcChannel> seen;
+  for ( const ChannelVector& chans : groups ) {
+    for ( AdcChannel icha : chans ) {
+      if ( ! seen.insert(icha).second ) return 1;
+    }
+  }
+  Index ngrp = groups.size();
+  std::vector<FloatVector> noises(pnoise == nullptr ? ngrp : 0);
+  std::vector<FloatVector>& outs = pnoise == nullptr ? noises : *pnoise;
+  outs.resize(ngrp);
+  auto updateRange = [&](Index igrp1, Index igrp2) {
+    FloatVector block;
+    std::vector<Index> counts;
+    for ( Index igrp=igrp1; igrp<igrp2; ++igrp ) updateGroup(acds, groups[igrp], outs[igrp], block, counts);
+  };
+  if ( m_nthread == 1 ) {
+    updateRange(0, ngrp);
+  } else {
+    auto run = [&]() {
+      tbb::parallel_for(tbb::blocked_range<Index>(0, ngrp),
+                        [&](const tbb::blocked_range<Index>& grps) {
+        updateRange(grps.begin(), grps.end());
+      });
+    };
+    if ( m_nthread == 0 ) run();
+    else tbb::task_arena(m_nthread).execute(run);
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+void CoherentNoiseRemover::updateGroup(AdcChannelDataMap& acds, const ChannelVector& chans,
+                                       FloatVector& noise, FloatVector& block,
+                                       std::vector<Index>& counts) const {
+  // Find the group channels. Map lookups are only done here, not for every tick.
+  std::vector<AdcChannelData*> acdps;
+  Index ntick = 0;
+  for ( AdcChannel icha : chans ) {
+    AdcChannelDataMap::iterator iacd = acds.find(icha);
+    if ( iacd == acds.end() ) continue;
+    acdps.push_back(&iacd->second);
+    ntick = std::max(ntick, Index(iacd->second.sampleCount()));
+  }
+  Index nchan = acdps.size();
+  noise.assign(ntick, 0.0);
+  if ( nchan == 0 || ntick == 0 ) return;
+  // Transpose to tick-major, packing the values used for each tick at the start of its row.
+  block.resize(ntick*nchan);
+  counts.assign(ntick, 0);
+  for ( const AdcChannelData* pacd : acdps ) {
+    const AdcSignal* psam = pacd->sampleData();
+    Index nsam = pacd->sampleCount();
+    bool useFilter = m_skipSignal && pacd->signal.size() >= nsam;
+    for ( Index itck=0; itck<nsam; ++itck ) {
+      if ( useFilter && pacd->signal[itck] ) continue;
+      block[itck*nchan + counts[itck]++] = psam[itck];
+    }
+  }
+  rowStatistic(m_stat, block.data(), ntick, nchan, counts.data(), noise.data());
+  // Scatter the correction.
+  const float* pnoi = noise.data();
+  for ( AdcChannelData* pacd : acdps ) {
+    AdcSignal* psam = pacd->sampleData();
+    Index nsam = pacd->sampleCount();
+    for ( Index itck=0; itck<nsam; ++itck ) psam[itck] -= pnoi[itck];
+  }
+}
+
+//**********************************************************************
+
+void CoherentNoiseRemover::rowStatistic(Statistic stat, float* pblk, Index ntick, Index stride,
+                                        const Index* counts, float* pout) {
+  for ( Index itck=0; itck<ntick; ++itck ) {
+    float* prow = pblk + itck*stride;
+    Index nval = counts[itck];
+    if ( nval == 0 ) {
+      pout[itck] = 0.0;
+    } else if ( stat == Mean ) {
+      float sum = 0.0;
+      for ( Index ival=0; ival<nval; ++ival ) sum += prow[ival];
+      pout[itck] = sum/nval;
+    } else {
+      float* pmid = prow + nval/2;
+      std::nth_element(prow, pmid, prow + nval);
+      float val = *pmid;
+      if ( nval%2 == 0 ) val = 0.5*(val + *std::max_element(prow, pmid));
+      pout[itck] = val;
+    }
+  }
+}
+
+//**********************************************************************
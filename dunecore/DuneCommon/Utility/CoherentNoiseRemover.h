@@ -0,0 +1,75 @@
+// CoherentNoiseRemover.h
+//
+// Shared kernel for removing coherent noise from groups of channels, e.g. the
+// groups of a ChannelGroupService or the channels of an FEMB or ASIC, for use in
+// AdcNoiseRemovalService and tool implementations.
+//
+// For each group, the samples of the group channels found in the channel map are
+// transposed into a tick-major block so that the values for one tick are contiguous.
+// The per-tick statistic (median or mean) is evaluated over each block row and the
+// result, the coherent noise, is subtracted from the samples of each channel.
+// Ticks flagged in AdcChannelData::signal are optionally excluded from the
+// statistic (but still corrected). Ticks with no contributing channel have
+// zero correction.
+//
+// The median of n values is the mean of the two central values for even n and is
+// found with nth_element. The mean is a plain loop over the contiguous row that
+// the compiler may vectorize.
+//
+// Groups are processed in parallel with TBB for nthread != 1. The thread count 0
+// means the concurrency of the current TBB arena. The groups must be disjoint.
+//
+// Usage:
+//   CoherentNoiseRemover cnr(CoherentNoiseRemover::Median, true);
+//   cnr.update(acds, groups);
+
+#ifndef CoherentNoiseRemover_H
+#define CoherentNoiseRemover_H
+
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include <vector>
+
+class CoherentNoiseRemover {
+
+public:
+
+  using Index = AdcIndex;
+  using ChannelVector = std::vector<AdcChannel>;
+  using ChannelVectorVector = std::vector<ChannelVector>;
+  using FloatVector = std::vector<float>;
+
+  enum Statistic { Median, Mean };
+
+  // Ctor.
+  //          stat: Statistic used to evaluate the noise for each tick.
+  //   skipSignal: If true, ticks flagged as signal are excluded from the statistic.
+  //      nthread: Number of threads as for Fw2dFFT (0 for the TBB arena concurrency).
+  CoherentNoiseRemover(Statistic stat =Median, bool skipSignal =true, Index nthread =0)
+  : m_stat(stat), m_skipSignal(skipSignal), m_nthread(nthread) { }
+
+  // Remove the coherent noise for each group from the channels in acds.
+  // Group channels not in acds are ignored.
+  // If pnoise is not null, it is filled with the noise vector for each group.
+  // Returns 0 for success, 1 if a channel is in more than one group.
+  int update(AdcChannelDataMap& acds, const ChannelVectorVector& groups,
+             std::vector<FloatVector>* pnoise =nullptr) const;
+
+  // Remove the noise for one group. The work vectors are resized as needed.
+  void updateGroup(AdcChannelDataMap& acds, const ChannelVector& chans,
+                   FloatVector& noise, FloatVector& block, std::vector<Index>& counts) const;
+
+  // Evaluate the statistic for each row of a tick-major block.
+  // Row itck holds counts[itck] values starting at pblk + itck*stride.
+  // The values in a row may be reordered.
+  static void rowStatistic(Statistic stat, float* pblk, Index ntick, Index stride,
+                           const Index* counts, float* pout);
+
+private:
+
+  Statistic m_stat;
+  bool m_skipSignal;
+  Index m_nthread;
+
+};
+
+#endif
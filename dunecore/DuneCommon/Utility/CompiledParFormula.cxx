@@ -0,0 +1,408 @@
+// CompiledParFormula.cxx
+
+#include "dunecore/DuneCommon/Utility/CompiledParFormula.h"
+#include <cmath>
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <map>
+#include <algorithm>
+
+using Names = ParFormula::Names;
+using Name = ParFormula::Name;
+using Index = ParFormula::Index;
+using Value = ParFormula::Value;
+using Values = ParFormula::Values;
+using Instruction = CompiledParFormula::Instruction;
+using Program = CompiledParFormula::Program;
+
+//**********************************************************************
+
+namespace {
+
+double fsin(double x) { return std::sin(x); }
+double fcos(double x) { return std::cos(x); }
+double ftan(double x) { return std::tan(x); }
+double fasin(double x) { return std::asin(x); }
+double facos(double x) { return std::acos(x); }
+double fatan(double x) { return std::atan(x); }
+double fsinh(double x) { return std::sinh(x); }
+double fcosh(double x) { return std::cosh(x); }
+double ftanh(double x) { return std::tanh(x); }
+double fexp(double x) { return std::exp(x); }
+double flog(double x) { return std::log(x); }
+double flog10(double x) { return std::log10(x); }
+double fsqrt(double x) { return std::sqrt(x); }
+double fabsv(double x) { return std::fabs(x); }
+double ffloor(double x) { return std::floor(x); }
+double fceil(double x) { return std::ceil(x); }
+double fatan2(double y, double x) { return std::atan2(y, x); }
+double fpow(double x, double y) { return std::pow(x, y); }
+double fminv(double x, double y) { return std::min(x, y); }
+double fmaxv(double x, double y) { return std::max(x, y); }
+
+const std::map<Name, CompiledParFormula::Fun1Ptr>& fun1s() {
+  static const std::map<Name, CompiledParFormula::Fun1Ptr> funs = {
+    {"sin", fsin}, {"cos", fcos}, {"tan", ftan}, {"asin", fasin}, {"acos", facos},
+    {"atan", fatan}, {"sinh", fsinh}, {"cosh", fcosh}, {"tanh", ftanh}, {"exp", fexp},
+    {"log", flog}, {"log10", flog10}, {"sqrt", fsqrt}, {"abs", fabsv}, {"fabs", fabsv},
+    {"floor", ffloor}, {"ceil", fceil},
+    {"Sin", fsin}, {"Cos", fcos}, {"Tan", ftan}, {"ASin", fasin}, {"ACos", facos},
+    {"ATan", fatan}, {"SinH", fsinh}, {"CosH", fcosh}, {"TanH", ftanh}, {"Exp", fexp},
+    {"Log", flog}, {"Log10", flog10}, {"Sqrt", fsqrt}, {"Abs", fabsv},
+    {"Floor", ffloor}, {"Ceil", fceil}
+  };
+  return funs;
+}
+
+const std::map<Name, CompiledParFormula::Fun2Ptr>& fun2s() {
+  static const std::map<Name, CompiledParFormula::Fun2Ptr> funs = {
+    {"atan2", fatan2}, {"pow", fpow}, {"min", fminv}, {"max", fmaxv},
+    {"ATan2", fatan2}, {"Power", fpow}, {"Min", fminv}, {"Max", fmaxv}
+  };
+  return funs;
+}
+
+// Recursive-descent parser that appends instructions to a program.
+class Parser {
+
+public:
+
+  Parser(const Name& sform, Program& prog, Names& parNames, Values& consts)
+  : m_s(sform), m_prog(prog), m_parNames(parNames), m_consts(consts) { }
+
+  // Parse the full string. Returns an error message or blank for success.
+  Name parse() {
+    skip();
+    if ( m_pos >= m_s.size() ) return "Formula is empty.";
+    parseOr();
+    skip();
+    if ( m_err.empty() && m_pos < m_s.size() ) fail("Unexpected character");
+    return m_err;
+  }
+
+  Index nvar() const { return m_nvar; }
+
+private:
+
+  void skip() { while ( m_pos < m_s.size() && isspace(m_s[m_pos]) ) ++m_pos; }
+
+  bool accept(const char* tok) {
+    skip();
+    Index len = strlen(tok);
+    if ( m_s.compare(m_pos, len, tok) != 0 ) return false;
+    m_pos += len;
+    return true;
+  }
+
+  void fail(Name msg) {
+    if ( m_err.empty() ) m_err = msg + " at position " + std::to_string(m_pos) + " in " + m_s;
+  }
+
+  void emit(CompiledParFormula::OpCode op, Index idx =0) {
+    Instruction ins;
+    ins.op = op;
+    ins.idx = idx;
+    m_prog.push_back(ins);
+  }
+
+  void parseOr() {
+    parseAnd();
+    while ( m_err.empty() && accept("||") ) { parseAnd(); emit(CompiledParFormula::Or); }
+  }
+
+  void parseAnd() {
+    parseCompare();
+    while ( m_err.empty() && accept("&&") ) { parseCompare(); emit(CompiledParFormula::And); }
+  }
+
+  void parseCompare() {
+    parseSum();
+    while ( m_err.empty() ) {
+      CompiledParFormula::OpCode op;
+      if ( accept("<=") ) op = CompiledParFormula::Le;
+      else if ( accept(">=") ) op = CompiledParFormula::Ge;
+      else if ( accept("==") ) op = CompiledParFormula::Eq;
+      else if ( accept("!=") ) op = CompiledParFormula::Ne;
+      else if ( accept("<") ) op = CompiledParFormula::Lt;
+      else if ( accept(">") ) op = CompiledParFormula::Gt;
+      else break;
+      parseSum();
+      emit(op);
+    }
+  }
+
+  void parseSum() {
+    parseProduct();
+    while ( m_err.empty() ) {
+      if ( accept("+") ) { parseProduct(); emit(CompiledParFormula::Add); }
+      else if ( accept("-") ) { parseProduct(); emit(CompiledParFormula::Sub); }
+      else break;
+    }
+  }
+
+  void parseProduct() {
+    parseUnary();
+    while ( m_err.empty() ) {
+      skip();
+      if ( m_s.compare(m_pos, 2, "**") == 0 ) break;
+      if ( accept("*") ) { parseUnary(); emit(CompiledParFormula::Mul); }
+      else if ( accept("/") ) { parseUnary(); emit(CompiledParFormula::Div); }
+      else break;
+    }
+  }
+
+  void parseUnary() {
+    if ( accept("-") ) { parseUnary(); emit(CompiledParFormula::Neg); return; }
+    if ( accept("+") ) { parseUnary(); return; }
+    if ( accept("!") ) { parseUnary(); emit(CompiledParFormula::Not); return; }
+    parsePower();
+  }
+
+  // Power is right associative and binds tighter than unary minus on its left.
+  void parsePower() {
+    parsePrimary();
+    if ( m_err.empty() && (accept("^") || accept("**")) ) {
+      parseUnary();
+      emit(CompiledParFormula::Pow);
+    }
+  }
+
+  void parsePrimary() {
+    skip();
+    if ( m_pos >= m_s.size() ) return fail("Unexpected end");
+    char ch = m_s[m_pos];
+    if ( ch == '(' ) {
+      ++m_pos;
+      parseOr();
+      if ( ! accept(")") ) fail("Missing )");
+      return;
+    }
+    if ( ch == '[' ) {
+      Name::size_type iend = m_s.find(']', m_pos);
+      if ( iend == Name::npos ) return fail("Missing ]");
+      Name pnam = m_s.substr(m_pos + 1, iend - m_pos - 1);
+      if ( pnam.empty() ) return fail("Empty parameter name");
+      m_pos = iend + 1;
+      Names::const_iterator inam = std::find(m_parNames.begin(), m_parNames.end(), pnam);
+      Index ipar = inam - m_parNames.begin();
+      if ( inam == m_parNames.end() ) m_parNames.push_back(pnam);
+      emit(CompiledParFormula::PushPar, ipar);
+      return;
+    }
+    if ( isdigit(ch) || ch == '.' ) {
+      const char* pbeg = m_s.c_str() + m_pos;
+      char* pend = nullptr;
+      double val = strtod(pbeg, &pend);
+      if ( pend == pbeg ) return fail("Invalid number");
+      m_pos += pend - pbeg;
+      pushConst(val);
+      return;
+    }
+    if ( isalpha(ch) || ch == '_' ) {
+      Index ibeg = m_pos;
+      while ( m_pos < m_s.size() && (isalnum(m_s[m_pos]) || m_s[m_pos] == '_' || m_s[m_pos] == ':') ) ++m_pos;
+      Name word = m_s.substr(ibeg, m_pos - ibeg);
+      if ( word.compare(0, 7, "TMath::") == 0 ) word = word.substr(7);
+      if ( word == "pi" || word == "Pi" ) return pushConst(M_PI);
+      if ( word == "x" || word == "y" || word == "z" || word == "t" ) {
+        Index ivar = word == "x" ? 0 : word == "y" ? 1 : word == "z" ? 2 : 3;
+        if ( word == "x" && accept("[") ) {
+          skip();
+          Index jbeg = m_pos;
+          while ( m_pos < m_s.size() && isdigit(m_s[m_pos]) ) ++m_pos;
+          if ( m_pos == jbeg ) return fail("Invalid variable index");
+          ivar = std::stoi(m_s.substr(jbeg, m_pos - jbeg));
+          if ( ! accept("]") ) return fail("Missing ]");
+        }
+        if ( ivar + 1 > m_nvar ) m_nvar = ivar + 1;
+        emit(CompiledParFormula::PushVar, ivar);
+        return;
+      }
+      auto ifun1 = fun1s().find(word);
+      auto ifun2 = fun2s().find(word);
+      if ( ifun1 == fun1s().end() && ifun2 == fun2s().end() ) return fail("Unknown name " + word);
+      if ( ! accept("(") ) return fail("Missing ( after " + word);
+      parseOr();
+      if ( ifun2 != fun2s().end() ) {
+        if ( ! accept(",") ) return fail("Missing second argument for " + word);
+        parseOr();
+        emit(CompiledParFormula::Fun2);
+        m_prog.back().pfun2 = ifun2->second;
+      } else {
+        emit(CompiledParFormula::Fun1);
+        m_prog.back().pfun1 = ifun1->second;
+      }
+      if ( ! accept(")") ) return fail("Missing )");
+      return;
+    }
+    fail("Unexpected character");
+  }
+
+  void pushConst(double val) {
+    emit(CompiledParFormula::PushConst, m_consts.size());
+    m_consts.push_back(val);
+  }
+
+  const Name& m_s;
+  Program& m_prog;
+  Names& m_parNames;
+  Values& m_consts;
+  Name::size_type m_pos = 0;
+  Index m_nvar = 0;
+  Name m_err;
+
+};
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+CompiledParFormula::CompiledParFormula(Name snam, Name sform)
+: m_nam(snam), m_sform(sform) {
+  Parser parser(m_sform, m_prog, m_parNames, m_consts);
+  m_error = parser.parse();
+  if ( m_error.size() ) {
+    m_status = 1;
+    m_prog.clear();
+    m_parNames.clear();
+    m_consts.clear();
+  } else {
+    m_nvar = parser.nvar();
+  }
+  // Find the stack depth.
+  Index depth = 0;
+  for ( const Instruction& ins : m_prog ) {
+    if ( ins.op == PushConst || ins.op == PushPar || ins.op == PushVar ) ++depth;
+    else if ( ins.op != Neg && ins.op != Not && ins.op != Fun1 ) --depth;
+    if ( depth > m_stackSize ) m_stackSize = depth;
+  }
+  m_setCounts.resize(npar(), 0);
+  m_parValues.resize(npar(), 0.0);
+}
+
+//**********************************************************************
+
+bool CompiledParFormula::isPar(Name parnam) const {
+  return std::find(m_parNames.begin(), m_parNames.end(), parnam) != m_parNames.end();
+}
+
+//**********************************************************************
+
+bool CompiledParFormula::ready() const {
+  if ( m_status ) return false;
+  for ( Index nset : m_setCounts ) {
+    if ( nset == 0 ) return false;
+  }
+  return true;
+}
+
+//**********************************************************************
+
+Names CompiledParFormula::setPars() const {
+  Names nams;
+  for ( Index ipar=0; ipar<npar(); ++ipar ) {
+    if ( m_setCounts[ipar] ) nams.push_back(m_parNames[ipar]);
+  }
+  return nams;
+}
+  
+//**********************************************************************
+
+Names CompiledParFormula::unsetPars() const {
+  Names nams;
+  for ( Index ipar=0; ipar<npar(); ++ipar ) {
+    if ( m_setCounts[ipar] == 0 ) nams.push_back(m_parNames[ipar]);
+  }
+  return nams;
+}
+  
+//**********************************************************************
+
+Names CompiledParFormula::resetPars() const {
+  Names nams;
+  for ( Index ipar=0; ipar<npar(); ++ipar ) {
+    if ( m_setCounts[ipar] > 1 ) nams.push_back(m_parNames[ipar]);
+  }
+  return nams;
+}
+  
+//**********************************************************************
+
+void CompiledParFormula::evalMany(const Value* pvars, Index nset, Value* pevals) const {
+  if ( ! ready() ) {
+    for ( Index iset=0; iset<nset; ++iset ) pevals[iset] = m_defval;
+    return;
+  }
+  for ( Index iset=0; iset<nset; ++iset ) pevals[iset] = run(pvars + iset*m_nvar);
+}
+
+//**********************************************************************
+
+int CompiledParFormula::setParValue(Name parnam, Value parval) {
+  Index ipar = 0;
+  for ( ; ipar<npar(); ++ipar ) {
+    if ( m_parNames[ipar] == parnam ) break;
+  }
+  if ( ipar >= npar() ) return 1;
+  m_parValues[ipar] = parval;
+  ++m_setCounts[ipar];
+  return 0;
+}
+
+//**********************************************************************
+
+int CompiledParFormula::unsetParValues() {
+  for ( Index ipar=0; ipar<npar(); ++ipar ) {
+    m_setCounts[ipar] = 0;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+double CompiledParFormula::run(const Value* pvars) const {
+  const Index nstkLocal = 32;
+  double stkLocal[nstkLocal];
+  std::vector<double> stkHeap;
+  double* pstk = stkLocal;
+  if ( m_stackSize > nstkLocal ) {
+    stkHeap.resize(m_stackSize);
+    pstk = stkHeap.data();
+  }
+  Index nstk = 0;
+  for ( const Instruction& ins : m_prog ) {
+    switch ( ins.op ) {
+    case PushConst: pstk[nstk++] = m_consts[ins.idx]; break;
+    case PushPar:   pstk[nstk++] = m_parValues[ins.idx]; break;
+    case PushVar:   pstk[nstk++] = pvars[ins.idx]; break;
+    case Neg:       pstk[nstk-1] = -pstk[nstk-1]; break;
+    case Not:       pstk[nstk-1] = pstk[nstk-1] == 0.0; break;
+    case Fun1:      pstk[nstk-1] = ins.pfun1(pstk[nstk-1]); break;
+    default: {
+      double rhs = pstk[--nstk];
+      double& lhs = pstk[nstk-1];
+      switch ( ins.op ) {
+      case Add:  lhs += rhs; break;
+      case Sub:  lhs -= rhs; break;
+      case Mul:  lhs *= rhs; break;
+      case Div:  lhs /= rhs; break;
+      case Pow:  lhs = std::pow(lhs, rhs); break;
+      case Lt:   lhs = lhs < rhs; break;
+      case Le:   lhs = lhs <= rhs; break;
+      case Gt:   lhs = lhs > rhs; break;
+      case Ge:   lhs = lhs >= rhs; break;
+      case Eq:   lhs = lhs == rhs; break;
+      case Ne:   lhs = lhs != rhs; break;
+      case And:  lhs = lhs != 0.0 && rhs != 0.0; break;
+      case Or:   lhs = lhs != 0.0 || rhs != 0.0; break;
+      case Fun2: lhs = ins.pfun2(lhs, rhs); break;
+      default: break;
+      }
+    }
+    }
+  }
+  return nstk ? pstk[0] : m_defval;
+}
+
+//**********************************************************************
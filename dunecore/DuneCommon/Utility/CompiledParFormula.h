@@ -0,0 +1,122 @@
+// CompiledParFormula.h
+//
+// Implementation of ParFormula that parses the formula once into a
+// compact stack program and evaluates that without ROOT.
+//
+// The syntax is that of the TFormula expressions used with RootParFormula:
+//   parameters:  [name] or [0], [1], ...
+//   variables:   x, y, z, t or x[0], x[1], ...
+//   numbers:     1, 2.5, 1.e-3, pi
+//   operators:   + - * / ^ ** (power), unary - + !, < <= > >= == !=, && ||
+//   functions:   sin cos tan asin acos atan atan2 sinh cosh tanh exp log log10
+//                sqrt abs fabs pow min max floor ceil, optionally with TMath::
+// Parameters are listed in order of first appearance.
+//
+// Evaluation uses only local state so const methods may be called
+// concurrently. evalMany evaluates a block of variable sets.
+//
+// If the formula cannot be parsed, status() is nonzero, error() gives the
+// reason and evaluation returns the default value.
+
+#ifndef CompiledParFormula_H
+#define CompiledParFormula_H
+
+#include "dunecore/DuneInterface/Utility/ParFormula.h"
+
+class CompiledParFormula : public ParFormula {
+
+public:
+
+  // Ctor from a string formula.
+  CompiledParFormula(Name snam, Name sform);
+
+  // Parse status and message.
+  int status() const { return m_status; }
+  const Name& error() const { return m_error; }
+
+  // Name.
+  Name name() const override { return m_nam; }
+
+  // Formula.
+  Name formulaString() const override { return m_sform; }
+
+  // Variable dimension.
+  Index nvar() const override { return m_nvar; }
+
+  // Parameter counts.
+  Index npar() const override { return m_parNames.size(); }
+  Names pars() const override { return m_parNames; }
+  Names setPars() const override;
+  Names unsetPars() const override;
+  Names resetPars() const override;
+
+  // Return if a parameter appears in the equation.
+  bool isPar(Name parnam) const override;
+
+  // Return if ready for evaluation.
+  bool ready() const override;
+
+  // Default return.
+  Value defaultEval() const override { return m_defval; }
+
+  // Evaluate.
+  double eval(const Values& vars) const override {
+    return ready() && nvar() <= vars.size() ? run(vars.data()) : m_defval;
+  }
+  double eval(Value var) const override {
+    return ready() && nvar() <= 1 ? run(&var) : m_defval;
+  }
+  double eval() const override {
+    return ready() && nvar() == 0 ? run(nullptr) : m_defval;
+  }
+  void evalMany(const Value* pvars, Index nset, Value* pevals) const override;
+
+  // Set a parameter value.
+  int setParValue(Name parnam, Value parval) override;
+
+  // Set default return.
+  int setDefaultEval(Value val) override { m_defval = val; return 0; }
+
+  // Unset paramter values.
+  int unsetParValues() override;
+
+public:
+
+  // Program instruction.
+  enum OpCode { PushConst, PushPar, PushVar, Neg, Not, Add, Sub, Mul, Div, Pow,
+                Lt, Le, Gt, Ge, Eq, Ne, And, Or, Fun1, Fun2 };
+  using Fun1Ptr = double (*)(double);
+  using Fun2Ptr = double (*)(double, double);
+  struct Instruction {
+    OpCode op;
+    Index idx = 0;          // Constant, parameter or variable index
+    Fun1Ptr pfun1 = nullptr;
+    Fun2Ptr pfun2 = nullptr;
+  };
+  using Program = std::vector<Instruction>;
+
+  // Program and maximum stack depth.
+  const Program& program() const { return m_prog; }
+  Index stackSize() const { return m_stackSize; }
+
+private:
+
+  // Evaluate the program for variables pvars.
+  double run(const Value* pvars) const;
+
+  Name m_nam;
+  Name m_sform;
+  int m_status = 0;
+  Name m_error;
+  Index m_nvar = 0;
+  Names m_parNames;
+  Values m_parValues;
+  std::vector<Index> m_setCounts;
+  Value m_defval = 0.0;
+  Values m_consts;
+  Program m_prog;
+  Index m_stackSize = 0;
+
+};
+
+#endif
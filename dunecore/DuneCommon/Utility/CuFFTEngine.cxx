@@ -0,0 +1,210 @@
+// CuFFTEngine.cxx
+
+#include "CuFFTEngine.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#ifdef DUNECORE_CUFFT
+#include <cuda_runtime.h>
+#include <cufft.h>
+#include <cublas_v2.h>
+#include <map>
+#include <mutex>
+#include <utility>
+#endif
+
+using std::string;
+using std::cout;
+using std::endl;
+using Index = CuFFTEngine::Index;
+
+#ifdef DUNECORE_CUFFT
+
+//**********************************************************************
+// Device state.
+//**********************************************************************
+
+struct CuFFTEngine::Device {
+  using PlanMap = std::map<std::pair<Index, Index>, cufftHandle>;
+  int device = 0;
+  float* sams = nullptr;             // batchSize() x nsamMax() samples
+  cufftComplex* dfts = nullptr;      // batchSize() x (nsamMax()/2 + 1) terms
+  cufftComplex* kernel = nullptr;    // nsamMax()/2 + 1 terms
+  cublasHandle_t blas = nullptr;
+  PlanMap forwardPlans;
+  PlanMap backwardPlans;
+  std::mutex mutex;
+  // Return the plan for nbatch transforms of nsam samples, null if it cannot be made.
+  cufftHandle* plan(PlanMap& plans, cufftType type, Index nsam, Index nbatch);
+};
+
+//**********************************************************************
+
+cufftHandle* CuFFTEngine::Device::plan(PlanMap& plans, cufftType type, Index nsam, Index nbatch) {
+  std::pair<Index, Index> key(nsam, nbatch);
+  PlanMap::iterator iplan = plans.find(key);
+  if ( iplan != plans.end() ) return &iplan->second;
+  cufftHandle hplan;
+  int n = nsam;
+  // Null embeddings give the packed layout: real rows nsam apart and complex rows nsam/2 + 1 apart.
+  if ( cufftPlanMany(&hplan, 1, &n, nullptr, 1, 0, nullptr, 1, 0, type, nbatch) != CUFFT_SUCCESS ) {
+    return nullptr;
+  }
+  return &(plans[key] = hplan);
+}
+
+//**********************************************************************
+// Class methods.
+//**********************************************************************
+
+bool CuFFTEngine::available() {
+  int ndev = 0;
+  return cudaGetDeviceCount(&ndev) == cudaSuccess && ndev > 0;
+}
+
+//**********************************************************************
+
+CuFFTEngine::CuFFTEngine(Index nsamMax, Index nbatchMax, int device)
+: m_nsamMax(nsamMax), m_nbatchMax(nbatchMax > 0 ? nbatchMax : 1) {
+  const string myname = "CuFFTEngine::ctor: ";
+  if ( ! available() ) return;
+  std::unique_ptr<Device> pdev(new Device);
+  pdev->device = device;
+  size_t ncmp = m_nsamMax/2 + 1;
+  bool ok = cudaSetDevice(device) == cudaSuccess &&
+            cudaMalloc(&pdev->sams, sizeof(float)*m_nbatchMax*m_nsamMax) == cudaSuccess &&
+            cudaMalloc(&pdev->dfts, sizeof(cufftComplex)*m_nbatchMax*ncmp) == cudaSuccess &&
+            cudaMalloc(&pdev->kernel, sizeof(cufftComplex)*ncmp) == cudaSuccess &&
+            cublasCreate(&pdev->blas) == CUBLAS_STATUS_SUCCESS;
+  if ( ! ok ) {
+    cout << myname << "Unable to allocate device buffers on device " << device << endl;
+    if ( pdev->blas != nullptr ) cublasDestroy(pdev->blas);
+    cudaFree(pdev->sams);
+    cudaFree(pdev->dfts);
+    cudaFree(pdev->kernel);
+    return;
+  }
+  m_pdev = std::move(pdev);
+}
+
+//**********************************************************************
+
+CuFFTEngine::~CuFFTEngine() {
+  if ( ! m_pdev ) return;
+  cudaSetDevice(m_pdev->device);
+  for ( auto& ent : m_pdev->forwardPlans ) cufftDestroy(ent.second);
+  for ( auto& ent : m_pdev->backwardPlans ) cufftDestroy(ent.second);
+  cublasDestroy(m_pdev->blas);
+  cudaFree(m_pdev->sams);
+  cudaFree(m_pdev->dfts);
+  cudaFree(m_pdev->kernel);
+}
+
+//**********************************************************************
+
+int CuFFTEngine::executeForwardBatch(Index nsam, Index nbatch, Float* pin, Complex* pout) {
+  const string myname = "CuFFTEngine::executeForwardBatch: ";
+  if ( ! m_pdev ) return 5;
+  if ( nsam > m_nsamMax || nbatch > m_nbatchMax ) {
+    cout << myname << "Block is too large. Maximum is " << m_nbatchMax << " x " << m_nsamMax << endl;
+    return 2;
+  }
+  if ( nsam == 0 || nbatch == 0 ) return 0;
+  Device& dev = *m_pdev;
+  std::lock_guard<std::mutex> lock(dev.mutex);
+  cudaSetDevice(dev.device);
+  cufftHandle* pplan = dev.plan(dev.forwardPlans, CUFFT_R2C, nsam, nbatch);
+  if ( pplan == nullptr ) return 1;
+  size_t ncmp = nsam/2 + 1;
+  if ( cudaMemcpy(dev.sams, pin, sizeof(float)*nbatch*nsam, cudaMemcpyHostToDevice) != cudaSuccess ) return 1;
+  if ( cufftExecR2C(*pplan, dev.sams, dev.dfts) != CUFFT_SUCCESS ) return 1;
+  if ( cudaMemcpy(pout, dev.dfts, sizeof(cufftComplex)*nbatch*ncmp, cudaMemcpyDeviceToHost) != cudaSuccess ) return 1;
+  return 0;
+}
+
+//**********************************************************************
+
+int CuFFTEngine::executeBackwardBatch(Index nsam, Index nbatch, Complex* pin, Float* pout) {
+  const string myname = "CuFFTEngine::executeBackwardBatch: ";
+  if ( ! m_pdev ) return 5;
+  if ( nsam > m_nsamMax || nbatch > m_nbatchMax ) {
+    cout << myname << "Block is too large. Maximum is " << m_nbatchMax << " x " << m_nsamMax << endl;
+    return 2;
+  }
+  if ( nsam == 0 || nbatch == 0 ) return 0;
+  Device& dev = *m_pdev;
+  std::lock_guard<std::mutex> lock(dev.mutex);
+  cudaSetDevice(dev.device);
+  cufftHandle* pplan = dev.plan(dev.backwardPlans, CUFFT_C2R, nsam, nbatch);
+  if ( pplan == nullptr ) return 1;
+  size_t ncmp = nsam/2 + 1;
+  if ( cudaMemcpy(dev.dfts, pin, sizeof(cufftComplex)*nbatch*ncmp, cudaMemcpyHostToDevice) != cudaSuccess ) return 1;
+  if ( cufftExecC2R(*pplan, dev.dfts, dev.sams) != CUFFT_SUCCESS ) return 1;
+  if ( cudaMemcpy(pout, dev.sams, sizeof(float)*nbatch*nsam, cudaMemcpyDeviceToHost) != cudaSuccess ) return 1;
+  return 0;
+}
+
+//**********************************************************************
+
+int CuFFTEngine::convolveBatch(Index nsam, Index nrow, const Complex* pker, Float* psam) {
+  const string myname = "CuFFTEngine::convolveBatch: ";
+  if ( ! m_pdev ) return 5;
+  if ( nsam > m_nsamMax ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 2;
+  }
+  if ( nsam == 0 || nrow == 0 ) return 0;
+  Device& dev = *m_pdev;
+  std::lock_guard<std::mutex> lock(dev.mutex);
+  cudaSetDevice(dev.device);
+  size_t ncmp = nsam/2 + 1;
+  if ( cudaMemcpy(dev.kernel, pker, sizeof(cufftComplex)*ncmp, cudaMemcpyHostToDevice) != cudaSuccess ) return 1;
+  for ( Index irow0=0; irow0<nrow; irow0+=m_nbatchMax ) {
+    Index nbat = std::min(m_nbatchMax, nrow - irow0);
+    cufftHandle* pfwd = dev.plan(dev.forwardPlans, CUFFT_R2C, nsam, nbat);
+    cufftHandle* pbwd = dev.plan(dev.backwardPlans, CUFFT_C2R, nsam, nbat);
+    if ( pfwd == nullptr || pbwd == nullptr ) return 1;
+    float* prow = psam + size_t(irow0)*nsam;
+    size_t nbyte = sizeof(float)*nbat*nsam;
+    if ( cudaMemcpy(dev.sams, prow, nbyte, cudaMemcpyHostToDevice) != cudaSuccess ) return 1;
+    if ( cufftExecR2C(*pfwd, dev.sams, dev.dfts) != CUFFT_SUCCESS ) return 1;
+    // Each DFT is a column of the ncmp x nbat matrix dfts; scale its rows by the kernel.
+    if ( cublasCdgmm(dev.blas, CUBLAS_SIDE_LEFT, ncmp, nbat, dev.dfts, ncmp,
+                     dev.kernel, 1, dev.dfts, ncmp) != CUBLAS_STATUS_SUCCESS ) return 1;
+    if ( cufftExecC2R(*pbwd, dev.dfts, dev.sams) != CUFFT_SUCCESS ) return 1;
+    if ( cudaMemcpy(prow, dev.sams, nbyte, cudaMemcpyDeviceToHost) != cudaSuccess ) return 1;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+#else
+
+//**********************************************************************
+// Built without cuFFT.
+//**********************************************************************
+
+struct CuFFTEngine::Device { };
+
+bool CuFFTEngine::available() { return false; }
+
+CuFFTEngine::CuFFTEngine(Index nsamMax, Index nbatchMax, int)
+: m_nsamMax(nsamMax), m_nbatchMax(nbatchMax > 0 ? nbatchMax : 1) { }
+
+CuFFTEngine::~CuFFTEngine() = default;
+
+int CuFFTEngine::executeForwardBatch(Index, Index, Float*, Complex*) { return 5; }
+
+int CuFFTEngine::executeBackwardBatch(Index, Index, Complex*, Float*) { return 5; }
+
+int CuFFTEngine::convolveBatch(Index, Index, const Complex*, Float*) { return 5; }
+
+//**********************************************************************
+
+#endif
+
+bool CuFFTEngine::isValid() const { return bool(m_pdev); }
+
+//**********************************************************************
@@ -0,0 +1,78 @@
+// CuFFTEngine.h
+//
+// Batched real-data DFTs on a GPU with cuFFT, with the batch interface of FwFFTEngine:
+//   executeForwardBatch - nbatch forward transforms, inputs nsam apart and outputs
+//                         nsam/2 + 1 apart
+//   executeBackwardBatch - the inverse, not normalized
+//   convolveBatch - forward transform, kernel multiply and inverse transform of a
+//                   block of channels
+// The complex terms have the FFTW layout (fftwf_complex) so the buffers and kernels of
+// FwFloatFFT may be used unchanged.
+//
+// The buffers passed in are host memory. The engine holds device buffers for up to
+// batchSize() channels of nsamMax() samples, and convolveBatch keeps each block on the
+// device from the forward transform through the inverse, so there is one copy to the
+// device and one back per block. Plans are created once for each (nsam, nbatch).
+// Calls on one engine are serialized; use one engine per thread for concurrency.
+//
+// The engine is built with cuFFT when the CUDA toolkit is found at configure time
+// (DUNECORE_CUFFT). Otherwise, or if there is no device, available() is false, the
+// engine is not valid and the transforms return status 5, so callers should fall back
+// to FwFloatFFT:
+//   CuFFTEngine gpu(nsam, 256);
+//   if ( gpu.isValid() ) gpu.convolveBatch(nsam, ncha, pker, psam);
+//   else cpu.convolveBatch(nsam, ncha, pker, psam, work);
+
+#ifndef CuFFTEngine_H
+#define CuFFTEngine_H
+
+#include "dunecore/DuneCommon/Utility/FftwTraits.h"
+#include <memory>
+
+class CuFFTEngine {
+
+public:
+
+  using Index = unsigned int;
+  using Float = float;
+  using Complex = FftwTraits<float>::Complex;
+
+  // Is cuFFT built in and a device present?
+  static bool available();
+
+  // Ctor for up to nbatchMax transforms of at most nsamMax samples on a device.
+  CuFFTEngine(Index nsamMax, Index nbatchMax, int device =0);
+  CuFFTEngine(const CuFFTEngine&) = delete;
+  CuFFTEngine& operator=(const CuFFTEngine&) = delete;
+
+  // Dtor. Destroys the plans and frees the device buffers.
+  ~CuFFTEngine();
+
+  // Were the device buffers allocated?
+  bool isValid() const;
+
+  Index nsamMax() const { return m_nsamMax; }
+  Index batchSize() const { return m_nbatchMax; }
+
+  // nbatch transforms of exactly nsam samples (nbatch <= batchSize()) on host buffers laid
+  // out as for FwFFTEngine::executeForwardBatch and executeBackwardBatch.
+  // Returns 0 for success.
+  int executeForwardBatch(Index nsam, Index nbatch, Float* pin, Complex* pout);
+  int executeBackwardBatch(Index nsam, Index nbatch, Complex* pin, Float* pout);
+
+  // Same as FwFFTEngine::convolveBatch: multiply the DFTs of nrow channels of nsam samples,
+  // nsam apart in psam, by the kernel pker (nsam/2 + 1 terms) and transform back in place.
+  // Any number of rows may be given; they are sent in blocks of batchSize().
+  int convolveBatch(Index nsam, Index nrow, const Complex* pker, Float* psam);
+
+private:
+
+  struct Device;
+
+  Index m_nsamMax;
+  Index m_nbatchMax;
+  std::unique_ptr<Device> m_pdev;
+
+};
+
+#endif
@@ -3,6 +3,13 @@
 #include "dunecore/DuneCommon/Utility/DuneContextManager.h"
 
 using Context = DuneContextManager::Context;
+using Index = DuneContextManager::Index;
+
+namespace {
+
+thread_local Index threadSlot = DuneContextManager::globalSlot();
+
+}
 
 //******************************************************************************
 
@@ -16,14 +23,82 @@ DuneContextManager* DuneContextManager::instance() {
 
 //******************************************************************************
 
+void DuneContextManager::bindSlot(Index islot) {
+  threadSlot = islot;
+}
+
+//******************************************************************************
+
+Index DuneContextManager::currentSlot() {
+  return threadSlot;
+}
+
+//******************************************************************************
+
 void DuneContextManager::setContext(const Context* pcon) {
-  m_pcon.reset(pcon);
+  setContext(currentSlot(), pcon);
+}
+
+//******************************************************************************
+
+void DuneContextManager::setContext(Index islot, const Context* pcon) {
+  std::unique_ptr<const Context> pnew(pcon);
+  std::unique_ptr<const Context> pold;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ContextStack& cons = m_slots[islot];
+    if ( cons.empty() ) cons.emplace_back();
+    pold = std::move(cons.back());
+    cons.back() = std::move(pnew);
+  }
+}
+
+//******************************************************************************
+
+void DuneContextManager::pushContext(Index islot, const Context* pcon) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_slots[islot].emplace_back(pcon);
+}
+
+//******************************************************************************
+
+void DuneContextManager::popContext(Index islot) {
+  std::unique_ptr<const Context> pold;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto islo = m_slots.find(islot);
+    if ( islo == m_slots.end() || islo->second.empty() ) return;
+    pold = std::move(islo->second.back());
+    islo->second.pop_back();
+  }
 }
 
 //******************************************************************************
 
 const Context* DuneContextManager::context() const {
-  return m_pcon.get();
+  return context(currentSlot());
+}
+
+//******************************************************************************
+
+const Context* DuneContextManager::context(Index islot) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto islo = m_slots.find(islot);
+  if ( islo == m_slots.end() || islo->second.empty() ) return nullptr;
+  return islo->second.back().get();
+}
+
+//******************************************************************************
+
+void DuneContextManager::clearSlot(Index islot) {
+  ContextStack cons;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto islo = m_slots.find(islot);
+    if ( islo == m_slots.end() ) return;
+    cons = std::move(islo->second);
+    m_slots.erase(islo);
+  }
 }
 
 //******************************************************************************
@@ -7,34 +7,92 @@
 // valid for well-delineated processing periods. For HEP, this would typically
 // include run and event numbers.
 //
-// The class is a singleton in a single-threaded environment but it is envisioned
-// that a separate context would be maintained for each thread in an MT environment.
+// The class is a singleton. The context is held in slots, e.g. one for each art
+// schedule, so that events processed concurrently each have their own context.
+// Each thread uses the global slot unless it is bound to another slot with a
+// ScopedSlot guard, e.g. while a module runs for a schedule:
+//   DuneContextManager::ScopedSlot slot(scheduleId);
+//   ... DuneContextManager::instance()->context() is the context for the schedule ...
+// Each slot holds a stack of contexts: a ScopedContext guard sets a context for the
+// current slot and restores the previous one when it goes out of scope.
+// All methods may be called concurrently.
 
 #ifndef DuneContextManager_H
 #define DuneContextManager_H
 
 #include "dunecore/DuneInterface/Data/DuneContext.h"
 #include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <limits>
 
 class DuneContextManager {
 
 public:  // Types.
 
   using Context = DuneContext;
+  using Index = unsigned int;
+
+  // Guard that binds the current thread to a slot and restores the previous
+  // binding when it goes out of scope.
+  class ScopedSlot {
+  public:
+    explicit ScopedSlot(Index islot) : m_old(currentSlot()) { bindSlot(islot); }
+    ~ScopedSlot() { bindSlot(m_old); }
+    ScopedSlot(const ScopedSlot&) =delete;
+    ScopedSlot& operator=(const ScopedSlot&) =delete;
+  private:
+    Index m_old;
+  };
+
+  // Guard that pushes a context onto the stack of the current slot and pops it
+  // when it goes out of scope. The guard takes ownership of the context.
+  class ScopedContext {
+  public:
+    explicit ScopedContext(const Context* pcon) : m_islot(currentSlot()) {
+      instance()->pushContext(m_islot, pcon);
+    }
+    ~ScopedContext() { instance()->popContext(m_islot); }
+    ScopedContext(const ScopedContext&) =delete;
+    ScopedContext& operator=(const ScopedContext&) =delete;
+  private:
+    Index m_islot;
+  };
 
 public:  // Class methods
 
   static DuneContextManager* instance();
 
+  // Slot used by threads that are not bound to another slot.
+  static Index globalSlot() { return std::numeric_limits<Index>::max(); }
+
+  // Bind the current thread to a slot. Prefer ScopedSlot.
+  static void bindSlot(Index islot);
+
+  // Slot for the current thread.
+  static Index currentSlot();
+
 public:  // Object methods
 
-  // Set the context.
+  // Set the context for the current slot or slot islot.
   // Caller creates the object on the heap and relinquishes ownership.
-  // The previous context is destroyed.
+  // The previous context (top of the stack) is destroyed.
   void setContext(const Context*);
+  void setContext(Index islot, const Context*);
+
+  // Push or pop a context for a slot. Prefer ScopedContext.
+  // Push takes ownership of the context. Pop destroys it.
+  void pushContext(Index islot, const Context*);
+  void popContext(Index islot);
 
   // Return the current context generically.
+  // The pointer remains valid until the context is replaced or popped.
   const Context* context() const;
+  const Context* context(Index islot) const;
+
+  // Remove a slot and its contexts, e.g. at the end of a job.
+  void clearSlot(Index islot);
   
   // Return the current context promoted to the specified type.
   // Returns 0 if the context exists and is promoted.
@@ -43,8 +101,11 @@ public:  // Object methods
 
 private:  // Data.
 
+  using ContextStack = std::vector<std::unique_ptr<const Context>>;
+
   static DuneContextManager* m_instance;
-  std::unique_ptr<const Context> m_pcon;
+  std::map<Index, ContextStack> m_slots;
+  mutable std::mutex m_mutex;
 
 };
 
@@ -5,6 +5,14 @@
 
 using Name = DuneContextToolRedirector::Name;
 using Content = DuneContextToolRedirector::Context;
+using Key = DuneContextToolRedirector::Key;
+
+namespace {
+
+// Maximum number of cached names, e.g. for concurrent events in different runs.
+const std::size_t maxCachedNames = 32;
+
+}
 
 //**********************************************************************
 
@@ -13,10 +21,27 @@ DuneContextToolRedirector::DuneContextToolRedirector(fhicl::ParameterSet const&
 
 //**********************************************************************
 
+Key DuneContextToolRedirector::contextKey(const Context* pcon) const {
+  if ( pcon == nullptr ) return nullKey();
+  return (Key(pcon->getRun()) << 32) | Key(pcon->getEvent());
+}
+
+//**********************************************************************
+
 Name DuneContextToolRedirector::getName() const {
   DuneContextManager* pcm = DuneContextManager::instance();
   const Context* pcon = pcm->context();
-  return getNameInContext(pcon);
+  Key key = contextKey(pcon);
+  {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto inam = m_cachedNames.find(key);
+    if ( inam != m_cachedNames.end() ) return inam->second;
+  }
+  Name nam = getNameInContext(pcon);
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  if ( m_cachedNames.size() >= maxCachedNames ) m_cachedNames.clear();
+  m_cachedNames.emplace(key, nam);
+  return nam;
 }
 
 //**********************************************************************
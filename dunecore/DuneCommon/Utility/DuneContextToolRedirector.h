@@ -9,6 +9,9 @@
 // Note this is a ToolRedirector and concrete implementations are
 // required to provide a fcl param with key "tool_redirector" so
 // the tool manager recognizes them as such.
+//
+// The name returned by getName is cached for each context key (see contextKey)
+// so the name is evaluated only when the context changes, e.g. once per run.
 
 #ifndef DuneContextToolRedirector_H
 #define DuneContextToolRedirector_H
@@ -16,6 +19,8 @@
 #include "dunecore/DuneInterface/Data/DuneContext.h"
 #include "dunecore/ArtSupport/ToolRedirector.h"
 #include <string>
+#include <map>
+#include <mutex>
 
 class DuneContextToolRedirector : public ToolRedirector {
 
@@ -23,6 +28,10 @@ public:
 
   using Name = std::string;
   using Context = DuneContext;
+  using Key = unsigned long long;
+
+  // Key for a missing context.
+  static Key nullKey() { return Key(-1); }
 
   // Ctor.
   DuneContextToolRedirector(fhicl::ParameterSet const& ps);
@@ -35,10 +44,23 @@ public:
   // missing context (null pointer).
   virtual Name getNameInContext(const Context* pcon) const =0;
 
-  // Get context from the context manager and call the above method.
+  // Return a key such that getNameInContext returns the same name for all
+  // contexts with the same key.
+  // The default combines the run and event numbers. Implementations that depend
+  // only on the run should return the run.
+  virtual Key contextKey(const Context* pcon) const;
+
+  // Get context from the context manager and call the above method
+  // unless the name is cached for the context key.
   // This is used by the tool manager.
   virtual Name getName() const;
 
+private:
+
+  // Cached names indexed by context key.
+  mutable std::map<Key, Name> m_cachedNames;
+  mutable std::mutex m_cacheMutex;
+
 };
 
 #endif
@@ -1,9 +1,14 @@
 // DuneFFT.cxx
 #include "DuneFFT.h"
+#include "dunecore/DuneCommon/Utility/FwFFT.h"
 #include <iostream>
 #include <sstream>
 #include <vector>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
 #include "TVirtualFFT.h"
 #include "TComplex.h"
 
@@ -14,13 +19,108 @@ using std::endl;
 using std::vector;
 using std::setw;
 using std::fixed;
+using Index = DuneFFT::Index;
+
+//**********************************************************************
+// Local definitions.
+//**********************************************************************
+
+namespace {
+
+std::atomic<DuneFFT::Backend> backendSetting{DuneFFT::Fftw};
+std::atomic<Index> planOptionSetting{1};
+
+// Sample count handled by the engine for nsam samples.
+Index engineSize(Index nsam) {
+  Index nmax = 64;
+  while ( nmax < nsam ) nmax *= 2;
+  return nmax;
+}
+
+// Workspace for this thread for an engine size.
+FwFFT::Workspace& threadWorkspace(Index nmax) {
+  thread_local std::map<Index, std::unique_ptr<FwFFT::Workspace>> works;
+  std::unique_ptr<FwFFT::Workspace>& pwork = works[nmax];
+  if ( ! pwork ) pwork.reset(new FwFFT::Workspace(nmax));
+  return *pwork;
+}
+
+}  // end unnamed namespace
 
 //**********************************************************************
 // Class methods.
 //**********************************************************************
 
+void DuneFFT::setBackend(Backend val) {
+  backendSetting = val;
+}
+
+//**********************************************************************
+
+DuneFFT::Backend DuneFFT::backend() {
+  return backendSetting;
+}
+
+//**********************************************************************
+
+void DuneFFT::setPlanOption(Index opt) {
+  planOptionSetting = opt;
+}
+
+//**********************************************************************
+
+Index DuneFFT::planOption() {
+  return planOptionSetting;
+}
+
+//**********************************************************************
+
+FwFFT& DuneFFT::engine(Index nsam) {
+  static std::mutex engineMutex;
+  static std::map<Index, std::unique_ptr<FwFFT>> engines;
+  Index nmax = engineSize(nsam);
+  std::lock_guard<std::mutex> lock(engineMutex);
+  std::unique_ptr<FwFFT>& pfft = engines[nmax];
+  if ( ! pfft ) pfft.reset(new FwFFT(nmax, planOption()));
+  return *pfft;
+}
+
+//**********************************************************************
+
 int DuneFFT::
 fftForward(Index nsam, const float* psam, DFT& dft, Index logLevel) {
+  if ( backend() == Root ) return rootForward(nsam, psam, dft, logLevel);
+  if ( nsam == 0 ) {
+    dft.reset(nsam);
+    return dft.isValid() ? 0 : 1;
+  }
+  Index nmax = engineSize(nsam);
+  return engine(nsam).fftForward(nsam, psam, dft, threadWorkspace(nmax), logLevel);
+}
+
+//**********************************************************************
+
+int DuneFFT::
+fftForward(const FloatVector& sams, DFT& dft, Index logLevel) {
+  return fftForward(sams.size(), &sams[0], dft, logLevel);
+}
+
+//**********************************************************************
+
+int DuneFFT::
+fftInverse(const DFT& dft, FloatVector& sams, Index logLevel) {
+  if ( backend() == Root ) return rootInverse(dft, sams, logLevel);
+  if ( ! dft.isValid() ) return 1;
+  Index nsam = dft.nSample();
+  if ( nsam == 0 ) return 1;
+  Index nmax = engineSize(nsam);
+  return engine(nsam).fftInverse(dft, sams, threadWorkspace(nmax), logLevel);
+}
+
+//**********************************************************************
+
+int DuneFFT::
+rootForward(Index nsam, const float* psam, DFT& dft, Index logLevel) {
   const string myname = "DuneFFT::fftForward: ";
   dft.reset(nsam);
   if ( ! dft.isValid() ) return 1;
@@ -69,14 +169,7 @@ fftForward(Index nsam, const float* psam, DFT& dft, Index logLevel) {
 //**********************************************************************
 
 int DuneFFT::
-fftForward(const FloatVector& sams, DFT& dft, Index logLevel) {
-  return fftForward(sams.size(), &sams[0], dft, logLevel);
-}
-
-//**********************************************************************
-
-int DuneFFT::
-fftInverse(const DFT& dft, FloatVector& sams, Index logLevel) {
+rootInverse(const DFT& dft, FloatVector& sams, Index logLevel) {
   const string myname = "DuneFFT::fftInverse: ";
   if ( ! dft.isValid() ) return 1;
   Index namp = dft.nAmplitude();
@@ -4,8 +4,12 @@
 // April 2019
 //
 // This utility provides wrappers for performing forward and backward DFT (discrete
-// Fourier transform) of real (time-domain) data. It uses the the Root TVirtualFFT
-// interface which in turn uses FFTW by default.
+// Fourier transform) of real (time-domain) data. Two backends are available:
+//   Fftw - FwFFT engines held in a process-wide cache (default)
+//   Root - the Root TVirtualFFT interface, which builds a new transform for each call
+// For the Fftw backend, sample counts are grouped in powers of two and each group has
+// one FwFFT that caches the plans for its sizes. Each thread has its own workspace for
+// each group so the transforms may be called concurrently.
 //
 // The real data is held in a vector of floats. The DFT is a vector of complex values
 // of the same length and so has a factor of two redundancy. The DFT data is returned
@@ -20,6 +24,8 @@
 
 #include "dunecore/DuneCommon/Utility/CompactRealDftData.h"
 
+class FwFFT;
+
 class DuneFFT {
 
 public:
@@ -28,6 +34,20 @@ public:
   using DFT = CompactRealDftData<float>;
   using FloatVector = std::vector<float>;
 
+  enum Backend { Fftw, Root };
+
+  // Select the backend for all subsequent transforms.
+  static void setBackend(Backend val);
+  static Backend backend();
+
+  // Set the FwFFT plan optimization (0-2, see FwFFT) for engines created
+  // after this call. Default is 1.
+  static void setPlanOption(Index opt);
+  static Index planOption();
+
+  // Return the process-wide FwFFT that handles transforms of nsam samples.
+  static FwFFT& engine(Index nsam);
+
   // Forward transform: real data (ntick starting at psam[0] --> complex freqs).
   //   ntick - # ticks to use in transform.
   //   psam - Address of the first element in the data array
@@ -42,6 +62,12 @@ public:
   // Thr real and imag freq component are also recorded in xres, xims
   static int fftInverse(const DFT& dft, FloatVector& sams, Index logLevel =0);
 
+private:
+
+  // Root implementations.
+  static int rootForward(Index ntick, const float* psam, DFT& dft, Index logLevel);
+  static int rootInverse(const DFT& dft, FloatVector& sams, Index logLevel);
+
 };
 
 #endif
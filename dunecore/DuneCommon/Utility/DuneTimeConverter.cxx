@@ -34,6 +34,36 @@ uint64_t DuneTimeConverter::toNova(art::Timestamp tart) {
 
 //**********************************************************************
 
+void DuneTimeConverter::
+fromNova(const uint64_t* ptnovas, unsigned int n, art::Timestamp* ptarts) {
+  // (ticksRem*1000)/64 in fromNova is ticksRem*125/8.
+  const uint64_t tickPerSec = novaTicksPerSec();
+  const uint64_t t0Sec = novaT0Sec();
+  for ( unsigned int itim=0; itim<n; ++itim ) {
+    uint64_t novaTime = ptnovas[itim];
+    uint64_t secSinceNovaT0 = novaTime/tickPerSec;
+    uint64_t ticksRem = novaTime - tickPerSec*secSinceNovaT0;
+    uint64_t nsec = (ticksRem*125) >> 3;
+    ptarts[itim] = art::Timestamp(((secSinceNovaT0 + t0Sec) << 32) + nsec);
+  }
+}
+
+//**********************************************************************
+
+void DuneTimeConverter::
+toNova(const art::Timestamp* ptarts, unsigned int n, uint64_t* ptnovas) {
+  // (tlo*64)/1000 in toNova is tlo*8/125.
+  const uint64_t tickPerSec = novaTicksPerSec();
+  const uint64_t t0Sec = novaT0Sec();
+  for ( unsigned int itim=0; itim<n; ++itim ) {
+    uint64_t thi = ptarts[itim].timeHigh();
+    uint64_t tlo = ptarts[itim].timeLow();
+    ptnovas[itim] = tickPerSec*(thi - t0Sec) + (tlo << 3)/125;
+  }
+}
+
+//**********************************************************************
+
 art::Timestamp DuneTimeConverter::makeTimestamp(uint32_t tsec, uint32_t tns) {
   uint64_t tthi = tsec;
   uint64_t thilo = (tthi << 32) + tns;
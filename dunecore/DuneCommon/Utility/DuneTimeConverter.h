@@ -13,6 +13,10 @@
 //   Remainder in ns in the low word
 // NOvA time is the # ticks since 2010 with 1 tick = 1/(64 MHz),
 // i.e. there are 64 ticks/us.
+//
+// The conversions between ticks and ns use the exact integer ratio
+// 1000/64 = 125/8 so there is no floating point and no division other
+// than by constants.
 
 #include <stdint.h>
 #include <string>
@@ -42,6 +46,10 @@ public:
   // Convert NOvA time to dune time.
   static uint64_t toNova(art::Timestamp tart);
 
+  // Convert arrays of n times. The results are the same as above.
+  static void fromNova(const uint64_t* ptnovas, unsigned int n, art::Timestamp* ptarts);
+  static void toNova(const art::Timestamp* ptarts, unsigned int n, uint64_t* ptnovas);
+
   // Construct timestamp from the time in sec and remainder in ns
   static art::Timestamp makeTimestamp(uint32_t tsec, uint32_t trem);
 
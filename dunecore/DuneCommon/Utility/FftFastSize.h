@@ -0,0 +1,25 @@
+// FftFastSize.h
+//
+// Transform lengths that FFTW handles efficiently.
+//
+// FFTW is fastest for lengths whose prime factors are all small. fftFastSize(n)
+// returns the smallest length >= n of the form 2^a 3^b 5^c 7^d. FwFFT and Fw2dFFT
+// use this to zero-pad transforms when the fast-size policy is enabled.
+
+#ifndef FftFastSize_H
+#define FftFastSize_H
+
+#include <initializer_list>
+
+inline unsigned int fftFastSize(unsigned int n) {
+  if ( n <= 1 ) return n;
+  for ( unsigned int m=n; ; ++m ) {
+    unsigned int r = m;
+    for ( unsigned int p : {2u, 3u, 5u, 7u} ) {
+      while ( r%p == 0 ) r /= p;
+    }
+    if ( r == 1 ) return m;
+  }
+}
+
+#endif
@@ -0,0 +1,165 @@
+// FftwRealDftData.h
+//
+// Concrete class that holds 1D DFT data in the FFTW half-complex layout.
+//
+// For n real samples, the DFT is stored as the n/2 + 1 complex terms
+// dft[0], ..., dft[n/2] interleaved (real0, imag0, real1, ...) in one buffer aligned
+// for SIMD access, i.e. exactly as written by an FFTW r2c transform. The remaining
+// terms are obtained from
+//   dft[i] = CC{dft[n-i]}
+// where CC denotes complex conjugation.
+//
+// The stored terms are those of the standard (unnormalized) FFTW transform. The
+// global and term normalizations are applied when the terms are accessed, and the
+// amplitude and phase are computed only when requested, so the FFTW output can be
+// used without conversion. The accessors follow CompactRealDftData: the Nyquist term
+// (even n) has its sign in the amplitude and phase zero.
+
+#ifndef FftwRealDftData_H
+#define FftwRealDftData_H
+
+#include "dunecore/DuneCommon/Utility/RealDftData.h"
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <new>
+#include <cstddef>
+
+//**********************************************************************
+
+template<typename F>
+class FftwRealDftData : public RealDftData<F> {
+
+public:
+
+  using typename RealDftData<F>::Index;
+  using Float = F;
+  using Complex = std::complex<F>;     // same memory layout as fftw_complex
+  using Norm = RealDftNormalization;
+
+  // Allocator that aligns the data for SIMD access.
+  template<typename T>
+  struct AlignedAllocator {
+    using value_type = T;
+    static constexpr std::size_t alignment = 64;
+    AlignedAllocator() =default;
+    template<typename U> AlignedAllocator(const AlignedAllocator<U>&) { }
+    T* allocate(std::size_t n) {
+      return static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(alignment)));
+    }
+    void deallocate(T* ptr, std::size_t) { ::operator delete(ptr, std::align_val_t(alignment)); }
+    template<typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template<typename U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+  };
+
+  using ComplexVector = std::vector<Complex, AlignedAllocator<Complex>>;
+
+  // Default ctor.
+  FftwRealDftData() =default;
+
+  // Ctor from normalization. Leaves object empty and so invalid.
+  explicit FftwRealDftData(Norm norm)
+  : m_norm(norm) { }
+
+  // Ctor from normalization and sample count.
+  FftwRealDftData(Norm norm, Index nsam)
+  : m_norm(norm) {
+    reset(nsam);
+  }
+
+  // Ctor from another representation, keeping its normalization.
+  explicit FftwRealDftData(const RealDftData<F>& rhs)
+  : m_norm(rhs.normalization()) {
+    if ( ! rhs.isValid() ) return;
+    reset(rhs.nSample());
+    for ( Index ifrq=0; ifrq<nComplex(); ++ifrq ) {
+      F amp = rhs.convAmplitude(ifrq);
+      F pha = rhs.phase(ifrq);
+      m_data[ifrq] = Complex(amp*cos(pha), amp*sin(pha));
+    }
+  }
+
+  // Normalization.
+  const Norm& normalization() const override { return m_norm; }
+
+  // Clear data.
+  void clear() override {
+    m_nsam = 0;
+    m_data.clear();
+  }
+
+  // Reset to nsam samples and zero the DFT.
+  void reset(Index nsam) override {
+    m_nsam = nsam;
+    m_data.assign(nsam > 0 ? nsam/2 + 1 : 0, Complex(0.0, 0.0));
+  }
+
+  // Dimension information.
+  Index nSample() const override { return m_nsam; }
+  Index nComplex() const { return m_data.size(); }
+
+  // Access the raw (unnormalized) terms.
+  Complex* data() { return m_data.data(); }
+  const Complex* data() const { return m_data.data(); }
+
+  // Access the raw terms by component: real0, imag0, real1, ...
+  Float* floatData() { return reinterpret_cast<Float*>(m_data.data()); }
+  const Float* floatData() const { return reinterpret_cast<const Float*>(m_data.data()); }
+
+  // Return the raw term for any frequency ifrq < nSample.
+  Complex rawValue(Index ifrq) const {
+    if ( ifrq < nComplex() ) return m_data[ifrq];
+    if ( ifrq < nSample() ) return std::conj(m_data[nSample() - ifrq]);
+    return Complex(this->badValue(), 0.0);
+  }
+
+  // Set the raw term for a compact frequency.
+  int setRawValue(Index ifrq, Complex val) {
+    if ( ifrq >= nComplex() ) return 1;
+    m_data[ifrq] = val;
+    return 0;
+  }
+
+  // Factor applied to the raw terms for frequency ifrq.
+  F factor(Index ifrq) const {
+    F fac = 1.0;
+    if ( m_norm.isConsistent() ) fac = 1.0/sqrt(F(m_nsam));
+    if ( m_norm.isBin() ) fac = 1.0/F(m_nsam);
+    if ( m_norm.isPower() && this->isAliased(ifrq) ) fac *= sqrt(2.0);
+    return fac;
+  }
+
+  // Overide methods that return DFT terms for any representation.
+  F amplitude(Index ifrq) const override {
+    if ( ifrq >= nSample() ) return this->badValue();
+    Complex val = rawValue(ifrq);
+    F amp = this->isNyquist(ifrq) ? val.real() : std::abs(val);
+    return factor(ifrq)*amp;
+  }
+  F phase(Index ifrq) const override {
+    if ( ifrq >= nSample() ) return this->badValue();
+    if ( this->isNyquist(ifrq) ) return 0.0;
+    return std::arg(rawValue(ifrq));
+  }
+  F real(Index ifrq) const override {
+    if ( ifrq >= nSample() ) return this->badValue();
+    return factor(ifrq)*rawValue(ifrq).real();
+  }
+  F imag(Index ifrq) const override {
+    if ( ifrq >= nSample() ) return this->badValue();
+    if ( this->isNyquist(ifrq) ) return 0.0;
+    return factor(ifrq)*rawValue(ifrq).imag();
+  }
+
+private:
+
+  // Data.
+  Norm m_norm;
+  Index m_nsam = 0;
+  ComplexVector m_data;
+
+};
+
+//**********************************************************************
+
+#endif
@@ -0,0 +1,71 @@
+// FftwTraits.h
+//
+// Maps the FFTW types and calls onto the floating-point type of the transform:
+//   FftwTraits<double> - fftw_ functions (libfftw3)
+//   FftwTraits<float> - fftwf_ functions (libfftw3f)
+// so that the wrappers (e.g. FwFFTEngine) can be written once for both precisions.
+
+#ifndef FftwTraits_H
+#define FftwTraits_H
+
+#include "fftw3.h"
+#include <cstddef>
+
+template<typename F>
+struct FftwTraits;
+
+template<>
+struct FftwTraits<double> {
+  using Complex = fftw_complex;
+  using Plan = fftw_plan;
+  static const char* name() { return "double"; }
+  static void* malloc(std::size_t nbyte) { return fftw_malloc(nbyte); }
+  static void free(void* ptr) { fftw_free(ptr); }
+  static Plan planR2c(int n, double* pin, Complex* pout, unsigned flag) {
+    return fftw_plan_dft_r2c_1d(n, pin, pout, flag);
+  }
+  static Plan planC2r(int n, Complex* pin, double* pout, unsigned flag) {
+    return fftw_plan_dft_c2r_1d(n, pin, pout, flag);
+  }
+  static Plan planManyR2c(int n, int nbatch, double* pin, int idist, Complex* pout, int odist, unsigned flag) {
+    return fftw_plan_many_dft_r2c(1, &n, nbatch, pin, nullptr, 1, idist, pout, nullptr, 1, odist, flag);
+  }
+  static Plan planManyC2r(int n, int nbatch, Complex* pin, int idist, double* pout, int odist, unsigned flag) {
+    return fftw_plan_many_dft_c2r(1, &n, nbatch, pin, nullptr, 1, idist, pout, nullptr, 1, odist, flag);
+  }
+  static void executeR2c(Plan plan, double* pin, Complex* pout) { fftw_execute_dft_r2c(plan, pin, pout); }
+  static void executeC2r(Plan plan, Complex* pin, double* pout) { fftw_execute_dft_c2r(plan, pin, pout); }
+  static void destroy(Plan plan) { fftw_destroy_plan(plan); }
+  static int alignmentOf(double* ptr) { return fftw_alignment_of(ptr); }
+  static int importWisdom(const char* fname) { return fftw_import_wisdom_from_filename(fname); }
+  static int exportWisdom(const char* fname) { return fftw_export_wisdom_to_filename(fname); }
+};
+
+template<>
+struct FftwTraits<float> {
+  using Complex = fftwf_complex;
+  using Plan = fftwf_plan;
+  static const char* name() { return "float"; }
+  static void* malloc(std::size_t nbyte) { return fftwf_malloc(nbyte); }
+  static void free(void* ptr) { fftwf_free(ptr); }
+  static Plan planR2c(int n, float* pin, Complex* pout, unsigned flag) {
+    return fftwf_plan_dft_r2c_1d(n, pin, pout, flag);
+  }
+  static Plan planC2r(int n, Complex* pin, float* pout, unsigned flag) {
+    return fftwf_plan_dft_c2r_1d(n, pin, pout, flag);
+  }
+  static Plan planManyR2c(int n, int nbatch, float* pin, int idist, Complex* pout, int odist, unsigned flag) {
+    return fftwf_plan_many_dft_r2c(1, &n, nbatch, pin, nullptr, 1, idist, pout, nullptr, 1, odist, flag);
+  }
+  static Plan planManyC2r(int n, int nbatch, Complex* pin, int idist, float* pout, int odist, unsigned flag) {
+    return fftwf_plan_many_dft_c2r(1, &n, nbatch, pin, nullptr, 1, idist, pout, nullptr, 1, odist, flag);
+  }
+  static void executeR2c(Plan plan, float* pin, Complex* pout) { fftwf_execute_dft_r2c(plan, pin, pout); }
+  static void executeC2r(Plan plan, Complex* pin, float* pout) { fftwf_execute_dft_c2r(plan, pin, pout); }
+  static void destroy(Plan plan) { fftwf_destroy_plan(plan); }
+  static int alignmentOf(float* ptr) { return fftwf_alignment_of(ptr); }
+  static int importWisdom(const char* fname) { return fftwf_import_wisdom_from_filename(fname); }
+  static int exportWisdom(const char* fname) { return fftwf_export_wisdom_to_filename(fname); }
+};
+
+#endif
@@ -0,0 +1,175 @@
+// FloatHist.cxx
+
+#include "FloatHist.h"
+#include "TH1F.h"
+#include <cmath>
+#include <algorithm>
+
+using Index = FloatHist::Index;
+
+//**********************************************************************
+
+FloatHist::FloatHist(Index nbin, double xmin, double xmax)
+: m_xmin(xmin), m_xmax(xmax), m_dx(nbin > 0 ? (xmax - xmin)/nbin : 0.0),
+  m_vals(nbin, 0.0) { }
+
+//**********************************************************************
+
+int FloatHist::findBin(double x) const {
+  if ( x < m_xmin ) return -1;
+  if ( ! (m_dx > 0.0) ) return nbin();
+  double rbin = (x - m_xmin)/m_dx;
+  if ( ! (rbin < nbin()) ) return nbin();
+  return int(rbin);
+}
+
+//**********************************************************************
+
+double FloatHist::sum() const {
+  double sum = 0.0;
+  for ( float val : m_vals ) sum += val;
+  return sum;
+}
+
+//**********************************************************************
+
+double FloatHist::mean() const {
+  double sumw = 0.0;
+  double sumwx = 0.0;
+  for ( Index ibin=0; ibin<nbin(); ++ibin ) {
+    sumw += m_vals[ibin];
+    sumwx += m_vals[ibin]*binCenter(ibin);
+  }
+  return sumw != 0.0 ? sumwx/sumw : 0.0;
+}
+
+//**********************************************************************
+
+double FloatHist::rms() const {
+  double sumw = 0.0;
+  double sumwx = 0.0;
+  double sumwxx = 0.0;
+  for ( Index ibin=0; ibin<nbin(); ++ibin ) {
+    double x = binCenter(ibin);
+    sumw += m_vals[ibin];
+    sumwx += m_vals[ibin]*x;
+    sumwxx += m_vals[ibin]*x*x;
+  }
+  if ( sumw == 0.0 ) return 0.0;
+  double xm = sumwx/sumw;
+  double var = sumwxx/sumw - xm*xm;
+  return var > 0.0 ? sqrt(var) : 0.0;
+}
+
+//**********************************************************************
+
+void FloatHist::fill(double x, double wt) {
+  int ibin = findBin(x);
+  if ( ibin < 0 ) m_under += wt;
+  else if ( Index(ibin) >= nbin() ) m_over += wt;
+  else m_vals[ibin] += wt;
+  m_entries += 1.0;
+}
+
+//**********************************************************************
+
+void FloatHist::fill(const float* pxs, Index nx) {
+  if ( pxs == nullptr ) return;
+  for ( Index ix=0; ix<nx; ++ix ) fill(pxs[ix]);
+}
+
+//**********************************************************************
+
+void FloatHist::reset() {
+  m_vals.assign(nbin(), 0.0);
+  m_under = 0.0;
+  m_over = 0.0;
+  m_entries = 0.0;
+}
+
+//**********************************************************************
+
+void FloatHist::scale(double fac) {
+  for ( float& val : m_vals ) val *= fac;
+  m_under *= fac;
+  m_over *= fac;
+}
+
+//**********************************************************************
+
+void FloatHist::shiftBins(int nshift) {
+  int nb = nbin();
+  if ( nshift == 0 || nb == 0 ) return;
+  if ( nshift > 0 ) {
+    for ( int ibin=std::max(nb-nshift, 0); ibin<nb; ++ibin ) m_over += m_vals[ibin];
+    for ( int ibin=nb-1; ibin>=0; --ibin ) {
+      m_vals[ibin] = ibin >= nshift ? m_vals[ibin-nshift] : 0.0;
+    }
+  } else {
+    int nsh = -nshift;
+    for ( int ibin=0; ibin<std::min(nsh, nb); ++ibin ) m_under += m_vals[ibin];
+    for ( int ibin=0; ibin<nb; ++ibin ) {
+      m_vals[ibin] = ibin + nsh < nb ? m_vals[ibin+nsh] : 0.0;
+    }
+  }
+}
+
+//**********************************************************************
+
+void FloatHist::shiftAxis(double dx) {
+  m_xmin += dx;
+  m_xmax += dx;
+}
+
+//**********************************************************************
+
+int FloatHist::rebin(Index ngroup) {
+  if ( ngroup == 0 ) return 1;
+  if ( ngroup == 1 ) return 0;
+  Index nbinNew = nbin()/ngroup;
+  for ( Index ibin=nbinNew*ngroup; ibin<nbin(); ++ibin ) m_over += m_vals[ibin];
+  for ( Index ibinNew=0; ibinNew<nbinNew; ++ibinNew ) {
+    float sum = 0.0;
+    for ( Index ibin=ibinNew*ngroup; ibin<(ibinNew+1)*ngroup; ++ibin ) sum += m_vals[ibin];
+    m_vals[ibinNew] = sum;
+  }
+  m_vals.resize(nbinNew);
+  m_dx *= ngroup;
+  m_xmax = m_xmin + nbinNew*m_dx;
+  return 0;
+}
+
+//**********************************************************************
+
+TH1* FloatHist::makeTH1(Name hnam, Name httl) const {
+  TH1* ph = new TH1F(hnam.c_str(), httl.c_str(), nbin(), m_xmin, m_xmax);
+  ph->SetDirectory(nullptr);
+  copyTo(ph);
+  return ph;
+}
+
+//**********************************************************************
+
+int FloatHist::copyTo(TH1* ph) const {
+  if ( ph == nullptr ) return 1;
+  if ( Index(ph->GetNbinsX()) != nbin() ) return 2;
+  for ( Index ibin=0; ibin<nbin(); ++ibin ) ph->SetBinContent(ibin + 1, m_vals[ibin]);
+  ph->SetBinContent(0, m_under);
+  ph->SetBinContent(nbin() + 1, m_over);
+  ph->SetEntries(m_entries);
+  return 0;
+}
+
+//**********************************************************************
+
+int FloatHist::copyFrom(const TH1* ph) {
+  if ( ph == nullptr ) return 1;
+  if ( Index(ph->GetNbinsX()) != nbin() ) return 2;
+  for ( Index ibin=0; ibin<nbin(); ++ibin ) m_vals[ibin] = ph->GetBinContent(ibin + 1);
+  m_under = ph->GetBinContent(0);
+  m_over = ph->GetBinContent(nbin() + 1);
+  m_entries = ph->GetEntries();
+  return 0;
+}
+
+//**********************************************************************
@@ -0,0 +1,117 @@
+// FloatHist.h
+//
+// One-dimensional histogram with uniform binning held in a std::vector<float>.
+//
+// This is a light alternative to TH1 for per-channel analysis. There is no
+// name, no Root directory registration and no global state, so instances may
+// be created, filled and modified concurrently in different threads. Shift,
+// rebin and scale are done in place without cloning.
+//
+// Conversion to Root is done only when needed, e.g. at output time:
+//   FloatHist fh(200, -100, 100);
+//   fh.fill(acd.samples);
+//   fh.rebin(2);
+//   TH1* ph = fh.makeTH1("hadc", "ADC");
+// The created histogram is not attached to any Root directory and is owned
+// by the caller.
+//
+// The contents are accessible as an array so they may be passed to array
+// methods such as GausStepFitter::fitArray(fh.contents(), fh.binCenter(0),
+// fh.binWidth(), res).
+//
+// Bins are indexed from 0 to nbin()-1. Underflow and overflow are held
+// separately.
+
+#ifndef FloatHist_H
+#define FloatHist_H
+
+#include <vector>
+#include <string>
+
+class TH1;
+
+class FloatHist {
+
+public:
+
+  using Index = unsigned int;
+  using Name = std::string;
+  using FloatVector = std::vector<float>;
+
+  // Ctors.
+  FloatHist() =default;
+  FloatHist(Index nbin, double xmin, double xmax);
+
+  // Return the binning.
+  Index nbin() const { return m_vals.size(); }
+  double xmin() const { return m_xmin; }
+  double xmax() const { return m_xmax; }
+  double binWidth() const { return m_dx; }
+  double binLowEdge(Index ibin) const { return m_xmin + ibin*m_dx; }
+  double binCenter(Index ibin) const { return m_xmin + (ibin + 0.5)*m_dx; }
+
+  // Return the bin for x: -1 for underflow and nbin() for overflow.
+  int findBin(double x) const;
+
+  // Return the contents.
+  const FloatVector& contents() const { return m_vals; }
+  float* data() { return m_vals.data(); }
+  float binContent(Index ibin) const { return ibin < nbin() ? m_vals[ibin] : 0.0; }
+  float underflow() const { return m_under; }
+  float overflow() const { return m_over; }
+  double entries() const { return m_entries; }
+
+  // Sum, mean and RMS of the in-range contents.
+  double sum() const;
+  double mean() const;
+  double rms() const;
+
+  // Fill.
+  void fill(double x, double wt =1.0);
+  void fill(const float* pxs, Index nx);
+  void fill(const FloatVector& xs) { fill(xs.data(), xs.size()); }
+
+  // Set a bin content.
+  void setBinContent(Index ibin, float val) { if ( ibin < nbin() ) m_vals[ibin] = val; }
+
+  // Zero the contents.
+  void reset();
+
+  // Multiply the contents by fac.
+  void scale(double fac);
+
+  // Move the contents nshift bins up (or down if negative) keeping the axis.
+  // Contents moved out of range are added to the underflow or overflow.
+  void shiftBins(int nshift);
+
+  // Shift the axis by dx keeping the contents.
+  void shiftAxis(double dx);
+
+  // Merge each ngroup adjacent bins. If nbin is not a multiple of ngroup, the
+  // remaining bins are added to the overflow and xmax is reduced.
+  // Returns nonzero if ngroup is zero.
+  int rebin(Index ngroup);
+
+  // Create a TH1F with the same binning and contents.
+  // It is not attached to a Root directory.
+  TH1* makeTH1(Name hnam, Name httl ="") const;
+
+  // Copy contents into or from a Root histogram with the same number of bins.
+  // The axis range of the Root histogram is not changed.
+  // Return nonzero if the histogram is null or has a different bin count.
+  int copyTo(TH1* ph) const;
+  int copyFrom(const TH1* ph);
+
+private:
+
+  double m_xmin = 0.0;
+  double m_xmax = 0.0;
+  double m_dx = 0.0;
+  FloatVector m_vals;
+  float m_under = 0.0;
+  float m_over = 0.0;
+  double m_entries = 0.0;
+
+};
+
+#endif
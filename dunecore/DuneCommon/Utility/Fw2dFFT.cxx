@@ -1,9 +1,17 @@
 // Fw2dFFT.cxx
 #include "Fw2dFFT.h"
+#include "FwWisdom.h"
+#include "FftFastSize.h"
+#include "dunecore/DuneInterface/Data/TraceRecorder.h"
 #include <iostream>
 #include <sstream>
 #include <vector>
 #include <iomanip>
+#include <algorithm>
+#include <mutex>
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 #include "TVirtualFFT.h"
 #include "TComplex.h"
 
@@ -15,21 +23,33 @@ using std::vector;
 using std::setw;
 using std::fixed;
 
+namespace {
+
+// Number of columns in each block of the split column transforms.
+constexpr Fw2dFFT::Index splitColumnBlock = 16;
+
+}  // end unnamed namespace
+
 //**********************************************************************
 // Class methods.
 //**********************************************************************
 
-Fw2dFFT::Fw2dFFT(Index ndatMax, Index opt)
+Fw2dFFT::Fw2dFFT(Index ndatMax, Index opt, Index nthread)
 : m_ndatMax(ndatMax),
   m_flag(opt==2 ? FFTW_PATIENT : opt==1 ? FFTW_MEASURE : FFTW_ESTIMATE),
-  m_inData(reinterpret_cast<DftFloat*>(fftw_malloc(m_ndatMax*sizeof(DftFloat)))),
-  m_outData(reinterpret_cast<Complex*>(fftw_malloc(m_ndatMax*sizeof(DftFloat)))) { }
+  m_nthread(nthread) {
+  FwWisdom::instance().load();
+}
 
 //**********************************************************************
 
 Fw2dFFT::~Fw2dFFT() {
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
   for ( auto& iplan : m_forwardPlans ) fftw_destroy_plan(iplan.second);
   for ( auto& iplan : m_backwardPlans ) fftw_destroy_plan(iplan.second);
+  for ( auto& iplan : m_inPlaceForwardPlans ) fftw_destroy_plan(iplan.second);
+  for ( auto& iplan : m_inPlaceBackwardPlans ) fftw_destroy_plan(iplan.second);
+  for ( auto& iplan : m_splitPlans ) fftw_destroy_plan(iplan.second);
   fftw_free(m_inData);
   fftw_free(m_outData);
 }
@@ -47,73 +67,167 @@ Fw2dFFT::Index Fw2dFFT::checkDataSize(const IndexArray& nsams) const {
 
 //**********************************************************************
 
+Fw2dFFT::IndexArray Fw2dFFT::transformSizes(const IndexArray& nsams) const {
+  if ( ! m_fastSize ) return nsams;
+  IndexArray nfasts = {fftFastSize(nsams[0]), fftFastSize(nsams[1])};
+  return checkDataSize(nfasts) ? nsams : nfasts;
+}
+
+//**********************************************************************
+
 bool Fw2dFFT::haveForwardPlan(const IndexArray& nsams) const {
-  return m_forwardPlans.count(nsams);
+  return m_forwardPlans.count(transformSizes(nsams));
 }
 
 //**********************************************************************
 
 bool Fw2dFFT::haveBackwardPlan(const IndexArray& nsams) const {
-  return m_backwardPlans.count(nsams);
+  return m_backwardPlans.count(transformSizes(nsams));
+}
+
+//**********************************************************************
+
+bool Fw2dFFT::haveInPlaceForwardPlan(const IndexArray& nsams) const {
+  return m_inPlaceForwardPlans.count(transformSizes(nsams));
+}
+
+//**********************************************************************
+
+bool Fw2dFFT::haveInPlaceBackwardPlan(const IndexArray& nsams) const {
+  return m_inPlaceBackwardPlans.count(transformSizes(nsams));
 }
 
 //**********************************************************************
 
 Fw2dFFT::Plan& Fw2dFFT::forwardPlan(const IndexArray& nsams) {
+  return exactForwardPlan(transformSizes(nsams));
+}
+
+//**********************************************************************
+
+Fw2dFFT::Plan& Fw2dFFT::backwardPlan(const IndexArray& nsams) {
+  return exactBackwardPlan(transformSizes(nsams));
+}
+
+//**********************************************************************
+
+Fw2dFFT::Plan& Fw2dFFT::exactForwardPlan(const IndexArray& nsams) {
   const string myname = "Fw2dFFT::forwardPlan: ";
   static Plan badplan;
   if ( checkDataSize(nsams) ) {
     cout << myname << "Data cannot be accomodated. Maximum data size is " << m_ndatMax << endl;
     return badplan;
   }
+  allocateWorkspace();
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
   if ( m_forwardPlans.count(nsams) == 0 ) {
     m_forwardPlans[nsams] = fftw_plan_dft_r2c_2d(nsams[0], nsams[1], m_inData, fftwOutData(), m_flag);
+    if ( m_flag != FFTW_ESTIMATE ) FwWisdom::instance().notePlan();
   }
   return m_forwardPlans[nsams];
 }
 
 //**********************************************************************
 
-Fw2dFFT::Plan& Fw2dFFT::backwardPlan(const IndexArray& nsams) {
+Fw2dFFT::Plan& Fw2dFFT::exactBackwardPlan(const IndexArray& nsams) {
   const string myname = "Fw2dFFT::backwardPlan: ";
   static Plan badplan;
   if ( checkDataSize(nsams) ) {
     cout << myname << "Data cannot be accomodated. Maximum data size is " << m_ndatMax << endl;
     return badplan;
   }
+  allocateWorkspace();
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
   if ( m_backwardPlans.count(nsams) == 0 ) {
     m_backwardPlans[nsams] = fftw_plan_dft_c2r_2d(nsams[0], nsams[1], fftwOutData(), m_inData, m_flag);
+    if ( m_flag != FFTW_ESTIMATE ) FwWisdom::instance().notePlan();
   }
   return m_backwardPlans[nsams];
 }
 
 //**********************************************************************
 
+Fw2dFFT::Plan Fw2dFFT::exactInPlacePlan(const IndexArray& nsams, bool forward) {
+  const string myname = "Fw2dFFT::exactInPlacePlan: ";
+  if ( checkDataSize(nsams) ) {
+    cout << myname << "Data cannot be accomodated. Maximum data size is " << m_ndatMax << endl;
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
+  PlanMap& plans = forward ? m_inPlaceForwardPlans : m_inPlaceBackwardPlans;
+  PlanMap::iterator iplan = plans.find(nsams);
+  if ( iplan != plans.end() ) return iplan->second;
+  // The plans are executed on the DFT storage which need not have the fftw_malloc
+  // alignment. Planning may overwrite the array so it is done on a scratch buffer.
+  unsigned flag = m_flag | FFTW_UNALIGNED;
+  Index ndft = DFT::dftComplexDataSize(nsams);
+  fftw_complex* pdft = reinterpret_cast<fftw_complex*>(fftw_malloc(ndft*sizeof(fftw_complex)));
+  DftFloat* pdat = reinterpret_cast<DftFloat*>(pdft);
+  Plan plan = forward ? fftw_plan_dft_r2c_2d(nsams[0], nsams[1], pdat, pdft, flag)
+                      : fftw_plan_dft_c2r_2d(nsams[0], nsams[1], pdft, pdat, flag);
+  fftw_free(pdft);
+  if ( plan == nullptr ) return plan;
+  if ( m_flag != FFTW_ESTIMATE ) FwWisdom::instance().notePlan();
+  plans.emplace(nsams, plan);
+  return plan;
+}
+
+//**********************************************************************
+
 int Fw2dFFT::
 fftForward(const Data& dat, DFT& dft, Index logLevel) {
   const string myname = "Fw2dFFT::fftForward: ";
   if ( ! dat.isValid() ) return 1;
-  auto nsams = dat.nSamples();
+  IndexArray ndats = dat.nSamples();
+  IndexArray nsams = transformSizes(ndats);
+  if ( checkDataSize(nsams) ) {
+    cout << myname << "Sample counts are too large. Maximum data size is " << m_ndatMax << endl;
+    return 2;
+  }
   dft.reset(nsams);
   if ( ! dft.isValid() ) return 2;
   if ( dft.normalization().isPower() ) {
     cout << myname << "ERROR: Power normalization is not (yet) supported." << endl;
     return 3;
   }
-  Index ndatIn = dat.size();
+  allocateWorkspace();
+  Index ndatIn = DFT::dataSize(nsams);
   Index ndatOut = DFT::dftFloatDataSize(nsams);
-  Plan& plan = forwardPlan(nsams);
   float fndat = ndatIn;
   float nfac = dft.normalization().isStandard()   ? 1.0             :
                dft.normalization().isConsistent() ? 1.0/sqrt(fndat) :
                dft.normalization().isBin()        ? 1.0/fndat       : 0.0;
-  if ( dat.copyDataOut(m_inData) ) {
-    cout << myname << "ERROR: Copy of input data failed." << endl;
-    return 4;
+  if ( nsams == ndats ) {
+    if ( dat.copyDataOut(m_inData) ) {
+      cout << myname << "ERROR: Copy of input data failed." << endl;
+      return 4;
+    }
+  } else {
+    // Copy the rows into the zero-padded array and record the padding.
+    Data::ConstView<> vin = dat.view();
+    StridedView<DftFloat, 2> vpad(m_inData, nsams);
+    for ( Index irow=0; irow<nsams[0]; ++irow ) {
+      DftFloat* prow = vpad.row(irow);
+      Index ncopy = irow < ndats[0] ? ndats[1] : 0;
+      if ( ncopy ) std::copy(vin.row(irow), vin.row(irow) + ncopy, prow);
+      std::fill(prow + ncopy, prow + nsams[1], 0.0);
+    }
+    std::lock_guard<std::mutex> lock(m_padMutex);
+    m_paddedFrom[nsams] = ndats;
+  }
+  TraceSpan span("fft", "Fw2dFFT::fftForward");
+  span.arg("nrow", nsams[0]).arg("ncol", nsams[1]).arg("nthread", m_nthread);
+  if ( m_nthread == 1 ) {
+    Plan& plan = exactForwardPlan(nsams);
+    fftw_execute(plan);
+  } else if ( executeSplitForward(nsams, m_inData, fftwOutData(), false) ) {
+    cout << myname << "ERROR: Split transform failed." << endl;
+    return 5;
   }
-  fftw_execute(plan);
   dft.reset(nsams);
-  for ( Index idat=0; idat<ndatOut; ++idat ) dft.floatData()[idat] = nfac*floatOutData()[idat];
+  DftFloat* pdft = dft.floatData();
+  const DftFloat* pout = floatOutData();
+  for ( Index idat=0; idat<ndatOut; ++idat ) pdft[idat] = nfac*pout[idat];
   return 0;
 }
 
@@ -134,7 +248,8 @@ fftBackward(const DFT& dft, Data& dat, Index logLevel) {
     cout << myname << "ERROR: Power normalization is not (yet) supported." << endl;
     return 3;
   }
-  dat.reset(nsams);
+  IndexArray ndats = croppedSizes(nsams);
+  dat.reset(ndats);
   if ( ! dat.isValid() ) {
     cout << myname << "ERROR: Unable to initialize output data container." << endl;
     return 4;
@@ -143,11 +258,277 @@ fftBackward(const DFT& dft, Data& dat, Index logLevel) {
   float nfac = dft.normalization().isStandard()   ? 1.0/fndat       :
                dft.normalization().isConsistent() ? 1.0/sqrt(fndat) :
                dft.normalization().isBin()        ? 1.0             : 0.0;
-  Plan& plan = backwardPlan(nsams);
-  for ( Index idat=0; idat<ndatOut; ++idat ) floatOutData()[idat] = nfac*dft.floatData()[idat];
-  fftw_execute(plan);
+  const DftFloat* pdft = dft.floatData();
+  DftFloat* pout = floatOutData();
+  for ( Index idat=0; idat<ndatOut; ++idat ) pout[idat] = nfac*pdft[idat];
+  TraceSpan span("fft", "Fw2dFFT::fftBackward");
+  span.arg("nrow", nsams[0]).arg("ncol", nsams[1]).arg("nthread", m_nthread);
+  if ( m_nthread == 1 ) {
+    Plan& plan = exactBackwardPlan(nsams);
+    fftw_execute(plan);
+  } else if ( executeSplitBackward(nsams, m_inData, fftwOutData(), false) ) {
+    cout << myname << "ERROR: Split transform failed." << endl;
+    return 5;
+  }
+  if ( ndats != nsams ) {
+    // Crop: pack the leading part of each row to the front of the array.
+    StridedView<DftFloat, 2> vpad(m_inData, nsams);
+    StridedView<DftFloat, 2> vout(m_inData, ndats);
+    for ( Index irow=0; irow<ndats[0]; ++irow ) {
+      std::copy(vpad.row(irow), vpad.row(irow) + ndats[1], vout.row(irow));
+    }
+  }
   dat.copyDataIn(m_inData);
   return 0;
 }
 
 //**********************************************************************
+
+int Fw2dFFT::
+fftForwardInPlace(const Data& dat, DFT& dft, Index logLevel) {
+  const string myname = "Fw2dFFT::fftForwardInPlace: ";
+  if ( ! dat.isValid() ) return 1;
+  IndexArray ndats = dat.nSamples();
+  IndexArray nsams = transformSizes(ndats);
+  if ( checkDataSize(nsams) ) {
+    cout << myname << "Sample counts are too large. Maximum data size is " << m_ndatMax << endl;
+    return 2;
+  }
+  if ( dft.normalization().isPower() ) {
+    cout << myname << "ERROR: Power normalization is not (yet) supported." << endl;
+    return 3;
+  }
+  Plan plan = m_nthread == 1 ? exactInPlacePlan(nsams, true) : nullptr;
+  if ( m_nthread == 1 && plan == nullptr ) {
+    cout << myname << "ERROR: Unable to create the in-place plan." << endl;
+    return 5;
+  }
+  dft.reset(nsams);
+  if ( ! dft.isValid() ) return 2;
+  Index ncol = nsams[1]/2 + 1;
+  float fndat = DFT::dataSize(nsams);
+  DftFloat nfac = dft.normalization().isStandard()   ? 1.0             :
+                  dft.normalization().isConsistent() ? 1.0/sqrt(fndat) :
+                  dft.normalization().isBin()        ? 1.0/fndat       : 0.0;
+  // Copy the scaled rows into the padded rows of the DFT storage. The padding
+  // (and any rows or columns added for fast sizes) is left zero by the reset.
+  Data::ConstView<> vin = dat.view();
+  StridedView<DftFloat, 2> vbuf(dft.floatData(), {{nsams[0], 2*ncol}});
+  for ( Index irow=0; irow<ndats[0]; ++irow ) {
+    const DataFloat* pin = vin.row(irow);
+    DftFloat* pbuf = vbuf.row(irow);
+    for ( Index icol=0; icol<ndats[1]; ++icol ) pbuf[icol] = nfac*pin[icol];
+  }
+  if ( nsams != ndats ) {
+    std::lock_guard<std::mutex> lock(m_padMutex);
+    m_paddedFrom[nsams] = ndats;
+  }
+  fftw_complex* pdft = reinterpret_cast<fftw_complex*>(dft.data());
+  TraceSpan span("fft", "Fw2dFFT::fftForwardInPlace");
+  span.arg("nrow", nsams[0]).arg("ncol", nsams[1]).arg("nthread", m_nthread);
+  if ( m_nthread == 1 ) {
+    fftw_execute_dft_r2c(plan, vbuf.data(), pdft);
+  } else if ( executeSplitForward(nsams, vbuf.data(), pdft, true) ) {
+    cout << myname << "ERROR: Split transform failed." << endl;
+    dft.reset(nsams);
+    return 5;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int Fw2dFFT::
+fftBackwardInPlace(DFT& dft, Data& dat, Index logLevel) {
+  const string myname = "Fw2dFFT::fftBackwardInPlace: ";
+  if ( ! dft.isValid() ) return 1;
+  IndexArray nsams = dft.nSamples();
+  if ( checkDataSize(nsams) ) {
+    cout << myname << "Sample counts are too large. Maximum data size is " << m_ndatMax << endl;
+    return 2;
+  }
+  if ( dft.normalization().isPower() ) {
+    cout << myname << "ERROR: Power normalization is not (yet) supported." << endl;
+    return 3;
+  }
+  IndexArray ndats = croppedSizes(nsams);
+  dat.reset(ndats);
+  if ( ! dat.isValid() ) {
+    cout << myname << "ERROR: Unable to initialize output data container." << endl;
+    return 4;
+  }
+  Plan plan = m_nthread == 1 ? exactInPlacePlan(nsams, false) : nullptr;
+  if ( m_nthread == 1 && plan == nullptr ) {
+    cout << myname << "ERROR: Unable to create the in-place plan." << endl;
+    return 5;
+  }
+  Index ncol = nsams[1]/2 + 1;
+  float fndat = DFT::dataSize(nsams);
+  DataFloat nfac = dft.normalization().isStandard()   ? 1.0/fndat       :
+                   dft.normalization().isConsistent() ? 1.0/sqrt(fndat) :
+                   dft.normalization().isBin()        ? 1.0             : 0.0;
+  fftw_complex* pdft = reinterpret_cast<fftw_complex*>(dft.data());
+  StridedView<DftFloat, 2> vbuf(dft.floatData(), {{nsams[0], 2*ncol}});
+  TraceSpan span("fft", "Fw2dFFT::fftBackwardInPlace");
+  span.arg("nrow", nsams[0]).arg("ncol", nsams[1]).arg("nthread", m_nthread);
+  if ( m_nthread == 1 ) {
+    fftw_execute_dft_c2r(plan, pdft, vbuf.data());
+  } else if ( executeSplitBackward(nsams, vbuf.data(), pdft, true) ) {
+    cout << myname << "ERROR: Split transform failed." << endl;
+    dft.clear();
+    return 5;
+  }
+  // Copy the scaled leading part of each padded row.
+  Data::View<> vout = dat.view();
+  for ( Index irow=0; irow<ndats[0]; ++irow ) {
+    const DftFloat* pbuf = vbuf.row(irow);
+    DataFloat* pout = vout.row(irow);
+    for ( Index icol=0; icol<ndats[1]; ++icol ) pout[icol] = nfac*pbuf[icol];
+  }
+  dft.clear();
+  return 0;
+}
+
+//**********************************************************************
+
+void Fw2dFFT::allocateWorkspace() {
+  if ( m_inData != nullptr ) return;
+  m_inData = reinterpret_cast<DftFloat*>(fftw_malloc(m_ndatMax*sizeof(DftFloat)));
+  m_outData = reinterpret_cast<Complex*>(fftw_malloc(m_ndatMax*sizeof(DftFloat)));
+}
+
+//**********************************************************************
+
+Fw2dFFT::IndexArray Fw2dFFT::croppedSizes(const IndexArray& nsams) const {
+  if ( ! m_fastSize ) return nsams;
+  std::lock_guard<std::mutex> lock(m_padMutex);
+  auto ipad = m_paddedFrom.find(nsams);
+  return ipad == m_paddedFrom.end() ? nsams : ipad->second;
+}
+
+//**********************************************************************
+
+Fw2dFFT::Plan Fw2dFFT::splitPlan(SplitKind kind, Index nlen, Index nbatch, Index ncol) {
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
+  SplitPlanKey key = {Index(kind), nlen, nbatch};
+  SplitPlanMap::iterator iplan = m_splitPlans.find(key);
+  if ( iplan != m_splitPlans.end() ) return iplan->second;
+  // The plans are executed on rows and columns at arbitrary offsets.
+  unsigned flag = m_flag | FFTW_UNALIGNED;
+  int n = nlen;
+  Plan plan = nullptr;
+  if ( kind == RowForwardInPlace || kind == RowBackwardInPlace ) {
+    // In-place transforms of rows padded to ncol complex terms.
+    Index ndft = ncol*nbatch;
+    fftw_complex* pdft = reinterpret_cast<fftw_complex*>(fftw_malloc(ndft*sizeof(fftw_complex)));
+    double* pdat = reinterpret_cast<double*>(pdft);
+    if ( kind == RowForwardInPlace ) {
+      plan = fftw_plan_many_dft_r2c(1, &n, nbatch, pdat, nullptr, 1, 2*ncol,
+                                    pdft, nullptr, 1, ncol, flag);
+    } else {
+      plan = fftw_plan_many_dft_c2r(1, &n, nbatch, pdft, nullptr, 1, ncol,
+                                    pdat, nullptr, 1, 2*ncol, flag);
+    }
+    fftw_free(pdft);
+  } else if ( kind == RowForward || kind == RowBackward ) {
+    Index ndat = nlen*nbatch;
+    Index ndft = ncol*nbatch;
+    double* pdat = reinterpret_cast<double*>(fftw_malloc(ndat*sizeof(double)));
+    fftw_complex* pdft = reinterpret_cast<fftw_complex*>(fftw_malloc(ndft*sizeof(fftw_complex)));
+    if ( kind == RowForward ) {
+      plan = fftw_plan_many_dft_r2c(1, &n, nbatch, pdat, nullptr, 1, nlen,
+                                    pdft, nullptr, 1, ncol, flag);
+    } else {
+      plan = fftw_plan_many_dft_c2r(1, &n, nbatch, pdft, nullptr, 1, ncol,
+                                    pdat, nullptr, 1, nlen, flag);
+    }
+    fftw_free(pdat);
+    fftw_free(pdft);
+  } else {
+    // In-place transforms of nbatch adjacent columns in rows ncol terms apart.
+    Index ndft = nlen*ncol;
+    fftw_complex* pdft = reinterpret_cast<fftw_complex*>(fftw_malloc(ndft*sizeof(fftw_complex)));
+    int sign = kind == ColumnForward ? FFTW_FORWARD : FFTW_BACKWARD;
+    plan = fftw_plan_many_dft(1, &n, nbatch, pdft, nullptr, ncol, 1,
+                              pdft, nullptr, ncol, 1, sign, flag);
+    fftw_free(pdft);
+  }
+  if ( plan == nullptr ) return plan;
+  if ( m_flag != FFTW_ESTIMATE ) FwWisdom::instance().notePlan();
+  m_splitPlans.emplace(key, plan);
+  return plan;
+}
+
+//**********************************************************************
+
+int Fw2dFFT::
+executeSplitForward(const IndexArray& nsams, DftFloat* pdat, fftw_complex* pdft, bool inPlace) {
+  Index nrow = nsams[0];
+  Index nlen = nsams[1];
+  Index ncol = nlen/2 + 1;
+  Index ndatRow = inPlace ? 2*ncol : nlen;
+  Plan rowPlan = splitPlan(inPlace ? RowForwardInPlace : RowForward, nlen, 1, ncol);
+  if ( rowPlan == nullptr ) return 1;
+  Index ncolRem = ncol%splitColumnBlock;
+  Plan colPlan = splitPlan(ColumnForward, nrow, splitColumnBlock, ncol);
+  Plan remPlan = ncolRem ? splitPlan(ColumnForward, nrow, ncolRem, ncol) : nullptr;
+  if ( colPlan == nullptr || (ncolRem && remPlan == nullptr) ) return 2;
+  Index nblk = (ncol + splitColumnBlock - 1)/splitColumnBlock;
+  auto run = [&]() {
+    tbb::parallel_for(tbb::blocked_range<Index>(0, nrow),
+                      [&](const tbb::blocked_range<Index>& rows) {
+      for ( Index irow=rows.begin(); irow<rows.end(); ++irow ) {
+        fftw_execute_dft_r2c(rowPlan, pdat + irow*ndatRow, pdft + irow*ncol);
+      }
+    });
+    tbb::parallel_for(tbb::blocked_range<Index>(0, nblk),
+                      [&](const tbb::blocked_range<Index>& blks) {
+      for ( Index iblk=blks.begin(); iblk<blks.end(); ++iblk ) {
+        Index icol = iblk*splitColumnBlock;
+        Plan plan = icol + splitColumnBlock <= ncol ? colPlan : remPlan;
+        fftw_execute_dft(plan, pdft + icol, pdft + icol);
+      }
+    });
+  };
+  if ( m_nthread == 0 ) run();
+  else tbb::task_arena(m_nthread).execute(run);
+  return 0;
+}
+
+//**********************************************************************
+
+int Fw2dFFT::
+executeSplitBackward(const IndexArray& nsams, DftFloat* pdat, fftw_complex* pdft, bool inPlace) {
+  Index nrow = nsams[0];
+  Index nlen = nsams[1];
+  Index ncol = nlen/2 + 1;
+  Index ndatRow = inPlace ? 2*ncol : nlen;
+  Plan rowPlan = splitPlan(inPlace ? RowBackwardInPlace : RowBackward, nlen, 1, ncol);
+  if ( rowPlan == nullptr ) return 1;
+  Index ncolRem = ncol%splitColumnBlock;
+  Plan colPlan = splitPlan(ColumnBackward, nrow, splitColumnBlock, ncol);
+  Plan remPlan = ncolRem ? splitPlan(ColumnBackward, nrow, ncolRem, ncol) : nullptr;
+  if ( colPlan == nullptr || (ncolRem && remPlan == nullptr) ) return 2;
+  Index nblk = (ncol + splitColumnBlock - 1)/splitColumnBlock;
+  auto run = [&]() {
+    tbb::parallel_for(tbb::blocked_range<Index>(0, nblk),
+                      [&](const tbb::blocked_range<Index>& blks) {
+      for ( Index iblk=blks.begin(); iblk<blks.end(); ++iblk ) {
+        Index icol = iblk*splitColumnBlock;
+        Plan plan = icol + splitColumnBlock <= ncol ? colPlan : remPlan;
+        fftw_execute_dft(plan, pdft + icol, pdft + icol);
+      }
+    });
+    tbb::parallel_for(tbb::blocked_range<Index>(0, nrow),
+                      [&](const tbb::blocked_range<Index>& rows) {
+      for ( Index irow=rows.begin(); irow<rows.end(); ++irow ) {
+        fftw_execute_dft_c2r(rowPlan, pdft + irow*ncol, pdat + irow*ndatRow);
+      }
+    });
+  };
+  if ( m_nthread == 0 ) run();
+  else tbb::task_arena(m_nthread).execute(run);
+  return 0;
+}
+
+//**********************************************************************
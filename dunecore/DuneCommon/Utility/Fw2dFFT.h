@@ -10,8 +10,30 @@
 // These may be created in advance by calling fowardPlan or backwardPlan or are created
 // in the first call to perform an FFT with that set of dimentsions.
 //
-// Space to hold the transformation data is allocated in the constructor. Use
-// checkDataSize to check if the space is sufficient for given data dimensions.
+// Space to hold the transformation data is allocated in the first out-of-place
+// transform or plan. Use checkDataSize to check if the space is sufficient for given
+// data dimensions.
+//
+// The in-place transforms fftForwardInPlace and fftBackwardInPlace instead use the
+// storage of the DFT object as the FFTW in-place buffer: row i of the real data is
+// held in the first n1 of the 2*(n1/2 + 1) values starting at
+//   dft.floatData() + 2*i*(n1/2 + 1)
+// and is transformed there into the DFT layout. The workspace is then not allocated
+// and each transform makes one copy of the data (with the float-double conversion)
+// rather than three. The backward transform overwrites the DFT.
+//
+// FFTW wisdom is loaded from and saved to the file configured in FwWisdom.
+//
+// The transforms may be multithreaded by constructing with nthread != 1. The 2D
+// transform is then split into 1D transforms of the rows and of blocks of columns
+// that are run in parallel with TBB. The thread count 0 means the concurrency of the
+// current TBB arena, i.e. that set by art for the job. The split transforms give the
+// same results as the single 2D plans within rounding.
+//
+// With setFastSize(true), each dimension is zero-padded to the next length
+// 2^a 3^b 5^c 7^d (see FftFastSize.h) if the padded data fits. The DFT then has the
+// padded dimensions. The original dimensions are remembered for each padded size and
+// the backward transform crops its output to those.
 //
 // The real data is held in a vector of floats. The DFT is a vector of complex values
 // of the same length and so has a factor of two redundancy. The DFT data is returned
@@ -26,6 +48,8 @@
 #include "dunecore/DuneInterface/Data/Real2dData.h"
 #include "dunecore/DuneInterface/Data/FftwReal2dDftData.h"
 #include <map>
+#include <array>
+#include <mutex>
 
 class Fw2dFFT {
 
@@ -40,13 +64,28 @@ public:
   using Complex = DFT::Complex;
   using Plan = fftw_plan;
   using PlanMap = std::map<IndexArray, Plan>;
+  using SplitPlanKey = std::array<Index, 3>;    // kind, length, batch size
+  using SplitPlanMap = std::map<SplitPlanKey, Plan>;
+  using PaddingMap = std::map<IndexArray, IndexArray>;
   typedef double FftwComplex[2];
 
   // Ctor from maximum data size and optimization.
   // For n1xn2 data, ndat must be at least as big as n1*n2 and 2*n1*(n2/2+1)
   // opt = 0-2 (FFTW_ESTIMATE, FFTW_PLAN, FFTW_PATIENT)
   //       Larger numbers take longer to build plans but are faster for each transform.
-  Fw2dFFT(Index ndatMax, Index opt);
+  // nthread = 1 for single-threaded 2D plans, 0 for the TBB concurrency, >1 for at
+  //           most that many threads.
+  Fw2dFFT(Index ndatMax, Index opt, Index nthread =1);
+
+  // Return the thread count passed to the ctor.
+  Index nthread() const { return m_nthread; }
+
+  // Enable or disable padding to fast transform sizes.
+  void setFastSize(bool val) { m_fastSize = val; }
+  bool fastSize() const { return m_fastSize; }
+
+  // Return the transform dimensions used for data dimensions nsams.
+  IndexArray transformSizes(const IndexArray& nsams) const;
 
   // Dtor. Frees the data caches and destroys the plans.
   ~Fw2dFFT();
@@ -62,7 +101,7 @@ public:
   bool haveForwardPlan(const IndexArray& nsams) const;
   bool haveBackwardPlan(const IndexArray& nsams) const;
 
-  // Return the plan for a data size.
+  // Return the plan for a data size, i.e. for transformSizes(nsams).
   // The plan is created if not already existing.
   Plan& forwardPlan(const IndexArray& nsams);
   Plan& backwardPlan(const IndexArray& nsams);
@@ -79,20 +118,68 @@ public:
   // Returns 0 for success.
   int fftBackward(const DFT& dft, Data& dat, Index logLevel =0);
 
+  // In-place forward transform: the DFT is computed in the storage of dft.
+  // Returns 0 for success.
+  int fftForwardInPlace(const Data& dat, DFT& dft, Index logLevel =0);
+
+  // In-place inverse transform: the DFT storage is overwritten with the real data
+  // which is then copied to dat. The DFT is cleared.
+  // Returns 0 for success.
+  int fftBackwardInPlace(DFT& dft, Data& dat, Index logLevel =0);
+
+  // Return if we have an in-place plan for given data sizes.
+  bool haveInPlaceForwardPlan(const IndexArray& nsams) const;
+  bool haveInPlaceBackwardPlan(const IndexArray& nsams) const;
+
   // Return the DFT data as FFTW complex.
-  FftwComplex* fftwOutData() { return reinterpret_cast<FftwComplex*>(m_outData); }
+  FftwComplex* fftwOutData() { allocateWorkspace(); return reinterpret_cast<FftwComplex*>(m_outData); }
 
   // Return the DFT data as floating point: real0, imag0, real1, ...
-  DftFloat* floatOutData() { return reinterpret_cast<DftFloat*>(m_outData); }
+  DftFloat* floatOutData() { allocateWorkspace(); return reinterpret_cast<DftFloat*>(m_outData); }
 
 private:
 
+  // Allocate the out-of-place workspace if not already done.
+  void allocateWorkspace();
+
+  // Return the plan for exactly dimensions nsams.
+  Plan& exactForwardPlan(const IndexArray& nsams);
+  Plan& exactBackwardPlan(const IndexArray& nsams);
+
+  // Return the in-place plan for exactly dimensions nsams. Null if the data
+  // cannot be accommodated.
+  Plan exactInPlacePlan(const IndexArray& nsams, bool forward);
+
+  // Return the original dimensions for transform dimensions nsams.
+  IndexArray croppedSizes(const IndexArray& nsams) const;
+
+  // Kinds of 1D plans used for the split transforms.
+  enum SplitKind { RowForward, RowBackward, ColumnForward, ColumnBackward,
+                   RowForwardInPlace, RowBackwardInPlace };
+
+  // Return the 1D plan of kind for nbatch transforms of length nlen in an array
+  // with rows of ncol complex terms. The plan is created if not already existing.
+  Plan splitPlan(SplitKind kind, Index nlen, Index nbatch, Index ncol);
+
+  // Split transforms between real data pdat and DFT pdft. If inPlace is true,
+  // pdat is pdft with padded rows.
+  // Returns 0 for success.
+  int executeSplitForward(const IndexArray& nsams, DftFloat* pdat, fftw_complex* pdft, bool inPlace);
+  int executeSplitBackward(const IndexArray& nsams, DftFloat* pdat, fftw_complex* pdft, bool inPlace);
+
   Index m_ndatMax;
   Index m_flag;
-  DftFloat* m_inData;
-  Complex* m_outData;
+  Index m_nthread;
+  DftFloat* m_inData = nullptr;
+  Complex* m_outData = nullptr;
   PlanMap m_forwardPlans;
   PlanMap m_backwardPlans;
+  PlanMap m_inPlaceForwardPlans;
+  PlanMap m_inPlaceBackwardPlans;
+  SplitPlanMap m_splitPlans;
+  bool m_fastSize = false;
+  mutable std::mutex m_padMutex;
+  PaddingMap m_paddedFrom;   // original dimensions for each padded size
 
 };
 
@@ -1,9 +1,14 @@
 // FwFFT.cxx
 #include "FwFFT.h"
+#include "FwWisdom.h"
+#include "FftFastSize.h"
+#include "dunecore/DuneInterface/Data/TraceRecorder.h"
 #include <iostream>
 #include <sstream>
 #include <vector>
 #include <iomanip>
+#include <algorithm>
+#include <mutex>
 #include "TVirtualFFT.h"
 #include "TComplex.h"
 
@@ -15,83 +20,317 @@ using std::vector;
 using std::setw;
 using std::fixed;
 
+//**********************************************************************
+// Workspace methods.
+//**********************************************************************
+
+template<typename F>
+FwFFTEngine<F>::Workspace::Workspace(Index nsamMax, Index nbatch)
+: m_nsamMax(nsamMax),
+  m_nbatch(nbatch > 0 ? nbatch : 1),
+  m_inData((Float*) Traits::malloc(m_nbatch*m_nsamMax*sizeof(Float))),
+  m_outData((Complex*) Traits::malloc(m_nbatch*m_nsamMax*sizeof(Complex))) { }
+
+//**********************************************************************
+
+template<typename F>
+FwFFTEngine<F>::Workspace::~Workspace() {
+  Traits::free(m_inData);
+  Traits::free(m_outData);
+}
+
 //**********************************************************************
 // Class methods.
 //**********************************************************************
 
-FwFFT::FwFFT(Index nsamMax, Index opt)
+template<typename F>
+FwFFTEngine<F>::FwFFTEngine(Index nsamMax, Index opt)
 : m_nsamMax(nsamMax),
   m_flag(opt==2 ? FFTW_PATIENT : opt==1 ? FFTW_MEASURE : FFTW_ESTIMATE),
-  m_inData((Float*) fftw_malloc(m_nsamMax*sizeof(Float))),
-  m_outData((Complex*) fftw_malloc(m_nsamMax*sizeof(Complex))) { }
+  m_planWork(nsamMax),
+  m_work(nsamMax) {
+  FwWisdom::instance().load();
+}
 
 //**********************************************************************
 
-FwFFT::~FwFFT() {
-  for ( auto& iplan : m_forwardPlans ) fftw_destroy_plan(iplan.second);
-  for ( auto& iplan : m_backwardPlans ) fftw_destroy_plan(iplan.second);
-  fftw_free(m_inData);
-  fftw_free(m_outData);
+template<typename F>
+FwFFTEngine<F>::~FwFFTEngine() {
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
+  for ( auto& iplan : m_forwardPlans ) Traits::destroy(iplan.second);
+  for ( auto& iplan : m_backwardPlans ) Traits::destroy(iplan.second);
+  for ( auto& iplan : m_forwardBatchPlans ) Traits::destroy(iplan.second);
+  for ( auto& iplan : m_backwardBatchPlans ) Traits::destroy(iplan.second);
 }
 
 //**********************************************************************
 
-FwFFT::Plan& FwFFT::forwardPlan(Index nsam) {
+template<typename F>
+typename FwFFTEngine<F>::Index FwFFTEngine<F>::transformSize(Index nsam) const {
+  if ( ! m_fastSize ) return nsam;
+  Index nfast = fftFastSize(nsam);
+  return nfast <= m_nsamMax ? nfast : nsam;
+}
+
+//**********************************************************************
+
+template<typename F>
+typename FwFFTEngine<F>::Plan& FwFFTEngine<F>::forwardPlan(Index nsam) {
+  return exactForwardPlan(transformSize(nsam));
+}
+
+//**********************************************************************
+
+template<typename F>
+typename FwFFTEngine<F>::Plan& FwFFTEngine<F>::backwardPlan(Index nsam) {
+  return exactBackwardPlan(transformSize(nsam));
+}
+
+//**********************************************************************
+
+template<typename F>
+typename FwFFTEngine<F>::Plan& FwFFTEngine<F>::exactForwardPlan(Index nsam) {
   const string myname = "FwFFT::forwardPlan";
   static Plan badplan;
   if ( nsam > m_nsamMax ) {
     cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
     return badplan;
   }
-  if ( m_forwardPlans.count(nsam) == 0 ) {
-    m_forwardPlans[nsam] = fftw_plan_dft_r2c_1d(nsam, m_inData, m_outData, m_flag);
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
+  typename PlanMap::iterator iplan = m_forwardPlans.find(nsam);
+  if ( iplan == m_forwardPlans.end() ) {
+    Plan plan = Traits::planR2c(nsam, m_planWork.inData(), m_planWork.outData(), m_flag);
+    iplan = m_forwardPlans.emplace(nsam, plan).first;
+    if ( m_flag != FFTW_ESTIMATE ) FwWisdom::instance().notePlan();
   }
-  return m_forwardPlans[nsam];
+  return iplan->second;
 }
 
 //**********************************************************************
 
-FwFFT::Plan& FwFFT::backwardPlan(Index nsam) {
+template<typename F>
+typename FwFFTEngine<F>::Plan& FwFFTEngine<F>::exactBackwardPlan(Index nsam) {
   const string myname = "FwFFT::backwardPlan";
   static Plan badplan;
   if ( nsam > m_nsamMax ) {
     cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
     return badplan;
   }
-  if ( m_backwardPlans.count(nsam) == 0 ) {
-    m_backwardPlans[nsam] = fftw_plan_dft_c2r_1d(nsam, m_outData, m_inData, m_flag);
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
+  typename PlanMap::iterator iplan = m_backwardPlans.find(nsam);
+  if ( iplan == m_backwardPlans.end() ) {
+    Plan plan = Traits::planC2r(nsam, m_planWork.outData(), m_planWork.inData(), m_flag);
+    iplan = m_backwardPlans.emplace(nsam, plan).first;
+    if ( m_flag != FFTW_ESTIMATE ) FwWisdom::instance().notePlan();
   }
-  return m_backwardPlans[nsam];
+  return iplan->second;
 }
 
 //**********************************************************************
 
-int FwFFT::
-fftForward(Index nsam, const float* psam, DFT& dft, Index logLevel) {
-  const string myname = "FwFFT::fftForward: ";
+template<typename F>
+typename FwFFTEngine<F>::Plan& FwFFTEngine<F>::forwardBatchPlan(Index nsam, Index nbatch) {
+  const string myname = "FwFFT::forwardBatchPlan";
+  static Plan badplan;
+  if ( nsam > m_nsamMax || nsam == 0 || nbatch == 0 ) {
+    cout << myname << "Invalid sample count " << nsam << " or batch size " << nbatch << endl;
+    return badplan;
+  }
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
+  typename BatchPlanMap::iterator iplan = m_forwardBatchPlans.find({nsam, nbatch});
+  if ( iplan == m_forwardBatchPlans.end() ) {
+    // Plan on temporary buffers so the measuring planners do not touch any workspace.
+    Workspace work(nsam, nbatch);
+    int ndist = nsam/2 + 1;
+    Plan plan = Traits::planManyR2c(nsam, nbatch, work.inData(), nsam, work.outData(), ndist, m_flag);
+    iplan = m_forwardBatchPlans.emplace(std::make_pair(nsam, nbatch), plan).first;
+    if ( m_flag != FFTW_ESTIMATE ) FwWisdom::instance().notePlan();
+  }
+  return iplan->second;
+}
+
+//**********************************************************************
+
+template<typename F>
+typename FwFFTEngine<F>::Plan& FwFFTEngine<F>::backwardBatchPlan(Index nsam, Index nbatch) {
+  const string myname = "FwFFT::backwardBatchPlan";
+  static Plan badplan;
+  if ( nsam > m_nsamMax || nsam == 0 || nbatch == 0 ) {
+    cout << myname << "Invalid sample count " << nsam << " or batch size " << nbatch << endl;
+    return badplan;
+  }
+  std::lock_guard<std::mutex> lock(FwWisdom::plannerMutex());
+  typename BatchPlanMap::iterator iplan = m_backwardBatchPlans.find({nsam, nbatch});
+  if ( iplan == m_backwardBatchPlans.end() ) {
+    Workspace work(nsam, nbatch);
+    int ndist = nsam/2 + 1;
+    Plan plan = Traits::planManyC2r(nsam, nbatch, work.outData(), ndist, work.inData(), nsam, m_flag);
+    iplan = m_backwardBatchPlans.emplace(std::make_pair(nsam, nbatch), plan).first;
+    if ( m_flag != FFTW_ESTIMATE ) FwWisdom::instance().notePlan();
+  }
+  return iplan->second;
+}
+
+//**********************************************************************
+
+template<typename F>
+bool FwFFTEngine<F>::isAligned(Float* preal, Complex* pcomplex) {
+  return Traits::alignmentOf(preal) == Traits::alignmentOf(m_planWork.inData()) &&
+         Traits::alignmentOf(reinterpret_cast<F*>(pcomplex)) ==
+         Traits::alignmentOf(reinterpret_cast<F*>(m_planWork.outData()));
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::executeForwardBatch(Index nsam, Index nbatch, Float* pin, Complex* pout) {
+  const string myname = "FwFFT::executeForwardBatch: ";
+  if ( nsam > m_nsamMax ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 2;
+  }
+  if ( ! isAligned(pin, pout) ) {
+    cout << myname << "Buffers are not aligned." << endl;
+    return 3;
+  }
+  Plan plan = forwardBatchPlan(nsam, nbatch);
+  if ( plan == nullptr ) return 1;
+  TraceSpan span("fft", "FwFFT::executeForwardBatch");
+  span.arg("nsam", nsam).arg("nbatch", nbatch);
+  Traits::executeR2c(plan, pin, pout);
+  return 0;
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::executeBackwardBatch(Index nsam, Index nbatch, Complex* pin, Float* pout) {
+  const string myname = "FwFFT::executeBackwardBatch: ";
+  if ( nsam > m_nsamMax ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 2;
+  }
+  if ( ! isAligned(pout, pin) ) {
+    cout << myname << "Buffers are not aligned." << endl;
+    return 3;
+  }
+  Plan plan = backwardBatchPlan(nsam, nbatch);
+  if ( plan == nullptr ) return 1;
+  TraceSpan span("fft", "FwFFT::executeBackwardBatch");
+  span.arg("nsam", nsam).arg("nbatch", nbatch);
+  Traits::executeC2r(plan, pin, pout);
+  return 0;
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::executeForward(Index nsam, Float* pin, Complex* pout) {
+  const string myname = "FwFFT::executeForward: ";
+  if ( nsam > m_nsamMax ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 2;
+  }
+  // New-array execution requires the alignment of the planning buffers.
+  if ( Traits::alignmentOf(pin) != Traits::alignmentOf(m_planWork.inData()) ||
+       Traits::alignmentOf(reinterpret_cast<F*>(pout)) !=
+       Traits::alignmentOf(reinterpret_cast<F*>(m_planWork.outData())) ) {
+    cout << myname << "Buffers are not aligned." << endl;
+    return 3;
+  }
+  Plan plan = exactForwardPlan(nsam);
+  if ( plan == nullptr ) return 1;
+  TraceSpan span("fft", "FwFFT::executeForward");
+  span.arg("nsam", nsam);
+  Traits::executeR2c(plan, pin, pout);
+  return 0;
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::executeBackward(Index nsam, Complex* pin, Float* pout) {
+  const string myname = "FwFFT::executeBackward: ";
   if ( nsam > m_nsamMax ) {
     cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
     return 2;
   }
-  dft.reset(nsam);
+  if ( Traits::alignmentOf(reinterpret_cast<F*>(pin)) !=
+       Traits::alignmentOf(reinterpret_cast<F*>(m_planWork.outData())) ||
+       Traits::alignmentOf(pout) != Traits::alignmentOf(m_planWork.inData()) ) {
+    cout << myname << "Buffers are not aligned." << endl;
+    return 3;
+  }
+  Plan plan = exactBackwardPlan(nsam);
+  if ( plan == nullptr ) return 1;
+  TraceSpan span("fft", "FwFFT::executeBackward");
+  span.arg("nsam", nsam);
+  Traits::executeC2r(plan, pin, pout);
+  return 0;
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftForward(Index nsam, const float* psam, DFT& dft, Workspace& work, Index logLevel) {
+  const string myname = "FwFFT::fftForward: ";
+  if ( nsam > m_nsamMax || nsam > work.size() ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 2;
+  }
+  Index ntran = paddedSize(nsam, work);
+  dft.reset(ntran);
   if ( ! dft.isValid() ) return 1;
   if ( nsam == 0 ) return 0;
-  for ( Index isam=0; isam<nsam; ++isam ) m_inData[isam] = psam[isam];
-  Plan& plan = forwardPlan(nsam);
-  fftw_execute(plan);
+  Float* inData = work.inData();
+  Complex* outData = work.outData();
+  for ( Index isam=0; isam<nsam; ++isam ) inData[isam] = psam[isam];
+  for ( Index isam=nsam; isam<ntran; ++isam ) inData[isam] = 0.0;
+  if ( executeForward(ntran, inData, outData) ) return 3;
+  fillDft(ntran, outData, dft, logLevel);
+  return 0;
+}
+
+//**********************************************************************
+
+template<typename F>
+typename FwFFTEngine<F>::Index FwFFTEngine<F>::paddedSize(Index nsam, const Workspace& work) {
+  Index ntran = transformSize(nsam);
+  if ( ntran > work.size() ) ntran = nsam;
+  if ( ntran != nsam ) {
+    std::lock_guard<std::mutex> lock(m_padMutex);
+    m_paddedFrom[ntran] = nsam;
+  }
+  return ntran;
+}
+
+//**********************************************************************
+
+template<typename F>
+typename FwFFTEngine<F>::Index FwFFTEngine<F>::croppedSize(Index ntran) const {
+  if ( ! m_fastSize ) return ntran;
+  std::lock_guard<std::mutex> lock(m_padMutex);
+  typename PaddingMap::const_iterator ipad = m_paddedFrom.find(ntran);
+  return ipad == m_paddedFrom.end() ? ntran : ipad->second;
+}
+
+//**********************************************************************
+
+template<typename F>
+void FwFFTEngine<F>::fillDft(Index nsam, const Complex* outData, DFT& dft, Index logLevel) const {
+  const string myname = "FwFFT::fftForward: ";
   double xre = 0.0;
   double xim = 0.0;
   Index namp = dft.nAmplitude();
   Index npha = dft.nPhase();
-  FloatVector amps(namp);
-  FloatVector phas(npha);
   // Loop over the compact samples.
   float nfac = 1.0;
   if ( dft.normalization().isConsistent() ) nfac = 1.0/sqrt(nsam);
   if ( dft.normalization().isBin() ) nfac = 1.0/nsam;
   for ( Index ifrq=0; ifrq<namp; ++ifrq ) {
-    xre = m_outData[ifrq][0];
-    xim = m_outData[ifrq][1];
+    xre = outData[ifrq][0];
+    xim = outData[ifrq][1];
     // For an even # samples (namp = npha + 1), the Nyquist term is real
     // and we store the sign with the amplitude.
     double xam = ifrq < npha ? sqrt(xre*xre + xim*xim) : xre;
@@ -112,20 +351,37 @@ fftForward(Index nsam, const float* psam, DFT& dft, Index logLevel) {
       cout << endl;
     }
   }
-  return 0;
 }
 
 //**********************************************************************
 
-int FwFFT::
+template<typename F>
+int FwFFTEngine<F>::
+fftForward(Index nsam, const float* psam, DFT& dft, Index logLevel) {
+  return fftForward(nsam, psam, dft, m_work, logLevel);
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftForward(const FloatVector& sams, DFT& dft, Workspace& work, Index logLevel) {
+  return fftForward(sams.size(), &sams[0], dft, work, logLevel);
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
 fftForward(const FloatVector& sams, DFT& dft, Index logLevel) {
-  return fftForward(sams.size(), &sams[0], dft, logLevel);
+  return fftForward(sams, dft, m_work, logLevel);
 }
 
 //**********************************************************************
 
-int FwFFT::
-fftInverse(const DFT& dft, FloatVector& sams, Index logLevel) {
+template<typename F>
+int FwFFTEngine<F>::
+fftInverse(const DFT& dft, FloatVector& sams, Workspace& work, Index logLevel) {
   const string myname = "FwFFT::fftInverse: ";
   if ( ! dft.isValid() ) return 1;
   Index namp = dft.nAmplitude();
@@ -134,24 +390,210 @@ fftInverse(const DFT& dft, FloatVector& sams, Index logLevel) {
   if ( namp < npha ) return 2;
   if ( namp - npha > 1 ) return 3;
   Index nsam = namp + npha - 1;
-  if ( nsam > m_nsamMax ) {
+  if ( nsam > m_nsamMax || nsam > work.size() ) {
     cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
     return 4;
   }
+  Complex* freqData = work.outData();
+  Float* samData = work.inData();
   for ( Index ifrq=0; ifrq<nsam; ++ifrq ) {
     double amp = dft.convAmplitude(ifrq);
     double pha = dft.phase(ifrq);
     double xre = amp*cos(pha);
     double xim = amp*sin(pha);
-    m_outData[ifrq][0] = xre;
-    m_outData[ifrq][1] = xim;
+    freqData[ifrq][0] = xre;
+    freqData[ifrq][1] = xim;
+  }
+  if ( executeBackward(nsam, freqData, samData) ) return 5;
+  float nfac = 1.0/nsam;
+  Index nout = croppedSize(nsam);
+  sams.resize(nout);
+  for ( Index isam=0; isam<nout; ++isam ) sams[isam] = nfac*samData[isam];
+  return 0;
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftInverse(const DFT& dft, FloatVector& sams, Index logLevel) {
+  return fftInverse(dft, sams, m_work, logLevel);
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftForward(Index nsam, const float* psam, HalfComplexDFT& dft, Workspace& work, Index logLevel) {
+  const string myname = "FwFFT::fftForward: ";
+  if ( nsam > m_nsamMax || nsam > work.size() ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 2;
+  }
+  Index ntran = paddedSize(nsam, work);
+  dft.reset(ntran);
+  if ( ! dft.isValid() ) return 1;
+  if ( nsam == 0 ) return 0;
+  Float* inData = work.inData();
+  for ( Index isam=0; isam<nsam; ++isam ) inData[isam] = psam[isam];
+  for ( Index isam=nsam; isam<ntran; ++isam ) inData[isam] = 0.0;
+  if ( executeForward(ntran, inData, reinterpret_cast<Complex*>(dft.data())) ) return 3;
+  if ( logLevel >= 3 ) {
+    for ( Index ifrq=0; ifrq<dft.nComplex(); ++ifrq ) {
+      cout << myname << setw(4) << ifrq << ": ("
+           << setw(10) << fixed << dft.data()[ifrq].real() << ", "
+           << setw(10) << fixed << dft.data()[ifrq].imag() << ")" << endl;
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftForward(const FloatVector& sams, HalfComplexDFT& dft, Index logLevel) {
+  return fftForward(sams.size(), &sams[0], dft, m_work, logLevel);
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftInverse(const HalfComplexDFT& dft, FloatVector& sams, Workspace& work, Index logLevel) {
+  const string myname = "FwFFT::fftInverse: ";
+  if ( ! dft.isValid() ) return 1;
+  Index nsam = dft.nSample();
+  if ( nsam > m_nsamMax || nsam > work.size() ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 4;
+  }
+  // The c2r transform overwrites its input, so the terms are copied to the workspace.
+  Complex* freqData = work.outData();
+  Float* samData = work.inData();
+  const F* pdft = dft.floatData();
+  for ( Index ifrq=0; ifrq<dft.nComplex(); ++ifrq ) {
+    freqData[ifrq][0] = pdft[2*ifrq];
+    freqData[ifrq][1] = pdft[2*ifrq + 1];
   }
-  Plan& plan = backwardPlan(nsam);
-  fftw_execute(plan);
+  if ( executeBackward(nsam, freqData, samData) ) return 5;
   float nfac = 1.0/nsam;
-  sams.resize(nsam);
-  for ( Index isam=0; isam<nsam; ++isam ) sams[isam] = nfac*m_inData[isam];
+  Index nout = croppedSize(nsam);
+  sams.resize(nout);
+  for ( Index isam=0; isam<nout; ++isam ) sams[isam] = nfac*samData[isam];
+  return 0;
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftInverse(const HalfComplexDFT& dft, FloatVector& sams, Index logLevel) {
+  return fftInverse(dft, sams, m_work, logLevel);
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftForwardBatch(Index nsam, const SamplePointerVector& psams, DFTVector& dfts,
+                Workspace& work, Index logLevel) {
+  const string myname = "FwFFT::fftForwardBatch: ";
+  if ( nsam > m_nsamMax || nsam > work.size() ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 2;
+  }
+  Index ncha = psams.size();
+  if ( dfts.size() != ncha ) {
+    cout << myname << "DFT count " << dfts.size() << " differs from channel count " << ncha << endl;
+    return 4;
+  }
+  Index ntran = paddedSize(nsam, work);
+  for ( DFT& dft : dfts ) {
+    dft.reset(ntran);
+    if ( ! dft.isValid() ) return 1;
+  }
+  if ( nsam == 0 ) return 0;
+  Float* inData = work.inData();
+  Complex* outData = work.outData();
+  if ( Traits::alignmentOf(inData) != Traits::alignmentOf(m_planWork.inData()) ||
+       Traits::alignmentOf(reinterpret_cast<F*>(outData)) !=
+       Traits::alignmentOf(reinterpret_cast<F*>(m_planWork.outData())) ) {
+    cout << myname << "Buffers are not aligned." << endl;
+    return 3;
+  }
+  Index ndist = ntran/2 + 1;
+  Index nbatMax = work.batchSize();
+  for ( Index icha0=0; icha0<ncha; icha0+=nbatMax ) {
+    Index nbat = std::min(nbatMax, ncha - icha0);
+    for ( Index ibat=0; ibat<nbat; ++ibat ) {
+      const float* psam = psams[icha0 + ibat];
+      Float* pin = inData + ibat*ntran;
+      for ( Index isam=0; isam<nsam; ++isam ) pin[isam] = psam[isam];
+      for ( Index isam=nsam; isam<ntran; ++isam ) pin[isam] = 0.0;
+    }
+    Plan plan = forwardBatchPlan(ntran, nbat);
+    if ( plan == nullptr ) return 3;
+    Traits::executeR2c(plan, inData, outData);
+    for ( Index ibat=0; ibat<nbat; ++ibat ) {
+      if ( logLevel >= 3 ) cout << myname << "Channel " << icha0 + ibat << endl;
+      fillDft(ntran, outData + ibat*ndist, dfts[icha0 + ibat], logLevel);
+    }
+  }
   return 0;
 }
 
 //**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+fftForwardBatch(Index nsam, const SamplePointerVector& psams, DFTVector& dfts, Index logLevel) {
+  Index nbat = std::min<Index>(psams.size(), 64);
+  Workspace work(transformSize(nsam), nbat);
+  return fftForwardBatch(nsam, psams, dfts, work, logLevel);
+}
+
+//**********************************************************************
+
+template<typename F>
+int FwFFTEngine<F>::
+convolveBatch(Index nsam, Index nrow, const Complex* pker, float* psam, Workspace& work) {
+  const string myname = "FwFFT::convolveBatch: ";
+  if ( nsam > m_nsamMax || nsam > work.size() ) {
+    cout << myname << "Sample count is too large. Maximum is " << m_nsamMax << endl;
+    return 2;
+  }
+  if ( nsam == 0 ) return 0;
+  Float* inData = work.inData();
+  Complex* outData = work.outData();
+  Index ncmp = nsam/2 + 1;
+  Index nbatMax = work.batchSize();
+  for ( Index irow0=0; irow0<nrow; irow0+=nbatMax ) {
+    Index nbat = std::min(nbatMax, nrow - irow0);
+    float* prow = psam + std::size_t(irow0)*nsam;
+    std::size_t nval = std::size_t(nbat)*nsam;
+    for ( std::size_t ival=0; ival<nval; ++ival ) inData[ival] = prow[ival];
+    int rstat = executeForwardBatch(nsam, nbat, inData, outData);
+    if ( rstat ) return rstat;
+    for ( Index ibat=0; ibat<nbat; ++ibat ) {
+      Complex* pdft = outData + ibat*ncmp;
+      for ( Index icmp=0; icmp<ncmp; ++icmp ) {
+        Float xre = pdft[icmp][0]*pker[icmp][0] - pdft[icmp][1]*pker[icmp][1];
+        Float xim = pdft[icmp][0]*pker[icmp][1] + pdft[icmp][1]*pker[icmp][0];
+        pdft[icmp][0] = xre;
+        pdft[icmp][1] = xim;
+      }
+    }
+    rstat = executeBackwardBatch(nsam, nbat, outData, inData);
+    if ( rstat ) return rstat;
+    for ( std::size_t ival=0; ival<nval; ++ival ) prow[ival] = inData[ival];
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+template class FwFFTEngine<double>;
+template class FwFFTEngine<float>;
+
+//**********************************************************************
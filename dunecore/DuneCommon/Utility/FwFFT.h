@@ -13,39 +13,133 @@
 //
 // The concrete type for the returned data is
 //   CompactRealDftData<float>
+//
+// Plans are created once for each data size, under a lock, and are executed with the
+// FFTW new-array interface on the buffers of a Workspace. The transforms that take a
+// workspace may be called from different threads on a shared FwFFT provided each
+// thread uses its own workspace. The transforms without a workspace argument use one
+// held by this object and so may not be called concurrently.
+//
+// Blocks of equal-length channels may be transformed together with fftForwardBatch.
+// These use plans from fftw_plan_many_dft_r2c with as many channels as the workspace
+// batch size and write the results directly into the caller's DFT objects.
+// The batched plans may also be executed directly on workspace buffers with
+// executeForwardBatch and executeBackwardBatch, e.g. to apply a kernel to the DFTs
+// of a block of channels without filling DFT objects.
+//
+// convolveBatch runs the whole forward transform, kernel multiply and inverse transform
+// for a block of channels in the workspace. CuFFTEngine provides the same batch calls on
+// a GPU.
+//
+// FFTW wisdom is loaded from and saved to the file configured in FwWisdom.
+//
+// The transforms are implemented in FwFFTEngine<F> for FFTW floating-point type F:
+//   FwFFT - double precision (fftw)
+//   FwFloatFFT - single precision (fftwf), which halves the buffer sizes and doubles
+//                the SIMD width at float-level precision
+// Both take float samples and return CompactRealDftData<float>.
+// The transforms may also use FftwRealDftData<F>, which holds the FFTW half-complex
+// output directly so that no conversion to amplitude and phase is made.
+//
+// With setFastSize(true), transforms of lengths with large prime factors are zero-padded
+// to the next length 2^a 3^b 5^c 7^d (see FftFastSize.h) if that fits in nsamMax. The
+// DFT then has the padded length. The original length is remembered for each padded
+// length and the inverse transform crops its output to that length.
 
 #ifndef FwFFT_H
 #define FwFFT_H
 
 #include "dunecore/DuneCommon/Utility/CompactRealDftData.h"
-#include "fftw3.h"
+#include "dunecore/DuneCommon/Utility/FftwRealDftData.h"
+#include "dunecore/DuneCommon/Utility/FftwTraits.h"
 #include <map>
+#include <mutex>
+#include <utility>
 
-class FwFFT {
+template<typename F>
+class FwFFTEngine {
 
 public:
 
+  using Traits = FftwTraits<F>;
   using Index = unsigned int;
-  using Float = double;
-  using Complex = fftw_complex;
+  using Float = F;
+  using Complex = typename Traits::Complex;
   using DFT = CompactRealDftData<float>;
+  using HalfComplexDFT = FftwRealDftData<F>;
   using FloatVector = std::vector<float>;
-  using Plan = fftw_plan;
+  using Plan = typename Traits::Plan;
   using PlanMap = std::map<Index, Plan>;
+  using BatchPlanMap = std::map<std::pair<Index, Index>, Plan>;
+  using PaddingMap = std::map<Index, Index>;
+  using DFTVector = std::vector<DFT>;
+  using SamplePointerVector = std::vector<const float*>;
+
+  // Aligned input and output buffers for the transforms.
+  // Holds nbatch transforms of up to nsamMax samples each.
+  class Workspace {
+  public:
+    explicit Workspace(Index nsamMax, Index nbatch =1);
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+    ~Workspace();
+    Index size() const { return m_nsamMax; }
+    Index batchSize() const { return m_nbatch; }
+    Float* inData() { return m_inData; }
+    Complex* outData() { return m_outData; }
+  private:
+    Index m_nsamMax;
+    Index m_nbatch;
+    Float* m_inData;
+    Complex* m_outData;
+  };
 
   // Ctor from maximum data size and optimization.
   // opt = 0-2 (FFTW_ESTIMATE, FFTW_PLAN, FFTW_PATIENT)
   //       Larger nubers take longer to build plans but are faster for each transform.
-  FwFFT(Index nsamMax, Index opt);
+  FwFFTEngine(Index nsamMax, Index opt);
 
   // Dtor. Frees the data caches and destroys the plans.
-  ~FwFFT();
+  ~FwFFTEngine();
 
-  // Return the plan for a data size.
-  // The plan is cretaed if not already existing.
+  // Return the maximum data size.
+  Index nsamMax() const { return m_nsamMax; }
+
+  // Enable or disable padding to fast transform lengths.
+  void setFastSize(bool val) { m_fastSize = val; }
+  bool fastSize() const { return m_fastSize; }
+
+  // Return the transform length used for nsam samples.
+  Index transformSize(Index nsam) const;
+
+  // Return the plan for a data size, i.e. for transformSize(nsam).
+  // The plan is created if not already existing.
   Plan& forwardPlan(Index nsam);
   Plan& backwardPlan(Index nsam);
 
+  // Return the plan for nbatch forward transforms of nsam samples.
+  // Input transforms are nsam apart and output nsam/2 + 1 apart.
+  // The plan is created if not already existing.
+  Plan& forwardBatchPlan(Index nsam, Index nbatch);
+
+  // Return the plan for nbatch backward transforms of nsam samples.
+  // Input transforms are nsam/2 + 1 apart and output nsam apart.
+  // The plan is created if not already existing.
+  Plan& backwardBatchPlan(Index nsam, Index nbatch);
+
+  // Execute the plan for exactly nsam samples on caller-provided buffers.
+  // The buffers must have the FFTW SIMD alignment, e.g. be allocated with fftw_malloc
+  // or taken from a Workspace.
+  // The backward transform overwrites the input.
+  // Returns 0 for success.
+  int executeForward(Index nsam, Float* pin, Complex* pout);
+  int executeBackward(Index nsam, Complex* pin, Float* pout);
+
+  // Same for nbatch transforms laid out as in the batch plans, e.g. in
+  // a Workspace with batch size at least nbatch.
+  int executeForwardBatch(Index nsam, Index nbatch, Float* pin, Complex* pout);
+  int executeBackwardBatch(Index nsam, Index nbatch, Complex* pin, Float* pout);
+
   // Return the plan for a given size.
   // If not already existing, the plan is created.
   // Forward transform: real data (ntick starting at psam[0] --> complex freqs).
@@ -53,24 +147,88 @@ public:
   //   psam - Address of the first element in the data array
   //   dft - the DFT
   //   logLevel - 0=silent, 1=init, 2=each event, >2=more
+  //   work - buffers used for the transform
+  int fftForward(Index nsam, const float* psam, DFT& dft, Workspace& work, Index logLevel =0);
   int fftForward(Index nsam, const float* psam, DFT& dft, Index logLevel =0);
 
   // Same for a full sample vector sams.
+  int fftForward(const FloatVector& sams, DFT& dft, Workspace& work, Index logLevel =0);
   int fftForward(const FloatVector& sams, DFT& dft, Index logLevel =0);
 
   // Inverse transform: complex freqs mags, phases --> real data sams
   // The real and imag freq component are also recorded in xres, xims
+  int fftInverse(const DFT& dft, FloatVector& sams, Workspace& work, Index logLevel =0);
   int fftInverse(const DFT& dft, FloatVector& sams, Index logLevel =0);
 
+  // Same with the DFT in the FFTW layout. The transform output is written
+  // directly into dft.
+  int fftForward(Index nsam, const float* psam, HalfComplexDFT& dft, Workspace& work, Index logLevel =0);
+  int fftForward(const FloatVector& sams, HalfComplexDFT& dft, Index logLevel =0);
+  int fftInverse(const HalfComplexDFT& dft, FloatVector& sams, Workspace& work, Index logLevel =0);
+  int fftInverse(const HalfComplexDFT& dft, FloatVector& sams, Index logLevel =0);
+
+  // Batched forward transform of channels with nsam samples each.
+  //   psams - address of the first sample for each channel
+  //   dfts - DFT for each channel. Must have the same size as psams.
+  //   work - buffers used for the transform. The channels are transformed in blocks
+  //          of work.batchSize().
+  // Without the workspace argument, a workspace holding up to 64 channels is created.
+  int fftForwardBatch(Index nsam, const SamplePointerVector& psams, DFTVector& dfts,
+                      Workspace& work, Index logLevel =0);
+  int fftForwardBatch(Index nsam, const SamplePointerVector& psams, DFTVector& dfts,
+                      Index logLevel =0);
+
+  // Multiply the DFTs of nrow channels of nsam samples by the kernel pker (nsam/2 + 1
+  // terms) and transform back, in place in psam, where the channels are nsam samples
+  // apart. The channels are transformed in blocks of work.batchSize() with the batch
+  // plans. The inverse is not normalized, i.e. a unit kernel multiplies the samples by nsam.
+  int convolveBatch(Index nsam, Index nrow, const Complex* pker, float* psam, Workspace& work);
+
 private:
 
+  // Return the plan for exactly nsam samples.
+  Plan& exactForwardPlan(Index nsam);
+  Plan& exactBackwardPlan(Index nsam);
+
+  // Return the transform length for nsam samples in work and record the padding.
+  Index paddedSize(Index nsam, const Workspace& work);
+
+  // Return the original length for a transform of ntran samples.
+  Index croppedSize(Index ntran) const;
+
+  // Return if buffers have the alignment of the planning buffers.
+  bool isAligned(Float* preal, Complex* pcomplex);
+
+  // Fill dft from the nsam/2 + 1 complex terms in pout.
+  void fillDft(Index nsam, const Complex* pout, DFT& dft, Index logLevel) const;
+
   Index m_nsamMax;
   Index m_flag;
-  double* m_inData;
-  Complex* m_outData;
+  Workspace m_planWork;   // buffers used to create the plans
+  Workspace m_work;       // buffers for the transforms without a workspace argument
   PlanMap m_forwardPlans;
   PlanMap m_backwardPlans;
+  BatchPlanMap m_forwardBatchPlans;
+  BatchPlanMap m_backwardBatchPlans;
+  bool m_fastSize = false;
+  mutable std::mutex m_padMutex;
+  PaddingMap m_paddedFrom;   // original length for each padded length
+
+};
 
+extern template class FwFFTEngine<double>;
+extern template class FwFFTEngine<float>;
+
+// Double-precision transforms.
+class FwFFT : public FwFFTEngine<double> {
+public:
+  using FwFFTEngine<double>::FwFFTEngine;
+};
+
+// Single-precision transforms.
+class FwFloatFFT : public FwFFTEngine<float> {
+public:
+  using FwFFTEngine<float>::FwFFTEngine;
 };
 
 #endif
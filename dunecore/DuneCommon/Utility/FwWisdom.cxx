@@ -0,0 +1,128 @@
+// FwWisdom.cxx
+
+#include "FwWisdom.h"
+#include "FftwTraits.h"
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+namespace {
+
+// Import wisdom for precision F if the file exists.
+// Returns 0 for success or no file, 1 for failure.
+template<typename F>
+int importWisdom(const string& fname) {
+  struct stat st;
+  if ( stat(fname.c_str(), &st) != 0 ) return 0;
+  return FftwTraits<F>::importWisdom(fname.c_str()) == 0;
+}
+
+// Export wisdom for precision F through a temporary file.
+// Returns 0 for success.
+template<typename F>
+int exportWisdom(const string& fname) {
+  string tmpname = fname + ".tmp." + std::to_string(getpid());
+  if ( FftwTraits<F>::exportWisdom(tmpname.c_str()) == 0 ||
+       std::rename(tmpname.c_str(), fname.c_str()) != 0 ) {
+    std::remove(tmpname.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+FwWisdom& FwWisdom::instance() {
+  // Create the mutex first so it outlives the instance.
+  plannerMutex();
+  static FwWisdom obj;
+  return obj;
+}
+
+//**********************************************************************
+
+std::mutex& FwWisdom::plannerMutex() {
+  static std::mutex mtx;
+  return mtx;
+}
+
+//**********************************************************************
+
+FwWisdom::~FwWisdom() {
+  if ( m_unsaved ) save();
+}
+
+//**********************************************************************
+
+void FwWisdom::setPath(const string& path) {
+  std::lock_guard<std::mutex> lock(plannerMutex());
+  m_pathSet = true;
+  m_path = path;
+}
+
+//**********************************************************************
+
+string FwWisdom::path() const {
+  std::lock_guard<std::mutex> lock(plannerMutex());
+  return pathLocked();
+}
+
+//**********************************************************************
+
+string FwWisdom::pathLocked() const {
+  if ( m_pathSet ) return m_path;
+  const char* penv = std::getenv(envName());
+  return penv == nullptr ? "" : penv;
+}
+
+//**********************************************************************
+
+int FwWisdom::load() {
+  const string myname = "FwWisdom::load: ";
+  std::lock_guard<std::mutex> lock(plannerMutex());
+  string fname = pathLocked();
+  if ( fname.empty() ) return 0;
+  if ( m_loaded && fname == m_loadedPath ) return 0;
+  m_loaded = true;
+  m_loadedPath = fname;
+  int rstat = 0;
+  if ( importWisdom<double>(fname) ) {
+    cout << myname << "WARNING: Unable to import FFTW wisdom from " << fname << endl;
+    rstat = 1;
+  }
+  if ( importWisdom<float>(floatPath(fname)) ) {
+    cout << myname << "WARNING: Unable to import FFTW wisdom from " << floatPath(fname) << endl;
+    rstat = 1;
+  }
+  return rstat;
+}
+
+//**********************************************************************
+
+int FwWisdom::save() {
+  const string myname = "FwWisdom::save: ";
+  std::lock_guard<std::mutex> lock(plannerMutex());
+  string fname = pathLocked();
+  if ( fname.empty() ) return 0;
+  int rstat = 0;
+  if ( exportWisdom<double>(fname) ) {
+    cout << myname << "WARNING: Unable to export FFTW wisdom to " << fname << endl;
+    rstat = 1;
+  }
+  if ( exportWisdom<float>(floatPath(fname)) ) {
+    cout << myname << "WARNING: Unable to export FFTW wisdom to " << floatPath(fname) << endl;
+    rstat = 1;
+  }
+  if ( rstat == 0 ) m_unsaved = false;
+  return rstat;
+}
+
+//**********************************************************************
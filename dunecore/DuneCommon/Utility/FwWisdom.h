@@ -0,0 +1,86 @@
+// FwWisdom.h
+//
+// Process-wide store of FFTW wisdom shared by all FwFFT and Fw2dFFT instances.
+//
+// FFTW keeps the wisdom accumulated by its planners in global state, so plans
+// measured by any instance are available to the others. This class adds loading
+// the wisdom from and saving it to a file so that the FFTW_MEASURE and
+// FFTW_PATIENT planning costs are paid once rather than in every process.
+//
+// The file path is taken from setPath or, if that has not been called, from the
+// environment variable DUNE_FFTW_WISDOM. An empty path disables both load and save.
+// FFTW keeps separate wisdom for each precision. The double-precision wisdom is held
+// in the file at the path and the single-precision (fftwf) wisdom in path + ".float".
+// The FwFFT and Fw2dFFT ctors call load(), which imports each path at most once.
+// If new plans have been created, the wisdom is saved when the process exits or
+// when save() is called.
+//
+// The FFTW planner is not thread safe. Planning and wisdom access are guarded
+// by plannerMutex().
+
+#ifndef FwWisdom_H
+#define FwWisdom_H
+
+#include <string>
+#include <mutex>
+#include <atomic>
+
+class FwWisdom {
+
+public:
+
+  // Return the process-wide instance.
+  static FwWisdom& instance();
+
+  // Return the lock for the FFTW planner.
+  static std::mutex& plannerMutex();
+
+  // Name of the environment variable holding the default path.
+  static const char* envName() { return "DUNE_FFTW_WISDOM"; }
+
+  // Dtor. Calls save() if there are unsaved plans.
+  ~FwWisdom();
+
+  // Set the wisdom file path. This overrides the environment variable.
+  void setPath(const std::string& path);
+
+  // Return the current wisdom file path.
+  std::string path() const;
+
+  // Return the single-precision wisdom file path for a path.
+  static std::string floatPath(const std::string& path) { return path + ".float"; }
+
+  // Import the wisdom from path(), if not already done for that path.
+  // Returns 0 if the wisdom has been imported or there is nothing to import,
+  // 1 if the file exists but cannot be read.
+  int load();
+
+  // Export the wisdom to path(). The file is written to a temporary name and
+  // renamed so that concurrent jobs do not see a partial file.
+  // Returns 0 for success or if the path is empty.
+  int save();
+
+  // Record that a plan has been created. Called with plannerMutex() held.
+  void notePlan() { m_unsaved = true; }
+
+  // Return if there are plans not yet saved.
+  bool hasUnsavedPlans() const { return m_unsaved; }
+
+private:
+
+  FwWisdom() = default;
+  FwWisdom(const FwWisdom&) = delete;
+  FwWisdom& operator=(const FwWisdom&) = delete;
+
+  // Return the path. Caller must hold plannerMutex().
+  std::string pathLocked() const;
+
+  bool m_pathSet = false;
+  std::string m_path;
+  std::string m_loadedPath;
+  bool m_loaded = false;
+  std::atomic<bool> m_unsaved{false};
+
+};
+
+#endif
@@ -8,6 +8,10 @@
 #include "TList.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 
 using std::cout;
 using std::endl;
@@ -108,3 +112,100 @@ int GausRmsFitter::fit(TH1* ph, double mean0) const {
 }
 
 //**********************************************************************
+
+int GausRmsFitter::evaluate(const float* pdat, Index ndat, double mean0, Estimate& est) const {
+  Name myname = "GausRmsFitter::evaluate: ";
+  est = Estimate();
+  if ( pdat == nullptr || ndat == 0 ) {
+    est.status = 101;
+    return est.status;
+  }
+  // Full range.
+  if ( ! (m_sigma0 > 0.0 && m_nsigma > 0.0) ) {
+    double sum = 0.0;
+    double sumsq = 0.0;
+    for ( Index idat=0; idat<ndat; ++idat ) {
+      double x = pdat[idat] - mean0;
+      sum += x;
+      sumsq += x*x;
+    }
+    double dmean = sum/ndat;
+    est.count = ndat;
+    if ( m_sigma0 > 0.0 ) {
+      est.mean = mean0;
+      est.sigma = m_sigma0;
+    } else {
+      est.mean = mean0 + dmean;
+      double var = sumsq/ndat - dmean*dmean;
+      est.sigma = var > 0.0 ? sqrt(var) : 0.0;
+    }
+    return 0;
+  }
+  // Sort the samples and build cumulative sums relative to mean0 so the sums
+  // over any window are differences.
+  std::vector<float> vals(pdat, pdat + ndat);
+  std::sort(vals.begin(), vals.end());
+  std::vector<double> sums(ndat + 1, 0.0);
+  std::vector<double> sumsqs(ndat + 1, 0.0);
+  for ( Index idat=0; idat<ndat; ++idat ) {
+    double x = vals[idat] - mean0;
+    sums[idat+1] = sums[idat] + x;
+    sumsqs[idat+1] = sumsqs[idat] + x*x;
+  }
+  double mean = mean0;
+  double sigma = 0.0;
+  double sigmaOld = m_sigma0;
+  const Index maxtry = 100;
+  Index itry = 0;
+  Index count = 0;
+  for ( ; itry<maxtry; ++itry ) {
+    double dx = m_nsigma*sigmaOld;
+    Index idat1 = std::lower_bound(vals.begin(), vals.end(), mean - dx) - vals.begin();
+    Index idat2 = std::upper_bound(vals.begin(), vals.end(), mean + dx) - vals.begin();
+    count = idat2 > idat1 ? idat2 - idat1 : 0;
+    if ( count == 0 ) {
+      sigma = 0.0;
+      break;
+    }
+    double dmean = (sums[idat2] - sums[idat1])/count;
+    double var = (sumsqs[idat2] - sumsqs[idat1])/count - dmean*dmean;
+    sigma = var > 0.0 ? sqrt(var) : 0.0;
+    mean = mean0 + dmean;
+    if ( m_LogLevel >= 3 ) {
+      cout << myname << setw(5) << itry << ": (" << mean - dx << ", " << mean + dx << "): "
+           << mean << ", " << sigma << endl;
+    }
+    if ( sigma < 1.001*sigmaOld ) break;
+    sigmaOld = sigma;
+  }
+  if ( itry >= maxtry && m_LogLevel >= 1 ) cout << myname << "WARNING: too many iterations." << endl;
+  est.mean = mean;
+  est.sigma = sigma;
+  est.count = count;
+  est.niter = itry + (itry < maxtry);
+  est.status = count ? 0 : 102;
+  return est.status;
+}
+
+//**********************************************************************
+
+GausRmsFitter::Index
+GausRmsFitter::evaluateMany(const std::vector<const FloatVector*>& pdats,
+                            const std::vector<double>& mean0s, EstimateVector& ests) const {
+  Index ncha = pdats.size();
+  ests.assign(ncha, Estimate());
+  tbb::parallel_for(tbb::blocked_range<Index>(0, ncha),
+                    [&](const tbb::blocked_range<Index>& ichas) {
+    for ( Index icha=ichas.begin(); icha!=ichas.end(); ++icha ) {
+      const FloatVector* pdat = pdats[icha];
+      double mean0 = icha < mean0s.size() ? mean0s[icha] : 0.0;
+      if ( pdat == nullptr ) ests[icha].status = 101;
+      else evaluate(*pdat, mean0, ests[icha]);
+    }
+  });
+  Index nfail = 0;
+  for ( const Estimate& est : ests ) if ( est.status ) ++nfail;
+  return nfail;
+}
+
+//**********************************************************************
@@ -28,8 +28,17 @@
 // are used to construct the function.
 //
 // Any other configuration results in a fit error.
+//
+// The mean and sigma may also be evaluated directly from samples, e.g. the
+// ADC samples for a channel, with evaluate. The same sigma0, nsigma and mean0
+// semantics are used with the window applied to the sample values instead of
+// histogram bins. The samples are sorted once and cumulative sums are formed
+// so each iteration is a pair of binary searches. No histogram or function is
+// created and the method is const so evaluateMany can process many channels
+// in parallel.
 
 #include <string>
+#include <vector>
 class TH1;
 
 class GausRmsFitter {
@@ -38,6 +47,17 @@ public:
 
   using Name = std::string;
   using Index = unsigned int;
+  using FloatVector = std::vector<float>;
+
+  // Result of a histogram-free evaluation.
+  struct Estimate {
+    double mean = 0.0;
+    double sigma = 0.0;
+    Index count = 0;      // Number of samples in the final window
+    Index niter = 0;      // Number of iterations
+    int status = 0;
+  };
+  using EstimateVector = std::vector<Estimate>;
 
   // Ctor for fit of full histogram.
   GausRmsFitter(Name fnam);
@@ -51,6 +71,19 @@ public:
   // This function has the assigned mean, sigma and fit range and the fitted height.
   int fit(TH1* ph, double mean0) const;
 
+  // Evaluate the mean and sigma for ndat samples pdat with starting mean mean0.
+  // Returns 0 for success, 101 if there are no samples and 102 if the window is empty.
+  int evaluate(const float* pdat, Index ndat, double mean0, Estimate& est) const;
+  int evaluate(const FloatVector& dats, double mean0, Estimate& est) const {
+    return evaluate(dats.data(), dats.size(), mean0, est);
+  }
+
+  // Evaluate for many sample vectors in parallel. If mean0s is shorter than
+  // pdats, starting mean zero is used for the remaining channels.
+  // Returns the number of failed evaluations.
+  Index evaluateMany(const std::vector<const FloatVector*>& pdats,
+                     const std::vector<double>& mean0s, EstimateVector& ests) const;
+
   // Set the log level.
   void setLogLevel(Index lev) { m_LogLevel = lev; }
 
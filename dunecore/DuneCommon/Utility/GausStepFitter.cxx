@@ -7,10 +7,52 @@
 #include "TH1.h"
 #include "TList.h"
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 
 using std::cout;
 using std::endl;
 
+namespace {
+
+// Solve the 3x3 system a*x = b in place. Returns false if singular.
+bool solve3(double a[3][3], double b[3]) {
+  for ( int icol=0; icol<3; ++icol ) {
+    int ipiv = icol;
+    for ( int irow=icol+1; irow<3; ++irow ) {
+      if ( fabs(a[irow][icol]) > fabs(a[ipiv][icol]) ) ipiv = irow;
+    }
+    if ( a[ipiv][icol] == 0.0 ) return false;
+    if ( ipiv != icol ) {
+      for ( int jcol=0; jcol<3; ++jcol ) std::swap(a[icol][jcol], a[ipiv][jcol]);
+      std::swap(b[icol], b[ipiv]);
+    }
+    for ( int irow=icol+1; irow<3; ++irow ) {
+      double fac = a[irow][icol]/a[icol][icol];
+      for ( int jcol=icol; jcol<3; ++jcol ) a[irow][jcol] -= fac*a[icol][jcol];
+      b[irow] -= fac*b[icol];
+    }
+  }
+  for ( int irow=2; irow>=0; --irow ) {
+    for ( int jcol=irow+1; jcol<3; ++jcol ) b[irow] -= a[irow][jcol]*b[jcol];
+    b[irow] /= a[irow][irow];
+  }
+  return true;
+}
+
+// Sum of squared residuals for parameters (height, mean, sigma).
+double gausChi2(const float* pys, unsigned int ny, double x0, double dx, const double* pars) {
+  double chi2 = 0.0;
+  for ( unsigned int iy=0; iy<ny; ++iy ) {
+    double rat = (x0 + iy*dx - pars[1])/pars[2];
+    double res = pys[iy] - pars[0]*exp(-0.5*rat*rat);
+    chi2 += res*res;
+  }
+  return chi2;
+}
+
+}  // end unnamed namespace
+
 //**********************************************************************
 
 GausStepFitter::GausStepFitter(double pos, double sigma, double height, Name fnam, Name fopt)
@@ -62,3 +104,168 @@ int GausStepFitter::fit(TH1* ph) const {
 }
 
 //**********************************************************************
+
+int GausStepFitter::estimate(const float* pys, Index ny, double x0, double dx, Result& res) const {
+  res = Result();
+  if ( pys == nullptr || ny < 3 || dx <= 0.0 ) {
+    res.status = 2;
+    return res.status;
+  }
+  // Work with positive values so negative heights may be estimated.
+  double sgn = m_height < 0.0 ? -1.0 : 1.0;
+  Index iymax = 0;
+  for ( Index iy=1; iy<ny; ++iy ) if ( sgn*pys[iy] > sgn*pys[iymax] ) iymax = iy;
+  double ymax = sgn*pys[iymax];
+  if ( ymax <= 0.0 ) {
+    res.status = 3;
+    return res.status;
+  }
+  // Weighted fit of a parabola to log(y) for the contiguous values above a
+  // fraction of the peak. The weight y^2 reduces the bias from the tails.
+  double ythr = 0.1*ymax;
+  Index iy1 = iymax;
+  while ( iy1 > 0 && sgn*pys[iy1-1] > ythr ) --iy1;
+  Index iy2 = iymax + 1;
+  while ( iy2 < ny && sgn*pys[iy2] > ythr ) ++iy2;
+  double xc = x0 + iymax*dx;
+  double sums[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+  double sumly[3] = {0.0, 0.0, 0.0};
+  for ( Index iy=iy1; iy<iy2; ++iy ) {
+    double y = sgn*pys[iy];
+    double u = (x0 + iy*dx - xc)/dx;
+    double w = y*y;
+    double ly = log(y);
+    double up = w;
+    for ( int ipow=0; ipow<5; ++ipow ) {
+      sums[ipow] += up;
+      if ( ipow < 3 ) sumly[ipow] += up*ly;
+      up *= u;
+    }
+  }
+  double a[3][3] = {{sums[0], sums[1], sums[2]},
+                    {sums[1], sums[2], sums[3]},
+                    {sums[2], sums[3], sums[4]}};
+  double cs[3] = {sumly[0], sumly[1], sumly[2]};
+  if ( iy2 - iy1 >= 3 && solve3(a, cs) && cs[2] < 0.0 ) {
+    double umean = -0.5*cs[1]/cs[2];
+    res.mean = xc + umean*dx;
+    res.sigma = dx*sqrt(-0.5/cs[2]);
+    res.height = sgn*exp(cs[0] - 0.25*cs[1]*cs[1]/cs[2]);
+  } else {
+    // Too narrow for the parabola: use the peak and configured width.
+    res.mean = xc;
+    res.sigma = m_sigma > 0.0 ? m_sigma : dx;
+    res.height = sgn*ymax;
+  }
+  res.chi2 = gausChi2(pys, ny, x0, dx, &res.height);
+  return 0;
+}
+
+//**********************************************************************
+
+int GausStepFitter::fitArray(const float* pys, Index ny, double x0, double dx, Result& res) const {
+  Name myname = "GausStepFitter::fitArray: ";
+  Result est;
+  if ( estimate(pys, ny, x0, dx, est) == 2 ) {
+    res = est;
+    return res.status;
+  }
+  bool haveEstimate = est.status == 0;
+  double sigma = m_sigma;
+  double height = m_height;
+  double sigfac = 2.0;
+  const Index maxiter = 200;
+  Index niter = 0;
+  for ( int ifit=0; ifit<5; ++ifit ) {
+    double sigmax = 1.1*sigfac*sigma;
+    double sigmin = 0.9*sigma/sigfac;
+    double hmin = 0.0;
+    double hmax = 1.e10;
+    if ( height > 0.0 ) {
+      hmin = 0.1*height;
+      hmax = 2.0*height;
+    } else if ( height < 0.0 ) {
+      hmin = 2.0*height;
+      hmax = 0.1*height;
+    }
+    double pmin[3] = {hmin, -1.e30, sigmin};
+    double pmax[3] = {hmax,  1.e30, sigmax};
+    double pars[3] = {m_height != 0.0 ? m_height : 1.0, m_pos, sigma};
+    if ( haveEstimate ) {
+      pars[0] = est.height;
+      pars[1] = est.mean;
+      pars[2] = est.sigma;
+    }
+    for ( int ipar=0; ipar<3; ++ipar ) pars[ipar] = std::min(pmax[ipar], std::max(pmin[ipar], pars[ipar]));
+    if ( m_LogLevel >= 1 ) cout << myname << "  Doing constrained fit " << ifit
+                                << " with pos=" << pars[1] << ", sigma=" << pars[2]
+                                << " (" << sigmin << ", " << sigmax << ")" << endl;
+    // Levenberg-Marquardt minimization.
+    double chi2 = gausChi2(pys, ny, x0, dx, pars);
+    double lambda = 1.e-3;
+    for ( Index iter=0; iter<maxiter; ++iter, ++niter ) {
+      double jtj[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+      double jtr[3] = {0.0, 0.0, 0.0};
+      for ( Index iy=0; iy<ny; ++iy ) {
+        double dxm = x0 + iy*dx - pars[1];
+        double rat = dxm/pars[2];
+        double g = exp(-0.5*rat*rat);
+        double der[3] = {g, pars[0]*g*rat/pars[2], pars[0]*g*rat*rat/pars[2]};
+        double r = pys[iy] - pars[0]*g;
+        for ( int irow=0; irow<3; ++irow ) {
+          jtr[irow] += der[irow]*r;
+          for ( int jcol=0; jcol<3; ++jcol ) jtj[irow][jcol] += der[irow]*der[jcol];
+        }
+      }
+      bool improved = false;
+      double chi2New = chi2;
+      while ( lambda < 1.e10 ) {
+        double a[3][3];
+        double del[3];
+        for ( int irow=0; irow<3; ++irow ) {
+          for ( int jcol=0; jcol<3; ++jcol ) a[irow][jcol] = jtj[irow][jcol];
+          a[irow][irow] *= 1.0 + lambda;
+          del[irow] = jtr[irow];
+        }
+        if ( solve3(a, del) ) {
+          double parsNew[3];
+          for ( int ipar=0; ipar<3; ++ipar ) {
+            parsNew[ipar] = std::min(pmax[ipar], std::max(pmin[ipar], pars[ipar] + del[ipar]));
+          }
+          chi2New = gausChi2(pys, ny, x0, dx, parsNew);
+          if ( chi2New <= chi2 ) {
+            for ( int ipar=0; ipar<3; ++ipar ) pars[ipar] = parsNew[ipar];
+            lambda = std::max(1.e-10, 0.1*lambda);
+            improved = true;
+            break;
+          }
+        }
+        lambda *= 10.0;
+      }
+      if ( ! improved ) break;
+      bool done = chi2 - chi2New <= 1.e-10*chi2;
+      chi2 = chi2New;
+      if ( done ) break;
+    }
+    bool atHiLimit = pars[2] > 0.999*sigmax;
+    bool atLoLimit = pars[2] < 1.001*sigmin;
+    if ( m_LogLevel >= 1 ) cout << myname << "  Fit sigma=" << pars[2] << ", chi2=" << chi2 << endl;
+    res.height = pars[0];
+    res.mean = pars[1];
+    res.sigma = pars[2];
+    res.chi2 = chi2;
+    res.niter = niter;
+    if ( !atHiLimit && !atLoLimit ) {
+      if ( m_LogLevel >= 1 ) cout << myname << "Fit suceeded." << endl;
+      res.status = 0;
+      return 0;
+    }
+    if ( atLoLimit ) sigma /= sigfac;
+    else             sigma *= sigfac;
+  }
+  if ( m_LogLevel >= 1 ) cout << myname << "Fit failed." << endl;
+  res.status = 1;
+  return 1;
+}
+
+//**********************************************************************
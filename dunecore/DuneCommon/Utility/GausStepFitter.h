@@ -8,8 +8,23 @@
 //
 // Utility that fits a histogram with a Gaussian stating from specified
 // position, width and fit window.
+//
+// The fit is repeated with the sigma limits stepped up or down by a factor
+// of two until the fitted sigma is not at a limit.
+//
+// The same fit may be done without ROOT on an array of uniformly spaced
+// values, e.g. histogram bin contents, with fitArray. An analytic starting
+// estimate (parabola fit to the log of the values near the peak) is refined
+// with a Levenberg-Marquardt minimization of the unweighted chi-square, which
+// is what the default fit option WW does for the histogram. The same height
+// limits and sigma stepping are applied.
+//
+// The fitter holds only its configuration and all methods are const, so the
+// array methods may be called concurrently for different channels. The
+// histogram fit uses ROOT and is not safe to call concurrently.
 
 #include <string>
+#include <vector>
 class TH1;
 
 class GausStepFitter {
@@ -18,6 +33,17 @@ public:
 
   using Name = std::string;
   using Index = unsigned int;
+  using FloatVector = std::vector<float>;
+
+  // Result of an array fit.
+  struct Result {
+    double height = 0.0;
+    double mean = 0.0;
+    double sigma = 0.0;
+    double chi2 = 0.0;    // Sum of squared residuals
+    Index niter = 0;      // Number of minimization iterations
+    int status = 0;
+  };
 
   // Ctor.
   //   pos - starting position
@@ -31,6 +57,22 @@ public:
   // If successful, a gaus function is attahed to the histogram.
   int fit(TH1* ph) const;
 
+  // Analytic estimate of the Gaussian parameters for ny values pys with
+  // the first at x0 and spacing dx.
+  // Returns 0 for success.
+  int estimate(const float* pys, Index ny, double x0, double dx, Result& res) const;
+
+  // Fit ny values pys with the first at x0 and spacing dx.
+  // Returns 0 for success, 1 if the sigma is at a limit for all tries and
+  // 2 if there are too few values.
+  int fitArray(const float* pys, Index ny, double x0, double dx, Result& res) const;
+  int fitArray(const FloatVector& ys, double x0, double dx, Result& res) const {
+    return fitArray(ys.data(), ys.size(), x0, dx, res);
+  }
+
+  // Set the log level.
+  void setLogLevel(Index lev) { m_LogLevel = lev; }
+
 private:
 
   double m_pos;
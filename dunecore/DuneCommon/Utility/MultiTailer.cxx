@@ -0,0 +1,173 @@
+// MultiTailer.cxx
+
+#include "MultiTailer.h"
+#include <cmath>
+
+using Index = MultiTailer::Index;
+using FloatVector = MultiTailer::FloatVector;
+
+//**********************************************************************
+
+float MultiTailer::cancellingAlpha(float decayTime) {
+  if ( decayTime <= 0.0 ) return 0.0;
+  return 1.0/exp(-1.0/decayTime) - 1.0;
+}
+
+//**********************************************************************
+
+int MultiTailer::addComponent(float decayTime, float alpha, float tail0) {
+  if ( decayTime <= 0.0 ) return 1;
+  m_decayTime.push_back(decayTime);
+  m_beta.push_back(exp(-1.0/decayTime));
+  m_alpha.push_back(alpha);
+  m_tail0.push_back(tail0);
+  return 0;
+}
+
+//**********************************************************************
+
+void MultiTailer::clear() {
+  m_decayTime.clear();
+  m_beta.clear();
+  m_alpha.clear();
+  m_tail0.clear();
+}
+
+//**********************************************************************
+
+int MultiTailer::removeTails(float* psam, Index nsam, float ped) const {
+  return process(psam, nsam, ped, true);
+}
+
+//**********************************************************************
+
+int MultiTailer::addTails(float* psam, Index nsam, float ped) const {
+  return process(psam, nsam, ped, false);
+}
+
+//**********************************************************************
+
+int MultiTailer::removeTails(float* const* pchas, Index ncha, Index nsam, const float* ppeds) const {
+  return processBlock(pchas, ncha, nsam, ppeds, true);
+}
+
+//**********************************************************************
+
+int MultiTailer::addTails(float* const* pchas, Index ncha, Index nsam, const float* ppeds) const {
+  return processBlock(pchas, ncha, nsam, ppeds, false);
+}
+
+//**********************************************************************
+
+int MultiTailer::removeTails(const FloatVectorPtrVector& chas, const FloatVector* ppeds) const {
+  return processVectors(chas, ppeds, true);
+}
+
+//**********************************************************************
+
+int MultiTailer::addTails(const FloatVectorPtrVector& chas, const FloatVector* ppeds) const {
+  return processVectors(chas, ppeds, false);
+}
+
+//**********************************************************************
+
+int MultiTailer::process(float* psam, Index nsam, float ped, bool remove) const {
+  if ( nsam == 0 ) return 0;
+  if ( psam == nullptr ) return 1;
+  Index ncom = size();
+  std::vector<double> tails(m_tail0.begin(), m_tail0.end());
+  double s = 0.0;
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    double t = 0.0;
+    for ( Index icom=0; icom<ncom; ++icom ) {
+      if ( isam > 0 ) tails[icom] = m_beta[icom]*tails[icom] - m_alpha[icom]*s;
+      t += tails[icom];
+    }
+    if ( remove ) {
+      s = psam[isam] - t - ped;
+      psam[isam] = s;
+    } else {
+      s = psam[isam];
+      psam[isam] = s + t + ped;
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int MultiTailer::processBlock(float* const* pchas, Index ncha, Index nsam,
+                              const float* ppeds, bool remove) const {
+  if ( ncha == 0 || nsam == 0 ) return 0;
+  if ( pchas == nullptr ) return 1;
+  for ( Index icha=0; icha<ncha; ++icha ) if ( pchas[icha] == nullptr ) return 1;
+  Index ncom = size();
+  // Tail state for each component and channel: tails[icom*ncha + icha].
+  std::vector<double> tails(ncom*ncha);
+  for ( Index icom=0; icom<ncom; ++icom ) {
+    for ( Index icha=0; icha<ncha; ++icha ) tails[icom*ncha + icha] = m_tail0[icom];
+  }
+  std::vector<double> sigs(ncha, 0.0);
+  std::vector<double> tsum(ncha, 0.0);
+  std::vector<double> peds(ncha, 0.0);
+  if ( ppeds != nullptr ) peds.assign(ppeds, ppeds + ncha);
+  double* pt = tails.data();
+  double* ps = sigs.data();
+  double* pts = tsum.data();
+  const double* pp = peds.data();
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    for ( Index icha=0; icha<ncha; ++icha ) pts[icha] = 0.0;
+    for ( Index icom=0; icom<ncom; ++icom ) {
+      double* ptc = pt + icom*ncha;
+      if ( isam > 0 ) {
+        const double beta = m_beta[icom];
+        const double alpha = m_alpha[icom];
+        for ( Index icha=0; icha<ncha; ++icha ) ptc[icha] = beta*ptc[icha] - alpha*ps[icha];
+      }
+      for ( Index icha=0; icha<ncha; ++icha ) pts[icha] += ptc[icha];
+    }
+    if ( remove ) {
+      for ( Index icha=0; icha<ncha; ++icha ) {
+        float& sam = pchas[icha][isam];
+        ps[icha] = sam - pts[icha] - pp[icha];
+        sam = ps[icha];
+      }
+    } else {
+      for ( Index icha=0; icha<ncha; ++icha ) {
+        float& sam = pchas[icha][isam];
+        ps[icha] = sam;
+        sam = ps[icha] + pts[icha] + pp[icha];
+      }
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int MultiTailer::processVectors(const FloatVectorPtrVector& chas, const FloatVector* ppeds,
+                                bool remove) const {
+  Index ncha = chas.size();
+  if ( ncha == 0 ) return 0;
+  if ( ppeds != nullptr && ppeds->size() < ncha ) return 2;
+  bool sameSize = true;
+  for ( FloatVector* pcha : chas ) {
+    if ( pcha == nullptr ) return 1;
+    if ( pcha->size() != chas.front()->size() ) sameSize = false;
+  }
+  if ( sameSize ) {
+    std::vector<float*> pchas(ncha);
+    for ( Index icha=0; icha<ncha; ++icha ) pchas[icha] = chas[icha]->data();
+    return processBlock(pchas.data(), ncha, chas.front()->size(),
+                        ppeds == nullptr ? nullptr : ppeds->data(), remove);
+  }
+  int rstat = 0;
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    FloatVector& sams = *chas[icha];
+    float ped = ppeds == nullptr ? 0.0 : (*ppeds)[icha];
+    if ( process(sams.data(), sams.size(), ped, remove) ) rstat = 1;
+  }
+  return rstat;
+}
+
+//**********************************************************************
@@ -0,0 +1,95 @@
+// MultiTailer.h
+//
+// Class that adds or removes a sum of exponential tails from sampled
+// data in place. It generalizes SampleTailer to N tail components and to
+// blocks of channels.
+//
+// The data is a sum of signal, tails and pedestal:
+//   d[i] = s[i] + SUM_k t_k[i] + p
+// and each tail decays with its own contribution from the signal:
+//   t_k[i] = beta_k t_k[i-1] - alpha_k s[i-1]
+//   t_k[0] = tail0_k
+// With one component this is the SampleTailer recurrence.
+//
+// The recurrence is serial in time so the block methods step all channels
+// of a block through each tick together. The inner loops run over channels
+// and may be vectorised by the compiler.
+//
+// The samples are overwritten, e.g. AdcChannelData::samples, and no copies
+// of the data, signal or tails are kept.
+//
+// Usage:
+//   MultiTailer mtl;
+//   mtl.addComponent(20.0, MultiTailer::cancellingAlpha(20.0));
+//   mtl.addComponent(500.0, 0.01);
+//   mtl.removeTails(acd.samples, acd.pedestal);
+
+#ifndef MultiTailer_H
+#define MultiTailer_H
+
+#include <vector>
+
+class MultiTailer {
+
+public:
+
+  using Index = unsigned int;
+  using FloatVector = std::vector<float>;
+  using FloatVectorPtrVector = std::vector<FloatVector*>;
+
+  // Alpha for which the tail precisely cancels the signal.
+  static float cancellingAlpha(float decayTime);
+
+  // Add a tail component with decay time (ticks), alpha and starting value.
+  // Returns nonzero and does not add the component if the decay time is not positive.
+  int addComponent(float decayTime, float alpha, float tail0 =0.0);
+
+  // Remove all components.
+  void clear();
+
+  // Getters.
+  Index size() const { return m_beta.size(); }
+  float decayTime(Index icom) const { return icom < size() ? m_decayTime[icom] : 0.0; }
+  float beta(Index icom) const { return icom < size() ? m_beta[icom] : 0.0; }
+  float alpha(Index icom) const { return icom < size() ? m_alpha[icom] : 0.0; }
+  float tail0(Index icom) const { return icom < size() ? m_tail0[icom] : 0.0; }
+
+  // Replace data with signal for one channel, i.e. remove the tails and pedestal.
+  // Returns nonzero for error.
+  int removeTails(float* psam, Index nsam, float ped =0.0) const;
+  int removeTails(FloatVector& sams, float ped =0.0) const {
+    return removeTails(sams.data(), sams.size(), ped);
+  }
+
+  // Replace signal with data for one channel, i.e. add the tails and pedestal.
+  int addTails(float* psam, Index nsam, float ped =0.0) const;
+  int addTails(FloatVector& sams, float ped =0.0) const {
+    return addTails(sams.data(), sams.size(), ped);
+  }
+
+  // Block versions for ncha channels, each with nsam samples at pchas[icha],
+  // and pedestals ppeds[icha] (zero if ppeds is null).
+  int removeTails(float* const* pchas, Index ncha, Index nsam, const float* ppeds =nullptr) const;
+  int addTails(float* const* pchas, Index ncha, Index nsam, const float* ppeds =nullptr) const;
+
+  // Block versions for vectors. Channels are processed together if
+  // they have the same length and one-by-one otherwise.
+  int removeTails(const FloatVectorPtrVector& chas, const FloatVector* ppeds =nullptr) const;
+  int addTails(const FloatVectorPtrVector& chas, const FloatVector* ppeds =nullptr) const;
+
+private:
+
+  // Shared implementation. If remove is true, data is replaced with
+  // signal and otherwise signal with data.
+  int process(float* psam, Index nsam, float ped, bool remove) const;
+  int processBlock(float* const* pchas, Index ncha, Index nsam, const float* ppeds, bool remove) const;
+  int processVectors(const FloatVectorPtrVector& chas, const FloatVector* ppeds, bool remove) const;
+
+  FloatVector m_decayTime;
+  FloatVector m_beta;
+  FloatVector m_alpha;
+  FloatVector m_tail0;
+
+};
+
+#endif
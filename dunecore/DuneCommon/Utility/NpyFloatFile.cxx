@@ -0,0 +1,148 @@
+// NpyFloatFile.cxx
+
+#include "NpyFloatFile.h"
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::string;
+
+//**********************************************************************
+
+NpyFloatFile::NpyFloatFile(Name fname) : m_fname(fname) {
+  int fd = open(m_fname.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    setError(2, "Unable to open file " + m_fname);
+    return;
+  }
+  struct stat st;
+  if ( fstat(fd, &st) != 0 || st.st_size <= 0 ) {
+    close(fd);
+    setError(3, "Unable to size file " + m_fname);
+    return;
+  }
+  m_mapSize = st.st_size;
+  void* pmap = mmap(nullptr, m_mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( pmap == MAP_FAILED ) {
+    m_mapSize = 0;
+    setError(4, "Unable to map file " + m_fname);
+    return;
+  }
+  m_pmap = pmap;
+  m_status = parseHeader();
+}
+
+//**********************************************************************
+
+NpyFloatFile::~NpyFloatFile() {
+  if ( m_pmap != nullptr ) munmap(m_pmap, m_mapSize);
+}
+
+//**********************************************************************
+
+int NpyFloatFile::read(FloatVector& vals) const {
+  if ( m_status ) return m_status;
+  vals.resize(m_size);
+  if ( m_valueSize == sizeof(float) ) {
+    std::memcpy(vals.data(), m_pdata, m_size*sizeof(float));
+  } else {
+    for ( Index ival=0; ival<m_size; ++ival ) {
+      double val;
+      std::memcpy(&val, m_pdata + ival*sizeof(double), sizeof(double));
+      vals[ival] = val;
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int NpyFloatFile::parseHeader() {
+  const char* pbeg = static_cast<const char*>(m_pmap);
+  // Magic string and version.
+  const char magic[] = "\x93NUMPY";
+  const std::size_t nmagic = 6;
+  if ( m_mapSize < nmagic + 4 || std::memcmp(pbeg, magic, nmagic) != 0 ) {
+    return setError(11, "File is not in npy format: " + m_fname);
+  }
+  unsigned char major = pbeg[6];
+  std::size_t hlen = 0;
+  std::size_t hpos = 0;
+  const unsigned char* plen = reinterpret_cast<const unsigned char*>(pbeg + 8);
+  if ( major == 1 ) {
+    hlen = plen[0] | (plen[1] << 8);
+    hpos = 10;
+  } else if ( major == 2 || major == 3 ) {
+    if ( m_mapSize < 12 ) return setError(12, "Truncated npy header in " + m_fname);
+    hlen = std::size_t(plen[0]) | (std::size_t(plen[1]) << 8) |
+           (std::size_t(plen[2]) << 16) | (std::size_t(plen[3]) << 24);
+    hpos = 12;
+  } else {
+    return setError(12, "Unsupported npy version in " + m_fname);
+  }
+  if ( hpos + hlen > m_mapSize ) return setError(13, "Truncated npy header in " + m_fname);
+  string hdr(pbeg + hpos, hlen);
+  // Data type. Values are copied without byte swapping so the host is
+  // assumed to be little endian.
+  string::size_type ipos = hdr.find("'descr'");
+  if ( ipos == string::npos ) return setError(14, "Missing descr in " + m_fname);
+  ipos = hdr.find('\'', ipos + 7);
+  string::size_type jpos = ipos == string::npos ? ipos : hdr.find('\'', ipos + 1);
+  if ( jpos == string::npos ) return setError(14, "Invalid descr in " + m_fname);
+  string descr = hdr.substr(ipos + 1, jpos - ipos - 1);
+  if ( descr == "<f4" ) m_valueSize = 4;
+  else if ( descr == "<f8" ) m_valueSize = 8;
+  else return setError(15, "Unsupported data type " + descr + " in " + m_fname);
+  // Order.
+  ipos = hdr.find("'fortran_order'");
+  if ( ipos == string::npos ) return setError(16, "Missing fortran_order in " + m_fname);
+  ipos = hdr.find_first_not_of(" :", ipos + 15);
+  if ( ipos == string::npos || hdr.compare(ipos, 5, "False") != 0 ) {
+    return setError(16, "Fortran order is not supported in " + m_fname);
+  }
+  // Shape.
+  ipos = hdr.find("'shape'");
+  if ( ipos == string::npos ) return setError(17, "Missing shape in " + m_fname);
+  ipos = hdr.find('(', ipos);
+  jpos = ipos == string::npos ? ipos : hdr.find(')', ipos);
+  if ( jpos == string::npos ) return setError(17, "Invalid shape in " + m_fname);
+  m_shape.clear();
+  std::uint64_t nval = 1;
+  const std::uint64_t maxval = 0xffffffff;
+  for ( string::size_type kpos=ipos+1; kpos<jpos; ) {
+    kpos = hdr.find_first_of("0123456789", kpos);
+    if ( kpos == string::npos || kpos >= jpos ) break;
+    std::uint64_t dim = 0;
+    while ( kpos < jpos && hdr[kpos] >= '0' && hdr[kpos] <= '9' ) {
+      dim = 10*dim + (hdr[kpos] - '0');
+      if ( dim > maxval ) return setError(18, "Array is too large in " + m_fname);
+      ++kpos;
+    }
+    m_shape.push_back(dim);
+    nval *= dim;
+    if ( nval > maxval ) return setError(18, "Array is too large in " + m_fname);
+  }
+  // Data.
+  std::size_t dpos = hpos + hlen;
+  if ( dpos + nval*m_valueSize > m_mapSize ) {
+    return setError(19, "File is shorter than the array in " + m_fname);
+  }
+  m_size = nval;
+  m_pdata = pbeg + dpos;
+  m_error.clear();
+  return 0;
+}
+
+//**********************************************************************
+
+int NpyFloatFile::setError(int stat, Name msg) {
+  m_status = stat;
+  m_error = msg;
+  return stat;
+}
+
+//**********************************************************************
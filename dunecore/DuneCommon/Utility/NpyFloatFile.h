@@ -0,0 +1,82 @@
+// NpyFloatFile.h
+//
+// Reader for a float array stored in a numpy .npy file.
+//
+// The file is memory mapped and the header is validated before any values
+// are read. Supported content is a C-ordered array of little-endian 32-bit
+// (<f4) or 64-bit (<f8) floats with any shape. Values are returned flattened.
+// Such a file is written from python with
+//   numpy.save("gains.npy", numpy.asarray(vals, dtype=numpy.float32))
+// and loading an array of O(1M) values is a single copy instead of a fcl parse.
+//
+// Usage:
+//   NpyFloatFile npf("gains.npy");
+//   if ( npf.status() ) cout << npf.error() << endl;
+//   std::vector<float> vals;
+//   npf.read(vals);
+
+#ifndef NpyFloatFile_H
+#define NpyFloatFile_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class NpyFloatFile {
+
+public:
+
+  using Index = unsigned int;
+  using Name = std::string;
+  using IndexVector = std::vector<Index>;
+  using FloatVector = std::vector<float>;
+
+  // Ctor from the file path. The file is opened, mapped and the header checked.
+  explicit NpyFloatFile(Name fname);
+
+  // Dtor. Unmaps the file.
+  ~NpyFloatFile();
+
+  // No copy.
+  NpyFloatFile(const NpyFloatFile&) =delete;
+  NpyFloatFile& operator=(const NpyFloatFile&) =delete;
+
+  // Status: 0 if the file is valid.
+  int status() const { return m_status; }
+
+  // Description of the problem if status is nonzero.
+  const Name& error() const { return m_error; }
+
+  // File name.
+  const Name& fileName() const { return m_fname; }
+
+  // Array shape, number of values and bytes per value (4 or 8).
+  const IndexVector& shape() const { return m_shape; }
+  Index size() const { return m_size; }
+  Index valueSize() const { return m_valueSize; }
+
+  // Copy the values into vals, converting to float if needed.
+  // Returns nonzero and leaves vals unchanged if the file is not valid.
+  int read(FloatVector& vals) const;
+
+private:
+
+  Name m_fname;
+  int m_status = 1;
+  Name m_error;
+  IndexVector m_shape;
+  Index m_size = 0;
+  Index m_valueSize = 0;
+  void* m_pmap = nullptr;
+  std::size_t m_mapSize = 0;
+  const char* m_pdata = nullptr;
+
+  // Parse the header. Returns 0 for success.
+  int parseHeader();
+
+  // Set the error status and message and return the status.
+  int setError(int stat, Name msg);
+
+};
+
+#endif
@@ -0,0 +1,261 @@
+// RealDftFilter.h
+//
+// In-place frequency-domain filter for 1D DFTs of real data.
+//
+// The filter holds one complex gain for each compact frequency of an nsam-sample DFT,
+// i.e. for ifrq = 0, ..., nsam/2. It starts as unity and is built up by multiplying in
+// kernels:
+//   multiply - the DFT of a response, e.g. a deconvolution or shaping function
+//   scale    - real gains, one for each compact frequency
+//   wiener   - S/(S+N) for signal and noise power spectra S and N
+//   notch    - zero a range of frequencies
+//   lowPass  - Butterworth low-pass with cutoff in frequency index units
+//   shift    - delay by a (possibly fractional) number of samples
+// The filter is then applied to any number of channels, so the gains are evaluated
+// once per batch rather than once per channel.
+//
+// Applying a gain multiplies every term by the same factor, so the result has the
+// normalization of the input for any RealDftNormalization. The response in multiply
+// is converted to convolution (standard-unit) normalization with convAmplitude, and
+// the wiener power spectra only enter as a ratio so they may have any normalization
+// provided it is the same for both.
+//
+// The terms at zero frequency and Nyquist (nsam even) are real, so only the real part
+// of their gains is applied.
+//
+// The filter may be applied to
+//   - the compact amplitude and phase vectors, e.g. AdcChannelData::dftmags/dftphases
+//   - CompactRealDftData
+//   - FftwRealDftData
+//   - vectors of the above.
+// The apply loops run over contiguous gain and data arrays so that they are
+// vectorized by the compiler.
+//
+// Example (deconvolute and smooth all the channels in acds):
+//   RealDftFilter<float> filt(nsam);
+//   filt.multiply(invResponse);
+//   filt.lowPass(0.4*nsam/2, 4);
+//   for ( auto& iacd : acds ) filt.apply(iacd.second.dftmags, iacd.second.dftphases);
+//
+// art-independent class
+
+#ifndef RealDftFilter_H
+#define RealDftFilter_H
+
+#include "dunecore/DuneCommon/Utility/CompactRealDftData.h"
+#include "dunecore/DuneCommon/Utility/FftwRealDftData.h"
+#include <vector>
+#include <complex>
+#include <cmath>
+
+//**********************************************************************
+
+template<typename F>
+class RealDftFilter {
+
+public:
+
+  using Index = unsigned int;
+  using Float = F;
+  using FloatVector = std::vector<F>;
+  using Complex = std::complex<F>;
+
+  // Ctor for nsam samples. The gain is unity.
+  explicit RealDftFilter(Index nsam) { reset(nsam); }
+
+  // Reset to nsam samples and unit gain.
+  void reset(Index nsam) {
+    m_nsam = nsam;
+    Index ncmp = nCompact();
+    m_gre.assign(ncmp, 1.0);
+    m_gim.assign(ncmp, 0.0);
+    m_gmag.assign(ncmp, 1.0);
+    m_gpha.assign(ncmp, 0.0);
+  }
+
+  // Dimensions.
+  Index nSample() const { return m_nsam; }
+  Index nCompact() const { return m_nsam ? m_nsam/2 + 1 : 0; }
+  Index nPhase() const { return (m_nsam + 1)/2; }
+
+  // Return the gain for compact frequency ifrq.
+  Complex gain(Index ifrq) const {
+    if ( ifrq >= nCompact() ) return Complex(0.0, 0.0);
+    return Complex(m_gre[ifrq], m_gim[ifrq]);
+  }
+
+  // Multiply by the DFT of a response function with the same sample count.
+  // Returns nonzero if the response is invalid or has the wrong size.
+  int multiply(const RealDftData<F>& resp) {
+    if ( ! resp.isValid() ) return 1;
+    if ( resp.nSample() != nSample() ) return 2;
+    for ( Index ifrq=0; ifrq<nCompact(); ++ifrq ) {
+      F amp = resp.convAmplitude(ifrq);
+      F pha = resp.phase(ifrq);
+      multiplyGain(ifrq, Complex(amp*cos(pha), amp*sin(pha)));
+    }
+    update();
+    return 0;
+  }
+
+  // Multiply by real gains, one for each compact frequency.
+  int scale(const FloatVector& gains) {
+    if ( gains.size() != nCompact() ) return 1;
+    for ( Index ifrq=0; ifrq<nCompact(); ++ifrq ) {
+      m_gre[ifrq] *= gains[ifrq];
+      m_gim[ifrq] *= gains[ifrq];
+    }
+    update();
+    return 0;
+  }
+
+  // Wiener filter S/(S+N) for signal and noise power spectra for the compact
+  // frequencies. Frequencies with S + N = 0 are zeroed.
+  int wiener(const FloatVector& spwrs, const FloatVector& npwrs) {
+    if ( spwrs.size() != nCompact() ) return 1;
+    if ( npwrs.size() != nCompact() ) return 2;
+    FloatVector gains(nCompact(), 0.0);
+    for ( Index ifrq=0; ifrq<nCompact(); ++ifrq ) {
+      F den = spwrs[ifrq] + npwrs[ifrq];
+      if ( den > 0.0 ) gains[ifrq] = spwrs[ifrq]/den;
+    }
+    return scale(gains);
+  }
+
+  // Zero the compact frequencies in range [ifrq1, ifrq2).
+  int notch(Index ifrq1, Index ifrq2) {
+    if ( ifrq1 > ifrq2 ) return 1;
+    if ( ifrq2 > nCompact() ) ifrq2 = nCompact();
+    for ( Index ifrq=ifrq1; ifrq<ifrq2; ++ifrq ) {
+      m_gre[ifrq] = 0.0;
+      m_gim[ifrq] = 0.0;
+    }
+    update();
+    return 0;
+  }
+
+  // Butterworth low-pass with gain 1/sqrt(1 + (ifrq/fcut)^(2*order)).
+  // For order 0, frequencies above fcut are zeroed.
+  int lowPass(F fcut, Index order) {
+    if ( fcut <= 0.0 ) return 1;
+    FloatVector gains(nCompact(), 1.0);
+    for ( Index ifrq=0; ifrq<nCompact(); ++ifrq ) {
+      F x = ifrq/fcut;
+      if ( order == 0 ) gains[ifrq] = x > 1.0 ? 0.0 : 1.0;
+      else gains[ifrq] = 1.0/sqrt(1.0 + pow(x, 2*order));
+    }
+    return scale(gains);
+  }
+
+  // Delay by dsam samples, i.e. multiply by exp(-2 pi i ifrq dsam/nsam).
+  // The shift is circular.
+  int shift(F dsam) {
+    const double twopi = 2.0*acos(-1.0);
+    for ( Index ifrq=0; ifrq<nCompact(); ++ifrq ) {
+      double arg = -twopi*ifrq*dsam/nSample();
+      multiplyGain(ifrq, Complex(cos(arg), sin(arg)));
+    }
+    update();
+    return 0;
+  }
+
+  // Apply to the compact amplitudes and phases.
+  // Phases are returned in the range [-pi, pi).
+  int apply(FloatVector& amps, FloatVector& phas) const {
+    Index namp = nCompact();
+    Index npha = nPhase();
+    if ( amps.size() != namp ) return 1;
+    if ( phas.size() != npha ) return 2;
+    F* pamp = amps.data();
+    F* ppha = phas.data();
+    const F* pmag = m_gmag.data();
+    const F* pgph = m_gpha.data();
+    const F pi = acos(-1.0);
+    const F twopi = 2.0*pi;
+    const F otwopi = 1.0/twopi;
+    for ( Index ifrq=0; ifrq<npha; ++ifrq ) {
+      pamp[ifrq] *= pmag[ifrq];
+      F pha = ppha[ifrq] + pgph[ifrq] + pi;
+      ppha[ifrq] = pha - twopi*std::floor(pha*otwopi) - pi;
+    }
+    // Nyquist term: amplitude carries the sign.
+    if ( namp > npha ) pamp[npha] *= m_gre[npha];
+    return 0;
+  }
+
+  // Apply to a compact DFT.
+  int apply(CompactRealDftData<F>& dft) const {
+    if ( dft.nSample() != nSample() ) return 3;
+    FloatVector amps;
+    FloatVector phas;
+    dft.moveOut(amps, phas);
+    int rstat = apply(amps, phas);
+    dft.moveIn(amps, phas);
+    return rstat;
+  }
+
+  // Apply to a DFT held in the FFTW layout.
+  int apply(FftwRealDftData<F>& dft) const {
+    if ( dft.nSample() != nSample() ) return 3;
+    F* pdat = dft.floatData();
+    const F* pgre = m_gre.data();
+    const F* pgim = m_gim.data();
+    for ( Index ifrq=0; ifrq<nCompact(); ++ifrq ) {
+      F re = pdat[2*ifrq];
+      F im = pdat[2*ifrq + 1];
+      pdat[2*ifrq]     = re*pgre[ifrq] - im*pgim[ifrq];
+      pdat[2*ifrq + 1] = re*pgim[ifrq] + im*pgre[ifrq];
+    }
+    return 0;
+  }
+
+  // Apply to a batch of DFTs.
+  // Returns the number of DFTs that could not be filtered.
+  template<class D>
+  Index apply(std::vector<D>& dfts) const {
+    Index nbad = 0;
+    for ( D& dft : dfts ) if ( apply(dft) ) ++nbad;
+    return nbad;
+  }
+
+  // Apply to a batch of compact amplitude and phase vectors.
+  Index apply(std::vector<FloatVector>& amps, std::vector<FloatVector>& phas) const {
+    if ( amps.size() != phas.size() ) return amps.size() > phas.size() ? amps.size() : phas.size();
+    Index nbad = 0;
+    for ( Index idft=0; idft<amps.size(); ++idft ) if ( apply(amps[idft], phas[idft]) ) ++nbad;
+    return nbad;
+  }
+
+private:
+
+  // Multiply the gain for one frequency.
+  void multiplyGain(Index ifrq, Complex val) {
+    Complex gain = Complex(m_gre[ifrq], m_gim[ifrq])*val;
+    m_gre[ifrq] = gain.real();
+    m_gim[ifrq] = gain.imag();
+  }
+
+  // Keep the zero-frequency and Nyquist gains real and update the polar form.
+  void update() {
+    Index ncmp = nCompact();
+    if ( ncmp == 0 ) return;
+    m_gim[0] = 0.0;
+    if ( nPhase() < ncmp ) m_gim[ncmp-1] = 0.0;
+    for ( Index ifrq=0; ifrq<ncmp; ++ifrq ) {
+      Complex gain(m_gre[ifrq], m_gim[ifrq]);
+      m_gmag[ifrq] = std::abs(gain);
+      m_gpha[ifrq] = std::arg(gain);
+    }
+  }
+
+  Index m_nsam = 0;
+  FloatVector m_gre;     // Real part of the gains
+  FloatVector m_gim;     // Imaginary part of the gains
+  FloatVector m_gmag;    // Magnitude of the gains
+  FloatVector m_gpha;    // Phase of the gains
+
+};
+
+//**********************************************************************
+
+#endif
@@ -0,0 +1,174 @@
+// StringTemplate.cxx
+
+#include "StringTemplate.h"
+#include <cstdio>
+#include <algorithm>
+
+using Index = StringTemplate::Index;
+using Name = StringTemplate::Name;
+
+//**********************************************************************
+
+StringTemplate::StringTemplate(const Name& pat) : m_pat(pat) {
+  buildSegments();
+}
+
+//**********************************************************************
+
+Index StringTemplate::addField(const Name& skey, Index width) {
+  if ( skey.empty() ) return badIndex();
+  m_fields.push_back({skey, width, false, ""});
+  buildSegments();
+  return m_fields.size() - 1;
+}
+
+//**********************************************************************
+
+Index StringTemplate::fieldIndex(const Name& skey) const {
+  for ( Index ifld=0; ifld<nfield(); ++ifld ) {
+    if ( m_fields[ifld].key == skey ) return ifld;
+  }
+  return badIndex();
+}
+
+//**********************************************************************
+
+Index StringTemplate::count(Index ifld) const {
+  Index nocc = 0;
+  for ( const Segment& seg : m_segs ) if ( seg.ifld == ifld ) ++nocc;
+  return nocc;
+}
+
+//**********************************************************************
+
+int StringTemplate::setValue(Index ifld, long val) {
+  char buf[32];
+  int len = snprintf(buf, sizeof(buf), "%ld", val);
+  return setPadded(ifld, buf, len, val < 0 ? '-' : '0');
+}
+
+//**********************************************************************
+
+int StringTemplate::setValue(Index ifld, unsigned long val) {
+  char buf[32];
+  int len = snprintf(buf, sizeof(buf), "%lu", val);
+  return setPadded(ifld, buf, len, '0');
+}
+
+//**********************************************************************
+
+int StringTemplate::setValue(Index ifld, const Name& val) {
+  return setPadded(ifld, val.c_str(), val.size(), '_');
+}
+
+//**********************************************************************
+
+int StringTemplate::setFloat(Index ifld, float val, int prec, bool trunc,
+                             const Name& sdot, const Name& smin) {
+  if ( ifld >= nfield() ) return 1;
+  char buf[64];
+  int len = snprintf(buf, sizeof(buf), "%.*f", prec < 0 ? 6 : prec, val);
+  if ( len < 0 ) return 2;
+  if ( len >= int(sizeof(buf)) ) len = sizeof(buf) - 1;
+  if ( ! trunc || len == 0 ) return setPadded(ifld, buf, len, '\0');
+  // Drop trailing zeroes after the decimal point and a trailing point.
+  int ipos = len - 1;
+  while ( ipos > 0 ) {
+    if ( buf[ipos] == '.' ) {
+      --ipos;
+      break;
+    } else if ( buf[ipos] == '0' ) --ipos;
+    else break;
+  }
+  len = ipos + 1;
+  Field& fld = m_fields[ifld];
+  fld.value.clear();
+  for ( int ich=0; ich<len; ++ich ) {
+    char ch = buf[ich];
+    if ( ch == '.' && sdot.size() && sdot != "." ) fld.value += sdot;
+    else if ( ch == '-' && smin.size() && smin != "." ) fld.value += smin;
+    else fld.value += ch;
+  }
+  fld.haveValue = true;
+  return 0;
+}
+
+//**********************************************************************
+
+int StringTemplate::clearValue(Index ifld) {
+  if ( ifld >= nfield() ) return 1;
+  m_fields[ifld].haveValue = false;
+  m_fields[ifld].value.clear();
+  return 0;
+}
+
+//**********************************************************************
+
+const Name& StringTemplate::str() {
+  format(m_out);
+  return m_out;
+}
+
+//**********************************************************************
+
+void StringTemplate::format(Name& sout) const {
+  sout.clear();
+  for ( const Segment& seg : m_segs ) {
+    if ( seg.ifld == badIndex() ) {
+      sout.append(m_pat, seg.pos, seg.len);
+    } else {
+      const Field& fld = m_fields[seg.ifld];
+      if ( fld.haveValue ) sout.append(fld.value);
+      else                 sout.append(fld.key);
+    }
+  }
+}
+
+//**********************************************************************
+
+int StringTemplate::setPadded(Index ifld, const char* pval, Name::size_type len, char cfill) {
+  if ( ifld >= nfield() ) return 1;
+  Field& fld = m_fields[ifld];
+  fld.value.clear();
+  // A null fill means no padding, as for floatToString.
+  if ( cfill != '\0' && fld.width > len ) fld.value.append(fld.width - len, cfill);
+  fld.value.append(pval, len);
+  fld.haveValue = true;
+  return 0;
+}
+
+//**********************************************************************
+
+void StringTemplate::buildSegments() {
+  // Find the field occurences, skipping those that overlap earlier fields.
+  std::vector<Segment> occs;
+  for ( Index ifld=0; ifld<nfield(); ++ifld ) {
+    const Name& skey = m_fields[ifld].key;
+    Name::size_type ipos = m_pat.find(skey);
+    while ( ipos != Name::npos ) {
+      Name::size_type iend = ipos + skey.size();
+      bool overlap = false;
+      for ( const Segment& occ : occs ) {
+        if ( ipos < occ.pos + occ.len && occ.pos < iend ) {
+          overlap = true;
+          break;
+        }
+      }
+      if ( ! overlap ) occs.push_back({ipos, skey.size(), ifld});
+      ipos = m_pat.find(skey, overlap ? ipos + 1 : iend);
+    }
+  }
+  std::sort(occs.begin(), occs.end(),
+            [](const Segment& lhs, const Segment& rhs) { return lhs.pos < rhs.pos; });
+  // Fill the literals between the occurences.
+  m_segs.clear();
+  Name::size_type ipos = 0;
+  for ( const Segment& occ : occs ) {
+    if ( occ.pos > ipos ) m_segs.push_back({ipos, occ.pos - ipos, badIndex()});
+    m_segs.push_back(occ);
+    ipos = occ.pos + occ.len;
+  }
+  if ( ipos < m_pat.size() ) m_segs.push_back({ipos, m_pat.size() - ipos, badIndex()});
+}
+
+//**********************************************************************
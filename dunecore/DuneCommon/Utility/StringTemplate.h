@@ -0,0 +1,112 @@
+// StringTemplate.h
+//
+// Compiled form of the StringManipulator replacements for building names
+// repeatedly from one pattern, e.g. a histogram name for each channel.
+//
+// The pattern is parsed once into literal segments and fields. Values are
+// then set for the fields and str() assembles the result in a buffer that
+// is reused from call to call, so that after the first few calls no memory
+// is allocated.
+//
+// Usage:
+//   StringTemplate stm("hped_%RUN%_%CHAN%");
+//   StringTemplate::Index ifrun = stm.addField("%RUN%", 6);
+//   StringTemplate::Index ifcha = stm.addField("%CHAN%");
+//   stm.setValue(ifrun, run);
+//   for ( Index icha : ... ) {
+//     stm.setValue(ifcha, icha);
+//     const std::string& hnam = stm.str();
+//     ...
+//   }
+//
+// The formatting matches the StringManipulator methods:
+//   setValue(ifld, val) for a field with width 0 matches replace
+//   setValue(ifld, val) for a field with width > 0 matches replaceFixedWidth
+//   setFloat(...) matches floatToString
+// Each field is replaced at all its occurrences. A field that has no value
+// keeps its key. Occurrences that overlap with those of an earlier field are
+// ignored, as they would be if the keys were replaced in the order added.
+//
+// An object holds the current values so different threads should use
+// different objects.
+
+#ifndef StringTemplate_H
+#define StringTemplate_H
+
+#include <string>
+#include <vector>
+#include <limits>
+
+class StringTemplate {
+
+public:
+
+  using Index = unsigned int;
+  using Name = std::string;
+
+  static Index badIndex() { return std::numeric_limits<Index>::max(); }
+
+  // Ctor from the pattern.
+  explicit StringTemplate(const Name& pat);
+
+  // Add a field with key skey, e.g. "%RUN%", and width.
+  // Returns the field index or badIndex() if the key is empty.
+  Index addField(const Name& skey, Index width =0);
+
+  // Return the pattern, the number of fields and the index for a key.
+  const Name& pattern() const { return m_pat; }
+  Index nfield() const { return m_fields.size(); }
+  Index fieldIndex(const Name& skey) const;
+
+  // Return the number of occurences of a field in the pattern.
+  Index count(Index ifld) const;
+
+  // Set the value for a field.
+  // Return nonzero if the field index is invalid.
+  int setValue(Index ifld, long val);
+  int setValue(Index ifld, unsigned long val);
+  int setValue(Index ifld, int val) { return setValue(ifld, long(val)); }
+  int setValue(Index ifld, unsigned int val) { return setValue(ifld, (unsigned long) val); }
+  int setValue(Index ifld, const Name& val);
+  int setValue(Index ifld, const char* val) { return setValue(ifld, Name(val)); }
+  int setFloat(Index ifld, float val, int prec, bool trunc, const Name& sdot ="", const Name& smin ="");
+
+  // Remove the value for a field so that its key is restored.
+  int clearValue(Index ifld);
+
+  // Return the string obtained by replacing each field with its value.
+  // The returned reference is valid until the next call.
+  const Name& str();
+
+  // Format into a caller-supplied buffer.
+  void format(Name& sout) const;
+
+private:
+
+  struct Field {
+    Name key;
+    Index width;
+    bool haveValue;
+    Name value;
+  };
+
+  struct Segment {
+    Name::size_type pos;
+    Name::size_type len;
+    Index ifld;         // badIndex() for a literal
+  };
+
+  // Set the value with padding to the field width.
+  int setPadded(Index ifld, const char* pval, Name::size_type len, char cfill);
+
+  // Rebuild the segments from the field occurences.
+  void buildSegments();
+
+  Name m_pat;
+  std::vector<Field> m_fields;
+  std::vector<Segment> m_segs;
+  Name m_out;
+
+};
+
+#endif
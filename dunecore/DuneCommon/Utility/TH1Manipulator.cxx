@@ -7,6 +7,7 @@
 #include "TGaxis.h"
 #include "TList.h"
 #include "TStyle.h"
+#include <algorithm>
 
 using std::string;
 
@@ -146,5 +147,42 @@ int TH1Manipulator::fixFrameFillColor() {
   return 0;
 }
 
+//**********************************************************************
+
+int TH1Manipulator::shiftBins(TH1* ph, int nshift) {
+  if ( ph == nullptr ) return 1;
+  int nbin = ph->GetNbinsX();
+  if ( nshift == 0 || nbin == 0 ) return 0;
+  double entries = ph->GetEntries();
+  ph->Sumw2(false);
+  double under = ph->GetBinContent(0);
+  double over = ph->GetBinContent(nbin+1);
+  if ( nshift > 0 ) {
+    for ( int ibin=std::max(nbin-nshift+1, 1); ibin<=nbin; ++ibin ) over += ph->GetBinContent(ibin);
+    for ( int ibin=nbin; ibin>=1; --ibin ) {
+      ph->SetBinContent(ibin, ibin > nshift ? ph->GetBinContent(ibin-nshift) : 0.0);
+    }
+  } else {
+    int nsh = -nshift;
+    for ( int ibin=1; ibin<=std::min(nsh, nbin); ++ibin ) under += ph->GetBinContent(ibin);
+    for ( int ibin=1; ibin<=nbin; ++ibin ) {
+      ph->SetBinContent(ibin, ibin + nsh <= nbin ? ph->GetBinContent(ibin+nsh) : 0.0);
+    }
+  }
+  ph->SetBinContent(0, under);
+  ph->SetBinContent(nbin+1, over);
+  ph->SetEntries(entries);
+  return 0;
+}
+
+//**********************************************************************
+
+int TH1Manipulator::shiftAxis(TH1* ph, double dx) {
+  if ( ph == nullptr ) return 1;
+  TAxis* pax = ph->GetXaxis();
+  pax->SetLimits(pax->GetXmin() + dx, pax->GetXmax() + dx);
+  return 0;
+}
+
 //**********************************************************************
 //**********************************************************************
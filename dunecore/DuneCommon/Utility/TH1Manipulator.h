@@ -9,6 +9,9 @@
 // # divisions) are taken from the histogram.
 //
 // After modifying plot range, repeat call to fix top/right axis.
+//
+// There are also in-place shifts of the bins or axis of a 1D histogram so
+// that no clone or refill is needed. See also FloatHist.
 
 #ifndef TH1Manipulator_H
 #define TH1Manipulator_H
@@ -41,6 +44,16 @@ public:
   // Otherwise underflows look like zeros.
   static int fixFrameFillColor();
 
+  // Move the contents of a 1D histogram nshift bins up (down if negative) in
+  // place. Contents moved out of range are added to the underflow or overflow
+  // and errors are dropped.
+  // Returns nonzero if the histogram is null.
+  static int shiftBins(TH1* ph, int nshift);
+
+  // Shift the X-axis of a histogram by dx in place.
+  // Returns nonzero if the histogram is null.
+  static int shiftAxis(TH1* ph, double dx);
+
 };
 
 #endif
@@ -40,12 +40,76 @@ namespace {
 
 //void EmptyErrorHandler(Int_t, Bool_t, const char*, const char*) { }
 
+// Pool of cleared batch canvases for reuse.
+struct PooledCanvas {
+  TCanvas* pcan;
+  int wx;
+  int wy;
+};
+
+bool& canvasReuseFlag() {
+  static bool reuse = false;
+  return reuse;
+}
+
+std::vector<PooledCanvas>& canvasPool() {
+  static std::vector<PooledCanvas> pool;
+  return pool;
+}
+
+// Take a canvas with the requested size from the pool.
+// Canvases that Root has already deleted are dropped.
+TCanvas* takePooledCanvas(int wx, int wy) {
+  if ( ! canvasReuseFlag() || ! gROOT->IsBatch() ) return nullptr;
+  std::vector<PooledCanvas>& pool = canvasPool();
+  for ( Index ient=pool.size(); ient>0; --ient ) {
+    PooledCanvas ent = pool[ient-1];
+    if ( gROOT->GetListOfCanvases()->IndexOf(ent.pcan) < 0 ) {
+      pool.erase(pool.begin() + ient - 1);
+      continue;
+    }
+    if ( ent.wx == wx && ent.wy == wy ) {
+      pool.erase(pool.begin() + ient - 1);
+      return ent.pcan;
+    }
+  }
+  return nullptr;
+}
+
 }  // end unnamed namespace
 
 //**********************************************************************
 // Static members.
 //**********************************************************************
 
+void TPadManipulator::setCanvasReuse(bool reuse) {
+  canvasReuseFlag() = reuse;
+  if ( ! reuse ) clearCanvasPool();
+}
+
+//**********************************************************************
+
+bool TPadManipulator::canvasReuse() {
+  return canvasReuseFlag();
+}
+
+//**********************************************************************
+
+Index TPadManipulator::canvasPoolSize() {
+  return canvasPool().size();
+}
+
+//**********************************************************************
+
+void TPadManipulator::clearCanvasPool() {
+  for ( PooledCanvas& ent : canvasPool() ) {
+    if ( gROOT->GetListOfCanvases()->IndexOf(ent.pcan) >= 0 ) delete ent.pcan;
+  }
+  canvasPool().clear();
+}
+
+//**********************************************************************
+
 TPadManipulator* TPadManipulator::get(Name onam, TDirectory* tdir) {
   Name myname = "TPadManipulator::get: ";
   TPadManipulator* ppad = nullptr;
@@ -231,7 +295,7 @@ TPadManipulator::~TPadManipulator() {
   if ( m_ppad != nullptr && m_parent == nullptr ) {
     // May 2020: If the pad is not in the Root list of canvases, then it may
     // be that Root has already deleted it.
-    if ( gROOT->GetListOfCanvases()->IndexOf(m_ppad) >= 0 ) {
+    if ( gROOT->GetListOfCanvases()->IndexOf(m_ppad) >= 0 && ! poolCanvas() ) {
       m_ppad->Close();
       gSystem->ProcessEvents();
       delete m_ppad;
@@ -374,8 +438,11 @@ int TPadManipulator::printOnce(string fname) {
   // display on screen.
   // We should (but don't yet) also remove the canvas after draw so
   // there are no problems if a draw to screen is attempted later.
+  // If canvas reuse is enabled, that canvas is returned to the pool.
   bool setBackToNonBatch = false;
+  bool newCanvas = false;
   if ( pcan == nullptr ) {
+    newCanvas = true;
     bool isBatch = gROOT->IsBatch();
     if ( ! isBatch ) {
       gROOT->SetBatch(true);
@@ -400,6 +467,7 @@ int TPadManipulator::printOnce(string fname) {
   pcan->Print(fname.c_str());
   if ( pehSave != nullptr ) SetErrorHandler(pehSave);
   gErrorIgnoreLevel = levelSave;
+  if ( newCanvas && canvasReuse() ) erase();
   if ( setBackToNonBatch ) gROOT->SetBatch(false);
   return 0;
 }
@@ -1406,7 +1474,12 @@ int TPadManipulator::draw() {
   if ( haveParent() ) return parent()->draw();
   if ( m_ppad == nullptr ) {
     if ( ! haveHistOrGraph() && npad() == 0 ) return 1;
-    TCanvas* pcan = new TCanvas;
+    TCanvas* pcan = takePooledCanvas(m_canvasWidth, m_canvasHeight);
+    if ( pcan != nullptr ) {
+      m_ppad = pcan;
+      return update();
+    }
+    pcan = new TCanvas;
     if ( m_canvasWidth > 0 && m_canvasHeight > 0 ) {
       string snam = pcan->GetName();
       string sttl = pcan->GetTitle();
@@ -1425,8 +1498,11 @@ int TPadManipulator::draw() {
 int TPadManipulator::erase() {
   if ( haveParent() ) return parent()->erase();
   if ( m_ppad == nullptr ) return 0;
-  delete m_ppad;
-  m_ppad = nullptr;
+  if ( ! poolCanvas() ) {
+    delete m_ppad;
+    m_ppad = nullptr;
+    clearSubPads(false);
+  }
   return 0;
 }
 
@@ -1704,3 +1780,29 @@ void TPadManipulator::setParents(bool recurse) {
  }
 
 //**********************************************************************
+
+//**********************************************************************
+
+void TPadManipulator::clearSubPads(bool doDelete) {
+  for ( TPadManipulator& man : m_subMans ) {
+    man.clearSubPads(doDelete);
+    if ( doDelete ) delete man.m_ppad;
+    man.m_ppad = nullptr;
+  }
+}
+
+//**********************************************************************
+
+bool TPadManipulator::poolCanvas() {
+  if ( haveParent() || ! canvasReuse() ) return false;
+  TCanvas* pcan = dynamic_cast<TCanvas*>(m_ppad);
+  if ( pcan == nullptr || ! pcan->IsBatch() ) return false;
+  if ( canvasPoolSize() >= canvasPoolMaxSize() ) return false;
+  clearSubPads(true);
+  pcan->Clear();
+  canvasPool().push_back({pcan, m_canvasWidth, m_canvasHeight});
+  m_ppad = nullptr;
+  return true;
+}
+
+//**********************************************************************
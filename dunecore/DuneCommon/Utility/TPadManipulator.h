@@ -15,6 +15,13 @@
 //
 // It is also posssible to and multiple subpads and draw into those instead of the
 // top-level pad. There is a manipulator for each subpad.
+//
+// Jobs that print many plots may enable canvas reuse with setCanvasReuse(true).
+// Batch canvases are then returned to a small pool when a top-level manipulator
+// is erased or destroyed and are taken from there by the next draw with the same
+// canvas size. The canvas created to print a manipulator that has not been drawn
+// is also returned after printing. Like the rest of the Root graphics, the pool
+// is not thread safe.
 
 #ifndef TPadManipulator_H
 #define TPadManipulator_H
@@ -72,6 +79,17 @@ public:
   // Read object with name onam from the Root file fnam.
   static TPadManipulator* read(Name fnam, Name onam ="tpad");
 
+  // Enable or disable reuse of batch canvases. Disabling clears the pool.
+  static void setCanvasReuse(bool reuse);
+  static bool canvasReuse();
+
+  // Number of canvases in the pool and the maximum number pooled.
+  static Index canvasPoolSize();
+  static Index canvasPoolMaxSize() { return 4; }
+
+  // Delete the pooled canvases.
+  static void clearCanvasPool();
+
   // Default ctor.
   // Creates an empty top-level object.
   TPadManipulator();
@@ -425,6 +443,14 @@ private:
   // If recurse is true, the operation is also performed on their children.
   void setParents(bool recurse);
 
+  // Remove the pads for all descendants. If doDelete is true, the pads are
+  // deleted. Otherwise they are assumed to already be deleted with the canvas.
+  void clearSubPads(bool doDelete);
+
+  // Return the canvas for this top-level manipulator to the pool.
+  // Returns false if the canvas cannot be pooled.
+  bool poolCanvas();
+
 private:
 
   TPadManipulator* m_parent;  //! ==> Do not stream
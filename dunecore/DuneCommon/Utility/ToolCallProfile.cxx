@@ -0,0 +1,150 @@
+// ToolCallProfile.cxx
+
+#include "ToolCallProfile.h"
+#include <map>
+#include <mutex>
+#include <iomanip>
+#include <algorithm>
+
+using std::endl;
+using std::setw;
+using std::fixed;
+using std::setprecision;
+using Name = ToolCallProfile::Name;
+using Index = ToolCallProfile::Index;
+using Entry = ToolCallProfile::Entry;
+using ProfilePtr = std::shared_ptr<ToolCallProfile>;
+
+namespace {
+
+std::mutex& registryMutex() {
+  static std::mutex mtx;
+  return mtx;
+}
+
+std::map<Name, ProfilePtr>& registry() {
+  static std::map<Name, ProfilePtr> prfs;
+  return prfs;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+Name ToolCallProfile::methodName(Index imet) {
+  static const std::array<Name, NMethod> snams = {
+    "update", "view", "updateMap", "viewMap", "updateFlatMap", "viewFlatMap",
+    "updateTpcData", "viewTpcData"
+  };
+  return imet < NMethod ? snams[imet] : "invalid";
+}
+
+//**********************************************************************
+
+ProfilePtr ToolCallProfile::registered(const Name& label) {
+  std::lock_guard<std::mutex> lock(registryMutex());
+  ProfilePtr& pprf = registry()[label];
+  if ( ! pprf ) pprf.reset(new ToolCallProfile(label));
+  return pprf;
+}
+
+//**********************************************************************
+
+void ToolCallProfile::printAll(std::ostream& out, Name prefix) {
+  std::vector<ProfilePtr> prfs;
+  {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for ( const auto& ent : registry() ) prfs.push_back(ent.second);
+  }
+  std::vector<std::pair<Entry, ProfilePtr>> ents;
+  for ( const ProfilePtr& pprf : prfs ) ents.emplace_back(pprf->total(), pprf);
+  std::stable_sort(ents.begin(), ents.end(),
+                   [](const std::pair<Entry, ProfilePtr>& lhs, const std::pair<Entry, ProfilePtr>& rhs) {
+                     return lhs.first.nanoseconds > rhs.first.nanoseconds;
+                   });
+  printHeader(out, prefix);
+  for ( const auto& ent : ents ) printRow(out, prefix, ent.second->label(), "all", ent.first);
+}
+
+//**********************************************************************
+
+void ToolCallProfile::record(Index imet, Count nchan, Count nsec, long nbyte) {
+  if ( imet >= NMethod ) return;
+  AtomicEntry& ent = m_ents[imet];
+  ent.calls.fetch_add(1, std::memory_order_relaxed);
+  ent.channels.fetch_add(nchan, std::memory_order_relaxed);
+  ent.nanoseconds.fetch_add(nsec, std::memory_order_relaxed);
+  ent.bytes.fetch_add(nbyte, std::memory_order_relaxed);
+}
+
+//**********************************************************************
+
+void ToolCallProfile::reset() {
+  for ( AtomicEntry& ent : m_ents ) {
+    ent.calls = 0;
+    ent.channels = 0;
+    ent.nanoseconds = 0;
+    ent.bytes = 0;
+  }
+}
+
+//**********************************************************************
+
+Entry ToolCallProfile::entry(Index imet) const {
+  Entry out;
+  if ( imet >= NMethod ) return out;
+  const AtomicEntry& ent = m_ents[imet];
+  out.calls = ent.calls.load(std::memory_order_relaxed);
+  out.channels = ent.channels.load(std::memory_order_relaxed);
+  out.nanoseconds = ent.nanoseconds.load(std::memory_order_relaxed);
+  out.bytes = ent.bytes.load(std::memory_order_relaxed);
+  return out;
+}
+
+//**********************************************************************
+
+Entry ToolCallProfile::total() const {
+  Entry out;
+  for ( Index imet=0; imet<NMethod; ++imet ) {
+    Entry ent = entry(imet);
+    out.calls += ent.calls;
+    out.channels += ent.channels;
+    out.nanoseconds += ent.nanoseconds;
+    out.bytes += ent.bytes;
+  }
+  return out;
+}
+
+//**********************************************************************
+
+void ToolCallProfile::print(std::ostream& out, Name prefix) const {
+  printHeader(out, prefix);
+  for ( Index imet=0; imet<NMethod; ++imet ) {
+    Entry ent = entry(imet);
+    if ( ent.calls ) printRow(out, prefix, m_label, methodName(imet), ent);
+  }
+}
+
+//**********************************************************************
+
+void ToolCallProfile::printHeader(std::ostream& out, const Name& prefix) {
+  out << prefix << setw(30) << "Tool" << setw(15) << "Method" << setw(10) << "Calls"
+      << setw(12) << "Channels" << setw(12) << "Time [s]" << setw(12) << "us/chan"
+      << setw(14) << "Bytes" << endl;
+}
+
+//**********************************************************************
+
+void ToolCallProfile::printRow(std::ostream& out, const Name& prefix, const Name& label,
+                               const Name& snam, const Entry& ent) {
+  double uspc = ent.channels ? 1.e-3*ent.nanoseconds/ent.channels : 0.0;
+  std::ios_base::fmtflags oldflags = out.flags();
+  std::streamsize oldprec = out.precision();
+  out << prefix << setw(30) << label << setw(15) << snam << setw(10) << ent.calls
+      << setw(12) << ent.channels << fixed << setprecision(3) << setw(12) << ent.seconds()
+      << setw(12) << uspc << setw(14) << ent.bytes << endl;
+  out.flags(oldflags);
+  out.precision(oldprec);
+}
+
+//**********************************************************************
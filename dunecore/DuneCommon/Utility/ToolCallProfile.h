@@ -0,0 +1,125 @@
+// ToolCallProfile.h
+//
+// Call statistics for one tool instance: for each tool method, the number of
+// calls, the number of channels processed, the wall time and the growth in the
+// bytes held by the processed data.
+//
+// Counts are accumulated atomically so a profile may be updated concurrently,
+// e.g. by a tool whose channels are processed in parallel.
+//
+// Profiles may be registered by label so that a summary table for all the
+// tools in a job can be printed with printAll. The registry holds shared
+// pointers, so registered profiles live until the end of the job.
+//
+// Usage:
+//   std::shared_ptr<ToolCallProfile> pprf = ToolCallProfile::registered("mytool");
+//   {
+//     ToolCallProfile::Timer tim(*pprf, ToolCallProfile::UpdateMap, nchan);
+//     ...
+//     tim.addBytes(nbyte);
+//   }
+//   ToolCallProfile::printAll();
+
+#ifndef ToolCallProfile_H
+#define ToolCallProfile_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <iostream>
+
+class ToolCallProfile {
+
+public:
+
+  using Name = std::string;
+  using Index = unsigned int;
+  using Count = unsigned long;
+  using Clock = std::chrono::steady_clock;
+
+  // Profiled methods.
+  enum Method {
+    Update, View, UpdateMap, ViewMap, UpdateFlatMap, ViewFlatMap,
+    UpdateTpcData, ViewTpcData, NMethod
+  };
+
+  // Return the name for a method.
+  static Name methodName(Index imet);
+
+  // Counts for one method.
+  struct Entry {
+    Count calls = 0;
+    Count channels = 0;
+    Count nanoseconds = 0;
+    long bytes = 0;
+    double seconds() const { return 1.e-9*nanoseconds; }
+  };
+
+  // Scoped timer that records one call when it goes out of scope.
+  class Timer {
+  public:
+    Timer(ToolCallProfile& prf, Method imet, Count nchan)
+    : m_prf(prf), m_imet(imet), m_nchan(nchan), m_start(Clock::now()) { }
+    Timer(const Timer&) =delete;
+    Timer& operator=(const Timer&) =delete;
+    ~Timer() {
+      Count nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count();
+      m_prf.record(m_imet, m_nchan, nsec, m_bytes);
+    }
+    void addBytes(long nbyte) { m_bytes += nbyte; }
+  private:
+    ToolCallProfile& m_prf;
+    Method m_imet;
+    Count m_nchan;
+    long m_bytes = 0;
+    Clock::time_point m_start;
+  };
+
+  // Return the profile registered with a label, creating it if needed.
+  static std::shared_ptr<ToolCallProfile> registered(const Name& label);
+
+  // Print the summary table for all registered profiles, ordered by decreasing time.
+  static void printAll(std::ostream& out =std::cout, Name prefix ="");
+
+  // Ctor.
+  explicit ToolCallProfile(const Name& label) : m_label(label) { }
+
+  // Record one call.
+  void record(Index imet, Count nchan, Count nsec, long nbyte);
+
+  // Clear the counts.
+  void reset();
+
+  // Return the label.
+  const Name& label() const { return m_label; }
+
+  // Return the counts for a method and the sum over methods.
+  Entry entry(Index imet) const;
+  Entry total() const;
+
+  // Print the summary table for this profile.
+  void print(std::ostream& out =std::cout, Name prefix ="") const;
+
+private:
+
+  struct AtomicEntry {
+    std::atomic<Count> calls {0};
+    std::atomic<Count> channels {0};
+    std::atomic<Count> nanoseconds {0};
+    std::atomic<long> bytes {0};
+  };
+
+  // Print the table header and one row.
+  static void printHeader(std::ostream& out, const Name& prefix);
+  static void printRow(std::ostream& out, const Name& prefix, const Name& label,
+                       const Name& snam, const Entry& ent);
+
+  Name m_label;
+  std::array<AtomicEntry, NMethod> m_ents;
+
+};
+
+#endif
@@ -68,6 +68,36 @@ double cePulser(int ia, const double rfLines[6], double r6, double qvscale) {
 
 //**********************************************************************
 
+// Table of cePulser for all gain settings ia = -63 to 63 for fixed circuit
+// parameters, e.g. to simulate many pulses or channels with the same pulser.
+class CePulserTable {
+
+public:
+
+  // Ctor from the cePulser parameters.
+  CePulserTable(const double rfLines[6], double r6, double qvscale) {
+    double v0 = cePulserVoltage(0, rfLines, r6, qvscale);
+    m_vals[0] = 0.0;
+    for ( int ia=1; ia<64; ++ia ) m_vals[ia] = cePulserVoltage(ia, rfLines, r6, qvscale) - v0;
+  }
+
+  // Ctor from the Root parameter array used in cePulser(x, pars).
+  explicit CePulserTable(const double* pars) : CePulserTable(pars, pars[6], pars[7]) { }
+
+  // Same as cePulser(ia, rfLines, r6, qvscale).
+  double operator()(int ia) const {
+    if ( ia < 0 ) ia = -ia;
+    return ia < 64 ? m_vals[ia] : 0.0;
+  }
+
+private:
+
+  double m_vals[64];
+
+};
+
+//**********************************************************************
+
 // Pulser functions with Root syntax.
 inline
 double cePulserVoltage(double* x, double* pars) {
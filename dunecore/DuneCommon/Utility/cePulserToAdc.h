@@ -29,6 +29,15 @@ double cePulserToAdc(int ia, double adcScale, double pedestal, double negScale,
   return dadc + pedestal;
 }
 
+// Same using a table of the pulser response.
+inline
+double cePulserToAdc(int ia, double adcScale, double pedestal, double negScale,
+                     const CePulserTable& pulser) {
+  double dadc = adcScale*pulser(ia);
+  if ( ia < 0 ) dadc *= negScale;
+  return dadc + pedestal;
+}
+
 double cePulserToAdc(double* x, double* pars) {
   int ia = x[0];
   double adcScale = pars[0];
@@ -0,0 +1,236 @@
+// bench_FFT.cxx
+//
+// Throughput benchmark for the DFT utilities DuneFFT, FwFFT, FwFloatFFT and Fw2dFFT.
+//
+// The transforms are timed for realistic data sizes over the plan options, batch
+// sizes and thread counts so that the FFT configuration for a detector can be chosen
+// from measurements. For each configuration one transform is made to build the plan
+// and that is followed by NREP timed transforms. The rates are reported in
+// transforms/s and in GB/s of input plus output data.
+//
+// If DUNE_BENCH_DB is set, the median and spread of the rates of the individual
+// timed transforms are added to that BenchmarkDB file for comparison with benchcompare.
+//
+// Usage: bench_FFT [WHAT] [NREP]
+//   WHAT = 1d, batch, 2d or all [all]
+//   NREP = number of timed transforms (or batches) for each configuration [20]
+//
+// This is not run by ctest.
+
+#include "dunecore/DuneCommon/Utility/DuneFFT.h"
+#include "dunecore/DuneCommon/Utility/FwFFT.h"
+#include "dunecore/DuneCommon/Utility/Fw2dFFT.h"
+#include "dunecore/DuneCommon/Utility/BenchmarkDB.h"
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <functional>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::setw;
+using std::vector;
+
+using Index = unsigned int;
+using FloatVector = std::vector<float>;
+using DFT = FwFFT::DFT;
+using Norm = RealDftNormalization;
+using IndexArray = Fw2dFFT::IndexArray;
+
+//**********************************************************************
+
+namespace {
+
+// Sample values with some structure.
+FloatVector makeSamples(Index nsam) {
+  FloatVector sams(nsam);
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    sams[isam] = 10.0*sin(0.013*isam) + 3.0*cos(0.37*isam) + 0.001*(isam%17);
+  }
+  return sams;
+}
+
+// Times nrep calls to fun after one untimed call and prints the rates.
+// ntran = transforms per call, nbyte = bytes read and written per call.
+// The rate of each call is recorded in the benchmark database as kernel "name size".
+void timeit(string name, string size, Index nrep, double ntran, double nbyte, std::function<int()> fun) {
+  if ( fun() ) {
+    cout << "  " << std::left << setw(40) << name << std::right << "   FAILED" << endl;
+    return;
+  }
+  vector<double> rates;
+  rates.reserve(nrep);
+  double dt = 0.0;
+  for ( Index irep=0; irep<nrep; ++irep ) {
+    auto t0 = std::chrono::steady_clock::now();
+    fun();
+    auto t1 = std::chrono::steady_clock::now();
+    double dtrep = std::chrono::duration<double>(t1 - t0).count();
+    if ( dtrep <= 0.0 ) dtrep = 1.e-9;
+    rates.push_back(ntran/dtrep);
+    dt += dtrep;
+  }
+  if ( dt <= 0.0 ) dt = 1.e-9;
+  cout << "  " << std::left << setw(40) << name << std::right
+       << std::fixed << std::setprecision(1)
+       << setw(12) << nrep*ntran/dt << " transforms/s"
+       << std::setprecision(3)
+       << setw(10) << 1.e-9*nrep*nbyte/dt << " GB/s" << endl;
+  cout.unsetf(std::ios::floatfield);
+  BenchmarkDB::record("bench_FFT " + name + " " + size, "rate", "transforms/s", true, rates);
+}
+
+const vector<Index> nsams1d = {2000, 4492, 6000, 8192, 10000};
+const vector<Index> opts = {0, 1, 2};
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int bench_1d(Index nrep) {
+  const string myname = "bench_FFT: ";
+  string line = "-----------------------------";
+  cout << myname << line << endl;
+  cout << myname << "1D forward and inverse transforms." << endl;
+  Norm norm(Norm::Consistent, Norm::Power);
+  for ( Index nsam : nsams1d ) {
+    FloatVector sams = makeSamples(nsam);
+    cout << myname << "Sample count: " << nsam << endl;
+    string ssize = "nsam " + std::to_string(nsam);
+    Index ncmp = nsam/2 + 1;
+    double nbyteD = nsam*sizeof(float) + ncmp*2*sizeof(double);
+    double nbyteF = nsam*sizeof(float) + ncmp*2*sizeof(float);
+    DFT dft(norm);
+    FloatVector out;
+    DuneFFT::setBackend(DuneFFT::Root);
+    timeit("DuneFFT Root forward", ssize, nrep, 1, nbyteD,
+           [&]() { return DuneFFT::fftForward(sams, dft); });
+    DuneFFT::setBackend(DuneFFT::Fftw);
+    timeit("DuneFFT Fftw forward", ssize, nrep, 1, nbyteD,
+           [&]() { return DuneFFT::fftForward(sams, dft); });
+    timeit("DuneFFT Fftw inverse", ssize, nrep, 1, nbyteD,
+           [&]() { return DuneFFT::fftInverse(dft, out); });
+    for ( Index opt : opts ) {
+      string sopt = " opt " + std::to_string(opt);
+      FwFFT xf(nsam, opt);
+      FwFFT::Workspace work(nsam);
+      timeit("FwFFT forward" + sopt, ssize, nrep, 1, nbyteD,
+             [&]() { return xf.fftForward(nsam, &sams[0], dft, work); });
+      timeit("FwFFT inverse" + sopt, ssize, nrep, 1, nbyteD,
+             [&]() { return xf.fftInverse(dft, out, work); });
+      FwFFT::HalfComplexDFT hdft(norm);
+      timeit("FwFFT half-complex forward" + sopt, ssize, nrep, 1, nbyteD,
+             [&]() { return xf.fftForward(nsam, &sams[0], hdft, work); });
+      FwFloatFFT xff(nsam, opt);
+      FwFloatFFT::Workspace fwork(nsam);
+      timeit("FwFloatFFT forward" + sopt, ssize, nrep, 1, nbyteF,
+             [&]() { return xff.fftForward(nsam, &sams[0], dft, fwork); });
+      FwFloatFFT::HalfComplexDFT fhdft(norm);
+      timeit("FwFloatFFT half-complex forward" + sopt, ssize, nrep, 1, nbyteF,
+             [&]() { return xff.fftForward(nsam, &sams[0], fhdft, fwork); });
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int bench_batch(Index nrep) {
+  const string myname = "bench_FFT: ";
+  string line = "-----------------------------";
+  cout << myname << line << endl;
+  cout << myname << "Batched 1D forward transforms." << endl;
+  Norm norm(Norm::Consistent, Norm::Power);
+  const vector<Index> nbats = {1, 8, 32, 64};
+  for ( Index nsam : nsams1d ) {
+    FloatVector sams = makeSamples(nsam);
+    cout << myname << "Sample count: " << nsam << endl;
+    string ssize = "nsam " + std::to_string(nsam);
+    double nbyte = nsam*sizeof(float) + (nsam/2 + 1)*2*sizeof(double);
+    for ( Index opt : opts ) {
+      FwFFT xf(nsam, opt);
+      for ( Index nbat : nbats ) {
+        FwFFT::SamplePointerVector psams(nbat, &sams[0]);
+        FwFFT::DFTVector dfts(nbat, DFT(norm));
+        FwFFT::Workspace work(nsam, nbat);
+        string name = "FwFFT batch " + std::to_string(nbat) + " opt " + std::to_string(opt);
+        timeit(name, ssize, nrep, nbat, nbat*nbyte,
+               [&]() { return xf.fftForwardBatch(nsam, psams, dfts, work); });
+      }
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int bench_2d(Index nrep) {
+  const string myname = "bench_FFT: ";
+  string line = "-----------------------------";
+  cout << myname << line << endl;
+  cout << myname << "2D forward and backward transforms." << endl;
+  Norm norm(Norm::Consistent, Norm::Power);
+  const vector<IndexArray> nsamss = {{480, 6000}, {800, 6000}, {1280, 8192}, {2560, 8192}};
+  const vector<Index> nthrs = {1, 2, 4, 0};
+  for ( const IndexArray& nsams : nsamss ) {
+    Index nrow = nsams[0];
+    Index ncol = nsams[1];
+    cout << myname << "Data size: " << nrow << " x " << ncol << endl;
+    string ssize = "size " + std::to_string(nrow) + "x" + std::to_string(ncol);
+    Fw2dFFT::Data dat(nsams, makeSamples(nrow*ncol));
+    Index ndft = 2*nrow*(ncol/2 + 1);
+    double nbyte = nrow*ncol*sizeof(float) + ndft*sizeof(double);
+    // Patient plans for the largest sizes take too long to be useful here.
+    for ( Index opt : {0u, 1u} ) {
+      for ( Index nthr : nthrs ) {
+        Fw2dFFT xf(ndft, opt, nthr);
+        Fw2dFFT::DFT dft(norm, nsams);
+        Fw2dFFT::Data out;
+        string sconf = " opt " + std::to_string(opt) + " threads " + std::to_string(nthr);
+        timeit("Fw2dFFT forward" + sconf, ssize, nrep, 1, nbyte,
+               [&]() { return xf.fftForward(dat, dft); });
+        timeit("Fw2dFFT backward" + sconf, ssize, nrep, 1, nbyte,
+               [&]() { return xf.fftBackward(dft, out); });
+      }
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int main(int argc, const char* argv[]) {
+  string what = "all";
+  Index nrep = 20;
+  if ( argc > 1 ) {
+    what = argv[1];
+    if ( what == "-h" ) {
+      cout << argv[0] << ": [WHAT] [NREP]" << endl;
+      cout << "  WHAT: 1d, batch, 2d or all [all]" << endl;
+      cout << "  NREP: Number of timed transforms for each configuration [20]" << endl;
+      return 0;
+    }
+  }
+  if ( argc > 2 ) {
+    std::istringstream ssarg(argv[2]);
+    ssarg >> nrep;
+  }
+  bool all = what == "all";
+  bool found = false;
+  int rstat = 0;
+  if ( all || what == "1d" ) { found = true; rstat += bench_1d(nrep); }
+  if ( all || what == "batch" ) { found = true; rstat += bench_batch(nrep); }
+  if ( all || what == "2d" ) { found = true; rstat += bench_2d(nrep); }
+  if ( ! found ) {
+    cout << argv[0] << ": Invalid selection: " << what << endl;
+    return 1;
+  }
+  return rstat;
+}
+
+//**********************************************************************
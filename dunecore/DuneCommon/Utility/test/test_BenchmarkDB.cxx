@@ -0,0 +1,160 @@
+// test_BenchmarkDB.cxx
+//
+// Test BenchmarkDB.
+
+#include "dunecore/DuneCommon/Utility/BenchmarkDB.h"
+#include <string>
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = BenchmarkDB::Index;
+using Result = BenchmarkDB::Result;
+using DoubleVector = BenchmarkDB::DoubleVector;
+
+//**********************************************************************
+
+int test_BenchmarkDB() {
+  const string myname = "test_BenchmarkDB: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  string fname = "test_BenchmarkDB.db";
+  std::remove(fname.c_str());
+
+  cout << myname << line << endl;
+  cout << myname << "Summarize measurements." << endl;
+  Result res = BenchmarkDB::summarize("kern", "time", "ns", false, {10.0, 12.0, 11.0, 50.0, 9.0});
+  assert( res.count == 5 );
+  assert( res.value == 11.0 );
+  assert( std::fabs(res.spread - 1.4826) < 1.e-6 );
+  res = BenchmarkDB::summarize("kern", "time", "ns", false, {4.0});
+  assert( res.value == 4.0 );
+  assert( res.spread == 0.0 );
+  res = BenchmarkDB::summarize("kern", "time", "ns", false, {});
+  assert( res.count == 0 );
+  assert( res.value == 0.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check a missing read-only file." << endl;
+  assert( ! BenchmarkDB(fname, true).isValid() );
+
+  cout << myname << line << endl;
+  cout << myname << "Fill a baseline and a new run." << endl;
+  {
+    BenchmarkDB db(fname);
+    assert( db.isValid() );
+    assert( db.fileName() == fname );
+    assert( db.runs().empty() );
+    // Quiet kernels.
+    assert( db.add("base", BenchmarkDB::summarize("fast", "time", "ns", false, {100, 101, 99})) == 0 );
+    assert( db.add("base", BenchmarkDB::summarize("rate", "rate", "Hz", true, {100, 101, 99})) == 0 );
+    assert( db.add("base", BenchmarkDB::summarize("same", "time", "ns", false, {100, 101, 99})) == 0 );
+    // Noisy kernel.
+    assert( db.add("base", BenchmarkDB::summarize("noisy", "time", "ns", false, {100, 80, 120})) == 0 );
+    assert( db.add("base", BenchmarkDB::summarize("gone", "time", "ns", false, {5})) == 0 );
+    assert( db.add("new", BenchmarkDB::summarize("fast", "time", "ns", false, {120, 121, 119})) == 0 );
+    assert( db.add("new", BenchmarkDB::summarize("rate", "rate", "Hz", true, {120, 121, 119})) == 0 );
+    assert( db.add("new", BenchmarkDB::summarize("same", "time", "ns", false, {102, 103, 101})) == 0 );
+    assert( db.add("new", BenchmarkDB::summarize("noisy", "time", "ns", false, {120, 100, 140})) == 0 );
+    assert( db.add("new", BenchmarkDB::summarize("extra", "time", "ns", false, {5})) == 0 );
+    // Replace a result.
+    assert( db.add("new", BenchmarkDB::summarize("extra", "time", "ns", false, {6})) == 0 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Read back." << endl;
+  BenchmarkDB db(fname, true);
+  assert( db.isValid() );
+  BenchmarkDB::NameVector runs = db.runs();
+  assert( runs.size() == 2 );
+  assert( runs[0] == "base" );
+  assert( runs[1] == "new" );
+  BenchmarkDB::ResultVector ress = db.results("new");
+  assert( ress.size() == 5 );
+  assert( ress[0].kernel == "extra" );
+  assert( ress[0].value == 6.0 );
+  assert( ress[0].count == 1 );
+  assert( ress[3].kernel == "rate" );
+  assert( ress[3].higherIsBetter );
+  assert( ress[3].unit == "Hz" );
+  assert( db.results("nosuchrun").empty() );
+
+  cout << myname << line << endl;
+  cout << myname << "Compare." << endl;
+  BenchmarkDB::ComparisonVector cmps = db.compare("base", "new");
+  assert( cmps.size() == 6 );
+  Index nchk = 0;
+  for ( const BenchmarkDB::Comparison& cmp : cmps ) {
+    cout << myname << "  " << cmp.kernel << ": " << BenchmarkDB::statusName(cmp.status)
+         << " change " << cmp.change << ", threshold " << cmp.threshold << endl;
+    if ( cmp.kernel == "fast" ) {
+      assert( cmp.status == BenchmarkDB::Regressed );
+      assert( std::fabs(cmp.change + 0.2) < 1.e-9 );
+      ++nchk;
+    } else if ( cmp.kernel == "rate" ) {
+      assert( cmp.status == BenchmarkDB::Improved );
+      assert( std::fabs(cmp.change - 0.2) < 1.e-9 );
+      ++nchk;
+    } else if ( cmp.kernel == "same" ) {
+      assert( cmp.status == BenchmarkDB::Unchanged );
+      assert( cmp.threshold >= 0.05 );
+      assert( cmp.threshold < 0.1 );
+      ++nchk;
+    } else if ( cmp.kernel == "noisy" ) {
+      assert( cmp.status == BenchmarkDB::Unchanged );
+      assert( cmp.threshold > 0.2 );
+      ++nchk;
+    } else if ( cmp.kernel == "extra" ) {
+      assert( cmp.status == BenchmarkDB::Added );
+      ++nchk;
+    } else if ( cmp.kernel == "gone" ) {
+      assert( cmp.status == BenchmarkDB::Removed );
+      assert( cmp.baseValue == 5.0 );
+      ++nchk;
+    }
+  }
+  assert( nchk == 6 );
+  // A looser tolerance hides the regression.
+  for ( const BenchmarkDB::Comparison& cmp : db.compare("base", "new", 0.25) ) {
+    assert( cmp.status != BenchmarkDB::Regressed );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Remove a run." << endl;
+  {
+    BenchmarkDB wdb(fname);
+    assert( wdb.remove("new") == 0 );
+    assert( wdb.runs().size() == 1 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check recording without an environment database." << endl;
+  unsetenv("DUNE_BENCH_DB");
+  assert( BenchmarkDB::fromEnvironment() == nullptr );
+  assert( BenchmarkDB::record("kern", "time", "ns", false, {1.0}) == 0 );
+  assert( BenchmarkDB::environmentRun().size() > 0 );
+
+  std::remove(fname.c_str());
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_BenchmarkDB();
+}
+
+//**********************************************************************
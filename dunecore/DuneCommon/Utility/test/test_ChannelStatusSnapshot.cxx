@@ -0,0 +1,108 @@
+// test_ChannelStatusSnapshot.cxx
+//
+// Test ChannelStatusSnapshot: status capping, category bits and counts, and
+// the channel lists across word boundaries.
+
+#undef NDEBUG
+
+#include "dunecore/DuneCommon/Utility/ChannelStatusSnapshot.h"
+#include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include <string>
+#include <iostream>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using Index = ChannelStatusSnapshot::Index;
+using IndexVector = ChannelStatusSnapshot::IndexVector;
+using SnapshotPtr = ChannelStatusSnapshot::SnapshotPtr;
+
+//**********************************************************************
+
+int test_ChannelStatusSnapshot() {
+  const string myname = "test_ChannelStatusSnapshot: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Build snapshot." << endl;
+  const Index ncha = 200;
+  IndexVector stats(ncha, AdcChannelStatusGood);
+  IndexVector expBad = {0, 63, 64, 130, 199};
+  IndexVector expNoisy = {5, 127, 128};
+  for ( Index icha : expBad ) stats[icha] = AdcChannelStatusBad;
+  for ( Index icha : expNoisy ) stats[icha] = AdcChannelStatusNoisy;
+  stats[10] = 1000;
+  SnapshotPtr psnap = std::make_shared<const ChannelStatusSnapshot>(stats);
+  cout << myname << "  # channels: " << psnap->size() << endl;
+  cout << myname << "       # bad: " << psnap->count(ChannelStatusSnapshot::Bad) << endl;
+  cout << myname << "     # noisy: " << psnap->count(ChannelStatusSnapshot::Noisy) << endl;
+  assert( psnap->size() == ncha );
+  assert( psnap->count(ChannelStatusSnapshot::Bad) == expBad.size() );
+  assert( psnap->count(ChannelStatusSnapshot::Noisy) == expNoisy.size() );
+  assert( psnap->count(ChannelStatusSnapshot::Good) == ncha - expBad.size() - expNoisy.size() );
+
+  cout << myname << line << endl;
+  cout << myname << "Check status and categories." << endl;
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    Index expStat = stats[icha] < ChannelStatusSnapshot::MaxStatus ? stats[icha] : ChannelStatusSnapshot::MaxStatus;
+    assert( psnap->hasChannel(icha) );
+    assert( psnap->status(icha) == expStat );
+    ChannelStatusSnapshot::Category icat = ChannelStatusSnapshot::category(stats[icha]);
+    assert( psnap->isGood(icha) == (icat == ChannelStatusSnapshot::Good) );
+    assert( psnap->isBad(icha) == (icat == ChannelStatusSnapshot::Bad) );
+    assert( psnap->isNoisy(icha) == (icat == ChannelStatusSnapshot::Noisy) );
+  }
+  assert( psnap->isGood(10) );
+  assert( ! psnap->hasChannel(ncha) );
+  assert( psnap->status(ncha) == ChannelStatusSnapshot::MaxStatus );
+  assert( psnap->status(ncha, 7) == 7 );
+  assert( ! psnap->isGood(ncha) );
+  assert( ! psnap->isBad(ncha) );
+  assert( ! psnap->isNoisy(ncha) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check channel lists." << endl;
+  assert( psnap->channels(ChannelStatusSnapshot::Bad) == expBad );
+  assert( psnap->channels(ChannelStatusSnapshot::Noisy) == expNoisy );
+  assert( psnap->channels(ChannelStatusSnapshot::Good).size() == psnap->count(ChannelStatusSnapshot::Good) );
+  assert( psnap->bits(ChannelStatusSnapshot::Bad).size() == (ncha + 63)/64 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check empty snapshot." << endl;
+  ChannelStatusSnapshot empty{IndexVector()};
+  assert( empty.size() == 0 );
+  assert( empty.count(ChannelStatusSnapshot::Good) == 0 );
+  assert( empty.channels(ChannelStatusSnapshot::Bad).empty() );
+  assert( ! empty.isGood(0) );
+  assert( ChannelStatusSnapshot::fromIndexMap(nullptr, 10) == nullptr );
+
+  cout << myname << line << endl;
+  cout << myname << "Check the content hash." << endl;
+  assert( psnap->contentHash() == ChannelStatusSnapshot::contentHash(stats) );
+  assert( psnap->matches(stats) );
+  IndexVector statsCapped = stats;
+  statsCapped[10] = 2000;
+  assert( psnap->matches(statsCapped) );
+  IndexVector statsNew = stats;
+  statsNew[20] = AdcChannelStatusBad;
+  assert( ChannelStatusSnapshot::contentHash(statsNew) != psnap->contentHash() );
+  assert( ! psnap->matches(statsNew) );
+  assert( ! psnap->matches(IndexVector(stats.begin(), stats.end() - 1)) );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_ChannelStatusSnapshot();
+}
+
+//**********************************************************************
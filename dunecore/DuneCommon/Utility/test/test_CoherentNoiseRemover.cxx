@@ -0,0 +1,125 @@
+// test_CoherentNoiseRemover.cxx
+//
+// Test CoherentNoiseRemover.
+
+#undef NDEBUG
+
+#include "../CoherentNoiseRemover.h"
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = CoherentNoiseRemover::Index;
+using FloatVector = CoherentNoiseRemover::FloatVector;
+
+//**********************************************************************
+
+bool areEqual(double x1, double x2, double tol =1.e-5) {
+  return fabs(x1 - x2) < tol;
+}
+
+//**********************************************************************
+
+int test_CoherentNoiseRemover() {
+  const string myname = "test_CoherentNoiseRemover: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Row statistics." << endl;
+  FloatVector blk = {3.0, 1.0, 2.0, 10.0,
+                     4.0, 1.0, 3.0,  2.0,
+                     5.0, 0.0, 0.0,  0.0};
+  std::vector<Index> counts = {3, 4, 1};
+  FloatVector out(3);
+  FloatVector blk2 = blk;
+  CoherentNoiseRemover::rowStatistic(CoherentNoiseRemover::Median, blk2.data(), 3, 4, counts.data(), out.data());
+  assert( areEqual(out[0], 2.0) );
+  assert( areEqual(out[1], 2.5) );
+  assert( areEqual(out[2], 5.0) );
+  blk2 = blk;
+  CoherentNoiseRemover::rowStatistic(CoherentNoiseRemover::Mean, blk2.data(), 3, 4, counts.data(), out.data());
+  assert( areEqual(out[0], 2.0) );
+  assert( areEqual(out[1], 2.5) );
+  assert( areEqual(out[2], 5.0) );
+
+  cout << myname << line << endl;
+  cout << myname << "Remove coherent noise." << endl;
+  Index ntick = 50;
+  Index ngrp = 6;
+  Index nchaPerGroup = 9;
+  CoherentNoiseRemover::ChannelVectorVector groups(ngrp);
+  AdcChannelDataMap acds;
+  for ( Index igrp=0; igrp<ngrp; ++igrp ) {
+    for ( Index ich=0; ich<nchaPerGroup; ++ich ) {
+      AdcChannel icha = 100*igrp + ich;
+      groups[igrp].push_back(icha);
+      AdcChannelData& acd = acds[icha];
+      acd.samples.resize(ntick);
+      acd.signal.assign(ntick, false);
+      for ( Index itck=0; itck<ntick; ++itck ) {
+        // Coherent noise plus a small channel offset.
+        acd.samples[itck] = (igrp + 1)*std::sin(0.3*itck) + 0.01*(int(ich) - 4);
+      }
+    }
+    // A signal in one channel that must not bias the median.
+    AdcChannelData& acd = acds[100*igrp];
+    for ( Index itck=20; itck<25; ++itck ) {
+      acd.samples[itck] += 100.0;
+      acd.signal[itck] = true;
+    }
+  }
+  // A group channel that is not in the data.
+  groups[0].push_back(99);
+  for ( Index nthr : {1u, 0u} ) {
+    AdcChannelDataMap acdsCopy;
+    for ( const auto& iacd : acds ) {
+      acdsCopy[iacd.first].samples = iacd.second.samples;
+      acdsCopy[iacd.first].signal = iacd.second.signal;
+    }
+    CoherentNoiseRemover cnr(CoherentNoiseRemover::Median, true, nthr);
+    std::vector<FloatVector> noise;
+    assert( cnr.update(acdsCopy, groups, &noise) == 0 );
+    assert( noise.size() == ngrp );
+    for ( Index igrp=0; igrp<ngrp; ++igrp ) {
+      assert( noise[igrp].size() == ntick );
+      for ( Index itck=0; itck<ntick; ++itck ) {
+        // Excluding the signal channel leaves an even count and shifts the median.
+        float shift = itck >= 20 && itck < 25 ? 0.005 : 0.0;
+        assert( areEqual(noise[igrp][itck], (igrp + 1)*std::sin(0.3*itck) + shift, 1.e-4) );
+      }
+      for ( Index ich=0; ich<nchaPerGroup; ++ich ) {
+        const AdcChannelData& acd = acdsCopy[100*igrp + ich];
+        float sig = ich == 0 ? 100.0 : 0.0;
+        assert( areEqual(acd.samples[10], 0.01*(int(ich) - 4), 1.e-4) );
+        assert( areEqual(acd.samples[22], sig + 0.01*(int(ich) - 4) - 0.005, 1.e-4) );
+      }
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Reject overlapping groups." << endl;
+  groups[1].push_back(groups[2][0]);
+  CoherentNoiseRemover cnr;
+  assert( cnr.update(acds, groups) == 1 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_CoherentNoiseRemover();
+}
+
+//**********************************************************************
@@ -0,0 +1,173 @@
+// test_CompiledParFormula.cxx
+//
+// This is a test and demonstration for CompiledParFormula.
+
+#undef NDEBUG
+
+#include "../CompiledParFormula.h"
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <thread>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using Index = unsigned int;
+using DVec = std::vector<double>;
+
+//**********************************************************************
+
+namespace {
+
+bool floatcheck(double x1, double x2) {
+  return fabs(x1-x2) < 1.e-10*(1.0 + fabs(x2));
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_CompiledParFormula() {
+  const string myname = "test_CompiledParFormula: ";
+  cout << myname << "Starting test" << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create formula and check." << endl;
+  string snam = "myform";
+  string sform = "[offset] + [scale]*x";
+  CompiledParFormula cpf(snam, sform);
+  assert( cpf.status() == 0 );
+  assert( cpf.name() == snam );
+  assert( cpf.formulaString() == sform );
+  assert( cpf.npar() == 2 );
+  assert( cpf.pars()[0] == "offset" );
+  assert( cpf.pars()[1] == "scale" );
+  assert( cpf.nvar() == 1 );
+  assert( cpf.setPars().size() == 0 );
+  assert( cpf.unsetPars().size() == 2 );
+  assert( cpf.resetPars().size() == 0 );
+  assert( ! cpf.ready() );
+  assert( cpf.isPar("offset") );
+  assert( ! cpf.isPar("nosuch") );
+
+  cout << myname << line << endl;
+  cout << myname << "Set parameters and evaluate." << endl;
+  assert( cpf.setParValue("offset", 10.0) == 0 );
+  assert( ! cpf.ready() );
+  assert( cpf.setParValue("scale", 3.0) == 0 );
+  assert( cpf.ready() );
+  assert( cpf.setParValue("scale", 2.0) == 0 );
+  assert( cpf.resetPars().size() == 1 );
+  assert( cpf.setParValue("nosuch", 2.0) != 0 );
+  DVec vals = { 0.0, 1.0, 2.0 };
+  DVec evcs = { 10.0, 12.0, 14.0 };
+  for ( Index ival=0; ival<vals.size(); ++ival ) {
+    assert( floatcheck(cpf.eval(vals[ival]), evcs[ival]) );
+    assert( floatcheck(cpf.eval(DVec(1, vals[ival])), evcs[ival]) );
+  }
+  DVec outs(vals.size());
+  cpf.evalMany(vals.data(), vals.size(), outs.data());
+  for ( Index ival=0; ival<vals.size(); ++ival ) assert( floatcheck(outs[ival], evcs[ival]) );
+  assert( cpf.setDefaultEval(99.0) == 0 );
+  assert( cpf.unsetParValues() == 0 );
+  assert( ! cpf.ready() );
+  assert( floatcheck(cpf.eval(0.0), 99.0) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check syntax." << endl;
+  {
+    double x = 0.7;
+    double y = -1.3;
+    double p0 = 2.5;
+    double pb = 0.25;
+    vector<std::pair<string, double>> checks = {
+      {"[0]*x*x - [b]", p0*x*x - pb},
+      {"-x^2", -x*x},
+      {"2^-1", 0.5},
+      {"2**3**2", 512.0},
+      {"[0]*sin(x) + cos(y)/[b]", p0*sin(x) + cos(y)/pb},
+      {"TMath::Exp(-x/[b]) + TMath::Power(x, 3)", exp(-x/pb) + pow(x, 3)},
+      {"sqrt(abs(y)) + log10(100) + atan2(y, x)", sqrt(fabs(y)) + 2.0 + atan2(y, x)},
+      {"(x > 0.5)*[0] + (y >= 0 || x < 1)*10 + !(x == 0.7)", p0 + 10.0},
+      {"min(x, y) + max(x, y) + 1.e-3 + pi", x + y + 1.e-3 + M_PI},
+      {"x[0] + 2*x[1]", x + 2*y},
+      {"x + y*z", x + y*4.0},
+    };
+    for ( const auto& chk : checks ) {
+      CompiledParFormula form("chk", chk.first);
+      cout << myname << "  " << chk.first << ": status " << form.status() << endl;
+      assert( form.status() == 0 );
+      form.setParValue("0", p0);
+      form.setParValue("b", pb);
+      assert( form.ready() );
+      DVec vars = {x, y, 4.0};
+      double val = form.eval(vars);
+      cout << myname << "    " << val << " ?= " << chk.second << endl;
+      assert( floatcheck(val, chk.second) );
+    }
+    for ( string sbad : {"", "x +", "sin x", "[a", "foo(x)", "(x", "1 2", "pow(x)"} ) {
+      CompiledParFormula form("bad", sbad);
+      cout << myname << "  \"" << sbad << "\": " << form.error() << endl;
+      assert( form.status() != 0 );
+      assert( ! form.ready() );
+      assert( form.eval(1.0) == form.defaultEval() );
+    }
+    CompiledParFormula form0("const", "[a]*2");
+    assert( form0.nvar() == 0 );
+    form0.setParValue("a", 4.0);
+    assert( floatcheck(form0.eval(), 8.0) );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Evaluate concurrently." << endl;
+  {
+    CompiledParFormula form("thr", "[a]*x[0] + [b]*x[1]*x[1]");
+    form.setParValue("a", 2.0);
+    form.setParValue("b", 0.5);
+    assert( form.nvar() == 2 );
+    Index nset = 1000;
+    DVec vars(2*nset);
+    for ( Index iset=0; iset<nset; ++iset ) {
+      vars[2*iset] = iset;
+      vars[2*iset+1] = 0.01*iset;
+    }
+    Index nthr = 4;
+    vector<DVec> outs(nthr, DVec(nset));
+    vector<std::thread> thrs;
+    for ( Index ithr=0; ithr<nthr; ++ithr ) {
+      thrs.emplace_back([&form, &vars, &outs, ithr, nset]() {
+        form.evalMany(vars.data(), nset, outs[ithr].data());
+      });
+    }
+    for ( std::thread& thr : thrs ) thr.join();
+    for ( Index ithr=0; ithr<nthr; ++ithr ) {
+      for ( Index iset=0; iset<nset; ++iset ) {
+        double x0 = vars[2*iset];
+        double x1 = vars[2*iset+1];
+        assert( floatcheck(outs[ithr][iset], 2.0*x0 + 0.5*x1*x1) );
+      }
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_CompiledParFormula();
+}
+
+//**********************************************************************
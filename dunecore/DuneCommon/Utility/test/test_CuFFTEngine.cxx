@@ -0,0 +1,124 @@
+// test_CuFFTEngine.cxx
+//
+// Test the batched convolution of FwFloatFFT and CuFFTEngine against a direct
+// circular convolution. The GPU part is skipped if there is no cuFFT device.
+
+#include "dunecore/DuneCommon/Utility/FwFFT.h"
+#include "dunecore/DuneCommon/Utility/CuFFTEngine.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using Index = unsigned int;
+using Complex = FwFloatFFT::Complex;
+
+//**********************************************************************
+
+int test_CuFFTEngine(Index nsam, Index nrow) {
+  const string myname = "test_CuFFTEngine: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create " << nrow << " channels of " << nsam << " samples." << endl;
+  vector<float> sams(nrow*nsam);
+  for ( Index irow=0; irow<nrow; ++irow ) {
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      sams[irow*nsam + isam] = std::sin(0.1*(irow + 1)*isam) + 0.01*((isam*7 + irow) % 13);
+    }
+  }
+  // Three-tap response and its DFT, with the 1/nsam of the inverse.
+  vector<float> resp(nsam, 0.0);
+  resp[0] = 0.5;
+  resp[1] = 0.3;
+  resp[nsam-1] = 0.2;
+  Index ncmp = nsam/2 + 1;
+  vector<Complex> ker(ncmp);
+  for ( Index icmp=0; icmp<ncmp; ++icmp ) {
+    double xre = 0.0;
+    double xim = 0.0;
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      double arg = -2.0*M_PI*icmp*isam/nsam;
+      xre += resp[isam]*std::cos(arg);
+      xim += resp[isam]*std::sin(arg);
+    }
+    ker[icmp][0] = xre/nsam;
+    ker[icmp][1] = xim/nsam;
+  }
+  vector<float> expSams(nrow*nsam, 0.0);
+  for ( Index irow=0; irow<nrow; ++irow ) {
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      double sum = 0.0;
+      for ( Index jsam=0; jsam<nsam; ++jsam ) {
+        sum += resp[jsam]*sams[irow*nsam + (isam + nsam - jsam) % nsam];
+      }
+      expSams[irow*nsam + isam] = sum;
+    }
+  }
+  auto check = [&](const vector<float>& outs) {
+    float dmax = 0.0;
+    for ( Index ival=0; ival<outs.size(); ++ival ) dmax = std::max(dmax, std::fabs(outs[ival] - expSams[ival]));
+    cout << myname << "  Maximum difference: " << dmax << endl;
+    assert( dmax < 1.e-4 );
+  };
+
+  cout << myname << line << endl;
+  cout << myname << "Convolve with FwFloatFFT." << endl;
+  FwFloatFFT cpu(nsam, 0);
+  FwFloatFFT::Workspace work(nsam, 16);
+  vector<float> cpuSams = sams;
+  assert( cpu.convolveBatch(nsam, nrow, ker.data(), cpuSams.data(), work) == 0 );
+  check(cpuSams);
+
+  cout << myname << line << endl;
+  cout << myname << "Convolve with CuFFTEngine." << endl;
+  CuFFTEngine gpu(nsam, 16);
+  cout << myname << "  Available: " << CuFFTEngine::available() << endl;
+  assert( gpu.isValid() == CuFFTEngine::available() );
+  vector<float> gpuSams = sams;
+  int gstat = gpu.convolveBatch(nsam, nrow, ker.data(), gpuSams.data());
+  if ( gpu.isValid() ) {
+    assert( gstat == 0 );
+    check(gpuSams);
+    cout << myname << "Compare the batch forward transforms." << endl;
+    FwFloatFFT::Workspace work1(nsam, 1);
+    vector<Complex> gdft(ncmp);
+    for ( Index isam=0; isam<nsam; ++isam ) work1.inData()[isam] = sams[isam];
+    assert( cpu.executeForwardBatch(nsam, 1, work1.inData(), work1.outData()) == 0 );
+    vector<float> row(sams.begin(), sams.begin() + nsam);
+    assert( gpu.executeForwardBatch(nsam, 1, row.data(), gdft.data()) == 0 );
+    for ( Index icmp=0; icmp<ncmp; ++icmp ) {
+      assert( std::fabs(gdft[icmp][0] - work1.outData()[icmp][0]) < 1.e-3 );
+      assert( std::fabs(gdft[icmp][1] - work1.outData()[icmp][1]) < 1.e-3 );
+    }
+  } else {
+    assert( gstat == 5 );
+    assert( gpuSams == sams );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  test_CuFFTEngine(64, 40);
+  test_CuFFTEngine(75, 3);
+  return 0;
+}
+
+//**********************************************************************
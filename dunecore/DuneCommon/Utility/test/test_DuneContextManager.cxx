@@ -6,6 +6,8 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 using std::string;
 using std::cout;
@@ -49,6 +51,49 @@ int test_DuneContextManager(bool useExistingFcl =false) {
   assert( pcm->context() != nullptr );
   assert( pcm->context()->getRun() == 123 );
   assert( pcm->context()->getEvent() == 456 );
+  assert( pcm->context(DuneContextManager::globalSlot()) == pevi );
+
+  cout << myname << line << endl;
+  cout << myname << "Push and pop context." << endl;
+  {
+    DuneContextManager::ScopedContext scon(new DuneEventInfo(123, 457));
+    assert( pcm->context()->getEvent() == 457 );
+  }
+  assert( pcm->context() == pevi );
+
+  cout << myname << line << endl;
+  cout << myname << "Use another slot." << endl;
+  assert( DuneContextManager::currentSlot() == DuneContextManager::globalSlot() );
+  {
+    DuneContextManager::ScopedSlot sslo(2);
+    assert( DuneContextManager::currentSlot() == 2 );
+    assert( pcm->context() == nullptr );
+    pcm->setContext(new DuneEventInfo(124, 10));
+    assert( pcm->context()->getRun() == 124 );
+  }
+  assert( DuneContextManager::currentSlot() == DuneContextManager::globalSlot() );
+  assert( pcm->context() == pevi );
+  assert( pcm->context(2)->getRun() == 124 );
+
+  cout << myname << line << endl;
+  cout << myname << "Use slots from concurrent threads." << endl;
+  std::vector<std::thread> thrs;
+  std::vector<int> nbad(4, 0);
+  for ( DuneContextManager::Index islot=0; islot<4; ++islot ) {
+    thrs.emplace_back([pcm, islot, &nbad]() {
+      DuneContextManager::ScopedSlot sslo(100 + islot);
+      for ( DuneContextManager::Index ievt=0; ievt<1000; ++ievt ) {
+        pcm->setContext(new DuneEventInfo(200 + islot, ievt));
+        const DuneContext* pctx = pcm->context();
+        if ( pctx->getRun() != 200 + islot || pctx->getEvent() != ievt ) ++nbad[islot];
+      }
+      pcm->clearSlot(100 + islot);
+      if ( pcm->context() != nullptr ) ++nbad[islot];
+    });
+  }
+  for ( std::thread& thr : thrs ) thr.join();
+  for ( int nb : nbad ) assert( nb == 0 );
+  assert( pcm->context() == pevi );
 
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
@@ -39,7 +39,9 @@ class TestContextToolRedirector : public DuneContextToolRedirector {
 public:
   TestContextToolRedirector(fhicl::ParameterSet const& ps) : DuneContextToolRedirector(ps) { }
   ~TestContextToolRedirector() { }
+  mutable Index ncall = 0;
   Name getNameInContext(const Context* pcon) const {
+    ++ncall;
     const TestContext* ptcon = dynamic_cast<const TestContext*>(pcon);
     if ( ptcon == nullptr ) return "ERROR: Not TestContext";
     return ptcon->getLabel() + std::to_string(pcon->getRun());
@@ -95,6 +97,23 @@ int test_DuneContextToolRedirector(bool useExistingFcl =false) {
   cout << "Label " << lab << " for run " << run << " returns " << nam << endl;
   assert( nam == "tool123" );
 
+  cout << myname << line << endl;
+  cout << myname << "Check the name is cached for the context." << endl;
+  Index ncall = sel.ncall;
+  assert( sel.getName() == "tool123" );
+  assert( sel.getName() == "tool123" );
+  assert( sel.ncall == ncall );
+  assert( sel.contextKey(pcon) == sel.contextKey(pcon) );
+  assert( sel.contextKey(nullptr) == DuneContextToolRedirector::nullKey() );
+  DuneContextManager::instance()->setContext(new TestContext("tool", 124));
+  assert( sel.getName() == "tool124" );
+  assert( sel.ncall == ncall + 1 );
+  assert( sel.getName() == "tool124" );
+  assert( sel.ncall == ncall + 1 );
+  DuneContextManager::instance()->setContext(new TestContext("tool", 123));
+  assert( sel.getName() == "tool123" );
+  assert( sel.ncall == ncall + 1 );
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
@@ -126,6 +126,24 @@ int test_DuneFFT(Index ignorm, Index itnorm, int loglev, Index len) {
     assert( fabs(sams2[isam] - sams[isam]) < 1.e-4 );
   }
 
+  cout << myname << line << endl;
+  cout << myname << "Compare the backends." << endl;
+  assert( DuneFFT::backend() == DuneFFT::Fftw );
+  assert( &DuneFFT::engine(nsam) == &DuneFFT::engine(nsam + 1) || nsam%64 == 0 );
+  DuneFFT::setBackend(DuneFFT::Root);
+  DFT dftRoot(norm);
+  assert( DuneFFT::fftForward(sams, dftRoot, loglev) == 0 );
+  assert( dftRoot.size() == dft.size() );
+  for ( Index ifrq=0; ifrq<namp; ++ifrq ) {
+    assert( fabs(dftRoot.real(ifrq) - dft.real(ifrq)) < 1.e-4*(1.0 + fabs(dft.amplitude(ifrq))) );
+    assert( fabs(dftRoot.imag(ifrq) - dft.imag(ifrq)) < 1.e-4*(1.0 + fabs(dft.amplitude(ifrq))) );
+  }
+  FloatVector samsRoot;
+  assert( DuneFFT::fftInverse(dft, samsRoot, loglev) == 0 );
+  assert( samsRoot.size() == nsam );
+  for ( Index isam=0; isam<nsam; ++isam ) assert( fabs(samsRoot[isam] - sams2[isam]) < 1.e-4 );
+  DuneFFT::setBackend(DuneFFT::Fftw);
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <iomanip>
 #include <cassert>
+#include <vector>
 
 using std::string;
 using std::cout;
@@ -66,6 +67,24 @@ int test_DuneTimeConverter() {
   cout << myname << "Low tolerance: " << tol << endl;
   assert( abs(lodiff) < tol );
 
+  cout << myname << line << endl;
+  cout << myname << "Convert arrays." << endl;
+  {
+    const unsigned int ntim = 1000;
+    std::vector<uint64_t> tnovas(ntim);
+    for ( unsigned int itim=0; itim<ntim; ++itim ) tnovas[itim] = tnova + 7919*itim*itim;
+    std::vector<art::Timestamp> tarts(ntim);
+    DuneTimeConverter::fromNova(tnovas.data(), ntim, tarts.data());
+    std::vector<uint64_t> tnovas2(ntim);
+    DuneTimeConverter::toNova(tarts.data(), ntim, tnovas2.data());
+    for ( unsigned int itim=0; itim<ntim; ++itim ) {
+      assert( tarts[itim] == DuneTimeConverter::fromNova(tnovas[itim]) );
+      assert( tnovas2[itim] == DuneTimeConverter::toNova(tarts[itim]) );
+      assert( tnovas2[itim] <= tnovas[itim] );
+      assert( tnovas2[itim] + 1 >= tnovas[itim] );
+    }
+  }
+
   cout << myname << line << endl;
   cout << myname << "Test creation from string." << endl;
   string stime = "1577836800.123456789";
@@ -0,0 +1,121 @@
+// test_FftwRealDftData.cxx
+//
+// Test FftwRealDftData.
+//
+// The raw terms are filled with a direct DFT and the normalized accessors are
+// compared with CompactRealDftData holding the same transform.
+
+#include "dunecore/DuneCommon/Utility/FftwRealDftData.h"
+#include "dunecore/DuneCommon/Utility/CompactRealDftData.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using Dft = FftwRealDftData<float>;
+using CompactDft = CompactRealDftData<float>;
+using Index = Dft::Index;
+using Complex = Dft::Complex;
+using Norm = RealDftNormalization;
+
+//**********************************************************************
+
+int test_FftwRealDftData(Index nsam, Index ignorm, Index itnorm) {
+  const string myname = "test_FftwRealDftData: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  Norm norm(ignorm, itnorm);
+  cout << myname << line << endl;
+  cout << myname << "# samples: " << nsam << ", normalization: " << ignorm << ", " << itnorm << endl;
+
+  cout << myname << line << endl;
+  cout << myname << "Fill DFT." << endl;
+  vector<double> sams(nsam);
+  for ( Index isam=0; isam<nsam; ++isam ) sams[isam] = 3.0*sin(0.7*isam) + 0.2*isam - 1.0;
+  Dft dft(norm, nsam);
+  assert( dft.isValid() );
+  assert( dft.nSample() == nsam );
+  assert( dft.nComplex() == nsam/2 + 1 );
+  assert( reinterpret_cast<std::uintptr_t>(dft.data())%64 == 0 );
+  const double twopi = 2.0*acos(-1.0);
+  for ( Index ifrq=0; ifrq<dft.nComplex(); ++ifrq ) {
+    double xre = 0.0;
+    double xim = 0.0;
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      xre += sams[isam]*cos(twopi*ifrq*isam/nsam);
+      xim -= sams[isam]*sin(twopi*ifrq*isam/nsam);
+    }
+    assert( dft.setRawValue(ifrq, Complex(xre, xim)) == 0 );
+  }
+  assert( dft.setRawValue(dft.nComplex(), Complex(1.0, 1.0)) == 1 );
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with the compact representation." << endl;
+  CompactDft cdft(norm, nsam);
+  float nfac = norm.isConsistent() ? 1.0/sqrt(nsam) : norm.isBin() ? 1.0/nsam : 1.0;
+  for ( Index ifrq=0; ifrq<cdft.nAmplitude(); ++ifrq ) {
+    Complex val = dft.data()[ifrq];
+    bool nyquist = ifrq >= cdft.nPhase();
+    float fac = nfac;
+    if ( norm.isPower() && dft.isAliased(ifrq) ) fac *= sqrt(2.0);
+    cdft.setAmplitude(ifrq, fac*(nyquist ? val.real() : std::abs(val)));
+    if ( ! nyquist ) cdft.setPhase(ifrq, std::arg(val));
+  }
+  for ( Index ifrq=0; ifrq<nsam; ++ifrq ) {
+    float tol = 1.e-4*(1.0 + fabs(cdft.amplitude(ifrq)));
+    assert( fabs(dft.amplitude(ifrq) - cdft.amplitude(ifrq)) < tol );
+    assert( fabs(dft.real(ifrq) - cdft.real(ifrq)) < tol );
+    if ( ifrq < dft.nComplex() ) assert( fabs(dft.imag(ifrq) - cdft.imag(ifrq)) < tol );
+    else assert( fabs(dft.imag(ifrq) + dft.imag(nsam - ifrq)) < tol );
+    assert( fabs(dft.phase(ifrq) - cdft.phase(ifrq)) < 1.e-4 );
+    assert( fabs(dft.convAmplitude(ifrq) - cdft.convAmplitude(ifrq)) < tol*nsam );
+  }
+  assert( fabs(dft.power() - cdft.power()) < 1.e-4*cdft.power() );
+
+  cout << myname << line << endl;
+  cout << myname << "Convert from the compact representation." << endl;
+  Dft dft2(cdft);
+  assert( dft2.nSample() == nsam );
+  assert( dft2.normalization().isConsistent() == norm.isConsistent() );
+  for ( Index ifrq=0; ifrq<dft.nComplex(); ++ifrq ) {
+    float tol = 1.e-4*(1.0 + std::abs(dft.data()[ifrq]));
+    assert( std::abs(dft2.data()[ifrq] - dft.data()[ifrq]) < tol );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Clear." << endl;
+  dft.clear();
+  assert( dft.size() == 0 );
+  assert( ! dft.isValid() );
+  assert( dft.amplitude(0) == dft.badValue() );
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  for ( Index nsam : {10u, 11u} ) {
+    for ( Index ignorm : {1u, 2u, 3u} ) {
+      for ( Index itnorm : {1u, 2u} ) {
+        if ( test_FftwRealDftData(nsam, ignorm, itnorm) ) return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+//**********************************************************************
@@ -0,0 +1,146 @@
+// test_FloatHist.cxx
+//
+// Test FloatHist.
+
+#undef NDEBUG
+
+#include "../FloatHist.h"
+#include "../TH1Manipulator.h"
+#include "TH1F.h"
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+using std::string;
+using std::cout;
+using std::endl;
+using Index = FloatHist::Index;
+
+//**********************************************************************
+
+bool areEqual(double x1, double x2, double tol =1.e-5) {
+  return fabs(x1 - x2) < tol;
+}
+
+//**********************************************************************
+
+int test_FloatHist() {
+  const string myname = "test_FloatHist: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create and fill." << endl;
+  FloatHist fh(10, 0.0, 20.0);
+  assert( fh.nbin() == 10 );
+  assert( areEqual(fh.binWidth(), 2.0) );
+  assert( areEqual(fh.binCenter(0), 1.0) );
+  assert( fh.findBin(-0.1) == -1 );
+  assert( fh.findBin(0.0) == 0 );
+  assert( fh.findBin(19.9) == 9 );
+  assert( fh.findBin(20.0) == 10 );
+  FloatHist::FloatVector xs = {-1.0, 0.5, 3.0, 3.5, 5.0, 19.0, 25.0};
+  fh.fill(xs);
+  fh.fill(5.0, 2.0);
+  assert( fh.entries() == 8 );
+  assert( fh.underflow() == 1.0 );
+  assert( fh.overflow() == 1.0 );
+  assert( fh.binContent(0) == 1.0 );
+  assert( fh.binContent(1) == 2.0 );
+  assert( fh.binContent(2) == 3.0 );
+  assert( fh.binContent(9) == 1.0 );
+  assert( areEqual(fh.sum(), 7.0) );
+  double xmean = (1.0 + 2*3.0 + 3*5.0 + 19.0)/7.0;
+  cout << myname << "  Mean: " << fh.mean() << endl;
+  cout << myname << "   RMS: " << fh.rms() << endl;
+  assert( areEqual(fh.mean(), xmean) );
+
+  cout << myname << line << endl;
+  cout << myname << "Convert to Root." << endl;
+  std::unique_ptr<TH1> ph(fh.makeTH1("hfh", "FloatHist"));
+  assert( ph != nullptr );
+  assert( ph->GetDirectory() == nullptr );
+  assert( ph->GetNbinsX() == 10 );
+  for ( Index ibin=0; ibin<fh.nbin(); ++ibin ) {
+    assert( ph->GetBinContent(ibin+1) == fh.binContent(ibin) );
+  }
+  assert( ph->GetBinContent(0) == fh.underflow() );
+  assert( ph->GetBinContent(11) == fh.overflow() );
+  assert( ph->GetEntries() == fh.entries() );
+  FloatHist fhin(10, 0.0, 20.0);
+  assert( fhin.copyFrom(ph.get()) == 0 );
+  assert( fhin.contents() == fh.contents() );
+  FloatHist fhbad(5, 0.0, 20.0);
+  assert( fhbad.copyFrom(ph.get()) != 0 );
+  assert( fhbad.copyTo(nullptr) != 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Shift bins." << endl;
+  FloatHist fhs = fh;
+  fhs.shiftBins(2);
+  assert( fhs.nbin() == 10 );
+  assert( fhs.binContent(0) == 0.0 );
+  assert( fhs.binContent(2) == 1.0 );
+  assert( fhs.binContent(4) == 3.0 );
+  assert( fhs.overflow() == 2.0 );
+  assert( areEqual(fhs.sum() + fhs.overflow() + fhs.underflow(),
+                   fh.sum() + fh.overflow() + fh.underflow()) );
+  fhs.shiftBins(-3);
+  assert( fhs.binContent(1) == 3.0 );
+  assert( fhs.underflow() == 2.0 );
+  assert( TH1Manipulator::shiftBins(ph.get(), 2) == 0 );
+  for ( Index ibin=0; ibin<fh.nbin(); ++ibin ) {
+    float val = ibin >= 2 ? fh.binContent(ibin-2) : 0.0;
+    assert( ph->GetBinContent(ibin+1) == val );
+  }
+  assert( ph->GetBinContent(11) == 2.0 );
+  assert( ph->GetEntries() == fh.entries() );
+  assert( TH1Manipulator::shiftBins(nullptr, 2) != 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Shift axis." << endl;
+  FloatHist fha = fh;
+  fha.shiftAxis(100.0);
+  assert( areEqual(fha.xmin(), 100.0) );
+  assert( areEqual(fha.xmax(), 120.0) );
+  assert( areEqual(fha.mean(), xmean + 100.0) );
+  assert( fha.contents() == fh.contents() );
+  assert( TH1Manipulator::shiftAxis(ph.get(), 100.0) == 0 );
+  assert( areEqual(ph->GetXaxis()->GetXmin(), 100.0) );
+  assert( areEqual(ph->GetXaxis()->GetXmax(), 120.0) );
+
+  cout << myname << line << endl;
+  cout << myname << "Rebin and scale." << endl;
+  FloatHist fhr = fh;
+  assert( fhr.rebin(0) != 0 );
+  assert( fhr.rebin(3) == 0 );
+  assert( fhr.nbin() == 3 );
+  assert( areEqual(fhr.binWidth(), 6.0) );
+  assert( areEqual(fhr.xmax(), 18.0) );
+  assert( fhr.binContent(0) == 6.0 );
+  assert( fhr.binContent(1) == 0.0 );
+  assert( fhr.overflow() == 2.0 );
+  fhr.scale(0.5);
+  assert( fhr.binContent(0) == 3.0 );
+  assert( fhr.overflow() == 1.0 );
+  fhr.reset();
+  assert( fhr.sum() == 0.0 );
+  assert( fhr.entries() == 0.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_FloatHist();
+}
+
+//**********************************************************************
@@ -187,6 +187,72 @@ int test_Fw2dFFT(Index ignorm, Index itnorm, int loglev) {
   assert( bstat == 0 );
   assert( printData(dat, dat2) );
 
+  cout << myname << line << endl;
+  cout << myname << "Multithreaded transform." << endl;
+  Fw2dFFT xf3(ndft, 0, 2);
+  assert( xf3.nthread() == 2 );
+  DftData dft3(norm, nsams);
+  assert( xf3.fftForward(dat, dft3, loglev) == 0 );
+  for ( Index idat=0; idat<ndft; ++idat ) {
+    assert( fabs(dft3.floatData()[idat] - dft.floatData()[idat]) < 1.e-4 );
+  }
+  Data dat3;
+  assert( xf3.fftBackward(dft3, dat3, loglev) == 0 );
+  assert( printData(dat, dat3) );
+
+  cout << myname << line << endl;
+  cout << myname << "Fast-size padding." << endl;
+  IndexArray nsamsp = {n0, 11};
+  DataVector samsp;
+  for ( Index irow=0; irow<n0; ++irow ) {
+    for ( Index icol=0; icol<nsamsp[1]; ++icol ) samsp.push_back(sams[irow*n1 + icol]);
+  }
+  Data datp(nsamsp, samsp);
+  Fw2dFFT xfp(ndft, 0);
+  xfp.setFastSize(true);
+  IndexArray ntrans = xfp.transformSizes(nsamsp);
+  assert( ntrans[0] == 3 );
+  assert( ntrans[1] == 12 );
+  DftData dftp(norm, nsamsp);
+  assert( xfp.fftForward(datp, dftp, loglev) == 0 );
+  assert( dftp.nSamples() == ntrans );
+  Data datp2;
+  assert( xfp.fftBackward(dftp, datp2, loglev) == 0 );
+  assert( printData(datp, datp2) );
+
+  cout << myname << line << endl;
+  cout << myname << "In-place transforms." << endl;
+  for ( Index nthr : {1, 2} ) {
+    Fw2dFFT xfi(ndft, 0, nthr);
+    xfi.setFastSize(nthr == 2);
+    DftData dfti(norm, nsams);
+    assert( xfi.fftForwardInPlace(dat, dfti, loglev) == 0 );
+    if ( nthr == 1 ) {
+      assert( xfi.haveInPlaceForwardPlan(nsams) );
+      assert( ! xfi.haveForwardPlan(nsams) );
+    }
+    assert( dfti.nSamples() == xfi.transformSizes(nsams) );
+    if ( dfti.nSamples() == nsams ) {
+      for ( Index idat=0; idat<ndft; ++idat ) {
+        assert( fabs(dfti.floatData()[idat] - dft.floatData()[idat]) < 1.e-4 );
+      }
+    }
+    Data dati;
+    assert( xfi.fftBackwardInPlace(dfti, dati, loglev) == 0 );
+    assert( dfti.size() == 0 );
+    assert( printData(dat, dati) );
+    DftData dftpi(norm, nsamsp);
+    xfi.setFastSize(true);
+    assert( xfi.fftForwardInPlace(datp, dftpi, loglev) == 0 );
+    assert( dftpi.nSamples() == ntrans );
+    for ( Index idat=0; idat<dftpi.size(); ++idat ) {
+      assert( std::abs(dftpi.data()[idat] - dftp.data()[idat]) < 1.e-4 );
+    }
+    Data datpi;
+    assert( xfi.fftBackwardInPlace(dftpi, datpi, loglev) == 0 );
+    assert( printData(datp, datpi) );
+  }
+
 /*
   cout << myname << line << endl;
   cout << myname << "Check power." << endl;
@@ -130,6 +130,88 @@ int test_FwFFT(Index ignorm, Index itnorm, int loglev, Index len) {
     assert( fabs(sams2[isam] - sams[isam]) < 1.e-4 );
   }
 
+  cout << myname << line << endl;
+  cout << myname << "Transform with a caller workspace." << endl;
+  FwFFT::Workspace work(xf.nsamMax());
+  DFT dft3(norm);
+  assert( xf.fftForward(sams, dft3, work, loglev) == 0 );
+  assert( dft3.size() == nsam );
+  for ( Index ifrq=0; ifrq<namp; ++ifrq ) {
+    assert( dft3.amplitude(ifrq) == dft.amplitude(ifrq) );
+  }
+  FloatVector sams3;
+  assert( xf.fftInverse(dft3, sams3, work, loglev) == 0 );
+  assert( sams3 == sams2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Batched transform." << endl;
+  vector<FloatVector> chans(5, sams);
+  for ( Index icha=0; icha<chans.size(); ++icha ) chans[icha][0] += icha;
+  FwFFT::SamplePointerVector psams;
+  for ( const FloatVector& chan : chans ) psams.push_back(chan.data());
+  FwFFT::DFTVector dfts(chans.size(), DFT(norm));
+  FwFFT::Workspace bwork(xf.nsamMax(), 2);
+  assert( xf.fftForwardBatch(nsam, psams, dfts, bwork, loglev) == 0 );
+  for ( Index icha=0; icha<chans.size(); ++icha ) {
+    DFT dftcha(norm);
+    assert( xf.fftForward(chans[icha], dftcha, loglev) == 0 );
+    assert( dfts[icha].size() == nsam );
+    for ( Index ifrq=0; ifrq<namp; ++ifrq ) {
+      assert( fabs(dfts[icha].amplitude(ifrq) - dftcha.amplitude(ifrq)) < 1.e-5 );
+      if ( ifrq < npha ) assert( fabs(dfts[icha].phase(ifrq) - dftcha.phase(ifrq)) < 1.e-5 );
+    }
+  }
+  FwFFT::DFTVector dftsBad(1, DFT(norm));
+  assert( xf.fftForwardBatch(nsam, psams, dftsBad) != 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Batched round trip on workspace buffers." << endl;
+  Index nbat = bwork.batchSize();
+  for ( Index ibat=0; ibat<nbat; ++ibat ) {
+    for ( Index isam=0; isam<nsam; ++isam ) bwork.inData()[ibat*nsam + isam] = chans[ibat][isam];
+  }
+  assert( xf.executeForwardBatch(nsam, nbat, bwork.inData(), bwork.outData()) == 0 );
+  assert( xf.executeBackwardBatch(nsam, nbat, bwork.outData(), bwork.inData()) == 0 );
+  for ( Index ibat=0; ibat<nbat; ++ibat ) {
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      assert( fabs(bwork.inData()[ibat*nsam + isam]/nsam - chans[ibat][isam]) < 1.e-4 );
+    }
+  }
+  assert( xf.executeForwardBatch(xf.nsamMax() + 1, nbat, bwork.inData(), bwork.outData()) != 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Single-precision transform." << endl;
+  FwFloatFFT xff(50, 0);
+  DFT dftf(norm);
+  assert( xff.fftForward(sams, dftf, loglev) == 0 );
+  assert( dftf.size() == nsam );
+  for ( Index ifrq=0; ifrq<namp; ++ifrq ) {
+    assert( fabs(dftf.amplitude(ifrq) - dft.amplitude(ifrq)) < 1.e-4*(1.0 + fabs(dft.amplitude(ifrq))) );
+  }
+  FloatVector samsf;
+  assert( xff.fftInverse(dftf, samsf, loglev) == 0 );
+  assert( samsf.size() == nsam );
+  for ( Index isam=0; isam<nsam; ++isam ) assert( fabs(samsf[isam] - sams[isam]) < 1.e-3 );
+
+  cout << myname << line << endl;
+  cout << myname << "Fast-size padding." << endl;
+  FwFFT xfp(50, 0);
+  assert( ! xfp.fastSize() );
+  assert( xfp.transformSize(22) == 22 );
+  xfp.setFastSize(true);
+  assert( xfp.transformSize(22) == 24 );
+  assert( xfp.transformSize(20) == 20 );
+  assert( xfp.transformSize(49) == 49 );
+  FloatVector samsp(sams);
+  samsp.resize(22, 1.5);
+  DFT dftp(norm);
+  assert( xfp.fftForward(samsp, dftp, loglev) == 0 );
+  assert( dftp.size() == 24 );
+  FloatVector samsp2;
+  assert( xfp.fftInverse(dftp, samsp2, loglev) == 0 );
+  assert( samsp2.size() == samsp.size() );
+  for ( Index isam=0; isam<samsp.size(); ++isam ) assert( fabs(samsp2[isam] - samsp[isam]) < 1.e-4 );
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
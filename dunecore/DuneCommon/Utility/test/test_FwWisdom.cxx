@@ -0,0 +1,85 @@
+// test_FwWisdom.cxx
+//
+// Test FwWisdom.
+
+#include "dunecore/DuneCommon/Utility/FwWisdom.h"
+#include "dunecore/DuneCommon/Utility/FwFFT.h"
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::ifstream;
+using std::ofstream;
+
+using Index = unsigned int;
+
+//**********************************************************************
+
+int test_FwWisdom() {
+  const string myname = "test_FwWisdom: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  string fname = "test_FwWisdom.dat";
+  std::remove(fname.c_str());
+  FwWisdom& wis = FwWisdom::instance();
+
+  cout << myname << line << endl;
+  cout << myname << "Set path." << endl;
+  wis.setPath(fname);
+  assert( wis.path() == fname );
+  assert( wis.load() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Measure a plan." << endl;
+  FwFFT xf(200, 1);
+  FwFFT::FloatVector sams(200, 1.0);
+  FwFFT::DFT dft(RealDftNormalization(1, 1));
+  assert( xf.fftForward(sams, dft) == 0 );
+  assert( wis.hasUnsavedPlans() );
+
+  cout << myname << line << endl;
+  cout << myname << "Save wisdom." << endl;
+  assert( wis.save() == 0 );
+  assert( ! wis.hasUnsavedPlans() );
+  assert( ifstream(fname).good() );
+
+  cout << myname << line << endl;
+  cout << myname << "Load bad wisdom." << endl;
+  string badname = fname + ".bad";
+  ofstream(badname) << "not wisdom" << endl;
+  wis.setPath(badname);
+  assert( wis.load() == 1 );
+  assert( wis.load() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Disable." << endl;
+  wis.setPath("");
+  assert( wis.path() == "" );
+  assert( wis.load() == 0 );
+  assert( wis.save() == 0 );
+
+  std::remove(fname.c_str());
+  std::remove(badname.c_str());
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_FwWisdom();
+}
+
+//**********************************************************************
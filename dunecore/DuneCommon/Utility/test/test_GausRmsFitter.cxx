@@ -19,6 +19,8 @@
 #include <iomanip>
 #include <cassert>
 #include <vector>
+#include <random>
+#include <cmath>
 
 using std::string;
 using std::cout;
@@ -95,6 +97,81 @@ int test_GausRmsFitter(int dbg, double satfrac) {
 
 //**********************************************************************
 
+int test_GausRmsFitterSamples(int dbg, double satfrac) {
+  const string myname = "test_GausRmsFitterSamples: ";
+  cout << myname << "Starting test" << endl;
+  string line = "-----------------------------";
+  using Estimate = GausRmsFitter::Estimate;
+  using FloatVector = GausRmsFitter::FloatVector;
+
+  cout << myname << line << endl;
+  cout << myname << "Test data with frac " << satfrac << endl;
+  std::mt19937 gen(12345);
+  std::normal_distribution<float> dist1(50.0, 4.0);
+  std::normal_distribution<float> dist2(20.0, 4.0);
+  int npt = 1000;
+  int ncha = 20;
+  std::vector<FloatVector> dats(ncha);
+  for ( FloatVector& dat : dats ) {
+    for ( int ipt=0; ipt<npt; ++ipt ) dat.push_back(dist1(gen));
+    for ( int ipt=0; ipt<satfrac*npt; ++ipt ) dat.push_back(dist2(gen));
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Evaluate one channel." << endl;
+  GausRmsFitter gsf(4.0, 4.0, "ff");
+  if ( dbg > 0 ) gsf.setLogLevel(dbg);
+  Estimate est;
+  assert( gsf.evaluate(dats[0], 50, est) == 0 );
+  cout << myname << "   Mean: " << est.mean << endl;
+  cout << myname << "  Sigma: " << est.sigma << endl;
+  cout << myname << "  Count: " << est.count << endl;
+  cout << myname << "  Niter: " << est.niter << endl;
+  assert( fabs(est.mean - 50.0) < 1.0 );
+  assert( fabs(est.sigma - 4.0) < 0.5 );
+  assert( est.count > 0.9*npt );
+  assert( est.count <= dats[0].size() );
+
+  cout << myname << line << endl;
+  cout << myname << "Evaluate all channels." << endl;
+  std::vector<const FloatVector*> pdats;
+  for ( const FloatVector& dat : dats ) pdats.push_back(&dat);
+  pdats.push_back(nullptr);
+  std::vector<double> mean0s(ncha, 50.0);
+  GausRmsFitter::EstimateVector ests;
+  assert( gsf.evaluateMany(pdats, mean0s, ests) == 1 );
+  assert( ests.size() == pdats.size() );
+  assert( ests.back().status == 101 );
+  for ( int icha=0; icha<ncha; ++icha ) {
+    Estimate chest;
+    assert( gsf.evaluate(dats[icha], 50, chest) == 0 );
+    assert( ests[icha].status == 0 );
+    assert( ests[icha].mean == chest.mean );
+    assert( ests[icha].sigma == chest.sigma );
+    assert( fabs(chest.sigma - 4.0) < 0.5 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check other configurations." << endl;
+  assert( gsf.evaluate(FloatVector(), 50, est) == 101 );
+  GausRmsFitter gsfFixed(4.0, 0.0, "ff");
+  assert( gsfFixed.evaluate(dats[0], 45, est) == 0 );
+  assert( est.mean == 45.0 );
+  assert( est.sigma == 4.0 );
+  GausRmsFitter gsfFull(0.0, 0.0, "ff");
+  assert( gsfFull.evaluate(dats[0], 0, est) == 0 );
+  cout << myname << "  Full mean: " << est.mean << endl;
+  cout << myname << "   Full RMS: " << est.sigma << endl;
+  assert( est.count == dats[0].size() );
+  if ( satfrac > 0.0 ) assert( est.sigma > 4.5 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
 int main(int narg, const char* argc[]) {
   int dbg = 0;
   DoubleVector satfracs = {0.0, 0.1, 0.2, 0.5};
@@ -119,6 +196,7 @@ int main(int narg, const char* argc[]) {
   }
   int err = 0;
   for ( double satfrac : satfracs ) err += test_GausRmsFitter(dbg, satfrac);
+  for ( double satfrac : satfracs ) err += test_GausRmsFitterSamples(dbg, satfrac);
   return err;
 }
 
@@ -19,6 +19,9 @@
 #include <iomanip>
 #include <cassert>
 #include <vector>
+#include <random>
+#include <cmath>
+#include <thread>
 
 using std::string;
 using std::cout;
@@ -88,6 +91,91 @@ int test_GausStepFitter(double satfrac) {
 
 //**********************************************************************
 
+int test_GausStepFitterArray(double satfrac) {
+  const string myname = "test_GausStepFitterArray: ";
+  cout << myname << "Starting test" << endl;
+  string line = "-----------------------------";
+  using Result = GausStepFitter::Result;
+  using FloatVector = GausStepFitter::FloatVector;
+
+  cout << myname << line << endl;
+  cout << myname << "Test data with frac " << satfrac << endl;
+  // Binned data like that in the histogram test: bin centers 0.5, 1.5, ...
+  std::mt19937 gen(2468);
+  std::normal_distribution<double> dist1(50.0, 4.0);
+  std::normal_distribution<double> dist2(30.0, 4.0);
+  int npt = 1000;
+  int nbin = 100;
+  int ncha = 16;
+  std::vector<FloatVector> dats(ncha, FloatVector(nbin, 0.0));
+  for ( FloatVector& dat : dats ) {
+    for ( int ipt=0; ipt<npt; ++ipt ) {
+      int ibin = floor(dist1(gen));
+      if ( ibin >= 0 && ibin < nbin ) dat[ibin] += 1.0;
+    }
+    for ( int ipt=0; ipt<satfrac*npt; ++ipt ) {
+      int ibin = floor(dist2(gen));
+      if ( ibin >= 0 && ibin < nbin ) dat[ibin] += 1.0;
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Estimate and fit one channel." << endl;
+  // Zero height means only the sign of the height is constrained.
+  GausStepFitter gsf(50, 3.0, 0.0, "ff");
+  Result est;
+  assert( gsf.estimate(dats[0].data(), nbin, 0.5, 1.0, est) == 0 );
+  cout << myname << "  Estimate height: " << est.height << endl;
+  cout << myname << "    Estimate mean: " << est.mean << endl;
+  cout << myname << "   Estimate sigma: " << est.sigma << endl;
+  assert( fabs(est.mean - 50.0) < 2.0 );
+  assert( fabs(est.sigma - 4.0) < 1.5 );
+  Result res;
+  assert( gsf.fitArray(dats[0], 0.5, 1.0, res) == 0 );
+  cout << myname << "    Fit height: " << res.height << endl;
+  cout << myname << "      Fit mean: " << res.mean << endl;
+  cout << myname << "     Fit sigma: " << res.sigma << endl;
+  cout << myname << "      Fit chi2: " << res.chi2 << endl;
+  cout << myname << "  Fit # iters: " << res.niter << endl;
+  assert( fabs(res.mean - 50.0) < 1.0 );
+  assert( fabs(res.sigma - 4.0) < 0.6 );
+  assert( fabs(res.height - npt/(sqrt(2.0*M_PI)*4.0)) < 15.0 );
+  assert( res.chi2 <= est.chi2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Fit channels concurrently." << endl;
+  std::vector<Result> ress(ncha);
+  std::vector<int> stats(ncha, -1);
+  std::vector<std::thread> threads;
+  int nthr = 4;
+  for ( int ithr=0; ithr<nthr; ++ithr ) {
+    threads.emplace_back([&, ithr]() {
+      for ( int icha=ithr; icha<ncha; icha+=nthr ) {
+        stats[icha] = gsf.fitArray(dats[icha], 0.5, 1.0, ress[icha]);
+      }
+    });
+  }
+  for ( std::thread& thr : threads ) thr.join();
+  for ( int icha=0; icha<ncha; ++icha ) {
+    Result chres;
+    assert( stats[icha] == 0 );
+    assert( gsf.fitArray(dats[icha], 0.5, 1.0, chres) == 0 );
+    assert( ress[icha].mean == chres.mean );
+    assert( ress[icha].sigma == chres.sigma );
+    assert( fabs(chres.mean - 50.0) < 1.0 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check bad input." << endl;
+  assert( gsf.fitArray(FloatVector(2, 1.0), 0.5, 1.0, res) == 2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
 int main(int narg, const char* argc[]) {
   DoubleVector satfracs = {0.0, 0.1, 0.2, 0.5};
   if ( narg > 1 ) {
@@ -106,6 +194,7 @@ int main(int narg, const char* argc[]) {
   }
   int err = 0;
   for ( double satfrac : satfracs ) err += test_GausStepFitter(satfrac);
+  for ( double satfrac : satfracs ) err += test_GausStepFitterArray(satfrac);
   return err;
 }
 
@@ -0,0 +1,117 @@
+// test_MultiTailer.cxx
+//
+// Test for MultiTailer.
+
+#undef NDEBUG
+
+#include "../MultiTailer.h"
+#include "../SampleTailer.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using FloatVector = MultiTailer::FloatVector;
+using Index = unsigned int;
+
+//**********************************************************************
+
+int test_MultiTailer() {
+  const string myname = "test_MultiTailer: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  Index nsam = 300;
+  FloatVector sig0(nsam, 0.0);
+  for ( Index isam=20; isam<30; ++isam ) sig0[isam] = 10.0*(isam - 19);
+  for ( Index isam=30; isam<40; ++isam ) sig0[isam] = 10.0*(40 - isam);
+
+  cout << myname << line << endl;
+  cout << myname << "Compare one component with SampleTailer." << endl;
+  {
+    float tdec = 50.0;
+    float alpha = 0.02;
+    float tail0 = 3.0;
+    float ped = 2.0;
+    SampleTailer sta(tdec, alpha);
+    sta.setTail0(tail0);
+    sta.setPedestal(ped);
+    assert( sta.setSignal(sig0) == 0 );
+    MultiTailer mtl;
+    assert( mtl.addComponent(tdec, alpha, tail0) == 0 );
+    assert( mtl.size() == 1 );
+    assert( mtl.addComponent(0.0, alpha) != 0 );
+    assert( mtl.size() == 1 );
+    FloatVector sams = sig0;
+    assert( mtl.addTails(sams, ped) == 0 );
+    for ( Index isam=0; isam<nsam; ++isam ) assert( fabs(sams[isam] - sta.data(isam)) < 1.e-4 );
+    assert( mtl.removeTails(sams, ped) == 0 );
+    for ( Index isam=0; isam<nsam; ++isam ) assert( fabs(sams[isam] - sig0[isam]) < 1.e-3 );
+    sta.setDecayTime(tdec, true);
+    assert( fabs(MultiTailer::cancellingAlpha(tdec) - sta.alpha()) < 1.e-6 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check three components and blocks." << endl;
+  {
+    MultiTailer mtl;
+    assert( mtl.addComponent(10.0, MultiTailer::cancellingAlpha(10.0)) == 0 );
+    assert( mtl.addComponent(100.0, 0.005) == 0 );
+    assert( mtl.addComponent(1000.0, -0.001, 1.0) == 0 );
+    assert( mtl.size() == 3 );
+    Index ncha = 7;
+    vector<FloatVector> chas(ncha);
+    FloatVector peds(ncha);
+    for ( Index icha=0; icha<ncha; ++icha ) {
+      chas[icha].resize(nsam);
+      for ( Index isam=0; isam<nsam; ++isam ) chas[icha][isam] = (icha + 1.0)*sig0[isam];
+      peds[icha] = 1.0*icha;
+    }
+    // Expected data from single-channel calls.
+    vector<FloatVector> exps = chas;
+    for ( Index icha=0; icha<ncha; ++icha ) assert( mtl.addTails(exps[icha], peds[icha]) == 0 );
+    MultiTailer::FloatVectorPtrVector pchas;
+    for ( FloatVector& cha : chas ) pchas.push_back(&cha);
+    assert( mtl.addTails(pchas, &peds) == 0 );
+    for ( Index icha=0; icha<ncha; ++icha ) {
+      for ( Index isam=0; isam<nsam; ++isam ) assert( chas[icha][isam] == exps[icha][isam] );
+    }
+    assert( mtl.removeTails(pchas, &peds) == 0 );
+    float dmax = 0.0;
+    for ( Index icha=0; icha<ncha; ++icha ) {
+      for ( Index isam=0; isam<nsam; ++isam ) {
+        float dif = fabs(chas[icha][isam] - (icha + 1.0)*sig0[isam]);
+        if ( dif > dmax ) dmax = dif;
+      }
+    }
+    cout << myname << "Maximum round-trip difference: " << dmax << endl;
+    assert( dmax < 1.e-2 );
+    // Channels with different lengths are processed one by one.
+    chas[2].resize(nsam/2);
+    exps[2] = chas[2];
+    assert( mtl.addTails(exps[2], peds[2]) == 0 );
+    assert( mtl.addTails(pchas, &peds) == 0 );
+    for ( Index isam=0; isam<nsam/2; ++isam ) assert( chas[2][isam] == exps[2][isam] );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_MultiTailer();
+}
+
+//**********************************************************************
@@ -0,0 +1,125 @@
+// test_NpyFloatFile.cxx
+//
+// Test NpyFloatFile.
+
+#undef NDEBUG
+
+#include "dunecore/DuneCommon/Utility/NpyFloatFile.h"
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::ofstream;
+using std::vector;
+
+using Index = unsigned int;
+
+namespace {
+
+// Write an npy v1 file with the given descr and shape string.
+template<typename T>
+void writeNpy(string fname, string descr, string shape, const vector<T>& vals,
+              Index ntrunc =0) {
+  string hdr = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': " + shape + ", }";
+  while ( (10 + hdr.size() + 1) % 64 ) hdr += ' ';
+  hdr += '\n';
+  ofstream fout(fname.c_str(), std::ios::binary);
+  fout.write("\x93NUMPY\x01\x00", 8);
+  unsigned char len[2] = {static_cast<unsigned char>(hdr.size() & 0xff),
+                          static_cast<unsigned char>(hdr.size() >> 8)};
+  fout.write(reinterpret_cast<const char*>(len), 2);
+  fout.write(hdr.data(), hdr.size());
+  fout.write(reinterpret_cast<const char*>(vals.data()), vals.size()*sizeof(T) - ntrunc);
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_NpyFloatFile() {
+  const string myname = "test_NpyFloatFile: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Write files." << endl;
+  Index nval = 1000;
+  vector<float> fvals(nval);
+  vector<double> dvals(nval);
+  for ( Index ival=0; ival<nval; ++ival ) {
+    fvals[ival] = 0.5*ival - 10.0;
+    dvals[ival] = 0.25*ival + 3.0;
+  }
+  writeNpy("test_NpyFloatFile_f4.npy", "<f4", "(1000,)", fvals);
+  writeNpy("test_NpyFloatFile_f8.npy", "<f8", "(10, 100)", dvals);
+  writeNpy("test_NpyFloatFile_i4.npy", "<i4", "(1000,)", fvals);
+  writeNpy("test_NpyFloatFile_short.npy", "<f4", "(1000,)", fvals, 8);
+  {
+    ofstream fout("test_NpyFloatFile_text.npy");
+    fout << "values: [1, 2, 3]" << endl;
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Read float file." << endl;
+  {
+    NpyFloatFile npf("test_NpyFloatFile_f4.npy");
+    cout << myname << "Status: " << npf.status() << " " << npf.error() << endl;
+    assert( npf.status() == 0 );
+    assert( npf.size() == nval );
+    assert( npf.valueSize() == 4 );
+    assert( npf.shape().size() == 1 );
+    assert( npf.shape()[0] == nval );
+    vector<float> vals;
+    assert( npf.read(vals) == 0 );
+    assert( vals == fvals );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Read double file." << endl;
+  {
+    NpyFloatFile npf("test_NpyFloatFile_f8.npy");
+    assert( npf.status() == 0 );
+    assert( npf.size() == nval );
+    assert( npf.valueSize() == 8 );
+    assert( npf.shape().size() == 2 );
+    assert( npf.shape()[0] == 10 );
+    assert( npf.shape()[1] == 100 );
+    vector<float> vals;
+    assert( npf.read(vals) == 0 );
+    assert( vals.size() == nval );
+    for ( Index ival=0; ival<nval; ++ival ) assert( fabs(vals[ival] - dvals[ival]) < 1.e-5 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check invalid files." << endl;
+  for ( string fname : {"test_NpyFloatFile_i4.npy", "test_NpyFloatFile_short.npy",
+                        "test_NpyFloatFile_missing.npy", "test_NpyFloatFile_text.npy"} ) {
+    NpyFloatFile npf(fname);
+    cout << myname << "  " << fname << ": " << npf.status() << " " << npf.error() << endl;
+    assert( npf.status() != 0 );
+    vector<float> vals(3, 1.0);
+    assert( npf.read(vals) != 0 );
+    assert( vals.size() == 3 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_NpyFloatFile();
+}
+
+//**********************************************************************
@@ -0,0 +1,194 @@
+// test_RealDftFilter.cxx
+//
+// Test RealDftFilter.
+//
+// The DFTs are evaluated directly so that the test does not depend on FFTW.
+
+#include "dunecore/DuneCommon/Utility/RealDftFilter.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using Filter = RealDftFilter<float>;
+using Dft = FftwRealDftData<float>;
+using CompactDft = CompactRealDftData<float>;
+using Index = Filter::Index;
+using FloatVector = Filter::FloatVector;
+using Complex = Filter::Complex;
+using Norm = RealDftNormalization;
+
+namespace {
+
+// Direct forward DFT.
+Dft forward(const FloatVector& sams, Norm norm) {
+  Index nsam = sams.size();
+  Dft dft(norm, nsam);
+  const double twopi = 2.0*acos(-1.0);
+  for ( Index ifrq=0; ifrq<dft.nComplex(); ++ifrq ) {
+    double xre = 0.0;
+    double xim = 0.0;
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      xre += sams[isam]*cos(twopi*ifrq*isam/nsam);
+      xim -= sams[isam]*sin(twopi*ifrq*isam/nsam);
+    }
+    dft.setRawValue(ifrq, Complex(xre, xim));
+  }
+  return dft;
+}
+
+// Direct inverse DFT.
+FloatVector inverse(const Dft& dft) {
+  Index nsam = dft.nSample();
+  FloatVector sams(nsam, 0.0);
+  const double twopi = 2.0*acos(-1.0);
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    double sum = 0.0;
+    for ( Index ifrq=0; ifrq<nsam; ++ifrq ) {
+      Complex val = dft.rawValue(ifrq);
+      double arg = twopi*ifrq*isam/nsam;
+      sum += val.real()*cos(arg) - val.imag()*sin(arg);
+    }
+    sams[isam] = sum/nsam;
+  }
+  return sams;
+}
+
+// Compact DFT with the same normalization and terms.
+CompactDft compact(const Dft& dft) {
+  FloatVector amps(dft.nComplex());
+  FloatVector phas((dft.nSample() + 1)/2);
+  for ( Index ifrq=0; ifrq<amps.size(); ++ifrq ) amps[ifrq] = dft.amplitude(ifrq);
+  for ( Index ifrq=0; ifrq<phas.size(); ++ifrq ) phas[ifrq] = dft.phase(ifrq);
+  return CompactDft(dft.normalization(), amps, phas);
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_RealDftFilter(Index nsam) {
+  const string myname = "test_RealDftFilter: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  Norm norm(Norm::Consistent, Norm::Power);
+  cout << myname << line << endl;
+  cout << myname << "# samples: " << nsam << endl;
+  FloatVector sams(nsam);
+  for ( Index isam=0; isam<nsam; ++isam ) sams[isam] = 2.0*sin(0.9*isam) + 0.1*isam*isam - 1.0;
+  Dft dft0 = forward(sams, norm);
+
+  cout << myname << line << endl;
+  cout << myname << "Check unit filter." << endl;
+  Filter filt(nsam);
+  assert( filt.nSample() == nsam );
+  assert( filt.nCompact() == nsam/2 + 1 );
+  assert( filt.gain(0) == Complex(1.0, 0.0) );
+  Dft dft = dft0;
+  assert( filt.apply(dft) == 0 );
+  for ( Index ifrq=0; ifrq<nsam; ++ifrq ) assert( dft.rawValue(ifrq) == dft0.rawValue(ifrq) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check integer shift." << endl;
+  Index ishift = 3;
+  assert( filt.shift(ishift) == 0 );
+  dft = dft0;
+  assert( filt.apply(dft) == 0 );
+  const Dft dftsh = dft;
+  FloatVector shsams = inverse(dft);
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    float expval = sams[(isam + nsam - ishift)%nsam];
+    assert( fabs(shsams[isam] - expval) < 1.e-3*(1.0 + fabs(expval)) );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check shift of the compact representation." << endl;
+  CompactDft cdft = compact(dft0);
+  assert( filt.apply(cdft) == 0 );
+  for ( Index ifrq=0; ifrq<nsam; ++ifrq ) {
+    float tol = 1.e-3*(1.0 + dft.amplitude(ifrq));
+    assert( fabs(cdft.amplitude(ifrq) - dft.amplitude(ifrq)) < tol );
+    if ( ifrq < cdft.nPhase() ) {
+      assert( cdft.phase(ifrq) >= -acos(-1.0) );
+      assert( cdft.phase(ifrq) < acos(-1.0) );
+      assert( fabs(cdft.real(ifrq) - dft.real(ifrq)) < tol );
+      assert( fabs(cdft.imag(ifrq) - dft.imag(ifrq)) < tol );
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check response multiplication." << endl;
+  FloatVector delta(nsam, 0.0);
+  delta[ishift] = 1.0;
+  Filter filtResp(nsam);
+  assert( filtResp.multiply(forward(delta, norm)) == 0 );
+  assert( filtResp.multiply(forward(FloatVector(nsam + 1, 1.0), norm)) == 2 );
+  for ( Index ifrq=0; ifrq<filt.nCompact(); ++ifrq ) {
+    assert( std::abs(filtResp.gain(ifrq) - filt.gain(ifrq)) < 1.e-4 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check notch, low-pass and Wiener kernels." << endl;
+  Filter filtf(nsam);
+  Index ncmp = filtf.nCompact();
+  assert( filtf.notch(1, 3) == 0 );
+  assert( filtf.notch(3, 1) != 0 );
+  assert( filtf.lowPass(ncmp/2.0, 2) == 0 );
+  FloatVector spwrs(ncmp, 4.0);
+  FloatVector npwrs(ncmp, 1.0);
+  assert( filtf.wiener(spwrs, npwrs) == 0 );
+  assert( filtf.wiener(spwrs, FloatVector(ncmp + 1, 1.0)) != 0 );
+  dft = dft0;
+  assert( filtf.apply(dft) == 0 );
+  for ( Index ifrq=0; ifrq<ncmp; ++ifrq ) {
+    float x = ifrq/(ncmp/2.0);
+    float expgain = ifrq >= 1 && ifrq < 3 ? 0.0 : 0.8/sqrt(1.0 + x*x*x*x);
+    assert( fabs(filtf.gain(ifrq).real() - expgain) < 1.e-5 );
+    assert( std::abs(dft.data()[ifrq] - expgain*dft0.data()[ifrq]) < 1.e-4*(1.0 + std::abs(dft0.data()[ifrq])) );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check batch application." << endl;
+  vector<Dft> dfts(4, dft0);
+  dfts.push_back(forward(FloatVector(nsam + 2, 1.0), norm));
+  assert( filt.apply(dfts) == 1 );
+  vector<FloatVector> amps(3);
+  vector<FloatVector> phas(3);
+  for ( Index idft=0; idft<3; ++idft ) compact(dft0).copyOut(amps[idft], phas[idft]);
+  assert( filt.apply(amps, phas) == 0 );
+  FloatVector expamps;
+  FloatVector expphas;
+  cdft.copyOut(expamps, expphas);
+  for ( Index idft=0; idft<4; ++idft ) {
+    for ( Index ifrq=0; ifrq<nsam; ++ifrq ) assert( dfts[idft].rawValue(ifrq) == dftsh.rawValue(ifrq) );
+  }
+  for ( Index idft=0; idft<3; ++idft ) {
+    assert( amps[idft] == expamps );
+    assert( phas[idft] == expphas );
+  }
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  for ( Index nsam : {16u, 17u} ) {
+    if ( test_RealDftFilter(nsam) ) return 1;
+  }
+  return 0;
+}
+
+//**********************************************************************
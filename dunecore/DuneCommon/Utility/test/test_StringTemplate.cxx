@@ -0,0 +1,138 @@
+// test_StringTemplate.cxx
+//
+// This is a test and demonstration for StringTemplate. The results are
+// compared with those from StringManipulator.
+
+#undef NDEBUG
+
+#include "../StringTemplate.h"
+#include "../StringManipulator.h"
+#include <string>
+#include <iostream>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = StringTemplate::Index;
+
+//**********************************************************************
+
+bool checkEqual(string s1, string s2) {
+  string prefix = "test_StringTemplate: ";
+  cout << prefix << s1;
+  cout << (s1 == s2 ? " == " : " != ");
+  cout << s2 << endl;
+  return s1 == s2;
+}
+
+//**********************************************************************
+
+int test_StringTemplate() {
+  const string myname = "test_StringTemplate: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Parse pattern." << endl;
+  string spat = "hped_%RUN%_%CHAN%_run%RUN%";
+  StringTemplate stm(spat);
+  assert( stm.pattern() == spat );
+  assert( stm.nfield() == 0 );
+  assert( checkEqual(stm.str(), spat) );
+  Index ifrun = stm.addField("%RUN%", 6);
+  Index ifcha = stm.addField("%CHAN%");
+  assert( stm.addField("") == StringTemplate::badIndex() );
+  assert( ifrun == 0 );
+  assert( ifcha == 1 );
+  assert( stm.nfield() == 2 );
+  assert( stm.fieldIndex("%CHAN%") == ifcha );
+  assert( stm.fieldIndex("%EVENT%") == StringTemplate::badIndex() );
+  assert( stm.count(ifrun) == 2 );
+  assert( stm.count(ifcha) == 1 );
+  assert( checkEqual(stm.str(), spat) );
+
+  cout << myname << line << endl;
+  cout << myname << "Format integers." << endl;
+  assert( stm.setValue(ifrun, 1234) == 0 );
+  assert( stm.setValue(5, 1234) != 0 );
+  for ( Index icha : {0u, 7u, 512u, 15359u} ) {
+    assert( stm.setValue(ifcha, icha) == 0 );
+    string sexp = spat;
+    StringManipulator sman(sexp, false);
+    sman.replaceFixedWidth("%RUN%", 1234, 6);
+    sman.replace("%CHAN%", icha);
+    assert( checkEqual(stm.str(), sexp) );
+  }
+  stm.setValue(ifrun, -12);
+  {
+    string sexp = spat;
+    StringManipulator sman(sexp, false);
+    sman.replaceFixedWidth("%RUN%", -12, 6);
+    sman.replace("%CHAN%", 15359u);
+    assert( checkEqual(stm.str(), sexp) );
+  }
+  assert( stm.clearValue(ifcha) == 0 );
+  assert( stm.str().find("%CHAN%") != string::npos );
+
+  cout << myname << line << endl;
+  cout << myname << "Format strings and floats." << endl;
+  StringTemplate stm2("%DET%/hgain_%GAIN%mVfC_%SHAPE%us.png");
+  Index ifdet = stm2.addField("%DET%", 8);
+  Index ifgai = stm2.addField("%GAIN%");
+  Index ifsha = stm2.addField("%SHAPE%");
+  stm2.setValue(ifdet, "pdsp");
+  for ( float gain : {14.0f, 4.7f, 7.8f, 25.0f} ) {
+    stm2.setFloat(ifgai, gain, 1, true, "p");
+    stm2.setFloat(ifsha, -2.0f + 0.5f*gain, 2, false);
+    string sexp = "%DET%/hgain_%GAIN%mVfC_%SHAPE%us.png";
+    StringManipulator sman(sexp, false);
+    sman.replaceFixedWidth("%DET%", string("pdsp"), 8);
+    sman.replace("%GAIN%", StringManipulator::floatToString(gain, 1, true, "p"));
+    sman.replace("%SHAPE%", StringManipulator::floatToString(-2.0f + 0.5f*gain, 2, false));
+    assert( checkEqual(stm2.str(), sexp) );
+    string sout;
+    stm2.format(sout);
+    assert( sout == sexp );
+  }
+  stm2.setFloat(ifgai, -1.25, 3, true, "p", "m");
+  assert( checkEqual(stm2.str(), "____pdsp/hgain_m1p25mVfC_10.50us.png") );
+
+  cout << myname << line << endl;
+  cout << myname << "Check overlapping keys." << endl;
+  StringTemplate stm3("%SUBRUN%-%RUN%-%RUN%B%");
+  Index ifrunx = stm3.addField("%RUN%B%");
+  Index ifsub = stm3.addField("%SUBRUN%", 3);
+  Index ifrun3 = stm3.addField("%RUN%", 3);
+  stm3.setValue(ifrunx, "x");
+  stm3.setValue(ifsub, 5);
+  stm3.setValue(ifrun3, 7);
+  assert( stm3.count(ifrun3) == 1 );
+  assert( checkEqual(stm3.str(), "005-007-x") );
+
+  cout << myname << line << endl;
+  cout << myname << "Check the buffer is reused." << endl;
+  const string& sref = stm.str();
+  const char* pdat = sref.data();
+  for ( Index icha=0; icha<1000; ++icha ) {
+    stm.setValue(ifcha, icha);
+    assert( &stm.str() == &sref );
+  }
+  assert( sref.data() == pdat );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_StringTemplate();
+}
+
+//**********************************************************************
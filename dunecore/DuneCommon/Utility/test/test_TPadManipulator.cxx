@@ -188,6 +188,42 @@ int test_TPadManipulator() {
   }
   pmani->print("test_TPadManipulator-read.png");
 
+  cout << myname << line << endl;
+  cout << myname << "Check canvas reuse." << endl;
+  {
+    bool batchSave = gROOT->IsBatch();
+    gROOT->SetBatch(true);
+    TPadManipulator::setCanvasReuse(true);
+    assert( TPadManipulator::canvasReuse() );
+    assert( TPadManipulator::canvasPoolSize() == 0 );
+    int ncan = -1;
+    for ( int iplt=0; iplt<3; ++iplt ) {
+      TPadManipulator manr(700, 500);
+      manr.add(ph, "hist");
+      assert( manr.print("test_TPadManipulator-reuse.png") == 0 );
+      assert( ! manr.haveCanvas() );
+      assert( TPadManipulator::canvasPoolSize() == 1 );
+      int ncanNew = gROOT->GetListOfCanvases()->GetEntries();
+      if ( ncan >= 0 ) assert( ncanNew == ncan );
+      ncan = ncanNew;
+    }
+    for ( int iplt=0; iplt<2; ++iplt ) {
+      // The first iteration creates a canvas and the second reuses it.
+      TPadManipulator mans(700, 1000, 1, 2);
+      mans.man(0)->add(ph, "hist");
+      mans.man(1)->add(ph, "hist");
+      assert( mans.draw() == 0 );
+      assert( TPadManipulator::canvasPoolSize() == 1 );
+      assert( mans.man(1)->pad() != nullptr );
+      assert( mans.print("test_TPadManipulator-reuse2.png") == 0 );
+      assert( mans.haveCanvas() );
+    }
+    assert( TPadManipulator::canvasPoolSize() == 2 );
+    TPadManipulator::setCanvasReuse(false);
+    assert( TPadManipulator::canvasPoolSize() == 0 );
+    gROOT->SetBatch(batchSave);
+  }
+
   cout << myname << line << endl;
   cout << myname << "Root canvas count: " << gROOT->GetListOfCanvases()->GetEntries() << endl;
   cout << myname << "Deleting manipulator." << endl;
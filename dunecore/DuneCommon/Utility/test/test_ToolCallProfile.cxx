@@ -0,0 +1,103 @@
+// test_ToolCallProfile.cxx
+//
+// Test ToolCallProfile.
+
+#undef NDEBUG
+
+#include "../ToolCallProfile.h"
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using Index = ToolCallProfile::Index;
+
+//**********************************************************************
+
+int test_ToolCallProfile() {
+  const string myname = "test_ToolCallProfile: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Record calls." << endl;
+  ToolCallProfile prf("mytool");
+  assert( prf.label() == "mytool" );
+  assert( prf.total().calls == 0 );
+  prf.record(ToolCallProfile::UpdateMap, 100, 2000, 400);
+  prf.record(ToolCallProfile::UpdateMap, 50, 1000, -100);
+  prf.record(ToolCallProfile::View, 1, 10, 0);
+  prf.record(ToolCallProfile::NMethod, 1, 10, 0);
+  ToolCallProfile::Entry ent = prf.entry(ToolCallProfile::UpdateMap);
+  assert( ent.calls == 2 );
+  assert( ent.channels == 150 );
+  assert( ent.nanoseconds == 3000 );
+  assert( ent.bytes == 300 );
+  ToolCallProfile::Entry tot = prf.total();
+  assert( tot.calls == 3 );
+  assert( tot.channels == 151 );
+  assert( tot.nanoseconds == 3010 );
+  assert( ToolCallProfile::methodName(ToolCallProfile::ViewTpcData) == "viewTpcData" );
+  prf.print(cout, myname);
+
+  cout << myname << line << endl;
+  cout << myname << "Timer." << endl;
+  {
+    ToolCallProfile::Timer tim(prf, ToolCallProfile::Update, 1);
+    tim.addBytes(8);
+  }
+  ent = prf.entry(ToolCallProfile::Update);
+  assert( ent.calls == 1 );
+  assert( ent.channels == 1 );
+  assert( ent.bytes == 8 );
+  prf.reset();
+  assert( prf.total().calls == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Concurrent recording." << endl;
+  std::vector<std::thread> thrs;
+  Index nthr = 4;
+  Index ncal = 10000;
+  for ( Index ithr=0; ithr<nthr; ++ithr ) {
+    thrs.emplace_back([&prf, ncal]() {
+      for ( Index ical=0; ical<ncal; ++ical ) prf.record(ToolCallProfile::Update, 1, 1, 1);
+    });
+  }
+  for ( std::thread& thr : thrs ) thr.join();
+  assert( prf.entry(ToolCallProfile::Update).calls == nthr*ncal );
+  assert( prf.entry(ToolCallProfile::Update).bytes == long(nthr*ncal) );
+
+  cout << myname << line << endl;
+  cout << myname << "Registry." << endl;
+  std::shared_ptr<ToolCallProfile> pprf1 = ToolCallProfile::registered("fast");
+  std::shared_ptr<ToolCallProfile> pprf2 = ToolCallProfile::registered("slow");
+  assert( pprf1 != pprf2 );
+  assert( ToolCallProfile::registered("fast") == pprf1 );
+  pprf1->record(ToolCallProfile::UpdateMap, 10, 100, 0);
+  pprf2->record(ToolCallProfile::UpdateMap, 10, 100000, 0);
+  std::ostringstream sout;
+  ToolCallProfile::printAll(sout);
+  cout << sout.str();
+  string sres = sout.str();
+  assert( sres.find("slow") < sres.find("fast") );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_ToolCallProfile();
+}
+
+//**********************************************************************
@@ -89,6 +89,90 @@ int test_coldelecResponse() {
   for ( double arat : arats ) cout << setw(w) << std::fixed << arat;
   cout << endl;
 
+  cout << myname << line << endl;
+  cout << "Compare the factored and batch evaluations with the original expression." << endl;
+  {
+    auto original = [](double time, double gain, double shaping) -> double {
+      if (time <=0 || time >= 10*shaping) return 0.0;
+      const double reltime = time/shaping;
+      gain *= 10*1.012;
+      return 4.31054*exp(-2.94809*reltime)*gain
+        -2.6202*exp(-2.82833*reltime)*cos(1.19361*reltime)*gain
+        -2.6202*exp(-2.82833*reltime)*cos(1.19361*reltime)*cos(2.38722*reltime)*gain
+        +0.464924*exp(-2.40318*reltime)*cos(2.5928*reltime)*gain
+        +0.464924*exp(-2.40318*reltime)*cos(2.5928*reltime)*cos(5.18561*reltime)*gain
+        +0.762456*exp(-2.82833*reltime)*sin(1.19361*reltime)*gain
+        -0.762456*exp(-2.82833*reltime)*cos(2.38722*reltime)*sin(1.19361*reltime)*gain
+        +0.762456*exp(-2.82833*reltime)*cos(1.19361*reltime)*sin(2.38722*reltime)*gain
+        -2.620200*exp(-2.82833*reltime)*sin(1.19361*reltime)*sin(2.38722*reltime)*gain
+        -0.327684*exp(-2.40318*reltime)*sin(2.5928*reltime)*gain
+        +0.327684*exp(-2.40318*reltime)*cos(5.18561*reltime)*sin(2.5928*reltime)*gain
+        -0.327684*exp(-2.40318*reltime)*cos(2.5928*reltime)*sin(5.18561*reltime)*gain
+        +0.464924*exp(-2.40318*reltime)*sin(2.5928*reltime)*sin(5.18561*reltime)*gain;
+    };
+    double gain = 14.0;
+    double shap = 2.0;
+    double t0 = -3.0;
+    double dt = 0.05;
+    Index ntim = 600;
+    vector<double> times(ntim);
+    for ( Index itim=0; itim<ntim; ++itim ) times[itim] = t0 + itim*dt;
+    vector<double> resps1(ntim);
+    coldelecResponse(times.data(), ntim, gain, shap, resps1.data());
+    vector<double> resps2;
+    coldelecResponse(t0, dt, ntim, gain, shap, resps2);
+    assert( resps2.size() == ntim );
+    double tol = 1.e-10*gain;
+    Index nzero = 0;
+    for ( Index itim=0; itim<ntim; ++itim ) {
+      double time = times[itim];
+      double resp0 = original(time, gain, shap);
+      if ( resp0 == 0.0 ) ++nzero;
+      assert( fabs(coldelecResponse(time, gain, shap) - resp0) < tol );
+      assert( fabs(resps1[itim] - resp0) < tol );
+      assert( fabs(resps2[itim] - resp0) < tol );
+    }
+    cout << myname << "Zero count: " << nzero << endl;
+    assert( nzero > 0 && nzero < ntim );
+    coldelecResponse(t0 + (ntim-1)*dt, -dt, ntim, gain, shap, resps2);
+    for ( Index itim=0; itim<ntim; ++itim ) {
+      assert( fabs(resps2[itim] - resps1[ntim-1-itim]) < tol );
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << "Compare the tabulated and direct evaluations." << endl;
+  {
+    const ColdelecResponseTable& tab = ColdelecResponseTable::instance();
+    assert( &tab == &ColdelecResponseTable::instance() );
+    double gain = 14.0;
+    double shap = 2.0;
+    double t0 = -3.0;
+    double dt = 0.05;
+    Index ntim = 600;
+    vector<double> times(ntim);
+    for ( Index itim=0; itim<ntim; ++itim ) times[itim] = t0 + itim*dt;
+    vector<double> resps1(ntim);
+    tab.response(times.data(), ntim, gain, shap, resps1.data());
+    vector<double> resps2;
+    tab.response(t0, dt, ntim, gain, shap, resps2);
+    assert( resps2.size() == ntim );
+    double tol = 1.e-8*gain;
+    for ( Index itim=0; itim<ntim; ++itim ) {
+      double time = times[itim];
+      double resp0 = coldelecResponse(time, gain, shap);
+      assert( fabs(tab.response(time, gain, shap) - resp0) < tol );
+      assert( fabs(resps1[itim] - resp0) < tol );
+      assert( fabs(resps2[itim] - resp0) < tol );
+      if ( resp0 == 0.0 ) assert( resps1[itim] == 0.0 );
+    }
+    TF1* pf = coldelecResponseTF1(gain, shap, 1.0, "cerespTab", true);
+    TF1* pf0 = coldelecResponseTF1(gain, shap, 1.0, "cerespDir");
+    for ( double t=0.0; t<25.0; t+=0.37 ) assert( fabs(pf->Eval(t) - pf0->Eval(t)) < tol );
+    delete pf;
+    delete pf0;
+  }
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
@@ -0,0 +1,367 @@
+// AdcBitMask.h
+//
+// Bit-packed mask with one bit for each tick, e.g. to flag signal or bad ticks.
+//
+// The bits are held in 64-bit words so that counts, logical combinations across
+// channels and conversions to ROIs work a word at a time, and the word array may be
+// handed to vectorized code. Bits beyond size() in the last word are always zero.
+//
+// Masks convert to and from the vector<bool> (AdcFilterVector) used in
+// AdcChannelData::signal and the inclusive tick ranges in AdcChannelData::rois:
+//   AdcBitMask mask(acd.signal);
+//   mask |= otherChannelMask;
+//   mask.toRois(acd.rois);
+//   mask.toVector(acd.signal);
+//
+// fromThreshold and dilate build a keep mask from samples a word at a time, e.g. for
+// ROI building (see AdcThresholdRoi.h).
+
+#ifndef AdcBitMask_H
+#define AdcBitMask_H
+
+#include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include <vector>
+#include <cstdint>
+
+class AdcBitMask {
+
+public:
+
+  using Index = AdcIndex;
+  using Word = std::uint64_t;
+  using WordVector = std::vector<Word>;
+
+  static constexpr Index wordSize() { return 64; }
+  static Index wordCount(Index nbit) { return (nbit + wordSize() - 1)/wordSize(); }
+
+  // Ctor for nbit bits with value val.
+  explicit AdcBitMask(Index nbit =0, bool val =false) { resize(nbit, val); }
+
+  // Ctor from a bool vector.
+  explicit AdcBitMask(const AdcFilterVector& vals) { fromVector(vals); }
+
+  // Ctor from ROIs for nbit bits.
+  AdcBitMask(const AdcRoiVector& rois, Index nbit) { fromRois(rois, nbit); }
+
+  // Size.
+  Index size() const { return m_nbit; }
+  bool empty() const { return m_nbit == 0; }
+
+  // Resize. New bits are set to val.
+  void resize(Index nbit, bool val =false);
+
+  // Clear the mask.
+  void clear() { m_nbit = 0; m_words.clear(); }
+
+  // Access bits. No range check.
+  bool test(Index ibit) const { return (m_words[ibit/wordSize()] >> (ibit%wordSize())) & 1; }
+  bool operator[](Index ibit) const { return test(ibit); }
+  void set(Index ibit) { m_words[ibit/wordSize()] |= Word(1) << (ibit%wordSize()); }
+  void reset(Index ibit) { m_words[ibit/wordSize()] &= ~(Word(1) << (ibit%wordSize())); }
+  void set(Index ibit, bool val) { if ( val ) set(ibit); else reset(ibit); }
+
+  // Set or reset the bits in [ibit1, ibit2).
+  void setRange(Index ibit1, Index ibit2, bool val =true);
+
+  // Set or reset all bits.
+  void setAll(bool val =true) { setRange(0, m_nbit, val); }
+
+  // Word access.
+  Index nword() const { return m_words.size(); }
+  const Word* words() const { return m_words.data(); }
+  Word* words() { return m_words.data(); }
+
+  // Return the first bit at or after ibit with value val, or size() if there is none.
+  Index findNext(Index ibit, bool val) const;
+
+  // Number of set bits.
+  Index count() const;
+
+  // Return if any or no bits are set.
+  bool any() const;
+  bool none() const { return ! any(); }
+
+  // Logical combinations with a mask of the same size.
+  // If the sizes differ, only the common bits are combined and the size is unchanged.
+  AdcBitMask& operator&=(const AdcBitMask& rhs);
+  AdcBitMask& operator|=(const AdcBitMask& rhs);
+  AdcBitMask& operator^=(const AdcBitMask& rhs);
+
+  // Invert all bits.
+  AdcBitMask& flip();
+
+  // Combine the masks for many channels.
+  static AdcBitMask andOf(const std::vector<AdcBitMask>& masks);
+  static AdcBitMask orOf(const std::vector<AdcBitMask>& masks);
+
+  // Set the mask for nsam samples with bits set where the sample is above thresh.
+  // If useAbs is true, the comparison is made with the magnitude of the sample.
+  void fromThreshold(const AdcSignal* psam, Index nsam, AdcSignal thresh, bool useAbs =false);
+
+  // Extend each run of set bits by nlow bits before and nhigh after, clipped to the mask.
+  void dilate(Index nlow, Index nhigh);
+
+  // Conversions to and from bool vectors.
+  void fromVector(const AdcFilterVector& vals);
+  void toVector(AdcFilterVector& vals) const;
+
+  // Conversions to and from ROIs, i.e. inclusive ranges of set bits.
+  // fromRois clips the ROIs to nbit.
+  void fromRois(const AdcRoiVector& rois, Index nbit);
+  void toRois(AdcRoiVector& rois) const;
+
+  // Equality.
+  bool operator==(const AdcBitMask& rhs) const { return m_nbit == rhs.m_nbit && m_words == rhs.m_words; }
+  bool operator!=(const AdcBitMask& rhs) const { return ! (*this == rhs); }
+
+private:
+
+  // Zero the bits beyond size() in the last word.
+  void trim();
+
+  // OR into the mask a copy of itself shifted by nsh bits to higher (up) or lower bits.
+  void orShifted(Index nsh, bool up);
+
+  Index m_nbit = 0;
+  WordVector m_words;
+
+};
+
+//**********************************************************************
+
+inline void AdcBitMask::resize(Index nbit, bool val) {
+  Index nbit0 = m_nbit;
+  m_words.resize(wordCount(nbit), 0);
+  m_nbit = nbit;
+  if ( val && nbit > nbit0 ) setRange(nbit0, nbit, true);
+  trim();
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::setRange(Index ibit1, Index ibit2, bool val) {
+  if ( ibit2 > m_nbit ) ibit2 = m_nbit;
+  if ( ibit1 >= ibit2 ) return;
+  Index iwrd1 = ibit1/wordSize();
+  Index iwrd2 = (ibit2 - 1)/wordSize();
+  for ( Index iwrd=iwrd1; iwrd<=iwrd2; ++iwrd ) {
+    Word mask = ~Word(0);
+    if ( iwrd == iwrd1 ) mask &= ~Word(0) << (ibit1%wordSize());
+    if ( iwrd == iwrd2 && ibit2%wordSize() ) mask &= ~Word(0) >> (wordSize() - ibit2%wordSize());
+    if ( val ) m_words[iwrd] |= mask;
+    else m_words[iwrd] &= ~mask;
+  }
+}
+
+//**********************************************************************
+
+inline AdcBitMask::Index AdcBitMask::findNext(Index ibit, bool val) const {
+  if ( ibit >= m_nbit ) return m_nbit;
+  Index iwrd = ibit/wordSize();
+  Word inv = val ? Word(0) : ~Word(0);
+  // Bits with value val in the first word, starting at ibit.
+  Word wrd = (m_words[iwrd] ^ inv) & (~Word(0) << (ibit%wordSize()));
+  while ( wrd == 0 ) {
+    if ( ++iwrd >= nword() ) return m_nbit;
+    wrd = m_words[iwrd] ^ inv;
+  }
+  Index ibitOut = iwrd*wordSize() + __builtin_ctzll(wrd);
+  return ibitOut < m_nbit ? ibitOut : m_nbit;
+}
+
+//**********************************************************************
+
+inline AdcBitMask::Index AdcBitMask::count() const {
+  Index nset = 0;
+  for ( Word wrd : m_words ) nset += __builtin_popcountll(wrd);
+  return nset;
+}
+
+//**********************************************************************
+
+inline bool AdcBitMask::any() const {
+  for ( Word wrd : m_words ) if ( wrd ) return true;
+  return false;
+}
+
+//**********************************************************************
+
+inline AdcBitMask& AdcBitMask::operator&=(const AdcBitMask& rhs) {
+  Index nwrd = nword() < rhs.nword() ? nword() : rhs.nword();
+  Word* pdst = words();
+  const Word* psrc = rhs.words();
+  for ( Index iwrd=0; iwrd<nwrd; ++iwrd ) pdst[iwrd] &= psrc[iwrd];
+  return *this;
+}
+
+//**********************************************************************
+
+inline AdcBitMask& AdcBitMask::operator|=(const AdcBitMask& rhs) {
+  Index nwrd = nword() < rhs.nword() ? nword() : rhs.nword();
+  Word* pdst = words();
+  const Word* psrc = rhs.words();
+  for ( Index iwrd=0; iwrd<nwrd; ++iwrd ) pdst[iwrd] |= psrc[iwrd];
+  trim();
+  return *this;
+}
+
+//**********************************************************************
+
+inline AdcBitMask& AdcBitMask::operator^=(const AdcBitMask& rhs) {
+  Index nwrd = nword() < rhs.nword() ? nword() : rhs.nword();
+  Word* pdst = words();
+  const Word* psrc = rhs.words();
+  for ( Index iwrd=0; iwrd<nwrd; ++iwrd ) pdst[iwrd] ^= psrc[iwrd];
+  trim();
+  return *this;
+}
+
+//**********************************************************************
+
+inline AdcBitMask& AdcBitMask::flip() {
+  for ( Word& wrd : m_words ) wrd = ~wrd;
+  trim();
+  return *this;
+}
+
+//**********************************************************************
+
+inline AdcBitMask AdcBitMask::andOf(const std::vector<AdcBitMask>& masks) {
+  if ( masks.empty() ) return AdcBitMask();
+  AdcBitMask out = masks[0];
+  for ( Index imsk=1; imsk<masks.size(); ++imsk ) out &= masks[imsk];
+  return out;
+}
+
+//**********************************************************************
+
+inline AdcBitMask AdcBitMask::orOf(const std::vector<AdcBitMask>& masks) {
+  if ( masks.empty() ) return AdcBitMask();
+  AdcBitMask out = masks[0];
+  for ( Index imsk=1; imsk<masks.size(); ++imsk ) out |= masks[imsk];
+  return out;
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::fromThreshold(const AdcSignal* psam, Index nsam, AdcSignal thresh, bool useAbs) {
+  m_nbit = nsam;
+  m_words.assign(wordCount(nsam), 0);
+  // Compares for one word are independent so that the inner loop may be vectorized.
+  for ( Index iwrd=0; iwrd<nword(); ++iwrd ) {
+    Index ibit0 = iwrd*wordSize();
+    Index nb = nsam - ibit0 < wordSize() ? nsam - ibit0 : wordSize();
+    const AdcSignal* pwrd = psam + ibit0;
+    Word wrd = 0;
+    if ( useAbs ) {
+      for ( Index ib=0; ib<nb; ++ib ) wrd |= Word(pwrd[ib] > thresh || -pwrd[ib] > thresh) << ib;
+    } else {
+      for ( Index ib=0; ib<nb; ++ib ) wrd |= Word(pwrd[ib] > thresh) << ib;
+    }
+    m_words[iwrd] = wrd;
+  }
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::orShifted(Index nsh, bool up) {
+  Index nwrd = nword();
+  if ( nsh == 0 || nwrd == 0 ) return;
+  Index nwsh = nsh/wordSize();
+  Index nbsh = nsh%wordSize();
+  if ( nwsh >= nwrd ) return;
+  WordVector src = m_words;
+  for ( Index iwrd=0; iwrd<nwrd; ++iwrd ) {
+    Word wrd = 0;
+    if ( up ) {
+      if ( iwrd >= nwsh ) {
+        Index jwrd = iwrd - nwsh;
+        wrd = src[jwrd] << nbsh;
+        if ( nbsh && jwrd > 0 ) wrd |= src[jwrd - 1] >> (wordSize() - nbsh);
+      }
+    } else {
+      if ( iwrd + nwsh < nwrd ) {
+        Index jwrd = iwrd + nwsh;
+        wrd = src[jwrd] >> nbsh;
+        if ( nbsh && jwrd + 1 < nwrd ) wrd |= src[jwrd + 1] << (wordSize() - nbsh);
+      }
+    }
+    m_words[iwrd] |= wrd;
+  }
+  trim();
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::dilate(Index nlow, Index nhigh) {
+  // The extension doubles with each shift so that a pad of n takes about log2(n) passes.
+  for ( int idir=0; idir<2; ++idir ) {
+    Index npad = idir ? nlow : nhigh;
+    bool up = idir == 0;
+    Index ndone = 0;
+    Index nsh = 1;
+    while ( ndone < npad ) {
+      if ( nsh > npad - ndone ) nsh = npad - ndone;
+      orShifted(nsh, up);
+      ndone += nsh;
+      nsh = ndone + 1;
+    }
+  }
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::fromVector(const AdcFilterVector& vals) {
+  m_nbit = vals.size();
+  m_words.assign(wordCount(m_nbit), 0);
+  for ( Index ibit=0; ibit<m_nbit; ++ibit ) {
+    if ( vals[ibit] ) m_words[ibit/wordSize()] |= Word(1) << (ibit%wordSize());
+  }
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::toVector(AdcFilterVector& vals) const {
+  vals.assign(m_nbit, false);
+  for ( Index iwrd=0; iwrd<nword(); ++iwrd ) {
+    Word wrd = m_words[iwrd];
+    while ( wrd ) {
+      Index ibit = iwrd*wordSize() + __builtin_ctzll(wrd);
+      vals[ibit] = true;
+      wrd &= wrd - 1;
+    }
+  }
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::fromRois(const AdcRoiVector& rois, Index nbit) {
+  m_nbit = nbit;
+  m_words.assign(wordCount(nbit), 0);
+  for ( const AdcRoi& roi : rois ) setRange(roi.first, roi.second + 1, true);
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::toRois(AdcRoiVector& rois) const {
+  rois.clear();
+  Index ibit = 0;
+  while ( ibit < m_nbit ) {
+    Index ibit1 = findNext(ibit, true);
+    if ( ibit1 >= m_nbit ) break;
+    Index ibit2 = findNext(ibit1, false);
+    rois.emplace_back(ibit1, ibit2 - 1);
+    ibit = ibit2;
+  }
+}
+
+//**********************************************************************
+
+inline void AdcBitMask::trim() {
+  Index nrem = m_nbit%wordSize();
+  if ( nrem && ! m_words.empty() ) m_words.back() &= ~Word(0) >> (wordSize() - nrem);
+}
+
+//**********************************************************************
+
+#endif
@@ -0,0 +1,272 @@
+// AdcChannelBlock.h
+//
+// Structure-of-arrays container for the tick data of a block of channels,
+// e.g. all those in an APA.
+//
+// The samples are held in one contiguous channel x tick matrix with each row padded
+// to a multiple of 16 values so that every row starts on a 64-byte boundary relative
+// to the start of the matrix. Raw counts and flags may optionally be held in matrices
+// with the same layout. Kernels may then loop over ticks and channels without
+// chasing the separate allocations of each AdcChannelData.
+//
+// The block is filled from an AdcChannelDataMap with load, which assigns one row to
+// each channel in map order or, optionally, in a given channel order, e.g. the
+// group-contiguous order of a ChannelGroupService so that each group is a
+// contiguous range of rows. bind sets AdcChannelData::blockSamples so that each
+// channel is a non-owning view of its row, and store copies the rows back to the
+// samples vectors and removes those views. Channels with fewer ticks than the block
+// are zero-padded.
+//
+// Example:
+//   AdcChannelBlock blk;
+//   blk.load(acds);
+//   blk.bind(acds);
+//   for ( auto& iacd : acds ) {
+//     AdcSignal* psam = iacd.second.sampleData();
+//     for ( Index itck=0; itck<iacd.second.sampleCount(); ++itck ) psam[itck] -= ped;
+//   }
+//   blk.store(acds);
+//
+// The block must outlive any channel bound to it and must not be reset while
+// they are in use.
+
+#ifndef AdcChannelBlock_H
+#define AdcChannelBlock_H
+
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include <vector>
+#include <map>
+#include <set>
+
+class AdcChannelBlock {
+
+public:
+
+  using Index = AdcIndex;
+  using ChannelIndexMap = std::map<AdcChannel, Index>;
+  using ChannelVector = std::vector<AdcChannel>;
+
+  // Optional content.
+  enum Content { Samples=1, Raw=2, Flags=4 };
+
+  // Padding of each row, in values.
+  static Index rowPadding() { return 16; }
+
+  static Index badIndex() { return AdcChannelData::badIndex(); }
+
+  // Default ctor. Block is empty.
+  AdcChannelBlock() =default;
+
+  // Ctor with nrow channels of ntick ticks. All are zero.
+  // content is a bit mask of Content values.
+  AdcChannelBlock(Index nrow, Index ntick, Index content =Samples) {
+    reset(nrow, ntick, content);
+  }
+
+  // Resize to nrow channels of ntick ticks and zero the data.
+  void reset(Index nrow, Index ntick, Index content =Samples);
+
+  // Clear the block.
+  void clear() { reset(0, 0, m_content); }
+
+  // Dimensions.
+  Index nrow() const { return m_channels.size(); }
+  Index ntick() const { return m_ntick; }
+  Index stride() const { return m_stride; }
+  bool hasRaw() const { return m_content & Raw; }
+  bool hasFlags() const { return m_content & Flags; }
+
+  // Rows.
+  AdcSignal* samples(Index irow) { return irow < nrow() ? &m_samples[irow*m_stride] : nullptr; }
+  const AdcSignal* samples(Index irow) const { return irow < nrow() ? &m_samples[irow*m_stride] : nullptr; }
+  AdcCount* raw(Index irow) { return hasRaw() && irow < nrow() ? &m_raw[irow*m_stride] : nullptr; }
+  const AdcCount* raw(Index irow) const { return hasRaw() && irow < nrow() ? &m_raw[irow*m_stride] : nullptr; }
+  AdcFlag* flags(Index irow) { return hasFlags() && irow < nrow() ? &m_flags[irow*m_stride] : nullptr; }
+  const AdcFlag* flags(Index irow) const { return hasFlags() && irow < nrow() ? &m_flags[irow*m_stride] : nullptr; }
+
+  // Full matrices: row irow starts at irow*stride().
+  AdcSignal* sampleData() { return m_samples.data(); }
+  const AdcSignal* sampleData() const { return m_samples.data(); }
+
+  // Channel for each row and row for each channel.
+  AdcChannel channel(Index irow) const { return irow < nrow() ? m_channels[irow] : AdcChannelData::badChannel(); }
+  Index row(AdcChannel icha) const {
+    ChannelIndexMap::const_iterator irow = m_rows.find(icha);
+    return irow == m_rows.end() ? badIndex() : irow->second;
+  }
+  int setChannel(Index irow, AdcChannel icha);
+
+  // Reset the block and copy in the data for the channels in acds.
+  // The tick count is the largest sample count, or raw count if raw is requested.
+  // Raw and flags are copied if requested in content.
+  int load(const AdcChannelDataMap& acds, Index content =Samples);
+
+  // Same with rows assigned in the order of chans. Channels in chans but not in acds
+  // are skipped and those in acds but not in chans follow in map order.
+  int load(const AdcChannelDataMap& acds, const ChannelVector& chans, Index content =Samples);
+
+  // Make each channel in acds with a row a view of that row.
+  // Returns the number of channels without a row.
+  Index bind(AdcChannelDataMap& acds);
+
+  // Remove the views set by bind.
+  static void unbind(AdcChannelDataMap& acds);
+
+  // Copy the rows to the samples (and raw and flags if held) of the channels in acds
+  // and unbind them. The samples are resized to the tick count of the block.
+  // Returns the number of channels without a row.
+  Index store(AdcChannelDataMap& acds) const;
+
+private:
+
+  using EntryVector = std::vector<const AdcChannelDataMap::value_type*>;
+
+  // Reset the block and copy in the data for entries ents, one per row.
+  int loadEntries(const EntryVector& ents, Index content);
+
+  Index m_content = Samples;
+  Index m_ntick = 0;
+  Index m_stride = 0;
+  std::vector<AdcChannel> m_channels;
+  ChannelIndexMap m_rows;
+  AdcSignalVector m_samples;
+  AdcCountVector m_raw;
+  AdcFlagVector m_flags;
+
+};
+
+//**********************************************************************
+
+inline void AdcChannelBlock::reset(Index nrow, Index ntick, Index content) {
+  m_content = content | Samples;
+  m_ntick = ntick;
+  Index npad = rowPadding();
+  m_stride = npad*((ntick + npad - 1)/npad);
+  m_channels.assign(nrow, AdcChannelData::badChannel());
+  m_rows.clear();
+  Index ndat = nrow*m_stride;
+  m_samples.assign(ndat, 0.0);
+  m_raw.assign(hasRaw() ? ndat : 0, 0);
+  m_flags.assign(hasFlags() ? ndat : 0, 0);
+}
+
+//**********************************************************************
+
+inline int AdcChannelBlock::setChannel(Index irow, AdcChannel icha) {
+  if ( irow >= nrow() ) return 1;
+  if ( m_rows.count(icha) ) return 2;
+  m_rows.erase(m_channels[irow]);
+  m_channels[irow] = icha;
+  m_rows[icha] = irow;
+  return 0;
+}
+
+//**********************************************************************
+
+inline int AdcChannelBlock::load(const AdcChannelDataMap& acds, Index content) {
+  EntryVector ents;
+  ents.reserve(acds.size());
+  for ( const auto& iacd : acds ) ents.push_back(&iacd);
+  return loadEntries(ents, content);
+}
+
+//**********************************************************************
+
+inline int AdcChannelBlock::
+load(const AdcChannelDataMap& acds, const ChannelVector& chans, Index content) {
+  EntryVector ents;
+  ents.reserve(acds.size());
+  std::set<AdcChannel> used;
+  for ( AdcChannel icha : chans ) {
+    AdcChannelDataMap::const_iterator iacd = acds.find(icha);
+    if ( iacd == acds.end() || ! used.insert(icha).second ) continue;
+    ents.push_back(&*iacd);
+  }
+  if ( ents.size() < acds.size() ) {
+    for ( const auto& iacd : acds ) if ( used.count(iacd.first) == 0 ) ents.push_back(&iacd);
+  }
+  return loadEntries(ents, content);
+}
+
+//**********************************************************************
+
+inline int AdcChannelBlock::loadEntries(const EntryVector& ents, Index content) {
+  Index ntick = 0;
+  for ( const auto* pent : ents ) {
+    Index nsam = pent->second.sampleCount();
+    if ( nsam > ntick ) ntick = nsam;
+    Index nraw = (content & Raw) ? pent->second.raw.size() : 0;
+    if ( nraw > ntick ) ntick = nraw;
+  }
+  reset(ents.size(), ntick, content);
+  Index irow = 0;
+  for ( const auto* pent : ents ) {
+    const AdcChannelData& acd = pent->second;
+    setChannel(irow, pent->first);
+    const AdcSignal* pin = acd.sampleData();
+    AdcSignal* pout = samples(irow);
+    Index nsam = acd.sampleCount();
+    for ( Index itck=0; itck<nsam; ++itck ) pout[itck] = pin[itck];
+    if ( hasRaw() ) {
+      AdcCount* praw = raw(irow);
+      Index nraw = acd.raw.size() < ntick ? acd.raw.size() : ntick;
+      for ( Index itck=0; itck<nraw; ++itck ) praw[itck] = acd.raw[itck];
+    }
+    if ( hasFlags() ) {
+      AdcFlag* pflg = flags(irow);
+      Index nflg = acd.flags.size() < ntick ? acd.flags.size() : ntick;
+      for ( Index itck=0; itck<nflg; ++itck ) pflg[itck] = acd.flags[itck];
+    }
+    ++irow;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+inline AdcChannelBlock::Index AdcChannelBlock::bind(AdcChannelDataMap& acds) {
+  Index nbad = 0;
+  for ( auto& iacd : acds ) {
+    Index irow = row(iacd.first);
+    if ( irow == badIndex() ) {
+      ++nbad;
+      continue;
+    }
+    iacd.second.blockSamples = samples(irow);
+    iacd.second.blockTicks = m_ntick;
+  }
+  return nbad;
+}
+
+//**********************************************************************
+
+inline void AdcChannelBlock::unbind(AdcChannelDataMap& acds) {
+  for ( auto& iacd : acds ) {
+    iacd.second.blockSamples = nullptr;
+    iacd.second.blockTicks = 0;
+  }
+}
+
+//**********************************************************************
+
+inline AdcChannelBlock::Index AdcChannelBlock::store(AdcChannelDataMap& acds) const {
+  Index nbad = 0;
+  for ( auto& iacd : acds ) {
+    Index irow = row(iacd.first);
+    if ( irow == badIndex() ) {
+      ++nbad;
+      continue;
+    }
+    AdcChannelData& acd = iacd.second;
+    const AdcSignal* pin = samples(irow);
+    if ( acd.blockSamples == pin ) acd.blockSamples = nullptr;
+    acd.samples.assign(pin, pin + m_ntick);
+    if ( hasRaw() ) acd.raw.assign(raw(irow), raw(irow) + m_ntick);
+    if ( hasFlags() ) acd.flags.assign(flags(irow), flags(irow) + m_ntick);
+  }
+  return nbad;
+}
+
+//**********************************************************************
+
+#endif
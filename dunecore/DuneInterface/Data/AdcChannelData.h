@@ -21,6 +21,11 @@
 //   fembChannel - Channel number in FEMB (0, 1,..., 127).
 // channelStatus - Channel status (0=ok, 1=bad, 2=noisy)
 //
+// The event and channel info are shared pointers. Decoders should create one event
+// info for each event and attach it to all channels, e.g. with
+// setEventInfo(AdcChannelDataMap&, EventInfoPtr), and take the channel info from a
+// DuneChannelInfoTable filled once per run, so that no allocation is made per channel.
+//
 // Held directly:
 //  channelClock - Time counter for the channel data
 //         tick0 - Tick offset between triggerTick0 and first tick in raw/samples data.
@@ -34,10 +39,21 @@
 //   sampleNoise - Noise level (e.g. RMS for samples)
 //         flags - Array holding the status flag for each tick
 //        signal - Array holding bools indicating which ticks have signals
+//                 AdcBitMask provides a packed form with conversions to and from rois.
 //          rois - Array of ROIs indicating ticks of interest (e.g. have signals)
 //       dftmags - Array of magnitudes for the DFT of the samples.
 //     dftphases - Array of phases for the DFT of the samples.
-//      metadata - Extra attributes
+//      metadata - Extra attributes (see AdcMetadata)
+//                 Before class version 10 this was written as a std::map<string, float>;
+//                 an ioread rule in classes_def.xml converts such data when it is read.
+//
+//  blockSamples - Non-owning pointer to samples held elsewhere: the row for this channel
+//                 in an AdcChannelBlock (see AdcChannelBlock::bind) or a range of the
+//                 samples of the view parent (see addSampleView). Null if not bound.
+//    blockTicks - Number of ticks in that row or range.
+//                 Use sampleData() and sampleCount() to access the bound samples if
+//                 present and those in samples otherwise. Not persisted.
+//    viewOffset - For a sample view, the offset of its first sample in the parent.
 //
 //         digit - Corresponding raw digit
 //          wire - Corresponding wire
@@ -49,6 +65,12 @@
 //    viewParent - Pointer to the data object holding this as a view. Creator of the view
 //                 object is responsible for filling this field.
 //
+// Lightweight views, e.g. one for each ROI, may be made with addSampleView or
+// addRoiViews. These reference a sample range of the parent through blockSamples
+// rather than copying it, and share the parent event and channel info. Writes through
+// sampleData() modify the parent samples; call detachSamples() first to give the view
+// its own copy. The parent samples must not be resized while such views exist.
+//
 // User can compare values against the defaults below to know if a value has been set.
 // For arrays, check if the size in nonzero.
 //
@@ -84,6 +106,8 @@
 #include "dunecore/DuneInterface/Data/AdcTypes.h"
 #include "dunecore/DuneInterface/Data/DuneEventInfo.h"
 #include "dunecore/DuneInterface/Data/DuneChannelInfo.h"
+#include "dunecore/DuneInterface/Data/DuneChannelInfoTable.h"
+#include "dunecore/DuneInterface/Data/AdcMetadata.h"
 
 namespace raw {
   class RawDigit;
@@ -99,6 +123,8 @@ public:
   using Name = std::string;
   using NameVector = std::vector<Name>;
   using FloatMap = std::map<Name, float>;
+  using Metadata = AdcMetadata;
+  using MetadataKey = AdcMetadata::Key;
   using View = std::vector<AdcChannelData>;
   using ViewMap = std::map<Name, View>;
   using EventInfo = DuneEventInfo;
@@ -137,7 +163,10 @@ public:
   AdcRoiVector rois;
   AdcSignalVector dftmags;
   AdcSignalVector dftphases;
-  FloatMap metadata;
+  Metadata metadata;
+  AdcSignal* blockSamples =nullptr;
+  AdcIndex blockTicks =0;
+  AdcIndex viewOffset =0;
   AdcChannelData* viewParent =nullptr;
 
   // Connections to persistent data.
@@ -190,6 +219,14 @@ public:
     setChannelInfo(new ChannelInfo(a_channel, a_fembID, a_fembChannel, a_channelStatus));
   }
 
+  // Set channel info from a table. Info is created for this channel if the
+  // table has none.
+  void setChannelInfo(const DuneChannelInfoTable& tab, Channel a_channel) {
+    ChannelInfoPtr pchi = tab.get(a_channel);
+    if ( pchi ) setChannelInfo(pchi);
+    else setChannelInfo(a_channel);
+  }
+
   // Return channel info.
   bool hasChannelInfo() const { return bool(m_pchanInfo); }
   ChannelInfoPtr getChannelInfoPtr() const { return m_pchanInfo; }
@@ -210,6 +247,12 @@ public:
     return tickoff + AdcLongIndex(tick0);
   }
 
+  // Return the samples for this channel: the block row if bound and samples otherwise.
+  bool hasBlockSamples() const { return blockSamples != nullptr; }
+  AdcSignal* sampleData() { return hasBlockSamples() ? blockSamples : samples.data(); }
+  const AdcSignal* sampleData() const { return hasBlockSamples() ? blockSamples : samples.data(); }
+  AdcIndex sampleCount() const { return hasBlockSamples() ? blockTicks : samples.size(); }
+
   // Copy ctor.
   // Only copy event and channel data and not samples and
   // derived data.
@@ -234,25 +277,32 @@ public:
       if ( viewParent == nullptr ) return false;
       return viewParent->hasMetadata(mname.substr(3));
     }
-    return metadata.find(mname) != metadata.end();
+    return metadata.count(mname);
   }
 
+  // Check if a metadata field is defined using its key.
+  bool hasMetadata(MetadataKey mkey) const { return metadata.has(mkey); }
+
   // Fetch metadata.
   float getMetadata(Name mname, float def =0.0) const {
     if ( mname.substr(0,3) == "../" ) {
       if ( viewParent == nullptr ) return def;
       return viewParent->getMetadata(mname.substr(3));
     }
-    FloatMap::const_iterator imtd = metadata.find(mname);
-    if ( imtd == metadata.end() ) return def;
-    return imtd->second;
+    return metadata.get(AdcMetadata::findKey(mname), def);
   }
 
+  // Fetch metadata using its key.
+  float getMetadata(MetadataKey mkey, float def =0.0) const { return metadata.get(mkey, def); }
+
   // Set metadata.
   void setMetadata(Name mname, float val) {
     metadata[mname] = val;
   }
 
+  // Set metadata using its key.
+  void setMetadata(MetadataKey mkey, float val) { metadata.set(mkey, val); }
+
   // Check if an attribute is defined.
   bool hasAttribute(Name mname, float def =0.0) const {
     if ( mname.substr(0,3) == "../" ) {
@@ -355,6 +405,24 @@ public:
   // View is added if not already existing.
   View& updateView(Name vnam);
 
+  // Remove all views.
+  void clearViews() { m_views.clear(); }
+
+  // Add an entry to view vnam that references samples [isam0, isam0+nsam) of this
+  // object, clipped to sampleCount(), without copying them.
+  // Returns the new entry. Adding entries invalidates references to earlier ones.
+  AdcChannelData& addSampleView(Name vnam, AdcIndex isam0, AdcIndex nsam);
+
+  // Add a sample view entry to view vnam for each ROI.
+  // Returns the number of entries added.
+  AdcIndex addRoiViews(Name vnam ="rois");
+
+  // Return if this references the samples of its view parent.
+  bool isSampleView() const { return viewParent != nullptr && hasBlockSamples(); }
+
+  // Copy the referenced samples into samples and drop the reference.
+  void detachSamples();
+
   // Return the number of entries for a specified view path.
   // This includes the self view.
   AdcIndex viewSize(Name vpnam) const;
@@ -381,6 +449,11 @@ typedef std::map<AdcChannel, AdcChannelData> AdcChannelDataMap;
 #pragma link C++ class AdcChannelDataMap;
 #endif
 
+// Attach the same event info to all channels in a map.
+inline void setEventInfo(AdcChannelDataMap& acds, AdcChannelData::EventInfoPtr pevi) {
+  for ( AdcChannelDataMap::value_type& iacd : acds ) iacd.second.setEventInfo(pevi);
+}
+
 //**********************************************************************
 
 inline void AdcChannelData::clear() {
@@ -404,6 +477,9 @@ inline void AdcChannelData::clear() {
   digitIndex = badIndex();
   wireIndex = badIndex();
   metadata.clear();
+  blockSamples = nullptr;
+  blockTicks = 0;
+  viewOffset = 0;
   m_peventInfo.reset();
   m_pchanInfo.reset();
 }
@@ -547,4 +623,51 @@ AdcChannelData* AdcChannelData::mutableViewEntry(Name vpnam, AdcIndex ient) {
   
 //**********************************************************************
 
+inline
+AdcChannelData& AdcChannelData::addSampleView(Name vnam, AdcIndex isam0, AdcIndex nsam) {
+  AdcIndex nsamPar = sampleCount();
+  if ( isam0 > nsamPar ) isam0 = nsamPar;
+  if ( nsam > nsamPar - isam0 ) nsam = nsamPar - isam0;
+  View& vie = updateView(vnam);
+  vie.emplace_back();
+  AdcChannelData& acd = vie.back();
+  acd.m_peventInfo = m_peventInfo;
+  acd.m_pchanInfo = m_pchanInfo;
+  acd.channelClock = channelClock;
+  acd.tick0 = tick0 + isam0;
+  acd.pedestal = pedestal;
+  acd.pedestalRms = pedestalRms;
+  acd.sampleUnit = sampleUnit;
+  acd.sampleNoise = sampleNoise;
+  acd.blockSamples = sampleData() == nullptr ? nullptr : sampleData() + isam0;
+  acd.blockTicks = nsam;
+  acd.viewOffset = isam0;
+  acd.viewParent = this;
+  return acd;
+}
+
+//**********************************************************************
+
+inline
+AdcIndex AdcChannelData::addRoiViews(Name vnam) {
+  View& vie = updateView(vnam);
+  vie.reserve(vie.size() + rois.size());
+  for ( const AdcRoi& roi : rois ) {
+    addSampleView(vnam, roi.first, roi.second + 1 - roi.first);
+  }
+  return rois.size();
+}
+
+//**********************************************************************
+
+inline
+void AdcChannelData::detachSamples() {
+  if ( ! hasBlockSamples() ) return;
+  samples.assign(blockSamples, blockSamples + blockTicks);
+  blockSamples = nullptr;
+  blockTicks = 0;
+}
+
+//**********************************************************************
+
 #endif
@@ -0,0 +1,223 @@
+// AdcChannelDataFlatMap.h
+//
+// Flat alternative to AdcChannelDataMap.
+//
+// The channel data are held in one vector of (channel, data) pairs sorted by channel
+// so that tools looping over all channels, e.g. of an APA, access memory sequentially
+// and filling the container needs one allocation rather than one per channel.
+// Lookup by channel uses a dense index of positions for the channels between the
+// lowest and highest in the container, so the channels should be (nearly) contiguous.
+//
+// The interface follows that of std::map: iteration yields entries with members first
+// (channel) and second (AdcChannelData) in channel order, and find, count, operator[],
+// at, erase, size and empty are provided. Unlike a map, adding or erasing a channel
+// invalidates iterators and references to the data of other channels, and with it the
+// view parent pointers of their views. Add channels in increasing order (which is
+// cheapest) and attach views after the container is filled.
+//
+// Data may be moved between the two containers with moveFrom and moveTo, e.g. to use
+// the flat container for a map obtained from TpcData.
+
+#ifndef AdcChannelDataFlatMap_H
+#define AdcChannelDataFlatMap_H
+
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+
+class AdcChannelDataFlatMap {
+
+public:
+
+  using Index = AdcIndex;
+  using key_type = AdcChannel;
+  using mapped_type = AdcChannelData;
+  using value_type = std::pair<AdcChannel, AdcChannelData>;
+  using Vector = std::vector<value_type>;
+  using iterator = Vector::iterator;
+  using const_iterator = Vector::const_iterator;
+  using IndexVector = std::vector<Index>;
+
+  // The copy ctor of AdcChannelData drops the samples, so the vector must move
+  // its entries when it grows.
+  static_assert(std::is_nothrow_move_constructible<AdcChannelData>::value,
+                "AdcChannelData must be nothrow move constructible.");
+
+  static Index badIndex() { return AdcChannelData::badIndex(); }
+
+  // Default ctor.
+  AdcChannelDataFlatMap() =default;
+
+  // Ctor moving the data from a map. The map is left empty.
+  explicit AdcChannelDataFlatMap(AdcChannelDataMap&& acds) { moveFrom(acds); }
+
+  // No copy. Move is allowed.
+  AdcChannelDataFlatMap(const AdcChannelDataFlatMap&) =delete;
+  AdcChannelDataFlatMap& operator=(const AdcChannelDataFlatMap&) =delete;
+  AdcChannelDataFlatMap(AdcChannelDataFlatMap&&) =default;
+  AdcChannelDataFlatMap& operator=(AdcChannelDataFlatMap&&) =default;
+
+  // Size.
+  std::size_t size() const { return m_entries.size(); }
+  bool empty() const { return m_entries.empty(); }
+
+  // Reserve space for ncha channels.
+  void reserve(Index ncha) { m_entries.reserve(ncha); }
+
+  // Remove all channels.
+  void clear() { m_entries.clear(); m_index.clear(); m_icha0 = 0; }
+
+  // Iteration in channel order.
+  iterator begin() { return m_entries.begin(); }
+  iterator end() { return m_entries.end(); }
+  const_iterator begin() const { return m_entries.begin(); }
+  const_iterator end() const { return m_entries.end(); }
+
+  // Position of a channel or badIndex() if it is not present.
+  Index position(AdcChannel icha) const {
+    if ( icha < m_icha0 ) return badIndex();
+    Index iidx = icha - m_icha0;
+    return iidx < m_index.size() ? m_index[iidx] : badIndex();
+  }
+
+  // Lookup.
+  std::size_t count(AdcChannel icha) const { return position(icha) != badIndex(); }
+  iterator find(AdcChannel icha) {
+    Index ipos = position(icha);
+    return ipos == badIndex() ? end() : begin() + ipos;
+  }
+  const_iterator find(AdcChannel icha) const {
+    Index ipos = position(icha);
+    return ipos == badIndex() ? end() : begin() + ipos;
+  }
+  AdcChannelData& at(AdcChannel icha) {
+    Index ipos = position(icha);
+    if ( ipos == badIndex() ) throw std::out_of_range("AdcChannelDataFlatMap::at");
+    return m_entries[ipos].second;
+  }
+  const AdcChannelData& at(AdcChannel icha) const {
+    Index ipos = position(icha);
+    if ( ipos == badIndex() ) throw std::out_of_range("AdcChannelDataFlatMap::at");
+    return m_entries[ipos].second;
+  }
+
+  // Return the data for a channel, adding it if it is not present.
+  AdcChannelData& operator[](AdcChannel icha) { return insert(icha).first->second; }
+
+  // Add a channel. Returns the iterator for the channel and whether it was added.
+  std::pair<iterator, bool> insert(AdcChannel icha, AdcChannelData&& acd =AdcChannelData());
+
+  // Remove a channel. Returns the number removed.
+  std::size_t erase(AdcChannel icha);
+
+  // Move the data in acds into this container, replacing any existing data for the
+  // same channels. The map is left empty.
+  void moveFrom(AdcChannelDataMap& acds);
+
+  // Move the data in this container into acds, replacing any existing data for the
+  // same channels. This container is left empty.
+  void moveTo(AdcChannelDataMap& acds);
+
+  // Dense index: position for each channel starting at firstIndexChannel().
+  AdcChannel firstIndexChannel() const { return m_icha0; }
+  const IndexVector& index() const { return m_index; }
+
+private:
+
+  // Set the index for the entries starting at position ipos.
+  void reindex(Index ipos);
+
+  Vector m_entries;
+  AdcChannel m_icha0 = 0;
+  IndexVector m_index;
+
+};
+
+//**********************************************************************
+
+inline std::pair<AdcChannelDataFlatMap::iterator, bool>
+AdcChannelDataFlatMap::insert(AdcChannel icha, AdcChannelData&& acd) {
+  Index ipos = position(icha);
+  if ( ipos != badIndex() ) return {begin() + ipos, false};
+  // Extend the index to include the new channel.
+  if ( m_index.empty() ) {
+    m_icha0 = icha;
+    m_index.assign(1, badIndex());
+  } else if ( icha < m_icha0 ) {
+    m_index.insert(m_index.begin(), m_icha0 - icha, badIndex());
+    m_icha0 = icha;
+  } else if ( icha - m_icha0 >= m_index.size() ) {
+    m_index.resize(icha - m_icha0 + 1, badIndex());
+  }
+  // Most often the new channel is the last.
+  iterator ient = end();
+  if ( ! empty() && icha < m_entries.back().first ) {
+    ient = std::lower_bound(begin(), end(), icha,
+                            [](const value_type& ent, AdcChannel ich) { return ent.first < ich; });
+  }
+  ipos = ient - begin();
+  m_entries.emplace(ient, icha, std::move(acd));
+  reindex(ipos);
+  return {begin() + ipos, true};
+}
+
+//**********************************************************************
+
+inline std::size_t AdcChannelDataFlatMap::erase(AdcChannel icha) {
+  Index ipos = position(icha);
+  if ( ipos == badIndex() ) return 0;
+  m_entries.erase(begin() + ipos);
+  m_index[icha - m_icha0] = badIndex();
+  reindex(ipos);
+  return 1;
+}
+
+//**********************************************************************
+
+inline void AdcChannelDataFlatMap::moveFrom(AdcChannelDataMap& acds) {
+  if ( empty() ) {
+    // Fast path: the map is already sorted.
+    m_entries.reserve(acds.size());
+    for ( AdcChannelDataMap::value_type& iacd : acds ) {
+      m_entries.emplace_back(iacd.first, std::move(iacd.second));
+    }
+    acds.clear();
+    m_index.clear();
+    if ( ! empty() ) {
+      m_icha0 = m_entries.front().first;
+      m_index.assign(m_entries.back().first - m_icha0 + 1, badIndex());
+      reindex(0);
+    }
+    return;
+  }
+  for ( AdcChannelDataMap::value_type& iacd : acds ) {
+    (*this)[iacd.first] = std::move(iacd.second);
+  }
+  acds.clear();
+}
+
+//**********************************************************************
+
+inline void AdcChannelDataFlatMap::moveTo(AdcChannelDataMap& acds) {
+  AdcChannelDataMap::iterator ihint = acds.end();
+  for ( value_type& ent : m_entries ) {
+    ihint = acds.insert_or_assign(ihint, ent.first, std::move(ent.second));
+    ++ihint;
+  }
+  clear();
+}
+
+//**********************************************************************
+
+inline void AdcChannelDataFlatMap::reindex(Index ipos) {
+  for ( Index jpos=ipos; jpos<m_entries.size(); ++jpos ) {
+    m_index[m_entries[jpos].first - m_icha0] = jpos;
+  }
+}
+
+//**********************************************************************
+
+#endif
@@ -0,0 +1,325 @@
+// AdcChannelDataMapPacked.cxx
+
+#include "dunecore/DuneInterface/Data/AdcChannelDataMapPacked.h"
+#include "dunecore/DuneInterface/Data/AdcBitMask.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using Index = AdcChannelDataMapPacked::Index;
+using Options = AdcChannelDataMapPacked::Options;
+using Name = AdcChannelDataMapPacked::Name;
+using EventInfoPtr = AdcChannelData::EventInfoPtr;
+
+namespace {
+
+const float maxQuantum = 32767.0;
+
+// Call fun(isam1, isam2) for each of the ROIs clipped to nsam, i.e. for the
+// sample ranges [isam1, isam2) that are stored in ROI-only mode.
+template<class F>
+void forEachRoiRange(const AdcRoiVector& rois, Index nsam, F fun) {
+  for ( const AdcRoi& roi : rois ) {
+    if ( roi.first >= nsam || roi.second < roi.first ) continue;
+    Index isam2 = std::min(roi.second + 1, nsam);
+    fun(roi.first, isam2);
+  }
+}
+
+// Return the index of name in names, adding it if needed.
+Index nameIndex(std::map<Name, Index>& idxs, std::vector<Name>& names, const Name& name) {
+  auto iidx = idxs.find(name);
+  if ( iidx != idxs.end() ) return iidx->second;
+  Index idx = names.size();
+  idxs[name] = idx;
+  names.push_back(name);
+  return idx;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+void AdcChannelDataMapPacked::pack(const AdcChannelDataMap& acds, const Options& opt) {
+  clear();
+  m_sampleQuantum = opt.sampleQuantum > 0.0 ? opt.sampleQuantum : 0.0;
+  m_roiOnly = opt.roiOnly;
+  m_keepRaw = opt.keepRaw;
+  m_keepFlags = opt.keepFlags;
+  std::map<const DuneEventInfo*, Index> evis;
+  std::map<Name, Index> units;
+  std::map<Name, Index> mets;
+  Index ncha = acds.size();
+  for ( IndexVector* pvec : {&m_fembIDs, &m_fembChannels, &m_channelStatuses, &m_eventIndices,
+                             &m_unitIndices, &m_rawCounts, &m_sampleCounts, &m_flagCounts,
+                             &m_signalCounts, &m_roiCounts, &m_metadataCounts} ) {
+    pvec->reserve(ncha);
+  }
+  m_channels.reserve(ncha);
+  std::vector<float> sams;
+  for ( const AdcChannelDataMap::value_type& iacd : acds ) {
+    const AdcChannelData& acd = iacd.second;
+    m_channels.push_back(iacd.first);
+    m_fembIDs.push_back(acd.fembID());
+    m_fembChannels.push_back(acd.fembChannel());
+    m_channelStatuses.push_back(acd.channelStatus());
+    const DuneEventInfo* pevi = acd.getEventInfoPtr().get();
+    Index ievi = AdcChannelData::badIndex();
+    if ( pevi != nullptr ) {
+      auto iidx = evis.find(pevi);
+      if ( iidx == evis.end() ) {
+        ievi = m_eventInfos.size();
+        evis[pevi] = ievi;
+        m_eventInfos.push_back(*pevi);
+      } else {
+        ievi = iidx->second;
+      }
+    }
+    m_eventIndices.push_back(ievi);
+    m_unitIndices.push_back(nameIndex(units, m_sampleUnits, acd.sampleUnit));
+    m_tick0s.push_back(acd.tick0);
+    m_channelClocks.push_back(acd.channelClock);
+    m_pedestals.push_back(acd.pedestal);
+    m_pedestalRmss.push_back(acd.pedestalRms);
+    m_sampleNoises.push_back(acd.sampleNoise);
+    // Raw and flags.
+    m_rawCounts.push_back(m_keepRaw ? acd.raw.size() : 0);
+    if ( m_keepRaw ) m_raw.insert(m_raw.end(), acd.raw.begin(), acd.raw.end());
+    m_flagCounts.push_back(m_keepFlags ? acd.flags.size() : 0);
+    if ( m_keepFlags ) m_flags.insert(m_flags.end(), acd.flags.begin(), acd.flags.end());
+    // Samples.
+    Index nsam = acd.sampleCount();
+    const AdcSignal* psam = acd.sampleData();
+    m_sampleCounts.push_back(nsam);
+    sams.clear();
+    if ( m_roiOnly ) {
+      forEachRoiRange(acd.rois, nsam, [&sams, psam](Index isam1, Index isam2) {
+        sams.insert(sams.end(), psam + isam1, psam + isam2);
+      });
+    } else {
+      sams.assign(psam, psam + nsam);
+    }
+    if ( isQuantized() ) {
+      float amax = 0.0;
+      for ( float sam : sams ) if ( std::isfinite(sam) ) amax = std::max(amax, std::fabs(sam));
+      float step = m_sampleQuantum;
+      if ( amax > maxQuantum*step ) step = amax/maxQuantum*(1.0 + 1.e-6);
+      m_sampleSteps.push_back(step);
+      float rstep = 1.0/step;
+      for ( float sam : sams ) {
+        float qval = std::isfinite(sam) ? std::nearbyint(sam*rstep) : 0.0;
+        qval = std::min(maxQuantum, std::max(-maxQuantum, qval));
+        m_quantizedSamples.push_back(short(qval));
+      }
+    } else {
+      m_samples.insert(m_samples.end(), sams.begin(), sams.end());
+    }
+    // Signal, ROIs and metadata.
+    m_signalCounts.push_back(acd.signal.size());
+    AdcBitMask sig(acd.signal);
+    m_signalWords.insert(m_signalWords.end(), sig.words(), sig.words() + sig.nword());
+    m_roiCounts.push_back(acd.rois.size());
+    for ( const AdcRoi& roi : acd.rois ) {
+      m_roiBounds.push_back(roi.first);
+      m_roiBounds.push_back(roi.second);
+    }
+    m_metadataCounts.push_back(acd.metadata.size());
+    for ( const auto& ent : acd.metadata ) {
+      m_metadataKeys.push_back(nameIndex(mets, m_metadataNames, ent.first));
+      m_metadataValues.push_back(ent.second);
+    }
+  }
+}
+
+//**********************************************************************
+
+int AdcChannelDataMapPacked::unpack(AdcChannelDataMap& acds) const {
+  Index ncha = size();
+  // Check the per-channel columns and the totals of the value columns.
+  for ( const IndexVector* pvec : {&m_fembIDs, &m_fembChannels, &m_channelStatuses, &m_eventIndices,
+                                   &m_unitIndices, &m_rawCounts, &m_sampleCounts, &m_flagCounts,
+                                   &m_signalCounts, &m_roiCounts, &m_metadataCounts} ) {
+    if ( pvec->size() != ncha ) return 1;
+  }
+  if ( m_tick0s.size() != ncha || m_channelClocks.size() != ncha || m_pedestals.size() != ncha ||
+       m_pedestalRmss.size() != ncha || m_sampleNoises.size() != ncha ) return 1;
+  if ( isQuantized() && m_sampleSteps.size() != ncha ) return 1;
+  std::size_t nraw = 0;
+  std::size_t nsto = 0;
+  std::size_t nflg = 0;
+  std::size_t nwrd = 0;
+  std::size_t nroi = 0;
+  std::size_t nmet = 0;
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    if ( m_unitIndices[icha] >= m_sampleUnits.size() ) return 1;
+    if ( m_eventIndices[icha] != AdcChannelData::badIndex() &&
+         m_eventIndices[icha] >= m_eventInfos.size() ) return 1;
+    nraw += m_rawCounts[icha];
+    nflg += m_flagCounts[icha];
+    nwrd += AdcBitMask::wordCount(m_signalCounts[icha]);
+    nmet += m_metadataCounts[icha];
+    if ( m_roiOnly ) {
+      if ( 2*(nroi + m_roiCounts[icha]) > m_roiBounds.size() ) return 1;
+      for ( Index iroi=0; iroi<m_roiCounts[icha]; ++iroi ) {
+        Index isam1 = m_roiBounds[2*(nroi + iroi)];
+        Index isam2 = m_roiBounds[2*(nroi + iroi) + 1];
+        if ( isam1 < m_sampleCounts[icha] && isam2 >= isam1 ) {
+          nsto += std::min(isam2 + 1, m_sampleCounts[icha]) - isam1;
+        }
+      }
+    } else {
+      nsto += m_sampleCounts[icha];
+    }
+    nroi += m_roiCounts[icha];
+  }
+  if ( nraw != m_raw.size() || nflg != m_flags.size() || nwrd != m_signalWords.size() ||
+       2*nroi != m_roiBounds.size() || nmet != m_metadataKeys.size() ||
+       nmet != m_metadataValues.size() ) return 1;
+  if ( nsto != (isQuantized() ? m_quantizedSamples.size() : m_samples.size()) ) return 1;
+  for ( Index imet : m_metadataKeys ) if ( imet >= m_metadataNames.size() ) return 1;
+  // Shared event infos.
+  std::vector<EventInfoPtr> evis;
+  evis.reserve(m_eventInfos.size());
+  for ( const DuneEventInfo& evi : m_eventInfos ) evis.push_back(std::make_shared<DuneEventInfo>(evi));
+  // Fill the channels.
+  int rstat = 0;
+  std::size_t iraw = 0;
+  std::size_t isto = 0;
+  std::size_t iflg = 0;
+  std::size_t iwrd = 0;
+  std::size_t iroi = 0;
+  std::size_t imet = 0;
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    auto iacd = acds.end();
+    bool added = false;
+    if ( acds.count(m_channels[icha]) ) {
+      rstat = 2;
+    } else {
+      iacd = acds.emplace(m_channels[icha], AdcChannelData()).first;
+      added = true;
+    }
+    Index nsam = m_sampleCounts[icha];
+    AdcRoiVector rois(m_roiCounts[icha]);
+    for ( AdcRoi& roi : rois ) {
+      roi.first = m_roiBounds[2*iroi];
+      roi.second = m_roiBounds[2*iroi + 1];
+      ++iroi;
+    }
+    Index nwrdCha = AdcBitMask::wordCount(m_signalCounts[icha]);
+    if ( added ) {
+      AdcChannelData& acd = iacd->second;
+      acd.setChannelInfo(m_channels[icha], m_fembIDs[icha], m_fembChannels[icha], m_channelStatuses[icha]);
+      if ( m_eventIndices[icha] != AdcChannelData::badIndex() ) acd.setEventInfo(evis[m_eventIndices[icha]]);
+      acd.tick0 = m_tick0s[icha];
+      acd.channelClock = m_channelClocks[icha];
+      acd.pedestal = m_pedestals[icha];
+      acd.pedestalRms = m_pedestalRmss[icha];
+      acd.sampleNoise = m_sampleNoises[icha];
+      acd.sampleUnit = m_sampleUnits[m_unitIndices[icha]];
+      acd.raw.assign(m_raw.begin() + iraw, m_raw.begin() + iraw + m_rawCounts[icha]);
+      acd.flags.assign(m_flags.begin() + iflg, m_flags.begin() + iflg + m_flagCounts[icha]);
+      float step = isQuantized() ? m_sampleSteps[icha] : 0.0;
+      std::size_t jsto = isto;
+      auto getSample = [this, step, &jsto]() -> float {
+        float val = step > 0.0 ? step*m_quantizedSamples[jsto] : m_samples[jsto];
+        ++jsto;
+        return val;
+      };
+      acd.samples.assign(nsam, 0.0);
+      if ( m_roiOnly ) {
+        forEachRoiRange(rois, nsam, [&acd, &getSample](Index isam1, Index isam2) {
+          for ( Index isam=isam1; isam<isam2; ++isam ) acd.samples[isam] = getSample();
+        });
+      } else {
+        for ( Index isam=0; isam<nsam; ++isam ) acd.samples[isam] = getSample();
+      }
+      AdcBitMask sig(m_signalCounts[icha]);
+      std::copy(m_signalWords.begin() + iwrd, m_signalWords.begin() + iwrd + nwrdCha, sig.words());
+      sig.toVector(acd.signal);
+      acd.rois = rois;
+      for ( Index jmet=0; jmet<m_metadataCounts[icha]; ++jmet ) {
+        acd.metadata[m_metadataNames[m_metadataKeys[imet + jmet]]] = m_metadataValues[imet + jmet];
+      }
+    }
+    // Advance the value cursors.
+    iraw += m_rawCounts[icha];
+    iflg += m_flagCounts[icha];
+    iwrd += nwrdCha;
+    imet += m_metadataCounts[icha];
+    if ( m_roiOnly ) {
+      forEachRoiRange(rois, nsam, [&isto](Index isam1, Index isam2) { isto += isam2 - isam1; });
+    } else {
+      isto += nsam;
+    }
+  }
+  return rstat;
+}
+
+//**********************************************************************
+
+void AdcChannelDataMapPacked::clear() {
+  m_sampleQuantum = 0.0;
+  m_roiOnly = false;
+  m_keepRaw = true;
+  m_keepFlags = true;
+  m_eventInfos.clear();
+  m_sampleUnits.clear();
+  m_metadataNames.clear();
+  m_channels.clear();
+  for ( IndexVector* pvec : {&m_fembIDs, &m_fembChannels, &m_channelStatuses, &m_eventIndices,
+                             &m_unitIndices, &m_rawCounts, &m_sampleCounts, &m_flagCounts,
+                             &m_signalCounts, &m_roiCounts, &m_metadataCounts,
+                             &m_roiBounds, &m_metadataKeys} ) {
+    pvec->clear();
+  }
+  m_tick0s.clear();
+  m_channelClocks.clear();
+  for ( FloatVector* pvec : {&m_pedestals, &m_pedestalRmss, &m_sampleNoises, &m_sampleSteps,
+                             &m_samples, &m_metadataValues} ) {
+    pvec->clear();
+  }
+  m_raw.clear();
+  m_quantizedSamples.clear();
+  m_flags.clear();
+  m_signalWords.clear();
+}
+
+//**********************************************************************
+
+Options AdcChannelDataMapPacked::options() const {
+  Options opt;
+  opt.sampleQuantum = m_sampleQuantum;
+  opt.roiOnly = m_roiOnly;
+  opt.keepRaw = m_keepRaw;
+  opt.keepFlags = m_keepFlags;
+  return opt;
+}
+
+//**********************************************************************
+
+std::size_t AdcChannelDataMapPacked::byteCount() const {
+  std::size_t nbyt = m_eventInfos.size()*sizeof(DuneEventInfo);
+  for ( const NameVector* pvec : {&m_sampleUnits, &m_metadataNames} ) {
+    for ( const Name& nam : *pvec ) nbyt += nam.size();
+  }
+  nbyt += m_channels.size()*sizeof(AdcChannel);
+  for ( const IndexVector* pvec : {&m_fembIDs, &m_fembChannels, &m_channelStatuses, &m_eventIndices,
+                                   &m_unitIndices, &m_rawCounts, &m_sampleCounts, &m_flagCounts,
+                                   &m_signalCounts, &m_roiCounts, &m_metadataCounts,
+                                   &m_roiBounds, &m_metadataKeys} ) {
+    nbyt += pvec->size()*sizeof(Index);
+  }
+  nbyt += m_tick0s.size()*sizeof(AdcInt);
+  nbyt += m_channelClocks.size()*sizeof(AdcLongIndex);
+  for ( const FloatVector* pvec : {&m_pedestals, &m_pedestalRmss, &m_sampleNoises, &m_sampleSteps,
+                                   &m_samples, &m_metadataValues} ) {
+    nbyt += pvec->size()*sizeof(float);
+  }
+  nbyt += m_raw.size()*sizeof(AdcCount);
+  nbyt += m_quantizedSamples.size()*sizeof(short);
+  nbyt += m_flags.size()*sizeof(AdcFlag);
+  nbyt += m_signalWords.size()*sizeof(std::uint64_t);
+  return nbyt;
+}
+
+//**********************************************************************
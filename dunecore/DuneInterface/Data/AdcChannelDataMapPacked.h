@@ -0,0 +1,143 @@
+// AdcChannelDataMapPacked.h
+//
+// Compact, column-oriented persistent form of an AdcChannelDataMap.
+//
+// Writing an AdcChannelDataMap through its ROOT dictionary streams each channel
+// member by member, including every sample, the bool vector of signal flags
+// and the sample unit string. This class instead holds one contiguous column for
+// each field with the values of all channels, so ROOT writes a few large arrays
+// that compress well:
+//   AdcChannelDataMapPacked::Options opt;
+//   opt.sampleQuantum = 0.01;    // Round samples to multiples of 0.01
+//   opt.roiOnly = true;          // Keep only the samples inside the ROIs
+//   AdcChannelDataMapPacked pack(acds, opt);
+//   ... write pack with ROOT ...
+//   AdcChannelDataMap acdsOut;
+//   pack.unpack(acdsOut);
+//
+// Options:
+//   sampleQuantum - If positive, samples are stored as 16-bit multiples of a step
+//                   which is this value or, for a channel whose samples do not fit,
+//                   the smallest step for which they do. The unpacked samples differ
+//                   from the originals by at most half the step of their channel,
+//                   see sampleStep(icha). If zero, samples are stored as floats.
+//         roiOnly - If true, only samples inside the ROIs are stored and the others
+//                   are unpacked as zero.
+//         keepRaw - If false, the raw counts are dropped.
+//       keepFlags - If false, the sample flags are dropped.
+//
+// For each channel the event and channel info, scalar conditions, raw, samples, flags,
+// signal, rois, sample unit and metadata are kept. The event info is stored once for
+// each distinct pointer and is shared again after unpacking. Binned samples, DFTs,
+// views and links to art products are not kept.
+
+#ifndef AdcChannelDataMapPacked_H
+#define AdcChannelDataMapPacked_H
+
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class AdcChannelDataMapPacked {
+
+public:
+
+  using Index = AdcIndex;
+  using IndexVector = std::vector<Index>;
+  using Name = std::string;
+  using NameVector = std::vector<Name>;
+  using FloatVector = std::vector<float>;
+  using QuantumVector = std::vector<short>;
+  using WordVector = std::vector<std::uint64_t>;
+
+  struct Options {
+    float sampleQuantum = 0.0;
+    bool roiOnly = false;
+    bool keepRaw = true;
+    bool keepFlags = true;
+  };
+
+  // Empty map.
+  AdcChannelDataMapPacked() = default;
+
+  // Pack the data in acds with the default or given options.
+  explicit AdcChannelDataMapPacked(const AdcChannelDataMap& acds) { pack(acds); }
+  AdcChannelDataMapPacked(const AdcChannelDataMap& acds, const Options& opt) { pack(acds, opt); }
+
+  // Replace the content with the data in acds.
+  void pack(const AdcChannelDataMap& acds) { pack(acds, Options()); }
+  void pack(const AdcChannelDataMap& acds, const Options& opt);
+
+  // Add the packed channels to acds.
+  // Returns 0 for success,
+  //   1 - columns are inconsistent (nothing is added)
+  //   2 - some channels are already in acds (those are left unchanged)
+  int unpack(AdcChannelDataMap& acds) const;
+
+  // Remove all channels.
+  void clear();
+
+  // Number of channels.
+  Index size() const { return m_channels.size(); }
+  bool empty() const { return m_channels.empty(); }
+
+  // Options used to pack.
+  Options options() const;
+  bool isRoiOnly() const { return m_roiOnly; }
+  bool isQuantized() const { return m_sampleQuantum > 0.0; }
+
+  // Channel number and sample step for channel index icha.
+  // The step is zero for float samples.
+  AdcChannel channel(Index icha) const { return m_channels[icha]; }
+  float sampleStep(Index icha) const { return isQuantized() ? m_sampleSteps[icha] : 0.0; }
+
+  // Approximate number of bytes in the columns.
+  std::size_t byteCount() const;
+
+private:
+
+  // Options.
+  float m_sampleQuantum = 0.0;
+  bool m_roiOnly = false;
+  bool m_keepRaw = true;
+  bool m_keepFlags = true;
+
+  // Distinct event infos, sample units and metadata names.
+  std::vector<DuneEventInfo> m_eventInfos;
+  NameVector m_sampleUnits;
+  NameVector m_metadataNames;
+
+  // One entry for each channel.
+  std::vector<AdcChannel> m_channels;
+  IndexVector m_fembIDs;
+  IndexVector m_fembChannels;
+  IndexVector m_channelStatuses;
+  IndexVector m_eventIndices;      // Index in m_eventInfos or badIndex
+  IndexVector m_unitIndices;
+  std::vector<AdcInt> m_tick0s;
+  std::vector<AdcLongIndex> m_channelClocks;
+  FloatVector m_pedestals;
+  FloatVector m_pedestalRmss;
+  FloatVector m_sampleNoises;
+  FloatVector m_sampleSteps;
+  IndexVector m_rawCounts;
+  IndexVector m_sampleCounts;      // Number of samples before any ROI selection
+  IndexVector m_flagCounts;
+  IndexVector m_signalCounts;
+  IndexVector m_roiCounts;
+  IndexVector m_metadataCounts;
+
+  // Values of all channels.
+  AdcCountVector m_raw;
+  FloatVector m_samples;
+  QuantumVector m_quantizedSamples;
+  AdcFlagVector m_flags;
+  WordVector m_signalWords;
+  IndexVector m_roiBounds;         // First and last tick of each ROI
+  IndexVector m_metadataKeys;      // Index in m_metadataNames
+  FloatVector m_metadataValues;
+
+};
+
+#endif
@@ -0,0 +1,101 @@
+// AdcChannelDataPipeline.cxx
+
+#include "dunecore/DuneInterface/Data/AdcChannelDataPipeline.h"
+
+using Index = AdcChannelDataPipeline::Index;
+using Lock = std::unique_lock<std::mutex>;
+
+//**********************************************************************
+
+AdcChannelDataPipeline::
+AdcChannelDataPipeline(Stage a_stage, Stage a_sink, Index a_maxInFlight)
+: m_stage(a_stage), m_sink(a_sink), m_maxInFlight(a_maxInFlight > 0 ? a_maxInFlight : 1) { }
+
+//**********************************************************************
+
+AdcChannelDataPipeline::~AdcChannelDataPipeline() {
+  try {
+    finish();
+  } catch ( ... ) { }
+}
+
+//**********************************************************************
+
+void AdcChannelDataPipeline::push(Batch&& acds) {
+  Lock lock(m_mutex);
+  if ( ! m_worker.joinable() ) {
+    m_stop = false;
+    m_worker = std::thread(&AdcChannelDataPipeline::run, this);
+  }
+  m_haveRoom.wait(lock, [this] { return m_queue.size() + m_nbusy < m_maxInFlight; });
+  m_queue.push_back(std::move(acds));
+  m_haveWork.notify_one();
+}
+
+//**********************************************************************
+
+int AdcChannelDataPipeline::finish() {
+  Lock lock(m_mutex);
+  if ( m_worker.joinable() ) {
+    m_haveRoom.wait(lock, [this] { return m_queue.empty() && m_nbusy == 0; });
+    m_stop = true;
+    m_haveWork.notify_one();
+    lock.unlock();
+    m_worker.join();
+    lock.lock();
+  }
+  int rstat = m_status;
+  m_status = 0;
+  if ( m_exception ) {
+    std::exception_ptr pexc = m_exception;
+    m_exception = nullptr;
+    std::rethrow_exception(pexc);
+  }
+  return rstat;
+}
+
+//**********************************************************************
+
+Index AdcChannelDataPipeline::inFlight() const {
+  Lock lock(m_mutex);
+  return m_queue.size() + m_nbusy;
+}
+
+//**********************************************************************
+
+Index AdcChannelDataPipeline::processedCount() const {
+  Lock lock(m_mutex);
+  return m_nprocessed;
+}
+
+//**********************************************************************
+
+void AdcChannelDataPipeline::run() {
+  Lock lock(m_mutex);
+  while ( true ) {
+    m_haveWork.wait(lock, [this] { return m_stop || ! m_queue.empty(); });
+    if ( m_queue.empty() ) break;
+    Batch acds = std::move(m_queue.front());
+    m_queue.pop_front();
+    ++m_nbusy;
+    lock.unlock();
+    int sstat = 0;
+    std::exception_ptr pexc;
+    try {
+      sstat = m_stage ? m_stage(acds) : 0;
+      if ( sstat == 0 && m_sink ) sstat = m_sink(acds);
+    } catch ( ... ) {
+      pexc = std::current_exception();
+    }
+    // Release the batch memory before taking the slot back.
+    acds.clear();
+    lock.lock();
+    if ( sstat != 0 && m_status == 0 ) m_status = sstat;
+    if ( pexc && ! m_exception ) m_exception = pexc;
+    --m_nbusy;
+    ++m_nprocessed;
+    m_haveRoom.notify_all();
+  }
+}
+
+//**********************************************************************
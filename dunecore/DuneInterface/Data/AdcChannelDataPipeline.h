@@ -0,0 +1,93 @@
+// AdcChannelDataPipeline.h
+//
+// Bounded producer-consumer pipeline for batches of channel data, e.g. one
+// AdcChannelDataMap for each APA.
+//
+// The producer, typically the decoder, pushes each batch as soon as it is filled.
+// A worker thread runs the stage, e.g. RawDigitPrepService::prepareBatch, and then
+// the sink, e.g. wire building or output, on each batch in push order and then
+// deletes the batch. Decoding of later batches so overlaps with preparation of
+// earlier ones. At most maxInFlight() batches are queued or being processed at
+// once: push blocks until there is room so that peak memory is that of a few
+// batches rather than the whole event.
+//
+//   AdcChannelDataPipeline pipe(
+//     [&](AdcChannelDataMap& acds) { return prepsvc.prepareBatch(clockData, acds); },
+//     [&](AdcChannelDataMap& acds) { return writeWires(acds); }, 2);
+//   for ( ApaIndex iapa : apas ) pipe.push(decode(iapa));
+//   int rstat = pipe.finish();
+//
+// The stage and sink are called on the worker thread, one batch at a time.
+// If the stage fails for a batch, the sink is not called for that batch. Later
+// batches are still processed and finish returns the first nonzero status.
+// An exception thrown by the stage or sink, e.g. a cet::exception from a tool,
+// is caught on the worker thread and the batch is counted as processed in the
+// same way. finish rethrows the first such exception after all batches are done.
+// After finish, the pipeline may be used again, e.g. for the next event.
+
+#ifndef AdcChannelDataPipeline_H
+#define AdcChannelDataPipeline_H
+
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include <functional>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <thread>
+
+class AdcChannelDataPipeline {
+
+public:
+
+  using Index = AdcIndex;
+  using Batch = AdcChannelDataMap;
+  using Stage = std::function<int(Batch&)>;
+
+  // Ctor from the stage, the sink and the number of batches allowed in flight.
+  // Either function may be empty. A maxInFlight of zero is taken to be one.
+  AdcChannelDataPipeline(Stage a_stage, Stage a_sink, Index a_maxInFlight =2);
+
+  // Dtor. Waits for the queued batches. An exception not yet rethrown by
+  // finish is dropped.
+  ~AdcChannelDataPipeline();
+
+  AdcChannelDataPipeline(const AdcChannelDataPipeline&) =delete;
+  AdcChannelDataPipeline& operator=(const AdcChannelDataPipeline&) =delete;
+
+  // Queue a batch, blocking while maxInFlight() batches are in flight.
+  // The worker thread is started on the first push.
+  void push(Batch&& acds);
+
+  // Wait for all queued batches to be processed and stop the worker.
+  // Returns the first nonzero status from the stage or sink since the last finish.
+  // Rethrows the first exception from the stage or sink since the last finish.
+  int finish();
+
+  // Configuration and counts.
+  Index maxInFlight() const { return m_maxInFlight; }
+  Index inFlight() const;
+  Index processedCount() const;
+
+private:
+
+  void run();
+
+  Stage m_stage;
+  Stage m_sink;
+  Index m_maxInFlight;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_haveWork;   // signals the worker
+  std::condition_variable m_haveRoom;   // signals push and finish
+  std::deque<Batch> m_queue;
+  Index m_nbusy = 0;
+  Index m_nprocessed = 0;
+  int m_status = 0;
+  std::exception_ptr m_exception;
+  bool m_stop = false;
+  std::thread m_worker;
+
+};
+
+#endif
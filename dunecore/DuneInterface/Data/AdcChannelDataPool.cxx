@@ -0,0 +1,158 @@
+// AdcChannelDataPool.cxx
+
+#include "dunecore/DuneInterface/Data/AdcChannelDataPool.h"
+
+using Index = AdcChannelDataPool::Index;
+using PoolPtr = AdcChannelDataPool::PoolPtr;
+using AdcDataPtr = AdcChannelDataPool::AdcDataPtr;
+
+//**********************************************************************
+
+PoolPtr AdcChannelDataPool::threadPool() {
+  thread_local PoolPtr ppool = std::make_shared<AdcChannelDataPool>();
+  return ppool;
+}
+
+//**********************************************************************
+
+AdcDataPtr AdcChannelDataPool::makeMap() {
+  std::weak_ptr<AdcChannelDataPool> wpool = threadPool();
+  // The pool may be gone if the owning thread has exited.
+  auto del = [wpool](AdcChannelDataMap* pacds) {
+    if ( PoolPtr ppool = wpool.lock() ) ppool->release(*pacds);
+    delete pacds;
+  };
+  return AdcDataPtr(new AdcChannelDataMap, del);
+}
+
+//**********************************************************************
+
+void AdcChannelDataPool::recycle(AdcChannelData& acd) {
+  acd.clear();
+  acd.binSamples.clear();
+  acd.viewParent = nullptr;
+  acd.clearViews();
+}
+
+//**********************************************************************
+
+std::size_t AdcChannelDataPool::bufferBytes(const AdcChannelData& acd) {
+  return acd.raw.capacity()*sizeof(AdcCount) +
+         acd.samples.capacity()*sizeof(AdcSignal) +
+         acd.flags.capacity()*sizeof(AdcFlag) +
+         acd.signal.capacity()/8 +
+         acd.rois.capacity()*sizeof(AdcRoi) +
+         acd.dftmags.capacity()*sizeof(AdcSignal) +
+         acd.dftphases.capacity()*sizeof(AdcSignal);
+}
+
+//**********************************************************************
+
+AdcChannelDataPool::AdcChannelDataPool(Index a_capacity, MemoryBudget* a_pbudget)
+: m_capacity(a_capacity), m_pbudget(a_pbudget) { }
+
+//**********************************************************************
+
+AdcChannelDataPool::~AdcChannelDataPool() {
+  if ( m_pbudget != nullptr ) m_pbudget->release(m_bytes);
+}
+
+//**********************************************************************
+
+void AdcChannelDataPool::setCapacity(Index val) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_capacity = val;
+  if ( m_nodes.size() > m_capacity ) eraseFrom(m_capacity);
+}
+
+//**********************************************************************
+
+void AdcChannelDataPool::setBudget(MemoryBudget* pbudget) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  eraseFrom(0);
+  m_pbudget = pbudget;
+}
+
+//**********************************************************************
+
+Index AdcChannelDataPool::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_nodes.size();
+}
+
+//**********************************************************************
+
+std::size_t AdcChannelDataPool::bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_bytes;
+}
+
+//**********************************************************************
+
+AdcChannelData& AdcChannelDataPool::insert(AdcChannelDataMap& acds, AdcChannel icha) {
+  AdcChannelDataMap::iterator iacd = acds.find(icha);
+  if ( iacd != acds.end() ) return iacd->second;
+  Node node;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if ( m_nodes.size() ) {
+      node = std::move(m_nodes.back());
+      m_nodes.pop_back();
+      std::size_t nbyte = bufferBytes(node.mapped());
+      m_bytes -= nbyte;
+      if ( m_pbudget != nullptr ) m_pbudget->release(nbyte);
+      ++m_nreuse;
+    } else {
+      ++m_nnew;
+    }
+  }
+  if ( node.empty() ) return acds[icha];
+  node.key() = icha;
+  return acds.insert(std::move(node)).position->second;
+}
+
+//**********************************************************************
+
+Index AdcChannelDataPool::release(AdcChannelDataMap& acds) {
+  std::vector<Node> nodes;
+  nodes.reserve(acds.size());
+  while ( ! acds.empty() ) {
+    Node node = acds.extract(acds.begin());
+    recycle(node.mapped());
+    nodes.push_back(std::move(node));
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Index nkeep = 0;
+  for ( Node& node : nodes ) {
+    if ( m_nodes.size() >= m_capacity ) break;
+    std::size_t nbyte = bufferBytes(node.mapped());
+    if ( m_pbudget != nullptr && ! m_pbudget->tryAcquire(nbyte) ) {
+      ++m_nbudgetDrop;
+      continue;
+    }
+    m_bytes += nbyte;
+    m_nodes.push_back(std::move(node));
+    ++nkeep;
+  }
+  return nkeep;
+}
+
+//**********************************************************************
+
+void AdcChannelDataPool::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  eraseFrom(0);
+}
+
+//**********************************************************************
+
+void AdcChannelDataPool::eraseFrom(Index ifirst) {
+  if ( ifirst >= m_nodes.size() ) return;
+  std::size_t nbyte = 0;
+  for ( Index inod=ifirst; inod<m_nodes.size(); ++inod ) nbyte += bufferBytes(m_nodes[inod].mapped());
+  m_nodes.resize(ifirst);
+  m_bytes -= nbyte;
+  if ( m_pbudget != nullptr ) m_pbudget->release(nbyte);
+}
+
+//**********************************************************************
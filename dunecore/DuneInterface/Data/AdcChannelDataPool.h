@@ -0,0 +1,111 @@
+// AdcChannelDataPool.h
+//
+// Recycling pool for the AdcChannelData held in AdcChannelDataMap.
+//
+// Each event, the prep chain fills raw, samples, flags, ... for the same channels with
+// the same sizes. Rather than freeing these buffers at the end of the event and
+// allocating them again in the next, the pool keeps the map nodes of released channel
+// maps, with the data cleared but the vector capacities retained, and hands them out
+// again when channels are added:
+//   AdcChannelDataPool::AdcDataPtr pacds = AdcChannelDataPool::makeMap();
+//   AdcChannelData& acd = AdcChannelDataPool::threadPool()->insert(*pacds, icha);
+//   acd.raw.resize(nsam);   // no allocation if the recycled buffer is large enough
+// Maps created with makeMap (including those from TpcData::createAdcData) return their
+// nodes to the pool in bulk when the last reference is dropped, e.g. when the event
+// data is deleted at the end of the event.
+//
+// There is one pool for each thread. A pool may be released to from any thread and
+// keeps at most capacity() nodes, dropping the rest.
+//
+// The bytes held by the pooled buffers are charged to a MemoryBudget, by default
+// MemoryBudget::instance(). Released nodes that do not fit in the budget are
+// deleted rather than pooled, so the pool shrinks when the input and decoders
+// need the memory.
+
+#ifndef AdcChannelDataPool_H
+#define AdcChannelDataPool_H
+
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include "dunecore/DuneInterface/Data/MemoryBudget.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+
+class AdcChannelDataPool {
+
+public:
+
+  using Index = AdcIndex;
+  using Node = AdcChannelDataMap::node_type;
+  using AdcDataPtr = std::shared_ptr<AdcChannelDataMap>;
+  using PoolPtr = std::shared_ptr<AdcChannelDataPool>;
+
+  // Return the pool for this thread.
+  static PoolPtr threadPool();
+
+  // Create an empty channel map whose nodes are released to the pool for this
+  // thread when it is deleted.
+  static AdcDataPtr makeMap();
+
+  // Clear a channel data object for reuse. The vector capacities are retained.
+  static void recycle(AdcChannelData& acd);
+
+  // Bytes held by the buffers of a channel data object.
+  static std::size_t bufferBytes(const AdcChannelData& acd);
+
+  // Ctor.
+  explicit AdcChannelDataPool(Index a_capacity =defaultCapacity(),
+                              MemoryBudget* a_pbudget =&MemoryBudget::instance());
+
+  // Dtor. Releases the pooled bytes from the budget.
+  ~AdcChannelDataPool();
+
+  // Maximum number of pooled nodes.
+  static Index defaultCapacity() { return 32768; }
+  Index capacity() const { return m_capacity; }
+  void setCapacity(Index val);
+
+  // Number of pooled nodes and bytes held by their buffers.
+  Index size() const;
+  std::size_t bytes() const;
+
+  // Budget charged with the pooled bytes, null for none. Changing the budget
+  // empties the pool.
+  MemoryBudget* budget() const { return m_pbudget; }
+  void setBudget(MemoryBudget* pbudget);
+
+  // Return the channel data for channel icha in acds, adding it from the pool if
+  // it is not already present.
+  AdcChannelData& insert(AdcChannelDataMap& acds, AdcChannel icha);
+
+  // Move the nodes of acds into the pool, leaving acds empty.
+  // Returns the number of nodes kept.
+  Index release(AdcChannelDataMap& acds);
+
+  // Delete the pooled nodes.
+  void clear();
+
+  // Counts of insertions that reused a node or allocated a new one.
+  Index reuseCount() const { return m_nreuse; }
+  Index newCount() const { return m_nnew; }
+
+  // Count of released nodes deleted because the budget was full.
+  Index budgetDropCount() const { return m_nbudgetDrop; }
+
+private:
+
+  mutable std::mutex m_mutex;
+  Index m_capacity;
+  std::vector<Node> m_nodes;
+  MemoryBudget* m_pbudget;
+  std::size_t m_bytes = 0;
+  Index m_nreuse = 0;
+  Index m_nnew = 0;
+  Index m_nbudgetDrop = 0;
+
+  // Delete the pooled nodes from position ifirst on, with the lock held.
+  void eraseFrom(Index ifirst);
+
+};
+
+#endif
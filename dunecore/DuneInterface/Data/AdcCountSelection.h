@@ -9,8 +9,14 @@
 // Class AdcSelection holds the channel number, pedestal, (floating) ADC count vector
 // and filter vector for one ADC channel. The latter indicates which channels are
 // to be retained.
+//
+// AdcCountSelectionView is the same for counts held by the caller, e.g. the ADC
+// vector of a raw digit, given as a pointer and size. The keep flags are held in a
+// bit-packed AdcBitMask. Neither the counts nor the view may be used after the
+// counts are resized or destroyed.
 
 #include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include "dunecore/DuneInterface/Data/AdcBitMask.h"
 
 struct AdcCountSelection {
 
@@ -31,4 +37,36 @@ struct AdcCountSelection {
 
 typedef std::vector<AdcCountSelection> AdcCountSelectionVector;
 
+struct AdcCountSelectionView {
+
+  // typedefs
+  typedef unsigned int Channel;
+
+  // public data
+  const AdcCount* counts;
+  AdcIndex ncount;
+  Channel channel;
+  AdcPedestal pedestal;
+  AdcBitMask keep;
+
+  // Ctor from ncount counts starting at pcounts. The mask is set to keep all.
+  AdcCountSelectionView(const AdcCount* pcounts, AdcIndex a_ncount, Channel a_channel,
+                        AdcPedestal a_pedestal)
+  : counts(pcounts), ncount(a_ncount), channel(a_channel), pedestal(a_pedestal),
+    keep(a_ncount, true) { }
+
+  // Ctor from an ADC count vector.
+  AdcCountSelectionView(const AdcCountVector& a_counts, Channel a_channel, AdcPedestal a_pedestal)
+  : AdcCountSelectionView(a_counts.data(), a_counts.size(), a_channel, a_pedestal) { }
+
+  // Access the counts.
+  AdcIndex size() const { return ncount; }
+  AdcCount operator[](AdcIndex isam) const { return counts[isam]; }
+  const AdcCount* begin() const { return counts; }
+  const AdcCount* end() const { return counts + ncount; }
+
+};
+
+typedef std::vector<AdcCountSelectionView> AdcCountSelectionViewVector;
+
 #endif
@@ -0,0 +1,257 @@
+// AdcMetadata.h
+//
+// Flat store for the float metadata attached to a channel (AdcChannelData::metadata).
+//
+// Metadata names are interned in a process-wide registry that assigns each a small
+// integer key. A store holds parallel vectors of keys, names and values sorted by key,
+// so lookups compare integers and only adding a field touches the name.
+// Tools in the per-event loop may look up the key once, e.g. at configuration,
+//   AdcMetadata::Key m_nroiKey = AdcMetadata::key("nroi");
+// and then use the key accessors
+//   acd.metadata.set(m_nroiKey, nroi);
+//
+// For compatibility with std::map<std::string, float>, the store also provides map-like
+// string access: operator[], find, count, erase, size, and iteration over entries with
+// members first (the name) and second (the value). Entries are proxies so iterate with
+//   for ( const auto& ent : acd.metadata ) cout << ent.first << ": " << ent.second << endl;
+// Iteration is in key, i.e. registration, order rather than alphabetical order.
+// Use toMap to obtain a std::map.
+//
+// The keys are specific to the process so only the names and values are persisted.
+// The keys are rebuilt from the names by restoreKeys when the store is read (see the
+// ioread rule in classes_def.xml).
+
+#ifndef AdcMetadata_H
+#define AdcMetadata_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <algorithm>
+
+class AdcMetadata {
+
+public:
+
+  using Name = std::string;
+  using Key = unsigned int;
+  using Value = float;
+  using FloatMap = std::map<Name, Value>;
+  using KeyVector = std::vector<Key>;
+  using NameVector = std::vector<Name>;
+  using ValueVector = std::vector<Value>;
+
+  static Key badKey() { return Key(-1); }
+
+  // Return the key for a name, registering it if needed.
+  static Key key(const Name& name);
+
+  // Return the key for a name or badKey() if it is not registered.
+  static Key findKey(const Name& name);
+
+  // Return the name for a key. Blank for an invalid key.
+  static const Name& name(Key key);
+
+  // Number of registered names.
+  static Key keyCount();
+
+  // Iterators over the entries. The entries are proxies with members first and second.
+  template<typename Store, typename V>
+  class Iterator {
+  public:
+    struct Entry {
+      const Name& first;
+      V& second;
+    };
+    struct Arrow {
+      Entry ent;
+      const Entry* operator->() const { return &ent; }
+    };
+    Iterator(Store* pmtd, std::size_t ient) : m_pmtd(pmtd), m_ient(ient) { }
+    Entry operator*() const { return Entry{m_pmtd->m_names[m_ient], m_pmtd->m_values[m_ient]}; }
+    Arrow operator->() const { return Arrow{**this}; }
+    Iterator& operator++() { ++m_ient; return *this; }
+    Iterator operator++(int) { Iterator old = *this; ++m_ient; return old; }
+    bool operator==(const Iterator& rhs) const { return m_ient == rhs.m_ient; }
+    bool operator!=(const Iterator& rhs) const { return m_ient != rhs.m_ient; }
+    Key key() const { return m_pmtd->m_keys[m_ient]; }
+  private:
+    Store* m_pmtd;
+    std::size_t m_ient;
+  };
+
+  using iterator = Iterator<AdcMetadata, Value>;
+  using const_iterator = Iterator<const AdcMetadata, const Value>;
+
+  // Key accessors.
+  bool has(Key key) const { return findEntry(key) < size(); }
+  Value get(Key key, Value def =0.0) const {
+    std::size_t ient = findEntry(key);
+    return ient < size() ? m_values[ient] : def;
+  }
+  void set(Key key, Value val) { m_values[entry(key)] = val; }
+  bool erase(Key key);
+
+  // Map-like accessors.
+  bool empty() const { return m_keys.empty(); }
+  std::size_t size() const { return m_keys.size(); }
+  void clear() { m_keys.clear(); m_names.clear(); m_values.clear(); }
+  std::size_t count(const Name& name) const { return has(findKey(name)); }
+  Value& operator[](const Name& name) { return m_values[entry(key(name), &name)]; }
+  std::size_t erase(const Name& name) { return erase(findKey(name)); }
+  iterator find(const Name& name) { return iterator(this, findEntry(findKey(name))); }
+  const_iterator find(const Name& name) const { return const_iterator(this, findEntry(findKey(name))); }
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size()); }
+
+  // Return the keys, names and values in key order.
+  const KeyVector& keys() const { return m_keys; }
+  const NameVector& names() const { return m_names; }
+  const ValueVector& values() const { return m_values; }
+
+  // Copy to a map.
+  FloatMap toMap() const;
+
+  // Rebuild the keys from the names, e.g. after the names and values are read.
+  // Entries are re-sorted by key and, for a repeated name, the last value is kept.
+  void restoreKeys();
+
+private:
+
+  // Registry of the names.
+  struct Registry {
+    std::shared_mutex mutex;
+    std::unordered_map<Name, Key> keys;
+    std::deque<Name> names;     // deque so that references stay valid
+  };
+  static Registry& registry();
+
+  // Return the entry index for a key, adding the entry if needed.
+  // The name is looked up in the registry unless it is supplied.
+  std::size_t entry(Key key, const Name* pname =nullptr);
+
+  // Return the entry index for a key or size() if it is not present.
+  std::size_t findEntry(Key key) const;
+
+  // Persistent names and values. The transient keys are declared last so that the
+  // ioread rule that sets them runs after the names are read.
+  NameVector m_names;
+  ValueVector m_values;
+  KeyVector m_keys;
+
+};
+
+//**********************************************************************
+
+inline AdcMetadata::Registry& AdcMetadata::registry() {
+  static Registry reg;
+  return reg;
+}
+
+//**********************************************************************
+
+inline AdcMetadata::Key AdcMetadata::key(const Name& name) {
+  Registry& reg = registry();
+  {
+    std::shared_lock<std::shared_mutex> lock(reg.mutex);
+    auto ikey = reg.keys.find(name);
+    if ( ikey != reg.keys.end() ) return ikey->second;
+  }
+  std::unique_lock<std::shared_mutex> lock(reg.mutex);
+  auto ikey = reg.keys.find(name);
+  if ( ikey != reg.keys.end() ) return ikey->second;
+  Key newKey = reg.names.size();
+  reg.names.push_back(name);
+  reg.keys[name] = newKey;
+  return newKey;
+}
+
+//**********************************************************************
+
+inline AdcMetadata::Key AdcMetadata::findKey(const Name& name) {
+  Registry& reg = registry();
+  std::shared_lock<std::shared_mutex> lock(reg.mutex);
+  auto ikey = reg.keys.find(name);
+  return ikey == reg.keys.end() ? badKey() : ikey->second;
+}
+
+//**********************************************************************
+
+inline const AdcMetadata::Name& AdcMetadata::name(Key key) {
+  static const Name blank;
+  Registry& reg = registry();
+  std::shared_lock<std::shared_mutex> lock(reg.mutex);
+  return key < reg.names.size() ? reg.names[key] : blank;
+}
+
+//**********************************************************************
+
+inline AdcMetadata::Key AdcMetadata::keyCount() {
+  Registry& reg = registry();
+  std::shared_lock<std::shared_mutex> lock(reg.mutex);
+  return reg.names.size();
+}
+
+//**********************************************************************
+
+inline std::size_t AdcMetadata::entry(Key key, const Name* pname) {
+  auto ikey = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+  std::size_t ient = ikey - m_keys.begin();
+  if ( ikey != m_keys.end() && *ikey == key ) return ient;
+  m_keys.insert(ikey, key);
+  m_names.insert(m_names.begin() + ient, pname == nullptr ? name(key) : *pname);
+  m_values.insert(m_values.begin() + ient, 0.0);
+  return ient;
+}
+
+//**********************************************************************
+
+inline std::size_t AdcMetadata::findEntry(Key key) const {
+  if ( key == badKey() ) return size();
+  auto ikey = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+  if ( ikey != m_keys.end() && *ikey == key ) return ikey - m_keys.begin();
+  return size();
+}
+
+//**********************************************************************
+
+inline bool AdcMetadata::erase(Key key) {
+  std::size_t ient = findEntry(key);
+  if ( ient >= size() ) return false;
+  m_keys.erase(m_keys.begin() + ient);
+  m_names.erase(m_names.begin() + ient);
+  m_values.erase(m_values.begin() + ient);
+  return true;
+}
+
+//**********************************************************************
+
+inline AdcMetadata::FloatMap AdcMetadata::toMap() const {
+  FloatMap out;
+  for ( std::size_t ient=0; ient<size(); ++ient ) out[m_names[ient]] = m_values[ient];
+  return out;
+}
+
+//**********************************************************************
+
+inline void AdcMetadata::restoreKeys() {
+  NameVector names;
+  ValueVector values;
+  names.swap(m_names);
+  values.swap(m_values);
+  m_keys.clear();
+  std::size_t nent = std::min(names.size(), values.size());
+  for ( std::size_t ient=0; ient<nent; ++ient ) {
+    m_values[entry(key(names[ient]), &names[ient])] = values[ient];
+  }
+}
+
+//**********************************************************************
+
+#endif
@@ -0,0 +1,115 @@
+// AdcNoiseBank.h
+//
+// Bank of pre-generated noise waveforms for ChannelNoiseService implementations.
+//
+// The bank holds one or more pools, e.g. one for each plane or channel class. Each
+// pool is a long noise waveform, typically generated with a few large inverse FFTs
+// when the service is initialized. Noise for a channel is then the pool read
+// circularly from an offset, optionally with a sign flip, so that adding noise to
+// a channel is one or two contiguous add loops rather than an FFT:
+//
+//   AdcNoiseBank bank(nplane);
+//   for ( Index ipol=0; ipol<nplane; ++ipol ) {
+//     AdcSignal* pdat = bank.resetPool(ipol, npoolTicks);
+//     // fill pdat with noise for the plane
+//   }
+//   ...
+//   bank.addNoise(plane(chan), rand.Integer(bank.poolSize(plane(chan))), sigs);
+//
+// A read that runs past the end of a pool continues from its start. Reads longer
+// than the pool wrap more than once and so repeat noise.
+//
+// The bank is not modified by addNoise so one bank may be shared by threads.
+
+#ifndef AdcNoiseBank_H
+#define AdcNoiseBank_H
+
+#include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include <vector>
+
+class AdcNoiseBank {
+
+public:
+
+  using Index = AdcIndex;
+
+  // Ctor with npool empty pools.
+  explicit AdcNoiseBank(Index npool =0) : m_pools(npool) { }
+
+  // Number of pools.
+  Index npool() const { return m_pools.size(); }
+
+  // Change the number of pools. New pools are empty.
+  void resize(Index npool) { m_pools.resize(npool); }
+
+  // Number of samples in pool ipol or 0 if there is no such pool.
+  Index poolSize(Index ipol) const { return ipol < npool() ? m_pools[ipol].size() : 0; }
+
+  // Return if pool ipol has samples.
+  bool hasPool(Index ipol) const { return poolSize(ipol) > 0; }
+
+  // Resize pool ipol to nsam zero samples and return a pointer to them for filling.
+  // Returns nullptr if there is no such pool.
+  AdcSignal* resetPool(Index ipol, Index nsam);
+
+  // Copy a waveform into pool ipol. Returns nonzero if there is no such pool.
+  int setPool(Index ipol, const AdcSignalVector& sams);
+
+  // Read-only access to the samples for pool ipol.
+  const AdcSignal* poolData(Index ipol) const { return hasPool(ipol) ? m_pools[ipol].data() : nullptr; }
+
+  // Add noise from pool ipol starting at offset ioff to nsig signals at psig.
+  // If flip is true, the noise is subtracted.
+  // Returns nonzero if the pool is absent or empty.
+  int addNoise(Index ipol, Index ioff, AdcSignal* psig, Index nsig, bool flip =false) const;
+  int addNoise(Index ipol, Index ioff, AdcSignalVector& sigs, bool flip =false) const {
+    return addNoise(ipol, ioff, sigs.data(), sigs.size(), flip);
+  }
+
+private:
+
+  std::vector<AdcSignalVector> m_pools;
+
+};
+
+//**********************************************************************
+
+inline AdcSignal* AdcNoiseBank::resetPool(Index ipol, Index nsam) {
+  if ( ipol >= npool() ) return nullptr;
+  m_pools[ipol].assign(nsam, 0.0);
+  return m_pools[ipol].data();
+}
+
+//**********************************************************************
+
+inline int AdcNoiseBank::setPool(Index ipol, const AdcSignalVector& sams) {
+  if ( ipol >= npool() ) return 1;
+  m_pools[ipol] = sams;
+  return 0;
+}
+
+//**********************************************************************
+
+inline int AdcNoiseBank::addNoise(Index ipol, Index ioff, AdcSignal* psig, Index nsig, bool flip) const {
+  if ( ! hasPool(ipol) ) return 1;
+  const AdcSignalVector& pool = m_pools[ipol];
+  Index nsam = pool.size();
+  ioff %= nsam;
+  AdcSignal sign = flip ? -1.0 : 1.0;
+  Index isig = 0;
+  while ( isig < nsig ) {
+    // Read contiguously from ioff up to the end of the pool.
+    Index ncpy = nsam - ioff;
+    if ( ncpy > nsig - isig ) ncpy = nsig - isig;
+    const AdcSignal* pnoi = pool.data() + ioff;
+    AdcSignal* pout = psig + isig;
+    for ( Index icpy=0; icpy<ncpy; ++icpy ) pout[icpy] += sign*pnoi[icpy];
+    isig += ncpy;
+    ioff = 0;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+#endif
@@ -0,0 +1,123 @@
+// AdcRawConversion.h
+//
+// Kernels to convert raw ADC counts to samples:
+//   sample = gain*(raw - pedestal)
+// optionally replacing samples whose flag is not AdcGood with a fill value.
+//
+// The kernels are simple branch-free loops over contiguous arrays that the compiler
+// vectorizes. They may be applied to a single array, a channel or all the rows of an
+// AdcChannelBlock, e.g. an APA, so that tools need not each provide their own loop.
+//
+// Example:
+//   AdcChannelBlock blk;
+//   blk.load(acds, AdcChannelBlock::Raw);
+//   AdcRawConversion::convert(blk, peds, gains);
+//   blk.store(acds);
+
+#ifndef AdcRawConversion_H
+#define AdcRawConversion_H
+
+#include "dunecore/DuneInterface/Data/AdcChannelBlock.h"
+#include <vector>
+
+class AdcRawConversion {
+
+public:
+
+  using Index = AdcIndex;
+  using SignalVector = std::vector<AdcSignal>;
+
+  // Convert nsam raw counts to samples.
+  static void convert(const AdcCount* praw, AdcSignal* psam, Index nsam,
+                      AdcSignal ped, AdcSignal gain =1.0);
+
+  // Convert nsam raw counts to samples, setting those without flag AdcGood to fill.
+  static void convert(const AdcCount* praw, const AdcFlag* pflg, AdcSignal* psam, Index nsam,
+                      AdcSignal ped, AdcSignal gain =1.0, AdcSignal fill =0.0);
+
+  // Convert the raw data of a channel using its pedestal.
+  // The samples are resized to the raw size unless the channel is a view of block
+  // samples in which case the raw size must not exceed the block size.
+  // If maskFlags is true, samples without flag AdcGood are set to fill. Samples
+  // beyond the end of the flags are not masked.
+  // Returns 0 for success,
+  //   1 - channel has no raw data
+  //   2 - raw data does not fit in the block samples
+  static int convert(AdcChannelData& acd, AdcSignal gain =1.0,
+                     bool maskFlags =false, AdcSignal fill =0.0);
+
+  // Convert the raw data in each row of a block using the pedestal and gain for the row.
+  // An empty gain vector means unit gain. Flags are applied if the block holds them and
+  // maskFlags is true. Row padding is left unchanged.
+  // Returns 0 for success,
+  //   1 - block has no raw data
+  //   2 - pedestal or gain vector size differs from the row count
+  static int convert(AdcChannelBlock& blk, const SignalVector& peds,
+                     const SignalVector& gains =SignalVector(),
+                     bool maskFlags =false, AdcSignal fill =0.0);
+
+};
+
+//**********************************************************************
+
+inline
+void AdcRawConversion::convert(const AdcCount* praw, AdcSignal* psam, Index nsam,
+                               AdcSignal ped, AdcSignal gain) {
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    psam[isam] = gain*(AdcSignal(praw[isam]) - ped);
+  }
+}
+
+//**********************************************************************
+
+inline
+void AdcRawConversion::convert(const AdcCount* praw, const AdcFlag* pflg, AdcSignal* psam,
+                               Index nsam, AdcSignal ped, AdcSignal gain, AdcSignal fill) {
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    AdcSignal sam = gain*(AdcSignal(praw[isam]) - ped);
+    psam[isam] = pflg[isam] == AdcGood ? sam : fill;
+  }
+}
+
+//**********************************************************************
+
+inline
+int AdcRawConversion::convert(AdcChannelData& acd, AdcSignal gain,
+                              bool maskFlags, AdcSignal fill) {
+  Index nraw = acd.raw.size();
+  if ( nraw == 0 ) return 1;
+  if ( acd.hasBlockSamples() ) {
+    if ( nraw > acd.blockTicks ) return 2;
+  } else {
+    acd.samples.resize(nraw);
+  }
+  AdcSignal* psam = acd.sampleData();
+  Index nflg = maskFlags ? acd.flags.size() : 0;
+  if ( nflg > nraw ) nflg = nraw;
+  convert(acd.raw.data(), acd.flags.data(), psam, nflg, acd.pedestal, gain, fill);
+  convert(acd.raw.data() + nflg, psam + nflg, nraw - nflg, acd.pedestal, gain);
+  return 0;
+}
+
+//**********************************************************************
+
+inline
+int AdcRawConversion::convert(AdcChannelBlock& blk, const SignalVector& peds,
+                              const SignalVector& gains, bool maskFlags, AdcSignal fill) {
+  if ( ! blk.hasRaw() ) return 1;
+  Index nrow = blk.nrow();
+  if ( peds.size() != nrow ) return 2;
+  if ( gains.size() && gains.size() != nrow ) return 2;
+  bool useFlags = maskFlags && blk.hasFlags();
+  Index ntck = blk.ntick();
+  for ( Index irow=0; irow<nrow; ++irow ) {
+    AdcSignal gain = gains.size() ? gains[irow] : 1.0;
+    if ( useFlags ) convert(blk.raw(irow), blk.flags(irow), blk.samples(irow), ntck, peds[irow], gain, fill);
+    else convert(blk.raw(irow), blk.samples(irow), ntck, peds[irow], gain);
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+#endif
@@ -0,0 +1,81 @@
+// AdcSignalRun.h
+//
+// Sparse form of a tick signal vector as runs of contiguous ticks.
+//
+// Run irun holds values[i] for ticks begin + i. A run vector holds runs in
+// increasing tick order that do not overlap. Ticks outside the runs have value
+// zero, so that a channel with charge in only a few ticks is held in a few
+// values rather than a full-length vector.
+//
+// Helpers convert to and from the dense form:
+//   addToDense(runs, sigs)   adds the runs into a dense vector
+//   fromDense(sigs, runs)    collects the runs of nonzero values from a dense vector
+//   sparseSampleCount(runs)  returns the number of values held
+
+#ifndef AdcSignalRun_H
+#define AdcSignalRun_H
+
+#include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include <vector>
+
+struct AdcSignalRun {
+
+  AdcIndex begin = 0;
+  AdcSignalVector values;
+
+  AdcSignalRun() =default;
+  AdcSignalRun(AdcIndex a_begin, const AdcSignalVector& a_values)
+  : begin(a_begin), values(a_values) { }
+
+  // Last + 1 tick.
+  AdcIndex end() const { return begin + values.size(); }
+
+};
+
+typedef std::vector<AdcSignalRun> AdcSignalRunVector;
+
+//**********************************************************************
+
+// Add runs into a dense vector. Values beyond the end of sigs are dropped
+// unless extend is true, in which case sigs is extended with zeros.
+inline void addToDense(const AdcSignalRunVector& runs, AdcSignalVector& sigs, bool extend =false) {
+  if ( extend && ! runs.empty() && runs.back().end() > sigs.size() ) sigs.resize(runs.back().end(), 0.0);
+  AdcIndex nsig = sigs.size();
+  for ( const AdcSignalRun& run : runs ) {
+    if ( run.begin >= nsig ) break;
+    AdcIndex nval = run.end() <= nsig ? run.values.size() : nsig - run.begin;
+    AdcSignal* pout = sigs.data() + run.begin;
+    const AdcSignal* pin = run.values.data();
+    for ( AdcIndex ival=0; ival<nval; ++ival ) pout[ival] += pin[ival];
+  }
+}
+
+//**********************************************************************
+
+// Replace runs with the runs of nonzero values in sigs.
+inline void fromDense(const AdcSignalVector& sigs, AdcSignalRunVector& runs) {
+  runs.clear();
+  AdcIndex nsig = sigs.size();
+  AdcIndex isig = 0;
+  while ( isig < nsig ) {
+    while ( isig < nsig && sigs[isig] == 0.0 ) ++isig;
+    if ( isig >= nsig ) break;
+    AdcIndex isig1 = isig;
+    while ( isig < nsig && sigs[isig] != 0.0 ) ++isig;
+    runs.emplace_back();
+    runs.back().begin = isig1;
+    runs.back().values.assign(sigs.begin() + isig1, sigs.begin() + isig);
+  }
+}
+
+//**********************************************************************
+
+inline AdcIndex sparseSampleCount(const AdcSignalRunVector& runs) {
+  AdcIndex nval = 0;
+  for ( const AdcSignalRun& run : runs ) nval += run.values.size();
+  return nval;
+}
+
+//**********************************************************************
+
+#endif
@@ -15,6 +15,11 @@
 // (yet) directly supported. We assume that concrete subclasses are
 // otherwise made aware of the current event or time if there is to
 // be such dependence.
+//
+// The method countBlock(...) fills the counts for n consecutive samples
+// of one channel starting at tick0. The default calls count for each
+// sample. Subclasses may override it to avoid the per-sample virtual
+// call and vectorize the transfer function.
 
 class AdcSimulator {
 
@@ -28,6 +33,10 @@ public:
 
   virtual Count count(double vin, Channel chan =0, Tick tick =0) const =0;
 
+  virtual void countBlock(const float* vin, Count* out, Tick n, Channel chan =0, Tick tick0 =0) const {
+    for ( Tick itck=0; itck<n; ++itck ) out[itck] = count(vin[itck], chan, tick0 + itck);
+  }
+
 };
 
 #endif
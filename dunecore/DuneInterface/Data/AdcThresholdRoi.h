@@ -0,0 +1,43 @@
+// AdcThresholdRoi.h
+//
+// Shared threshold-with-padding kernel for ROI building and signal finding.
+//
+// Ticks with samples above the threshold (or with magnitude above the threshold) are
+// kept together with npadLow ticks before and npadHigh ticks after each. The keep mask
+// is built a word at a time with AdcBitMask::fromThreshold and dilate, and the ROIs
+// are found by scanning the mask words. For a channel:
+//   AdcThresholdRoi::build(acd, thresh, npadLow, npadHigh);
+// sets acd.signal and acd.rois. AdcRoiBuildingService and AdcSignalFindingService
+// implementations may call this in place of their own tick loops.
+
+#ifndef AdcThresholdRoi_H
+#define AdcThresholdRoi_H
+
+#include "dunecore/DuneInterface/Data/AdcBitMask.h"
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+
+namespace AdcThresholdRoi {
+
+using Index = AdcBitMask::Index;
+
+// Build the keep mask for nsam samples.
+inline void makeMask(const AdcSignal* psam, Index nsam, AdcSignal thresh,
+                     Index npadLow, Index npadHigh, bool useAbs, AdcBitMask& mask) {
+  mask.fromThreshold(psam, nsam, thresh, useAbs);
+  mask.dilate(npadLow, npadHigh);
+}
+
+// Set acd.signal and acd.rois from the samples of acd.
+// Returns the number of kept ticks.
+inline Index build(AdcChannelData& acd, AdcSignal thresh, Index npadLow, Index npadHigh,
+                   bool useAbs =false) {
+  AdcBitMask mask;
+  makeMask(acd.sampleData(), acd.sampleCount(), thresh, npadLow, npadHigh, useAbs, mask);
+  mask.toVector(acd.signal);
+  mask.toRois(acd.rois);
+  return mask.count();
+}
+
+}
+
+#endif
@@ -30,14 +30,33 @@
 // its histograms. Any copies of the result share in that management.
 // If a histogram is not managed, the caller should ensure that it has
 // appropriate lifetime.
+//
+// Results are cheap to return and merge: the class is movable, a status-only
+// result (see hasResults) holds only empty maps, and extending with a temporary
+// result moves its entries rather than copying them:
+//   ret += update(acd);
+//   ret += std::move(dm);
+//
+// A histogram may be deferred, i.e. added as a factory that creates and fills it,
+// so that it is only created if getHist is called for it, e.g. by a viewer or a
+// job that keeps the plot:
+//   res.setDeferredHist("myhist", [=]() { return makeMyHist(vals); });
+//   res.setDeferredHist("myhist", "My title", nbin, x1, x2, vals);
+// The result owns the created histogram and copies share it. A deferred histogram
+// is reported by haveHist and getHists but not by getHistMap.
 
 #include <vector>
 #include <map>
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <memory>
+#include <iterator>
+#include <utility>
+#include <functional>
 
 #include "TH1.h"
+#include "TH1F.h"
 #include "TGraph.h"
 
 class DataMap {
@@ -61,6 +80,32 @@ public:
   using GraphMap = std::map<Name,GraphPtr>;
   using SharedHistPtr = std::shared_ptr<TH1>;
   using SharedHistVector = std::vector<SharedHistPtr>;
+  using HistFactory = std::function<TH1*()>;
+
+  // Histogram created by a factory when it is first requested.
+  class DeferredHist {
+  public:
+    explicit DeferredHist(HistFactory fac) : m_fac(std::move(fac)) { }
+    bool isRealized() const { return m_called; }
+    TH1* get() {
+      if ( ! m_called ) {
+        m_called = true;
+        TH1* ph = m_fac ? m_fac() : nullptr;
+        m_fac = nullptr;
+        if ( ph != nullptr ) {
+          ph->SetDirectory(nullptr);
+          m_ph.reset(ph);
+        }
+      }
+      return m_ph.get();
+    }
+  private:
+    HistFactory m_fac;
+    bool m_called = false;
+    SharedHistPtr m_ph;
+  };
+  using DeferredHistPtr = std::shared_ptr<DeferredHist>;
+  using DeferredHistMap = std::map<Name,DeferredHistPtr>;
 
 public:
 
@@ -113,12 +158,6 @@ public:
   // Ctor from status flag.
   explicit DataMap(int stat =0) : m_stat(stat) { }
 
-  // Dtor.
-  ~DataMap() {
-    const std::string myname = "DataMap::dtor: ";
-    //std::cout << myname << "@" << this << std::endl;
-  }
-
   // Setters.
   // If own is true, the result has owns the histogram(s).
   // If results are copied to other results, then this ownership
@@ -134,6 +173,7 @@ public:
   void setFloatVector(Name name, const FloatVector& val) { m_fltvecs[name] = val; }
   void setString(Name name, String val) { m_strs[name] = val; }
   void setHist(Name name, TH1* ph, bool own =false) {
+    m_defHsts.erase(name);
     m_hsts[name] = ph;
     if ( own && ph != nullptr ) {
       ph->SetDirectory(nullptr);
@@ -144,9 +184,30 @@ public:
     if ( ph != nullptr ) setHist(ph->GetName(), ph, own);
   }
   void setHist(std::shared_ptr<TH1> ph) {
+    m_defHsts.erase(ph->GetName());
     m_hsts[ph->GetName()] = ph.get();
     m_sharedHsts.push_back(ph);
   }
+  // Deferred histogram: fac is called on the first getHist(name) and the result
+  // is then owned.
+  void setDeferredHist(Name name, HistFactory fac) {
+    m_hsts.erase(name);
+    m_defHsts[name] = std::make_shared<DeferredHist>(std::move(fac));
+  }
+  // Deferred histogram with nbin uniform bins on [xmin, xmax) and the bin contents
+  // vals (zero for missing values).
+  void setDeferredHist(Name name, Name title, int nbin, double xmin, double xmax,
+                       FloatVector vals, Name xlab ="", Name ylab ="") {
+    setDeferredHist(name, [=]() -> TH1* {
+      TH1* ph = new TH1F(name.c_str(), title.c_str(), nbin, xmin, xmax);
+      ph->SetDirectory(nullptr);
+      if ( xlab.size() ) ph->GetXaxis()->SetTitle(xlab.c_str());
+      if ( ylab.size() ) ph->GetYaxis()->SetTitle(ylab.c_str());
+      int nval = vals.size() < unsigned(nbin) ? vals.size() : nbin;
+      for ( int ibin=0; ibin<nval; ++ibin ) ph->SetBinContent(ibin + 1, vals[ibin]);
+      return ph;
+    });
+  }
   void setHistVector(Name name, const HistVector& hsts, bool own =false) {
     const std::string myname = "DataMap::setHistVector: ";
     m_hstvecs[name] = hsts;
@@ -182,20 +243,51 @@ public:
     if ( pg != nullptr ) setGraph(pg->GetName(), pg);
   }
 
+  // Return if any results other than the status are held.
+  bool hasResults() const {
+    return m_ints.size() || m_intvecs.size() || m_flts.size() || m_fltvecs.size() ||
+           m_strs.size() || m_hsts.size() || m_hstvecs.size() || m_sharedHsts.size() ||
+           m_defHsts.size() || m_grfs.size();
+  }
+
   // Extend this map with another.
   void extend(const DataMap& rhs) {
     m_stat += rhs.status();
+    if ( ! rhs.hasResults() ) return;
     mapextend<int>(m_ints, rhs.m_ints);
     mapextend<IntVector>(m_intvecs, rhs.m_intvecs);
     mapextend<Float>(m_flts, rhs.m_flts);
     mapextend<FloatVector>(m_fltvecs, rhs.m_fltvecs);
     mapextend<String>(m_strs, rhs.m_strs);
+    dropHists(rhs);
     mapextend<TH1*>(m_hsts, rhs.m_hsts);
+    mapextend<DeferredHistPtr>(m_defHsts, rhs.m_defHsts);
     mapextend<HistVector>(m_hstvecs, rhs.m_hstvecs);
     m_sharedHsts.insert(m_sharedHsts.end(), rhs.m_sharedHsts.begin(), rhs.m_sharedHsts.end());
     mapextend<GraphPtr>(m_grfs, rhs.m_grfs);
   }
+
+  // Extend this map with another whose entries may be moved.
+  void extend(DataMap&& rhs) {
+    m_stat += rhs.status();
+    if ( ! rhs.hasResults() ) return;
+    mapmove<int>(m_ints, rhs.m_ints);
+    mapmove<IntVector>(m_intvecs, rhs.m_intvecs);
+    mapmove<Float>(m_flts, rhs.m_flts);
+    mapmove<FloatVector>(m_fltvecs, rhs.m_fltvecs);
+    mapmove<String>(m_strs, rhs.m_strs);
+    dropHists(rhs);
+    mapmove<TH1*>(m_hsts, rhs.m_hsts);
+    mapmove<DeferredHistPtr>(m_defHsts, rhs.m_defHsts);
+    mapmove<HistVector>(m_hstvecs, rhs.m_hstvecs);
+    if ( m_sharedHsts.empty() ) m_sharedHsts = std::move(rhs.m_sharedHsts);
+    else m_sharedHsts.insert(m_sharedHsts.end(),
+                             std::make_move_iterator(rhs.m_sharedHsts.begin()),
+                             std::make_move_iterator(rhs.m_sharedHsts.end()));
+    mapmove<GraphPtr>(m_grfs, rhs.m_grfs);
+  }
   DataMap& operator+=(const DataMap& rhs) { extend(rhs); return *this; }
+  DataMap& operator+=(DataMap&& rhs) { extend(std::move(rhs)); return *this; }
 
   // Status.
   // Typically 0 indicates success.
@@ -209,10 +301,16 @@ public:
   bool haveFloat(Name name) const { return maphas<Float>(m_flts, name); }
   bool haveFloatVector(Name name) const { return maphas<FloatVector>(m_fltvecs, name); }
   bool haveString(Name name) const { return maphas<String>(m_strs, name); }
-  bool haveHist(Name name)  const { return maphas<TH1*>(m_hsts, name); }
+  bool haveHist(Name name)  const { return maphas<TH1*>(m_hsts, name) || maphas<DeferredHistPtr>(m_defHsts, name); }
   bool haveHistVector(Name name)  const { return maphas<HistVector>(m_hstvecs, name); }
   bool haveGraph(Name name)  const { return maphas<GraphPtr>(m_grfs, name); }
 
+  // Return if a histogram is deferred and not yet created.
+  bool isHistDeferred(Name name) const {
+    DeferredHistMap::const_iterator ient = m_defHsts.find(name);
+    return ient != m_defHsts.end() && ! ient->second->isRealized();
+  }
+
   // Return a result for a given name.
   // The indicated default is returned if a value is not stored.
   int getInt(Name name, int def =0) const { return mapget<int>(m_ints, name, def); }
@@ -220,7 +318,15 @@ public:
   Float getFloat(Name name, Float def =0.0) const { return mapget<Float>(m_flts, name, def); }
   const FloatVector& getFloatVector(Name name) const { return mapgetobj<FloatVector>(m_fltvecs, name); }
   String getString(Name name, String def ="") const { return mapget<String>(m_strs, name, def); }
-  TH1* getHist(Name name, TH1* def =nullptr) const { return mapget<TH1*>(m_hsts, name, def); }
+  // A deferred histogram is created here.
+  TH1* getHist(Name name, TH1* def =nullptr) const {
+    DeferredHistMap::const_iterator ient = m_defHsts.find(name);
+    if ( ient != m_defHsts.end() ) {
+      TH1* ph = ient->second->get();
+      return ph == nullptr ? def : ph;
+    }
+    return mapget<TH1*>(m_hsts, name, def);
+  }
   const HistVector& getHistVector(Name name) const { return mapgetobj<HistVector>(m_hstvecs, name); }
   TGraph* getGraph(Name name) const { return mapgetobj<GraphPtr>(m_grfs, name).get(); }
 
@@ -233,11 +339,14 @@ public:
   const HistMap& getHistMap() const { return m_hsts; }
   const HistVectorMap& getHistVectorMap() const { return m_hstvecs; }
   const GraphMap& getGraphMap() const { return m_grfs; }
+  const DeferredHistMap& getDeferredHistMap() const { return m_defHsts; }
 
   // Return the named histograms in a vector.
+  // Deferred histograms are created and follow the others.
   HistVector getHists() const {
     HistVector hsts;
     for ( HistMap::value_type ihst : m_hsts ) hsts.push_back(ihst.second);
+    for ( const DeferredHistMap::value_type& ient : m_defHsts ) hsts.push_back(ient.second->get());
     return hsts;
   }
   
@@ -310,6 +419,13 @@ public:
         sout << prefix << "  " << ient.first << ": " << ph << endl;
       }
     }
+    if ( m_defHsts.size() ) {
+      sout << prefix << "Deferred histograms:" << endl;
+      for ( const DeferredHistMap::value_type& ient : m_defHsts ) {
+        sout << prefix << "  " << ient.first << ": "
+             << (ient.second->isRealized() ? "created" : "not created") << endl;
+      }
+    }
     if ( m_hstvecs.size() ) {
       sout << prefix << "Histogram vectors:" << endl;
       for ( typename HistVectorMap::value_type ient : m_hstvecs ) {
@@ -338,8 +454,15 @@ private:
   HistMap m_hsts;
   HistVectorMap m_hstvecs;
   SharedHistVector m_sharedHsts;
+  DeferredHistMap m_defHsts;
   GraphMap m_grfs;
 
+  // Remove the histograms of either kind that are replaced by those in rhs.
+  void dropHists(const DataMap& rhs) {
+    for ( const HistMap::value_type& ient : rhs.m_hsts ) m_defHsts.erase(ient.first);
+    for ( const DeferredHistMap::value_type& ient : rhs.m_defHsts ) m_hsts.erase(ient.first);
+  }
+
   // Return if a map has key.
   template<typename T>
   bool maphas(const std::map<Name,T>& vals, Name name) const {
@@ -379,10 +502,21 @@ private:
   // Extend or overwrite the entries in a map with those from another.
   template<typename T>
   void mapextend(std::map<Name,T>& lhs, const std::map<Name,T>& rhs) {
-    for ( typename std::map<Name,T>::value_type ient : rhs ) {
-      Name key = ient.first;
-      T val = ient.second;
-      lhs[key] = val;
+    for ( const typename std::map<Name,T>::value_type& ient : rhs ) {
+      lhs.insert_or_assign(ient.first, ient.second);
+    }
+  }
+
+  // Same, moving the values from the other map.
+  template<typename T>
+  void mapmove(std::map<Name,T>& lhs, std::map<Name,T>& rhs) {
+    if ( rhs.empty() ) return;
+    if ( lhs.empty() ) {
+      lhs = std::move(rhs);
+      return;
+    }
+    for ( typename std::map<Name,T>::value_type& ient : rhs ) {
+      lhs.insert_or_assign(ient.first, std::move(ient.second));
     }
   }
 
@@ -0,0 +1,101 @@
+// DuneChannelInfoTable.h
+//
+// Table of channel info for a run.
+//
+// Channel info is static for a run, so rather than allocating a new DuneChannelInfo
+// for each channel in each event, decoders may fill this table once per run and
+// attach its entries to the channel data:
+//   DuneChannelInfoTable tab(run);
+//   tab.set(DuneChannelInfo(icha, fembID, fembChannel, status));
+//   acd.setChannelInfo(tab.get(icha));
+// The entries are held in fixed-size chunks that are never moved. The pointers returned
+// by get share ownership of the table (shared_ptr aliasing) so no allocation is made
+// per channel and the entries remain valid after the table is destroyed.
+//
+// Entries may be added while pointers are in use, but the table must not be modified
+// while other threads call get.
+
+#ifndef DuneChannelInfoTable_H
+#define DuneChannelInfoTable_H
+
+#include "dunecore/DuneInterface/Data/DuneChannelInfo.h"
+#include <vector>
+#include <memory>
+#include <array>
+
+class DuneChannelInfoTable {
+
+public:
+
+  using Index = DuneChannelInfo::Index;
+  using Channel = DuneChannelInfo::Channel;
+  using ChannelInfoPtr = std::shared_ptr<const DuneChannelInfo>;
+
+  static Index badIndex() { return DuneChannelInfo::badIndex(); }
+
+  // Ctor for a run.
+  explicit DuneChannelInfoTable(Index a_run =badIndex())
+  : m_run(a_run), m_chunks(std::make_shared<ChunkVector>()) { }
+
+  // Run for this table.
+  Index run() const { return m_run; }
+
+  // Clear the table and assign a new run.
+  // Pointers obtained earlier remain valid.
+  void reset(Index a_run) {
+    m_run = a_run;
+    m_chunks = std::make_shared<ChunkVector>();
+    m_size = 0;
+  }
+
+  // Number of channels with info.
+  Index size() const { return m_size; }
+
+  // Add or replace the info for a channel.
+  // Returns nonzero if the channel is invalid.
+  int set(const DuneChannelInfo& info) {
+    if ( ! info.isValid() ) return 1;
+    Index ichk = info.channel/chunkSize();
+    ChunkVector& chunks = *m_chunks;
+    if ( ichk >= chunks.size() ) chunks.resize(ichk + 1);
+    if ( ! chunks[ichk] ) chunks[ichk].reset(new Chunk);
+    DuneChannelInfo& dest = (*chunks[ichk])[info.channel%chunkSize()];
+    if ( ! dest.isValid() ) ++m_size;
+    dest = info;
+    return 0;
+  }
+
+  // Return if there is info for a channel.
+  bool has(Channel icha) const { return find(icha) != nullptr; }
+
+  // Return the info for a channel or null if there is none.
+  ChannelInfoPtr get(Channel icha) const {
+    const DuneChannelInfo* pinf = find(icha);
+    if ( pinf == nullptr ) return ChannelInfoPtr();
+    return ChannelInfoPtr(m_chunks, pinf);
+  }
+
+private:
+
+  static Index chunkSize() { return 1024; }
+
+  using Chunk = std::array<DuneChannelInfo, 1024>;
+  using ChunkVector = std::vector<std::unique_ptr<Chunk>>;
+
+  const DuneChannelInfo* find(Channel icha) const {
+    if ( icha == DuneChannelInfo::badChannel() ) return nullptr;
+    Index ichk = icha/chunkSize();
+    if ( ichk >= m_chunks->size() ) return nullptr;
+    const std::unique_ptr<Chunk>& pchk = (*m_chunks)[ichk];
+    if ( ! pchk ) return nullptr;
+    const DuneChannelInfo& info = (*pchk)[icha%chunkSize()];
+    return info.isValid() ? &info : nullptr;
+  }
+
+  Index m_run;
+  std::shared_ptr<ChunkVector> m_chunks;
+  Index m_size = 0;
+
+};
+
+#endif
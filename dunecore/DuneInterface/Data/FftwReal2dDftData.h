@@ -11,6 +11,8 @@
 //   dft[i0][i1] = CC{dft[n0-i0][n1-i1]}    for i0 > 0
 //   dft[0][i1] = CC{dft[0][n1-i1]}
 // where CC denotes complex conjugation.
+//
+// complexView() gives a StridedView of the stored values with those dimensions.
 
 #ifndef FftwReal2dDftData_H
 #define FftwReal2dDftData_H
@@ -38,25 +40,29 @@ public:
   using typename Real2dDftData<F>::Complex;     // same memory layout as fftw_complex
   using ComplexVector = std::vector<Complex>;
   using typename Real2dDftData<F>::Norm;
+  template<bool Checked =false> using ComplexView = StridedView<Complex, 2, Checked>;
+  template<bool Checked =false> using ConstComplexView = StridedView<const Complex, 2, Checked>;
+
+  // FFTW DFT dimensions of the stored complex values for specified sample sizes,
+  // i.e. the last is reduced to nsam/2 + 1.
+  template<std::size_t N>
+  static constexpr std::array<Index, N> dftComplexSizes(const std::array<Index, N>& nsams) {
+    std::array<Index, N> nfrqs = nsams;
+    if constexpr ( N > 0 ) nfrqs[N-1] = nsams[N-1]/2 + 1;
+    return nfrqs;
+  }
 
   // FFTW DFT data size for specified sample sizes.
   // Returns the number of complex values.
   template<std::size_t N>
-  static Index dftComplexDataSize(const std::array<Index, N>& nsams) {
-    Index ndat = 1;
-    Index ndim = nsams.size();
-    for ( Index idim=0; idim<ndim; ++idim ) {
-      Index nsam = nsams[idim];
-      Index fac = idim == ndim - 1 ? nsam/2 + 1 : nsam;
-      ndat *= fac;
-    }
-    return ndat;
+  static constexpr Index dftComplexDataSize(const std::array<Index, N>& nsams) {
+    return StridedView<const Complex, N>::dataSize(dftComplexSizes(nsams));
   }
 
   // FFTW DFT data size for specified sample sizes.
   // Returns the number of floats, i.e. twice the number of complex values.
   template<std::size_t N>
-  static Index dftFloatDataSize(const std::array<Index, N>& nsams) {
+  static constexpr Index dftFloatDataSize(const std::array<Index, N>& nsams) {
     return 2*dftComplexDataSize(nsams);
   }
 
@@ -105,6 +111,16 @@ public:
   Float* floatData() { return reinterpret_cast<Float*>(m_data.data()); }
   const Float* floatData() const { return reinterpret_cast<const Float*>(m_data.data()); }
 
+  // View of the stored complex values, i.e. dimensions dftComplexSizes(nSamples()).
+  template<bool Checked =false>
+  ComplexView<Checked> complexView() {
+    return ComplexView<Checked>(m_data.data(), dftComplexSizes(m_nsams));
+  }
+  template<bool Checked =false>
+  ConstComplexView<Checked> complexView() const {
+    return ConstComplexView<Checked>(m_data.data(), dftComplexSizes(m_nsams));
+  }
+
   // Return the global index for an index array.
   // Returns the number of global indices if any index is out of range.
   Index globalIndex(const IndexArray& ifrqs) const {
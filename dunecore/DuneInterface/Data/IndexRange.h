@@ -111,7 +111,7 @@ public:
   
 };
 
-std::ostream& operator<<(std::ostream& lhs, const IndexRange& ir) {
+inline std::ostream& operator<<(std::ostream& lhs, const IndexRange& ir) {
   lhs << ir.name << ": ";
   if ( ir.size() == 0 ) {
     lhs << "<empty>";
@@ -98,7 +98,7 @@ public:
   }
 };
 
-std::ostream& operator<<(std::ostream& lhs, const IndexRangeGroup& ir) {
+inline std::ostream& operator<<(std::ostream& lhs, const IndexRangeGroup& ir) {
   if ( ir.size() == 0 ) {
     lhs << ir.name << ": <empty>";
   // If the group holds one range and the range and group names are the same,
@@ -0,0 +1,147 @@
+// IndexRangeLookup.h
+//
+// Precomputed lookup for a collection of index ranges or range groups.
+//
+// Each range or group is an entry with an integer ID given by its position in the
+// collection, and entries may be found by name with id(). A dense table built from
+// the ranges maps each index (e.g. channel) to the IDs of the entries that contain
+// it so that classification of an index is O(1):
+//   IndexRangeLookup irl(groups);
+//   Index igrp = irl.firstId(icha);
+//   if ( igrp != IndexRangeLookup::badIndex() ) ... irl.name(igrp) ...
+// The entries containing an index are listed in ID order.
+
+#ifndef IndexRangeLookup_H
+#define IndexRangeLookup_H
+
+#include "dunecore/DuneInterface/Data/IndexRangeGroup.h"
+#include <map>
+#include <limits>
+#include <algorithm>
+
+class IndexRangeLookup {
+
+public:
+
+  using Index = IndexRange::Index;
+  using IndexVector = std::vector<Index>;
+  using Name = IndexRange::Name;
+  using RangeVector = std::vector<IndexRange>;
+  using GroupVector = std::vector<IndexRangeGroup>;
+  using IdMap = std::map<Name, Index>;
+
+  static Index badIndex() { return std::numeric_limits<Index>::max(); }
+
+  // Default ctor: no entries.
+  IndexRangeLookup() =default;
+
+  // Ctor with one entry for each range.
+  explicit IndexRangeLookup(const RangeVector& rans) {
+    for ( const IndexRange& ran : rans ) m_groups.emplace_back(ran);
+    build();
+  }
+
+  // Ctor with one entry for each group.
+  explicit IndexRangeLookup(const GroupVector& grps) : m_groups(grps) { build(); }
+
+  // Number of entries.
+  Index size() const { return m_groups.size(); }
+
+  // ID for an entry name. Returns badIndex() if the name is not found.
+  Index id(Name nam) const {
+    IdMap::const_iterator iid = m_ids.find(nam);
+    return iid == m_ids.end() ? badIndex() : iid->second;
+  }
+
+  // Entry for an ID. Entries built from ranges hold that single range.
+  const IndexRangeGroup& group(Index iid) const { return m_groups.at(iid); }
+  Name name(Index iid) const { return iid < size() ? m_groups[iid].name : Name(); }
+
+  // Range [indexBegin, indexEnd) covered by the table.
+  Index indexBegin() const { return m_ival0; }
+  Index indexEnd() const { return m_ival0 + m_offsets.size() - 1; }
+
+  // Number of entries containing index ival.
+  Index count(Index ival) const {
+    Index ipos = position(ival);
+    return ipos == badIndex() ? 0 : m_offsets[ipos+1] - m_offsets[ipos];
+  }
+
+  // ID of the first entry containing index ival or badIndex() if there is none.
+  Index firstId(Index ival) const {
+    Index ipos = position(ival);
+    if ( ipos == badIndex() || m_offsets[ipos+1] == m_offsets[ipos] ) return badIndex();
+    return m_entries[m_offsets[ipos]];
+  }
+
+  // Pointer to the count(ival) IDs of the entries containing index ival.
+  const Index* ids(Index ival) const {
+    Index ipos = position(ival);
+    return ipos == badIndex() ? nullptr : m_entries.data() + m_offsets[ipos];
+  }
+
+  // Return if entry iid contains index ival.
+  bool contains(Index iid, Index ival) const {
+    const Index* pids = ids(ival);
+    Index nid = count(ival);
+    for ( Index iidx=0; iidx<nid; ++iidx ) if ( pids[iidx] == iid ) return true;
+    return false;
+  }
+
+private:
+
+  // Position of ival in the table or badIndex() if it is outside.
+  Index position(Index ival) const {
+    if ( ival < m_ival0 ) return badIndex();
+    Index ipos = ival - m_ival0;
+    return ipos + 1 < m_offsets.size() ? ipos : badIndex();
+  }
+
+  // Build the name map and table.
+  void build();
+
+  GroupVector m_groups;
+  IdMap m_ids;
+  Index m_ival0 = 0;
+  IndexVector m_offsets = IndexVector(1, 0);   // Start of the IDs for each index
+  IndexVector m_entries;                        // IDs for all indices
+
+};
+
+//**********************************************************************
+
+inline void IndexRangeLookup::build() {
+  m_ids.clear();
+  // Find the indices for each entry.
+  std::vector<IndexVector> vals(size());
+  Index ival0 = badIndex();
+  Index ival1 = 0;
+  for ( Index iid=0; iid<size(); ++iid ) {
+    const IndexRangeGroup& grp = m_groups[iid];
+    m_ids.emplace(grp.name, iid);
+    IndexVector& ivals = vals[iid];
+    grp.getIndices(ivals);
+    std::sort(ivals.begin(), ivals.end());
+    ivals.erase(std::unique(ivals.begin(), ivals.end()), ivals.end());
+    if ( ivals.empty() ) continue;
+    if ( ivals.front() < ival0 ) ival0 = ivals.front();
+    if ( ivals.back() + 1 > ival1 ) ival1 = ivals.back() + 1;
+  }
+  m_ival0 = ival0 == badIndex() ? 0 : ival0;
+  Index nval = ival1 > m_ival0 ? ival1 - m_ival0 : 0;
+  // Count the entries for each index and then fill them.
+  m_offsets.assign(nval + 1, 0);
+  for ( const IndexVector& ivals : vals ) {
+    for ( Index ival : ivals ) ++m_offsets[ival - m_ival0 + 1];
+  }
+  for ( Index ipos=0; ipos<nval; ++ipos ) m_offsets[ipos+1] += m_offsets[ipos];
+  m_entries.assign(m_offsets.back(), badIndex());
+  IndexVector next(m_offsets.begin(), m_offsets.end() - 1);
+  for ( Index iid=0; iid<size(); ++iid ) {
+    for ( Index ival : vals[iid] ) m_entries[next[ival - m_ival0]++] = iid;
+  }
+}
+
+//**********************************************************************
+
+#endif
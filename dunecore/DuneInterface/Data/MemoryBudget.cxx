@@ -0,0 +1,190 @@
+// MemoryBudget.cxx
+
+#include "dunecore/DuneInterface/Data/MemoryBudget.h"
+
+using Size = MemoryBudget::Size;
+using Index = MemoryBudget::Index;
+using Milliseconds = MemoryBudget::Milliseconds;
+using Lock = std::unique_lock<std::mutex>;
+
+//**********************************************************************
+
+MemoryBudget::Reservation::Reservation(MemoryBudget& bud, Size nbyte)
+: m_pbud(&bud), m_size(nbyte) {
+  bud.acquire(nbyte);
+}
+
+//**********************************************************************
+
+MemoryBudget::Reservation::Reservation(Reservation&& rhs) noexcept
+: m_pbud(rhs.m_pbud), m_size(rhs.m_size) {
+  rhs.m_pbud = nullptr;
+  rhs.m_size = 0;
+}
+
+//**********************************************************************
+
+MemoryBudget::Reservation& MemoryBudget::Reservation::operator=(Reservation&& rhs) noexcept {
+  if ( this != &rhs ) {
+    release();
+    m_pbud = rhs.m_pbud;
+    m_size = rhs.m_size;
+    rhs.m_pbud = nullptr;
+    rhs.m_size = 0;
+  }
+  return *this;
+}
+
+//**********************************************************************
+
+void MemoryBudget::Reservation::release() {
+  if ( m_pbud != nullptr ) m_pbud->release(m_size);
+  m_pbud = nullptr;
+  m_size = 0;
+}
+
+//**********************************************************************
+
+MemoryBudget& MemoryBudget::instance() {
+  // Never deleted so thread-local buffers may release to it at exit.
+  static MemoryBudget* pbud = new MemoryBudget;
+  return *pbud;
+}
+
+//**********************************************************************
+
+MemoryBudget::MemoryBudget(Size a_limit, Milliseconds a_maxWait)
+: m_limit(a_limit), m_maxWait(a_maxWait) { }
+
+//**********************************************************************
+
+Size MemoryBudget::limit() const {
+  Lock lock(m_mutex);
+  return m_limit;
+}
+
+//**********************************************************************
+
+void MemoryBudget::setLimit(Size val) {
+  {
+    Lock lock(m_mutex);
+    m_limit = val;
+  }
+  m_cond.notify_all();
+}
+
+//**********************************************************************
+
+Milliseconds MemoryBudget::maxWait() const {
+  Lock lock(m_mutex);
+  return m_maxWait;
+}
+
+//**********************************************************************
+
+void MemoryBudget::setMaxWait(Milliseconds val) {
+  Lock lock(m_mutex);
+  m_maxWait = val;
+}
+
+//**********************************************************************
+
+Size MemoryBudget::used() const {
+  Lock lock(m_mutex);
+  return m_used;
+}
+
+//**********************************************************************
+
+Size MemoryBudget::peak() const {
+  Lock lock(m_mutex);
+  return m_peak;
+}
+
+//**********************************************************************
+
+bool MemoryBudget::hasRoom(Size nbyte) const {
+  Lock lock(m_mutex);
+  return fits(nbyte);
+}
+
+//**********************************************************************
+
+bool MemoryBudget::tryAcquire(Size nbyte) {
+  Lock lock(m_mutex);
+  if ( ! fits(nbyte) ) {
+    ++m_nrefuse;
+    return false;
+  }
+  add(nbyte);
+  return true;
+}
+
+//**********************************************************************
+
+bool MemoryBudget::acquire(Size nbyte) {
+  Lock lock(m_mutex);
+  bool room = fits(nbyte);
+  if ( ! room ) {
+    ++m_nwait;
+    room = m_cond.wait_for(lock, m_maxWait, [this, nbyte] { return fits(nbyte); });
+    if ( ! room ) ++m_noverrun;
+  }
+  add(nbyte);
+  return room;
+}
+
+//**********************************************************************
+
+bool MemoryBudget::waitForRoom(Size nbyte, Milliseconds maxWait) const {
+  Lock lock(m_mutex);
+  return m_cond.wait_for(lock, maxWait, [this, nbyte] { return fits(nbyte); });
+}
+
+//**********************************************************************
+
+void MemoryBudget::charge(Size nbyte) {
+  Lock lock(m_mutex);
+  add(nbyte);
+}
+
+//**********************************************************************
+
+void MemoryBudget::release(Size nbyte) {
+  if ( nbyte == 0 ) return;
+  {
+    Lock lock(m_mutex);
+    m_used = nbyte < m_used ? m_used - nbyte : 0;
+  }
+  m_cond.notify_all();
+}
+
+//**********************************************************************
+
+Index MemoryBudget::waitCount() const {
+  Lock lock(m_mutex);
+  return m_nwait;
+}
+
+//**********************************************************************
+
+Index MemoryBudget::overrunCount() const {
+  Lock lock(m_mutex);
+  return m_noverrun;
+}
+
+//**********************************************************************
+
+Index MemoryBudget::refusalCount() const {
+  Lock lock(m_mutex);
+  return m_nrefuse;
+}
+
+//**********************************************************************
+
+void MemoryBudget::add(Size nbyte) {
+  m_used += nbyte;
+  if ( m_used > m_peak ) m_peak = m_used;
+}
+
+//**********************************************************************
@@ -0,0 +1,120 @@
+// MemoryBudget.h
+//
+// Limit on the memory held in flight by the raw data input and decoding: records
+// read ahead by HDF5RawFile2Service, the staging buffers and link decodes of the
+// decoder tools and the channel data kept by AdcChannelDataPool for reuse.
+//
+// Users account for the bytes they hold and check for room before taking more:
+//   MemoryBudget& bud = MemoryBudget::instance();
+//   MemoryBudget::Reservation res(bud, nbyte);  // waits up to maxWait() for room
+//   ...                                          // released when res is deleted
+// Work that can be skipped or deferred (read-ahead, pooling) uses hasRoom or
+// tryAcquire. Memory that is already allocated is added with charge.
+//
+// A limit of zero (the default) means no limit. A request always fits if nothing
+// else is held, so a single request larger than the limit is not refused. A blocking
+// acquire takes the memory anyway after waiting maxWait() for room, so holders that
+// are only released at the end of the event cannot deadlock the decoding; these
+// overruns are counted.
+//
+// There is one process-wide budget, instance(), configured from the parameters
+// MemoryBudgetMB and MemoryBudgetMaxWaitMs of HDF5RawFile2Service.
+
+#ifndef MemoryBudget_H
+#define MemoryBudget_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+class MemoryBudget {
+
+public:
+
+  using Size = std::size_t;
+  using Index = unsigned int;
+  using Milliseconds = std::chrono::milliseconds;
+
+  // Memory held for the life of a reservation.
+  class Reservation {
+  public:
+    Reservation() = default;
+    // Acquire nbyte from bud, waiting at most bud.maxWait() for room.
+    Reservation(MemoryBudget& bud, Size nbyte);
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+    Reservation(Reservation&& rhs) noexcept;
+    Reservation& operator=(Reservation&& rhs) noexcept;
+    ~Reservation() { release(); }
+    Size size() const { return m_size; }
+    void release();
+  private:
+    MemoryBudget* m_pbud = nullptr;
+    Size m_size = 0;
+  };
+
+  // The process-wide budget.
+  static MemoryBudget& instance();
+
+  // Ctor.
+  explicit MemoryBudget(Size a_limit =0, Milliseconds a_maxWait =defaultMaxWait());
+
+  static Milliseconds defaultMaxWait() { return Milliseconds(10000); }
+
+  // Limit in bytes, zero for none.
+  Size limit() const;
+  void setLimit(Size val);
+
+  // Longest wait in acquire before the limit is overrun.
+  Milliseconds maxWait() const;
+  void setMaxWait(Milliseconds val);
+
+  // Bytes held now and at most.
+  Size used() const;
+  Size peak() const;
+
+  // Is there room for nbyte more?
+  bool hasRoom(Size nbyte) const;
+
+  // Take nbyte if there is room. Returns whether they were taken.
+  bool tryAcquire(Size nbyte);
+
+  // Take nbyte, waiting up to maxWait() for room. Returns false if the bytes were
+  // taken without room.
+  bool acquire(Size nbyte);
+
+  // Wait up to maxWait for room for nbyte without taking them. Returns hasRoom(nbyte).
+  bool waitForRoom(Size nbyte, Milliseconds maxWait) const;
+
+  // Add nbyte, e.g. for memory that is already allocated.
+  void charge(Size nbyte);
+
+  // Give back nbyte.
+  void release(Size nbyte);
+
+  // Counts of acquisitions that had to wait, of those that overran the limit and
+  // of refused tryAcquire calls.
+  Index waitCount() const;
+  Index overrunCount() const;
+  Index refusalCount() const;
+
+private:
+
+  mutable std::mutex m_mutex;
+  mutable std::condition_variable m_cond;
+  Size m_limit;
+  Milliseconds m_maxWait;
+  Size m_used = 0;
+  Size m_peak = 0;
+  Index m_nwait = 0;
+  Index m_noverrun = 0;
+  Index m_nrefuse = 0;
+
+  // Room check and accounting with the lock held.
+  bool fits(Size nbyte) const { return m_limit == 0 || m_used == 0 || m_used + nbyte <= m_limit; }
+  void add(Size nbyte);
+
+};
+
+#endif
@@ -0,0 +1,32 @@
+// NumaPlacement.cxx
+
+#include "dunecore/DuneInterface/Data/NumaPlacement.h"
+#include "tbb/info.h"
+
+using Index = NumaPlacement::Index;
+
+//**********************************************************************
+
+NumaPlacement& NumaPlacement::instance() {
+  static NumaPlacement plc;
+  return plc;
+}
+
+//**********************************************************************
+
+Index NumaPlacement::configure(bool enable, Index nthreadPerNode) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_arenas.clear();
+  if ( ! enable ) return 1;
+  std::vector<tbb::numa_node_id> ids = tbb::info::numa_nodes();
+  if ( ids.size() < 2 ) return 1;
+  for ( tbb::numa_node_id id : ids ) {
+    tbb::task_arena::constraints con(id);
+    if ( nthreadPerNode > 0 ) con.set_max_concurrency(nthreadPerNode);
+    m_arenas.push_back(std::make_unique<tbb::task_arena>(con));
+    m_arenas.back()->initialize();
+  }
+  return m_arenas.size();
+}
+
+//**********************************************************************
@@ -0,0 +1,113 @@
+// NumaPlacement.h
+//
+// Placement of per-APA work on the NUMA nodes of the machine.
+//
+// With placement enabled, each item of a parallel loop (an APA, or a link of an
+// APA) is run by a TBB arena whose threads are bound to the NUMA node assigned to
+// the item. The nodes are assigned in contiguous blocks of items:
+//   node(iitm, nitm) = iitm*nodeCount()/nitm
+// so when the decoder and the TpcData tools run the same APA index with the same
+// APA count, they use the same node. The channel data are allocated from the
+// AdcChannelDataPool of the thread that decodes them and so, with the first-touch
+// policy of the OS, on the node of that APA.
+//
+// There is one process-wide placement, instance(), disabled by default and
+// configured with the NumaPlacement and NumaThreadsPerNode parameters of
+// FDHDDataInterface. If TBB does not report more than one NUMA node (e.g. it
+// was built without hwloc support), the loops run in the default arena as with
+// tbb::parallel_for.
+//
+// Usage:
+//   std::vector<Index> nodes(nlink);
+//   for ( Index ilnk=0; ilnk<nlink; ++ilnk ) nodes[ilnk] = plc.node(links[ilnk].apa, napa);
+//   plc.parallelFor(nodes, [&](Index ilnk) { decode(links[ilnk]); });
+
+#ifndef NumaPlacement_H
+#define NumaPlacement_H
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class NumaPlacement {
+
+public:
+
+  using Index = unsigned int;
+  using IndexVector = std::vector<Index>;
+
+  // The process-wide placement.
+  static NumaPlacement& instance();
+
+  // Enable or disable placement. With nthreadPerNode > 0, at most that many threads
+  // are used on each node. Returns the number of nodes used.
+  Index configure(bool enable, Index nthreadPerNode =0);
+
+  // Is placement in use, i.e. enabled with more than one node?
+  bool enabled() const { return m_arenas.size() > 1; }
+
+  // Number of nodes used, 1 if placement is not in use.
+  Index nodeCount() const { return enabled() ? m_arenas.size() : 1; }
+
+  // Node for item iitm of nitm.
+  Index node(Index iitm, Index nitm) const {
+    return nitm == 0 ? 0 : Index((unsigned long long)(iitm)*nodeCount()/nitm);
+  }
+
+  // Evaluate fun(iitm) for each item iitm in [0, nodes.size()) in parallel, each on
+  // the threads of node nodes[iitm]. Returns when all are done.
+  template<class F>
+  void parallelFor(const IndexVector& nodes, F fun) const;
+
+private:
+
+  std::vector<std::unique_ptr<tbb::task_arena>> m_arenas;
+  std::mutex m_mutex;
+
+};
+
+//**********************************************************************
+// Definitions for the above declarations.
+//**********************************************************************
+
+template<class F>
+void NumaPlacement::parallelFor(const IndexVector& nodes, F fun) const {
+  Index nitm = nodes.size();
+  if ( ! enabled() ) {
+    tbb::parallel_for(tbb::blocked_range<Index>(0, nitm),
+                      [&](const tbb::blocked_range<Index>& iitms) {
+      for ( Index iitm=iitms.begin(); iitm<iitms.end(); ++iitm ) fun(iitm);
+    });
+    return;
+  }
+  Index nnod = m_arenas.size();
+  std::vector<IndexVector> nodeItems(nnod);
+  for ( Index iitm=0; iitm<nitm; ++iitm ) nodeItems[nodes[iitm] % nnod].push_back(iitm);
+  std::vector<tbb::task_group> groups(nnod);
+  for ( Index inod=0; inod<nnod; ++inod ) {
+    const IndexVector& itms = nodeItems[inod];
+    if ( itms.empty() ) continue;
+    tbb::task_group& grp = groups[inod];
+    m_arenas[inod]->execute([&grp, &itms, &fun]() {
+      grp.run([&itms, &fun]() {
+        tbb::parallel_for(tbb::blocked_range<Index>(0, itms.size()),
+                          [&](const tbb::blocked_range<Index>& iitms) {
+          for ( Index iitm=iitms.begin(); iitm<iitms.end(); ++iitm ) fun(itms[iitm]);
+        });
+      });
+    });
+  }
+  for ( Index inod=0; inod<nnod; ++inod ) {
+    if ( nodeItems[inod].empty() ) continue;
+    tbb::task_group& grp = groups[inod];
+    m_arenas[inod]->execute([&grp]() { grp.wait(); });
+  }
+}
+
+//**********************************************************************
+
+#endif
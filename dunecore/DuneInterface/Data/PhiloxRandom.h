@@ -0,0 +1,99 @@
+// PhiloxRandom.h
+//
+// Counter-based random numbers with the Philox4x32-10 generator of Salmon et al.,
+// "Parallel random numbers: as easy as 1, 2, 3" (SC11).
+//
+// Each call maps a 128-bit counter and a 64-bit key to four 32-bit random words
+// and there is no state, so the numbers for a given (key, counter) are the same
+// whatever thread generates them and in whatever order. A typical use is to take
+// the key from the event/job seed and the counter from the channel and tick so
+// that channels may be processed in parallel with reproducible results:
+//
+//   PhiloxRandom::Key key = PhiloxRandom::makeKey(seed);
+//   PhiloxRandom::addGaus(psig, ntick, ped, pedrms, key, chan, event);
+//
+// Tick itck of a stream (s1, s2) uses the counter (itck/4, s1, s2, 0), word itck%4.
+
+#ifndef PhiloxRandom_H
+#define PhiloxRandom_H
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+
+class PhiloxRandom {
+
+public:
+
+  using Word = std::uint32_t;
+  using Counter = std::array<Word, 4>;
+  using Key = std::array<Word, 2>;
+  using Index = unsigned int;
+
+  // Key from a 64-bit seed.
+  static Key makeKey(std::uint64_t seed) { return {{Word(seed), Word(seed >> 32)}}; }
+
+  // Return the four random words for a counter and key.
+  static Counter generate(Counter ctr, Key key);
+
+  // Convert a random word to a uniform value in (0, 1).
+  // The top 23 bits are used so that the result is exact and never reaches 1.
+  static float toUniform(Word wrd) { return ((wrd >> 9) + 0.5f)*(1.0f/8388608.0f); }
+
+  // Fill four standard normal values from one counter with the Box-Muller transform.
+  static void gaus4(const Counter& ctr, const Key& key, float* pout);
+
+  // Add n normal values with mean and sigma to pout for stream (s1, s2).
+  static void addGaus(float* pout, Index n, float mean, float sigma, const Key& key,
+                      Word s1, Word s2 =0);
+
+};
+
+//**********************************************************************
+
+inline PhiloxRandom::Counter PhiloxRandom::generate(Counter ctr, Key key) {
+  const std::uint64_t m0 = 0xD2511F53;
+  const std::uint64_t m1 = 0xCD9E8D57;
+  const Word w0 = 0x9E3779B9;
+  const Word w1 = 0xBB67AE85;
+  for ( int irnd=0; irnd<10; ++irnd ) {
+    if ( irnd > 0 ) {
+      key[0] += w0;
+      key[1] += w1;
+    }
+    std::uint64_t p0 = m0*ctr[0];
+    std::uint64_t p1 = m1*ctr[2];
+    ctr = {{Word(p1 >> 32) ^ ctr[1] ^ key[0], Word(p1),
+            Word(p0 >> 32) ^ ctr[3] ^ key[1], Word(p0)}};
+  }
+  return ctr;
+}
+
+//**********************************************************************
+
+inline void PhiloxRandom::gaus4(const Counter& ctr, const Key& key, float* pout) {
+  const float twopi = 6.283185307f;
+  Counter rnd = generate(ctr, key);
+  for ( int ipr=0; ipr<2; ++ipr ) {
+    float rad = std::sqrt(-2.0f*std::log(toUniform(rnd[2*ipr])));
+    float phi = twopi*toUniform(rnd[2*ipr + 1]);
+    pout[2*ipr] = rad*std::cos(phi);
+    pout[2*ipr + 1] = rad*std::sin(phi);
+  }
+}
+
+//**********************************************************************
+
+inline void PhiloxRandom::addGaus(float* pout, Index n, float mean, float sigma,
+                                  const Key& key, Word s1, Word s2) {
+  float vals[4];
+  for ( Index ibeg=0; ibeg<n; ibeg+=4 ) {
+    gaus4({{Word(ibeg/4), s1, s2, 0}}, key, vals);
+    Index nval = n - ibeg < 4 ? n - ibeg : 4;
+    for ( Index ival=0; ival<nval; ++ival ) pout[ibeg + ival] += mean + sigma*vals[ival];
+  }
+}
+
+//**********************************************************************
+
+#endif
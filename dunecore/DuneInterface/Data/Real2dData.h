@@ -7,13 +7,26 @@
 //
 // It is templated so DFT elements can be stored at different levels of
 // floating point precision.
+//
+// The data are held contiguously in row-major order: row i (first index) starts at
+// floatData() + i*stride(). Kernels should loop over rows with rowData(i) and use the
+// unchecked accessor operator()(i, j) or a view() (see StridedView) rather than
+// value(..), which validates its indices on every call. view<true>() gives a view
+// that throws for indices out of range.
+//
+// The generation counter is incremented by every non-const method that gives access
+// to or modifies the data, so that derived data (e.g. the DFT in Tpc2dRoi) can tell
+// if it is stale. Read through a const reference to leave it unchanged.
 
 #ifndef Real2dData_H
 #define Real2dData_H
 
 #include "dunecore/DuneInterface/Data/RealDftNormalization.h"
+#include "dunecore/DuneInterface/Data/StridedView.h"
 #include <complex>
 #include <array>
+#include <vector>
+#include <limits>
 
 //**********************************************************************
 
@@ -34,18 +47,14 @@ public:
   using IndexArray = std::array<Index,2>;
   using Norm = RealDftNormalization;
   using Complex = std::complex<Float>;     // same memory layout as fftw_complex
+  template<bool Checked =false> using View = StridedView<F, 2, Checked>;
+  template<bool Checked =false> using ConstView = StridedView<const F, 2, Checked>;
 
   // Data size for specified sample sizes.
   // Returns the number of floats.
   template<std::size_t N>
-  static Index dataSize(const std::array<Index, N>& nsams) {
-    Index ndat = 1;
-    Index ndim = nsams.size();
-    for ( Index idim=0; idim<ndim; ++idim ) {
-      Index nsam = nsams[idim];
-      ndat *= nsam;
-    }
-    return ndat;
+  static constexpr Index dataSize(const std::array<Index, N>& nsams) {
+    return StridedView<const F, N>::dataSize(nsams);
   }
 
   // Constructor.
@@ -66,12 +75,14 @@ public:
 
   // Clear the data, i.e. zero the # samples.
   void clear() {
+    markModified();
     for ( Index& nsam : m_nsams ) nsam = 0;
     m_data.clear();
   }
 
   // Reset to (nsamx, nsamy) samples and zero the DFT.
   void reset(const IndexArray& nsams)  {
+    markModified();
     m_nsams = nsams;
     m_data.clear();
     Index ndat = dataSize(m_nsams);
@@ -116,11 +127,38 @@ public:
   // Return the data (row major order).
   const std::vector<F>& data() const { return m_data; }
 
+  // Raw access to the data.
+  // The stride is the offset between rows, i.e. the number of values in a row.
+  // The non-const accessors increment the generation.
+  F* floatData() { markModified(); return m_data.data(); }
+  const F* floatData() const { return m_data.data(); }
+  Index stride() const { return m_nsams[1]; }
+  F* rowData(Index irow) { markModified(); return m_data.data() + irow*stride(); }
+  const F* rowData(Index irow) const { return m_data.data() + irow*stride(); }
+
+  // Unchecked access to the value for indices (irow, icol).
+  F& operator()(Index irow, Index icol) { markModified(); return m_data[irow*stride() + icol]; }
+  F operator()(Index irow, Index icol) const { return m_data[irow*stride() + icol]; }
+
+  // View of the data with the rank and the unit stride fixed at compile time.
+  // The non-const view increments the generation.
+  template<bool Checked =false>
+  View<Checked> view() { markModified(); return View<Checked>(m_data.data(), m_nsams); }
+  template<bool Checked =false>
+  ConstView<Checked> view() const { return ConstView<Checked>(m_data.data(), m_nsams); }
+
+  // Generation of the data.
+  unsigned long generation() const { return m_generation; }
+
+  // Record that the data has been modified.
+  void markModified() { ++m_generation; }
+
   // Copy the data in from a vector.
   // Return 0 for success.
   int copyDataIn(const DataVector& data) {
     if ( ! isValid() ) return 1;
     if ( data.size() != m_data.size() ) return 2;
+    markModified();
     m_data = data;
     return 0;
   }
@@ -130,6 +168,7 @@ public:
   template<typename T>
   int copyDataIn(const T* pdat) {
     if ( ! isValid() ) return 1;
+    markModified();
     Index ndat = size();
     for ( Index idat=0; idat<ndat; ++idat ) {
       m_data[idat] = pdat[idat];
@@ -198,6 +237,7 @@ public:
     Index idat = globalIndex(isams, pchk);
     if ( pchk != nullptr && *pchk > 0 ) return size();
     if ( idat >= size() ) return size();
+    markModified();
     m_data[idat] = val;
     return idat;
   }
@@ -205,13 +245,7 @@ public:
   // Return the total power.
   F power() const {
     F pwr = 0.0;
-    IndexArray idats;
-    for ( idats[0]=0; idats[0]<size(0); ++idats[0] ) {
-      for ( idats[1]=0; idats[1]<size(1); ++idats[1] ) {
-        F val = value(idats);
-        pwr += val*val;
-      }
-    }
+    for ( F val : m_data ) pwr += val*val;
     return pwr;
   }
 
@@ -219,6 +253,7 @@ private:
 
   IndexArray m_nsams;
   DataVector m_data;
+  unsigned long m_generation =0;
 
 };
 
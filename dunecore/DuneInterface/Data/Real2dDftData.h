@@ -14,6 +14,7 @@
 #define Real2dDftData_H
 
 #include "dunecore/DuneInterface/Data/RealDftNormalization.h"
+#include "dunecore/DuneInterface/Data/StridedView.h"
 #include <complex>
 #include <array>
 
@@ -31,14 +32,8 @@ public:
   // Data size for specified sample sizes.
   // Returns the number of floats.
   template<std::size_t N>
-  static Index dataSize(const std::array<Index, N>& nsams) {
-    Index ndat = 1;
-    Index ndim = nsams.size();
-    for ( Index idim=0; idim<ndim; ++idim ) {
-      Index nsam = nsams[idim];
-      ndat *= nsam;
-    }
-    return ndat;
+  static constexpr Index dataSize(const std::array<Index, N>& nsams) {
+    return StridedView<const F, N>::dataSize(nsams);
   }
 
   // Dtor.
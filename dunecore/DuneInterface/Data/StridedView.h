@@ -0,0 +1,135 @@
+// StridedView.h
+//
+// Non-owning view of a contiguous row-major array whose rank R is fixed at
+// compile time, e.g. the data in Real2dData or FftwReal2dDftData.
+//
+// The extents are given when the view is made and the strides are computed from
+// them. The last stride is always one, so the index arithmetic is unrolled over
+// the rank and a loop over the last index is plain pointer arithmetic that the
+// compiler can vectorize:
+//   StridedView<float, 2> v = dat.view();
+//   for ( Index irow=0; irow<v.extent(0); ++irow ) {
+//     float* prow = v.row(irow);
+//     for ( Index icol=0; icol<v.extent(1); ++icol ) prow[icol] *= gain;
+//   }
+//
+// If Checked is true, the accessors throw std::out_of_range for indices outside
+// the extents. The unchecked view (the default) does no checks.
+//
+// The view is invalidated by anything that resizes or reallocates the data.
+
+#ifndef StridedView_H
+#define StridedView_H
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template<typename T, std::size_t R, bool Checked =false>
+class StridedView {
+
+  static_assert(R > 0, "StridedView rank must be positive.");
+
+public:
+
+  using Value = T;
+  using Index = unsigned int;
+  using IndexArray = std::array<Index, R>;
+
+  // Number of values for extents nsams.
+  static constexpr Index dataSize(const IndexArray& nsams) {
+    Index ndat = 1;
+    for ( std::size_t idim=0; idim<R; ++idim ) ndat *= nsams[idim];
+    return ndat;
+  }
+
+  // Strides for extents nsams.
+  static constexpr IndexArray makeStrides(const IndexArray& nsams) {
+    IndexArray strs{};
+    Index str = 1;
+    for ( std::size_t jdim=R; jdim>0; --jdim ) {
+      strs[jdim-1] = str;
+      str *= nsams[jdim-1];
+    }
+    return strs;
+  }
+
+  static constexpr std::size_t rank() { return R; }
+  static constexpr bool isChecked() { return Checked; }
+
+  // Empty view.
+  constexpr StridedView() =default;
+
+  // View of the data at pdat with extents nsams.
+  constexpr StridedView(T* pdat, const IndexArray& nsams)
+  : m_pdat(pdat), m_nsams(nsams), m_strides(makeStrides(nsams)) { }
+
+  // Conversion from a view of the same rank, e.g. non-const to const or
+  // unchecked to checked.
+  template<typename U, bool C,
+           typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  constexpr StridedView(const StridedView<U, R, C>& rhs)
+  : StridedView(rhs.data(), rhs.extents()) { }
+
+  constexpr T* data() const { return m_pdat; }
+  constexpr const IndexArray& extents() const { return m_nsams; }
+  constexpr Index extent(std::size_t idim) const { return m_nsams[idim]; }
+  constexpr const IndexArray& strides() const { return m_strides; }
+  constexpr Index stride(std::size_t idim) const { return m_strides[idim]; }
+  constexpr Index size() const { return dataSize(m_nsams); }
+  constexpr bool empty() const { return size() == 0; }
+
+  // Return if all indices are within the extents.
+  constexpr bool inRange(const IndexArray& isams) const {
+    for ( std::size_t idim=0; idim<R; ++idim ) {
+      if ( isams[idim] >= m_nsams[idim] ) return false;
+    }
+    return true;
+  }
+
+  // Offset of the value for indices isams from data().
+  constexpr Index offset(const IndexArray& isams) const {
+    if constexpr ( Checked ) check(isams);
+    return leadingOffset(isams, std::make_index_sequence<R-1>()) + isams[R-1];
+  }
+  template<typename... I>
+  constexpr Index offset(I... isams) const {
+    static_assert(sizeof...(I) == R, "StridedView index count must equal the rank.");
+    return offset(IndexArray{{Index(isams)...}});
+  }
+
+  // Value for indices isams.
+  template<typename... I>
+  constexpr T& operator()(I... isams) const { return m_pdat[offset(isams...)]; }
+  constexpr T& operator[](const IndexArray& isams) const { return m_pdat[offset(isams)]; }
+
+  // Pointer to the first value with first index irow, i.e. the start of the
+  // contiguous stride(0) values for that index.
+  constexpr T* row(Index irow) const {
+    if constexpr ( Checked ) {
+      if ( irow >= m_nsams[0] ) throw std::out_of_range("StridedView: Row index is out of range.");
+    }
+    return m_pdat + std::size_t(irow)*m_strides[0];
+  }
+
+private:
+
+  constexpr void check(const IndexArray& isams) const {
+    if ( ! inRange(isams) ) throw std::out_of_range("StridedView: Index is out of range.");
+  }
+
+  // Unrolled sum over the leading dimensions. The last has stride one.
+  template<std::size_t... D>
+  constexpr Index leadingOffset(const IndexArray& isams, std::index_sequence<D...>) const {
+    return (Index(0) + ... + (isams[D]*m_strides[D]));
+  }
+
+  T* m_pdat = nullptr;
+  IndexArray m_nsams{};
+  IndexArray m_strides{};
+
+};
+
+#endif
@@ -7,6 +7,18 @@
 // i.e. an array of floats indexed by channel and tick.
 //
 // The data may be read with data().value(..) and written wiht data().setValue(..).
+// Loops over the data should instead use the row pointers, e.g.
+//   for ( Index irow=0; irow<roi.channelSize(); ++irow ) {
+//     float* pdat = roi.data().rowData(irow);
+//     for ( Index isam=0; isam<roi.sampleSize(); ++isam ) pdat[isam] *= gain;
+//   }
+// or channelData(icha) for an absolute channel number.
+//
+// The DFT is tagged with the generation of the data (see Real2dData) it was computed
+// from, so tools can share one transform and recompute it only if the data changed:
+//   if ( roi.ensureDft(fft, norm) ) ...error...
+//   const Tpc2dRoi::Dft& dft = *roi.dft();
+// A DFT assigned with resetDft is taken to correspond to the current data.
 
 #ifndef Tpc2dRoi_H
 #define Tpc2dRoi_H
@@ -55,13 +67,21 @@ public:
   float value(Index icha, LongIndex itck, float valdef =0.0) const {
     if ( icha < channelOffset() ) return valdef;
     if ( itck < sampleOffset() ) return valdef;
-    Index chk = 0;
-    DataArray::IndexArray idxs;
-    idxs[0] = icha - channelOffset();
-    idxs[1] = itck - sampleOffset();
-    float val = data().value(idxs, &chk);
-    if ( chk ) return valdef;
-    return val;
+    Index irow = icha - channelOffset();
+    LongIndex isam = itck - sampleOffset();
+    if ( irow >= channelSize() || isam >= sampleSize() ) return valdef;
+    return data()(irow, isam);
+  }
+
+  // Return the data for a channel, i.e. sampleSize() values starting at tick
+  // sampleOffset(). Null if the channel is out of range.
+  float* channelData(Index icha) {
+    if ( icha < channelOffset() || icha - channelOffset() >= channelSize() ) return nullptr;
+    return data().rowData(icha - channelOffset());
+  }
+  const float* channelData(Index icha) const {
+    if ( icha < channelOffset() || icha - channelOffset() >= channelSize() ) return nullptr;
+    return data().rowData(icha - channelOffset());
   }
 
   // Return a pointer to DFT. Null if undefined.
@@ -70,7 +90,30 @@ public:
 
   // Reset the DFT data pointer. Existing data is deleted.
   // This class now owns that DFT data.
-  void resetDft(Dft* pdft) { m_pdft.reset(pdft); }
+  void resetDft(Dft* pdft) {
+    m_pdft.reset(pdft);
+    m_dftGeneration = data().generation();
+  }
+
+  // Return if there is a DFT computed from the current data.
+  bool dftIsCurrent() const { return m_pdft && m_dftGeneration == data().generation(); }
+
+  // Mark the DFT as not corresponding to the current data.
+  void invalidateDft() { m_dftGeneration = data().generation() - 1; }
+
+  // Compute the DFT with normalization norm if it is absent, stale or has a
+  // different normalization. FFT is e.g. Fw2dFFT.
+  // Returns 0 for success or the status from fft.fftForward.
+  template<class FFT>
+  int ensureDft(FFT& fft, Dft::Norm norm, Index logLevel =0);
+
+  // Same with the normalization of the existing DFT.
+  // Returns -1 if there is no DFT.
+  template<class FFT>
+  int ensureDft(FFT& fft, Index logLevel =0) {
+    if ( ! m_pdft ) return -1;
+    return ensureDft(fft, m_pdft->normalization(), logLevel);
+  }
 
 private:
 
@@ -78,7 +121,27 @@ private:
   LongIndex m_sampleOffset;
   Index m_channelOffset;
   DftPtr m_pdft;
+  unsigned long m_dftGeneration =0;
 
 };
 
+//**********************************************************************
+
+template<class FFT>
+int Tpc2dRoi::ensureDft(FFT& fft, Dft::Norm norm, Index logLevel) {
+  if ( dftIsCurrent() && norm == m_pdft->normalization() ) return 0;
+  if ( ! m_pdft || ! (norm == m_pdft->normalization()) ) {
+    m_pdft.reset(new Dft(norm, data().nSamples()));
+  }
+  int rstat = fft.fftForward(data(), *m_pdft, logLevel);
+  if ( rstat ) {
+    invalidateDft();
+    return rstat;
+  }
+  m_dftGeneration = data().generation();
+  return 0;
+}
+
+//**********************************************************************
+
 #endif
@@ -1,6 +1,7 @@
 // TpcData.cxx
 
 #include "dunecore/DuneInterface/Data/TpcData.h"
+#include "dunecore/DuneInterface/Data/AdcChannelDataPool.h"
 
 using std::cout;
 using std::endl;
@@ -12,7 +13,7 @@ TpcData::TpcData() : m_parent(nullptr) { }
 //**********************************************************************
 
 TpcData::TpcData(Index npla) : m_parent(nullptr), m_adcs(npla) {
-  for ( Index ipla=0; ipla<npla; ++ipla ) m_adcs[ipla].reset(new AdcChannelDataMap);
+  for ( Index ipla=0; ipla<npla; ++ipla ) m_adcs[ipla] = AdcChannelDataPool::makeMap();
 }
 
 //**********************************************************************
@@ -39,6 +40,20 @@ TpcData* TpcData::addTpcData(Name nam, bool copyAdcData) {
 
 //**********************************************************************
 
+TpcData* TpcData::addTpcData(Name nam, Index iadc0, Index nadc) {
+  Name::size_type ipos = nam.rfind("/");
+  const TpcData* pdat = ipos == Name::npos ? this : getTpcData(nam.substr(0, ipos));
+  if ( pdat == nullptr ) return nullptr;
+  const AdcDataVector& adcs = pdat->getAdcData();
+  if ( iadc0 > adcs.size() || nadc > adcs.size() - iadc0 ) return nullptr;
+  TpcData* ptpc = addTpcData(nam, false);
+  if ( ptpc == nullptr ) return nullptr;
+  ptpc->m_adcs.assign(adcs.begin() + iadc0, adcs.begin() + iadc0 + nadc);
+  return ptpc;
+}
+
+//**********************************************************************
+
 TpcData* TpcData::getTpcData(Name nam) {
   if ( nam == "" || nam == "." ) return this;
   Name::size_type ipos = nam.find("/");
@@ -97,14 +112,14 @@ const TpcData* TpcData::getTpcData(Name nam) const {
 //**********************************************************************
 
 TpcData::AdcDataPtr TpcData::createAdcData(bool updateParent) {
-  return addAdcData(AdcDataPtr(new AdcChannelDataMap), updateParent);
+  return addAdcData(AdcChannelDataPool::makeMap(), updateParent);
 }
 
 //**********************************************************************
 
 TpcData::AdcDataPtr TpcData::addAdcData(AdcDataPtr padc, bool updateParent) {
-  m_adcs.push_back(padc);
-  if ( updateParent && m_parent != nullptr ) m_parent->addAdcData(padc, true);
+  if ( updateParent ) addAdcDataToAncestors(padc);
+  else m_adcs.push_back(padc);
   return padc;
 }
 
@@ -116,6 +131,27 @@ void TpcData::clearAdcData() {
 
 //**********************************************************************
 
+void TpcData::releaseAdcData() {
+  AdcDataVector().swap(m_adcs);
+  for ( TpcDataMap::value_type& itpd : m_dat ) itpd.second.releaseAdcData();
+}
+
+//**********************************************************************
+
+void TpcData::release() {
+  AdcDataVector().swap(m_adcs);
+  Tpc2dRoiVector().swap(m_2drois);
+  m_dat.clear();
+}
+
+//**********************************************************************
+
+void TpcData::addAdcDataToAncestors(const AdcDataPtr& padc) {
+  for ( TpcData* pdat=this; pdat!=nullptr; pdat=pdat->m_parent ) pdat->m_adcs.push_back(padc);
+}
+
+//**********************************************************************
+
 std::ostream& TpcData::print(Name prefix, Index depth) const {
   Index nmap = getAdcData().size();
   cout << prefix << "ADC Channel map count is " << nmap;
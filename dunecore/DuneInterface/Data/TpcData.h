@@ -65,6 +65,11 @@ public:
   // If copyAdcData is true, the new object copies the AdcData (pointers).
   TpcData* addTpcData(Name nam, bool copyAdcData =true);
 
+  // Add a named TPC data constituent that copies only the nadc AdcData pointers
+  // starting at index iadc0 in the parent, e.g. the maps for one plane.
+  // Fails and returns null if the range is not in the parent.
+  TpcData* addTpcData(Name nam, Index iadc0, Index nadc);
+
   // Return a constituent TPC data object by name.
   // The name "" or "." returns this object.
   // If the name is target/subname, constituent subname from
@@ -81,12 +86,23 @@ public:
 
   // Add ADC data.
   // If updateParent is true, the same object is added to all ancestors.
+  // The maps created here return their channel data to AdcChannelDataPool when deleted.
   AdcDataPtr createAdcData(bool updateParent =true);
   AdcDataPtr addAdcData(AdcDataPtr padc, bool updateParent =true);
 
   // Delete the ADC data. References in acestor and descendants are not affected.
   void clearAdcData();
 
+  // Delete the ADC data in this object and all its descendants.
+  // The maps are released if they are not referenced elsewhere.
+  void releaseAdcData();
+
+  // Release everything held by this object: ADC data, 2D ROIs and constituents.
+  // Call e.g. at the end of an event so that the event data is not kept alive
+  // by a TpcData object held beyond the event. References to constituents
+  // become invalid.
+  void release();
+
   // Print a brief description of thid object:
   // # ADC maps and channels for each.
   // # 2D ROIS
@@ -96,6 +112,9 @@ public:
 
 private:
 
+  // Add ADC data to this object and all its ancestors.
+  void addAdcDataToAncestors(const AdcDataPtr& padc);
+
   TpcData*       m_parent;
   TpcDataMap     m_dat;
   AdcDataVector  m_adcs;
@@ -0,0 +1,473 @@
+// TpcDataCache.cxx
+
+#include "dunecore/DuneInterface/Data/TpcDataCache.h"
+#include "dunecore/DuneInterface/Data/AdcChannelDataPool.h"
+#include "dunecore/DuneInterface/Data/AdcBitMask.h"
+#include <vector>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using std::string;
+using std::vector;
+using Index = TpcDataCache::Index;
+using Name = TpcDataCache::Name;
+using Hash = TpcDataCache::Hash;
+using AdcDataPtr = TpcData::AdcDataPtr;
+using EventInfoPtr = AdcChannelData::EventInfoPtr;
+using std::uint32_t;
+using std::uint64_t;
+
+namespace {
+
+const uint64_t magicWord = 0x44435054454e5544ul;   // "DUNETPCD"
+const uint32_t formatVersion = 1;
+
+// Fixed-size records.
+
+struct Header {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t run;
+  uint32_t subrun;
+  uint32_t event;
+  uint64_t cfg;
+  uint64_t nevi;
+  uint64_t nmap;
+};
+
+struct EventRecord {
+  uint32_t run;
+  uint32_t event;
+  uint32_t subRun;
+  uint32_t trigger;
+  int64_t time;
+  int64_t timerem;
+  uint64_t triggerClock;
+  uint64_t triggerTick0;
+};
+
+struct ChannelRecord {
+  uint32_t channel;
+  uint32_t fembID;
+  uint32_t fembChannel;
+  uint32_t channelStatus;
+  uint32_t ievi;         // Index in the event table or badIndex
+  int32_t tick0;
+  float pedestal;
+  float pedestalRms;
+  float sampleNoise;
+  uint32_t nraw;
+  uint32_t nsam;
+  uint32_t nflg;
+  uint32_t nroi;
+  uint32_t nsig;
+  uint32_t nunit;
+  uint32_t nmet;
+  uint64_t channelClock;
+};
+
+struct Roi2dRecord {
+  uint32_t ncha;
+  uint32_t nsam;
+  uint32_t icha0;
+  uint32_t pad;
+  uint64_t isam0;
+};
+
+//**********************************************************************
+
+// Buffer the snapshot is written to.
+class Writer {
+public:
+  void align() { m_buf.resize((m_buf.size() + 7)/8*8, 0); }
+  template<typename T>
+  void put(const T& val) { putArray(&val, 1); }
+  template<typename T>
+  void putArray(const T* pval, std::size_t nval) {
+    align();
+    if ( nval == 0 ) return;
+    const char* pch = reinterpret_cast<const char*>(pval);
+    m_buf.insert(m_buf.end(), pch, pch + nval*sizeof(T));
+  }
+  void putString(const string& str) {
+    put<uint32_t>(str.size());
+    putArray(str.data(), str.size());
+  }
+  const vector<char>& buffer() const { return m_buf; }
+private:
+  vector<char> m_buf;
+};
+
+//**********************************************************************
+
+// Sequential reader of a mapped snapshot.
+// After any failure, ok() is false and all reads return null.
+class Reader {
+public:
+  Reader(const char* pbeg, std::size_t nbyte) : m_pbeg(pbeg), m_nbyte(nbyte) { }
+  bool ok() const { return m_ok; }
+  template<typename T>
+  const T* getArray(std::size_t nval) {
+    m_pos = (m_pos + 7)/8*8;
+    std::size_t nget = nval*sizeof(T);
+    if ( ! m_ok || m_pos > m_nbyte || nget > m_nbyte - m_pos ) {
+      m_ok = false;
+      return nullptr;
+    }
+    const T* pval = reinterpret_cast<const T*>(m_pbeg + m_pos);
+    m_pos += nget;
+    return pval;
+  }
+  template<typename T>
+  bool get(T& val) {
+    const T* pval = getArray<T>(1);
+    if ( pval == nullptr ) return false;
+    val = *pval;
+    return true;
+  }
+  bool getString(string& str) {
+    uint32_t nch = 0;
+    if ( ! get(nch) ) return false;
+    const char* pch = getArray<char>(nch);
+    if ( pch == nullptr ) return false;
+    str.assign(pch, nch);
+    return true;
+  }
+private:
+  const char* m_pbeg;
+  std::size_t m_nbyte;
+  std::size_t m_pos = 0;
+  bool m_ok = true;
+};
+
+//**********************************************************************
+
+// Read-only mapping of a file.
+class MappedFile {
+public:
+  explicit MappedFile(const string& fnam) {
+    int fd = open(fnam.c_str(), O_RDONLY);
+    if ( fd < 0 ) return;
+    struct stat st;
+    if ( fstat(fd, &st) == 0 && st.st_size > 0 ) {
+      void* pmap = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if ( pmap != MAP_FAILED ) {
+        m_pdat = static_cast<const char*>(pmap);
+        m_size = st.st_size;
+      }
+    }
+    close(fd);
+  }
+  ~MappedFile() {
+    if ( m_pdat != nullptr ) munmap(const_cast<char*>(m_pdat), m_size);
+  }
+  MappedFile(const MappedFile&) =delete;
+  MappedFile& operator=(const MappedFile&) =delete;
+  const char* data() const { return m_pdat; }
+  std::size_t size() const { return m_size; }
+private:
+  const char* m_pdat = nullptr;
+  std::size_t m_size = 0;
+};
+
+//**********************************************************************
+
+// Tables of the shared objects in a snapshot.
+struct WriteTables {
+  std::map<const AdcChannelDataMap*, uint32_t> maps;
+  vector<const AdcChannelDataMap*> mapList;
+  std::map<const DuneEventInfo*, uint32_t> evis;
+  vector<const DuneEventInfo*> eviList;
+};
+
+void collect(const TpcData& tpd, WriteTables& tabs) {
+  for ( const AdcDataPtr& padc : tpd.getAdcData() ) {
+    if ( ! padc || tabs.maps.count(padc.get()) ) continue;
+    tabs.maps[padc.get()] = tabs.mapList.size();
+    tabs.mapList.push_back(padc.get());
+    for ( const AdcChannelDataMap::value_type& iacd : *padc ) {
+      const DuneEventInfo* pevi = iacd.second.getEventInfoPtr().get();
+      if ( pevi == nullptr || tabs.evis.count(pevi) ) continue;
+      tabs.evis[pevi] = tabs.eviList.size();
+      tabs.eviList.push_back(pevi);
+    }
+  }
+  for ( const TpcData::TpcDataMap::value_type& itpd : tpd.getData() ) collect(itpd.second, tabs);
+}
+
+//**********************************************************************
+
+void writeChannel(Writer& wrt, const AdcChannelData& acd, const WriteTables& tabs) {
+  ChannelRecord rec;
+  std::memset(&rec, 0, sizeof(rec));
+  rec.channel = acd.channel();
+  rec.fembID = acd.fembID();
+  rec.fembChannel = acd.fembChannel();
+  rec.channelStatus = acd.channelStatus();
+  const DuneEventInfo* pevi = acd.getEventInfoPtr().get();
+  rec.ievi = pevi == nullptr ? AdcChannelData::badIndex() : tabs.evis.at(pevi);
+  rec.tick0 = acd.tick0;
+  rec.pedestal = acd.pedestal;
+  rec.pedestalRms = acd.pedestalRms;
+  rec.sampleNoise = acd.sampleNoise;
+  rec.nraw = acd.raw.size();
+  rec.nsam = acd.sampleCount();
+  rec.nflg = acd.flags.size();
+  rec.nroi = acd.rois.size();
+  rec.nsig = acd.signal.size();
+  rec.nunit = acd.sampleUnit.size();
+  rec.nmet = acd.metadata.size();
+  rec.channelClock = acd.channelClock;
+  wrt.put(rec);
+  wrt.putArray(acd.raw.data(), rec.nraw);
+  wrt.putArray(acd.sampleData(), rec.nsam);
+  wrt.putArray(acd.flags.data(), rec.nflg);
+  vector<uint32_t> rois;
+  rois.reserve(2*rec.nroi);
+  for ( const AdcRoi& roi : acd.rois ) {
+    rois.push_back(roi.first);
+    rois.push_back(roi.second);
+  }
+  wrt.putArray(rois.data(), rois.size());
+  AdcBitMask sig(acd.signal);
+  wrt.putArray(sig.words(), sig.nword());
+  wrt.putArray(acd.sampleUnit.data(), rec.nunit);
+  for ( const auto& ent : acd.metadata ) {
+    wrt.putString(ent.first);
+    wrt.put<float>(ent.second);
+  }
+}
+
+//**********************************************************************
+
+void writeNode(Writer& wrt, const TpcData& tpd, const WriteTables& tabs) {
+  vector<uint32_t> imaps;
+  for ( const AdcDataPtr& padc : tpd.getAdcData() ) {
+    imaps.push_back(padc ? tabs.maps.at(padc.get()) : AdcChannelData::badIndex());
+  }
+  wrt.put<uint32_t>(imaps.size());
+  wrt.putArray(imaps.data(), imaps.size());
+  wrt.put<uint32_t>(tpd.get2dRois().size());
+  for ( const Tpc2dRoi& roi : tpd.get2dRois() ) {
+    Roi2dRecord rec;
+    rec.ncha = roi.channelSize();
+    rec.nsam = roi.sampleSize();
+    rec.icha0 = roi.channelOffset();
+    rec.pad = 0;
+    rec.isam0 = roi.sampleOffset();
+    wrt.put(rec);
+    wrt.putArray(roi.data().floatData(), roi.data().size());
+  }
+  wrt.put<uint32_t>(tpd.getData().size());
+  for ( const TpcData::TpcDataMap::value_type& itpd : tpd.getData() ) {
+    wrt.putString(itpd.first);
+    writeNode(wrt, itpd.second, tabs);
+  }
+}
+
+//**********************************************************************
+
+// Read a node into tpd.
+// Returns 0 for success, 2 for a format error or 3 for a name clash.
+int readNode(Reader& rdr, TpcData& tpd, const vector<AdcDataPtr>& maps) {
+  uint32_t nmap = 0;
+  if ( ! rdr.get(nmap) ) return 2;
+  const uint32_t* pimap = rdr.getArray<uint32_t>(nmap);
+  if ( pimap == nullptr ) return 2;
+  for ( uint32_t imap=0; imap<nmap; ++imap ) {
+    uint32_t jmap = pimap[imap];
+    if ( jmap == AdcChannelData::badIndex() ) tpd.addAdcData(AdcDataPtr(), false);
+    else if ( jmap < maps.size() ) tpd.addAdcData(maps[jmap], false);
+    else return 2;
+  }
+  uint32_t nroi = 0;
+  if ( ! rdr.get(nroi) ) return 2;
+  for ( uint32_t iroi=0; iroi<nroi; ++iroi ) {
+    Roi2dRecord rec;
+    if ( ! rdr.get(rec) ) return 2;
+    const float* pdat = rdr.getArray<float>(std::size_t(rec.ncha)*rec.nsam);
+    if ( pdat == nullptr ) return 2;
+    tpd.get2dRois().emplace_back(rec.ncha, rec.nsam, rec.icha0, rec.isam0);
+    tpd.get2dRois().back().data().copyDataIn(pdat);
+  }
+  uint32_t nchi = 0;
+  if ( ! rdr.get(nchi) ) return 2;
+  for ( uint32_t ichi=0; ichi<nchi; ++ichi ) {
+    string nam;
+    if ( ! rdr.getString(nam) ) return 2;
+    TpcData* pchi = tpd.addTpcData(nam, false);
+    if ( pchi == nullptr ) return 3;
+    int rstat = readNode(rdr, *pchi, maps);
+    if ( rstat ) return rstat;
+  }
+  return 0;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+Hash TpcDataCache::hash(const std::string& str) {
+  Hash val = 0xcbf29ce484222325ul;
+  for ( unsigned char ch : str ) {
+    val ^= ch;
+    val *= 0x100000001b3ul;
+  }
+  return val;
+}
+
+//**********************************************************************
+
+Name TpcDataCache::
+fileName(Name stage, Index run, Index subrun, Index event, Hash cfg) const {
+  for ( char& ch : stage ) if ( ch == '/' ) ch = '-';
+  if ( stage.empty() ) stage = "top";
+  std::ostringstream ssout;
+  ssout << m_dir << "/tpcdata_" << stage << "_r" << run << "_s" << subrun << "_e" << event
+        << "_" << std::hex << std::setw(16) << std::setfill('0') << cfg << ".tpcd";
+  return ssout.str();
+}
+
+//**********************************************************************
+
+bool TpcDataCache::has(Name stage, Index run, Index subrun, Index event, Hash cfg) const {
+  struct stat st;
+  return stat(fileName(stage, run, subrun, event, cfg).c_str(), &st) == 0;
+}
+
+//**********************************************************************
+
+int TpcDataCache::
+write(const TpcData& tpdTop, Name stage, Index run, Index subrun, Index event, Hash cfg) const {
+  const TpcData* ptpd = tpdTop.getTpcData(stage);
+  if ( ptpd == nullptr ) return 1;
+  const TpcData& tpd = *ptpd;
+  WriteTables tabs;
+  collect(tpd, tabs);
+  Writer wrt;
+  Header hdr;
+  hdr.magic = magicWord;
+  hdr.version = formatVersion;
+  hdr.run = run;
+  hdr.subrun = subrun;
+  hdr.event = event;
+  hdr.cfg = cfg;
+  hdr.nevi = tabs.eviList.size();
+  hdr.nmap = tabs.mapList.size();
+  wrt.put(hdr);
+  for ( const DuneEventInfo* pevi : tabs.eviList ) {
+    EventRecord rec;
+    rec.run = pevi->run;
+    rec.event = pevi->event;
+    rec.subRun = pevi->subRun;
+    rec.trigger = pevi->trigger;
+    rec.time = pevi->time;
+    rec.timerem = pevi->timerem;
+    rec.triggerClock = pevi->triggerClock;
+    rec.triggerTick0 = pevi->triggerTick0;
+    wrt.put(rec);
+  }
+  for ( const AdcChannelDataMap* pacm : tabs.mapList ) {
+    wrt.put<uint64_t>(pacm->size());
+    for ( const AdcChannelDataMap::value_type& iacd : *pacm ) {
+      wrt.put<uint32_t>(iacd.first);
+      writeChannel(wrt, iacd.second, tabs);
+    }
+  }
+  writeNode(wrt, tpd, tabs);
+  Name fnam = fileName(stage, run, subrun, event, cfg);
+  Name fnamTmp = fnam + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream fout(fnamTmp, std::ios::binary | std::ios::trunc);
+    if ( ! fout ) return 2;
+    fout.write(wrt.buffer().data(), wrt.buffer().size());
+    if ( ! fout ) {
+      fout.close();
+      std::remove(fnamTmp.c_str());
+      return 2;
+    }
+  }
+  if ( std::rename(fnamTmp.c_str(), fnam.c_str()) ) {
+    std::remove(fnamTmp.c_str());
+    return 2;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+int TpcDataCache::
+read(TpcData& tpd, Name stage, Index run, Index subrun, Index event, Hash cfg) const {
+  MappedFile mfil(fileName(stage, run, subrun, event, cfg));
+  if ( mfil.data() == nullptr ) return 1;
+  Reader rdr(mfil.data(), mfil.size());
+  Header hdr;
+  if ( ! rdr.get(hdr) ) return 2;
+  if ( hdr.magic != magicWord || hdr.version != formatVersion ) return 2;
+  if ( hdr.run != run || hdr.subrun != subrun || hdr.event != event || hdr.cfg != cfg ) return 2;
+  // Event info.
+  vector<EventInfoPtr> evis;
+  for ( uint64_t ievi=0; ievi<hdr.nevi; ++ievi ) {
+    EventRecord rec;
+    if ( ! rdr.get(rec) ) return 2;
+    evis.push_back(std::make_shared<DuneEventInfo>(rec.run, rec.event, rec.subRun,
+                                                   rec.time, rec.timerem, rec.trigger,
+                                                   rec.triggerClock, rec.triggerTick0));
+  }
+  // Channel maps.
+  vector<AdcDataPtr> maps;
+  for ( uint64_t imap=0; imap<hdr.nmap; ++imap ) {
+    uint64_t ncha = 0;
+    if ( ! rdr.get(ncha) ) return 2;
+    AdcDataPtr pacm = AdcChannelDataPool::makeMap();
+    for ( uint64_t icha=0; icha<ncha; ++icha ) {
+      uint32_t chan = 0;
+      ChannelRecord rec;
+      if ( ! rdr.get(chan) || ! rdr.get(rec) ) return 2;
+      AdcChannelData& acd = (*pacm)[chan];
+      acd.setChannelInfo(rec.channel, rec.fembID, rec.fembChannel, rec.channelStatus);
+      if ( rec.ievi < evis.size() ) acd.setEventInfo(evis[rec.ievi]);
+      acd.tick0 = rec.tick0;
+      acd.pedestal = rec.pedestal;
+      acd.pedestalRms = rec.pedestalRms;
+      acd.sampleNoise = rec.sampleNoise;
+      acd.channelClock = rec.channelClock;
+      const AdcCount* praw = rdr.getArray<AdcCount>(rec.nraw);
+      const AdcSignal* psam = rdr.getArray<AdcSignal>(rec.nsam);
+      const AdcFlag* pflg = rdr.getArray<AdcFlag>(rec.nflg);
+      const uint32_t* proi = rdr.getArray<uint32_t>(2*std::size_t(rec.nroi));
+      const AdcBitMask::Word* psig = rdr.getArray<AdcBitMask::Word>(AdcBitMask::wordCount(rec.nsig));
+      const char* punit = rdr.getArray<char>(rec.nunit);
+      if ( ! rdr.ok() ) return 2;
+      acd.raw.assign(praw, praw + rec.nraw);
+      acd.samples.assign(psam, psam + rec.nsam);
+      acd.flags.assign(pflg, pflg + rec.nflg);
+      acd.rois.resize(rec.nroi);
+      for ( uint32_t iroi=0; iroi<rec.nroi; ++iroi ) {
+        acd.rois[iroi] = AdcRoi(proi[2*iroi], proi[2*iroi+1]);
+      }
+      AdcBitMask sig(rec.nsig);
+      std::copy(psig, psig + sig.nword(), sig.words());
+      sig.toVector(acd.signal);
+      acd.sampleUnit.assign(punit, rec.nunit);
+      for ( uint32_t imet=0; imet<rec.nmet; ++imet ) {
+        string nam;
+        float val = 0.0;
+        if ( ! rdr.getString(nam) || ! rdr.get(val) ) return 2;
+        acd.metadata[nam] = val;
+      }
+    }
+    maps.push_back(pacm);
+  }
+  return readNode(rdr, tpd, maps);
+}
+
+//**********************************************************************
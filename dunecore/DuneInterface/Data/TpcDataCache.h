@@ -0,0 +1,77 @@
+// TpcDataCache.h
+//
+// File cache for snapshots of TpcData processing stages.
+//
+// When tuning the end of a long dataprep chain, the output of an intermediate stage
+// may be written once and later jobs may resume from it instead of decoding and
+// processing the raw data again:
+//   TpcDataCache cache("/scratch/tpccache");
+//   TpcDataCache::Hash hash = TpcDataCache::hash(configString);
+//   if ( cache.read(tpd, "raw", run, subrun, event, hash) ) {
+//     ... run the chain up to stage raw ...
+//     cache.write(tpd, "raw", run, subrun, event, hash);
+//   }
+// The hash identifies the configuration of the chain up to the stage, e.g. the
+// hash of the tool configurations.
+//
+// A snapshot holds the named TpcData object and its constituents (see
+// TpcData::addTpcData), the ADC channel maps they reference (preserving the sharing of
+// maps between parents and constituents) and their 2D ROIs. For each channel the event
+// and channel info, scalar conditions, raw, samples, flags, signal, rois, sample unit
+// and metadata are kept. Views, DFTs and links to art products are not.
+//
+// Each snapshot is one binary file in native byte order with every array aligned to
+// 8 bytes. Files are written to a temporary name and renamed so that readers never see
+// a partial file, and are read through mmap.
+
+#ifndef TpcDataCache_H
+#define TpcDataCache_H
+
+#include "dunecore/DuneInterface/Data/TpcData.h"
+#include <string>
+#include <cstdint>
+
+class TpcDataCache {
+
+public:
+
+  using Index = unsigned int;
+  using Name = std::string;
+  using Hash = std::uint64_t;
+
+  // 64-bit FNV-1a hash of a string, e.g. a configuration dump.
+  static Hash hash(const std::string& str);
+
+  // Ctor from the cache directory.
+  explicit TpcDataCache(Name a_dir) : m_dir(a_dir) { }
+
+  // Cache directory.
+  const Name& directory() const { return m_dir; }
+
+  // Return the file name for a snapshot.
+  Name fileName(Name stage, Index run, Index subrun, Index event, Hash cfg) const;
+
+  // Return if a snapshot exists.
+  bool has(Name stage, Index run, Index subrun, Index event, Hash cfg) const;
+
+  // Write the TpcData object with name stage in tpd.
+  // Returns 0 for success,
+  //   1 - stage not found
+  //   2 - file could not be written
+  int write(const TpcData& tpd, Name stage, Index run, Index subrun, Index event, Hash cfg) const;
+
+  // Read a snapshot into tpd: its ADC data and 2D ROIs are appended to those of
+  // tpd and its constituents are added to tpd.
+  // Returns 0 for success,
+  //   1 - no snapshot
+  //   2 - file is not a valid snapshot for the key
+  //   3 - a constituent name is already used in tpd
+  int read(TpcData& tpd, Name stage, Index run, Index subrun, Index event, Hash cfg) const;
+
+private:
+
+  Name m_dir;
+
+};
+
+#endif
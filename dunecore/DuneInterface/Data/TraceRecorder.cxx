@@ -0,0 +1,235 @@
+// TraceRecorder.cxx
+
+#include "dunecore/DuneInterface/Data/TraceRecorder.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+using Index = TraceRecorder::Index;
+using Count = TraceRecorder::Count;
+using Name = TraceRecorder::Name;
+using Event = TraceRecorder::Event;
+
+namespace {
+
+const char* envFileName() {
+  const char* pnam = std::getenv("DUNE_TRACE_FILE");
+  return pnam == nullptr ? "" : pnam;
+}
+
+// Write a string as a JSON string.
+void writeString(std::ostream& out, const char* str) {
+  out << '"';
+  for ( const char* pch=str; *pch!='\0'; ++pch ) {
+    if ( *pch == '"' || *pch == '\\' ) out << '\\' << *pch;
+    else if ( static_cast<unsigned char>(*pch) < 0x20 ) out << ' ';
+    else out << *pch;
+  }
+  out << '"';
+}
+
+// Write nanoseconds as microseconds.
+void writeMicroseconds(std::ostream& out, long nsec) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.3f", 1.e-3*nsec);
+  out << buf;
+}
+
+}  // end unnamed namespace
+
+std::atomic<bool> TraceRecorder::s_enabled(envFileName()[0] != '\0');
+
+//**********************************************************************
+
+TraceRecorder& TraceRecorder::instance() {
+  static TraceRecorder rec;
+  return rec;
+}
+
+//**********************************************************************
+
+TraceRecorder::TraceRecorder()
+: m_start(Clock::now()), m_fileName(envFileName()),
+  m_maxEvents(10000000), m_nevt(0), m_ndrop(0) { }
+
+//**********************************************************************
+
+TraceRecorder::~TraceRecorder() {
+  const Name myname = "TraceRecorder::dtor: ";
+  if ( m_fileName.empty() || m_written ) return;
+  if ( write() == 0 ) {
+    cout << myname << "Wrote " << eventCount() << " spans to " << m_fileName << endl;
+  } else {
+    cout << myname << "ERROR: Unable to write " << m_fileName << endl;
+  }
+}
+
+//**********************************************************************
+
+void TraceRecorder::configure(const Name& fname, Count maxEvents) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_fileName = fname;
+  m_written = false;
+  m_maxEvents = maxEvents;
+  s_enabled = ! fname.empty();
+}
+
+//**********************************************************************
+
+Name TraceRecorder::fileName() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_fileName;
+}
+
+//**********************************************************************
+
+long TraceRecorder::now() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count();
+}
+
+//**********************************************************************
+
+void TraceRecorder::record(const Event& evt) {
+  if ( m_nevt.fetch_add(1, std::memory_order_relaxed) >= m_maxEvents.load(std::memory_order_relaxed) ) {
+    m_nevt.fetch_sub(1, std::memory_order_relaxed);
+    m_ndrop.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  ThreadBuffer& buf = threadBuffer();
+  std::lock_guard<std::mutex> lock(buf.mutex);
+  buf.events.push_back(evt);
+}
+
+//**********************************************************************
+
+const char* TraceRecorder::intern(const Name& str) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_strings.insert(str).first->c_str();
+}
+
+//**********************************************************************
+
+Count TraceRecorder::eventCount() const {
+  return m_nevt.load();
+}
+
+//**********************************************************************
+
+std::vector<std::pair<Index, Event>> TraceRecorder::events() const {
+  std::vector<BufferPtr> bufs;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bufs = m_buffers;
+  }
+  std::vector<std::pair<Index, Event>> evts;
+  for ( const BufferPtr& pbuf : bufs ) {
+    std::lock_guard<std::mutex> lock(pbuf->mutex);
+    Index nevt0 = evts.size();
+    for ( const Event& evt : pbuf->events ) evts.emplace_back(pbuf->thread, evt);
+    // Spans are recorded when they end so enclosing spans follow those they contain.
+    std::stable_sort(evts.begin() + nevt0, evts.end(),
+                     [](const std::pair<Index, Event>& lhs, const std::pair<Index, Event>& rhs) {
+                       return lhs.second.start < rhs.second.start;
+                     });
+  }
+  return evts;
+}
+
+//**********************************************************************
+
+int TraceRecorder::write() {
+  Name fname = fileName();
+  int stat = write(fname);
+  if ( stat == 0 ) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_written = true;
+  }
+  return stat;
+}
+
+//**********************************************************************
+
+int TraceRecorder::write(const Name& fname) const {
+  if ( fname.empty() ) return 1;
+  std::ofstream fout(fname);
+  if ( ! fout ) return 2;
+  long pid = ::getpid();
+  std::vector<std::pair<Index, Event>> evts = events();
+  Index nthr = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    nthr = m_buffers.size();
+  }
+  fout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for ( Index ithr=0; ithr<nthr; ++ithr ) {
+    fout << (first ? "\n" : ",\n");
+    first = false;
+    fout << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << ithr
+         << ",\"args\":{\"name\":\"thread " << ithr << "\"}}";
+  }
+  for ( const std::pair<Index, Event>& ievt : evts ) {
+    const Event& evt = ievt.second;
+    fout << (first ? "\n" : ",\n");
+    first = false;
+    fout << "{\"name\":";
+    writeString(fout, evt.name);
+    fout << ",\"cat\":";
+    writeString(fout, evt.category);
+    fout << ",\"ph\":\"X\",\"ts\":";
+    writeMicroseconds(fout, evt.start);
+    fout << ",\"dur\":";
+    writeMicroseconds(fout, evt.duration);
+    fout << ",\"pid\":" << pid << ",\"tid\":" << ievt.first;
+    if ( evt.nargs ) {
+      fout << ",\"args\":{";
+      for ( Index iarg=0; iarg<evt.nargs; ++iarg ) {
+        if ( iarg ) fout << ",";
+        writeString(fout, evt.argNames[iarg]);
+        fout << ":" << evt.argValues[iarg];
+      }
+      fout << "}";
+    }
+    fout << "}";
+  }
+  fout << "\n]}" << endl;
+  return fout ? 0 : 2;
+}
+
+//**********************************************************************
+
+void TraceRecorder::clear() {
+  std::vector<BufferPtr> bufs;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bufs = m_buffers;
+  }
+  for ( const BufferPtr& pbuf : bufs ) {
+    std::lock_guard<std::mutex> lock(pbuf->mutex);
+    m_nevt -= pbuf->events.size();
+    pbuf->events.clear();
+  }
+  m_ndrop = 0;
+}
+
+//**********************************************************************
+
+TraceRecorder::ThreadBuffer& TraceRecorder::threadBuffer() {
+  // Buffers are never removed so the pointer stays valid after the thread
+  // exits and the spans it recorded are kept.
+  thread_local ThreadBuffer* pbuf = nullptr;
+  if ( pbuf == nullptr ) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.push_back(std::make_shared<ThreadBuffer>());
+    m_buffers.back()->thread = m_buffers.size() - 1;
+    pbuf = m_buffers.back().get();
+  }
+  return *pbuf;
+}
+
+//**********************************************************************
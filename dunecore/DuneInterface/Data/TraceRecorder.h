@@ -0,0 +1,200 @@
+// TraceRecorder.h
+//
+// Timeline tracing of the decoder, FFT and tool layers.
+//
+// A TraceSpan records the start and duration of a scope, e.g. the decode of one
+// link or the call of a tool for one APA, with the thread that ran it and up to
+// maxArgs integer annotations such as the APA index and channel range. The spans
+// are written to a Chrome trace JSON file which may be viewed in Perfetto
+// (https://ui.perfetto.dev) or chrome://tracing to see stalls, imbalance between
+// threads and time waiting for locks.
+//
+// There is one process-wide recorder, instance(), disabled by default. It is
+// enabled at startup if the environment variable DUNE_TRACE_FILE is set to
+// the name of the output file, or by calling configure, e.g. with the TraceFile
+// parameter of FDHDDataInterface. The file is written by write() or, if that is
+// not called, when the process exits.
+//
+// When the recorder is disabled, a span costs one relaxed atomic load. Building
+// with DUNECORE_NO_TRACE defined removes the spans altogether.
+//
+// The category, name and argument names are held as pointers and so must be string
+// literals or strings returned by intern(). Spans are held in a buffer for each
+// thread so recording does not lock across threads. At most maxEvents spans are
+// kept; later ones are counted as dropped.
+//
+// Usage:
+//   {
+//     TraceSpan span("decoder", "decodeLink");
+//     span.arg("apa", iapa);
+//     ...
+//     span.arg("channel", icha0).arg("nchan", ncha);
+//   }
+
+#ifndef TraceRecorder_H
+#define TraceRecorder_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+class TraceRecorder {
+
+public:
+
+  using Index = unsigned int;
+  using Count = unsigned long;
+  using Name = std::string;
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr Index maxArgs = 4;
+
+  // One recorded span. Times are nanoseconds since the recorder was created.
+  struct Event {
+    const char* category = "";
+    const char* name = "";
+    long start = 0;
+    long duration = 0;
+    Index nargs = 0;
+    std::array<const char*, maxArgs> argNames;
+    std::array<long, maxArgs> argValues;
+  };
+  using EventVector = std::vector<Event>;
+
+  // The process-wide recorder.
+  static TraceRecorder& instance();
+
+  // Is recording enabled?
+  static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+  // Enable recording to file fname, or disable it if fname is blank.
+  // Recorded spans are kept.
+  void configure(const Name& fname, Count maxEvents =10000000);
+
+  // Output file name.
+  Name fileName() const;
+
+  // Nanoseconds since the recorder was created.
+  long now() const;
+
+  // Record a span on the calling thread.
+  void record(const Event& evt);
+
+  // Return a string with the same content and the lifetime of the process.
+  const char* intern(const Name& str);
+
+  // Number of recorded and dropped spans.
+  Count eventCount() const;
+  Count droppedCount() const { return m_ndrop.load(); }
+
+  // Return the recorded spans for all threads ordered by thread and start time.
+  // Each is paired with the thread index.
+  std::vector<std::pair<Index, Event>> events() const;
+
+  // Write the spans to the configured file or to fname.
+  // Returns 0 for success, 1 if there is no file name, 2 if the file cannot be written.
+  int write();
+  int write(const Name& fname) const;
+
+  // Remove all recorded spans.
+  void clear();
+
+  // Dtor writes the file if it is configured and write has not been called.
+  ~TraceRecorder();
+
+private:
+
+  struct ThreadBuffer {
+    Index thread = 0;
+    mutable std::mutex mutex;
+    EventVector events;
+  };
+  using BufferPtr = std::shared_ptr<ThreadBuffer>;
+
+  TraceRecorder();
+
+  // Return the buffer for the calling thread.
+  ThreadBuffer& threadBuffer();
+
+  static std::atomic<bool> s_enabled;
+
+  Clock::time_point m_start;
+  Name m_fileName;
+  bool m_written = false;
+  std::atomic<Count> m_maxEvents;
+  std::atomic<Count> m_nevt;
+  std::atomic<Count> m_ndrop;
+  std::vector<BufferPtr> m_buffers;
+  std::set<Name> m_strings;
+  mutable std::mutex m_mutex;
+
+};
+
+//**********************************************************************
+
+// Scoped span recorded when it goes out of scope.
+
+#ifdef DUNECORE_NO_TRACE
+
+class TraceSpan {
+public:
+  TraceSpan(const char*, const char*) { }
+  TraceSpan(const TraceSpan&) =delete;
+  TraceSpan& operator=(const TraceSpan&) =delete;
+  TraceSpan& arg(const char*, long) { return *this; }
+  bool active() const { return false; }
+};
+
+#else
+
+class TraceSpan {
+
+public:
+
+  TraceSpan(const char* category, const char* name) : m_active(TraceRecorder::enabled()) {
+    if ( m_active ) {
+      m_evt.category = category;
+      m_evt.name = name;
+      m_evt.start = TraceRecorder::instance().now();
+    }
+  }
+
+  TraceSpan(const TraceSpan&) =delete;
+  TraceSpan& operator=(const TraceSpan&) =delete;
+
+  ~TraceSpan() {
+    if ( m_active ) {
+      TraceRecorder& rec = TraceRecorder::instance();
+      m_evt.duration = rec.now() - m_evt.start;
+      rec.record(m_evt);
+    }
+  }
+
+  // Add an annotation. Those beyond maxArgs are ignored.
+  TraceSpan& arg(const char* argName, long val) {
+    if ( m_active && m_evt.nargs < TraceRecorder::maxArgs ) {
+      m_evt.argNames[m_evt.nargs] = argName;
+      m_evt.argValues[m_evt.nargs] = val;
+      ++m_evt.nargs;
+    }
+    return *this;
+  }
+
+  // Is this span being recorded?
+  bool active() const { return m_active; }
+
+private:
+
+  bool m_active;
+  TraceRecorder::Event m_evt;
+
+};
+
+#endif
+
+#endif
@@ -8,6 +8,14 @@
 // Both are indexed by name.
 //
 // It is used to hold intermediate states in data preparation.
+//
+// The wire containers created here are owned by this object and the wire map
+// holds pointers to them. Containers owned elsewhere may also be added to the map.
+//
+// Wires may be built directly from the channel data with buildWire, which copies the
+// ROI samples into the wire signal once, without intermediate vectors. Reserve space
+// for the wires of the state (e.g. the channel count of the APA) before building so
+// that the pointers held in the channel data stay valid.
 
 #ifndef WiredAdcChannelDataMap_H
 #define WiredAdcChannelDataMap_H
@@ -35,12 +43,33 @@ public:
   WiredAdcChannelDataMap(const NameVector names, AdcChannel nchmax) {
     for ( Name name : names ) {
       dataMaps[name];
-      WireContainer* pwires = new WireContainer;
-      wires[name] = pwires;
-      pwires->reserve(nchmax);
+      reserveWires(name, nchmax);
     }
   }
 
+  // No copy: the wire map points to the containers held here. Move is allowed.
+  WiredAdcChannelDataMap(const WiredAdcChannelDataMap&) =delete;
+  WiredAdcChannelDataMap& operator=(const WiredAdcChannelDataMap&) =delete;
+  WiredAdcChannelDataMap(WiredAdcChannelDataMap&&) =default;
+  WiredAdcChannelDataMap& operator=(WiredAdcChannelDataMap&&) =default;
+
+  // Return the wire container for a state, creating it if there is none,
+  // and reserve space for nwire wires in it.
+  WireContainer& reserveWires(Name sname, AdcChannel nwire) {
+    WireContainer*& pwires = wires[sname];
+    if ( pwires == nullptr ) pwires = &m_wireStore[sname];
+    pwires->reserve(nwire);
+    return *pwires;
+  }
+
+  // Build a wire for channel data acd from the samples in its ROIs and append it to
+  // the wire container for state sname. On success, acd.wire and acd.wireIndex are set.
+  // Returns 0 for success,
+  //   1 - there is no wire container for the state
+  //   2 - an ROI extends beyond the samples
+  //   3 - the container is full: adding would invalidate the pointers to its wires
+  int buildWire(Name sname, AdcChannelData& acd, geo::View_t view);
+
   // Return if this object holds ADC channel data for the given stae name.
   bool hasData(Name sname) {
     return dataMaps.find(sname) != dataMaps.end();
@@ -51,6 +80,34 @@ public:
     return wires.find(sname) != wires.end();
   }
 
+private:
+
+  // Wire containers created by this object.
+  std::map<Name, WireContainer> m_wireStore;
+
 };
 
+//**********************************************************************
+
+inline
+int WiredAdcChannelDataMap::buildWire(Name sname, AdcChannelData& acd, geo::View_t view) {
+  std::map<Name, WireContainer*>::iterator iwir = wires.find(sname);
+  if ( iwir == wires.end() || iwir->second == nullptr ) return 1;
+  WireContainer& wcon = *iwir->second;
+  if ( ! wcon.empty() && wcon.size() == wcon.capacity() ) return 3;
+  const AdcSignal* psam = acd.sampleData();
+  AdcIndex nsam = acd.sampleCount();
+  recob::Wire::RegionsOfInterest_t sigs(nsam);
+  for ( const AdcRoi& roi : acd.rois ) {
+    if ( roi.first > roi.second || roi.second >= nsam ) return 2;
+    sigs.add_range(roi.first, psam + roi.first, psam + roi.second + 1);
+  }
+  wcon.emplace_back(std::move(sigs), acd.channel(), view);
+  acd.wire = &wcon.back();
+  acd.wireIndex = wcon.size() - 1;
+  return 0;
+}
+
+//**********************************************************************
+
 #endif
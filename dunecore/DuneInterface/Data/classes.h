@@ -3,6 +3,7 @@
 #include "dunecore/DuneInterface/Data/DuneEventInfo.h"
 #include "dunecore/DuneInterface/Data/DuneChannelInfo.h"
 #include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include "dunecore/DuneInterface/Data/AdcChannelDataMapPacked.h"
 #include "dunecore/DuneInterface/Data/Real2dData.h"
 #include "dunecore/DuneInterface/Data/FftwReal2dDftData.h"
 #include "dunecore/DuneInterface/Data/Tpc2dRoi.h"
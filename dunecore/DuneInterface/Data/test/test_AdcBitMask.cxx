@@ -0,0 +1,156 @@
+// test_AdcBitMask.cxx
+//
+// Test AdcBitMask.
+
+#include "dunecore/DuneInterface/Data/AdcBitMask.h"
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include "dunecore/DuneInterface/Data/AdcThresholdRoi.h"
+#include <string>
+#include <iostream>
+#include <cmath>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+
+//**********************************************************************
+
+int test_AdcBitMask() {
+  const string myname = "test_AdcBitMask: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Check construction and bit access." << endl;
+  Index nbit = 200;
+  AdcBitMask mask(nbit);
+  assert( mask.size() == nbit );
+  assert( mask.nword() == 4 );
+  assert( mask.none() );
+  assert( mask.count() == 0 );
+  mask.set(3);
+  mask.set(64);
+  mask.set(199);
+  assert( mask.test(3) );
+  assert( mask[64] );
+  assert( ! mask[65] );
+  assert( mask.count() == 3 );
+  mask.reset(64);
+  assert( mask.count() == 2 );
+  AdcBitMask ones(nbit, true);
+  assert( ones.count() == nbit );
+  assert( ones.words()[3] == (AdcBitMask::Word(1) << 8) - 1 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check ranges and search." << endl;
+  mask.setRange(60, 130);
+  assert( mask.count() == 72 );
+  assert( mask.findNext(0, true) == 3 );
+  assert( mask.findNext(4, true) == 60 );
+  assert( mask.findNext(60, false) == 130 );
+  assert( mask.findNext(131, true) == 199 );
+  assert( ones.findNext(0, false) == nbit );
+  mask.setRange(100, 110, false);
+  assert( mask.count() == 62 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check ROI conversion." << endl;
+  AdcRoiVector rois;
+  mask.toRois(rois);
+  assert( rois.size() == 4 );
+  assert( rois[0] == AdcRoi(3, 3) );
+  assert( rois[1] == AdcRoi(60, 99) );
+  assert( rois[2] == AdcRoi(110, 129) );
+  assert( rois[3] == AdcRoi(199, 199) );
+  AdcBitMask mask2(rois, nbit);
+  assert( mask2 == mask );
+  ones.toRois(rois);
+  assert( rois.size() == 1 );
+  assert( rois[0] == AdcRoi(0, nbit - 1) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check vector conversion and agreement with AdcChannelData." << endl;
+  AdcChannelData acd;
+  mask.toVector(acd.signal);
+  assert( acd.signal.size() == nbit );
+  for ( Index ibit=0; ibit<nbit; ++ibit ) assert( acd.signal[ibit] == mask[ibit] );
+  acd.roisFromSignal();
+  mask.toRois(rois);
+  assert( acd.rois == rois );
+  assert( AdcBitMask(acd.signal) == mask );
+
+  cout << myname << line << endl;
+  cout << myname << "Check logical operations." << endl;
+  AdcBitMask mask3(nbit);
+  mask3.setRange(0, 70);
+  AdcBitMask mand = mask;
+  mand &= mask3;
+  assert( mand.count() == 11 );
+  AdcBitMask mor = mask;
+  mor |= mask3;
+  assert( mor.count() == 62 + 70 - 11 );
+  AdcBitMask mxor = mask;
+  mxor ^= mask3;
+  assert( mxor.count() == mor.count() - mand.count() );
+  assert( AdcBitMask::andOf({mask, mask3}) == mand );
+  assert( AdcBitMask::orOf({mask, mask3}) == mor );
+  AdcBitMask minv = mask;
+  minv.flip();
+  assert( minv.count() == nbit - mask.count() );
+  minv.setAll(false);
+  assert( minv.none() );
+  minv.resize(250, true);
+  assert( minv.count() == 50 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check threshold and dilation against a tick loop." << endl;
+  Index nsam = 300;
+  AdcSignalVector sams(nsam, 0.0);
+  for ( Index isam : {0u, 5u, 63u, 64u, 130u, 200u, 299u} ) sams[isam] = 10.0;
+  sams[150] = -12.0;
+  for ( bool useAbs : {false, true} ) {
+    for ( Index npadLow : {0u, 1u, 3u, 70u} ) {
+      for ( Index npadHigh : {0u, 2u, 64u, 100u} ) {
+        AdcBitMask tmask;
+        AdcThresholdRoi::makeMask(sams.data(), nsam, 5.0, npadLow, npadHigh, useAbs, tmask);
+        AdcFilterVector keep(nsam, false);
+        for ( Index isam=0; isam<nsam; ++isam ) {
+          bool over = useAbs ? std::abs(sams[isam]) > 5.0 : sams[isam] > 5.0;
+          if ( ! over ) continue;
+          Index isam1 = isam > npadLow ? isam - npadLow : 0;
+          Index isam2 = isam + npadHigh + 1 < nsam ? isam + npadHigh + 1 : nsam;
+          for ( Index jsam=isam1; jsam<isam2; ++jsam ) keep[jsam] = true;
+        }
+        assert( tmask == AdcBitMask(keep) );
+      }
+    }
+  }
+  AdcChannelData acdt;
+  acdt.samples = sams;
+  assert( AdcThresholdRoi::build(acdt, 5.0, 1, 2) == 22 );
+  assert( acdt.signal.size() == nsam );
+  assert( acdt.rois.size() == 6 );
+  assert( acdt.rois[0] == AdcRoi(0, 2) );
+  assert( acdt.rois[2] == AdcRoi(62, 66) );
+  assert( acdt.rois[5] == AdcRoi(298, 299) );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcBitMask();
+}
+
+//**********************************************************************
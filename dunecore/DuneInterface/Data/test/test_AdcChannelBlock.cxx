@@ -0,0 +1,135 @@
+// test_AdcChannelBlock.cxx
+//
+// Test AdcChannelBlock.
+
+#include "dunecore/DuneInterface/Data/AdcChannelBlock.h"
+#include <string>
+#include <iostream>
+#include <cstdint>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+
+//**********************************************************************
+
+int test_AdcChannelBlock() {
+  const string myname = "test_AdcChannelBlock: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create channel data." << endl;
+  AdcChannelDataMap acds;
+  Index ncha = 5;
+  for ( Index icha=100; icha<100+ncha; ++icha ) {
+    AdcChannelData& acd = acds[icha];
+    acd.setChannelInfo(icha);
+    Index nsam = icha == 102 ? 30 : 40;
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      acd.samples.push_back(icha + 0.01*isam);
+      acd.raw.push_back(isam);
+      acd.flags.push_back(isam%3);
+    }
+    assert( ! acd.hasBlockSamples() );
+    assert( acd.sampleCount() == nsam );
+    assert( acd.sampleData() == acd.samples.data() );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Load block." << endl;
+  AdcChannelBlock blk;
+  assert( blk.nrow() == 0 );
+  assert( blk.load(acds, AdcChannelBlock::Raw) == 0 );
+  assert( blk.nrow() == ncha );
+  assert( blk.ntick() == 40 );
+  assert( blk.stride() == 48 );
+  assert( blk.hasRaw() );
+  assert( ! blk.hasFlags() );
+  assert( blk.flags(0) == nullptr );
+  for ( Index irow=0; irow<ncha; ++irow ) {
+    assert( blk.channel(irow) == 100 + irow );
+    assert( blk.row(100 + irow) == irow );
+    assert( (blk.samples(irow) - blk.sampleData()) % 16 == 0 );
+  }
+  assert( blk.row(99) == AdcChannelBlock::badIndex() );
+  assert( blk.samples(2)[29] == acds[102].samples[29] );
+  assert( blk.samples(2)[30] == 0.0 );
+  assert( blk.raw(4)[7] == 7 );
+
+  cout << myname << line << endl;
+  cout << myname << "Bind and modify the samples." << endl;
+  assert( blk.bind(acds) == 0 );
+  for ( auto& iacd : acds ) {
+    AdcChannelData& acd = iacd.second;
+    assert( acd.hasBlockSamples() );
+    assert( acd.sampleCount() == 40 );
+    assert( acd.sampleData() == blk.samples(blk.row(iacd.first)) );
+    AdcSignal* psam = acd.sampleData();
+    for ( Index isam=0; isam<acd.sampleCount(); ++isam ) psam[isam] *= 2.0;
+  }
+  assert( acds[101].samples[3] == 101.03f );
+  assert( blk.samples(1)[3] == 2.0f*101.03f );
+
+  cout << myname << line << endl;
+  cout << myname << "Store." << endl;
+  acds[200].setChannelInfo(200);
+  assert( blk.store(acds) == 1 );
+  for ( Index icha=100; icha<100+ncha; ++icha ) {
+    const AdcChannelData& acd = acds[icha];
+    assert( ! acd.hasBlockSamples() );
+    assert( acd.samples.size() == 40 );
+    assert( acd.samples[3] == 2.0f*AdcSignal(icha + 0.03) );
+    assert( acd.raw.size() == 40 );
+  }
+  assert( acds[102].samples[35] == 0.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Unbind and clear." << endl;
+  assert( blk.bind(acds) == 1 );
+  AdcChannelBlock::unbind(acds);
+  for ( const auto& iacd : acds ) assert( ! iacd.second.hasBlockSamples() );
+  acds[100].blockSamples = blk.samples(0);
+  acds[100].clear();
+  assert( ! acds[100].hasBlockSamples() );
+  blk.clear();
+  assert( blk.nrow() == 0 );
+  assert( blk.samples(0) == nullptr );
+
+  cout << myname << line << endl;
+  cout << myname << "Load in a given channel order." << endl;
+  AdcChannelDataMap acdsOrd;
+  for ( Index icha=10; icha<16; ++icha ) acdsOrd[icha].samples.assign(8, icha);
+  assert( blk.load(acdsOrd, {14, 11, 99, 14, 12}) == 0 );
+  assert( blk.nrow() == 6 );
+  assert( blk.channel(0) == 14 );
+  assert( blk.channel(1) == 11 );
+  assert( blk.channel(2) == 12 );
+  assert( blk.channel(3) == 10 );
+  assert( blk.channel(4) == 13 );
+  assert( blk.channel(5) == 15 );
+  assert( blk.row(14) == 0 );
+  assert( blk.row(99) == AdcChannelBlock::badIndex() );
+  assert( blk.samples(0)[7] == 14.0 );
+  assert( blk.samples(3)[0] == 10.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcChannelBlock();
+}
+
+//**********************************************************************
@@ -186,6 +186,43 @@ int test_AdcChannelData() {
     assert( acd12.getMetadata("viewIndex12") == ient12 );
   }
 
+  cout << line << endl;
+  cout << myname << "Check ROI sample views." << endl;
+  AdcChannelData acdroi;
+  acdroi.setChannelInfo(12345, 101);
+  acdroi.tick0 = 100;
+  for ( Index isam=0; isam<50; ++isam ) acdroi.samples.push_back(isam);
+  acdroi.rois.emplace_back(5, 9);
+  acdroi.rois.emplace_back(20, 29);
+  acdroi.rois.emplace_back(45, 60);
+  assert( acdroi.addRoiViews() == 3 );
+  const View& roiview = acdroi.view("rois");
+  assert( roiview.size() == 3 );
+  vector<Index> nsamRois = {5, 10, 5};
+  for ( Index iroi=0; iroi<3; ++iroi ) {
+    const AdcChannelData& acdr = roiview[iroi];
+    AdcIndex isam0 = acdroi.rois[iroi].first;
+    assert( acdr.isSampleView() );
+    assert( acdr.viewParent == &acdroi );
+    assert( acdr.channel() == 12345 );
+    assert( acdr.fembID() == 101 );
+    assert( acdr.samples.size() == 0 );
+    assert( acdr.sampleCount() == nsamRois[iroi] );
+    assert( acdr.viewOffset == isam0 );
+    assert( acdr.tick0 == AdcInt(100 + isam0) );
+    assert( acdr.sampleData() == acdroi.samples.data() + isam0 );
+    assert( acdr.sampleData()[1] == isam0 + 1 );
+  }
+  AdcChannelData& acdr1 = acdroi.updateView("rois")[1];
+  acdr1.sampleData()[0] = -1.0;
+  assert( acdroi.samples[20] == -1.0 );
+  acdr1.detachSamples();
+  assert( ! acdr1.isSampleView() );
+  assert( acdr1.samples.size() == 10 );
+  acdr1.sampleData()[0] = -2.0;
+  assert( acdr1.samples[0] == -2.0 );
+  assert( acdroi.samples[20] == -1.0 );
+
   cout << line << endl;
   cout << myname << "All tests passed." << endl;
   return 0;
@@ -0,0 +1,122 @@
+// test_AdcChannelDataFlatMap.cxx
+//
+// Test AdcChannelDataFlatMap.
+
+#include "dunecore/DuneInterface/Data/AdcChannelDataFlatMap.h"
+#include <string>
+#include <iostream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+
+//**********************************************************************
+
+int test_AdcChannelDataFlatMap() {
+  const string myname = "test_AdcChannelDataFlatMap: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Fill in order." << endl;
+  AdcChannelDataFlatMap acds;
+  assert( acds.empty() );
+  assert( acds.find(100) == acds.end() );
+  Index ncha = 20;
+  acds.reserve(ncha);
+  for ( Index icha=100; icha<100+ncha; icha+=2 ) {
+    AdcChannelData& acd = acds[icha];
+    acd.setChannelInfo(icha);
+    acd.samples.resize(10, icha);
+  }
+  assert( acds.size() == ncha/2 );
+  assert( acds.firstIndexChannel() == 100 );
+  assert( acds.index().size() == ncha - 1 );
+  for ( Index icha=90; icha<130; ++icha ) {
+    bool have = icha >= 100 && icha < 100 + ncha && icha%2 == 0;
+    assert( acds.count(icha) == have );
+    if ( have ) {
+      assert( acds.find(icha)->first == icha );
+      assert( acds.at(icha).channel() == icha );
+      assert( acds.at(icha).samples[9] == icha );
+    } else {
+      assert( acds.find(icha) == acds.end() );
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Fill out of order." << endl;
+  assert( acds.insert(99).second );
+  assert( acds.insert(105).second );
+  assert( acds.insert(130).second );
+  assert( ! acds.insert(104).second );
+  assert( acds.size() == ncha/2 + 3 );
+  assert( acds.firstIndexChannel() == 99 );
+  AdcChannel ichaLast = 0;
+  Index ipos = 0;
+  for ( const auto& iacd : acds ) {
+    if ( ipos ) assert( iacd.first > ichaLast );
+    assert( acds.position(iacd.first) == ipos );
+    ichaLast = iacd.first;
+    ++ipos;
+  }
+  assert( acds.at(104).samples.size() == 10 );
+  assert( acds.at(106).samples[0] == 106 );
+
+  cout << myname << line << endl;
+  cout << myname << "Erase." << endl;
+  assert( acds.erase(105) == 1 );
+  assert( acds.erase(105) == 0 );
+  assert( acds.count(105) == 0 );
+  assert( acds.at(106).samples[0] == 106 );
+  assert( acds.position(106) == 4 );
+  bool caught = false;
+  try {
+    acds.at(105);
+  } catch ( const std::out_of_range& ) {
+    caught = true;
+  }
+  assert( caught );
+
+  cout << myname << line << endl;
+  cout << myname << "Move to and from a map." << endl;
+  Index nflat = acds.size();
+  AdcChannelDataMap acdmap;
+  acdmap[5].samples.resize(3);
+  acds.moveTo(acdmap);
+  assert( acds.empty() );
+  assert( acdmap.size() == nflat + 1 );
+  assert( acdmap[110].samples[0] == 110 );
+  AdcChannelDataFlatMap acds2(std::move(acdmap));
+  assert( acdmap.empty() );
+  assert( acds2.size() == nflat + 1 );
+  assert( acds2.firstIndexChannel() == 5 );
+  assert( acds2.at(110).samples[0] == 110 );
+  AdcChannelDataMap acdmap2;
+  acdmap2[110].samples.resize(2);
+  acdmap2[111].samples.resize(2);
+  acds2.moveFrom(acdmap2);
+  assert( acds2.size() == nflat + 2 );
+  assert( acds2.at(110).samples.size() == 2 );
+  assert( acds2.at(111).samples.size() == 2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcChannelDataFlatMap();
+}
+
+//**********************************************************************
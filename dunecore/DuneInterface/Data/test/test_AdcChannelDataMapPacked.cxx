@@ -0,0 +1,168 @@
+// test_AdcChannelDataMapPacked.cxx
+//
+// Test AdcChannelDataMapPacked.
+
+#include "dunecore/DuneInterface/Data/AdcChannelDataMapPacked.h"
+#include <string>
+#include <iostream>
+#include <cmath>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcChannelDataMapPacked::Index;
+using Options = AdcChannelDataMapPacked::Options;
+
+//**********************************************************************
+
+int test_AdcChannelDataMapPacked() {
+  const string myname = "test_AdcChannelDataMapPacked: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Build the data." << endl;
+  AdcChannelDataMap acds;
+  AdcChannelData::EventInfoPtr pevi(new DuneEventInfo(123, 56, 4, 1000, 12, 3));
+  Index ncha = 5;
+  Index nsam = 100;
+  for ( Index icha=100; icha<100+ncha; ++icha ) {
+    AdcChannelData& acd = acds[icha];
+    acd.setEventInfo(pevi);
+    acd.setChannelInfo(icha, 2, icha-100, 0);
+    acd.pedestal = 500.0 + icha;
+    acd.pedestalRms = 2.5;
+    acd.sampleNoise = 1.25;
+    acd.tick0 = 10;
+    acd.channelClock = 123456789012ul;
+    acd.raw.resize(nsam, icha);
+    for ( Index isam=0; isam<nsam; ++isam ) acd.samples.push_back(0.37*isam - 3.1*icha);
+    acd.flags.resize(nsam, 0);
+    acd.flags[3] = 7;
+    acd.signal.resize(nsam, false);
+    for ( Index isam=20; isam<30; ++isam ) acd.signal[isam] = true;
+    acd.rois.push_back(AdcRoi(20, 29));
+    acd.rois.push_back(AdcRoi(95, 120));
+    acd.sampleUnit = icha == 100 ? "ADC count" : "ke";
+    acd.metadata["noise"] = 1.5;
+    if ( icha == 102 ) acd.metadata["gain"] = 0.5;
+  }
+  // A channel with large samples and no event info.
+  AdcChannelData& acdBig = acds[200];
+  acdBig.setChannelInfo(200, 3, 0, 1);
+  acdBig.samples = {1.e6, -2.e6, 0.5, 0.0};
+  acdBig.rois.push_back(AdcRoi(1, 2));
+
+  cout << myname << line << endl;
+  cout << myname << "Check lossless packing." << endl;
+  AdcChannelDataMapPacked pack(acds);
+  assert( pack.size() == ncha + 1 );
+  assert( ! pack.isQuantized() );
+  assert( ! pack.isRoiOnly() );
+  assert( pack.channel(0) == 100 );
+  assert( pack.sampleStep(0) == 0.0 );
+  cout << myname << "Byte count: " << pack.byteCount() << endl;
+  AdcChannelDataMap acdsNew;
+  assert( pack.unpack(acdsNew) == 0 );
+  assert( acdsNew.size() == acds.size() );
+  const DuneEventInfo* pevi0 = nullptr;
+  for ( const AdcChannelDataMap::value_type& iacd : acds ) {
+    const AdcChannelData& acd = iacd.second;
+    const AdcChannelData& acdNew = acdsNew.at(iacd.first);
+    assert( acdNew.channel() == acd.channel() );
+    assert( acdNew.fembID() == acd.fembID() );
+    assert( acdNew.fembChannel() == acd.fembChannel() );
+    assert( acdNew.channelStatus() == acd.channelStatus() );
+    assert( acdNew.hasEventInfo() == acd.hasEventInfo() );
+    if ( acd.hasEventInfo() ) {
+      assert( acdNew.run() == 123 );
+      assert( acdNew.event() == 56 );
+      assert( acdNew.subRun() == 4 );
+      if ( pevi0 == nullptr ) pevi0 = acdNew.getEventInfoPtr().get();
+      assert( acdNew.getEventInfoPtr().get() == pevi0 );
+    }
+    assert( acdNew.pedestal == acd.pedestal );
+    assert( acdNew.pedestalRms == acd.pedestalRms );
+    assert( acdNew.sampleNoise == acd.sampleNoise );
+    assert( acdNew.tick0 == acd.tick0 );
+    assert( acdNew.channelClock == acd.channelClock );
+    assert( acdNew.raw == acd.raw );
+    assert( acdNew.samples == acd.samples );
+    assert( acdNew.flags == acd.flags );
+    assert( acdNew.signal == acd.signal );
+    assert( acdNew.rois == acd.rois );
+    assert( acdNew.sampleUnit == acd.sampleUnit );
+    assert( acdNew.metadata.toMap() == acd.metadata.toMap() );
+  }
+  assert( acdsNew.at(102).metadata.find("gain")->second == 0.5 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check unpacking into a filled map." << endl;
+  assert( pack.unpack(acdsNew) == 2 );
+  assert( acdsNew.size() == acds.size() );
+
+  cout << myname << line << endl;
+  cout << myname << "Check quantized ROI-only packing." << endl;
+  Options opt;
+  opt.sampleQuantum = 0.01;
+  opt.roiOnly = true;
+  opt.keepRaw = false;
+  pack.pack(acds, opt);
+  assert( pack.size() == ncha + 1 );
+  assert( pack.isQuantized() );
+  assert( pack.isRoiOnly() );
+  assert( ! pack.options().keepRaw );
+  assert( pack.options().keepFlags );
+  assert( pack.sampleStep(0) == 0.01f );
+  assert( pack.sampleStep(ncha) > 60.0 );
+  cout << myname << "Byte count: " << pack.byteCount() << endl;
+  acdsNew.clear();
+  assert( pack.unpack(acdsNew) == 0 );
+  Index icha = 0;
+  for ( const AdcChannelDataMap::value_type& iacd : acds ) {
+    const AdcChannelData& acd = iacd.second;
+    const AdcChannelData& acdNew = acdsNew.at(iacd.first);
+    float tol = 0.5*pack.sampleStep(icha)*(1.0 + 1.e-5);
+    assert( acdNew.raw.empty() );
+    assert( acdNew.flags == acd.flags );
+    assert( acdNew.rois == acd.rois );
+    assert( acdNew.samples.size() == acd.samples.size() );
+    AdcFilterVector inRoi(acd.samples.size(), false);
+    for ( const AdcRoi& roi : acd.rois ) {
+      for ( Index isam=roi.first; isam<=roi.second && isam<inRoi.size(); ++isam ) inRoi[isam] = true;
+    }
+    for ( Index isam=0; isam<acd.samples.size(); ++isam ) {
+      if ( inRoi[isam] ) assert( std::fabs(acdNew.samples[isam] - acd.samples[isam]) <= tol );
+      else assert( acdNew.samples[isam] == 0.0 );
+    }
+    ++icha;
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check clear." << endl;
+  pack.clear();
+  assert( pack.empty() );
+  assert( ! pack.isQuantized() );
+  acdsNew.clear();
+  assert( pack.unpack(acdsNew) == 0 );
+  assert( acdsNew.empty() );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcChannelDataMapPacked();
+}
+
+//**********************************************************************
@@ -0,0 +1,141 @@
+// test_AdcChannelDataPipeline.cxx
+//
+// Test AdcChannelDataPipeline.
+
+#include "dunecore/DuneInterface/Data/AdcChannelDataPipeline.h"
+#include <string>
+#include <iostream>
+#include <atomic>
+#include <stdexcept>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+
+//**********************************************************************
+
+int test_AdcChannelDataPipeline() {
+  const string myname = "test_AdcChannelDataPipeline: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Process batches." << endl;
+  Index nbat = 20;
+  Index nchaPerBatch = 8;
+  std::atomic<Index> maxSeen(0);
+  std::atomic<Index> nsunk(0);
+  Index sumSamples = 0;
+  AdcChannelDataPipeline* ppipe = nullptr;
+  auto stage = [&](AdcChannelDataMap& acds) {
+    Index nfly = ppipe->inFlight();
+    if ( nfly > maxSeen ) maxSeen = nfly;
+    for ( auto& iacd : acds ) {
+      AdcChannelData& acd = iacd.second;
+      acd.samples.resize(acd.raw.size());
+      for ( Index isam=0; isam<acd.raw.size(); ++isam ) acd.samples[isam] = acd.raw[isam] - 100.0;
+    }
+    return 0;
+  };
+  auto sink = [&](AdcChannelDataMap& acds) {
+    for ( const auto& iacd : acds ) {
+      for ( AdcSignal sam : iacd.second.samples ) sumSamples += sam;
+    }
+    ++nsunk;
+    return 0;
+  };
+  AdcChannelDataPipeline pipe(stage, sink, 3);
+  ppipe = &pipe;
+  assert( pipe.maxInFlight() == 3 );
+  for ( Index ibat=0; ibat<nbat; ++ibat ) {
+    AdcChannelDataMap acds;
+    for ( Index icha=0; icha<nchaPerBatch; ++icha ) {
+      AdcChannelData& acd = acds[ibat*nchaPerBatch + icha];
+      acd.raw.assign(10, 101);
+    }
+    pipe.push(std::move(acds));
+    assert( pipe.inFlight() <= 3 );
+  }
+  assert( pipe.finish() == 0 );
+  assert( pipe.inFlight() == 0 );
+  assert( pipe.processedCount() == nbat );
+  assert( nsunk == nbat );
+  assert( maxSeen <= 3 );
+  assert( sumSamples == nbat*nchaPerBatch*10 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check failure status and reuse." << endl;
+  nsunk = 0;
+  AdcChannelDataPipeline pipe2([](AdcChannelDataMap& acds) { return acds.count(5) ? 5 : 0; }, sink);
+  for ( Index ibat=0; ibat<4; ++ibat ) {
+    AdcChannelDataMap acds;
+    acds[ibat + 3];
+    pipe2.push(std::move(acds));
+  }
+  assert( pipe2.finish() == 5 );
+  assert( nsunk == 3 );
+  assert( pipe2.finish() == 0 );
+  AdcChannelDataMap acds;
+  acds[1];
+  pipe2.push(std::move(acds));
+  assert( pipe2.finish() == 0 );
+  assert( pipe2.processedCount() == 5 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check an exception from the stage." << endl;
+  nsunk = 0;
+  auto throwStage = [](AdcChannelDataMap& acds) {
+    if ( acds.count(2) ) throw std::runtime_error("stage failed for channel 2");
+    if ( acds.count(4) ) throw std::logic_error("stage failed for channel 4");
+    return 0;
+  };
+  AdcChannelDataPipeline pipe3(throwStage, sink, 1);
+  for ( Index ibat=0; ibat<6; ++ibat ) {
+    AdcChannelDataMap acdsThrow;
+    acdsThrow[ibat];
+    pipe3.push(std::move(acdsThrow));
+  }
+  bool caught = false;
+  try {
+    pipe3.finish();
+  } catch ( const std::runtime_error& exc ) {
+    caught = true;
+    assert( string(exc.what()) == "stage failed for channel 2" );
+  }
+  assert( caught );
+  assert( pipe3.processedCount() == 6 );
+  assert( nsunk == 4 );
+  assert( pipe3.finish() == 0 );
+  AdcChannelDataMap acdsAfter;
+  acdsAfter[1];
+  pipe3.push(std::move(acdsAfter));
+  assert( pipe3.finish() == 0 );
+  assert( nsunk == 5 );
+  {
+    // The destructor drops an exception that was not collected by finish.
+    AdcChannelDataPipeline pipe4(throwStage, sink);
+    AdcChannelDataMap acdsDrop;
+    acdsDrop[2];
+    pipe4.push(std::move(acdsDrop));
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcChannelDataPipeline();
+}
+
+//**********************************************************************
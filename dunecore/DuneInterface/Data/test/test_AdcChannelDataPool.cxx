@@ -0,0 +1,157 @@
+// test_AdcChannelDataPool.cxx
+//
+// Test AdcChannelDataPool.
+
+#include "dunecore/DuneInterface/Data/AdcChannelDataPool.h"
+#include <string>
+#include <iostream>
+#include <thread>
+#include <algorithm>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+using PoolPtr = AdcChannelDataPool::PoolPtr;
+using AdcDataPtr = AdcChannelDataPool::AdcDataPtr;
+
+//**********************************************************************
+
+int test_AdcChannelDataPool() {
+  const string myname = "test_AdcChannelDataPool: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Fetch the thread pool." << endl;
+  PoolPtr ppool = AdcChannelDataPool::threadPool();
+  assert( ppool );
+  assert( AdcChannelDataPool::threadPool() == ppool );
+  assert( ppool->size() == 0 );
+  assert( ppool->capacity() == AdcChannelDataPool::defaultCapacity() );
+
+  cout << myname << line << endl;
+  cout << myname << "Fill an event." << endl;
+  Index ncha = 10;
+  Index nsam = 1000;
+  std::vector<const AdcSignal*> psams;
+  {
+    AdcDataPtr pacds = AdcChannelDataPool::makeMap();
+    for ( Index icha=0; icha<ncha; ++icha ) {
+      AdcChannelData& acd = ppool->insert(*pacds, icha);
+      assert( &ppool->insert(*pacds, icha) == &acd );
+      acd.setChannelInfo(icha);
+      acd.samples.resize(nsam, 1.0);
+      acd.raw.resize(nsam, 2);
+      acd.metadata["nroi"] = 3;
+      acd.updateView("rois").resize(2);
+      psams.push_back(acd.samples.data());
+    }
+    assert( pacds->size() == ncha );
+    assert( ppool->newCount() == ncha );
+    assert( ppool->reuseCount() == 0 );
+  }
+  assert( ppool->size() == ncha );
+
+  cout << myname << line << endl;
+  cout << myname << "Refill with recycled data." << endl;
+  {
+    AdcDataPtr pacds = AdcChannelDataPool::makeMap();
+    for ( Index icha=100; icha<100+ncha; ++icha ) {
+      AdcChannelData& acd = ppool->insert(*pacds, icha);
+      assert( acd.samples.size() == 0 );
+      assert( acd.samples.capacity() >= nsam );
+      assert( acd.raw.size() == 0 );
+      assert( acd.raw.capacity() >= nsam );
+      assert( acd.metadata.size() == 0 );
+      assert( acd.viewSize() == 0 );
+      assert( ! acd.hasChannelInfo() );
+      acd.samples.resize(nsam);
+      assert( std::find(psams.begin(), psams.end(), acd.samples.data()) != psams.end() );
+    }
+    assert( pacds->size() == ncha );
+    assert( pacds->begin()->first == 100 );
+    assert( ppool->size() == 0 );
+    assert( ppool->reuseCount() == ncha );
+  }
+  assert( ppool->size() == ncha );
+
+  cout << myname << line << endl;
+  cout << myname << "Check capacity." << endl;
+  ppool->setCapacity(4);
+  assert( ppool->size() == 4 );
+  {
+    AdcDataPtr pacds = AdcChannelDataPool::makeMap();
+    for ( Index icha=0; icha<ncha; ++icha ) ppool->insert(*pacds, icha);
+  }
+  assert( ppool->size() == 4 );
+  ppool->clear();
+  assert( ppool->size() == 0 );
+  ppool->setCapacity(AdcChannelDataPool::defaultCapacity());
+
+  cout << myname << line << endl;
+  cout << myname << "Release from another thread." << endl;
+  {
+    AdcDataPtr pacds = AdcChannelDataPool::makeMap();
+    for ( Index icha=0; icha<ncha; ++icha ) ppool->insert(*pacds, icha).samples.resize(nsam);
+    std::thread thr([&pacds]() { pacds.reset(); });
+    thr.join();
+  }
+  assert( ppool->size() == ncha );
+
+  cout << myname << line << endl;
+  cout << myname << "Delete a map after its thread exits." << endl;
+  AdcDataPtr pacdsOut;
+  std::thread thr([&pacdsOut]() {
+    pacdsOut = AdcChannelDataPool::makeMap();
+    AdcChannelDataPool::threadPool()->insert(*pacdsOut, 1);
+  });
+  thr.join();
+  assert( pacdsOut->size() == 1 );
+  pacdsOut.reset();
+  assert( ppool->size() == ncha );
+
+  cout << myname << line << endl;
+  cout << myname << "Check budget." << endl;
+  {
+    MemoryBudget bud;
+    AdcChannelDataPool pool(AdcChannelDataPool::defaultCapacity(), &bud);
+    assert( pool.budget() == &bud );
+    AdcChannelDataMap acds;
+    for ( Index icha=0; icha<ncha; ++icha ) pool.insert(acds, icha).raw.resize(nsam);
+    std::size_t nbyteCha = AdcChannelDataPool::bufferBytes(acds.begin()->second);
+    assert( nbyteCha >= nsam*sizeof(AdcCount) );
+    assert( pool.release(acds) == ncha );
+    assert( pool.bytes() == ncha*nbyteCha );
+    assert( bud.used() == pool.bytes() );
+    for ( Index icha=0; icha<ncha; ++icha ) pool.insert(acds, icha);
+    assert( pool.size() == 0 );
+    assert( bud.used() == 0 );
+    bud.setLimit(4*nbyteCha);
+    assert( pool.release(acds) == 4 );
+    assert( pool.budgetDropCount() == ncha - 4 );
+    assert( bud.used() == 4*nbyteCha );
+    pool.clear();
+    assert( pool.bytes() == 0 );
+    assert( bud.used() == 0 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcChannelDataPool();
+}
+
+//**********************************************************************
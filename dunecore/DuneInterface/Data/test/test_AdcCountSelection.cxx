@@ -0,0 +1,77 @@
+// test_AdcCountSelection.cxx
+//
+// Test AdcCountSelection and AdcCountSelectionView.
+
+#include "dunecore/DuneInterface/Data/AdcCountSelection.h"
+#include <string>
+#include <iostream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+
+//**********************************************************************
+
+int test_AdcCountSelection() {
+  const string myname = "test_AdcCountSelection: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create counts." << endl;
+  Index ncnt = 150;
+  AdcCountVector cnts(ncnt);
+  for ( Index icnt=0; icnt<ncnt; ++icnt ) cnts[icnt] = 1000 + icnt;
+
+  cout << myname << line << endl;
+  cout << myname << "Check the owning selection." << endl;
+  AdcCountSelection acs(cnts, 123, 1000.5);
+  assert( &acs.counts == &cnts );
+  assert( acs.channel == 123 );
+  assert( acs.filter.size() == ncnt );
+  assert( acs.filter[ncnt-1] );
+
+  cout << myname << line << endl;
+  cout << myname << "Check the view." << endl;
+  AdcCountSelectionView acv(cnts, 123, 1000.5);
+  assert( acv.counts == cnts.data() );
+  assert( acv.size() == ncnt );
+  assert( acv.channel == 123 );
+  assert( acv.pedestal == 1000.5 );
+  assert( acv.keep.size() == ncnt );
+  assert( acv.keep.count() == ncnt );
+  assert( acv[10] == cnts[10] );
+  assert( acv.end() - acv.begin() == long(ncnt) );
+  cnts[10] = 5;
+  assert( acv[10] == 5 );
+  acv.keep.setRange(20, 30, false);
+  assert( acv.keep.count() == ncnt - 10 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check a view of part of the counts." << endl;
+  AdcCountSelectionViewVector acvs;
+  acvs.emplace_back(cnts.data() + 50, 60, 124, 999.0);
+  assert( acvs[0][0] == cnts[50] );
+  assert( acvs[0].keep.size() == 60 );
+  assert( acvs[0].keep.nword() == 1 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcCountSelection();
+}
+
+//**********************************************************************
@@ -0,0 +1,131 @@
+// test_AdcMetadata.cxx
+//
+// Test AdcMetadata.
+
+#include "dunecore/DuneInterface/Data/AdcMetadata.h"
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include <string>
+#include <iostream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Key = AdcMetadata::Key;
+using Index = unsigned int;
+
+//**********************************************************************
+
+int test_AdcMetadata() {
+  const string myname = "test_AdcMetadata: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Check key registry." << endl;
+  Key nkey0 = AdcMetadata::keyCount();
+  assert( AdcMetadata::findKey("test_zeta") == AdcMetadata::badKey() );
+  Key kzeta = AdcMetadata::key("test_zeta");
+  Key kalpha = AdcMetadata::key("test_alpha");
+  assert( kzeta != AdcMetadata::badKey() );
+  assert( kalpha != kzeta );
+  assert( AdcMetadata::key("test_zeta") == kzeta );
+  assert( AdcMetadata::findKey("test_alpha") == kalpha );
+  assert( AdcMetadata::name(kzeta) == "test_zeta" );
+  assert( AdcMetadata::name(AdcMetadata::badKey()) == "" );
+  assert( AdcMetadata::keyCount() == nkey0 + 2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check key access." << endl;
+  AdcMetadata mtd;
+  assert( mtd.empty() );
+  mtd.set(kzeta, 2.5);
+  mtd.set(kalpha, 1.5);
+  assert( mtd.size() == 2 );
+  assert( mtd.has(kzeta) );
+  assert( mtd.get(kzeta) == 2.5 );
+  assert( mtd.get(AdcMetadata::badKey(), -1.0) == -1.0 );
+  assert( mtd.keys()[0] < mtd.keys()[1] );
+  assert( mtd.names()[mtd.keys()[0] == kzeta ? 0 : 1] == "test_zeta" );
+
+  cout << myname << line << endl;
+  cout << myname << "Check map-like access." << endl;
+  mtd["test_beta"] = 3.0;
+  mtd["test_beta"] += 1.0;
+  assert( mtd.size() == 3 );
+  assert( mtd.count("test_beta") == 1 );
+  assert( mtd.count("test_gamma") == 0 );
+  assert( mtd.find("test_gamma") == mtd.end() );
+  AdcMetadata::iterator iben = mtd.find("test_beta");
+  assert( iben != mtd.end() );
+  assert( iben->first == "test_beta" );
+  assert( iben->second == 4.0 );
+  (*iben).second = 5.0;
+  assert( mtd.get(AdcMetadata::findKey("test_beta")) == 5.0 );
+  float sum = 0.0;
+  Index nent = 0;
+  for ( const auto& ent : mtd ) {
+    sum += ent.second;
+    assert( ent.first.substr(0, 5) == "test_" );
+    ++nent;
+  }
+  assert( nent == 3 );
+  assert( sum == 9.0 );
+  AdcMetadata::FloatMap fmap = mtd.toMap();
+  assert( fmap.size() == 3 );
+  assert( fmap["test_alpha"] == 1.5 );
+  assert( mtd.erase("test_alpha") == 1 );
+  assert( mtd.erase("test_alpha") == 0 );
+  assert( mtd.size() == 2 );
+  mtd.clear();
+  assert( mtd.empty() );
+
+  cout << myname << line << endl;
+  cout << myname << "Check restoring the keys." << endl;
+  // Emulate a store read from a file written by a process with other keys.
+  AdcMetadata mtdSrc;
+  mtdSrc["test_read2"] = 2.0;
+  mtdSrc["test_read1"] = 1.0;
+  mtdSrc["test_alpha"] = 0.5;
+  AdcMetadata mtdRead = mtdSrc;
+  mtdRead.restoreKeys();
+  assert( mtdRead.size() == 3 );
+  assert( mtdRead.toMap() == mtdSrc.toMap() );
+  assert( mtdRead.get(kalpha) == 0.5 );
+  assert( mtdRead.get(AdcMetadata::findKey("test_read1")) == 1.0 );
+  for ( Index ient=1; ient<mtdRead.size(); ++ient ) assert( mtdRead.keys()[ient-1] < mtdRead.keys()[ient] );
+
+  cout << myname << line << endl;
+  cout << myname << "Check AdcChannelData accessors." << endl;
+  AdcChannelData acd;
+  acd.setMetadata("test_alpha", 11.0);
+  acd.setMetadata(kzeta, 12.0);
+  assert( acd.hasMetadata("test_alpha") );
+  assert( acd.hasMetadata(kzeta) );
+  assert( acd.getMetadata("test_zeta") == 12.0 );
+  assert( acd.getMetadata(kalpha) == 11.0 );
+  assert( acd.getMetadata("test_none", -2.0) == -2.0 );
+  assert( acd.getAttribute("test_alpha") == 11.0 );
+  assert( acd.hasAttribute("test_zeta") );
+  assert( acd.getAttribute("metadata") == 2 );
+  acd.clear();
+  assert( acd.metadata.empty() );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcMetadata();
+}
+
+//**********************************************************************
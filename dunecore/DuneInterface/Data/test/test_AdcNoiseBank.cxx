@@ -0,0 +1,74 @@
+// test_AdcNoiseBank.cxx
+//
+// Test AdcNoiseBank.
+
+#include "dunecore/DuneInterface/Data/AdcNoiseBank.h"
+#include <string>
+#include <iostream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+
+//**********************************************************************
+
+int test_AdcNoiseBank() {
+  const string myname = "test_AdcNoiseBank: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create and fill pools." << endl;
+  AdcNoiseBank bank(2);
+  assert( bank.npool() == 2 );
+  assert( ! bank.hasPool(0) );
+  assert( bank.poolSize(5) == 0 );
+  Index nsam = 100;
+  AdcSignal* pdat = bank.resetPool(0, nsam);
+  assert( pdat != nullptr );
+  for ( Index isam=0; isam<nsam; ++isam ) pdat[isam] = isam;
+  assert( bank.poolSize(0) == nsam );
+  assert( bank.setPool(1, {1.0, 2.0, 3.0}) == 0 );
+  assert( bank.setPool(2, {1.0}) != 0 );
+  assert( bank.resetPool(2, 10) == nullptr );
+  assert( bank.poolData(1)[2] == 3.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Add noise." << endl;
+  AdcSignalVector sigs(250, 1000.0);
+  assert( bank.addNoise(0, 30, sigs) == 0 );
+  for ( Index isig=0; isig<sigs.size(); ++isig ) {
+    AdcSignal noi = (30 + isig)%nsam;
+    assert( sigs[isig] == 1000.0 + noi );
+  }
+  assert( bank.addNoise(0, 30 + 5*nsam, sigs, true) == 0 );
+  for ( AdcSignal sig : sigs ) assert( sig == 1000.0 );
+  AdcSignalVector sigs1(4, 0.0);
+  assert( bank.addNoise(1, 2, sigs1) == 0 );
+  assert( sigs1[0] == 3.0 );
+  assert( sigs1[1] == 1.0 );
+  assert( sigs1[3] == 3.0 );
+  assert( bank.addNoise(2, 0, sigs1) != 0 );
+  AdcNoiseBank empty(1);
+  assert( empty.addNoise(0, 0, sigs1) != 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcNoiseBank();
+}
+
+//**********************************************************************
@@ -0,0 +1,115 @@
+// test_AdcRawConversion.cxx
+//
+// Test AdcRawConversion.
+
+#include "dunecore/DuneInterface/Data/AdcRawConversion.h"
+#include <string>
+#include <iostream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+
+//**********************************************************************
+
+int test_AdcRawConversion() {
+  const string myname = "test_AdcRawConversion: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Convert arrays." << endl;
+  Index nsam = 37;
+  AdcCountVector raw(nsam);
+  AdcFlagVector flags(nsam, AdcGood);
+  for ( Index isam=0; isam<nsam; ++isam ) raw[isam] = 1000 + isam;
+  flags[5] = AdcStuckOff;
+  flags[30] = AdcOverflow;
+  AdcSignalVector sams(nsam, -1.0);
+  AdcRawConversion::convert(raw.data(), sams.data(), nsam, 1000.0, 2.0);
+  for ( Index isam=0; isam<nsam; ++isam ) assert( sams[isam] == 2.0*isam );
+  AdcRawConversion::convert(raw.data(), flags.data(), sams.data(), nsam, 1010.0, 1.0, -99.0);
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    AdcSignal exp = flags[isam] == AdcGood ? AdcSignal(isam) - 10.0 : -99.0;
+    assert( sams[isam] == exp );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Convert a channel." << endl;
+  AdcChannelData acd;
+  acd.setChannelInfo(100);
+  assert( AdcRawConversion::convert(acd) == 1 );
+  acd.raw = raw;
+  acd.flags.assign(flags.begin(), flags.begin() + 20);
+  acd.pedestal = 1001.0;
+  assert( AdcRawConversion::convert(acd, 0.5, true, 0.0) == 0 );
+  assert( acd.samples.size() == nsam );
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    AdcSignal exp = isam == 5 ? 0.0 : 0.5*(AdcSignal(isam) - 1.0);
+    assert( acd.samples[isam] == exp );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Convert a block." << endl;
+  AdcChannelDataMap acds;
+  Index ncha = 4;
+  AdcRawConversion::SignalVector peds;
+  AdcRawConversion::SignalVector gains;
+  for ( Index icha=200; icha<200+ncha; ++icha ) {
+    AdcChannelData& acdb = acds[icha];
+    acdb.setChannelInfo(icha);
+    acdb.raw = raw;
+    acdb.flags = flags;
+    acdb.pedestal = 1000.0 + icha - 200;
+    peds.push_back(acdb.pedestal);
+    gains.push_back(icha - 199);
+  }
+  AdcChannelBlock blk;
+  assert( AdcRawConversion::convert(blk, peds) == 1 );
+  blk.load(acds, AdcChannelBlock::Raw | AdcChannelBlock::Flags);
+  assert( blk.ntick() == nsam );
+  assert( AdcRawConversion::convert(blk, AdcRawConversion::SignalVector(2)) == 2 );
+  assert( AdcRawConversion::convert(blk, peds, AdcRawConversion::SignalVector(2)) == 2 );
+  assert( AdcRawConversion::convert(blk, peds, gains, true) == 0 );
+  for ( Index irow=0; irow<ncha; ++irow ) {
+    const AdcSignal* psam = blk.samples(irow);
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      AdcSignal exp = flags[isam] == AdcGood ? gains[irow]*(AdcSignal(isam) - irow) : 0.0;
+      assert( psam[isam] == exp );
+    }
+    for ( Index isam=nsam; isam<blk.stride(); ++isam ) assert( psam[isam] == 0.0 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Convert bound channels." << endl;
+  assert( blk.bind(acds) == 0 );
+  for ( auto& iacd : acds ) {
+    assert( AdcRawConversion::convert(iacd.second) == 0 );
+    assert( iacd.second.samples.size() == 0 );
+    assert( iacd.second.sampleData()[3] == 3.0 - (iacd.first - 200) );
+  }
+  acds[200].raw.push_back(0);
+  assert( AdcRawConversion::convert(acds[200]) == 2 );
+  blk.store(acds);
+  assert( acds[201].samples.size() == nsam );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcRawConversion();
+}
+
+//**********************************************************************
@@ -0,0 +1,76 @@
+// test_AdcSignalRun.cxx
+//
+// Test AdcSignalRun.
+
+#include "dunecore/DuneInterface/Data/AdcSignalRun.h"
+#include <string>
+#include <iostream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = AdcIndex;
+
+//**********************************************************************
+
+int test_AdcSignalRun() {
+  const string myname = "test_AdcSignalRun: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Convert from dense." << endl;
+  AdcSignalVector sigs(100, 0.0);
+  sigs[3] = 1.0;
+  sigs[4] = 2.0;
+  sigs[50] = -1.5;
+  sigs[99] = 4.0;
+  AdcSignalRunVector runs;
+  fromDense(sigs, runs);
+  assert( runs.size() == 3 );
+  assert( runs[0].begin == 3 );
+  assert( runs[0].end() == 5 );
+  assert( runs[0].values[1] == 2.0 );
+  assert( runs[1].begin == 50 );
+  assert( runs[2].end() == 100 );
+  assert( sparseSampleCount(runs) == 4 );
+  fromDense(AdcSignalVector(10, 0.0), runs);
+  assert( runs.empty() );
+
+  cout << myname << line << endl;
+  cout << myname << "Convert to dense." << endl;
+  fromDense(sigs, runs);
+  AdcSignalVector out(100, 1.0);
+  addToDense(runs, out);
+  for ( Index isig=0; isig<out.size(); ++isig ) assert( out[isig] == 1.0 + sigs[isig] );
+  AdcSignalVector shrt(60, 0.0);
+  addToDense(runs, shrt);
+  assert( shrt.size() == 60 );
+  assert( shrt[50] == -1.5 );
+  AdcSignalVector empty;
+  addToDense(runs, empty, true);
+  assert( empty == sigs );
+  runs.clear();
+  runs.emplace_back(58, AdcSignalVector(5, 1.0));
+  addToDense(runs, shrt);
+  assert( shrt[59] == 1.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcSignalRun();
+}
+
+//**********************************************************************
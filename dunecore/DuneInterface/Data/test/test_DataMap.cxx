@@ -189,6 +189,81 @@ int test_DataMap(bool useExistingFcl =false) {
   assert( res.getHistVector("myhstvec2") == hsts2 );
   res2.print();
 
+  cout << myname << line << endl;
+  cout << myname << "Extend with status-only and moved data maps." << endl;
+  assert( ! DataMap(3).hasResults() );
+  assert( res.hasResults() );
+  DataMap res3;
+  res3 += DataMap(2);
+  assert( res3 == 2 );
+  assert( ! res3.hasResults() );
+  res3 += std::move(res2);
+  assert( res3 == 2 );
+  assert( res3.getInt("myint2") == 578 );
+  assert( res3.getHistVector("myhstvec2") == hsts2 );
+  DataMap res4;
+  res4.setInt("myint", 1);
+  res4.setIntVector("myintvec", {1, 2, 3});
+  res3 += std::move(res4);
+  assert( res3.getInt("myint") == 1 );
+  assert( res3.getInt("myint2") == 578 );
+  assert( res3.getIntVector("myintvec").size() == 3 );
+  DataMap res5(std::move(res3));
+  assert( res5 == 2 );
+  assert( res5.getIntMap().size() == 2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Add deferred histograms." << endl;
+  {
+    DataMap resd;
+    int ncall = 0;
+    resd.setDeferredHist("hdef", [&ncall]() -> TH1* {
+      ++ncall;
+      TH1* ph = new TH1F("hdef", "Deferred", 10, 0, 10);
+      ph->SetBinContent(3, 5.0);
+      return ph;
+    });
+    resd.setDeferredHist("hbin", "Binned", 4, 0.0, 4.0, {1.0, 2.0, 3.0});
+    assert( resd.hasResults() );
+    assert( resd.haveHist("hdef") );
+    assert( resd.haveHist("hbin") );
+    assert( resd.isHistDeferred("hdef") );
+    assert( resd.getHistMap().size() == 0 );
+    assert( resd.getDeferredHistMap().size() == 2 );
+    resd.print();
+    DataMap resc;
+    resc += resd;
+    assert( ncall == 0 );
+    TH1* phd = resd.getHist("hdef");
+    assert( phd != nullptr );
+    assert( ncall == 1 );
+    assert( phd->GetBinContent(3) == 5.0 );
+    assert( ! resd.isHistDeferred("hdef") );
+    assert( resd.getHist("hdef") == phd );
+    assert( resc.getHist("hdef") == phd );
+    assert( ncall == 1 );
+    assert( resd.isHistDeferred("hbin") );
+    TH1* phb = resd.getHist("hbin");
+    assert( phb->GetNbinsX() == 4 );
+    assert( phb->GetBinContent(2) == 2.0 );
+    assert( phb->GetBinContent(4) == 0.0 );
+    assert( resd.getHists().size() == 2 );
+    // An eager histogram replaces a deferred one with the same name and vice versa.
+    resd.setHist("hdef", ph);
+    assert( resd.getHist("hdef") == ph );
+    assert( resd.getDeferredHistMap().size() == 1 );
+    resc.setHist("hbin", ph);
+    resc += std::move(resd);
+    assert( resc.getHist("hbin") == phb );
+    assert( resc.getHist("hdef") == ph );
+    assert( resc.getHistMap().size() == 1 );
+    // A deferred histogram that is not created returns the default.
+    DataMap resn;
+    resn.setDeferredHist("hnull", []() -> TH1* { return nullptr; });
+    assert( resn.getHist("hnull") == nullptr );
+    assert( resn.getHist("hnull", ph) == ph );
+  }
+
   cout << myname << line << endl;
   cout << myname << "Done." << endl;
   return 0;
@@ -0,0 +1,91 @@
+// test_DuneChannelInfoTable.cxx
+//
+// Test DuneChannelInfoTable and the sharing of event and channel info in AdcChannelData.
+
+#include "dunecore/DuneInterface/Data/DuneChannelInfoTable.h"
+#include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include <string>
+#include <iostream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = DuneChannelInfoTable::Index;
+using ChannelInfoPtr = DuneChannelInfoTable::ChannelInfoPtr;
+
+//**********************************************************************
+
+int test_DuneChannelInfoTable() {
+  const string myname = "test_DuneChannelInfoTable: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Fill table." << endl;
+  DuneChannelInfoTable tab(123);
+  assert( tab.run() == 123 );
+  assert( tab.size() == 0 );
+  assert( ! tab.has(5) );
+  assert( ! tab.get(5) );
+  assert( tab.set(DuneChannelInfo()) != 0 );
+  for ( Index icha=0; icha<3000; icha+=10 ) {
+    assert( tab.set(DuneChannelInfo(icha, icha/128, icha%128, 0)) == 0 );
+  }
+  assert( tab.size() == 300 );
+  assert( tab.has(2990) );
+  assert( ! tab.has(2991) );
+  assert( ! tab.has(DuneChannelInfo::badChannel()) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check entries." << endl;
+  ChannelInfoPtr pchi = tab.get(1250);
+  assert( pchi );
+  assert( pchi->channel == 1250 );
+  assert( pchi->fembID == 1250/128 );
+  assert( tab.get(1250).get() == pchi.get() );
+  assert( tab.set(DuneChannelInfo(1250, 7, 8, 1)) == 0 );
+  assert( tab.size() == 300 );
+  assert( pchi->channelStatus == 1 );
+
+  cout << myname << line << endl;
+  cout << myname << "Share info between channels." << endl;
+  AdcChannelDataMap acds;
+  for ( Index icha=1240; icha<1260; ++icha ) acds[icha].setChannelInfo(tab, icha);
+  assert( acds[1250].getChannelInfoPtr().get() == pchi.get() );
+  assert( acds[1250].channelStatus() == 1 );
+  assert( acds[1251].channel() == 1251 );
+  assert( acds[1251].fembID() == DuneChannelInfo::badIndex() );
+  AdcChannelData::EventInfoPtr pevi = std::make_shared<const DuneEventInfo>(123, 45);
+  setEventInfo(acds, pevi);
+  for ( const auto& iacd : acds ) {
+    assert( iacd.second.getEventInfoPtr().get() == pevi.get() );
+    assert( iacd.second.run() == 123 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Entries outlive the table." << endl;
+  tab.reset(124);
+  assert( tab.size() == 0 );
+  assert( ! tab.has(1250) );
+  assert( pchi->channel == 1250 );
+  assert( acds[1240].channel() == 1240 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_DuneChannelInfoTable();
+}
+
+//**********************************************************************
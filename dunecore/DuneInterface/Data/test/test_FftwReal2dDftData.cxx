@@ -123,6 +123,29 @@ int test_FftwReal2dDftData(Index nsam0, Index nsam1) {
          << endl;
   }
 
+  cout << line << endl;
+  cout << myname << "Check the complex view." << endl;
+  {
+    const DftData& cdft = dft;
+    DftData::ConstComplexView<true> vw = cdft.complexView<true>();
+    assert( vw.data() == dft.data() );
+    assert( vw.extent(0) == nsam0 );
+    assert( vw.extent(1) == nsam1/2 + 1 );
+    assert( vw.size() == ndftComplex );
+    for ( Index ifrq0=0; ifrq0<vw.extent(0); ++ifrq0 ) {
+      const Complex* prow = vw.row(ifrq0);
+      for ( Index ifrq1=0; ifrq1<vw.extent(1); ++ifrq1 ) {
+        Index idat = dft.globalIndex({ifrq0, ifrq1});
+        assert( vw.offset(ifrq0, ifrq1) == idat );
+        assert( &vw(ifrq0, ifrq1) == prow + ifrq1 );
+        assert( vw(ifrq0, ifrq1) == dft.value(idat) );
+      }
+    }
+    bool thrown = false;
+    try { vw(nsam0, 0); } catch ( const std::out_of_range& ) { thrown = true; }
+    assert( thrown );
+  }
+
   cout << line << endl;
   cout << myname << "Copy object." << endl;
   DftData dft2(dft);
@@ -152,6 +175,10 @@ int test_FftwReal2dDftData(Index nsam0, Index nsam1) {
 
 //**********************************************************************
 
+// The sizes are available at compile time.
+static_assert(DftData::dftComplexDataSize(IndexArray{{4, 6}}) == 16, "Bad DFT size.");
+static_assert(DftData::dataSize(IndexArray{{4, 6}}) == 24, "Bad data size.");
+
 int main(int argc, char* argv[]) {
   if ( argc > 1 ) {
     cout << "Usage: " << argv[0] << " [ARG]" << endl;
@@ -0,0 +1,100 @@
+// test_IndexRangeLookup.cxx
+//
+// Test IndexRangeLookup.
+
+#include "dunecore/DuneInterface/Data/IndexRangeLookup.h"
+#include <string>
+#include <iostream>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = IndexRangeLookup::Index;
+
+//**********************************************************************
+
+int test_IndexRangeLookup() {
+  const string myname = "test_IndexRangeLookup: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  const Index badIndex = IndexRangeLookup::badIndex();
+
+  cout << myname << line << endl;
+  cout << myname << "Check empty lookup." << endl;
+  IndexRangeLookup irl0;
+  assert( irl0.size() == 0 );
+  assert( irl0.id("apa1") == badIndex );
+  assert( irl0.count(0) == 0 );
+  assert( irl0.firstId(0) == badIndex );
+  assert( irl0.ids(0) == nullptr );
+
+  cout << myname << line << endl;
+  cout << myname << "Build lookup from ranges." << endl;
+  IndexRangeLookup::RangeVector rans;
+  rans.emplace_back("apa1u", 100, 110);
+  rans.emplace_back("apa1v", 110, 120);
+  rans.emplace_back("apa1x", 105, 115);
+  rans.emplace_back("empty", 200, 200);
+  IndexRangeLookup irl(rans);
+  assert( irl.size() == 4 );
+  assert( irl.id("apa1v") == 1 );
+  assert( irl.id("empty") == 3 );
+  assert( irl.name(2) == "apa1x" );
+  assert( irl.name(4) == "" );
+  assert( irl.indexBegin() == 100 );
+  assert( irl.indexEnd() == 120 );
+  for ( Index ival=90; ival<130; ++ival ) {
+    Index nexp = 0;
+    Index iexp = badIndex;
+    for ( Index iran=0; iran<rans.size(); ++iran ) {
+      if ( ! rans[iran].contains(ival) ) continue;
+      if ( nexp == 0 ) iexp = iran;
+      ++nexp;
+      assert( irl.contains(iran, ival) );
+    }
+    assert( irl.count(ival) == nexp );
+    assert( irl.firstId(ival) == iexp );
+  }
+  assert( irl.ids(112)[0] == 1 );
+  assert( irl.ids(112)[1] == 2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Build lookup from groups." << endl;
+  IndexRangeLookup::GroupVector grps;
+  grps.emplace_back("apa1", rans);
+  grps.emplace_back("apa1z", IndexRangeLookup::RangeVector(1, IndexRange("apa1z", 120, 130)));
+  grps.emplace_back("all", IndexRangeLookup::RangeVector(1, IndexRange("all", 0, 130)));
+  IndexRangeLookup irlg(grps);
+  assert( irlg.size() == 3 );
+  assert( irlg.id("all") == 2 );
+  assert( irlg.indexBegin() == 0 );
+  assert( irlg.indexEnd() == 130 );
+  assert( irlg.count(50) == 1 );
+  assert( irlg.firstId(50) == 2 );
+  assert( irlg.count(107) == 2 );
+  assert( irlg.firstId(107) == 0 );
+  assert( irlg.firstId(125) == 1 );
+  assert( irlg.contains(2, 125) );
+  assert( ! irlg.contains(0, 125) );
+  assert( irlg.count(130) == 0 );
+  assert( irlg.group(0).size() == 4 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_IndexRangeLookup();
+}
+
+//**********************************************************************
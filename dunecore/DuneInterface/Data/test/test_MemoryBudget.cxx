@@ -0,0 +1,125 @@
+// test_MemoryBudget.cxx
+//
+// Test MemoryBudget.
+
+#include "dunecore/DuneInterface/Data/MemoryBudget.h"
+#include <string>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <utility>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Size = MemoryBudget::Size;
+using Milliseconds = MemoryBudget::Milliseconds;
+using Reservation = MemoryBudget::Reservation;
+
+//**********************************************************************
+
+int test_MemoryBudget() {
+  const string myname = "test_MemoryBudget: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Check the process budget." << endl;
+  MemoryBudget& gbud = MemoryBudget::instance();
+  assert( &MemoryBudget::instance() == &gbud );
+  assert( gbud.limit() == 0 );
+  assert( gbud.hasRoom(Size(1) << 40) );
+
+  cout << myname << line << endl;
+  cout << myname << "Acquire without limit." << endl;
+  MemoryBudget bud;
+  assert( bud.acquire(1000) );
+  assert( bud.tryAcquire(2000) );
+  assert( bud.used() == 3000 );
+  bud.release(3000);
+  assert( bud.used() == 0 );
+  assert( bud.peak() == 3000 );
+  assert( bud.waitCount() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Acquire with limit." << endl;
+  bud.setLimit(1000);
+  bud.setMaxWait(Milliseconds(20));
+  assert( bud.tryAcquire(600) );
+  assert( bud.hasRoom(400) );
+  assert( ! bud.hasRoom(401) );
+  assert( ! bud.tryAcquire(500) );
+  assert( bud.refusalCount() == 1 );
+  assert( ! bud.waitForRoom(500, Milliseconds(1)) );
+  assert( ! bud.acquire(500) );
+  assert( bud.waitCount() == 1 );
+  assert( bud.overrunCount() == 1 );
+  assert( bud.used() == 1100 );
+  bud.release(1100);
+  cout << myname << "A single request may exceed the limit." << endl;
+  assert( bud.tryAcquire(5000) );
+  bud.release(5000);
+  bud.charge(1500);
+  assert( bud.used() == 1500 );
+  assert( ! bud.hasRoom(1) );
+  bud.release(2000);
+  assert( bud.used() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Reservations." << endl;
+  {
+    Reservation res1(bud, 700);
+    assert( res1.size() == 700 );
+    assert( bud.used() == 700 );
+    Reservation res2(std::move(res1));
+    assert( res1.size() == 0 );
+    assert( bud.used() == 700 );
+    Reservation res3;
+    res3 = std::move(res2);
+    assert( bud.used() == 700 );
+    res3.release();
+    assert( bud.used() == 0 );
+    Reservation res4(bud, 300);
+  }
+  assert( bud.used() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Wait for room released by another thread." << endl;
+  bud.setMaxWait(Milliseconds(10000));
+  Size nover = bud.overrunCount();
+  {
+    Reservation res1(bud, 800);
+    std::atomic<bool> started(false);
+    std::thread thr([&bud, &started]() {
+      started = true;
+      Reservation res(bud, 800);
+      assert( res.size() == 800 );
+    });
+    while ( ! started ) std::this_thread::yield();
+    std::this_thread::sleep_for(Milliseconds(10));
+    res1.release();
+    thr.join();
+  }
+  assert( bud.overrunCount() == nover );
+  assert( bud.used() == 0 );
+  assert( bud.peak() == 5000 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_MemoryBudget();
+}
+
+//**********************************************************************
@@ -0,0 +1,88 @@
+// test_NumaPlacement.cxx
+//
+// Test NumaPlacement.
+
+#include "dunecore/DuneInterface/Data/NumaPlacement.h"
+#include <string>
+#include <iostream>
+#include <atomic>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = NumaPlacement::Index;
+using IndexVector = NumaPlacement::IndexVector;
+
+//**********************************************************************
+
+// Run a loop over nitm items, checking each is done once.
+void checkLoop(const NumaPlacement& plc, Index nitm) {
+  IndexVector nodes(nitm);
+  for ( Index iitm=0; iitm<nitm; ++iitm ) nodes[iitm] = plc.node(iitm, nitm);
+  std::vector<std::atomic<Index>> counts(nitm);
+  for ( std::atomic<Index>& cnt : counts ) cnt = 0;
+  plc.parallelFor(nodes, [&counts](Index iitm) { ++counts[iitm]; });
+  for ( Index iitm=0; iitm<nitm; ++iitm ) assert( counts[iitm] == 1 );
+}
+
+//**********************************************************************
+
+int test_NumaPlacement() {
+  const string myname = "test_NumaPlacement: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Check the default placement." << endl;
+  NumaPlacement& plc = NumaPlacement::instance();
+  assert( &NumaPlacement::instance() == &plc );
+  assert( ! plc.enabled() );
+  assert( plc.nodeCount() == 1 );
+  for ( Index iitm=0; iitm<10; ++iitm ) assert( plc.node(iitm, 10) == 0 );
+  assert( plc.node(0, 0) == 0 );
+  checkLoop(plc, 0);
+  checkLoop(plc, 150);
+
+  cout << myname << line << endl;
+  cout << myname << "Enable placement." << endl;
+  Index nnod = plc.configure(true, 2);
+  cout << myname << "# nodes: " << nnod << endl;
+  assert( plc.nodeCount() == nnod );
+  assert( plc.enabled() == (nnod > 1) );
+  Index nitm = 150;
+  Index lastNode = 0;
+  for ( Index iitm=0; iitm<nitm; ++iitm ) {
+    Index inod = plc.node(iitm, nitm);
+    assert( inod < nnod );
+    assert( inod >= lastNode );
+    lastNode = inod;
+  }
+  assert( lastNode == nnod - 1 );
+  checkLoop(plc, nitm);
+  checkLoop(plc, 1);
+
+  cout << myname << line << endl;
+  cout << myname << "Disable placement." << endl;
+  assert( plc.configure(false) == 1 );
+  assert( ! plc.enabled() );
+  checkLoop(plc, nitm);
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_NumaPlacement();
+}
+
+//**********************************************************************
@@ -0,0 +1,93 @@
+// test_PhiloxRandom.cxx
+//
+// Test PhiloxRandom.
+
+#include "dunecore/DuneInterface/Data/PhiloxRandom.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = PhiloxRandom::Index;
+using Counter = PhiloxRandom::Counter;
+using Key = PhiloxRandom::Key;
+
+//**********************************************************************
+
+int test_PhiloxRandom() {
+  const string myname = "test_PhiloxRandom: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Check the Random123 known-answer values." << endl;
+  Counter out = PhiloxRandom::generate({{0, 0, 0, 0}}, {{0, 0}});
+  assert( out == Counter({{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}) );
+  out = PhiloxRandom::generate({{~0u, ~0u, ~0u, ~0u}}, {{~0u, ~0u}});
+  assert( out == Counter({{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}) );
+  out = PhiloxRandom::generate({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                               {{0xa4093822, 0x299f31d0}});
+  assert( out == Counter({{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check uniform range." << endl;
+  assert( PhiloxRandom::toUniform(0) > 0.0 );
+  assert( PhiloxRandom::toUniform(~0u) < 1.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check normal values." << endl;
+  Key key = PhiloxRandom::makeKey(12345);
+  Index nval = 100001;
+  std::vector<float> vals(nval, 0.0);
+  PhiloxRandom::addGaus(vals.data(), nval, 10.0, 2.0, key, 7);
+  double sum = 0.0;
+  double sumsq = 0.0;
+  for ( float val : vals ) {
+    sum += val;
+    sumsq += val*val;
+  }
+  double mean = sum/nval;
+  double rms = std::sqrt(sumsq/nval - mean*mean);
+  cout << myname << "  Mean: " << mean << endl;
+  cout << myname << "   RMS: " << rms << endl;
+  assert( std::fabs(mean - 10.0) < 0.03 );
+  assert( std::fabs(rms - 2.0) < 0.03 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check reproducibility." << endl;
+  std::vector<float> full(vals.size(), 0.0);
+  PhiloxRandom::addGaus(full.data(), full.size(), 10.0, 2.0, key, 7);
+  assert( full == vals );
+  // A shorter fill of the same stream is a prefix.
+  std::vector<float> head(10, 0.0);
+  PhiloxRandom::addGaus(head.data(), head.size(), 10.0, 2.0, key, 7);
+  for ( Index ival=0; ival<head.size(); ++ival ) assert( head[ival] == vals[ival] );
+  std::vector<float> other(100, 0.0);
+  PhiloxRandom::addGaus(other.data(), other.size(), 10.0, 2.0, key, 8);
+  assert( other[0] != vals[0] );
+  std::vector<float> other2(100, 0.0);
+  PhiloxRandom::addGaus(other2.data(), other2.size(), 10.0, 2.0, PhiloxRandom::makeKey(1), 7);
+  assert( other2[0] != vals[0] );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_PhiloxRandom();
+}
+
+//**********************************************************************
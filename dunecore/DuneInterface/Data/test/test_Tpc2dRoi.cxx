@@ -7,6 +7,7 @@
 
 #include <string>
 #include <iostream>
+#include <cmath>
 #include <fstream>
 #include <vector>
 #include "dunecore/DuneInterface/Data/Tpc2dRoi.h"
@@ -23,6 +24,22 @@ using Index = Tpc2dRoi::Index;
 
 //**********************************************************************
 
+// Transform that counts its calls and fills the DFT with the data sum.
+class TestFFT {
+public:
+  int ncall = 0;
+  int fftForward(const Float2dData& dat, Tpc2dRoi::Dft& dft, Index) {
+    ++ncall;
+    dft.reset(dat.nSamples());
+    double sum = 0.0;
+    for ( float val : dat.data() ) sum += val;
+    dft.floatData()[0] = sum;
+    return 0;
+  }
+};
+
+//**********************************************************************
+
 int test_Tpc2dRoi() {
   const string myname = "test_Tpc2dRoi: ";
 #ifdef NDEBUG
@@ -92,6 +109,85 @@ int test_Tpc2dRoi() {
   }
   cout << myname << "Test count: " << ntst << endl;
 
+  cout << myline << endl;
+  cout << myname << "Check raw access." << endl;
+  assert( roi1.data().stride() == nsam );
+  assert( roi1.data().rowData(0) == roi1.data().floatData() );
+  assert( roi1.channelData(icha0 - 1) == nullptr );
+  assert( roi1.channelData(icha0 + ncha) == nullptr );
+  assert( roi1.value(icha0 + ncha, isam0) == 0.0 );
+  assert( roi1.value(icha0, isam0 + nsam, -1.0) == -1.0 );
+  for ( kcha=0; kcha<ncha; ++kcha ) {
+    const float* pdat = roi1.channelData(icha0 + kcha);
+    assert( pdat == roi1.data().rowData(kcha) );
+    for ( ksam=0; ksam<nsam; ++ksam ) {
+      float expval = nsam*kcha + ksam + 1;
+      assert( pdat[ksam] == expval );
+      assert( roi1.data()(kcha, ksam) == expval );
+    }
+  }
+  roi1.data()(1, 2) = -5.0;
+  assert( roi1.value(icha0 + 1, isam0 + 2) == -5.0 );
+  double pwr = 0.0;
+  for ( float val : roi1.data().data() ) pwr += val*val;
+  assert( std::abs(roi1.data().power() - pwr) < 1.e-5*pwr );
+
+  cout << myline << endl;
+  cout << myname << "Check views." << endl;
+  {
+    const Tpc2dRoi& croi = roi1;
+    Float2dData::ConstView<> cvw = croi.data().view();
+    assert( cvw.extent(0) == ncha );
+    assert( cvw.extent(1) == nsam );
+    assert( cvw.stride(0) == nsam );
+    assert( cvw.stride(1) == 1 );
+    for ( kcha=0; kcha<ncha; ++kcha ) {
+      assert( cvw.row(kcha) == croi.channelData(icha0 + kcha) );
+      for ( ksam=0; ksam<nsam; ++ksam ) assert( cvw(kcha, ksam) == croi.data()(kcha, ksam) );
+    }
+    unsigned long gen = roi1.data().generation();
+    Float2dData::View<true> vw = roi1.data().view<true>();
+    assert( roi1.data().generation() > gen );
+    vw(2, 1) = -7.0;
+    assert( roi1.value(icha0 + 2, isam0 + 1) == -7.0 );
+    bool thrown = false;
+    try { vw(0, nsam) = 1.0; } catch ( const std::out_of_range& ) { thrown = true; }
+    assert( thrown );
+  }
+
+  cout << myline << endl;
+  cout << myname << "Check the DFT caching." << endl;
+  TestFFT fft;
+  Tpc2dRoi::Dft::Norm norm(1, 1);
+  assert( ! roi1.dftIsCurrent() );
+  assert( roi1.ensureDft(fft) == -1 );
+  assert( roi1.ensureDft(fft, norm) == 0 );
+  assert( fft.ncall == 1 );
+  assert( roi1.dftIsCurrent() );
+  assert( roi1.ensureDft(fft) == 0 );
+  assert( roi1.ensureDft(fft, norm) == 0 );
+  assert( fft.ncall == 1 );
+  const Tpc2dRoi& croi1 = roi1;
+  float sum1 = croi1.dft()->floatData()[0];
+  assert( croi1.value(icha0, isam0) == 1.0 );
+  assert( croi1.channelData(icha0)[0] == 1.0 );
+  assert( roi1.dftIsCurrent() );
+  roi1.data().rowData(0)[0] += 10.0;
+  assert( ! roi1.dftIsCurrent() );
+  assert( roi1.ensureDft(fft) == 0 );
+  assert( fft.ncall == 2 );
+  assert( croi1.dft()->floatData()[0] == sum1 + 10.0 );
+  roi1.invalidateDft();
+  assert( ! roi1.dftIsCurrent() );
+  assert( roi1.ensureDft(fft) == 0 );
+  assert( fft.ncall == 3 );
+  Tpc2dRoi::Dft::Norm norm2(2, 1);
+  assert( roi1.ensureDft(fft, norm2) == 0 );
+  assert( fft.ncall == 4 );
+  assert( roi1.dft()->normalization().isConsistent() );
+  roi1.resetDft(new Tpc2dRoi::Dft(norm, roi1.data().nSamples()));
+  assert( roi1.dftIsCurrent() );
+
   cout << myline << endl;
   cout << myname << "All tests passed." << endl;
   return 0;
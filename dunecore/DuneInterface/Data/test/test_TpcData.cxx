@@ -127,6 +127,51 @@ int test_TpcData() {
   cout << myname << "Print object." << endl;
   tpd.print(myname);
 
+  cout << line << endl;
+  cout << myname << "Add constituent with an ADC data range." << endl;
+  assert( tpd.addTpcData("sub2", 1, 2) == nullptr );
+  assert( tpd.addTpcData("sub2", 3, 0) == nullptr );
+  assert( tpd.addTpcData("sub3/sub31", 0, 1) == nullptr );
+  TpcData* pdat2 = tpd.addTpcData("sub2", 1, 1);
+  assert( pdat2 != nullptr );
+  assert( pdat2->getParent() == &tpd );
+  assert( pdat2->getAdcData().size() == 1 );
+  assert( pdat2->getAdcData()[0] == pacm1 );
+  assert( tpd.addTpcData("sub2", 0, 1) == nullptr );
+  TpcData* pdat21 = tpd.addTpcData("sub2/sub21", 0, 0);
+  assert( pdat21 != nullptr );
+  assert( pdat21->getParent() == pdat2 );
+  assert( pdat21->getAdcData().size() == 0 );
+  TpcData::AdcDataPtr pacm2 = pdat21->createAdcData();
+  assert( pdat21->getAdcData().size() == 1 );
+  assert( pdat2->getAdcData().size() == 2 );
+  assert( tpd.getAdcData().size() == 3 );
+  assert( tpd.getAdcData()[2] == pacm2 );
+
+  cout << line << endl;
+  cout << myname << "Release ADC data." << endl;
+  std::weak_ptr<AdcChannelDataMap> wacm2 = pacm2;
+  pacm2.reset();
+  assert( ! wacm2.expired() );
+  pdat2->releaseAdcData();
+  assert( pdat2->getAdcData().size() == 0 );
+  assert( pdat21->getAdcData().size() == 0 );
+  assert( tpd.getAdcData().size() == 3 );
+  assert( ! wacm2.expired() );
+  tpd.releaseAdcData();
+  assert( tpd.getAdcData().size() == 0 );
+  assert( wacm2.expired() );
+  assert( tpd.getTpcData("sub2/sub21") == pdat21 );
+
+  cout << line << endl;
+  cout << myname << "Release everything." << endl;
+  tpd.get2dRois().emplace_back(2, 3, 0, 0);
+  tpd.release();
+  assert( tpd.getAdcData().size() == 0 );
+  assert( tpd.get2dRois().size() == 0 );
+  assert( tpd.getData().size() == 0 );
+  assert( tpd.getTpcData("sub1") == nullptr );
+
   cout << line << endl;
   cout << myname << "All tests passed." << endl;
   return 0;
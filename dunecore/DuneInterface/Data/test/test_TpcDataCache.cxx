@@ -0,0 +1,166 @@
+// test_TpcDataCache.cxx
+//
+// Test TpcDataCache.
+
+#include "dunecore/DuneInterface/Data/TpcDataCache.h"
+#include <string>
+#include <iostream>
+#include <cstdio>
+#include <unistd.h>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = TpcDataCache::Index;
+using Hash = TpcDataCache::Hash;
+using AdcDataPtr = TpcData::AdcDataPtr;
+
+//**********************************************************************
+
+int test_TpcDataCache() {
+  const string myname = "test_TpcDataCache: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create the cache." << endl;
+  string dir = "/tmp/test_TpcDataCache_" + std::to_string(getpid());
+  assert( system(("mkdir -p " + dir).c_str()) == 0 );
+  TpcDataCache cache(dir);
+  assert( cache.directory() == dir );
+  Hash cfg = TpcDataCache::hash("myconfig");
+  assert( cfg == TpcDataCache::hash("myconfig") );
+  assert( cfg != TpcDataCache::hash("myconfih") );
+  Index run = 123;
+  Index subrun = 4;
+  Index event = 56;
+
+  cout << myname << line << endl;
+  cout << myname << "Build the data." << endl;
+  TpcData tpd;
+  TpcData* ptpc = tpd.addTpcData("apa1");
+  assert( ptpc != nullptr );
+  AdcDataPtr pacm = ptpc->createAdcData();
+  assert( pacm );
+  AdcChannelData::EventInfoPtr pevi(new DuneEventInfo(run, event, subrun, 1000, 12, 3));
+  Index ncha = 5;
+  Index nsam = 20;
+  for ( Index icha=100; icha<100+ncha; ++icha ) {
+    AdcChannelData& acd = (*pacm)[icha];
+    acd.setEventInfo(pevi);
+    acd.setChannelInfo(icha, 2, icha-100, 0);
+    acd.pedestal = 500.0 + icha;
+    acd.pedestalRms = 2.5;
+    acd.tick0 = 10;
+    acd.raw.resize(nsam, icha);
+    for ( Index isam=0; isam<nsam; ++isam ) acd.samples.push_back(0.5*isam);
+    acd.flags.resize(nsam, 0);
+    acd.flags[3] = 7;
+    acd.signal.resize(nsam, false);
+    acd.signal[4] = true;
+    acd.signal[5] = true;
+    acd.rois.push_back(AdcRoi(4, 5));
+    acd.sampleUnit = "ke";
+    acd.metadata["noise"] = 1.5;
+  }
+  TpcData* ptpl = ptpc->addTpcData("plane0", true);
+  assert( ptpl != nullptr );
+  assert( ptpl->getAdcData().size() == 1 );
+  assert( ptpl->getAdcData()[0] == pacm );
+  ptpl->get2dRois().emplace_back(3, 4, 101, 8);
+  ptpl->get2dRois().back().data().setValue({1, 2}, 3.5);
+
+  cout << myname << line << endl;
+  cout << myname << "Write the stage." << endl;
+  assert( ! cache.has("apa1", run, subrun, event, cfg) );
+  assert( cache.write(tpd, "bad", run, subrun, event, cfg) == 1 );
+  assert( cache.write(tpd, "apa1", run, subrun, event, cfg) == 0 );
+  assert( cache.has("apa1", run, subrun, event, cfg) );
+  assert( ! cache.has("apa1", run, subrun, event+1, cfg) );
+  cout << myname << "File: " << cache.fileName("apa1", run, subrun, event, cfg) << endl;
+
+  cout << myname << line << endl;
+  cout << myname << "Read the stage." << endl;
+  TpcData tpdNew;
+  assert( cache.read(tpdNew, "apa1", run, subrun, event+1, cfg) == 1 );
+  assert( cache.read(tpdNew, "apa1", run, subrun, event, cfg) == 0 );
+  assert( tpdNew.getAdcData().size() == 1 );
+  AdcDataPtr pacmNew = tpdNew.getAdcData()[0];
+  assert( pacmNew );
+  assert( pacmNew != pacm );
+  assert( pacmNew->size() == ncha );
+  const TpcData* ptplNew = tpdNew.getTpcData("plane0");
+  assert( ptplNew != nullptr );
+  assert( ptplNew->getAdcData().size() == 1 );
+  assert( ptplNew->getAdcData()[0] == pacmNew );
+  assert( ptplNew->get2dRois().size() == 1 );
+  const Tpc2dRoi& roi = ptplNew->get2dRois().front();
+  assert( roi.channelSize() == 3 );
+  assert( roi.sampleSize() == 4 );
+  assert( roi.channelOffset() == 101 );
+  assert( roi.sampleOffset() == 8 );
+  assert( roi.data().value({1, 2}) == 3.5 );
+  assert( roi.data().value({1, 1}) == 0.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check the channel data." << endl;
+  const DuneEventInfo* pevi0 = nullptr;
+  for ( const AdcChannelDataMap::value_type& iacd : *pacm ) {
+    const AdcChannelData& acd = iacd.second;
+    const AdcChannelData& acdNew = pacmNew->at(iacd.first);
+    assert( acdNew.channel() == acd.channel() );
+    assert( acdNew.fembID() == acd.fembID() );
+    assert( acdNew.fembChannel() == acd.fembChannel() );
+    assert( acdNew.run() == run );
+    assert( acdNew.event() == event );
+    assert( acdNew.subRun() == subrun );
+    if ( pevi0 == nullptr ) pevi0 = acdNew.getEventInfoPtr().get();
+    assert( acdNew.getEventInfoPtr().get() == pevi0 );
+    assert( acdNew.pedestal == acd.pedestal );
+    assert( acdNew.pedestalRms == acd.pedestalRms );
+    assert( acdNew.tick0 == acd.tick0 );
+    assert( acdNew.raw == acd.raw );
+    assert( acdNew.samples == acd.samples );
+    assert( acdNew.flags == acd.flags );
+    assert( acdNew.signal == acd.signal );
+    assert( acdNew.rois == acd.rois );
+    assert( acdNew.sampleUnit == acd.sampleUnit );
+    assert( acdNew.metadata.size() == 1 );
+    assert( acdNew.metadata.find("noise")->second == 1.5 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check a name clash." << endl;
+  assert( cache.read(tpdNew, "apa1", run, subrun, event, cfg) == 3 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check a corrupt file." << endl;
+  string fnam = cache.fileName("apa1", run, subrun, event, cfg);
+  assert( truncate(fnam.c_str(), 100) == 0 );
+  TpcData tpdBad;
+  assert( cache.read(tpdBad, "apa1", run, subrun, event, cfg) == 2 );
+
+  cout << myname << line << endl;
+  cout << myname << "Clean up." << endl;
+  std::remove(fnam.c_str());
+  std::remove(dir.c_str());
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_TpcDataCache();
+}
+
+//**********************************************************************
@@ -0,0 +1,133 @@
+// test_TraceRecorder.cxx
+//
+// Test TraceRecorder and TraceSpan.
+
+#include "dunecore/DuneInterface/Data/TraceRecorder.h"
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <cstdio>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+
+using Index = TraceRecorder::Index;
+using Event = TraceRecorder::Event;
+
+//**********************************************************************
+
+int test_TraceRecorder() {
+  const string myname = "test_TraceRecorder: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  string fname = "test_TraceRecorder.json";
+
+  cout << myname << line << endl;
+  cout << myname << "Check the disabled recorder." << endl;
+  TraceRecorder& rec = TraceRecorder::instance();
+  assert( &TraceRecorder::instance() == &rec );
+  rec.configure("");
+  assert( ! TraceRecorder::enabled() );
+  {
+    TraceSpan span("test", "disabled");
+    assert( ! span.active() );
+    span.arg("apa", 1);
+  }
+  assert( rec.eventCount() == 0 );
+  assert( rec.write() == 1 );
+
+  cout << myname << line << endl;
+  cout << myname << "Record spans." << endl;
+  rec.configure(fname);
+  assert( TraceRecorder::enabled() );
+  assert( rec.fileName() == fname );
+  {
+    TraceSpan outer("test", "outer");
+    assert( outer.active() );
+    outer.arg("apa", 3).arg("channel", 2560).arg("nchan", 2560);
+    TraceSpan inner("test", "inner");
+    for ( Index iarg=0; iarg<TraceRecorder::maxArgs + 2; ++iarg ) inner.arg("i", iarg);
+  }
+  assert( rec.eventCount() == 2 );
+  std::vector<std::pair<Index, Event>> evts = rec.events();
+  assert( evts.size() == 2 );
+  assert( string(evts[0].second.name) == "outer" );
+  assert( string(evts[1].second.name) == "inner" );
+  assert( evts[0].first == evts[1].first );
+  assert( evts[0].second.start <= evts[1].second.start );
+  assert( evts[0].second.duration >= evts[1].second.duration );
+  assert( evts[0].second.nargs == 3 );
+  assert( string(evts[0].second.argNames[1]) == "channel" );
+  assert( evts[0].second.argValues[1] == 2560 );
+  assert( evts[1].second.nargs == TraceRecorder::maxArgs );
+
+  cout << myname << line << endl;
+  cout << myname << "Record spans on other threads." << endl;
+  const char* pnam = rec.intern(string("thread") + "Span");
+  assert( rec.intern("threadSpan") == pnam );
+  Index nthr = 4;
+  std::vector<std::thread> thrs;
+  for ( Index ithr=0; ithr<nthr; ++ithr ) {
+    thrs.emplace_back([pnam, ithr]() {
+      TraceSpan span("test", pnam);
+      span.arg("thread", ithr);
+    });
+  }
+  for ( std::thread& thr : thrs ) thr.join();
+  assert( rec.eventCount() == 2 + nthr );
+  evts = rec.events();
+  std::vector<Index> tids;
+  for ( const std::pair<Index, Event>& ievt : evts ) {
+    if ( ievt.second.name != pnam ) continue;
+    assert( ievt.first != evts[0].first );
+    tids.push_back(ievt.first);
+  }
+  assert( tids.size() == nthr );
+
+  cout << myname << line << endl;
+  cout << myname << "Write the trace." << endl;
+  assert( rec.write() == 0 );
+  std::ifstream fin(fname);
+  std::ostringstream sscon;
+  sscon << fin.rdbuf();
+  string scon = sscon.str();
+  assert( scon.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0 );
+  assert( scon.find("\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"X\"") != string::npos );
+  assert( scon.find("\"args\":{\"apa\":3,\"channel\":2560,\"nchan\":2560}") != string::npos );
+  assert( scon.find("\"thread_name\"") != string::npos );
+  assert( scon.find("\n]}") != string::npos );
+  std::remove(fname.c_str());
+
+  cout << myname << line << endl;
+  cout << myname << "Check the span limit." << endl;
+  rec.clear();
+  assert( rec.eventCount() == 0 );
+  rec.configure(fname, 2);
+  for ( Index ispn=0; ispn<5; ++ispn ) TraceSpan span("test", "limited");
+  assert( rec.eventCount() == 2 );
+  assert( rec.droppedCount() == 3 );
+  rec.clear();
+  rec.configure("");
+  assert( rec.droppedCount() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_TraceRecorder();
+}
+
+//**********************************************************************
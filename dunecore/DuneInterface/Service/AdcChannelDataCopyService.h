@@ -7,6 +7,13 @@
 // September 2016
 //
 // Interface for a service that copies AdcChannelData.
+//
+// Besides the full copy, there are two cheaper forms for pipelines that keep
+// intermediate states:
+//   copyFields copies only the selected fields, e.g. all but the raw data when the
+//              state is only used to monitor samples.
+//   move       moves the data buffers when the old state is not read again.
+// Both have defaults here so that implementations need only provide copy.
 
 #include <iostream>
 #include "dunecore/DuneInterface/Data/AdcChannelData.h"
@@ -15,12 +22,82 @@ class AdcChannelDataCopyService {
 
 public:
 
+  using Index = unsigned int;
+
+  // Fields selected in copyFields. Info is the event and channel info, the clock,
+  // tick0, pedestal, sample unit and noise, and the digit and wire connections.
+  enum Field {
+    Info       =   1,
+    Raw        =   2,
+    Samples    =   4,
+    Flags      =   8,
+    Signal     =  16,
+    Rois       =  32,
+    Dft        =  64,
+    Metadata   = 128,
+    BinSamples = 256,
+    AllFields  = 511
+  };
+
   virtual ~AdcChannelDataCopyService() = default;
 
   // Copy the data from one AdcChannelData object to another.
   // Returns nonzero for error.
   virtual int copy(const AdcChannelData& oldacd, AdcChannelData& newacd) const =0;
 
+  // Copy the fields selected in the bit mask fields (Field values) from one object
+  // to another. Fields not selected are left unchanged in newacd.
+  // Samples are taken from the block row if oldacd is bound to a block.
+  // Returns nonzero for error.
+  virtual int copyFields(const AdcChannelData& oldacd, AdcChannelData& newacd, Index fields) const {
+    if ( fields & Info ) {
+      newacd.setEventInfo(oldacd.getEventInfoPtr());
+      newacd.setChannelInfo(oldacd.getChannelInfoPtr());
+      newacd.channelClock = oldacd.channelClock;
+      newacd.tick0 = oldacd.tick0;
+      newacd.pedestal = oldacd.pedestal;
+      newacd.pedestalRms = oldacd.pedestalRms;
+      newacd.sampleUnit = oldacd.sampleUnit;
+      newacd.sampleNoise = oldacd.sampleNoise;
+      newacd.digit = oldacd.digit;
+      newacd.wire = oldacd.wire;
+      newacd.digitIndex = oldacd.digitIndex;
+      newacd.wireIndex = oldacd.wireIndex;
+    }
+    if ( fields & Raw ) newacd.raw = oldacd.raw;
+    if ( fields & Samples ) {
+      const AdcSignal* psam = oldacd.sampleData();
+      newacd.samples.assign(psam, psam + oldacd.sampleCount());
+    }
+    if ( fields & Flags ) newacd.flags = oldacd.flags;
+    if ( fields & Signal ) newacd.signal = oldacd.signal;
+    if ( fields & Rois ) newacd.rois = oldacd.rois;
+    if ( fields & Dft ) {
+      newacd.dftmags = oldacd.dftmags;
+      newacd.dftphases = oldacd.dftphases;
+    }
+    if ( fields & Metadata ) newacd.metadata = oldacd.metadata;
+    if ( fields & BinSamples ) newacd.binSamples = oldacd.binSamples;
+    return 0;
+  }
+
+  // Move the data from one object to another. The data buffers are transferred rather
+  // than copied and oldacd is left empty. Use this when oldacd is not read again.
+  // The default is a move assignment. Objects bound to a block (see AdcChannelBlock)
+  // have their samples copied from the block instead.
+  // Returns nonzero for error.
+  virtual int move(AdcChannelData& oldacd, AdcChannelData& newacd) const {
+    if ( oldacd.hasBlockSamples() ) {
+      const AdcSignal* psam = oldacd.sampleData();
+      oldacd.samples.assign(psam, psam + oldacd.sampleCount());
+      oldacd.blockSamples = nullptr;
+      oldacd.blockTicks = 0;
+    }
+    newacd = std::move(oldacd);
+    oldacd.clear();
+    return 0;
+  }
+
   // Print parameters.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const =0;
 
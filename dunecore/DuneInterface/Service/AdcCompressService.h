@@ -14,6 +14,8 @@
 #include <string>
 #include <iostream>
 #include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include "dunecore/DuneInterface/Data/AdcBitMask.h"
+#include <vector>
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
 
 namespace fhicl {
@@ -27,6 +29,11 @@ class AdcCompressService {
 
 public:
 
+  typedef std::vector<AdcCountVector> AdcCountVectorVector;
+  typedef std::vector<AdcBitMask> AdcBitMaskVector;
+  typedef std::vector<AdcCount> AdcCountOffsetVector;
+  typedef std::vector<raw::Compress_t> CompressVector;
+
   // Dtor.
   virtual ~AdcCompressService() =default;
 
@@ -40,6 +47,30 @@ public:
                        AdcCount offset,
                        raw::Compress_t& comp) const =0;
 
+  // Compress a block of channels, e.g. those for an APA, in one call.
+  //     sigs: I/O ADC vectors to be compressed, one for each channel.
+  //    keeps: Input word-packed masks indicating which signals are retained.
+  //  offsets: Input pedestals.
+  //    comps: Output compression strategies.
+  // The default calls compress for each channel. Implementations may override this
+  // to work a word at a time. Returns the first nonzero channel status or 1 if the
+  // input sizes differ.
+  virtual int compressBlock(AdcCountVectorVector& sigs,
+                            const AdcBitMaskVector& keeps,
+                            const AdcCountOffsetVector& offsets,
+                            CompressVector& comps) const {
+    if ( keeps.size() != sigs.size() || offsets.size() != sigs.size() ) return 1;
+    comps.resize(sigs.size());
+    int rstat = 0;
+    AdcFilterVector keep;
+    for ( AdcIndex icha=0; icha<sigs.size(); ++icha ) {
+      keeps[icha].toVector(keep);
+      int cstat = compress(sigs[icha], keep, offsets[icha], comps[icha]);
+      if ( cstat != 0 && rstat == 0 ) rstat = cstat;
+    }
+    return rstat;
+  }
+
   // Print the configuration.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="  ") const =0;
 
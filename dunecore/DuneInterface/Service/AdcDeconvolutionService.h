@@ -25,6 +25,21 @@ public:
   virtual int update(detinfo::DetectorClocksData const& clockData,
                      AdcChannelData& data) const =0;
 
+  // Deconvolute a block of channels that share a response, e.g. one plane of an APA.
+  // Implementations may override this to load the channels into an AdcChannelBlock and
+  // run one batched forward FFT, one multiply with the cached response and filter and
+  // one batched inverse FFT. The default calls update for each channel.
+  // Returns the first nonzero channel status.
+  virtual int updateBlock(detinfo::DetectorClocksData const& clockData,
+                          AdcChannelDataMap& datamap) const {
+    int rstat = 0;
+    for ( AdcChannelDataMap::value_type& iacd : datamap ) {
+      int cstat = update(clockData, iacd.second);
+      if ( cstat != 0 && rstat == 0 ) rstat = cstat;
+    }
+    return rstat;
+  }
+
   // Print parameters.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const =0;
 
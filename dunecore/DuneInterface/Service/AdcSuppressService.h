@@ -15,6 +15,8 @@
 #include <iostream>
 #include "dunecore/DuneInterface/Data/AdcTypes.h"
 #include "dunecore/DuneInterface/Data/AdcCountSelection.h"
+#include "dunecore/DuneInterface/Data/AdcBitMask.h"
+#include <vector>
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
 
 namespace fhicl {
@@ -29,6 +31,10 @@ class AdcSuppressService {
 public:
 
   typedef unsigned int Channel;
+  typedef std::vector<AdcCountVector> AdcCountVectorVector;
+  typedef std::vector<Channel> ChannelVector;
+  typedef std::vector<AdcPedestal> PedestalVector;
+  typedef std::vector<AdcBitMask> AdcBitMaskVector;
 
   // Dtor.
   virtual ~AdcSuppressService() =default;
@@ -42,13 +48,64 @@ public:
                      AdcPedestal ped,
                      AdcFilterVector& keep) const =0;
 
+  // Suppress a block of channels, e.g. those for an APA, in one call.
+  //     sigs: Input ADC vectors, one for each channel.
+  //    chans: Input channel numbers.
+  //     peds: Input pedestals.
+  //    keeps: I/O word-packed masks indicating which signals are retained. A mask
+  //           whose size differs from that of its ADC vector is reset to retain all.
+  // The default calls filter for each channel. Implementations may override this
+  // to work a word at a time. Returns the first nonzero channel status or 1 if the
+  // input sizes differ.
+  virtual int filterBlock(const AdcCountVectorVector& sigs,
+                          const ChannelVector& chans,
+                          const PedestalVector& peds,
+                          AdcBitMaskVector& keeps) const {
+    if ( chans.size() != sigs.size() || peds.size() != sigs.size() ) return 1;
+    keeps.resize(sigs.size());
+    int rstat = 0;
+    AdcFilterVector keep;
+    for ( AdcIndex icha=0; icha<sigs.size(); ++icha ) {
+      AdcBitMask& mask = keeps[icha];
+      if ( mask.size() != sigs[icha].size() ) mask.resize(0);
+      if ( mask.empty() ) mask.resize(sigs[icha].size(), true);
+      mask.toVector(keep);
+      int cstat = filter(sigs[icha], chans[icha], peds[icha], keep);
+      mask.fromVector(keep);
+      if ( cstat != 0 && rstat == 0 ) rstat = cstat;
+    }
+    return rstat;
+  }
+
+  // Suppress nsig signals starting at psig held by the caller.
+  //     keep: I/O word-packed mask indicating which signals are retained. A mask
+  //           whose size differs from nsig is reset to retain all.
+  // The default copies the signals and mask to vectors and calls filter.
+  // Implementations may override this to work on the caller's data without copies.
+  virtual int filter(const AdcCount* psig, AdcIndex nsig,
+                     Channel chan,
+                     AdcPedestal ped,
+                     AdcBitMask& keep) const {
+    if ( keep.size() != nsig ) keep.resize(0);
+    if ( keep.empty() ) keep.resize(nsig, true);
+    AdcCountVector sigs(psig, psig + nsig);
+    AdcFilterVector keepVector;
+    keep.toVector(keepVector);
+    int rstat = filter(sigs, chan, ped, keepVector);
+    keep.fromVector(keepVector);
+    return rstat;
+  }
+
   // Print the configuration.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="  ") const =0;
 
-  // Alternate interface.
+  // Alternate interfaces.
   int filter(AdcCountSelection& acs) {
     return filter(acs.counts, acs.channel, acs.pedestal, acs.filter);
   }
+  int filter(AdcCountSelectionView& acs) {
+    return filter(acs.counts, acs.ncount, acs.channel, acs.pedestal, acs.keep);
+  }
 
 };
 
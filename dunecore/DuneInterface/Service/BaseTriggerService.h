@@ -15,6 +15,7 @@
 
 //jpd -- needed to allow for triggering on triggers
 #include "dunecore/DAQTriggerSim/TriggerDataProducts/BasicTrigger.h"
+#include "dunecore/DAQTriggerSim/TriggerDataProducts/TriggerPrimitive.h"
 //#ifndef __CLING__
 #include "art/Framework/Principal/Event.h"
 //#endif
@@ -63,6 +64,15 @@ public:
   virtual bool PDTrigger(const std::vector<raw::OpDetWaveform>&)
   { return false; }
 
+  // Make your trigger decision based on TPC trigger primitives only.
+  // Can be overridden by the inherited class.
+  //
+  //   params:
+  //   tps - A vector of trigger primitives, e.g. from TriggerPrimitiveFinder, so the
+  //         algorithm does not need the full raw digits...
+  virtual bool TPTrigger(const std::vector<triggersim::TriggerPrimitive>&)
+  { return false; }
+
   // Make your trigger decision based on a mixture of TPC and PD info.
   // Can be overridden by the inherited class.
   //
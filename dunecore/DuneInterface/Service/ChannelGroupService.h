@@ -4,10 +4,28 @@
 // October 2016
 //
 // Interface for a service that groups channels.
+//
+// Implementations may precompute an IndexRangeLookup holding the contiguous
+// channel ranges for each group and return it with lookup(). Then groupOf is a
+// table lookup and ranges returns the precomputed ranges. Otherwise both are
+// evaluated from channels(igrp) on each call.
+//
+// The channels of all groups may also be returned in a group-contiguous order with
+// channelOrder(), e.g. to load an AdcChannelBlock so that each group is a contiguous
+// range of rows and group-wise kernels read sequential memory:
+//   ChannelGroupService::ChannelOrder cor = pcgs->channelOrder();
+//   blk.load(acds, cor.channels);
+//   // Rows [cor.begin(igrp), cor.end(igrp)) hold group igrp if all its channels are in acds.
+// Implementations may likewise precompute the order and return it with order().
+//
+// The service has SHARED scope so it may be used by modules processing events
+// concurrently. Implementations must build their groups in the constructor and
+// keep all const methods thread-safe.
 
 #ifndef ChannelGroupService_H
 #define ChannelGroupService_H
 
+#include "dunecore/DuneInterface/Data/IndexRangeLookup.h"
 #include <vector>
 #include <iostream>
 
@@ -19,6 +37,36 @@ public:
   typedef unsigned int Channel;
   typedef std::vector<Channel> ChannelVector;
   typedef std::string Name;
+  typedef std::vector<Name> NameVector;
+  typedef std::vector<ChannelVector> ChannelVectorVector;
+  typedef IndexRangeGroup::RangeVector RangeVector;
+  typedef std::vector<Index> IndexVector;
+
+  static Index badIndex() { return IndexRangeLookup::badIndex(); }
+
+  // Group-contiguous order of the channels in all groups.
+  // channels holds the channels of the first group, then those of the second, etc.
+  // A channel in more than one group is placed only with the first and isPartition
+  // is then false. Group igrp has positions [begin(igrp), end(igrp)) in channels.
+  struct ChannelOrder {
+    ChannelVector channels;
+    IndexVector offsets;       // Size is the # groups + 1
+    IndexVector positions;     // Position of each channel number or badIndex()
+    bool isPartition = true;
+    Index size() const { return offsets.size() ? offsets.size() - 1 : 0; }
+    Index begin(Index igrp) const { return igrp < size() ? offsets[igrp] : channels.size(); }
+    Index end(Index igrp) const { return igrp < size() ? offsets[igrp+1] : channels.size(); }
+    Index position(Channel icha) const { return icha < positions.size() ? positions[icha] : badIndex(); }
+  };
+
+  // Build the contiguous ranges for a channel vector.
+  static RangeVector makeRanges(Name name, const ChannelVector& chans);
+
+  // Build a lookup from group names and channels.
+  static IndexRangeLookup makeLookup(const NameVector& names, const ChannelVectorVector& chanvecs);
+
+  // Build the group-contiguous order for group channels.
+  static ChannelOrder makeOrder(const ChannelVectorVector& chanvecs);
 
   virtual ~ChannelGroupService() = default;
 
@@ -34,11 +82,107 @@ public:
   // Print parameters.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const =0;
 
+  // Return the precomputed lookup or null if there is none.
+  virtual const IndexRangeLookup* lookup() const { return nullptr; }
+
+  // Return the precomputed channel order or null if there is none.
+  virtual const ChannelOrder* order() const { return nullptr; }
+
+  // Return the first group holding a channel or badIndex() if there is none.
+  Index groupOf(Channel icha) const;
+
+  // Return the contiguous channel ranges for a group.
+  RangeVector ranges(Index igrp) const;
+
+  // Return the group-contiguous channel order.
+  ChannelOrder channelOrder() const;
+
 };
 
+//**********************************************************************
+
+inline ChannelGroupService::RangeVector
+ChannelGroupService::makeRanges(Name name, const ChannelVector& chans) {
+  RangeVector rans;
+  for ( Channel icha : chans ) {
+    if ( rans.size() && rans.back().end == icha ) ++rans.back().end;
+    else rans.emplace_back(name + "_" + std::to_string(rans.size()), icha, icha + 1);
+  }
+  return rans;
+}
+
+//**********************************************************************
+
+inline IndexRangeLookup
+ChannelGroupService::makeLookup(const NameVector& names, const ChannelVectorVector& chanvecs) {
+  std::vector<IndexRangeGroup> grps;
+  for ( Index igrp=0; igrp<chanvecs.size(); ++igrp ) {
+    Name name = igrp < names.size() ? names[igrp] : Name();
+    grps.emplace_back(name, makeRanges(name, chanvecs[igrp]));
+  }
+  return IndexRangeLookup(grps);
+}
+
+//**********************************************************************
+
+inline ChannelGroupService::ChannelOrder
+ChannelGroupService::makeOrder(const ChannelVectorVector& chanvecs) {
+  ChannelOrder cor;
+  cor.offsets.reserve(chanvecs.size() + 1);
+  Channel ncha = 0;
+  for ( const ChannelVector& chans : chanvecs ) {
+    for ( Channel icha : chans ) if ( icha >= ncha ) ncha = icha + 1;
+  }
+  cor.positions.assign(ncha, badIndex());
+  for ( const ChannelVector& chans : chanvecs ) {
+    cor.offsets.push_back(cor.channels.size());
+    for ( Channel icha : chans ) {
+      if ( cor.positions[icha] != badIndex() ) {
+        cor.isPartition = false;
+        continue;
+      }
+      cor.positions[icha] = cor.channels.size();
+      cor.channels.push_back(icha);
+    }
+  }
+  cor.offsets.push_back(cor.channels.size());
+  return cor;
+}
+
+//**********************************************************************
+
+inline ChannelGroupService::Index ChannelGroupService::groupOf(Channel icha) const {
+  const IndexRangeLookup* plu = lookup();
+  if ( plu != nullptr ) return plu->firstId(icha);
+  for ( Index igrp=0; igrp<size(); ++igrp ) {
+    for ( Channel jcha : channels(igrp) ) if ( jcha == icha ) return igrp;
+  }
+  return badIndex();
+}
+
+//**********************************************************************
+
+inline ChannelGroupService::RangeVector ChannelGroupService::ranges(Index igrp) const {
+  const IndexRangeLookup* plu = lookup();
+  if ( plu != nullptr ) return igrp < plu->size() ? plu->group(igrp).ranges : RangeVector();
+  return makeRanges(name(igrp), channels(igrp));
+}
+
+//**********************************************************************
+
+inline ChannelGroupService::ChannelOrder ChannelGroupService::channelOrder() const {
+  const ChannelOrder* pcor = order();
+  if ( pcor != nullptr ) return *pcor;
+  ChannelVectorVector chanvecs;
+  for ( Index igrp=0; igrp<size(); ++igrp ) chanvecs.push_back(channels(igrp));
+  return makeOrder(chanvecs);
+}
+
+//**********************************************************************
+
 #ifndef __CLING__
 #include "art/Framework/Services/Registry/ServiceMacros.h"
-DECLARE_ART_SERVICE_INTERFACE(ChannelGroupService, LEGACY)
+DECLARE_ART_SERVICE_INTERFACE(ChannelGroupService, SHARED)
 #endif
 
 #endif
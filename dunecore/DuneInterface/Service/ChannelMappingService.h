@@ -8,6 +8,7 @@
 #ifndef ChannelMappingService_H
 #define ChannelMappingService_H
 
+#include <cstddef>
 #include <vector>
 #include <iostream>
 #include "dunecore/DuneInterface/Data/AdcTypes.h"
@@ -26,6 +27,30 @@ public:
   // Map offline to online.
   virtual Channel online(Channel offlineChannel) const =0;
 
+  // Batch versions: map nchan channels in[0..nchan-1] to out[0..nchan-1].
+  // The default implementations loop over the single-channel calls. Implementations
+  // with table lookups should override these to avoid one virtual call per channel.
+  // Classes overriding only the single-channel calls can add
+  //   using ChannelMappingService::offline;
+  //   using ChannelMappingService::online;
+  // to keep the batch calls visible through the derived type.
+  virtual void offline(const Channel* onlineChannels, std::size_t nchan, Channel* offlineChannels) const {
+    for ( std::size_t ich=0; ich<nchan; ++ich ) offlineChannels[ich] = offline(onlineChannels[ich]);
+  }
+  virtual void online(const Channel* offlineChannels, std::size_t nchan, Channel* onlineChannels) const {
+    for ( std::size_t ich=0; ich<nchan; ++ich ) onlineChannels[ich] = online(offlineChannels[ich]);
+  }
+
+  // Vector versions of the batch calls. The output is resized to match the input.
+  void offline(const std::vector<Channel>& onlineChannels, std::vector<Channel>& offlineChannels) const {
+    offlineChannels.resize(onlineChannels.size());
+    offline(onlineChannels.data(), onlineChannels.size(), offlineChannels.data());
+  }
+  void online(const std::vector<Channel>& offlineChannels, std::vector<Channel>& onlineChannels) const {
+    onlineChannels.resize(offlineChannels.size());
+    online(offlineChannels.data(), offlineChannels.size(), onlineChannels.data());
+  }
+
   // Print parameters.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const =0;
 
@@ -11,6 +11,7 @@
 #include <vector>
 #include <iostream>
 #include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include "dunecore/DuneInterface/Data/AdcNoiseBank.h"
 
 namespace detinfo {
   class DetectorClocksData;
@@ -31,6 +32,17 @@ public:
                        detinfo::DetectorPropertiesData const& detProp,
                        Channel chan, AdcSignalVector& sigs) const =0;
   virtual void newEvent() {};
+
+  // Optional noise bank extension.
+  // An implementation may pre-generate pools of noise waveforms, e.g. one for each
+  // plane, with batched FFTs in buildNoiseBank and then draw offsets into those pools
+  // in addNoise. buildNoiseBank is called once before the first addNoise and returns
+  // nonzero for failure. noiseBank returns the bank or null if there is none.
+  // The defaults build nothing so that noise is generated in each addNoise call.
+  virtual int buildNoiseBank(detinfo::DetectorClocksData const&,
+                             detinfo::DetectorPropertiesData const&) { return 0; }
+  virtual const AdcNoiseBank* noiseBank() const { return nullptr; }
+
   // Print parameters.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const =0;
 
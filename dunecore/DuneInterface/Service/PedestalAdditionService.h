@@ -13,6 +13,7 @@
 #include <iostream>
 #include <vector>
 #include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include "dunecore/DuneInterface/Data/AdcChannelBlock.h"
 
 namespace sim {
 class SimChannel;
@@ -31,6 +32,30 @@ public:
   // The pedestal and its RMS are returned in ped and pedrms.
   virtual int addPedestal(Channel chan, AdcSignalVector& sigs, float& ped, float& pedrms) const =0;
 
+  // Add pedestals to each row of a channel x tick block, e.g. for a plane.
+  // The pedestal and RMS for each row are returned in peds and pedrmss.
+  // The default calls addPedestal for each row. Implementations may override this
+  // to fill the block in one pass. Pedestal noise should then be drawn with a
+  // counter-based generator such as PhiloxRandom keyed on the channel, so that
+  // the result does not depend on how the rows are split across threads.
+  // Returns the first nonzero row status.
+  virtual int addPedestals(AdcChannelBlock& blk, std::vector<float>& peds, std::vector<float>& pedrmss) const {
+    AdcIndex nrow = blk.nrow();
+    AdcIndex ntick = blk.ntick();
+    peds.assign(nrow, 0.0);
+    pedrmss.assign(nrow, 0.0);
+    int rstat = 0;
+    AdcSignalVector sigs;
+    for ( AdcIndex irow=0; irow<nrow; ++irow ) {
+      AdcSignal* prow = blk.samples(irow);
+      sigs.assign(prow, prow + ntick);
+      int cstat = addPedestal(blk.channel(irow), sigs, peds[irow], pedrmss[irow]);
+      for ( AdcIndex itck=0; itck<ntick; ++itck ) prow[itck] = sigs[itck];
+      if ( cstat != 0 && rstat == 0 ) rstat = cstat;
+    }
+    return rstat;
+  }
+
   // Print parameters.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const =0;
 
@@ -49,6 +49,22 @@ public:
                       std::vector<recob::Wire>* pwires =nullptr,
                       WiredAdcChannelDataMap* pwiredData =nullptr) const =0;
 
+  // Prepare one batch of channels for the current event, e.g. those for one APA.
+  // This allows an event to be prepared incrementally as the decoder produces the
+  // batches, e.g. with AdcChannelDataPipeline, so that only a few batches need be in
+  // memory at once. The batches for an event are disjoint and are passed between
+  // beginEvent and endEvent, one at a time and in any order. The remaining arguments
+  // are as for prepare. The default calls prepare for the batch, which is correct for
+  // implementations whose steps act within a batch, e.g. coherent noise removal over
+  // one APA. Implementations with steps that combine channels across batches should
+  // override this.
+  virtual int prepareBatch(detinfo::DetectorClocksData const& clockData,
+                           AdcChannelDataMap& batch,
+                           std::vector<recob::Wire>* pwires =nullptr,
+                           WiredAdcChannelDataMap* pwiredData =nullptr) const {
+    return prepare(clockData, batch, pwires, pwiredData);
+  }
+
   // Print parameters.
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const =0;
 
@@ -7,10 +7,16 @@
 //
 // I have simple adopted the interface used in SignalShapingServiceDUNE.
 // A method to return the expected size for the signal vector has been added.
+//
+// The block methods convolute or deconvolute each row of an AdcChannelBlock, e.g. all
+// the channels of a view, in one call. The default implementations call the
+// single-channel methods for each row. Services override them to transform the rows
+// together.
 
 #ifndef SignalShapingService_H
 #define SignalShapingService_H
 
+#include "dunecore/DuneInterface/Data/AdcChannelBlock.h"
 #include <vector>
 
 namespace detinfo {
@@ -51,7 +57,43 @@ public:
   // Do deconvolution calcution (for reconstruction).
   virtual void Deconvolute(detinfo::DetectorClocksData const& clockData, Channel channel,  FloatVector& sigs) const =0;
   virtual void Deconvolute(detinfo::DetectorClocksData const& clockData, Channel channel, DoubleVector& sigs) const =0;
+
+  // Convolution and deconvolution of each row of a channel block.
+  // The block tick count must be the signal size.
+  virtual void Convolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const;
+  virtual void Deconvolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const;
+
+private:
+
+  // Apply the single-channel convolution or deconvolution to each row of a block.
+  void transformRows(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk, bool decon) const;
     
 };
 
+//**********************************************************************
+
+inline void SignalShapingService::
+Convolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const {
+  transformRows(clockData, blk, false);
+}
+
+inline void SignalShapingService::
+Deconvolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const {
+  transformRows(clockData, blk, true);
+}
+
+inline void SignalShapingService::
+transformRows(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk, bool decon) const {
+  using Index = AdcChannelBlock::Index;
+  Index ntck = blk.ntick();
+  FloatVector sigs;
+  for ( Index irow=0; irow<blk.nrow(); ++irow ) {
+    AdcSignal* psam = blk.samples(irow);
+    sigs.assign(psam, psam + ntck);
+    if ( decon ) Deconvolute(clockData, blk.channel(irow), sigs);
+    else Convolute(clockData, blk.channel(irow), sigs);
+    for ( Index itck=0; itck<ntck; ++itck ) psam[itck] = itck < sigs.size() ? sigs[itck] : 0.0;
+  }
+}
+
 #endif
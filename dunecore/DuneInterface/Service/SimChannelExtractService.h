@@ -12,6 +12,7 @@
 #include <vector>
 #include <iostream>
 #include "dunecore/DuneInterface/Data/AdcTypes.h"
+#include "dunecore/DuneInterface/Data/AdcSignalRun.h"
 
 namespace detinfo {
   class DetectorClocksData;
@@ -30,6 +31,18 @@ public:
   virtual int extract(detinfo::DetectorClocksData const& clockData,
                       const sim::SimChannel* psc, AdcSignalVector& sig) const =0;
 
+  // Sparse extraction: the charge as runs of contiguous ticks in increasing tick order.
+  // Most channels have charge in only a few ticks and implementations may override this
+  // to fill only those. The default extracts the dense vector and collects its nonzero runs.
+  virtual int extractSparse(detinfo::DetectorClocksData const& clockData,
+                            const sim::SimChannel* psc, AdcSignalRunVector& runs) const {
+    AdcSignalVector sig;
+    int rstat = extract(clockData, psc, sig);
+    if ( rstat != 0 ) return rstat;
+    fromDense(sig, runs);
+    return 0;
+  }
+
   virtual std::ostream& print(std::ostream& out =std::cout, std::string prefix ="") const =0;
 
 };
@@ -5,12 +5,29 @@
 //
 // Interface for a tool that builds a string from AdcChannelData, 
 // a DataMap and a string pattern.
+//
+// Building may be split into an event part and a channel part so that callers
+// that build the same patterns for many channels need not substitute the run,
+// event, etc. fields for each channel:
+//   buildEvent substitutes only the fields that depend on the event info
+//   buildChannel substitutes the remaining fields into the result of buildEvent
+// The defaults leave the pattern unchanged in buildEvent and use build for the
+// channel part. Implementations that override them may precompile the patterns,
+// e.g. with StringTemplate, so that only the channel fields are formatted.
+//
+// AdcChannelStringCache holds the event part for each pattern and rebuilds it
+// only when the event changes:
+//   AdcChannelStringCache m_namCache;
+//   ...
+//   std::string hnam = m_namCache.build(m_adcStringBuilder, acd, dm, "hadc_run%RUN%_ch%CHAN%");
 
 #ifndef AdcChannelStringTool_H
 #define AdcChannelStringTool_H
 
 #include "dunecore/DuneInterface/Data/AdcChannelData.h"
 #include "dunecore/DuneInterface/Data/DataMap.h"
+#include <map>
+#include <tuple>
 
 class AdcChannelStringTool {
 
@@ -38,6 +55,67 @@ public:
   virtual std::string
   build(const AdcChannelData& acd, const DataMap& dm, std::string spat) const =0;
 
+  // Substitute only the event fields. The result may depend only on the event info of acd.
+  virtual std::string
+  buildEvent(const AdcChannelData&, const DataMap&, std::string spat) const { return spat; }
+
+  // Substitute the remaining fields in a pattern returned by buildEvent.
+  virtual std::string
+  buildChannel(const AdcChannelData& acd, const DataMap& dm, std::string sevt) const {
+    return build(acd, dm, sevt);
+  }
+
+};
+
+//**********************************************************************
+
+// Cache of the event part of string patterns.
+// One cache should be used for each thread.
+class AdcChannelStringCache {
+
+public:
+
+  using Index = AdcChannelStringTool::Index;
+  using Name = std::string;
+  using EventKey = std::tuple<Index, Index, Index, const AdcChannelStringTool*>;
+
+  // Build the string for acd from pattern spat. The event part is reused if the tool,
+  // run, subrun and event are those of the previous call for the pattern.
+  // Returns spat if ptool is null.
+  Name build(const AdcChannelStringTool* ptool, const AdcChannelData& acd,
+             const DataMap& dm, const Name& spat) {
+    if ( ptool == nullptr ) return spat;
+    EventKey key(acd.run(), acd.subRun(), acd.event(), ptool);
+    Entry& ent = m_entries[spat];
+    if ( ! ent.valid || ent.key != key ) {
+      ent.sevt = ptool->buildEvent(acd, dm, spat);
+      ent.key = key;
+      ent.valid = true;
+    }
+    return ptool->buildChannel(acd, dm, ent.sevt);
+  }
+
+  // Same without data map.
+  Name build(const AdcChannelStringTool* ptool, const AdcChannelData& acd, const Name& spat) {
+    return build(ptool, acd, DataMap(), spat);
+  }
+
+  // Number of cached patterns.
+  Index size() const { return m_entries.size(); }
+
+  // Drop the cached patterns.
+  void clear() { m_entries.clear(); }
+
+private:
+
+  struct Entry {
+    bool valid = false;
+    EventKey key;
+    Name sevt;
+  };
+
+  std::map<Name, Entry> m_entries;
+
 };
 
 #endif
@@ -40,6 +40,21 @@
 // The single-object methods view(acd) and update(acd) will return status
 // interfaceNotImplemented().
 //
+// The flat variants updateFlatMap and viewFlatMap accept AdcChannelDataFlatMap.
+// By default, updateFlatMap moves the data into a temporary map, calls
+// updateMap and moves the data back, so it works for all tools. viewFlatMap
+// loops over channels calling view(acd) as viewMap does, so tools that override
+// viewMap should also override viewFlatMap. Multi-channel tools may override
+// both to take advantage of the contiguous storage.
+//
+// Tools whose update(acd) and view(acd) may be called concurrently for different
+// channels, i.e. that do not modify shared state or do so in a thread-safe way,
+// may override channelParallel() to return true. The default updateMap(acds) and
+// viewMap(acds) (and their flat variants) then evaluate the channels in parallel with
+// TBB, within the arena of the caller (e.g. that set by art for the job), and merge
+// the results in channel order so the returned DataMap is the same as for serial
+// processing. TpcDataTool provides the analogous mapParallel() for TpcData.
+//
 // Discussion of this interface may be found at
 //   https://cdcvs.fnal.gov/redmine/issues/19661
 
@@ -47,9 +62,13 @@
 #define AdcChannelTool_H
 
 #include "dunecore/DuneInterface/Data/AdcChannelData.h"
+#include "dunecore/DuneInterface/Data/AdcChannelDataFlatMap.h"
 #include "dunecore/DuneInterface/Data/DataMap.h"
 #include "dunecore/DuneInterface/Data/DuneEventInfo.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include <set>
+#include <vector>
 
 class AdcChannelTool {
 
@@ -83,6 +102,14 @@ public:
   // The status is set to the number of failures.
   virtual DataMap viewMap(const AdcChannelDataMap& acds) const;
 
+  // Modify data for multiple channels held in a flat map.
+  // Default moves the data into a map, calls updateMap and moves it back.
+  virtual DataMap updateFlatMap(AdcChannelDataFlatMap& acds) const;
+
+  // View data for multiple channels held in a flat map.
+  // Default calls view for each channel as viewMap does.
+  virtual DataMap viewFlatMap(const AdcChannelDataFlatMap& acds) const;
+
   // Methods indicating if calls to update should be forwarded to view
   // or vice versa. Implementers should override neither or one  to
   // return true.
@@ -96,6 +123,10 @@ public:
   // In both cases, the passed dat is first copied.
   virtual bool viewWithUpdate() const { return false; }
 
+  // If this is true, the default map methods may call update or view
+  // concurrently for different channels.
+  virtual bool channelParallel() const { return false; }
+
   // Optional call at the start of processing an event.
   virtual DataMap beginEvent(const DuneEventInfo&) const { return DataMap(); }
 
@@ -109,12 +140,37 @@ public:
   // Argument provides means to pass data in.
   virtual DataMap close(const DataMap* dmin =nullptr) { return DataMap(); }
 
+protected:
+
+  // Evaluate fun(acd) in parallel for each entry in a channel container and
+  // return the results in entry order.
+  template<class C, class F>
+  static std::vector<DataMap> evaluateChannels(C& acds, F fun);
+
 };
 
 //**********************************************************************
 // Definitions for the above declarations.
 //**********************************************************************
 
+template<class C, class F>
+std::vector<DataMap> AdcChannelTool::evaluateChannels(C& acds, F fun) {
+  using Entry = decltype(&*acds.begin());
+  std::vector<Entry> ents;
+  ents.reserve(acds.size());
+  for ( auto& iacd : acds ) ents.push_back(&iacd);
+  std::vector<DataMap> dms(ents.size());
+  tbb::parallel_for(tbb::blocked_range<Index>(0, ents.size()),
+                    [&](const tbb::blocked_range<Index>& ients) {
+    for ( Index ient=ients.begin(); ient<ients.end(); ++ient ) {
+      dms[ient] = fun(ents[ient]->second);
+    }
+  });
+  return dms;
+}
+
+//**********************************************************************
+
 inline
 DataMap AdcChannelTool::update(AdcChannelData& acd) const {
   if ( updateWithView() ) return view(acd);
@@ -140,15 +196,19 @@ DataMap AdcChannelTool::updateMap(AdcChannelDataMap& acds) const {
   DataMap ret;
   DataMap::IntVector failedChannels;
   std::set<int> failedCodeSet;
+  bool par = channelParallel() && acds.size() > 1;
+  std::vector<DataMap> dms;
+  if ( par ) dms = evaluateChannels(acds, [this](AdcChannelData& acd) { return update(acd); });
+  Index ient = 0;
   for ( AdcChannelDataMap::value_type& iacd : acds ) {
-    DataMap dm = update(iacd.second);
+    DataMap dm = par ? std::move(dms[ient++]) : update(iacd.second);
     if ( dm.status() == interfaceNotImplemented() ) return DataMap(interfaceNotImplemented());
     else if ( dm.status() ) {
       failedChannels.push_back(iacd.first);
       failedCodeSet.insert(dm.status());
       if ( ! ret.status() ) ret.setStatus(dm.status());
     }
-    else ret += dm;
+    else ret += std::move(dm);
   }
   DataMap::IntVector failedCodes(failedCodeSet.begin(), failedCodeSet.end());
   ret.setIntVector("failedChannels", failedChannels);
@@ -166,11 +226,52 @@ DataMap AdcChannelTool::viewMap(const AdcChannelDataMap& acds) const {
   }
   DataMap ret;
   int nfail = 0;
+  bool par = channelParallel() && acds.size() > 1;
+  std::vector<DataMap> dms;
+  if ( par ) dms = evaluateChannels(acds, [this](const AdcChannelData& acd) { return view(acd); });
+  Index ient = 0;
   for ( const AdcChannelDataMap::value_type& iacd : acds ) {
-    DataMap dm = view(iacd.second);
+    DataMap dm = par ? std::move(dms[ient++]) : view(iacd.second);
+    if ( dm.status() == interfaceNotImplemented() ) return DataMap(interfaceNotImplemented());
+    else if ( dm.status() ) ++nfail;
+    else ret += std::move(dm);
+  }
+  ret.setStatus(nfail);
+  return ret;
+}
+
+//**********************************************************************
+
+inline
+DataMap AdcChannelTool::updateFlatMap(AdcChannelDataFlatMap& acds) const {
+  if ( updateWithView() ) return viewFlatMap(acds);
+  AdcChannelDataMap acdmap;
+  acds.moveTo(acdmap);
+  DataMap ret = updateMap(acdmap);
+  acds.moveFrom(acdmap);
+  return ret;
+}
+
+//**********************************************************************
+
+inline
+DataMap AdcChannelTool::viewFlatMap(const AdcChannelDataFlatMap& acds) const {
+  if ( viewWithUpdate() ) {
+    AdcChannelDataMap adcstmp;
+    for ( const AdcChannelDataFlatMap::value_type& iacd : acds ) adcstmp.emplace(iacd.first, iacd.second);
+    return updateMap(adcstmp);
+  }
+  DataMap ret;
+  int nfail = 0;
+  bool par = channelParallel() && acds.size() > 1;
+  std::vector<DataMap> dms;
+  if ( par ) dms = evaluateChannels(acds, [this](const AdcChannelData& acd) { return view(acd); });
+  Index ient = 0;
+  for ( const AdcChannelDataFlatMap::value_type& iacd : acds ) {
+    DataMap dm = par ? std::move(dms[ient++]) : view(iacd.second);
     if ( dm.status() == interfaceNotImplemented() ) return DataMap(interfaceNotImplemented());
     else if ( dm.status() ) ++nfail;
-    else ret += dm;
+    else ret += std::move(dm);
   }
   ret.setStatus(nfail);
   return ret;
@@ -6,11 +6,17 @@
 // Interface for a tool providing access to an array
 // of floating values. It also holds an offset, i.e.
 // the index of the first value, and a label.
+//
+// The values are a contiguous table that callers may read directly in hot loops.
+// It is stable until version() changes. FloatArrayView caches the table and
+// provides the value methods without virtual calls.
 
 #ifndef FloatArrayTool_H
 #define FloatArrayTool_H
 
 #include <vector>
+#include <string>
+#include <algorithm>
 
 class FloatArrayTool {
 
@@ -70,6 +76,72 @@ public:
     return 0;
   }
 
+  // Counter changed whenever the values change.
+  virtual Index version() const { return 0; }
+
+};
+
+//**********************************************************************
+
+// Non-virtual access to a FloatArrayTool. The value methods match those of
+// FloatArrayTool for tools that do not override them.
+class FloatArrayView {
+
+public:
+
+  using Index = FloatArrayTool::Index;
+
+  // Ctor from a tool, which may be null.
+  explicit FloatArrayView(const FloatArrayTool* ptool =nullptr) { reset(ptool); }
+
+  // Take the table and version from a tool.
+  void reset(const FloatArrayTool* ptool) {
+    m_ptool = ptool;
+    if ( ptool == nullptr ) {
+      m_pval = nullptr;
+      m_nval = 0;
+      m_offset = 0;
+      m_defval = 0.0;
+      m_version = 0;
+      return;
+    }
+    m_pval = ptool->values().data();
+    m_nval = ptool->size();
+    m_offset = ptool->offset();
+    m_defval = ptool->defaultValue();
+    m_version = ptool->version();
+  }
+
+  // Retake the table if the tool version has changed. Returns true if it had.
+  bool refresh() {
+    if ( isCurrent() ) return false;
+    reset(m_ptool);
+    return true;
+  }
+
+  // Return if the view matches the current tool version.
+  bool isCurrent() const { return m_ptool == nullptr || m_ptool->version() == m_version; }
+
+  // Table access.
+  Index offset() const { return m_offset; }
+  Index size() const { return m_nval; }
+  const float* data() const { return m_pval; }
+  float defaultValue() const { return m_defval; }
+
+  // Value access as in FloatArrayTool.
+  bool inRange(Index ival) const { return ival >= m_offset && ival + m_offset < m_nval; }
+  float value(Index ival) const { return inRange(ival) ? m_pval[ival + m_offset] : m_defval; }
+  float value(Index ival, float defval) const { return inRange(ival) ? m_pval[ival + m_offset] : defval; }
+
+private:
+
+  const FloatArrayTool* m_ptool = nullptr;
+  const float* m_pval = nullptr;
+  Index m_nval = 0;
+  Index m_offset = 0;
+  float m_defval = 0.0;
+  Index m_version = 0;
+
 };
 
 #endif
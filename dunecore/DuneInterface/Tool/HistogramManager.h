@@ -8,6 +8,11 @@
 // Ih histogram has an associated directory, then the tool
 // should unset that association and take mangement, i.e. ensure
 // the histogram is deleted at the appropriate time.
+//
+// Histograms may also be accessed by an integer ID assigned when they are
+// managed. Fills made with fill(id, ...) may be buffered, e.g. per thread,
+// so that they can be made concurrently. Buffered fills are added to the
+// histograms by flush() which must not be called concurrently with fill.
 
 #ifndef HistogramManager_H
 #define HistogramManager_H
@@ -23,6 +28,9 @@ public:
 
   using Name = std::string;
   using NameVector = std::vector<Name>;
+  using Index = unsigned int;
+
+  static Index badIndex() { return -1; }
 
   virtual ~HistogramManager() =default;
 
@@ -42,6 +50,18 @@ public:
   // Defult argument "* releases all histograms.
   virtual int release(Name hname ="*") =0;
 
+  // Return the ID for a managed histogram or badIndex() if it is not found.
+  virtual Index id(Name) const { return badIndex(); }
+
+  // Return the histogram for an ID.
+  virtual TH1* getById(Index) const { return nullptr; }
+
+  // Fill the histogram with an ID. Returns nonzero for error.
+  virtual int fill(Index, double, double =1.0) { return 1; }
+
+  // Add any buffered fills to the histograms. Returns nonzero for error.
+  virtual int flush() { return 0; }
+
 };
 
 #endif
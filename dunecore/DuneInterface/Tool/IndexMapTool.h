@@ -5,6 +5,17 @@
 //
 // Interface for tools that map one index to another, e.g.
 // online to offline channel or vice versa.
+//
+// getMany maps many indices in a single call so that a full-detector lookup need
+// not make one virtual call per index. By default it calls get for each. It is not
+// an overload of get so that subclasses overriding get do not hide it.
+//
+// Tools backed by a table may expose it with table() and tableSize() so that callers
+// can index it directly in hot loops. The table is stable until version() changes.
+// IndexMapView wraps a tool and uses the table where there is one and virtual calls
+// otherwise:
+//   IndexMapView view(pimt);
+//   for ( Index icha : chans ) sta[icha] = view.get(icha);
 
 #ifndef IndexMapTool_H
 #define IndexMapTool_H
@@ -21,6 +32,69 @@ public:
 
   virtual Index get(Index idx) const =0;
 
+  // Map the nidx indices in pidx to pval.
+  virtual void getMany(const Index* pidx, Index nidx, Index* pval) const {
+    for ( Index iidx=0; iidx<nidx; ++iidx ) pval[iidx] = get(pidx[iidx]);
+  }
+
+  // Dense view: if not null, table()[idx] == get(idx) for all idx < tableSize().
+  virtual const Index* table() const { return nullptr; }
+  virtual Index tableSize() const { return 0; }
+
+  // Counter changed whenever the map (and so any table) changes.
+  virtual Index version() const { return 0; }
+
+};
+
+//**********************************************************************
+
+// Non-virtual access to an IndexMapTool, using its table where there is one.
+class IndexMapView {
+
+public:
+
+  using Index = IndexMapTool::Index;
+
+  // Ctor from a tool, which may be null.
+  explicit IndexMapView(const IndexMapTool* ptool =nullptr) { reset(ptool); }
+
+  // Take the table and version from a tool.
+  void reset(const IndexMapTool* ptool) {
+    m_ptool = ptool;
+    m_ptab = ptool == nullptr ? nullptr : ptool->table();
+    m_ntab = m_ptab == nullptr ? 0 : ptool->tableSize();
+    m_version = ptool == nullptr ? 0 : ptool->version();
+  }
+
+  // Retake the table if the tool version has changed. Returns true if it had.
+  bool refresh() {
+    if ( isCurrent() ) return false;
+    reset(m_ptool);
+    return true;
+  }
+
+  // Return if the view matches the current tool version.
+  bool isCurrent() const { return m_ptool == nullptr || m_ptool->version() == m_version; }
+
+  // Return if there is a table, its size and data.
+  bool isDense() const { return m_ptab != nullptr; }
+  Index size() const { return m_ntab; }
+  const Index* data() const { return m_ptab; }
+
+  // Map an index. Indices beyond the table use the tool.
+  // Returns IndexMapTool::badIndex() if there is no tool.
+  Index get(Index idx) const {
+    if ( idx < m_ntab ) return m_ptab[idx];
+    return m_ptool == nullptr ? IndexMapTool::badIndex() : m_ptool->get(idx);
+  }
+
+private:
+
+  const IndexMapTool* m_ptool = nullptr;
+  const Index* m_ptab = nullptr;
+  Index m_ntab = 0;
+  Index m_version = 0;
+
 };
 
 #endif
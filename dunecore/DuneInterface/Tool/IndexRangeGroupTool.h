@@ -9,6 +9,7 @@
 #define IndexRangeGroupTool_H
 
 #include "dunecore/DuneInterface/Data/IndexRangeGroup.h"
+#include "dunecore/DuneInterface/Data/IndexRangeLookup.h"
 
 class IndexRangeGroupTool {
 
@@ -20,6 +21,10 @@ public:
 
   virtual IndexRangeGroup get(Name nam) const =0;
 
+  // Return a lookup holding all the groups provided by the tool, with IDs and a
+  // table of the groups containing each index, or null if the tool does not provide one.
+  virtual const IndexRangeLookup* lookup() const { return nullptr; }
+
 };
 
 #endif
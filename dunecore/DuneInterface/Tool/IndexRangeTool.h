@@ -9,6 +9,7 @@
 #define IndexRangeTool_H
 
 #include "dunecore/DuneInterface/Data/IndexRange.h"
+#include "dunecore/DuneInterface/Data/IndexRangeLookup.h"
 
 class IndexRangeTool {
 
@@ -20,6 +21,10 @@ public:
 
   virtual IndexRange get(Name nam) const =0;
 
+  // Return a lookup holding all the ranges provided by the tool, with IDs and a
+  // table of the ranges containing each index, or null if the tool does not provide one.
+  virtual const IndexRangeLookup* lookup() const { return nullptr; }
+
 };
 
 #endif
@@ -5,6 +5,8 @@
 // June 2020: Change get to return by balue instead of ref.
 //
 // Interface for tools that map one index to a vector of indices.
+//
+// getMany maps many indices in a single call. By default it calls get for each.
 
 #ifndef IndexVectorMapTool_H
 #define IndexVectorMapTool_H
@@ -26,6 +28,11 @@ public:
   // Return the vector for an index.
   virtual IndexVector get(Index idx) const =0;
 
+  // Fill pvecs[i] with the vector for index pidx[i] for the nidx indices.
+  virtual void getMany(const Index* pidx, Index nidx, IndexVector* pvecs) const {
+    for ( Index iidx=0; iidx<nidx; ++iidx ) pvecs[iidx] = get(pidx[iidx]);
+  }
+
   // Return if the vector for an index contains a value.
   virtual bool contains(Index idx, Index val) {
     IndexVector vec = get(idx);
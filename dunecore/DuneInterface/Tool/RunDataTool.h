@@ -4,19 +4,29 @@
 #define RunDataTool_H
 
 // Interface for a tool providing access to run conditions data.
+//
+// Jobs that know their runs in advance, e.g. from the input file list, may call
+// prefetch at the start of the job so that the first runData call for each run
+// does not wait for the data to be found and read.
 
 #include "dunecore/DuneInterface/Data/RunData.h"
+#include <vector>
 
 class RunDataTool {
 
 public:
 
   using Index = unsigned int;
+  using IndexVector = std::vector<Index>;
 
   virtual ~RunDataTool() =default;
 
   virtual RunData runData(Index run, Index subRun =0) const =0;
 
+  // Start resolving the data for runs (all with subrun subRun) in the background.
+  // Returns the number of runs scheduled. The default schedules none.
+  virtual Index prefetch(const IndexVector& /*runs*/, Index /*subRun*/ =0) const { return 0; }
+
 };
 
 #endif
@@ -5,6 +5,14 @@
 
 // Interface for a tool providing access to a timing offset,
 // e.g. for the ADC samples from a TPC.
+//
+// Tools whose offset is an affine function of the trigger clock may also
+// return an Evaluator holding the constants for that function. It is valid
+// for all data with the same run, subrun, channel and FEMB ID as the datum
+// used to build it, so a decoder can fetch it once, e.g. per run and channel,
+// and then compute each offset inline without virtual calls:
+//   TimeOffsetTool::Evaluator eval = ptool->evaluator(dat);
+//   if ( eval.isValid() ) tick0 = eval.value(dat.triggerClock);
 
 #include<string>
 
@@ -41,10 +49,63 @@ public:
     const Offset& setStatus(int val) { status = val; return *this; }
   };
 
+  // Offset constants for one run and channel. With
+  //   num = mult*triggerClock + phase
+  // the offset value is
+  //   base + num/period             if not scaled (integer division)
+  //   base + long(scale*num/period) if scaled
+  // and its remainder is baseRem + (num%period)/period.
+  // Status is nonzero if the tool does not provide an evaluator or the data
+  // are invalid. The unit is that of the tool offsets.
+  class Evaluator {
+  public:
+    int status =1;
+    long base =0;
+    double baseRem =0.0;
+    long mult =0;
+    long phase =0;
+    long period =1;
+    bool scaled =false;
+    double scale =1.0;
+    bool isValid() const { return status == 0; }
+    long value(LongIndex clock) const {
+      long num = mult*long(clock) + phase;
+      if ( scaled ) return base + long(scale*num/period);
+      return base + num/period;
+    }
+    double rem(LongIndex clock) const {
+      long num = mult*long(clock) + phase;
+      return baseRem + double(num - period*(num/period))/period;
+    }
+    // Fill the status, value and remainder of an offset. The unit is not set.
+    void fill(LongIndex clock, Offset& off) const {
+      off.status = status;
+      off.value = value(clock);
+      off.rem = rem(clock);
+    }
+  };
+
   virtual ~TimeOffsetTool() =default;
 
   virtual Offset offset(const Data& dat) const =0;
 
+  // Return the evaluator for data like dat. The default has nonzero status,
+  // i.e. callers must use offset or offsets.
+  virtual Evaluator evaluator(const Data&) const { return Evaluator(); }
+
+  // Fill the offsets poffs for ndat data pdats.
+  // Subclasses may override this to share the per-call work, e.g. the run
+  // data lookup, between the data.
+  // Returns the number of invalid offsets.
+  virtual Index offsets(const Data* pdats, Index ndat, Offset* poffs) const {
+    Index nbad = 0;
+    for ( Index idat=0; idat<ndat; ++idat ) {
+      poffs[idat] = offset(pdats[idat]);
+      if ( ! poffs[idat].isValid() ) ++nbad;
+    }
+    return nbad;
+  }
+
 };
 
 #endif
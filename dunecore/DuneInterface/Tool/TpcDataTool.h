@@ -7,12 +7,28 @@
 //
 // It inherits from AdcChannelTool and the default implementation here
 // calls the ADC channel map methods of that class.
+//
+// Tools whose updateMap and viewMap may be called concurrently for different
+// maps, e.g. the APAs in TpcData, may override mapParallel() to return true.
+// The default TpcData methods then process the maps in parallel with TBB, each
+// on the NUMA node that NumaPlacement assigns to its position in the TpcData.
+//
+// The default TpcData methods combine the results for the maps in map order with
+// mergeMapResult, which by default moves each into the sum with operator+=, so
+// statuses add and later entries overwrite earlier ones with the same name. Tools
+// may override mergeMapResult to e.g. sum counts. If any map returns
+// interfaceNotImplemented(), that is returned.
+//
+// With TraceRecorder enabled, each call of fun for a map is recorded as a span
+// with the map index and channel range.
 
 #ifndef TpcDataTool_H
 #define TpcDataTool_H
 
 #include "dunecore/DuneInterface/Tool/AdcChannelTool.h"
 #include "dunecore/DuneInterface/Data/TpcData.h"
+#include "dunecore/DuneInterface/Data/NumaPlacement.h"
+#include "dunecore/DuneInterface/Data/TraceRecorder.h"
 
 class TpcDataTool : public AdcChannelTool {
 
@@ -29,20 +45,72 @@ public:
   //   1: AdcChannelDataMap
   virtual int forwardTpcData() const { return 1; }
 
+  // If this is true, the default TpcData methods may call updateMap or
+  // viewMap concurrently for different maps.
+  virtual bool mapParallel() const { return false; }
+
+protected:
+
+  // Merge the result dm for the map with index iadc in TpcData into dmsum.
+  virtual void mergeMapResult(DataMap& dmsum, DataMap&& dm, Index /*iadc*/) const {
+    dmsum += std::move(dm);
+  }
+
+  // Evaluate fun(acds) for each non-null map in tpd, in parallel if
+  // mapParallel() is true, and return the merged result.
+  template<class T, class F>
+  DataMap evaluateMaps(T& tpd, F fun) const;
+
 };
 
 //**********************************************************************
 // Definitions for the above declarations.
 //**********************************************************************
 
+template<class T, class F>
+DataMap TpcDataTool::evaluateMaps(T& tpd, F fun) const {
+  std::vector<TpcData::AdcDataPtr> padcs;
+  // NUMA node of each map, from its position in the TpcData as for the decoder.
+  const NumaPlacement& plc = NumaPlacement::instance();
+  NumaPlacement::IndexVector nodes;
+  NumaPlacement::IndexVector imaps;
+  Index nmap = tpd.getAdcData().size();
+  for ( Index imap=0; imap<nmap; ++imap ) {
+    TpcData::AdcDataPtr padc = tpd.getAdcData()[imap];
+    if ( ! padc ) continue;
+    padcs.push_back(padc);
+    nodes.push_back(plc.node(imap, nmap));
+    imaps.push_back(imap);
+  }
+  std::vector<DataMap> dms(padcs.size());
+  auto evaluate = [&](Index iadc) {
+    TraceSpan span("tool", "TpcDataTool::evaluateMap");
+    if ( span.active() ) {
+      const AdcChannelDataMap& acds = *padcs[iadc];
+      span.arg("map", imaps[iadc]).arg("node", nodes[iadc]).arg("nchan", acds.size());
+      if ( acds.size() ) span.arg("channel", acds.begin()->first);
+    }
+    dms[iadc] = fun(*padcs[iadc]);
+  };
+  if ( mapParallel() && padcs.size() > 1 ) {
+    plc.parallelFor(nodes, evaluate);
+  } else {
+    for ( Index iadc=0; iadc<padcs.size(); ++iadc ) evaluate(iadc);
+  }
+  DataMap dmsum;
+  for ( Index iadc=0; iadc<dms.size(); ++iadc ) {
+    if ( dms[iadc].status() == interfaceNotImplemented() ) return DataMap(interfaceNotImplemented());
+    mergeMapResult(dmsum, std::move(dms[iadc]), iadc);
+  }
+  return dmsum;
+}
+
+//**********************************************************************
+
 inline
 DataMap TpcDataTool::updateTpcData(TpcData& tpd) const {
   if ( forwardTpcData() == 1 ) {
-    DataMap dm;
-    for ( TpcData::AdcDataPtr padc : tpd.getAdcData() ) {
-      if ( padc ) dm = updateMap(*padc);
-    }
-    return dm;
+    return evaluateMaps(tpd, [this](AdcChannelDataMap& acds) { return updateMap(acds); });
   } else if ( updateWithView() ) {
     return viewTpcData(tpd);
   }
@@ -54,11 +122,7 @@ DataMap TpcDataTool::updateTpcData(TpcData& tpd) const {
 inline
 DataMap TpcDataTool::viewTpcData(const TpcData& tpd) const {
   if ( forwardTpcData() == 1 ) {
-    DataMap dm;
-    for ( TpcData::AdcDataPtr padc : tpd.getAdcData() ) {
-      if ( padc ) dm = viewMap(*padc);
-    }
-    return dm;
+    return evaluateMaps(tpd, [this](const AdcChannelDataMap& acds) { return viewMap(acds); });
   }
   // We do not copy TpcData.
   return DataMap(interfaceNotImplemented());
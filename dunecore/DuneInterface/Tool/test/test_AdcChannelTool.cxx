@@ -59,6 +59,15 @@ DataMap AdcChannelTool_update::update(AdcChannelData& acd) const {
 
 //**********************************************************************
 
+// Same tool with parallel channel dispatch.
+
+class AdcChannelTool_parallel : public AdcChannelTool_update {
+public:
+  bool channelParallel() const override { return true; }
+};
+
+//**********************************************************************
+
 // Test with all default methods.
 
 int test_AdcChannelTool_default() {
@@ -103,6 +112,20 @@ int test_AdcChannelTool_default() {
   assert( ret == act.interfaceNotImplemented() );
   ret.print();
 
+  cout << myname << line << endl;
+  cout << myname << "Call updateFlatMap." << endl;
+  AdcChannelDataFlatMap facds(makeAdcData(ncha));
+  ret = act.updateFlatMap(facds);
+  assert( ret == act.interfaceNotImplemented() );
+  assert( facds.size() == ncha );
+  ret.print();
+
+  cout << myname << line << endl;
+  cout << myname << "Call viewFlatMap." << endl;
+  ret = act.viewFlatMap(facds);
+  assert( ret == act.interfaceNotImplemented() );
+  ret.print();
+
   cout << myname << line << endl;
   cout << myname << "Test complete." << endl;
 
@@ -175,6 +198,81 @@ int test_AdcChannelTool_update() {
     assert(acd.channel() == icha);
     assert(acd.fembID() == 200);
   }
+
+  cout << myname << line << endl;
+  cout << myname << "Call updateFlatMap." << endl;
+  AdcChannelDataFlatMap facds(makeAdcData(ncha));
+  ret = act.updateFlatMap(facds);
+  ret.print();
+  assert( ! ret );
+  assert( facds.size() == ncha );
+  for ( const auto& iacd : facds ) {
+    Index icha = iacd.first;
+    const AdcChannelData& acd = iacd.second;
+    assert(acd.channel() == icha);
+    assert(acd.fembID() == 100 + acd.channel());
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Call viewFlatMap." << endl;
+  for ( auto& iacd : facds ) iacd.second.setChannelInfo(iacd.second.channel(), 200);
+  ret = act.viewFlatMap(facds);
+  ret.print();
+  assert( ! ret );
+  for ( const auto& iacd : facds ) {
+    Index icha = iacd.first;
+    const AdcChannelData& acd = iacd.second;
+    assert(acd.channel() == icha);
+    assert(acd.fembID() == 200);
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Test complete." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+// Test parallel dispatch.
+
+int test_AdcChannelTool_parallel() {
+  const string myname = "test_AdcChannelTool_parallel: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << endl;
+  cout << myname << line << endl;
+  cout << myname << "Instantiate tools." << endl;
+  AdcChannelTool_update actSer;
+  AdcChannelTool_parallel actPar;
+  assert( ! actSer.channelParallel() );
+  assert( actPar.channelParallel() );
+  Index ncha = 10;
+  AdcChannelDataMap acdsSer = makeAdcData(ncha);
+  AdcChannelDataMap acdsPar = makeAdcData(ncha);
+
+  cout << myname << line << endl;
+  cout << myname << "Compare updateMap." << endl;
+  DataMap retSer = actSer.updateMap(acdsSer);
+  DataMap retPar = actPar.updateMap(acdsPar);
+  assert( ! retSer );
+  assert( ! retPar );
+  assert( retPar.getInt("fembchan") == retSer.getInt("fembchan") );
+  assert( retPar.getIntVector("fembchans") == retSer.getIntVector("fembchans") );
+  for ( const auto& iacd : acdsPar ) {
+    assert( iacd.second.fembID() == 100 + iacd.first );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Compare viewMap." << endl;
+  retSer = actSer.viewMap(acdsSer);
+  retPar = actPar.viewMap(acdsPar);
+  assert( ! retPar );
+  assert( retPar.getIntVector("fembchans") == retSer.getIntVector("fembchans") );
+
   cout << myname << line << endl;
   cout << myname << "Test complete." << endl;
   return 0;
@@ -185,6 +283,7 @@ int test_AdcChannelTool_update() {
 int main(int argc, char* argv[]) {
   test_AdcChannelTool_default();
   test_AdcChannelTool_update();
+  test_AdcChannelTool_parallel();
   return 0;
 }
 
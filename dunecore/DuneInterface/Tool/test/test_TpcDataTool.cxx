@@ -57,6 +57,31 @@ DataMap TpcDataTool_update::update(AdcChannelData& acd) const {
 
 //**********************************************************************
 
+// Tool that counts channels in each map and sums the counts over maps.
+
+class TpcDataTool_count : public TpcDataTool {
+public:
+  bool m_par;
+  TpcDataTool_count(bool par) : m_par(par) { }
+  DataMap updateMap(AdcChannelDataMap& acds) const override {
+    DataMap ret;
+    ret.setInt("ncha", acds.size());
+    ret.setIntVector("chans", {int(acds.begin()->first)});
+    return ret;
+  }
+  bool mapParallel() const override { return m_par; }
+  void mergeMapResult(DataMap& dmsum, DataMap&& dm, Index) const override {
+    int ncha = dmsum.getInt("ncha") + dm.getInt("ncha");
+    DataMap::IntVector chans = dmsum.getIntVector("chans");
+    chans.push_back(dm.getIntVector("chans").at(0));
+    dmsum += std::move(dm);
+    dmsum.setInt("ncha", ncha);
+    dmsum.setIntVector("chans", chans);
+  }
+};
+
+//**********************************************************************
+
 // Test with all default methods.
 
 int test_TpcDataTool_default() {
@@ -178,9 +203,57 @@ int test_TpcDataTool_update() {
 
 //**********************************************************************
 
+// Test merging of the results for multiple maps.
+
+int test_TpcDataTool_merge(bool par) {
+  const string myname = "test_TpcDataTool_merge: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << endl;
+  cout << myname << line << endl;
+  cout << myname << "Create data with parallel " << par << "." << endl;
+  TpcData tpd;
+  Index nmap = 4;
+  for ( Index imap=0; imap<nmap; ++imap ) {
+    TpcData::AdcDataPtr pacm = tpd.createAdcData();
+    for ( Index icha=0; icha<10 + imap; ++icha ) {
+      (*pacm)[100*imap + icha].setChannelInfo(100*imap + icha);
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Call update TPC." << endl;
+  TpcDataTool_count act(par);
+  DataMap ret = act.updateTpcData(tpd);
+  ret.print();
+  assert( ! ret );
+  assert( ret.getInt("ncha") == 46 );
+  DataMap::IntVector expChans = {0, 100, 200, 300};
+  assert( ret.getIntVector("chans") == expChans );
+
+  cout << myname << line << endl;
+  cout << myname << "Call update TPC with the default merge." << endl;
+  TpcDataTool_update actUpd;
+  ret = actUpd.updateTpcData(tpd);
+  assert( ! ret );
+  assert( ret.getInt("fembchan") == 1000*(100 + 312) + 312 );
+
+  cout << myname << line << endl;
+  cout << myname << "Test complete." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
 int main(int argc, char* argv[]) {
   test_TpcDataTool_default();
   test_TpcDataTool_update();
+  test_TpcDataTool_merge(false);
+  test_TpcDataTool_merge(true);
   return 0;
 }
 
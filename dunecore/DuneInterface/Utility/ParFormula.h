@@ -63,6 +63,17 @@ public:  // const methods
   virtual double eval(Value var) const =0;
   virtual double eval() const =0;
 
+  // Evaluate the formula for nset sets of nvar() variables stored consecutively
+  // in pvars and write the results to pevals.
+  virtual void evalMany(const Value* pvars, Index nset, Value* pevals) const {
+    Index nv = nvar();
+    Values vars(nv);
+    for ( Index iset=0; iset<nset; ++iset ) {
+      vars.assign(pvars + iset*nv, pvars + (iset + 1)*nv);
+      pevals[iset] = nv == 0 ? eval() : eval(vars);
+    }
+  }
+
 public:  // non-const methods
 
   // Set a parameter value.
@@ -0,0 +1,180 @@
+//includes
+#include "CalibTreeColumns.h"
+#include "TTree.h"
+
+namespace CalibTreeRecord {
+
+  //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+  int CalibTreeColumns::MakeBranches(TTree* ptree, int bufsize)
+  {
+    if(ptree==nullptr) return -1;
+    int nbr=0;
+    auto col = [ptree, bufsize, &nbr](const char* name, auto* pvec){
+      ptree->Branch(name, pvec, bufsize);
+      ++nbr;
+    };
+    ptree->Branch("run", &run, "run/i", bufsize);
+    ptree->Branch("subrun", &subrun, "subrun/i", bufsize);
+    ptree->Branch("event", &event, "event/i", bufsize);
+    ptree->Branch("bunch_hits", &bunch_hits, "bunch_hits/O", bufsize);
+    nbr+=4;
+
+    col("eve_trackId", &eve_trackId);
+    col("eve_pdgid", &eve_pdgid);
+    col("eve_x_pos", &eve_x_pos);
+    col("eve_y_pos", &eve_y_pos);
+    col("eve_z_pos", &eve_z_pos);
+    col("eve_t_pos", &eve_t_pos);
+    col("eve_generator", &eve_generator);
+    col("eve_part_offset", &eve_part_offset);
+
+    col("part_isEve", &part_isEve);
+    col("part_trackId", &part_trackId);
+    col("part_pdgid", &part_pdgid);
+    col("part_dP", &part_dP);
+    col("part_dE", &part_dE);
+    col("part_x_pos", &part_x_pos);
+    col("part_y_pos", &part_y_pos);
+    col("part_z_pos", &part_z_pos);
+    col("part_t_pos", &part_t_pos);
+    col("part_hit_offset", &part_hit_offset);
+    col("part_ophit_offset", &part_ophit_offset);
+
+    col("hit_charge", &hit_charge);
+    col("hit_num_electrons", &hit_num_electrons);
+    col("hit_energy", &hit_energy);
+    col("hit_time", &hit_time);
+    col("hit_width", &hit_width);
+    col("hit_split", &hit_split);
+    col("hit_wire", &hit_wire);
+    col("hit_index", &hit_index);
+    col("hit_is_collection_wire", &hit_is_collection_wire);
+
+    col("ophit_pes", &ophit_pes);
+    col("ophit_num_photons", &ophit_num_photons);
+    col("ophit_time", &ophit_time);
+    col("ophit_width", &ophit_width);
+    col("ophit_energy", &ophit_energy);
+    col("ophit_split", &ophit_split);
+    col("ophit_opdet", &ophit_opdet);
+    col("ophit_index", &ophit_index);
+    col("ophit_opchan", &ophit_opchan);
+
+    col("hc_index", &hc_index);
+    col("hc_loc_offset", &hc_loc_offset);
+    col("hc_eve_index", &hc_eve_index);
+    col("hc_part_index", &hc_part_index);
+    col("hc_hit_index", &hc_hit_index);
+
+    col("ophc_index", &ophc_index);
+    col("ophc_loc_offset", &ophc_loc_offset);
+    col("ophc_eve_index", &ophc_eve_index);
+    col("ophc_part_index", &ophc_part_index);
+    col("ophc_hit_index", &ophc_hit_index);
+    return nbr;
+  }
+
+  //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+  void CalibTreeColumns::Fill(const CalibTreeRecord& rec)
+  {
+    Clear();
+    run=rec.run;
+    subrun=rec.subrun;
+    event=rec.event;
+    bunch_hits=rec.bunch_hits;
+
+    eve_part_offset.push_back(0);
+    part_hit_offset.push_back(0);
+    part_ophit_offset.push_back(0);
+    for(const EveRecord& eve : rec.eves){
+      eve_trackId.push_back(eve.trackId);
+      eve_pdgid.push_back(eve.pdgid);
+      eve_x_pos.push_back(eve.x_pos);
+      eve_y_pos.push_back(eve.y_pos);
+      eve_z_pos.push_back(eve.z_pos);
+      eve_t_pos.push_back(eve.t_pos);
+      eve_generator.push_back(eve.generator);
+      for(const ParticleRecord& part : eve.particles){
+        part_isEve.push_back(part.isEve);
+        part_trackId.push_back(part.trackId);
+        part_pdgid.push_back(part.pdgid);
+        part_dP.push_back(part.dP);
+        part_dE.push_back(part.dE);
+        part_x_pos.push_back(part.x_pos);
+        part_y_pos.push_back(part.y_pos);
+        part_z_pos.push_back(part.z_pos);
+        part_t_pos.push_back(part.t_pos);
+        for(const PartialHit& hit : part.partial_hits){
+          hit_charge.push_back(hit.charge);
+          hit_num_electrons.push_back(hit.num_electrons);
+          hit_energy.push_back(hit.energy);
+          hit_time.push_back(hit.time);
+          hit_width.push_back(hit.width);
+          hit_split.push_back(hit.split);
+          hit_wire.push_back(hit.wire);
+          hit_index.push_back(hit.index);
+          hit_is_collection_wire.push_back(hit.is_collection_wire);
+        }
+        for(const PartialOpHit& hit : part.partial_ophits){
+          ophit_pes.push_back(hit.pes);
+          ophit_num_photons.push_back(hit.num_photons);
+          ophit_time.push_back(hit.time);
+          ophit_width.push_back(hit.width);
+          ophit_energy.push_back(hit.energy);
+          ophit_split.push_back(hit.split);
+          ophit_opdet.push_back(hit.opdet);
+          ophit_index.push_back(hit.index);
+          ophit_opchan.push_back(hit.opchan);
+        }
+        part_hit_offset.push_back(hit_charge.size());
+        part_ophit_offset.push_back(ophit_pes.size());
+      }
+      eve_part_offset.push_back(part_trackId.size());
+    }
+
+    FillContributors(rec.hits, hc_index, hc_loc_offset, hc_eve_index, hc_part_index, hc_hit_index);
+    FillContributors(rec.ophits, ophc_index, ophc_loc_offset, ophc_eve_index, ophc_part_index, ophc_hit_index);
+  }
+
+  //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+  void CalibTreeColumns::FillContributors(const std::vector<HitContributor>& hcs,
+                                          std::vector<Int_t>& index, std::vector<UInt_t>& offset,
+                                          std::vector<Int_t>& eves, std::vector<Int_t>& parts,
+                                          std::vector<Int_t>& hits)
+  {
+    offset.push_back(0);
+    for(const HitContributor& hc : hcs){
+      index.push_back(hc.index);
+      for(const HCRec& loc : hc.locations){
+        eves.push_back(loc.eve_index);
+        parts.push_back(loc.part_index);
+        hits.push_back(loc.hit_index);
+      }
+      offset.push_back(eves.size());
+    }
+  }
+
+  //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+  void CalibTreeColumns::Clear()
+  {
+    run=0;
+    subrun=0;
+    event=0;
+    bunch_hits=false;
+    eve_trackId.clear(); eve_pdgid.clear();
+    eve_x_pos.clear(); eve_y_pos.clear(); eve_z_pos.clear(); eve_t_pos.clear();
+    eve_generator.clear(); eve_part_offset.clear();
+    part_isEve.clear(); part_trackId.clear(); part_pdgid.clear();
+    part_dP.clear(); part_dE.clear();
+    part_x_pos.clear(); part_y_pos.clear(); part_z_pos.clear(); part_t_pos.clear();
+    part_hit_offset.clear(); part_ophit_offset.clear();
+    hit_charge.clear(); hit_num_electrons.clear(); hit_energy.clear(); hit_time.clear();
+    hit_width.clear(); hit_split.clear(); hit_wire.clear(); hit_index.clear();
+    hit_is_collection_wire.clear();
+    ophit_pes.clear(); ophit_num_photons.clear(); ophit_time.clear(); ophit_width.clear();
+    ophit_energy.clear(); ophit_split.clear(); ophit_opdet.clear(); ophit_index.clear();
+    ophit_opchan.clear();
+    hc_index.clear(); hc_loc_offset.clear(); hc_eve_index.clear(); hc_part_index.clear(); hc_hit_index.clear();
+    ophc_index.clear(); ophc_loc_offset.clear(); ophc_eve_index.clear(); ophc_part_index.clear(); ophc_hit_index.clear();
+  }
+}
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////
+//
+// File: CalibTreeColumns.h
+//
+// Flat columnar form of a CalibTreeRecord::CalibTreeRecord for writing to
+// a TTree with one branch per field. The nested eve/particle/hit vectors
+// are flattened into one column per field and offset columns give the
+// ranges at each level, e.g. the particles of eve i are entries
+// [eve_part_offset[i], eve_part_offset[i+1]) of the particle columns.
+// Analysis can then read only the branches it needs and loop over plain
+// arrays instead of deserialising the nested objects.
+//
+// Usage:
+//   CalibTreeRecord::CalibTreeColumns cols;
+//   cols.MakeBranches(ptree);
+//   for each event { cols.Fill(record); ptree->Fill(); }
+//
+////////////////////////////////////////////////////////////////////////
+
+#ifndef DUNE_DUNEOBJ_CALIBTREECOLUMNS_H
+#define DUNE_DUNEOBJ_CALIBTREECOLUMNS_H
+#include "dunecore/DuneObj/CalibTreeRecord.h"
+#include <vector>
+#include <string>
+
+class TTree;
+
+namespace CalibTreeRecord {
+
+  class CalibTreeColumns {
+    public:
+      //Event
+      UInt_t run=0;
+      UInt_t subrun=0;
+      UInt_t event=0;
+      Bool_t bunch_hits=false;
+
+      //Eves. eve_part_offset has one entry more than the eves.
+      std::vector<Int_t> eve_trackId;
+      std::vector<UInt_t> eve_pdgid;
+      std::vector<Double_t> eve_x_pos;
+      std::vector<Double_t> eve_y_pos;
+      std::vector<Double_t> eve_z_pos;
+      std::vector<Double_t> eve_t_pos;
+      std::vector<std::string> eve_generator;
+      std::vector<UInt_t> eve_part_offset;
+
+      //Particles. The hit and ophit offsets have one entry more than the particles.
+      std::vector<Bool_t> part_isEve;
+      std::vector<Int_t> part_trackId;
+      std::vector<UInt_t> part_pdgid;
+      std::vector<Double_t> part_dP;
+      std::vector<Double_t> part_dE;
+      std::vector<Double_t> part_x_pos;
+      std::vector<Double_t> part_y_pos;
+      std::vector<Double_t> part_z_pos;
+      std::vector<Double_t> part_t_pos;
+      std::vector<UInt_t> part_hit_offset;
+      std::vector<UInt_t> part_ophit_offset;
+
+      //Partial hits
+      std::vector<Double_t> hit_charge;
+      std::vector<Double_t> hit_num_electrons;
+      std::vector<Double_t> hit_energy;
+      std::vector<Double_t> hit_time;
+      std::vector<Double_t> hit_width;
+      std::vector<Double_t> hit_split;
+      std::vector<UInt_t> hit_wire;
+      std::vector<Long64_t> hit_index;
+      std::vector<Bool_t> hit_is_collection_wire;
+
+      //Partial ophits
+      std::vector<Double_t> ophit_pes;
+      std::vector<Double_t> ophit_num_photons;
+      std::vector<Double_t> ophit_time;
+      std::vector<Double_t> ophit_width;
+      std::vector<Double_t> ophit_energy;
+      std::vector<Double_t> ophit_split;
+      std::vector<UInt_t> ophit_opdet;
+      std::vector<Long64_t> ophit_index;
+      std::vector<UInt_t> ophit_opchan;
+
+      //Hit contributors. The location offsets have one entry more than the contributors.
+      std::vector<Int_t> hc_index;
+      std::vector<UInt_t> hc_loc_offset;
+      std::vector<Int_t> hc_eve_index;
+      std::vector<Int_t> hc_part_index;
+      std::vector<Int_t> hc_hit_index;
+
+      //OpHit contributors
+      std::vector<Int_t> ophc_index;
+      std::vector<UInt_t> ophc_loc_offset;
+      std::vector<Int_t> ophc_eve_index;
+      std::vector<Int_t> ophc_part_index;
+      std::vector<Int_t> ophc_hit_index;
+
+      //Create one branch per column in ptree. The object must outlive the tree filling.
+      //Returns the number of branches created or -1 if ptree is null.
+      int MakeBranches(TTree* ptree, int bufsize=32000);
+
+      //Flatten a record into the columns, replacing the previous content.
+      void Fill(const CalibTreeRecord& rec);
+
+      //Clear all the columns. The capacity is kept for the next event.
+      void Clear();
+
+    private:
+      static void FillContributors(const std::vector<HitContributor>& hcs,
+                                   std::vector<Int_t>& index, std::vector<UInt_t>& offset,
+                                   std::vector<Int_t>& eves, std::vector<Int_t>& parts,
+                                   std::vector<Int_t>& hits);
+  };
+
+}
+
+#endif
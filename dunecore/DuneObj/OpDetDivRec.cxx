@@ -12,6 +12,7 @@
 #include <TObject.h>
 #include "OpDetDivRec.h"
 #include <algorithm>
+#include <functional>
 
 namespace sim {
   OpDetDivRec::OpDetDivRec():
@@ -92,6 +93,65 @@ namespace sim {
     }
   }
 
+  size_t OpDetDivRecAccumulator::KeyHash::operator()(Key const& k) const{
+    size_t h = std::hash<OpDet_Time_Chans::stored_time_t>()(k.time);
+    h ^= std::hash<int>()(k.opChan) + 0x9e3779b97f4a7c15ULL + (h<<6) + (h>>2);
+    h ^= std::hash<int>()(k.trackID) + 0x9e3779b97f4a7c15ULL + (h<<6) + (h>>2);
+    return h;
+  }
+
+  void OpDetDivRecAccumulator::AddPhoton(int opchan, int tid, OpDet_Time_Chans::stored_time_t time, double nphot){
+    fCounts[Key{time, opchan, tid}] += nphot;
+  }
+
+  void OpDetDivRecAccumulator::Finalize(OpDetDivRec& rec){
+    //Sort the buffered counts once by time, then channel and track.
+    std::vector<std::pair<Key, double>> entries(fCounts.begin(), fCounts.end());
+    fCounts.clear();
+    std::sort(entries.begin(), entries.end(),
+        [](std::pair<Key, double> const& a, std::pair<Key, double> const& b){
+          if(a.first.time!=b.first.time) return a.first.time<b.first.time;
+          if(a.first.opChan!=b.first.opChan) return a.first.opChan<b.first.opChan;
+          return a.first.trackID<b.first.trackID;
+        });
+    //Compact into one OpDet_Time_Chans per time.
+    OpDetDivRec::Time_Chans_t added;
+    for(auto const& entry : entries){
+      OpDet_Time_Chans::stored_time_t time = entry.first.time;
+      if(added.empty() || added.back().time!=time) added.emplace_back(time);
+      Chan_Phot cp(entry.first.opChan, entry.first.trackID);
+      cp.phot = entry.second;
+      added.back().phots.push_back(cp);
+    }
+    OpDetDivRec::Time_Chans_t& tcs = rec.time_chans;
+    if(tcs.empty()){
+      tcs = std::move(added);
+      return;
+    }
+    //Merge with the times already in the record.
+    OpDetDivRec::Time_Chans_t merged;
+    merged.reserve(tcs.size() + added.size());
+    auto iold = tcs.begin();
+    auto inew = added.begin();
+    while(iold!=tcs.end() || inew!=added.end()){
+      if(inew==added.end() || (iold!=tcs.end() && iold->time<inew->time)){
+        merged.push_back(std::move(*iold++));
+      }else if(iold==tcs.end() || inew->time<iold->time){
+        merged.push_back(std::move(*inew++));
+      }else{
+        for(auto const& cp : inew->phots){
+          auto cfp = std::find_if(iold->phots.begin(), iold->phots.end(),
+              [&cp](Chan_Phot const& old){ return old.opChan==cp.opChan && old.trackID==cp.trackID; });
+          if(cfp==iold->phots.end()) iold->phots.push_back(cp);
+          else cfp->phot += cp.phot;
+        }
+        merged.push_back(std::move(*iold++));
+        ++inew;
+      }
+    }
+    tcs = std::move(merged);
+  }
+
   OpDet_Time_Chans::OpDet_Time_Chans(stored_time_t& timeIn):
     time(timeIn)
   {}
@@ -15,6 +15,7 @@
 #include <map>
 #include <utility>
 #include <algorithm>
+#include <unordered_map>
 
 namespace sim {
   //these records already exist tied to optical detectors (as they are made tied to the BTRs. No need to be OpDet wise.
@@ -84,7 +85,10 @@ namespace sim {
     }
   };
 
+  class OpDetDivRecAccumulator;
+
   class OpDetDivRec{
+    friend class OpDetDivRecAccumulator;
     public:
       typedef std::vector<OpDet_Time_Chans> Time_Chans_t;
       struct time_slice{
@@ -139,6 +143,38 @@ namespace sim {
 
 }
 
+namespace sim {
+  //Accumulation mode for building an OpDetDivRec from many photons.
+  //AddPhoton is O(1): photons are counted in a hash keyed by (time, opChan, trackID).
+  //Finalize then sorts and compacts the counts once and merges them into the record,
+  //so building a record for a bright event is near-linear instead of quadratic.
+  //Usage:
+  //  OpDetDivRecAccumulator acc;
+  //  for each photon: acc.AddPhoton(opchan, tid, time);
+  //  acc.Finalize(rec);
+  class OpDetDivRecAccumulator{
+    public:
+      void AddPhoton(int opchan, int tid, OpDet_Time_Chans::stored_time_t pdTime, double nphot=1.0);
+      //Merge the buffered photons into rec, keeping its times sorted, and clear the buffer.
+      void Finalize(OpDetDivRec& rec);
+      size_t size() const { return fCounts.size(); }
+      void clear() { fCounts.clear(); }
+
+    private:
+      struct Key{
+        OpDet_Time_Chans::stored_time_t time;
+        int opChan;
+        int trackID;
+        bool operator==(Key const& rhs) const
+        { return time==rhs.time && opChan==rhs.opChan && trackID==rhs.trackID; }
+      };
+      struct KeyHash{
+        size_t operator()(Key const& k) const;
+      };
+      std::unordered_map<Key, double, KeyHash> fCounts;
+  };
+}
+
 // -----------------------------------------------------------------------------
 // ---  template implementation
 // ---
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////
+//
+// File: OpDetDivRecView.cxx
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "OpDetDivRecView.h"
+#include <algorithm>
+
+namespace sim {
+
+  OpDetDivRecView::OpDetDivRecView():
+    fOpDetNum(-1),
+    fEntryOffsets(1, 0),
+    fTrackOffsets(1, 0)
+  { }
+
+  OpDetDivRecView::OpDetDivRecView(OpDetDivRec const& rec){
+    Fill(rec);
+  }
+
+  void OpDetDivRecView::Fill(OpDetDivRec const& rec){
+    fOpDetNum = rec.OpDetNum();
+    fTimes.clear();
+    fTotals.clear();
+    fEntryOffsets.assign(1, 0);
+    fEntries.clear();
+    fTrackOffsets.assign(1, 0);
+    fTrackSums.clear();
+    OpDetDivRec::Time_Chans_t const& tcs = rec.GetTimeChans();
+    //The record is kept sorted by time but guarantee it here.
+    std::vector<size_t> order(tcs.size());
+    for(size_t itc=0; itc<tcs.size(); ++itc) order[itc] = itc;
+    std::stable_sort(order.begin(), order.end(),
+        [&tcs](size_t a, size_t b){ return tcs[a].time<tcs[b].time; });
+    for(size_t itc : order){
+      OpDet_Time_Chans const& tc = tcs[itc];
+      bool newTime = fTimes.empty() || fTimes.back()!=tc.time;
+      if(newTime){
+        fTimes.push_back(tc.time);
+        fTotals.push_back(0.0);
+        fEntryOffsets.push_back(fEntries.size());
+        fTrackOffsets.push_back(fTrackSums.size());
+      }
+      for(auto const& cp : tc.phots){
+        fEntries.push_back({cp.opChan, cp.trackID, cp.phot});
+        fTotals.back() += cp.phot;
+      }
+      fEntryOffsets.back() = fEntries.size();
+    }
+    //Sort and compact the entries for each time and build the track totals.
+    std::vector<size_t> offsets(1, 0);
+    std::vector<Entry> entries;
+    entries.reserve(fEntries.size());
+    for(size_t itim=0; itim<fTimes.size(); ++itim){
+      auto ibeg = fEntries.begin() + fEntryOffsets[itim];
+      auto iend = fEntries.begin() + fEntryOffsets[itim+1];
+      std::sort(ibeg, iend, [](Entry const& a, Entry const& b){
+          return a.opChan!=b.opChan ? a.opChan<b.opChan : a.trackID<b.trackID; });
+      size_t itrk0 = fTrackSums.size();
+      size_t ient0 = entries.size();
+      for(auto ient=ibeg; ient!=iend; ++ient){
+        if(entries.size()>ient0 && entries.back().opChan==ient->opChan && entries.back().trackID==ient->trackID){
+          entries.back().phot += ient->phot;
+        }else{
+          entries.push_back(*ient);
+        }
+        auto itrk = std::find_if(fTrackSums.begin() + itrk0, fTrackSums.end(),
+            [ient](OpDetDivRecView::TrackSum const& tt){ return tt.trackID==ient->trackID; });
+        if(itrk==fTrackSums.end()) fTrackSums.push_back({ient->trackID, ient->phot});
+        else itrk->phot += ient->phot;
+      }
+      std::sort(fTrackSums.begin() + itrk0, fTrackSums.end(),
+          [](OpDetDivRecView::TrackSum const& a, OpDetDivRecView::TrackSum const& b){ return a.trackID<b.trackID; });
+      offsets.push_back(entries.size());
+      fTrackOffsets[itim+1] = fTrackSums.size();
+    }
+    fEntries = std::move(entries);
+    fEntryOffsets = std::move(offsets);
+  }
+
+  size_t OpDetDivRecView::TimeIndex(stored_time_t time) const{
+    auto itim = std::lower_bound(fTimes.begin(), fTimes.end(), time);
+    if(itim==fTimes.end() || *itim!=time) return badIndex();
+    return itim - fTimes.begin();
+  }
+
+  double OpDetDivRecView::Photons(size_t itim, int opChan) const{
+    Entry const* ibeg = BeginEntries(itim);
+    Entry const* iend = EndEntries(itim);
+    Entry const* ient = std::lower_bound(ibeg, iend, opChan,
+        [](Entry const& e, int chan){ return e.opChan<chan; });
+    double sum = 0.0;
+    for(; ient!=iend && ient->opChan==opChan; ++ient) sum += ient->phot;
+    return sum;
+  }
+
+  double OpDetDivRecView::Photons(size_t itim, int opChan, int tid) const{
+    Entry const* ibeg = BeginEntries(itim);
+    Entry const* iend = EndEntries(itim);
+    Entry const* ient = std::lower_bound(ibeg, iend, std::make_pair(opChan, tid),
+        [](Entry const& e, std::pair<int, int> const& key){
+          return e.opChan!=key.first ? e.opChan<key.first : e.trackID<key.second; });
+    if(ient==iend || ient->opChan!=opChan || ient->trackID!=tid) return 0.0;
+    return ient->phot;
+  }
+
+  double OpDetDivRecView::TrackTotal(size_t itim, int tid) const{
+    auto ibeg = fTrackSums.begin() + fTrackOffsets[itim];
+    auto iend = fTrackSums.begin() + fTrackOffsets[itim+1];
+    auto itrk = std::lower_bound(ibeg, iend, tid,
+        [](OpDetDivRecView::TrackSum const& tt, int id){ return tt.trackID<id; });
+    if(itrk==iend || itrk->trackID!=tid) return 0.0;
+    return itrk->phot;
+  }
+
+  double OpDetDivRecView::GetFrac(stored_time_t time, int opChan) const{
+    size_t itim = TimeIndex(time);
+    if(itim==badIndex() || fTotals[itim]<=0.0) return 0.0;
+    return Photons(itim, opChan)/fTotals[itim];
+  }
+
+  double OpDetDivRecView::GetFrac(stored_time_t time, int opChan, int tid) const{
+    size_t itim = TimeIndex(time);
+    if(itim==badIndex()) return 0.0;
+    double total = TrackTotal(itim, tid);
+    if(total<=0.0) return 0.0;
+    return Photons(itim, opChan, tid)/total;
+  }
+
+  OpDetDivRecView::Slice OpDetDivRecView::GetSlice(stored_time_t low_time, stored_time_t high_time) const{
+    Slice ret;
+    ret.beginTime = std::lower_bound(fTimes.begin(), fTimes.end(), low_time) - fTimes.begin();
+    ret.endTime = std::lower_bound(fTimes.begin(), fTimes.end(), high_time) - fTimes.begin();
+    if(ret.endTime<ret.beginTime) ret.endTime = ret.beginTime;
+    ret.beginEntry = fEntries.data() + fEntryOffsets[ret.beginTime];
+    ret.endEntry = fEntries.data() + fEntryOffsets[ret.endTime];
+    return ret;
+  }
+
+}
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////
+//
+// File: OpDetDivRecView.h
+// Read-optimised, finalised form of an OpDetDivRec for backtracking.
+//
+// The times are stored sorted. For each time the photon counts are stored
+// contiguously, sorted by opChan and then trackID, with the total and the
+// per-track totals precomputed. GetFrac is then two binary searches and no
+// allocation, and GetSlice returns the range of times and entries between
+// two times without copying.
+//
+// Fractions are summed over the entries for a channel, i.e.
+//   GetFrac(time, opChan)      = photons on opChan / all photons at time
+//   GetFrac(time, opChan, tid) = photons from tid on opChan / all photons from tid at time
+// Times that are not in the record give zero.
+//
+// The view holds copies of the record data and is not persisted.
+//
+////////////////////////////////////////////////////////////////////////
+
+#ifndef DUNE_DUNEOBJ_OPDETDIVRECVIEW_H
+#define DUNE_DUNEOBJ_OPDETDIVRECVIEW_H
+
+#include "OpDetDivRec.h"
+#include <vector>
+#include <limits>
+
+namespace sim {
+
+  class OpDetDivRecView{
+    public:
+      typedef OpDet_Time_Chans::stored_time_t stored_time_t;
+
+      struct Entry{
+        int opChan;
+        int trackID;
+        double phot;
+      };
+
+      struct TrackSum{
+        int trackID;
+        double phot;
+      };
+
+      //Times [beginTime, endTime) and their entries [beginEntry, endEntry).
+      struct Slice{
+        size_t beginTime;
+        size_t endTime;
+        Entry const* beginEntry;
+        Entry const* endEntry;
+        bool empty() const { return beginTime==endTime; }
+      };
+
+      static size_t badIndex() { return std::numeric_limits<size_t>::max(); }
+
+      OpDetDivRecView();
+      explicit OpDetDivRecView(OpDetDivRec const& rec);
+
+      //Rebuild from a record.
+      void Fill(OpDetDivRec const& rec);
+
+      int OpDetNum() const { return fOpDetNum; }
+      size_t NTimes() const { return fTimes.size(); }
+      stored_time_t Time(size_t itim) const { return fTimes[itim]; }
+      double Total(size_t itim) const { return fTotals[itim]; }
+
+      //Index of the entry for time or badIndex() if there is none.
+      size_t TimeIndex(stored_time_t time) const;
+
+      //Entries for a time index.
+      Entry const* BeginEntries(size_t itim) const { return fEntries.data() + fEntryOffsets[itim]; }
+      Entry const* EndEntries(size_t itim) const { return fEntries.data() + fEntryOffsets[itim+1]; }
+
+      //Photons for a time index on a channel, optionally from one track.
+      double Photons(size_t itim, int opChan) const;
+      double Photons(size_t itim, int opChan, int tid) const;
+
+      //Photons for a time index from one track.
+      double TrackTotal(size_t itim, int tid) const;
+
+      double GetFrac(stored_time_t time, int opChan) const;
+      double GetFrac(stored_time_t time, int opChan, int tid) const;
+
+      //Times in [low_time, high_time).
+      Slice GetSlice(stored_time_t low_time, stored_time_t high_time) const;
+
+    private:
+      int fOpDetNum;
+      std::vector<stored_time_t> fTimes;
+      std::vector<double> fTotals;
+      std::vector<size_t> fEntryOffsets;
+      std::vector<Entry> fEntries;
+      std::vector<size_t> fTrackOffsets;
+      std::vector<TrackSum> fTrackSums;
+  };
+
+}
+
+#endif //DUNE_DUNEOBJ_OPDETDIVRECVIEW_H
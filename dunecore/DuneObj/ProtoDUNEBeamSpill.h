@@ -5,6 +5,8 @@
 #include <bitset>
 #include <iostream>
 #include <map>
+#include <array>
+#include <algorithm>
 #include "lardataobj/RecoBase/Track.h"
 
 namespace beam
@@ -55,8 +57,30 @@ namespace beam
 
     std::vector<short> active;
     bool decoded;
+
+    //Packed copies of the fiber bitmap and the glitch mask
+    //Fibers with a glitch are removed from the masked bits
+    std::bitset<192> GetFiberBits() const;
+    std::bitset<192> GetGlitchBits() const;
+    std::bitset<192> GetMaskedFiberBits() const { return GetFiberBits() & ~GetGlitchBits(); };
   };
 
+  inline std::bitset<192> FBM::GetFiberBits() const {
+    std::bitset<192> bits;
+    for(size_t iF = 0; iF < 192; ++iF){
+      if(fibers[iF]) bits.set(iF);
+    }
+    return bits;
+  }
+
+  inline std::bitset<192> FBM::GetGlitchBits() const {
+    std::bitset<192> bits;
+    for(size_t iF = 0; iF < 192; ++iF){
+      if(glitch_mask[iF]) bits.set(iF);
+    }
+    return bits;
+  }
+
   //Cerenkov Threshold Detector
   //
   struct CKov{          
@@ -83,6 +107,13 @@ namespace beam
       double            GetT0Nano(size_t);
       size_t            GetNT0(){return t0.size();};
       void              AddT0(std::pair< double, double >);
+
+      //Lookups of the good particles by time using an index sorted in time.
+      //Times are (sec, nano) pairs as for the T0s and tolerances are in seconds.
+      //FindNearestT0 returns the T0 index or -1 if none is within the tolerance.
+      //GetT0sInRange returns the indices, in time order, with low <= T0 < high.
+      int               FindNearestT0(std::pair< double, double > theTime, double tolerance);
+      std::vector< size_t > GetT0sInRange(std::pair< double, double > low, std::pair< double, double > high);
      
       FBM               GetFBM(std::string name, size_t theTrigger);
       void              AddFBMTrigger(std::string, FBM); 
@@ -93,6 +124,8 @@ namespace beam
 
       std::array<double,4> ReturnTriggerAndTime(std::string, size_t);
       short             GetFiberStatus(std::string, size_t, size_t);
+      std::bitset<192>  GetFiberBits(std::string, size_t);
+      std::bitset<192>  GetMaskedFiberBits(std::string, size_t);
       std::vector<short> GetActiveFibers(std::string, size_t);
       std::vector<short> GetMaskedFibers(std::string, size_t);
       double            GetFiberTime(std::string, size_t); 
@@ -180,6 +213,14 @@ namespace beam
       //
       std::vector<std::pair<double,double>> t0;
 
+      //T0 indices sorted in time. Not persisted: it is rebuilt on
+      //first use after the T0s change.
+      std::vector<size_t> t0Order;
+      void              SortT0s();
+      static double     TimeDiff(const std::pair< double, double > & a, const std::pair< double, double > & b){
+        return (a.first - b.first) + 1.e-9*(a.second - b.second);
+      };
+
       //Timestamp from the CTB signaling a 
       //Good particle signal was received
       //
@@ -253,6 +294,43 @@ namespace beam
 
   inline void ProtoDUNEBeamSpill::AddT0(std::pair< double, double > theT0){
     t0.push_back(theT0);
+    t0Order.clear();
+  }
+
+  inline void ProtoDUNEBeamSpill::SortT0s(){
+    if( t0Order.size() == t0.size() ) return;
+    t0Order.resize(t0.size());
+    for(size_t i = 0; i < t0.size(); ++i) t0Order[i] = i;
+    std::stable_sort( t0Order.begin(), t0Order.end(),
+                      [this](size_t i, size_t j){ return TimeDiff(t0[i], t0[j]) < 0.; } );
+  }
+
+  inline int ProtoDUNEBeamSpill::FindNearestT0(std::pair< double, double > theTime, double tolerance){
+    SortT0s();
+    auto itT = std::lower_bound( t0Order.begin(), t0Order.end(), theTime,
+                                 [this](size_t i, const std::pair< double, double > & t){ return TimeDiff(t0[i], t) < 0.; } );
+
+    //The nearest is either the first at or after the time or the one before it.
+    //Ties go to the earlier T0.
+    int nearest = -1;
+    double best = tolerance;
+    if( itT != t0Order.end() ){
+      double dt = TimeDiff(t0[*itT], theTime);
+      if( dt <= best ){ best = dt; nearest = *itT; }
+    }
+    if( itT != t0Order.begin() ){
+      double dt = TimeDiff(theTime, t0[*(itT - 1)]);
+      if( dt <= best ){ nearest = *(itT - 1); }
+    }
+    return nearest;
+  }
+
+  inline std::vector< size_t > ProtoDUNEBeamSpill::GetT0sInRange(std::pair< double, double > low, std::pair< double, double > high){
+    SortT0s();
+    auto before = [this](size_t i, const std::pair< double, double > & t){ return TimeDiff(t0[i], t) < 0.; };
+    auto itLow  = std::lower_bound( t0Order.begin(), t0Order.end(), low,  before );
+    auto itHigh = std::lower_bound( itLow,           t0Order.end(), high, before );
+    return std::vector< size_t >( itLow, itHigh );
   }
 
   ////////////Fiber Monitor Access
@@ -412,6 +490,30 @@ namespace beam
     return fiberMonitors[FBMName][nTrigger].fibers[iFiber];
   }
 
+  inline std::bitset<192> ProtoDUNEBeamSpill::GetFiberBits(std::string FBMName, size_t nTrigger){
+    if( fiberMonitors.find(FBMName) == fiberMonitors.end() ){
+      std::cout << "Please input monitor in range [0," << fiberMonitors.size() - 1 << "]" << std::endl;
+      return std::bitset<192>();
+    }
+    if( (nTrigger >= fiberMonitors[FBMName].size()) ){
+      std::cout << "Please input trigger in range [0," << fiberMonitors[FBMName].size() - 1 << "]" << std::endl;
+      return std::bitset<192>();
+    }
+    return fiberMonitors[FBMName][nTrigger].GetFiberBits();
+  }
+
+  inline std::bitset<192> ProtoDUNEBeamSpill::GetMaskedFiberBits(std::string FBMName, size_t nTrigger){
+    if( fiberMonitors.find(FBMName) == fiberMonitors.end() ){
+      std::cout << "Please input monitor in range [0," << fiberMonitors.size() - 1 << "]" << std::endl;
+      return std::bitset<192>();
+    }
+    if( (nTrigger >= fiberMonitors[FBMName].size()) ){
+      std::cout << "Please input trigger in range [0," << fiberMonitors[FBMName].size() - 1 << "]" << std::endl;
+      return std::bitset<192>();
+    }
+    return fiberMonitors[FBMName][nTrigger].GetMaskedFiberBits();
+  }
+
   inline std::vector<short> ProtoDUNEBeamSpill::GetActiveFibers(std::string FBMName, size_t nTrigger){
     std::vector<short> active;
 
@@ -0,0 +1,102 @@
+// RDTimeStampRanges.cxx
+
+#include "dunecore/DuneObj/RDTimeStampRanges.h"
+#include <algorithm>
+#include <numeric>
+
+using raw::RDTimeStampRanges;
+using Index = RDTimeStampRanges::Index;
+using IndexVector = RDTimeStampRanges::IndexVector;
+
+//**********************************************************************
+
+RDTimeStampRanges::RDTimeStampRanges(const std::vector<raw::RDTimeStamp>& tss) {
+  // Split the input into blocks with the same timestamp.
+  IndexVector blockStarts;
+  for ( Index its=0; its<tss.size(); ++its ) {
+    if ( its == 0 || tss[its].GetTimeStamp() != tss[its-1].GetTimeStamp() ) blockStarts.push_back(its);
+  }
+  Index nblk = blockStarts.size();
+  blockStarts.push_back(tss.size());
+  // Order the blocks by timestamp, keeping the input order for equal timestamps.
+  IndexVector order(nblk);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](Index iblk, Index jblk) {
+    return tss[blockStarts[iblk]].GetTimeStamp() < tss[blockStarts[jblk]].GetTimeStamp();
+  });
+  fTimeStamps.reserve(nblk);
+  fRangeOffsets.reserve(nblk + 1);
+  fRangeOffsets.push_back(0);
+  for ( Index iblk : order ) {
+    fTimeStamps.push_back(tss[blockStarts[iblk]].GetTimeStamp());
+    for ( Index its=blockStarts[iblk]; its<blockStarts[iblk+1]; ++its ) {
+      Index icha = tss[its].GetFlags();
+      bool extend = fRangeOffsets.back() < fFirstChannels.size() &&
+                    fFirstChannels.back() + fNChannels.back() == icha;
+      if ( extend ) {
+        ++fNChannels.back();
+      } else {
+        fFirstChannels.push_back(icha);
+        fNChannels.push_back(1);
+      }
+    }
+    fRangeOffsets.push_back(fFirstChannels.size());
+  }
+}
+
+//**********************************************************************
+
+Index RDTimeStampRanges::nChannel() const {
+  return std::accumulate(fNChannels.begin(), fNChannels.end(), Index(0));
+}
+
+//**********************************************************************
+
+IndexVector RDTimeStampRanges::Channels(Index ient) const {
+  IndexVector chans;
+  for ( Index iran=fRangeOffsets[ient]; iran<fRangeOffsets[ient+1]; ++iran ) {
+    for ( Index icha=0; icha<fNChannels[iran]; ++icha ) chans.push_back(fFirstChannels[iran] + icha);
+  }
+  return chans;
+}
+
+//**********************************************************************
+
+RDTimeStampRanges::EntryRange RDTimeStampRanges::FindEntries(ULong64_t t0, ULong64_t t1) const {
+  if ( t1 <= t0 ) return EntryRange(0, 0);
+  std::vector<ULong64_t>::const_iterator ibeg =
+    std::lower_bound(fTimeStamps.begin(), fTimeStamps.end(), t0);
+  std::vector<ULong64_t>::const_iterator iend =
+    std::lower_bound(ibeg, fTimeStamps.end(), t1);
+  return EntryRange(ibeg - fTimeStamps.begin(), iend - fTimeStamps.begin());
+}
+
+//**********************************************************************
+
+IndexVector RDTimeStampRanges::ChannelsInRange(ULong64_t t0, ULong64_t t1) const {
+  IndexVector chans;
+  EntryRange ents = FindEntries(t0, t1);
+  for ( Index ient=ents.first; ient<ents.second; ++ient ) {
+    for ( Index iran=fRangeOffsets[ient]; iran<fRangeOffsets[ient+1]; ++iran ) {
+      for ( Index icha=0; icha<fNChannels[iran]; ++icha ) chans.push_back(fFirstChannels[iran] + icha);
+    }
+  }
+  return chans;
+}
+
+//**********************************************************************
+
+std::vector<raw::RDTimeStamp> RDTimeStampRanges::Expand() const {
+  std::vector<raw::RDTimeStamp> tss;
+  tss.reserve(nChannel());
+  for ( Index ient=0; ient<size(); ++ient ) {
+    for ( Index iran=fRangeOffsets[ient]; iran<fRangeOffsets[ient+1]; ++iran ) {
+      for ( Index icha=0; icha<fNChannels[iran]; ++icha ) {
+        tss.emplace_back(fTimeStamps[ient], fFirstChannels[iran] + icha);
+      }
+    }
+  }
+  return tss;
+}
+
+//**********************************************************************
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////
+//
+// RDTimeStampRanges.h
+// Compact, time-sorted form of the per-channel raw::RDTimeStamps written
+// by the TPC decoders.
+//
+// The decoders write one RDTimeStamp per channel, with the offline channel
+// number in the flags word, so all the channels of a link repeat the same
+// timestamp. This product holds one entry per block of consecutive
+// RDTimeStamps with the same timestamp (i.e. per link) and the channels of
+// the entry as ranges [first, first+count). Entries are sorted by timestamp
+// so the earliest and latest timestamps and the channels in a time range are
+// found without scanning the channels.
+//
+////////////////////////////////////////////////////////////////////////
+
+#ifndef  RDTimeStampRanges_H
+#define  RDTimeStampRanges_H
+
+#include "RtypesCore.h"
+#include "lardataobj/RawData/RDTimeStamp.h"
+#include <utility>
+#include <vector>
+
+namespace raw {
+
+  class RDTimeStampRanges
+  {
+
+  public:
+
+    using Index = unsigned int;
+    using IndexVector = std::vector<Index>;
+    using EntryRange = std::pair<Index, Index>;   ///< Entries [first, second)
+
+    RDTimeStampRanges() { fRangeOffsets.push_back(0); }  // Default constructor
+
+    /// Build from the per-channel timestamps. The channel is taken from the flags.
+    explicit RDTimeStampRanges(const std::vector<raw::RDTimeStamp>& tss);
+
+    /// Number of entries and total number of channels.
+    Index size() const { return fTimeStamps.size(); }
+    bool empty() const { return fTimeStamps.empty(); }
+    Index nChannel() const;
+
+    /// Earliest and latest timestamps. Zero if there are no entries.
+    ULong64_t Earliest() const { return empty() ? 0 : fTimeStamps.front(); }
+    ULong64_t Latest() const { return empty() ? 0 : fTimeStamps.back(); }
+
+    /// Timestamp, channel ranges and channels for entry ient < size().
+    ULong64_t GetTimeStamp(Index ient) const { return fTimeStamps[ient]; }
+    Index nRange(Index ient) const { return fRangeOffsets[ient+1] - fRangeOffsets[ient]; }
+    Index FirstChannel(Index ient, Index iran) const { return fFirstChannels[fRangeOffsets[ient] + iran]; }
+    Index nChannel(Index ient, Index iran) const { return fNChannels[fRangeOffsets[ient] + iran]; }
+    IndexVector Channels(Index ient) const;
+
+    /// Entries with timestamp in [t0, t1).
+    EntryRange FindEntries(ULong64_t t0, ULong64_t t1) const;
+
+    /// Channels with timestamp in [t0, t1), in entry order.
+    IndexVector ChannelsInRange(ULong64_t t0, ULong64_t t1) const;
+
+    /// Per-channel timestamps, in entry order, with the channel in the flags.
+    std::vector<raw::RDTimeStamp> Expand() const;
+
+  private:
+
+    std::vector<ULong64_t> fTimeStamps;   ///< Sorted timestamp for each entry
+    std::vector<Index> fRangeOffsets;     ///< Ranges of entry i are fRangeOffsets[i]...fRangeOffsets[i+1]-1
+    std::vector<Index> fFirstChannels;    ///< First channel of each range
+    std::vector<Index> fNChannels;        ///< Number of channels in each range
+
+  };
+
+} // namespace raw
+
+#endif // RDTimeStampRanges_H
@@ -20,6 +20,7 @@
 #include "dunecore/DuneObj/ProtoDUNEBeamSpill.h"
 #include "dunecore/DuneObj/ProtoDUNETimeStamp.h"
 #include "dunecore/DuneObj/RDStatus.h"
+#include "dunecore/DuneObj/RDTimeStampRanges.h"
 #include "dunecore/DuneObj/DUNEHDF5FileInfo.h"
 #include "dunecore/DuneObj/DUNEHDF5FileInfo2.h"
 
@@ -14,11 +14,24 @@ using Index = unsigned int;
 
 //**********************************************************************
 
+AdcChannelData::EventInfoPtr AdcChannelDataTester::eventInfo() {
+  if ( ! m_pevi || m_pevi->run != run || m_pevi->subRun != subrun || m_pevi->event != event ) {
+    m_pevi = std::make_shared<const AdcChannelData::EventInfo>(run, event, subrun);
+  }
+  return m_pevi;
+}
+
+//**********************************************************************
+
 int AdcChannelDataTester::
 fill(AdcChannelData& acd, Index icha, Index isam0) {
   const string myname = "AdcChannelDataTester::fill: ";
-  acd.setEventInfo(new AdcChannelData::EventInfo(run, event, subrun));
-  acd.setChannelInfo(icha);
+  acd.setEventInfo(eventInfo());
+  if ( ! m_chanInfos.has(icha) ) {
+    m_chanInfos.set(DuneChannelInfo(icha, DuneChannelInfo::badIndex(),
+                                    DuneChannelInfo::badIndex(), DuneChannelInfo::badIndex()));
+  }
+  acd.setChannelInfo(m_chanInfos, icha);
   acd.pedestal = pedestal;
   acd.sampleUnit = "ke";
   if ( acd.raw.size() < nsam ) acd.raw.resize(nsam, 0);
@@ -7,6 +7,9 @@
 //
 // Wire strums put data starting at tick i for channel or wire i.
 // Where needed, the geometry is obtained from the geometry service.
+//
+// All channels filled for the same run, subrun and event share one event info
+// object and the channel info is taken from a table held by the tester.
 
 #ifndef AdcChannelDataTester_H
 #define AdcChannelDataTester_H
@@ -47,6 +50,14 @@ public:
   // Strum all wires in the detector.
   int strumDetectorWires(AdcChannelDataMap& acds);
 
+  // Return the event info for the current run, subrun and event.
+  AdcChannelData::EventInfoPtr eventInfo();
+
+private:
+
+  AdcChannelData::EventInfoPtr m_pevi;
+  DuneChannelInfoTable m_chanInfos;
+
 };
 
 #endif
@@ -0,0 +1,91 @@
+// AnalyticWirePlane.cxx
+
+#include "AnalyticWirePlane.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using geo::AnalyticWirePlane;
+using Index = AnalyticWirePlane::Index;
+using Segment = AnalyticWirePlane::Segment;
+
+//**********************************************************************
+
+AnalyticWirePlane::AnalyticWirePlane() : m_cache(new Cache) { }
+
+//**********************************************************************
+
+AnalyticWirePlane::
+AnalyticWirePlane(double x, double y0, double z0, double dy, double dz,
+                  double y1, double z1, Index nwires,
+                  double ymin, double ymax, double zmin, double zmax)
+: m_x(x), m_y0(y0), m_z0(z0), m_nwires(nwires),
+  m_ymin(ymin), m_ymax(ymax), m_zmin(zmin), m_zmax(zmax),
+  m_cache(new Cache) {
+  double dnorm = std::hypot(dy, dz);
+  if ( dnorm > 0.0 ) {
+    m_dy = dy/dnorm;
+    m_dz = dz/dnorm;
+  }
+  // Pitch vector: the component of (wire 1 - wire 0) perpendicular to the wires.
+  if ( nwires > 1 ) {
+    double ddy = y1 - y0;
+    double ddz = z1 - z0;
+    double along = ddy*m_dy + ddz*m_dz;
+    m_py = ddy - along*m_dy;
+    m_pz = ddz - along*m_dz;
+  }
+}
+
+//**********************************************************************
+
+AnalyticWirePlane::AnalyticWirePlane(AnalyticWirePlane&&) noexcept = default;
+AnalyticWirePlane& AnalyticWirePlane::operator=(AnalyticWirePlane&&) noexcept = default;
+AnalyticWirePlane::~AnalyticWirePlane() = default;
+
+//**********************************************************************
+
+Segment AnalyticWirePlane::computeEndpoints(Index iwir) const {
+  // Point on the wire line and the range of the line parameter t inside the frame.
+  double yc = m_y0 + iwir*m_py;
+  double zc = m_z0 + iwir*m_pz;
+  double tlo = -std::numeric_limits<double>::infinity();
+  double thi = std::numeric_limits<double>::infinity();
+  auto clip = [&tlo, &thi](double c, double d, double vmin, double vmax) {
+    if ( d == 0.0 ) {
+      if ( c < vmin || c > vmax ) thi = tlo = 0.0;
+      return;
+    }
+    double t1 = (vmin - c)/d;
+    double t2 = (vmax - c)/d;
+    if ( t1 > t2 ) std::swap(t1, t2);
+    tlo = std::max(tlo, t1);
+    thi = std::min(thi, t2);
+  };
+  clip(yc, m_dy, m_ymin, m_ymax);
+  clip(zc, m_dz, m_zmin, m_zmax);
+  // A line that misses the frame gives a zero-length wire at the line point.
+  if ( !(tlo <= thi) || std::isinf(tlo) || std::isinf(thi) ) tlo = thi = 0.0;
+  Segment seg;
+  seg.x = m_x;
+  seg.y1 = yc + tlo*m_dy;
+  seg.z1 = zc + tlo*m_dz;
+  seg.y2 = yc + thi*m_dy;
+  seg.z2 = zc + thi*m_dz;
+  return seg;
+}
+
+//**********************************************************************
+
+const Segment& AnalyticWirePlane::endpoints(Index iwir) const {
+  std::call_once(m_cache->filled, [this]() {
+    m_cache->segments.reserve(m_nwires);
+    for ( Index jwir=0; jwir<m_nwires; ++jwir ) {
+      m_cache->segments.push_back(computeEndpoints(jwir));
+    }
+  });
+  return m_cache->segments[iwir];
+}
+
+//**********************************************************************
@@ -0,0 +1,97 @@
+// AnalyticWirePlane.h
+//
+// Analytic model of the wires of one plane: equally spaced parallel wires clipped
+// by the rectangular wire frame of the plane.
+//
+// The model is built from the plane parameters (plane x, center and direction of
+// the first wire, the center of the second wire, the number of wires and the
+// y-z bounds of the frame). Wire end points are then computed with the line
+//   c(i) = c0 + i*p
+// through the center of wire i, where p is the pitch vector perpendicular to the
+// wire direction, clipped to the frame. For a plane whose wires all end on the frame
+// this reproduces the wire geometry without reading it wire by wire.
+//
+// The end points of all wires in the plane are computed on the first call to
+// endpoints() and cached. That call is thread safe. The model is move-only
+// because of the cache.
+//
+// art-independent class
+
+#ifndef AnalyticWirePlane_H
+#define AnalyticWirePlane_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace geo {
+class AnalyticWirePlane;
+}
+
+class geo::AnalyticWirePlane {
+
+public:
+
+  using Index = unsigned int;
+
+  // Wire end points. x is the same for all wires of the plane.
+  struct Segment {
+    double x = 0.0;
+    double y1 = 0.0;
+    double z1 = 0.0;
+    double y2 = 0.0;
+    double z2 = 0.0;
+  };
+
+  // Default ctor: plane with no wires.
+  AnalyticWirePlane();
+
+  // Ctor from plane parameters.
+  //   x - x position of the plane
+  //   y0, z0 - center of wire 0
+  //   dy, dz - direction along the wires (normalized here)
+  //   y1, z1 - center of wire 1 (ignored if nwires < 2)
+  //   nwires - number of wires
+  //   ymin, ymax, zmin, zmax - wire frame
+  AnalyticWirePlane(double x, double y0, double z0, double dy, double dz,
+                    double y1, double z1, Index nwires,
+                    double ymin, double ymax, double zmin, double zmax);
+
+  AnalyticWirePlane(AnalyticWirePlane&&) noexcept;
+  AnalyticWirePlane& operator=(AnalyticWirePlane&&) noexcept;
+  ~AnalyticWirePlane();
+
+  Index nwires() const { return m_nwires; }
+
+  // Compute the end points of wire iwir without using the cache.
+  Segment computeEndpoints(Index iwir) const;
+
+  // Return the end points of wire iwir from the cache, which is filled for the
+  // whole plane on first use. The wire number must be less than nwires().
+  const Segment& endpoints(Index iwir) const;
+
+private:
+
+  struct Cache {
+    std::once_flag filled;
+    std::vector<Segment> segments;
+  };
+
+  double m_x = 0.0;
+  double m_y0 = 0.0;
+  double m_z0 = 0.0;
+  double m_dy = 0.0;
+  double m_dz = 1.0;
+  double m_py = 0.0;
+  double m_pz = 0.0;
+  Index m_nwires = 0;
+  double m_ymin = 0.0;
+  double m_ymax = 0.0;
+  double m_zmin = 0.0;
+  double m_zmax = 0.0;
+  std::unique_ptr<Cache> m_cache;
+
+};
+
+#endif
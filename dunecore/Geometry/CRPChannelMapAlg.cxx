@@ -186,6 +186,7 @@ void geo::CRPChannelMapAlg::Initialize(geo::GeometryData_t const& geodata)
   
   buildReadoutPlanes(geodata.cryostats);
   fillChannelToWireMap(geodata.cryostats);
+  fChannelClasses.fill(*this, geodata);
   
   MF_LOG_TRACE(fLogCategory)
     << "CRPChannelMapAlg::Initialize() completed.";
@@ -198,6 +199,7 @@ void geo::CRPChannelMapAlg::Uninitialize() {
   fReadoutMapInfo.clear();
   fChannelToWireMap.clear();
   fPlaneInfo.clear();
+  fChannelClasses.clear();
   
 } // geo::CRPChannelMapAlg::Uninitialize()
 
@@ -809,6 +811,8 @@ std::size_t geo::CRPChannelMapAlg::findPlaneType(readout::ROPID const& rid) cons
 geo::SigType_t geo::CRPChannelMapAlg::SignalTypeForChannelImpl
   (raw::ChannelID_t const channel) const
 {
+  if (fChannelClasses.hasChannel(channel)) return fChannelClasses.signalType(channel);
+  
   ChannelToWireMap::ChannelsInROPStruct const* channelInfo
     = fChannelToWireMap.find(channel);
   if (!channelInfo) return geo::kMysteryType;
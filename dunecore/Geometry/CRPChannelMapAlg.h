@@ -26,9 +26,15 @@
 
 // CRP60D specific sorting
 #include "dunecore/Geometry/GeoObjectSorterCRU60D.h"
+#include "dunecore/Geometry/ChannelClassTable.h"
 
 // C/C++ standard libraries
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <cassert>
 #include <utility>
 
@@ -67,22 +73,15 @@ namespace geo { namespace dune{ namespace vd { namespace crp{
     /// Returns data of the ROP including `channel`, `nullptr` if none.
     ChannelsInROPStruct const* find(raw::ChannelID_t channel) const
     {
-      auto const dend = fROPfirstChannel.end();
-      auto const iNextData = fROPfirstChannel.upper_bound( channel );
-      assert(iNextData != fROPfirstChannel.begin());
-      return ((iNextData == dend) && (channel >= endChannel()))
-	? nullptr: &(std::prev(iNextData)->second);
+      return (channel < fChannelROP.size())? fChannelROP[channel]: nullptr;
     }
 
     
     /// Returns data of the ROP `ropid`, `nullptr` if none.
     ChannelsInROPStruct const* find(readout::ROPID const& ropid) const
     {
-      auto const dbegin = fROPfirstChannel.begin(), dend = fROPfirstChannel.end();
-      for( auto it = dbegin; it != dend; ++it ){
-	if (it->second.ropid == ropid) return &(it->second);
-      }
-      return nullptr;
+      auto const it = fROPdata.find(ropid);
+      return (it == fROPdata.end())? nullptr: it->second;
     }
     
     /// Returns the ID of the first invalid channel (the last channel, plus 1).
@@ -92,12 +91,19 @@ namespace geo { namespace dune{ namespace vd { namespace crp{
     unsigned int nChannels() const
     { return endChannel(); }
     
-    /// Sets the ID of the channels after the last valid one.
-    void setEndChannel(raw::ChannelID_t channel) { fEndChannel = channel; }
+    /// Sets the ID of the channels after the last valid one, and builds the
+    /// channel lookup table: call after all the ROPs are added.
+    void setEndChannel(raw::ChannelID_t channel)
+    {
+      fEndChannel = channel;
+      buildChannelIndex();
+    }
     
     /// Resets the data of the map to like just constructed.
     void clear(){
       fROPfirstChannel.clear();
+      fROPdata.clear();
+      std::vector<ChannelsInROPStruct const*>().swap(fChannelROP);
       fEndChannel = raw::ChannelID_t{ 0 };
     }
 
@@ -105,12 +111,41 @@ namespace geo { namespace dune{ namespace vd { namespace crp{
 		 raw::ChannelID_t firstROPchannel, unsigned int nChannels )
     {
       assert( fROPfirstChannel.find( firstROPchannel ) == fROPfirstChannel.end() );
-      fROPfirstChannel[ firstROPchannel ] = {firstROPchannel, nChannels, rid};
+      ChannelsInROPStruct& data = fROPfirstChannel[ firstROPchannel ];
+      data = {firstROPchannel, nChannels, rid};
+      fROPdata.emplace(rid, &data); // first ROP wins, as in a scan by channel
     }
 
   private:
+
+    /// Hash of a ROP ID for the lookup by ROP.
+    struct ROPIDhash {
+      std::size_t operator()(readout::ROPID const& rid) const
+      {
+        std::size_t h = rid.Cryostat;
+        h = h*1000003U + rid.TPCset;
+        h = h*1000003U + rid.ROP;
+        return std::hash<std::size_t>{}(h);
+      }
+    };
+
+    /// Fills fChannelROP: each channel from the first of a ROP up to the first
+    /// of the next one (or the end channel) points to that ROP.
+    void buildChannelIndex()
+    {
+      fChannelROP.assign(fEndChannel, nullptr);
+      for( auto it = fROPfirstChannel.begin(); it != fROPfirstChannel.end(); ++it ){
+        auto const inext = std::next(it);
+        raw::ChannelID_t const first = std::min(it->first, fEndChannel);
+        raw::ChannelID_t const last
+          = (inext == fROPfirstChannel.end())? fEndChannel: std::min(inext->first, fEndChannel);
+        std::fill(fChannelROP.begin() + first, fChannelROP.begin() + last, &(it->second));
+      }
+    }
 				       
     std::map<raw::ChannelID_t, ChannelsInROPStruct> fROPfirstChannel;
+    std::unordered_map<readout::ROPID, ChannelsInROPStruct const*, ROPIDhash> fROPdata; ///< by ROP
+    std::vector<ChannelsInROPStruct const*> fChannelROP; ///< ROP of each channel
     raw::ChannelID_t fEndChannel = 0;
   };
       }}}} //namespaces
@@ -152,6 +187,9 @@ class geo::CRPChannelMapAlg: public geo::ChannelMapAlg {
   /// Returns the number of readout channels (ID's go `0` to `Nchannels()`).
   virtual unsigned int Nchannels() const override;
   
+  /// Per-channel signal type, view and plane, filled in Initialize()
+  ChannelClassTable const& ChannelClasses() const { return fChannelClasses; }
+  
   /// @brief Returns the number of channels in the specified ROP
   /// @return number of channels in the specified ROP, 0 if non-existent
   virtual unsigned int Nchannels(readout::ROPID const& ropid) const override;
@@ -484,6 +522,9 @@ class geo::CRPChannelMapAlg: public geo::ChannelMapAlg {
   /// Mapping of channels and ROP's.
   geo::dune::vd::crp::ChannelToWireMap fChannelToWireMap;
   
+  /// Per-channel signal type, view and plane.
+  ChannelClassTable fChannelClasses;
+  
   /// Range of channels covered by each of the wire planes.
   geo::PlaneDataContainer<PlaneInfo_t> fPlaneInfo;
   
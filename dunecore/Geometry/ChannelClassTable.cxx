@@ -0,0 +1,98 @@
+// ChannelClassTable.cxx
+
+#include "ChannelClassTable.h"
+#include "larcorealg/Geometry/ChannelMapAlg.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "cetlib_except/exception.h"
+
+using geo::ChannelClassTable;
+using geo::SigType_t;
+using geo::View_t;
+using raw::ChannelID_t;
+using Byte = ChannelClassTable::Byte;
+
+//**********************************************************************
+
+void ChannelClassTable::fill(ChannelMapAlg const& alg, GeometryData_t const& geodata) {
+  clear();
+  ChannelID_t ncha = alg.Nchannels();
+  std::vector<Byte> sigtypes(ncha, Byte(kMysteryType));
+  std::vector<Byte> views(ncha, Byte(kUnknown));
+  std::vector<Byte> planes(ncha, NoPlane);
+  for ( ChannelID_t icha=0; icha<ncha; ++icha ) {
+    sigtypes[icha] = alg.SignalTypeForChannel(icha);
+    std::vector<WireID> wirids;
+    try {
+      wirids = alg.ChannelToWire(icha);
+    } catch (cet::exception const&) {
+      continue;
+    }
+    if ( wirids.empty() ) continue;
+    WireID const& wirid = wirids.front();
+    if ( wirid.Cryostat >= geodata.cryostats.size() ) continue;
+    CryostatGeo const& crygeo = geodata.cryostats[wirid.Cryostat];
+    if ( wirid.TPC >= crygeo.NTPC() ) continue;
+    TPCGeo const& tpcgeo = crygeo.TPC(wirid.TPC);
+    if ( wirid.Plane >= tpcgeo.Nplanes() ) continue;
+    views[icha] = tpcgeo.Plane(wirid.Plane).View();
+    planes[icha] = wirid.Plane;
+  }
+  m_sigtypes.swap(sigtypes);
+  m_views.swap(views);
+  m_planes.swap(planes);
+}
+
+//**********************************************************************
+
+void ChannelClassTable::assign(ByteSpan sigtypes, ByteSpan views, ByteSpan planes) {
+  clear();
+  if ( views.size() != sigtypes.size() || planes.size() != sigtypes.size() ) return;
+  m_sigtypes.assign(sigtypes.begin(), sigtypes.end());
+  m_views.assign(views.begin(), views.end());
+  m_planes.assign(planes.begin(), planes.end());
+}
+
+//**********************************************************************
+
+void ChannelClassTable::clear() {
+  std::vector<Byte>().swap(m_sigtypes);
+  std::vector<Byte>().swap(m_views);
+  std::vector<Byte>().swap(m_planes);
+}
+
+//**********************************************************************
+
+void ChannelClassTable::
+signalTypes(ChannelID_t const* chans, std::size_t n, SigType_t* out) const {
+  const ChannelID_t ncha = size();
+  const Byte* tab = m_sigtypes.data();
+  for ( std::size_t i=0; i<n; ++i ) {
+    out[i] = chans[i] < ncha ? SigType_t(tab[chans[i]]) : kMysteryType;
+  }
+}
+
+//**********************************************************************
+
+void ChannelClassTable::
+views(ChannelID_t const* chans, std::size_t n, View_t* out) const {
+  const ChannelID_t ncha = size();
+  const Byte* tab = m_views.data();
+  for ( std::size_t i=0; i<n; ++i ) {
+    out[i] = chans[i] < ncha ? View_t(tab[chans[i]]) : kUnknown;
+  }
+}
+
+//**********************************************************************
+
+void ChannelClassTable::
+planes(ChannelID_t const* chans, std::size_t n, Byte* out) const {
+  const ChannelID_t ncha = size();
+  const Byte* tab = m_planes.data();
+  for ( std::size_t i=0; i<n; ++i ) {
+    out[i] = chans[i] < ncha ? tab[chans[i]] : NoPlane;
+  }
+}
+
+//**********************************************************************
@@ -0,0 +1,85 @@
+// ChannelClassTable.h
+//
+// Per-channel table of signal type, view and plane number for a channel map.
+//
+// The DUNE channel map algorithms classify a channel with their own arithmetic or
+// lookups on every SignalTypeForChannel() call. This table is filled once, at the end
+// of the algorithm's Initialize(), from the algorithm itself:
+//   signal type - SignalTypeForChannel(channel) as computed by the algorithm
+//   plane, view - from the first wire of ChannelToWire(channel)
+// The algorithm then answers SignalTypeForChannel() from the table. The byte arrays
+// are exposed directly, and with gather calls, so that a full readout can
+// be classified without a virtual call per channel, e.g.
+//   const ChannelClassTable& tab = alg.ChannelClasses();
+//   tab.signalTypes(channels.data(), channels.size(), sigtypes.data());
+//
+// Channels outside the table give kMysteryType, kUnknown and NoPlane.
+// Channels without wires (or for which ChannelToWire throws) give kUnknown and NoPlane.
+
+#ifndef ChannelClassTable_H
+#define ChannelClassTable_H
+
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
+#include "larcorealg/Geometry/GeometryData.h"
+#include "larcorealg/CoreUtils/span.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace geo {
+class ChannelMapAlg;
+class ChannelClassTable;
+}
+
+class geo::ChannelClassTable {
+
+public:
+
+  using Byte = std::uint8_t;
+  using ByteSpan = util::span<Byte const*>;
+
+  static constexpr Byte NoPlane = 0xff;
+
+  // Fill the table for channels 0 to alg.Nchannels()-1. The table is empty while it is
+  // filled, so an algorithm that consults it in SignalTypeForChannelImpl() falls back
+  // to its own calculation here.
+  void fill(ChannelMapAlg const& alg, GeometryData_t const& geodata);
+
+  // Fill the table with copies of tables of equal length, e.g. from a GeometrySnapshot.
+  void assign(ByteSpan sigtypes, ByteSpan views, ByteSpan planes);
+
+  // Empty the table and release its memory.
+  void clear();
+
+  // Number of channels in the table.
+  raw::ChannelID_t size() const { return m_sigtypes.size(); }
+  bool empty() const { return m_sigtypes.empty(); }
+  bool hasChannel(raw::ChannelID_t icha) const { return icha < m_sigtypes.size(); }
+
+  // Single-channel lookups. The channel must be in the table.
+  SigType_t signalType(raw::ChannelID_t icha) const { return SigType_t(m_sigtypes[icha]); }
+  View_t view(raw::ChannelID_t icha) const { return View_t(m_views[icha]); }
+  Byte plane(raw::ChannelID_t icha) const { return m_planes[icha]; }
+
+  // The full tables, indexed by channel.
+  ByteSpan signalTypes() const { return span(m_sigtypes); }
+  ByteSpan views() const { return span(m_views); }
+  ByteSpan planes() const { return span(m_planes); }
+
+  // Gather the values for the n channels chans[i] into out[i].
+  void signalTypes(raw::ChannelID_t const* chans, std::size_t n, SigType_t* out) const;
+  void views(raw::ChannelID_t const* chans, std::size_t n, View_t* out) const;
+  void planes(raw::ChannelID_t const* chans, std::size_t n, Byte* out) const;
+
+private:
+
+  static ByteSpan span(std::vector<Byte> const& v) { return ByteSpan(v.data(), v.data() + v.size()); }
+
+  std::vector<Byte> m_sigtypes;
+  std::vector<Byte> m_views;
+  std::vector<Byte> m_planes;
+
+};
+
+#endif
@@ -5,6 +5,9 @@
 //
 // Return geometry info for a channel using the current
 // geometry service.
+//
+// Use ChannelGeoTable::instance(pgeo, ChannelGeoTable::Standard) for the values for
+// all channels.
 
 #ifndef ChannelGeo_H
 #define ChannelGeo_H
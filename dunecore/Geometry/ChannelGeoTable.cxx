@@ -0,0 +1,111 @@
+// ChannelGeoTable.cxx
+
+#include "ChannelGeoTable.h"
+#include "ChannelGeo.h"
+#include "IcebergChannelGeo.h"
+
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "larcore/Geometry/Geometry.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+using std::string;
+using Index = ChannelGeoTable::Index;
+using TablePtr = ChannelGeoTable::TablePtr;
+using EndPointsSpan = ChannelGeoTable::EndPointsSpan;
+
+namespace {
+
+using Key = std::tuple<const geo::GeometryCore*, int, string, Index>;
+
+std::mutex& registryMutex() {
+  static std::mutex mtx;
+  return mtx;
+}
+
+std::map<Key, TablePtr>& registry() {
+  static std::map<Key, TablePtr> tabs;
+  return tabs;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+TablePtr ChannelGeoTable::instance(const geo::GeometryCore* pgeo, Kind kind) {
+  if ( pgeo == nullptr ) return nullptr;
+  Key key(pgeo, kind, pgeo->DetectorName(), pgeo->Nchannels());
+  std::lock_guard<std::mutex> lock(registryMutex());
+  TablePtr& ptab = registry()[key];
+  if ( ! ptab ) ptab.reset(new ChannelGeoTable(pgeo, kind));
+  return ptab;
+}
+
+//**********************************************************************
+
+TablePtr ChannelGeoTable::instance(Kind kind) {
+  return instance(&*art::ServiceHandle<geo::Geometry>(), kind);
+}
+
+//**********************************************************************
+
+void ChannelGeoTable::clear() {
+  std::lock_guard<std::mutex> lock(registryMutex());
+  registry().clear();
+}
+
+//**********************************************************************
+
+ChannelGeoTable::ChannelGeoTable(const geo::GeometryCore* pgeo, Kind kind)
+: m_kind(kind) {
+  m_offsets.push_back(0);
+  if ( pgeo == nullptr ) return;
+  m_detname = pgeo->DetectorName();
+  if ( kind == Iceberg ) fill<IcebergChannelGeo>(pgeo);
+  else fill<ChannelGeo>(pgeo);
+}
+
+//**********************************************************************
+
+Index ChannelGeoTable::nWires(Index icha) const {
+  if ( icha >= size() ) return 0;
+  return m_offsets[icha+1] - m_offsets[icha];
+}
+
+//**********************************************************************
+
+EndPointsSpan ChannelGeoTable::wires(Index icha) const {
+  if ( icha >= size() ) return EndPointsSpan(nullptr, nullptr);
+  const EndPoints* pbeg = m_ends.data();
+  return EndPointsSpan(pbeg + m_offsets[icha], pbeg + m_offsets[icha+1]);
+}
+
+//**********************************************************************
+
+EndPointsSpan ChannelGeoTable::allWires() const {
+  return EndPointsSpan(m_ends.data(), m_ends.data() + m_ends.size());
+}
+
+//**********************************************************************
+
+template<class G>
+void ChannelGeoTable::fill(const geo::GeometryCore* pgeo) {
+  Index ncha = pgeo->Nchannels();
+  m_valid.resize(ncha, false);
+  m_offsets.reserve(ncha + 1);
+  m_tops.resize(ncha);
+  m_bots.resize(ncha);
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    G cgeo(icha, pgeo);
+    m_valid[icha] = cgeo.isValid();
+    m_ends.insert(m_ends.end(), cgeo.wires().begin(), cgeo.wires().end());
+    m_offsets.push_back(m_ends.size());
+    m_tops[icha] = cgeo.top();
+    m_bots[icha] = cgeo.bottom();
+  }
+  m_ends.shrink_to_fit();
+}
+
+//**********************************************************************
@@ -0,0 +1,98 @@
+// ChannelGeoTable.h
+//
+// Read-only table of the wire segments and top and bottom points for all
+// channels in a geometry.
+//
+// The table holds the same values as ChannelGeo (or IcebergChannelGeo) for each
+// channel but they are evaluated once and stored contiguously, so that tools
+// needing the geometry for every channel do not query the geometry service
+// channel by channel. Tables are shared through a registry with one entry for
+// each geometry and kind, e.g.
+//   ChannelGeoTable::TablePtr ptab = ChannelGeoTable::instance(pgeo);
+//   for ( const auto& ends : ptab->wires(icha) ) ...
+//
+// The registry holds the tables until clear() is called. It is keyed by the
+// geometry address, detector name and channel count, so a table is rebuilt if
+// the geometry is replaced.
+
+#ifndef ChannelGeoTable_H
+#define ChannelGeoTable_H
+
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/CoreUtils/span.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class ChannelGeoTable {
+
+public:
+
+  using Index = unsigned int;
+  using Point = geo::Point_t;
+  using EndPoints = geo::GeometryCore::Segment_t;
+  using EndPointsSpan = util::span<EndPoints const*>;
+  using TablePtr = std::shared_ptr<const ChannelGeoTable>;
+
+  // Which channel geometry is tabulated:
+  //   Standard - ChannelGeo
+  //   Iceberg - IcebergChannelGeo
+  enum Kind { Standard, Iceberg };
+
+  // Return the shared table for a geometry, building it if needed.
+  // Returns null if pgeo is null.
+  static TablePtr instance(const geo::GeometryCore* pgeo, Kind kind =Standard);
+
+  // Return the shared table for the current geometry service.
+  static TablePtr instance(Kind kind =Standard);
+
+  // Remove all tables from the registry. Tables still held elsewhere remain valid.
+  static void clear();
+
+  // Ctor building the table for a geometry.
+  ChannelGeoTable(const geo::GeometryCore* pgeo, Kind kind =Standard);
+
+  // Return the kind and detector name.
+  Kind kind() const { return m_kind; }
+  const std::string& detectorName() const { return m_detname; }
+
+  // Return the number of channels.
+  Index size() const { return m_valid.size(); }
+
+  // Is this a valid channel?
+  bool isValid(Index icha) const { return icha < size() && m_valid[icha]; }
+
+  // Return the number of wires (wire segments) for a channel.
+  Index nWires(Index icha) const;
+
+  // Return the wire endpoints for a channel. Empty for invalid channels.
+  EndPointsSpan wires(Index icha) const;
+
+  // Return the top or bottom endpoint for a channel.
+  // The channel must be valid.
+  const Point& top(Index icha) const { return m_tops[icha]; }
+  const Point& bottom(Index icha) const { return m_bots[icha]; }
+
+  // Return the wire endpoints for all channels. Those for channel icha
+  // start at offset(icha) and end at offset(icha+1).
+  EndPointsSpan allWires() const;
+  Index offset(Index icha) const { return m_offsets[icha]; }
+
+private:
+
+  Kind m_kind;
+  std::string m_detname;
+  std::vector<bool> m_valid;
+  std::vector<Index> m_offsets;
+  std::vector<EndPoints> m_ends;
+  std::vector<Point> m_tops;
+  std::vector<Point> m_bots;
+
+  // Fill the table using channel geometry class G.
+  template<class G>
+  void fill(const geo::GeometryCore* pgeo);
+
+};
+
+#endif
@@ -21,6 +21,8 @@
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
 #include "larcorealg/Geometry/ChannelMapAlg.h"
 #include "dunecore/Geometry/GeoObjectSorter35.h"
+#include "dunecore/Geometry/ChannelClassTable.h"
+#include "dunecore/Geometry/ChannelMap35Table.h"
 #include "fhiclcpp/ParameterSet.h"
 
 namespace geo{
@@ -37,6 +39,14 @@ namespace geo{
     /// Returns a list of TPC wires connected to the specified readout channel ID
     /// @throws cet::exception (category: "Geometry") if non-existent channel
     std::vector<WireID>      ChannelToWire(raw::ChannelID_t channel) const override;
+
+    /// Same as ChannelToWire() but without allocating: returns a view of the
+    /// channel's entries in the table built in Initialize()
+    /// @throws cet::exception (category: "Geometry") if non-existent channel
+    ChannelMap35Table::WireIDSpan ChannelToWireSpan(raw::ChannelID_t channel) const;
+
+    /// Precomputed channel and wire tables, filled in Initialize()
+    ChannelMap35Table const& Table() const { return fTable; }
     
     unsigned int             Nchannels()                            const override;
     
@@ -60,6 +70,8 @@ namespace geo{
     //@}
     View_t                   View( raw::ChannelID_t const channel )      const;
     SigType_t                SignalTypeForChannelImpl( raw::ChannelID_t const channel) const override;
+    /// Per-channel signal type, view and plane, filled in Initialize()
+    ChannelClassTable const& ChannelClasses() const { return fChannelClasses; }
     std::set<View_t>  const& Views()                                     const;
     std::set<PlaneID> const& PlaneIDs()                                  const override;
 
@@ -262,6 +274,8 @@ namespace geo{
     PlaneInfoMap_t<unsigned int>                         fWiresPerPlane;  ///< The number of wires in this plane 
                                                                           ///< in the heirachy
     geo::GeoObjectSorter35                               fSorter;         ///< sorts geo::XXXGeo objects
+    ChannelClassTable                                    fChannelClasses; ///< per-channel signal type, view and plane
+    ChannelMap35Table                                    fTable;          ///< channel-to-wire, wire-to-channel and wire coordinate tables
     
     /// all data we need for each APA
     typedef struct {
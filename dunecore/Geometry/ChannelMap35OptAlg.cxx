@@ -198,6 +198,29 @@ namespace geo{
     mf::LogVerbatim("ChannelMap35OptAlg") << "V channels per APA = " << 2*nAnchoredWires[0][0][1] ;
     mf::LogVerbatim("ChannelMap35OptAlg") << "Z channels per APA side = " << nAnchoredWires[0][0][2] ;
 
+    // Fill the tables used for the channel and wire queries.
+    fTable.reset(fNTPC, fPlanesPerAPA);
+    for(unsigned int cs = 0; cs != fNcryostat; ++cs){
+      for(unsigned int apa = 0; apa != fNTPC[cs]/2; ++apa){
+        for(unsigned int p = 0; p != fPlanesPerAPA; ++p){
+          fTable.setApaPlane(cs, apa, p, fFirstChannelInThisPlane[cs][apa][p],
+                             nAnchoredWires[cs][apa][p], fWiresPerPlane[cs][apa][p]);
+        }
+      }
+      for (unsigned int tpc=0; tpc<fNTPC[cs]; tpc++){
+        for (unsigned int plane=0; plane<fPlanesPerAPA; plane++){
+          const PlaneData_t& PlaneData = fPlaneData[cs][tpc][plane];
+          fTable.setWireCoordinate(geo::PlaneID(cs, tpc, plane),
+                                   PlaneData.fFirstWireCenterY, PlaneData.fFirstWireCenterZ,
+                                   fSinOrientation[plane], fCosOrientation[plane],
+                                   fWirePitch[plane], PlaneData.fWireSortingInZ);
+        }
+      }
+    }
+    fTable.buildChannelToWire(fNchannels);
+
+    fChannelClasses.fill(*this, geodata);
+
     return;
 
   }
@@ -208,87 +231,27 @@ namespace geo{
 
     PlaneInfoMap_t<raw::ChannelID_t>().swap(fFirstChannelInThisPlane);
     PlaneInfoMap_t<raw::ChannelID_t>().swap(fFirstChannelInNextPlane);
+    fChannelClasses.clear();
+    fTable.clear();
 
   }
 
   //----------------------------------------------------------------------------
   std::vector<geo::WireID> ChannelMap35OptAlg::ChannelToWire(raw::ChannelID_t channel)  const
+  {
+    ChannelMap35Table::WireIDSpan wires = ChannelToWireSpan(channel);
+    return std::vector<WireID>(wires.begin(), wires.end());
+  }
+
+  //----------------------------------------------------------------------------
+  ChannelMap35Table::WireIDSpan ChannelMap35OptAlg::ChannelToWireSpan(raw::ChannelID_t channel)  const
   {
 
     // first check if this channel ID is legal
-    if(channel >= fNchannels )
+    if(channel >= fNchannels || !fTable.hasChannel(channel))
       throw cet::exception("Geometry") << "ILLEGAL CHANNEL ID for channel " << channel << "\n";
 
-    std::vector< WireID > AllSegments;
-    
-    static unsigned int cstat;
-    static unsigned int tpc;
-    static unsigned int plane;
-    static unsigned int wireThisPlane;
-    static unsigned int NextPlane;
-    static unsigned int ThisPlane;
-    
-    for(unsigned int csloop = 0; csloop != fNcryostat; ++csloop){
-      
-      bool breakVariable = false;
-      
-      for(unsigned int apaloop = 0; apaloop != fNTPC[csloop]/2; ++apaloop){
-        for(unsigned int planeloop = 0; planeloop != fPlanesPerAPA; ++planeloop){
-          
-          NextPlane = fFirstChannelInNextPlane[csloop][apaloop][planeloop];
-                 ThisPlane = fFirstChannelInThisPlane[csloop][apaloop][planeloop];
-          
-          if(channel < NextPlane){
-            
-            cstat = csloop;
-            tpc   = 2*apaloop;
-            plane = planeloop;
-            wireThisPlane  = channel - ThisPlane;
-            
-            breakVariable = true;
-            break;
-          }// end if break          
-          if(breakVariable) break;
-          
-        }// end plane loop        
-        if(breakVariable) break;
-        
-      }// end apa loop      
-      if(breakVariable) break;
-      
-    }// end cryostat loop
-    
-
-    int WrapDirection = 1; // go from tpc to (tpc+1) or tpc to (tpc-1)
-
-    // find the lowest wire
-    raw::ChannelID_t ChannelGroup = std::floor( wireThisPlane/nAnchoredWires[cstat][tpc/2][plane] );
-    unsigned int bottomwire = wireThisPlane-ChannelGroup*nAnchoredWires[cstat][tpc/2][plane];
-    
-    if(ChannelGroup%2==1){
-      // start in the other TPC
-      tpc += 1;
-      WrapDirection  = -1;         
-    }
-    
-    for(unsigned int WireSegmentCount = 0; WireSegmentCount != 50; ++WireSegmentCount){
-      
-      tpc += WrapDirection*(WireSegmentCount%2);
-      
-      geo::WireID CodeWire(cstat, tpc, plane, bottomwire + WireSegmentCount*nAnchoredWires[cstat][std::floor(tpc/2)][plane]);
-      
-      AllSegments.push_back(CodeWire);
-      
-      // reset the tcp variable so it doesnt "accumulate value"
-      tpc -= WrapDirection*(WireSegmentCount%2);
-      
-      if( bottomwire + (WireSegmentCount+1)*nAnchoredWires[cstat][std::floor(tpc/2)][plane] > 
-          fWiresPerPlane[cstat][std::floor(tpc/2)][plane]-1) break;
-      
-    } //end WireSegmentCount loop
-    
-    
-    return AllSegments;
+    return fTable.channelToWire(channel);
   }
 
 
@@ -313,31 +276,14 @@ namespace geo{
   {
     // Returns the wire number corresponding to a (Y,Z) position in the plane
     // with float precision.
-    // Core code ripped from original NearestWireID() implementation
-    
-    const PlaneData_t& PlaneData = AccessElement(fPlaneData, planeid);
-    
-    //get the orientation angle of a given plane and calculate the distance between first wire
-    //and a point projected in the plane
-//    const double rotate = (planeid.TPC % 2 == 1)? -1.: +1.;
-    
-    // the formula used here is geometric:
+    //
+    // The formula is geometric:
     // distance = delta_y cos(theta_z) + delta_z sin(theta_z)
-    // with a correction for the orientation of the TPC:
-    // odd TPCs have supplementary wire angle (pi-theta_z), changing cosine sign
-    
-    const bool bSuppl = (planeid.TPC % 2) == 1;
-    float distance =
-      -(YPos - PlaneData.fFirstWireCenterY) * (bSuppl? -1.: +1.) * fCosOrientation[planeid.Plane]
-      +(ZPos - PlaneData.fFirstWireCenterZ) * fSinOrientation[planeid.Plane]
-      ;
-    
-    // The sign of this formula is correct if the wire with larger ID is on the
-    // "right" (intuitively, larger z; rigorously, smaller intercept)
-    // than this one.
-    // Of course, we are not always that lucky. fWireSortingInZ fixes our luck.
+    // with a correction for the orientation of the TPC: odd TPCs have
+    // supplementary wire angle (pi-theta_z), changing cosine sign.
+    // The coefficients for each plane are precomputed in the table.
 
-    return PlaneData.fWireSortingInZ * distance/fWirePitch[planeid.Plane];
+    return fTable.wireCoordinate(YPos, ZPos, planeid);
   } // ChannelMap35OptAlg::WireCoordinate()
   
   
@@ -387,21 +333,12 @@ namespace geo{
     (geo::WireID const& wireid) const
   {
 
-    unsigned int OtherSideWires = 0;
-
-    raw::ChannelID_t Channel = AccessAPAelement(fFirstChannelInThisPlane, wireid);
-
-    // get number of wires starting on the first side of the APA if starting
-    // on the other side TPC.
-    if (wireid.TPC % 2 == 1) OtherSideWires += AnchoredWires(wireid);
-    
-    // Lastly, account for the fact that channel number while moving up wire number in one
-    // plane resets after 2 times the number of wires anchored -- one for each APA side.
-    // At the same time, OtherSideWires accounts for the fact that if a channel starts on
-    // the other side, it is offset by the number of wires on the first side.
-    Channel += (OtherSideWires + wireid.Wire)%(2*AnchoredWires(wireid));
+    // Channel number while moving up wire number in one plane resets after 2 times
+    // the number of wires anchored -- one for each APA side. A channel starting on
+    // the other side is offset by the number of wires on the first side.
+    // The first channel and offset for each plane are precomputed in the table.
 
-    return Channel;
+    return fTable.planeWireToChannel(wireid);
 
   }
 
@@ -409,6 +346,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   SigType_t ChannelMap35OptAlg::SignalTypeForChannelImpl( raw::ChannelID_t const channel )  const
   {
+    if ( fChannelClasses.hasChannel(channel) ) return fChannelClasses.signalType(channel);
     raw::ChannelID_t chan = channel % fChannelsPerAPA;
     SigType_t sigt = kInduction;
 
@@ -0,0 +1,111 @@
+// ChannelMap35Table.cxx
+
+#include "ChannelMap35Table.h"
+
+using geo::ChannelMap35Table;
+using geo::WireID;
+using geo::PlaneID;
+using raw::ChannelID_t;
+using Index = ChannelMap35Table::Index;
+using std::size_t;
+using std::vector;
+
+//**********************************************************************
+
+void ChannelMap35Table::reset(const vector<Index>& ntpcs, Index nplane) {
+  clear();
+  m_ntpcs = ntpcs;
+  m_nplane = nplane;
+  size_t npla = 0;
+  for ( Index ntpc : m_ntpcs ) {
+    m_cryFirstPlane.push_back(npla);
+    npla += ntpc*nplane;
+  }
+  m_planes.resize(npla);
+}
+
+//**********************************************************************
+
+void ChannelMap35Table::setApaPlane(Index icry, Index iapa, Index ipla,
+                                    ChannelID_t firstChannel, Index nanchored, Index nwire) {
+  for ( Index iside=0; iside<2; ++iside ) {
+    PlaneID pid(icry, 2*iapa + iside, ipla);
+    if ( ! hasPlane(pid) ) continue;
+    PlaneEntry& ent = m_planes[planeIndex(pid)];
+    ent.firstChannel = firstChannel;
+    ent.wireOffset = iside == 1 ? nanchored : 0;
+    ent.nchan = nanchored > 0 ? 2*nanchored : 1;
+    ent.nanchored = nanchored;
+    ent.nwire = nwire;
+  }
+}
+
+//**********************************************************************
+
+void ChannelMap35Table::setWireCoordinate(const PlaneID& pid, double y0, double z0,
+                                          double sinth, double costh, double pitch, double sorting) {
+  if ( ! hasPlane(pid) ) return;
+  PlaneEntry& ent = m_planes[planeIndex(pid)];
+  // Odd TPCs have the supplementary wire angle, changing the sign of the cosine.
+  const bool bSuppl = (pid.TPC % 2) == 1;
+  ent.y0 = y0;
+  ent.z0 = z0;
+  ent.cy = (bSuppl ? 1.0 : -1.0)*costh;
+  ent.cz = sinth;
+  ent.pitch = pitch;
+  ent.sorting = sorting;
+}
+
+//**********************************************************************
+
+void ChannelMap35Table::buildChannelToWire(ChannelID_t nchannels) {
+  vector<size_t>().swap(m_channelWireOffsets);
+  vector<WireID>().swap(m_channelWires);
+  m_channelWireOffsets.reserve(nchannels + 1);
+  // The APA planes hold consecutive channel ranges in (cry, apa, pla) order.
+  for ( Index icry=0; icry<m_ntpcs.size(); ++icry ) {
+    for ( Index iapa=0; iapa<m_ntpcs[icry]/2; ++iapa ) {
+      for ( Index ipla=0; ipla<m_nplane; ++ipla ) {
+        const PlaneEntry& ent = m_planes[planeIndex(PlaneID(icry, 2*iapa, ipla))];
+        Index nanc = ent.nanchored;
+        for ( Index ichaPla=0; ichaPla<2*nanc; ++ichaPla ) {
+          if ( m_channelWireOffsets.size() >= nchannels ) break;
+          m_channelWireOffsets.push_back(m_channelWires.size());
+          // Lowest wire and the TPC where the channel starts.
+          Index group = ichaPla/nanc;
+          Index bottomwire = ichaPla - group*nanc;
+          Index itpc = 2*iapa;
+          int wrapDirection = 1;
+          if ( group%2 == 1 ) {
+            itpc += 1;
+            wrapDirection = -1;
+          }
+          // The segments alternate between the two TPCs of the APA.
+          for ( Index iseg=0; iseg<50; ++iseg ) {
+            Index itpcSeg = itpc + wrapDirection*int(iseg%2);
+            m_channelWires.emplace_back(icry, itpcSeg, ipla, bottomwire + iseg*nanc);
+            if ( bottomwire + (iseg + 1)*nanc > ent.nwire - 1 ) break;
+          }
+        }
+      }
+    }
+  }
+  // Channels beyond the planes have no wires.
+  while ( m_channelWireOffsets.size() < size_t(nchannels) + 1 ) {
+    m_channelWireOffsets.push_back(m_channelWires.size());
+  }
+  m_channelWires.shrink_to_fit();
+}
+
+//**********************************************************************
+
+void ChannelMap35Table::clear() {
+  vector<Index>().swap(m_ntpcs);
+  m_nplane = 0;
+  vector<size_t>().swap(m_cryFirstPlane);
+  vector<PlaneEntry>().swap(m_planes);
+  vector<size_t>().swap(m_channelWireOffsets);
+  vector<WireID>().swap(m_channelWires);
+}
+
+//**********************************************************************
@@ -0,0 +1,118 @@
+// ChannelMap35Table.h
+//
+// Precomputed channel and wire tables shared by the 35t channel maps
+// ChannelMap35Alg and ChannelMap35OptAlg.
+//
+// The two algorithms differ only in how Initialize() counts the anchored wires.
+// Each passes its per-APA layout to the table once, after which the table answers
+//   channelToWire      - view of the wire segments of a channel
+//   planeWireToChannel - channel for a wire
+//   wireCoordinate     - wire coordinate of a (y, z) position in a plane
+// without searching the channel ranges or evaluating trigonometry per call, e.g.
+//   tab.reset(ntpcs, nplane);
+//   tab.setApaPlane(icry, iapa, ipla, firstChannel, nanchored, nwire);
+//   tab.setWireCoordinate(PlaneID(icry, itpc, ipla), y0, z0, sinth, costh, pitch, sorting);
+//   tab.buildChannelToWire(nchannels);
+//
+// The values are those of the per-call arithmetic previously in the algorithms.
+// The wire coordinate keeps the single-precision distance of that arithmetic.
+
+#ifndef ChannelMap35Table_H
+#define ChannelMap35Table_H
+
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
+#include "larcorealg/CoreUtils/span.h"
+#include <cstddef>
+#include <vector>
+
+namespace geo {
+class ChannelMap35Table;
+}
+
+class geo::ChannelMap35Table {
+
+public:
+
+  using Index = unsigned int;
+  using WireIDSpan = util::span<WireID const*>;
+
+  // Define the layout: the number of TPCs in each cryostat (two per APA) and the
+  // number of planes in each TPC. This clears any previous content.
+  void reset(const std::vector<Index>& ntpcs, Index nplane);
+
+  // Set the first channel, number of anchored wires and number of wires for one
+  // APA plane. The plane has 2*nanchored channels.
+  void setApaPlane(Index icry, Index iapa, Index ipla,
+                   raw::ChannelID_t firstChannel, Index nanchored, Index nwire);
+
+  // Set the wire coordinate parameters for one TPC plane: first wire centre,
+  // wire angle, pitch and wire-ordering sign.
+  void setWireCoordinate(const PlaneID& pid, double y0, double z0,
+                         double sinth, double costh, double pitch, double sorting);
+
+  // Fill the channel-to-wire table for channels 0 to nchannels-1 from the APA planes.
+  void buildChannelToWire(raw::ChannelID_t nchannels);
+
+  // Empty the tables and release their memory.
+  void clear();
+
+  // Number of channels in the channel-to-wire table.
+  raw::ChannelID_t size() const { return m_channelWireOffsets.empty() ? 0 : m_channelWireOffsets.size() - 1; }
+  bool hasChannel(raw::ChannelID_t icha) const { return icha < size(); }
+
+  // Wire segments for a channel. The channel must be in the table.
+  WireIDSpan channelToWire(raw::ChannelID_t icha) const {
+    const WireID* pwir = m_channelWires.data();
+    return WireIDSpan(pwir + m_channelWireOffsets[icha], pwir + m_channelWireOffsets[icha+1]);
+  }
+
+  // Channel for a wire. The plane must be in the layout.
+  raw::ChannelID_t planeWireToChannel(const WireID& wid) const {
+    const PlaneEntry& ent = m_planes[planeIndex(wid)];
+    return ent.firstChannel + (ent.wireOffset + wid.Wire)%ent.nchan;
+  }
+
+  // Wire coordinate for position (ypos, zpos). The plane must be in the layout.
+  double wireCoordinate(double ypos, double zpos, const PlaneID& pid) const {
+    const PlaneEntry& ent = m_planes[planeIndex(pid)];
+    float distance = (ypos - ent.y0)*ent.cy + (zpos - ent.z0)*ent.cz;
+    return ent.sorting*distance/ent.pitch;
+  }
+
+  // Is the plane in the layout?
+  bool hasPlane(const PlaneID& pid) const {
+    return pid.Cryostat < m_ntpcs.size() && pid.TPC < m_ntpcs[pid.Cryostat] && pid.Plane < m_nplane;
+  }
+
+private:
+
+  // Values for one TPC plane.
+  struct PlaneEntry {
+    raw::ChannelID_t firstChannel = 0;   // first channel of the APA plane
+    Index wireOffset = 0;                // anchored wires on the other side for odd TPCs
+    Index nchan = 1;                     // channels in the APA plane
+    Index nanchored = 0;
+    Index nwire = 0;
+    double y0 = 0.0;
+    double z0 = 0.0;
+    double cy = 0.0;
+    double cz = 0.0;
+    double pitch = 1.0;
+    double sorting = 1.0;
+  };
+
+  std::vector<Index> m_ntpcs;
+  Index m_nplane = 0;
+  std::vector<std::size_t> m_cryFirstPlane;
+  std::vector<PlaneEntry> m_planes;
+  std::vector<std::size_t> m_channelWireOffsets;
+  std::vector<WireID> m_channelWires;
+
+  std::size_t planeIndex(const PlaneID& pid) const {
+    return m_cryFirstPlane[pid.Cryostat] + pid.TPC*m_nplane + pid.Plane;
+  }
+
+};
+
+#endif
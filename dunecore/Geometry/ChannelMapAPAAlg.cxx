@@ -17,6 +17,8 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "messagefacility/MessageLogger/MessageLogger.h" 
 
+#include <type_traits>
+
 namespace geo{
 
   //----------------------------------------------------------------------------
@@ -24,6 +26,8 @@ namespace geo{
     : fSorter(geo::GeoObjectSorterAPA(p))
   {
     fChannelsPerOpDet = p.get< unsigned int >("ChannelsPerOpDet"      );
+    fUseChannelToWireTable = p.get< bool >("UseChannelToWireTable", false);
+    fLazyWireGeometry = p.get< bool >("LazyWireGeometry", false);
   }
 
   //----------------------------------------------------------------------------
@@ -108,10 +112,13 @@ namespace geo{
 
     //save data into fFirstWireCenterY and fFirstWireCenterZ
     fPlaneData.resize(fNcryostat);
+    fWireModels.resize(fNcryostat);
     for (unsigned int cs=0; cs<fNcryostat; ++cs){
       fPlaneData[cs].resize(cgeo[cs].NTPC());
+      fWireModels[cs].resize(cgeo[cs].NTPC());
       for (unsigned int tpc=0; tpc<cgeo[cs].NTPC(); ++tpc){
         fPlaneData[cs][tpc].resize(cgeo[cs].TPC(tpc).Nplanes());
+        fWireModels[cs][tpc].resize(cgeo[cs].TPC(tpc).Nplanes());
         for (unsigned int plane=0; plane<cgeo[cs].TPC(tpc).Nplanes(); ++plane){
           PlaneData_t& PlaneData = fPlaneData[cs][tpc][plane];
           const geo::PlaneGeo& thePlane = cgeo[cs].TPC(tpc).Plane(plane);
@@ -133,7 +140,9 @@ namespace geo{
           PlaneData.fZmax = endpoint.Z();
           PlaneData.fZmin = endpoint.Z();
 	  unsigned int nwires = thePlane.Nwires(); 
-	  for (unsigned int iwire=0;iwire<nwires;iwire++){
+	  // in the lazy wire geometry mode only the first and last wires are used
+	  unsigned int iwireStep = (fLazyWireGeometry && nwires > 1)? nwires - 1: 1;
+	  for (unsigned int iwire=0;iwire<nwires;iwire+=iwireStep){
             endpoint = thePlane.Wire(iwire).GetStart();
             PlaneData.fYmax = std::max(PlaneData.fYmax,endpoint.Y());
             PlaneData.fYmin = std::min(PlaneData.fYmin,endpoint.Y());
@@ -146,6 +155,13 @@ namespace geo{
             PlaneData.fZmin = std::min(PlaneData.fZmin,endpoint.Z());
 	  } // loop on wire 
 
+          // analytic wire model of the plane, for WireEndPoints()
+          auto const wdir = thePlane.Wire(0).Direction();
+          auto const xyz1 = (nwires > 1)? thePlane.Wire(1).GetCenter(): xyz;
+          fWireModels[cs][tpc][plane] = AnalyticWirePlane(
+            xyz.X(), xyz.Y(), xyz.Z(), wdir.Y(), wdir.Z(), xyz1.Y(), xyz1.Z(), nwires,
+            PlaneData.fYmin, PlaneData.fYmax, PlaneData.fZmin, PlaneData.fZmax);
+
         } // for plane
       } // for TPC
     } // for cryostat
@@ -183,6 +199,30 @@ namespace geo{
       
     }
 
+    // coefficients of WireCoordinate() for the batch calls
+    fWireProjections.resize(fNcryostat);
+    for (unsigned int cs=0; cs<fNcryostat; ++cs){
+      fWireProjections[cs].resize(cgeo[cs].NTPC());
+      for (unsigned int tpc=0; tpc<cgeo[cs].NTPC(); ++tpc){
+        fWireProjections[cs][tpc].resize(cgeo[cs].TPC(tpc).Nplanes());
+        for (unsigned int plane=0; plane<cgeo[cs].TPC(tpc).Nplanes(); ++plane){
+          const PlaneData_t& PlaneData = fPlaneData[cs][tpc][plane];
+          const bool bSuppl = (tpc % 2) == 1;
+          const double scale = PlaneData.fWireSortingInZ/fWirePitch[plane];
+          fWireProjections[cs][tpc][plane] = WirePlaneProjection(
+            PlaneData.fFirstWireCenterY, PlaneData.fFirstWireCenterZ,
+            -scale * (bSuppl? -1.: +1.) * fCosOrientation[plane],
+            scale * fSinOrientation[plane],
+            PlaneData.fYmin, PlaneData.fYmax, PlaneData.fZmin, PlaneData.fZmax,
+            fWiresInPlane[plane]);
+        }
+      }
+    }
+
+    if(fUseChannelToWireTable) buildChannelToWireTable();
+
+    fChannelClasses.fill(*this, geodata);
+
     return;
 
   }
@@ -193,7 +233,43 @@ namespace geo{
 
     PlaneInfoMap_t<raw::ChannelID_t>().swap(fFirstChannelInThisPlane);
     PlaneInfoMap_t<raw::ChannelID_t>().swap(fFirstChannelInNextPlane);
+    std::vector<size_t>().swap(fChannelWireOffsets);
+    std::vector<WireID>().swap(fChannelWires);
+    PlaneInfoMap_t<AnalyticWirePlane>().swap(fWireModels);
+    fChannelClasses.clear();
+
+  }
+
+  //----------------------------------------------------------------------------
+  void ChannelMapAPAAlg::buildChannelToWireTable()
+  {
+    // ChannelToWire() computes the wires while the offsets are empty
+    std::vector<size_t> offsets;
+    offsets.reserve(fNchannels+1);
+    fChannelWires.clear();
+    for(raw::ChannelID_t channel = 0; channel != fNchannels; ++channel){
+      offsets.push_back(fChannelWires.size());
+      std::vector<WireID> const wires = ChannelToWire(channel);
+      fChannelWires.insert(fChannelWires.end(), wires.begin(), wires.end());
+    }
+    offsets.push_back(fChannelWires.size());
+    fChannelWires.shrink_to_fit();
+    fChannelWireOffsets = std::move(offsets);
+
+    mf::LogInfo("ChannelMapAPAAlg") << "Channel-to-wire table has " << fChannelWires.size()
+                                    << " wires for " << fNchannels << " channels";
+  }
 
+  //----------------------------------------------------------------------------
+  ChannelMapAPAAlg::WireIDSpan ChannelMapAPAAlg::ChannelToWireSpan(raw::ChannelID_t channel) const
+  {
+    if(channel >= fNchannels )
+      throw cet::exception("Geometry") << "ILLEGAL CHANNEL ID for channel " << channel << "\n";
+    if(fChannelWireOffsets.empty())
+      throw cet::exception("Geometry") << "ChannelMapAPAAlg::ChannelToWireSpan: no channel-to-wire table"
+                                       << " (set UseChannelToWireTable)\n";
+    WireID const* wires = fChannelWires.data();
+    return WireIDSpan(wires + fChannelWireOffsets[channel], wires + fChannelWireOffsets[channel+1]);
   }
 
   //----------------------------------------------------------------------------
@@ -204,6 +280,11 @@ namespace geo{
     if(channel >= fNchannels )
       throw cet::exception("Geometry") << "ILLEGAL CHANNEL ID for channel " << channel << "\n";
 
+    if(!fChannelWireOffsets.empty()){
+      WireIDSpan const wires = ChannelToWireSpan(channel);
+      return std::vector<WireID>(wires.begin(), wires.end());
+    }
+
     std::vector< WireID > AllSegments;
     
     static unsigned int cstat;
@@ -312,6 +393,39 @@ namespace geo{
 
     return PlaneData.fWireSortingInZ * distance/fWirePitch[planeid.Plane];
   } // ChannelMapAPAAlg::WireCoordinate()
+
+
+  //----------------------------------------------------------------------------
+  std::pair<geo::Point_t, geo::Point_t> ChannelMapAPAAlg::WireEndPoints
+    (geo::WireID const& wireid) const
+  {
+    AnalyticWirePlane const& model = AccessElement(fWireModels, wireid);
+    if(wireid.Wire >= model.nwires())
+      throw cet::exception("Geometry") << "ChannelMapAPAAlg::WireEndPoints: invalid wire "
+                                       << std::string(wireid) << "\n";
+    AnalyticWirePlane::Segment const& seg = model.endpoints(wireid.Wire);
+    return { geo::Point_t(seg.x, seg.y1, seg.z1), geo::Point_t(seg.x, seg.y2, seg.z2) };
+  } // ChannelMapAPAAlg::WireEndPoints()
+
+
+  //----------------------------------------------------------------------------
+  void ChannelMapAPAAlg::WireCoordinates
+    (double const* YPos, double const* ZPos, std::size_t n,
+     geo::PlaneID const& planeid, double* wireCoords) const
+  {
+    AccessElement(fWireProjections, planeid).wireCoordinates(YPos, ZPos, n, wireCoords);
+  } // ChannelMapAPAAlg::WireCoordinates()
+
+
+  //----------------------------------------------------------------------------
+  void ChannelMapAPAAlg::NearestWires
+    (double const* YPos, double const* ZPos, std::size_t n,
+     geo::PlaneID const& planeid, geo::WireID::WireID_t* wires) const
+  {
+    static_assert(std::is_same_v<geo::WireID::WireID_t, WirePlaneProjection::WireNumber>,
+                  "Wire number types differ");
+    AccessElement(fWireProjections, planeid).nearestWires(YPos, ZPos, n, wires);
+  } // ChannelMapAPAAlg::NearestWires()
   
   //----------------------------------------------------------------------------
   WireID ChannelMapAPAAlg::NearestWireID
@@ -384,6 +498,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   SigType_t ChannelMapAPAAlg::SignalTypeForChannelImpl( raw::ChannelID_t const channel )  const
   {
+    if ( fChannelClasses.hasChannel(channel) ) return fChannelClasses.signalType(channel);
     raw::ChannelID_t chan = channel % fChannelsPerAPA;
     SigType_t sigt = kInduction;
 
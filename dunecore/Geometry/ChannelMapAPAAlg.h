@@ -16,7 +16,13 @@
 #include "larcoreobj/SimpleTypesAndConstants/readout_types.h" // readout::ROPID, ...
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
 #include "larcorealg/Geometry/ChannelMapAlg.h"
+#include "larcorealg/CoreUtils/span.h"
 #include "dunecore/Geometry/GeoObjectSorterAPA.h"
+#include "dunecore/Geometry/WirePlaneProjection.h"
+#include "dunecore/Geometry/AnalyticWirePlane.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h"
+#include <utility>
+#include "dunecore/Geometry/ChannelClassTable.h"
 
 #include "fhiclcpp/ParameterSet.h"
 
@@ -34,6 +40,20 @@ namespace geo{
     /// Returns a list of TPC wires connected to the specified readout channel ID
     /// @throws cet::exception (category: "Geometry") if non-existent channel
     std::vector<WireID>      ChannelToWire(raw::ChannelID_t channel) const override;
+
+    /// Non-owning view of the wires connected to one channel
+    using WireIDSpan = util::span<WireID const*>;
+
+    /// Same as ChannelToWire() but without allocating: returns a view of the
+    /// channel's entries in the precomputed table, which is built in Initialize()
+    /// if the parameter UseChannelToWireTable is true. The view is valid until
+    /// the next Initialize() or Uninitialize().
+    /// @throws cet::exception (category: "Geometry") if non-existent channel or no table
+    WireIDSpan               ChannelToWireSpan(raw::ChannelID_t channel) const;
+
+    /// Returns whether the channel-to-wire table is built
+    bool                     HasChannelToWireTable() const
+      { return !fChannelWireOffsets.empty(); }
     
     unsigned int             Nchannels()                            const override;
     
@@ -52,11 +72,30 @@ namespace geo{
     virtual WireID NearestWireID
       (const geo::Point_t& worldPos, geo::PlaneID const& planeID) const override;
     //@}
+
+    /// @brief Batch version of WireCoordinate() for the n points (YPos[i], ZPos[i])
+    /// in one plane, computed in single precision (see WirePlaneProjection)
+    void WireCoordinates(double const* YPos, double const* ZPos, std::size_t n,
+                         geo::PlaneID const& planeID, double* wireCoords) const;
+
+    /// @brief Batch version of NearestWireID() for the n points (YPos[i], ZPos[i])
+    /// in one plane, filling the wire numbers (see WirePlaneProjection)
+    void NearestWires(double const* YPos, double const* ZPos, std::size_t n,
+                      geo::PlaneID const& planeID, geo::WireID::WireID_t* wires) const;
+
+    /// @brief Returns the end points of a wire from the analytic wire model of its
+    /// plane (see AnalyticWirePlane). The end points of all the wires of a plane are
+    /// computed and cached on the first call for that plane.
+    /// @throws cet::exception (category: "Geometry") if non-existent wire
+    std::pair<geo::Point_t, geo::Point_t> WireEndPoints(geo::WireID const& wireID) const;
+
     //@{
     virtual raw::ChannelID_t PlaneWireToChannel(geo::WireID const& wireID) const override;
     //@}
     View_t                   View( raw::ChannelID_t const channel )      const;
     SigType_t                SignalTypeForChannelImpl( raw::ChannelID_t const channel) const override;
+    /// Per-channel signal type, view and plane, filled in Initialize()
+    ChannelClassTable const& ChannelClasses() const { return fChannelClasses; }
     std::set<View_t>  const& Views()                                     const;
     std::set<PlaneID> const& PlaneIDs()                                  const override;
 
@@ -262,6 +301,7 @@ namespace geo{
                                                                           ///< in the heirachy
 
     geo::GeoObjectSorterAPA                              fSorter;         ///< sorts geo::XXXGeo objects
+    ChannelClassTable                                    fChannelClasses; ///< per-channel signal type, view and plane
 
     /// all data we need for each APA
     typedef struct {
@@ -283,6 +323,24 @@ namespace geo{
     std::vector< double > fSinOrientation; // to explore improving speed
     std::vector< double > fCosOrientation; // to explore improving speed
 
+    /// single-precision wire coordinate tables for the batch calls (indices: c t p)
+    PlaneInfoMap_t<WirePlaneProjection>                  fWireProjections;
+
+    /// analytic wire models for WireEndPoints() (indices: c t p)
+    PlaneInfoMap_t<AnalyticWirePlane>                    fWireModels;
+
+    /// if true, Initialize() takes the wire frame of each plane from its first and
+    /// last wires instead of scanning the end points of every wire
+    bool                                                 fLazyWireGeometry;
+
+    /// channel-to-wire table in compressed-row form: the wires of channel c are
+    /// fChannelWires[fChannelWireOffsets[c]] to fChannelWires[fChannelWireOffsets[c+1]-1]
+    bool                        fUseChannelToWireTable;
+    std::vector<size_t>         fChannelWireOffsets;
+    std::vector<WireID>         fChannelWires;
+
+    void buildChannelToWireTable();
+
   };
 
 }
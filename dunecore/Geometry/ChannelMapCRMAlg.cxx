@@ -146,6 +146,7 @@ namespace geo{
 
     MF_LOG_DEBUG("ChannelMapCRM") << "# of channels is " << fNchannels;
 
+    fChannelClasses.fill(*this, geodata);
 
     return;
   }
@@ -153,6 +154,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   void ChannelMapCRMAlg::Uninitialize()
   {
+    fChannelClasses.clear();
   }
 
   //----------------------------------------------------------------------------
@@ -298,6 +300,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   SigType_t ChannelMapCRMAlg::SignalTypeForChannelImpl(raw::ChannelID_t const channel) const
   {
+    if ( fChannelClasses.hasChannel(channel) ) return fChannelClasses.signalType(channel);
 
     // still assume one cryostat for now -- faster
     unsigned int nChanPerTPC = fNchannels/fNTPC[0];
@@ -16,6 +16,7 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "larcorealg/Geometry/ChannelMapAlg.h"
 #include "dunecore/Geometry/GeoObjectSorterCRM.h"
+#include "dunecore/Geometry/ChannelClassTable.h"
 #include "fhiclcpp/ParameterSet.h"
 
 namespace geo{
@@ -54,6 +55,8 @@ namespace geo{
     //@}
     
     virtual SigType_t                SignalTypeForChannelImpl( raw::ChannelID_t const channel ) const override;
+    /// Per-channel signal type, view and plane, filled in Initialize()
+    ChannelClassTable const& ChannelClasses() const { return fChannelClasses; }
     virtual std::set<PlaneID> const& PlaneIDs()                                   const override;
   
     
@@ -193,6 +196,7 @@ namespace geo{
     PlaneInfoMap_t<unsigned int>  fWiresPerPlane;  ///< The number of wires in this plane 
                                                    ///< in the heirachy
     geo::GeoObjectSorterCRM  fSorter;              ///< class to sort geo objects
+    ChannelClassTable        fChannelClasses; ///< per-channel signal type, view and plane
     
     
     /// Retrieved the wire cound for the specified plane ID
@@ -38,49 +38,35 @@ namespace geo{
     mf::LogInfo("ChannelMapCRUAlg") << "Initializing CRM ChannelMap...";
 
     fNTPC.resize(fNcryostat);
-    fWireCounts.resize(fNcryostat);
     fNPlanes.resize(fNcryostat);
-    fFirstWireProj.resize(fNcryostat);
-    fOrthVectorsY.resize(fNcryostat);
-    fOrthVectorsZ.resize(fNcryostat);
-    fPlaneBaselines.resize(fNcryostat);
-    fWiresPerPlane.resize(fNcryostat);
     fFirstChannelInNextPlane.resize(fNcryostat);
     fFirstChannelInThisPlane.resize(fNcryostat);
     fPlaneIDs.clear();
     fTopChannel = 0;
 
-    int RunningTotal = 0;
-
     for(unsigned int cs = 0; cs != fNcryostat; ++cs){
-      
       fNTPC[cs] = cgeo[cs].NTPC();
+      fNPlanes[cs].resize(fNTPC[cs]);
+      for(unsigned int TPCCount = 0; TPCCount != fNTPC[cs]; ++TPCCount)
+        fNPlanes[cs][TPCCount] = cgeo[cs].TPC(TPCCount).Nplanes();
+    }
+    fChannelTable.reset(fNPlanes);
+
+    for(unsigned int cs = 0; cs != fNcryostat; ++cs){
       
       // Size up all the vectors 
-      fWireCounts[cs]             .resize(fNTPC[cs]);
-      fFirstWireProj[cs]          .resize(fNTPC[cs]);
-      fOrthVectorsY[cs]           .resize(fNTPC[cs]);
-      fOrthVectorsZ[cs]           .resize(fNTPC[cs]);
-      fPlaneBaselines[cs]         .resize(fNTPC[cs]);
-      fWiresPerPlane[cs]          .resize(fNTPC[cs]);
-      fNPlanes[cs]                .resize(fNTPC[cs]);
       fFirstChannelInThisPlane[cs].resize(fNTPC[cs]);
       fFirstChannelInNextPlane[cs].resize(fNTPC[cs]);
 
       for(unsigned int TPCCount = 0; TPCCount != fNTPC[cs]; ++TPCCount)
 	{
-	  unsigned int PlanesThisTPC = cgeo[cs].TPC(TPCCount).Nplanes();
-	  fWireCounts[cs][TPCCount]   .resize(PlanesThisTPC);
-	  fFirstWireProj[cs][TPCCount].resize(PlanesThisTPC);
-	  fOrthVectorsY[cs][TPCCount] .resize(PlanesThisTPC);
-	  fOrthVectorsZ[cs][TPCCount] .resize(PlanesThisTPC);
-	  fNPlanes[cs][TPCCount]=PlanesThisTPC;
+	  unsigned int PlanesThisTPC = fNPlanes[cs][TPCCount];
 	  
 	  for(unsigned int PlaneCount = 0; PlaneCount != PlanesThisTPC; ++PlaneCount){
 	    
-	    fPlaneIDs.emplace(PlaneID(cs, TPCCount, PlaneCount));
+	    PlaneID const pid(cs, TPCCount, PlaneCount);
+	    fPlaneIDs.emplace(pid);
 	    double ThisWirePitch = cgeo[cs].TPC(TPCCount).WirePitch(PlaneCount);
-	    fWireCounts[cs][TPCCount][PlaneCount] = cgeo[cs].TPC(TPCCount).Plane(PlaneCount).Nwires();
 	    
 	    const geo::WireGeo& firstWire = cgeo[cs].TPC(TPCCount).Plane(PlaneCount).Wire(0);
 	    const double sth = firstWire.SinThetaZ(), cth = firstWire.CosThetaZ();
@@ -102,19 +88,19 @@ namespace geo{
           // That runs as fast as humanly possible.
           // We predivide everything by the wire pitch so we don't do this in the loop.
           //
-          // Putting this together into the useful constants we will use later per plane and tpc:
-          fOrthVectorsY[cs][TPCCount][PlaneCount] = OrthY / ThisWirePitch;
-          fOrthVectorsZ[cs][TPCCount][PlaneCount] = OrthZ / ThisWirePitch;
+          // Putting this together into the useful constants we will use later per plane and tpc
+          // (held in single precision by the channel table):
+          float FirstWireProj = WireCentre1.Y()*OrthY + WireCentre1.Z()*OrthZ;
+          FirstWireProj /= ThisWirePitch;
+          fChannelTable.setWireCoordinate
+            (pid, OrthY / ThisWirePitch, OrthZ / ThisWirePitch, FirstWireProj);
           
-          fFirstWireProj[cs][TPCCount][PlaneCount]  = WireCentre1.Y()*OrthY + WireCentre1.Z()*OrthZ;
-          fFirstWireProj[cs][TPCCount][PlaneCount] /= ThisWirePitch;
-          
-          // now to count up wires in each plane and get first channel in each plane
-          int WiresThisPlane = cgeo[cs].TPC(TPCCount).Plane(PlaneCount).Nwires();        
-          fWiresPerPlane[cs] .at(TPCCount).push_back(WiresThisPlane);
-          fPlaneBaselines[cs].at(TPCCount).push_back(RunningTotal);
-          
-          RunningTotal += WiresThisPlane;
+          // now to count up wires in each plane and get first channel in each plane;
+          // each plane is read out as its own ROP
+          unsigned int WiresThisPlane = cgeo[cs].TPC(TPCCount).Plane(PlaneCount).Nwires();
+          fChannelTable.setPlane(pid, fTopChannel, WiresThisPlane);
+          fChannelTable.addROP
+            (ConvertWirePlaneToROP(pid), fTopChannel, WiresThisPlane, { pid });
 
           fFirstChannelInThisPlane[cs].at(TPCCount).push_back(fTopChannel);
           fTopChannel += WiresThisPlane;
@@ -123,12 +109,14 @@ namespace geo{
         }// end loop over planes
       }// end loop over TPCs
     }// end loop over cryostats
+    fChannelTable.setEndChannel(fTopChannel);
 
     // calculate the total number of channels in the detector
     fNchannels = fTopChannel;
 
     MF_LOG_DEBUG("ChannelMapCRU") << "# of channels is " << fNchannels;
 
+    fChannelClasses.fill(*this, geodata);
 
     return;
   }
@@ -136,47 +124,21 @@ namespace geo{
   //----------------------------------------------------------------------------
   void ChannelMapCRUAlg::Uninitialize()
   {
+    fChannelTable.clear();
+    fChannelClasses.clear();
   }
 
   //----------------------------------------------------------------------------
   std::vector<geo::WireID> ChannelMapCRUAlg::ChannelToWire(raw::ChannelID_t channel)  const
   {
     std::vector< geo::WireID > AllSegments; 
-    unsigned int cstat = 0;
-    unsigned int tpc   = 0;
-    unsigned int plane = 0;
-    unsigned int wire  = 0;
     
     // first check if this channel ID is legal
-    if(channel > fTopChannel)
+    if(channel >= fTopChannel)
       throw cet::exception("Geometry") << "ILLEGAL CHANNEL ID for channel " << channel << "\n";
     
-    // then go find which plane, tpc and cryostat it is in from the information we stored earlier
-    bool foundWid(false);
-    for(unsigned int csloop = 0; csloop != fNcryostat; ++csloop){
-      for(unsigned int tpcloop = 0; tpcloop != fNTPC[csloop]; ++tpcloop){
-        for(unsigned int planeloop = 0;
-	    planeloop!=fFirstChannelInNextPlane[csloop][tpcloop].size();
-	    ++planeloop)
-	  {
-	    if(channel < fFirstChannelInNextPlane[csloop][tpcloop][planeloop]){
-	      cstat = csloop;
-	      tpc   = tpcloop;
-	      plane = planeloop;
-	      wire  = channel - fFirstChannelInThisPlane[cstat][tpcloop][planeloop];
-	      foundWid = true;
-	      break;
-	    }     
-          if(foundWid) break;
-        }// end plane loop
-        if(foundWid) break;
-      }// end tpc loop
-      if(foundWid) break;
-    }// end cryostat loop
-
-    geo::WireID CodeWire(cstat, tpc, plane, wire);
-    
-    AllSegments.push_back(CodeWire);
+    // then find the plane from the ROP table built in Initialize()
+    fChannelTable.channelToWire(channel, AllSegments);
 
     return AllSegments;
   }
@@ -202,9 +164,7 @@ namespace geo{
     // Returns the wire number corresponding to a (Y,Z) position in PlaneNo 
     // with float precision.
     // B. Baller August 2014
-    return YPos*AccessElement(fOrthVectorsY, planeID) 
-         + ZPos*AccessElement(fOrthVectorsZ, planeID)
-         - AccessElement(fFirstWireProj, planeID);
+    return fChannelTable.wireCoordinate(YPos, ZPos, planeID);
   }
 
   
@@ -257,12 +217,11 @@ namespace geo{
   raw::ChannelID_t ChannelMapCRUAlg::PlaneWireToChannel
     (geo::WireID const& wireID) const
   {
-    unsigned int const* pBaseLine = GetElementPtr(fPlaneBaselines, wireID);
     // This is the actual lookup part - first make sure coordinates are legal
-    if (pBaseLine) {
+    if (fChannelTable.hasPlane(wireID)) {
       // if the channel has legal coordinates, its ID is given by the wire
       // number above the number of wires in lower planes, tpcs and cryostats
-      return *pBaseLine + wireID.Wire;
+      return fChannelTable.planeWireToChannel(wireID);
     }
     else{  
       // if the coordinates were bad, throw an exception
@@ -281,6 +240,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   SigType_t ChannelMapCRUAlg::SignalTypeForChannelImpl(raw::ChannelID_t const channel) const
   {
+    if ( fChannelClasses.hasChannel(channel) ) return fChannelClasses.signalType(channel);
 
     // still assume one cryostat for now -- faster
     unsigned int nChanPerTPC = fNchannels/fNTPC[0];
@@ -480,14 +440,13 @@ namespace geo{
   {
     if (!raw::isValidChannelID(channel)) return {}; // invalid ROP returned
     
-    // which wires does the channel cover?
-    std::vector<geo::WireID> wires = ChannelToWire(channel);
-    
-    // - none:
-    if (wires.empty()) return {}; // default-constructed ID, invalid
+    if (channel >= fTopChannel)
+      throw cet::exception("Geometry") << "ILLEGAL CHANNEL ID for channel " << channel << "\n";
     
-    // - one: maps its plane ID into a ROP ID
-    return WirePlaneToROP(wires[0]);
+    // which ROP is the channel in?
+    unsigned int const irop = fChannelTable.findROP(channel);
+    if (irop == PlaneChannelTable::npos) return {}; // default-constructed ID, invalid
+    return fChannelTable.ropID(irop);
   } // ChannelMapCRUAlg::ChannelToROP()
   
   
@@ -506,8 +465,7 @@ namespace geo{
     (readout::ROPID const& ropid) const
   {
     if (!ropid.isValid) return raw::InvalidChannelID;
-    return (raw::ChannelID_t)
-      AccessElement(fPlaneBaselines, ConvertROPtoWirePlane(ropid));
+    return fChannelTable.planeFirstChannel(ConvertROPtoWirePlane(ropid));
   } // ChannelMapCRUAlg::FirstChannelInROP()
   
   
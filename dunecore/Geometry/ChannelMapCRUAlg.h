@@ -16,6 +16,8 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "larcorealg/Geometry/ChannelMapAlg.h"
 #include "dunecore/Geometry/GeoObjectSorterCRU.h"
+#include "dunecore/Geometry/ChannelClassTable.h"
+#include "dunecore/Geometry/PlaneChannelTable.h"
 #include "fhiclcpp/ParameterSet.h"
 
 namespace geo{
@@ -54,6 +56,8 @@ namespace geo{
     //@}
     
     virtual SigType_t                SignalTypeForChannelImpl( raw::ChannelID_t const channel ) const override;
+    /// Per-channel signal type, view and plane, filled in Initialize()
+    ChannelClassTable const& ChannelClasses() const { return fChannelClasses; }
     virtual std::set<PlaneID> const& PlaneIDs()                                   const override;
   
     
@@ -177,27 +181,17 @@ namespace geo{
     std::vector<unsigned int>     fNTPC;           ///< number of TPCs in each cryostat
     std::set<View_t>              fViews;          ///< vector of the views present in the detector
     std::set<PlaneID>             fPlaneIDs;       ///< vector of the PlaneIDs present in the detector
-    PlaneInfoMap_t<float>         fFirstWireProj;  ///< Distance (0,0,0) to first wire          
-                                                   ///< along orth vector per plane per TPC
-    PlaneInfoMap_t<float>         fOrthVectorsY;   ///< Unit vectors orthogonal to wires in
-    PlaneInfoMap_t<float>         fOrthVectorsZ;   ///< each plane - stored as 2 components
-                                                   ///< to avoid having to invoke any bulky
-                                                   ///< TObjects / CLHEP vectors etc         
-    PlaneInfoMap_t<float>         fWireCounts;     ///< Number of wires in each plane - for
-                                                   ///< range checking after calculation   
     TPCInfoMap_t<unsigned int>    fNPlanes;        ///< Number of planes in each TPC - for
                                                    ///< range checking after calculation   
-    PlaneInfoMap_t<unsigned int>  fPlaneBaselines; ///< The number of wires in all the 
-                                                   ///< tpcs and planes up to this one 
-                                                   ///< in the heirachy
-    PlaneInfoMap_t<unsigned int>  fWiresPerPlane;  ///< The number of wires in this plane 
-                                                   ///< in the heirachy
+    PlaneChannelTable        fChannelTable;        ///< first channel, wire count and wire
+                                                   ///< coordinate constants of each plane
     geo::GeoObjectSorterCRU  fSorter;              ///< class to sort geo objects
+    ChannelClassTable        fChannelClasses; ///< per-channel signal type, view and plane
     
     
     /// Retrieved the wire cound for the specified plane ID
     unsigned int WireCount(geo::PlaneID const& id) const
-    { return AccessElement(fWireCounts, id); }
+    { return fChannelTable.nWires(id); }
     
     /// Returns the largest number of TPCs in a single cryostat
     unsigned int MaxTPCs() const;
@@ -5,6 +5,11 @@
 //
 // Generated at Fri Jan 15 14:32:57 2016 by Vyacheslav Galymov using artmod
 // from cetpkgsupport v1_10_01.
+//
+// Parameters:
+//     DumpWires - print the end points and channel of every wire (default false)
+//     Parallel  - check the planes concurrently and merge the results (default true)
+//     MakePlots - draw the TPC boxes and wires in wires.pdf (default false)
 ////////////////////////////////////////////////////////////////////////
 
 #include "art/Framework/Core/EDAnalyzer.h"
@@ -25,8 +30,42 @@
 #include "TH2F.h"
 #include "TLine.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <array>
+
+namespace {
+
+  // Results of the checks on one wire plane, filled independently for each
+  // plane and printed in plane order.
+  struct PlaneCheck {
+    std::string info;      // plane summary
+    std::string errors;    // pitch inconsistencies
+    std::string dump;      // wire dump if requested
+    int nwires = 0;
+    std::vector<std::array<double, 4>> lines; // wire (z0, y0, z1, y1) for plots
+  };
+
+  // Call fun(i) for i in [0, n), concurrently if parallel is set.
+  template<class F>
+  void forEachIndex(bool parallel, size_t n, F fun) {
+    if ( ! parallel ) {
+      for ( size_t i = 0; i < n; ++i ) fun(i);
+      return;
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                      [&](const tbb::blocked_range<size_t> &range) {
+                        for ( size_t i = range.begin(); i != range.end(); ++i ) fun(i);
+                      });
+  }
+
+}
 
 class CheckDPhaseGeometry;
 
@@ -51,20 +90,107 @@ private:
   // Declare member data here.
   //const double dpwpitch = 0.3125; //cm
   bool m_dump_wires;
+  bool m_parallel;   // check the planes concurrently
+  bool m_make_plots; // draw the TPC boxes and wires in wires.pdf
+
+  // Check the wires of one plane.
+  PlaneCheck checkPlane(geo::GeometryCore const& geom, geo::PlaneGeo const& vPlane) const;
+
+  // Dump the wires of one plane.
+  std::string dumpPlane(geo::GeometryCore const& geom, geo::PlaneGeo const& vPlane) const;
 };
 
 
 CheckDPhaseGeometry::CheckDPhaseGeometry(fhicl::ParameterSet const & p)
   :
-  EDAnalyzer(p), m_dump_wires(p.get< bool >("DumpWires", false))
+  EDAnalyzer(p), m_dump_wires(p.get< bool >("DumpWires", false)),
+  m_parallel(p.get< bool >("Parallel", true)),
+  m_make_plots(p.get< bool >("MakePlots", false))
  // More initializers here.
 {;}
 
 
+PlaneCheck CheckDPhaseGeometry::checkPlane(geo::GeometryCore const& geom, geo::PlaneGeo const& vPlane) const
+{
+  PlaneCheck res;
+  std::ostringstream sout;
+  std::ostringstream serr;
+  auto const& planeID = vPlane.ID();
+  size_t const t = planeID.TPC;
+  auto view = vPlane.View();
+  if( view == geo::kU )
+    sout<<"  View type geo::kU"<<std::endl;
+  else if( view == geo::kV )
+    sout<<"  View type geo::kV"<<std::endl;
+  else if( view == geo::kX )
+    sout<<"  View type geo::kX"<<std::endl;
+  else if( view == geo::kY )
+    sout<<"  View type geo::kY"<<std::endl;
+  else if( view == geo::kZ )
+    sout<<"  View type geo::kZ"<<std::endl;
+  else 
+    sout<<"  View "<<view<<" uknown"<<std::endl;
+  
+  auto sigtype = geom.SignalType(planeID);
+  if(  sigtype == geo::kCollection )
+    sout<<"  View is geo::kCollection"<<std::endl;
+  else if( sigtype == geo::kInduction )
+    sout<<"  View is geo::kInduction"<<std::endl;
+  else
+    sout<<"  View signal type is unknown"<<std::endl;
+  
+  sout<<"  Number of wires : "<<vPlane.Nwires()<<std::endl;
+  sout<<"  Wire pitch      : "<<vPlane.WirePitch()<<std::endl;
+  sout<<"  Theta Z         : "<<vPlane.ThetaZ()<<std::endl;
+
+  double prval    = 0; 
+  double refpitch = 0;
+  for (geo::WireID const& wid : geom.Iterate<geo::WireID>(planeID)) {
+    auto const [p, w] = std::make_pair(wid.Plane, wid.Wire);
+    ++res.nwires;
+    
+    double xyz0[3];
+    double xyz1[3];
+    geom.WireEndPoints(wid,xyz0,xyz1);
+    if( m_make_plots ) res.lines.push_back({xyz0[2],xyz0[1],xyz1[2],xyz1[1]});
+    
+    double pitch = 0;
+    if( view == geo::kX )   {pitch = xyz0[0] - prval; prval = xyz0[0];}
+    else if(view == geo::kY){pitch = xyz0[1] - prval; prval = xyz0[1];}
+    else if(view == geo::kZ){pitch = xyz0[2] - prval; prval = xyz0[2];}
+    else { 
+      continue;
+    }
+    if( w == 1 ){ refpitch = pitch; }
+    if(w > 0 && fabs(pitch - refpitch) > 0.00001)
+      {
+        serr<<" Bad pitch : "<<t<<" "<<p<<" "<<w<<" "<<w-1<<" "<<pitch<<" "<<refpitch<<std::endl;
+      }
+  }
+  sout<<std::endl;
+  res.info = sout.str();
+  res.errors = serr.str();
+  return res;
+}
+
+
+std::string CheckDPhaseGeometry::dumpPlane(geo::GeometryCore const& geom, geo::PlaneGeo const& vPlane) const
+{
+  std::ostringstream sout;
+  double xyz[3];   
+  double abc[3];                                                                 
+  for (auto const& wid : geom.Iterate<geo::WireID>(vPlane.ID())) {
+    geom.WireEndPoints(wid,xyz,abc);
+    auto chan=geom.PlaneWireToChannel(wid);
+    sout << "FLAG " << chan << " " << wid << " " << xyz[0] << " " << xyz[1] << " " << xyz[2] <<  " " << abc[0] << " " << abc[1] << " " << abc[2] << std::endl;
+  }
+  return sout.str();
+}
+
+
 void CheckDPhaseGeometry::analyze(art::Event const & e)
 {
   std::vector<TBox*> TPCBox;
-  std::vector<TLine*> Wires;
 
   double minx = 1e9;
   double maxx = -1e9;
@@ -77,6 +203,7 @@ void CheckDPhaseGeometry::analyze(art::Event const & e)
 
   // get geometry
   art::ServiceHandle<geo::Geometry> geo;
+  geo::GeometryCore const& geom = *geo;
   /*
   // check channel map
   for( unsigned ch = 0; ch < geo->Nchannels(); ++ch ){
@@ -88,9 +215,23 @@ void CheckDPhaseGeometry::analyze(art::Event const & e)
   */
   std::cout<<"Total number of TPC "<<geo->NTPC()<<std::endl;
 
+  // The planes of all TPCs are checked first, concurrently if requested,
+  // and the results are then printed in TPC and plane order.
+  std::vector<geo::TPCGeo const*> tpcs;
+  std::vector<geo::PlaneGeo const*> planes;
+  std::vector<size_t> firstPlane;
   for (geo::TPCGeo const& tpc: geo->Iterate<geo::TPCGeo>(geo::CryostatID{0})) {
-    size_t const t = tpc.ID().TPC;
-    //if (t%2==0) continue;
+    tpcs.push_back(&tpc);
+    firstPlane.push_back(planes.size());
+    for (geo::PlaneGeo const& vPlane : geo->Iterate<geo::PlaneGeo>(tpc.ID())) planes.push_back(&vPlane);
+  }
+  firstPlane.push_back(planes.size());
+  std::vector<PlaneCheck> checks(planes.size());
+  forEachIndex(m_parallel, planes.size(),
+               [&](size_t ipla) { checks[ipla] = checkPlane(geom, *planes[ipla]); });
+
+  for (size_t itpc = 0; itpc < tpcs.size(); ++itpc) {
+    geo::TPCGeo const& tpc = *tpcs[itpc];
     auto const world = tpc.GetCenter();
     if (minx>world.X()-tpc.ActiveHalfWidth())
       minx = world.X()-tpc.ActiveHalfWidth();
@@ -105,121 +246,53 @@ void CheckDPhaseGeometry::analyze(art::Event const & e)
     if (maxz<world.Z()+tpc.ActiveLength()/2.)
       maxz = world.Z()+tpc.ActiveLength()/2.;
 
+    if( m_make_plots ){
+      TPCBox.push_back(new TBox(world.Z()-tpc.ActiveLength()/2.,
+                                world.Y()-tpc.ActiveHalfHeight(),
+                                world.Z()+tpc.ActiveLength()/2.,
+                                world.Y()+tpc.ActiveHalfHeight()));
+      TPCBox.back()->SetFillStyle(0);
+      TPCBox.back()->SetLineStyle(2);
+      TPCBox.back()->SetLineWidth(2);
+      TPCBox.back()->SetLineColor(16);
+    }
 
-    TPCBox.push_back(new TBox(world.Z()-tpc.ActiveLength()/2.,
-                              world.Y()-tpc.ActiveHalfHeight(),
-                              world.Z()+tpc.ActiveLength()/2.,
-                              world.Y()+tpc.ActiveHalfHeight()));
-    TPCBox.back()->SetFillStyle(0);
-    TPCBox.back()->SetLineStyle(2);
-    TPCBox.back()->SetLineWidth(2);
-    TPCBox.back()->SetLineColor(16);
-
-    // std::cout<<"TPC "<<t<<" has found "<<geo->Nplanes(t)<<" planes"<<std::endl;
-    // std::cout<<"TPC coordinates : "<<world.X()<<" "<<world.Y()<<" "<<world.Z()<<std::endl;
-    // std::cout<<"Drift direction : ";
-    // if(tpc.DriftDirection() == geo::kPosX) std::cout<<"geo::kPosX"<<std::endl;
-    // else if(tpc.DriftDirection() == geo::kNegX) std::cout<<"geo::kNegX"<<std::endl;
-    // else std::cout<<" Uknown drift direction"<<std::endl;
-    // std::cout<<"Drift distance  : "<<tpc.DriftDistance()<<std::endl;
     std::cout<<tpc.TPCInfo("  ", 4)<<std::endl;
     std::cout<<std::endl;
-    // scan the planes
-    for (geo::PlaneGeo const& vPlane : geo->Iterate<geo::PlaneGeo>(tpc.ID()))
-      {
-        auto const& planeID = vPlane.ID();
-	auto view = vPlane.View();
-	if( view == geo::kU )
-	  std::cout<<"  View type geo::kU"<<std::endl;
-	else if( view == geo::kV )
-	  std::cout<<"  View type geo::kV"<<std::endl;
-	else if( view == geo::kX )
-	  std::cout<<"  View type geo::kX"<<std::endl;
-	else if( view == geo::kY )
-	  std::cout<<"  View type geo::kY"<<std::endl;
-	else if( view == geo::kZ )
-	  std::cout<<"  View type geo::kZ"<<std::endl;
-	else 
-	  std::cout<<"  View "<<view<<" uknown"<<std::endl;
-	
-	auto sigtype = geo->SignalType(planeID);
-	if(  sigtype == geo::kCollection )
-	  std::cout<<"  View is geo::kCollection"<<std::endl;
-	else if( sigtype == geo::kInduction )
-	  std::cout<<"  View is geo::kInduction"<<std::endl;
-	else
-	  std::cout<<"  View signal type is unknown"<<std::endl;
-	
-	std::cout<<"  Number of wires : "<<vPlane.Nwires()<<std::endl;
-	std::cout<<"  Wire pitch      : "<<vPlane.WirePitch()<<std::endl;
-	std::cout<<"  Theta Z         : "<<vPlane.ThetaZ()<<std::endl;
-
-	double prval    = 0; 
-	double refpitch = 0;
-        for (auto const& wid : geo->Iterate<geo::WireID>(planeID)) {
-          auto const [p, w] = std::make_pair(wid.Plane, wid.Wire);
-	  ++nwires;
-	  //++nwires_tpc[t];
-	  
-	  if(true)
-	    {
-              double xyz0[3];
-              double xyz1[3];
-              geo->WireEndPoints(wid,xyz0,xyz1);
-	      Wires.push_back(new TLine(xyz0[2],xyz0[1],xyz1[2],xyz1[1]));
-	      
-	      double pitch = 0;
-	      //if( p == 0) {pitch = xyz0[1] - prval; prval = xyz0[1];}
-	      //else if( p == 1) {pitch = xyz0[2] - prval; prval = xyz0[2];}
-	      if( view == geo::kX )   {pitch = xyz0[0] - prval; prval = xyz0[0];}
-	      else if(view == geo::kY){pitch = xyz0[1] - prval; prval = xyz0[1];}
-	      else if(view == geo::kZ){pitch = xyz0[2] - prval; prval = xyz0[2];}
-	      else { 
-		continue;
-		//std::cerr<<"cannot determine the view\n"; break;
-	      }
-	      if( w == 1 ){ refpitch = pitch; }
-	      if(w > 0 && fabs(pitch - refpitch) > 0.00001)
-		{
-		  std::cerr<<" Bad pitch : "<<t<<" "<<p<<" "<<w<<" "<<w-1<<" "<<pitch<<" "<<refpitch<<std::endl;
-		  //<<std::setprecision(15)<<xyz0[0]<<" "<<xyz0[1]<<" "<<xyz0[2]<<std::endl;
-		}
-	    }
-	  //std::cout<<t<<" "<<p<<" "<<w<<" "<<xyz0[0]<<" "<<xyz0[1]<<" "<<xyz0[2]<<std::endl;
-	}
-	std::cout<<std::endl;
-      }
-    //break;
+    for (size_t ipla = firstPlane[itpc]; ipla < firstPlane[itpc+1]; ++ipla) {
+      std::cout<<checks[ipla].info;
+      std::cerr<<checks[ipla].errors;
+      nwires += checks[ipla].nwires;
+    }
   }
 
   if( m_dump_wires ){
-    
-    double xyz[3];   
-    double abc[3];                                                                 
-    for (auto const& wid : geo->Iterate<geo::WireID>()) {
-      geo->WireEndPoints(wid,xyz,abc);
-      auto chan=geo->PlaneWireToChannel(wid);
-      std::cout << "FLAG " << chan << " " << wid << " " << xyz[0] << " " << xyz[1] << " " << xyz[2] <<  " " << abc[0] << " " << abc[1] << " " << abc[2] << std::endl;
-    }
+    std::vector<geo::PlaneGeo const*> allPlanes;
+    for (geo::PlaneGeo const& vPlane : geo->Iterate<geo::PlaneGeo>()) allPlanes.push_back(&vPlane);
+    std::vector<std::string> dumps(allPlanes.size());
+    forEachIndex(m_parallel, allPlanes.size(),
+                 [&](size_t ipla) { dumps[ipla] = dumpPlane(geom, *allPlanes[ipla]); });
+    for (std::string const& dump : dumps) std::cout << dump;
   }// dump wires
 
-    /*
-  TCanvas *can = new TCanvas("c1","c1");
-  can->cd();
-  TH2F *frame = new TH2F("frame",";z (cm);y (cm)",3000,minz,maxz,3000,miny,maxy);
-  frame->SetStats(0);
-  frame->Draw();
-  for (auto box: TPCBox) box->Draw();
-  for (auto wire: Wires) wire->Draw();
-  can->Print("wires.pdf");
-  can->Print("wires.C");
-  std::cout<<"N wires = "<<nwires<<std::endl;
   std::cout<<"Total number of channel wires = "<<nwires<<std::endl;
-  //for (int i = 0; i<8; ++i)
-  //{
-  //std::cout<<"TPC "<<i<<" has "<<nwires_tpc[i]<<" wires"<<std::endl;
-  //}
-  */
+
+  if( m_make_plots ){
+    TCanvas *can = new TCanvas("c1","c1");
+    can->cd();
+    TH2F *frame = new TH2F("frame",";z (cm);y (cm)",3000,minz,maxz,3000,miny,maxy);
+    frame->SetStats(0);
+    frame->Draw();
+    for (auto box: TPCBox) box->Draw();
+    for (PlaneCheck const& check : checks) {
+      for (auto const& line : check.lines) {
+        TLine* wire = new TLine(line[0], line[1], line[2], line[3]);
+        wire->Draw();
+      }
+    }
+    can->Print("wires.pdf");
+    can->Print("wires.C");
+  }
 }
 
 DEFINE_ART_MODULE(CheckDPhaseGeometry)
@@ -5,6 +5,10 @@
 //
 // Generated at Tue Jan  6 22:27:12 2015 by Tingjun Yang using artmod
 // from cetpkgsupport v1_07_00.
+//
+// Parameters:
+//   Parallel  - count the wires of the TPCs and map the channels concurrently (default true)
+//   MakePlots - draw the wire, CRT module and CRT strip plots (default true)
 ////////////////////////////////////////////////////////////////////////
 #include "art/Framework/Core/EDAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
@@ -25,8 +29,12 @@
 #include "TLatex.h"
 #include "TLegend.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <iostream>
 #include <vector>
+#include <array>
 
 //constexpr unsigned short kMaxAuxDets = 100; // unused
 //constexpr unsigned short kMaxTkIDs = 100; // unused
@@ -56,6 +64,12 @@ public:
 private:
 
   // Declare member data here.
+  bool m_Parallel;
+  bool m_MakePlots;
+
+  // Call fun(i) for i in [0, n), concurrently if m_Parallel is set.
+  template<class F>
+  void forEachIndex(size_t n, F fun) const;
 
 };
 
@@ -67,14 +81,25 @@ dune::CheckGeometry::CheckGeometry(fhicl::ParameterSet const & p)
   reconfigure(p);
 }
 
+template<class F>
+void dune::CheckGeometry::forEachIndex(size_t n, F fun) const
+{
+  if (!m_Parallel) {
+    for (size_t i = 0; i < n; ++i) fun(i);
+    return;
+  }
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                    [&](const tbb::blocked_range<size_t> &range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i) fun(i);
+                    });
+}
+
 void dune::CheckGeometry::analyze(art::Event const & evt)
 {
   art::ServiceHandle<geo::Geometry> geo;
 
   //std::cout<<"channel = "<<geo->PlaneWireToChannel(0,600,1)<<std::endl;
 
-  TCanvas *can = new TCanvas("c1","c1");
-  can->cd();
   std::vector<TBox*> TPCBox;
   std::vector<TLine*> Wires;
 
@@ -85,9 +110,36 @@ void dune::CheckGeometry::analyze(art::Event const & evt)
   double minz = 1e9;
   double maxz = -1e9;
   
+  // The wires of each TPC are counted (and the drawn ones collected)
+  // independently, concurrently if requested, and merged in TPC order.
+  std::vector<geo::TPCGeo const*> tpcs;
+  for (geo::TPCGeo const& tpc : geo->Iterate<geo::TPCGeo>(geo::CryostatID{0})) tpcs.push_back(&tpc);
+  std::vector<int> tpc_nwires(tpcs.size(), 0);
+  std::vector<std::vector<std::array<double, 4>>> tpc_lines(tpcs.size());
+  forEachIndex(tpcs.size(), [&](size_t itpc) {
+    geo::TPCGeo const& tpc = *tpcs[itpc];
+    auto const t = tpc.ID().TPC;
+    for (auto const& wid : geo->Iterate<geo::WireID>(tpc.ID())) {
+      auto const [p, w] = std::make_pair(wid.Plane, wid.Wire);
+        ++tpc_nwires[itpc];
+//	if ((t==7&&p==0&&w==192)||
+//	    (t==7&&p==1&&w==112)||
+//	    (t==7&&p==2&&w==0)){
+//	if (true){
+        if (m_MakePlots&&(t==2||t==6||t==10)&&p==0&&w%10==0){
+        double xyz0[3];
+        double xyz1[3];
+        geo->WireEndPoints(wid,xyz0,xyz1);
+          tpc_lines[itpc].push_back({xyz0[2],xyz0[1],xyz1[2],xyz1[1]});
+	}
+      //std::cout<<wid<<" "<<xyz0[0]<<" "<<xyz0[1]<<" "<<xyz0[2]<<std::endl;
+    }
+  });
+
   int nwires = 0;
   std::vector<int> nwires_tpc(geo->NTPC(), 0);
-  for (geo::TPCGeo const& tpc : geo->Iterate<geo::TPCGeo>(geo::CryostatID{0})) {
+  for (size_t itpc = 0; itpc < tpcs.size(); ++itpc) {
+    geo::TPCGeo const& tpc = *tpcs[itpc];
     auto const t = tpc.ID().TPC;
     //if (t%2==0) continue;
     auto const world = tpc.GetCenter();
@@ -103,13 +155,10 @@ void dune::CheckGeometry::analyze(art::Event const & evt)
       minz = world.Z()-tpc.ActiveLength()/2.;
     if (maxz<world.Z()+tpc.ActiveLength()/2.)
       maxz = world.Z()+tpc.ActiveLength()/2.;
-//    std::cout<<t<<" "<<world.X()-tpc.ActiveHalfWidth()
-//	     <<" "<<world.X()+tpc.ActiveHalfWidth()
-//	     <<" "<<world.Y()-tpc.ActiveHalfHeight()
-//	     <<" "<<world.Y()+tpc.ActiveHalfHeight()
-//	     <<" "<<world.Z()-tpc.ActiveLength()/2.
-//	     <<" "<<world.Z()+tpc.ActiveLength()/2.<<std::endl;
  
+    nwires += tpc_nwires[itpc];
+    nwires_tpc[t] += tpc_nwires[itpc];
+    if (!m_MakePlots) continue;
     TPCBox.push_back(new TBox(world.Z()-tpc.ActiveLength()/2.,
                               world.Y()-tpc.ActiveHalfHeight(),
                               world.Z()+tpc.ActiveLength()/2.,
@@ -118,31 +167,20 @@ void dune::CheckGeometry::analyze(art::Event const & evt)
     TPCBox.back()->SetLineStyle(2);
     TPCBox.back()->SetLineWidth(2);
     TPCBox.back()->SetLineColor(16);
-    
-    for (auto const& wid : geo->Iterate<geo::WireID>(tpc.ID())) {
-      auto const [p, w] = std::make_pair(wid.Plane, wid.Wire);
-	++nwires;
-	++nwires_tpc[t];
-//	if ((t==7&&p==0&&w==192)||
-//	    (t==7&&p==1&&w==112)||
-//	    (t==7&&p==2&&w==0)){
-//	if (true){
-        if ((t==2||t==6||t==10)&&p==0&&w%10==0){
-        double xyz0[3];
-        double xyz1[3];
-        geo->WireEndPoints(wid,xyz0,xyz1);
-	  Wires.push_back(new TLine(xyz0[2],xyz0[1],xyz1[2],xyz1[1]));
-	}
-      //std::cout<<wid<<" "<<xyz0[0]<<" "<<xyz0[1]<<" "<<xyz0[2]<<std::endl;
-    }
+    for (auto const& line : tpc_lines[itpc])
+      Wires.push_back(new TLine(line[0],line[1],line[2],line[3]));
   }
 
-  TH2F *frame = new TH2F("frame",";z (cm);y (cm)",100,minz,maxz,100,miny,maxy);
-  frame->SetStats(0);
-  frame->Draw();
-  for (auto box: TPCBox) box->Draw();
-  for (auto wire: Wires) wire->Draw();
-  can->Print("wires.pdf");
+  if (m_MakePlots) {
+    TCanvas *can = new TCanvas("c1","c1");
+    can->cd();
+    TH2F *frame = new TH2F("frame",";z (cm);y (cm)",100,minz,maxz,100,miny,maxy);
+    frame->SetStats(0);
+    frame->Draw();
+    for (auto box: TPCBox) box->Draw();
+    for (auto wire: Wires) wire->Draw();
+    can->Print("wires.pdf");
+  }
   std::cout<<"N wires = "<<nwires<<std::endl;
   for (size_t i = 0; i<geo->NTPC(); ++i){
     std::cout<<"TPC "<<i<<" has "<<nwires_tpc[i]<<" wires"<<std::endl;
@@ -319,6 +357,7 @@ void dune::CheckGeometry::analyze(art::Event const & evt)
     pixel_z[i] = (z[0]+z[1])/2;
   }
    
+  if (m_MakePlots) {
   TLatex tex;
   tex.SetTextSize(0.02);
 
@@ -451,20 +490,22 @@ void dune::CheckGeometry::analyze(art::Event const & evt)
     }
     cstp[i]->Print(Form("cstp_%d.png",i));
   }
+  cancrt->Print("crt.pdf");
+  cancrt->Print("crt.png");
+  }
   std::ofstream outfile("pixel.txt");
   for (int i = 0; i<32; ++i){
     outfile<<pixel_x[i]<<" "<<pixel_y[i]<<" "<<pixel_z[i]<<std::endl;
   }
   outfile.close();
 
-  cancrt->Print("crt.pdf");
-  cancrt->Print("crt.png");
-
   //convert channel number to t/p/w
   outfile.clear();
   outfile.open("channelmap.txt");
-  for (size_t i = 0; i<geo->Nchannels(); ++i){
-    auto wire = geo->ChannelToWire(i)[0];
+  std::vector<geo::WireID> chanWires(geo->Nchannels());
+  forEachIndex(chanWires.size(), [&](size_t i) { chanWires[i] = geo->ChannelToWire(i)[0]; });
+  for (size_t i = 0; i<chanWires.size(); ++i){
+    auto const& wire = chanWires[i];
     outfile<<i<<" "<<wire.TPC<<" "<<wire.Plane<<" "<<wire.Wire<<std::endl;
   }
 
@@ -472,7 +513,8 @@ void dune::CheckGeometry::analyze(art::Event const & evt)
 
 void dune::CheckGeometry::reconfigure(fhicl::ParameterSet const & p)
 {
-  // Implementation of optional member function here.
+  m_Parallel = p.get<bool>("Parallel", true);
+  m_MakePlots = p.get<bool>("MakePlots", true);
 }
 
 DEFINE_ART_MODULE(dune::CheckGeometry)
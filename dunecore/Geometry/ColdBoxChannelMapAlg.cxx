@@ -38,7 +38,6 @@
 
 #include "ColdBoxChannelMapAlg.h"
 
-using geo::dune::vd::ChannelToWireMap;
 /*
 namespace {
   
@@ -71,6 +70,7 @@ void geo::ColdBoxChannelMapAlg::Initialize(geo::GeometryData_t const& geodata)
   
   buildReadoutPlanes(geodata.cryostats);
   fillChannelToWireMap(geodata.cryostats);
+  fChannelClasses.fill(*this, geodata);
   
   MF_LOG_TRACE("ColdBoxChannelMapAlg")
     << "ColdBoxChannelMapAlg::Initialize() completed.";
@@ -81,8 +81,8 @@ void geo::ColdBoxChannelMapAlg::Initialize(geo::GeometryData_t const& geodata)
 void geo::ColdBoxChannelMapAlg::Uninitialize() {
   
   fReadoutMapInfo.clear();
-  fChannelToWireMap.clear();
-  fPlaneInfo.clear();
+  fChannelTable.clear();
+  fChannelClasses.clear();
   
 } // geo::ColdBoxChannelMapAlg::Uninitialize()
 
@@ -91,48 +91,22 @@ void geo::ColdBoxChannelMapAlg::Uninitialize() {
 std::vector<geo::WireID> geo::ColdBoxChannelMapAlg::ChannelToWire
   (raw::ChannelID_t channel) const
 {
-  //
-  // input check
-  //
-  assert(!fPlaneInfo.empty());
-  
   //
   // output
   //
   std::vector<geo::WireID> AllSegments;
   
   //
-  // find the ROP with that channel
+  // find the ROP with that channel and associate one wire for each of its
+  // wire planes covering the channel
   //
-  ChannelToWireMap::ChannelsInROPStruct const* channelInfo
-    = fChannelToWireMap.find(channel);
-  if (!channelInfo) {
+  if (fChannelTable.channelToWire(channel, AllSegments) == geo::PlaneChannelTable::npos) {
     throw cet::exception("Geometry")
       << "geo::ColdBoxChannelMapAlg::ChannelToWire(" << channel
       << "): invalid channel requested (must be lower than "
       << Nchannels() << ")\n";
   }
   
-  //
-  // find the wire planes in that ROP
-  //
-  PlaneColl_t const& planes = ROPplanes(channelInfo->ropid);
-  
-  //
-  // associate one wire for each of those wire planes to the channel
-  //
-  AllSegments.reserve(planes.size()); // this is sometimes (often?) too much
-  for (auto const pid: planes) {
-    
-    //geo::PlaneID const& pid = plane->ID();
-    ChannelRange_t const& channelRange = fPlaneInfo[pid].channelRange();
-    
-    if (!channelRange.contains(channel)) continue;
-    AllSegments.emplace_back
-      (pid, static_cast<geo::WireID::WireID_t>(channel - channelRange.begin()));
-    
-  } // for planes in ROP
-  
   return AllSegments;
   
 } // geo::ColdBoxChannelMapAlg::ChannelToWire()
@@ -141,7 +115,7 @@ std::vector<geo::WireID> geo::ColdBoxChannelMapAlg::ChannelToWire
 //------------------------------------------------------------------------------
 unsigned int geo::ColdBoxChannelMapAlg::Nchannels() const {
   
-  return fChannelToWireMap.nChannels();
+  return fChannelTable.endChannel();
 } // geo::ColdBoxChannelMapAlg::Nchannels()
 
 
@@ -149,9 +123,8 @@ unsigned int geo::ColdBoxChannelMapAlg::Nchannels() const {
 unsigned int geo::ColdBoxChannelMapAlg::Nchannels
   (readout::ROPID const& ropid) const 
 {
-  ChannelToWireMap::ChannelsInROPStruct const* ROPinfo
-    = fChannelToWireMap.find(ropid);
-  return ROPinfo? ROPinfo->nChannels: 0U;
+  unsigned int const irop = fChannelTable.findROP(ropid);
+  return (irop == geo::PlaneChannelTable::npos)? 0U: fChannelTable.ropNChannels(irop);
 } // geo::ColdBoxChannelMapAlg::Nchannels(ROPID)
 
 
@@ -197,7 +170,7 @@ geo::WireID geo::ColdBoxChannelMapAlg::NearestWireID
 raw::ChannelID_t geo::ColdBoxChannelMapAlg::PlaneWireToChannel
   (geo::WireID const& wireID) const
 {
-  return fPlaneInfo[wireID].firstChannel() + wireID.Wire;
+  return fChannelTable.planeWireToChannel(wireID);
 } // geo::ColdBoxChannelMapAlg::PlaneWireToChannel()
 
 
@@ -352,9 +325,8 @@ readout::ROPID geo::ColdBoxChannelMapAlg::ChannelToROP
 {
   if (!raw::isValidChannelID(channel)) return {};
   
-  ChannelToWireMap::ChannelsInROPStruct const* info
-    = fChannelToWireMap.find(channel);
-  return info? info->ropid: readout::ROPID{};
+  unsigned int const irop = fChannelTable.findROP(channel);
+  return (irop == geo::PlaneChannelTable::npos)? readout::ROPID{}: fChannelTable.ropID(irop);
 } // geo::ColdBoxChannelMapAlg::ChannelToROP()
 
 
@@ -364,9 +336,9 @@ raw::ChannelID_t geo::ColdBoxChannelMapAlg::FirstChannelInROP
 {
   if (!ropid) return raw::InvalidChannelID;
   
-  ChannelToWireMap::ChannelsInROPStruct const* info
-    = fChannelToWireMap.find(ropid);
-  return info? info->firstChannel: raw::InvalidChannelID;
+  unsigned int const irop = fChannelTable.findROP(ropid);
+  return (irop == geo::PlaneChannelTable::npos)
+    ? raw::InvalidChannelID: fChannelTable.ropFirstChannel(irop);
 } // geo::ColdBoxChannelMapAlg::FirstChannelInROP()
 
 
@@ -404,11 +376,14 @@ void geo::ColdBoxChannelMapAlg::fillChannelToWireMap
   //
   // output setup
   //
-  assert(fPlaneInfo.empty());
-  std::array<unsigned int, 3U> maxSizes
-    = geo::details::extractMaxGeometryElements<3U>(Cryostats);
- 
-  fPlaneInfo.resize(maxSizes[0U], maxSizes[1U], maxSizes[2U]);
+  assert(fChannelTable.nPlane() == 0);
+  std::vector<std::vector<geo::PlaneChannelTable::Index>> nPlanes;
+  for (geo::CryostatGeo const& cryo: Cryostats) {
+    nPlanes.emplace_back();
+    for (unsigned int t: util::counter(cryo.NTPC()))
+      nPlanes.back().push_back(cryo.TPC(t).Nplanes());
+  }
+  fChannelTable.reset(nPlanes);
   
   raw::ChannelID_t nextChannel = 0; // next available channel
   for (geo::CryostatGeo const& cryo: Cryostats) {
@@ -449,11 +424,9 @@ void geo::ColdBoxChannelMapAlg::fillChannelToWireMap
         
         // assign available channels to all wires of the first plane
         nextChannel += (*iPlane)->Nwires();
-        fPlaneInfo[(*iPlane)->ID()] = {
-          ChannelRange_t{ firstROPchannel, nextChannel }, rid };
+        fChannelTable.setPlane((*iPlane)->ID(), firstROPchannel, (*iPlane)->Nwires());
         log << " [" << (*iPlane)->ID() << "] "
-          << fPlaneInfo[(*iPlane)->ID()].firstChannel()
-          << " -- " << fPlaneInfo[(*iPlane)->ID()].lastChannel() << ";";
+          << firstROPchannel << " -- " << (nextChannel - 1) << ";";
         
         geo::Point_t lastWirePos = (*iPlane)->LastWire().GetCenter();
 	
@@ -489,10 +462,9 @@ void geo::ColdBoxChannelMapAlg::fillChannelToWireMap
 
           nextChannel = firstChannel + nWires;
           
-          fPlaneInfo[plane.ID()] = { { firstChannel, nextChannel }, rid };
+          fChannelTable.setPlane(plane.ID(), firstChannel, nWires);
           log << " [" << plane.ID() << "] "
-            << fPlaneInfo[plane.ID()].firstChannel() << " -- "
-            << fPlaneInfo[plane.ID()].lastChannel() << ";";
+            << firstChannel << " -- " << (nextChannel - 1) << ";";
           
           // update for the next iteration
           lastWirePos = plane.LastWire().GetCenter();
@@ -500,7 +472,7 @@ void geo::ColdBoxChannelMapAlg::fillChannelToWireMap
         } // while
         
 	unsigned int const nChannels = nextChannel - firstROPchannel;
-        fChannelToWireMap.addROP(rid, firstROPchannel, nChannels);
+        fChannelTable.addROP(rid, firstROPchannel, nChannels, plane_ids);
         log
           << " => " << nChannels << " channels starting at " << firstROPchannel;
         
@@ -510,9 +482,9 @@ void geo::ColdBoxChannelMapAlg::fillChannelToWireMap
     
   } // for cryostat
   
-  fChannelToWireMap.setEndChannel(nextChannel);
+  fChannelTable.setEndChannel(nextChannel);
   mf::LogInfo("ColdBoxChannelMapAlg")
-    << "Counted " << fChannelToWireMap.nChannels() << " channels.";
+    << "Counted " << fChannelTable.endChannel() << " channels.";
   
 } // geo::ColdBoxChannelMapAlg::fillChannelToWireMap()
 
@@ -698,11 +670,12 @@ std::size_t geo::ColdBoxChannelMapAlg::findPlaneType(readout::ROPID const& rid)
 geo::SigType_t geo::ColdBoxChannelMapAlg::SignalTypeForChannelImpl
   (raw::ChannelID_t const channel) const
 {
-  ChannelToWireMap::ChannelsInROPStruct const* channelInfo
-    = fChannelToWireMap.find(channel);
-  if (!channelInfo) return geo::kMysteryType;
+  if (fChannelClasses.hasChannel(channel)) return fChannelClasses.signalType(channel);
+  
+  unsigned int const irop = fChannelTable.findROP(channel);
+  if (irop == geo::PlaneChannelTable::npos) return geo::kMysteryType;
   
-  switch (findPlaneType(channelInfo->ropid)) {
+  switch (findPlaneType(fChannelTable.ropID(irop))) {
     case kFirstInductionType:
     case kSecondInductionType:
       return geo::kInduction;
@@ -27,6 +27,8 @@
 
 // dune specific
 #include "dunecore/Geometry/GeoObjectSorterCRU.h"
+#include "dunecore/Geometry/ChannelClassTable.h"
+#include "dunecore/Geometry/PlaneChannelTable.h"
 
 // C/C++ standard libraries
 #include <vector>
@@ -42,80 +44,6 @@ namespace geo {
   
 } // namespace dune
 
-// -----------------------------------------------------------------------------
-namespace geo { namespace dune{ namespace vd {
-
-  class ChannelToWireMap
-  {
-    
-  public:
-
-    struct ChannelsInROPStruct
-    {
-      raw::ChannelID_t firstChannel = raw::InvalidChannelID;
-      unsigned int nChannels        = 0U;
-      readout::ROPID ropid; ///< ID of the ROP we cover.
-      ChannelsInROPStruct() = default;
-      ChannelsInROPStruct(
-			  raw::ChannelID_t firstChannel,
-			  unsigned int nChannels,
-			  readout::ROPID const& ropid )
-	: firstChannel(firstChannel), nChannels(nChannels), ropid(ropid)
-      {}
-    };
-    
-
-    /// Returns data of the ROP including `channel`, `nullptr` if none.
-    ChannelsInROPStruct const* find(raw::ChannelID_t channel) const
-    {
-      auto const dend = fROPfirstChannel.end();
-      auto const iNextData = fROPfirstChannel.upper_bound( channel );
-      assert(iNextData != fROPfirstChannel.begin());
-      return ((iNextData == dend) && (channel >= endChannel()))
-	? nullptr: &(std::prev(iNextData)->second);
-    }
-
-    
-    /// Returns data of the ROP `ropid`, `nullptr` if none.
-    ChannelsInROPStruct const* find(readout::ROPID const& ropid) const
-    {
-      auto const dbegin = fROPfirstChannel.begin(), dend = fROPfirstChannel.end();
-      for( auto it = dbegin; it != dend; ++it ){
-	if (it->second.ropid == ropid) return &(it->second);
-      }
-      return nullptr;
-    }
-    
-    /// Returns the ID of the first invalid channel (the last channel, plus 1).
-    raw::ChannelID_t endChannel() const { return fEndChannel; }
-    
-    /// Returns the number of mapped channels.
-    unsigned int nChannels() const
-    { return endChannel(); }
-    
-    /// Sets the ID of the channels after the last valid one.
-    void setEndChannel(raw::ChannelID_t channel) { fEndChannel = channel; }
-    
-    /// Resets the data of the map to like just constructed.
-    void clear(){
-      fROPfirstChannel.clear();
-      fEndChannel = raw::ChannelID_t{ 0 };
-    }
-
-    void addROP( readout::ROPID const& rid,
-		 raw::ChannelID_t firstROPchannel, unsigned int nChannels )
-    {
-      assert( fROPfirstChannel.find( firstROPchannel ) == fROPfirstChannel.end() );
-      fROPfirstChannel[ firstROPchannel ] = {firstROPchannel, nChannels, rid};
-    }
-
-  private:
-				       
-    std::map<raw::ChannelID_t, ChannelsInROPStruct> fROPfirstChannel;
-    raw::ChannelID_t fEndChannel = 0;
-  };
-    }}} //namespaces
-
 // -----------------------------------------------------------------------------
 
 class geo::ColdBoxChannelMapAlg: public geo::ChannelMapAlg {
@@ -153,6 +81,9 @@ class geo::ColdBoxChannelMapAlg: public geo::ChannelMapAlg {
   /// Returns the number of readout channels (ID's go `0` to `Nchannels()`).
   virtual unsigned int Nchannels() const override;
   
+  /// Per-channel signal type, view and plane, filled in Initialize()
+  ChannelClassTable const& ChannelClasses() const { return fChannelClasses; }
+  
   /// @brief Returns the number of channels in the specified ROP
   /// @return number of channels in the specified ROP, 0 if non-existent
   virtual unsigned int Nchannels(readout::ROPID const& ropid) const override;
@@ -363,24 +294,6 @@ class geo::ColdBoxChannelMapAlg: public geo::ChannelMapAlg {
    */
   /// @{
   
-  struct ChannelRange_t
-    : std::pair<raw::ChannelID_t, raw::ChannelID_t>
-    {
-      
-      using std::pair<raw::ChannelID_t, raw::ChannelID_t>::pair;
-
-      /// Returns the ID of the first channel in the range.
-      constexpr raw::ChannelID_t begin() const { return first; }
-
-      /// Returns the ID of the channel after the last one in the range.
-      constexpr raw::ChannelID_t end() const { return second; }
-      
-      /// Returns whether this range includes the specified `channel`.
-      constexpr bool contains(raw::ChannelID_t channel) const
-      { return (channel >= begin()) && (channel < end()); }
-    };
-
-  
   /// Collected information about TPC sets and readout planes in the geometry.
   struct ReadoutMappingInfo_t {
     /// Number of TPC sets in each cryostat.
@@ -451,42 +364,14 @@ class geo::ColdBoxChannelMapAlg: public geo::ChannelMapAlg {
     
   }; // ReadoutMappingInfo_t
   
-  /// Collection of information on one plane.
-  struct PlaneInfo_t {
-    
-    ChannelRange_t fChannelRange; ///< Range of channels covered by the plane.
-    readout::ROPID fROPID;        ///< Which readout plane this wire plane belongs to.
-    
-    /// Returns the range of channels covered by the wire plane.
-    constexpr ChannelRange_t const& channelRange() const
-      { return fChannelRange; }
-    
-    /// Returns the ID of the last channel in the range.
-    constexpr raw::ChannelID_t firstChannel() const
-      { return fChannelRange.begin(); }
-    
-    /// Returns the ID of the last channel in the range.
-    constexpr raw::ChannelID_t lastChannel() const
-      { return fChannelRange.end() - 1; }
-    
-    /// Returns the ID of the channel after the last in the range.
-    constexpr raw::ChannelID_t endChannel() const
-      { return fChannelRange.end(); }
-    
-    /// Returns the ID of the readout plane this wire plane belongs to.
-    constexpr readout::ROPID ROP() const { return fROPID; }
-    
-  }; // struct PlaneInfo_t
-  
-  
   /// Information about TPC sets and readout planes in the geometry.
   ReadoutMappingInfo_t fReadoutMapInfo;
   
-  /// Mapping of channels and ROP's.
-  geo::dune::vd::ChannelToWireMap fChannelToWireMap;
+  /// Channel ranges of the wire planes and readout planes.
+  geo::PlaneChannelTable fChannelTable;
   
-  /// Range of channels covered by each of the wire planes.
-  geo::PlaneDataContainer<PlaneInfo_t> fPlaneInfo;
+  /// Per-channel signal type, view and plane.
+  ChannelClassTable fChannelClasses;
   
    geo::GeoObjectSorterCRU  fSorter;              ///< class to sort geo objects
   
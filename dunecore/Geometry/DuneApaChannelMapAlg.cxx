@@ -30,17 +30,23 @@ using geo::PlaneGeo;
 using readout::TPCsetID;
 using readout::ROPID;
 using geo::SigType_t;
+using geo::WirePlaneProjection;
+using geo::AnalyticWirePlane;
+using geo::GeometrySnapshot;
+using geo::ChannelClassTable;
+using std::uint64_t;
 
 typedef unsigned int Index;
 Index badIndex = 999999;
 
 #include <iostream>
+#include <type_traits>
 using std::cout;
 using std::endl;
 //----------------------------------------------------------------------------
 
 DuneApaChannelMapAlg::
-DuneApaChannelMapAlg(const fhicl::ParameterSet& p)
+DuneApaChannelMapAlg(const fhicl::ParameterSet& p, bool useChannelToWireTableDefault)
 : fSorter(nullptr) {
   fChannelsPerOpDet = p.get<unsigned int>("ChannelsPerOpDet");
   fOpDetFlag = 0;
@@ -48,6 +54,9 @@ DuneApaChannelMapAlg(const fhicl::ParameterSet& p)
   string sdet;
   p.get_if_present<string>("DetectorVersion", sdet);
   if ( sdet.substr(0,7) == "dune35t" ) fOpDetFlag = 1;
+  fUseChannelToWireTable = p.get<bool>("UseChannelToWireTable", useChannelToWireTableDefault);
+  fLazyWireGeometry = p.get<bool>("LazyWireGeometry", false);
+  fSnapshotFile = p.get<string>("SnapshotFile", "");
 }
 
 //----------------------------------------------------------------------------
@@ -243,11 +252,14 @@ const PlaneGeo plageo2 = plageo;
 
   // Assign first channels for the TPCs.
   fPlaneData.resize(ncry);
+  fWireModels.resize(ncry);
   for ( Index icry=0; icry<ncry; ++icry ) {
     Index ntpc = fNTpc[icry];
     fPlaneData[icry].resize(ntpc);
+    fWireModels[icry].resize(ntpc);
     for ( Index itpc=0; itpc<ntpc; ++itpc ) {
       fPlaneData[icry][itpc].resize(crygeos[icry].TPC(itpc).Nplanes());
+      fWireModels[icry][itpc].resize(crygeos[icry].TPC(itpc).Nplanes());
       for ( Index ipla=0; ipla<crygeos[icry].TPC(itpc).Nplanes(); ++ipla ) {
         PlaneData_t& PlaneData = fPlaneData[icry][itpc][ipla];
         const PlaneGeo& thePlane = crygeos[icry].TPC(itpc).Plane(ipla);
@@ -269,7 +281,9 @@ const PlaneGeo plageo2 = plageo;
           PlaneData.fZmax = endpoint.Z();
           PlaneData.fZmin = endpoint.Z();
 	  unsigned int nwires = thePlane.Nwires(); 
-	  for (unsigned int iwire=0;iwire<nwires;iwire++){
+	  // in the lazy wire geometry mode only the first and last wires are used
+	  unsigned int iwireStep = (fLazyWireGeometry && nwires > 1)? nwires - 1: 1;
+	  for (unsigned int iwire=0;iwire<nwires;iwire+=iwireStep){
             endpoint = thePlane.Wire(iwire).GetStart();
             PlaneData.fYmax = std::max(PlaneData.fYmax,endpoint.Y());
             PlaneData.fYmin = std::min(PlaneData.fYmin,endpoint.Y());
@@ -282,6 +296,13 @@ const PlaneGeo plageo2 = plageo;
             PlaneData.fZmin = std::min(PlaneData.fZmin,endpoint.Z());
 	  } // loop on wire 
 
+        // analytic wire model of the plane, for WireEndPoints()
+        auto const wdir = thePlane.Wire(0).Direction();
+        auto const xyz1 = (nwires > 1)? thePlane.Wire(1).GetCenter(): xyz;
+        fWireModels[icry][itpc][ipla] = AnalyticWirePlane(
+          xyz.X(), xyz.Y(), xyz.Z(), wdir.Y(), wdir.Z(), xyz1.Y(), xyz1.Z(), nwires,
+          PlaneData.fYmin, PlaneData.fYmax, PlaneData.fZmin, PlaneData.fZmax);
+
       } // for plane
     } // for TPC
   } // for cryostat
@@ -313,6 +334,49 @@ const PlaneGeo plageo2 = plageo;
     mf::LogVerbatim("DuneApaChannelMapAlg") << "    Pitch in Z Plane = " << fWirePitch[2] ;
   }
 
+  // Coefficients of WireCoordinate for the batch calls.
+  fWireProjections.resize(ncry);
+  for ( Index icry=0; icry<ncry; ++icry ) {
+    Index ntpc = fNTpc[icry];
+    fWireProjections[icry].resize(ntpc);
+    for ( Index itpc=0; itpc<ntpc; ++itpc ) {
+      Index nplaTpc = crygeos[icry].TPC(itpc).Nplanes();
+      fWireProjections[icry][itpc].resize(nplaTpc);
+      for ( Index ipla=0; ipla<nplaTpc; ++ipla ) {
+        const PlaneData_t& PlaneData = fPlaneData[icry][itpc][ipla];
+        double backsign = (fPlaneRopIndex[icry][itpc][ipla] == 1) ? -1.0 : 1.0;
+        double scale = PlaneData.fWireSortingInZ/fWirePitch[ipla];
+        fWireProjections[icry][itpc][ipla] = WirePlaneProjection(
+          PlaneData.fFirstWireCenterY, PlaneData.fFirstWireCenterZ,
+          -scale*backsign*fCosOrientation[ipla], scale*fSinOrientation[ipla],
+          PlaneData.fYmin, PlaneData.fYmax, PlaneData.fZmin, PlaneData.fZmax,
+          fWiresPerPlane[icry][itpc][ipla]);
+      }
+    }
+  }
+
+  buildPlaneChannelTable();
+
+  // Per-channel tables, from the snapshot file if it matches this geometry.
+  uint64_t snapkey = fSnapshotFile.size() ? snapshotKey() : 0;
+  if ( fSnapshotFile.size() && readSnapshot(snapkey) ) {
+    mf::LogInfo("DuneApaChannelMapAlg") << "Channel tables taken from snapshot " << fSnapshotFile;
+  } else {
+    if ( fUseChannelToWireTable ) buildChannelToWireTable();
+    fChannelClasses.fill(*this, geodata);
+    if ( fSnapshotFile.size() ) {
+      int wstat = writeSnapshot(snapkey);
+      if ( wstat ) {
+        mf::LogWarning("DuneApaChannelMapAlg") << "Unable to write snapshot " << fSnapshotFile
+                                               << " (error " << wstat << ")";
+      } else if ( readSnapshot(snapkey) ) {
+        // Use the mapped copy so this process shares the pages as well.
+        vector<size_t>().swap(fChannelWireOffsets);
+        vector<WireID>().swap(fChannelWires);
+      }
+    }
+  }
+
 }
 
 //----------------------------------------------------------------------------
@@ -320,6 +384,166 @@ const PlaneGeo plageo2 = plageo;
 void DuneApaChannelMapAlg::Uninitialize() {
   PlaneInfoMap_t<ChannelID_t>().swap(fFirstChannelInThisPlane);
   PlaneInfoMap_t<ChannelID_t>().swap(fFirstChannelInNextPlane);
+  vector<size_t>().swap(fChannelWireOffsets);
+  vector<WireID>().swap(fChannelWires);
+  fChannelWireOffsetData = nullptr;
+  fChannelWireData = nullptr;
+  vector<PlaneChannel_t>().swap(fPlaneChannels);
+  fNPlaneMax = 0;
+  fSnapshot.clear();
+  PlaneInfoMap_t<AnalyticWirePlane>().swap(fWireModels);
+  fChannelClasses.clear();
+}
+
+//----------------------------------------------------------------------------
+
+void DuneApaChannelMapAlg::buildChannelToWireTable() {
+  // ChannelToWire computes the wires while there is no table.
+  vector<size_t> offsets;
+  offsets.reserve(fNchannels + 1);
+  fChannelWires.clear();
+  for ( ChannelID_t icha=0; icha<fNchannels; ++icha ) {
+    offsets.push_back(fChannelWires.size());
+    const vector<WireID> wirids = ChannelToWire(icha);
+    fChannelWires.insert(fChannelWires.end(), wirids.begin(), wirids.end());
+  }
+  offsets.push_back(fChannelWires.size());
+  fChannelWires.shrink_to_fit();
+  fChannelWireOffsets = std::move(offsets);
+  fChannelWireOffsetData = fChannelWireOffsets.data();
+  fChannelWireData = fChannelWires.data();
+  mf::LogInfo("DuneApaChannelMapAlg") << "Channel-to-wire table has " << fChannelWires.size()
+                                      << " wires for " << fNchannels << " channels";
+}
+
+//----------------------------------------------------------------------------
+
+void DuneApaChannelMapAlg::buildPlaneChannelTable() {
+  vector<PlaneChannel_t>().swap(fPlaneChannels);
+  fNPlaneMax = 0;
+  for ( Index icry=0; icry<fNcryostat; ++icry ) {
+    for ( Index itpc=0; itpc<fNTpc[icry]; ++itpc ) {
+      fNPlaneMax = std::max(fNPlaneMax, fPlanesPerTpc[icry][itpc]);
+    }
+  }
+  fPlaneChannels.resize(fNcryostat*fNTpcMax*fNPlaneMax);
+  for ( Index icry=0; icry<fNcryostat; ++icry ) {
+    for ( Index itpc=0; itpc<fNTpc[icry]; ++itpc ) {
+      for ( Index ipla=0; ipla<fPlanesPerTpc[icry][itpc]; ++ipla ) {
+        Index iapa = fPlaneApa[icry][itpc][ipla];
+        Index irop = fPlaneRop[icry][itpc][ipla];
+        Index irpl = fPlaneRopIndex[icry][itpc][ipla];
+        Index nrpl = fPlanesPerRop[icry][iapa][irop];
+        Index ncha = fAnchoredWires[icry][itpc][ipla];
+        Index woff = 0;
+        if ( nrpl > 1 ) {      // Wrapped ROP
+          Index ipla1 = fRopPlane[icry][iapa][irop][0];
+          Index ipla2 = fRopPlane[icry][iapa][irop][1];
+          // Wire is in the back TPC.
+          if ( irpl == 1 ) {
+            woff = fAnchoredWires[icry][itpc][ipla1];
+            ncha += fAnchoredWires[icry][itpc][ipla1];
+          // Wire is in the front TPC.
+          } else {
+            ncha += fAnchoredWires[icry][itpc][ipla2];
+          }
+        }
+        PlaneChannel_t& ent = fPlaneChannels[(icry*fNTpcMax + itpc)*fNPlaneMax + ipla];
+        ent.fFirstChannel = fFirstChannelInThisRop[icry][iapa][irop];
+        ent.fWireOffset = woff;
+        ent.fNChannels = ncha;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+DuneApaChannelMapAlg::WireIDSpan DuneApaChannelMapAlg::ChannelToWireSpan(ChannelID_t icha) const {
+  if ( icha >= fNchannels )
+    throw cet::exception("DuneApaChannelMapAlg") << __func__ << ": Invalid channel " << icha;
+  if ( fChannelWireOffsetData == nullptr )
+    throw cet::exception("DuneApaChannelMapAlg") << __func__ << ": No channel-to-wire table (set UseChannelToWireTable).";
+  return WireIDSpan(fChannelWireData + fChannelWireOffsetData[icha],
+                    fChannelWireData + fChannelWireOffsetData[icha+1]);
+}
+
+//----------------------------------------------------------------------------
+
+uint64_t DuneApaChannelMapAlg::snapshotKey() const {
+  const string tag = "DuneApaChannelMapAlg";
+  uint64_t key = GeometrySnapshot::hash(tag.data(), tag.size());
+  auto addval = [&key](auto val) { key = GeometrySnapshot::hash(&val, sizeof(val), key); };
+  addval(fNchannels);
+  addval(fNcryostat);
+  addval(fUseChannelToWireTable);
+  for ( Index icry=0; icry<fNcryostat; ++icry ) {
+    for ( Index itpc=0; itpc<fNTpc[icry]; ++itpc ) {
+      for ( Index ipla=0; ipla<fPlanesPerTpc[icry][itpc]; ++ipla ) {
+        const PlaneData_t& PlaneData = fPlaneData[icry][itpc][ipla];
+        addval(fWiresPerPlane[icry][itpc][ipla]);
+        addval(fAnchoredWires[icry][itpc][ipla]);
+        addval(fPlaneApa[icry][itpc][ipla]);
+        addval(fPlaneRop[icry][itpc][ipla]);
+        addval(fPlaneRopIndex[icry][itpc][ipla]);
+        addval(PlaneData.fFirstWireCenterY);
+        addval(PlaneData.fFirstWireCenterZ);
+        addval(PlaneData.fWireSortingInZ);
+        addval(PlaneData.fYmin);
+        addval(PlaneData.fYmax);
+        addval(PlaneData.fZmin);
+        addval(PlaneData.fZmax);
+      }
+    }
+  }
+  for ( double val : fWirePitch ) addval(val);
+  for ( double val : fOrientation ) addval(val);
+  return key;
+}
+
+//----------------------------------------------------------------------------
+
+bool DuneApaChannelMapAlg::readSnapshot(uint64_t key) {
+  using Byte = ChannelClassTable::Byte;
+  GeometrySnapshot snap(fSnapshotFile);
+  if ( ! snap.isValid() || snap.key() != key ) return false;
+  util::span<Byte const*> sigtypes = snap.get<Byte>("SignalTypes");
+  util::span<Byte const*> views = snap.get<Byte>("Views");
+  util::span<Byte const*> planes = snap.get<Byte>("Planes");
+  if ( sigtypes.size() != fNchannels || views.size() != fNchannels || planes.size() != fNchannels ) return false;
+  const size_t* offsets = nullptr;
+  const WireID* wirids = nullptr;
+  if ( fUseChannelToWireTable ) {
+    util::span<size_t const*> offspan = snap.get<size_t>("ChannelWireOffsets");
+    WireIDSpan wirspan = snap.get<WireID>("ChannelWires");
+    if ( offspan.size() != fNchannels + 1 ) return false;
+    if ( offspan.begin()[0] != 0 || offspan.begin()[fNchannels] != wirspan.size() ) return false;
+    offsets = offspan.begin();
+    wirids = wirspan.begin();
+  }
+  fChannelClasses.assign(sigtypes, views, planes);
+  fChannelWireOffsetData = offsets;
+  fChannelWireData = wirids;
+  fSnapshot = std::move(snap);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+
+int DuneApaChannelMapAlg::writeSnapshot(uint64_t key) const {
+  using Byte = ChannelClassTable::Byte;
+  vector<GeometrySnapshot::Section> secs;
+  ChannelClassTable::ByteSpan sigtypes = fChannelClasses.signalTypes();
+  ChannelClassTable::ByteSpan views = fChannelClasses.views();
+  ChannelClassTable::ByteSpan planes = fChannelClasses.planes();
+  secs.push_back(GeometrySnapshot::section<Byte>("SignalTypes", sigtypes.begin(), sigtypes.size()));
+  secs.push_back(GeometrySnapshot::section<Byte>("Views", views.begin(), views.size()));
+  secs.push_back(GeometrySnapshot::section<Byte>("Planes", planes.begin(), planes.size()));
+  if ( fUseChannelToWireTable ) {
+    secs.push_back(GeometrySnapshot::section("ChannelWireOffsets", fChannelWireOffsets.data(), fChannelWireOffsets.size()));
+    secs.push_back(GeometrySnapshot::section("ChannelWires", fChannelWires.data(), fChannelWires.size()));
+  }
+  return GeometrySnapshot::write(fSnapshotFile, key, secs);
 }
 
 //----------------------------------------------------------------------------
@@ -327,6 +551,10 @@ void DuneApaChannelMapAlg::Uninitialize() {
 vector<WireID> DuneApaChannelMapAlg::ChannelToWire(ChannelID_t icha) const {
   vector< WireID > wirids;
   if ( icha >= fNchannels ) return wirids;
+  if ( fChannelWireOffsetData != nullptr ) {
+    WireIDSpan tabids = ChannelToWireSpan(icha);
+    return vector<WireID>(tabids.begin(), tabids.end());
+  }
   // Loop over ROPs to find the one holding this channel.
   Index ncry = fNcryostat;
   Index icry = badIndex;
@@ -461,11 +689,44 @@ NearestWireID(const geo::Point_t& xyz, PlaneID const& plaid) const {
 
 //----------------------------------------------------------------------------
 
+void DuneApaChannelMapAlg::
+WireCoordinates(double const* YPos, double const* ZPos, std::size_t n,
+                PlaneID const& plaid, double* wireCoords) const {
+  AccessElement(fWireProjections, plaid).wireCoordinates(YPos, ZPos, n, wireCoords);
+}
+
+//----------------------------------------------------------------------------
+
+void DuneApaChannelMapAlg::
+NearestWires(double const* YPos, double const* ZPos, std::size_t n,
+             PlaneID const& plaid, WireID::WireID_t* wires) const {
+  static_assert(std::is_same_v<WireID::WireID_t, WirePlaneProjection::WireNumber>,
+                "Wire number types differ");
+  AccessElement(fWireProjections, plaid).nearestWires(YPos, ZPos, n, wires);
+}
+
+//----------------------------------------------------------------------------
+
+std::pair<geo::Point_t, geo::Point_t>
+DuneApaChannelMapAlg::WireEndPoints(WireID const& wirid) const {
+  const AnalyticWirePlane& model = AccessElement(fWireModels, wirid);
+  if ( wirid.Wire >= model.nwires() )
+    throw cet::exception("DuneApaChannelMapAlg") << __func__ << ": Invalid wire " << std::string(wirid);
+  const AnalyticWirePlane::Segment& seg = model.endpoints(wirid.Wire);
+  return { geo::Point_t(seg.x, seg.y1, seg.z1), geo::Point_t(seg.x, seg.y2, seg.z2) };
+}
+
+//----------------------------------------------------------------------------
+
 ChannelID_t DuneApaChannelMapAlg::PlaneWireToChannel(WireID const& wirid) const {
   Index icry = wirid.Cryostat;
   Index itpc = wirid.TPC;
   Index ipla = wirid.Plane;
   Index ichaRop = wirid.Wire;
+  if ( fPlaneChannels.size() && icry < fNcryostat && itpc < fNTpcMax && ipla < fNPlaneMax ) {
+    const PlaneChannel_t& ent = fPlaneChannels[(icry*fNTpcMax + itpc)*fNPlaneMax + ipla];
+    if ( ent.fNChannels ) return ent.fFirstChannel + (ichaRop + ent.fWireOffset)%ent.fNChannels;
+  }
   Index iapa = fPlaneApa[icry][itpc][ipla];
   Index irop = fPlaneRop[icry][itpc][ipla];
   Index irpl = fPlaneRopIndex[icry][itpc][ipla];
@@ -492,6 +753,7 @@ ChannelID_t DuneApaChannelMapAlg::PlaneWireToChannel(WireID const& wirid) const
 //----------------------------------------------------------------------------
 
 SigType_t DuneApaChannelMapAlg::SignalTypeForChannelImpl(ChannelID_t const icha) const {
+  if ( fChannelClasses.hasChannel(icha) ) return fChannelClasses.signalType(icha);
   Index ncry = fNcryostat;
   for ( Index icry=0; icry<ncry; ++icry ) {
     Index napa=fNApa[icry];
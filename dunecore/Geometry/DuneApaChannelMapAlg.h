@@ -27,6 +27,17 @@
 /// Optical detector flag determines how optical channel mapping is done:
 //    OpDetFlag = 0 - Simple mapping with ChannelsPerOpDet fore each optical detector
 //    OpDetFlag = 1 - Dune 35t mapping
+///
+/// If SnapshotFile is set, the per-channel tables built in Initialize() (channel
+/// classes and, with UseChannelToWireTable, the channel-to-wire table) are taken from
+/// that file when it matches the geometry, and are otherwise built and written to it.
+/// The channel-to-wire table is then used in place from the memory-mapped file, so it
+/// is shared between the processes on a node. See GeometrySnapshot.
+///
+/// PlaneWireToChannel() uses a flat per-plane table, built in Initialize(), of the
+/// first channel, wire offset and channel count of the ROP holding each plane.
+/// Derived classes may enable the channel-to-wire table by default by passing
+/// true for the second ctor argument; UseChannelToWireTable still overrides it.
 ////////////////////////////////////////////////////////////////////////
 #ifndef geo_DuneApaChannelMapAlg_H
 #define geo_DuneApaChannelMapAlg_H
@@ -38,6 +49,15 @@
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
 #include "larcorealg/Geometry/ChannelMapAlg.h"
 #include "larcorealg/Geometry/GeoObjectSorter.h"
+#include "larcorealg/CoreUtils/span.h"
+#include "dunecore/Geometry/WirePlaneProjection.h"
+#include "dunecore/Geometry/AnalyticWirePlane.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h"
+#include <utility>
+#include "dunecore/Geometry/ChannelClassTable.h"
+#include "dunecore/Geometry/GeometrySnapshot.h"
+#include <cstdint>
+#include <string>
 #include "fhiclcpp/ParameterSet.h"
 
 namespace geo{
@@ -46,7 +66,7 @@ class DuneApaChannelMapAlg : public ChannelMapAlg {
 
 public:
 
-  DuneApaChannelMapAlg(const fhicl::ParameterSet& pset);
+  DuneApaChannelMapAlg(const fhicl::ParameterSet& pset, bool useChannelToWireTableDefault =false);
     
   void setSorter(const geo::GeoObjectSorter& sort);
   void Initialize(GeometryData_t const& geodata) override;
@@ -55,6 +75,22 @@ public:
   /// Returns a list of TPC wires connected to the specified readout channel ID
   /// @throws cet::exception (category: "Geometry") if non-existent channel
   std::vector<WireID> ChannelToWire(raw::ChannelID_t channel) const override;
+
+  /// Non-owning view of the wires connected to one channel
+  using WireIDSpan = util::span<WireID const*>;
+
+  /// Same as ChannelToWire() but without allocating: returns a view of the
+  /// channel's entries in the precomputed table, which is built in Initialize()
+  /// if the parameter UseChannelToWireTable is true. The view is valid until
+  /// the next Initialize() or Uninitialize().
+  /// @throws cet::exception (category: "DuneApaChannelMapAlg") if non-existent channel or no table
+  WireIDSpan ChannelToWireSpan(raw::ChannelID_t channel) const;
+
+  /// Returns whether the channel-to-wire table is built
+  bool HasChannelToWireTable() const { return fChannelWireOffsetData != nullptr; }
+
+  /// Returns whether the per-channel tables were taken from the snapshot file
+  bool UsesSnapshot() const { return fSnapshot.isValid(); }
     
   unsigned int Nchannels() const override;
     
@@ -71,10 +107,29 @@ public:
   virtual WireID
   NearestWireID(const geo::Point_t& worldPos, geo::PlaneID const& planeID) const override;
   //@}
+
+  /// Batch version of WireCoordinate() for the n points (YPos[i], ZPos[i]) in one
+  /// plane, computed in single precision (see WirePlaneProjection).
+  void WireCoordinates(double const* YPos, double const* ZPos, std::size_t n,
+                       geo::PlaneID const& planeID, double* wireCoords) const;
+
+  /// Batch version of NearestWireID() for the n points (YPos[i], ZPos[i]) in one
+  /// plane, filling the wire numbers (see WirePlaneProjection).
+  void NearestWires(double const* YPos, double const* ZPos, std::size_t n,
+                    geo::PlaneID const& planeID, geo::WireID::WireID_t* wires) const;
+
+  /// Returns the end points of a wire from the analytic wire model of its plane
+  /// (see AnalyticWirePlane). The end points of all the wires of a plane are
+  /// computed and cached on the first call for that plane.
+  /// @throws cet::exception (category: "DuneApaChannelMapAlg") if non-existent wire
+  std::pair<geo::Point_t, geo::Point_t> WireEndPoints(geo::WireID const& wireID) const;
+
   //@{
   virtual raw::ChannelID_t PlaneWireToChannel(geo::WireID const& wireID) const override;
   //@}
   SigType_t                SignalTypeForChannelImpl( raw::ChannelID_t const channel) const override;
+  /// Per-channel signal type, view and plane, filled in Initialize()
+  ChannelClassTable const& ChannelClasses() const { return fChannelClasses; }
   std::set<PlaneID> const& PlaneIDs()                                  const override;
 
   //
@@ -257,6 +312,14 @@ protected:
   PlaneInfoMap_t<raw::ChannelID_t>     fFirstChannelInThisRop; ///<  (cry, apa, rop)
   PlaneInfoMap_t<raw::ChannelID_t>     fFirstChannelInNextRop; ///<  (cry, apa, rop)
   const geo::GeoObjectSorter*          fSorter;                ///< sorts geo::XXXGeo objects
+  ChannelClassTable                    fChannelClasses; ///< per-channel signal type, view and plane
+  bool                                 fUseChannelToWireTable; ///< build the channel-to-wire table
+  std::vector<size_t>                  fChannelWireOffsets;    ///< wires of channel c are table entries [fChannelWireOffsets[c], fChannelWireOffsets[c+1])
+  std::vector<WireID>                  fChannelWires;          ///< channel-to-wire table: wires of all channels in channel order
+  const size_t*                        fChannelWireOffsetData = nullptr; ///< table offsets, in fChannelWireOffsets or fSnapshot
+  const WireID*                        fChannelWireData = nullptr;       ///< table wires, in fChannelWires or fSnapshot
+  std::string                          fSnapshotFile;          ///< snapshot of the per-channel tables, if not empty
+  GeometrySnapshot                     fSnapshot;              ///< mapped snapshot, if the tables come from it
 
   /// all data we need for each APA
   typedef struct {
@@ -278,6 +341,44 @@ protected:
   std::vector< double > fSinOrientation; // to explore improving speed
     std::vector< double > fCosOrientation; // to explore improving speed
 
+  /// single-precision wire coordinate tables for the batch calls (indices: c t p)
+  PlaneInfoMap_t<WirePlaneProjection>                  fWireProjections;
+
+  /// analytic wire models for WireEndPoints() (indices: c t p)
+  PlaneInfoMap_t<AnalyticWirePlane>                    fWireModels;
+
+  /// if true, Initialize() takes the wire frame of each plane from its first and
+  /// last wires instead of scanning the end points of every wire
+  bool                                                 fLazyWireGeometry;
+
+    /// Fills the channel-to-wire table from ChannelToWire().
+    void buildChannelToWireTable();
+
+    /// entry of the plane-to-channel table: channel for wire w is
+    /// fFirstChannel + (w + fWireOffset) % fNChannels
+    struct PlaneChannel_t {
+      raw::ChannelID_t fFirstChannel = 0;
+      unsigned int     fWireOffset = 0;
+      unsigned int     fNChannels = 0;
+    };
+
+    /// plane-to-channel table, indexed by (cry*fNTpcMax + tpc)*fNPlaneMax + pla
+    std::vector<PlaneChannel_t>  fPlaneChannels;
+    unsigned int                 fNPlaneMax = 0;
+
+    /// Fills the plane-to-channel table.
+    void buildPlaneChannelTable();
+
+    /// Returns the key identifying the geometry and configuration in the snapshot.
+    std::uint64_t snapshotKey() const;
+
+    /// Takes the per-channel tables from the snapshot file. Returns false, leaving
+    /// the tables untouched, if the file is missing or does not match.
+    bool readSnapshot(std::uint64_t key);
+
+    /// Writes the per-channel tables to the snapshot file. Returns 0 for success.
+    int writeSnapshot(std::uint64_t key) const;
+
     /// Returns whether the specified ID represents a valid cryostat.
     bool HasCryostat(CryostatID const& cid) const
       { return cid.Cryostat < fNcryostat; }
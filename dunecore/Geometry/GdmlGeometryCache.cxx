@@ -0,0 +1,148 @@
+// GdmlGeometryCache.cxx
+
+#include "GdmlGeometryCache.h"
+#include "GeometrySnapshot.h"
+#include "TGeoManager.h"
+#include "RVersion.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using geo::GdmlGeometryCache;
+using std::string;
+using std::cout;
+using std::endl;
+using Name = GdmlGeometryCache::Name;
+using Key = GdmlGeometryCache::Key;
+
+namespace {
+
+bool fileExists(const Name& fname) {
+  struct stat sbuf;
+  return ::stat(fname.c_str(), &sbuf) == 0 && S_ISREG(sbuf.st_mode);
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+// Class methods.
+//**********************************************************************
+
+Key GdmlGeometryCache::key(const Name& gdmlfile) {
+  FILE* pfil = std::fopen(gdmlfile.c_str(), "rb");
+  if ( pfil == nullptr ) return 0;
+  int rootVersion = ROOT_VERSION_CODE;
+  Key val = GeometrySnapshot::hash(&rootVersion, sizeof(rootVersion));
+  std::vector<char> buf(1 << 20);
+  std::size_t nread = 0;
+  while ( (nread = std::fread(buf.data(), 1, buf.size(), pfil)) > 0 ) {
+    val = GeometrySnapshot::hash(buf.data(), nread, val);
+  }
+  bool bad = std::ferror(pfil);
+  std::fclose(pfil);
+  if ( bad ) return 0;
+  // Zero flags an unreadable file.
+  return val == 0 ? 1 : val;
+}
+
+//**********************************************************************
+
+Name GdmlGeometryCache::defaultDirectory() {
+  const char* pdir = std::getenv("DUNE_GEOMETRY_CACHE");
+  if ( pdir != nullptr && *pdir != '\0' ) return pdir;
+  return "/tmp";
+}
+
+//**********************************************************************
+
+Name GdmlGeometryCache::cacheFileName(const Name& gdmlfile, Key key, const Name& dir) {
+  Name::size_type ipos = gdmlfile.rfind('/');
+  Name gdir = ipos == Name::npos ? "." : gdmlfile.substr(0, ipos);
+  Name stem = ipos == Name::npos ? gdmlfile : gdmlfile.substr(ipos + 1);
+  Name::size_type idot = stem.rfind('.');
+  if ( idot != Name::npos && idot > 0 ) stem = stem.substr(0, idot);
+  std::ostringstream ssout;
+  ssout << (dir.size() ? dir : gdir) << "/" << stem << "_"
+        << std::hex << std::setw(16) << std::setfill('0') << key << ".root";
+  return ssout.str();
+}
+
+//**********************************************************************
+// Member functions.
+//**********************************************************************
+
+GdmlGeometryCache::GdmlGeometryCache(Name dir, int logLevel)
+: m_dir(dir), m_logLevel(logLevel) {
+  while ( m_dir.size() > 1 && m_dir.back() == '/' ) m_dir.pop_back();
+}
+
+//**********************************************************************
+
+Name GdmlGeometryCache::find(const Name& gdmlfile) const {
+  const string myname = "GdmlGeometryCache::find: ";
+  Key gkey = key(gdmlfile);
+  if ( gkey == 0 ) {
+    cout << myname << "ERROR: Unable to read " << gdmlfile << endl;
+    return "";
+  }
+  for ( Name dir : {Name(), m_dir} ) {
+    Name fname = cacheFileName(gdmlfile, gkey, dir);
+    if ( fileExists(fname) ) {
+      if ( m_logLevel >= 2 ) cout << myname << "Found " << fname << endl;
+      return fname;
+    }
+  }
+  if ( m_logLevel >= 2 ) cout << myname << "No cache file for " << gdmlfile << endl;
+  return "";
+}
+
+//**********************************************************************
+
+int GdmlGeometryCache::make(const Name& gdmlfile, Name& fname) const {
+  const string myname = "GdmlGeometryCache::make: ";
+  fname.clear();
+  Key gkey = key(gdmlfile);
+  if ( gkey == 0 ) {
+    cout << myname << "ERROR: Unable to read " << gdmlfile << endl;
+    return 1;
+  }
+  Name cname = cacheFileName(gdmlfile, gkey, m_dir);
+  if ( TGeoManager::IsLocked() ) {
+    cout << myname << "ERROR: The geometry is locked." << endl;
+    return 2;
+  }
+  TGeoManager* pgeo = TGeoManager::Import(gdmlfile.c_str());
+  if ( pgeo == nullptr ) {
+    cout << myname << "ERROR: Unable to import " << gdmlfile << endl;
+    return 3;
+  }
+  // Export picks the format from the name, so the temporary name must end in .root.
+  Name tmpname = cname.substr(0, cname.size() - 5) + ".tmp" + std::to_string(getpid()) + ".root";
+  bool ok = pgeo->Export(tmpname.c_str()) != 0;
+  delete pgeo;
+  if ( ok ) ok = std::rename(tmpname.c_str(), cname.c_str()) == 0;
+  if ( ! ok ) {
+    std::remove(tmpname.c_str());
+    cout << myname << "ERROR: Unable to write " << cname << endl;
+    return 4;
+  }
+  if ( m_logLevel >= 1 ) cout << myname << "Wrote " << cname << endl;
+  fname = cname;
+  return 0;
+}
+
+//**********************************************************************
+
+Name GdmlGeometryCache::get(const Name& gdmlfile) const {
+  Name fname = find(gdmlfile);
+  if ( fname.size() ) return fname;
+  if ( make(gdmlfile, fname) ) return gdmlfile;
+  return fname;
+}
+
+//**********************************************************************
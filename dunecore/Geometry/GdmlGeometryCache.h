@@ -0,0 +1,79 @@
+// GdmlGeometryCache.h
+//
+// Cache of ROOT-serialised TGeoManager files made from GDML geometry descriptions.
+//
+// Building the TGeo geometry from one of the large GDML files, e.g. the full-wire
+// 10 kt or VD geometries, means parsing the XML and takes tens of seconds. The same
+// geometry written with TGeoManager::Export to a ROOT file is read back with
+// TGeoManager::Import in a fraction of that time. The geometry service passes its
+// ROOT file name to TGeoManager::Import, so a job uses the cache by setting
+//   services.Geometry.ROOT: "/path/to/dune10kt_v4_1x2x6_0123456789abcdef.root"
+// while GDML still names the GDML file (it is used by Geant4).
+//
+// Cache files are keyed by the checksum of the GDML text and the ROOT version and
+// are named STEM_KEY.root, where STEM is the GDML file name without its extension and
+// KEY is the key in hexadecimal. A file is looked for first next to the GDML file,
+// where a release may ship it, and then in the cache directory. The default cache
+// directory is $DUNE_GEOMETRY_CACHE or, if that is not set, /tmp.
+//
+// Making a cache file builds a TGeoManager and replaces gGeoManager, so it should be
+// done before the job geometry is loaded, e.g. with the dunegeocache command:
+//   dunegeocache dune10kt_v4_1x2x6.gdml
+// The file is written to a temporary name and renamed, so concurrent jobs never
+// read a partial file.
+//
+// art-independent class
+
+#ifndef GdmlGeometryCache_H
+#define GdmlGeometryCache_H
+
+#include <cstdint>
+#include <string>
+
+namespace geo {
+class GdmlGeometryCache;
+}
+
+class geo::GdmlGeometryCache {
+
+public:
+
+  using Name = std::string;
+  using Key = std::uint64_t;
+
+  // Key for GDML file gdmlfile. Returns 0 if the file cannot be read.
+  static Key key(const Name& gdmlfile);
+
+  // Cache directory from the environment.
+  static Name defaultDirectory();
+
+  // Name of the cache file for gdmlfile and key in directory dir.
+  // If dir is blank, the directory of gdmlfile is used.
+  static Name cacheFileName(const Name& gdmlfile, Key key, const Name& dir);
+
+  // Cache in directory dir.
+  // logLevel: 0 - errors only, 1 - also report new cache files, 2 - also lookups
+  explicit GdmlGeometryCache(Name dir = defaultDirectory(), int logLevel = 1);
+
+  const Name& directory() const { return m_dir; }
+  int logLevel() const { return m_logLevel; }
+
+  // Return the existing cache file for gdmlfile or blank if there is none.
+  Name find(const Name& gdmlfile) const;
+
+  // Write the cache file for gdmlfile to the cache directory and set fname to its name.
+  // Returns 0 for success.
+  int make(const Name& gdmlfile, Name& fname) const;
+
+  // Return the cache file for gdmlfile, making it if needed. If that fails, gdmlfile
+  // is returned so the caller can fall back to parsing the GDML.
+  Name get(const Name& gdmlfile) const;
+
+private:
+
+  Name m_dir;
+  int m_logLevel;
+
+};
+
+#endif
@@ -0,0 +1,65 @@
+// GeoObjectSortKeys.h
+//
+// Decorate-sort-undecorate for the GeoObjectSorter classes.
+//
+// The sorter comparators read the world coordinates (centers, wire ends) of both
+// objects on every comparison, i.e. O(n log n) times for n wires. sortByKey() instead
+// computes the key of each object once, sorts the keys and then moves the objects
+// into the sorted order, e.g.
+//   sortByKey(wgeo.begin(), wgeo.end(), wireCenterKey, sortWireAPA);
+// where sortWireAPA compares two keys. std::sort makes the same comparisons on the
+// keys as it would on the objects, so for a key comparator that gives the same results
+// as the object comparator the final order is unchanged, including that of objects
+// that compare equal.
+
+#ifndef GeoObjectSortKeys_H
+#define GeoObjectSortKeys_H
+
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/WireGeo.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace geo {
+
+  /// Wire quantities used by the wire comparators.
+  struct WireSortKey {
+    Point_t  center;
+    Vector_t delta;   ///< end minus start
+    double   thetaZ;
+  };
+
+  inline Point_t tpcCenterKey(TPCGeo const& tpc) { return tpc.GetCenter(); }
+  inline Point_t planeBoxCenterKey(PlaneGeo const& plane) { return plane.GetBoxCenter(); }
+  inline Point_t wireCenterKey(WireGeo const& wire) { return wire.GetCenter(); }
+  inline WireSortKey wireSortKey(WireGeo const& wire) {
+    return WireSortKey{ wire.GetCenter(), wire.GetEnd() - wire.GetStart(), wire.ThetaZ() };
+  }
+
+  /// Sorts [first, last) with comparator less applied to keyfun(object).
+  template <typename RanIt, typename KeyFun, typename KeyLess>
+  void sortByKey(RanIt first, RanIt last, KeyFun keyfun, KeyLess less) {
+    using Object = typename std::iterator_traits<RanIt>::value_type;
+    using Key = std::decay_t<decltype(keyfun(*first))>;
+    const std::size_t nobj = std::distance(first, last);
+    if ( nobj < 2 ) return;
+    std::vector<std::pair<Key, std::size_t>> keys;
+    keys.reserve(nobj);
+    for ( std::size_t iobj=0; iobj<nobj; ++iobj ) keys.emplace_back(keyfun(first[iobj]), iobj);
+    std::sort(keys.begin(), keys.end(),
+              [&less](auto const& lhs, auto const& rhs) { return less(lhs.first, rhs.first); });
+    std::vector<Object> sorted;
+    sorted.reserve(nobj);
+    for ( auto const& key : keys ) sorted.push_back(std::move(first[key.second]));
+    std::move(sorted.begin(), sorted.end(), first);
+  }
+
+} // namespace geo
+
+#endif
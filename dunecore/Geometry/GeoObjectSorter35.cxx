@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "dunecore/Geometry/GeoObjectSorter35.h"
+#include "dunecore/Geometry/GeoObjectSortKeys.h"
 #include "larcorealg/Geometry/AuxDetGeo.h"
 #include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
 #include "larcorealg/Geometry/CryostatGeo.h"
@@ -18,6 +19,7 @@
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include <cmath> // for std::abs
+#include <limits>
 
 namespace geo{
 
@@ -89,11 +91,9 @@ namespace geo{
 
   //----------------------------------------------------------------------------
   // Define sort order for tpcs in APA configuration.
-  static bool sortTPC35(const TPCGeo& t1, const TPCGeo& t2)
+  //   compares the TPC centers
+  static bool sortTPC35(const Point_t& xyz1, const Point_t& xyz2)
   {
-    auto const xyz1 = t1.GetCenter();
-    auto const xyz2 = t2.GetCenter();
-
     // very useful for aligning volume sorting with GDML bounds
     //  --> looking at this output is one way to find the z-borders between APAs,
     //      which tells soreWire35 to sort depending on z position via "InVertSplitRegion"
@@ -121,11 +121,9 @@ namespace geo{
   //----------------------------------------------------------------------------
   // Define sort order for planes in APA configuration
   //   same as standard, but implemented differently
-  static bool sortPlane35(const PlaneGeo& p1, const PlaneGeo& p2)
+  //   compares the plane box centers
+  static bool sortPlane35(const Point_t& xyz1, const Point_t& xyz2)
   {
-    auto const xyz1 = p1.GetBoxCenter();
-    auto const xyz2 = p2.GetBoxCenter();
-
     //mf::LogVerbatim("sortPlanes35") << "Sorting planes: ("
     //				    << xyz1.X() <<","<< xyz1.Y() <<","<< xyz1.Z() << ") and ("
     //				    << xyz2.X() <<","<< xyz2.Y() <<","<< xyz2.Z() << ")";
@@ -145,17 +143,33 @@ namespace geo{
   // at the plane level where there is one vertical center.
   // If the plane center is above, count from top down (the top stacked and
   // largest APAs) If the plane is below (bottom stacked APA) count bottom up
+  // The comparator takes the wire centers.
   struct sortWire35{
 
     std::string detVersion;
 
+    // z range (zSplitMin, zSplitMax) looking for top/bottom APAs, from detVersion
+    double zSplitMin = std::numeric_limits<double>::infinity();
+    double zSplitMax = std::numeric_limits<double>::infinity();
+
     sortWire35(std::string detv)
       : detVersion(detv)
-    {}
+    {
+      ///////////////////////////////////////////////////////////
+      // Hard code a number to tell sorting when to look
+      // for top/bottom APAs and when to look for only one
+      if(detVersion=="dune35t")             zSplitMin = 76.35;                            // the old
+      else if(detVersion=="dune35t4apa")    { zSplitMin = 51;       zSplitMax = 102; }    // the new...
+      else if(detVersion=="dune35t4apa_v2") { zSplitMin = 52.74;    zSplitMax = 106.23; } // ...and improved
+      else if(    detVersion=="dune35t4apa_v3"
+               || detVersion=="dune35t4apa_v4"
+               || detVersion=="dune35t4apa_v5"
+               || detVersion=="dune35t4apa_v6"
+                                          ) { zSplitMin = 51.41045; zSplitMax = 103.33445; }
+      ///////////////////////////////////////////////////////////
+    }
 
-    bool operator()(WireGeo const& w1, WireGeo const& w2){
-      auto const xyz1 = w1.GetCenter();
-      auto const xyz2 = w2.GetCenter();
+    bool operator()(Point_t const& xyz1, Point_t const& xyz2) const {
 
 
       //mf::LogVerbatim("sortWire35") << "Sorting wires: ("
@@ -167,22 +181,7 @@ namespace geo{
       // vertical wires should always have same y, and always increase in z direction
       if( xyz1.Y()==xyz2.Y() && xyz1.Z()<xyz2.Z() ) return true;
 
-      ///////////////////////////////////////////////////////////
-      // Hard code a number to tell sorting when to look
-      // for top/bottom APAs and when to look for only one
-      bool InVertSplitRegion = false;
-      if(detVersion=="dune35t")             InVertSplitRegion = xyz1.Z() > 76.35;      // the old
-      else if(detVersion=="dune35t4apa")    InVertSplitRegion = ((51 < xyz1.Z())       // the new...
-                                                                 && (xyz1.Z() < 102)); //
-      else if(detVersion=="dune35t4apa_v2") InVertSplitRegion = ((52.74 < xyz1.Z())    // ...and improved
-                                                                 && (xyz1.Z() < 106.23));
-      else if(    detVersion=="dune35t4apa_v3"
-               || detVersion=="dune35t4apa_v4"
-               || detVersion=="dune35t4apa_v5"
-               || detVersion=="dune35t4apa_v6"
-                                          ) InVertSplitRegion = ((51.41045 < xyz1.Z())
-                                                                 && (xyz1.Z() < 103.33445));
-      ///////////////////////////////////////////////////////////
+      bool InVertSplitRegion = (zSplitMin < xyz1.Z()) && (xyz1.Z() < zSplitMax);
 
       // we want the wires to be sorted such that the smallest corner wire
       // on the readout end of a plane is wire zero, with wire number
@@ -234,7 +233,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   void GeoObjectSorter35::SortTPCs(std::vector<geo::TPCGeo>  & tgeo) const
   {
-    std::sort(tgeo.begin(), tgeo.end(), sortTPC35);
+    sortByKey(tgeo.begin(), tgeo.end(), tpcCenterKey, sortTPC35);
   }
 
   //----------------------------------------------------------------------------
@@ -244,8 +243,8 @@ namespace geo{
     // sort the planes to increase in drift direction
     // The drift direction has to be set before this method is called.  It is set when
     // the CryostatGeo objects are sorted by the CryostatGeo::SortSubVolumes method
-    if     (driftDir == geo::kPosX) std::sort(pgeo.rbegin(), pgeo.rend(), sortPlane35);
-    else if(driftDir == geo::kNegX) std::sort(pgeo.begin(),  pgeo.end(),  sortPlane35);
+    if     (driftDir == geo::kPosX) sortByKey(pgeo.rbegin(), pgeo.rend(), planeBoxCenterKey, sortPlane35);
+    else if(driftDir == geo::kNegX) sortByKey(pgeo.begin(),  pgeo.end(),  planeBoxCenterKey, sortPlane35);
     else if(driftDir == geo::kUnknownDrift)
       throw cet::exception("TPCGeo") << "Drift direction is unknown, can't sort the planes\n";
   }
@@ -255,7 +254,7 @@ namespace geo{
   {
     sortWire35 sw35(fDetVersion);
 
-    std::sort(wgeo.begin(), wgeo.end(), sw35);
+    sortByKey(wgeo.begin(), wgeo.end(), wireCenterKey, sw35);
   }
 
 
@@ -8,6 +8,7 @@
 
 #include "dunecore/Geometry/GeoObjectSorterAPA.h"
 #include "dunecore/Geometry/OpDetSorter.h"
+#include "dunecore/Geometry/GeoObjectSortKeys.h"
 #include "larcorealg/Geometry/AuxDetGeo.h"
 #include "larcorealg/Geometry/CryostatGeo.h"
 #include "larcorealg/Geometry/TPCGeo.h"
@@ -79,11 +80,9 @@ namespace geo{
 
   //----------------------------------------------------------------------------
   // Define sort order for tpcs in APA configuration.
-  static bool sortTPCAPA(const TPCGeo& t1, const TPCGeo& t2)
+  //   compares the TPC centers
+  static bool sortTPCAPA(const Point_t& xyz1, const Point_t& xyz2)
   {
-    auto const xyz1 = t1.GetCenter();
-    auto const xyz2 = t2.GetCenter();
-
     // The goal is to number TPCs first in the x direction so that,
     // in the case of APA configuration, TPCs 2c and 2c+1 make up APA c.
     // then numbering will go in y then in z direction.
@@ -105,19 +104,16 @@ namespace geo{
  //----------------------------------------------------------------------------
   // Define sort order for planes in APA configuration
   //   same as standard, but implemented differently
-  static bool sortPlaneAPA(const PlaneGeo& p1, const PlaneGeo& p2)
+  //   compares the plane box centers
+  static bool sortPlaneAPA(const Point_t& xyz1, const Point_t& xyz2)
   {
-    auto const xyz1 = p1.GetBoxCenter();
-    auto const xyz2 = p2.GetBoxCenter();
-
     return xyz1.X() > xyz2.X();
   }
 
 
   //----------------------------------------------------------------------------
-  bool sortWireAPA(WireGeo& w1, WireGeo& w2){
-    auto const xyz1 = w1.GetCenter();
-    auto const xyz2 = w2.GetCenter();
+  // compares the wire centers
+  bool sortWireAPA(const Point_t& xyz1, const Point_t& xyz2){
 
     // we want the wires to be sorted such that the smallest corner wire
     // on the readout end of a plane is wire zero, with wire number
@@ -162,7 +158,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   void GeoObjectSorterAPA::SortTPCs(std::vector<geo::TPCGeo>  & tgeo) const
   {
-    std::sort(tgeo.begin(), tgeo.end(), sortTPCAPA);
+    sortByKey(tgeo.begin(), tgeo.end(), tpcCenterKey, sortTPCAPA);
   }
 
   //----------------------------------------------------------------------------
@@ -172,8 +168,8 @@ namespace geo{
     // sort the planes to increase in drift direction
     // The drift direction has to be set before this method is called.  It is set when
     // the CryostatGeo objects are sorted by the CryostatGeo::SortSubVolumes method
-    if     (driftDir == geo::kPosX) std::sort(pgeo.rbegin(), pgeo.rend(), sortPlaneAPA);
-    else if(driftDir == geo::kNegX) std::sort(pgeo.begin(),  pgeo.end(),  sortPlaneAPA);
+    if     (driftDir == geo::kPosX) sortByKey(pgeo.rbegin(), pgeo.rend(), planeBoxCenterKey, sortPlaneAPA);
+    else if(driftDir == geo::kNegX) sortByKey(pgeo.begin(),  pgeo.end(),  planeBoxCenterKey, sortPlaneAPA);
     else if(driftDir == geo::kUnknownDrift)
       throw cet::exception("TPCGeo") << "Drift direction is unknown, can't sort the planes\n";
   }
@@ -181,7 +177,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   void GeoObjectSorterAPA::SortWires(std::vector<geo::WireGeo> & wgeo) const
   {
-    std::sort(wgeo.begin(), wgeo.end(), sortWireAPA);
+    sortByKey(wgeo.begin(), wgeo.end(), wireCenterKey, sortWireAPA);
   }
 
   //----------------------------------------------------------------------------
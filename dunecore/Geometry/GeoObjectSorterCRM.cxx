@@ -8,6 +8,7 @@
 
 #include "dunecore/Geometry/GeoObjectSorterCRM.h"
 #include "dunecore/Geometry/OpDetSorter.h"
+#include "dunecore/Geometry/GeoObjectSortKeys.h"
 #include "larcorealg/Geometry/AuxDetGeo.h"
 #include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
 #include "larcorealg/Geometry/CryostatGeo.h"
@@ -69,10 +70,9 @@ namespace geo{
 
   //----------------------------------------------------------------------------
   // Define sort order for tpcs in dual-phase configuration
-  static bool sortTPCCRM(const TPCGeo& t1, const TPCGeo& t2)
+  //   compares the TPC centers
+  static bool sortTPCCRM(const Point_t& xyz1, const Point_t& xyz2)
   {
-    auto const xyz1 = t1.GetCenter();
-    auto const xyz2 = t2.GetCenter();
 
     // First sort all TPCs into same-z groups
     if(xyz1.Z()<xyz2.Z()) return true;
@@ -86,21 +86,17 @@ namespace geo{
 
   //----------------------------------------------------------------------------
   // Define sort order for planes in dual-phase configuration
-  static bool sortPlaneCRM(const PlaneGeo& p1, const PlaneGeo& p2)
+  //   compares the plane box centers
+  static bool sortPlaneCRM(const Point_t& xyz1, const Point_t& xyz2)
   {
-    auto const xyz1 = p1.GetBoxCenter();
-    auto const xyz2 = p2.GetBoxCenter();
-
     // drift direction is negative, plane number increases in drift direction
     return xyz1.X() > xyz2.X();
   }
 
 
   //----------------------------------------------------------------------------
-  bool sortWireCRM(WireGeo const& w1, WireGeo const& w2){
-
-    auto const xyz1 = w1.GetCenter();
-    auto const xyz2 = w2.GetCenter();
+  // compares the wire centers
+  bool sortWireCRM(Point_t const& xyz1, Point_t const& xyz2){
 
     // for dual-phase we have to planes with wires perpendicular to each other
     // sort wires in the increasing coordinate order
@@ -143,7 +139,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   void GeoObjectSorterCRM::SortTPCs(std::vector<geo::TPCGeo>  & tgeo) const
   {
-    std::sort(tgeo.begin(), tgeo.end(), sortTPCCRM);
+    sortByKey(tgeo.begin(), tgeo.end(), tpcCenterKey, sortTPCCRM);
   }
 
   //----------------------------------------------------------------------------
@@ -153,8 +149,8 @@ namespace geo{
     // sort the planes to increase in drift direction
     // The drift direction has to be set before this method is called.  It is set when
     // the CryostatGeo objects are sorted by the CryostatGeo::SortSubVolumes method
-    if     (driftDir == geo::kPosX) std::sort(pgeo.rbegin(), pgeo.rend(), sortPlaneCRM);
-    else if(driftDir == geo::kNegX) std::sort(pgeo.begin(),  pgeo.end(),  sortPlaneCRM);
+    if     (driftDir == geo::kPosX) sortByKey(pgeo.rbegin(), pgeo.rend(), planeBoxCenterKey, sortPlaneCRM);
+    else if(driftDir == geo::kNegX) sortByKey(pgeo.begin(),  pgeo.end(),  planeBoxCenterKey, sortPlaneCRM);
     else if(driftDir == geo::kUnknownDrift)
       throw cet::exception("TPCGeo") << "Drift direction is unknown, can't sort the planes\n";
   }
@@ -162,7 +158,7 @@ namespace geo{
   //----------------------------------------------------------------------------
   void GeoObjectSorterCRM::SortWires(std::vector<geo::WireGeo> & wgeo) const
   {
-    std::sort(wgeo.begin(), wgeo.end(), sortWireCRM);
+    sortByKey(wgeo.begin(), wgeo.end(), wireCenterKey, sortWireCRM);
   }
 
   //----------------------------------------------------------------------------
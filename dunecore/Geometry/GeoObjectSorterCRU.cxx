@@ -9,6 +9,7 @@
 
 #include "dunecore/Geometry/GeoObjectSorterCRU.h"
 #include "dunecore/Geometry/OpDetSorter.h"
+#include "dunecore/Geometry/GeoObjectSortKeys.h"
 #include "larcorealg/Geometry/AuxDetGeo.h"
 #include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
 #include "larcorealg/Geometry/CryostatGeo.h"
@@ -75,10 +76,8 @@ namespace geo {
 
     //----------------------------------------------------------------------------
     // Define sort order for tpcs (CRUs) in VD configuration
-    static bool sortTPC(const TPCGeo& t1, const TPCGeo& t2)
+    static bool sortTPC(const Point_t& xyz1, const Point_t& xyz2)
     {
-      auto const xyz1 = t1.GetCenter();
-      auto const xyz2 = t2.GetCenter();
 
       // First sort all TPCs into same-z groups
       if(xyz1.Z()<xyz2.Z()) return true;
@@ -92,10 +91,8 @@ namespace geo {
 
     //----------------------------------------------------------------------------
     // Define sort order for planes in VD configuration
-    static bool sortPlane(const PlaneGeo& p1, const PlaneGeo& p2)
+    static bool sortPlane(const Point_t& xyz1, const Point_t& xyz2)
     {
-      auto const xyz1 = p1.GetBoxCenter();
-      auto const xyz2 = p2.GetBoxCenter();
 
       // drift direction is negative, plane number increases in drift direction
       return xyz1.X() > xyz2.X();
@@ -103,7 +100,7 @@ namespace geo {
 
 
     //----------------------------------------------------------------------------
-    bool sortWire(WireGeo const& w1, WireGeo const& w2){
+    bool sortWire(WireSortKey const& w1, WireSortKey const& w2){
       // wire sorting algorithm
       // z_low -> z_high
       // for same-z group 
@@ -113,16 +110,14 @@ namespace geo {
       //  we assume all wires in the plane are parallel
 
       //  w1 geo info
-      auto center1 = w1.GetCenter();
-      auto start1  = w1.GetStart();
-      auto end1    = w1.GetEnd();
-      auto Delta   = end1-start1;
+      auto center1 = w1.center;
+      auto Delta   = w1.delta;
       //double dx1   = Delta.X();
       double dy1   = Delta.Y();
       double dz1   = Delta.Z();
       
       // w2 geo info
-      auto center2 = w2.GetCenter();
+      auto center2 = w2.center;
       
       auto CheckTol = [](double val, double tol = 1.E-4){ 
 	return (std::abs( val ) < tol); 
@@ -174,7 +169,7 @@ namespace geo {
   //----------------------------------------------------------------------------
   void GeoObjectSorterCRU::SortTPCs(std::vector<geo::TPCGeo>  & tgeo) const
   {
-    std::sort(tgeo.begin(), tgeo.end(), CRU::sortTPC);
+    sortByKey(tgeo.begin(), tgeo.end(), tpcCenterKey, CRU::sortTPC);
   }
 
   //----------------------------------------------------------------------------
@@ -184,8 +179,8 @@ namespace geo {
     // sort the planes to increase in drift direction
     // The drift direction has to be set before this method is called.  It is set when
     // the CryostatGeo objects are sorted by the CryostatGeo::SortSubVolumes method
-    if     (driftDir == geo::kPosX) std::sort(pgeo.rbegin(), pgeo.rend(), CRU::sortPlane);
-    else if(driftDir == geo::kNegX) std::sort(pgeo.begin(),  pgeo.end(),  CRU::sortPlane);
+    if     (driftDir == geo::kPosX) sortByKey(pgeo.rbegin(), pgeo.rend(), planeBoxCenterKey, CRU::sortPlane);
+    else if(driftDir == geo::kNegX) sortByKey(pgeo.begin(),  pgeo.end(),  planeBoxCenterKey, CRU::sortPlane);
     else if(driftDir == geo::kUnknownDrift)
       throw cet::exception("TPCGeo") << "Drift direction is unknown, can't sort the planes\n";
   }
@@ -193,7 +188,7 @@ namespace geo {
   //----------------------------------------------------------------------------
   void GeoObjectSorterCRU::SortWires(std::vector<geo::WireGeo> & wgeo) const
   {
-    std::sort(wgeo.begin(), wgeo.end(), CRU::sortWire);
+    sortByKey(wgeo.begin(), wgeo.end(), wireSortKey, CRU::sortWire);
   }
 
   //----------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 
 #include "dunecore/Geometry/GeoObjectSorterCRU60D.h"
 #include "dunecore/Geometry/OpDetSorter.h"
+#include "dunecore/Geometry/GeoObjectSortKeys.h"
 #include "larcorealg/Geometry/AuxDetGeo.h"
 #include "larcorealg/Geometry/AuxDetSensitiveGeo.h"
 #include "larcorealg/Geometry/CryostatGeo.h"
@@ -117,10 +118,8 @@ namespace geo {
 
     //----------------------------------------------------------------------------
     // Define sort order for TPC volumes (CRU60D) in VD configuration
-    static bool sortTPC(const TPCGeo& t1, const TPCGeo& t2)
+    static bool sortTPC(const Point_t& xyz1, const Point_t& xyz2)
     {
-      auto const xyz1 = t1.GetCenter();
-      auto const xyz2 = t2.GetCenter();
 
       // try to get drift coord index
       short int dc = geo::CRU60D::getDriftCoord();
@@ -143,10 +142,8 @@ namespace geo {
     }
 
     // Sort TPC for ProtoDUNE VD
-    static bool sortTPCPDVD(const TPCGeo& t1, const TPCGeo& t2)
+    static bool sortTPCPDVD(const Point_t& xyz1, const Point_t& xyz2)
     {
-      auto const xyz1 = t1.GetCenter();
-      auto const xyz2 = t2.GetCenter();
 
       // try to get drift coord index
       short int dc = geo::CRU60D::getDriftCoord();
@@ -180,10 +177,8 @@ namespace geo {
 
     //----------------------------------------------------------------------------
     // Define sort order for planes in VD configuration
-    static bool sortPlane(const PlaneGeo& p1, const PlaneGeo& p2)
+    static bool sortPlane(const Point_t& xyz1, const Point_t& xyz2)
     {
-      auto const xyz1 = p1.GetBoxCenter();
-      auto const xyz2 = p2.GetBoxCenter();
 
       // try to get drift coord index
       short int dc = geo::CRU60D::getDriftCoord();
@@ -194,21 +189,19 @@ namespace geo {
 
 
     //----------------------------------------------------------------------------
-    bool sortWireDX(WireGeo const& w1, WireGeo const& w2){ // X is drift coordinate
+    bool sortWireDX(WireSortKey const& w1, WireSortKey const& w2){ // X is drift coordinate
       // wire sorting algorithm
 
       //  w1 geo info
-      auto center1 = w1.GetCenter();
-      auto start1  = w1.GetStart();
-      auto end1    = w1.GetEnd();
-      auto Delta   = end1-start1;
+      auto center1 = w1.center;
+      auto Delta   = w1.delta;
       //double dx1   = Delta.X();
       double dy1   = Delta.Y();
       double dz1   = Delta.Z();
-      double thtz  = w1.ThetaZ();
+      double thtz  = w1.thetaZ;
 
       // w2 geo info
-      auto center2 = w2.GetCenter();
+      auto center2 = w2.center;
 
       auto CheckTol = [](double val, double tol = 1.E-4){
         return (std::abs( val ) < tol);
@@ -253,20 +246,18 @@ namespace geo {
     }
 
     //
-    bool sortWireDY(WireGeo const& w1, WireGeo const& w2){ // Y is drift coordinate
+    bool sortWireDY(WireSortKey const& w1, WireSortKey const& w2){ // Y is drift coordinate
       // wire sorting algorithm
 
       //  w1 geo info
-      auto center1 = w1.GetCenter();
-      auto start1  = w1.GetStart();
-      auto end1    = w1.GetEnd();
-      auto Delta   = end1-start1;
+      auto center1 = w1.center;
+      auto Delta   = w1.delta;
       double dx1   = Delta.X();
       double dz1   = Delta.Z();
-      double thtz  = w1.ThetaZ();
+      double thtz  = w1.thetaZ;
 
       // w2 geo info
-      auto center2 = w2.GetCenter();
+      auto center2 = w2.center;
 
       auto CheckTol = [](double val, double tol = 1.E-4){
         return (std::abs( val ) < tol);
@@ -310,7 +301,7 @@ namespace geo {
       return ( center1.Z() > center2.Z() );
     }
 
-    bool sortWire(WireGeo const& w1, WireGeo const& w2){
+    bool sortWire(WireSortKey const& w1, WireSortKey const& w2){
       short int dc = geo::CRU60D::getDriftCoord();
       if( dc == 1 ) return sortWireDY( w1, w2 );
       return sortWireDX( w1, w2 );
@@ -349,8 +340,8 @@ namespace geo {
       MF_LOG_DEBUG("GeoObjectSorterCRU60D")
         <<" Retrieved drift axis "<<geo::CRU60D::TPCDriftAxis;
     }
-    if (fSortTPCPDVD) std::sort(tgeo.begin(), tgeo.end(), CRU60D::sortTPCPDVD);
-    else              std::sort(tgeo.begin(), tgeo.end(), CRU60D::sortTPC);
+    if (fSortTPCPDVD) sortByKey(tgeo.begin(), tgeo.end(), tpcCenterKey, CRU60D::sortTPCPDVD);
+    else              sortByKey(tgeo.begin(), tgeo.end(), tpcCenterKey, CRU60D::sortTPC);
 
   }
 
@@ -361,8 +352,8 @@ namespace geo {
     // sort the planes to increase in drift direction
     // The drift direction has to be set before this method is called.  It is set when
     // the CryostatGeo objects are sorted by the CryostatGeo::SortSubVolumes method
-    if     (driftDir == geo::kPosX) std::sort(pgeo.rbegin(), pgeo.rend(), CRU60D::sortPlane);
-    else if(driftDir == geo::kNegX) std::sort(pgeo.begin(),  pgeo.end(),  CRU60D::sortPlane);
+    if     (driftDir == geo::kPosX) sortByKey(pgeo.rbegin(), pgeo.rend(), planeBoxCenterKey, CRU60D::sortPlane);
+    else if(driftDir == geo::kNegX) sortByKey(pgeo.begin(),  pgeo.end(),  planeBoxCenterKey, CRU60D::sortPlane);
     else if(driftDir == geo::kUnknownDrift)
       throw cet::exception("TPCGeo") << "Drift direction is unknown, can't sort the planes\n";
   }
@@ -370,7 +361,7 @@ namespace geo {
   //----------------------------------------------------------------------------
   void GeoObjectSorterCRU60D::SortWires(std::vector<geo::WireGeo> & wgeo) const
   {
-    std::sort(wgeo.begin(), wgeo.end(), CRU60D::sortWire);
+    sortByKey(wgeo.begin(), wgeo.end(), wireSortKey, CRU60D::sortWire);
   }
 
   //----------------------------------------------------------------------------
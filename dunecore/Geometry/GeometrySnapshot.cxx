@@ -0,0 +1,216 @@
+// GeometrySnapshot.cxx
+
+#include "GeometrySnapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using geo::GeometrySnapshot;
+using std::string;
+using std::vector;
+using std::size_t;
+using std::uint32_t;
+using std::uint64_t;
+
+namespace {
+
+const char snapMagic[8] = {'D', 'U', 'N', 'E', 'G', 'S', 'N', 'P'};
+constexpr uint32_t snapVersion = 1;
+constexpr uint32_t snapByteOrder = 0x01020304;
+constexpr size_t snapAlign = 64;
+constexpr size_t snapNameSize = 32;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint64_t nsection;
+  uint64_t key;
+  uint64_t checksum;   // of everything following the header
+};
+
+struct TableEntry {
+  char name[snapNameSize];
+  uint64_t elemsize;
+  uint64_t count;
+  uint64_t offset;
+};
+
+size_t alignUp(size_t off) {
+  return (off + snapAlign - 1)/snapAlign*snapAlign;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int GeometrySnapshot::
+write(const string& fname, uint64_t key, const vector<Section>& secs) {
+  // Build the image in memory: the tables are small compared with the geometry.
+  vector<TableEntry> tab(secs.size());
+  size_t off = alignUp(sizeof(FileHeader) + secs.size()*sizeof(TableEntry));
+  for ( size_t isec=0; isec<secs.size(); ++isec ) {
+    const Section& sec = secs[isec];
+    if ( sec.name.empty() || sec.name.size() >= snapNameSize ) return 1;
+    TableEntry& ent = tab[isec];
+    std::memset(&ent, 0, sizeof(ent));
+    std::memcpy(ent.name, sec.name.data(), sec.name.size());
+    ent.elemsize = sec.elemsize;
+    ent.count = sec.count;
+    ent.offset = off;
+    off = alignUp(off + sec.elemsize*sec.count);
+  }
+  vector<char> image(off, 0);
+  if ( ! tab.empty() ) std::memcpy(image.data() + sizeof(FileHeader), tab.data(), tab.size()*sizeof(TableEntry));
+  for ( size_t isec=0; isec<secs.size(); ++isec ) {
+    size_t nbyte = secs[isec].elemsize*secs[isec].count;
+    if ( nbyte ) std::memcpy(image.data() + tab[isec].offset, secs[isec].data, nbyte);
+  }
+  FileHeader hdr;
+  std::memset(&hdr, 0, sizeof(hdr));
+  std::memcpy(hdr.magic, snapMagic, sizeof(snapMagic));
+  hdr.version = snapVersion;
+  hdr.byteOrder = snapByteOrder;
+  hdr.nsection = secs.size();
+  hdr.key = key;
+  hdr.checksum = hash(image.data() + sizeof(FileHeader), image.size() - sizeof(FileHeader));
+  std::memcpy(image.data(), &hdr, sizeof(hdr));
+  // Write to a temporary file in the same directory and rename it into place.
+  string tmpname = fname + ".tmp." + std::to_string(getpid());
+  FILE* pfil = std::fopen(tmpname.c_str(), "wb");
+  if ( pfil == nullptr ) return 2;
+  bool ok = std::fwrite(image.data(), 1, image.size(), pfil) == image.size();
+  ok = (std::fclose(pfil) == 0) && ok;
+  if ( ok ) ok = std::rename(tmpname.c_str(), fname.c_str()) == 0;
+  if ( ! ok ) {
+    std::remove(tmpname.c_str());
+    return 3;
+  }
+  return 0;
+}
+
+//**********************************************************************
+
+uint64_t GeometrySnapshot::hash(const void* pdat, size_t nbyte, uint64_t seed) {
+  const unsigned char* pch = static_cast<const unsigned char*>(pdat);
+  uint64_t val = seed;
+  for ( size_t ibyt=0; ibyt<nbyte; ++ibyt ) {
+    val ^= pch[ibyt];
+    val *= 0x100000001b3ULL;
+  }
+  return val;
+}
+
+//**********************************************************************
+
+GeometrySnapshot::GeometrySnapshot(const string& fname) {
+  int fd = open(fname.c_str(), O_RDONLY);
+  if ( fd < 0 ) return;
+  struct stat st;
+  if ( fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(FileHeader) ) {
+    close(fd);
+    return;
+  }
+  size_t size = st.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if ( addr == MAP_FAILED ) return;
+  const char* base = static_cast<const char*>(addr);
+  FileHeader hdr;
+  std::memcpy(&hdr, base, sizeof(hdr));
+  bool ok = std::memcmp(hdr.magic, snapMagic, sizeof(snapMagic)) == 0 &&
+            hdr.version == snapVersion && hdr.byteOrder == snapByteOrder &&
+            hdr.nsection <= (size - sizeof(FileHeader))/sizeof(TableEntry) &&
+            hdr.checksum == hash(base + sizeof(FileHeader), size - sizeof(FileHeader));
+  vector<Entry> ents;
+  if ( ok ) {
+    const TableEntry* tab = reinterpret_cast<const TableEntry*>(base + sizeof(FileHeader));
+    for ( size_t isec=0; isec<hdr.nsection; ++isec ) {
+      const TableEntry& ent = tab[isec];
+      size_t nbyte = ent.elemsize*ent.count;
+      if ( ent.offset%snapAlign != 0 || ent.offset > size || nbyte > size - ent.offset ||
+           (ent.elemsize != 0 && nbyte/ent.elemsize != ent.count) ) {
+        ok = false;
+        break;
+      }
+      ents.push_back(Entry{string(ent.name, strnlen(ent.name, snapNameSize)),
+                           size_t(ent.elemsize), size_t(ent.count), size_t(ent.offset)});
+    }
+  }
+  if ( ! ok ) {
+    munmap(addr, size);
+    return;
+  }
+  m_addr = addr;
+  m_size = size;
+  m_key = hdr.key;
+  m_entries.swap(ents);
+}
+
+//**********************************************************************
+
+GeometrySnapshot::GeometrySnapshot(GeometrySnapshot&& rhs) noexcept
+: m_addr(rhs.m_addr), m_size(rhs.m_size), m_key(rhs.m_key),
+  m_entries(std::move(rhs.m_entries)) {
+  rhs.m_addr = nullptr;
+  rhs.m_size = 0;
+  rhs.m_key = 0;
+  rhs.m_entries.clear();
+}
+
+//**********************************************************************
+
+GeometrySnapshot& GeometrySnapshot::operator=(GeometrySnapshot&& rhs) noexcept {
+  if ( this != &rhs ) {
+    clear();
+    std::swap(m_addr, rhs.m_addr);
+    std::swap(m_size, rhs.m_size);
+    std::swap(m_key, rhs.m_key);
+    m_entries.swap(rhs.m_entries);
+  }
+  return *this;
+}
+
+//**********************************************************************
+
+GeometrySnapshot::~GeometrySnapshot() {
+  clear();
+}
+
+//**********************************************************************
+
+void GeometrySnapshot::clear() {
+  if ( m_addr != nullptr ) munmap(m_addr, m_size);
+  m_addr = nullptr;
+  m_size = 0;
+  m_key = 0;
+  m_entries.clear();
+}
+
+//**********************************************************************
+
+bool GeometrySnapshot::has(const string& name) const {
+  for ( const Entry& ent : m_entries ) if ( ent.name == name ) return true;
+  return false;
+}
+
+//**********************************************************************
+
+const void* GeometrySnapshot::
+find(const string& name, size_t elemsize, size_t& count) const {
+  count = 0;
+  for ( const Entry& ent : m_entries ) {
+    if ( ent.name != name ) continue;
+    if ( ent.elemsize != elemsize || ent.count == 0 ) return nullptr;
+    count = ent.count;
+    return static_cast<const char*>(m_addr) + ent.offset;
+  }
+  return nullptr;
+}
+
+//**********************************************************************
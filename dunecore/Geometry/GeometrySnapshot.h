@@ -0,0 +1,117 @@
+// GeometrySnapshot.h
+//
+// Read-only, memory-mapped file of named flat arrays, used to share the channel map
+// tables built in Initialize() between the processes running on one node.
+//
+// The first process to initialize a channel map algorithm writes the tables with
+// GeometrySnapshot::write(...). The others map the file and use the arrays in
+// place, so the pages are shared through the page cache rather than built and held
+// by every process, e.g.
+//   GeometrySnapshot snap(fname);
+//   if ( snap.isValid() && snap.key() == key ) {
+//     util::span<WireID const*> wires = snap.get<WireID>("ChannelWires");
+//     ...
+//   }
+// The arrays stay valid for the lifetime of the snapshot object.
+//
+// File layout, all in native byte order:
+//   header  - magic, version, byte-order tag, section count, key and checksum
+//   table   - name, element size, element count and file offset of each section
+//   data    - the sections, each starting on a 64-byte boundary
+// A file of another format, byte order or key, with a wrong checksum, or with a section
+// of an unexpected element size is not used. Only trivially copyable types can be stored.
+// The file is written to a temporary name and renamed, so readers never see a partial
+// file and concurrent writers are harmless.
+//
+// art-independent class
+
+#ifndef GeometrySnapshot_H
+#define GeometrySnapshot_H
+
+#include "larcorealg/CoreUtils/span.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace geo {
+class GeometrySnapshot;
+}
+
+class geo::GeometrySnapshot {
+
+public:
+
+  // Description of one array to be written.
+  struct Section {
+    std::string name;
+    const void* data = nullptr;
+    std::size_t elemsize = 0;
+    std::size_t count = 0;
+  };
+
+  // Describe the n entries starting at pdat as section name.
+  template<class T>
+  static Section section(std::string name, const T* pdat, std::size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections must be trivially copyable");
+    return Section{name, pdat, sizeof(T), n};
+  }
+
+  // Write the sections to file fname with key key. Returns 0 for success.
+  static int write(const std::string& fname, std::uint64_t key, const std::vector<Section>& secs);
+
+  // 64-bit FNV-1a hash, for building keys.
+  static std::uint64_t hash(const void* pdat, std::size_t nbyte,
+                            std::uint64_t seed = 0xcbf29ce484222325ULL);
+
+  // Empty snapshot.
+  GeometrySnapshot() = default;
+
+  // Map file fname. The snapshot is invalid if the file is missing or unusable.
+  explicit GeometrySnapshot(const std::string& fname);
+
+  GeometrySnapshot(GeometrySnapshot&& rhs) noexcept;
+  GeometrySnapshot& operator=(GeometrySnapshot&& rhs) noexcept;
+  GeometrySnapshot(const GeometrySnapshot&) = delete;
+  GeometrySnapshot& operator=(const GeometrySnapshot&) = delete;
+  ~GeometrySnapshot();
+
+  bool isValid() const { return m_addr != nullptr; }
+  std::uint64_t key() const { return m_key; }
+
+  // Unmap the file.
+  void clear();
+
+  // Return the section with this name. The span is empty if the section is absent
+  // or its element size is not sizeof(T).
+  template<class T>
+  util::span<T const*> get(const std::string& name) const {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections must be trivially copyable");
+    std::size_t n = 0;
+    const T* pdat = static_cast<const T*>(find(name, sizeof(T), n));
+    return util::span<T const*>(pdat, pdat + n);
+  }
+
+  // Return if the snapshot has a section with this name.
+  bool has(const std::string& name) const;
+
+private:
+
+  struct Entry {
+    std::string name;
+    std::size_t elemsize;
+    std::size_t count;
+    std::size_t offset;
+  };
+
+  const void* find(const std::string& name, std::size_t elemsize, std::size_t& count) const;
+
+  void* m_addr = nullptr;
+  std::size_t m_size = 0;
+  std::uint64_t m_key = 0;
+  std::vector<Entry> m_entries;
+
+};
+
+#endif
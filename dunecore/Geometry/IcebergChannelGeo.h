@@ -6,6 +6,9 @@
 // Return geometry info for a channel using the current
 // geometry service.
 //
+// Use ChannelGeoTable::instance(pgeo, ChannelGeoTable::Iceberg) for the values for
+// all channels.
+//
 // This is a special vertion that fixes the bottom limit of the wires
 // required for the May 2020 Iceberg geometry.
 
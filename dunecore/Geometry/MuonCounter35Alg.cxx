@@ -12,6 +12,32 @@
 #include "messagefacility/MessageLogger/MessageLogger.h" 
 
 #include <fstream>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+  // counters with fewer tree entries are not split further
+  const unsigned int maxLeafCounters = 4;
+
+  // counter boxes are widened by this amount (cm) so that flat counters have
+  // a nonzero thickness
+  const double boxPadding = 0.001;
+
+  // fill the hit data for one counter: counter ID, flag, track ID and
+  // intersection point
+  void addHit(std::vector< std::vector<double> > &hitcounters,
+	      const std::vector<double> &singlecountergeometry,
+	      int trackID, const TVector3 &point){
+
+    int counterID = singlecountergeometry[0];
+    int counterFlag = singlecountergeometry[1];
+    hitcounters.push_back({double(counterID), double(counterFlag), double(trackID),
+	  point.X(), point.Y(), point.Z()});
+
+  }
+
+}
 
 namespace geo{
 
@@ -140,8 +166,8 @@ namespace geo{
   //----------------------------------------------------------------------------
 
   int MuonCounter35Alg::testTrackInAllCounters(int trackID, 
-					       TVector3 trackpoint, TVector3 trackdirection, 
-					       std::vector< std::vector<double> > &geometry, 
+					       const TVector3 &trackpoint, const TVector3 &trackdirection, 
+					       const std::vector< std::vector<double> > &geometry, 
 					       std::vector< std::vector<double> > &hitcounters){
 
     // This function tests whether a track, defined by a point and a direction, 
@@ -153,14 +179,12 @@ namespace geo{
     // condition flag of a hit counter, and the track ID and intersection point with
     // that counter. It returns the number of hit counters.
 
-    int counterID = -1;
     int counterFlag = -1;
 
     // loop over the counters
     for(unsigned int igeo=0; igeo<geometry.size(); igeo++){
 
-      // first two indicies of each counter geometry are ID and flag
-      counterID = geometry[igeo][0];
+      // second index of each counter geometry is the flag
       counterFlag = geometry[igeo][1];
 
       // check that the counter is on
@@ -175,21 +199,7 @@ namespace geo{
 	// if track intersection point is inside the counter area, fill the 
 	// vector of hit counter data
 
-	if(inside){
-
-	  // add an empty vector to fill with the hit data
-	  hitcounters.push_back(std::vector<double>());
-	  int ncounter = hitcounters.size()-1;
-
-	  // add the data to the vector
-	  hitcounters[ncounter].push_back(counterID);
-	  hitcounters[ncounter].push_back(counterFlag);
-	  hitcounters[ncounter].push_back(trackID);
-	  hitcounters[ncounter].push_back(insectionPoint.X());
-	  hitcounters[ncounter].push_back(insectionPoint.Y());
-	  hitcounters[ncounter].push_back(insectionPoint.Z());
-
-	} // check if a track/counter plane intersection point was found
+	if(inside) addHit(hitcounters, geometry[igeo], trackID, insectionPoint);
 
       } // check that the counter condition flag is non-zero
 
@@ -201,8 +211,8 @@ namespace geo{
 
   //----------------------------------------------------------------------------
 
-  int MuonCounter35Alg::testTrackInCounter(TVector3 trackpoint, TVector3 trackdirection, 
-					   std::vector<double> &singlecountergeometry,
+  int MuonCounter35Alg::testTrackInCounter(const TVector3 &trackpoint, const TVector3 &trackdirection, 
+					   const std::vector<double> &singlecountergeometry,
 					   TVector3 &intersectionpoint){
 
     // This function tests whether a track, defined by a point and a direction, 
@@ -218,6 +228,7 @@ namespace geo{
 
     // sort the counter verticies into TVector3 vectors
     std::vector<TVector3> points;
+    points.reserve(singlecountergeometry.size()/3);
 
     // after the first two indicies, each next three values are coordinates
 
@@ -371,22 +382,8 @@ namespace geo{
       // This gives us a 2D polygon and a point which we can test to see if 
       // it is inside the polygon.
 
-      double *vert1 = NULL;
-      vert1 = (double*) realloc(vert1,points.size()*sizeof(double));
-
-      double *vert2 = NULL;
-      vert2 = (double*) realloc(vert2,points.size()*sizeof(double));
-
-      if(vert1 != NULL && vert2 != NULL){
-
-	for(unsigned int i=0; i<points.size(); i++){
-
-	  vert1[i] = 0;
-	  vert2[i] = 0;
-
-	}
-
-      }
+      std::vector<double> vert1(points.size(), 0.);
+      std::vector<double> vert2(points.size(), 0.);
 
       double test1 = 0.;
       double test2 = 0.;
@@ -446,10 +443,7 @@ namespace geo{
       // test for the intersection point inside the counter polygon
       // 1 = inside, 0 = outside
 
-      intersect = testPointInPolygon(points.size(), vert1, vert2, test1, test2);
-
-      free(vert1);
-      free(vert2);
+      intersect = testPointInPolygon(points.size(), vert1.data(), vert2.data(), test1, test2);
 
       if(intersect) intersectionpoint = planeinterpoint;
 
@@ -493,4 +487,200 @@ namespace geo{
 
   //----------------------------------------------------------------------------
 
+  MuonCounter35Alg::CounterIndex::CounterIndex(const std::vector< std::vector<double> > &geometry)
+    : fGeometry(geometry), fBoxes(geometry.size())
+  {
+
+    // box each counter that is switched on and has at least 3 corners
+
+    for(unsigned int igeo=0; igeo<geometry.size(); igeo++){
+
+      const std::vector<double> &counter = geometry[igeo];
+      if(counter.size() < 11 || counter[1] == 0) continue;
+
+      Box &box = fBoxes[igeo];
+      for(unsigned int k=0; k<3; k++){
+	box.lo[k] = std::numeric_limits<double>::max();
+	box.hi[k] = -std::numeric_limits<double>::max();
+      }
+      for(unsigned int icoord=2; icoord+2<counter.size(); icoord=icoord+3){
+	for(unsigned int k=0; k<3; k++){
+	  box.lo[k] = std::min(box.lo[k], counter[icoord+k]);
+	  box.hi[k] = std::max(box.hi[k], counter[icoord+k]);
+	}
+      }
+      for(unsigned int k=0; k<3; k++){
+	box.lo[k] -= boxPadding;
+	box.hi[k] += boxPadding;
+      }
+
+      fCounters.push_back(igeo);
+
+    }
+
+    if(fCounters.empty()) return;
+    fNodes.reserve(2*fCounters.size());
+    fNodes.push_back(Node());
+    build(0, 0, fCounters.size());
+
+  }
+
+  //----------------------------------------------------------------------------
+
+  void MuonCounter35Alg::CounterIndex::build(unsigned int inode, unsigned int begin, unsigned int end){
+
+    // box enclosing the counters and their centres
+
+    Box box;
+    double clo[3];
+    double chi[3];
+    for(unsigned int k=0; k<3; k++){
+      box.lo[k] = clo[k] = std::numeric_limits<double>::max();
+      box.hi[k] = chi[k] = -std::numeric_limits<double>::max();
+    }
+    for(unsigned int i=begin; i<end; i++){
+      const Box &cbox = fBoxes[fCounters[i]];
+      for(unsigned int k=0; k<3; k++){
+	box.lo[k] = std::min(box.lo[k], cbox.lo[k]);
+	box.hi[k] = std::max(box.hi[k], cbox.hi[k]);
+	double cen = 0.5*(cbox.lo[k] + cbox.hi[k]);
+	clo[k] = std::min(clo[k], cen);
+	chi[k] = std::max(chi[k], cen);
+      }
+    }
+    fNodes[inode].box = box;
+
+    if(end - begin <= maxLeafCounters){
+      fNodes[inode].first = begin;
+      fNodes[inode].count = end - begin;
+      return;
+    }
+
+    // split at the median centre along the axis with the largest spread
+
+    unsigned int axis = 0;
+    for(unsigned int k=1; k<3; k++){
+      if(chi[k] - clo[k] > chi[axis] - clo[axis]) axis = k;
+    }
+    unsigned int mid = begin + (end - begin)/2;
+    const std::vector<Box> &boxes = fBoxes;
+    std::nth_element(fCounters.begin() + begin, fCounters.begin() + mid, fCounters.begin() + end,
+		     [&boxes, axis](unsigned int lhs, unsigned int rhs){
+		       return boxes[lhs].lo[axis] + boxes[lhs].hi[axis] < boxes[rhs].lo[axis] + boxes[rhs].hi[axis];
+		     });
+
+    unsigned int ichild = fNodes.size();
+    fNodes.resize(ichild + 2);
+    fNodes[inode].first = ichild;
+    fNodes[inode].count = 0;
+    build(ichild, begin, mid);
+    build(ichild + 1, mid, end);
+
+  }
+
+  //----------------------------------------------------------------------------
+
+  bool MuonCounter35Alg::CounterIndex::lineCrossesBox(const Box &box, const double *point, const double *dir){
+
+    // slab test for the infinite line point + r*dir
+
+    double rmin = -std::numeric_limits<double>::max();
+    double rmax = std::numeric_limits<double>::max();
+
+    for(unsigned int k=0; k<3; k++){
+
+      if(dir[k] == 0){
+	if(point[k] < box.lo[k] || point[k] > box.hi[k]) return false;
+	continue;
+      }
+
+      double r1 = (box.lo[k] - point[k])/dir[k];
+      double r2 = (box.hi[k] - point[k])/dir[k];
+      if(r1 > r2) std::swap(r1, r2);
+      if(r1 > rmin) rmin = r1;
+      if(r2 < rmax) rmax = r2;
+      if(rmin > rmax) return false;
+
+    }
+
+    return true;
+
+  }
+
+  //----------------------------------------------------------------------------
+
+  int MuonCounter35Alg::CounterIndex::testTrack(int trackID, const TVector3 &trackpoint,
+						const TVector3 &trackdirection,
+						std::vector< std::vector<double> > &hitcounters) const {
+
+    if(fNodes.empty()) return hitcounters.size();
+
+    double point[3] = {trackpoint.X(), trackpoint.Y(), trackpoint.Z()};
+    double dir[3] = {trackdirection.X(), trackdirection.Y(), trackdirection.Z()};
+
+    // collect the counters whose boxes are crossed by the track line
+
+    std::vector<unsigned int> candidates;
+    unsigned int stack[64];
+    unsigned int nstack = 0;
+    stack[nstack++] = 0;
+
+    while(nstack > 0){
+
+      const Node &node = fNodes[stack[--nstack]];
+      if(!lineCrossesBox(node.box, point, dir)) continue;
+
+      if(node.count > 0){
+	for(unsigned int i=node.first; i<node.first+node.count; i++){
+	  if(lineCrossesBox(fBoxes[fCounters[i]], point, dir)) candidates.push_back(fCounters[i]);
+	}
+      }
+      else{
+	stack[nstack++] = node.first;
+	stack[nstack++] = node.first + 1;
+      }
+
+    }
+
+    // test the candidates in geometry order so the hits match testTrackInAllCounters
+
+    std::sort(candidates.begin(), candidates.end());
+
+    for(unsigned int igeo : candidates){
+
+      TVector3 insectionPoint(0.,0.,0.);
+
+      if(testTrackInCounter(trackpoint, trackdirection, fGeometry[igeo], insectionPoint)){
+	addHit(hitcounters, fGeometry[igeo], trackID, insectionPoint);
+      }
+
+    }
+
+    return hitcounters.size();
+
+  }
+
+  //----------------------------------------------------------------------------
+
+  int MuonCounter35Alg::CounterIndex::testTracks(const std::vector<int> &trackIDs,
+						 const std::vector<TVector3> &trackpoints,
+						 const std::vector<TVector3> &trackdirections,
+						 std::vector< std::vector<double> > &hitcounters) const {
+
+    unsigned int ntrack = std::min(trackIDs.size(), std::min(trackpoints.size(), trackdirections.size()));
+
+    if(ntrack != trackIDs.size() || ntrack != trackpoints.size() || ntrack != trackdirections.size()){
+      mf::LogError("MuonCounter35t") << "Track ID, point and direction vectors have different sizes.";
+    }
+
+    for(unsigned int itrk=0; itrk<ntrack; itrk++){
+      testTrack(trackIDs[itrk], trackpoints[itrk], trackdirections[itrk], hitcounters);
+    }
+
+    return hitcounters.size();
+
+  }
+
+  //----------------------------------------------------------------------------
+
 } // namespace
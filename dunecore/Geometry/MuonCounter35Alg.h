@@ -11,6 +11,10 @@
 #include "larcorealg/Geometry/ChannelMapAlg.h"
 #include "fhiclcpp/ParameterSet.h"
 
+#include "TVector3.h"
+
+#include <vector>
+
 namespace geo{
 
   class MuonCounter35Alg : public ChannelMapAlg{
@@ -29,20 +33,76 @@ namespace geo{
 
     // test if a track intersects any counter
 
-    static int testTrackInAllCounters(int trackID, TVector3 trackpoint, TVector3 trackvector, 
-			       std::vector< std::vector<double> > &geometry,
+    static int testTrackInAllCounters(int trackID, const TVector3 &trackpoint, const TVector3 &trackvector, 
+			       const std::vector< std::vector<double> > &geometry,
 			       std::vector< std::vector<double> > &hitcounters);
 
     // test if a track intersects a single counter
 
-    static int testTrackInCounter(TVector3 trackpoint, TVector3 trackvector,
-			   std::vector<double> &singlecountergeometry,
+    static int testTrackInCounter(const TVector3 &trackpoint, const TVector3 &trackvector,
+			   const std::vector<double> &singlecountergeometry,
 			   TVector3 &intersectionpoint);
 
     // function to test if a point is inside a 2D polygon
 
     static int testPointInPolygon(int nvert, double *vertx, double *verty, double testx, double testy);
 
+    // Bounding-volume hierarchy over the counters that are switched on.
+    //
+    // Each counter is enclosed in an axis-aligned box and the boxes are grouped
+    // in a binary tree, so that only the counters whose boxes are crossed by
+    // the track line are tested with testTrackInCounter. The hits are the same
+    // and in the same order as those from testTrackInAllCounters.
+    //
+    // The geometry must outlive the index.
+
+    class CounterIndex {
+
+    public:
+
+      // build the index for geometry as read by loadMuonCounterGeometry
+      explicit CounterIndex(const std::vector< std::vector<double> > &geometry);
+
+      // number of indexed (switched on) counters
+      unsigned int size() const { return fCounters.size(); }
+
+      // test one track, appending any hits to hitcounters; returns the number of hit counters
+      int testTrack(int trackID, const TVector3 &trackpoint, const TVector3 &trackvector,
+		    std::vector< std::vector<double> > &hitcounters) const;
+
+      // test many tracks: trackIDs, trackpoints and trackvectors must have the same size;
+      // returns the number of hit counters
+      int testTracks(const std::vector<int> &trackIDs,
+		     const std::vector<TVector3> &trackpoints,
+		     const std::vector<TVector3> &trackvectors,
+		     std::vector< std::vector<double> > &hitcounters) const;
+
+    private:
+
+      struct Box {
+	double lo[3];
+	double hi[3];
+      };
+
+      // tree node: internal nodes have count = 0 and children first and first+1;
+      // leaves hold count counters starting at fCounters[first]
+      struct Node {
+	Box box;
+	unsigned int first;
+	unsigned int count;
+      };
+
+      const std::vector< std::vector<double> > &fGeometry;
+      std::vector<unsigned int> fCounters;   // geometry indices, in tree order
+      std::vector<Box> fBoxes;               // box for each geometry index
+      std::vector<Node> fNodes;
+
+      void build(unsigned int inode, unsigned int begin, unsigned int end);
+
+      static bool lineCrossesBox(const Box &box, const double *point, const double *dir);
+
+    };
+
   private:
     
 
@@ -0,0 +1,139 @@
+// PlaneChannelTable.cxx
+
+#include "PlaneChannelTable.h"
+#include <algorithm>
+#include <cassert>
+
+using geo::PlaneChannelTable;
+using geo::WireID;
+using geo::PlaneID;
+using readout::ROPID;
+using raw::ChannelID_t;
+using Index = PlaneChannelTable::Index;
+using std::vector;
+
+//**********************************************************************
+
+void PlaneChannelTable::reset(const vector<vector<Index>>& nplanes) {
+  clear();
+  Index ntpc = 0;
+  Index npla = 0;
+  m_cryFirstTpc.push_back(ntpc);
+  for ( const vector<Index>& cryPlanes : nplanes ) {
+    for ( Index itpc=0; itpc<cryPlanes.size(); ++itpc ) {
+      m_tpcFirstPlane.push_back(npla);
+      npla += cryPlanes[itpc];
+    }
+    ntpc += cryPlanes.size();
+    m_cryFirstTpc.push_back(ntpc);
+  }
+  m_tpcFirstPlane.push_back(npla);
+  m_planeFirstChannel.resize(npla, 0);
+  m_planeNWires.resize(npla, 0);
+  m_planeROP.resize(npla, npos);
+  m_orthY.resize(npla, 0.0);
+  m_orthZ.resize(npla, 0.0);
+  m_firstProj.resize(npla, 0.0);
+  m_planeIDs.reserve(npla);
+  for ( Index icry=0; icry<nplanes.size(); ++icry ) {
+    for ( Index itpc=0; itpc<nplanes[icry].size(); ++itpc ) {
+      for ( Index ipla=0; ipla<nplanes[icry][itpc]; ++ipla ) {
+        m_planeIDs.emplace_back(icry, itpc, ipla);
+      }
+    }
+  }
+  m_ropPlaneOffsets.push_back(0);
+}
+
+//**********************************************************************
+
+void PlaneChannelTable::setPlane(const PlaneID& pid, ChannelID_t firstChannel, Index nwire) {
+  if ( ! hasPlane(pid) ) return;
+  Index ipla = planeIndex(pid);
+  m_planeFirstChannel[ipla] = firstChannel;
+  m_planeNWires[ipla] = nwire;
+}
+
+//**********************************************************************
+
+void PlaneChannelTable::setWireCoordinate(const PlaneID& pid, float orthY, float orthZ, float firstProj) {
+  if ( ! hasPlane(pid) ) return;
+  Index ipla = planeIndex(pid);
+  m_orthY[ipla] = orthY;
+  m_orthZ[ipla] = orthZ;
+  m_firstProj[ipla] = firstProj;
+}
+
+//**********************************************************************
+
+void PlaneChannelTable::addROP(const ROPID& rid, ChannelID_t firstChannel, Index nchan,
+                               const PlaneIDVector& pids) {
+  assert( m_ropFirstChannel.empty() || m_ropFirstChannel.back() < firstChannel );
+  assert( m_ropIDs.empty() || m_ropIDs.back() < rid );
+  Index irop = m_ropIDs.size();
+  m_ropFirstChannel.push_back(firstChannel);
+  m_ropNChannels.push_back(nchan);
+  m_ropIDs.push_back(rid);
+  for ( const PlaneID& pid : pids ) {
+    if ( ! hasPlane(pid) ) continue;
+    Index ipla = planeIndex(pid);
+    m_ropPlanes.push_back(ipla);
+    m_planeROP[ipla] = irop;
+  }
+  m_ropPlaneOffsets.push_back(m_ropPlanes.size());
+}
+
+//**********************************************************************
+
+void PlaneChannelTable::clear() {
+  vector<Index>().swap(m_cryFirstTpc);
+  vector<Index>().swap(m_tpcFirstPlane);
+  vector<ChannelID_t>().swap(m_planeFirstChannel);
+  vector<WireCount>().swap(m_planeNWires);
+  vector<Index>().swap(m_planeROP);
+  vector<float>().swap(m_orthY);
+  vector<float>().swap(m_orthZ);
+  vector<float>().swap(m_firstProj);
+  PlaneIDVector().swap(m_planeIDs);
+  vector<ChannelID_t>().swap(m_ropFirstChannel);
+  vector<WireCount>().swap(m_ropNChannels);
+  vector<ROPID>().swap(m_ropIDs);
+  vector<Index>().swap(m_ropPlaneOffsets);
+  vector<Index>().swap(m_ropPlanes);
+  m_endChannel = 0;
+}
+
+//**********************************************************************
+
+Index PlaneChannelTable::findROP(ChannelID_t icha) const {
+  if ( icha >= m_endChannel ) return npos;
+  vector<ChannelID_t>::const_iterator inext =
+    std::upper_bound(m_ropFirstChannel.begin(), m_ropFirstChannel.end(), icha);
+  if ( inext == m_ropFirstChannel.begin() ) return npos;
+  return (inext - m_ropFirstChannel.begin()) - 1;
+}
+
+//**********************************************************************
+
+Index PlaneChannelTable::findROP(const ROPID& rid) const {
+  vector<ROPID>::const_iterator irid = std::lower_bound(m_ropIDs.begin(), m_ropIDs.end(), rid);
+  if ( irid == m_ropIDs.end() || *irid != rid ) return npos;
+  return irid - m_ropIDs.begin();
+}
+
+//**********************************************************************
+
+Index PlaneChannelTable::channelToWire(ChannelID_t icha, vector<WireID>& wids) const {
+  wids.clear();
+  Index irop = findROP(icha);
+  if ( irop == npos ) return npos;
+  for ( Index iipl=m_ropPlaneOffsets[irop]; iipl<m_ropPlaneOffsets[irop+1]; ++iipl ) {
+    Index ipla = m_ropPlanes[iipl];
+    ChannelID_t icha0 = m_planeFirstChannel[ipla];
+    if ( icha < icha0 || icha - icha0 >= m_planeNWires[ipla] ) continue;
+    wids.emplace_back(m_planeIDs[ipla], WireID::WireID_t(icha - icha0));
+  }
+  return irop;
+}
+
+//**********************************************************************
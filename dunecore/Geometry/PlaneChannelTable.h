@@ -0,0 +1,145 @@
+// PlaneChannelTable.h
+//
+// Flat channel and wire-plane tables shared by the vertical-drift channel maps
+// ChannelMapCRUAlg and ColdBoxChannelMapAlg.
+//
+// Both maps assign a contiguous channel range to each wire plane and group the
+// planes in readout planes (ROPs) with increasing channel ranges. The table holds
+// that layout as struct-of-arrays:
+//   plane - first channel, wire count, ROP index, ID and the single-precision
+//           wire-coordinate constants, indexed by a flat plane index
+//   ROP   - first channel, channel count, ID and plane list, in channel order
+// so a channel is located with one binary search and no per-plane containers are
+// allocated, e.g.
+//   tab.reset(nplanes);
+//   tab.setPlane(pid, firstChannel, nwire);
+//   tab.setWireCoordinate(pid, orthY, orthZ, firstProj);
+//   tab.addROP(rid, firstChannel, nchannels, pids);
+//   tab.setEndChannel(nchannels);
+//
+// ROPs must be added in increasing order of both first channel and ID.
+
+#ifndef PlaneChannelTable_H
+#define PlaneChannelTable_H
+
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/readout_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace geo {
+class PlaneChannelTable;
+}
+
+class geo::PlaneChannelTable {
+
+public:
+
+  using Index = unsigned int;
+  using PlaneIDVector = std::vector<PlaneID>;
+
+  // Value returned for a ROP that is not found.
+  static constexpr Index npos = std::numeric_limits<Index>::max();
+
+  // Define the layout: the number of planes in each TPC of each cryostat,
+  // nplanes[icry][itpc]. This clears any previous content.
+  void reset(const std::vector<std::vector<Index>>& nplanes);
+
+  // Set the first channel and number of wires for a plane in the layout.
+  void setPlane(const PlaneID& pid, raw::ChannelID_t firstChannel, Index nwire);
+
+  // Set the wire coordinate constants for a plane: the components of the
+  // orthogonal vector and the projection of the first wire, all divided by the
+  // wire pitch.
+  void setWireCoordinate(const PlaneID& pid, float orthY, float orthZ, float firstProj);
+
+  // Add a readout plane holding channels [firstChannel, firstChannel+nchan) and
+  // the listed planes, which must already be in the layout.
+  void addROP(const readout::ROPID& rid, raw::ChannelID_t firstChannel, Index nchan,
+              const PlaneIDVector& pids);
+
+  // Set the channel after the last valid one.
+  void setEndChannel(raw::ChannelID_t icha) { m_endChannel = icha; }
+
+  // Empty the tables and release their memory.
+  void clear();
+
+  // Number of planes in the layout and of readout planes.
+  Index nPlane() const { return m_planeIDs.size(); }
+  Index nROP() const { return m_ropIDs.size(); }
+
+  // Channel after the last valid one.
+  raw::ChannelID_t endChannel() const { return m_endChannel; }
+
+  // Is the plane in the layout?
+  bool hasPlane(const PlaneID& pid) const {
+    if ( pid.Cryostat + 1 >= m_cryFirstTpc.size() ) return false;
+    Index itpc = m_cryFirstTpc[pid.Cryostat] + pid.TPC;
+    return itpc < m_cryFirstTpc[pid.Cryostat+1] &&
+           pid.Plane < m_tpcFirstPlane[itpc+1] - m_tpcFirstPlane[itpc];
+  }
+
+  // Plane values. The plane must be in the layout.
+  raw::ChannelID_t planeFirstChannel(const PlaneID& pid) const { return m_planeFirstChannel[planeIndex(pid)]; }
+  Index nWires(const PlaneID& pid) const { return m_planeNWires[planeIndex(pid)]; }
+  Index planeROP(const PlaneID& pid) const { return m_planeROP[planeIndex(pid)]; }
+
+  // Channel for a wire. The plane must be in the layout.
+  raw::ChannelID_t planeWireToChannel(const WireID& wid) const {
+    return m_planeFirstChannel[planeIndex(wid)] + wid.Wire;
+  }
+
+  // Wire coordinate for position (ypos, zpos). The plane must be in the layout.
+  double wireCoordinate(double ypos, double zpos, const PlaneID& pid) const {
+    Index ipla = planeIndex(pid);
+    return ypos*m_orthY[ipla] + zpos*m_orthZ[ipla] - m_firstProj[ipla];
+  }
+
+  // Index of the ROP holding a channel or of a ROP ID, npos if not found.
+  Index findROP(raw::ChannelID_t icha) const;
+  Index findROP(const readout::ROPID& rid) const;
+
+  // ROP values. The index must be less than nROP().
+  const readout::ROPID& ropID(Index irop) const { return m_ropIDs[irop]; }
+  raw::ChannelID_t ropFirstChannel(Index irop) const { return m_ropFirstChannel[irop]; }
+  Index ropNChannels(Index irop) const { return m_ropNChannels[irop]; }
+
+  // Replace wids with the wires for a channel, one for each plane of its ROP
+  // whose range includes the channel. Returns the ROP index or npos.
+  Index channelToWire(raw::ChannelID_t icha, std::vector<WireID>& wids) const;
+
+private:
+
+  using WireCount = std::uint32_t;
+
+  // Layout. The TPCs of cryostat icry are m_cryFirstTpc[icry]...m_cryFirstTpc[icry+1]-1
+  // and the planes of flat TPC index itpc start at m_tpcFirstPlane[itpc].
+  std::vector<Index> m_cryFirstTpc;
+  std::vector<Index> m_tpcFirstPlane;
+
+  // Planes.
+  std::vector<raw::ChannelID_t> m_planeFirstChannel;
+  std::vector<WireCount> m_planeNWires;
+  std::vector<Index> m_planeROP;
+  std::vector<float> m_orthY;
+  std::vector<float> m_orthZ;
+  std::vector<float> m_firstProj;
+  PlaneIDVector m_planeIDs;
+
+  // ROPs. The planes of ROP irop are m_ropPlanes[m_ropPlaneOffsets[irop]...].
+  std::vector<raw::ChannelID_t> m_ropFirstChannel;
+  std::vector<WireCount> m_ropNChannels;
+  std::vector<readout::ROPID> m_ropIDs;
+  std::vector<Index> m_ropPlaneOffsets;
+  std::vector<Index> m_ropPlanes;
+  raw::ChannelID_t m_endChannel = 0;
+
+  Index planeIndex(const PlaneID& pid) const {
+    return m_tpcFirstPlane[m_cryFirstTpc[pid.Cryostat] + pid.TPC] + pid.Plane;
+  }
+
+};
+
+#endif
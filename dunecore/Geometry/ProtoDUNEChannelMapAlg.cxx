@@ -35,7 +35,7 @@ namespace geo {
 //----------------------------------------------------------------------------
 
   ProtoDUNEChannelMapAlg::ProtoDUNEChannelMapAlg(const fhicl::ParameterSet& p)
-    : DuneApaChannelMapAlg(p), 
+    : DuneApaChannelMapAlg(p, true), 
       fMaxOpChannel(0), fNOpChannels(0)
   {
     fSorter = new GeoObjectSorterAPA(p);
@@ -35,7 +35,7 @@ namespace geo {
 //----------------------------------------------------------------------------
 
   ProtoDUNEChannelMapAlgv7::ProtoDUNEChannelMapAlgv7(const fhicl::ParameterSet& p)
-    : DuneApaChannelMapAlg(p), 
+    : DuneApaChannelMapAlg(p, true), 
       fMaxOpChannel(0), fNOpChannels(0)
   {
     fSorter = new GeoObjectSorterAPA(p);
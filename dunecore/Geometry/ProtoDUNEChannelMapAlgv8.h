@@ -11,6 +11,9 @@
 /// Inherits from the central DuneApaChannelMapAlg, just adding special channel-mapping
 /// specific to the photon detectors in protoDUNE.
 ///
+/// The channel-to-wire table of the base class is built by default (see
+/// DuneApaChannelMapAlg); UseChannelToWireTable: false disables it.
+///
 ////////////////////////////////////////////////////////////////////////
 #ifndef geo_ProtoDUNEChannelMapAlgv8_H
 #define geo_ProtoDUNEChannelMapAlgv8_H
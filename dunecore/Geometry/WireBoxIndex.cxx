@@ -0,0 +1,213 @@
+// WireBoxIndex.cxx
+
+#include "WireBoxIndex.h"
+
+#include <algorithm>
+#include <numeric>
+
+using Index = WireBoxIndex::Index;
+using IndexVector = WireBoxIndex::IndexVector;
+using std::vector;
+
+//**********************************************************************
+
+void WireBoxIndex::IntervalTree::
+build(const vector<float>& los, const vector<float>& his) {
+  clear();
+  Index nint = los.size();
+  m_order.resize(nint);
+  std::iota(m_order.begin(), m_order.end(), 0);
+  std::stable_sort(m_order.begin(), m_order.end(),
+                   [&los](Index lhs, Index rhs) { return los[lhs] < los[rhs]; });
+  m_los.resize(nint);
+  m_his.resize(nint);
+  for ( Index iint=0; iint<nint; ++iint ) {
+    m_los[iint] = los[m_order[iint]];
+    m_his[iint] = his[m_order[iint]];
+  }
+  if ( nint == 0 ) return;
+  // Max tree: node 1 covers [0, nint), node n has children 2n and 2n+1.
+  m_maxHi.resize(4*nint);
+  struct Builder {
+    const vector<float>& his;
+    vector<float>& maxHi;
+    float operator()(Index inod, Index ibeg, Index iend) {
+      if ( iend - ibeg == 1 ) return maxHi[inod] = his[ibeg];
+      Index imid = (ibeg + iend)/2;
+      float lmax = (*this)(2*inod, ibeg, imid);
+      float rmax = (*this)(2*inod + 1, imid, iend);
+      return maxHi[inod] = std::max(lmax, rmax);
+    }
+  } builder{m_his, m_maxHi};
+  builder(1, 0, nint);
+}
+
+//**********************************************************************
+
+void WireBoxIndex::IntervalTree::clear() {
+  m_order.clear();
+  m_los.clear();
+  m_his.clear();
+  m_maxHi.clear();
+}
+
+//**********************************************************************
+
+Index WireBoxIndex::IntervalTree::nlow(float hi) const {
+  return std::upper_bound(m_los.begin(), m_los.end(), hi) - m_los.begin();
+}
+
+//**********************************************************************
+
+void WireBoxIndex::IntervalTree::find(float lo, float hi, IndexVector& out) const {
+  if ( m_los.empty() ) return;
+  find(1, 0, m_los.size(), nlow(hi), lo, out);
+}
+
+//**********************************************************************
+
+void WireBoxIndex::IntervalTree::
+find(Index inod, Index ibeg, Index iend, Index nlo, float lo, IndexVector& out) const {
+  // Only the first nlo intervals start at or below hi.
+  if ( ibeg >= nlo || m_maxHi[inod] < lo ) return;
+  if ( iend - ibeg == 1 ) {
+    out.push_back(m_order[ibeg]);
+    return;
+  }
+  Index imid = (ibeg + iend)/2;
+  find(2*inod, ibeg, imid, nlo, lo, out);
+  find(2*inod + 1, imid, iend, nlo, lo, out);
+}
+
+//**********************************************************************
+
+void WireBoxIndex::build(const BoxVector& boxes) {
+  clear();
+  m_boxes = boxes;
+  Index nwir = m_boxes.size();
+  vector<float> zcens(nwir);
+  vector<float> y1s(nwir), y2s(nwir), x1s(nwir), x2s(nwir);
+  for ( Index iwir=0; iwir<nwir; ++iwir ) {
+    const Box& box = m_boxes[iwir];
+    zcens[iwir] = 0.5*(box.z1 + box.z2);
+    m_maxHalfPitch = std::max(m_maxHalfPitch, 0.5f*(box.z2 - box.z1));
+    y1s[iwir] = box.y1;
+    y2s[iwir] = box.y2;
+    x1s[iwir] = box.x1;
+    x2s[iwir] = box.x2;
+  }
+  m_maxHalfPitch = 1.001*m_maxHalfPitch + 1.e-6;
+  m_zorder.resize(nwir);
+  std::iota(m_zorder.begin(), m_zorder.end(), 0);
+  std::stable_sort(m_zorder.begin(), m_zorder.end(),
+                   [&zcens](Index lhs, Index rhs) { return zcens[lhs] < zcens[rhs]; });
+  m_zcenters.resize(nwir);
+  for ( Index iord=0; iord<nwir; ++iord ) m_zcenters[iord] = zcens[m_zorder[iord]];
+  m_ytree.build(y1s, y2s);
+  m_xtree.build(x1s, x2s);
+}
+
+//**********************************************************************
+
+void WireBoxIndex::clear() {
+  m_boxes.clear();
+  m_zorder.clear();
+  m_zcenters.clear();
+  m_maxHalfPitch = 0.0;
+  m_ytree.clear();
+  m_xtree.clear();
+}
+
+//**********************************************************************
+
+void WireBoxIndex::zCandidates(float z1, float z2, Index& ibeg, Index& iend) const {
+  ibeg = std::lower_bound(m_zcenters.begin(), m_zcenters.end(), z1 - m_maxHalfPitch) - m_zcenters.begin();
+  iend = std::upper_bound(m_zcenters.begin(), m_zcenters.end(), z2 + m_maxHalfPitch) - m_zcenters.begin();
+  if ( iend < ibeg ) iend = ibeg;
+}
+
+//**********************************************************************
+
+IndexVector WireBoxIndex::
+overlapping(float x1, float x2, float y1, float y2, float z1, float z2) const {
+  IndexVector cands;
+  // Take the candidates from the most selective of the three orderings.
+  Index ibeg = 0;
+  Index iend = 0;
+  zCandidates(z1, z2, ibeg, iend);
+  Index nz = iend - ibeg;
+  Index ny = m_ytree.nlow(y2);
+  Index nx = m_xtree.nlow(x2);
+  if ( nz <= ny && nz <= nx ) {
+    cands.assign(m_zorder.begin() + ibeg, m_zorder.begin() + iend);
+  } else if ( ny <= nx ) {
+    m_ytree.find(y1, y2, cands);
+  } else {
+    m_xtree.find(x1, x2, cands);
+  }
+  IndexVector iwirs;
+  for ( Index iwir : cands ) {
+    const Box& box = m_boxes[iwir];
+    if ( box.x2 < x1 || box.x1 > x2 ) continue;
+    if ( box.y2 < y1 || box.y1 > y2 ) continue;
+    if ( box.z2 < z1 || box.z1 > z2 ) continue;
+    iwirs.push_back(iwir);
+  }
+  std::sort(iwirs.begin(), iwirs.end());
+  return iwirs;
+}
+
+//**********************************************************************
+
+IndexVector WireBoxIndex::zRange(float z1, float z2) const {
+  Index ibeg = 0;
+  Index iend = 0;
+  zCandidates(z1, z2, ibeg, iend);
+  IndexVector iwirs;
+  for ( Index iord=ibeg; iord<iend; ++iord ) {
+    Index iwir = m_zorder[iord];
+    const Box& box = m_boxes[iwir];
+    if ( box.z2 < z1 || box.z1 > z2 ) continue;
+    iwirs.push_back(iwir);
+  }
+  std::sort(iwirs.begin(), iwirs.end());
+  return iwirs;
+}
+
+//**********************************************************************
+
+IndexVector WireBoxIndex::yRange(float y1, float y2) const {
+  IndexVector iwirs;
+  m_ytree.find(y1, y2, iwirs);
+  std::sort(iwirs.begin(), iwirs.end());
+  return iwirs;
+}
+
+//**********************************************************************
+
+IndexVector WireBoxIndex::driftRange(float x1, float x2) const {
+  IndexVector iwirs;
+  m_xtree.find(x1, x2, iwirs);
+  std::sort(iwirs.begin(), iwirs.end());
+  return iwirs;
+}
+
+//**********************************************************************
+
+Index WireBoxIndex::nearest(float y, float z) const {
+  // Walk outward from z in order of distance until a wire holds y.
+  Index nwir = size();
+  Index iright = std::lower_bound(m_zcenters.begin(), m_zcenters.end(), z) - m_zcenters.begin();
+  Index ileft = iright;
+  while ( ileft > 0 || iright < nwir ) {
+    bool useLeft = iright >= nwir ||
+                   (ileft > 0 && z - m_zcenters[ileft-1] <= m_zcenters[iright] - z);
+    Index iord = useLeft ? --ileft : iright++;
+    Index iwir = m_zorder[iord];
+    const Box& box = m_boxes[iwir];
+    if ( box.y1 <= y && y <= box.y2 ) return iwir;
+  }
+  return nwir;
+}
+
+//**********************************************************************
@@ -0,0 +1,105 @@
+// WireBoxIndex.h
+//
+// Spatial index for the wires of a WireSelector.
+//
+// Each wire is described by a box: the drift range [x1, x2], the extent [y1, y2]
+// along the wire and the pitch cell [z1, z2] in the wire coordinate (see
+// WireSelector::WireInfo). The index holds
+//   - the wires ordered in z (wire coordinate) for z-range and nearest-wire queries
+//   - interval trees on the y and x extents for y-range and drift-range queries
+// so that the selections take O(log N + K) rather than a scan over all N wires.
+//
+// Selections return indices in the box vector used to build the index, in
+// increasing order. Ranges are inclusive.
+//
+// Example:
+//   WireSelector sel;
+//   sel.selectWireAngle(0.0);
+//   const WireBoxIndex& idx = sel.fillWireIndex();
+//   for ( Index iwir : idx.overlapping(x1, x2, y1, y2, z1, z2) ) use(sel.data()[iwir]);
+//
+// art-independent class
+
+#ifndef WireBoxIndex_H
+#define WireBoxIndex_H
+
+#include <vector>
+
+class WireBoxIndex {
+
+public:
+
+  using Index = unsigned int;
+  using IndexVector = std::vector<Index>;
+
+  struct Box {
+    float x1, x2;
+    float y1, y2;
+    float z1, z2;
+  };
+
+  using BoxVector = std::vector<Box>;
+
+  // Build the index for the boxes.
+  void build(const BoxVector& boxes);
+
+  // Clear the index.
+  void clear();
+
+  // Number of boxes.
+  Index size() const { return m_boxes.size(); }
+  bool empty() const { return m_boxes.empty(); }
+
+  // Return the boxes.
+  const BoxVector& boxes() const { return m_boxes; }
+
+  // Wires whose box overlaps the region [x1, x2] x [y1, y2] x [z1, z2].
+  IndexVector overlapping(float x1, float x2, float y1, float y2, float z1, float z2) const;
+
+  // Wires whose pitch cell overlaps [z1, z2].
+  IndexVector zRange(float z1, float z2) const;
+
+  // Wires whose extent along the wire overlaps [y1, y2].
+  IndexVector yRange(float y1, float y2) const;
+
+  // Wires whose drift range overlaps [x1, x2].
+  IndexVector driftRange(float x1, float x2) const;
+
+  // Wire whose y extent holds y with the center of its pitch cell closest to z.
+  // Returns size() if no wire holds y.
+  Index nearest(float y, float z) const;
+
+private:
+
+  // Static interval tree: the intervals sorted by low edge with a max tree on
+  // the high edges. Used for the y and x extents.
+  class IntervalTree {
+  public:
+    void build(const std::vector<float>& los, const std::vector<float>& his);
+    void clear();
+    // Append to out the indices of intervals overlapping [lo, hi].
+    void find(float lo, float hi, IndexVector& out) const;
+    // Number of intervals with low edge <= hi, an upper limit for find(lo, hi).
+    Index nlow(float hi) const;
+  private:
+    void find(Index inod, Index ibeg, Index iend, Index nlo, float lo, IndexVector& out) const;
+    IndexVector m_order;           // interval indices sorted by low edge
+    std::vector<float> m_los;      // sorted low edges
+    std::vector<float> m_his;      // high edges in the same order
+    std::vector<float> m_maxHi;    // max of the high edges in each tree node
+  };
+
+  // Range [ibeg, iend) in m_zorder of the wires with z center in
+  // [z1 - m_maxHalfPitch, z2 + m_maxHalfPitch].
+  void zCandidates(float z1, float z2, Index& ibeg, Index& iend) const;
+
+  BoxVector m_boxes;
+  IndexVector m_zorder;          // wire indices sorted by pitch cell center
+  std::vector<float> m_zcenters; // sorted cell centers
+  float m_maxHalfPitch = 0.0;   // with a margin for rounding
+  IntervalTree m_ytree;
+  IntervalTree m_xtree;
+
+};
+
+#endif
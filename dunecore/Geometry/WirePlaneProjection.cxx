@@ -0,0 +1,153 @@
+// WirePlaneProjection.cxx
+
+#include "WirePlaneProjection.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define WIREPROJ_AVX2 1
+#endif
+
+using geo::WirePlaneProjection;
+using WireNumber = WirePlaneProjection::WireNumber;
+
+namespace {
+
+// Coefficients in the form used by the kernels.
+struct Coeffs {
+  float y0, z0, ycoef, zcoef, ymin, ymax, zmin, zmax;
+  int iwirMax;
+};
+
+inline float coordScalar(const Coeffs& c, float y, float z) {
+  return c.ycoef*(y - c.y0) + c.zcoef*(z - c.z0);
+}
+
+inline WireNumber nearestScalar(const Coeffs& c, float y, float z) {
+  float ycap = std::max(c.ymin, std::min(c.ymax, y));
+  float zcap = std::max(c.zmin, std::min(c.zmax, z));
+  int iwir = int(0.5f + coordScalar(c, ycap, zcap));
+  return std::max(0, std::min(c.iwirMax, iwir));
+}
+
+void wireCoordinatesScalar(const Coeffs& c, const double* ys, const double* zs, size_t n, double* out) {
+  for ( size_t i=0; i<n; ++i ) out[i] = coordScalar(c, ys[i], zs[i]);
+}
+
+void nearestWiresScalar(const Coeffs& c, const double* ys, const double* zs, size_t n, WireNumber* out) {
+  for ( size_t i=0; i<n; ++i ) out[i] = nearestScalar(c, ys[i], zs[i]);
+}
+
+#ifdef WIREPROJ_AVX2
+
+// Eight points per iteration: the doubles are narrowed to floats and projected with
+// the same multiply and add sequence as the scalar code. The tail is done with the
+// scalar code.
+
+__attribute__((target("avx2")))
+inline __m256 load8(const double* p) {
+  __m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(p));
+  __m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(p + 4));
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+}
+
+__attribute__((target("avx2")))
+inline __m256 coord8(const Coeffs& c, __m256 y, __m256 z) {
+  __m256 dy = _mm256_sub_ps(y, _mm256_set1_ps(c.y0));
+  __m256 dz = _mm256_sub_ps(z, _mm256_set1_ps(c.z0));
+  return _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(c.ycoef), dy),
+                       _mm256_mul_ps(_mm256_set1_ps(c.zcoef), dz));
+}
+
+__attribute__((target("avx2")))
+void wireCoordinatesAvx2(const Coeffs& c, const double* ys, const double* zs, size_t n, double* out) {
+  size_t i = 0;
+  for ( ; i+8<=n; i+=8 ) {
+    __m256 w = coord8(c, load8(ys + i), load8(zs + i));
+    _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm256_castps256_ps128(w)));
+    _mm256_storeu_pd(out + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(w, 1)));
+  }
+  wireCoordinatesScalar(c, ys + i, zs + i, n - i, out + i);
+}
+
+__attribute__((target("avx2")))
+void nearestWiresAvx2(const Coeffs& c, const double* ys, const double* zs, size_t n, WireNumber* out) {
+  const __m256 ymin = _mm256_set1_ps(c.ymin);
+  const __m256 ymax = _mm256_set1_ps(c.ymax);
+  const __m256 zmin = _mm256_set1_ps(c.zmin);
+  const __m256 zmax = _mm256_set1_ps(c.zmax);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256i imax = _mm256_set1_epi32(c.iwirMax);
+  const __m256i izero = _mm256_setzero_si256();
+  size_t i = 0;
+  for ( ; i+8<=n; i+=8 ) {
+    // Same operand order as the scalar std::max(lo, std::min(hi, v)).
+    __m256 y = _mm256_max_ps(ymin, _mm256_min_ps(ymax, load8(ys + i)));
+    __m256 z = _mm256_max_ps(zmin, _mm256_min_ps(zmax, load8(zs + i)));
+    __m256i iwir = _mm256_cvttps_epi32(_mm256_add_ps(half, coord8(c, y, z)));
+    iwir = _mm256_max_epi32(izero, _mm256_min_epi32(imax, iwir));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), iwir);
+  }
+  nearestWiresScalar(c, ys + i, zs + i, n - i, out + i);
+}
+
+bool cpuHasAvx2() {
+  static const bool has = __builtin_cpu_supports("avx2");
+  return has;
+}
+
+#endif
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+WirePlaneProjection::
+WirePlaneProjection(double y0, double z0, double ycoef, double zcoef,
+                    double ymin, double ymax, double zmin, double zmax,
+                    WireNumber nwires)
+: m_y0(y0), m_z0(z0), m_ycoef(ycoef), m_zcoef(zcoef),
+  m_ymin(ymin), m_ymax(ymax), m_zmin(zmin), m_zmax(zmax),
+  m_nwires(nwires), m_useSimd(simdAvailable()) { }
+
+//**********************************************************************
+
+void WirePlaneProjection::
+wireCoordinates(const double* ypos, const double* zpos, std::size_t n, double* wirecoords) const {
+  Coeffs c{m_y0, m_z0, m_ycoef, m_zcoef, m_ymin, m_ymax, m_zmin, m_zmax, int(m_nwires) - 1};
+#ifdef WIREPROJ_AVX2
+  if ( m_useSimd ) return wireCoordinatesAvx2(c, ypos, zpos, n, wirecoords);
+#endif
+  wireCoordinatesScalar(c, ypos, zpos, n, wirecoords);
+}
+
+//**********************************************************************
+
+void WirePlaneProjection::
+nearestWires(const double* ypos, const double* zpos, std::size_t n, WireNumber* wires) const {
+  // An empty plane has no nearest wire; follow the scalar NearestWireID and give 0.
+  Coeffs c{m_y0, m_z0, m_ycoef, m_zcoef, m_ymin, m_ymax, m_zmin, m_zmax, std::max(int(m_nwires) - 1, 0)};
+#ifdef WIREPROJ_AVX2
+  if ( m_useSimd ) return nearestWiresAvx2(c, ypos, zpos, n, wires);
+#endif
+  nearestWiresScalar(c, ypos, zpos, n, wires);
+}
+
+//**********************************************************************
+
+void WirePlaneProjection::setUseSimd(bool val) {
+  m_useSimd = val && simdAvailable();
+}
+
+//**********************************************************************
+
+bool WirePlaneProjection::simdAvailable() {
+#ifdef WIREPROJ_AVX2
+  return cpuHasAvx2();
+#else
+  return false;
+#endif
+}
+
+//**********************************************************************
@@ -190,10 +190,24 @@ const WireSelector::WireSummary& WireSelector::fillWireSummary() {
 
 //**********************************************************************
 
+const WireBoxIndex& WireSelector::fillWireIndex() {
+  if ( haveData() && m_wireIndex.size() == m_data.size() ) return m_wireIndex;
+  WireBoxIndex::BoxVector boxes;
+  boxes.reserve(fillData().size());
+  for ( const WireInfo& dat : data() ) {
+    boxes.push_back(WireBoxIndex::Box{dat.x1(), dat.x2(), dat.y1(), dat.y2(), dat.z1(), dat.z2()});
+  }
+  m_wireIndex.build(boxes);
+  return m_wireIndex;
+}
+
+//**********************************************************************
+
 void WireSelector::clearData() {
   m_data.clear();
   m_datamap.clear();
   m_wireSummary.clear();
+  m_wireIndex.clear();
   m_haveData = false;
 }
 
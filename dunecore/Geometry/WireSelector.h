@@ -14,11 +14,17 @@
 //   auto rng = sel.dataMap().equal_range(icha);
 //   for ( auto ient=rng.first; ient!=rng.secon; ++ient) {
 //     const WireSelector::WireInfo& win = *(ient->second);
+//
+// To select the wires in a region without scanning all of them, use the spatial
+// index (see WireBoxIndex), which returns indices in data():
+//   for ( Index iwir : sel.fillWireIndex().overlapping(x1, x2, y1, y2, z1, z2) ) {
+//     const WireSelector::WireInfo& win = sel.data()[iwir];
 
 #ifndef WireSelector_H
 #define WireSelector_H
 
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "dunecore/Geometry/WireBoxIndex.h"
 #include <vector>
 #include <map>
 
@@ -127,6 +133,7 @@ public:
   const WireInfoVector& data() const { return m_data; }
   const WireInfoMap& dataMap() const { return m_datamap; }
   const WireSummary& wireSummary() const { return m_wireSummary; }
+  const WireBoxIndex& wireIndex() const { return m_wireIndex; }
 
   // Non-const methods.
 
@@ -168,6 +175,9 @@ public:
   // Returns the wire summary data after building if needed.
   const WireSummary& fillWireSummary();
 
+  // Returns the spatial index for the wire data after building it if needed.
+  const WireBoxIndex& fillWireIndex();
+
   // Clear the wire data.
   void clearData();
 
@@ -186,6 +196,7 @@ private:
   WireInfoVector m_data;
   WireInfoMap m_datamap;
   WireSummary m_wireSummary;
+  WireBoxIndex m_wireIndex;
 
 };
 
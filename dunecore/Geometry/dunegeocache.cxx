@@ -0,0 +1,89 @@
+// dunegeocache.cxx
+//
+// Executable that makes or finds the GdmlGeometryCache files for GDML geometry files.
+// Names that are not found as given are looked up in FW_SEARCH_PATH. The name of
+// each cache file is written to stdout, e.g. for use as the Geometry service ROOT
+// file.
+
+#include "dunecore/Geometry/GdmlGeometryCache.h"
+#include "cetlib/search_path.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <sys/stat.h>
+
+using std::string;
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::vector;
+using geo::GdmlGeometryCache;
+
+namespace {
+
+int help(string prog) {
+  cout << "Usage: " << prog << " [-d DIR] [-f] [-v] FILE [FILE ...]" << endl;
+  cout << "  Writes the name of the ROOT geometry cache file for each GDML FILE," << endl;
+  cout << "  making the cache file if it does not already exist." << endl;
+  cout << "  -d - Cache directory DIR [$DUNE_GEOMETRY_CACHE or /tmp]" << endl;
+  cout << "       Blank means the directory of each GDML file, e.g. to ship the cache." << endl;
+  cout << "  -f - Remake a cache file in DIR even if one exists." << endl;
+  cout << "  -v - Report lookups." << endl;
+  return 0;
+}
+
+}  // end unnamed namespace
+
+int main(int argc, char** argv) {
+  const string myname = "dunegeocache: ";
+  string prog = argv[0];
+  string dir = GdmlGeometryCache::defaultDirectory();
+  bool force = false;
+  int logLevel = 1;
+  vector<string> names;
+  for ( int iarg=1; iarg<argc; ++iarg ) {
+    string sarg = argv[iarg];
+    if ( sarg == "-h" ) return help(prog);
+    if ( sarg == "-f" ) {
+      force = true;
+    } else if ( sarg == "-v" ) {
+      logLevel = 2;
+    } else if ( sarg == "-d" ) {
+      if ( iarg + 1 >= argc ) {
+        cerr << myname << "ERROR: Option -d requires a value." << endl;
+        return 1;
+      }
+      dir = argv[++iarg];
+    } else if ( sarg.size() > 1 && sarg[0] == '-' ) {
+      cerr << myname << "ERROR: Invalid option: " << sarg << endl;
+      return 1;
+    } else {
+      names.push_back(sarg);
+    }
+  }
+  if ( names.empty() ) return help(prog);
+  // Messages go to stderr so that stdout has only the file names.
+  std::streambuf* pcoutbuf = cout.rdbuf(cerr.rdbuf());
+  GdmlGeometryCache cache(dir, logLevel);
+  vector<string> fnames;
+  int nerr = 0;
+  for ( string name : names ) {
+    struct stat sbuf;
+    if ( ::stat(name.c_str(), &sbuf) != 0 && std::getenv("FW_SEARCH_PATH") != nullptr ) {
+      string path;
+      cet::search_path sp("FW_SEARCH_PATH");
+      if ( sp.find_file(name, path) ) name = path;
+    }
+    string fname = force ? "" : cache.find(name);
+    if ( fname.empty() && cache.make(name, fname) ) {
+      cerr << myname << "ERROR: No cache for " << name << endl;
+      ++nerr;
+      continue;
+    }
+    fnames.push_back(fname);
+  }
+  cout.rdbuf(pcoutbuf);
+  for ( const string& fname : fnames ) cout << fname << endl;
+  return nerr ? 2 : 0;
+}
@@ -0,0 +1,228 @@
+// bench_GeometryDune.cxx
+//
+// Microbenchmark for the channel-mapping calls of the DUNE geometries.
+//
+// For each geometry the Geometry service is loaded as in test_GeometryDune and
+// the calls
+//   ChannelToWire, PlaneWireToChannel, NearestWireID, WireCoordinate, SignalType
+// are timed over all channels (or wires or plane positions). The time and the number
+// of heap allocations per call are reported so that regressions can be caught by
+// comparing with a previous release. If DUNE_BENCH_DB is set, the median and spread
+// of the time per call over the passes are added to that BenchmarkDB file for
+// comparison with benchcompare.
+//
+// Usage: bench_GeometryDune [GEO] [NREP]
+//   GEO = 35t, protodune, 10kt, vdcrp, coldbox or all [all]
+//   NREP = number of passes over the channels for each call [3]
+//
+// This is not run by ctest.
+
+#undef NDEBUG
+
+#include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/Exceptions.h"
+#include "dunecore/ArtSupport/ArtServiceHelper.h"
+#include "dunecore/DuneCommon/Utility/BenchmarkDB.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::setw;
+using std::vector;
+using geo::PlaneID;
+using geo::WireID;
+
+typedef unsigned int Index;
+
+//**********************************************************************
+
+// Count the heap allocations made by the timed calls.
+
+namespace {
+std::atomic<unsigned long> nalloc{0};
+}
+
+void* operator new(std::size_t nbyte) {
+  ++nalloc;
+  if ( void* ptr = std::malloc(nbyte == 0 ? 1 : nbyte) ) return ptr;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t nbyte) {
+  ++nalloc;
+  if ( void* ptr = std::malloc(nbyte == 0 ? 1 : nbyte) ) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+//**********************************************************************
+
+namespace {
+
+// Keeps the results of the timed calls live.
+volatile double sink = 0.0;
+
+// Times nrep passes of ncall calls each made by fun() and prints ns/call and
+// allocations/call. The time per call of each pass is recorded in the benchmark
+// database as kernel "gname name".
+template<class F>
+void timeit(string gname, string name, Index nrep, Index ncall, F fun) {
+  vector<double> nsPerCall;
+  nsPerCall.reserve(nrep);
+  double fcall = ncall > 0 ? ncall : 1;
+  unsigned long nalloc0 = nalloc;
+  double dt = 0.0;
+  double sum = 0.0;
+  for ( Index irep=0; irep<nrep; ++irep ) {
+    auto t0 = std::chrono::steady_clock::now();
+    sum += fun();
+    auto t1 = std::chrono::steady_clock::now();
+    double dtrep = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    nsPerCall.push_back(dtrep/fcall);
+    dt += dtrep;
+  }
+  unsigned long nall = nalloc - nalloc0;
+  sink = sink + sum;
+  double ftot = nrep > 0 ? nrep*fcall : 1;
+  cout << "  " << std::left << setw(20) << name << std::right
+       << setw(10) << nrep*ncall << " calls"
+       << std::fixed << std::setprecision(1)
+       << setw(10) << dt/ftot << " ns/call"
+       << std::setprecision(3)
+       << setw(10) << nall/ftot << " allocs/call" << endl;
+  cout.unsetf(std::ios::floatfield);
+  BenchmarkDB::record("bench_GeometryDune " + gname + " " + name, "time", "ns/call", false, nsPerCall);
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int bench_GeometryDune(string gname, Index nrep) {
+  const string myname = "bench_GeometryDune: ";
+  string line = "-----------------------------";
+  cout << myname << line << endl;
+  cout << myname << "Geometry: " << gname << endl;
+  std::stringstream config;
+  config << "#include \"geometry_dune.fcl\"" << endl;
+  config << "services.Geometry:                   @local::" << gname << endl;
+  config << "services.ExptGeoHelperInterface:     @local::dune_geometry_helper" << endl;
+  ArtServiceHelper::load_services(config);
+  art::ServiceHandle<geo::Geometry> pgeo;
+  Index ncha = pgeo->Nchannels();
+  cout << myname << "Channel count: " << ncha << endl;
+
+  // Collect the wires and, for each plane, points spread along the wire coordinate.
+  vector<WireID> wids;
+  vector<PlaneID> plaids;
+  vector<geo::Point_t> pts;
+  for ( auto const& gpla : pgeo->Iterate<geo::PlaneGeo>() ) {
+    PlaneID plaid = gpla.ID();
+    for ( auto const& wid : pgeo->Iterate<geo::WireID>(plaid) ) wids.push_back(wid);
+    Index nwir = gpla.Nwires();
+    for ( Index iwir=0; iwir<nwir; iwir+=7 ) {
+      plaids.push_back(plaid);
+      pts.push_back(gpla.Wire(iwir).GetCenter());
+    }
+  }
+  Index nwid = wids.size();
+  Index npt = pts.size();
+
+  timeit(gname, "ChannelToWire", nrep, ncha, [&]() {
+    double sum = 0.0;
+    for ( Index icha=0; icha<ncha; ++icha ) sum += pgeo->ChannelToWire(icha).size();
+    return sum;
+  });
+
+  timeit(gname, "PlaneWireToChannel", nrep, nwid, [&]() {
+    double sum = 0.0;
+    for ( const WireID& wid : wids ) sum += pgeo->PlaneWireToChannel(wid);
+    return sum;
+  });
+
+  timeit(gname, "NearestWireID", nrep, npt, [&]() {
+    double sum = 0.0;
+    for ( Index ipt=0; ipt<npt; ++ipt ) {
+      WireID wid;
+      try { wid = pgeo->NearestWireID(pts[ipt], plaids[ipt]); }
+      catch (geo::InvalidWireError const& e) {
+        if ( e.hasSuggestedWire() ) wid = e.suggestedWireID();
+      }
+      sum += wid.Wire;
+    }
+    return sum;
+  });
+
+  timeit(gname, "WireCoordinate", nrep, npt, [&]() {
+    double sum = 0.0;
+    for ( Index ipt=0; ipt<npt; ++ipt ) sum += pgeo->WireCoordinate(pts[ipt], plaids[ipt]);
+    return sum;
+  });
+
+  timeit(gname, "SignalType", nrep, ncha, [&]() {
+    double sum = 0.0;
+    for ( Index icha=0; icha<ncha; ++icha ) sum += pgeo->SignalType(icha);
+    return sum;
+  });
+
+  return 0;
+}
+
+//**********************************************************************
+
+int main(int argc, const char* argv[]) {
+  string sgeo = "all";
+  Index nrep = 3;
+  if ( argc > 1 ) {
+    sgeo = argv[1];
+    if ( sgeo == "-h" ) {
+      cout << argv[0] << ": [GEO] [NREP]" << endl;
+      cout << "  GEO: 35t, protodune, 10kt, vdcrp, coldbox or all [all]" << endl;
+      cout << "  NREP: Number of passes over the channels for each call [3]" << endl;
+      return 0;
+    }
+  }
+  if ( argc > 2 ) {
+    std::istringstream ssarg(argv[2]);
+    ssarg >> nrep;
+  }
+  // The service helper may be loaded only once per process, so a single
+  // geometry is benchmarked in each job and "all" runs each in a separate job.
+  vector<std::pair<string, string>> geos = {
+    {"35t",       "dune35t_geo"},
+    {"protodune", "protodune_geo"},
+    {"10kt",      "dune10kt_workspace_geo"},
+    {"vdcrp",     "dunevd10kt_1x8x14_3view_v2_geo"},
+    {"coldbox",   "dunecrpcb_geo"}
+  };
+  for ( const auto& geo : geos ) {
+    if ( sgeo == geo.first ) return bench_GeometryDune(geo.second, nrep);
+  }
+  if ( sgeo == "all" ) {
+    string cmd = argv[0];
+    int rstat = 0;
+    for ( const auto& geo : geos ) {
+      string gcmd = cmd + " " + geo.first + " " + std::to_string(nrep);
+      if ( std::system(gcmd.c_str()) != 0 ) rstat = 1;
+    }
+    return rstat;
+  }
+  cout << argv[0] << ": Invalid geometry: " << sgeo << endl;
+  return 1;
+}
+
+//**********************************************************************
@@ -0,0 +1,109 @@
+// test_AnalyticWirePlane.cxx
+//
+// This is a test and demonstration for AnalyticWirePlane.
+// Wire end points are computed for an induction-like and a collection-like plane
+// and checked against the wire frame and the wire lines.
+
+#undef NDEBUG
+
+#include "../AnalyticWirePlane.h"
+#include <string>
+#include <iostream>
+#include <cmath>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using geo::AnalyticWirePlane;
+
+using Index = AnalyticWirePlane::Index;
+
+namespace {
+
+bool onFrame(double y, double z, double ymin, double ymax, double zmin, double zmax) {
+  const double tol = 1.0e-6;
+  bool inside = y > ymin - tol && y < ymax + tol && z > zmin - tol && z < zmax + tol;
+  bool edge = std::abs(y - ymin) < tol || std::abs(y - ymax) < tol ||
+              std::abs(z - zmin) < tol || std::abs(z - zmax) < tol;
+  return inside && edge;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_AnalyticWirePlane(double angle) {
+  const string myname = "test_AnalyticWirePlane: ";
+  cout << myname << "Starting test with wire angle " << angle << "." << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create the plane." << endl;
+  // Frame and pitch similar to an FD APA.
+  const double x = 12.5;
+  const double ymin = -598.4;
+  const double ymax = 598.4;
+  const double zmin = 0.3;
+  const double zmax = 231.0;
+  const double pitch = 0.48;
+  const double dy = std::cos(angle);
+  const double dz = std::sin(angle);
+  // Wire 0 starts at the low-z, low-y corner region; successive wires step in z.
+  const double zstep = std::abs(dy) > 1.0e-9 ? pitch/std::abs(dy) : pitch;
+  const double z0 = zmin + 0.5*zstep;
+  const double y0 = 0.0;
+  const Index nwires = Index((zmax - zmin)/zstep);
+  AnalyticWirePlane plane(x, y0, z0, dy, dz, y0, z0 + zstep, nwires, ymin, ymax, zmin, zmax);
+  assert( plane.nwires() == nwires );
+  cout << myname << "Wire count: " << nwires << endl;
+
+  cout << myname << line << endl;
+  cout << myname << "Check the wire end points." << endl;
+  for ( Index iwir=0; iwir<nwires; ++iwir ) {
+    AnalyticWirePlane::Segment seg = plane.computeEndpoints(iwir);
+    assert( seg.x == x );
+    assert( onFrame(seg.y1, seg.z1, ymin, ymax, zmin, zmax) );
+    assert( onFrame(seg.y2, seg.z2, ymin, ymax, zmin, zmax) );
+    // Both ends are on the line through the wire center along the wire direction.
+    double zc = z0 + iwir*zstep;
+    assert( std::abs((seg.y1 - y0)*dz - (seg.z1 - zc)*dy) < 1.0e-6 );
+    assert( std::abs((seg.y2 - y0)*dz - (seg.z2 - zc)*dy) < 1.0e-6 );
+    // Wires parallel to y span the full frame height.
+    if ( dz == 0.0 ) assert( std::abs(std::abs(seg.y2 - seg.y1) - (ymax - ymin)) < 1.0e-6 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check the cache." << endl;
+  for ( Index iwir=0; iwir<nwires; ++iwir ) {
+    AnalyticWirePlane::Segment seg = plane.computeEndpoints(iwir);
+    const AnalyticWirePlane::Segment& cseg = plane.endpoints(iwir);
+    assert( cseg.y1 == seg.y1 && cseg.z1 == seg.z1 );
+    assert( cseg.y2 == seg.y2 && cseg.z2 == seg.z2 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check move." << endl;
+  AnalyticWirePlane moved(std::move(plane));
+  assert( moved.nwires() == nwires );
+  assert( moved.endpoints(nwires-1).z1 == moved.computeEndpoints(nwires-1).z1 );
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  int nerr = 0;
+  nerr += test_AnalyticWirePlane(0.0);
+  nerr += test_AnalyticWirePlane(0.62700);
+  nerr += test_AnalyticWirePlane(-0.62700);
+  return nerr;
+}
+
+//**********************************************************************
@@ -0,0 +1,120 @@
+// test_ChannelGeoTable.cxx
+//
+// Test ChannelGeoTable by comparing its entries with those from ChannelGeo
+// for the ProtoDUNE geometry.
+
+#undef NDEBUG
+
+#include "dunecore/Geometry/ChannelGeoTable.h"
+#include "dunecore/Geometry/ChannelGeo.h"
+#include "dunecore/ArtSupport/ArtServiceHelper.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "larcore/Geometry/Geometry.h"
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using Index = ChannelGeoTable::Index;
+
+namespace {
+
+bool samePoint(const ChannelGeoTable::Point& lhs, const ChannelGeoTable::Point& rhs) {
+  return lhs.x() == rhs.x() && lhs.y() == rhs.y() && lhs.z() == rhs.z();
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_ChannelGeoTable(string gname, Index nskip) {
+  const string myname = "test_ChannelGeoTable: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Load geometry " << gname << endl;
+  std::stringstream config;
+  config << "#include \"geometry_dune.fcl\"" << endl;
+  config << "services.Geometry:                   @local::" + gname << endl;
+  config << "services.ExptGeoHelperInterface:     @local::dune_geometry_helper" << endl;
+  ArtServiceHelper::load_services(config);
+  const geo::GeometryCore* pgeo = &*art::ServiceHandle<geo::Geometry>();
+  Index ncha = pgeo->Nchannels();
+  cout << myname << "  # channels: " << ncha << endl;
+
+  cout << myname << line << endl;
+  cout << myname << "Fetch table." << endl;
+  ChannelGeoTable::TablePtr ptab = ChannelGeoTable::instance(pgeo);
+  assert( ptab != nullptr );
+  assert( ptab->size() == ncha );
+  assert( ptab->kind() == ChannelGeoTable::Standard );
+  assert( ChannelGeoTable::instance() == ptab );
+  assert( ChannelGeoTable::instance(nullptr) == nullptr );
+  cout << myname << "  # wire segments: " << ptab->allWires().size() << endl;
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with ChannelGeo for every " << nskip << " channels." << endl;
+  Index nchk = 0;
+  for ( Index icha=0; icha<ncha; icha += nskip ) {
+    ChannelGeo cgeo(icha, pgeo);
+    assert( ptab->isValid(icha) == cgeo.isValid() );
+    assert( ptab->nWires(icha) == cgeo.nWires() );
+    ChannelGeoTable::EndPointsSpan wires = ptab->wires(icha);
+    assert( wires.size() == cgeo.nWires() );
+    Index iwir = 0;
+    for ( const ChannelGeoTable::EndPoints& ends : wires ) {
+      assert( samePoint(ends.first, cgeo.wires()[iwir].first) );
+      assert( samePoint(ends.second, cgeo.wires()[iwir].second) );
+      ++iwir;
+    }
+    if ( cgeo.isValid() ) {
+      assert( samePoint(ptab->top(icha), cgeo.top()) );
+      assert( samePoint(ptab->bottom(icha), cgeo.bottom()) );
+    }
+    ++nchk;
+  }
+  cout << myname << "  Checked " << nchk << " channels." << endl;
+  assert( ! ptab->isValid(ncha) );
+  assert( ptab->nWires(ncha) == 0 );
+  assert( ptab->wires(ncha).size() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Clear registry." << endl;
+  ChannelGeoTable::clear();
+  ChannelGeoTable::TablePtr ptab2 = ChannelGeoTable::instance(pgeo);
+  assert( ptab2 != ptab );
+  assert( ptab2->size() == ptab->size() );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main(int argc, char* argv[]) {
+  string gname = "protodune_geo";
+  Index nskip = 37;
+  if ( argc > 1 ) {
+    string sarg = argv[1];
+    if ( sarg == "-h" ) {
+      cout << "Usage: " << argv[0] << " [gname] [nskip]" << endl;
+      cout << "  gname: Geometry name, e.g. protodune_geo" << endl;
+      cout << "  nskip: Channel step for the comparison with ChannelGeo" << endl;
+      return 0;
+    }
+    gname = sarg;
+    if ( argc > 2 ) nskip = std::stoi(argv[2]);
+  }
+  if ( nskip == 0 ) nskip = 1;
+  return test_ChannelGeoTable(gname, nskip);
+}
+
+//**********************************************************************
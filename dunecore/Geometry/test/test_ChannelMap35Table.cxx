@@ -0,0 +1,136 @@
+// test_ChannelMap35Table.cxx
+//
+// Test ChannelMap35Table with a small 35t-like layout: one cryostat with two
+// APAs and three planes. The channel-to-wire table is compared with the
+// per-channel calculation previously used in ChannelMap35Alg.
+
+#undef NDEBUG
+
+#include "dunecore/Geometry/ChannelMap35Table.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using geo::ChannelMap35Table;
+using geo::PlaneID;
+using geo::WireID;
+using Index = ChannelMap35Table::Index;
+
+//**********************************************************************
+
+int test_ChannelMap35Table() {
+  const string myname = "test_ChannelMap35Table: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Build table." << endl;
+  const Index napa = 2;
+  const Index npla = 3;
+  const Index nanc[npla] = {37, 40, 112};
+  const Index nwir[npla] = {144, 148, 112};
+  ChannelMap35Table tab;
+  tab.reset({2*napa}, npla);
+  Index first[napa][npla];
+  Index ncha = 0;
+  for ( Index iapa=0; iapa<napa; ++iapa ) {
+    for ( Index ipla=0; ipla<npla; ++ipla ) {
+      first[iapa][ipla] = ncha;
+      tab.setApaPlane(0, iapa, ipla, ncha, nanc[ipla], nwir[ipla]);
+      ncha += 2*nanc[ipla];
+    }
+  }
+  tab.buildChannelToWire(ncha);
+  cout << myname << "  # channels: " << tab.size() << endl;
+  assert( tab.size() == ncha );
+  assert( tab.hasPlane(PlaneID(0, 3, 2)) );
+  assert( ! tab.hasPlane(PlaneID(0, 4, 0)) );
+
+  cout << myname << line << endl;
+  cout << myname << "Compare channel-to-wire with the per-channel calculation." << endl;
+  Index nwirTot = 0;
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    Index iapa = 0;
+    Index ipla = 0;
+    bool found = false;
+    for ( iapa=0; iapa<napa; ++iapa ) {
+      for ( ipla=0; ipla<npla; ++ipla ) {
+        if ( icha < first[iapa][ipla] + 2*nanc[ipla] ) {
+          found = true;
+          break;
+        }
+      }
+      if ( found ) break;
+    }
+    assert( found );
+    Index ichaPla = icha - first[iapa][ipla];
+    Index group = ichaPla/nanc[ipla];
+    Index bottom = ichaPla - group*nanc[ipla];
+    Index itpc = 2*iapa;
+    int dir = 1;
+    if ( group%2 == 1 ) {
+      itpc += 1;
+      dir = -1;
+    }
+    vector<WireID> expWires;
+    for ( Index iseg=0; iseg<50; ++iseg ) {
+      expWires.emplace_back(0, itpc + dir*int(iseg%2), ipla, bottom + iseg*nanc[ipla]);
+      if ( bottom + (iseg+1)*nanc[ipla] > nwir[ipla] - 1 ) break;
+    }
+    ChannelMap35Table::WireIDSpan wires = tab.channelToWire(icha);
+    assert( wires.size() == expWires.size() );
+    Index iwir = 0;
+    for ( const WireID& wid : wires ) {
+      assert( wid == expWires[iwir] );
+      assert( tab.planeWireToChannel(wid) == icha );
+      ++iwir;
+    }
+    nwirTot += wires.size();
+  }
+  cout << myname << "  # wire segments: " << nwirTot << endl;
+
+  cout << myname << line << endl;
+  cout << myname << "Check wire coordinates." << endl;
+  const double pi = acos(-1.0);
+  double theta = 0.25*pi;
+  double pitch = 0.5;
+  for ( Index itpc=0; itpc<2*napa; ++itpc ) {
+    PlaneID pid(0, itpc, 0);
+    tab.setWireCoordinate(pid, 10.0, 20.0, sin(theta), cos(theta), pitch, -1.0);
+    double sgn = itpc%2 ? -1.0 : 1.0;
+    for ( double y : {-5.0, 0.0, 12.5} ) {
+      for ( double z : {3.0, 20.0, 41.0} ) {
+        float dist = -(y - 10.0)*sgn*cos(theta) + (z - 20.0)*sin(theta);
+        double expCoord = -1.0*dist/pitch;
+        assert( tab.wireCoordinate(y, z, pid) == expCoord );
+      }
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Clear table." << endl;
+  tab.clear();
+  assert( tab.size() == 0 );
+  assert( ! tab.hasChannel(0) );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_ChannelMap35Table();
+}
+
+//**********************************************************************
@@ -0,0 +1,111 @@
+// test_GdmlGeometryCache.cxx
+//
+// This is a test and demonstration for GdmlGeometryCache.
+// A small GDML file is cached, the cache is found again and imported, and
+// editing the GDML changes the key.
+
+#undef NDEBUG
+
+#include "../GdmlGeometryCache.h"
+#include "TGeoManager.h"
+#include "TGeoVolume.h"
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using geo::GdmlGeometryCache;
+
+namespace {
+
+void writeGdml(string fname, string worldSize) {
+  std::ofstream fout(fname);
+  fout << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+       << "<gdml xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\""
+       << " xsi:noNamespaceSchemaLocation=\"GDMLSchema/gdml.xsd\">\n"
+       << "<define/>\n"
+       << "<materials>\n"
+       << "  <material name=\"Vacuum\" Z=\"1.0\"><D value=\"1.e-25\"/><atom value=\"1.00794\"/></material>\n"
+       << "</materials>\n"
+       << "<solids>\n"
+       << "  <box name=\"WorldBox\" x=\"" << worldSize << "\" y=\"100\" z=\"100\" lunit=\"cm\"/>\n"
+       << "</solids>\n"
+       << "<structure>\n"
+       << "  <volume name=\"volWorld\"><materialref ref=\"Vacuum\"/><solidref ref=\"WorldBox\"/></volume>\n"
+       << "</structure>\n"
+       << "<setup name=\"Default\" version=\"1.0\"><world ref=\"volWorld\"/></setup>\n"
+       << "</gdml>\n";
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_GdmlGeometryCache() {
+  const string myname = "test_GdmlGeometryCache: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  string gdmlfile = "test_GdmlGeometryCache.gdml";
+
+  cout << myname << line << endl;
+  cout << myname << "Check the key and names." << endl;
+  writeGdml(gdmlfile, "100");
+  assert( GdmlGeometryCache::key("nosuchfile.gdml") == 0 );
+  GdmlGeometryCache::Key key = GdmlGeometryCache::key(gdmlfile);
+  assert( key != 0 );
+  assert( GdmlGeometryCache::key(gdmlfile) == key );
+  string cname = GdmlGeometryCache::cacheFileName(gdmlfile, key, ".");
+  cout << myname << "Cache file: " << cname << endl;
+  assert( cname.find("./test_GdmlGeometryCache_") == 0 );
+  assert( cname.size() == 2 + 23 + 16 + 5 );
+  assert( cname.substr(cname.size() - 5) == ".root" );
+  assert( GdmlGeometryCache::cacheFileName("/a/b/geo.gdml", 1, "") == "/a/b/geo_0000000000000001.root" );
+  assert( GdmlGeometryCache::cacheFileName("/a/b/geo.gdml", 1, "/c") == "/c/geo_0000000000000001.root" );
+  std::remove(cname.c_str());
+
+  cout << myname << line << endl;
+  cout << myname << "Make the cache." << endl;
+  GdmlGeometryCache cache(".", 2);
+  assert( cache.directory() == "." );
+  assert( cache.find(gdmlfile).empty() );
+  assert( cache.get("nosuchfile.gdml") == "nosuchfile.gdml" );
+  string fname = cache.get(gdmlfile);
+  assert( fname == cname );
+  assert( cache.find(gdmlfile) == cname );
+  assert( cache.get(gdmlfile) == cname );
+
+  cout << myname << line << endl;
+  cout << myname << "Import the cache." << endl;
+  TGeoManager* pgeo = TGeoManager::Import(fname.c_str());
+  assert( pgeo != nullptr );
+  assert( pgeo->GetTopVolume() != nullptr );
+  assert( string(pgeo->GetTopVolume()->GetName()) == "volWorld" );
+  delete pgeo;
+
+  cout << myname << line << endl;
+  cout << myname << "Edit the GDML." << endl;
+  writeGdml(gdmlfile, "200");
+  assert( GdmlGeometryCache::key(gdmlfile) != key );
+  assert( cache.find(gdmlfile).empty() );
+
+  std::remove(cname.c_str());
+  std::remove(gdmlfile.c_str());
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_GdmlGeometryCache();
+}
+
+//**********************************************************************
@@ -0,0 +1,123 @@
+// test_GeometrySnapshot.cxx
+//
+// This is a test and demonstration for GeometrySnapshot.
+// Sections are written to a file, mapped back and compared. Files with a bad key,
+// a damaged body or a wrong element size are rejected.
+
+#undef NDEBUG
+
+#include "../GeometrySnapshot.h"
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using geo::GeometrySnapshot;
+
+using Index = unsigned int;
+
+namespace {
+
+struct Rec {
+  bool valid;
+  unsigned int cry;
+  unsigned int tpc;
+  unsigned int pla;
+  unsigned int wir;
+};
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_GeometrySnapshot() {
+  const string myname = "test_GeometrySnapshot: ";
+  cout << myname << "Starting test." << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  const string fname = "test_GeometrySnapshot.dat";
+  const std::uint64_t key = GeometrySnapshot::hash(myname.data(), myname.size());
+
+  cout << myname << line << endl;
+  cout << myname << "Write snapshot." << endl;
+  vector<std::uint8_t> bytes = {3, 1, 4, 1, 5, 9, 2};
+  vector<size_t> offsets;
+  vector<Rec> recs;
+  for ( Index icha=0; icha<1000; ++icha ) {
+    offsets.push_back(recs.size());
+    for ( Index iwir=0; iwir<1+icha%3; ++iwir ) recs.push_back(Rec{true, 0, icha%2, icha%3, icha + iwir});
+  }
+  offsets.push_back(recs.size());
+  vector<GeometrySnapshot::Section> secs;
+  secs.push_back(GeometrySnapshot::section("Bytes", bytes.data(), bytes.size()));
+  secs.push_back(GeometrySnapshot::section("Offsets", offsets.data(), offsets.size()));
+  secs.push_back(GeometrySnapshot::section("Recs", recs.data(), recs.size()));
+  secs.push_back(GeometrySnapshot::section<float>("Empty", nullptr, 0));
+  assert( GeometrySnapshot::write(fname, key, secs) == 0 );
+  secs.push_back(GeometrySnapshot::section("ThisNameIsMuchTooLongForASection", bytes.data(), 1));
+  assert( GeometrySnapshot::write(fname + ".bad", key, secs) != 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Read snapshot." << endl;
+  GeometrySnapshot snap(fname);
+  assert( snap.isValid() );
+  assert( snap.key() == key );
+  assert( snap.has("Bytes") );
+  assert( snap.has("Empty") );
+  assert( ! snap.has("Missing") );
+  util::span<std::uint8_t const*> rbytes = snap.get<std::uint8_t>("Bytes");
+  assert( vector<std::uint8_t>(rbytes.begin(), rbytes.end()) == bytes );
+  util::span<size_t const*> roffsets = snap.get<size_t>("Offsets");
+  assert( vector<size_t>(roffsets.begin(), roffsets.end()) == offsets );
+  util::span<Rec const*> rrecs = snap.get<Rec>("Recs");
+  assert( rrecs.size() == recs.size() );
+  assert( reinterpret_cast<std::uintptr_t>(rrecs.begin())%64 == 0 );
+  for ( Index irec=0; irec<recs.size(); ++irec ) {
+    assert( rrecs.begin()[irec].tpc == recs[irec].tpc );
+    assert( rrecs.begin()[irec].wir == recs[irec].wir );
+  }
+  assert( snap.get<float>("Empty").empty() );
+  assert( snap.get<double>("Bytes").empty() );
+  assert( snap.get<int>("Missing").empty() );
+
+  cout << myname << line << endl;
+  cout << myname << "Move snapshot." << endl;
+  GeometrySnapshot snap2(std::move(snap));
+  assert( ! snap.isValid() );
+  assert( snap2.isValid() );
+  assert( snap2.get<Rec>("Recs").begin() == rrecs.begin() );
+  snap2.clear();
+  assert( ! snap2.isValid() );
+
+  cout << myname << line << endl;
+  cout << myname << "Damaged snapshot." << endl;
+  {
+    std::fstream fil(fname, std::ios::in | std::ios::out | std::ios::binary);
+    fil.seekp(-1, std::ios::end);
+    fil.put('x');
+  }
+  assert( ! GeometrySnapshot(fname).isValid() );
+  assert( ! GeometrySnapshot(fname + ".missing").isValid() );
+
+  std::remove(fname.c_str());
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_GeometrySnapshot();
+}
+
+//**********************************************************************
@@ -0,0 +1,114 @@
+// test_MuonCounter35Alg.cxx
+//
+// Test MuonCounter35Alg::CounterIndex by comparing its hits with those from
+// testTrackInAllCounters for random tracks through walls of synthetic counters.
+
+#undef NDEBUG
+
+#include "dunecore/Geometry/MuonCounter35Alg.h"
+#include <string>
+#include <iostream>
+#include <random>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using geo::MuonCounter35Alg;
+
+using Geometry = vector<vector<double>>;
+
+//**********************************************************************
+
+int test_MuonCounter35Alg(unsigned int ntrk) {
+  const string myname = "test_MuonCounter35Alg: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Build counter geometry." << endl;
+  // Two walls of 10x10 counters, one normal to z and one to x, with every
+  // seventh counter switched off.
+  Geometry geo;
+  for ( int iwal=0; iwal<2; ++iwal ) {
+    for ( int i1=0; i1<10; ++i1 ) {
+      for ( int i2=0; i2<10; ++i2 ) {
+        int id = geo.size();
+        double u1 = -100.0 + 20.0*i1;
+        double u2 = -100.0 + 20.0*i2;
+        double w = iwal == 0 ? -150.0 : 150.0;
+        vector<double> ctr = {double(id), double(id%7 == 0 ? 0 : 1)};
+        double us1[4] = {u1, u1 + 19.0, u1 + 19.0, u1};
+        double us2[4] = {u2, u2, u2 + 19.0, u2 + 19.0};
+        for ( int iver=0; iver<4; ++iver ) {
+          if ( iwal == 0 ) ctr.insert(ctr.end(), {us1[iver], us2[iver], w});
+          else ctr.insert(ctr.end(), {w, us1[iver], us2[iver]});
+        }
+        geo.push_back(ctr);
+      }
+    }
+  }
+  MuonCounter35Alg::CounterIndex idx(geo);
+  cout << myname << "  # counters: " << geo.size() << ", # indexed: " << idx.size() << endl;
+  assert( idx.size() == 171 );
+
+  cout << myname << line << endl;
+  cout << myname << "Test a track through the centre of counter 11." << endl;
+  {
+    Geometry hits;
+    int nhit = idx.testTrack(5, TVector3(-71.0, -71.0, 0.0), TVector3(0.0, 0.0, 1.0), hits);
+    assert( nhit == 1 );
+    assert( hits[0][0] == 11 );
+    assert( hits[0][2] == 5 );
+    assert( hits[0][5] == -150.0 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with testTrackInAllCounters for " << ntrk << " tracks." << endl;
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> posdist(-200.0, 200.0);
+  std::uniform_real_distribution<double> dirdist(-1.0, 1.0);
+  vector<int> ids;
+  vector<TVector3> pts;
+  vector<TVector3> dirs;
+  for ( unsigned int itrk=0; itrk<ntrk; ++itrk ) {
+    ids.push_back(itrk);
+    pts.emplace_back(posdist(gen), posdist(gen), posdist(gen));
+    dirs.emplace_back(dirdist(gen), dirdist(gen), dirdist(gen));
+  }
+  Geometry hitsAll;
+  for ( unsigned int itrk=0; itrk<ntrk; ++itrk ) {
+    MuonCounter35Alg::testTrackInAllCounters(ids[itrk], pts[itrk], dirs[itrk], geo, hitsAll);
+  }
+  Geometry hitsIdx;
+  int nhit = idx.testTracks(ids, pts, dirs, hitsIdx);
+  cout << myname << "  # hits: " << hitsAll.size() << endl;
+  assert( hitsAll.size() > 0 );
+  assert( nhit == int(hitsAll.size()) );
+  assert( hitsIdx == hitsAll );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main(int argc, char* argv[]) {
+  unsigned int ntrk = 10000;
+  if ( argc > 1 ) {
+    string sarg = argv[1];
+    if ( sarg == "-h" ) {
+      cout << "Usage: " << argv[0] << " [NTRK]" << endl;
+      return 0;
+    }
+    ntrk = std::stoi(sarg);
+  }
+  return test_MuonCounter35Alg(ntrk);
+}
+
+//**********************************************************************
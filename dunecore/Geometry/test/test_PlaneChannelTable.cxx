@@ -0,0 +1,153 @@
+// test_PlaneChannelTable.cxx
+//
+// Test PlaneChannelTable with a small vertical-drift-like layout: two cryostats
+// with different numbers of TPCs and planes. The first induction ROP of each
+// TPC holds two planes whose channel ranges overlap, as in ColdBoxChannelMapAlg.
+// The channel-to-wire and ROP lookups are compared with a search over the planes.
+
+#undef NDEBUG
+
+#include "dunecore/Geometry/PlaneChannelTable.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using geo::PlaneChannelTable;
+using geo::PlaneID;
+using geo::WireID;
+using readout::ROPID;
+using Index = PlaneChannelTable::Index;
+
+//**********************************************************************
+
+int test_PlaneChannelTable() {
+  const string myname = "test_PlaneChannelTable: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Build table." << endl;
+  // Planes 0 and 1 of each TPC make ROP 0, the other planes one ROP each.
+  const vector<vector<Index>> nplanes = {{4, 4}, {4}};
+  const Index nwir[4] = {30, 25, 40, 50};
+  const Index overlap = 5;
+  struct PlaneRange {
+    PlaneID pid;
+    Index first;
+    Index nwire;
+    ROPID rid;
+  };
+  vector<PlaneRange> ranges;
+  PlaneChannelTable tab;
+  tab.reset(nplanes);
+  Index ncha = 0;
+  Index nrop = 0;
+  for ( Index icry=0; icry<nplanes.size(); ++icry ) {
+    for ( Index itpc=0; itpc<nplanes[icry].size(); ++itpc ) {
+      Index ipla = 0;
+      for ( Index irop=0; ipla<nplanes[icry][itpc]; ++irop ) {
+        ROPID rid(icry, itpc, irop);
+        Index first = ncha;
+        vector<PlaneID> pids;
+        Index nplaRop = irop == 0 ? 2 : 1;
+        for ( Index iplaRop=0; iplaRop<nplaRop; ++iplaRop, ++ipla ) {
+          PlaneID pid(icry, itpc, ipla);
+          Index firstPla = iplaRop == 0 ? ncha : ncha - overlap;
+          tab.setPlane(pid, firstPla, nwir[ipla]);
+          tab.setWireCoordinate(pid, 0.5, -0.25, 2.0*ipla);
+          ranges.push_back({pid, firstPla, nwir[ipla], rid});
+          pids.push_back(pid);
+          ncha = firstPla + nwir[ipla];
+        }
+        tab.addROP(rid, first, ncha - first, pids);
+        ++nrop;
+      }
+    }
+  }
+  tab.setEndChannel(ncha);
+  cout << myname << "  # planes: " << tab.nPlane() << endl;
+  cout << myname << "    # ROPs: " << tab.nROP() << endl;
+  cout << myname << "# channels: " << tab.endChannel() << endl;
+  assert( tab.nPlane() == 12 );
+  assert( tab.nROP() == nrop );
+  assert( tab.endChannel() == ncha );
+  assert( tab.hasPlane(PlaneID(0, 1, 3)) );
+  assert( tab.hasPlane(PlaneID(1, 0, 3)) );
+  assert( ! tab.hasPlane(PlaneID(1, 1, 0)) );
+  assert( ! tab.hasPlane(PlaneID(0, 0, 4)) );
+  assert( ! tab.hasPlane(PlaneID(2, 0, 0)) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check planes and ROPs." << endl;
+  for ( const PlaneRange& ran : ranges ) {
+    assert( tab.planeFirstChannel(ran.pid) == ran.first );
+    assert( tab.nWires(ran.pid) == ran.nwire );
+    Index irop = tab.findROP(ran.rid);
+    assert( irop != PlaneChannelTable::npos );
+    assert( tab.ropID(irop) == ran.rid );
+    assert( tab.planeROP(ran.pid) == irop );
+    for ( Index iwir=0; iwir<ran.nwire; ++iwir ) {
+      assert( tab.planeWireToChannel(WireID(ran.pid, iwir)) == ran.first + iwir );
+    }
+    assert( tab.wireCoordinate(2.0, 4.0, ran.pid) == 2.0*0.5 - 4.0*0.25 - 2.0*ran.pid.Plane );
+  }
+  assert( tab.findROP(ROPID(0, 0, 3)) == PlaneChannelTable::npos );
+
+  cout << myname << line << endl;
+  cout << myname << "Compare channel-to-wire with the search over planes." << endl;
+  Index nwirTot = 0;
+  Index nmulti = 0;
+  vector<WireID> wids;
+  for ( Index icha=0; icha<ncha; ++icha ) {
+    vector<WireID> expWires;
+    for ( const PlaneRange& ran : ranges ) {
+      if ( icha >= ran.first && icha < ran.first + ran.nwire ) {
+        expWires.emplace_back(ran.pid, icha - ran.first);
+      }
+    }
+    assert( ! expWires.empty() );
+    Index irop = tab.channelToWire(icha, wids);
+    assert( irop != PlaneChannelTable::npos );
+    assert( tab.findROP(icha) == irop );
+    assert( icha >= tab.ropFirstChannel(irop) );
+    assert( icha < tab.ropFirstChannel(irop) + tab.ropNChannels(irop) );
+    assert( wids == expWires );
+    nwirTot += wids.size();
+    if ( wids.size() > 1 ) ++nmulti;
+  }
+  cout << myname << "          # wire segments: " << nwirTot << endl;
+  cout << myname << "  # channels with 2 wires: " << nmulti << endl;
+  assert( nmulti == 3*overlap );
+  assert( tab.channelToWire(ncha, wids) == PlaneChannelTable::npos );
+  assert( wids.empty() );
+  assert( tab.findROP(ncha) == PlaneChannelTable::npos );
+
+  cout << myname << line << endl;
+  cout << myname << "Clear table." << endl;
+  tab.clear();
+  assert( tab.nPlane() == 0 );
+  assert( tab.nROP() == 0 );
+  assert( tab.endChannel() == 0 );
+  assert( ! tab.hasPlane(PlaneID(0, 0, 0)) );
+  assert( tab.findROP(0) == PlaneChannelTable::npos );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_PlaneChannelTable();
+}
+
+//**********************************************************************
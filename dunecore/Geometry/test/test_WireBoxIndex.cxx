@@ -0,0 +1,123 @@
+// test_WireBoxIndex.cxx
+//
+// This is a test and demonstration for WireBoxIndex.
+// Random wire boxes are indexed and the selections are compared with scans
+// over all the boxes.
+
+#undef NDEBUG
+
+#include "../WireBoxIndex.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using Index = WireBoxIndex::Index;
+using IndexVector = WireBoxIndex::IndexVector;
+using Box = WireBoxIndex::Box;
+
+//**********************************************************************
+
+int test_WireBoxIndex(Index nwir) {
+  const string myname = "test_WireBoxIndex: ";
+  cout << myname << "Starting test with " << nwir << " wires." << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create wires." << endl;
+  // Planes of wires with two pitches, varying lengths and two drift volumes.
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> flat(0.0, 1.0);
+  WireBoxIndex::BoxVector boxes;
+  for ( Index iwir=0; iwir<nwir; ++iwir ) {
+    float pitch = iwir%2 ? 0.47 : 0.48;
+    float z = 0.48*iwir*(1.0 + 0.1*flat(gen));
+    float y = 600.0*(flat(gen) - 0.5);
+    float len = 1.0 + 600.0*flat(gen);
+    float x = iwir%3 ? 10.0 : -10.0;
+    float drift = iwir%3 ? 350.0 : -350.0;
+    boxes.push_back(Box{std::min(x, x + drift), std::max(x, x + drift),
+                        y - 0.5f*len, y + 0.5f*len, z - 0.5f*pitch, z + 0.5f*pitch});
+  }
+  WireBoxIndex idx;
+  idx.build(boxes);
+  assert( idx.size() == nwir );
+
+  cout << myname << line << endl;
+  cout << myname << "Compare selections with scans." << endl;
+  auto overlaps = [](float a1, float a2, float b1, float b2) { return a2 >= b1 && a1 <= b2; };
+  float zmax = 0.55*nwir;
+  for ( Index itry=0; itry<200; ++itry ) {
+    float za = zmax*flat(gen);
+    float zb = za + (itry%4 ? 5.0 : zmax)*flat(gen);
+    float ya = 700.0*(flat(gen) - 0.5);
+    float yb = ya + (itry%3 ? 10.0 : 600.0)*flat(gen);
+    float xa = 400.0*(flat(gen) - 0.5);
+    float xb = xa + 50.0*flat(gen);
+    IndexVector expReg, expZ, expY, expX;
+    for ( Index iwir=0; iwir<nwir; ++iwir ) {
+      const Box& box = boxes[iwir];
+      bool inz = overlaps(box.z1, box.z2, za, zb);
+      bool iny = overlaps(box.y1, box.y2, ya, yb);
+      bool inx = overlaps(box.x1, box.x2, xa, xb);
+      if ( inz ) expZ.push_back(iwir);
+      if ( iny ) expY.push_back(iwir);
+      if ( inx ) expX.push_back(iwir);
+      if ( inz && iny && inx ) expReg.push_back(iwir);
+    }
+    assert( idx.overlapping(xa, xb, ya, yb, za, zb) == expReg );
+    assert( idx.zRange(za, zb) == expZ );
+    assert( idx.yRange(ya, yb) == expY );
+    assert( idx.driftRange(xa, xb) == expX );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check nearest wires." << endl;
+  for ( Index itry=0; itry<200; ++itry ) {
+    float z = zmax*flat(gen);
+    float y = 700.0*(flat(gen) - 0.5);
+    Index iwir = idx.nearest(y, z);
+    float dbest = 1.e30;
+    for ( const Box& box : boxes ) {
+      if ( box.y1 <= y && y <= box.y2 ) dbest = std::min(dbest, std::abs(0.5f*(box.z1 + box.z2) - z));
+    }
+    if ( iwir == idx.size() ) {
+      assert( dbest == 1.e30f );
+      continue;
+    }
+    const Box& box = boxes[iwir];
+    assert( box.y1 <= y && y <= box.y2 );
+    assert( std::abs(0.5f*(box.z1 + box.z2) - z) == dbest );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check clear." << endl;
+  idx.clear();
+  assert( idx.empty() );
+  assert( idx.overlapping(-1.e9, 1.e9, -1.e9, 1.e9, -1.e9, 1.e9).empty() );
+  assert( idx.nearest(0.0, 0.0) == 0 );
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  int nerr = 0;
+  for ( Index nwir : {0, 1, 2, 17, 5000} ) nerr += test_WireBoxIndex(nwir);
+  return nerr;
+}
+
+//**********************************************************************
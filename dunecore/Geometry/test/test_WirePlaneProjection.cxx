@@ -0,0 +1,129 @@
+// test_WirePlaneProjection.cxx
+//
+// This is a test and demonstration for WirePlaneProjection.
+// Random points are projected with the scalar and vector paths and compared with
+// the double-precision formula used by the APA channel map algorithms.
+
+#undef NDEBUG
+
+#include "../WirePlaneProjection.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using geo::WirePlaneProjection;
+
+using Index = unsigned int;
+
+//**********************************************************************
+
+int test_WirePlaneProjection(bool useSimd, Index npt) {
+  const string myname = "test_WirePlaneProjection: ";
+  cout << myname << "Starting test with useSimd " << useSimd << " and " << npt << " points." << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Create projection for a u-like plane." << endl;
+  // Wire angle, pitch and extent similar to an FD APA induction plane.
+  const double y0 = -598.4;
+  const double z0 = 3.1;
+  const double theta = 0.623;
+  const double pitch = 0.4669;
+  const double ycoef = -std::cos(theta)/pitch;
+  const double zcoef = std::sin(theta)/pitch;
+  const double ymin = -600.0;
+  const double ymax = 600.0;
+  const double zmin = 0.0;
+  const double zmax = 230.0;
+  const Index nwires = 800;
+  WirePlaneProjection proj(y0, z0, ycoef, zcoef, ymin, ymax, zmin, zmax, nwires);
+  proj.setUseSimd(useSimd);
+  assert( proj.usesSimd() == (useSimd && WirePlaneProjection::simdAvailable()) );
+  assert( proj.nwires() == nwires );
+
+  cout << myname << line << endl;
+  cout << myname << "Create points, some outside the plane." << endl;
+  vector<double> ys(npt);
+  vector<double> zs(npt);
+  std::mt19937 gen(12345 + npt);
+  std::uniform_real_distribution<double> ydist(-700.0, 700.0);
+  std::uniform_real_distribution<double> zdist(-50.0, 280.0);
+  for ( Index ipt=0; ipt<npt; ++ipt ) {
+    ys[ipt] = ydist(gen);
+    zs[ipt] = zdist(gen);
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check wire coordinates." << endl;
+  vector<double> wcs(npt);
+  proj.wireCoordinates(ys.data(), zs.data(), npt, wcs.data());
+  double maxdiff = 0.0;
+  for ( Index ipt=0; ipt<npt; ++ipt ) {
+    double wcExp = ycoef*(ys[ipt] - y0) + zcoef*(zs[ipt] - z0);
+    maxdiff = std::max(maxdiff, std::abs(wcs[ipt] - wcExp));
+  }
+  cout << myname << "Max difference: " << maxdiff << endl;
+  assert( maxdiff < 2.0e-3 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check nearest wires." << endl;
+  vector<WirePlaneProjection::WireNumber> iwirs(npt);
+  proj.nearestWires(ys.data(), zs.data(), npt, iwirs.data());
+  Index nclose = 0;
+  for ( Index ipt=0; ipt<npt; ++ipt ) {
+    double ycap = std::max(ymin, std::min(ymax, ys[ipt]));
+    double zcap = std::max(zmin, std::min(zmax, zs[ipt]));
+    double wc = ycoef*(ycap - y0) + zcoef*(zcap - z0);
+    int iwirSigned = 0.5 + wc;
+    Index iwirExp = std::min(Index(std::max(iwirSigned, 0)), nwires - 1);
+    assert( iwirs[ipt] < nwires );
+    if ( iwirs[ipt] == iwirExp ) continue;
+    // Allowed only for points at the midpoint between two wires.
+    assert( std::abs(wc - std::floor(wc) - 0.5) < 2.0e-3 );
+    ++nclose;
+  }
+  cout << myname << "Midpoint differences: " << nclose << endl;
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with the other path." << endl;
+  WirePlaneProjection proj2 = proj;
+  proj2.setUseSimd(!useSimd);
+  vector<double> wcs2(npt);
+  vector<WirePlaneProjection::WireNumber> iwirs2(npt);
+  proj2.wireCoordinates(ys.data(), zs.data(), npt, wcs2.data());
+  proj2.nearestWires(ys.data(), zs.data(), npt, iwirs2.data());
+  // The paths agree to float rounding; the compiler may contract the scalar
+  // expression into a fused multiply-add.
+  for ( Index ipt=0; ipt<npt; ++ipt ) {
+    assert( std::abs(wcs2[ipt] - wcs[ipt]) < 1.0e-3 );
+    if ( iwirs2[ipt] != iwirs[ipt] ) assert( std::abs(wcs[ipt] - std::floor(wcs[ipt]) - 0.5) < 2.0e-3 );
+  }
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  int nerr = 0;
+  for ( Index npt : {0, 1, 7, 8, 9, 1000} ) {
+    nerr += test_WirePlaneProjection(false, npt);
+    nerr += test_WirePlaneProjection(true, npt);
+  }
+  return nerr;
+}
+
+//**********************************************************************
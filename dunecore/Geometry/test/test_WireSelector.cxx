@@ -261,6 +261,9 @@ int test_WireSelector(string gname, double wireAngle, double minDrift, unsigned
   assert( ws.data().size() == nwirSel );
   assert( ws.dataMap().size() == nwirSel );
   assert( wsum.size() == nwirSel );
+  const WireBoxIndex& widx = ws.fillWireIndex();
+  assert( widx.size() == nwirSel );
+  assert( widx.overlapping(wsum.xmin, wsum.xmax, wsum.ymin, wsum.ymax, wsum.zmin, wsum.zmax).size() == nwirSel );
 
   // Build discriminated adcdata as a vector of x-values for each channel.
   cout << myname << line << endl;
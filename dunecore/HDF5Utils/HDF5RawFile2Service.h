@@ -5,6 +5,33 @@
 //
 // Generated at Tue Nov 15 16:04:29 2022 by Thomas Junk using cetskelgen
 // from  version .
+//
+// Optional read-ahead: Prefetch(rid) queues a trigger record whose
+// fragments are then read into memory by a background thread, so that the
+// file I/O (latency-bound over xrootd) overlaps with processing of earlier
+// events.  Decoders retrieve fragments with GetFragPtr, which hands over a
+// prefetched fragment if there is one and reads from the file otherwise.
+//
+// HDF5RawDataFile is not thread safe.  While prefetching is in use, any
+// direct access to the file through GetPtr() must hold the lock returned
+// by LockFile().
+//
+// File-level metadata (run number, layout version, record type, record IDs
+// and the file-level SourceID-to-GeoID map) is read once in SetPtr and can
+// be shared as a read-only snapshot through GetFileInfo().
+//
+// HDF5 file access tuning (chunk cache, metadata cache, page buffer and
+// metadata block aggregation) is configured with the service parameters
+// ChunkCacheSlots, ChunkCacheBytes, ChunkCachePreemption, MetadataCacheBytes,
+// PageBufferBytes, MetaBlockBytes and ReportCacheStats; zero/negative keeps
+// the HDF5 default.  Sources open files with GetFileAccessConfig().
+//
+// MemoryBudgetMB and MemoryBudgetMaxWaitMs configure the process-wide
+// MemoryBudget shared with the decoders and the channel data pools.  The
+// prefetched fragments are charged to it until they are handed over or
+// dropped, and the prefetch thread does not start a record while the budget
+// has no room for one more; a record that a decoder asks for before its
+// prefetch has started is then read directly.
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef DUNEHDF5RawFile2Service_H
@@ -15,14 +42,36 @@
 #include "fhiclcpp/ParameterSet.h"
 #include "dunecore/HDF5Utils/dunedaqhdf5utils2/HDF5RawDataFile.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
 namespace dune
 {
 
   class HDF5RawFile2Service {
   public:
+
+    using record_id_t = dunedaq::hdf5libs::HDF5RawDataFile::record_id_t;
+    using FragmentPtr = std::unique_ptr<dunedaq::daqdataformats::Fragment>;
+
+    struct FileInfo {
+      std::string fileName;
+      uint32_t runNumber = 0;
+      uint32_t layoutVersion = 0;
+      std::string recordType;
+      size_t recordedSize = 0;
+      dunedaq::hdf5libs::HDF5RawDataFile::record_id_set recordIDs;
+      dunedaq::hdf5libs::HDF5SourceIDHandler::source_id_geo_id_map_t sourceIDGeoIDs;   // file level
+    };
+    using FileInfoPtr = std::shared_ptr<const FileInfo>;
+
     explicit HDF5RawFile2Service(fhicl::ParameterSet const& p, art::ActivityRegistry& areg);
-    // The compiler-generated destructor is fine for non-base
-    // classes without bare pointers or other resource use.
+    ~HDF5RawFile2Service();
 
     // sets the pointer and assumes ownership of it
 
@@ -32,11 +81,67 @@ namespace dune
 
     dunedaq::hdf5libs::HDF5RawDataFile *GetPtr();
 
+    // gets the metadata of the open file, or null if there is none.  The snapshot stays
+    // valid after the file is closed.
+
+    FileInfoPtr GetFileInfo() const { return fFileInfo; }
+
+    // gets the file access tuning to use when opening files
+
+    const dunedaq::hdf5libs::HDF5RawDataFile::FileAccessConfig& GetFileAccessConfig() const { return fAccessConfig; }
+
+    // serializes access to the file between the caller and the prefetch thread
+
+    std::unique_lock<std::mutex> LockFile();
+
+    // queues a record for reading by the prefetch thread, which is started on first use.
+    // Records already queued or held are ignored.
+
+    void Prefetch(const record_id_t& rid);
+
+    // drops prefetched records earlier than rid, and removes them from the queue
+
+    void ReleaseRecordsBefore(const record_id_t& rid);
+
+    // returns the fragment for a record and source ID.  A prefetched fragment is handed
+    // over (so a second call reads the file again); if the record is being read, this
+    // waits for it.  Otherwise the fragment is read from the file directly.
+
+    FragmentPtr GetFragPtr(const record_id_t& rid, const dunedaq::daqdataformats::SourceID& sid);
+
+    // stops the prefetch thread, drops prefetched data and closes the file
+
     void Close();
 
   private:
 
+    struct PrefetchedRecord {
+      bool complete = false;
+      size_t bytes = 0;                         // charged to the memory budget
+      std::map<dunedaq::daqdataformats::SourceID, FragmentPtr> fragments;
+    };
+
+    void prefetchLoop();
+    void stopPrefetch();
+
+    // removes prefetched records and releases their bytes from the budget, with the
+    // prefetch lock held
+
+    void dropPrefetched(std::map<record_id_t, PrefetchedRecord>::iterator first,
+                        std::map<record_id_t, PrefetchedRecord>::iterator last);
+
     std::unique_ptr<dunedaq::hdf5libs::HDF5RawDataFile> fRawDataFilePtr;
+    FileInfoPtr fFileInfo;
+    dunedaq::hdf5libs::HDF5RawDataFile::FileAccessConfig fAccessConfig;
+
+    std::mutex fFileMutex;                      // guards fRawDataFilePtr operations
+    std::mutex fPrefetchMutex;                  // guards the members below
+    std::condition_variable fPrefetchCond;
+    std::deque<record_id_t> fPrefetchQueue;
+    std::map<record_id_t, PrefetchedRecord> fPrefetched;
+    std::thread fPrefetchThread;
+    bool fStopPrefetch = false;
+    size_t fLastRecordBytes = 0;                // size of the last prefetched record, to estimate the next
 
   };
 
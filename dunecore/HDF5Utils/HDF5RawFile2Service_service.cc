@@ -11,6 +11,10 @@
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "dunecore/HDF5Utils/HDF5RawFile2Service.h"
+#include "dunecore/DuneInterface/Data/MemoryBudget.h"
+
+#include <algorithm>
+#include <chrono>
 
 // constructor
 
@@ -18,13 +22,48 @@ dune::HDF5RawFile2Service::HDF5RawFile2Service(fhicl::ParameterSet const& p, art
 // :
 // Initialize member data here.
 {
+  fAccessConfig.chunk_cache_slots = p.get<size_t>("ChunkCacheSlots", 0);
+  fAccessConfig.chunk_cache_bytes = p.get<size_t>("ChunkCacheBytes", 0);
+  fAccessConfig.chunk_cache_preemption = p.get<double>("ChunkCachePreemption", -1.);
+  fAccessConfig.metadata_cache_bytes = p.get<size_t>("MetadataCacheBytes", 0);
+  fAccessConfig.page_buffer_bytes = p.get<size_t>("PageBufferBytes", 0);
+  fAccessConfig.meta_block_bytes = p.get<size_t>("MetaBlockBytes", 0);
+  fAccessConfig.report_cache_stats = p.get<bool>("ReportCacheStats", false);
+
+  // the budget is process wide, so it is configured here, where the input starts
+
+  MemoryBudget& budget = MemoryBudget::instance();
+  budget.setLimit(p.get<size_t>("MemoryBudgetMB", 0) << 20);
+  budget.setMaxWait(std::chrono::milliseconds(p.get<unsigned int>("MemoryBudgetMaxWaitMs",
+                                                                  MemoryBudget::defaultMaxWait().count())));
+}
+
+dune::HDF5RawFile2Service::~HDF5RawFile2Service()
+{
+  stopPrefetch();
 }
 
 // sets the pointer and assumes ownership of it
 
 void dune::HDF5RawFile2Service::SetPtr(std::unique_ptr<dunedaq::hdf5libs::HDF5RawDataFile> fileptr)
 {
+  stopPrefetch();
+  std::lock_guard<std::mutex> flock(fFileMutex);
   fRawDataFilePtr = std::move(fileptr);
+  fFileInfo.reset();
+  if (!fRawDataFilePtr) return;
+
+  // file-level metadata does not change while the file is open, so read it once here
+
+  auto info = std::make_shared<FileInfo>();
+  info->fileName = fRawDataFilePtr->get_file_name();
+  info->runNumber = fRawDataFilePtr->get_attribute<uint32_t>("run_number");
+  info->layoutVersion = fRawDataFilePtr->get_version();
+  info->recordType = fRawDataFilePtr->get_record_type();
+  info->recordedSize = fRawDataFilePtr->get_recorded_size();
+  info->recordIDs = fRawDataFilePtr->get_all_record_ids();
+  info->sourceIDGeoIDs = fRawDataFilePtr->get_file_level_source_id_geo_id_map();
+  fFileInfo = std::move(info);
 }
 
 // gets a non-owning copy of the file pointer
@@ -34,9 +73,172 @@ dunedaq::hdf5libs::HDF5RawDataFile* dune::HDF5RawFile2Service::GetPtr()
   return fRawDataFilePtr.get();
 }
 
+std::unique_lock<std::mutex> dune::HDF5RawFile2Service::LockFile()
+{
+  return std::unique_lock<std::mutex>(fFileMutex);
+}
+
+void dune::HDF5RawFile2Service::Prefetch(const record_id_t& rid)
+{
+  std::lock_guard<std::mutex> plock(fPrefetchMutex);
+  if (fPrefetched.count(rid) > 0) return;
+  if (std::find(fPrefetchQueue.begin(), fPrefetchQueue.end(), rid) != fPrefetchQueue.end()) return;
+  fPrefetchQueue.push_back(rid);
+  if (!fPrefetchThread.joinable())
+    {
+      fPrefetchThread = std::thread(&HDF5RawFile2Service::prefetchLoop, this);
+    }
+  fPrefetchCond.notify_all();
+}
+
+void dune::HDF5RawFile2Service::ReleaseRecordsBefore(const record_id_t& rid)
+{
+  std::lock_guard<std::mutex> plock(fPrefetchMutex);
+  dropPrefetched(fPrefetched.begin(), fPrefetched.lower_bound(rid));
+  fPrefetchQueue.erase(std::remove_if(fPrefetchQueue.begin(), fPrefetchQueue.end(),
+                                      [&rid](const record_id_t& qid) { return qid < rid; }),
+                       fPrefetchQueue.end());
+}
+
+dune::HDF5RawFile2Service::FragmentPtr
+dune::HDF5RawFile2Service::GetFragPtr(const record_id_t& rid, const dunedaq::daqdataformats::SourceID& sid)
+{
+  {
+    std::unique_lock<std::mutex> plock(fPrefetchMutex);
+
+    // a record that is still queued, e.g. because the memory budget holds the prefetch
+    // back, is taken off the queue and read here
+
+    auto iqueued = std::find(fPrefetchQueue.begin(), fPrefetchQueue.end(), rid);
+    if (iqueued != fPrefetchQueue.end()) fPrefetchQueue.erase(iqueued);
+
+    // wait until the record is no longer being read
+
+    fPrefetchCond.wait(plock, [&] {
+        if (fStopPrefetch) return true;
+        auto irec = fPrefetched.find(rid);
+        return irec == fPrefetched.end() || irec->second.complete;
+      });
+    auto irec = fPrefetched.find(rid);
+    if (irec != fPrefetched.end())
+      {
+        auto ifrag = irec->second.fragments.find(sid);
+        if (ifrag != irec->second.fragments.end())
+          {
+            FragmentPtr frag = std::move(ifrag->second);
+            irec->second.fragments.erase(ifrag);
+            size_t nbyte = frag ? frag->get_size() : 0;
+            irec->second.bytes -= nbyte;
+            MemoryBudget::instance().release(nbyte);
+            return frag;
+          }
+      }
+  }
+
+  // not prefetched (or the prefetch failed): read it here, which also reports any error
+
+  std::lock_guard<std::mutex> flock(fFileMutex);
+  return fRawDataFilePtr->get_frag_ptr(rid, sid);
+}
+
 void dune::HDF5RawFile2Service::Close()
 {
+  stopPrefetch();
+  std::lock_guard<std::mutex> flock(fFileMutex);
   fRawDataFilePtr.reset();
+  fFileInfo.reset();
+}
+
+// background thread: read the fragments of queued records one at a time.  The file lock
+// is taken per fragment so the event loop is never held up for a whole record.  A record
+// is only started when the memory budget has room for one of the size of the last; the
+// budget is polled, as it is released by other threads without notifying this one.
+
+void dune::HDF5RawFile2Service::prefetchLoop()
+{
+  MemoryBudget& budget = MemoryBudget::instance();
+  std::unique_lock<std::mutex> plock(fPrefetchMutex);
+  while (true)
+    {
+      while (!fPrefetchCond.wait_for(plock, std::chrono::milliseconds(20), [this, &budget] {
+            return fStopPrefetch || (!fPrefetchQueue.empty() && budget.hasRoom(fLastRecordBytes));
+          })) {}
+      if (fStopPrefetch) return;
+      record_id_t rid = fPrefetchQueue.front();
+      fPrefetchQueue.pop_front();
+      fPrefetched[rid];
+      plock.unlock();
+
+      std::set<dunedaq::daqdataformats::SourceID> sids;
+      try
+        {
+          std::lock_guard<std::mutex> flock(fFileMutex);
+          sids = fRawDataFilePtr->get_fragment_source_ids(rid);
+        }
+      catch (...)
+        {
+          sids.clear();    // GetFragPtr falls back to a direct read
+        }
+
+      for (const auto& sid : sids)
+        {
+          FragmentPtr frag;
+          try
+            {
+              std::lock_guard<std::mutex> flock(fFileMutex);
+              frag = fRawDataFilePtr->get_frag_ptr(rid, sid);
+            }
+          catch (...)
+            {
+              continue;
+            }
+          plock.lock();
+          if (fStopPrefetch) return;
+          auto irec = fPrefetched.find(rid);
+          if (irec == fPrefetched.end())    // released while we were reading
+            {
+              plock.unlock();
+              break;
+            }
+          size_t nbyte = frag ? frag->get_size() : 0;
+          budget.charge(nbyte);
+          irec->second.bytes += nbyte;
+          irec->second.fragments[sid] = std::move(frag);
+          plock.unlock();
+        }
+
+      plock.lock();
+      auto irec = fPrefetched.find(rid);
+      if (irec != fPrefetched.end())
+        {
+          irec->second.complete = true;
+          fLastRecordBytes = irec->second.bytes;
+        }
+      fPrefetchCond.notify_all();
+    }
+}
+
+void dune::HDF5RawFile2Service::stopPrefetch()
+{
+  {
+    std::lock_guard<std::mutex> plock(fPrefetchMutex);
+    fStopPrefetch = true;
+  }
+  fPrefetchCond.notify_all();
+  if (fPrefetchThread.joinable()) fPrefetchThread.join();
+  std::lock_guard<std::mutex> plock(fPrefetchMutex);
+  fPrefetchQueue.clear();
+  dropPrefetched(fPrefetched.begin(), fPrefetched.end());
+  fStopPrefetch = false;
+}
+
+void dune::HDF5RawFile2Service::dropPrefetched(std::map<record_id_t, PrefetchedRecord>::iterator first,
+                                               std::map<record_id_t, PrefetchedRecord>::iterator last)
+{
+  size_t nbyte = 0;
+  for (auto irec = first; irec != last; ++irec) nbyte += irec->second.bytes;
+  fPrefetched.erase(first, last);
+  MemoryBudget::instance().release(nbyte);
 }
 
 
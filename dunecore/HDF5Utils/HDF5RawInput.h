@@ -39,6 +39,10 @@ class dune::HDF5RawInputDetail {
                 art::EventPrincipal*& outE);
 
   void closeCurrentFile() {
+    if (fFileIndex) {
+      dune::HDF5Utils::withdrawFileIndex(fFileIndex->fileName);
+      fFileIndex.reset();
+    }
     if (hdf_file_->filePtr)
       dune::HDF5Utils::closeFile(std::move(hdf_file_));
   };
@@ -50,5 +54,9 @@ class dune::HDF5RawInputDetail {
   int fLogLevel;
   double fClockFreqMHz;            // clock frequency in MHz -- used to unpack trigger timestamps for the event
   art::SourceHelper const& pmaker;
+  // Record index of the open file, built and published at open time if
+  // IndexRecordsAtOpen is set.
+  bool fIndexRecordsAtOpen;
+  dune::HDF5Utils::FileIndexPtr fFileIndex;
  };
 #endif
@@ -22,6 +22,11 @@
 #include "dunecore/HDF5Utils/HDF5RawFile2Service.h"
 #include "dunecore/HDF5Utils/HDF5Utils.h"
 
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace dune {
 //Forward declare the class
 class HDF5RawInput2Detail;
@@ -42,18 +47,48 @@ class dune::HDF5RawInput2Detail {
                 art::EventPrincipal*& outE);
 
   void closeCurrentFile() {
+    if (fFileIndex)
+      {
+        dune::HDF5Utils::withdrawFileIndex(fFileIndex->fileName);
+        fFileIndex.reset();
+      }
     art::ServiceHandle<dune::HDF5RawFile2Service> rawFileService;
     rawFileService->Close();
   };
 
  private:
+
+  // remove records not requested by the selection parameters from fUnprocessedEventRecordIDs
+
+  void applyRecordSelection();
+
+  // build and publish the record index of the selected records of the open file
+
+  void indexRecords();
+
+  // start opening and indexing the file after filename in fFileNames in the background
+
+  void preopenNextFile(std::string const & filename);
+
   dunedaq::hdf5libs::HDF5RawDataFile::record_id_set fUnprocessedEventRecordIDs;
   std::string pretend_module_name;
   int fLogLevel;
   double fClockFreqMHz;               // clock frequency in MHz -- used to unpack trigger timestamps for the event
   std::string fHandleSequenceOption;  // to steer what to do with trigger record sequence numbers
   unsigned int fTrnScale;             // in case we are doing shiftadd, this the scale factor on trig number
+  unsigned int fPrefetchRecords;      // number of records ahead to read in the background, 0 to disable
+  std::set<uint64_t> fSelectTriggerNumbers;     // if not empty, read only these trigger numbers
+  dunedaq::hdf5libs::HDF5RawDataFile::record_id_set fSelectRecordIDs;  // if not empty, read only these (trigger, sequence) IDs
+  unsigned int fRecordStride;         // read every fRecordStride-th record of each file
+  unsigned int fRecordOffset;         // starting with this one
+  bool fPreopenNextFile;              // open the next input file while the current one is processed
+  std::vector<std::string> fFileNames;  // input file list, for finding the next file
+  size_t fNextFileIndex;              // position in fFileNames of the file being pre-opened
+  std::string fNextFileName;
+  std::future<std::unique_ptr<dunedaq::hdf5libs::HDF5RawDataFile>> fNextFile;
   art::SourceHelper const& pmaker;
+  bool fIndexRecordsAtOpen;           // build the HDF5Utils record index of the selected records at open
+  dune::HDF5Utils::FileIndexPtr fFileIndex;
 
   int fLastEvent;
  };
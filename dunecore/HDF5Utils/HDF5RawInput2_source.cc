@@ -4,6 +4,9 @@
 #include "dunecore/HDF5Utils/HDF5RawInput2.h"
 #include "dunecore/DuneObj/DUNEHDF5FileInfo2.h"
 #include "lardataobj/RawData/RDTimeStamp.h"
+#include "dunecore/DuneInterface/Data/TraceRecorder.h"
+
+#include <algorithm>
 
 dune::HDF5RawInput2Detail::HDF5RawInput2Detail(
                                                fhicl::ParameterSet const & ps,
@@ -14,7 +17,27 @@ dune::HDF5RawInput2Detail::HDF5RawInput2Detail(
     fClockFreqMHz(ps.get<double>("ClockFrequencyMHz", 50.0)),
     fHandleSequenceOption(ps.get<std::string>("HandleSequenceOption","ignore")),
     fTrnScale(ps.get<unsigned int>("TrnScale",10000)),
-    pmaker(sh) {
+    fPrefetchRecords(ps.get<unsigned int>("PrefetchRecords",0)),
+    fRecordStride(ps.get<unsigned int>("RecordStride",1)),
+    fRecordOffset(ps.get<unsigned int>("RecordOffset",0)),
+    fPreopenNextFile(ps.get<bool>("PreopenNextFile",false)),
+    fFileNames(ps.get<std::vector<std::string>>("fileNames",{})),
+    fNextFileIndex(0),
+    pmaker(sh),
+    fIndexRecordsAtOpen(ps.get<bool>("IndexRecordsAtOpen",false)) {
+      for (auto trn : ps.get<std::vector<uint64_t>>("SelectTriggerNumbers",{})) fSelectTriggerNumbers.insert(trn);
+      for (const auto& rid : ps.get<std::vector<std::vector<uint64_t>>>("SelectRecordIDs",{}))
+        {
+          if (rid.size() != 2)
+            {
+              throw cet::exception("HDF5RawInput2_source.cc") << "SelectRecordIDs entries must be [trigger number, sequence number]";
+            }
+          fSelectRecordIDs.emplace(rid[0], rid[1]);
+        }
+      if (fRecordStride == 0)
+        {
+          throw cet::exception("HDF5RawInput2_source.cc") << "RecordStride must be at least 1";
+        }
       rh.reconstitutes<raw::DUNEHDF5FileInfo2, art::InEvent>(pretend_module_name);
       rh.reconstitutes<raw::RDTimeStamp, art::InEvent>(pretend_module_name, "trigger");
     }
@@ -25,7 +48,20 @@ void dune::HDF5RawInput2Detail::readFile(
   // open the input file with the dunedaq class and hand the ownership off to the rawFileServie
 
   art::ServiceHandle<dune::HDF5RawFile2Service> rawFileService;
-  auto hdf_file = std::make_unique<dunedaq::hdf5libs::HDF5RawDataFile>(filename);
+  std::unique_ptr<dunedaq::hdf5libs::HDF5RawDataFile> hdf_file;
+  if (fNextFile.valid())
+    {
+      // take the pre-opened file if it is the one asked for; get() rethrows any open failure
+      if (fNextFileName == filename) hdf_file = fNextFile.get();
+      else
+        {
+          try { fNextFile.get(); } catch (...) {}
+        }
+    }
+  if (!hdf_file)
+    {
+      hdf_file = std::make_unique<dunedaq::hdf5libs::HDF5RawDataFile>(filename, rawFileService->GetFileAccessConfig());
+    }
   rawFileService->SetPtr(std::move(hdf_file));
 
   // for convenience, get a non-owning pointer
@@ -33,8 +69,10 @@ void dune::HDF5RawInput2Detail::readFile(
 
   fUnprocessedEventRecordIDs = rf->get_all_trigger_record_ids();
   fLastEvent = 0;
+  applyRecordSelection();
+  if (fIndexRecordsAtOpen) indexRecords();
 
-  uint32_t run_number = rf->get_attribute<uint32_t>("run_number");
+  uint32_t run_number = rawFileService->GetFileInfo()->runNumber;
   MF_LOG_INFO("HDF5")
     << "HDF5 opened HDF file with run number " <<
     run_number  << " and " <<
@@ -44,10 +82,84 @@ void dune::HDF5RawInput2Detail::readFile(
        for (const auto & e : fUnprocessedEventRecordIDs) MF_LOG_INFO("HDF5") << e.first << " " << e.second;
     }
 
+  if (fPreopenNextFile) preopenNextFile(filename);
+
   fb = new art::FileBlock(art::FileFormatVersion(1, "RawEvent2011"),
                           filename); 
 }
 
+// one walk over the selected records, under the file lock as the prefetch thread may be
+// reading.  Decoders that read through the HDF5 C API find the records in the published
+// index with HDF5Utils::getRecordIndex or findRecordIndex.
+
+void dune::HDF5RawInput2Detail::indexRecords()
+{
+  art::ServiceHandle<dune::HDF5RawFile2Service> rawFileService;
+  auto rf = rawFileService->GetPtr();
+  auto flock = rawFileService->LockFile();
+  auto layout = rf->get_file_layout();
+  std::vector<std::string> recordNames;
+  recordNames.reserve(fUnprocessedEventRecordIDs.size());
+  for (const auto& rid : fUnprocessedEventRecordIDs)
+    {
+      recordNames.push_back(layout.get_record_number_string(rid.first, rid.second));
+    }
+  fFileIndex = dune::HDF5Utils::buildFileIndex(rf->get_file_id(), recordNames);
+  flock.unlock();
+  dune::HDF5Utils::publishFileIndex(fFileIndex);
+  if (fLogLevel > 0)
+    {
+      MF_LOG_INFO("HDF5") << "HDF5 indexed " << recordNames.size() << " records of " << fFileIndex->fileName;
+    }
+}
+
+// HDF5 is not thread safe, so the open holds the service's file lock: it overlaps with
+// the processing of the current file's events, not with reads from it
+
+void dune::HDF5RawInput2Detail::preopenNextFile(std::string const & filename)
+{
+  auto ifile = std::find(fFileNames.begin() + fNextFileIndex, fFileNames.end(), filename);
+  if (ifile == fFileNames.end() || ifile + 1 == fFileNames.end()) return;
+  ++ifile;
+  fNextFileIndex = ifile - fFileNames.begin();
+  fNextFileName = *ifile;
+
+  art::ServiceHandle<dune::HDF5RawFile2Service> rawFileService;
+  dune::HDF5RawFile2Service* service = rawFileService.get();
+  auto config = service->GetFileAccessConfig();
+  fNextFile = std::async(std::launch::async, [service, config, name = fNextFileName] {
+      auto flock = service->LockFile();
+      auto file = std::make_unique<dunedaq::hdf5libs::HDF5RawDataFile>(name, config);
+      file->get_all_record_ids();    // index the records now; the result is cached in the file object
+      return file;
+    });
+  if (fLogLevel > 0)
+    {
+      MF_LOG_INFO("HDF5") << "HDF5 pre-opening next file " << fNextFileName;
+    }
+}
+
+// the selection only uses the record IDs from the file's group names, so records
+// that are skipped are never touched
+
+void dune::HDF5RawInput2Detail::applyRecordSelection()
+{
+  if (fSelectTriggerNumbers.empty() && fSelectRecordIDs.empty() && fRecordStride == 1 && fRecordOffset == 0) return;
+
+  size_t nall = fUnprocessedEventRecordIDs.size();
+  size_t irec = 0;
+  for (auto irid = fUnprocessedEventRecordIDs.begin(); irid != fUnprocessedEventRecordIDs.end(); ++irec)
+    {
+      bool keep = irec >= fRecordOffset && (irec - fRecordOffset) % fRecordStride == 0;
+      if (keep && !fSelectTriggerNumbers.empty()) keep = fSelectTriggerNumbers.count(irid->first) > 0;
+      if (keep && !fSelectRecordIDs.empty()) keep = fSelectRecordIDs.count(*irid) > 0;
+      if (keep) ++irid;
+      else irid = fUnprocessedEventRecordIDs.erase(irid);
+    }
+  MF_LOG_INFO("HDF5")
+    << "HDF5 record selection keeps " << fUnprocessedEventRecordIDs.size() << " of " << nall << " records";
+}
+
 bool dune::HDF5RawInput2Detail::readNext(art::RunPrincipal const* const inR,
                                          art::SubRunPrincipal const* const inSR,
                                          art::RunPrincipal*& outR,
@@ -72,11 +184,34 @@ bool dune::HDF5RawInput2Detail::readNext(art::RunPrincipal const* const inR,
   auto nextEventRecordID = *nextEventRecordID_i;
   fUnprocessedEventRecordIDs.erase(nextEventRecordID_i);
 
-  uint32_t run_id = rf->get_attribute<uint32_t>("run_number");
+  TraceSpan span("input", "HDF5RawInput2::readNext");
+  span.arg("record", nextEventRecordID.first).arg("sequence", nextEventRecordID.second);
+
+  // keep the next fPrefetchRecords records being read in the background, and drop
+  // whatever the decoders did not pick up from earlier records
+
+  if (fPrefetchRecords > 0)
+    {
+      rawFileService->ReleaseRecordsBefore(nextEventRecordID);
+      rawFileService->Prefetch(nextEventRecordID);
+      unsigned int nqueued = 0;
+      for (const auto& rid : fUnprocessedEventRecordIDs)
+        {
+          if (nqueued++ == fPrefetchRecords) break;
+          rawFileService->Prefetch(rid);
+        }
+    }
+
+  // file-level attributes are cached by the service when the file is opened
+
+  auto fileInfo = rawFileService->GetFileInfo();
+  uint32_t run_id = fileInfo->runNumber;
 
   // get trigger record header pointer
 
+  auto flock = rawFileService->LockFile();
   auto trh = rf->get_trh_ptr(nextEventRecordID);
+  flock.unlock();
 
   //check that the run number in the trigger record header agrees with that in the file attribute
 
@@ -168,7 +303,7 @@ bool dune::HDF5RawInput2Detail::readNext(art::RunPrincipal const* const inR,
 
  
   std::unique_ptr<raw::DUNEHDF5FileInfo2> the_info(
-                                                   new raw::DUNEHDF5FileInfo2(rf->get_file_name(), run_id, nextEventRecordID.first,
+                                                   new raw::DUNEHDF5FileInfo2(fileInfo->fileName, run_id, nextEventRecordID.first,
                                                                               nextEventRecordID.second));
 
   put_product_in_principal(std::move(the_info), *outE, pretend_module_name,
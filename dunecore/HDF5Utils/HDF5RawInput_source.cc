@@ -12,7 +12,8 @@ dune::HDF5RawInputDetail::HDF5RawInputDetail(
   : pretend_module_name(ps.get<std::string>("raw_data_label", "daq")),
     fLogLevel(ps.get<int>("LogLevel", 0)),
     fClockFreqMHz(ps.get<double>("ClockFrequencyMHz", 50.0)),
-    pmaker(sh) {
+    pmaker(sh),
+    fIndexRecordsAtOpen(ps.get<bool>("IndexRecordsAtOpen", true)) {
   rh.reconstitutes<raw::DUNEHDF5FileInfo, art::InEvent>(pretend_module_name); 
   rh.reconstitutes<raw::RDTimeStamp, art::InEvent>(pretend_module_name, "trigger");
 }
@@ -20,8 +21,17 @@ dune::HDF5RawInputDetail::HDF5RawInputDetail(
 void dune::HDF5RawInputDetail::readFile(
     std::string const & filename, art::FileBlock*& fb) {
   hdf_file_ = dune::HDF5Utils::openFile(filename);
-  unprocessedEventList_
-      = dune::HDF5Utils::getTopLevelGroupNames(hdf_file_);
+  if (fIndexRecordsAtOpen) {
+    // One walk over the file; the decoders then find each record in the
+    // published index instead of listing its groups per event.
+    fFileIndex = dune::HDF5Utils::buildFileIndex(hdf_file_->filePtr);
+    dune::HDF5Utils::publishFileIndex(fFileIndex);
+    unprocessedEventList_.assign(fFileIndex->recordNames.begin(),
+                                 fFileIndex->recordNames.end());
+  } else {
+    unprocessedEventList_
+        = dune::HDF5Utils::getTopLevelGroupNames(hdf_file_);
+  }
   MF_LOG_INFO("HDF5")
       << "HDF5 opened HDF file with run number " <<
          hdf_file_->runNumber  << " and " <<
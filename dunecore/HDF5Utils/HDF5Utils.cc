@@ -4,6 +4,9 @@
 #include "detdataformats/wib/WIBFrame.hpp"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include "TMath.h"
 
 namespace dune {
@@ -61,15 +64,179 @@ namespace dune {
       std::deque<std::string> theList;
       hsize_t nobj = 0;
       H5Gget_num_objs(grp, &nobj);
+      std::vector<char> memb_name;
       for (hsize_t idx = 0; idx < nobj; ++idx) {
-        hsize_t len = H5Gget_objname_by_idx(grp, idx, NULL, 0 );
-        char *memb_name = new char(len+1);
-        H5Gget_objname_by_idx(grp, idx, memb_name, len+1 );
-        theList.emplace_back(memb_name);
-        delete memb_name;
+        ssize_t len = H5Gget_objname_by_idx(grp, idx, NULL, 0 );
+        if (len < 0) continue;
+        if (memb_name.size() < size_t(len) + 1) memb_name.resize(len + 1);
+        H5Gget_objname_by_idx(grp, idx, memb_name.data(), len+1 );
+        theList.emplace_back(memb_name.data(), len);
       }
       return theList;
     }
+
+    namespace {
+
+      // Names and object types of the members of a group.
+      void listGroupMembers(hid_t grp, std::vector<std::string> &names, std::vector<H5G_obj_t> &types) {
+        hsize_t nobj = 0;
+        H5Gget_num_objs(grp, &nobj);
+        names.clear();
+        types.clear();
+        names.reserve(nobj);
+        types.reserve(nobj);
+        std::vector<char> memb_name;
+        for (hsize_t idx = 0; idx < nobj; ++idx) {
+          ssize_t len = H5Gget_objname_by_idx(grp, idx, NULL, 0 );
+          if (len < 0) continue;
+          if (memb_name.size() < size_t(len) + 1) memb_name.resize(len + 1);
+          H5Gget_objname_by_idx(grp, idx, memb_name.data(), len+1 );
+          names.emplace_back(memb_name.data(), len);
+          types.push_back(H5Gget_objtype_by_idx(grp, idx));
+        }
+      }
+
+      DatasetInfo getDatasetInfo(hid_t grp, const std::string &name, const std::string &path) {
+        DatasetInfo info;
+        info.name = name;
+        info.path = path;
+        hid_t ds = H5Dopen(grp, name.data(), H5P_DEFAULT);
+        if (ds >= 0) {
+          info.dataSize = getDatasetSize(ds);
+          info.storageSize = H5Dget_storage_size(ds);
+          info.offset = H5Dget_offset(ds);
+          H5Dclose(ds);
+        }
+        return info;
+      }
+
+      std::string getFileName(hid_t fd) {
+        ssize_t len = H5Fget_name(fd, NULL, 0);
+        if (len <= 0) return "";
+        std::vector<char> name(len + 1);
+        H5Fget_name(fd, name.data(), len + 1);
+        return std::string(name.data(), len);
+      }
+
+    }
+
+    const DetectorInfo* RecordIndex::detector(const std::string &name) const {
+      for (const auto &det : detectors) {
+        if (det.name == name) return &det;
+      }
+      return nullptr;
+    }
+
+    RecordIndexPtr buildRecordIndex(hid_t fd, const std::string &recordGroupName) {
+      auto index = std::make_shared<RecordIndex>();
+      index->fileName = getFileName(fd);
+      index->recordGroupName = recordGroupName;
+      hid_t recGroup = H5Gopen(fd, recordGroupName.data(), H5P_DEFAULT);
+      if (recGroup < 0) return index;
+      std::vector<std::string> detNames, elNames, dsNames;
+      std::vector<H5G_obj_t> detTypes, elTypes, dsTypes;
+      listGroupMembers(recGroup, detNames, detTypes);
+      for (size_t idet = 0; idet < detNames.size(); ++idet) {
+        if (detTypes[idet] != H5G_GROUP) continue;
+        DetectorInfo det;
+        det.name = detNames[idet];
+        hid_t detGroup = H5Gopen(recGroup, det.name.data(), H5P_DEFAULT);
+        listGroupMembers(detGroup, elNames, elTypes);
+        for (size_t iel = 0; iel < elNames.size(); ++iel) {
+          std::string elPath = det.name + "/" + elNames[iel];
+          if (elTypes[iel] == H5G_DATASET) {
+            det.datasets.push_back(getDatasetInfo(detGroup, elNames[iel], elPath));
+            continue;
+          }
+          if (elTypes[iel] != H5G_GROUP) continue;
+          ElementInfo el;
+          el.name = elNames[iel];
+          hid_t elGroup = H5Gopen(detGroup, el.name.data(), H5P_DEFAULT);
+          listGroupMembers(elGroup, dsNames, dsTypes);
+          el.datasets.reserve(dsNames.size());
+          for (size_t ids = 0; ids < dsNames.size(); ++ids) {
+            if (dsTypes[ids] != H5G_DATASET) continue;
+            el.datasets.push_back(getDatasetInfo(elGroup, dsNames[ids], elPath + "/" + dsNames[ids]));
+          }
+          H5Gclose(elGroup);
+          det.elements.push_back(std::move(el));
+        }
+        H5Gclose(detGroup);
+        index->detectors.push_back(std::move(det));
+      }
+      H5Gclose(recGroup);
+      return index;
+    }
+
+    RecordIndexPtr FileIndex::record(const std::string &recordGroupName) const {
+      auto ipos = recordPositions.find(recordGroupName);
+      return ipos == recordPositions.end() ? nullptr : records[ipos->second];
+    }
+
+    FileIndexPtr buildFileIndex(hid_t fd, const std::vector<std::string> &recordGroupNames) {
+      auto index = std::make_shared<FileIndex>();
+      index->fileName = getFileName(fd);
+      index->recordNames = recordGroupNames;
+      index->records.reserve(recordGroupNames.size());
+      for (size_t irec = 0; irec < recordGroupNames.size(); ++irec) {
+        index->records.push_back(buildRecordIndex(fd, recordGroupNames[irec]));
+        index->recordPositions[recordGroupNames[irec]] = irec;
+      }
+      return index;
+    }
+
+    FileIndexPtr buildFileIndex(hid_t fd) {
+      hid_t grp = H5Gopen(fd, "/", H5P_DEFAULT);
+      std::deque<std::string> names = getMidLevelGroupNames(grp);
+      H5Gclose(grp);
+      return buildFileIndex(fd, std::vector<std::string>(names.begin(), names.end()));
+    }
+
+    namespace {
+
+      // Published file indices by file name.  The map is replaced, never modified, so
+      // readers only need an atomic load.
+      typedef std::map<std::string, FileIndexPtr> FileIndexMap;
+      std::shared_ptr<const FileIndexMap> publishedFileIndices = std::make_shared<const FileIndexMap>();
+      std::mutex publishMutex;
+
+    }
+
+    void publishFileIndex(FileIndexPtr fileIndex) {
+      if (!fileIndex) return;
+      std::lock_guard<std::mutex> lock(publishMutex);
+      auto newMap = std::make_shared<FileIndexMap>(*std::atomic_load(&publishedFileIndices));
+      (*newMap)[fileIndex->fileName] = fileIndex;
+      std::atomic_store(&publishedFileIndices, std::shared_ptr<const FileIndexMap>(newMap));
+    }
+
+    void withdrawFileIndex(const std::string &fileName) {
+      std::lock_guard<std::mutex> lock(publishMutex);
+      auto newMap = std::make_shared<FileIndexMap>(*std::atomic_load(&publishedFileIndices));
+      newMap->erase(fileName);
+      std::atomic_store(&publishedFileIndices, std::shared_ptr<const FileIndexMap>(newMap));
+    }
+
+    RecordIndexPtr findRecordIndex(const std::string &fileName, const std::string &recordGroupName) {
+      std::shared_ptr<const FileIndexMap> indices = std::atomic_load(&publishedFileIndices);
+      auto ifil = indices->find(fileName);
+      if (ifil == indices->end()) return nullptr;
+      return ifil->second->record(recordGroupName);
+    }
+
+    RecordIndexPtr getRecordIndex(hid_t fd, const std::string &recordGroupName) {
+      static RecordIndexPtr cachedIndex;
+      std::string fileName = getFileName(fd);
+      RecordIndexPtr index = findRecordIndex(fileName, recordGroupName);
+      if (index) return index;
+      index = std::atomic_load(&cachedIndex);
+      if (index && index->recordGroupName == recordGroupName && index->fileName == fileName) {
+        return index;
+      }
+      index = buildRecordIndex(fd, recordGroupName);
+      std::atomic_store(&cachedIndex, index);
+      return index;
+    }
   
     // trigger timestamp formatter with a fixed 20 ns clock period (50 MHz clock)
 
@@ -131,10 +298,20 @@ namespace dune {
       return grp;
     }
 
+    hsize_t getDatasetSize(hid_t dataset) {
+      hid_t space = H5Dget_space(dataset);
+      hid_t type = H5Dget_type(dataset);
+      hssize_t npoints = (space >= 0) ? H5Sget_simple_extent_npoints(space) : 0;
+      size_t typesize = (type >= 0) ? H5Tget_size(type) : 0;
+      if (type >= 0) H5Tclose(type);
+      if (space >= 0) H5Sclose(space);
+      return (npoints > 0) ? hsize_t(npoints)*typesize : 0;
+    }
+
     void getHeaderInfo(hid_t the_group, const std::string & det_type,
                        HeaderInfo & info) {
       hid_t datasetid = H5Dopen(the_group, det_type.data(), H5P_DEFAULT);
-      hsize_t ds_size = H5Dget_storage_size(datasetid);
+      hsize_t ds_size = getDatasetSize(datasetid);
       //std::cout << "      Data Set Size (bytes): " << ds_size << std::endl;
       // todo -- check for zero size
       if (ds_size < 64) {
@@ -12,6 +12,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 
 
@@ -59,6 +60,84 @@ namespace dune {
     void getHeaderInfo(hid_t the_group, const std::string & det_type,
                        HeaderInfo & info);
 
+    // Size in bytes of the data in a dataset: number of elements times element size.
+    // Unlike H5Dget_storage_size this does not depend on the layout or compression.
+    hsize_t getDatasetSize(hid_t dataset);
+
+    // Index of the datasets in one trigger record, built with a single walk over the group
+    // hierarchy  record -> detector (e.g. "TPC") -> element (e.g. "APA001") -> datasets (links).
+    // Datasets found directly in a detector group are listed in DetectorInfo::datasets.
+    // The index is immutable once built, so decoder tasks on several threads can use it
+    // without calling the HDF5 library or taking locks.
+
+    struct DatasetInfo {
+      std::string name;            // dataset name within its group
+      std::string path;            // path relative to the record group, e.g. "TPC/APA001/Link00"
+      hsize_t dataSize = 0;        // bytes of data, as read into memory
+      hsize_t storageSize = 0;     // bytes stored in the file, smaller if compressed
+      haddr_t offset = HADDR_UNDEF; // file offset for contiguous datasets
+    };
+
+    struct ElementInfo {
+      std::string name;
+      std::vector<DatasetInfo> datasets;
+    };
+
+    struct DetectorInfo {
+      std::string name;
+      std::vector<ElementInfo> elements;
+      std::vector<DatasetInfo> datasets;
+    };
+
+    struct RecordIndex {
+      std::string fileName;
+      std::string recordGroupName;
+      std::vector<DetectorInfo> detectors;
+      // Return the detector with the given name or null if absent.
+      const DetectorInfo* detector(const std::string &name) const;
+    };
+
+    typedef std::shared_ptr<const RecordIndex> RecordIndexPtr;
+
+    // Build the index for the record group recordGroupName of file fd.
+    RecordIndexPtr buildRecordIndex(hid_t fd, const std::string &recordGroupName);
+
+    // Same, but taken from the published index of the file if there is one.  Otherwise the
+    // index of the most recently requested record is kept and returned again if the file
+    // and record match.  The cache is published atomically, so this may be called from
+    // several threads; see buildRecordIndex for the contents.
+    RecordIndexPtr getRecordIndex(hid_t fd, const std::string &recordGroupName);
+
+    // Index of the records of a file, built once when the file is opened: one RecordIndex
+    // for each record group, in file order.  A published index is shared by the source and
+    // the decoders, which then get the record indices from getRecordIndex or
+    // findRecordIndex without walking the file per event.
+
+    struct FileIndex {
+      std::string fileName;
+      std::vector<std::string> recordNames;
+      std::vector<RecordIndexPtr> records;             // same order as recordNames
+      std::map<std::string, size_t> recordPositions;   // position of each record name
+      // Return the index of a record group or null if it is not in the file index.
+      RecordIndexPtr record(const std::string &recordGroupName) const;
+    };
+
+    typedef std::shared_ptr<const FileIndex> FileIndexPtr;
+
+    // Build the file index for the listed record groups of file fd.
+    FileIndexPtr buildFileIndex(hid_t fd, const std::vector<std::string> &recordGroupNames);
+
+    // Same for all top-level groups of the file, the records of the legacy format.
+    FileIndexPtr buildFileIndex(hid_t fd);
+
+    // Make the index of a file available to getRecordIndex and findRecordIndex until it is
+    // withdrawn, e.g. when the file is closed.  Several files may be published at once.
+    void publishFileIndex(FileIndexPtr fileIndex);
+    void withdrawFileIndex(const std::string &fileName);
+
+    // Index of a record of a published file, or null.
+    RecordIndexPtr findRecordIndex(const std::string &fileName, const std::string &recordGroupName);
+
     typedef std::vector<Fragment> Fragments;
     //typedef std::map<std::string, std::unique_ptr<Fragments>> FragmentListsByType;
 
@@ -58,12 +58,20 @@ HDF5FileLayout::get_path_params(daqdataformats::SourceID::Subsystem type) const
   }
 }
 
-std::string
-HDF5FileLayout::get_record_number_string(uint64_t record_number, // NOLINT(build/unsigned)
-                                         daqdataformats::sequence_number_t seq_num) const
+const HDF5FileLayout::ElementPathTemplate&
+HDF5FileLayout::get_element_path_template(daqdataformats::SourceID::Subsystem type) const
 {
-  std::ostringstream record_number_string;
+  auto itpl = m_element_path_templates.find(type);
+  if (itpl == m_element_path_templates.end())
+    throw cet::exception("HDF5FileLayout.cpp") << " FileLayoutUnconfiguredSubsystem " << type << " " << daqdataformats::SourceID::subsystem_to_string(type);
+  return itpl->second;
+}
 
+void
+HDF5FileLayout::append_record_number_string(std::string& out,
+                                            uint64_t record_number, // NOLINT(build/unsigned)
+                                            daqdataformats::sequence_number_t seq_num) const
+{
   int width = m_conf_params.digits_for_record_number;
 
   if (record_number >= m_powers_ten[m_conf_params.digits_for_record_number]) {
@@ -71,7 +79,8 @@ HDF5FileLayout::get_record_number_string(uint64_t record_number, // NOLINT(build
     width = 0; // tells it to revert to normal width
   }
 
-  record_number_string << m_conf_params.record_name_prefix << std::setw(width) << std::setfill('0') << record_number;
+  out += m_conf_params.record_name_prefix;
+  append_zero_padded(out, record_number, width);
 
   if (m_conf_params.digits_for_sequence_number > 0) {
 
@@ -80,10 +89,19 @@ HDF5FileLayout::get_record_number_string(uint64_t record_number, // NOLINT(build
       MF_LOG_WARNING("HDF5FileLayout.cpp") << " File Layout Not Enough Digits For Path " << seq_num << " " << m_conf_params.digits_for_sequence_number;
       width = 0; // tells it to revert to normal width
     }
-    record_number_string << "." << std::setw(width) << std::setfill('0') << seq_num;
+    out += '.';
+    append_zero_padded(out, seq_num, width);
   }
+}
 
-  return record_number_string.str();
+std::string
+HDF5FileLayout::get_record_number_string(uint64_t record_number, // NOLINT(build/unsigned)
+                                         daqdataformats::sequence_number_t seq_num) const
+{
+  std::string record_number_string;
+  record_number_string.reserve(m_conf_params.record_name_prefix.size() + 32);
+  append_record_number_string(record_number_string, record_number, seq_num);
+  return record_number_string;
 }
 
 std::string
@@ -201,13 +219,14 @@ HDF5FileLayout::get_fragment_path(uint64_t trig_num, // NOLINT(build/unsigned)
                                   daqdataformats::SourceID element_id) const
 {
 
-  auto const& path_params = get_path_params(element_id.subsystem);
+  auto const& path_template = get_element_path_template(element_id.subsystem);
 
-  std::ostringstream path_string;
-  path_string << get_trigger_number_string(trig_num, seq_num) << "/" << path_params.detector_group_name << "/"
-              << path_params.element_name_prefix << std::setw(path_params.digits_for_element_number)
-              << std::setfill('0') << element_id.id;
-  return path_string.str();
+  std::string path_string;
+  path_string.reserve(m_conf_params.record_name_prefix.size() + path_template.prefix.size() + 48);
+  append_record_number_string(path_string, trig_num, seq_num);
+  path_string += path_template.prefix;
+  append_zero_padded(path_string, element_id.id, path_template.digits);
+  return path_string;
 }
 
 /**
@@ -244,11 +263,11 @@ HDF5FileLayout::get_fragment_type_path(uint64_t trig_num, // NOLINT(build/unsign
                                        daqdataformats::sequence_number_t seq_num,
                                        daqdataformats::SourceID::Subsystem type) const
 {
-  auto const& path_params = get_path_params(type);
+  auto const& path_template = get_element_path_template(type);
 
-  std::ostringstream path_string;
-  path_string << get_trigger_number_string(trig_num, seq_num) << "/" << path_params.detector_group_name;
-  return path_string.str();
+  std::string path_string = get_trigger_number_string(trig_num, seq_num);
+  path_string += path_template.type_path;
+  return path_string;
 }
 
 /**
@@ -289,6 +308,11 @@ HDF5FileLayout::fill_path_params_maps(hdf5filelayout::FileLayoutParams const& fl
 
     m_path_params_map[sys_type] = path_param;
     m_detector_group_name_to_type_map[path_param.detector_group_name] = sys_type;
+
+    ElementPathTemplate& path_template = m_element_path_templates[sys_type];
+    path_template.type_path = "/" + path_param.detector_group_name;
+    path_template.prefix = path_template.type_path + "/" + path_param.element_name_prefix;
+    path_template.digits = path_param.digits_for_element_number;
   }
 }
 
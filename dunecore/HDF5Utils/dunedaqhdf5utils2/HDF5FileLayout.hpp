@@ -25,6 +25,7 @@
 
 #include "nlohmann/json.hpp"
 
+#include <charconv>
 #include <cstdint>
 #include <iomanip>
 #include <limits>
@@ -184,6 +185,43 @@ private:
    */
   std::map<std::string, daqdataformats::SourceID::Subsystem> m_detector_group_name_to_type_map;
 
+  /**
+   * @brief precomputed part of the Fragment paths of a subsystem, "/<detector group>/<element prefix>",
+   * to which only the zero-padded element number is appended
+   */
+  struct ElementPathTemplate
+  {
+    std::string type_path;   // "/<detector group>"
+    std::string prefix;      // "/<detector group>/<element prefix>"
+    int digits = 0;
+  };
+  std::map<daqdataformats::SourceID::Subsystem, ElementPathTemplate> m_element_path_templates;
+
+  /**
+   * @brief appends value to out, zero-padded to width digits, using a fixed buffer
+   */
+  static void append_zero_padded(std::string& out, uint64_t value, int width) // NOLINT(build/unsigned)
+  {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    int ndig = res.ptr - buf;
+    if (width > ndig)
+      out.append(width - ndig, '0');
+    out.append(buf, res.ptr);
+  }
+
+  /**
+   * @brief appends the record number string to out
+   */
+  void append_record_number_string(std::string& out,
+                                   uint64_t record_number, // NOLINT(build/unsigned)
+                                   daqdataformats::sequence_number_t seq_num) const;
+
+  /**
+   * @brief template for a subsystem, throws as get_path_params if it is not configured
+   */
+  const ElementPathTemplate& get_element_path_template(daqdataformats::SourceID::Subsystem type) const;
+
   // quick powers of ten lookup
   constexpr static uint64_t m_powers_ten[] // NOLINT(build/unsigned)
     = {
@@ -11,6 +11,7 @@
 #include "dunecore/HDF5Utils/dunedaqhdf5utils2/hdf5filelayout/Nljs.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <filesystem>
 #include <map>
 #include <memory>
@@ -27,6 +28,8 @@ constexpr uint32_t MAX_FILELAYOUT_VERSION = 4294967295; // NOLINT(build/unsigned
 
 HDF5RawDataFile::~HDF5RawDataFile()
 {
+  if (m_access_config.report_cache_stats && m_file_ptr)
+    report_cache_stats();
 
   // explicit destruction; not really needed, but nice to be clear...
   m_file_ptr.reset();
@@ -37,12 +40,68 @@ HDF5RawDataFile::~HDF5RawDataFile()
 /**
  * @brief Constructor for reading a file
  */
-HDF5RawDataFile::HDF5RawDataFile(const std::string& file_name)
+namespace {
+
+// HighFive property applying the FileAccessConfig to a file access property list
+struct FileAccessTuning
+{
+  const HDF5RawDataFile::FileAccessConfig& config;
+
+  void apply(hid_t fapl) const
+  {
+    const auto& cfg = config;
+    if (cfg.chunk_cache_slots > 0 || cfg.chunk_cache_bytes > 0 || cfg.chunk_cache_preemption >= 0.) {
+      int mdc_nelmts = 0;
+      size_t nslots = 0;
+      size_t nbytes = 0;
+      double w0 = 0.;
+      H5Pget_cache(fapl, &mdc_nelmts, &nslots, &nbytes, &w0);
+      if (cfg.chunk_cache_slots > 0)
+        nslots = cfg.chunk_cache_slots;
+      if (cfg.chunk_cache_bytes > 0)
+        nbytes = cfg.chunk_cache_bytes;
+      if (cfg.chunk_cache_preemption >= 0.)
+        w0 = std::min(cfg.chunk_cache_preemption, 1.);
+      if (H5Pset_cache(fapl, mdc_nelmts, nslots, nbytes, w0) < 0)
+        throw cet::exception("HDF5RawDataFile") << "Unable to set the chunk cache";
+    }
+    if (cfg.metadata_cache_bytes > 0) {
+      H5AC_cache_config_t mdc_config;
+      mdc_config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+      H5Pget_mdc_config(fapl, &mdc_config);
+      mdc_config.set_initial_size = true;
+      mdc_config.initial_size = cfg.metadata_cache_bytes;
+      mdc_config.max_size = std::max(mdc_config.max_size, cfg.metadata_cache_bytes);
+      mdc_config.min_size = std::min(mdc_config.min_size, cfg.metadata_cache_bytes);
+      if (H5Pset_mdc_config(fapl, &mdc_config) < 0)
+        throw cet::exception("HDF5RawDataFile") << "Unable to set the metadata cache size";
+    }
+    if (cfg.page_buffer_bytes > 0 && H5Pset_page_buffer_size(fapl, cfg.page_buffer_bytes, 0, 0) < 0)
+      throw cet::exception("HDF5RawDataFile") << "Unable to set the page buffer size";
+    if (cfg.meta_block_bytes > 0 && H5Pset_meta_block_size(fapl, cfg.meta_block_bytes) < 0)
+      throw cet::exception("HDF5RawDataFile") << "Unable to set the metadata block size";
+  }
+};
+
+// bytes of data held by a dataset once read into memory; the storage size is smaller
+// than this for compressed datasets
+size_t
+dataset_data_size(const HighFive::DataSet& data_set)
+{
+  return data_set.getSpace().getElementCount() * data_set.getDataType().getSize();
+}
+
+} // namespace
+
+HDF5RawDataFile::HDF5RawDataFile(const std::string& file_name, const FileAccessConfig& access_config)
   : m_open_flags(HighFive::File::ReadOnly)
+  , m_access_config(access_config)
 {
   // do the file open
   try {
-    m_file_ptr = std::make_unique<HighFive::File>(file_name, m_open_flags);
+    HighFive::FileAccessProps fapl;
+    fapl.add(FileAccessTuning{ m_access_config });
+    m_file_ptr = std::make_unique<HighFive::File>(file_name, m_open_flags, fapl);
   } catch (std::exception const& excpt) {
     throw cet::exception("HDF5RawDataFile") << " File open failure: " << file_name << " " << excpt.what();
   }
@@ -67,6 +126,37 @@ HDF5RawDataFile::HDF5RawDataFile(const std::string& file_name)
   sid_handler.fetch_file_level_geo_id_info(*m_file_ptr, m_file_level_source_id_geo_id_map);
 }
 
+void
+HDF5RawDataFile::report_cache_stats() const
+{
+  hid_t fid = m_file_ptr->getId();
+  double mdc_hit_rate = 0.;
+  size_t mdc_max_size = 0;
+  size_t mdc_min_clean_size = 0;
+  size_t mdc_cur_size = 0;
+  int mdc_cur_num_entries = 0;
+  if (H5Fget_mdc_hit_rate(fid, &mdc_hit_rate) >= 0 &&
+      H5Fget_mdc_size(fid, &mdc_max_size, &mdc_min_clean_size, &mdc_cur_size, &mdc_cur_num_entries) >= 0) {
+    MF_LOG_INFO("HDF5RawDataFile") << get_file_name() << ": metadata cache hit rate " << mdc_hit_rate << ", size "
+                                   << mdc_cur_size << " of " << mdc_max_size << " bytes in " << mdc_cur_num_entries
+                                   << " entries";
+  }
+  if (m_access_config.page_buffer_bytes > 0) {
+    // index 0 counts metadata pages, index 1 raw data pages
+    unsigned accesses[2] = { 0, 0 };
+    unsigned hits[2] = { 0, 0 };
+    unsigned misses[2] = { 0, 0 };
+    unsigned evictions[2] = { 0, 0 };
+    unsigned bypasses[2] = { 0, 0 };
+    if (H5Fget_page_buffering_stats(fid, accesses, hits, misses, evictions, bypasses) >= 0) {
+      MF_LOG_INFO("HDF5RawDataFile") << get_file_name() << ": page buffer metadata hits " << hits[0] << "/"
+                                     << accesses[0] << ", raw data hits " << hits[1] << "/" << accesses[1]
+                                     << ", evictions " << evictions[0] + evictions[1] << ", bypasses "
+                                     << bypasses[0] + bypasses[1];
+    }
+  }
+}
+
 void
 HDF5RawDataFile::read_file_layout()
 {
@@ -136,17 +226,18 @@ HDF5RawDataFile::explore_subgroup(const HighFive::Group& parent_group,
   }
 }
 
-void
-HDF5RawDataFile::add_record_level_info_to_caches_if_needed(record_id_t rid)
+const HDF5RawDataFile::RecordIndex&
+HDF5RawDataFile::get_record_index(const record_id_t& rid)
 {
-  // we should probably check that all relevant caches have an entry for the
-  // specified record ID, but we will just check one, in the interest of
-  // performance, and trust the "else" part of this routine to fill in *all*
-  // of the appropriate caches
-  if (m_source_id_path_cache.count(rid) != 0) {
-    return;
+  auto irec = m_record_index_cache.find(rid);
+  if (irec != m_record_index_cache.end()) {
+    return irec->second;
   }
 
+  // check the record ID against the cached list, without copying it
+  if (!has_record_id(rid))
+    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
+
   // create the handler to do the work
   HDF5SourceIDHandler sid_handler(get_version());
 
@@ -157,48 +248,58 @@ HDF5RawDataFile::add_record_level_info_to_caches_if_needed(record_id_t rid)
     throw cet::exception("HDF5RawDataFile.cpp") << "Invalid HDF5 Group: " << record_level_group_name;
   }
 
+  RecordIndex rec_index;
+
   // start with a copy of the file-level source-id-to-geo-id map and give the
   // handler an opportunity to add any record-level additions
-  HDF5SourceIDHandler::source_id_geo_id_map_t local_source_id_geo_id_map = m_file_level_source_id_geo_id_map;
-  sid_handler.fetch_record_level_geo_id_info(record_group, local_source_id_geo_id_map);
+  rec_index.source_id_geo_ids = m_file_level_source_id_geo_id_map;
+  sid_handler.fetch_record_level_geo_id_info(record_group, rec_index.source_id_geo_ids);
 
-  // fetch the record-level source-id-to-path map
-  HDF5SourceIDHandler::source_id_path_map_t source_id_path_map;
-  sid_handler.fetch_source_id_path_info(record_group, source_id_path_map);
-
-  // fetch the record-level fragment-type-to-source-id map
-  HDF5SourceIDHandler::fragment_type_source_id_map_t fragment_type_source_id_map;
-  sid_handler.fetch_fragment_type_source_id_info(record_group, fragment_type_source_id_map);
-
-  // fetch the record-level subdetector-to-source-id map
-  HDF5SourceIDHandler::subdetector_source_id_map_t subdetector_source_id_map;
-  sid_handler.fetch_subdetector_source_id_info(record_group, subdetector_source_id_map);
+  // fetch the record-level source-id-to-path, fragment-type-to-source-id and
+  // subdetector-to-source-id maps
+  sid_handler.fetch_source_id_path_info(record_group, rec_index.source_id_paths);
+  sid_handler.fetch_fragment_type_source_id_info(record_group, rec_index.fragment_type_source_ids);
+  sid_handler.fetch_subdetector_source_id_info(record_group, rec_index.subdetector_source_ids);
 
   // loop through the source-id-to-path map to create various lists of SourceIDs in the record
-  daqdataformats::SourceID rh_sid = sid_handler.fetch_record_header_source_id(record_group);
-  std::set<daqdataformats::SourceID> full_source_id_set;
-  std::set<daqdataformats::SourceID> fragment_source_id_set;
-  HDF5SourceIDHandler::subsystem_source_id_map_t subsystem_source_id_map;
-  for (auto const& source_id_path : source_id_path_map) {
-    full_source_id_set.insert(source_id_path.first);
-    if (source_id_path.first != rh_sid) {
-      fragment_source_id_set.insert(source_id_path.first);
+  rec_index.record_header_source_id = sid_handler.fetch_record_header_source_id(record_group);
+  for (auto const& source_id_path : rec_index.source_id_paths) {
+    rec_index.source_ids.insert(source_id_path.first);
+    if (source_id_path.first != rec_index.record_header_source_id) {
+      rec_index.fragment_source_ids.insert(source_id_path.first);
+      rec_index.fragment_dataset_paths.push_back(source_id_path.second);
     }
     HDF5SourceIDHandler::add_subsystem_source_id_to_map(
-      subsystem_source_id_map, source_id_path.first.subsystem, source_id_path.first);
+      rec_index.subsystem_source_ids, source_id_path.first.subsystem, source_id_path.first);
+  }
+
+  // reverse lookup for get_source_id_for_geo_id; the first SourceID listing a geo ID wins
+  for (auto const& map_entry : rec_index.source_id_geo_ids) {
+    for (auto const& geo_id : map_entry.second) {
+      rec_index.geo_id_source_ids.emplace(geo_id, map_entry.first);
+    }
   }
 
   // note that even if the "fetch" methods above fail to add anything to the specified
   // maps, the maps will still be valid (though, possibly empty), and once we add them
-  // to the caches here, we will be assured that lookups from the caches will not fail.
-  m_source_id_cache[rid] = full_source_id_set;
-  m_record_header_source_id_cache[rid] = rh_sid;
-  m_fragment_source_id_cache[rid] = fragment_source_id_set;
-  m_source_id_geo_id_cache[rid] = local_source_id_geo_id_map;
-  m_source_id_path_cache[rid] = source_id_path_map;
-  m_subsystem_source_id_cache[rid] = subsystem_source_id_map;
-  m_fragment_type_source_id_cache[rid] = fragment_type_source_id_map;
-  m_subdetector_source_id_cache[rid] = subdetector_source_id_map;
+  // to the cache here, we will be assured that lookups from the cache will not fail.
+  return m_record_index_cache.emplace(rid, std::move(rec_index)).first->second;
+}
+
+bool
+HDF5RawDataFile::has_record_id(const record_id_t& rid)
+{
+  if (m_all_record_ids_in_file.empty())
+    get_all_record_ids();
+  return m_all_record_ids_in_file.count(rid) != 0;
+}
+
+const std::string&
+HDF5RawDataFile::RecordIndex::path(const daqdataformats::SourceID& source_id) const
+{
+  static const std::string empty_path;
+  auto ipath = source_id_paths.find(source_id);
+  return ipath == source_id_paths.end() ? empty_path : ipath->second;
 }
 
 /**
@@ -342,15 +443,14 @@ HDF5RawDataFile::get_timeslice_header_dataset_paths()
 std::string
 HDF5RawDataFile::get_record_header_dataset_path(const record_id_t& rid)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
+  if (!has_record_id(rid))
     throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
 
   if (get_version() <= 2) {
     return (m_file_ptr->getPath() + m_file_layout_ptr->get_record_header_path(rid.first, rid.second));
   } else {
-    daqdataformats::SourceID source_id = get_record_header_source_id(rid);
-    return m_source_id_path_cache[rid][source_id];
+    auto const& rec_index = get_record_index(rid);
+    return rec_index.path(rec_index.record_header_source_id);
   }
 }
 
@@ -413,8 +513,7 @@ HDF5RawDataFile::get_all_fragment_dataset_paths()
 std::vector<std::string>
 HDF5RawDataFile::get_fragment_dataset_paths(const record_id_t& rid)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
+  if (!has_record_id(rid))
     throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
 
   std::vector<std::string> frag_paths;
@@ -427,10 +526,7 @@ HDF5RawDataFile::get_fragment_dataset_paths(const record_id_t& rid)
         frag_paths.push_back(path);
     }
   } else {
-    std::set<daqdataformats::SourceID> source_id_list = get_fragment_source_ids(rid);
-    for (auto const& source_id : source_id_list) {
-      frag_paths.push_back(m_source_id_path_cache[rid][source_id]);
-    }
+    frag_paths = get_record_index(rid).fragment_dataset_paths;
   }
   return frag_paths;
 }
@@ -454,9 +550,9 @@ HDF5RawDataFile::get_fragment_dataset_paths(const daqdataformats::SourceID::Subs
                                         m_file_layout_ptr->get_fragment_type_path(rid.first, rid.second, subsystem));
       frag_paths.insert(frag_paths.end(), datasets.begin(), datasets.end());
     } else {
-      std::set<daqdataformats::SourceID> source_id_list = get_source_ids_for_subsystem(rid, subsystem);
-      for (auto const& source_id : source_id_list) {
-        frag_paths.push_back(m_source_id_path_cache[rid][source_id]);
+      auto const& rec_index = get_record_index(rid);
+      for (auto const& source_id : rec_index.source_ids_for(rec_index.subsystem_source_ids, subsystem)) {
+        frag_paths.push_back(rec_index.path(source_id));
       }
     }
   }
@@ -473,8 +569,7 @@ HDF5RawDataFile::get_fragment_dataset_paths(const std::string& subsystem_name)
 std::vector<std::string>
 HDF5RawDataFile::get_fragment_dataset_paths(const record_id_t& rid, const daqdataformats::SourceID::Subsystem subsystem)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
+  if (!has_record_id(rid))
     throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
 
   if (get_version() <= 2) {
@@ -482,9 +577,9 @@ HDF5RawDataFile::get_fragment_dataset_paths(const record_id_t& rid, const daqdat
                              m_file_layout_ptr->get_fragment_type_path(rid.first, rid.second, subsystem));
   } else {
     std::vector<std::string> frag_paths;
-    std::set<daqdataformats::SourceID> source_id_list = get_source_ids_for_subsystem(rid, subsystem);
-    for (auto const& source_id : source_id_list) {
-      frag_paths.push_back(m_source_id_path_cache[rid][source_id]);
+    auto const& rec_index = get_record_index(rid);
+    for (auto const& source_id : rec_index.source_ids_for(rec_index.subsystem_source_ids, subsystem)) {
+      frag_paths.push_back(rec_index.path(source_id));
     }
     return frag_paths;
   }
@@ -565,14 +660,10 @@ HDF5RawDataFile::get_all_geo_ids()
 std::set<uint64_t> // NOLINT(build/unsigned)
 HDF5RawDataFile::get_geo_ids(const record_id_t& rid)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
-
-  add_record_level_info_to_caches_if_needed(rid);
+  auto const& rec_index = get_record_index(rid);
 
   std::set<uint64_t> set_of_geo_ids;
-  for (auto const& map_entry : m_source_id_geo_id_cache[rid]) {
+  for (auto const& map_entry : rec_index.source_id_geo_ids) {
     for (auto const& geo_id : map_entry.second) {
       set_of_geo_ids.insert(geo_id);
     }
@@ -584,14 +675,10 @@ std::set<uint64_t> // NOLINT(build/unsigned)
 HDF5RawDataFile::get_geo_ids_for_subdetector(const record_id_t& rid,
                                              const detdataformats::DetID::Subdetector subdet)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
-
-  add_record_level_info_to_caches_if_needed(rid);
+  auto const& rec_index = get_record_index(rid);
 
   std::set<uint64_t> set_of_geo_ids;
-  for (auto const& map_entry : m_source_id_geo_id_cache[rid]) {
+  for (auto const& map_entry : rec_index.source_id_geo_ids) {
     for (auto const& geo_id : map_entry.second) {
 
       // auto geo_info = detchannelmaps::HardwareMapService::parse_geo_id(geo_id);
@@ -611,74 +698,50 @@ HDF5RawDataFile::get_geo_ids_for_subdetector(const record_id_t& rid,
 std::set<daqdataformats::SourceID>
 HDF5RawDataFile::get_source_ids(const record_id_t& rid)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
+  auto const& rec_index = get_record_index(rid);
 
-  add_record_level_info_to_caches_if_needed(rid);
-
-  return m_source_id_cache[rid];
+  return rec_index.source_ids;
 }
 
 daqdataformats::SourceID
 HDF5RawDataFile::get_record_header_source_id(const record_id_t& rid)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
-
-  add_record_level_info_to_caches_if_needed(rid);
+  auto const& rec_index = get_record_index(rid);
 
-  return m_record_header_source_id_cache[rid];
+  return rec_index.record_header_source_id;
 }
 
 std::set<daqdataformats::SourceID>
 HDF5RawDataFile::get_fragment_source_ids(const record_id_t& rid)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
-
-  add_record_level_info_to_caches_if_needed(rid);
+  auto const& rec_index = get_record_index(rid);
 
-  return m_fragment_source_id_cache[rid];
+  return rec_index.fragment_source_ids;
 }
 
 std::set<daqdataformats::SourceID>
 HDF5RawDataFile::get_source_ids_for_subsystem(const record_id_t& rid,
                                               const daqdataformats::SourceID::Subsystem subsystem)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
-
-  add_record_level_info_to_caches_if_needed(rid);
+  auto const& rec_index = get_record_index(rid);
 
-  return m_subsystem_source_id_cache[rid][subsystem];
+  return rec_index.source_ids_for(rec_index.subsystem_source_ids, subsystem);
 }
 
 std::set<daqdataformats::SourceID>
 HDF5RawDataFile::get_source_ids_for_fragment_type(const record_id_t& rid, const daqdataformats::FragmentType frag_type)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
+  auto const& rec_index = get_record_index(rid);
 
-  add_record_level_info_to_caches_if_needed(rid);
-
-  return m_fragment_type_source_id_cache[rid][frag_type];
+  return rec_index.source_ids_for(rec_index.fragment_type_source_ids, frag_type);
 }
 
 std::set<daqdataformats::SourceID>
 HDF5RawDataFile::get_source_ids_for_subdetector(const record_id_t& rid, const detdataformats::DetID::Subdetector subdet)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
+  auto const& rec_index = get_record_index(rid);
 
-  add_record_level_info_to_caches_if_needed(rid);
-
-  return m_subdetector_source_id_cache[rid][subdet];
+  return rec_index.source_ids_for(rec_index.subdetector_source_ids, subdet);
 }
 
 std::unique_ptr<char[]>
@@ -691,7 +754,7 @@ HDF5RawDataFile::get_dataset_raw_data(const std::string& dataset_path)
   if (!data_set.isValid())
     throw cet::exception("HDF5RawDataFile.cpp") << "Invalid HDF5 Dataset: " << dataset_path << " " << get_file_name();
 
-  size_t data_size = data_set.getStorageSize();
+  size_t data_size = dataset_data_size(data_set);
 
   auto membuffer = std::make_unique<char[]>(data_size);
   data_set.read(membuffer.get());
@@ -713,13 +776,9 @@ HDF5RawDataFile::get_frag_ptr(const record_id_t& rid, const daqdataformats::Sour
   if (get_version() < 2)
     throw cet::exception("HDF5RawDataFile.cpp") << "Incompatible File Layout Version: " <<  get_version() << " 2 " << MAX_FILELAYOUT_VERSION;
 
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
-
-  add_record_level_info_to_caches_if_needed(rid);
+  auto const& rec_index = get_record_index(rid);
 
-  return get_frag_ptr(m_source_id_path_cache[rid][source_id]);
+  return get_frag_ptr(rec_index.path(source_id));
 }
 
 std::unique_ptr<daqdataformats::Fragment>
@@ -788,6 +847,52 @@ HDF5RawDataFile::get_frag_ptr(const uint64_t rec_num, // NOLINT(build/unsigned)
   return get_frag_ptr(rid, geo_id);
 }
 
+HDF5RawDataFile::FragmentArena
+HDF5RawDataFile::get_frags(const record_id_t& rid, const std::set<daqdataformats::SourceID>& source_ids)
+{
+  if (get_version() < 2)
+    throw cet::exception("HDF5RawDataFile.cpp") << "Incompatible File Layout Version: " <<  get_version() << " 2 " << MAX_FILELAYOUT_VERSION;
+
+  auto const& path_map = get_record_index(rid).source_id_paths;
+
+  // first pass: open the datasets and lay them out in the buffer, keeping each
+  // fragment aligned for its header fields
+
+  const size_t alignment = alignof(std::max_align_t);
+  std::vector<HighFive::DataSet> data_sets;
+  std::vector<size_t> offsets;
+  data_sets.reserve(source_ids.size());
+  offsets.reserve(source_ids.size());
+  FragmentArena arena;
+  arena.source_ids.reserve(source_ids.size());
+  HighFive::Group parent_group = m_file_ptr->getGroup("/");
+  for (auto const& sid : source_ids) {
+    auto ipath = path_map.find(sid);
+    if (ipath == path_map.end())
+      throw cet::exception("HDF5RawDataFile.cpp") << "SourceID Not Found in record " << rid.first << " " << rid.second
+                                                   << ": " << sid;
+    HighFive::DataSet data_set = parent_group.getDataSet(ipath->second);
+    if (!data_set.isValid())
+      throw cet::exception("HDF5RawDataFile.cpp") << "Invalid HDF5 Dataset: " << ipath->second << " " << get_file_name();
+    offsets.push_back(arena.buffer_size);
+    arena.buffer_size += (dataset_data_size(data_set) + alignment - 1) / alignment * alignment;
+    data_sets.push_back(std::move(data_set));
+    arena.source_ids.push_back(sid);
+  }
+
+  // second pass: read everything into the single buffer
+
+  arena.buffer = std::make_unique<char[]>(arena.buffer_size);
+  arena.fragments.reserve(data_sets.size());
+  for (size_t i = 0; i < data_sets.size(); ++i) {
+    char* pfrag = arena.buffer.get() + offsets[i];
+    data_sets[i].read(pfrag);
+    arena.fragments.push_back(std::make_unique<daqdataformats::Fragment>(
+      pfrag, dunedaq::daqdataformats::Fragment::BufferAdoptionMode::kReadOnlyMode));
+  }
+  return arena;
+}
+
 std::unique_ptr<daqdataformats::TriggerRecordHeader>
 HDF5RawDataFile::get_trh_ptr(const std::string& dataset_name)
 {
@@ -802,14 +907,9 @@ HDF5RawDataFile::get_trh_ptr(const record_id_t& rid)
   if (get_version() < 2)
     throw cet::exception("HDF5RawDataFile.cpp") << "Incompatible File Layout Version: " <<  get_version() << " 2 " << MAX_FILELAYOUT_VERSION;
 
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
-
-  add_record_level_info_to_caches_if_needed(rid);
+  auto const& rec_index = get_record_index(rid);
 
-  daqdataformats::SourceID rh_source_id = m_record_header_source_id_cache[rid];
-  return get_trh_ptr(m_source_id_path_cache[rid][rh_source_id]);
+  return get_trh_ptr(rec_index.path(rec_index.record_header_source_id));
 }
 
 std::unique_ptr<daqdataformats::TimeSliceHeader>
@@ -827,14 +927,9 @@ HDF5RawDataFile::get_tsh_ptr(const record_id_t& rid)
   if (get_version() < 2)
     throw cet::exception("HDF5RawDataFile.cpp") << "Incompatible File Layout Version: " <<  get_version() << " 2 " << MAX_FILELAYOUT_VERSION;
 
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
-
-  add_record_level_info_to_caches_if_needed(rid);
+  auto const& rec_index = get_record_index(rid);
 
-  daqdataformats::SourceID rh_source_id = m_record_header_source_id_cache[rid];
-  return get_tsh_ptr(m_source_id_path_cache[rid][rh_source_id]);
+  return get_tsh_ptr(rec_index.path(rec_index.record_header_source_id));
 }
 
 daqdataformats::TriggerRecord
@@ -862,35 +957,23 @@ HDF5RawDataFile::get_timeslice(const daqdataformats::timeslice_number_t ts_num)
 std::vector<uint64_t> // NOLINT(build/unsigned)
 HDF5RawDataFile::get_geo_ids_for_source_id(const record_id_t& rid, const daqdataformats::SourceID& source_id)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
+  auto const& rec_index = get_record_index(rid);
 
-  add_record_level_info_to_caches_if_needed(rid);
-
-  return m_source_id_geo_id_cache[rid][source_id];
+  auto igeo = rec_index.source_id_geo_ids.find(source_id);
+  if (igeo == rec_index.source_id_geo_ids.end())
+    return std::vector<uint64_t>(); // NOLINT(build/unsigned)
+  return igeo->second;
 }
 
 daqdataformats::SourceID
 HDF5RawDataFile::get_source_id_for_geo_id(const record_id_t& rid,
                                           const uint64_t requested_geo_id) // NOLINT(build/unsigned)
 {
-  auto rec_id = get_all_record_ids().find(rid);
-  if (rec_id == get_all_record_ids().end())
-    throw cet::exception("HDF5RawDataFile.cpp") << "Record ID Not Found: " << rid.first << " " << rid.second;
+  auto const& rec_index = get_record_index(rid);
 
-  add_record_level_info_to_caches_if_needed(rid);
-
-  // if we want to make this faster, we could build a reverse lookup cache in
-  // add_record_level_info_to_caches_if_needed() and just look up the requested geo_id here
-  for (auto const& map_entry : m_source_id_geo_id_cache[rid]) {
-    auto geoid_list = map_entry.second;
-    for (auto const& geoid_from_list : geoid_list) {
-      if (geoid_from_list == requested_geo_id) {
-        return map_entry.first;
-      }
-    }
-  }
+  auto isid = rec_index.geo_id_source_ids.find(requested_geo_id);
+  if (isid != rec_index.geo_id_source_ids.end())
+    return isid->second;
 
   daqdataformats::SourceID empty_sid;
   return empty_sid;
@@ -41,6 +41,7 @@
 #include <set>
 #include <string>
 #include <sys/statvfs.h>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -68,15 +69,46 @@ public:
   typedef std::pair<uint64_t, daqdataformats::sequence_number_t> record_id_t; // NOLINT(build/unsigned)
   typedef std::set<record_id_t, std::less<>> record_id_set;
 
+  /**
+   * @brief File access tuning applied to the HDF5 file access property list.
+   * A value of zero leaves the corresponding HDF5 default in place.
+   */
+  struct FileAccessConfig
+  {
+    size_t chunk_cache_slots = 0;          // number of hash slots in the raw data chunk cache
+    size_t chunk_cache_bytes = 0;          // total size of the raw data chunk cache
+    double chunk_cache_preemption = -1.;   // w0 preemption policy in [0,1], negative for the default
+    size_t metadata_cache_bytes = 0;       // initial size of the metadata cache
+    size_t page_buffer_bytes = 0;          // page buffer size; only valid for files written with paged aggregation
+    size_t meta_block_bytes = 0;           // metadata block aggregation size
+    bool report_cache_stats = false;       // log metadata cache and page buffer statistics at close
+  };
+
+  /**
+   * @brief The fragments of one record read in a single pass into one contiguous buffer.
+   * The fragments are read-only views into the buffer, so they are valid only while
+   * the arena is alive.  fragments[i] comes from source_ids[i].
+   */
+  struct FragmentArena
+  {
+    std::unique_ptr<char[]> buffer;
+    size_t buffer_size = 0;
+    std::vector<daqdataformats::SourceID> source_ids;
+    std::vector<std::unique_ptr<daqdataformats::Fragment>> fragments;
+  };
+
   // removed constructor for writing
 
   // constructor for reading
-  explicit HDF5RawDataFile(const std::string& file_name);
+  explicit HDF5RawDataFile(const std::string& file_name, const FileAccessConfig& access_config = FileAccessConfig());
 
   ~HDF5RawDataFile();
 
   std::string get_file_name() const { return m_file_ptr->getName(); }
 
+  // HDF5 identifier of the open file, for reading it with the HDF5 C API
+  hid_t get_file_id() const { return m_file_ptr->getId(); }
+
   size_t get_recorded_size() const noexcept { return m_recorded_size; }
 
   std::string get_record_type() const noexcept { return m_record_type; }
@@ -155,6 +187,12 @@ public:
   //get a list of all the geo ids anywhere in the file
   std::set<uint64_t> get_all_geo_ids(); // NOLINT(build/unsigned)
 
+  // get the file-level SourceID-to-GeoID map (record-level additions are not included)
+  const HDF5SourceIDHandler::source_id_geo_id_map_t& get_file_level_source_id_geo_id_map() const
+  {
+    return m_file_level_source_id_geo_id_map;
+  }
+
   //get GeoIDs in a record
   std::set<uint64_t> get_geo_ids(const record_id_t& rid); // NOLINT(build/unsigned)
   std::set<uint64_t> get_geo_ids(const uint64_t rec_num, //NOLINT(build/unsigned)
@@ -315,6 +353,21 @@ public:
                                                          const daqdataformats::sequence_number_t seq_num,
                                                          const uint64_t geo_id); // NOLINT(build/unsigned)
 
+  // get several fragments of a record with one allocation
+  FragmentArena get_frags(const record_id_t& rid, const std::set<daqdataformats::SourceID>& source_ids);
+  FragmentArena get_frags(const record_id_t& rid)
+  {
+    return get_frags(rid, get_fragment_source_ids(rid));
+  }
+  FragmentArena get_frags(const record_id_t& rid, const daqdataformats::SourceID::Subsystem subsystem)
+  {
+    return get_frags(rid, get_source_ids_for_subsystem(rid, subsystem));
+  }
+  FragmentArena get_frags(const record_id_t& rid, const detdataformats::DetID::Subdetector subdet)
+  {
+    return get_frags(rid, get_source_ids_for_subdetector(rid, subdet));
+  }
+
   std::unique_ptr<daqdataformats::TriggerRecordHeader> get_trh_ptr(const record_id_t& rid);
   std::unique_ptr<daqdataformats::TriggerRecordHeader> get_trh_ptr(const daqdataformats::trigger_number_t trig_num,
                                                                    const daqdataformats::sequence_number_t seq_num = 0)
@@ -354,11 +407,15 @@ private:
   std::unique_ptr<HDF5FileLayout> m_file_layout_ptr;
   const std::string m_bare_file_name;
   const unsigned m_open_flags;
+  const FileAccessConfig m_access_config;
 
   // Total size of data being written
   size_t m_recorded_size;
   std::string m_record_type;
 
+  // file access tuning
+  void report_cache_stats() const;
+
   // file layout reading
 
   void read_file_layout();
@@ -372,20 +429,44 @@ private:
                         std::string relative_path,
                         std::vector<std::string>& path_list);
 
-  // adds record-level information to caches, if needed
-  void add_record_level_info_to_caches_if_needed(record_id_t rid);
+  // per-record index of the SourceID, path and geo ID information, built on first access
+  struct RecordIndex
+  {
+    std::set<daqdataformats::SourceID> source_ids;
+    daqdataformats::SourceID record_header_source_id;
+    std::set<daqdataformats::SourceID> fragment_source_ids;
+    std::vector<std::string> fragment_dataset_paths; // in SourceID order, layout version > 2
+    HDF5SourceIDHandler::source_id_path_map_t source_id_paths;
+    HDF5SourceIDHandler::source_id_geo_id_map_t source_id_geo_ids;
+    std::unordered_map<uint64_t, daqdataformats::SourceID> geo_id_source_ids; // NOLINT(build/unsigned)
+    HDF5SourceIDHandler::subsystem_source_id_map_t subsystem_source_ids;
+    HDF5SourceIDHandler::fragment_type_source_id_map_t fragment_type_source_ids;
+    HDF5SourceIDHandler::subdetector_source_id_map_t subdetector_source_ids;
+
+    // dataset path for a SourceID, empty if it is not in the record
+    const std::string& path(const daqdataformats::SourceID& source_id) const;
+
+    // entry of one of the key-to-SourceID maps, empty if the key is not there
+    template<typename M>
+    static const std::set<daqdataformats::SourceID>& source_ids_for(const M& source_id_map,
+                                                                    const typename M::key_type& key)
+    {
+      static const std::set<daqdataformats::SourceID> empty_set;
+      auto ientry = source_id_map.find(key);
+      return ientry == source_id_map.end() ? empty_set : ientry->second;
+    }
+  };
+
+  // returns the index for a record, building it if needed; throws if the record is not in the file
+  const RecordIndex& get_record_index(const record_id_t& rid);
+
+  // checks a record ID against the cached list of records without copying it
+  bool has_record_id(const record_id_t& rid);
 
   // caches of full-file and record-specific information
   record_id_set m_all_record_ids_in_file;
   HDF5SourceIDHandler::source_id_geo_id_map_t m_file_level_source_id_geo_id_map;
-  std::map<record_id_t, std::set<daqdataformats::SourceID>> m_source_id_cache;
-  std::map<record_id_t, daqdataformats::SourceID> m_record_header_source_id_cache;
-  std::map<record_id_t, std::set<daqdataformats::SourceID>> m_fragment_source_id_cache;
-  std::map<record_id_t, HDF5SourceIDHandler::source_id_path_map_t> m_source_id_path_cache;
-  std::map<record_id_t, HDF5SourceIDHandler::source_id_geo_id_map_t> m_source_id_geo_id_cache;
-  std::map<record_id_t, HDF5SourceIDHandler::subsystem_source_id_map_t> m_subsystem_source_id_cache;
-  std::map<record_id_t, HDF5SourceIDHandler::fragment_type_source_id_map_t> m_fragment_type_source_id_cache;
-  std::map<record_id_t, HDF5SourceIDHandler::subdetector_source_id_map_t> m_subdetector_source_id_cache;
+  std::map<record_id_t, RecordIndex> m_record_index_cache;
 };
 
 // HDF5RawDataFile attribute getters definitions
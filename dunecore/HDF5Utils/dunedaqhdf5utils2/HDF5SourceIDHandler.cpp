@@ -9,9 +9,69 @@
 #include "dunecore/HDF5Utils/dunedaqhdf5utils2/HDF5SourceIDHandler.hpp"
 #include "dunecore/HDF5Utils/dunedaqhdf5utils2/hdf5sourceidmaps/Nljs.hpp"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace dunedaq {
 namespace hdf5libs {
 
+namespace {
+
+/**
+ * Parse results for recently seen attribute strings.  Apart from the path map, the
+ * record-level maps are normally identical for all of the records in a file, so
+ * after the first record the JSON parsing is replaced by a hash lookup and a copy.
+ * The cache is shared between handlers (one is made per record) and threads.
+ */
+template<typename T>
+class ParseCache
+{
+public:
+  template<typename P>
+  void fetch(const std::string& json_string, T& result, P parse)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto ientry = m_entries.find(json_string);
+      if (ientry != m_entries.end()) {
+        merge(ientry->second, result);
+        return;
+      }
+    }
+    T parsed{};
+    parse(json_string, parsed);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.size() >= s_max_entries)
+      m_entries.clear();
+    merge(m_entries.emplace(json_string, std::move(parsed)).first->second, result);
+  }
+
+private:
+  static constexpr size_t s_max_entries = 16;
+
+  // same effect as parsing into result: entries already there are overwritten
+  template<typename K, typename V>
+  static void merge(const std::map<K, V>& from, std::map<K, V>& to)
+  {
+    if (to.empty()) {
+      to = from;
+      return;
+    }
+    for (auto const& entry : from)
+      to.insert_or_assign(entry.first, entry.second);
+  }
+  static void merge(const daqdataformats::SourceID& from, daqdataformats::SourceID& to) { to = from; }
+
+  std::mutex m_mutex;
+  std::unordered_map<std::string, T> m_entries;
+};
+
+ParseCache<daqdataformats::SourceID> record_header_source_id_cache;
+ParseCache<HDF5SourceIDHandler::fragment_type_source_id_map_t> fragment_type_source_id_map_cache;
+ParseCache<HDF5SourceIDHandler::subdetector_source_id_map_t> subdetector_source_id_map_cache;
+
+} // namespace
+
 void
 HDF5SourceIDHandler::store_file_level_geo_id_info(HighFive::File& h5_file, const source_id_geo_id_map_t& the_map)
 {
@@ -79,7 +139,8 @@ HDF5SourceIDHandler::fetch_record_header_source_id(const HighFive::Group& record
   if (m_version >= 3) {
     try {
       std::string sid_string = get_attribute<HighFive::Group, std::string>(record_group, "record_header_source_id");
-      parse_json_string(sid_string, source_id);
+      record_header_source_id_cache.fetch(
+        sid_string, source_id, [](const std::string& js, daqdataformats::SourceID& sid) { parse_json_string(js, sid); });
     } catch (...) {
     }
   }
@@ -106,7 +167,10 @@ HDF5SourceIDHandler::fetch_fragment_type_source_id_info(const HighFive::Group& r
   if (m_version >= 3) {
     try {
       std::string map_string = get_attribute<HighFive::Group, std::string>(record_group, "fragment_type_source_id_map");
-      parse_json_string(map_string, fragment_type_source_id_map);
+      fragment_type_source_id_map_cache.fetch(
+        map_string, fragment_type_source_id_map, [](const std::string& js, fragment_type_source_id_map_t& the_map) {
+          parse_json_string(js, the_map);
+        });
     } catch (...) {
     }
   }
@@ -119,7 +183,10 @@ HDF5SourceIDHandler::fetch_subdetector_source_id_info(const HighFive::Group& rec
   if (m_version >= 3) {
     try {
       std::string map_string = get_attribute<HighFive::Group, std::string>(record_group, "subdetector_source_id_map");
-      parse_json_string(map_string, subdetector_source_id_map);
+      subdetector_source_id_map_cache.fetch(
+        map_string, subdetector_source_id_map, [](const std::string& js, subdetector_source_id_map_t& the_map) {
+          parse_json_string(js, the_map);
+        });
     } catch (...) {
     }
   }
@@ -298,11 +365,13 @@ HDF5SourceIDHandler::parse_json_string(const std::string& json_string, source_id
   hdf5sourceidmaps::SourceIDPathMap json_struct;
   hdf5sourceidmaps::data_t json_tmp_data = nlohmann::json::parse(json_string);
   hdf5sourceidmaps::from_json(json_tmp_data, json_struct);
-  for (auto const& json_element : json_struct.map_entries) {
+  // the map is written from a std::map, so the entries normally arrive in order and
+  // inserting at the end is constant time
+  for (auto& json_element : json_struct.map_entries) {
     daqdataformats::SourceID::Subsystem subsys = static_cast<daqdataformats::SourceID::Subsystem>(json_element.subsys);
     daqdataformats::SourceID::ID_t id = static_cast<daqdataformats::SourceID::ID_t>(json_element.id);
     daqdataformats::SourceID source_id(subsys, id);
-    source_id_path_map[source_id] = json_element.path;
+    source_id_path_map.insert_or_assign(source_id_path_map.end(), source_id, std::move(json_element.path));
   }
 }
 
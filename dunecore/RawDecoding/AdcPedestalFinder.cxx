@@ -0,0 +1,103 @@
+// AdcPedestalFinder.cxx
+
+#include "AdcPedestalFinder.h"
+
+#include <cmath>
+
+//**********************************************************************
+
+dune::AdcPedestalFinder::Pedestal
+dune::AdcPedestalFinder::evaluate(const AdcCount* adcs, size_t nsam)
+{
+  Pedestal ped;
+  if (nsam == 0) return ped;
+
+  // range of the data, so only the occupied part of the histogram is touched
+
+  int amin = adcs[0];
+  int amax = adcs[0];
+  long long sum = 0;
+  for (size_t isam = 0; isam < nsam; ++isam)
+    {
+      int adc = adcs[isam];
+      if (adc < amin) amin = adc;
+      if (adc > amax) amax = adc;
+      sum += adc;
+    }
+  size_t nbin = amax - amin + 1;
+  fCounts.assign(nbin, 0);
+  unsigned int* counts = fCounts.data() - amin;
+  for (size_t isam = 0; isam < nsam; ++isam) ++counts[adcs[isam]];
+
+  // median: the middle order statistic, or the mean of the two middle ones for even N,
+  // as in TMath::Median
+
+  size_t khi = nsam/2;
+  size_t klo = (nsam % 2 == 1) ? khi : khi - 1;
+  int vlo = amin;
+  int vhi = amin;
+  size_t nbelow = 0;
+  bool foundlo = false;
+  for (int adc = amin; adc <= amax; ++adc)
+    {
+      size_t nnext = nbelow + counts[adc];
+      if (!foundlo && klo < nnext)
+        {
+          vlo = adc;
+          foundlo = true;
+        }
+      if (khi < nnext)
+        {
+          vhi = adc;
+          break;
+        }
+      nbelow = nnext;
+    }
+  double dmed = 0.5*(double(vlo) + double(vhi));
+  int imed = dmed + 0.01;  // add an offset to make sure the floor gets the right integer
+  ped.median = imed;
+
+  // standard deviation with the two-pass formula of TMath::RMS, summed over histogram bins
+
+  double mean = double(sum)/double(nsam);
+  double tot = 0.;
+  size_t s1 = 0;
+  for (int adc = amin; adc <= amax; ++adc)
+    {
+      unsigned int cnt = counts[adc];
+      if (cnt == 0) continue;
+      double dx = adc - mean;
+      tot += cnt*dx*dx;
+      if (adc < imed) s1 += cnt;
+    }
+  ped.sigma = (nsam > 1) ? std::sqrt(tot/double(nsam - 1)) : 0.;
+
+  // correction suggested by David Adams, May 6, 2019
+
+  size_t sm = (imed >= amin && imed <= amax) ? counts[imed] : 0;
+  if (sm > 0)
+    {
+      float mcorr = (-0.5 + (0.5*(float) nsam - (float) s1)/ ((float) sm) );
+      ped.correction = mcorr;
+      ped.median += mcorr;
+    }
+  return ped;
+}
+
+//**********************************************************************
+
+void dune::AdcPedestalFinder::evaluate(const AdcCount* adcs, size_t nchan, size_t nsam, Pedestal* peds)
+{
+  for (size_t ichan = 0; ichan < nchan; ++ichan)
+    {
+      peds[ichan] = evaluate(adcs + ichan*nsam, nsam);
+    }
+}
+
+//**********************************************************************
+
+void dune::AdcPedestalFinder::evaluate(const AdcCount* adcs, size_t nchan, size_t nsam, std::vector<Pedestal>& peds)
+{
+  peds.resize(nchan);
+  evaluate(adcs, nchan, nsam, peds.data());
+}
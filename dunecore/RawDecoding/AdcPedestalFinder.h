@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Class:       AdcPedestalFinder
+// File:        AdcPedestalFinder.h
+//
+// Pedestal and noise estimate for a waveform of ADC counts, as used by the raw decoders
+// to fill raw::RawDigit::SetPedestal.
+//
+// The pedestal is the sample median with the correction suggested by David Adams (May 2019)
+// that interpolates within the integer median bin:
+//   imed   = floor(median)
+//   median = imed - 0.5 + (0.5*N - N(<imed))/N(==imed)
+// and sigma is the sample standard deviation (N-1 normalization), including tails from
+// signals and bad samples.
+//
+// The values are identical to those obtained with TMath::Median and TMath::RMS but are
+// computed from a histogram of the counts: one pass to find the range, one to fill, and a
+// scan over the occupied range.  That is O(N) instead of sorting a copy of the data.
+//
+// The batch interface evaluates many channels stored back to back, e.g. the channel-major
+// output of WIB2FrameUnpacker, reusing a single histogram.
+//
+// The histogram is held by the finder, so use one finder per thread.
+//
+// art-independent class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AdcPedestalFinder_H
+#define AdcPedestalFinder_H
+
+#include <cstddef>
+#include <vector>
+
+namespace dune {
+  class AdcPedestalFinder;
+}
+
+class dune::AdcPedestalFinder {
+
+public:
+
+  typedef short AdcCount;    // same as raw::RawDigit::ADCvector_t::value_type
+
+  struct Pedestal {
+    float median = 0.;       // corrected median
+    float sigma = 0.;        // standard deviation
+    float correction = 0.;   // correction applied to the integer median
+  };
+
+  // Evaluate the pedestal for nsam samples.  Zero samples gives all zeros.
+  Pedestal evaluate(const AdcCount* adcs, size_t nsam);
+
+  // Evaluate nchan channels each with nsam samples, channel ichan starting at adcs + ichan*nsam.
+  // Results are written to peds[0..nchan-1].
+  void evaluate(const AdcCount* adcs, size_t nchan, size_t nsam, Pedestal* peds);
+
+  // Same for a vector, which is resized to nchan.
+  void evaluate(const AdcCount* adcs, size_t nchan, size_t nsam, std::vector<Pedestal>& peds);
+
+private:
+
+  std::vector<unsigned int> fCounts;   // histogram of counts, reused between calls
+
+};
+
+#endif
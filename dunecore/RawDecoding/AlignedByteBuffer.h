@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Class:       AlignedByteBuffer
+// File:        AlignedByteBuffer.h
+//
+// Grow-only, cache-line aligned raw byte buffer for staging HDF5 dataset reads.
+// Unlike std::vector<char>, growing the buffer does not zero-initialize or copy the
+// old contents, and the storage is kept between uses, so reading a dataset of a size
+// already seen costs no allocation at all.
+//
+// Use one buffer per thread, e.g. via local(), where concurrent readers are possible.
+//
+// The capacity is charged to MemoryBudget::instance() while the buffer holds it.
+//
+// art-independent class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AlignedByteBuffer_H
+#define AlignedByteBuffer_H
+
+#include "dunecore/DuneInterface/Data/MemoryBudget.h"
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <utility>
+
+namespace dune {
+  class AlignedByteBuffer;
+}
+
+class dune::AlignedByteBuffer {
+
+public:
+
+  static constexpr size_t Alignment = 64;
+
+  AlignedByteBuffer() = default;
+  AlignedByteBuffer(const AlignedByteBuffer&) = delete;
+  AlignedByteBuffer& operator=(const AlignedByteBuffer&) = delete;
+  AlignedByteBuffer(AlignedByteBuffer&& rhs) noexcept
+    : fData(std::move(rhs.fData)), fCapacity(std::exchange(rhs.fCapacity, 0)) { }
+  AlignedByteBuffer& operator=(AlignedByteBuffer&& rhs) noexcept {
+    std::swap(fData, rhs.fData);
+    std::swap(fCapacity, rhs.fCapacity);
+    return *this;
+  }
+  ~AlignedByteBuffer() { MemoryBudget::instance().release(fCapacity); }
+
+  // Make room for at least nbyte bytes and return the start of the storage.
+  // The contents are unspecified after a reallocation.
+  char* reserve(size_t nbyte) {
+    if (nbyte > fCapacity)
+      {
+        // grow geometrically so a slowly increasing fragment size does not reallocate every time
+        size_t ncap = fCapacity + fCapacity/2;
+        if (ncap < nbyte) ncap = nbyte;
+        fData.reset();
+        MemoryBudget::instance().release(fCapacity);
+        fCapacity = 0;
+        fData.reset(static_cast<char*>(::operator new(ncap, std::align_val_t(Alignment))));
+        fCapacity = ncap;
+        MemoryBudget::instance().charge(ncap);
+      }
+    return fData.get();
+  }
+
+  char* data() { return fData.get(); }
+  const char* data() const { return fData.get(); }
+  size_t capacity() const { return fCapacity; }
+
+  // Buffer owned by the calling thread.
+  static AlignedByteBuffer& local() {
+    static thread_local AlignedByteBuffer buf;
+    return buf;
+  }
+
+private:
+
+  struct Deleter {
+    void operator()(char* p) const { ::operator delete(p, std::align_val_t(Alignment)); }
+  };
+
+  std::unique_ptr<char, Deleter> fData;
+  size_t fCapacity = 0;
+
+};
+
+#endif
@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Class:       DAPHNEFrameTraits
+// File:        DAPHNEFrameTraits.h
+//
+// Frame traits for PackedFrameUnpacker describing the DAPHNE photon-detector frame: one
+// channel with 1024 time samples of 14 bits packed in the ADC words.  The header gives
+// the crate, slot and link from the DAQ header and the timestamp of the first sample;
+// the DAPHNE channel of the frame is returned by channel().
+//
+// art-independent class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DAPHNEFrameTraits_H
+#define DAPHNEFrameTraits_H
+
+#include "dunecore/RawDecoding/PackedFrameUnpacker.h"
+#include "detdataformats/daphne/DAPHNEFrame.hpp"
+#include <cstddef>
+
+namespace dune {
+  struct DAPHNEFrameTraits;
+}
+
+struct dune::DAPHNEFrameTraits {
+
+  typedef dunedaq::detdataformats::daphne::DAPHNEFrame Frame;
+
+  static constexpr size_t FrameSize = sizeof(Frame);
+  static constexpr size_t AdcOffset = offsetof(Frame, adc_words);
+  static constexpr unsigned int NChannels = 1;
+  static constexpr unsigned int NTicks = Frame::s_num_adcs;
+  static constexpr unsigned int BitsPerAdc = Frame::s_bits_per_adc;
+
+  static FrameHeader header(const uint8_t* pframe) {
+    const Frame* frame = reinterpret_cast<const Frame*>(pframe);
+    FrameHeader hdr;
+    hdr.crate = frame->daq_header.crate_id;
+    hdr.slot = frame->daq_header.slot_id;
+    hdr.link = frame->daq_header.link_id;
+    hdr.timestamp = frame->get_timestamp();
+    return hdr;
+  }
+
+  // DAPHNE channel of the frame at pframe.
+  static unsigned int channel(const uint8_t* pframe) {
+    return reinterpret_cast<const Frame*>(pframe)->header.channel;
+  }
+
+};
+
+#endif
@@ -8,10 +8,24 @@
 #include "art/Persistency/Common/PtrMaker.h"
 #include "lardataobj/RawData/RawDigit.h"
 #include "lardataobj/RawData/RDTimeStamp.h"
+#include "lardataobj/RawData/OpDetWaveform.h"
 #include "artdaq-core/Data/Fragment.hh"
 #include "dunecore/DuneObj/PDSPTPCDataInterfaceParent.h"
+#include "dunecore/DuneObj/RDTimeStampRanges.h"
+#include "dunecore/RawDecoding/WIB2FrameUnpacker.h"
+#include "dunecore/RawDecoding/WIB2FrameChecker.h"
+#include "dunecore/RawDecoding/WIB2FrameTraits.h"
+#include "dunecore/RawDecoding/DAPHNEFrameTraits.h"
+#include "dunecore/RawDecoding/AdcPedestalFinder.h"
+#include "dunecore/DuneInterface/Data/TpcData.h"
+#include "dunecore/DuneInterface/Data/MemoryBudget.h"
+#include "dunecore/DuneInterface/Data/NumaPlacement.h"
 #include "daqdataformats/v3_3_3/Fragment.hpp"
+#include "dunecore/ChannelMap/FDHDChannelMapService.h"
+#include "dunecore/HDF5Utils/HDF5Utils.h"
 #include <hdf5.h>
+#include <mutex>
+#include <unordered_map>
 
 typedef dunedaq::daqdataformats::Fragment duneFragment;
 typedef std::vector<duneFragment> duneFragments; 
@@ -45,19 +59,149 @@ class FDHDDataInterface : public PDSPTPCDataInterfaceParent {
       std::vector<raw::RDStatus> &rdstatuses,  
       std::vector<int> &apalist);
 
+  // Streaming decode for long records, e.g. TimeSlice data: same as retrieveDataForSpecifiedAPAs
+  // but only ticks [firstTick, firstTick+nTick) of each link are read from the file, so memory
+  // use is bounded by the window size.  nTick = 0 means up to the end of the record.  Call
+  // this with consecutive windows to process a record one chunk at a time; a window that
+  // starts beyond the end of the record returns no digits.  The RDTimeStamps hold the
+  // timestamp of the first frame in the window instead of the trigger timestamp.
 
+  int retrieveDataForSpecifiedAPAsInWindow(
+      art::Event &evt, std::vector<raw::RawDigit> &raw_digits,
+      std::vector<raw::RDTimeStamp> &rd_timestamps,
+      std::vector<raw::RDStatus> &rdstatuses,
+      std::vector<int> &apalist,
+      size_t firstTick, size_t nTick);
+
+  // Same as retrieveDataForSpecifiedAPAs but the timestamps are returned as one
+  // compact, time-sorted raw::RDTimeStampRanges entry per link instead of one
+  // RDTimeStamp per channel, e.g. for a producer that writes that product.
+
+  int retrieveDataForSpecifiedAPAs(
+      art::Event &evt, std::vector<raw::RawDigit> &raw_digits,
+      raw::RDTimeStampRanges &rd_timestamp_ranges,
+      std::vector<raw::RDStatus> &rdstatuses,
+      std::vector<int> &apalist);
+
+  // Decode directly into channel data without making raw::RawDigits: one
+  // AdcChannelDataMap is added to tpd for each APA in apalist, in list order.
+  // Each channel has the raw counts, the pedestal and RMS estimate, the
+  // channel clock (same timestamp as the RDTimeStamps above), channel info
+  // shared for the run, and event info shared by all channels.  The samples
+  // are copied once, from the decode buffer into AdcChannelData::raw, into
+  // channel data recycled by AdcChannelDataPool.  Use makeRawDigits if a
+  // downstream module needs the digits.
+
+  int retrieveTpcDataForSpecifiedAPAs(art::Event &evt, TpcData &tpd, std::vector<int> &apalist);
+
+  int retrieveTpcDataForSpecifiedAPAsInWindow(art::Event &evt, TpcData &tpd, std::vector<int> &apalist,
+                                              size_t firstTick, size_t nTick);
+
+  // Build the raw digits and timestamps for channel data filled as above.
+
+  static void makeRawDigits(const AdcChannelDataMap &acds, RawDigits &raw_digits, RDTimeStamps &timestamps);
+
+  // Photon-detector data: one raw::OpDetWaveform for each DAPHNE frame in the datasets
+  // of the "PDS" detector group of the record, appended to waveforms.  The decode uses
+  // the same record index, staging buffers and ParallelDecode dispatch as the TPC links
+  // and each waveform is sized once before its samples are unpacked into it.  The
+  // waveform time is the frame timestamp in DAQ clock ticks and the channel is the DAQ
+  // channel pdsChannel(crate, slot, link, DAPHNE channel); dunecore has no PDS channel
+  // map.  Returns the number of waveforms added.
+
+  int retrievePdsData(art::Event &evt, std::vector<raw::OpDetWaveform> &waveforms);
+
+  static unsigned int pdsChannel(unsigned int crate, unsigned int slot, unsigned int link,
+                                 unsigned int channel) {
+    return ((crate*16 + slot)*64 + link)*64 + channel;
+  }
 
  private:
 
   std::map<int,std::vector<std::string>> _input_labels_by_apa;
   void _collectRDStatus (std::vector<raw::RDStatus> &rdstatuses){};
-  void getFragmentsForEvent (hid_t the_group, RawDigits& raw_digits,
-                             RDTimeStamps &timestamps, int apano,
-                             unsigned int maxchan);
-  void getFragmentsForEvent (hid_t the_group, RawDigits& raw_digits,
-                             RDTimeStamps &timestamps, int apano);
-  void getMedianSigma (const raw::RawDigit::ADCvector_t &v_adc, float &median,
-                       float &sigma);
+
+  // one link dataset of an APA group
+  struct LinkRef {
+    hid_t group;                                   // record group
+    const dune::HDF5Utils::DatasetInfo* dataset;   // link dataset in the record index
+    size_t apaIndex;                               // position of the APA in the requested list
+  };
+
+  // range of ticks to decode; first = count = 0 means the full record
+  struct TickWindow {
+    size_t first;
+    size_t count;
+    bool windowed() const { return first > 0 || count > 0; }
+  };
+
+  // (WIB frame channel, offline channel, channel info) for a selected channel of a link
+  struct LinkChannel {
+    unsigned int frameChannel;
+    unsigned int offlineChannel;
+    AdcChannelData::ChannelInfoPtr info;
+  };
+  typedef std::vector<LinkChannel> LinkChannels;
+
+  // decoded samples of one link, valid on the decoding thread until its next decode
+  struct DecodedLink {
+    const dune::WIB2FrameUnpacker::AdcCount* adcs;   // channel-major, n_frames per channel
+    size_t n_frames;                                 // samples per channel
+    const dune::AdcPedestalFinder::Pedestal* peds;  // indexed by WIB frame channel
+    const LinkChannels* channels;
+    uint64_t timestamp;          // trigger time, or the first frame time for a tick window
+    uint64_t triggerTimestamp;
+    dune::WIB2FrameChecker::Result check;   // frame integrity, empty if not checked
+  };
+
+  // open the record group of the event and reset the per-run caches; returns the group
+  hid_t openRecord (art::Event &evt, dune::HDF5Utils::RecordIndexPtr &recordIndex);
+
+  void getLinkList (hid_t the_group, const dune::HDF5Utils::RecordIndex &index,
+                    const std::vector<int> &apalist, std::vector<LinkRef> &links);
+  void getFragmentsForAPAs (hid_t the_group, const dune::HDF5Utils::RecordIndex &index,
+                            RawDigits& raw_digits,
+                            RDTimeStamps &timestamps, const std::vector<int> &apalist,
+                            const TickWindow &window, dune::WIB2FrameChecker::Result &check);
+  void getFragmentForLink (const LinkRef &link, const dune::FDHDChannelMapService &channelMap,
+                           const TickWindow &window,
+                           RawDigits& raw_digits, RDTimeStamps &timestamps,
+                           dune::WIB2FrameChecker::Result &check);
+  void getAdcDataForAPAs (hid_t the_group, const dune::HDF5Utils::RecordIndex &index,
+                          const std::vector<TpcData::AdcDataPtr> &apaData,
+                          const std::vector<int> &apalist, const TickWindow &window,
+                          uint64_t &triggerTimestamp);
+  void getAdcDataForLink (const LinkRef &link, const dune::FDHDChannelMapService &channelMap,
+                          const TickWindow &window, AdcChannelDataMap &acds,
+                          uint64_t &triggerTimestamp);
+
+  // read the fragment of one link into the staging buffer; returns null if it has no frames
+  char* readLinkFrames (const LinkRef &link, size_t frameSize, const TickWindow &window,
+                        size_t &n_frames) const;
+
+  // NUMA node for each link from the position of its APA among napa
+  NumaPlacement::IndexVector linkNodes (const std::vector<LinkRef> &links, size_t napa) const;
+
+  // memory held while a parallel task decodes a link: the staged dataset and its samples.
+  // Waits for room in the MemoryBudget, so decode tasks are throttled when it is full
+  MemoryBudget::Reservation reserveDecode (const LinkRef &link) const;
+
+  // read and unpack one link in the configured frame format; returns false if it has no frames
+  bool decodeLink (const LinkRef &link, const dune::FDHDChannelMapService &channelMap,
+                   const TickWindow &window, DecodedLink &decoded);
+
+  // decodeLink for the frame format described by Traits (see PackedFrameUnpacker.h)
+  template <class Traits>
+  bool decodeLinkFrames (const LinkRef &link, const dune::FDHDChannelMapService &channelMap,
+                         const TickWindow &window, DecodedLink &decoded);
+
+  // PDS datasets of the record and decode of one of them into waveforms
+  void getPdsLinkList (hid_t the_group, const dune::HDF5Utils::RecordIndex &index,
+                       std::vector<LinkRef> &links) const;
+  void getWaveformsForLink (const LinkRef &link, std::vector<raw::OpDetWaveform> &waveforms) const;
+
+  const LinkChannels & getLinkChannels (const dune::FDHDChannelMapService &channelMap,
+                                        unsigned int crate, unsigned int slot, unsigned int link);
 
   //For nicer log syntax
   std::string logname = "FDHDDataInterface";
@@ -67,6 +211,25 @@ class FDHDDataInterface : public PDSPTPCDataInterfaceParent {
   unsigned int fDefaultCrate = 1;
   int fDebugLevel = 0;   // switch to turn on debugging printout
 
+  bool fParallelDecode = false;  // decode the links of all requested APAs concurrently
+  size_t fFirstTick = 0;         // default tick window for retrieveDataForSpecifiedAPAs
+  size_t fNTicks = 0;            // 0 = to the end of the record
+
+  // frame formats of the link datasets
+  enum FrameFormat { WIB2Format };
+  FrameFormat fFrameFormat = WIB2Format;
+  unsigned int fFrameChannels = dune::WIB2FrameTraits::NChannels;   // channels per link
+
+  dune::WIB2FrameUnpacker fUnpacker;   // bulk WIB2 frame decoder
+
+  bool fCheckFrames = true;            // check WIB2 frame headers and timestamps into the RDStatus
+  dune::WIB2FrameChecker fChecker;
+
+  // per-link channel lists keyed by WIB header (crate, slot, link), cleared when the run changes
+  std::unordered_map<unsigned int, LinkChannels> fLinkChannelCache;
+  art::RunNumber_t fLinkChannelCacheRun = 0;
+  std::mutex fLinkChannelMutex;
+
 };
 
 #endif
@@ -5,9 +5,11 @@
 #include <list>
 #include <set>
 #include <sstream>
+#include <cmath>
 #include <cstring>
+#include <iterator>
+#include <mutex>
 #include <string>
-#include "TMath.h"
 #include "TString.h"
 
 #include "art/Framework/Services/Registry/ServiceHandle.h"
@@ -15,14 +17,58 @@
 #include "dunecore/DuneObj/DUNEHDF5FileInfo.h"
 #include "dunecore/HDF5Utils/HDF5Utils.h"
 #include "detdataformats/wib2/WIB2Frame.hpp"
+#include "dunecore/RawDecoding/PackedFrameUnpacker.h"
+#include "dunecore/RawDecoding/WIB2FrameTraits.h"
+#include "dunecore/RawDecoding/DAPHNEFrameTraits.h"
+#include "cetlib_except/exception.h"
+#include <type_traits>
 #include "dunecore/ChannelMap/FDHDChannelMapService.h"
+#include "dunecore/RawDecoding/AlignedByteBuffer.h"
+#include "dunecore/RawDecoding/AdcPedestalFinder.h"
+#include "dunecore/DuneInterface/Data/AdcChannelDataPool.h"
+#include "dunecore/DuneInterface/Data/NumaPlacement.h"
+#include "dunecore/DuneInterface/Data/TraceRecorder.h"
 
 FDHDDataInterface::FDHDDataInterface(fhicl::ParameterSet const& p)
   : fFileInfoLabel(p.get<std::string>("FileInfoLabel", "daq")),
     fMaxChan(p.get<int>("MaxChan",1000000)),
     fDefaultCrate(p.get<unsigned int>("DefaultCrate", 1)),
-    fDebugLevel(p.get<int>("DebugLevel",0))
+    fDebugLevel(p.get<int>("DebugLevel",0)),
+    fParallelDecode(p.get<bool>("ParallelDecode", false)),
+    fFirstTick(p.get<size_t>("FirstTick", 0)),
+    fNTicks(p.get<size_t>("NTicks", 0)),
+    fUnpacker(p.get<bool>("UseSIMDUnpacker", true) ? dune::WIB2FrameUnpacker::AUTO : dune::WIB2FrameUnpacker::SCALAR),
+    fCheckFrames(p.get<bool>("CheckFrames", true)),
+    fChecker(p.get<uint64_t>("FrameTickIncrement", 32),
+             p.get<bool>("UseSIMDUnpacker", true) ? dune::WIB2FrameChecker::AUTO : dune::WIB2FrameChecker::SCALAR)
 {
+  if (p.get<bool>("NumaPlacement", false))
+    {
+      unsigned int nnode = NumaPlacement::instance().configure(true, p.get<unsigned int>("NumaThreadsPerNode", 0));
+      if (fDebugLevel > 0) std::cout << logname << ": NUMA nodes used: " << nnode << std::endl;
+    }
+  std::string traceFile = p.get<std::string>("TraceFile", "");
+  if (!traceFile.empty())
+    {
+      TraceRecorder::instance().configure(traceFile);
+      if (fDebugLevel > 0) std::cout << logname << ": trace file: " << traceFile << std::endl;
+    }
+  std::string frameFormat = p.get<std::string>("FrameFormat", "WIB2");
+  if (frameFormat == "WIB2")
+    {
+      fFrameFormat = WIB2Format;
+      fFrameChannels = dune::WIB2FrameTraits::NChannels;
+    }
+  else
+    {
+      throw cet::exception(logname) << "Unknown frame format: " << frameFormat;
+    }
+  if (fDebugLevel > 0)
+    {
+      std::cout << logname << ": frame format: " << frameFormat << std::endl;
+      std::cout << logname << ": WIB2 frame unpacker: " << fUnpacker.implementationName() << std::endl;
+      if (fCheckFrames) std::cout << logname << ": WIB2 frame checker: " << fChecker.implementationName() << std::endl;
+    }
 }
 
 
@@ -44,40 +90,209 @@ int FDHDDataInterface::retrieveDataForSpecifiedAPAs(art::Event &evt,
                                                     std::vector<raw::RDStatus> &rdstatuses,
                                                     std::vector<int> &apalist)
 {
-  using namespace dune::HDF5Utils;
-  auto infoHandle = evt.getHandle<raw::DUNEHDF5FileInfo>(fFileInfoLabel);
-  const std::string & toplevel_groupname = infoHandle->GetEventGroupName();
-  const std::string & file_name = infoHandle->GetFileName();
-  hid_t file_id = infoHandle->GetHDF5FileHandle();
-  hid_t the_group = getGroupFromPath(file_id, toplevel_groupname);
+  return retrieveDataForSpecifiedAPAsInWindow(evt, raw_digits, rd_timestamps, rdstatuses, apalist,
+                                              fFirstTick, fNTicks);
+}
+
 
+int FDHDDataInterface::retrieveDataForSpecifiedAPAs(art::Event &evt,
+                                                    std::vector<raw::RawDigit> &raw_digits,
+                                                    raw::RDTimeStampRanges &rd_timestamp_ranges,
+                                                    std::vector<raw::RDStatus> &rdstatuses,
+                                                    std::vector<int> &apalist)
+{
+  // The per-channel timestamps only live for the duration of the call.
+  RDTimeStamps rd_timestamps;
+  int status = retrieveDataForSpecifiedAPAsInWindow(evt, raw_digits, rd_timestamps, rdstatuses, apalist,
+                                                    fFirstTick, fNTicks);
+  rd_timestamp_ranges = raw::RDTimeStampRanges(rd_timestamps);
   if (fDebugLevel > 0)
     {
-      std::cout << "FDHDDataInterface : " << "HDF5 FileName: " << file_name << std::endl;
-      std::cout << "FDHDDataInterface :" << "Top-Level Group Name: " << toplevel_groupname << std::endl;
+      std::cout << "FDHDDataInterface : " << "Compacted " << rd_timestamps.size() << " timestamps to "
+                << rd_timestamp_ranges.size() << " entries" << std::endl;
     }
+  return status;
+}
+
+
+int FDHDDataInterface::retrieveDataForSpecifiedAPAsInWindow(art::Event &evt,
+                                                            std::vector<raw::RawDigit> &raw_digits,
+                                                            std::vector<raw::RDTimeStamp> &rd_timestamps,
+                                                            std::vector<raw::RDStatus> &rdstatuses,
+                                                            std::vector<int> &apalist,
+                                                            size_t firstTick, size_t nTick)
+{
+  using namespace dune::HDF5Utils;
+  RecordIndexPtr recordIndex;
+  hid_t the_group = openRecord(evt, recordIndex);
 
   if (fDebugLevel > 0)
     {
       std::cout << "FDHDDataInterface : " <<  "Retrieving Data for " << apalist.size() << " APAs " << std::endl;
     }
 
-  for (const int & i : apalist)
+  TickWindow window = {firstTick, nTick};
+  if (fDebugLevel > 0 && window.windowed())
     {
-      int apano = i;
-      if (fDebugLevel > 0)
+      std::cout << "FDHDDataInterface : " << "Tick window: first " << firstTick << ", count " << nTick << std::endl;
+    }
+  dune::WIB2FrameChecker::Result check;
+  getFragmentsForAPAs(the_group, *recordIndex, raw_digits, rd_timestamps, apalist, window, check);
+  H5Gclose(the_group);
+
+  // One status for all requested APAs: header mismatches flag corrupt data, timestamp
+  // gaps and out-of-order frames incomplete data; the status word holds the
+  // WIB2FrameChecker::StatusBit's.  All are zero if CheckFrames is off.
+  if (!apalist.empty())
+    {
+      rdstatuses.clear();
+      rdstatuses.emplace_back(check.nHeaderMismatch > 0, check.nTimestampGap + check.nOutOfOrder > 0,
+                              check.status());
+    }
+  if (!check.ok())
+    {
+      mf::LogWarning(logname) << "Frame check failed in " << check.nBadFragment << " links: "
+                              << check.nHeaderMismatch << " header mismatches, "
+                              << check.nTimestampGap << " timestamp gaps, "
+                              << check.nOutOfOrder << " out-of-order frames in "
+                              << check.nframes << " frames";
+    }
+
+  return 0;
+}
+
+
+int FDHDDataInterface::retrieveTpcDataForSpecifiedAPAs(art::Event &evt, TpcData &tpd,
+                                                       std::vector<int> &apalist)
+{
+  return retrieveTpcDataForSpecifiedAPAsInWindow(evt, tpd, apalist, fFirstTick, fNTicks);
+}
+
+
+int FDHDDataInterface::retrieveTpcDataForSpecifiedAPAsInWindow(art::Event &evt, TpcData &tpd,
+                                                               std::vector<int> &apalist,
+                                                               size_t firstTick, size_t nTick)
+{
+  using namespace dune::HDF5Utils;
+  RecordIndexPtr recordIndex;
+  hid_t the_group = openRecord(evt, recordIndex);
+
+  if (fDebugLevel > 0)
+    {
+      std::cout << "FDHDDataInterface : " <<  "Retrieving TPC data for " << apalist.size() << " APAs " << std::endl;
+    }
+
+  // the maps are created here, on the calling thread, in the order of apalist
+  std::vector<TpcData::AdcDataPtr> apaData;
+  apaData.reserve(apalist.size());
+  for (size_t iapa = 0; iapa < apalist.size(); ++iapa) apaData.push_back(tpd.createAdcData());
+
+  TickWindow window = {firstTick, nTick};
+  uint64_t triggerTimestamp = 0;
+  getAdcDataForAPAs(the_group, *recordIndex, apaData, apalist, window, triggerTimestamp);
+  H5Gclose(the_group);
+
+  // one event info shared by all channels
+  AdcChannelData::EventInfoPtr pevi = std::make_shared<const DuneEventInfo>(
+      evt.run(), evt.event(), evt.subRun(), evt.time().timeHigh(), evt.time().timeLow(),
+      DuneEventInfo::badIndex(),
+      triggerTimestamp > 0 ? triggerTimestamp : DuneEventInfo::badLongIndex());
+  for (const auto & pacds : apaData) setEventInfo(*pacds, pevi);
+
+  return 0;
+}
+
+
+int FDHDDataInterface::retrievePdsData(art::Event &evt, std::vector<raw::OpDetWaveform> &waveforms)
+{
+  using namespace dune::HDF5Utils;
+  RecordIndexPtr recordIndex;
+  hid_t the_group = openRecord(evt, recordIndex);
+
+  std::vector<LinkRef> links;
+  getPdsLinkList(the_group, *recordIndex, links);
+  size_t nwfOld = waveforms.size();
+
+  if (fDebugLevel > 0)
+    {
+      std::cout << "FDHDDataInterface : " <<  "Retrieving PDS data from " << links.size() << " datasets" << std::endl;
+    }
+
+  if (!fParallelDecode)
+    {
+      for (const auto & link : links)
+        {
+          getWaveformsForLink(link, waveforms);
+        }
+    }
+  else
+    {
+      std::vector<std::vector<raw::OpDetWaveform>> waveformSlices(links.size());
+      const NumaPlacement & placement = NumaPlacement::instance();
+      NumaPlacement::IndexVector nodes(links.size());
+      for (size_t ilink = 0; ilink < links.size(); ++ilink) nodes[ilink] = placement.node(ilink, links.size());
+      placement.parallelFor(nodes, [&](size_t ilink)
+                            {
+                              MemoryBudget::Reservation memory = reserveDecode(links[ilink]);
+                              getWaveformsForLink(links[ilink], waveformSlices[ilink]);
+                            });
+
+      size_t nwf = waveforms.size();
+      for (const auto & slice : waveformSlices) nwf += slice.size();
+      waveforms.reserve(nwf);
+      for (auto & slice : waveformSlices)
         {
-          std::cout << "FDHDDataInterface :" << "apano: " << i << std::endl;
+          std::move(slice.begin(), slice.end(), std::back_inserter(waveforms));
         }
+    }
+  H5Gclose(the_group);
+
+  return waveforms.size() - nwfOld;
+}
 
-      getFragmentsForEvent(the_group, raw_digits, rd_timestamps, apano);
 
-      //Currently putting in dummy values for the RD Statuses
-      rdstatuses.clear();
-      rdstatuses.emplace_back(false, false, 0);
+// Digits and timestamps from channel data, in channel order.
+
+void FDHDDataInterface::makeRawDigits(const AdcChannelDataMap &acds, RawDigits &raw_digits,
+                                      RDTimeStamps &timestamps)
+{
+  raw_digits.reserve(raw_digits.size() + acds.size());
+  timestamps.reserve(timestamps.size() + acds.size());
+  for (const auto & iacd : acds)
+    {
+      const AdcChannelData & acd = iacd.second;
+      timestamps.emplace_back(acd.channelClock, acd.channel());
+      raw::RawDigit & rd = raw_digits.emplace_back(acd.channel(), acd.raw.size(), acd.raw);
+      rd.SetPedestal(acd.pedestal, acd.pedestalRms);
     }
+}
 
-  return 0;
+
+// Open the record group of the event.  The link channel lists are kept for the duration of a run.
+
+hid_t FDHDDataInterface::openRecord(art::Event &evt, dune::HDF5Utils::RecordIndexPtr &recordIndex)
+{
+  using namespace dune::HDF5Utils;
+  auto infoHandle = evt.getHandle<raw::DUNEHDF5FileInfo>(fFileInfoLabel);
+  const std::string & toplevel_groupname = infoHandle->GetEventGroupName();
+  const std::string & file_name = infoHandle->GetFileName();
+  hid_t file_id = infoHandle->GetHDF5FileHandle();
+  hid_t the_group = getGroupFromPath(file_id, toplevel_groupname);
+
+  if (evt.run() != fLinkChannelCacheRun)
+    {
+      fLinkChannelCache.clear();
+      fLinkChannelCacheRun = evt.run();
+    }
+
+  if (fDebugLevel > 0)
+    {
+      std::cout << "FDHDDataInterface : " << "HDF5 FileName: " << file_name << std::endl;
+      std::cout << "FDHDDataInterface :" << "Top-Level Group Name: " << toplevel_groupname << std::endl;
+    }
+
+  recordIndex = getRecordIndex(file_id, toplevel_groupname);
+  return the_group;
 }
 
 
@@ -95,162 +310,508 @@ int FDHDDataInterface::retrieveDataAPAListWithLabels( art::Event &evt,
 }
 
 
-// This is designed to read 1APA/CRU The function uses "apano", handed by DataPrep,
-// as an argument.
+// Find the link datasets of the requested APAs in the record index, which lists the group
+// hierarchy once per trigger record.  The returned LinkRef's are ordered first by the position
+// of the APA in apalist and then by the order of the links in the file.
 
-void FDHDDataInterface::getFragmentsForEvent(hid_t the_group, RawDigits& raw_digits, RDTimeStamps &timestamps, int apano)
+void FDHDDataInterface::getLinkList(hid_t the_group, const dune::HDF5Utils::RecordIndex &index,
+                                    const std::vector<int> &apalist, std::vector<LinkRef> &links)
 {
-  using namespace dune::HDF5Utils;
-  using dunedaq::detdataformats::wib2::WIB2Frame;
+  const dune::HDF5Utils::DetectorInfo* tpc = index.detector("TPC");
+  if (tpc == nullptr) return;
 
-  art::ServiceHandle<dune::FDHDChannelMapService> channelMap;
+  if (fDebugLevel > 0 && !tpc->elements.empty())
+    {
+      std::cout << logname << " Size of apaNames: " << tpc->elements.size() << std::endl;
+      std::cout << logname << " " << "apaNames[0]: "  << tpc->elements[0].name << std::endl;
+    }
 
-  std::deque<std::string> det_types
-    = getMidLevelGroupNames(the_group);
-  
-  for (const auto & det : det_types)
+  for (size_t iapa = 0; iapa < apalist.size(); ++iapa)
     {
-      if (det != "TPC") continue;
-      
-      if (fDebugLevel > 0)
+      for (const auto & apa : tpc->elements)
         {
-          std::cout << logname  << " Detector type:  " << det << std::endl;
+          // assume the APA group name is of the form APAnnn
+
+          int input_apa = atoi(apa.name.substr(3,3).c_str());
+          if (input_apa != apalist[iapa]) continue;
+
+          for (const auto & ds : apa.datasets)
+            {
+              links.push_back({the_group, &ds, iapa});
+            }
         }
-      hid_t geoGroup = getGroupFromPath(the_group, det);
-      std::deque<std::string> apaNames
-        = getMidLevelGroupNames(geoGroup);
-      
+    }
+}
+
+
+// The staging buffer holds the dataset as stored and the unpacked samples take about as
+// much again (16-bit samples from 14-bit WIB2 or DAPHNE words).
+
+MemoryBudget::Reservation FDHDDataInterface::reserveDecode(const LinkRef &linkref) const
+{
+  return MemoryBudget::Reservation(MemoryBudget::instance(), 2*linkref.dataset->dataSize);
+}
+
+
+// With NumaPlacement, the links of an APA are decoded on the NUMA node of the APA, which
+// is where the TpcData tools process its channel data.
+
+NumaPlacement::IndexVector FDHDDataInterface::linkNodes(const std::vector<LinkRef> &links, size_t napa) const
+{
+  const NumaPlacement & placement = NumaPlacement::instance();
+  NumaPlacement::IndexVector nodes(links.size());
+  for (size_t ilink = 0; ilink < links.size(); ++ilink) nodes[ilink] = placement.node(links[ilink].apaIndex, napa);
+  return nodes;
+}
+
+
+// Decode the links of all APAs in apalist.  DataPrep hands the APA numbers to the
+// interface, typically one at a time.  The outputs are reserved once for the maximum
+// number of channels.  With ParallelDecode, each link is decoded into its own output
+// slice in a TBB task and the slices are moved into raw_digits and timestamps in the
+// link order, so the output is the same as for the serial loop.
+
+void FDHDDataInterface::getFragmentsForAPAs(hid_t the_group, const dune::HDF5Utils::RecordIndex &index,
+                                            RawDigits& raw_digits,
+                                            RDTimeStamps &timestamps, const std::vector<int> &apalist,
+                                            const TickWindow &window, dune::WIB2FrameChecker::Result &check)
+{
+  // service handles are obtained on the calling thread; the channel map is only read from the tasks
+  art::ServiceHandle<dune::FDHDChannelMapService> channelMapHandle;
+  const dune::FDHDChannelMapService & channelMap = *channelMapHandle;
+
+  std::vector<LinkRef> links;
+  getLinkList(the_group, index, apalist, links);
+
+  TraceSpan span("decoder", "getFragmentsForAPAs");
+  span.arg("apa", apalist.empty() ? -1 : apalist.front()).arg("napa", apalist.size()).arg("nlink", links.size());
+
+  size_t nchanMax = links.size()*fFrameChannels;
+  raw_digits.reserve(raw_digits.size() + nchanMax);
+  timestamps.reserve(timestamps.size() + nchanMax);
+
+  if (!fParallelDecode)
+    {
+      for (const auto & link : links)
+        {
+          getFragmentForLink(link, channelMap, window, raw_digits, timestamps, check);
+        }
+    }
+  else
+    {
       if (fDebugLevel > 0)
         {
-          std::cout << logname << " Size of apaNames: " << apaNames.size() << std::endl;
-          std::cout << logname << " " << "apaNames[0]: "  << apaNames[0] << std::endl;
+          std::cout << logname << ": decoding " << links.size() << " links from " << apalist.size()
+                    << " APAs in parallel" << std::endl;
         }
 
-      for (const auto & apaname : apaNames)
+      std::vector<RawDigits> digitSlices(links.size());
+      std::vector<RDTimeStamps> timestampSlices(links.size());
+      std::vector<dune::WIB2FrameChecker::Result> checkSlices(links.size());
+      NumaPlacement::instance().parallelFor(linkNodes(links, apalist.size()), [&](size_t ilink)
+                            {
+                              MemoryBudget::Reservation memory = reserveDecode(links[ilink]);
+                              getFragmentForLink(links[ilink], channelMap, window, digitSlices[ilink], timestampSlices[ilink],
+                                                 checkSlices[ilink]);
+                            });
+
+      for (size_t ilink = 0; ilink < links.size(); ++ilink)
         {
-	  // assume the APA group name is of the form APAnnn
+          std::move(digitSlices[ilink].begin(), digitSlices[ilink].end(), std::back_inserter(raw_digits));
+          std::move(timestampSlices[ilink].begin(), timestampSlices[ilink].end(), std::back_inserter(timestamps));
+          check += checkSlices[ilink];
+        }
+    }
+}
 
-	  int input_apa = atoi(apaname.substr(3,3).c_str());
-	  if (input_apa != apano) continue;
 
-          hid_t linkGroup = getGroupFromPath(geoGroup, apaname);
-          std::deque<std::string> linkNames = getMidLevelGroupNames(linkGroup);
+// Same as getFragmentsForAPAs but filling the channel data map of the APA of each link.
+// With ParallelDecode, each link is decoded into its own map and the map nodes are then
+// spliced into the APA maps, so no samples are copied after the decode.
 
-          for (const auto & t : linkNames)
-            {
-              // link below is calculated from the HDF5 group name. However,later a link is calculated from 
-              // WIBFrameHeader and used in the rest of the code.
-              unsigned int link = atoi(t.substr(4,2).c_str());
-              hid_t dataset = H5Dopen(linkGroup, t.data(), H5P_DEFAULT);
-              hsize_t ds_size = H5Dget_storage_size(dataset);
-              if (ds_size <= sizeof(FragmentHeader)) continue; //Too small
-
-              std::vector<char> ds_data(ds_size);
-              H5Dread(dataset, H5T_STD_I8LE, H5S_ALL, H5S_ALL, H5P_DEFAULT, ds_data.data());
-              H5Dclose(dataset);
-
-              //Each fragment is a collection of WIB Frames
-              Fragment frag(&ds_data[0], Fragment::BufferAdoptionMode::kReadOnlyMode);
-              size_t n_frames = (ds_size - sizeof(FragmentHeader))/sizeof(WIB2Frame);
-              if (fDebugLevel > 0)
-                {
-                  std::cout << "n_frames calc.: " << ds_size << " " << sizeof(FragmentHeader) << " " << sizeof(WIB2Frame) << " " << n_frames << std::endl;
-                }
-              std::vector<raw::RawDigit::ADCvector_t> adc_vectors(256);
-              unsigned int slot = 0, link_from_frameheader = 0, crate = 0;
-          
-              for (size_t i = 0; i < n_frames; ++i)
-                {
-                  // dump WIB frames in hex
-                  //std::cout << "Frame number: " << i << std::endl;
-                  // size_t wfs32 = sizeof(WIB2Frame)/4;
-                  //uint32_t *fdp = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(frag.get_data()) + i*sizeof(WIB2Frame));
-                  //std::cout << std::dec;
-                  //for (size_t iwdt = 0; iwdt < 1; iwdt++)  // dumps just the first 32 bits.  use wfs32 if you want them all
-                  //{
-                  //  std::cout << iwdt << " : 10987654321098765432109876543210" << std::endl;
-                  //  std::cout << iwdt << " : " << std::bitset<32>{fdp[iwdt]} << std::endl;
-                  //}
-                  //std::cout << std::dec;
-
-                  auto frame = reinterpret_cast<WIB2Frame*>(static_cast<uint8_t*>(frag.get_data()) + i*sizeof(WIB2Frame));
-                  for (size_t j = 0; j < adc_vectors.size(); ++j)
-                    {
-                      adc_vectors[j].push_back(frame->get_adc(j));
-                    }
-              
-                  if (i == 0)
-                    {
-                      crate = frame->header.crate;
-                      slot = frame->header.slot;
-                      link_from_frameheader = frame->header.link;
-                    }
-                }
-              if (fDebugLevel > 0)
-                {
-                  std::cout << logname << ": crate, slot, link(HDF5 group), link(WIB Header): "  << crate << ", " << slot << ", " << link << ", " << link_from_frameheader << std::endl;
-                }
-
-              for (size_t iChan = 0; iChan < 256; ++iChan)
-                {
-                  const raw::RawDigit::ADCvector_t & v_adc = adc_vectors[iChan];
-
-                  uint32_t slotloc = slot;
-                  slotloc &= 0x7;
-
-                  auto hdchaninfo = channelMap->GetChanInfoFromWIBElements (crate, slotloc, link_from_frameheader, iChan); 
-                  unsigned int offline_chan = hdchaninfo.offlchan;
-
-                  if (offline_chan > fMaxChan) continue;
-
-                  raw::RDTimeStamp rd_ts(frag.get_trigger_timestamp(), offline_chan);
-                  timestamps.push_back(rd_ts);
-
-                  float median = 0., sigma = 0.;
-                  getMedianSigma(v_adc, median, sigma);
-                  raw::RawDigit rd(offline_chan, v_adc.size(), v_adc);
-                  rd.SetPedestal(median, sigma);
-                  raw_digits.push_back(rd);
-                }
+void FDHDDataInterface::getAdcDataForAPAs(hid_t the_group, const dune::HDF5Utils::RecordIndex &index,
+                                          const std::vector<TpcData::AdcDataPtr> &apaData,
+                                          const std::vector<int> &apalist, const TickWindow &window,
+                                          uint64_t &triggerTimestamp)
+{
+  art::ServiceHandle<dune::FDHDChannelMapService> channelMapHandle;
+  const dune::FDHDChannelMapService & channelMap = *channelMapHandle;
 
-            }
-          H5Gclose(linkGroup);
+  std::vector<LinkRef> links;
+  getLinkList(the_group, index, apalist, links);
+
+  TraceSpan span("decoder", "getAdcDataForAPAs");
+  span.arg("apa", apalist.empty() ? -1 : apalist.front()).arg("napa", apalist.size()).arg("nlink", links.size());
+
+  if (!fParallelDecode)
+    {
+      for (const auto & link : links)
+        {
+          getAdcDataForLink(link, channelMap, window, *apaData[link.apaIndex], triggerTimestamp);
+        }
+    }
+  else
+    {
+      std::vector<AdcChannelDataMap> linkData(links.size());
+      std::vector<uint64_t> linkTriggerTimestamps(links.size(), 0);
+      NumaPlacement::instance().parallelFor(linkNodes(links, apaData.size()), [&](size_t ilink)
+                            {
+                              MemoryBudget::Reservation memory = reserveDecode(links[ilink]);
+                              getAdcDataForLink(links[ilink], channelMap, window, linkData[ilink], linkTriggerTimestamps[ilink]);
+                            });
+
+      for (size_t ilink = 0; ilink < links.size(); ++ilink)
+        {
+          apaData[links[ilink].apaIndex]->merge(linkData[ilink]);
+          if (triggerTimestamp == 0) triggerTimestamp = linkTriggerTimestamps[ilink];
         }
     }
 }
 
-void FDHDDataInterface::getMedianSigma(const raw::RawDigit::ADCvector_t &v_adc, float &median,
-                                       float &sigma) {
-  size_t asiz = v_adc.size();
-  int imed=0;
-  if (asiz == 0) {
-    median = 0;
-    sigma = 0;
+
+// Return the (WIB frame channel, offline channel, channel info) entries for a link, keeping
+// only channels that pass the MaxChan selection.  The list is computed with the channel map service on
+// first use and then taken from the cache.  Entries are never removed during an event, so
+// the returned reference stays valid while other threads add links.
+
+const FDHDDataInterface::LinkChannels &
+FDHDDataInterface::getLinkChannels(const dune::FDHDChannelMapService &channelMap,
+                                   unsigned int crate, unsigned int slot, unsigned int link)
+{
+  uint32_t slotloc = slot;
+  slotloc &= 0x7;
+  unsigned int key = (crate << 16) | (slotloc << 8) | (link & 0xff);
+
+  std::lock_guard<std::mutex> lock(fLinkChannelMutex);
+  auto ilc = fLinkChannelCache.find(key);
+  if (ilc != fLinkChannelCache.end()) return ilc->second;
+
+  std::vector<unsigned int> offline_chans;
+  channelMap.GetOfflChansFromWIBElements (crate, slotloc, link, offline_chans);
+  LinkChannels & link_chans = fLinkChannelCache[key];
+  for (unsigned int iChan = 0; iChan < offline_chans.size(); ++iChan)
+    {
+      if (offline_chans[iChan] > fMaxChan) continue;
+      link_chans.push_back({iChan, offline_chans[iChan],
+                            std::make_shared<const DuneChannelInfo>(offline_chans[iChan], DuneChannelInfo::badIndex(),
+                                                                   DuneChannelInfo::badIndex(), DuneChannelInfo::badIndex())});
+    }
+  if (fDebugLevel > 0)
+    {
+      std::cout << logname << ": cached " << link_chans.size() << " channels for crate, slot, link: "
+                << crate << ", " << slotloc << ", " << link << std::endl;
+    }
+  return link_chans;
+}
+
+
+// The PDS datasets of the record: those of each element of the "PDS" detector group
+// followed by any found directly in the group, in file order.
+
+void FDHDDataInterface::getPdsLinkList(hid_t the_group, const dune::HDF5Utils::RecordIndex &index,
+                                       std::vector<LinkRef> &links) const
+{
+  const dune::HDF5Utils::DetectorInfo* pds = index.detector("PDS");
+  if (pds == nullptr) return;
+  for (const auto & element : pds->elements)
+    {
+      for (const auto & ds : element.datasets) links.push_back({the_group, &ds, 0});
+    }
+  for (const auto & ds : pds->datasets) links.push_back({the_group, &ds, 0});
+}
+
+
+// Decode the DAPHNE frames of one PDS dataset.  The waveforms are reserved for all frames
+// of the fragment and each is resized to the frame length, so the unpacker writes the
+// samples directly into the waveform.
+
+void FDHDDataInterface::getWaveformsForLink(const LinkRef &linkref, std::vector<raw::OpDetWaveform> &waveforms) const
+{
+  typedef dune::DAPHNEFrameTraits Traits;
+  typedef dune::PackedFrameUnpacker<Traits> Unpacker;
+
+  size_t n_frames = 0;
+  char* ds_data = readLinkFrames(linkref, Traits::FrameSize, TickWindow{0, 0}, n_frames);
+  if (n_frames == 0) return;
+
+  dune::HDF5Utils::Fragment frag(ds_data, dune::HDF5Utils::Fragment::BufferAdoptionMode::kReadOnlyMode);
+  const uint8_t* frames = static_cast<const uint8_t*>(frag.get_data());
+  waveforms.reserve(waveforms.size() + n_frames);
+  for (size_t ifrm = 0; ifrm < n_frames; ++ifrm)
+    {
+      const uint8_t* pframe = frames + ifrm*Traits::FrameSize;
+      dune::FrameHeader header = Unpacker::header(pframe);
+      unsigned int chan = pdsChannel(header.crate, header.slot, header.link, Traits::channel(pframe));
+      raw::OpDetWaveform & wf = waveforms.emplace_back(raw::TimeStamp_t(header.timestamp), chan, Traits::NTicks);
+      wf.resize(Traits::NTicks);
+      Unpacker::unpack(pframe, 1, wf.data());
+    }
+
+  if (fDebugLevel > 1)
+    {
+      std::cout << logname << ": " << linkref.dataset->path << ": " << n_frames << " PDS frames" << std::endl;
+    }
+}
+
+
+// Read the fragment of one link dataset into the per-thread staging buffer, which holds the
+// fragment header followed by the frames.  The HDF5 calls are serialized; the rest of the
+// decode is unlocked, so this may be called concurrently for different links.  For a tick
+// window, only the fragment header and the frames in the window are read, using hyperslab
+// selections on the byte dataset.  Returns the buffer and sets n_frames, which is 0 if
+// there is nothing to decode.
+
+char* FDHDDataInterface::readLinkFrames(const LinkRef &linkref, size_t frameSize,
+                                        const TickWindow &window, size_t &n_frames) const
+{
+  using namespace dune::HDF5Utils;
+
+  static std::mutex hdf5Mutex;
+
+  char* ds_data = nullptr;
+  n_frames = 0;
+  {
+    // time waiting for the lock is traced separately to show contention between decode tasks
+    std::unique_lock<std::mutex> lock(hdf5Mutex, std::defer_lock);
+    {
+      TraceSpan waitSpan("lock", "hdf5Mutex");
+      lock.lock();
+    }
+    TraceSpan readSpan("decoder", "readLinkFrames");
+    readSpan.arg("apaIndex", linkref.apaIndex).arg("bytes", linkref.dataset->dataSize);
+    hid_t dataset = H5Dopen(linkref.group, linkref.dataset->path.data(), H5P_DEFAULT);
+    if (!window.windowed())
+      {
+        hsize_t ds_size = linkref.dataset->dataSize;
+        if (ds_size <= sizeof(FragmentHeader)) //Too small
+          {
+            H5Dclose(dataset);
+            return nullptr;
+          }
+        ds_data = dune::AlignedByteBuffer::local().reserve(ds_size);
+        H5Dread(dataset, H5T_STD_I8LE, H5S_ALL, H5S_ALL, H5P_DEFAULT, ds_data);
+        n_frames = (ds_size - sizeof(FragmentHeader))/frameSize;
+        if (fDebugLevel > 0)
+          {
+            std::cout << "n_frames calc.: " << ds_size << " " << sizeof(FragmentHeader) << " " << frameSize << " " << n_frames << std::endl;
+          }
+      }
+    else
+      {
+        hid_t filespace = H5Dget_space(dataset);
+        hsize_t ds_size = linkref.dataset->dataSize;
+        size_t n_frames_all = ds_size > sizeof(FragmentHeader) ? (ds_size - sizeof(FragmentHeader))/frameSize : 0;
+        if (window.first < n_frames_all)
+          {
+            n_frames = n_frames_all - window.first;
+            if (window.count > 0 && window.count < n_frames) n_frames = window.count;
+          }
+        if (fDebugLevel > 0)
+          {
+            std::cout << "n_frames in window: " << n_frames << " of " << n_frames_all << std::endl;
+          }
+        if (n_frames > 0)
+          {
+            ds_data = dune::AlignedByteBuffer::local().reserve(sizeof(FragmentHeader) + n_frames*frameSize);
+            hsize_t offsets[2] = {0, sizeof(FragmentHeader) + window.first*frameSize};
+            hsize_t counts[2] = {sizeof(FragmentHeader), n_frames*frameSize};
+            char* dests[2] = {ds_data, ds_data + sizeof(FragmentHeader)};
+            for (size_t ipart = 0; ipart < 2; ++ipart)
+              {
+                // byte datasets are written as 1D or as N x 1: select along the first dimension
+                hsize_t start[2] = {offsets[ipart], 0};
+                hsize_t count[2] = {counts[ipart], 1};
+                H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, count, NULL);
+                hid_t memspace = H5Screate_simple(1, &counts[ipart], NULL);
+                H5Dread(dataset, H5T_STD_I8LE, memspace, filespace, H5P_DEFAULT, dests[ipart]);
+                H5Sclose(memspace);
+              }
+          }
+        H5Sclose(filespace);
+      }
+    H5Dclose(dataset);
+  }
+  if (n_frames == 0) return nullptr;
+  return ds_data;
+}
+
+
+// Read and decode one link dataset in the configured frame format.  HDF5 calls are serialized
+// as the library is not in general built thread safe (see readLinkFrames); the unpacking,
+// channel mapping and pedestal calculation run unlocked, so this may be called concurrently
+// for different links.
+
+bool FDHDDataInterface::decodeLink(const LinkRef &linkref, const dune::FDHDChannelMapService &channelMap,
+                                   const TickWindow &window, DecodedLink &decoded)
+{
+  switch (fFrameFormat)
+    {
+    case WIB2Format:
+      return decodeLinkFrames<dune::WIB2FrameTraits>(linkref, channelMap, window, decoded);
+    }
+  return false;
+}
+
+
+// The HDF5 reads, buffers, pedestals and channel lookup are shared by all formats; the frame
+// size, header and unpacking come from the traits and are resolved at compile time.  WIB2
+// frames use the runtime-dispatched SIMD unpacker, other formats PackedFrameUnpacker.
+
+template <class Traits>
+bool FDHDDataInterface::decodeLinkFrames(const LinkRef &linkref, const dune::FDHDChannelMapService &channelMap,
+                                         const TickWindow &window, DecodedLink &decoded)
+{
+  using namespace dune::HDF5Utils;
+  constexpr size_t frameSize = Traits::FrameSize;
+  constexpr size_t nticksPerFrame = Traits::NTicks;
+
+  const std::string & t = linkref.dataset->name;
+
+  // link below is calculated from the HDF5 group name. However,later a link is calculated from
+  // WIBFrameHeader and used in the rest of the code.
+  unsigned int link = atoi(t.substr(4,2).c_str());
+
+  // read into the reusable per-thread staging buffer: no allocation or memset per link
+  size_t n_frames = 0;
+  char* ds_data = readLinkFrames(linkref, frameSize, window, n_frames);
+  if (n_frames == 0) return false;
+
+  //Each fragment is a collection of frames
+  Fragment frag(ds_data, Fragment::BufferAdoptionMode::kReadOnlyMode);
+
+  // decode all frames of the fragment at once into a channel-major buffer:
+  // the samples of channel iChan are adcs[iChan*n_samples ... (iChan+1)*n_samples-1]
+
+  static thread_local dune::WIB2FrameUnpacker::AdcCountVector adcs;
+  const void* frames = frag.get_data();
+  decoded.check = dune::WIB2FrameChecker::Result();
+  {
+    TraceSpan unpackSpan("decoder", "unpackFrames");
+    unpackSpan.arg("apaIndex", linkref.apaIndex).arg("nframe", n_frames);
+    if constexpr (std::is_same<Traits, dune::WIB2FrameTraits>::value)
+      {
+        fUnpacker.unpack(static_cast<const dunedaq::detdataformats::wib2::WIB2Frame*>(frames), n_frames, adcs);
+        // all frames, not only frame 0 whose header is used below
+        if (fCheckFrames) decoded.check = fChecker.check(frames, n_frames);
+      }
+    else
+      {
+        dune::PackedFrameUnpacker<Traits>::unpack(frames, n_frames, adcs);
+      }
+  }
+  size_t n_samples = n_frames*nticksPerFrame;
+  dune::FrameHeader header = dune::PackedFrameUnpacker<Traits>::header(frames);
+  unsigned int crate = header.crate;
+  unsigned int slot = header.slot;
+  unsigned int link_from_frameheader = header.link;
+
+  if (fDebugLevel > 0)
+    {
+      std::cout << logname << ": crate, slot, link(HDF5 group), link(WIB Header): "  << crate << ", " << slot << ", " << link << ", " << link_from_frameheader << std::endl;
+    }
+
+  // pedestals of all channels of the link in one batch.  The RMS includes tails from bad
+  // samples and signals and may not be the best RMS calc.
+
+  static thread_local dune::AdcPedestalFinder pedFinder;
+  static thread_local std::vector<dune::AdcPedestalFinder::Pedestal> peds;
+  {
+    TraceSpan pedSpan("decoder", "pedestals");
+    pedSpan.arg("apaIndex", linkref.apaIndex).arg("nchan", Traits::NChannels);
+    pedFinder.evaluate(adcs.data(), Traits::NChannels, n_samples, peds);
   }
-  else {
-    // the RMS includes tails from bad samples and signals and may not be the best RMS calc.
-
-    imed = TMath::Median(asiz,v_adc.data()) + 0.01;  // add an offset to make sure the floor gets the right integer
-    median = imed;
-    sigma = TMath::RMS(asiz,v_adc.data());
-    
-    // add in a correction suggested by David Adams, May 6, 2019
-    
-    size_t s1 = 0;
-    size_t sm = 0;
-    for (size_t i = 0; i < asiz; ++i) {
-      if (v_adc.at(i) < imed) s1++;
-      if (v_adc.at(i) == imed) sm++;
-    }
-    if (sm > 0) {
-      float mcorr = (-0.5 + (0.5*(float) asiz - (float) s1)/ ((float) sm) );
+
+  // offline channels of this link, cached for the run
+
+  const LinkChannels & link_chans = getLinkChannels(channelMap, crate, slot, link_from_frameheader);
+
+  // the trigger time, or for a tick window the time of its first frame
+  uint64_t timestamp = window.windowed() ? header.timestamp : frag.get_trigger_timestamp();
+
+  decoded.adcs = adcs.data();
+  decoded.n_frames = n_samples;
+  decoded.peds = peds.data();
+  decoded.channels = &link_chans;
+  decoded.timestamp = timestamp;
+  decoded.triggerTimestamp = frag.get_trigger_timestamp();
+  return true;
+}
+
+
+// Decode one link into raw digits and timestamps.  The samples are copied once, from the
+// decode buffer into the vector owned by the digit.
+
+void FDHDDataInterface::getFragmentForLink(const LinkRef &linkref, const dune::FDHDChannelMapService &channelMap,
+                                           const TickWindow &window,
+                                           RawDigits& raw_digits, RDTimeStamps &timestamps,
+                                           dune::WIB2FrameChecker::Result &check)
+{
+  TraceSpan span("decoder", "getFragmentForLink");
+  span.arg("apaIndex", linkref.apaIndex);
+  DecodedLink decoded;
+  if (!decodeLink(linkref, channelMap, window, decoded)) return;
+  if (!decoded.channels->empty())
+    {
+      span.arg("channel", decoded.channels->front().offlineChannel).arg("nchan", decoded.channels->size());
+    }
+  check += decoded.check;
+  const LinkChannels & link_chans = *decoded.channels;
+  size_t n_frames = decoded.n_frames;
+
+  raw_digits.reserve(raw_digits.size() + link_chans.size());
+  timestamps.reserve(timestamps.size() + link_chans.size());
+
+  for (const auto & link_chan : link_chans)
+    {
+      size_t iChan = link_chan.frameChannel;
+      unsigned int offline_chan = link_chan.offlineChannel;
+
+      timestamps.emplace_back(decoded.timestamp, offline_chan);
+
+      const auto adc_begin = decoded.adcs + iChan*n_frames;
+      raw::RawDigit::ADCvector_t v_adc(adc_begin, adc_begin + n_frames);
+      const auto & ped = decoded.peds[iChan];
       if (fDebugLevel > 0)
         {
-          if (std::abs(mcorr)>1.0) std::cout << "mcorr: " << mcorr << std::endl;
+          if (std::abs(ped.correction)>1.0) std::cout << "mcorr: " << ped.correction << std::endl;
         }
-      median += mcorr;
+      raw::RawDigit & rd = raw_digits.emplace_back(offline_chan, n_frames, std::move(v_adc));
+      rd.SetPedestal(ped.median, ped.sigma);
+    }
+}
+
+
+// Decode one link into channel data taken from the pool of this thread.  The samples are
+// copied once, from the decode buffer into AdcChannelData::raw.
+
+void FDHDDataInterface::getAdcDataForLink(const LinkRef &linkref, const dune::FDHDChannelMapService &channelMap,
+                                          const TickWindow &window, AdcChannelDataMap &acds,
+                                          uint64_t &triggerTimestamp)
+{
+  TraceSpan span("decoder", "getAdcDataForLink");
+  span.arg("apaIndex", linkref.apaIndex);
+  DecodedLink decoded;
+  if (!decodeLink(linkref, channelMap, window, decoded)) return;
+  if (!decoded.channels->empty())
+    {
+      span.arg("channel", decoded.channels->front().offlineChannel).arg("nchan", decoded.channels->size());
+    }
+  if (triggerTimestamp == 0) triggerTimestamp = decoded.triggerTimestamp;
+  size_t n_frames = decoded.n_frames;
+  AdcChannelDataPool & pool = *AdcChannelDataPool::threadPool();
+
+  for (const auto & link_chan : *decoded.channels)
+    {
+      size_t iChan = link_chan.frameChannel;
+      AdcChannelData & acd = pool.insert(acds, link_chan.offlineChannel);
+      acd.setChannelInfo(link_chan.info);
+      acd.channelClock = decoded.timestamp;
+      const auto adc_begin = decoded.adcs + iChan*n_frames;
+      acd.raw.assign(adc_begin, adc_begin + n_frames);
+      const auto & ped = decoded.peds[iChan];
+      acd.pedestal = ped.median;
+      acd.pedestalRms = ped.sigma;
     }
-  }  
 }
 
 DEFINE_ART_CLASS_TOOL(FDHDDataInterface)
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Class:       PackedFrameUnpacker
+// File:        PackedFrameUnpacker.h
+//
+// Unpacker for a contiguous block of fixed-size readout frames whose ADC values are
+// bit-packed, parametrised at compile time by a frame traits class:
+//
+//   struct MyFrameTraits {
+//     static constexpr size_t FrameSize;         // bytes per frame
+//     static constexpr size_t AdcOffset;         // byte offset of the packed ADC data
+//     static constexpr unsigned int NChannels;   // channels per frame
+//     static constexpr unsigned int NTicks;      // time samples per frame
+//     static constexpr unsigned int BitsPerAdc;  // bits per ADC value (at most 16)
+//     static dune::FrameHeader header(const uint8_t* pframe);
+//   };
+//
+// Value (itick, ichan) of a frame starts at bit (itick*NChannels + ichan)*BitsPerAdc of
+// the little-endian bit stream at AdcOffset, which is the WIB2 packing for NTicks = 1.
+// All sizes are constants, so the per-frame loop is fully inlined and may be vectorised
+// by the compiler.  The output is channel-major as for WIB2FrameUnpacker:
+//
+//   out[ichan*nsam + iframe*NTicks + itick],  nsam = nframes*NTicks
+//
+// The decoders share the HDF5 traversal, buffers and channel mapping and only
+// instantiate this class for the frame format of the data, e.g.
+//   dune::PackedFrameUnpacker<dune::WIB2FrameTraits>::unpack(pframes, nframes, adcs);
+//
+// art-independent class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PackedFrameUnpacker_H
+#define PackedFrameUnpacker_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace dune {
+
+  // Header values used by the decoders.
+  struct FrameHeader {
+    unsigned int crate = 0;
+    unsigned int slot = 0;
+    unsigned int link = 0;
+    uint64_t timestamp = 0;
+  };
+
+  template <class Traits> class PackedFrameUnpacker;
+
+}
+
+template <class Traits>
+class dune::PackedFrameUnpacker {
+
+public:
+
+  typedef short AdcCount;                        // same as raw::RawDigit::ADCvector_t::value_type
+  typedef std::vector<AdcCount> AdcCountVector;
+
+  static constexpr size_t FrameSize = Traits::FrameSize;
+  static constexpr size_t AdcOffset = Traits::AdcOffset;
+  static constexpr unsigned int NChannels = Traits::NChannels;
+  static constexpr unsigned int NTicks = Traits::NTicks;
+  static constexpr unsigned int BitsPerAdc = Traits::BitsPerAdc;
+  static constexpr unsigned int NValues = NChannels*NTicks;
+  static constexpr size_t AdcBytes = (size_t(NValues)*BitsPerAdc + 7)/8;
+
+  static_assert(BitsPerAdc > 0 && BitsPerAdc <= 16, "ADC values must have 1 to 16 bits");
+  static_assert(NChannels > 0 && NTicks > 0, "Frames must hold at least one value");
+  static_assert(AdcOffset + AdcBytes <= FrameSize, "Packed ADC data do not fit in the frame");
+
+  // Decode the NValues values of one frame into adcs[itick*NChannels + ichan].
+  static void unpackFrame(const void* pframe, uint16_t* adcs) {
+    // Copy to a padded buffer so that each 8-byte window load stays in bounds.
+    uint8_t bytes[AdcBytes + 8];
+    std::memcpy(bytes, static_cast<const uint8_t*>(pframe) + AdcOffset, AdcBytes);
+    std::memset(bytes + AdcBytes, 0, 8);
+    constexpr uint64_t mask = (uint64_t(1) << BitsPerAdc) - 1;
+    for (unsigned int ival = 0; ival < NValues; ++ival)
+      {
+        size_t bit = size_t(ival)*BitsPerAdc;
+        uint64_t word;
+        std::memcpy(&word, bytes + bit/8, sizeof(word));
+        adcs[ival] = (word >> (bit%8)) & mask;
+      }
+  }
+
+  // Unpack nframes consecutive frames starting at pframes into out, which must have
+  // room for NValues*nframes values.  Layout is channel-major (see above).
+  static void unpack(const void* pframes, size_t nframes, AdcCount* out) {
+    const uint8_t* pbeg = static_cast<const uint8_t*>(pframes);
+    const size_t nsam = nframes*NTicks;
+    uint16_t adcs[NValues];
+    for (size_t ifrm = 0; ifrm < nframes; ++ifrm)
+      {
+        unpackFrame(pbeg + ifrm*FrameSize, adcs);
+        for (unsigned int itick = 0; itick < NTicks; ++itick)
+          {
+            const uint16_t* pin = adcs + itick*NChannels;
+            AdcCount* pout = out + ifrm*NTicks + itick;
+            for (unsigned int ichan = 0; ichan < NChannels; ++ichan, pout += nsam)
+              {
+                *pout = pin[ichan];
+              }
+          }
+      }
+  }
+
+  // Same, resizing out to NValues*nframes.
+  static void unpack(const void* pframes, size_t nframes, AdcCountVector& out) {
+    out.resize(size_t(NValues)*nframes);
+    unpack(pframes, nframes, out.data());
+  }
+
+  // Header of the frame at pframe.
+  static FrameHeader header(const void* pframe) {
+    return Traits::header(static_cast<const uint8_t*>(pframe));
+  }
+
+};
+
+#endif
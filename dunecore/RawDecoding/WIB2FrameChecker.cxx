@@ -0,0 +1,172 @@
+// WIB2FrameChecker.cxx
+
+#include "WIB2FrameChecker.h"
+
+#include <cstring>
+#include "detdataformats/wib2/WIB2Frame.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define WIB2CHECK_AVX2 1
+#endif
+
+using dunedaq::detdataformats::wib2::WIB2Frame;
+
+namespace {
+
+  typedef dune::WIB2FrameChecker::Result Result;
+
+  constexpr size_t frameSize = sizeof(WIB2Frame);
+  constexpr size_t headerOffset = offsetof(WIB2Frame, header);
+  constexpr size_t timestampOffset = headerOffset + offsetof(WIB2Frame::Header, timestamp_1);
+
+  static_assert(offsetof(WIB2Frame::Header, timestamp_2) == offsetof(WIB2Frame::Header, timestamp_1) + 4,
+                "The timestamp words must be adjacent");
+
+  // The first header word holds version, detector, crate, slot and link.
+  inline uint32_t headerWord(const uint8_t* pframe) {
+    uint32_t word;
+    std::memcpy(&word, pframe + headerOffset, sizeof(word));
+    return word;
+  }
+
+  // timestamp_1 is the low word, as in WIB2Frame::get_timestamp.
+  inline uint64_t timestamp(const uint8_t* pframe) {
+    uint64_t ts;
+    std::memcpy(&ts, pframe + timestampOffset, sizeof(ts));
+    return ts;
+  }
+
+  // Check frames [ifrm0, nframes) against the first frame; ifrm0 must be at least 1.
+  // Counts are added to res and the first failing frame is returned, npos if none.
+
+  size_t checkScalar(const uint8_t* pbeg, size_t ifrm0, size_t nframes, uint64_t inc, Result& res) {
+    size_t ibad = dune::WIB2FrameChecker::npos;
+    const uint32_t hdr0 = headerWord(pbeg);
+    uint64_t tsPrev = timestamp(pbeg + (ifrm0 - 1)*frameSize);
+    for (size_t ifrm = ifrm0; ifrm < nframes; ++ifrm)
+      {
+        const uint8_t* pframe = pbeg + ifrm*frameSize;
+        uint64_t ts = timestamp(pframe);
+        int64_t step = int64_t(ts - tsPrev);
+        bool badHeader = headerWord(pframe) != hdr0;
+        bool badOrder = step <= 0;
+        bool badGap = uint64_t(step) != inc;
+        res.nHeaderMismatch += badHeader;
+        res.nOutOfOrder += badOrder;
+        res.nTimestampGap += badGap && !badOrder;
+        if ((badHeader || badGap) && ibad == dune::WIB2FrameChecker::npos) ibad = ifrm;
+        tsPrev = ts;
+      }
+    return ibad;
+  }
+
+#ifdef WIB2CHECK_AVX2
+
+  // Four frames per iteration: the header words and timestamps of frames i...i+3 and
+  // the timestamps of frames i-1...i+2 are gathered with the frame stride, and the
+  // failures are counted from the comparison masks.  Returns the first frame not
+  // checked, which the caller checks with the scalar loop.
+
+  __attribute__((target("avx2")))
+  size_t checkAvx2(const uint8_t* pbeg, size_t nframes, uint64_t inc, Result& res, size_t& ibad) {
+    const long long fs = frameSize;
+    const __m256i offs = _mm256_setr_epi64x(0, fs, 2*fs, 3*fs);
+    const __m256i step4 = _mm256_set1_epi64x(4*fs);
+    const __m256i back = _mm256_set1_epi64x(fs);
+    const __m256i hdr0 = _mm256_set1_epi64x(headerWord(pbeg));
+    const __m256i hdrMask = _mm256_set1_epi64x(0xffffffff);
+    const __m256i vinc = _mm256_set1_epi64x(inc);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const long long* phdr = reinterpret_cast<const long long*>(pbeg + headerOffset);
+    const long long* pts = reinterpret_cast<const long long*>(pbeg + timestampOffset);
+    __m256i idx = _mm256_add_epi64(offs, back);
+    size_t ifrm = 1;
+    for (; ifrm + 4 <= nframes; ifrm += 4, idx = _mm256_add_epi64(idx, step4))
+      {
+        __m256i hdr = _mm256_and_si256(_mm256_i64gather_epi64(phdr, idx, 1), hdrMask);
+        __m256i ts = _mm256_i64gather_epi64(pts, idx, 1);
+        __m256i tsPrev = _mm256_i64gather_epi64(pts, _mm256_sub_epi64(idx, back), 1);
+        __m256i step = _mm256_sub_epi64(ts, tsPrev);
+        unsigned int mHeader = ~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hdr, hdr0))) & 0xf;
+        unsigned int mOrder = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(one, step)));
+        unsigned int mGap = ~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(step, vinc))) & 0xf;
+        res.nHeaderMismatch += __builtin_popcount(mHeader);
+        res.nOutOfOrder += __builtin_popcount(mOrder);
+        res.nTimestampGap += __builtin_popcount(mGap & ~mOrder);
+        unsigned int mBad = mHeader | mGap;
+        if (mBad && ibad == dune::WIB2FrameChecker::npos) ibad = ifrm + __builtin_ctz(mBad);
+      }
+    return ifrm;
+  }
+
+  bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+  }
+
+#endif
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+Result& dune::WIB2FrameChecker::Result::operator+=(const Result& rhs)
+{
+  nframes += rhs.nframes;
+  nHeaderMismatch += rhs.nHeaderMismatch;
+  nTimestampGap += rhs.nTimestampGap;
+  nOutOfOrder += rhs.nOutOfOrder;
+  nBadFragment += rhs.nBadFragment;
+  if (rhs.firstBadFrame != npos) firstBadFrame = rhs.firstBadFrame;
+  return *this;
+}
+
+//**********************************************************************
+
+dune::WIB2FrameChecker::WIB2FrameChecker(uint64_t tickIncrement, Mode mode)
+  : fTickIncrement(tickIncrement),
+    fUseSimd(mode != SCALAR && simdAvailable())
+{
+}
+
+//**********************************************************************
+
+Result dune::WIB2FrameChecker::check(const void* pframes, size_t nframes) const
+{
+  Result res;
+  res.nframes = nframes;
+  if (nframes < 2) return res;
+  const uint8_t* pbeg = static_cast<const uint8_t*>(pframes);
+  size_t ifrm0 = 1;
+  size_t ibad = npos;
+#ifdef WIB2CHECK_AVX2
+  if (fUseSimd) ifrm0 = checkAvx2(pbeg, nframes, fTickIncrement, res, ibad);
+#endif
+  size_t ibadTail = checkScalar(pbeg, ifrm0, nframes, fTickIncrement, res);
+  if (ibad == npos) ibad = ibadTail;
+  if (!res.ok())
+    {
+      res.firstBadFrame = ibad;
+      res.nBadFragment = 1;
+    }
+  return res;
+}
+
+//**********************************************************************
+
+std::string dune::WIB2FrameChecker::implementationName() const
+{
+  return fUseSimd ? "avx2" : "scalar";
+}
+
+//**********************************************************************
+
+bool dune::WIB2FrameChecker::simdAvailable()
+{
+#ifdef WIB2CHECK_AVX2
+  return cpuHasAvx2();
+#else
+  return false;
+#endif
+}
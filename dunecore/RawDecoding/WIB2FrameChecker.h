@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Class:       WIB2FrameChecker
+// File:        WIB2FrameChecker.h
+//
+// Integrity check for a contiguous block of WIB2 frames, e.g. the payload of one TPC
+// link fragment.  For every frame it compares the first header word (version, detector,
+// crate, slot and link) with that of the first frame and checks that the timestamp
+// advances by the expected number of clock ticks from the previous frame:
+//
+//   header mismatch - header word differs from frame 0
+//   timestamp gap   - timestamp step differs from the expected increment
+//   out of order    - timestamp step is zero or negative
+//
+// Only two header words are read per frame, so the check is bound by the memory
+// traffic of one cache line per frame and is cheap enough to run on all data.
+//
+// Two implementations are provided:
+//   SCALAR - portable loop
+//   SIMD   - AVX2 gathers (x86-64, selected at run time if the CPU supports it)
+// AUTO picks SIMD when available and falls back to SCALAR otherwise.
+// The two paths produce identical results.
+//
+// art-independent class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WIB2FrameChecker_H
+#define WIB2FrameChecker_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dune {
+  class WIB2FrameChecker;
+}
+
+class dune::WIB2FrameChecker {
+
+public:
+
+  enum Mode { AUTO, SCALAR, SIMD };
+
+  // Status bits summarising a check.
+  enum StatusBit {
+    HeaderMismatch = 0x1,
+    TimestampGap   = 0x2,
+    OutOfOrder     = 0x4
+  };
+
+  static constexpr size_t npos = size_t(-1);
+
+  // Result of a check.  Results for several fragments may be summed.
+  struct Result {
+    size_t nframes = 0;
+    size_t nHeaderMismatch = 0;
+    size_t nTimestampGap = 0;
+    size_t nOutOfOrder = 0;
+    size_t firstBadFrame = npos;     // first failing frame of the last fragment with a failure
+    size_t nBadFragment = 0;
+    bool ok() const { return nHeaderMismatch == 0 && nTimestampGap == 0 && nOutOfOrder == 0; }
+    unsigned int status() const {
+      return (nHeaderMismatch ? HeaderMismatch : 0) |
+             (nTimestampGap ? TimestampGap : 0) |
+             (nOutOfOrder ? OutOfOrder : 0);
+    }
+    Result& operator+=(const Result& rhs);
+  };
+
+  // Ctor from the expected timestamp increment between consecutive frames, 32 ticks of
+  // the 62.5 MHz clock for 2 MHz sampling.  Requesting SIMD on a machine without AVX2
+  // silently selects SCALAR.
+  explicit WIB2FrameChecker(uint64_t tickIncrement = 32, Mode mode = AUTO);
+
+  // Check nframes consecutive frames starting at pframes.
+  Result check(const void* pframes, size_t nframes) const;
+
+  // Expected timestamp increment.
+  uint64_t tickIncrement() const { return fTickIncrement; }
+
+  // Return whether this checker uses the vector path.
+  bool usesSimd() const { return fUseSimd; }
+
+  // Name of the implementation in use: "scalar" or "avx2".
+  std::string implementationName() const;
+
+  // Return whether a vector implementation is available on this machine.
+  static bool simdAvailable();
+
+private:
+
+  uint64_t fTickIncrement;
+  bool fUseSimd;
+
+};
+
+#endif
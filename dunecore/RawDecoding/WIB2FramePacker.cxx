@@ -0,0 +1,190 @@
+// WIB2FramePacker.cxx
+
+#include "WIB2FramePacker.h"
+
+#include <cstdint>
+#include <cstring>
+#include "detdataformats/wib2/WIB2Frame.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define WIB2PACK_AVX2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define WIB2PACK_NEON 1
+#endif
+
+using dunedaq::detdataformats::wib2::WIB2Frame;
+
+namespace {
+
+  constexpr unsigned int nchan = dune::WIB2FramePacker::NChannels;
+  constexpr unsigned int bitsPerAdc = WIB2Frame::s_bits_per_adc;
+  constexpr unsigned int nAdcWords = WIB2Frame::s_num_adc_words;
+  constexpr unsigned int nAdcBytes = nAdcWords*sizeof(WIB2Frame::word_t);
+  constexpr uint16_t adcMask = (1u << bitsPerAdc) - 1;
+
+  static_assert(WIB2Frame::s_num_ch_per_frame == (int) nchan, "Unexpected WIB2 channel count");
+  static_assert(bitsPerAdc == 14, "The vector kernels assume 14-bit ADC packing");
+  static_assert(nchan*bitsPerAdc == 8*nAdcBytes, "ADC words are expected to be fully packed");
+
+  inline uint8_t* adcBytes(uint8_t* pframe) {
+    return pframe + offsetof(WIB2Frame, adc_words);
+  }
+
+  // Pack the 256 (already masked) values adcs[ichan] into the ADC words of one frame.
+  // Bits are appended to a 64-bit accumulator and flushed one 32-bit word at a time.
+
+  void packFrameScalar(const uint16_t* adcs, uint8_t* pframe) {
+    uint32_t words[nAdcWords];
+    uint64_t acc = 0;
+    unsigned int nbit = 0;
+    unsigned int iword = 0;
+    for (unsigned int ichan = 0; ichan < nchan; ++ichan)
+      {
+        acc |= uint64_t(adcs[ichan]) << nbit;
+        nbit += bitsPerAdc;
+        if (nbit >= 32)
+          {
+            words[iword++] = uint32_t(acc);
+            acc >>= 32;
+            nbit -= 32;
+          }
+      }
+    std::memcpy(adcBytes(pframe), words, sizeof(words));
+  }
+
+#ifdef WIB2PACK_AVX2
+
+  // Eight channels are packed into 14 bytes per 128-bit lane: pairs of 14-bit values
+  // are merged into 28-bit values with a multiply-add, pairs of those into 56-bit
+  // values with a shift, and the 7 significant bytes of each 64-bit element are then
+  // compacted with a byte shuffle.  Stores are 16 bytes wide, so the result is staged
+  // in a padded local buffer rather than written over the frame trailer.
+
+  __attribute__((target("avx2")))
+  void packFrameAvx2(const uint16_t* adcs, uint8_t* pframe) {
+    const __m256i mul = _mm256_set1_epi32(0x40000001);
+    const __m256i lo32 = _mm256_set1_epi64x(0x00000000ffffffffLL);
+    const __m256i shuf = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6,  8, 9, 10, 11, 12, 13, 14,  -1, -1,
+                                          0, 1, 2, 3, 4, 5, 6,  8, 9, 10, 11, 12, 13, 14,  -1, -1);
+    alignas(32) uint8_t buf[nAdcBytes + 2];
+    uint8_t* p = buf;
+    // 16 channels = 28 bytes per iteration.
+    for (unsigned int ichan = 0; ichan < nchan; ichan += 16, p += 28)
+      {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(adcs + ichan));
+        v = _mm256_madd_epi16(v, mul);
+        v = _mm256_or_si256(_mm256_and_si256(v, lo32), _mm256_srli_epi64(_mm256_andnot_si256(lo32, v), 4));
+        v = _mm256_shuffle_epi8(v, shuf);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 14), _mm256_extracti128_si256(v, 1));
+      }
+    std::memcpy(adcBytes(pframe), buf, nAdcBytes);
+  }
+
+  bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+  }
+
+#endif
+
+#ifdef WIB2PACK_NEON
+
+  // Same 8-channel/14-byte pattern as the AVX2 kernel using shifts and a table lookup.
+
+  void packFrameNeon(const uint16_t* adcs, uint8_t* pframe) {
+    static const uint8_t idx[16] = {0, 1, 2, 3, 4, 5, 6,  8, 9, 10, 11, 12, 13, 14,  255, 255};
+    const uint8x16_t tbl = vld1q_u8(idx);
+    uint8_t buf[nAdcBytes + 2];
+    uint8_t* p = buf;
+    for (unsigned int ichan = 0; ichan < nchan; ichan += 8, p += 14)
+      {
+        uint32x4_t w = vreinterpretq_u32_u16(vld1q_u16(adcs + ichan));
+        w = vorrq_u32(vandq_u32(w, vdupq_n_u32(0xffff)), vshlq_n_u32(vshrq_n_u32(w, 16), 14));
+        uint64x2_t d = vreinterpretq_u64_u32(w);
+        d = vorrq_u64(vandq_u64(d, vdupq_n_u64(0xffffffffULL)), vshlq_n_u64(vshrq_n_u64(d, 32), 28));
+        vst1q_u8(p, vqtbl1q_u8(vreinterpretq_u8_u64(d), tbl));
+      }
+    std::memcpy(adcBytes(pframe), buf, nAdcBytes);
+  }
+
+#endif
+
+  typedef void (*FrameKernel)(const uint16_t*, uint8_t*);
+
+  FrameKernel simdKernel() {
+#if defined(WIB2PACK_AVX2)
+    if (cpuHasAvx2()) return &packFrameAvx2;
+#elif defined(WIB2PACK_NEON)
+    return &packFrameNeon;
+#endif
+    return nullptr;
+  }
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+dune::WIB2FramePacker::WIB2FramePacker(Mode mode)
+  : fUseSimd(mode != SCALAR && simdAvailable())
+{
+}
+
+//**********************************************************************
+
+void dune::WIB2FramePacker::packFrame(const AdcCount* adcs, void* pframe) const
+{
+  uint16_t vals[nchan];
+  for (unsigned int ichan = 0; ichan < nchan; ++ichan) vals[ichan] = adcs[ichan] & adcMask;
+  FrameKernel kernel = fUseSimd ? simdKernel() : &packFrameScalar;
+  kernel(vals, static_cast<uint8_t*>(pframe));
+}
+
+//**********************************************************************
+
+void dune::WIB2FramePacker::pack(const AdcCount* in, size_t nframes, void* pframes) const
+{
+  if (nframes == 0) return;
+  uint8_t* pbeg = static_cast<uint8_t*>(pframes);
+  FrameKernel kernel = fUseSimd ? simdKernel() : &packFrameScalar;
+  uint16_t vals[nchan];
+  for (size_t ifrm = 0; ifrm < nframes; ++ifrm)
+    {
+      const AdcCount* pin = in + ifrm;
+      for (unsigned int ichan = 0; ichan < nchan; ++ichan, pin += nframes)
+        {
+          vals[ichan] = *pin & adcMask;
+        }
+      kernel(vals, pbeg + ifrm*sizeof(WIB2Frame));
+    }
+}
+
+//**********************************************************************
+
+std::string dune::WIB2FramePacker::implementationName() const
+{
+  if (!fUseSimd) return "scalar";
+#if defined(WIB2PACK_AVX2)
+  return "avx2";
+#elif defined(WIB2PACK_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+//**********************************************************************
+
+bool dune::WIB2FramePacker::simdAvailable()
+{
+  return simdKernel() != nullptr;
+}
+
+//**********************************************************************
+
+size_t dune::WIB2FramePacker::frameSize()
+{
+  return sizeof(WIB2Frame);
+}
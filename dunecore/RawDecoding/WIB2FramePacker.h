@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Class:       WIB2FramePacker
+// File:        WIB2FramePacker.h
+//
+// Bulk packer for WIB2 frames, the inverse of WIB2FrameUnpacker.  Instead of calling
+// WIB2Frame::set_adc() once per channel and sample, all 256 channels of a frame are
+// packed into the 112 ADC words in one pass.  The input can be one frame's worth of
+// values or a channel-major block for many frames:
+//
+//   in[ichan*nframes + iframe] = ADC of channel ichan in frame iframe
+//
+// which is the layout of the samples of consecutive raw::RawDigit channels.
+//
+// Only the ADC words are written; the header and trailer of each frame are left as
+// they are, so frames can be initialized from a template before packing.  Values are
+// truncated to their low 14 bits, as WIB2Frame::set_adc does.
+//
+// Two implementations are provided, as for the unpacker:
+//   SCALAR - portable 64-bit bit accumulator
+//   SIMD   - AVX2 (x86-64, selected at run time if the CPU supports it) or
+//            NEON (aarch64, always available)
+// AUTO picks SIMD when available and falls back to SCALAR otherwise.
+// The two paths produce identical frames.
+//
+// art-independent class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WIB2FramePacker_H
+#define WIB2FramePacker_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dune {
+  class WIB2FramePacker;
+}
+
+class dune::WIB2FramePacker {
+
+public:
+
+  typedef short AdcCount;                        // same as raw::RawDigit::ADCvector_t::value_type
+
+  enum Mode { AUTO, SCALAR, SIMD };
+
+  static constexpr unsigned int NChannels = 256;     // channels per WIB2 frame
+
+  // Ctor.  Requesting SIMD on a machine without AVX2/NEON silently selects SCALAR.
+  explicit WIB2FramePacker(Mode mode = AUTO);
+
+  // Pack the NChannels values adcs[ichan] into the ADC words of the frame at pframe.
+  void packFrame(const AdcCount* adcs, void* pframe) const;
+
+  // Pack nframes consecutive frames starting at pframes from the channel-major block
+  // in, which holds NChannels*nframes values (see above).
+  void pack(const AdcCount* in, size_t nframes, void* pframes) const;
+
+  // Return whether this packer uses the vector path.
+  bool usesSimd() const { return fUseSimd; }
+
+  // Name of the implementation in use: "scalar", "avx2" or "neon".
+  std::string implementationName() const;
+
+  // Return whether a vector implementation is available on this machine.
+  static bool simdAvailable();
+
+  // Size in bytes of one WIB2 frame.
+  static size_t frameSize();
+
+private:
+
+  bool fUseSimd;
+
+};
+
+#endif
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Class:       WIB2FrameTraits
+// File:        WIB2FrameTraits.h
+//
+// Frame traits for PackedFrameUnpacker describing the WIB2 frame: 256 channels of one
+// time sample each, packed as 14-bit values in the ADC words.  The decoders use the
+// vectorised WIB2FrameUnpacker for the samples of this format and the traits for the
+// frame size and header.
+//
+// art-independent class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WIB2FrameTraits_H
+#define WIB2FrameTraits_H
+
+#include "dunecore/RawDecoding/PackedFrameUnpacker.h"
+#include "detdataformats/wib2/WIB2Frame.hpp"
+#include <cstddef>
+
+namespace dune {
+  struct WIB2FrameTraits;
+}
+
+struct dune::WIB2FrameTraits {
+
+  typedef dunedaq::detdataformats::wib2::WIB2Frame Frame;
+
+  static constexpr size_t FrameSize = sizeof(Frame);
+  static constexpr size_t AdcOffset = offsetof(Frame, adc_words);
+  static constexpr unsigned int NChannels = Frame::s_num_ch_per_frame;
+  static constexpr unsigned int NTicks = 1;
+  static constexpr unsigned int BitsPerAdc = Frame::s_bits_per_adc;
+
+  static FrameHeader header(const uint8_t* pframe) {
+    const Frame* frame = reinterpret_cast<const Frame*>(pframe);
+    FrameHeader hdr;
+    hdr.crate = frame->header.crate;
+    hdr.slot = frame->header.slot;
+    hdr.link = frame->header.link;
+    hdr.timestamp = frame->get_timestamp();
+    return hdr;
+  }
+
+};
+
+#endif
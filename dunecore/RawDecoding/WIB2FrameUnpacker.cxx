@@ -0,0 +1,197 @@
+// WIB2FrameUnpacker.cxx
+
+#include "WIB2FrameUnpacker.h"
+
+#include <cstdint>
+#include <cstring>
+#include "detdataformats/wib2/WIB2Frame.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define WIB2UNPACK_AVX2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define WIB2UNPACK_NEON 1
+#endif
+
+using dunedaq::detdataformats::wib2::WIB2Frame;
+
+namespace {
+
+  typedef dune::WIB2FrameUnpacker::AdcCount AdcCount;
+
+  constexpr unsigned int nchan = dune::WIB2FrameUnpacker::NChannels;
+  constexpr unsigned int bitsPerAdc = WIB2Frame::s_bits_per_adc;
+  constexpr unsigned int nAdcWords = WIB2Frame::s_num_adc_words;
+  constexpr uint32_t adcMask = (1u << bitsPerAdc) - 1;
+
+  static_assert(WIB2Frame::s_num_ch_per_frame == (int) nchan, "Unexpected WIB2 channel count");
+  static_assert(bitsPerAdc == 14, "The vector kernels assume 14-bit ADC packing");
+
+  inline const uint8_t* adcBytes(const uint8_t* pframe) {
+    return pframe + offsetof(WIB2Frame, adc_words);
+  }
+
+  // Decode the 256 channels of one frame into adcs[ichan].
+  // Each value is taken from the 32-bit word holding its low bit, completed from the
+  // next word when it straddles a word boundary.
+
+  void unpackFrameScalar(const uint8_t* pframe, uint16_t* adcs) {
+    uint32_t words[nAdcWords];
+    std::memcpy(words, adcBytes(pframe), sizeof(words));
+    for (unsigned int ichan = 0; ichan < nchan; ++ichan)
+      {
+        unsigned int bit = bitsPerAdc*ichan;
+        unsigned int iword = bit/32;
+        unsigned int shift = bit%32;
+        uint32_t adc = words[iword] >> shift;
+        if (shift + bitsPerAdc > 32) adc |= words[iword+1] << (32 - shift);
+        adcs[ichan] = adc & adcMask;
+      }
+  }
+
+#ifdef WIB2UNPACK_AVX2
+
+  // Four consecutive channels occupy exactly 7 bytes with intra-byte bit offsets
+  // 0, 6, 4, 2.  Each 128-bit lane gathers the 4 bytes covering each channel into a
+  // 32-bit element with a byte shuffle, shifts it into place and masks it.
+  // Loads are 16 bytes wide and so read up to 9 bytes past the ADC words of the
+  // frame.  That stays inside the frame (trailer) except for the last frame of a
+  // buffer, which the caller decodes with the scalar kernel.
+
+  __attribute__((target("avx2")))
+  inline __m256i unpack8Avx2(const uint8_t* p) {
+    const __m256i shuf = _mm256_setr_epi8(0, 1, 2, 3,  1, 2, 3, 4,  3, 4, 5, 6,  5, 6, 7, 8,
+                                          0, 1, 2, 3,  1, 2, 3, 4,  3, 4, 5, 6,  5, 6, 7, 8);
+    const __m256i shifts = _mm256_setr_epi32(0, 6, 4, 2, 0, 6, 4, 2);
+    const __m256i mask = _mm256_set1_epi32(adcMask);
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 7));
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    v = _mm256_shuffle_epi8(v, shuf);
+    v = _mm256_srlv_epi32(v, shifts);
+    return _mm256_and_si256(v, mask);
+  }
+
+  __attribute__((target("avx2")))
+  void unpackFrameAvx2(const uint8_t* pframe, uint16_t* adcs) {
+    const uint8_t* p = adcBytes(pframe);
+    // 16 channels = 28 bytes per iteration.
+    for (unsigned int ichan = 0; ichan < nchan; ichan += 16, p += 28)
+      {
+        __m256i a = unpack8Avx2(p);
+        __m256i b = unpack8Avx2(p + 14);
+        // packus works per lane: (a0-3, b0-3 | a4-7, b4-7) -> reorder 64-bit blocks.
+        __m256i packed = _mm256_packus_epi32(a, b);
+        packed = _mm256_permute4x64_epi64(packed, 0xd8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(adcs + ichan), packed);
+      }
+  }
+
+  bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+  }
+
+#endif
+
+#ifdef WIB2UNPACK_NEON
+
+  // Same 7-byte/4-channel pattern as the AVX2 kernel using a table lookup.
+
+  inline uint16x4_t unpack4Neon(const uint8_t* p) {
+    static const uint8_t idx[16] = {0, 1, 2, 3,  1, 2, 3, 4,  3, 4, 5, 6,  5, 6, 7, 8};
+    static const int32_t nsh[4] = {0, -6, -4, -2};
+    uint8x16_t v = vqtbl1q_u8(vld1q_u8(p), vld1q_u8(idx));
+    uint32x4_t w = vshlq_u32(vreinterpretq_u32_u8(v), vld1q_s32(nsh));
+    w = vandq_u32(w, vdupq_n_u32(adcMask));
+    return vmovn_u32(w);
+  }
+
+  void unpackFrameNeon(const uint8_t* pframe, uint16_t* adcs) {
+    const uint8_t* p = adcBytes(pframe);
+    for (unsigned int ichan = 0; ichan < nchan; ichan += 8, p += 14)
+      {
+        vst1q_u16(adcs + ichan, vcombine_u16(unpack4Neon(p), unpack4Neon(p + 7)));
+      }
+  }
+
+#endif
+
+  typedef void (*FrameKernel)(const uint8_t*, uint16_t*);
+
+  FrameKernel simdKernel() {
+#if defined(WIB2UNPACK_AVX2)
+    if (cpuHasAvx2()) return &unpackFrameAvx2;
+#elif defined(WIB2UNPACK_NEON)
+    return &unpackFrameNeon;
+#endif
+    return nullptr;
+  }
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+dune::WIB2FrameUnpacker::WIB2FrameUnpacker(Mode mode)
+  : fUseSimd(mode != SCALAR && simdAvailable())
+{
+}
+
+//**********************************************************************
+
+void dune::WIB2FrameUnpacker::unpack(const void* pframes, size_t nframes, AdcCount* out) const
+{
+  if (nframes == 0) return;
+  const uint8_t* pbeg = static_cast<const uint8_t*>(pframes);
+  FrameKernel kernel = fUseSimd ? simdKernel() : nullptr;
+  uint16_t adcs[nchan];
+  for (size_t ifrm = 0; ifrm < nframes; ++ifrm)
+    {
+      const uint8_t* pframe = pbeg + ifrm*sizeof(WIB2Frame);
+      // The vector loads may run past the end of the last frame.
+      if (kernel != nullptr && ifrm + 1 < nframes) kernel(pframe, adcs);
+      else unpackFrameScalar(pframe, adcs);
+      AdcCount* pout = out + ifrm;
+      for (unsigned int ichan = 0; ichan < nchan; ++ichan, pout += nframes)
+        {
+          *pout = adcs[ichan];
+        }
+    }
+}
+
+//**********************************************************************
+
+void dune::WIB2FrameUnpacker::unpack(const void* pframes, size_t nframes, AdcCountVector& out) const
+{
+  out.resize(nchan*nframes);
+  unpack(pframes, nframes, out.data());
+}
+
+//**********************************************************************
+
+std::string dune::WIB2FrameUnpacker::implementationName() const
+{
+  if (!fUseSimd) return "scalar";
+#if defined(WIB2UNPACK_AVX2)
+  return "avx2";
+#elif defined(WIB2UNPACK_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+//**********************************************************************
+
+bool dune::WIB2FrameUnpacker::simdAvailable()
+{
+  return simdKernel() != nullptr;
+}
+
+//**********************************************************************
+
+size_t dune::WIB2FrameUnpacker::frameSize()
+{
+  return sizeof(WIB2Frame);
+}
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Class:       WIB2FrameUnpacker
+// File:        WIB2FrameUnpacker.h
+//
+// Bulk unpacker for a contiguous block of WIB2 frames, e.g. the payload of one
+// TPC link fragment.  Each frame carries 256 channels of 14-bit ADC values packed
+// into 112 32-bit words.  Rather than calling WIB2Frame::get_adc() once per sample,
+// the whole block is decoded in one pass into a caller-supplied, channel-major buffer:
+//
+//   out[ichan*nframes + iframe] = ADC of channel ichan in frame iframe
+//
+// so that the samples of each channel are contiguous and can be handed directly to
+// raw::RawDigit.
+//
+// Two implementations are provided:
+//   SCALAR - portable word-window extraction
+//   SIMD   - AVX2 (x86-64, selected at run time if the CPU supports it) or
+//            NEON (aarch64, always available)
+// AUTO picks SIMD when available and falls back to SCALAR otherwise.
+// The two paths produce identical results.
+//
+// art-independent class
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WIB2FrameUnpacker_H
+#define WIB2FrameUnpacker_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dune {
+  class WIB2FrameUnpacker;
+}
+
+class dune::WIB2FrameUnpacker {
+
+public:
+
+  typedef short AdcCount;                        // same as raw::RawDigit::ADCvector_t::value_type
+  typedef std::vector<AdcCount> AdcCountVector;
+
+  enum Mode { AUTO, SCALAR, SIMD };
+
+  static constexpr unsigned int NChannels = 256;     // channels per WIB2 frame
+
+  // Ctor.  Requesting SIMD on a machine without AVX2/NEON silently selects SCALAR.
+  explicit WIB2FrameUnpacker(Mode mode = AUTO);
+
+  // Unpack nframes consecutive frames starting at pframes into out, which must
+  // have room for NChannels*nframes values.  Layout is channel-major (see above).
+  void unpack(const void* pframes, size_t nframes, AdcCount* out) const;
+
+  // Same, resizing out to NChannels*nframes.  The vector is reused if it is
+  // already large enough, so keeping one per decoder avoids reallocations.
+  void unpack(const void* pframes, size_t nframes, AdcCountVector& out) const;
+
+  // Return whether this unpacker uses the vector path.
+  bool usesSimd() const { return fUseSimd; }
+
+  // Name of the implementation in use: "scalar", "avx2" or "neon".
+  std::string implementationName() const;
+
+  // Return whether a vector implementation is available on this machine.
+  static bool simdAvailable();
+
+  // Size in bytes of one WIB2 frame.
+  static size_t frameSize();
+
+private:
+
+  bool fUseSimd;
+
+};
+
+#endif
@@ -0,0 +1,368 @@
+// dataprepbench.cxx
+//
+// Benchmark for decoding and data preparation outside art.
+//
+// The trigger records in an HDF5 raw data file are read, their TPC link
+// fragments are decoded as in FDHDDataInterface and the resulting channels are
+// passed as TpcData (one ADC channel map per APA) to a chain of TpcDataTool
+// tools. This is repeated for each requested thread count and the event and
+// byte rates, the time in each stage and the peak resident memory are reported.
+//
+// The stages are:
+//   read   - reading the link datasets from the file (serial, as HDF5 is not thread safe)
+//   decode - unpacking the WIB2 frames and finding pedestals (TBB, one task per link)
+//   build  - mapping to offline channels and filling the ADC channel data
+//   TOOL   - the updateTpcData call for each tool in the chain
+// If DUNE_BENCH_DB is set, the median and spread over events of the time in each
+// stage are added to that BenchmarkDB file for comparison with benchcompare.
+//
+// The fcl file provides both the services, including FDHDChannelMapService,
+// in the form accepted by ArtServiceHelper and the tools in the form read by
+// DuneToolManager.
+
+#include "dunecore/ArtSupport/ArtServiceHelper.h"
+#include "dunecore/ArtSupport/DuneToolManager.h"
+#include "dunecore/DuneCommon/Utility/BenchmarkDB.h"
+#include "dunecore/DuneInterface/Tool/TpcDataTool.h"
+#include "dunecore/DuneInterface/Data/TpcData.h"
+#include "dunecore/HDF5Utils/HDF5Utils.h"
+#include "dunecore/ChannelMap/FDHDChannelMapService.h"
+#include "dunecore/RawDecoding/WIB2FrameUnpacker.h"
+#include "dunecore/RawDecoding/AdcPedestalFinder.h"
+#include "detdataformats/wib2/WIB2Frame.hpp"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "tbb/global_control.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include <hdf5.h>
+#include <sys/resource.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <deque>
+#include <algorithm>
+#include <cstdlib>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::setw;
+using std::fixed;
+using std::setprecision;
+using std::vector;
+using std::ifstream;
+using std::istringstream;
+
+using Index = unsigned int;
+using IndexVector = std::vector<Index>;
+using NameVector = std::vector<string>;
+using Clock = std::chrono::steady_clock;
+using dunedaq::daqdataformats::FragmentHeader;
+using dunedaq::detdataformats::wib2::WIB2Frame;
+using dune::WIB2FrameUnpacker;
+using dune::AdcPedestalFinder;
+
+namespace {
+
+//**********************************************************************
+
+// Data for one link.
+struct LinkData {
+  Index iapa = 0;
+  std::vector<char> bytes;
+  size_t nframe = 0;
+  WIB2FrameUnpacker::AdcCountVector adcs;
+  std::vector<AdcPedestalFinder::Pedestal> peds;
+  unsigned int crate = 0;
+  unsigned int slot = 0;
+  unsigned int link = 0;
+};
+
+// Accumulated times for one pass and the times for each event.
+struct StageTimes {
+  double read = 0.0;
+  double decode = 0.0;
+  double build = 0.0;
+  std::vector<double> tools;
+  std::vector<double> readEvents;
+  std::vector<double> decodeEvents;
+  std::vector<double> buildEvents;
+  std::vector<std::vector<double>> toolEvents;
+};
+
+double seconds(Clock::time_point t0, Clock::time_point t1) {
+  return std::chrono::duration<double>(t1 - t0).count();
+}
+
+// Peak resident memory in MB.
+double peakRssMB() {
+  struct rusage usage;
+  if ( getrusage(RUSAGE_SELF, &usage) != 0 ) return 0.0;
+  return usage.ru_maxrss/1024.0;
+}
+
+// Split a comma-separated list.
+NameVector splitList(string slist) {
+  NameVector out;
+  istringstream sin(slist);
+  string sval;
+  while ( std::getline(sin, sval, ',') ) if ( sval.size() ) out.push_back(sval);
+  return out;
+}
+
+IndexVector splitIndexList(string slist) {
+  IndexVector out;
+  for ( string sval : splitList(slist) ) out.push_back(std::stoi(sval));
+  return out;
+}
+
+//**********************************************************************
+
+// Read the TPC links of one record.
+// Returns the number of bytes read.
+size_t readRecord(hid_t fd, const string& recnam, const IndexVector& apas, vector<LinkData>& links) {
+  using namespace dune::HDF5Utils;
+  links.clear();
+  RecordIndexPtr pidx = getRecordIndex(fd, recnam);
+  const DetectorInfo* ptpc = pidx == nullptr ? nullptr : pidx->detector("TPC");
+  if ( ptpc == nullptr ) return 0;
+  hid_t grp = getGroupFromPath(fd, recnam);
+  size_t nbyte = 0;
+  for ( Index iapa=0; iapa<ptpc->elements.size(); ++iapa ) {
+    const ElementInfo& apa = ptpc->elements[iapa];
+    // The APA group names are of the form APAnnn.
+    Index apanum = std::atoi(apa.name.substr(3, 3).c_str());
+    if ( apas.size() && std::find(apas.begin(), apas.end(), apanum) == apas.end() ) continue;
+    for ( const DatasetInfo& dsi : apa.datasets ) {
+      if ( dsi.dataSize <= sizeof(FragmentHeader) ) continue;
+      links.emplace_back();
+      LinkData& lnk = links.back();
+      lnk.iapa = iapa;
+      lnk.bytes.resize(dsi.dataSize);
+      hid_t ds = H5Dopen(grp, dsi.path.data(), H5P_DEFAULT);
+      H5Dread(ds, H5T_STD_I8LE, H5S_ALL, H5S_ALL, H5P_DEFAULT, lnk.bytes.data());
+      H5Dclose(ds);
+      lnk.nframe = (dsi.dataSize - sizeof(FragmentHeader))/sizeof(WIB2Frame);
+      nbyte += dsi.dataSize;
+    }
+  }
+  H5Gclose(grp);
+  return nbyte;
+}
+
+//**********************************************************************
+
+// Decode one link.
+void decodeLink(const WIB2FrameUnpacker& unpacker, LinkData& lnk) {
+  static thread_local AdcPedestalFinder pedFinder;
+  if ( lnk.nframe == 0 ) return;
+  const WIB2Frame* pfrms = reinterpret_cast<const WIB2Frame*>(lnk.bytes.data() + sizeof(FragmentHeader));
+  unpacker.unpack(pfrms, lnk.nframe, lnk.adcs);
+  pedFinder.evaluate(lnk.adcs.data(), WIB2FrameUnpacker::NChannels, lnk.nframe, lnk.peds);
+  lnk.crate = pfrms[0].header.crate;
+  lnk.slot = pfrms[0].header.slot & 0x7;
+  lnk.link = pfrms[0].header.link;
+}
+
+//**********************************************************************
+
+// Fill TpcData with one map per APA from the decoded links.
+void buildTpcData(const dune::FDHDChannelMapService& chmap, const vector<LinkData>& links,
+                  Index nmap, Index run, Index evt, TpcData& tpd) {
+  AdcChannelData::EventInfoPtr pevi(new DuneEventInfo(run, evt));
+  std::vector<TpcData::AdcDataPtr> pacdss;
+  for ( Index imap=0; imap<nmap; ++imap ) pacdss.push_back(tpd.createAdcData());
+  std::vector<unsigned int> chans;
+  for ( const LinkData& lnk : links ) {
+    if ( lnk.nframe == 0 ) continue;
+    AdcChannelDataMap& acds = *pacdss[lnk.iapa];
+    chans.clear();
+    chmap.GetOfflChansFromWIBElements(lnk.crate, lnk.slot, lnk.link, chans);
+    for ( Index ilch=0; ilch<chans.size() && ilch<WIB2FrameUnpacker::NChannels; ++ilch ) {
+      AdcChannelData& acd = acds[chans[ilch]];
+      acd.setEventInfo(pevi);
+      acd.setChannelInfo(chans[ilch]);
+      auto iadc = lnk.adcs.begin() + ilch*lnk.nframe;
+      acd.raw.assign(iadc, iadc + lnk.nframe);
+      acd.pedestal = lnk.peds[ilch].median;
+      acd.pedestalRms = lnk.peds[ilch].sigma;
+    }
+  }
+}
+
+//**********************************************************************
+
+int help(string prog) {
+  cout << "Usage: " << prog << " -c FCL -t TOOL1,TOOL2,... [-n NEVT] [-j NTHR1,NTHR2,...] [-a APA1,...] FILE" << endl;
+  cout << "  FCL - fcl file with the service and tool configurations" << endl;
+  cout << "  TOOL - names of the TpcDataTool tools applied to each event" << endl;
+  cout << "  NEVT - maximum number of records to process (default is all)" << endl;
+  cout << "  NTHR - thread counts for the sweep (default 1)" << endl;
+  cout << "  APA - APAs to decode (default is all)" << endl;
+  cout << "  FILE - HDF5 raw data file" << endl;
+  return 0;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int main(int argc, char** argv) {
+  const string myname = "dataprepbench: ";
+  string prog = argv[0];
+  string fclname;
+  string filename;
+  NameVector toolNames;
+  Index nevtMax = 0;
+  IndexVector nthrs = {1};
+  IndexVector apas;
+  for ( int iarg=1; iarg<argc; ++iarg ) {
+    string sarg = argv[iarg];
+    bool haveVal = iarg + 1 < argc;
+    if ( sarg == "-h" ) return help(prog);
+    if ( sarg[0] == '-' && ! haveVal ) {
+      cout << myname << "ERROR: Option " << sarg << " requires a value." << endl;
+      return 1;
+    }
+    if      ( sarg == "-c" ) fclname = argv[++iarg];
+    else if ( sarg == "-t" ) toolNames = splitList(argv[++iarg]);
+    else if ( sarg == "-n" ) nevtMax = std::stoi(argv[++iarg]);
+    else if ( sarg == "-j" ) nthrs = splitIndexList(argv[++iarg]);
+    else if ( sarg == "-a" ) apas = splitIndexList(argv[++iarg]);
+    else if ( sarg[0] == '-' ) {
+      cout << myname << "ERROR: Invalid option: " << sarg << endl;
+      return 1;
+    } else filename = sarg;
+  }
+  if ( fclname.empty() || filename.empty() ) {
+    help(prog);
+    return 1;
+  }
+
+  // Services and tools.
+  {
+    ifstream fin(fclname);
+    if ( ! fin ) {
+      cout << myname << "ERROR: Unable to open fcl file " << fclname << endl;
+      return 2;
+    }
+    // Only the channel map is used, so the other services are not constructed.
+    ArtServiceHelper::setLazyCreation(true);
+    ArtServiceHelper::load_services(fin);
+  }
+  art::ServiceHandle<dune::FDHDChannelMapService> hchmap;
+  const dune::FDHDChannelMapService& chmap = *hchmap;
+  DuneToolManager* ptm = DuneToolManager::instance(fclname);
+  if ( ptm == nullptr ) {
+    cout << myname << "ERROR: Unable to retrieve tool manager." << endl;
+    return 3;
+  }
+  std::vector<TpcDataTool*> tools;
+  for ( string tnam : toolNames ) {
+    TpcDataTool* ptoo = ptm->getShared<TpcDataTool>(tnam);
+    if ( ptoo == nullptr ) {
+      cout << myname << "ERROR: Unable to retrieve tool " << tnam << endl;
+      return 4;
+    }
+    tools.push_back(ptoo);
+  }
+
+  // Input file.
+  dune::HDF5Utils::HDFFileInfoPtr pfil = dune::HDF5Utils::openFile(filename);
+  if ( pfil == nullptr || pfil->filePtr < 0 ) {
+    cout << myname << "ERROR: Unable to open " << filename << endl;
+    return 5;
+  }
+  hid_t fd = pfil->filePtr;
+  std::deque<string> recnams = dune::HDF5Utils::getTopLevelGroupNames(pfil);
+  if ( nevtMax > 0 && recnams.size() > nevtMax ) recnams.resize(nevtMax);
+  Index run = pfil->runNumber;
+  cout << myname << "Processing " << recnams.size() << " records from " << filename << endl;
+
+  WIB2FrameUnpacker unpacker;
+  cout << myname << "Unpacker: " << unpacker.implementationName() << endl;
+
+  // Sweep the thread counts.
+  vector<LinkData> links;
+  for ( Index nthr : nthrs ) {
+    tbb::global_control gc(tbb::global_control::max_allowed_parallelism, nthr);
+    StageTimes tims;
+    tims.tools.resize(tools.size(), 0.0);
+    tims.toolEvents.resize(tools.size());
+    size_t nbyte = 0;
+    Index nevt = 0;
+    Index nchan = 0;
+    Clock::time_point tstart = Clock::now();
+    for ( const string& recnam : recnams ) {
+      Clock::time_point t0 = Clock::now();
+      nbyte += readRecord(fd, recnam, apas, links);
+      Clock::time_point t1 = Clock::now();
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, links.size()),
+                        [&](const tbb::blocked_range<size_t>& ilnks) {
+        for ( size_t ilnk=ilnks.begin(); ilnk<ilnks.end(); ++ilnk ) decodeLink(unpacker, links[ilnk]);
+      });
+      Clock::time_point t2 = Clock::now();
+      Index nmap = 0;
+      for ( const LinkData& lnk : links ) if ( lnk.iapa >= nmap ) nmap = lnk.iapa + 1;
+      TpcData tpd;
+      buildTpcData(chmap, links, nmap, run, nevt, tpd);
+      for ( const TpcData::AdcDataPtr& pacds : tpd.getAdcData() ) nchan += pacds->size();
+      Clock::time_point t3 = Clock::now();
+      tims.readEvents.push_back(seconds(t0, t1));
+      tims.decodeEvents.push_back(seconds(t1, t2));
+      tims.buildEvents.push_back(seconds(t2, t3));
+      tims.read += tims.readEvents.back();
+      tims.decode += tims.decodeEvents.back();
+      tims.build += tims.buildEvents.back();
+      for ( Index itoo=0; itoo<tools.size(); ++itoo ) {
+        Clock::time_point tt0 = Clock::now();
+        DataMap ret = tools[itoo]->updateTpcData(tpd);
+        tims.toolEvents[itoo].push_back(seconds(tt0, Clock::now()));
+        tims.tools[itoo] += tims.toolEvents[itoo].back();
+        if ( ret.status() != 0 && nevt == 0 ) {
+          cout << myname << "WARNING: Tool " << toolNames[itoo] << " returned status " << ret.status() << endl;
+        }
+      }
+      ++nevt;
+    }
+    double ttot = seconds(tstart, Clock::now());
+    double mbyte = 1.e-6*nbyte;
+    cout << myname << "----------------------------------------" << endl;
+    cout << myname << "Threads: " << nthr << endl;
+    cout << myname << "  Events: " << nevt << " (" << nchan << " channels)" << endl;
+    cout << myname << fixed << setprecision(3);
+    cout << myname << "  Total time: " << ttot << " s" << endl;
+    cout << myname << "  Rate: " << (ttot > 0.0 ? nevt/ttot : 0.0) << " events/s, "
+         << (ttot > 0.0 ? mbyte/ttot : 0.0) << " MB/s (" << mbyte << " MB read)" << endl;
+    cout << myname << "  Stage times [s/event]:" << endl;
+    double fevt = nevt ? 1.0/nevt : 0.0;
+    cout << myname << setw(30) << "read" << setw(12) << fevt*tims.read << endl;
+    cout << myname << setw(30) << "decode" << setw(12) << fevt*tims.decode << endl;
+    cout << myname << setw(30) << "build" << setw(12) << fevt*tims.build << endl;
+    for ( Index itoo=0; itoo<tools.size(); ++itoo ) {
+      cout << myname << setw(30) << toolNames[itoo] << setw(12) << fevt*tims.tools[itoo] << endl;
+    }
+    cout << myname << "  Peak RSS (job so far): " << peakRssMB() << " MB" << endl;
+    cout.unsetf(std::ios_base::floatfield);
+    string sthr = " threads " + std::to_string(nthr);
+    BenchmarkDB::record("dataprepbench read" + sthr, "time", "s/event", false, tims.readEvents);
+    BenchmarkDB::record("dataprepbench decode" + sthr, "time", "s/event", false, tims.decodeEvents);
+    BenchmarkDB::record("dataprepbench build" + sthr, "time", "s/event", false, tims.buildEvents);
+    for ( Index itoo=0; itoo<tools.size(); ++itoo ) {
+      BenchmarkDB::record("dataprepbench " + toolNames[itoo] + sthr, "time", "s/event", false,
+                          tims.toolEvents[itoo]);
+    }
+  }
+
+  for ( TpcDataTool* ptoo : tools ) ptoo->close();
+  dune::HDF5Utils::closeFile(std::move(pfil));
+  return 0;
+}
+
+//**********************************************************************
@@ -0,0 +1,230 @@
+// wib2decodebench.cxx
+//
+// Microbenchmark for the steps of the TPC decoding in FDHDDataInterface run on
+// synthetic WIB2 frames held in memory.
+//
+// Pedestal-like ADC values are generated for each link and packed into frames
+// with WIB2FramePacker. The following are then timed separately, repeating each
+// NREP times and keeping the fastest:
+//   pack           - WIB2FramePacker with the scalar and SIMD paths
+//   unpack         - WIB2FrameUnpacker with the scalar and SIMD paths
+//   channel copy   - copying the channel-major samples into one vector per offline
+//                    channel through a channel list, as when the RawDigits are made
+//   pedestal       - AdcPedestalFinder batch evaluation for each link
+// Rates are given in ns/sample and in GB/s of frame data (pack, unpack) or of
+// 16-bit samples (copy, pedestal).
+//
+// The SIMD unpack result is checked against the scalar one. If a maximum unpack
+// time is given with -m, the program returns nonzero when the fastest unpack
+// exceeds it so that the benchmark can be used as a regression check. If
+// DUNE_BENCH_DB is set, the median and spread of ns/sample over the repetitions
+// of each step are added to that BenchmarkDB file for comparison with benchcompare.
+
+#include "dunecore/RawDecoding/WIB2FrameUnpacker.h"
+#include "dunecore/RawDecoding/WIB2FramePacker.h"
+#include "dunecore/RawDecoding/AdcPedestalFinder.h"
+#include "dunecore/DuneCommon/Utility/BenchmarkDB.h"
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::setw;
+using std::fixed;
+using std::setprecision;
+using std::vector;
+using dune::WIB2FrameUnpacker;
+using dune::WIB2FramePacker;
+using dune::AdcPedestalFinder;
+
+using Index = unsigned int;
+using AdcCount = WIB2FrameUnpacker::AdcCount;
+using AdcCountVector = WIB2FrameUnpacker::AdcCountVector;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+//**********************************************************************
+
+// Run fun nrep times and return the fastest time in seconds.
+// The time of each repetition is returned in tsecs.
+template<class F>
+double fastest(Index nrep, F fun, vector<double>& tsecs) {
+  double tmin = 0.0;
+  tsecs.clear();
+  for ( Index irep=0; irep<nrep; ++irep ) {
+    Clock::time_point t0 = Clock::now();
+    fun();
+    double tsec = std::chrono::duration<double>(Clock::now() - t0).count();
+    tsecs.push_back(tsec);
+    if ( irep == 0 || tsec < tmin ) tmin = tsec;
+  }
+  return tmin;
+}
+
+// Print one row of the summary and record ns/sample for each repetition.
+void printRow(string myname, string label, double tsec, double nsam, double nbyte,
+              const vector<double>& tsecs) {
+  cout << myname << setw(24) << label
+       << setw(12) << (nsam > 0 ? 1.e9*tsec/nsam : 0.0)
+       << setw(12) << (tsec > 0 ? 1.e-9*nbyte/tsec : 0.0) << endl;
+  vector<double> nsPerSam;
+  for ( double trep : tsecs ) nsPerSam.push_back(nsam > 0 ? 1.e9*trep/nsam : 0.0);
+  BenchmarkDB::record("wib2decodebench " + label, "time", "ns/sample", false, nsPerSam);
+}
+
+int help(string prog) {
+  cout << "Usage: " << prog << " [-l NLINK] [-f NFRAME] [-r NREP] [-m MAXNS]" << endl;
+  cout << "  NLINK - number of links (default 10)" << endl;
+  cout << "  NFRAME - frames per link (default 8192)" << endl;
+  cout << "  NREP - repetitions of each measurement, the fastest is kept (default 5)" << endl;
+  cout << "  MAXNS - fail if the fastest unpack takes more than MAXNS ns/sample" << endl;
+  return 0;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int main(int argc, char** argv) {
+  const string myname = "wib2decodebench: ";
+  string prog = argv[0];
+  Index nlnk = 10;
+  Index nfrm = 8192;
+  Index nrep = 5;
+  double maxns = 0.0;
+  for ( int iarg=1; iarg<argc; ++iarg ) {
+    string sarg = argv[iarg];
+    if ( sarg == "-h" ) return help(prog);
+    if ( iarg + 1 >= argc ) {
+      cout << myname << "ERROR: Invalid or incomplete option: " << sarg << endl;
+      return 1;
+    }
+    string sval = argv[++iarg];
+    if      ( sarg == "-l" ) nlnk = std::stoi(sval);
+    else if ( sarg == "-f" ) nfrm = std::stoi(sval);
+    else if ( sarg == "-r" ) nrep = std::stoi(sval);
+    else if ( sarg == "-m" ) maxns = std::stod(sval);
+    else {
+      cout << myname << "ERROR: Invalid option: " << sarg << endl;
+      return 1;
+    }
+  }
+  if ( nlnk == 0 || nfrm == 0 || nrep == 0 ) {
+    cout << myname << "ERROR: Link, frame and repetition counts must be nonzero." << endl;
+    return 1;
+  }
+  const Index nchan = WIB2FrameUnpacker::NChannels;
+  const size_t frmSize = WIB2FrameUnpacker::frameSize();
+  const size_t lnkSize = nfrm*frmSize;
+  const size_t nsamLink = size_t(nchan)*nfrm;
+  const double nsam = double(nsamLink)*nlnk;
+  const double frameBytes = double(lnkSize)*nlnk;
+  const double sampleBytes = nsam*sizeof(AdcCount);
+  cout << myname << "Links: " << nlnk << ", frames/link: " << nfrm << ", repetitions: " << nrep << endl;
+  cout << myname << "Frame data: " << 1.e-6*frameBytes << " MB, samples: " << nsam << endl;
+  cout << myname << "SIMD available: " << (WIB2FrameUnpacker::simdAvailable() ? "yes" : "no") << endl;
+
+  // Generate pedestal-like samples, channel-major for each link.
+  vector<AdcCountVector> inputs(nlnk);
+  std::mt19937 gen(24680);
+  std::normal_distribution<float> noise(0.0, 4.0);
+  std::uniform_int_distribution<int> peddist(500, 1000);
+  for ( AdcCountVector& adcs : inputs ) {
+    adcs.resize(nsamLink);
+    for ( Index ichan=0; ichan<nchan; ++ichan ) {
+      int ped = peddist(gen);
+      for ( Index ifrm=0; ifrm<nfrm; ++ifrm ) {
+        int adc = ped + int(std::lround(noise(gen)));
+        adcs[ichan*nfrm + ifrm] = std::min(std::max(adc, 0), 0x3fff);
+      }
+    }
+  }
+  vector<vector<char>> frames(nlnk, vector<char>(lnkSize, 0));
+
+  // Offline channel list for each link: a shuffled range, as from the channel map.
+  vector<vector<Index>> lnkChans(nlnk, vector<Index>(nchan));
+  for ( Index ilnk=0; ilnk<nlnk; ++ilnk ) {
+    std::iota(lnkChans[ilnk].begin(), lnkChans[ilnk].end(), ilnk*nchan);
+    std::shuffle(lnkChans[ilnk].begin(), lnkChans[ilnk].end(), gen);
+  }
+
+  cout << myname << setw(24) << "Step" << setw(12) << "ns/sample" << setw(12) << "GB/s" << endl;
+  cout << fixed << setprecision(3);
+  vector<double> tsecs;
+
+  // Pack.
+  for ( WIB2FramePacker::Mode mode : {WIB2FramePacker::SCALAR, WIB2FramePacker::SIMD} ) {
+    WIB2FramePacker pkr(mode);
+    if ( mode == WIB2FramePacker::SIMD && ! pkr.usesSimd() ) continue;
+    double tsec = fastest(nrep, [&]() {
+      for ( Index ilnk=0; ilnk<nlnk; ++ilnk ) pkr.pack(inputs[ilnk].data(), nfrm, frames[ilnk].data());
+    }, tsecs);
+    printRow(myname, "pack " + pkr.implementationName(), tsec, nsam, frameBytes, tsecs);
+  }
+
+  // Unpack.
+  vector<AdcCountVector> outputs(nlnk);
+  vector<AdcCountVector> scalarOutputs(nlnk);
+  double tunpMin = 0.0;
+  for ( WIB2FrameUnpacker::Mode mode : {WIB2FrameUnpacker::SCALAR, WIB2FrameUnpacker::SIMD} ) {
+    WIB2FrameUnpacker unp(mode);
+    if ( mode == WIB2FrameUnpacker::SIMD && ! unp.usesSimd() ) continue;
+    vector<AdcCountVector>& outs = mode == WIB2FrameUnpacker::SCALAR ? scalarOutputs : outputs;
+    double tsec = fastest(nrep, [&]() {
+      for ( Index ilnk=0; ilnk<nlnk; ++ilnk ) unp.unpack(frames[ilnk].data(), nfrm, outs[ilnk]);
+    }, tsecs);
+    printRow(myname, "unpack " + unp.implementationName(), tsec, nsam, frameBytes, tsecs);
+    if ( tunpMin == 0.0 || tsec < tunpMin ) tunpMin = tsec;
+  }
+  if ( outputs[0].empty() ) outputs = scalarOutputs;
+  Index nbad = 0;
+  for ( Index ilnk=0; ilnk<nlnk; ++ilnk ) {
+    if ( outputs[ilnk] != scalarOutputs[ilnk] ) ++nbad;
+    if ( scalarOutputs[ilnk] != inputs[ilnk] ) ++nbad;
+  }
+
+  // Copy into one vector per offline channel.
+  vector<AdcCountVector> chanAdcs(size_t(nlnk)*nchan);
+  double tcopy = fastest(nrep, [&]() {
+    for ( Index ilnk=0; ilnk<nlnk; ++ilnk ) {
+      const AdcCountVector& adcs = outputs[ilnk];
+      for ( Index ichan=0; ichan<nchan; ++ichan ) {
+        AdcCountVector::const_iterator iadc = adcs.begin() + size_t(ichan)*nfrm;
+        chanAdcs[lnkChans[ilnk][ichan]].assign(iadc, iadc + nfrm);
+      }
+    }
+  }, tsecs);
+  printRow(myname, "channel copy", tcopy, nsam, sampleBytes, tsecs);
+
+  // Pedestals.
+  AdcPedestalFinder pedFinder;
+  vector<AdcPedestalFinder::Pedestal> peds;
+  double tped = fastest(nrep, [&]() {
+    for ( Index ilnk=0; ilnk<nlnk; ++ilnk ) pedFinder.evaluate(outputs[ilnk].data(), nchan, nfrm, peds);
+  }, tsecs);
+  printRow(myname, "pedestal", tped, nsam, sampleBytes, tsecs);
+
+  cout.unsetf(std::ios_base::floatfield);
+  if ( nbad ) {
+    cout << myname << "ERROR: Unpacked values differ from the input for " << nbad << " link results." << endl;
+    return 2;
+  }
+  double unpns = 1.e9*tunpMin/nsam;
+  if ( maxns > 0.0 && unpns > maxns ) {
+    cout << myname << "ERROR: Unpack time " << unpns << " ns/sample exceeds the maximum " << maxns << endl;
+    return 3;
+  }
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
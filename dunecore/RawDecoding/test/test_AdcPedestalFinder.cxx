@@ -0,0 +1,150 @@
+// test_AdcPedestalFinder.cxx
+//
+// This is a test and demonstration for AdcPedestalFinder.
+// Results are compared with a direct evaluation that sorts a copy of the data
+// (as TMath::Median does) and uses the two-pass RMS of TMath::RMS.
+
+#undef NDEBUG
+
+#include "../AdcPedestalFinder.h"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using dune::AdcPedestalFinder;
+
+using Index = unsigned int;
+using AdcCount = AdcPedestalFinder::AdcCount;
+using AdcVector = vector<AdcCount>;
+using Pedestal = AdcPedestalFinder::Pedestal;
+
+//**********************************************************************
+
+namespace {
+
+Pedestal reference(const AdcVector& adcs) {
+  Pedestal ped;
+  size_t n = adcs.size();
+  if ( n == 0 ) return ped;
+  AdcVector srt(adcs);
+  std::sort(srt.begin(), srt.end());
+  double dmed = n%2 == 1 ? srt[n/2] : 0.5*(srt[n/2-1] + srt[n/2]);
+  int imed = dmed + 0.01;
+  ped.median = imed;
+  double mean = 0.0;
+  for ( AdcCount adc : adcs ) mean += adc;
+  mean /= n;
+  double tot = 0.0;
+  for ( AdcCount adc : adcs ) tot += (adc - mean)*(adc - mean);
+  ped.sigma = n > 1 ? std::sqrt(tot/(n - 1)) : 0.0;
+  size_t s1 = 0;
+  size_t sm = 0;
+  for ( AdcCount adc : adcs ) {
+    if ( adc < imed ) ++s1;
+    if ( adc == imed ) ++sm;
+  }
+  if ( sm > 0 ) {
+    float mcorr = (-0.5 + (0.5*(float) n - (float) s1)/ ((float) sm) );
+    ped.correction = mcorr;
+    ped.median += mcorr;
+  }
+  return ped;
+}
+
+bool same(const Pedestal& lhs, const Pedestal& rhs) {
+  return lhs.median == rhs.median &&
+         std::abs(lhs.sigma - rhs.sigma) <= 1.e-5*(1.0 + rhs.sigma) &&
+         lhs.correction == rhs.correction;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_AdcPedestalFinder() {
+  const string myname = "test_AdcPedestalFinder: ";
+  cout << myname << "Starting test" << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  AdcPedestalFinder pf;
+
+  cout << myname << line << endl;
+  cout << myname << "Check empty and one-sample data." << endl;
+  Pedestal ped = pf.evaluate(nullptr, 0);
+  assert( ped.median == 0.0 && ped.sigma == 0.0 );
+  AdcCount one = 900;
+  ped = pf.evaluate(&one, 1);
+  assert( ped.median == 900.0 );
+  assert( ped.sigma == 0.0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check a hand-computed case." << endl;
+  // median 3, N(<3) = 2, N(=3) = 2 --> 3 - 0.5 + (2.5 - 2)/2 = 2.75
+  AdcVector adcs = {1, 2, 3, 3, 4};
+  ped = pf.evaluate(adcs.data(), adcs.size());
+  cout << myname << "  Median: " << ped.median << endl;
+  assert( ped.median == 2.75 );
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with reference for random waveforms." << endl;
+  std::mt19937 gen(2468);
+  for ( Index nsam : {2, 3, 10, 11, 500, 6000} ) {
+    for ( double noise : {0.0, 0.7, 3.0, 40.0} ) {
+      std::normal_distribution<double> dist(900.0, noise);
+      AdcVector wf(nsam);
+      for ( AdcCount& adc : wf ) adc = std::lround(dist(gen));
+      // Add a few signal-like outliers.
+      if ( nsam > 20 ) for ( Index isam=10; isam<15; ++isam ) wf[isam] += 600;
+      Pedestal pexp = reference(wf);
+      Pedestal pchk = pf.evaluate(wf.data(), wf.size());
+      if ( ! same(pchk, pexp) ) {
+        cout << myname << "  Mismatch for nsam=" << nsam << " noise=" << noise << ": "
+             << pchk.median << " " << pchk.sigma << " vs. "
+             << pexp.median << " " << pexp.sigma << endl;
+      }
+      assert( same(pchk, pexp) );
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check negative counts." << endl;
+  adcs = {-5, -3, -3, 0, 2, -3};
+  assert( same(pf.evaluate(adcs.data(), adcs.size()), reference(adcs)) );
+
+  cout << myname << line << endl;
+  cout << myname << "Check batch evaluation." << endl;
+  Index nchan = 256;
+  Index nsam = 300;
+  AdcVector block(nchan*nsam);
+  std::normal_distribution<double> dist(500.0, 4.0);
+  for ( AdcCount& adc : block ) adc = std::lround(dist(gen));
+  vector<Pedestal> peds;
+  pf.evaluate(block.data(), nchan, nsam, peds);
+  assert( peds.size() == nchan );
+  for ( Index ichan=0; ichan<nchan; ++ichan ) {
+    AdcVector wf(block.begin() + ichan*nsam, block.begin() + (ichan + 1)*nsam);
+    assert( same(peds[ichan], reference(wf)) );
+  }
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_AdcPedestalFinder();
+}
+
+//**********************************************************************
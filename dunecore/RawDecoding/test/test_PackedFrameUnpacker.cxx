@@ -0,0 +1,173 @@
+// test_PackedFrameUnpacker.cxx
+//
+// This is a test and demonstration for PackedFrameUnpacker.
+// Random ADC values are bit-packed into frames of a multi-tick test format and
+// unpacked with the traits-based unpacker. WIB2 frames filled with
+// WIB2Frame::set_adc are unpacked with WIB2FrameTraits and compared with
+// WIB2FrameUnpacker.
+
+#undef NDEBUG
+
+#include "../PackedFrameUnpacker.h"
+#include "../WIB2FrameTraits.h"
+#include "../WIB2FrameUnpacker.h"
+#include "detdataformats/wib2/WIB2Frame.hpp"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using dune::PackedFrameUnpacker;
+using dune::FrameHeader;
+using dune::WIB2FrameTraits;
+using dune::WIB2FrameUnpacker;
+using dunedaq::detdataformats::wib2::WIB2Frame;
+
+using Index = unsigned int;
+
+namespace {
+
+// Test format: 16-byte header (crate, slot, link bytes and a 64-bit timestamp
+// at byte 8) followed by 4 ticks of 64 channels of 12-bit values.
+struct TestFrameTraits {
+  static constexpr size_t AdcOffset = 16;
+  static constexpr unsigned int NChannels = 64;
+  static constexpr unsigned int NTicks = 4;
+  static constexpr unsigned int BitsPerAdc = 12;
+  static constexpr size_t FrameSize = AdcOffset + NChannels*NTicks*BitsPerAdc/8;
+  static FrameHeader header(const uint8_t* pframe) {
+    FrameHeader hdr;
+    hdr.crate = pframe[0];
+    hdr.slot = pframe[1];
+    hdr.link = pframe[2];
+    std::memcpy(&hdr.timestamp, pframe + 8, sizeof(hdr.timestamp));
+    return hdr;
+  }
+};
+
+// Set value ival of the little-endian bit stream at pdat.
+void setValue(uint8_t* pdat, Index ival, Index nbit, unsigned int val) {
+  for ( Index ibit=0; ibit<nbit; ++ibit ) {
+    Index pos = ival*nbit + ibit;
+    uint8_t msk = 1 << (pos%8);
+    if ( (val >> ibit) & 1 ) pdat[pos/8] |= msk;
+    else pdat[pos/8] &= ~msk;
+  }
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_PackedFrameUnpacker(Index nfrm) {
+  const string myname = "test_PackedFrameUnpacker: ";
+  cout << myname << "Starting test with " << nfrm << " frames." << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  using Unpacker = PackedFrameUnpacker<TestFrameTraits>;
+  const Index nchan = Unpacker::NChannels;
+  const Index ntick = Unpacker::NTicks;
+  const Index nsam = nfrm*ntick;
+
+  cout << myname << line << endl;
+  cout << myname << "Check constants." << endl;
+  assert( Unpacker::FrameSize == 400 );
+  assert( Unpacker::NValues == 256 );
+  assert( Unpacker::AdcBytes == 384 );
+
+  cout << myname << line << endl;
+  cout << myname << "Create test frames." << endl;
+  vector<uint8_t> data(nfrm*Unpacker::FrameSize, 0);
+  vector<vector<int>> adcsExp(nchan, vector<int>(nsam));
+  std::mt19937 gen(2345 + nfrm);
+  std::uniform_int_distribution<int> dist(0, 0xfff);
+  for ( Index ifrm=0; ifrm<nfrm; ++ifrm ) {
+    uint8_t* pfrm = data.data() + ifrm*Unpacker::FrameSize;
+    pfrm[0] = 3;
+    pfrm[1] = 4;
+    pfrm[2] = 5;
+    uint64_t tim = 1000000 + 32*ifrm;
+    std::memcpy(pfrm + 8, &tim, sizeof(tim));
+    for ( Index itck=0; itck<ntick; ++itck ) {
+      for ( Index ichan=0; ichan<nchan; ++ichan ) {
+        int adc = dist(gen);
+        if ( ifrm == 0 && itck == 0 && ichan == 0 ) adc = 0;
+        if ( ifrm == 0 && itck == ntick - 1 && ichan == nchan - 1 ) adc = 0xfff;
+        setValue(pfrm + Unpacker::AdcOffset, itck*nchan + ichan, Unpacker::BitsPerAdc, adc);
+        adcsExp[ichan][ifrm*ntick + itck] = adc;
+      }
+    }
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Unpack." << endl;
+  Unpacker::AdcCountVector adcs;
+  Unpacker::unpack(data.data(), nfrm, adcs);
+  assert( adcs.size() == nchan*nsam );
+  Index nbad = 0;
+  for ( Index ichan=0; ichan<nchan; ++ichan ) {
+    for ( Index isam=0; isam<nsam; ++isam ) {
+      int adcUnp = adcs[ichan*nsam + isam];
+      if ( adcUnp != adcsExp[ichan][isam] ) {
+        if ( nbad < 10 ) {
+          cout << myname << "  Mismatch for channel " << ichan << " sample " << isam
+               << ": " << adcUnp << " != " << adcsExp[ichan][isam] << endl;
+        }
+        ++nbad;
+      }
+    }
+  }
+  assert( nbad == 0 );
+
+  if ( nfrm > 0 ) {
+    cout << myname << line << endl;
+    cout << myname << "Check header." << endl;
+    FrameHeader hdr = Unpacker::header(data.data() + (nfrm - 1)*Unpacker::FrameSize);
+    assert( hdr.crate == 3 );
+    assert( hdr.slot == 4 );
+    assert( hdr.link == 5 );
+    assert( hdr.timestamp == 1000000 + 32*(nfrm - 1) );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Create WIB2 frames." << endl;
+  using Wib2Unpacker = PackedFrameUnpacker<WIB2FrameTraits>;
+  assert( Wib2Unpacker::FrameSize == WIB2FrameUnpacker::frameSize() );
+  assert( Wib2Unpacker::NChannels == WIB2FrameUnpacker::NChannels );
+  vector<WIB2Frame> frames(nfrm);
+  std::uniform_int_distribution<int> dist14(0, 0x3fff);
+  for ( WIB2Frame& frame : frames ) {
+    for ( Index ichan=0; ichan<Wib2Unpacker::NChannels; ++ichan ) frame.set_adc(ichan, dist14(gen));
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with WIB2FrameUnpacker." << endl;
+  WIB2FrameUnpacker::AdcCountVector adcsRef;
+  WIB2FrameUnpacker(WIB2FrameUnpacker::SCALAR).unpack(frames.data(), nfrm, adcsRef);
+  Wib2Unpacker::AdcCountVector adcsWib2;
+  Wib2Unpacker::unpack(frames.data(), nfrm, adcsWib2);
+  assert( adcsWib2 == adcsRef );
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  int nerr = 0;
+  for ( Index nfrm : {0, 1, 2, 17} ) {
+    nerr += test_PackedFrameUnpacker(nfrm);
+  }
+  return nerr;
+}
+
+//**********************************************************************
@@ -0,0 +1,139 @@
+// test_WIB2FrameChecker.cxx
+//
+// This is a test and demonstration for WIB2FrameChecker.
+// Consistent WIB2 frames are built and then damaged with header changes, timestamp
+// gaps and out-of-order frames. The scalar and vector checkers must report the
+// same failures.
+
+#undef NDEBUG
+
+#include "../WIB2FrameChecker.h"
+#include "detdataformats/wib2/WIB2Frame.hpp"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using dune::WIB2FrameChecker;
+using dunedaq::detdataformats::wib2::WIB2Frame;
+using Result = WIB2FrameChecker::Result;
+
+using Index = unsigned int;
+
+namespace {
+
+void setTimestamp(WIB2Frame& frame, uint64_t ts) {
+  frame.header.timestamp_1 = ts & 0xffffffff;
+  frame.header.timestamp_2 = ts >> 32;
+}
+
+vector<WIB2Frame> makeFrames(Index nfrm, uint64_t inc) {
+  vector<WIB2Frame> frames(nfrm);
+  uint64_t ts0 = 0xfffffff0;   // crosses the 32-bit boundary
+  for ( Index ifrm=0; ifrm<nfrm; ++ifrm ) {
+    WIB2Frame& frame = frames[ifrm];
+    frame.header.version = 2;
+    frame.header.crate = 5;
+    frame.header.slot = 3;
+    frame.header.link = 1;
+    setTimestamp(frame, ts0 + ifrm*inc);
+  }
+  return frames;
+}
+
+}  // end unnamed namespace
+
+//**********************************************************************
+
+int test_WIB2FrameChecker(WIB2FrameChecker::Mode mode, Index nfrm) {
+  const string myname = "test_WIB2FrameChecker: ";
+  cout << myname << "Starting test with mode " << mode << " and " << nfrm << " frames." << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  const uint64_t inc = 32;
+  WIB2FrameChecker chk(inc, mode);
+  cout << myname << "Implementation: " << chk.implementationName() << endl;
+  if ( mode == WIB2FrameChecker::SCALAR ) assert( ! chk.usesSimd() );
+  if ( mode != WIB2FrameChecker::SCALAR ) assert( chk.usesSimd() == WIB2FrameChecker::simdAvailable() );
+
+  cout << myname << line << endl;
+  cout << myname << "Check consistent frames." << endl;
+  vector<WIB2Frame> frames = makeFrames(nfrm, inc);
+  Result res = chk.check(frames.data(), nfrm);
+  assert( res.nframes == nfrm );
+  assert( res.ok() );
+  assert( res.status() == 0 );
+  assert( res.firstBadFrame == WIB2FrameChecker::npos );
+  assert( res.nBadFragment == 0 );
+  if ( nfrm < 8 ) return 0;
+
+  cout << myname << line << endl;
+  cout << myname << "Check a header mismatch." << endl;
+  frames[nfrm - 1].header.slot = 4;
+  frames[5].header.link = 2;
+  res = chk.check(frames.data(), nfrm);
+  assert( res.nHeaderMismatch == 2 );
+  assert( res.nTimestampGap == 0 );
+  assert( res.nOutOfOrder == 0 );
+  assert( res.status() == WIB2FrameChecker::HeaderMismatch );
+  assert( res.firstBadFrame == 5 );
+  assert( res.nBadFragment == 1 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check a timestamp gap." << endl;
+  frames = makeFrames(nfrm, inc);
+  for ( Index ifrm=6; ifrm<nfrm; ++ifrm ) {
+    setTimestamp(frames[ifrm], frames[ifrm].get_timestamp() + 3*inc);
+  }
+  res = chk.check(frames.data(), nfrm);
+  assert( res.nHeaderMismatch == 0 );
+  assert( res.nTimestampGap == 1 );
+  assert( res.nOutOfOrder == 0 );
+  assert( res.status() == WIB2FrameChecker::TimestampGap );
+  assert( res.firstBadFrame == 6 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check swapped frames." << endl;
+  frames = makeFrames(nfrm, inc);
+  std::swap(frames[3], frames[4]);
+  res = chk.check(frames.data(), nfrm);
+  assert( res.nHeaderMismatch == 0 );
+  assert( res.nOutOfOrder == 1 );
+  assert( res.nTimestampGap == 2 );
+  assert( res.status() == (WIB2FrameChecker::TimestampGap | WIB2FrameChecker::OutOfOrder) );
+  assert( res.firstBadFrame == 3 );
+
+  cout << myname << line << endl;
+  cout << myname << "Sum results." << endl;
+  Result sum;
+  sum += chk.check(frames.data(), nfrm);
+  sum += chk.check(frames.data(), 3);
+  assert( sum.nframes == nfrm + 3 );
+  assert( sum.nBadFragment == 1 );
+  assert( sum.nOutOfOrder == 1 );
+  assert( sum.firstBadFrame == 3 );
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  int nerr = 0;
+  for ( Index nfrm : {0, 1, 2, 8, 17, 100} ) {
+    nerr += test_WIB2FrameChecker(WIB2FrameChecker::SCALAR, nfrm);
+    nerr += test_WIB2FrameChecker(WIB2FrameChecker::SIMD, nfrm);
+    nerr += test_WIB2FrameChecker(WIB2FrameChecker::AUTO, nfrm);
+  }
+  return nerr;
+}
+
+//**********************************************************************
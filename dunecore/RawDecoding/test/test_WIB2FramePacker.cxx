@@ -0,0 +1,116 @@
+// test_WIB2FramePacker.cxx
+//
+// This is a test and demonstration for WIB2FramePacker.
+// Random ADC values are packed into WIB2 frames with each packer implementation and
+// compared with frames filled with WIB2Frame::set_adc.  The header and trailer of the
+// frames must not be modified.
+
+#undef NDEBUG
+
+#include "../WIB2FramePacker.h"
+#include "detdataformats/wib2/WIB2Frame.hpp"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using dune::WIB2FramePacker;
+using dunedaq::detdataformats::wib2::WIB2Frame;
+
+using Index = unsigned int;
+
+//**********************************************************************
+
+int test_WIB2FramePacker(WIB2FramePacker::Mode mode, Index nfrm) {
+  const string myname = "test_WIB2FramePacker: ";
+  cout << myname << "Starting test with mode " << mode << " and " << nfrm << " frames." << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  const Index nchan = WIB2FramePacker::NChannels;
+
+  cout << myname << line << endl;
+  cout << myname << "Check frame size." << endl;
+  assert( WIB2FramePacker::frameSize() == sizeof(WIB2Frame) );
+
+  cout << myname << line << endl;
+  cout << myname << "Create channel-major ADC block." << endl;
+  vector<WIB2FramePacker::AdcCount> adcs(nchan*nfrm);
+  std::mt19937 gen(54321 + nfrm);
+  std::uniform_int_distribution<int> dist(0, 0x3fff);
+  for ( auto& adc : adcs ) adc = dist(gen);
+  // Make sure the extreme values appear, and a value with bits above the 14th.
+  if ( nfrm > 0 ) {
+    adcs[0] = 0;
+    adcs[(nchan - 1)*nfrm] = 0x3fff;
+    adcs[nfrm] = 0x7abc;
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Fill reference frames with set_adc." << endl;
+  WIB2Frame blank;
+  std::memset(&blank, 0xa5, sizeof(blank));
+  vector<WIB2Frame> frames(nfrm, blank);
+  for ( Index ifrm=0; ifrm<nfrm; ++ifrm ) {
+    for ( Index ichan=0; ichan<nchan; ++ichan ) frames[ifrm].set_adc(ichan, adcs[ichan*nfrm + ifrm]);
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Pack." << endl;
+  WIB2FramePacker pkr(mode);
+  cout << myname << "Implementation: " << pkr.implementationName() << endl;
+  if ( mode == WIB2FramePacker::SCALAR ) assert( ! pkr.usesSimd() );
+  if ( mode != WIB2FramePacker::SCALAR ) assert( pkr.usesSimd() == WIB2FramePacker::simdAvailable() );
+  vector<WIB2Frame> packed(nfrm, blank);
+  pkr.pack(adcs.data(), nfrm, packed.data());
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with set_adc." << endl;
+  Index nbad = 0;
+  for ( Index ifrm=0; ifrm<nfrm; ++ifrm ) {
+    if ( std::memcmp(&packed[ifrm], &frames[ifrm], sizeof(WIB2Frame)) != 0 ) {
+      if ( nbad < 10 ) cout << myname << "  Mismatch for frame " << ifrm << endl;
+      ++nbad;
+    }
+    for ( Index ichan=0; ichan<nchan; ++ichan ) {
+      int adcExp = adcs[ichan*nfrm + ifrm] & 0x3fff;
+      assert( packed[ifrm].get_adc(ichan) == adcExp );
+    }
+  }
+  assert( nbad == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Pack single frames." << endl;
+  vector<WIB2FramePacker::AdcCount> fadcs(nchan);
+  for ( Index ifrm=0; ifrm<nfrm; ++ifrm ) {
+    for ( Index ichan=0; ichan<nchan; ++ichan ) fadcs[ichan] = adcs[ichan*nfrm + ifrm];
+    WIB2Frame frame = blank;
+    pkr.packFrame(fadcs.data(), &frame);
+    assert( std::memcmp(&frame, &frames[ifrm], sizeof(WIB2Frame)) == 0 );
+  }
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  int nerr = 0;
+  for ( Index nfrm : {0, 1, 2, 17, 100} ) {
+    nerr += test_WIB2FramePacker(WIB2FramePacker::SCALAR, nfrm);
+    nerr += test_WIB2FramePacker(WIB2FramePacker::SIMD, nfrm);
+    nerr += test_WIB2FramePacker(WIB2FramePacker::AUTO, nfrm);
+  }
+  return nerr;
+}
+
+//**********************************************************************
@@ -0,0 +1,100 @@
+// test_WIB2FrameUnpacker.cxx
+//
+// This is a test and demonstration for WIB2FrameUnpacker.
+// Random ADC values are packed into WIB2 frames with WIB2Frame::set_adc and the
+// result of each unpacker implementation is compared with WIB2Frame::get_adc.
+
+#undef NDEBUG
+
+#include "../WIB2FrameUnpacker.h"
+#include "detdataformats/wib2/WIB2Frame.hpp"
+#include <string>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using std::vector;
+using dune::WIB2FrameUnpacker;
+using dunedaq::detdataformats::wib2::WIB2Frame;
+
+using Index = unsigned int;
+
+//**********************************************************************
+
+int test_WIB2FrameUnpacker(WIB2FrameUnpacker::Mode mode, Index nfrm) {
+  const string myname = "test_WIB2FrameUnpacker: ";
+  cout << myname << "Starting test with mode " << mode << " and " << nfrm << " frames." << endl;
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+  const Index nchan = WIB2FrameUnpacker::NChannels;
+
+  cout << myname << line << endl;
+  cout << myname << "Check frame size." << endl;
+  assert( WIB2FrameUnpacker::frameSize() == sizeof(WIB2Frame) );
+
+  cout << myname << line << endl;
+  cout << myname << "Create frames." << endl;
+  vector<WIB2Frame> frames(nfrm);
+  std::mt19937 gen(12345 + nfrm);
+  std::uniform_int_distribution<int> dist(0, 0x3fff);
+  for ( WIB2Frame& frame : frames ) {
+    for ( Index ichan=0; ichan<nchan; ++ichan ) frame.set_adc(ichan, dist(gen));
+  }
+  // Make sure the extreme values appear.
+  if ( nfrm > 0 ) {
+    frames[0].set_adc(0, 0);
+    frames[0].set_adc(nchan - 1, 0x3fff);
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Unpack." << endl;
+  WIB2FrameUnpacker unp(mode);
+  cout << myname << "Implementation: " << unp.implementationName() << endl;
+  if ( mode == WIB2FrameUnpacker::SCALAR ) assert( ! unp.usesSimd() );
+  if ( mode != WIB2FrameUnpacker::SCALAR ) assert( unp.usesSimd() == WIB2FrameUnpacker::simdAvailable() );
+  WIB2FrameUnpacker::AdcCountVector adcs;
+  unp.unpack(frames.data(), nfrm, adcs);
+  assert( adcs.size() == nchan*nfrm );
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with WIB2Frame::get_adc." << endl;
+  Index nbad = 0;
+  for ( Index ifrm=0; ifrm<nfrm; ++ifrm ) {
+    for ( Index ichan=0; ichan<nchan; ++ichan ) {
+      int adcExp = frames[ifrm].get_adc(ichan);
+      int adcUnp = adcs[ichan*nfrm + ifrm];
+      if ( adcUnp != adcExp ) {
+        if ( nbad < 10 ) {
+          cout << myname << "  Mismatch for frame " << ifrm << " channel " << ichan
+               << ": " << adcUnp << " != " << adcExp << endl;
+        }
+        ++nbad;
+      }
+    }
+  }
+  assert( nbad == 0 );
+
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  int nerr = 0;
+  for ( Index nfrm : {0, 1, 2, 17, 100} ) {
+    nerr += test_WIB2FrameUnpacker(WIB2FrameUnpacker::SCALAR, nfrm);
+    nerr += test_WIB2FrameUnpacker(WIB2FrameUnpacker::SIMD, nfrm);
+    nerr += test_WIB2FrameUnpacker(WIB2FrameUnpacker::AUTO, nfrm);
+  }
+  return nerr;
+}
+
+//**********************************************************************
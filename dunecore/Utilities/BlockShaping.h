@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   BlockShaping.h
+///
+/// \brief  Batched application of signal shaping kernels to the rows
+///         of an AdcChannelBlock.
+///
+/// The rows are grouped by kernel, e.g. the convolution or deconvolution
+/// kernel of the SignalShaping for their plane or view, and each group is
+/// transformed in batches of up to maxBatch() rows with the batched FFTW
+/// plans of FwFFT on a single workspace. The kernel is applied in place in
+/// the frequency domain and has the LArFFT layout (FFT size/2 + 1 terms).
+/// Results keep the normalization of the LArFFT path (1/N on the inverse).
+///
+/// Each row may be rotated by an offset while it is copied back: output
+/// sample isam is taken from isam + offset (modulo the FFT size).
+///
+/// transformSamples applies a kernel in the same way to a single time
+/// series with a workspace for that call.
+///
+/// Used by the DUNE signal shaping services for their block and
+/// single-channel calls.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef BLOCKSHAPING_H
+#define BLOCKSHAPING_H
+
+#include "dunecore/DuneInterface/Data/AdcChannelBlock.h"
+#include "dunecore/DuneCommon/Utility/FwFFT.h"
+#include "cetlib_except/exception.h"
+#include "TComplex.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace util {
+
+class BlockShaping {
+
+public:
+
+  using Index = unsigned int;
+  using Kernel = std::vector<TComplex>;
+  using IndexVector = std::vector<Index>;
+  using KernelRows = std::map<const Kernel*, IndexVector>;
+  using OffsetVector = std::vector<int>;
+
+  /// Maximum number of rows in one batched transform.
+  static Index maxBatch() { return 64; }
+
+  /// Apply kernel *ient.first to each row in ient.second for each entry in
+  /// krows using transforms xf of size nsam = blk.ntick(). If offsets is not
+  /// empty, row irow is rotated by offsets[irow].
+  /// Throws cet::exception with category caller on failure.
+  static void transform(FwFFT& xf, AdcChannelBlock& blk, const KernelRows& krows,
+                        const OffsetVector& offsets, const std::string& caller);
+
+  /// Apply kernel kern to the nsam samples in data in place.
+  /// Throws cet::exception with category caller on failure.
+  static void transformSamples(FwFFT& xf, const Kernel& kern, double* data, Index nsam,
+                               const std::string& caller);
+
+};
+
+//**********************************************************************
+
+inline void
+BlockShaping::transform(FwFFT& xf, AdcChannelBlock& blk, const KernelRows& krows,
+                        const OffsetVector& offsets, const std::string& caller) {
+  const std::string myname = caller + "::transformBlock: ";
+  Index nrow = blk.nrow();
+  if ( nrow == 0 || krows.empty() ) return;
+  Index nsam = blk.ntick();
+  if ( nsam == 0 ) return;
+  if ( ! offsets.empty() && offsets.size() < nrow ) {
+    throw cet::exception(caller) << myname << "Offset count " << offsets.size()
+          << " is less than the row count " << nrow << "\n";
+  }
+  Index nfrq = nsam/2 + 1;
+  Index nbatMax = std::min<Index>(nrow, maxBatch());
+  FwFFT::Workspace work(nsam, nbatMax);
+  double* inData = work.inData();
+  fftw_complex* outData = work.outData();
+  double norm = 1.0/nsam;
+  for ( const auto& ient : krows ) {
+    const Kernel& kern = *ient.first;
+    const IndexVector& rows = ient.second;
+    if ( rows.empty() ) continue;
+    if ( kern.size() < nfrq ) {
+      throw cet::exception(caller) << myname
+            << "Kernel is not configured for channel " << blk.channel(rows.front()) << "\n";
+    }
+    for ( Index irow0=0; irow0<rows.size(); irow0+=nbatMax ) {
+      Index nbat = std::min<Index>(nbatMax, rows.size() - irow0);
+      for ( Index ibat=0; ibat<nbat; ++ibat ) {
+        const AdcSignal* psam = blk.samples(rows[irow0 + ibat]);
+        double* pin = inData + ibat*nsam;
+        for ( Index isam=0; isam<nsam; ++isam ) pin[isam] = psam[isam];
+      }
+      if ( xf.executeForwardBatch(nsam, nbat, inData, outData) ) {
+        throw cet::exception(caller) << myname << "Forward transform failed.\n";
+      }
+      for ( Index ibat=0; ibat<nbat; ++ibat ) {
+        fftw_complex* pfrq = outData + ibat*nfrq;
+        for ( Index ifrq=0; ifrq<nfrq; ++ifrq ) {
+          double kre = norm*kern[ifrq].Re();
+          double kim = norm*kern[ifrq].Im();
+          double re = pfrq[ifrq][0];
+          double im = pfrq[ifrq][1];
+          pfrq[ifrq][0] = re*kre - im*kim;
+          pfrq[ifrq][1] = re*kim + im*kre;
+        }
+      }
+      if ( xf.executeBackwardBatch(nsam, nbat, outData, inData) ) {
+        throw cet::exception(caller) << myname << "Backward transform failed.\n";
+      }
+      for ( Index ibat=0; ibat<nbat; ++ibat ) {
+        Index irow = rows[irow0 + ibat];
+        int soff = offsets.empty() ? 0 : offsets[irow] % int(nsam);
+        Index ioff = soff < 0 ? soff + nsam : soff;
+        const double* pout = inData + ibat*nsam;
+        AdcSignal* psam = blk.samples(irow);
+        Index nfirst = nsam - ioff;
+        for ( Index isam=0; isam<nfirst; ++isam ) psam[isam] = pout[isam + ioff];
+        for ( Index isam=nfirst; isam<nsam; ++isam ) psam[isam] = pout[isam - nfirst];
+      }
+    }
+  }
+}
+
+//**********************************************************************
+
+inline void
+BlockShaping::transformSamples(FwFFT& xf, const Kernel& kern, double* data, Index nsam,
+                               const std::string& caller) {
+  const std::string myname = caller + "::transformSamples: ";
+  if ( nsam == 0 ) return;
+  Index nfrq = nsam/2 + 1;
+  if ( kern.size() < nfrq ) {
+    throw cet::exception(caller) << myname << "Kernel is not configured.\n";
+  }
+  FwFFT::Workspace work(nsam, 1);
+  double* inData = work.inData();
+  fftw_complex* outData = work.outData();
+  std::copy(data, data + nsam, inData);
+  if ( xf.executeForwardBatch(nsam, 1, inData, outData) ) {
+    throw cet::exception(caller) << myname << "Forward transform failed.\n";
+  }
+  double norm = 1.0/nsam;
+  for ( Index ifrq=0; ifrq<nfrq; ++ifrq ) {
+    double kre = norm*kern[ifrq].Re();
+    double kim = norm*kern[ifrq].Im();
+    double re = outData[ifrq][0];
+    double im = outData[ifrq][1];
+    outData[ifrq][0] = re*kre - im*kim;
+    outData[ifrq][1] = re*kim + im*kre;
+  }
+  if ( xf.executeBackwardBatch(nsam, 1, outData, inData) ) {
+    throw cet::exception(caller) << myname << "Backward transform failed.\n";
+  }
+  std::copy(inData, inData + nsam, data);
+}
+
+//**********************************************************************
+
+}  // end namespace util
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 
 #include "larcore/Geometry/Geometry.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
@@ -30,6 +31,7 @@ namespace fhicl {
 
 namespace art {
   class ActivityRegistry;
+  class Run;
 }
 
 namespace geo {
@@ -38,6 +40,7 @@ namespace geo {
 
 namespace sim {
   class SimChannel;
+  struct IDE;
 }
 
 namespace util {
@@ -59,12 +62,38 @@ public:
   // The compiler-generated destructor is fine for non-base
   // classes without bare pointers or other resource use.
   
+  using TickCharge       = std::pair<unsigned, double>;
+  using TickChargeVector = std::vector<TickCharge>;
+
   // get charge collected on a view after amplification in CRP
   double viewCharge( const sim::SimChannel* psc, unsigned itck ) const;
+
+  // viewCharge for all ticks of a SimChannel in one pass over its TDC->IDE map.
+  // Dense version: qs[itck] = viewCharge(psc, itck). If qs is empty, it is sized
+  // to one past the last tick with charge; otherwise its size is kept and ticks
+  // beyond it are ignored.
+  void viewChargeVector( const sim::SimChannel* psc, std::vector<double> &qs ) const;
+
+  // Sparse version: (tick, charge) for each tick with nonzero charge in tick order.
+  void viewChargeVector( const sim::SimChannel* psc, TickChargeVector &qs ) const;
   
   // calculate the gain based on position information
   double crpGain( geo::Point_t const &pos ) const;
 
+  // batch version: gains[i] = crpGain(pos[i])
+  void crpGain( std::vector<geo::Point_t> const &pos, std::vector<double> &gains ) const;
+
+  // effective gain (LEM gain x transparency) for CRP crp and wire numbers
+  // chx in view kZ and chy in the other view
+  // Reads the gain map if it has been built.
+  double crpGain( unsigned crp, int chx, int chy ) const;
+
+  // build the per-CRP gain maps (done at begin run)
+  void buildGainMap();
+
+  // return if the gain map is built
+  bool haveGainMap() const { return !m_gainMap.empty(); }
+
   // default value of the effective gain
   double crpDefaultGain() const { return m_CrpDefGain; }
   
@@ -78,6 +107,30 @@ private:
 
   void   dumpLemEffMap(int nlems) const;
 
+  // fill the per-channel geometry table
+  void   buildChannelTable();
+
+  struct ChannelGeo;
+
+  // geometry used to apply the gain map for a channel
+  // or null if the default gain is to be used
+  const ChannelGeo* chargeGeo( unsigned chan ) const;
+
+  // amplified charge for the IDEs of one tick
+  double ideCharge( const ChannelGeo &cg, const std::vector<sim::IDE> &ides ) const;
+
+  // callback to rebuild the gain map
+  void   postBeginRun( art::Run const &run );
+
+  // return the index in the gain map or -1 if the wires are outside
+  long   gainMapIndex( unsigned crp, int chx, int chy ) const
+  {
+    if( crp >= m_gainMap.size() ) return -1;
+    const GainMap &gm = m_gainMap[crp];
+    if( chx < 0 || chy < 0 || (unsigned)chx >= gm.nx || (unsigned)chy >= gm.ny ) return -1;
+    return gm.offset + (long)chx * gm.ny + chy;
+  }
+
   //
   int    m_LogLevel;
   
@@ -102,6 +155,31 @@ private:
 
   // detector geometry
   const geo::Geometry* m_geo;
+
+  // geometry for each channel precomputed from the wire ID so that
+  // viewCharge does not repeat the lookups for each SimChannel and tick
+  struct ChannelGeo {
+    unsigned tpc    = 0;        // TPC (CRP) number
+    unsigned plane  = 0;        // plane of this channel
+    int      wire   = -1;       // wire number in this plane
+    int      tcoord = -1;       // transverse coordinate index: 0, 1 (view kZ) or 2 (kX, kY)
+    geo::View_t view      = geo::kUnknown;
+    geo::View_t viewother = geo::kUnknown;
+    const geo::PlaneGeo* pother = nullptr;  // the other plane in this TPC
+  };
+  std::vector<ChannelGeo> m_chanGeo;
+
+  // dense effective-gain map for each CRP: value for wire chx in view kZ and
+  // wire chy in the other view is at offset + chx*ny + chy in m_gainVals
+  struct GainMap {
+    unsigned nx     = 0;
+    unsigned ny     = 0;
+    long     offset = 0;
+  };
+  std::vector<GainMap> m_gainMap;
+  std::vector<float>   m_gainVals;
+  // maximum number of map entries; the gains are computed on the fly beyond this
+  unsigned long m_GainMapMaxSize;
 };
 
 }
@@ -8,6 +8,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
+#include <algorithm>
 
 #include "CrpGainService.h"
 #include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
@@ -17,6 +18,7 @@
 
 #include "lardataobj/Simulation/SimChannel.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Framework/Principal/Run.h"
 
 #include "dunecore/ArtSupport/DuneToolManager.h"
 #include "dunecore/DuneInterface/Tool/FloatArrayTool.h"
@@ -37,6 +39,7 @@ util::CrpGainService::CrpGainService(fhicl::ParameterSet const& ps, art::Activit
   m_CrpNLem      = ps.get<unsigned int>("CrpNumLem");
   m_LemViewChans = ps.get<unsigned int>("LemViewChans");  
   m_LemEffTool   = ps.get<string>("LemEffTool"); 
+  m_GainMapMaxSize = ps.get<unsigned long>("GainMapMaxSize", 100000000);
 
   if( !m_LemEffTool.empty() )
     {
@@ -75,6 +78,7 @@ util::CrpGainService::CrpGainService(fhicl::ParameterSet const& ps, art::Activit
       cout<<myname<<"  CrpNumLem :      "<<m_CrpNLem<<endl;
       cout<<myname<<"  LemViewChans :   "<<m_LemViewChans<<endl;
       cout<<myname<<"  LemEffTool :     "<<m_LemEffTool<<" (@"<<m_plemeff<<")"<<endl;
+      cout<<myname<<"  GainMapMaxSize : "<<m_GainMapMaxSize<<endl;
       cout<<myname<<"  Use nominal gain : "<<m_UseDefGain<<endl;
     }
 
@@ -90,6 +94,12 @@ util::CrpGainService::CrpGainService(fhicl::ParameterSet const& ps, art::Activit
     }
   }
   
+  if( !m_UseDefGain )
+    {
+      buildChannelTable();
+      areg.sPostBeginRun.watch(this, &CrpGainService::postBeginRun);
+    }
+
   // dump
   int nlemeff = ps.get<int>("DumpLemEff", 0);
   if( nlemeff > 0 ) dumpLemEffMap( nlemeff );
@@ -149,66 +159,108 @@ double util::CrpGainService::viewCharge( const sim::SimChannel* psc, unsigned it
   //
   // otherwise ... 
 
-  std::vector< geo::WireID > wids = m_geo->ChannelToWire( psc->Channel() );
-  geo::WireID wid  = wids[0];
+  const ChannelGeo* pcg = chargeGeo( psc->Channel() );
+  if( pcg == nullptr ) return q;
+
+  // get IDEs for this tick
+  std::vector<sim::IDE> IDEs = psc->TrackIDsAndEnergies( itck, itck );
+  if( IDEs.empty() )
+    {
+      cout<<myname<<"WARNING could not get IDEs for tick "<<itck<<endl;
+      return q;
+    }
   
-  // get tpc
-  const geo::TPCGeo& tpcgeo = m_geo->TPC(wid.asPlaneID().asTPCID());
+  return ideCharge( *pcg, IDEs );
+}
 
-  // this plane
-  const geo::PlaneGeo& pthis = tpcgeo.Plane( wid.Plane );
-  // wire number in this plane
-  int wire   = (int)(wid.Wire);
+//
+// get view charge for all ticks: dense output
+void util::CrpGainService::viewChargeVector( const sim::SimChannel* psc, std::vector<double> &qs ) const
+{
+  TickChargeVector tqs;
+  viewChargeVector( psc, tqs );
+  if( qs.empty() )
+    {
+      if( !tqs.empty() ) qs.resize( tqs.back().first + 1, 0.0 );
+    }
+  else std::fill( qs.begin(), qs.end(), 0.0 );
+  for( const TickCharge &tq : tqs )
+    {
+      if( tq.first >= qs.size() ) break;
+      qs[tq.first] = tq.second;
+    }
+}
 
-  // other plane
-  unsigned widother = 0;
-  if(wid.Plane == 0 ) widother = 1;
-  const geo::PlaneGeo& pother = tpcgeo.Plane( widother );
-  
-  // get drift axis
-  int drift = std::abs(tpcgeo.DetectDriftDirection())-1;  //x:0, y:1, z:2
-  int tcoord = -1;
-  if( pthis.View() == geo::kZ )
+//
+// get view charge for all ticks: sparse output
+// Each tick is handled as in viewCharge with the charge summed from the IDEs
+// in the map instead of a search for each tick.
+void util::CrpGainService::viewChargeVector( const sim::SimChannel* psc, TickChargeVector &qs ) const
+{
+  qs.clear();
+  const auto &tdcides = psc->TDCIDEMap();
+  if( tdcides.empty() ) return;
+  qs.reserve( tdcides.size() );
+
+  // the channel lookup is done once for all ticks
+  const ChannelGeo* pcg = m_UseDefGain ? nullptr : chargeGeo( psc->Channel() );
+  for( const auto &tdcide : tdcides )
     {
-      if( drift == 0 ) tcoord = 1;
-      else if( drift == 1 ) tcoord = 0;
+      const std::vector<sim::IDE> &ides = tdcide.second;
+      double q = 0.0;
+      for( const sim::IDE &ide : ides ) q += ide.numElectrons;
+      if( q <= 1.0E-3 ) continue;
+      q = pcg == nullptr ? q * (0.5 * m_CrpDefGain) : ideCharge( *pcg, ides );
+      if( q != 0.0 ) qs.emplace_back( tdcide.first, q );
     }
-  else if( pthis.View() == geo::kX || pthis.View() == geo::kY )
+}
+
+//
+// geometry for a channel or null if the default gain is used
+const util::CrpGainService::ChannelGeo* util::CrpGainService::chargeGeo( unsigned chan ) const
+{
+  const string myname = "util::CrpGainService::chargeGeo: ";
+
+  if( chan >= m_chanGeo.size() )
     {
-      tcoord = 2;
+      cout<<myname<<"WARNING channel "<<chan<<" is not in the geometry\n";
+      return nullptr;
     }
+  const ChannelGeo& cg = m_chanGeo[chan];
 
   if( m_LogLevel >= 3 )
     {
-      cout<<myname<<"chan "<<psc->Channel()
-	  <<" plane  "<<wid.Plane
-	  <<" wire "<<wire
-	  <<" view "<<pthis.View()
-	  <<" viewother "<<pother.View()
-	  <<" tcoord "<<tcoord<<endl;
+      cout<<myname<<"chan "<<chan
+	  <<" plane  "<<cg.plane
+	  <<" wire "<<cg.wire
+	  <<" view "<<cg.view
+	  <<" viewother "<<cg.viewother
+	  <<" tcoord "<<cg.tcoord<<endl;
     }
 
-  if( tcoord < 0 || (tcoord == 2 && pother.View() != geo::kZ) )
+  if( cg.tcoord < 0 || (cg.tcoord == 2 && cg.viewother != geo::kZ) )
     {
       cout<<myname<<"WARNING cannot figure out the coordinate system\n";
-      // return the default value
-      return q;
+      // use the default value
+      return nullptr;
     }
 
-  
-  // get IDEs for this tick
-  std::vector<sim::IDE> IDEs = psc->TrackIDsAndEnergies( itck, itck );
-  if( IDEs.empty() )
-    {
-      cout<<myname<<"WARNING could not get IDEs for tick "<<itck<<endl;
-      return q;
-    }
-  
-  unsigned tpcid = wid.TPC;
+  return &cg;
+}
+
+//
+// amplified charge for the IDEs of one tick
+double util::CrpGainService::ideCharge( const ChannelGeo &cg, const std::vector<sim::IDE> &ides ) const
+{
+  const string myname = "util::CrpGainService::ideCharge: ";
+
+  const geo::PlaneGeo& pother = *cg.pother;
+  unsigned tpcid = cg.tpc;
+  int wire       = cg.wire;
   
   //
   double qsum = 0.0;
-  for(auto &ide: IDEs)
+  for(auto &ide: ides)
     {
 
       // get the wire number in the other view for this position
@@ -220,25 +272,69 @@ double util::CrpGainService::viewCharge( const sim::SimChannel* psc, unsigned it
 	}
       
       double G = 0;
-      if( tcoord < 2 ) // we are in view kZ
+      if( cg.tcoord < 2 ) // we are in view kZ
 	{
-	  G = getCrpGain( tpcid, wire, wother );
+	  G = crpGain( tpcid, wire, wother );
 	}
       else // we are in view kX or kY
 	{
-	  G = getCrpGain( tpcid, wother, wire );
+	  G = crpGain( tpcid, wother, wire );
 	}
       // the charge is divided equially between collectiong views
       // so the effective gain per view is 1/2 of the total effective CRP gain
       qsum += (0.5 * G) * ide.numElectrons;
     }
   
-  //if( q != qsum )
-  //cout<<q<<" "<<qsum<<endl;
-  
   return qsum;
 }
 
+//
+// precompute the geometry used by viewCharge for each channel
+void util::CrpGainService::buildChannelTable()
+{
+  unsigned nchan = m_geo->Nchannels();
+  m_chanGeo.assign( nchan, ChannelGeo() );
+  for( unsigned chan = 0; chan < nchan; ++chan )
+    {
+      std::vector< geo::WireID > wids = m_geo->ChannelToWire( chan );
+      if( wids.empty() ) continue;
+      geo::WireID wid  = wids[0];
+
+      // get tpc
+      const geo::TPCGeo& tpcgeo = m_geo->TPC(wid.asPlaneID().asTPCID());
+
+      // this plane
+      const geo::PlaneGeo& pthis = tpcgeo.Plane( wid.Plane );
+
+      // other plane
+      unsigned widother = 0;
+      if(wid.Plane == 0 ) widother = 1;
+      const geo::PlaneGeo& pother = tpcgeo.Plane( widother );
+
+      // get drift axis
+      int drift = std::abs(tpcgeo.DetectDriftDirection())-1;  //x:0, y:1, z:2
+      int tcoord = -1;
+      if( pthis.View() == geo::kZ )
+	{
+	  if( drift == 0 ) tcoord = 1;
+	  else if( drift == 1 ) tcoord = 0;
+	}
+      else if( pthis.View() == geo::kX || pthis.View() == geo::kY )
+	{
+	  tcoord = 2;
+	}
+
+      ChannelGeo& cg = m_chanGeo[chan];
+      cg.tpc       = wid.TPC;
+      cg.plane     = wid.Plane;
+      cg.wire      = (int)(wid.Wire);
+      cg.tcoord    = tcoord;
+      cg.view      = pthis.View();
+      cg.viewother = pother.View();
+      cg.pother    = &pother;
+    }
+}
+
 //
 //
 double util::CrpGainService::crpGain( geo::Point_t const &pos ) const
@@ -305,7 +401,98 @@ double util::CrpGainService::crpGain( geo::Point_t const &pos ) const
     }
   
   //
-  return getCrpGain( tpcgeo->ID().TPC, ch[0], ch[1] );  
+  return crpGain( tpcgeo->ID().TPC, ch[0], ch[1] );  
+}
+
+//
+//
+void util::CrpGainService::crpGain( std::vector<geo::Point_t> const &pos, std::vector<double> &gains ) const
+{
+  gains.resize( pos.size() );
+  for( size_t ipos = 0; ipos < pos.size(); ++ipos ) gains[ipos] = crpGain( pos[ipos] );
+}
+
+//
+//
+double util::CrpGainService::crpGain( unsigned crp, int chx, int chy ) const
+{
+  long idx = gainMapIndex( crp, chx, chy );
+  if( idx >= 0 ) return m_gainVals[idx];
+  return getCrpGain( crp, chx, chy );
+}
+
+//
+// bake gain x transparency into a dense map for each CRP
+void util::CrpGainService::buildGainMap()
+{
+  const string myname = "util::CrpGainService::buildGainMap: ";
+  m_gainMap.clear();
+  m_gainVals.clear();
+  if( m_UseDefGain ) return;
+
+  // find the map size for each CRP: kZ view is the first index
+  std::vector<GainMap> maps( m_geo->NTPC() );
+  unsigned long nval = 0;
+  for (geo::TPCGeo const& tpcgeo: m_geo->Iterate<geo::TPCGeo>())
+    {
+      unsigned crp = tpcgeo.ID().TPC;
+      if( crp >= maps.size() ) maps.resize( crp + 1 );
+      const geo::PlaneGeo& pfirst = tpcgeo.FirstPlane();
+      const geo::PlaneGeo& plast  = tpcgeo.LastPlane();
+      GainMap &gm = maps[crp];
+      if( pfirst.View() == geo::kZ )
+	{
+	  gm.nx = pfirst.Nwires();
+	  gm.ny = plast.Nwires();
+	}
+      else if( plast.View() == geo::kZ )
+	{
+	  gm.nx = plast.Nwires();
+	  gm.ny = pfirst.Nwires();
+	}
+      gm.offset = nval;
+      nval += (unsigned long)gm.nx * gm.ny;
+    }
+
+  if( nval > m_GainMapMaxSize )
+    {
+      if( m_LogLevel >= 1 )
+	cout<<myname<<"Map size "<<nval<<" exceeds "<<m_GainMapMaxSize
+	    <<". Gains are computed for each call."<<endl;
+      return;
+    }
+
+  m_gainVals.resize( nval );
+  for( unsigned crp = 0; crp < maps.size(); ++crp )
+    {
+      const GainMap &gm = maps[crp];
+      float *pval = m_gainVals.data() + gm.offset;
+      for( unsigned chx = 0; chx < gm.nx; ++chx )
+	{
+	  int iX = chx / m_LemViewChans;
+	  for( unsigned chy = 0; chy < gm.ny; ++chy )
+	    {
+	      // same as getCrpGain without the warning for each cell beyond the last LEM
+	      int iY  = chy / m_LemViewChans;
+	      int lid = iY + iX * m_CrpNLemPerSide;
+	      lid = lid < (int)m_CrpNLem ? lid + (int)crp * m_CrpNLem : -1;
+	      *pval++ = getLemGain( lid ) * getLemTransparency( chx, chy );
+	    }
+	}
+    }
+  m_gainMap = maps;
+
+  if( m_LogLevel >= 2 )
+    {
+      cout<<myname<<"Gain map built for "<<m_gainMap.size()<<" CRPs with "<<nval<<" entries."<<endl;
+    }
+}
+
+//
+//
+void util::CrpGainService::postBeginRun( art::Run const & )
+{
+  buildGainMap();
 }
 
 
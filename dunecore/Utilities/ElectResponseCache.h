@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   ElectResponseCache.h
+///
+/// \brief  Process-wide cache of the DUNE cold electronics response.
+///
+/// The SignalShapingServiceDUNE, DUNE10kt, DUNE34kt and DUNE35t services
+/// all sample the same BNL SPICE parameterization of the electronics
+/// response. This class holds that calculation and keeps each response,
+/// keyed by shaping time, gain, sampling period, tick count and ADC
+/// normalization, so that it is built once per process and shared by the
+/// services, their planes and their reconfigurations.
+///
+/// Returned references remain valid for the life of the process.
+/// Lookup is thread safe.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef ELECTRESPONSECACHE_H
+#define ELECTRESPONSECACHE_H
+
+#include "dunecore/DuneCommon/Utility/coldelecResponse.h"
+#include <vector>
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <cmath>
+
+namespace util {
+
+class ElectResponseCache {
+
+public:
+
+  using DoubleVector = std::vector<double>;
+
+  /// The shared instance.
+  static ElectResponseCache& instance() {
+    static ElectResponseCache cache;
+    return cache;
+  }
+
+  /// Build the response for nticks samples of period (ns) with peaking time
+  /// shapingtime (us). The peak is normalized to adcPerPC*1.60217657e-7*gain/4.7.
+  static DoubleVector build(double shapingtime, double gain, double period,
+                            int nticks, double adcPerPC);
+
+  /// Return the cached response, building it if needed.
+  const DoubleVector& get(double shapingtime, double gain, double period,
+                          int nticks, double adcPerPC);
+
+  /// Number of cached responses.
+  unsigned int size() const {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fResponses.size();
+  }
+
+private:
+
+  using Key = std::tuple<double, double, double, int, double>;
+
+  mutable std::mutex fMutex;
+  std::map<Key, DoubleVector> fResponses;
+
+};
+
+//**********************************************************************
+
+inline ElectResponseCache::DoubleVector
+ElectResponseCache::build(double shapingtime, double gain, double period,
+                          int nticks, double adcPerPC) {
+  DoubleVector resp(nticks > 0 ? nticks : 0, 0.);
+
+  //Gain and shaping time variables from fcl file:
+  double Ao = 1.0;
+  double To = shapingtime;  //peaking time
+
+  // The following sets the microboone electronics response function in
+  // time-space. Function comes from BNL SPICE simulation of DUNE35t
+  // electronics. SPICE gives the electronics transfer function in
+  // frequency-space. The inverse laplace transform of that function
+  // (in time-space) was calculated in Mathematica and is what is being
+  // used below. Parameters Ao and To are cumulative gain/timing parameters
+  // from the full (ASIC->Intermediate amp->Receiver->ADC) electronics chain.
+  // They have been adjusted to make the SPICE simulation to match the
+  // actual electronics response. Default params are Ao=1.4, To=0.5us.
+  // The expression is evaluated with coldelecResponseShape.
+  double max = 0;
+
+  for(size_t i = 0; i < resp.size(); ++i){
+
+    //convert time to microseconds, to match resp[i] definition
+    double time = (1.*i)*period *1e-3;
+    resp[i] = coldelecResponseShape(time/To)*Ao;
+
+    if(resp[i] > max) max = resp[i];
+
+  }// end loop over time buckets
+
+  //normalize resp[i], before the convolution
+
+  for(auto& element : resp){
+    element /= max;
+    element *= adcPerPC * 1.60217657e-7;
+    element *= gain / 4.7;
+  }
+
+  return resp;
+}
+
+//**********************************************************************
+
+inline const ElectResponseCache::DoubleVector&
+ElectResponseCache::get(double shapingtime, double gain, double period,
+                        int nticks, double adcPerPC) {
+  Key key(shapingtime, gain, period, nticks, adcPerPC);
+  std::lock_guard<std::mutex> lock(fMutex);
+  std::map<Key, DoubleVector>::const_iterator ient = fResponses.find(key);
+  if ( ient == fResponses.end() ) {
+    ient = fResponses.emplace(key, build(shapingtime, gain, period, nticks, adcPerPC)).first;
+  }
+  return ient->second;
+}
+
+//**********************************************************************
+
+}  // end namespace util
+
+#endif
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   ResponseResampler.h
+///
+/// \brief  Linear resampling of a response function to a coarser
+///         sampling period, with a cache of the results.
+///
+/// The input response is sampled with period periodIn starting at time 0.
+/// Output tick i at time i*periodOut takes the input value if an input
+/// time matches exactly and the linear interpolation between the
+/// neighbouring input samples otherwise. Output stops at the first tick
+/// beyond the last input time so the result may be shorter than nticks.
+///
+/// Input and output times both increase so a single pass with two
+/// indices replaces a search of the input for each output tick.
+///
+/// The cache returns the stored result when called again with the same
+/// response, periods and tick count, e.g. when a signal shaping service
+/// is reinitialized.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef RESPONSERESAMPLER_H
+#define RESPONSERESAMPLER_H
+
+#include <vector>
+
+namespace util {
+
+class ResponseResampler {
+
+public:
+
+  using DoubleVector = std::vector<double>;
+
+  /// Resample without the cache.
+  static DoubleVector resample(const DoubleVector& resp, double periodIn,
+                               double periodOut, int nticks);
+
+  /// Resample using the cache.
+  const DoubleVector& get(const DoubleVector& resp, double periodIn,
+                          double periodOut, int nticks);
+
+  /// Number of cached results.
+  unsigned int size() const { return fEntries.size(); }
+
+  /// Clear the cache.
+  void clear() { fEntries.clear(); }
+
+  /// Maximum number of cached results. The oldest is dropped beyond this.
+  static unsigned int maxSize() { return 16; }
+
+private:
+
+  struct Entry {
+    double periodIn;
+    double periodOut;
+    int nticks;
+    DoubleVector input;
+    DoubleVector output;
+  };
+
+  std::vector<Entry> fEntries;
+
+};
+
+//**********************************************************************
+
+inline ResponseResampler::DoubleVector
+ResponseResampler::resample(const DoubleVector& resp, double periodIn,
+                            double periodOut, int nticks) {
+  DoubleVector out;
+  int nin = resp.size();
+  if ( nin == 0 || nticks <= 0 ) return out;
+  out.reserve(nticks);
+  int jtime = 0;
+  double tin = 0.0;
+  for ( int itime = 0; itime < nticks; itime++ ) {
+    double tout = (1.*itime) * periodOut;
+    while ( jtime < nin && (tin = (1.*jtime) * periodIn) < tout ) ++jtime;
+    if ( jtime == nin ) break;
+    if ( tin == tout || jtime == 0 ) {
+      out.push_back(resp[jtime]);
+    } else {
+      int low = jtime - 1;
+      double tlow = (1.*low) * periodIn;
+      out.push_back(resp[low] + (tout - tlow) * (resp[jtime] - resp[low]) / (tin - tlow));
+    }
+  }
+  return out;
+}
+
+//**********************************************************************
+
+inline const ResponseResampler::DoubleVector&
+ResponseResampler::get(const DoubleVector& resp, double periodIn,
+                       double periodOut, int nticks) {
+  for ( const Entry& ent : fEntries ) {
+    if ( ent.periodIn == periodIn && ent.periodOut == periodOut &&
+         ent.nticks == nticks && ent.input == resp ) return ent.output;
+  }
+  if ( fEntries.size() >= maxSize() ) fEntries.erase(fEntries.begin());
+  fEntries.push_back({periodIn, periodOut, nticks, resp, resample(resp, periodIn, periodOut, nticks)});
+  return fEntries.back().output;
+}
+
+//**********************************************************************
+
+}  // end namespace util
+
+#endif
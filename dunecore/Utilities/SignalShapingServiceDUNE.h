@@ -24,6 +24,17 @@
 /// IndFilter       - Root parameterized induction plane filter function.
 /// IndFilterParams - Induction filter function parameters.
 ///
+/// The rows of an AdcChannelBlock, e.g. all the channels of an APA, may be
+/// convoluted or deconvoluted in one call. Rows sharing a kernel are
+/// transformed together with batched FFTW plans on a single workspace
+/// (see BlockShaping).
+///
+/// The service has SHARED scope. The kernels are built in postBeginJob, or on
+/// first use after a reconfigure, once under a lock. This is the only use of
+/// the LArFFT service: the single-channel and block transforms apply the
+/// SignalShaping kernels with FwFFT on a workspace for each call, so they may
+/// run concurrently with each other and with other LArFFT clients.
+///
 ////////////////////////////////////////////////////////////////////////
 
 #ifndef SIGNALSHAPINGSERVICEDUNE_H
@@ -35,14 +46,22 @@
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 #include "lardata/Utilities/SignalShaping.h"
+#include "dunecore/Utilities/ResponseResampler.h"
 #include "TF1.h"
 #include "TH1D.h"
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 namespace detinfo {
   class DetectorClocksData;
   class DetectorPropertiesData;
 }
 
+class AdcChannelBlock;
+class FwFFT;
+
 using DoubleVec = std::vector<double>;
 namespace util {
 
@@ -96,12 +115,23 @@ public:
   void Deconvolute(detinfo::DetectorClocksData const& clockData,
                    Channel channel, FloatVector& func) const override;
 
+  // Batched convolution and deconvolution of each row of a channel block.
+  // The block tick count must be the FFT size. Each row is shifted by the
+  // field response offset of its channel as in the single-channel calls.
+  void Convolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const override;
+  void Deconvolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const override;
+
 private:
 
   // Private configuration methods.
 
+  // Build the kernels at the start of the job.
+  void postBeginJob();
+
   // Post-constructor initialization.
-  void init() const{const_cast<SignalShapingServiceDUNE*>(this)->init();}
+  // The const version may be called concurrently and returns when the
+  // initialization is complete.
+  void init() const;
   void init();
 
   // Calculate response functions.
@@ -113,8 +143,19 @@ private:
   // Calculate filter functions.
   void SetFilters(detinfo::DetectorClocksData const& clockData);
 
+  // Apply the convolution or deconvolution kernels to the rows of a block.
+  void TransformBlock(detinfo::DetectorClocksData const& clockData,
+                      AdcChannelBlock& blk, bool decon) const;
+
+  // Apply a kernel to one time series, which must have the FFT size.
+  template <class T> void TransformSamples(const std::vector<TComplex>& kern,
+                                           std::vector<T>& func) const;
+  void TransformSamples(const std::vector<TComplex>& kern, DoubleVector& func) const;
+
   // Attributes.
   bool fInit;               ///< Initialization flag.
+  std::atomic<bool> fInitDone;              ///< Set when initialization is complete.
+  mutable std::recursive_mutex fInitMutex;  ///< Held during initialization.
 
   // Sample the response function, including a configurable
   // drift velocity of electrons
@@ -130,6 +171,7 @@ private:
   std::vector<double> fFieldResponseTOffset;  ///< Time offset for field response in ns
   std::vector<double> fCalibResponseTOffset;
   double fInputFieldRespSamplingPeriod;       ///< Sampling period in the input field response.
+  ResponseResampler fResponseResampler;       ///< Cache of resampled responses.
   double fDeconNorm;
   double fADCPerPCAtLowestASICGain; ///< Pulse amplitude gain for a 1 pc charge impulse after convoluting it the with field and electronics response with the lowest ASIC gain setting of 4.7 mV/fC
   std::vector<DoubleVec> fNoiseFactVec; 
@@ -169,6 +211,10 @@ private:
   std::vector<TComplex> fIndUFilter;
   std::vector<TComplex> fIndVFilter;
 
+  // Transforms for the single-channel and block calls and their size.
+  std::unique_ptr<FwFFT> fFwFFT;
+  unsigned int fFFTSize;
+
 };
 
 }  // end namespace util
@@ -180,7 +226,7 @@ template <class T>
 inline void util::SignalShapingServiceDUNE::
 Convolute(detinfo::DetectorClocksData const& clockData,
           unsigned int channel, std::vector<T>& func) const {
-  SignalShaping(channel).Convolute(func);
+  TransformSamples(SignalShaping(channel).ConvKernel(), func);
 
   //negative number
   int time_offset = FieldResponseTOffset(clockData, channel);
@@ -200,7 +246,7 @@ template <class T>
 inline void util::SignalShapingServiceDUNE::
 ConvoluteElectronicResponse(detinfo::DetectorClocksData const& clockData,
                             unsigned int channel, std::vector<T>& func) const {
-  ElectronicShaping(channel).Convolute(func);
+  TransformSamples(ElectronicShaping(channel).ConvKernel(), func);
 
   //negative number
   int time_offset = FieldResponseTOffset(clockData, channel);
@@ -224,7 +270,7 @@ template <class T>
 inline void util::SignalShapingServiceDUNE::
 Deconvolute(detinfo::DetectorClocksData const& clockData,
             unsigned int channel, std::vector<T>& func) const {
-  SignalShaping(channel).Deconvolute(func);
+  TransformSamples(SignalShaping(channel).DeconvKernel(), func);
 
   int time_offset = FieldResponseTOffset(clockData, channel);
   
@@ -242,6 +288,16 @@ Deconvolute(detinfo::DetectorClocksData const& clockData,
 
 //----------------------------------------------------------------------
 
-DECLARE_ART_SERVICE(util::SignalShapingServiceDUNE, LEGACY)
+template <class T>
+inline void util::SignalShapingServiceDUNE::
+TransformSamples(const std::vector<TComplex>& kern, std::vector<T>& func) const {
+  DoubleVector data(func.begin(), func.end());
+  TransformSamples(kern, data);
+  std::copy(data.begin(), data.end(), func.begin());
+}
+
+//----------------------------------------------------------------------
+
+DECLARE_ART_SERVICE(util::SignalShapingServiceDUNE, SHARED)
 
 #endif
@@ -34,6 +34,7 @@
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 #include "lardata/Utilities/SignalShaping.h"
+#include "dunecore/Utilities/ResponseResampler.h"
 #include "TF1.h"
 #include "TH1D.h"
 
@@ -127,6 +128,7 @@ namespace util {
     std::vector<double> fFieldResponseTOffset;  ///< Time offset for field response in ns
     std::vector<double> fCalibResponseTOffset;
     double fInputFieldRespSamplingPeriod;       ///< Sampling period in the input field response.
+    ResponseResampler fResponseResampler;      ///< Cache of resampled responses.
   
     double fDeconNorm;
     double fADCPerPCAtLowestASICGain; ///< Pulse amplitude gain for a 1 pc charge impulse after convoluting it the with field and electronics response with the lowest ASIC gain setting of 4.7 mV/fC
@@ -14,6 +14,7 @@
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/Utilities/LArFFT.h"
+#include "dunecore/Utilities/ElectResponseCache.h"
 #include "TFile.h"
 
 //----------------------------------------------------------------------
@@ -520,68 +521,17 @@ void util::SignalShapingServiceDUNE34kt::SetElectResponse(double shapingtime, do
 {
   // Get services.
 
-  art::ServiceHandle<geo::Geometry> geo;
   art::ServiceHandle<util::LArFFT> fft;
 
   MF_LOG_DEBUG("SignalShapingDUNE34kt") << "Setting DUNE34kt electronics response function...";
 
+  // The response is shared with the other DUNE signal shaping services.
   int nticks = fft->FFTSize();
-  fElectResponse.resize(nticks, 0.);
-  std::vector<double> time(nticks,0.);
-
-  //Gain and shaping time variables from fcl file:    
-  double Ao = 1.0;
-  double To = shapingtime;  //peaking time
-    
-  // this is actually sampling time, in ns
-  // mf::LogInfo("SignalShapingDUNE35t") << "Check sampling intervals: " 
-  //                                  << fSampleRate << " ns" 
-  //                                  << "Check number of samples: " << fNTicks;
-
-  // The following sets the microboone electronics response function in 
-  // time-space. Function comes from BNL SPICE simulation of DUNE35t 
-  // electronics. SPICE gives the electronics transfer function in 
-  // frequency-space. The inverse laplace transform of that function 
-  // (in time-space) was calculated in Mathematica and is what is being 
-  // used below. Parameters Ao and To are cumulative gain/timing parameters 
-  // from the full (ASIC->Intermediate amp->Receiver->ADC) electronics chain. 
-  // They have been adjusted to make the SPICE simulation to match the 
-  // actual electronics response. Default params are Ao=1.4, To=0.5us. 
-  double max = 0;
-  
-  for(size_t i = 0; i < fElectResponse.size(); ++i){
-
-    //convert time to microseconds, to match fElectResponse[i] definition
-    time[i] = (1.*i)*fInputFieldRespSamplingPeriod*1e-3; 
-    fElectResponse[i] = 
-      4.31054*exp(-2.94809*time[i]/To)*Ao - 2.6202*exp(-2.82833*time[i]/To)*cos(1.19361*time[i]/To)*Ao
-      -2.6202*exp(-2.82833*time[i]/To)*cos(1.19361*time[i]/To)*cos(2.38722*time[i]/To)*Ao
-      +0.464924*exp(-2.40318*time[i]/To)*cos(2.5928*time[i]/To)*Ao
-      +0.464924*exp(-2.40318*time[i]/To)*cos(2.5928*time[i]/To)*cos(5.18561*time[i]/To)*Ao
-      +0.762456*exp(-2.82833*time[i]/To)*sin(1.19361*time[i]/To)*Ao
-      -0.762456*exp(-2.82833*time[i]/To)*cos(2.38722*time[i]/To)*sin(1.19361*time[i]/To)*Ao
-      +0.762456*exp(-2.82833*time[i]/To)*cos(1.19361*time[i]/To)*sin(2.38722*time[i]/To)*Ao
-      -2.6202*exp(-2.82833*time[i]/To)*sin(1.19361*time[i]/To)*sin(2.38722*time[i]/To)*Ao 
-      -0.327684*exp(-2.40318*time[i]/To)*sin(2.5928*time[i]/To)*Ao + 
-      +0.327684*exp(-2.40318*time[i]/To)*cos(5.18561*time[i]/To)*sin(2.5928*time[i]/To)*Ao
-      -0.327684*exp(-2.40318*time[i]/To)*cos(2.5928*time[i]/To)*sin(5.18561*time[i]/To)*Ao
-      +0.464924*exp(-2.40318*time[i]/To)*sin(2.5928*time[i]/To)*sin(5.18561*time[i]/To)*Ao;
-
-    if(fElectResponse[i] > max) max = fElectResponse[i];
-    
-  }// end loop over time buckets
-    
+  fElectResponse = ElectResponseCache::instance().get(shapingtime, gain, fInputFieldRespSamplingPeriod,
+                                                      nticks, fADCPerPCAtLowestASICGain);
 
   MF_LOG_DEBUG("SignalShapingDUNE34kt") << " Done.";
 
- //normalize fElectResponse[i], before the convolution   
-  
-   for(auto& element : fElectResponse){
-    element /= max;
-    element *= fADCPerPCAtLowestASICGain * 1.60217657e-7;
-    element *= gain / 4.7;
-   }
-  
   return;
 
 }
@@ -671,12 +621,6 @@ void util::SignalShapingServiceDUNE34kt::SetResponseSampling(detinfo::DetectorCl
 				       << "\033[00m" << std::endl;
 
   int nticks = fft->FFTSize();
-  std::vector<double> SamplingTime( nticks, 0. );
-  for ( int itime = 0; itime < nticks; itime++ ) {
-    SamplingTime[itime] = (1.*itime) * sampling_rate(clockData);
-    /// VELOCITY-OUT ... comment out kDVel usage here
-    //SamplingTime[itime] = (1.*itime) * sampling_rate(clockData) / kDVel;
-  }
 
   // Sampling
   for ( int iplane = 0; iplane < 2; iplane++ ) {
@@ -687,44 +631,9 @@ void util::SignalShapingServiceDUNE34kt::SetResponseSampling(detinfo::DetectorCl
     default: pResp = &(fColSignalShaping.Response_save()); break;
     }
 
-    std::vector<double> SamplingResp(nticks , 0. );
-    
-    
-    int nticks_input = pResp->size();
-    std::vector<double> InputTime(nticks_input, 0. );
-    for ( int itime = 0; itime < nticks_input; itime++ ) {
-      InputTime[itime] = (1.*itime) * fInputFieldRespSamplingPeriod;
-    }
-    
-   
-    /*
-      Much more sophisticated approach using a linear (trapezoidal) interpolation 
-      Current default!
-    */
-    int SamplingCount = 0;    
-    for ( int itime = 0; itime < nticks; itime++ ) {
-      int low = -1, up = -1;
-      for ( int jtime = 0; jtime < nticks_input; jtime++ ) {
-        if ( InputTime[jtime] == SamplingTime[itime] ) {
-          SamplingResp[itime] = (*pResp)[jtime];
-	  /// VELOCITY-OUT ... comment out kDVel usage here
-          //SamplingResp[itime] = kDVel * (*pResp)[jtime];
-          SamplingCount++;
-          break;
-        } else if ( InputTime[jtime] > SamplingTime[itime] ) {
-          low = jtime - 1;
-          up = jtime;
-          SamplingResp[itime] = (*pResp)[low] + ( SamplingTime[itime] - InputTime[low] ) * ( (*pResp)[up] - (*pResp)[low] ) / ( InputTime[up] - InputTime[low] );
-	  /// VELOCITY-OUT ... comment out kDVel usage here
-          //SamplingResp[itime] *= kDVel;
-          SamplingCount++;
-          break;
-        } else {
-          SamplingResp[itime] = 0.;
-        }
-      } // for ( int jtime = 0; jtime < nticks; jtime++ )
-    } // for ( int itime = 0; itime < nticks; itime++ )
-    SamplingResp.resize( SamplingCount, 0.);    
+    // Linear (trapezoidal) interpolation of the input response.
+    const std::vector<double>& SamplingResp =
+      fResponseResampler.get(*pResp, fInputFieldRespSamplingPeriod, sampling_rate(clockData), nticks);
 
   
 
@@ -39,6 +39,12 @@
 ///     Updated filter function to sample up-to correct 1.25 MHz
 ///     This service now inherits from SignalShapingService
 ///
+///     The rows of an AdcChannelBlock, e.g. all the channels of a view, may
+///     be convoluted or deconvoluted in one call. Rows sharing a kernel are
+///     transformed together with batched FFTW plans (see BlockShaping).
+///     The view (3 m or 1 m strips) of each channel is found once at
+///     initialization.
+///
 ///        
 ////////////////////////////////////////////////////////////////////////
 
@@ -48,6 +54,7 @@
 #include "dunecore/DuneInterface/Service/SignalShapingService.h"
 
 #include <vector>
+#include <memory>
 #include "fhiclcpp/ParameterSet.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
@@ -58,6 +65,8 @@ namespace detinfo {
   class DetectorClocksData;
 }
 
+class FwFFT;
+
 using DoubleVec = std::vector<double>;
 
 namespace util {
@@ -100,6 +109,11 @@ namespace util {
     void Deconvolute(detinfo::DetectorClocksData const& clockData, Channel channel, DoubleVector& func) const override;
     void Deconvolute(detinfo::DetectorClocksData const& clockData, Channel channel, FloatVector& func) const override;
 
+    // Batched convolution and deconvolution of each row of a channel block.
+    // The block tick count must be the FFT size.
+    void Convolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const override;
+    void Deconvolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const override;
+
   private:
 
     // Private configuration methods.
@@ -121,6 +135,15 @@ namespace util {
     void SetResponseSampling(detinfo::DetectorClocksData const& clockData,
                              util::SignalShaping &sig );
 
+    // Find the view of each channel from its strip length.
+    void SetChannelViews();
+
+    // Return 0 for a 3 m view channel, 1 for 1 m and -1 if unknown.
+    int ChannelView(unsigned int channel) const;
+
+    // Apply the convolution or deconvolution kernels to the rows of a block.
+    void TransformBlock(AdcChannelBlock& blk, bool decon) const;
+
     // Attributes.
     bool fInit;               ///< Initialization flag.
 
@@ -163,6 +186,12 @@ namespace util {
     TF1* fColFilterFunc;      	      ///< Parameterized collection filter function.
     std::vector<TComplex> fColFilter;
     std::vector<double>fParArray;
+
+    // View of each channel (see ChannelView) if there is a 1 m view.
+    std::vector<signed char> fChannelViews;
+
+    // Transforms for the block calls.
+    std::unique_ptr<FwFFT> fFwFFT;
   };
 }
 
@@ -15,6 +15,8 @@
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/Utilities/LArFFT.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom()
+#include "dunecore/DuneCommon/Utility/FwFFT.h"
+#include "dunecore/Utilities/BlockShaping.h"
 #include "TSpline.h"
 
 //#include "TFile.h"
@@ -125,21 +127,14 @@ util::SignalShapingServiceDUNEDPhase::SignalShaping(unsigned int channel) const
   if( !fHave1mView ) return fColSignalShaping;
   
   //
-  auto const* geom = lar::providerFrom<geo::Geometry>();
-  std::vector<geo::WireID> Wires =  geom->ChannelToWire(channel);
-
-  double wirestartpoint[3];
-  double wireendpoint[3];
-  geom->WireEndPoints(Wires[0],wirestartpoint,wireendpoint);
-  double wirelength = sqrt(pow(wirestartpoint[0]-wireendpoint[0],2) + pow(wirestartpoint[1]-wireendpoint[1],2) + pow(wirestartpoint[2]-wireendpoint[2],2));
-
-  if((int)wirelength == 300)
+  int iview = ChannelView(channel);
+  if(iview == 0)
     return fColSignalShaping;
-  else if((int)wirelength == 100)
+  else if(iview == 1)
     return fColSignalShaping1m;
   else
     throw cet::exception("SignalShapingServiceDUNEDPhase")
-        << "unexpected signal type " << geom->SignalType(channel)
+        << "unexpected signal type " << lar::providerFrom<geo::Geometry>()->SignalType(channel)
         << " for channel #" << channel << "\n";
 /*
   switch (geom->SignalType(channel)) {
@@ -201,6 +196,43 @@ void util::SignalShapingServiceDUNEDPhase::init()
   fColSignalShaping.CalculateDeconvKernel();
   fColSignalShaping1m.AddFilterFunction(fColFilter);
   fColSignalShaping1m.CalculateDeconvKernel();
+
+  // Views of the channels.
+  SetChannelViews();
+
+  // Transforms for the block calls.
+  art::ServiceHandle<util::LArFFT> fft;
+  fFwFFT.reset(new FwFFT(fft->FFTSize(), 0));
+}
+
+//----------------------------------------------------------------------
+// Find the view of each channel from the length of its strip.
+void util::SignalShapingServiceDUNEDPhase::SetChannelViews()
+{
+  fChannelViews.clear();
+  if( !fHave1mView ) return;
+  auto const* geom = lar::providerFrom<geo::Geometry>();
+  unsigned int nchan = geom->Nchannels();
+  fChannelViews.resize(nchan, -1);
+  for( unsigned int chan=0; chan<nchan; ++chan )
+    {
+      std::vector<geo::WireID> Wires =  geom->ChannelToWire(chan);
+      if( Wires.empty() ) continue;
+      double wirestartpoint[3];
+      double wireendpoint[3];
+      geom->WireEndPoints(Wires[0],wirestartpoint,wireendpoint);
+      double wirelength = sqrt(pow(wirestartpoint[0]-wireendpoint[0],2) + pow(wirestartpoint[1]-wireendpoint[1],2) + pow(wirestartpoint[2]-wireendpoint[2],2));
+      if((int)wirelength == 300) fChannelViews[chan] = 0;
+      else if((int)wirelength == 100) fChannelViews[chan] = 1;
+    }
+}
+
+//----------------------------------------------------------------------
+int util::SignalShapingServiceDUNEDPhase::ChannelView(unsigned int channel) const
+{
+  if( !fHave1mView ) return 0;
+  if( channel >= fChannelViews.size() ) return -1;
+  return fChannelViews[channel];
 }
 
 //-----Give Gain Settings to SimWire-----//
@@ -211,16 +243,11 @@ double util::SignalShapingServiceDUNEDPhase::GetASICGain(unsigned int const chan
 
   //
   double gain = 0;
-  art::ServiceHandle<geo::Geometry> geom;
-  std::vector<geo::WireID> Wires =  geom->ChannelToWire(channel);
-  double wirestartpoint[3];
-  double wireendpoint[3];
-  geom->WireEndPoints(Wires[0],wirestartpoint,wireendpoint);
-  double wirelength = sqrt(pow(wirestartpoint[0]-wireendpoint[0],2) + pow(wirestartpoint[1]-wireendpoint[1],2) + pow(wirestartpoint[2]-wireendpoint[2],2));
-
-  if((int)wirelength == 300)
+  int iview = ChannelView(channel);
+
+  if(iview == 0)
     gain = fPulseHeight;
-  else if((int)wirelength == 100)
+  else if(iview == 1)
     gain = fPulseHeight1m;
   else
     throw cet::exception("SignalShapingServiceDUNEDPhase")<< "can't determine"
@@ -236,16 +263,11 @@ double util::SignalShapingServiceDUNEDPhase::GetAreaNorm(unsigned int const chan
 
   //
   double gain = 0;
-  art::ServiceHandle<geo::Geometry> geom;
-  std::vector<geo::WireID> Wires =  geom->ChannelToWire(channel);
-  double wirestartpoint[3];
-  double wireendpoint[3];
-  geom->WireEndPoints(Wires[0],wirestartpoint,wireendpoint);
-  double wirelength = sqrt(pow(wirestartpoint[0]-wireendpoint[0],2) + pow(wirestartpoint[1]-wireendpoint[1],2) + pow(wirestartpoint[2]-wireendpoint[2],2));
-
-  if((int)wirelength == 300)
+  int iview = ChannelView(channel);
+
+  if(iview == 0)
     gain = fAreaNorm;
-  else if((int)wirelength == 100)
+  else if(iview == 1)
     gain = fAreaNorm1m;
   else
     throw cet::exception("SignalShapingServiceDUNEDPhase")<< "can't determine"
@@ -519,6 +541,39 @@ Deconvolute(detinfo::DetectorClocksData const&,
   return Deconvolute<double>(channel, func);
 }
 
+//----------------------------------------------------------------------
+// Block convolution and deconvolution.
+void util::SignalShapingServiceDUNEDPhase::
+Convolute(detinfo::DetectorClocksData const&, AdcChannelBlock& blk) const {
+  TransformBlock(blk, false);
+}
+
+void util::SignalShapingServiceDUNEDPhase::
+Deconvolute(detinfo::DetectorClocksData const&, AdcChannelBlock& blk) const {
+  TransformBlock(blk, true);
+}
+
+//----------------------------------------------------------------------
+// There is no field response offset so the rows are not rotated.
+void util::SignalShapingServiceDUNEDPhase::
+TransformBlock(AdcChannelBlock& blk, bool decon) const {
+  const std::string myname = "SignalShapingServiceDUNEDPhase::TransformBlock: ";
+  unsigned int nrow = blk.nrow();
+  if( nrow == 0 ) return;
+  // Group the rows by kernel. This also makes sure the service is initialized.
+  BlockShaping::KernelRows kernelRows;
+  for( unsigned int irow=0; irow<nrow; ++irow ) {
+    const util::SignalShaping& shaping = SignalShaping(blk.channel(irow));
+    kernelRows[decon ? &shaping.DeconvKernel() : &shaping.ConvKernel()].push_back(irow);
+  }
+  art::ServiceHandle<util::LArFFT> fft;
+  if( blk.ntick() != (unsigned int) fft->FFTSize() ) {
+    throw cet::exception("SignalShapingServiceDUNEDPhase") << myname
+          << "Bad time series size = " << blk.ntick() << "\n";
+  }
+  BlockShaping::transform(*fFwFFT, blk, kernelRows, BlockShaping::OffsetVector(),
+                          "SignalShapingServiceDUNEDPhase");
+}
 
 namespace util {
 
@@ -14,17 +14,23 @@
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/Utilities/LArFFT.h"
+#include "dunecore/Utilities/ElectResponseCache.h"
+#include "dunecore/DuneInterface/Data/AdcChannelBlock.h"
+#include "dunecore/DuneCommon/Utility/FwFFT.h"
+#include "dunecore/Utilities/BlockShaping.h"
 #include "TFile.h"
+#include <map>
 
 using std::string;
 
 //----------------------------------------------------------------------
 // Constructor.
 util::SignalShapingServiceDUNE::SignalShapingServiceDUNE(const fhicl::ParameterSet& pset,
-								    art::ActivityRegistry& /* reg */) 
-  : fInit(false)
+								    art::ActivityRegistry& reg) 
+  : fInit(false), fInitDone(false), fFFTSize(0)
 {
   reconfigure(pset);
+  reg.sPostBeginJob.watch(this, &SignalShapingServiceDUNE::postBeginJob);
 }
 
 
@@ -41,6 +47,7 @@ void util::SignalShapingServiceDUNE::reconfigure(const fhicl::ParameterSet& pset
   // Reset initialization flag.
   
   fInit = false;
+  fInitDone = false;
 
   // Reset kernels.
 
@@ -184,8 +191,7 @@ void util::SignalShapingServiceDUNE::reconfigure(const fhicl::ParameterSet& pset
 const util::SignalShaping&
 util::SignalShapingServiceDUNE::SignalShaping(unsigned int channel) const {
   const string myname = "SignalShapingServiceDUNE::ctor: ";
-  if(!fInit)
-    init();
+  init();
 
   // Figure out plane type.
 
@@ -212,8 +218,7 @@ return fColSignalShaping;
 const util::SignalShaping&
 util::SignalShapingServiceDUNE::ElectronicShaping(unsigned int channel) const {
   const string myname = "SignalShapingServiceDUNE::ElectronicShaping: ";
-  if(!fInit)
-    init();
+  init();
 
   // Figure out plane type.
 
@@ -374,6 +379,26 @@ unsigned int util::SignalShapingServiceDUNE::GetSignalSize() const {
   return SignalShaping(0).Response().size();
 }
 
+//----------------------------------------------------------------------
+// Initialize before any events are processed so the LArFFT buffers used to
+// build the kernels are not shared with other clients processing events.
+void util::SignalShapingServiceDUNE::postBeginJob()
+{
+  static_cast<const SignalShapingServiceDUNE*>(this)->init();
+}
+
+
+//----------------------------------------------------------------------
+// Thread-safe initialization. Calls made from within init() by the thread
+// doing the initialization find fInit set and return.
+void util::SignalShapingServiceDUNE::init() const
+{
+  if(fInitDone.load(std::memory_order_acquire)) return;
+  std::lock_guard<std::recursive_mutex> lock(fInitMutex);
+  const_cast<SignalShapingServiceDUNE*>(this)->init();
+}
+
+
 //----------------------------------------------------------------------
 // Initialization method.
 // Here we do initialization that can't be done in the constructor.
@@ -447,6 +472,13 @@ void util::SignalShapingServiceDUNE::init()
 
     fIndVSignalShaping.AddFilterFunction(fIndVFilter);
     fIndVSignalShaping.CalculateDeconvKernel();
+
+    // Transforms for the block calls.
+
+    art::ServiceHandle<util::LArFFT> fft;
+    fFFTSize = fft->FFTSize();
+    fFwFFT.reset(new FwFFT(fFFTSize, 0));
+    fInitDone.store(true, std::memory_order_release);
   }
 }
 
@@ -573,68 +605,17 @@ void util::SignalShapingServiceDUNE::SetElectResponse(double shapingtime, double
 {
   // Get services.
 
-  art::ServiceHandle<geo::Geometry> geo;
   art::ServiceHandle<util::LArFFT> fft;
 
   MF_LOG_DEBUG("SignalShapingDUNE") << "Setting DUNE electronics response function...";
 
+  // The response is shared with the other DUNE signal shaping services.
   int nticks = fft->FFTSize();
-  fElectResponse.resize(nticks, 0.);
-  std::vector<double> time(nticks,0.);
-
-  //Gain and shaping time variables from fcl file:    
-  double Ao = 1.0;
-  double To = shapingtime;  //peaking time
-    
-  // this is actually sampling time, in ns
-  // mf::LogInfo("SignalShapingDUNE") << "Check sampling intervals: " 
-  //                                  << fSampleRate << " ns" 
-  //                                  << "Check number of samples: " << fNTicks;
-
-  // The following sets the microboone electronics response function in 
-  // time-space. Function comes from BNL SPICE simulation of DUNE35t 
-  // electronics. SPICE gives the electronics transfer function in 
-  // frequency-space. The inverse laplace transform of that function 
-  // (in time-space) was calculated in Mathematica and is what is being 
-  // used below. Parameters Ao and To are cumulative gain/timing parameters 
-  // from the full (ASIC->Intermediate amp->Receiver->ADC) electronics chain. 
-  // They have been adjusted to make the SPICE simulation to match the 
-  // actual electronics response. Default params are Ao=1.4, To=0.5us. 
-  double max = 0;
-  
-  for(size_t i = 0; i < fElectResponse.size(); ++i){
-
-    //convert time to microseconds, to match fElectResponse[i] definition
-    time[i] = (1.*i)*fInputFieldRespSamplingPeriod *1e-3; 
-    fElectResponse[i] = 
-      4.31054*exp(-2.94809*time[i]/To)*Ao - 2.6202*exp(-2.82833*time[i]/To)*cos(1.19361*time[i]/To)*Ao
-      -2.6202*exp(-2.82833*time[i]/To)*cos(1.19361*time[i]/To)*cos(2.38722*time[i]/To)*Ao
-      +0.464924*exp(-2.40318*time[i]/To)*cos(2.5928*time[i]/To)*Ao
-      +0.464924*exp(-2.40318*time[i]/To)*cos(2.5928*time[i]/To)*cos(5.18561*time[i]/To)*Ao
-      +0.762456*exp(-2.82833*time[i]/To)*sin(1.19361*time[i]/To)*Ao
-      -0.762456*exp(-2.82833*time[i]/To)*cos(2.38722*time[i]/To)*sin(1.19361*time[i]/To)*Ao
-      +0.762456*exp(-2.82833*time[i]/To)*cos(1.19361*time[i]/To)*sin(2.38722*time[i]/To)*Ao
-      -2.6202*exp(-2.82833*time[i]/To)*sin(1.19361*time[i]/To)*sin(2.38722*time[i]/To)*Ao 
-      -0.327684*exp(-2.40318*time[i]/To)*sin(2.5928*time[i]/To)*Ao + 
-      +0.327684*exp(-2.40318*time[i]/To)*cos(5.18561*time[i]/To)*sin(2.5928*time[i]/To)*Ao
-      -0.327684*exp(-2.40318*time[i]/To)*cos(2.5928*time[i]/To)*sin(5.18561*time[i]/To)*Ao
-      +0.464924*exp(-2.40318*time[i]/To)*sin(2.5928*time[i]/To)*sin(5.18561*time[i]/To)*Ao;
-
-    if(fElectResponse[i] > max) max = fElectResponse[i];
-    
-  }// end loop over time buckets
-    
+  fElectResponse = ElectResponseCache::instance().get(shapingtime, gain, fInputFieldRespSamplingPeriod,
+                                                      nticks, fADCPerPCAtLowestASICGain);
 
   MF_LOG_DEBUG("SignalShapingDUNE") << " Done.";
 
- //normalize fElectResponse[i], before the convolution   
-  
-   for(auto& element : fElectResponse){
-    element /= max;
-    element *= fADCPerPCAtLowestASICGain * 1.60217657e-7;
-    element *= gain / 4.7;
-   }
-  
   return;
 
 }
@@ -724,12 +705,6 @@ void util::SignalShapingServiceDUNE::SetResponseSampling(detinfo::DetectorClocks
 				       << "\033[00m" << std::endl;
 
   int nticks = fft->FFTSize();
-  std::vector<double> SamplingTime( nticks, 0. );
-  for ( int itime = 0; itime < nticks; itime++ ) {
-    SamplingTime[itime] = (1.*itime) * sampling_rate(clockData);
-    /// VELOCITY-OUT ... comment out kDVel usage here
-    //SamplingTime[itime] = (1.*itime) * sampling_rate(clockData) / kDVel;
-  }
 
   // Sampling
   for ( int iplane = 0; iplane < 3; iplane++ ) {
@@ -748,44 +723,9 @@ void util::SignalShapingServiceDUNE::SetResponseSampling(detinfo::DetectorClocks
       }
     }
 
-    std::vector<double> SamplingResp(nticks , 0. );
-    
-    
-    int nticks_input = pResp->size();
-    std::vector<double> InputTime(nticks_input, 0. );
-    for ( int itime = 0; itime < nticks_input; itime++ ) {
-      InputTime[itime] = (1.*itime) * fInputFieldRespSamplingPeriod;
-    }
-    
-   
-    /*
-      Much more sophisticated approach using a linear (trapezoidal) interpolation 
-      Current default!
-    */
-    int SamplingCount = 0;    
-    for ( int itime = 0; itime < nticks; itime++ ) {
-      int low = -1, up = -1;
-      for ( int jtime = 0; jtime < nticks_input; jtime++ ) {
-        if ( InputTime[jtime] == SamplingTime[itime] ) {
-          SamplingResp[itime] = (*pResp)[jtime];
-	  /// VELOCITY-OUT ... comment out kDVel usage here
-          //SamplingResp[itime] = kDVel * (*pResp)[jtime];
-          SamplingCount++;
-          break;
-        } else if ( InputTime[jtime] > SamplingTime[itime] ) {
-          low = jtime - 1;
-          up = jtime;
-          SamplingResp[itime] = (*pResp)[low] + ( SamplingTime[itime] - InputTime[low] ) * ( (*pResp)[up] - (*pResp)[low] ) / ( InputTime[up] - InputTime[low] );
-	  /// VELOCITY-OUT ... comment out kDVel usage here
-          //SamplingResp[itime] *= kDVel;
-          SamplingCount++;
-          break;
-        } else {
-          SamplingResp[itime] = 0.;
-        }
-      } // for ( int jtime = 0; jtime < nticks; jtime++ )
-    } // for ( int itime = 0; itime < nticks; itime++ )
-    SamplingResp.resize( SamplingCount, 0.);    
+    // Linear (trapezoidal) interpolation of the input response.
+    const std::vector<double>& SamplingResp =
+      fResponseResampler.get(*pResp, fInputFieldRespSamplingPeriod, sampling_rate(clockData), nticks);
 
   
     if (not elect_only) {
@@ -872,6 +812,58 @@ Deconvolute(detinfo::DetectorClocksData const& clockData,
   return Deconvolute<double>(clockData, channel, func);
 }
 
+//----------------------------------------------------------------------
+
+void util::SignalShapingServiceDUNE::
+Convolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const {
+  TransformBlock(clockData, blk, false);
+}
+
+void util::SignalShapingServiceDUNE::
+Deconvolute(detinfo::DetectorClocksData const& clockData, AdcChannelBlock& blk) const {
+  TransformBlock(clockData, blk, true);
+}
+
+//----------------------------------------------------------------------
+
+void util::SignalShapingServiceDUNE::
+TransformBlock(detinfo::DetectorClocksData const& clockData,
+               AdcChannelBlock& blk, bool decon) const {
+  const string myname = "SignalShapingServiceDUNE::TransformBlock: ";
+  using Index = unsigned int;
+  Index nrow = blk.nrow();
+  if ( nrow == 0 ) return;
+  // Group the rows by kernel. This also makes sure the service is initialized.
+  // Sample isam of each row is taken from isam + ioff where ioff is the time
+  // offset for deconvolution and its negative for convolution.
+  BlockShaping::KernelRows kernelRows;
+  BlockShaping::OffsetVector offsets(nrow);
+  for ( Index irow=0; irow<nrow; ++irow ) {
+    const util::SignalShaping& shaping = SignalShaping(blk.channel(irow));
+    kernelRows[decon ? &shaping.DeconvKernel() : &shaping.ConvKernel()].push_back(irow);
+    int toff = FieldResponseTOffset(clockData, blk.channel(irow));
+    offsets[irow] = decon ? toff : -toff;
+  }
+  Index nsam = fFFTSize;
+  if ( blk.ntick() != nsam ) {
+    throw cet::exception("SignalShapingServiceDUNE") << myname
+          << "Bad time series size = " << blk.ntick() << "\n";
+  }
+  BlockShaping::transform(*fFwFFT, blk, kernelRows, offsets, "SignalShapingServiceDUNE");
+}
+
+//----------------------------------------------------------------------
+
+void util::SignalShapingServiceDUNE::
+TransformSamples(const std::vector<TComplex>& kern, DoubleVector& func) const {
+  const string myname = "SignalShapingServiceDUNE::TransformSamples: ";
+  init();
+  if ( func.size() != fFFTSize ) {
+    throw cet::exception("SignalShapingServiceDUNE") << myname
+          << "Bad time series size = " << func.size() << "\n";
+  }
+  BlockShaping::transformSamples(*fFwFFT, kern, func.data(), func.size(), "SignalShapingServiceDUNE");
+}
 
 namespace util {
 
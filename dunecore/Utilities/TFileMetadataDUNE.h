@@ -7,6 +7,12 @@
 // Created: 1-Nov-2017,  T. Junk
 //   Based on the MicroBooNE version by S. Gollapinni
 //
+// The per-event accounting in postEvent uses atomic counters so that
+// schedules in multithreaded jobs do not serialize on it.  The subrun list
+// is locked only when an event from a new subrun is seen.  The counters are
+// copied into md when an output file is closed and at the end of the job,
+// where the JSON is written.
+//
 ////////////////////////////////////////////////////////////////////////
 #ifndef TFILEMETADATADUNE_H
 #define TFILEMETADATADUNE_H
@@ -22,6 +28,8 @@
 #include "art/Persistency/Provenance/ScheduleContext.h"
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <mutex>
 
 using namespace std;
 
@@ -86,8 +94,25 @@ namespace util{
 
     // Private member functions.
 
+    // Record a subrun in fSubRunNumbers and md.fruns if it is new.
+    void addSubRun(art::SubRunID const& srid);
+
+    // Copy the event counters into md.
+    void syncCounters();
+
     // Data members.
 
+    // Per-event counters.
+    std::atomic<unsigned int> fEventCount{0};
+    std::atomic<unsigned int> fNewEventCount{0};
+    std::atomic<art::EventNumber_t> fFirstEvent{0};
+    std::atomic<art::EventNumber_t> fLastEvent{0};
+
+    // Most recently recorded subrun, packed as run<<32 | subrun, so that
+    // events from a known subrun do not take the lock.
+    std::atomic<unsigned long long> fLastSubRunKey{~0ull};
+    std::mutex fSubRunMutex;
+
     // Fcl parameters.
     bool fGenerateTFileMetadata;  
     std::string frunType;                     
@@ -193,28 +193,20 @@ void util::TFileMetadataDUNE::postEvent(art::Event const& evt, art::ScheduleCont
  
   if(!fGenerateTFileMetadata) return;	
   
-  art::RunNumber_t run = evt.run();
-  art::SubRunNumber_t subrun = evt.subRun();
   art::EventNumber_t event = evt.event();
-  art::SubRunID srid = evt.id().subRunID();
-      
-  // save run, subrun and runType information once every subrun    
-  if (fSubRunNumbers.count(srid) == 0){
-    fSubRunNumbers.insert(srid);
-    md.fruns.push_back(make_tuple(run, subrun, frunType));   
-  }
-  
-  // save the first event
-  if (md.fevent_count == 0) md.ffirst_event = event;
-  md.flast_event = event;
-  // event counter
-  ++md.fevent_count;
+
+  // save run, subrun and runType information once every subrun
+  addSubRun(evt.id().subRunID());
+
+  // save the first event; the thread taking count zero sets it
+  if (fEventCount.fetch_add(1, std::memory_order_relaxed) == 0) fFirstEvent.store(event, std::memory_order_relaxed);
+  fLastEvent.store(event, std::memory_order_relaxed);
 
   art::InputTag itag("TriggerResults");
   auto h = evt.getHandle<art::TriggerResults>(itag);
   if (h && h->accept()) {
     // Event passed at least one of the paths
-    ++md.fnew_event_count;
+    fNewEventCount.fetch_add(1, std::memory_order_relaxed);
   }
     
 }
@@ -231,6 +223,7 @@ void util::TFileMetadataDUNE::postCloseOutput(art::OutputFileInfo const& output_
   //if (md.fevent_count == 0) md.ffirst_event = event;
   //md.flast_event = event;
   // event counter
+  syncCounters();
   md.fFileName = output_file.fileName();
     
 }
@@ -243,15 +236,33 @@ void util::TFileMetadataDUNE::postBeginSubRun(art::SubRun const& sr)
 
   if(!fGenerateTFileMetadata) return;
 
-  art::RunNumber_t run = sr.run();
-  art::SubRunNumber_t subrun = sr.subRun();
-  art::SubRunID srid = sr.id();
-
   // save run, subrun and runType information once every subrun
+  addSubRun(sr.id());
+}
+
+//--------------------------------------------------------------------
+// Record a new subrun.  Events mostly come from the subrun recorded last,
+// which is checked without the lock.
+void util::TFileMetadataDUNE::addSubRun(art::SubRunID const& srid)
+{
+  unsigned long long key = (static_cast<unsigned long long>(srid.run()) << 32) | srid.subRun();
+  if (fLastSubRunKey.load(std::memory_order_acquire) == key) return;
+  std::lock_guard<std::mutex> lock(fSubRunMutex);
   if (fSubRunNumbers.count(srid) == 0){
     fSubRunNumbers.insert(srid);
-    md.fruns.push_back(make_tuple(run, subrun, frunType));
+    md.fruns.push_back(make_tuple(srid.run(), srid.subRun(), frunType));
   }
+  fLastSubRunKey.store(key, std::memory_order_release);
+}
+
+//--------------------------------------------------------------------
+// Copy the event counters into the metadata.
+void util::TFileMetadataDUNE::syncCounters()
+{
+  md.fevent_count = fEventCount.load();
+  md.fnew_event_count = fNewEventCount.load();
+  md.ffirst_event = fFirstEvent.load();
+  md.flast_event = fLastEvent.load();
 }
 
 //--------------------------------------------------------------------
@@ -285,6 +296,8 @@ void util::TFileMetadataDUNE::postEndJob()
   //update end time
   md.fend_time = time(0);
 
+  syncCounters();
+
   // convert start and end times into time format: Year-Month-DayTHours:Minutes:Seconds
   char endbuf[80], startbuf[80];
   struct tm tstruct;
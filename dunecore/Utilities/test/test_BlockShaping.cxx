@@ -0,0 +1,86 @@
+// test_BlockShaping.cxx
+//
+// Test BlockShaping.
+
+#include "dunecore/Utilities/BlockShaping.h"
+#include <string>
+#include <iostream>
+#include <cmath>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using util::BlockShaping;
+using Index = BlockShaping::Index;
+using Kernel = BlockShaping::Kernel;
+
+//**********************************************************************
+
+int test_BlockShaping() {
+  const string myname = "test_BlockShaping: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Build a kernel that delays by ndel ticks." << endl;
+  Index nsam = 64;
+  Index ndel = 3;
+  Index nfrq = nsam/2 + 1;
+  Kernel kern(nfrq);
+  for ( Index ifrq=0; ifrq<nfrq; ++ifrq ) {
+    double phase = -2.0*M_PI*ifrq*ndel/nsam;
+    kern[ifrq] = TComplex(std::cos(phase), std::sin(phase));
+  }
+  std::vector<double> data(nsam);
+  for ( Index isam=0; isam<nsam; ++isam ) data[isam] = std::sin(0.3*isam) + 0.1*isam;
+  FwFFT xf(nsam, 0);
+
+  cout << myname << line << endl;
+  cout << myname << "Transform one time series." << endl;
+  std::vector<double> out = data;
+  BlockShaping::transformSamples(xf, kern, out.data(), nsam, "test_BlockShaping");
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    double exp = data[(isam + nsam - ndel) % nsam];
+    assert( std::fabs(out[isam] - exp) < 1.e-9 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with a one-row block." << endl;
+  AdcChannelBlock blk(1, nsam);
+  for ( Index isam=0; isam<nsam; ++isam ) blk.samples(0)[isam] = data[isam];
+  BlockShaping::KernelRows krows;
+  krows[&kern].push_back(0);
+  BlockShaping::transform(xf, blk, krows, BlockShaping::OffsetVector(), "test_BlockShaping");
+  for ( Index isam=0; isam<nsam; ++isam ) {
+    assert( std::fabs(blk.samples(0)[isam] - out[isam]) < 1.e-4 );
+  }
+
+  cout << myname << line << endl;
+  cout << myname << "Check a short kernel is rejected." << endl;
+  Kernel badKern(nfrq - 1);
+  bool threw = false;
+  try {
+    BlockShaping::transformSamples(xf, badKern, out.data(), nsam, "test_BlockShaping");
+  } catch ( const cet::exception& ) {
+    threw = true;
+  }
+  assert( threw );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_BlockShaping();
+}
+
+//**********************************************************************
@@ -0,0 +1,75 @@
+// test_ElectResponseCache.cxx
+//
+// Test ElectResponseCache.
+
+#include "dunecore/Utilities/ElectResponseCache.h"
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using util::ElectResponseCache;
+using DoubleVector = ElectResponseCache::DoubleVector;
+
+//**********************************************************************
+
+int test_ElectResponseCache() {
+  const string myname = "test_ElectResponseCache: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Build a response." << endl;
+  double shapingTime = 2.0;
+  double gain = 14.0;
+  double period = 500.0;
+  int nticks = 4096;
+  double adcPerPC = 6000.0;
+  DoubleVector resp = ElectResponseCache::build(shapingTime, gain, period, nticks, adcPerPC);
+  assert( int(resp.size()) == nticks );
+  double peak = *std::max_element(resp.begin(), resp.end());
+  assert( std::fabs(resp[0]) < 1.e-3*peak );
+  double expPeak = adcPerPC*1.60217657e-7*gain/4.7;
+  cout << myname << "Peak: " << peak << " ?= " << expPeak << endl;
+  assert( std::fabs(peak - expPeak) < 1.e-12*expPeak );
+  unsigned int imax = std::max_element(resp.begin(), resp.end()) - resp.begin();
+  cout << myname << "Peak tick: " << imax << endl;
+  assert( imax > 0 && imax < 20 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check the cache." << endl;
+  ElectResponseCache& cache = ElectResponseCache::instance();
+  assert( &cache == &ElectResponseCache::instance() );
+  unsigned int nres0 = cache.size();
+  const DoubleVector& resp1 = cache.get(shapingTime, gain, period, nticks, adcPerPC);
+  assert( resp1 == resp );
+  assert( cache.size() == nres0 + 1 );
+  const DoubleVector& resp2 = cache.get(shapingTime, gain, period, nticks, adcPerPC);
+  assert( &resp2 == &resp1 );
+  assert( cache.size() == nres0 + 1 );
+  const DoubleVector& resp3 = cache.get(shapingTime, 2*gain, period, nticks, adcPerPC);
+  assert( &resp3 != &resp1 );
+  assert( cache.size() == nres0 + 2 );
+  assert( std::fabs(resp3[imax] - 2*resp1[imax]) < 1.e-12*resp3[imax] );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_ElectResponseCache();
+}
+
+//**********************************************************************
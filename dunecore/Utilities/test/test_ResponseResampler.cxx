@@ -0,0 +1,108 @@
+// test_ResponseResampler.cxx
+//
+// Test ResponseResampler.
+
+#include "dunecore/Utilities/ResponseResampler.h"
+#include <string>
+#include <iostream>
+#include <cmath>
+
+#undef NDEBUG
+#include <cassert>
+
+using std::string;
+using std::cout;
+using std::endl;
+using util::ResponseResampler;
+using DoubleVector = ResponseResampler::DoubleVector;
+
+//**********************************************************************
+
+// The original resampling with a search of the input for each output tick.
+DoubleVector resampleSearch(const DoubleVector& resp, double periodIn, double periodOut, int nticks) {
+  DoubleVector out(nticks, 0.);
+  int nin = resp.size();
+  int count = 0;
+  for ( int itime = 0; itime < nticks; itime++ ) {
+    double tout = (1.*itime) * periodOut;
+    for ( int jtime = 0; jtime < nin; jtime++ ) {
+      double tin = (1.*jtime) * periodIn;
+      if ( tin == tout ) {
+        out[itime] = resp[jtime];
+        ++count;
+        break;
+      } else if ( tin > tout ) {
+        int low = jtime - 1;
+        double tlow = (1.*low) * periodIn;
+        out[itime] = resp[low] + (tout - tlow) * (resp[jtime] - resp[low]) / (tin - tlow);
+        ++count;
+        break;
+      }
+    }
+  }
+  out.resize(count);
+  return out;
+}
+
+//**********************************************************************
+
+int test_ResponseResampler() {
+  const string myname = "test_ResponseResampler: ";
+#ifdef NDEBUG
+  cout << myname << "NDEBUG must be off." << endl;
+  abort();
+#endif
+  string line = "-----------------------------";
+
+  cout << myname << line << endl;
+  cout << myname << "Build the input response." << endl;
+  DoubleVector resp;
+  for ( int itime=0; itime<1000; ++itime ) resp.push_back(std::sin(0.01*itime)*std::exp(-0.002*itime));
+
+  cout << myname << line << endl;
+  cout << myname << "Compare with the search." << endl;
+  for ( double periodOut : {10.0, 200.0, 400.0, 500.0, 123.4} ) {
+    for ( int nticks : {1, 10, 100, 10000} ) {
+      DoubleVector exp = resampleSearch(resp, 100.0, periodOut, nticks);
+      DoubleVector out = ResponseResampler::resample(resp, 100.0, periodOut, nticks);
+      cout << myname << "  " << periodOut << ", " << nticks << ": " << out.size() << endl;
+      assert( out.size() == exp.size() );
+      for ( unsigned int itime=0; itime<out.size(); ++itime ) assert( out[itime] == exp[itime] );
+    }
+  }
+  assert( ResponseResampler::resample(DoubleVector(), 100.0, 200.0, 10).size() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Check the cache." << endl;
+  ResponseResampler rrs;
+  assert( rrs.size() == 0 );
+  const DoubleVector& out1 = rrs.get(resp, 100.0, 400.0, 1000);
+  assert( rrs.size() == 1 );
+  assert( out1 == ResponseResampler::resample(resp, 100.0, 400.0, 1000) );
+  const DoubleVector& out2 = rrs.get(resp, 100.0, 400.0, 1000);
+  assert( rrs.size() == 1 );
+  assert( &out2 == &out1 );
+  rrs.get(resp, 100.0, 500.0, 1000);
+  assert( rrs.size() == 2 );
+  DoubleVector resp2 = resp;
+  resp2[10] += 1.0;
+  rrs.get(resp2, 100.0, 500.0, 1000);
+  assert( rrs.size() == 3 );
+  int ntickMax = 2*ResponseResampler::maxSize();
+  for ( int nticks=1; nticks<=ntickMax; ++nticks ) rrs.get(resp, 100.0, 500.0, nticks);
+  assert( rrs.size() == ResponseResampler::maxSize() );
+  rrs.clear();
+  assert( rrs.size() == 0 );
+
+  cout << myname << line << endl;
+  cout << myname << "Done." << endl;
+  return 0;
+}
+
+//**********************************************************************
+
+int main() {
+  return test_ResponseResampler();
+}
+
+//**********************************************************************